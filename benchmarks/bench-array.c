@@ -0,0 +1,179 @@
+/* GLib benchmarks
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "glib-bench.h"
+
+/* Searching large arrays: pointer equality in a GPtrArray, and binary
+ * search in a sorted GArray of integers, with a comparison function and
+ * without. Plus removing many pointers from a GPtrArray at once. */
+
+#define N_ELEMENTS 100000
+#define N_LOOKUPS 1000
+#define N_REMOVALS 1000
+
+typedef struct {
+  GPtrArray *pointers;
+  GArray *integers;
+  guint32 *targets;  /* N_LOOKUPS of them, half of them missing */
+} ArrayBench;
+
+static ArrayBench *
+array_bench_new (void)
+{
+  ArrayBench *bench = g_new0 (ArrayBench, 1);
+  GRand *rand = g_rand_new_with_seed (42);
+  guint i;
+
+  bench->pointers = g_ptr_array_new ();
+  bench->integers = g_array_sized_new (FALSE, FALSE, sizeof (guint32), N_ELEMENTS);
+  for (i = 0; i < N_ELEMENTS; i++)
+    {
+      guint32 v = 2 * i;
+
+      g_ptr_array_add (bench->pointers, GUINT_TO_POINTER (v + 1));
+      g_array_append_val (bench->integers, v);
+    }
+
+  bench->targets = g_new (guint32, N_LOOKUPS);
+  for (i = 0; i < N_LOOKUPS; i++)
+    bench->targets[i] = g_rand_int_range (rand, 0, 2 * N_ELEMENTS);
+
+  g_rand_free (rand);
+
+  return bench;
+}
+
+static void
+array_bench_free (ArrayBench *bench)
+{
+  g_ptr_array_unref (bench->pointers);
+  g_array_unref (bench->integers);
+  g_free (bench->targets);
+  g_free (bench);
+}
+
+static void
+run_ptr_array_find (gpointer data,
+                    guint64  n_iterations)
+{
+  ArrayBench *bench = data;
+  guint64 i;
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      guint32 target = bench->targets[i % N_LOOKUPS];
+      guint index;
+
+      if (g_ptr_array_find (bench->pointers, GUINT_TO_POINTER (target + 1), &index))
+        g_assert_cmpuint (index, ==, target / 2);
+    }
+}
+
+static gint
+compare_guint32 (gconstpointer a,
+                 gconstpointer b)
+{
+  guint32 x = *(const guint32 *) a, y = *(const guint32 *) b;
+
+  return (x > y) - (x < y);
+}
+
+static void
+run_binary_search (gpointer data,
+                   guint64  n_iterations)
+{
+  ArrayBench *bench = data;
+  guint64 i;
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      const guint32 *target = &bench->targets[i % N_LOOKUPS];
+
+      g_assert_cmpint (g_array_binary_search (bench->integers, target, compare_guint32, NULL),
+                       ==, *target % 2 == 0);
+    }
+}
+
+static void
+run_binary_search_integers (gpointer data,
+                            guint64  n_iterations)
+{
+  ArrayBench *bench = data;
+  guint64 i;
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      const guint32 *target = &bench->targets[i % N_LOOKUPS];
+
+      g_assert_cmpint (g_array_binary_search_integers (bench->integers, target, FALSE, NULL),
+                       ==, *target % 2 == 0);
+    }
+}
+
+static void
+run_remove_fast_many (gpointer data,
+                      guint64  n_iterations)
+{
+  ArrayBench *bench = data;
+  gpointer *to_remove = g_new (gpointer, N_REMOVALS);
+  guint64 i;
+  guint j;
+
+  for (j = 0; j < N_REMOVALS; j++)
+    to_remove[j] = GUINT_TO_POINTER (bench->targets[j] | 1);
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      GPtrArray *copy = g_ptr_array_copy (bench->pointers, NULL, NULL);
+
+      g_assert_cmpuint (g_ptr_array_remove_fast_many (copy, to_remove, N_REMOVALS), >, 0);
+      g_ptr_array_unref (copy);
+    }
+
+  g_free (to_remove);
+}
+
+static void
+test_array (gconstpointer user_data)
+{
+  BenchFunc func = (BenchFunc) user_data;
+  ArrayBench *bench = array_bench_new ();
+  guint64 n_perf_iterations = 1000000;
+  const char *unit = "lookups/s";
+
+  if (func == run_ptr_array_find)
+    n_perf_iterations = 5000;
+  else if (func == run_remove_fast_many)
+    {
+      n_perf_iterations = 200;
+      unit = "arrays/s";
+    }
+
+  bench_measure (unit, 1, bench_iterations (n_perf_iterations), func, bench);
+
+  array_bench_free (bench);
+}
+
+void
+bench_add_array (void)
+{
+  g_test_add_data_func ("/bench/array/ptr-array-find", (gconstpointer) run_ptr_array_find, test_array);
+  g_test_add_data_func ("/bench/array/binary-search", (gconstpointer) run_binary_search, test_array);
+  g_test_add_data_func ("/bench/array/binary-search-integers", (gconstpointer) run_binary_search_integers, test_array);
+  g_test_add_data_func ("/bench/array/remove-fast-many", (gconstpointer) run_remove_fast_many, test_array);
+}
@@ -0,0 +1,344 @@
+/* GLib benchmarks
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "glib-bench.h"
+
+#ifdef G_OS_UNIX
+#include <sys/socket.h>
+#endif
+
+/* Method call round trips and signal throughput between two
+ * GDBusConnections over a socket pair, with the server side running in
+ * its own thread like a separate process would. */
+
+#define BENCH_PATH "/org/gtk/Bench"
+#define BENCH_INTERFACE "org.gtk.Bench"
+
+static const char introspection_xml[] =
+  "<node>"
+  "  <interface name='" BENCH_INTERFACE "'>"
+  "    <method name='Echo'>"
+  "      <arg type='s' name='text' direction='in'/>"
+  "      <arg type='s' name='text' direction='out'/>"
+  "    </method>"
+  "    <method name='EmitSignals'>"
+  "      <arg type='u' name='count' direction='in'/>"
+  "    </method>"
+  "    <signal name='Tick'>"
+  "      <arg type='u' name='serial'/>"
+  "    </signal>"
+  "  </interface>"
+  "</node>";
+
+typedef struct {
+  GIOStream *stream;
+  const char *guid;
+  GThread *thread;
+  GMainContext *context;
+  GMainLoop *loop;
+
+  GMutex mutex;
+  GCond cond;
+  gboolean ready;
+} BenchServer;
+
+static void
+server_method_call (GDBusConnection       *connection,
+                    const char            *sender,
+                    const char            *object_path,
+                    const char            *interface_name,
+                    const char            *method_name,
+                    GVariant              *parameters,
+                    GDBusMethodInvocation *invocation,
+                    gpointer               user_data)
+{
+  if (g_str_equal (method_name, "Echo"))
+    {
+      g_dbus_method_invocation_return_value (invocation, parameters);
+    }
+  else if (g_str_equal (method_name, "EmitSignals"))
+    {
+      guint32 count, i;
+
+      g_variant_get (parameters, "(u)", &count);
+      for (i = 0; i < count; i++)
+        g_dbus_connection_emit_signal (connection, NULL, BENCH_PATH, BENCH_INTERFACE,
+                                       "Tick", g_variant_new ("(u)", i), NULL);
+
+      g_dbus_method_invocation_return_value (invocation, NULL);
+    }
+  else
+    {
+      g_assert_not_reached ();
+    }
+}
+
+static const GDBusInterfaceVTable server_vtable = {
+  server_method_call, NULL, NULL, { 0 },
+};
+
+static gpointer
+server_thread_func (gpointer user_data)
+{
+  BenchServer *server = user_data;
+  GDBusConnection *connection;
+  GDBusNodeInfo *node_info;
+  GError *error = NULL;
+  guint registration_id;
+
+  g_main_context_push_thread_default (server->context);
+
+  connection = g_dbus_connection_new_sync (server->stream, server->guid,
+                                           G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_SERVER,
+                                           NULL, NULL, &error);
+  g_assert_no_error (error);
+
+  node_info = g_dbus_node_info_new_for_xml (introspection_xml, &error);
+  g_assert_no_error (error);
+  registration_id = g_dbus_connection_register_object (connection, BENCH_PATH,
+                                                       node_info->interfaces[0],
+                                                       &server_vtable, NULL, NULL,
+                                                       &error);
+  g_assert_no_error (error);
+  g_dbus_node_info_unref (node_info);
+
+  g_mutex_lock (&server->mutex);
+  server->ready = TRUE;
+  g_cond_signal (&server->cond);
+  g_mutex_unlock (&server->mutex);
+
+  g_main_loop_run (server->loop);
+
+  g_dbus_connection_unregister_object (connection, registration_id);
+  g_dbus_connection_close_sync (connection, NULL, NULL);
+  g_object_unref (connection);
+
+  g_main_context_pop_thread_default (server->context);
+
+  return NULL;
+}
+
+static gboolean
+quit_loop_cb (gpointer user_data)
+{
+  g_main_loop_quit (user_data);
+  return G_SOURCE_REMOVE;
+}
+
+#ifdef G_OS_UNIX
+static GIOStream *
+stream_for_fd (int fd)
+{
+  GError *error = NULL;
+  GSocket *socket;
+  GSocketConnection *connection;
+
+  socket = g_socket_new_from_fd (fd, &error);
+  g_assert_no_error (error);
+  connection = g_socket_connection_factory_create_connection (socket);
+  g_object_unref (socket);
+
+  return G_IO_STREAM (connection);
+}
+#endif
+
+/* Returns a client connection to a new server thread in @server */
+static GDBusConnection *
+bench_server_start (BenchServer *server)
+{
+#ifdef G_OS_UNIX
+  GDBusConnection *client;
+  GIOStream *client_stream;
+  GError *error = NULL;
+  char *guid;
+  int sv[2];
+
+  g_assert_cmpint (socketpair (AF_UNIX, SOCK_STREAM, 0, sv), ==, 0);
+
+  guid = g_dbus_generate_guid ();
+  memset (server, 0, sizeof (*server));
+  server->stream = stream_for_fd (sv[0]);
+  server->guid = guid;
+  server->context = g_main_context_new ();
+  server->loop = g_main_loop_new (server->context, FALSE);
+  g_mutex_init (&server->mutex);
+  g_cond_init (&server->cond);
+  server->thread = g_thread_new ("bench-dbus-server", server_thread_func, server);
+
+  client_stream = stream_for_fd (sv[1]);
+  client = g_dbus_connection_new_sync (client_stream, NULL,
+                                       G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT,
+                                       NULL, NULL, &error);
+  g_assert_no_error (error);
+  g_object_unref (client_stream);
+
+  /* Wait for the object to be exported */
+  g_mutex_lock (&server->mutex);
+  while (!server->ready)
+    g_cond_wait (&server->cond, &server->mutex);
+  g_mutex_unlock (&server->mutex);
+
+  server->guid = NULL;
+  g_free (guid);
+
+  return client;
+#else
+  return NULL;
+#endif
+}
+
+static void
+bench_server_stop (BenchServer     *server,
+                   GDBusConnection *client)
+{
+  g_dbus_connection_close_sync (client, NULL, NULL);
+  g_object_unref (client);
+
+  g_main_context_invoke (server->context, quit_loop_cb, server->loop);
+  g_thread_join (server->thread);
+
+  g_main_loop_unref (server->loop);
+  g_main_context_unref (server->context);
+  g_object_unref (server->stream);
+  g_mutex_clear (&server->mutex);
+  g_cond_clear (&server->cond);
+}
+
+static void
+run_round_trips (gpointer data,
+                 guint64  n_iterations)
+{
+  GDBusConnection *client = data;
+  guint64 i;
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      GError *error = NULL;
+      GVariant *reply;
+
+      reply = g_dbus_connection_call_sync (client, NULL, BENCH_PATH, BENCH_INTERFACE,
+                                           "Echo", g_variant_new ("(s)", "ping"),
+                                           G_VARIANT_TYPE ("(s)"),
+                                           G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+      g_assert_no_error (error);
+      g_variant_unref (reply);
+    }
+}
+
+static void
+test_dbus_round_trip (void)
+{
+  BenchServer server;
+  GDBusConnection *client;
+
+#ifndef G_OS_UNIX
+  g_test_skip ("Socket pairs are only available on Unix");
+  return;
+#endif
+
+  client = bench_server_start (&server);
+  bench_measure ("calls/s", 1, bench_iterations (20000), run_round_trips, client);
+  bench_server_stop (&server, client);
+}
+
+#define SIGNALS_PER_CALL 1000
+
+typedef struct {
+  GDBusConnection *client;
+  GMainContext *context;
+  guint64 n_received;
+} SignalBench;
+
+static void
+tick_cb (GDBusConnection *connection,
+         const char      *sender_name,
+         const char      *object_path,
+         const char      *interface_name,
+         const char      *signal_name,
+         GVariant        *parameters,
+         gpointer         user_data)
+{
+  SignalBench *bench = user_data;
+
+  bench->n_received++;
+}
+
+static void
+run_signals (gpointer data,
+             guint64  n_iterations)
+{
+  SignalBench *bench = data;
+  guint64 i;
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      GError *error = NULL;
+      GVariant *reply;
+      guint64 expected = bench->n_received + SIGNALS_PER_CALL;
+
+      reply = g_dbus_connection_call_sync (bench->client, NULL, BENCH_PATH, BENCH_INTERFACE,
+                                           "EmitSignals", g_variant_new ("(u)", SIGNALS_PER_CALL),
+                                           NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+      g_assert_no_error (error);
+      g_variant_unref (reply);
+
+      while (bench->n_received < expected)
+        g_main_context_iteration (bench->context, TRUE);
+    }
+}
+
+static void
+test_dbus_signals (void)
+{
+  BenchServer server;
+  SignalBench bench = { 0, };
+  guint subscription_id;
+
+#ifndef G_OS_UNIX
+  g_test_skip ("Socket pairs are only available on Unix");
+  return;
+#endif
+
+  bench.context = g_main_context_new ();
+  g_main_context_push_thread_default (bench.context);
+
+  bench.client = bench_server_start (&server);
+  subscription_id = g_dbus_connection_signal_subscribe (bench.client, NULL, BENCH_INTERFACE,
+                                                        "Tick", BENCH_PATH, NULL,
+                                                        G_DBUS_SIGNAL_FLAGS_NONE,
+                                                        tick_cb, &bench, NULL);
+
+  bench_measure ("signals/s", SIGNALS_PER_CALL, bench_iterations (50), run_signals, &bench);
+
+  g_dbus_connection_signal_unsubscribe (bench.client, subscription_id);
+  bench_server_stop (&server, bench.client);
+
+  /* Flush the unsubscription */
+  while (g_main_context_iteration (bench.context, FALSE));
+  g_main_context_pop_thread_default (bench.context);
+  g_main_context_unref (bench.context);
+}
+
+void
+bench_add_dbus (void)
+{
+  g_test_add_func ("/bench/dbus/round-trip", test_dbus_round_trip);
+  g_test_add_func ("/bench/dbus/signals", test_dbus_signals);
+}
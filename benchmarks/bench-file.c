@@ -0,0 +1,153 @@
+/* GLib benchmarks
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib/gstdio.h>
+
+#include "glib-bench.h"
+
+/* g_file_enumerate_children() on a synthetic tree of directories, with
+ * the attributes a file chooser would ask for. The tree stays in the
+ * page cache, so this measures GIO rather than the disk. */
+
+#define N_DIRS 10
+#define N_FILES_PER_DIR 500
+
+#define ENUMERATE_ATTRIBUTES \
+  G_FILE_ATTRIBUTE_STANDARD_NAME "," \
+  G_FILE_ATTRIBUTE_STANDARD_TYPE "," \
+  G_FILE_ATTRIBUTE_STANDARD_SIZE "," \
+  G_FILE_ATTRIBUTE_TIME_MODIFIED
+
+static void
+create_tree (const char *root)
+{
+  guint i, j;
+
+  for (i = 0; i < N_DIRS; i++)
+    {
+      char *dir = g_strdup_printf ("%s/dir-%u", root, i);
+
+      g_assert_cmpint (g_mkdir (dir, 0700), ==, 0);
+
+      for (j = 0; j < N_FILES_PER_DIR; j++)
+        {
+          GError *error = NULL;
+          char *path = g_strdup_printf ("%s/file-%u.txt", dir, j);
+
+          g_file_set_contents (path, "contents", -1, &error);
+          g_assert_no_error (error);
+          g_free (path);
+        }
+
+      g_free (dir);
+    }
+}
+
+static void
+remove_tree (const char *root)
+{
+  guint i, j;
+
+  for (i = 0; i < N_DIRS; i++)
+    {
+      char *dir = g_strdup_printf ("%s/dir-%u", root, i);
+
+      for (j = 0; j < N_FILES_PER_DIR; j++)
+        {
+          char *path = g_strdup_printf ("%s/file-%u.txt", dir, j);
+
+          g_remove (path);
+          g_free (path);
+        }
+
+      g_rmdir (dir);
+      g_free (dir);
+    }
+
+  g_rmdir (root);
+}
+
+static guint
+enumerate (GFile *dir)
+{
+  GFileEnumerator *enumerator;
+  GError *error = NULL;
+  GFileInfo *info;
+  guint n = 0;
+
+  enumerator = g_file_enumerate_children (dir, ENUMERATE_ATTRIBUTES,
+                                          G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS,
+                                          NULL, &error);
+  g_assert_no_error (error);
+
+  while ((info = g_file_enumerator_next_file (enumerator, NULL, &error)) != NULL)
+    {
+      if (g_file_info_get_file_type (info) == G_FILE_TYPE_DIRECTORY)
+        {
+          GFile *child = g_file_enumerator_get_child (enumerator, info);
+
+          n += enumerate (child);
+          g_object_unref (child);
+        }
+
+      n++;
+      g_object_unref (info);
+    }
+  g_assert_no_error (error);
+
+  g_object_unref (enumerator);
+
+  return n;
+}
+
+static void
+run_enumerate (gpointer data,
+               guint64  n_iterations)
+{
+  GFile *root = data;
+  guint64 i;
+
+  for (i = 0; i < n_iterations; i++)
+    g_assert_cmpuint (enumerate (root), ==, N_DIRS * (N_FILES_PER_DIR + 1));
+}
+
+static void
+test_file_enumerate_children (void)
+{
+  GError *error = NULL;
+  char *path;
+  GFile *root;
+
+  path = g_dir_make_tmp ("glib-bench-XXXXXX", &error);
+  g_assert_no_error (error);
+  create_tree (path);
+  root = g_file_new_for_path (path);
+
+  bench_measure ("files/s", N_DIRS * (N_FILES_PER_DIR + 1), bench_iterations (50),
+                 run_enumerate, root);
+
+  g_object_unref (root);
+  remove_tree (path);
+  g_free (path);
+}
+
+void
+bench_add_file (void)
+{
+  g_test_add_func ("/bench/file/enumerate-children", test_file_enumerate_children);
+}
@@ -0,0 +1,198 @@
+/* GLib benchmarks
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "glib-bench.h"
+
+/* GHashTable operations with string keys, at sizes which fit in the L1
+ * cache, the last level cache and neither. */
+
+static const guint hash_table_sizes[] = { 100, 10000, 1000000 };
+
+typedef struct {
+  guint size;
+  char **keys;       /* in insertion order */
+  char **lookups;    /* the same keys in another order, as distinct strings */
+  GHashTable *table;
+} HashTableBench;
+
+static HashTableBench *
+hash_table_bench_new (guint size)
+{
+  HashTableBench *bench = g_new0 (HashTableBench, 1);
+  GRand *rand = g_rand_new_with_seed (42);
+  guint i;
+
+  bench->size = size;
+  bench->keys = g_new (char *, size + 1);
+  bench->lookups = g_new (char *, size + 1);
+
+  for (i = 0; i < size; i++)
+    bench->keys[i] = g_strdup_printf ("key-%u-%08x", i, g_rand_int (rand));
+  bench->keys[size] = NULL;
+
+  for (i = 0; i < size; i++)
+    bench->lookups[i] = g_strdup (bench->keys[i]);
+  bench->lookups[size] = NULL;
+
+  /* Fisher-Yates, with a fixed seed for reproducible results */
+  for (i = size; i > 1; i--)
+    {
+      guint j = g_rand_int_range (rand, 0, i);
+      char *tmp = bench->lookups[i - 1];
+
+      bench->lookups[i - 1] = bench->lookups[j];
+      bench->lookups[j] = tmp;
+    }
+
+  g_rand_free (rand);
+
+  return bench;
+}
+
+static void
+hash_table_bench_free (HashTableBench *bench)
+{
+  g_clear_pointer (&bench->table, g_hash_table_unref);
+  g_strfreev (bench->keys);
+  g_strfreev (bench->lookups);
+  g_free (bench);
+}
+
+static void
+fill_table (HashTableBench *bench)
+{
+  guint i;
+
+  g_clear_pointer (&bench->table, g_hash_table_unref);
+  bench->table = g_hash_table_new (g_str_hash, g_str_equal);
+
+  for (i = 0; i < bench->size; i++)
+    g_hash_table_insert (bench->table, bench->keys[i], GUINT_TO_POINTER (i + 1));
+}
+
+static void
+run_insert (gpointer data,
+            guint64  n_iterations)
+{
+  guint64 i;
+
+  for (i = 0; i < n_iterations; i++)
+    fill_table (data);
+}
+
+static void
+run_lookup (gpointer data,
+            guint64  n_iterations)
+{
+  HashTableBench *bench = data;
+  guint64 i;
+  guint j;
+
+  for (i = 0; i < n_iterations; i++)
+    for (j = 0; j < bench->size; j++)
+      g_assert_nonnull (g_hash_table_lookup (bench->table, bench->lookups[j]));
+}
+
+static void
+run_remove (gpointer data,
+            guint64  n_iterations)
+{
+  HashTableBench *bench = data;
+  guint64 i;
+  guint j;
+
+  /* Refilling is part of the measurement, see the insert benchmark for
+   * its share */
+  for (i = 0; i < n_iterations; i++)
+    {
+      fill_table (bench);
+      for (j = 0; j < bench->size; j++)
+        g_hash_table_remove (bench->table, bench->lookups[j]);
+      g_assert_cmpuint (g_hash_table_size (bench->table), ==, 0);
+    }
+}
+
+static guint64
+hash_table_iterations (guint size)
+{
+  /* About 10⁷ operations per measurement */
+  return bench_iterations (MAX (10000000 / size, 1));
+}
+
+static void
+test_hash_table_insert (gconstpointer user_data)
+{
+  guint size = GPOINTER_TO_UINT (user_data);
+  HashTableBench *bench = hash_table_bench_new (size);
+
+  bench_measure ("inserts/s", size, hash_table_iterations (size), run_insert, bench);
+  g_assert_cmpuint (g_hash_table_size (bench->table), ==, size);
+
+  hash_table_bench_free (bench);
+}
+
+static void
+test_hash_table_lookup (gconstpointer user_data)
+{
+  guint size = GPOINTER_TO_UINT (user_data);
+  HashTableBench *bench = hash_table_bench_new (size);
+
+  fill_table (bench);
+  bench_measure ("lookups/s", size, hash_table_iterations (size), run_lookup, bench);
+
+  hash_table_bench_free (bench);
+}
+
+static void
+test_hash_table_remove (gconstpointer user_data)
+{
+  guint size = GPOINTER_TO_UINT (user_data);
+  HashTableBench *bench = hash_table_bench_new (size);
+
+  bench_measure ("inserts+removes/s", size, hash_table_iterations (size), run_remove, bench);
+
+  hash_table_bench_free (bench);
+}
+
+void
+bench_add_hash_table (void)
+{
+  gsize i;
+
+  for (i = 0; i < G_N_ELEMENTS (hash_table_sizes); i++)
+    {
+      gpointer size = GUINT_TO_POINTER (hash_table_sizes[i]);
+      char *path;
+
+      /* Only checking that the benchmarks work doesn't need a huge table */
+      if (!g_test_perf () && hash_table_sizes[i] > 10000)
+        continue;
+
+      path = g_strdup_printf ("/bench/hash-table/insert/%u", hash_table_sizes[i]);
+      g_test_add_data_func (path, size, test_hash_table_insert);
+      g_free (path);
+
+      path = g_strdup_printf ("/bench/hash-table/lookup/%u", hash_table_sizes[i]);
+      g_test_add_data_func (path, size, test_hash_table_lookup);
+      g_free (path);
+
+      path = g_strdup_printf ("/bench/hash-table/remove/%u", hash_table_sizes[i]);
+      g_test_add_data_func (path, size, test_hash_table_remove);
+      g_free (path);
+    }
+}
@@ -0,0 +1,162 @@
+/* GLib benchmarks
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "glib-bench.h"
+
+#ifdef G_OS_UNIX
+#include <glib-unix.h>
+#include <fcntl.h>
+#endif
+
+/* Cost of one GMainContext iteration dispatching a single idle source,
+ * while many other sources which never become ready are attached. */
+
+typedef enum {
+  IDLE_SOURCES,
+  TIMEOUT_SOURCES,
+  FD_SOURCES,
+} SourceKind;
+
+typedef struct {
+  SourceKind kind;
+  guint n_sources;
+} MainContextBench;
+
+static const MainContextBench main_context_benches[] = {
+  { IDLE_SOURCES, 0 },
+  { TIMEOUT_SOURCES, 16 },
+  { TIMEOUT_SOURCES, 1024 },
+#ifdef G_OS_UNIX
+  { FD_SOURCES, 16 },
+  { FD_SOURCES, 1024 },
+#endif
+};
+
+static gboolean
+never_dispatched_cb (gpointer user_data)
+{
+  g_assert_not_reached ();
+  return G_SOURCE_CONTINUE;
+}
+
+#ifdef G_OS_UNIX
+static gboolean
+never_dispatched_fd_cb (gint         fd,
+                        GIOCondition condition,
+                        gpointer     user_data)
+{
+  g_assert_not_reached ();
+  return G_SOURCE_CONTINUE;
+}
+#endif
+
+static gboolean
+count_cb (gpointer user_data)
+{
+  guint64 *n_dispatched = user_data;
+
+  (*n_dispatched)++;
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+run_iterations (gpointer data,
+                guint64  n_iterations)
+{
+  GMainContext *context = data;
+  guint64 i;
+
+  for (i = 0; i < n_iterations; i++)
+    g_main_context_iteration (context, FALSE);
+}
+
+static void
+test_main_context_iteration (gconstpointer user_data)
+{
+  const MainContextBench *bench = user_data;
+  GMainContext *context;
+  GSource *source;
+  GArray *fds;
+  guint64 n_dispatched = 0;
+  guint64 n_iterations;
+  guint i;
+
+  context = g_main_context_new ();
+  fds = g_array_new (FALSE, FALSE, sizeof (int));
+
+  for (i = 0; i < bench->n_sources; i++)
+    {
+      if (bench->kind == TIMEOUT_SOURCES)
+        {
+          /* Distinct ready times, so none of them is ever due */
+          source = g_timeout_source_new_seconds (3600 + i);
+          g_source_set_callback (source, never_dispatched_cb, NULL, NULL);
+        }
+#ifdef G_OS_UNIX
+      else
+        {
+          GError *error = NULL;
+          int pipe_fds[2];
+
+          /* The read end of an empty pipe is never readable */
+          g_unix_open_pipe (pipe_fds, O_CLOEXEC, &error);
+          g_assert_no_error (error);
+          g_array_append_vals (fds, pipe_fds, 2);
+
+          source = g_unix_fd_source_new (pipe_fds[0], G_IO_IN);
+          g_source_set_callback (source, G_SOURCE_FUNC (never_dispatched_fd_cb), NULL, NULL);
+        }
+#endif
+      g_source_attach (source, context);
+      g_source_unref (source);
+    }
+
+  source = g_idle_source_new ();
+  g_source_set_callback (source, count_cb, &n_dispatched, NULL);
+  g_source_attach (source, context);
+  g_source_unref (source);
+
+  n_iterations = bench_iterations (100000);
+  bench_measure ("iterations/s", 1, n_iterations, run_iterations, context);
+  g_assert_cmpuint (n_dispatched, >=, n_iterations);
+
+  g_main_context_unref (context);
+
+  for (i = 0; i < fds->len; i++)
+    g_close (g_array_index (fds, int, i), NULL);
+  g_array_unref (fds);
+}
+
+void
+bench_add_main_context (void)
+{
+  gsize i;
+
+  for (i = 0; i < G_N_ELEMENTS (main_context_benches); i++)
+    {
+      const MainContextBench *bench = &main_context_benches[i];
+      const char *kinds[] = { "idle", "timeouts", "fds" };
+      char *path;
+
+      path = g_strdup_printf ("/bench/main-context/iteration/%s-%u",
+                              kinds[bench->kind], bench->n_sources);
+      g_test_add_data_func (path, bench, test_main_context_iteration);
+      g_free (path);
+    }
+}
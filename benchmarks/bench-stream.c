@@ -0,0 +1,131 @@
+/* GLib benchmarks
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "glib-bench.h"
+
+/* Stream plumbing overhead: splicing between streams, and reading a text
+ * line by line with GDataInputStream. Memory streams are used so that
+ * only GIO itself is measured. */
+
+#define SPLICE_SIZE (4 * 1024 * 1024)
+#define N_LINES 10000
+
+static GBytes *
+make_text (void)
+{
+  GString *text = g_string_new (NULL);
+  guint i;
+
+  for (i = 0; i < N_LINES; i++)
+    g_string_append_printf (text, "%u: the quick brown fox jumps over the lazy dog\n", i);
+
+  return g_string_free_to_bytes (text);
+}
+
+static void
+run_splice (gpointer data,
+            guint64  n_iterations)
+{
+  GBytes *bytes = data;
+  guint64 i;
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      GInputStream *in;
+      GOutputStream *out;
+      GError *error = NULL;
+      gssize spliced;
+
+      in = g_memory_input_stream_new_from_bytes (bytes);
+      out = g_memory_output_stream_new_resizable ();
+
+      spliced = g_output_stream_splice (out, in,
+                                        G_OUTPUT_STREAM_SPLICE_CLOSE_SOURCE |
+                                        G_OUTPUT_STREAM_SPLICE_CLOSE_TARGET,
+                                        NULL, &error);
+      g_assert_no_error (error);
+      g_assert_cmpint (spliced, ==, (gssize) g_bytes_get_size (bytes));
+
+      g_object_unref (in);
+      g_object_unref (out);
+    }
+}
+
+static void
+run_read_line (gpointer data,
+               guint64  n_iterations)
+{
+  GBytes *bytes = data;
+  guint64 i;
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      GInputStream *in;
+      GDataInputStream *data_in;
+      GError *error = NULL;
+      char *line;
+      guint n_lines = 0;
+
+      in = g_memory_input_stream_new_from_bytes (bytes);
+      data_in = g_data_input_stream_new (in);
+
+      while ((line = g_data_input_stream_read_line (data_in, NULL, NULL, &error)) != NULL)
+        {
+          n_lines++;
+          g_free (line);
+        }
+      g_assert_no_error (error);
+      g_assert_cmpuint (n_lines, ==, N_LINES);
+
+      g_object_unref (data_in);
+      g_object_unref (in);
+    }
+}
+
+static void
+test_stream_splice (void)
+{
+  guint8 *data = g_malloc (SPLICE_SIZE);
+  GBytes *bytes;
+
+  memset (data, 'x', SPLICE_SIZE);
+  bytes = g_bytes_new_take (data, SPLICE_SIZE);
+
+  bench_measure ("MB/s", SPLICE_SIZE / 1e6, bench_iterations (200), run_splice, bytes);
+
+  g_bytes_unref (bytes);
+}
+
+static void
+test_stream_read_line (void)
+{
+  GBytes *bytes = make_text ();
+
+  bench_measure ("lines/s", N_LINES, bench_iterations (200), run_read_line, bytes);
+
+  g_bytes_unref (bytes);
+}
+
+void
+bench_add_stream (void)
+{
+  g_test_add_func ("/bench/stream/splice", test_stream_splice);
+  g_test_add_func ("/bench/stream/read-line", test_stream_read_line);
+}
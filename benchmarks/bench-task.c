@@ -0,0 +1,118 @@
+/* GLib benchmarks
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "glib-bench.h"
+
+/* GTask overhead: tasks returning from the main context, and tasks run
+ * in the worker thread pool, each completing through the main context
+ * as asynchronous operations do. */
+
+#define TASKS_PER_BATCH 1000
+
+typedef struct {
+  GMainContext *context;
+  guint n_pending;
+} TaskBench;
+
+static void
+task_done_cb (GObject      *source_object,
+              GAsyncResult *result,
+              gpointer      user_data)
+{
+  TaskBench *bench = user_data;
+  GError *error = NULL;
+
+  g_assert_true (g_task_propagate_boolean (G_TASK (result), &error));
+  g_assert_no_error (error);
+
+  bench->n_pending--;
+}
+
+static void
+task_thread_func (GTask        *task,
+                  gpointer      source_object,
+                  gpointer      task_data,
+                  GCancellable *cancellable)
+{
+  g_task_return_boolean (task, TRUE);
+}
+
+static void
+run_tasks (TaskBench *bench,
+           guint64    n_iterations,
+           gboolean   in_thread)
+{
+  guint64 i;
+  guint j;
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      for (j = 0; j < TASKS_PER_BATCH; j++)
+        {
+          GTask *task = g_task_new (NULL, NULL, task_done_cb, bench);
+
+          bench->n_pending++;
+          if (in_thread)
+            g_task_run_in_thread (task, task_thread_func);
+          else
+            g_task_return_boolean (task, TRUE);
+
+          g_object_unref (task);
+        }
+
+      while (bench->n_pending > 0)
+        g_main_context_iteration (bench->context, TRUE);
+    }
+}
+
+static void
+run_return (gpointer data,
+            guint64  n_iterations)
+{
+  run_tasks (data, n_iterations, FALSE);
+}
+
+static void
+run_in_thread (gpointer data,
+               guint64  n_iterations)
+{
+  run_tasks (data, n_iterations, TRUE);
+}
+
+static void
+test_task (gconstpointer user_data)
+{
+  gboolean in_thread = GPOINTER_TO_INT (user_data);
+  TaskBench bench = { 0, };
+
+  bench.context = g_main_context_new ();
+  g_main_context_push_thread_default (bench.context);
+
+  bench_measure ("tasks/s", TASKS_PER_BATCH, bench_iterations (100),
+                 in_thread ? run_in_thread : run_return, &bench);
+
+  g_main_context_pop_thread_default (bench.context);
+  g_main_context_unref (bench.context);
+}
+
+void
+bench_add_task (void)
+{
+  g_test_add_data_func ("/bench/task/return", GINT_TO_POINTER (FALSE), test_task);
+  g_test_add_data_func ("/bench/task/run-in-thread", GINT_TO_POINTER (TRUE), test_task);
+}
@@ -0,0 +1,199 @@
+/* GLib benchmarks
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "glib-bench.h"
+
+/* Building, serialising and parsing a GVariant shaped like a typical
+ * D-Bus property dictionary: a{sv} with strings, numbers, and an array
+ * of structures. */
+
+#define N_ENTRIES 64
+
+static GVariant *
+build_value (void)
+{
+  GVariantBuilder builder;
+  guint i;
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
+
+  for (i = 0; i < N_ENTRIES; i++)
+    {
+      char key[32];
+
+      g_snprintf (key, sizeof (key), "property-%u", i);
+
+      switch (i % 4)
+        {
+        case 0:
+          g_variant_builder_add (&builder, "{sv}", key,
+                                 g_variant_new_string ("a moderately long string value"));
+          break;
+        case 1:
+          g_variant_builder_add (&builder, "{sv}", key, g_variant_new_uint32 (i));
+          break;
+        case 2:
+          g_variant_builder_add (&builder, "{sv}", key, g_variant_new_double (i / 3.0));
+          break;
+        default:
+          {
+            GVariantBuilder array;
+            guint j;
+
+            g_variant_builder_init (&array, G_VARIANT_TYPE ("a(sub)"));
+            for (j = 0; j < 8; j++)
+              g_variant_builder_add (&array, "(sub)", "item", j, j % 2);
+            g_variant_builder_add (&builder, "{sv}", key, g_variant_builder_end (&array));
+          }
+          break;
+        }
+    }
+
+  return g_variant_ref_sink (g_variant_builder_end (&builder));
+}
+
+static void
+run_build (gpointer data,
+           guint64  n_iterations)
+{
+  guint64 i;
+
+  for (i = 0; i < n_iterations; i++)
+    g_variant_unref (build_value ());
+}
+
+static void
+run_serialise (gpointer data,
+               guint64  n_iterations)
+{
+  guint64 i;
+
+  /* Values built from their children are serialised on first access to
+   * their data, so build fresh ones; see the build benchmark for its
+   * share */
+  for (i = 0; i < n_iterations; i++)
+    {
+      GVariant *value = build_value ();
+
+      g_assert_nonnull (g_variant_get_data (value));
+      g_variant_unref (value);
+    }
+}
+
+static void
+run_parse (gpointer data,
+           guint64  n_iterations)
+{
+  GBytes *bytes = data;
+  guint64 i;
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      GVariant *value, *child;
+      GVariantIter iter;
+      const char *key;
+      gsize n = 0;
+
+      /* Untrusted, like data received from a peer */
+      value = g_variant_new_from_bytes (G_VARIANT_TYPE_VARDICT, bytes, FALSE);
+
+      g_variant_iter_init (&iter, value);
+      while (g_variant_iter_next (&iter, "{&sv}", &key, &child))
+        {
+          if (g_variant_is_of_type (child, G_VARIANT_TYPE_STRING))
+            n += strlen (g_variant_get_string (child, NULL));
+          n++;
+          g_variant_unref (child);
+        }
+      g_assert_cmpuint (n, >, N_ENTRIES);
+
+      g_variant_unref (value);
+    }
+}
+
+static void
+run_parse_text (gpointer data,
+                guint64  n_iterations)
+{
+  const char *text = data;
+  guint64 i;
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      GError *error = NULL;
+      GVariant *value;
+
+      value = g_variant_parse (G_VARIANT_TYPE_VARDICT, text, NULL, NULL, &error);
+      g_assert_no_error (error);
+      g_variant_unref (value);
+    }
+}
+
+static void
+test_variant_build (void)
+{
+  bench_measure ("values/s", 1, bench_iterations (20000), run_build, NULL);
+}
+
+static void
+test_variant_serialise (void)
+{
+  GVariant *value = build_value ();
+  gsize size = g_variant_get_size (value);
+
+  g_variant_unref (value);
+
+  bench_measure ("MB/s", size / 1e6, bench_iterations (20000), run_serialise, NULL);
+}
+
+static void
+test_variant_parse (void)
+{
+  GVariant *value = build_value ();
+  GBytes *bytes = g_variant_get_data_as_bytes (value);
+
+  bench_measure ("MB/s", g_bytes_get_size (bytes) / 1e6, bench_iterations (20000),
+                 run_parse, bytes);
+
+  g_bytes_unref (bytes);
+  g_variant_unref (value);
+}
+
+static void
+test_variant_parse_text (void)
+{
+  GVariant *value = build_value ();
+  char *text = g_variant_print (value, FALSE);
+
+  bench_measure ("MB/s", strlen (text) / 1e6, bench_iterations (2000),
+                 run_parse_text, text);
+
+  g_free (text);
+  g_variant_unref (value);
+}
+
+void
+bench_add_variant (void)
+{
+  g_test_add_func ("/bench/variant/build", test_variant_build);
+  g_test_add_func ("/bench/variant/serialise", test_variant_serialise);
+  g_test_add_func ("/bench/variant/parse", test_variant_parse);
+  g_test_add_func ("/bench/variant/parse-text", test_variant_parse_text);
+}
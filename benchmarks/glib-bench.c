@@ -0,0 +1,104 @@
+/* GLib benchmarks
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Benchmarks of the hot paths of GLib, GObject and GIO.
+ *
+ * Without `-m perf`, every benchmark runs a single iteration, which only
+ * checks that it works. With `-m perf` the results are reported through
+ * performance-report.h, so `--format=json --output=FILE` gives results
+ * which can be compared with a later run with `--baseline=FILE`.
+ */
+
+#include "glib-bench.h"
+
+#include "../gobject/tests/performance/performance-report.h"
+
+guint64
+bench_iterations (guint64 n_perf_iterations)
+{
+  return g_test_perf () ? n_perf_iterations : 1;
+}
+
+/* Runs @func @n_iterations times per repetition and reports the rate in
+ * @unit, each iteration processing @items_per_iteration items */
+void
+bench_measure (const char *unit,
+               double      items_per_iteration,
+               guint64     n_iterations,
+               BenchFunc   func,
+               gpointer    data)
+{
+  double *samples;
+  int i;
+
+  samples = g_new (double, perf_report_repeat);
+
+  for (i = 0; i < perf_report_repeat; i++)
+    {
+      double elapsed;
+
+      g_test_timer_start ();
+      func (data, n_iterations);
+      elapsed = g_test_timer_elapsed ();
+
+      samples[i] = items_per_iteration * n_iterations / MAX (elapsed, 1e-9);
+    }
+
+  perf_report_add (g_test_get_path (), unit, TRUE, samples, perf_report_repeat);
+
+  /* Sorted by perf_report_add() */
+  g_test_maximized_result (samples[perf_report_repeat / 2], "%.1f %s",
+                           samples[perf_report_repeat / 2], unit);
+
+  g_free (samples);
+}
+
+int
+main (int argc, char **argv)
+{
+  GOptionContext *context;
+  GError *error = NULL;
+  int ret;
+
+  g_test_init (&argc, &argv, NULL);
+
+  /* GTest writes TAP to stdout, so use --output for the JSON results */
+  context = g_option_context_new (NULL);
+  g_option_context_add_main_entries (context, perf_report_entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error) ||
+      !perf_report_init (&error))
+    {
+      g_printerr ("%s: %s\n", argv[0], error->message);
+      return 1;
+    }
+  g_option_context_free (context);
+
+  bench_add_main_context ();
+  bench_add_hash_table ();
+  bench_add_variant ();
+  bench_add_dbus ();
+  bench_add_stream ();
+  bench_add_task ();
+  bench_add_file ();
+  bench_add_array ();
+
+  ret = g_test_run ();
+  ret |= perf_report_finish ();
+
+  return ret;
+}
@@ -0,0 +1,46 @@
+/* GLib benchmarks
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <gio/gio.h>
+
+G_BEGIN_DECLS
+
+/* Runs @n_iterations iterations of a benchmark on @data */
+typedef void (* BenchFunc) (gpointer data,
+                            guint64  n_iterations);
+
+guint64 bench_iterations (guint64 n_perf_iterations);
+
+void    bench_measure    (const char *unit,
+                          double      items_per_iteration,
+                          guint64     n_iterations,
+                          BenchFunc   func,
+                          gpointer    data);
+
+void    bench_add_main_context (void);
+void    bench_add_hash_table   (void);
+void    bench_add_variant      (void);
+void    bench_add_dbus         (void);
+void    bench_add_stream       (void);
+void    bench_add_task         (void);
+void    bench_add_file         (void);
+void    bench_add_array        (void);
+
+G_END_DECLS
@@ -7,39 +7,271 @@
  * See https://llvm.org/LICENSE.txt for license information.
  */
 
-/* Simpler gnu89 version of StandaloneFuzzTargetMain.c from LLVM */
+/* Simpler gnu89 version of StandaloneFuzzTargetMain.c from LLVM
+ *
+ * Usage:
+ *   fuzz_target FILE
+ *     runs the target once on FILE
+ *   fuzz_target --bench [--iterations=N] PATH...
+ *     replays every file in PATH (files or directories, recursively) N times
+ *     and reports the throughput of the target
+ */
 
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
+#endif
 
 extern int LLVMFuzzerTestOneInput (const unsigned char *data, size_t size);
 
-int
-main (int argc, char **argv)
+#ifndef __has_feature
+#define __has_feature(x) 0
+#endif
+
+/* Count allocations by wrapping the glibc allocator, unless a sanitizer
+ * already replaces it. */
+#if defined (__GLIBC__) && !defined (__SANITIZE_ADDRESS__) && \
+    !__has_feature (address_sanitizer) && !__has_feature (memory_sanitizer)
+#define COUNT_ALLOCATIONS 1
+
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t n_members, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+extern void __libc_free (void *ptr);
+
+static unsigned long n_allocations;
+
+void *
+malloc (size_t size)
+{
+  __atomic_add_fetch (&n_allocations, 1, __ATOMIC_RELAXED);
+  return __libc_malloc (size);
+}
+
+void *
+calloc (size_t n_members, size_t size)
+{
+  __atomic_add_fetch (&n_allocations, 1, __ATOMIC_RELAXED);
+  return __libc_calloc (n_members, size);
+}
+
+void *
+realloc (void *ptr, size_t size)
+{
+  if (ptr == NULL)
+    __atomic_add_fetch (&n_allocations, 1, __ATOMIC_RELAXED);
+  return __libc_realloc (ptr, size);
+}
+
+void
+free (void *ptr)
+{
+  __libc_free (ptr);
+}
+#endif
+
+typedef struct
+{
+  unsigned char *data;
+  size_t len;
+} Input;
+
+static Input *inputs;
+static size_t n_inputs, inputs_size;
+
+static unsigned char *
+read_file (const char *path,
+           size_t     *len_out)
 {
   FILE *f;
   long tell_result;
   size_t n_read, len;
   unsigned char *buf;
 
-  if (argc < 2)
-    return 1;
-
-  f = fopen (argv[1], "r");
-  assert (f);
+  f = fopen (path, "rb");
+  if (f == NULL)
+    return NULL;
   fseek (f, 0, SEEK_END);
   tell_result = ftell (f);
   assert (tell_result >= 0);
   len = (size_t) tell_result;
   fseek (f, 0, SEEK_SET);
-  buf = (unsigned char*) malloc (len);
+  /* one extra byte so that empty files get a non-NULL buffer too */
+  buf = (unsigned char*) malloc (len + 1);
   n_read = fread (buf, 1, len, f);
   assert (n_read == len);
+  fclose (f);
+
+  *len_out = len;
+  return buf;
+}
+
+static int
+add_input (const char *path)
+{
+  Input input;
+
+#ifndef _WIN32
+  struct stat st;
+
+  if (stat (path, &st) == 0 && S_ISDIR (st.st_mode))
+    {
+      DIR *dir;
+      struct dirent *entry;
+      int ret = 0;
+
+      dir = opendir (path);
+      if (dir == NULL)
+        return -1;
+
+      while (ret == 0 && (entry = readdir (dir)) != NULL)
+        {
+          char *child;
+
+          if (strcmp (entry->d_name, ".") == 0 || strcmp (entry->d_name, "..") == 0)
+            continue;
+
+          child = (char *) malloc (strlen (path) + strlen (entry->d_name) + 2);
+          sprintf (child, "%s/%s", path, entry->d_name);
+          ret = add_input (child);
+          free (child);
+        }
+
+      closedir (dir);
+      return ret;
+    }
+#endif
+
+  input.data = read_file (path, &input.len);
+  if (input.data == NULL)
+    return -1;
+
+  if (n_inputs == inputs_size)
+    {
+      inputs_size = inputs_size ? inputs_size * 2 : 64;
+      inputs = (Input *) realloc (inputs, inputs_size * sizeof (Input));
+    }
+  inputs[n_inputs++] = input;
+
+  return 0;
+}
+
+static double
+get_seconds (void)
+{
+#ifdef _WIN32
+  LARGE_INTEGER counter, frequency;
+
+  QueryPerformanceCounter (&counter);
+  QueryPerformanceFrequency (&frequency);
+  return (double) counter.QuadPart / frequency.QuadPart;
+#else
+  struct timespec ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+#endif
+}
+
+static int
+bench (const char  *name,
+       int          argc,
+       char       **argv)
+{
+  unsigned long iterations = 100, i;
+  size_t j, n_bytes = 0;
+  double start, elapsed;
+#ifdef COUNT_ALLOCATIONS
+  unsigned long allocations_before;
+#endif
+  int arg;
+
+  for (arg = 0; arg < argc; arg++)
+    {
+      if (strncmp (argv[arg], "--iterations=", 13) == 0)
+        iterations = strtoul (argv[arg] + 13, NULL, 10);
+      else if (add_input (argv[arg]) < 0)
+        {
+          fprintf (stderr, "%s: cannot read %s\n", name, argv[arg]);
+          return 1;
+        }
+    }
+
+  if (n_inputs == 0 || iterations == 0)
+    {
+      fprintf (stderr, "%s: nothing to benchmark\n", name);
+      return 1;
+    }
+
+  for (j = 0; j < n_inputs; j++)
+    n_bytes += inputs[j].len;
+
+  /* warm up caches and one-time initialisation */
+  for (j = 0; j < n_inputs; j++)
+    LLVMFuzzerTestOneInput (inputs[j].data, inputs[j].len);
+
+#ifdef COUNT_ALLOCATIONS
+  allocations_before = __atomic_load_n (&n_allocations, __ATOMIC_RELAXED);
+#endif
+  start = get_seconds ();
+
+  for (i = 0; i < iterations; i++)
+    for (j = 0; j < n_inputs; j++)
+      LLVMFuzzerTestOneInput (inputs[j].data, inputs[j].len);
+
+  elapsed = get_seconds () - start;
+  if (elapsed <= 0)
+    elapsed = 1e-9;
+
+  printf ("%s: %lu inputs (%lu bytes) x %lu iterations in %.3f s\n",
+          name, (unsigned long) n_inputs, (unsigned long) n_bytes,
+          iterations, elapsed);
+  printf ("%s: %.0f inputs/s, %.2f MB/s",
+          name, n_inputs * iterations / elapsed,
+          n_bytes * iterations / elapsed / 1e6);
+#ifdef COUNT_ALLOCATIONS
+  printf (", %.1f allocations/input",
+          (double) (__atomic_load_n (&n_allocations, __ATOMIC_RELAXED) - allocations_before) /
+          (n_inputs * iterations));
+#endif
+  printf ("\n");
+
+  for (j = 0; j < n_inputs; j++)
+    free (inputs[j].data);
+  free (inputs);
+
+  return 0;
+}
+
+int
+main (int argc, char **argv)
+{
+  size_t len;
+  unsigned char *buf;
+
+  if (argc < 2)
+    return 1;
+
+  if (strcmp (argv[1], "--bench") == 0)
+    {
+      const char *name = strrchr (argv[0], '/');
+
+      return bench (name ? name + 1 : argv[0], argc - 2, argv + 2);
+    }
+
+  buf = read_file (argv[1], &len);
+  assert (buf);
   LLVMFuzzerTestOneInput (buf, len);
 
   free (buf);
-  fclose (f);
   printf ("Done!\n");
   return 0;
 }
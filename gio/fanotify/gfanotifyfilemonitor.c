@@ -0,0 +1,495 @@
+/* GIO - GLib Input, Output and Streaming Library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gfanotifyfilemonitor.h"
+#include <gio/giomodule.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/fanotify.h>
+#include <sys/statfs.h>
+#include <glib/glib-unix.h>
+
+#include "glib-private.h"
+
+/* A recursive monitor backend built on fanotify filesystem marks, which
+ * report directory entry events for a whole filesystem with a single
+ * mark, as a directory file handle plus a name (Linux 5.9).  Unlike
+ * inotify, the kernel resources needed do not grow with the number of
+ * directories in the monitored tree.
+ *
+ * Filesystem marks need CAP_SYS_ADMIN, and turning the directory file
+ * handles of the events back into paths needs CAP_DAC_READ_SEARCH, so
+ * this is mostly useful to system services.
+ *
+ * There is a single fanotify group per process, read from the GLib
+ * worker thread.  Each filesystem is marked once, when the first monitor
+ * below it starts, and the events are then matched against the paths of
+ * all the monitors on that filesystem.
+ */
+
+#define FANOTIFY_EVENTS (FAN_CREATE | FAN_DELETE | FAN_MOVED_FROM | FAN_MOVED_TO | \
+                         FAN_MODIFY | FAN_ATTRIB | FAN_CLOSE_WRITE | FAN_ONDIR)
+
+/* The order is the one in which merged events are reported */
+static const struct {
+  guint64           mask;
+  GFileMonitorEvent event;
+} fanotify_events[] = {
+  { FAN_CREATE, G_FILE_MONITOR_EVENT_CREATED },
+  { FAN_MOVED_TO, G_FILE_MONITOR_EVENT_MOVED_IN },
+  { FAN_MODIFY, G_FILE_MONITOR_EVENT_CHANGED },
+  { FAN_ATTRIB, G_FILE_MONITOR_EVENT_ATTRIBUTE_CHANGED },
+  { FAN_CLOSE_WRITE, G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT },
+  { FAN_MOVED_FROM, G_FILE_MONITOR_EVENT_MOVED_OUT },
+  { FAN_DELETE, G_FILE_MONITOR_EVENT_DELETED },
+};
+
+typedef struct
+{
+  gint32 fsid[2];
+  int    mount_fd;  /* any directory on the filesystem, for open_by_handle_at() */
+  guint  n_subs;
+} FanotifyMark;
+
+typedef struct
+{
+  gchar              *dirname;
+  gchar              *real_dirname;  /* as resolved by the kernel */
+  GFileMonitorSource *source;
+  FanotifyMark       *mark;
+} FanotifySub;
+
+/* The last directory resolved while reading a batch of events; events
+ * mostly come in runs for the same directory */
+typedef struct
+{
+  guint8  handle[sizeof (struct file_handle) + MAX_HANDLE_SZ];
+  gsize   handle_size;
+  gchar  *path;
+} FanotifyCache;
+
+G_LOCK_DEFINE_STATIC (fanotify_lock);
+
+static int fanotify_fd = -1;
+static GSList *fanotify_subs;
+static GSList *fanotify_marks;
+
+struct _GFanotifyFileMonitor
+{
+  GLocalFileMonitor parent_instance;
+
+  FanotifySub *sub;
+};
+
+G_DEFINE_TYPE_WITH_CODE (GFanotifyFileMonitor, g_fanotify_file_monitor, G_TYPE_LOCAL_FILE_MONITOR,
+                         g_io_extension_point_implement (G_RECURSIVE_FILE_MONITOR_EXTENSION_POINT_NAME,
+                                                         g_define_type_id, "fanotify", 20))
+
+static gchar *
+fanotify_get_fd_path (int fd)
+{
+  gchar proc_path[32];
+
+  g_snprintf (proc_path, sizeof (proc_path), "/proc/self/fd/%d", fd);
+
+  return g_file_read_link (proc_path, NULL);
+}
+
+static FanotifyMark *
+fanotify_find_mark (const gint32 *fsid)
+{
+  GSList *l;
+
+  for (l = fanotify_marks; l; l = l->next)
+    {
+      FanotifyMark *mark = l->data;
+
+      if (memcmp (mark->fsid, fsid, sizeof (mark->fsid)) == 0)
+        return mark;
+    }
+
+  return NULL;
+}
+
+static const gchar *
+fanotify_resolve_directory (FanotifyMark        *mark,
+                            struct file_handle  *handle,
+                            FanotifyCache       *cache)
+{
+  gsize handle_size = sizeof (struct file_handle) + handle->handle_bytes;
+  int fd;
+
+  if (handle_size > sizeof (cache->handle))
+    return NULL;
+
+  if (cache->path != NULL && cache->handle_size == handle_size &&
+      memcmp (cache->handle, handle, handle_size) == 0)
+    return cache->path;
+
+  g_clear_pointer (&cache->path, g_free);
+
+  /* Fails with ESTALE once the directory is gone */
+  fd = open_by_handle_at (mark->mount_fd, handle, O_PATH | O_CLOEXEC);
+  if (fd < 0)
+    return NULL;
+
+  cache->path = fanotify_get_fd_path (fd);
+  close (fd);
+
+  memcpy (cache->handle, handle, handle_size);
+  cache->handle_size = handle_size;
+
+  return cache->path;
+}
+
+static void
+fanotify_dispatch (FanotifyMark *mark,
+                   const gchar  *path,
+                   guint64       mask,
+                   gint64        now)
+{
+  GSList *l;
+
+  for (l = fanotify_subs; l; l = l->next)
+    {
+      FanotifySub *sub = l->data;
+      gsize len = strlen (sub->real_dirname);
+      const gchar *child;
+      gsize i;
+
+      if (sub->mark != mark || strncmp (path, sub->real_dirname, len) != 0)
+        continue;
+
+      /* The monitored directory itself, or something below it */
+      if (path[len] == '\0')
+        child = NULL;
+      else if (path[len] == G_DIR_SEPARATOR)
+        child = path + len + 1;
+      else if (len == 1)
+        child = path + len;
+      else
+        continue;
+
+      for (i = 0; i < G_N_ELEMENTS (fanotify_events); i++)
+        if (mask & fanotify_events[i].mask)
+          g_file_monitor_source_handle_event (sub->source, fanotify_events[i].event,
+                                              child, NULL, NULL, now);
+    }
+}
+
+static void
+fanotify_handle_event (const struct fanotify_event_metadata *metadata,
+                       FanotifyCache                        *cache,
+                       gint64                                now)
+{
+  const struct fanotify_event_info_fid *fid;
+  struct file_handle *handle;
+  FanotifyMark *mark;
+  const gchar *dirname;
+  const gchar *name;
+  gchar *path;
+
+  if (metadata->vers != FANOTIFY_METADATA_VERSION)
+    return;
+
+  /* Nothing tells which files changed */
+  if (metadata->mask & FAN_Q_OVERFLOW)
+    {
+      g_debug ("fanotify event queue overflowed");
+      return;
+    }
+
+  if (metadata->event_len < metadata->metadata_len + sizeof (*fid) + sizeof (*handle))
+    return;
+
+  fid = (gconstpointer) ((const guint8 *) metadata + metadata->metadata_len);
+  handle = (struct file_handle *) fid->handle;
+
+  /* Events on a directory itself may come without a name */
+  if (fid->hdr.info_type == FAN_EVENT_INFO_TYPE_DFID_NAME)
+    name = (const gchar *) handle->f_handle + handle->handle_bytes;
+  else if (fid->hdr.info_type == FAN_EVENT_INFO_TYPE_DFID)
+    name = ".";
+  else
+    return;
+
+  /* The last monitor on this filesystem may have gone away meanwhile */
+  mark = fanotify_find_mark ((const gint32 *) &fid->fsid);
+  if (mark == NULL)
+    return;
+
+  dirname = fanotify_resolve_directory (mark, handle, cache);
+  if (dirname == NULL)
+    return;
+
+  if (g_str_equal (name, "."))
+    path = g_strdup (dirname);
+  else
+    path = g_build_filename (dirname, name, NULL);
+
+  fanotify_dispatch (mark, path, metadata->mask, now);
+
+  g_free (path);
+}
+
+static gboolean
+fanotify_read_cb (gint         fd,
+                  GIOCondition condition,
+                  gpointer     user_data)
+{
+  guint64 buffer[4096];
+  FanotifyCache cache = { { 0, }, 0, NULL };
+  gint64 now;
+  ssize_t len;
+
+  now = g_get_monotonic_time ();
+
+  G_LOCK (fanotify_lock);
+
+  while ((len = read (fd, buffer, sizeof (buffer))) > 0)
+    {
+      const struct fanotify_event_metadata *metadata = (gconstpointer) buffer;
+
+      for (; FAN_EVENT_OK (metadata, len); metadata = FAN_EVENT_NEXT (metadata, len))
+        fanotify_handle_event (metadata, &cache, now);
+    }
+
+  G_UNLOCK (fanotify_lock);
+
+  g_free (cache.path);
+
+  return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+fanotify_startup (void)
+{
+  static gsize initialised;
+  static gboolean supported;
+
+  if (g_once_init_enter (&initialised))
+    {
+      int fd;
+
+      fd = fanotify_init (FAN_CLASS_NOTIF | FAN_REPORT_DFID_NAME | FAN_CLOEXEC | FAN_NONBLOCK,
+                          O_RDONLY | O_CLOEXEC);
+
+      /* Unprivileged groups can only use inode marks, which are not
+       * recursive; find out now rather than when starting each monitor */
+      if (fd >= 0 &&
+          fanotify_mark (fd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, FAN_CREATE | FAN_ONDIR,
+                         AT_FDCWD, "/") != 0)
+        {
+          close (fd);
+          fd = -1;
+        }
+
+      if (fd >= 0)
+        {
+          GSource *source;
+
+          fanotify_mark (fd, FAN_MARK_REMOVE | FAN_MARK_FILESYSTEM, FAN_CREATE | FAN_ONDIR,
+                         AT_FDCWD, "/");
+
+          fanotify_fd = fd;
+          source = g_unix_fd_source_new (fd, G_IO_IN);
+          g_source_set_callback (source, (GSourceFunc) fanotify_read_cb, NULL, NULL);
+          g_source_set_static_name (source, "fanotify reader");
+          g_source_attach (source, GLIB_PRIVATE_CALL (g_get_worker_context) ());
+          g_source_unref (source);
+
+          supported = TRUE;
+        }
+
+      g_once_init_leave (&initialised, 1);
+    }
+
+  return supported;
+}
+
+static void
+fanotify_sub_add (FanotifySub *sub)
+{
+  struct statfs buf;
+  FanotifyMark *mark;
+  gint32 fsid[2];
+  int fd;
+
+  /* There is nothing to mark if the directory does not exist (yet) */
+  fd = open (sub->dirname, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0)
+    return;
+
+  if (fstatfs (fd, &buf) != 0)
+    {
+      close (fd);
+      return;
+    }
+
+  /* Paths in events are resolved by the kernel, so symbolic links in the
+   * name we were given have to be resolved the same way */
+  sub->real_dirname = fanotify_get_fd_path (fd);
+  if (sub->real_dirname == NULL)
+    {
+      close (fd);
+      return;
+    }
+
+  memcpy (fsid, &buf.f_fsid, sizeof (fsid));
+
+  G_LOCK (fanotify_lock);
+
+  mark = fanotify_find_mark (fsid);
+  if (mark == NULL)
+    {
+      if (fanotify_mark (fanotify_fd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM,
+                         FANOTIFY_EVENTS, fd, NULL) != 0)
+        {
+          int errsv = errno;
+
+          g_warning ("Unable to watch %s with fanotify: %s",
+                     sub->dirname, g_strerror (errsv));
+          G_UNLOCK (fanotify_lock);
+          close (fd);
+          return;
+        }
+
+      mark = g_new0 (FanotifyMark, 1);
+      memcpy (mark->fsid, fsid, sizeof (mark->fsid));
+      mark->mount_fd = g_steal_fd (&fd);
+      fanotify_marks = g_slist_prepend (fanotify_marks, mark);
+    }
+
+  mark->n_subs++;
+  sub->mark = mark;
+  fanotify_subs = g_slist_prepend (fanotify_subs, sub);
+
+  G_UNLOCK (fanotify_lock);
+
+  if (fd >= 0)
+    close (fd);
+}
+
+static void
+fanotify_sub_cancel (FanotifySub *sub)
+{
+  G_LOCK (fanotify_lock);
+
+  if (sub->mark != NULL)
+    {
+      FanotifyMark *mark = sub->mark;
+
+      fanotify_subs = g_slist_remove (fanotify_subs, sub);
+      sub->mark = NULL;
+
+      if (--mark->n_subs == 0)
+        {
+          fanotify_mark (fanotify_fd, FAN_MARK_REMOVE | FAN_MARK_FILESYSTEM,
+                         FANOTIFY_EVENTS, mark->mount_fd, NULL);
+          close (mark->mount_fd);
+          fanotify_marks = g_slist_remove (fanotify_marks, mark);
+          g_free (mark);
+        }
+    }
+
+  G_UNLOCK (fanotify_lock);
+}
+
+static gboolean
+g_fanotify_file_monitor_is_supported (void)
+{
+  return fanotify_startup ();
+}
+
+static void
+g_fanotify_file_monitor_start (GLocalFileMonitor  *local_monitor,
+                               const gchar        *dirname,
+                               const gchar        *basename,
+                               const gchar        *filename,
+                               GFileMonitorSource *source)
+{
+  GFanotifyFileMonitor *fanotify_monitor = G_FANOTIFY_FILE_MONITOR (local_monitor);
+  gboolean success G_GNUC_UNUSED  /* when compiling with G_DISABLE_ASSERT */;
+
+  /* should already have been called, from is_supported() */
+  success = fanotify_startup ();
+  g_assert (success);
+
+  /* only ever used for recursive directory monitors */
+  g_assert (dirname != NULL && basename == NULL);
+
+  fanotify_monitor->sub = g_new0 (FanotifySub, 1);
+  fanotify_monitor->sub->dirname = g_strdup (dirname);
+  fanotify_monitor->sub->source = source;
+  fanotify_sub_add (fanotify_monitor->sub);
+}
+
+static gboolean
+g_fanotify_file_monitor_cancel (GFileMonitor *monitor)
+{
+  GFanotifyFileMonitor *fanotify_monitor = G_FANOTIFY_FILE_MONITOR (monitor);
+
+  if (fanotify_monitor->sub)
+    {
+      fanotify_sub_cancel (fanotify_monitor->sub);
+      g_free (fanotify_monitor->sub->dirname);
+      g_free (fanotify_monitor->sub->real_dirname);
+      g_free (fanotify_monitor->sub);
+      fanotify_monitor->sub = NULL;
+    }
+
+  return TRUE;
+}
+
+static void
+g_fanotify_file_monitor_finalize (GObject *object)
+{
+#ifndef G_DISABLE_ASSERT
+  GFanotifyFileMonitor *fanotify_monitor = G_FANOTIFY_FILE_MONITOR (object);
+#endif
+
+  /* must surely have been cancelled already */
+  g_assert (!fanotify_monitor->sub);
+
+  G_OBJECT_CLASS (g_fanotify_file_monitor_parent_class)->finalize (object);
+}
+
+static void
+g_fanotify_file_monitor_init (GFanotifyFileMonitor *monitor)
+{
+}
+
+static void
+g_fanotify_file_monitor_class_init (GFanotifyFileMonitorClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GFileMonitorClass *file_monitor_class = G_FILE_MONITOR_CLASS (klass);
+  GLocalFileMonitorClass *local_file_monitor_class = G_LOCAL_FILE_MONITOR_CLASS (klass);
+
+  local_file_monitor_class->is_supported = g_fanotify_file_monitor_is_supported;
+  local_file_monitor_class->start = g_fanotify_file_monitor_start;
+  local_file_monitor_class->mount_notify = FALSE;
+  file_monitor_class->cancel = g_fanotify_file_monitor_cancel;
+
+  gobject_class->finalize = g_fanotify_file_monitor_finalize;
+}
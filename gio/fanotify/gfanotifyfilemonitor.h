@@ -0,0 +1,46 @@
+/* GIO - GLib Input, Output and Streaming Library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __G_FANOTIFY_FILE_MONITOR_H__
+#define __G_FANOTIFY_FILE_MONITOR_H__
+
+#include <glib-object.h>
+#include <gio/gfilemonitor.h>
+#include <gio/glocalfilemonitor.h>
+#include <gio/giomodule.h>
+
+G_BEGIN_DECLS
+
+#define G_TYPE_FANOTIFY_FILE_MONITOR		(g_fanotify_file_monitor_get_type ())
+#define G_FANOTIFY_FILE_MONITOR(o)		(G_TYPE_CHECK_INSTANCE_CAST ((o), G_TYPE_FANOTIFY_FILE_MONITOR, GFanotifyFileMonitor))
+#define G_FANOTIFY_FILE_MONITOR_CLASS(k)	(G_TYPE_CHECK_CLASS_CAST ((k), G_TYPE_FANOTIFY_FILE_MONITOR, GFanotifyFileMonitorClass))
+#define G_IS_FANOTIFY_FILE_MONITOR(o)		(G_TYPE_CHECK_INSTANCE_TYPE ((o), G_TYPE_FANOTIFY_FILE_MONITOR))
+#define G_IS_FANOTIFY_FILE_MONITOR_CLASS(k)	(G_TYPE_CHECK_CLASS_TYPE ((k), G_TYPE_FANOTIFY_FILE_MONITOR))
+
+typedef struct _GFanotifyFileMonitor      GFanotifyFileMonitor;
+typedef struct _GFanotifyFileMonitorClass GFanotifyFileMonitorClass;
+
+struct _GFanotifyFileMonitorClass {
+  GLocalFileMonitorClass parent_class;
+};
+
+GType g_fanotify_file_monitor_get_type (void);
+
+G_END_DECLS
+
+#endif /* __G_FANOTIFY_FILE_MONITOR_H__ */
@@ -28,6 +28,7 @@
 #include "gremoteactiongroup.h"
 #include "gdbusintrospection.h"
 #include "gdbusconnection.h"
+#include "gdbusprivate.h"
 #include "gactiongroup.h"
 #include "gdbuserror.h"
 
@@ -127,6 +128,12 @@ typedef struct
   gchar           *object_path;
   GHashTable      *pending_changes;
   GSource         *pending_source;
+  guint            flush_interval;
+
+  /* The last state sent in a Changed signal for each action whose state
+   * changed, so that changes which end up back where they started, or
+   * that repeat the same value, are not sent again */
+  GHashTable      *sent_states;
 } GActionGroupExporter;
 
 #define ACTION_ADDED_EVENT             (1u<<0)
@@ -143,6 +150,7 @@ g_action_group_exporter_dispatch_events (gpointer user_data)
   GVariantBuilder state_changes;
   GVariantBuilder adds;
   GHashTableIter iter;
+  gboolean have_changes = FALSE;
   gpointer value;
   gpointer key;
 
@@ -164,7 +172,10 @@ g_action_group_exporter_dispatch_events (gpointer user_data)
                 ((events & (ACTION_REMOVED_EVENT | ACTION_ADDED_EVENT)) == 0));
 
       if (events & ACTION_REMOVED_EVENT)
-        g_variant_builder_add (&removes, "s", name);
+        {
+          g_variant_builder_add (&removes, "s", name);
+          have_changes = TRUE;
+        }
 
       if (events & ACTION_ENABLED_CHANGED_EVENT)
         {
@@ -172,15 +183,27 @@ g_action_group_exporter_dispatch_events (gpointer user_data)
 
           enabled = g_action_group_get_action_enabled (exporter->action_group, name);
           g_variant_builder_add (&enabled_changes, "{sb}", name, enabled);
+          have_changes = TRUE;
         }
 
       if (events & ACTION_STATE_CHANGED_EVENT)
         {
           GVariant *state;
+          GVariant *sent;
 
+          /* However many times the state changed since the last signal,
+           * only its current value is sent, and only if it differs */
           state = g_action_group_get_action_state (exporter->action_group, name);
-          g_variant_builder_add (&state_changes, "{sv}", name, state);
-          g_variant_unref (state);
+          sent = g_hash_table_lookup (exporter->sent_states, name);
+
+          if (state != NULL && (sent == NULL || !g_variant_equal (state, sent)))
+            {
+              g_variant_builder_add (&state_changes, "{sv}", name, state);
+              g_hash_table_insert (exporter->sent_states, g_strdup (name), g_steal_pointer (&state));
+              have_changes = TRUE;
+            }
+
+          g_clear_pointer (&state, g_variant_unref);
         }
 
       if (events & ACTION_ADDED_EVENT)
@@ -189,17 +212,29 @@ g_action_group_exporter_dispatch_events (gpointer user_data)
 
           description = g_action_group_describe_action (exporter->action_group, name);
           g_variant_builder_add (&adds, "{s@(bgav)}", name, description);
+          have_changes = TRUE;
         }
+
+      if (events & (ACTION_ADDED_EVENT | ACTION_REMOVED_EVENT))
+        g_hash_table_remove (exporter->sent_states, name);
     }
 
   g_hash_table_remove_all (exporter->pending_changes);
 
-  g_dbus_connection_emit_signal (exporter->connection, NULL, exporter->object_path,
-                                 "org.gtk.Actions", "Changed",
-                                 g_variant_new ("(asa{sb}a{sv}a{s(bgav)})",
-                                                &removes, &enabled_changes,
-                                                &state_changes, &adds),
-                                 NULL);
+  if (have_changes)
+    g_dbus_connection_emit_signal (exporter->connection, NULL, exporter->object_path,
+                                   "org.gtk.Actions", "Changed",
+                                   g_variant_new ("(asa{sb}a{sv}a{s(bgav)})",
+                                                  &removes, &enabled_changes,
+                                                  &state_changes, &adds),
+                                   NULL);
+  else
+    {
+      g_variant_builder_clear (&removes);
+      g_variant_builder_clear (&enabled_changes);
+      g_variant_builder_clear (&state_changes);
+      g_variant_builder_clear (&adds);
+    }
 
   exporter->pending_source = NULL;
 
@@ -244,7 +279,12 @@ g_action_group_exporter_set_events (GActionGroupExporter *exporter,
     {
       GSource *source;
 
-      source = g_idle_source_new ();
+      /* Changes are gathered until the source fires, so each action is
+       * reported at most once per flush interval */
+      if (exporter->flush_interval > 0)
+        source = g_timeout_source_new (exporter->flush_interval);
+      else
+        source = g_idle_source_new ();
       exporter->pending_source = source;
       g_source_set_callback (source, g_action_group_exporter_dispatch_events, exporter, NULL);
       g_source_set_static_name (source, "[gio] g_action_group_exporter_dispatch_events");
@@ -543,6 +583,7 @@ g_action_group_exporter_free (GActionGroupExporter *exporter)
                                         g_action_group_exporter_action_removed, exporter);
 
   g_hash_table_unref (exporter->pending_changes);
+  g_hash_table_unref (exporter->sent_states);
   if (exporter->pending_source)
     g_source_destroy (exporter->pending_source);
 
@@ -583,6 +624,12 @@ g_action_group_exporter_free (GActionGroupExporter *exporter)
  * limits a given action group to being exported from only one main
  * context.
  *
+ * Changes to the action group are sent to clients in batches, with the
+ * current state of each changed action, either once the main context is
+ * idle or, if the `GDBUS_EXPORT_FLUSH_INTERVAL` environment variable is
+ * set to a number of milliseconds, after that interval has passed since
+ * the first pending change.
+ *
  * Returns: the ID of the export (never zero), or 0 in case of failure
  *
  * Since: 2.32
@@ -617,6 +664,8 @@ g_dbus_connection_export_action_group (GDBusConnection  *connection,
   exporter->context = g_main_context_ref_thread_default ();
   exporter->pending_changes = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
   exporter->pending_source = NULL;
+  exporter->flush_interval = _g_dbus_get_export_flush_interval ();
+  exporter->sent_states = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_variant_unref);
   exporter->action_group = g_object_ref (action_group);
   exporter->connection = g_object_ref (connection);
   exporter->object_path = g_strdup (object_path);
@@ -2230,7 +2230,9 @@ g_application_get_is_remote (GApplication *application)
  *
  * If #GApplication is not using D-Bus then this function will return
  * %NULL.  This includes the situation where the D-Bus backend would
- * normally be in use but we were unable to connect to the bus.
+ * normally be in use but we were unable to connect to the bus, and the
+ * time before the connection is made if
+ * %G_APPLICATION_DEFER_DBUS_REGISTRATION is in use.
  *
  * This function must not be called before the application has been
  * registered.  See g_application_get_is_registered().
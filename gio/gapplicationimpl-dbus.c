@@ -34,6 +34,7 @@
 #include "gdbuserror.h"
 #include "gdbusprivate.h"
 #include "glib/gstdio.h"
+#include "gtrace-private.h"
 
 #include <string.h>
 #include <stdio.h>
@@ -115,6 +116,7 @@ struct _GApplicationImpl
   GActionGroup    *exported_actions;
   const gchar     *bus_name;
   guint            name_lost_signal;
+  GCancellable    *bus_cancellable;
 
   gchar           *object_path;
   guint            object_id;
@@ -396,6 +398,45 @@ name_lost (GDBusConnection *bus,
   g_signal_emit_by_name (impl->app, "name-lost", &handled);
 }
 
+typedef struct
+{
+  GVariant *request_name_reply;
+  GError   *request_name_error;
+  GVariant *describe_reply;
+  GError   *describe_error;
+  gboolean  describe_pending;
+} AttemptPrimaryData;
+
+static void
+attempt_primary_request_name_done (GObject      *source,
+                                   GAsyncResult *result,
+                                   gpointer      user_data)
+{
+  AttemptPrimaryData *data = user_data;
+
+  data->request_name_reply = g_dbus_connection_call_finish (G_DBUS_CONNECTION (source), result,
+                                                            &data->request_name_error);
+}
+
+static void
+attempt_primary_describe_done (GObject      *source,
+                               GAsyncResult *result,
+                               gpointer      user_data)
+{
+  AttemptPrimaryData *data = user_data;
+
+  data->describe_reply = g_dbus_connection_call_finish (G_DBUS_CONNECTION (source), result,
+                                                        &data->describe_error);
+  data->describe_pending = FALSE;
+}
+
+static void
+attempt_primary_cancelled (GCancellable *cancellable,
+                           gpointer      user_data)
+{
+  g_cancellable_cancel (user_data);
+}
+
 /* Attempt to become the primary instance.
  *
  * Returns %TRUE if everything went OK, regardless of if we became the
@@ -404,11 +445,18 @@ name_lost (GDBusConnection *bus,
  *
  * After a %TRUE return, impl->primary will be TRUE if we were
  * successful.
+ *
+ * If @remote_actions is non-%NULL and we end up not being the primary
+ * instance, it may be set to a #GDBusActionGroup for the primary
+ * instance that has already been synced.  The DescribeAll call for it
+ * is sent right behind RequestName so that a remote instance does not
+ * have to wait for another round-trip.
  */
 static gboolean
-g_application_impl_attempt_primary (GApplicationImpl  *impl,
-                                    GCancellable      *cancellable,
-                                    GError           **error)
+g_application_impl_attempt_primary (GApplicationImpl   *impl,
+                                    GCancellable       *cancellable,
+                                    GDBusActionGroup  **remote_actions,
+                                    GError            **error)
 {
   static const GDBusInterfaceVTable vtable = {
     g_application_impl_method_call,
@@ -419,9 +467,15 @@ g_application_impl_attempt_primary (GApplicationImpl  *impl,
   GApplicationClass *app_class = G_APPLICATION_GET_CLASS (impl->app);
   GBusNameOwnerFlags name_owner_flags;
   GApplicationFlags app_flags;
-  GVariant *reply;
+  AttemptPrimaryData data = { NULL, };
+  GDBusActionGroup *actions = NULL;
+  GCancellable *describe_cancellable = NULL;
+  gulong cancelled_id = 0;
+  GMainContext *context;
+  gboolean name_requested;
   guint32 rval;
   GError *local_error = NULL;
+  gint64 begin_time_nsec G_GNUC_UNUSED;
 
   if (org_gtk_Application == NULL)
     {
@@ -458,7 +512,11 @@ g_application_impl_attempt_primary (GApplicationImpl  *impl,
    * hit the mainloop in this thread.  There is also no danger of
    * receiving 'activate' or 'open' signals until after 'startup' runs,
    * for the same reason.
+   *
+   * None of this involves a round-trip to the bus.
    */
+  begin_time_nsec = G_TRACE_CURRENT_TIME;
+
   impl->object_id = g_dbus_connection_register_object (impl->session_bus, impl->object_path,
                                                        org_gtk_Application, &vtable, impl, NULL, error);
 
@@ -477,6 +535,12 @@ g_application_impl_attempt_primary (GApplicationImpl  *impl,
   if (impl->actions_id == 0)
     return FALSE;
 
+  g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                "GIO", "GApplication export objects",
+                "%s", impl->object_path);
+
+  begin_time_nsec = G_TRACE_CURRENT_TIME;
+
   impl->registered = TRUE;
   if (!app_class->dbus_register (impl->app,
                                  impl->session_bus,
@@ -490,6 +554,10 @@ g_application_impl_attempt_primary (GApplicationImpl  *impl,
 
   g_return_val_if_fail (local_error == NULL, FALSE);
 
+  g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                "GIO", "GApplication dbus_register",
+                "%s", impl->object_path);
+
   if (impl->bus_name == NULL)
     {
       /* If this is a non-unique application then it is sufficient to
@@ -526,22 +594,107 @@ g_application_impl_attempt_primary (GApplicationImpl  *impl,
   if (app_flags & G_APPLICATION_REPLACE)
     name_owner_flags |= G_BUS_NAME_OWNER_FLAGS_REPLACE;
 
-  reply = g_dbus_connection_call_sync (impl->session_bus,
-                                       DBUS_SERVICE_DBUS,
-                                       DBUS_PATH_DBUS,
-                                       DBUS_INTERFACE_DBUS,
-                                       "RequestName",
-                                       g_variant_new ("(su)", impl->bus_name, name_owner_flags),
-                                       G_VARIANT_TYPE ("(u)"),
-                                       0, -1, cancellable, error);
+  begin_time_nsec = G_TRACE_CURRENT_TIME;
 
-  if (reply == NULL)
-    return FALSE;
+  /* Use a private main context for the replies so that nothing else
+   * gets dispatched while we wait for them, the same way
+   * g_dbus_connection_call_sync() does.
+   *
+   * The signal subscription for the remote action group has to be set
+   * up before that though, or its change notifications would end up
+   * in the private context.
+   */
+  if (remote_actions != NULL && (~app_flags & G_APPLICATION_REPLACE))
+    {
+      actions = g_dbus_action_group_get (impl->session_bus, impl->bus_name, impl->object_path);
+      g_dbus_action_group_subscribe (actions);
+
+      describe_cancellable = g_cancellable_new ();
+      if (cancellable != NULL)
+        cancelled_id = g_cancellable_connect (cancellable, G_CALLBACK (attempt_primary_cancelled),
+                                              describe_cancellable, NULL);
+    }
+
+  context = g_main_context_new ();
+  g_main_context_push_thread_default (context);
+
+  g_dbus_connection_call (impl->session_bus,
+                          DBUS_SERVICE_DBUS,
+                          DBUS_PATH_DBUS,
+                          DBUS_INTERFACE_DBUS,
+                          "RequestName",
+                          g_variant_new ("(su)", impl->bus_name, name_owner_flags),
+                          G_VARIANT_TYPE ("(u)"),
+                          G_DBUS_CALL_FLAGS_NONE, -1, cancellable,
+                          attempt_primary_request_name_done, &data);
+
+  /* The bus handles our messages in order, so by the time it routes
+   * this call the name is owned by either us or the existing primary
+   * instance.  If it is us, we just drop the reply.  Don't let it
+   * activate anything in the meantime: if the primary instance goes
+   * away in between we fall back to a regular sync below.
+   */
+  if (actions != NULL)
+    {
+      data.describe_pending = TRUE;
+      g_dbus_connection_call (impl->session_bus,
+                              impl->bus_name,
+                              impl->object_path,
+                              "org.gtk.Actions",
+                              "DescribeAll",
+                              NULL,
+                              G_VARIANT_TYPE ("(a{s(bgav)})"),
+                              G_DBUS_CALL_FLAGS_NO_AUTO_START, -1, describe_cancellable,
+                              attempt_primary_describe_done, &data);
+    }
+
+  while (data.request_name_reply == NULL && data.request_name_error == NULL)
+    g_main_context_iteration (context, TRUE);
+
+  name_requested = (data.request_name_reply != NULL);
+  if (name_requested)
+    {
+      g_variant_get (data.request_name_reply, "(u)", &rval);
+      g_variant_unref (data.request_name_reply);
+
+      impl->primary = (rval != DBUS_REQUEST_NAME_REPLY_EXISTS);
+    }
+
+  g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                "GIO", "GApplication RequestName",
+                "%s: %s", impl->bus_name,
+                !name_requested ? "failed" : impl->primary ? "primary" : "remote");
+
+  if (actions != NULL)
+    {
+      if (!name_requested || impl->primary)
+        g_cancellable_cancel (describe_cancellable);
+
+      while (data.describe_pending)
+        g_main_context_iteration (context, TRUE);
+
+      g_cancellable_disconnect (cancellable, cancelled_id);
+      g_object_unref (describe_cancellable);
 
-  g_variant_get (reply, "(u)", &rval);
-  g_variant_unref (reply);
+      if (data.describe_reply != NULL && name_requested && !impl->primary)
+        {
+          g_dbus_action_group_sync_from_reply (actions, data.describe_reply);
+          *remote_actions = g_steal_pointer (&actions);
+        }
 
-  impl->primary = (rval != DBUS_REQUEST_NAME_REPLY_EXISTS);
+      g_clear_pointer (&data.describe_reply, g_variant_unref);
+      g_clear_error (&data.describe_error);
+      g_clear_object (&actions);
+    }
+
+  g_main_context_pop_thread_default (context);
+  g_main_context_unref (context);
+
+  if (!name_requested)
+    {
+      g_propagate_error (error, data.request_name_error);
+      return FALSE;
+    }
 
   if (!impl->primary && impl->name_lost_signal)
     {
@@ -614,13 +767,22 @@ g_application_impl_set_busy_state (GApplicationImpl *impl,
   if (impl->busy != busy)
     {
       impl->busy = busy;
-      send_property_change (impl);
+
+      /* With deferred registration, the object may not be exported yet */
+      if (impl->registered)
+        send_property_change (impl);
     }
 }
 
 void
 g_application_impl_destroy (GApplicationImpl *impl)
 {
+  if (impl->bus_cancellable)
+    {
+      g_cancellable_cancel (impl->bus_cancellable);
+      g_object_unref (impl->bus_cancellable);
+    }
+
   g_application_impl_stop_primary (impl);
 
   if (impl->session_bus)
@@ -631,6 +793,44 @@ g_application_impl_destroy (GApplicationImpl *impl)
   g_slice_free (GApplicationImpl, impl);
 }
 
+static void
+g_application_impl_deferred_bus_got (GObject      *source,
+                                     GAsyncResult *result,
+                                     gpointer      user_data)
+{
+  GApplicationImpl *impl = user_data;
+  GDBusConnection *session_bus;
+  GError *error = NULL;
+
+  /* g_application_impl_destroy() cancels us, in which case @impl is
+   * already gone.
+   */
+  session_bus = g_bus_get_finish (result, &error);
+  if (session_bus == NULL)
+    {
+      if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        g_clear_object (&impl->bus_cancellable);
+      g_error_free (error);
+      return;
+    }
+
+  g_clear_object (&impl->bus_cancellable);
+
+  impl->session_bus = session_bus;
+  impl->object_path = application_path_from_appid (g_application_get_application_id (impl->app));
+
+  if (!g_application_impl_attempt_primary (impl, NULL, NULL, &error))
+    {
+      g_warning ("Failed to register D-Bus objects for application: %s", error->message);
+      g_error_free (error);
+      g_application_impl_stop_primary (impl);
+      return;
+    }
+
+  if (impl->busy)
+    send_property_change (impl);
+}
+
 GApplicationImpl *
 g_application_impl_register (GApplication        *application,
                              const gchar         *appid,
@@ -640,8 +840,9 @@ g_application_impl_register (GApplication        *application,
                              GCancellable        *cancellable,
                              GError             **error)
 {
-  GDBusActionGroup *actions;
+  GDBusActionGroup *actions = NULL;
   GApplicationImpl *impl;
+  gint64 begin_time_nsec G_GNUC_UNUSED;
 
   g_assert ((flags & G_APPLICATION_NON_UNIQUE) || appid != NULL);
 
@@ -654,8 +855,29 @@ g_application_impl_register (GApplication        *application,
   if (~flags & G_APPLICATION_NON_UNIQUE)
     impl->bus_name = appid;
 
+  /* Nothing about a non-unique application needs the bus before
+   * startup, so connect in the background if asked to.  The objects get
+   * exported once the connection is up.
+   */
+  if ((flags & G_APPLICATION_NON_UNIQUE) && (~flags & G_APPLICATION_IS_LAUNCHER) &&
+      (flags & G_APPLICATION_DEFER_DBUS_REGISTRATION))
+    {
+      impl->bus_cancellable = g_cancellable_new ();
+      g_bus_get (G_BUS_TYPE_SESSION, impl->bus_cancellable,
+                 g_application_impl_deferred_bus_got, impl);
+
+      *remote_actions = NULL;
+      return impl;
+    }
+
+  begin_time_nsec = G_TRACE_CURRENT_TIME;
+
   impl->session_bus = g_bus_get_sync (G_BUS_TYPE_SESSION, cancellable, NULL);
 
+  g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                "GIO", "GApplication bus connect",
+                "%s", impl->session_bus != NULL ? "connected" : "failed");
+
   if (impl->session_bus == NULL)
     {
       /* If we can't connect to the session bus, proceed as a normal
@@ -672,7 +894,9 @@ g_application_impl_register (GApplication        *application,
    */
   if (~flags & G_APPLICATION_IS_LAUNCHER)
     {
-      if (!g_application_impl_attempt_primary (impl, cancellable, error))
+      if (!g_application_impl_attempt_primary (impl, cancellable,
+                                               (flags & G_APPLICATION_IS_SERVICE) ? NULL : &actions,
+                                               error))
         {
           g_application_impl_destroy (impl);
           return NULL;
@@ -694,18 +918,28 @@ g_application_impl_register (GApplication        *application,
         }
     }
 
-  /* We are non-primary.  Try to get the primary's list of actions.
+  /* We are non-primary.  Try to get the primary's list of actions,
+   * unless that was already done together with the name request.
    * This also serves as a mechanism to ensure that the primary exists
    * (ie: D-Bus service files installed correctly, etc).
    */
-  actions = g_dbus_action_group_get (impl->session_bus, impl->bus_name, impl->object_path);
-  if (!g_dbus_action_group_sync (actions, cancellable, error))
+  if (actions == NULL)
     {
-      /* The primary appears not to exist.  Fail the registration. */
-      g_application_impl_destroy (impl);
-      g_object_unref (actions);
+      begin_time_nsec = G_TRACE_CURRENT_TIME;
+
+      actions = g_dbus_action_group_get (impl->session_bus, impl->bus_name, impl->object_path);
+      if (!g_dbus_action_group_sync (actions, cancellable, error))
+        {
+          /* The primary appears not to exist.  Fail the registration. */
+          g_application_impl_destroy (impl);
+          g_object_unref (actions);
+
+          return NULL;
+        }
 
-      return NULL;
+      g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                    "GIO", "GApplication sync remote actions",
+                    "%s", impl->bus_name);
     }
 
   *remote_actions = G_REMOTE_ACTION_GROUP (actions);
@@ -29,6 +29,7 @@
 #include "gtask.h"
 #include "gseekable.h"
 #include "gioerror.h"
+#include "gioprivate.h"
 #include <string.h>
 #include "glibintl.h"
 
@@ -54,11 +55,20 @@
 
 #define DEFAULT_BUFFER_SIZE 4096
 
+/* Reads smaller than this are copied out of the buffer rather than handed
+ * out as a slice of it, so that tiny reads do not pin the whole buffer */
+#define MIN_SLICE_SIZE 1024
+
 struct _GBufferedInputStreamPrivate {
   guint8 *buffer;
   gsize   len;
   gsize   pos;
   gsize   end;
+  /* Owns @buffer once part of it has been handed out by
+   * g_input_stream_read_bytes(); the bytes below @shared_end must then
+   * never be overwritten */
+  GBytes *buffer_bytes;
+  gsize   shared_end;
   GAsyncReadyCallback outstanding_callback;
 };
 
@@ -126,6 +136,7 @@ static gboolean g_buffered_input_stream_truncate            (GSeekable       *se
 							     GError         **error);
 
 static void compact_buffer (GBufferedInputStream *stream);
+static void free_buffer    (GBufferedInputStreamPrivate *priv);
 
 G_DEFINE_TYPE_WITH_CODE (GBufferedInputStream,
 			 g_buffered_input_stream,
@@ -226,7 +237,7 @@ g_buffered_input_stream_set_buffer_size (GBufferedInputStream *stream,
       priv->len = size;
       priv->pos = 0;
       priv->end = in_buffer;
-      g_free (priv->buffer);
+      free_buffer (priv);
       priv->buffer = buffer;
     }
   else
@@ -295,7 +306,7 @@ g_buffered_input_stream_finalize (GObject *object)
   stream = G_BUFFERED_INPUT_STREAM (object);
   priv = stream->priv;
 
-  g_free (priv->buffer);
+  free_buffer (priv);
 
   G_OBJECT_CLASS (g_buffered_input_stream_parent_class)->finalize (object);
 }
@@ -627,6 +638,40 @@ g_buffered_input_stream_peek_buffer (GBufferedInputStream *stream,
   return priv->buffer + priv->pos;
 }
 
+static void
+free_buffer (GBufferedInputStreamPrivate *priv)
+{
+  if (priv->buffer_bytes)
+    g_clear_pointer (&priv->buffer_bytes, g_bytes_unref);
+  else
+    g_free (priv->buffer);
+
+  priv->buffer = NULL;
+  priv->shared_end = 0;
+}
+
+/* Moves the unread data to a freshly allocated buffer, leaving the old one
+ * to the slices that still reference it */
+static void
+detach_buffer (GBufferedInputStream *stream)
+{
+  GBufferedInputStreamPrivate *priv;
+  gsize current_size;
+  guint8 *buffer;
+
+  priv = stream->priv;
+
+  current_size = priv->end - priv->pos;
+
+  buffer = g_malloc (priv->len);
+  memcpy (buffer, priv->buffer + priv->pos, current_size);
+  free_buffer (priv);
+
+  priv->buffer = buffer;
+  priv->pos = 0;
+  priv->end = current_size;
+}
+
 static void
 compact_buffer (GBufferedInputStream *stream)
 {
@@ -635,6 +680,12 @@ compact_buffer (GBufferedInputStream *stream)
 
   priv = stream->priv;
 
+  if (priv->shared_end > 0)
+    {
+      detach_buffer (stream);
+      return;
+    }
+
   current_size = priv->end - priv->pos;
 
   memmove (priv->buffer, priv->buffer + priv->pos, current_size);
@@ -668,6 +719,10 @@ g_buffered_input_stream_real_fill (GBufferedInputStream  *stream,
   if (priv->len - priv->end < (gsize) count)
     compact_buffer (stream);
 
+  /* Do not overwrite data that has been handed out as a slice */
+  if (priv->end < priv->shared_end)
+    detach_buffer (stream);
+
   base_stream = G_FILTER_INPUT_STREAM (stream)->base_stream;
   nread = g_input_stream_read (base_stream,
                                priv->buffer + priv->end,
@@ -1018,6 +1073,107 @@ g_buffered_input_stream_read_byte (GBufferedInputStream  *stream,
   return priv->buffer[priv->pos++];
 }
 
+/*
+ * g_buffered_input_stream_read_bytes_internal:
+ * @stream: a #GBufferedInputStream
+ * @count: maximum number of bytes to read
+ * @cancellable: (nullable): optional #GCancellable object
+ * @bytes: (out): return location for the data read
+ * @error: location to store the error occurring, or %NULL to ignore
+ *
+ * Implements g_input_stream_read_bytes() for @stream by returning a slice
+ * of the internal buffer instead of copying out of it. The buffer is only
+ * refilled once it has been drained, so a slice never contains a partial
+ * fill.
+ *
+ * Returns: %FALSE if the generic implementation should be used instead,
+ *   otherwise %TRUE with @bytes set, or %NULL and @error set on failure
+ */
+gboolean
+g_buffered_input_stream_read_bytes_internal (GBufferedInputStream  *stream,
+                                             gsize                  count,
+                                             GCancellable          *cancellable,
+                                             GBytes               **bytes,
+                                             GError               **error)
+{
+  GBufferedInputStreamPrivate *priv;
+  GBufferedInputStreamClass *class;
+  GInputStream *input_stream;
+  gsize available;
+  gssize nread;
+
+  priv = stream->priv;
+  input_stream = G_INPUT_STREAM (stream);
+
+  if (count == 0 ||
+      G_INPUT_STREAM_GET_CLASS (stream)->read_fn != g_buffered_input_stream_read)
+    return FALSE;
+
+  available = priv->end - priv->pos;
+
+  /* Large reads on an empty buffer bypass it entirely */
+  if (available == 0 && count >= priv->len)
+    return FALSE;
+
+  if (!g_input_stream_set_pending (input_stream, error))
+    {
+      *bytes = NULL;
+      return TRUE;
+    }
+
+  if (g_cancellable_set_error_if_cancelled (cancellable, error))
+    {
+      g_input_stream_clear_pending (input_stream);
+      *bytes = NULL;
+      return TRUE;
+    }
+
+  if (available == 0)
+    {
+      if (cancellable)
+        g_cancellable_push_current (cancellable);
+
+      priv->pos = 0;
+      priv->end = 0;
+
+      class = G_BUFFERED_INPUT_STREAM_GET_CLASS (stream);
+      nread = class->fill (stream, priv->len, cancellable, error);
+
+      if (cancellable)
+        g_cancellable_pop_current (cancellable);
+
+      if (nread < 0)
+        {
+          g_input_stream_clear_pending (input_stream);
+          *bytes = NULL;
+          return TRUE;
+        }
+
+      available = priv->end - priv->pos;
+    }
+
+  count = MIN (count, available);
+
+  if (count == 0)
+    *bytes = g_bytes_new_static ("", 0);
+  else if (count < MIN_SLICE_SIZE)
+    *bytes = g_bytes_new (priv->buffer + priv->pos, count);
+  else
+    {
+      if (priv->buffer_bytes == NULL)
+        priv->buffer_bytes = g_bytes_new_take (priv->buffer, priv->len);
+
+      *bytes = g_bytes_new_from_bytes (priv->buffer_bytes, priv->pos, count);
+      priv->shared_end = MAX (priv->shared_end, priv->pos + count);
+    }
+
+  priv->pos += count;
+
+  g_input_stream_clear_pending (input_stream);
+
+  return TRUE;
+}
+
 /* ************************** */
 /* Async stuff implementation */
 /* ************************** */
@@ -1080,6 +1236,10 @@ g_buffered_input_stream_real_fill_async (GBufferedInputStream *stream,
   if (priv->len - priv->end < (gsize) count)
     compact_buffer (stream);
 
+  /* Do not overwrite data that has been handed out as a slice */
+  if (priv->end < priv->shared_end)
+    detach_buffer (stream);
+
   task = g_task_new (stream, cancellable, callback, user_data);
   g_task_set_source_tag (task, g_buffered_input_stream_real_fill_async);
 
@@ -79,6 +79,12 @@ static gssize   g_buffered_output_stream_write        (GOutputStream *stream,
                                                        gsize          count,
                                                        GCancellable  *cancellable,
                                                        GError       **error);
+static gboolean g_buffered_output_stream_writev       (GOutputStream        *stream,
+                                                       const GOutputVector  *vectors,
+                                                       gsize                 n_vectors,
+                                                       gsize                *bytes_written,
+                                                       GCancellable         *cancellable,
+                                                       GError              **error);
 static gboolean g_buffered_output_stream_flush        (GOutputStream    *stream,
                                                        GCancellable  *cancellable,
                                                        GError          **error);
@@ -138,6 +144,7 @@ g_buffered_output_stream_class_init (GBufferedOutputStreamClass *klass)
 
   ostream_class = G_OUTPUT_STREAM_CLASS (klass);
   ostream_class->write_fn = g_buffered_output_stream_write;
+  ostream_class->writev_fn = g_buffered_output_stream_writev;
   ostream_class->flush = g_buffered_output_stream_flush;
   ostream_class->close_fn = g_buffered_output_stream_close;
   ostream_class->flush_async  = g_buffered_output_stream_flush_async;
@@ -480,6 +487,91 @@ g_buffered_output_stream_write  (GOutputStream *stream,
   return count;
 }
 
+static gboolean
+g_buffered_output_stream_writev (GOutputStream        *stream,
+                                 const GOutputVector  *vectors,
+                                 gsize                 n_vectors,
+                                 gsize                *bytes_written,
+                                 GCancellable         *cancellable,
+                                 GError              **error)
+{
+  GBufferedOutputStream        *bstream;
+  GBufferedOutputStreamPrivate *priv;
+  GOutputStream                *base_stream;
+  GOutputVector                *gather;
+  gsize    total, n_gather, n_written, n_flushed, buffered, i;
+  gboolean res;
+
+  bstream = G_BUFFERED_OUTPUT_STREAM (stream);
+  priv = bstream->priv;
+  base_stream = G_FILTER_OUTPUT_STREAM (stream)->base_stream;
+
+  *bytes_written = 0;
+
+  /* If the total would overflow, handle it like a short write of the
+   * vectors before that point */
+  total = 0;
+  for (i = 0; i < n_vectors; i++)
+    {
+      if (total > G_MAXSIZE - vectors[i].size)
+        break;
+      total += vectors[i].size;
+    }
+  n_vectors = i;
+
+  if (priv->auto_grow && priv->len - priv->pos < total)
+    g_buffered_output_stream_set_buffer_size (bstream,
+                                              MAX (priv->len * 2, priv->pos + total));
+
+  /* Coalesce the vectors into the buffer if they fit */
+  if (total <= priv->len - priv->pos)
+    {
+      for (i = 0; i < n_vectors; i++)
+        {
+          memcpy (priv->buffer + priv->pos, vectors[i].buffer, vectors[i].size);
+          priv->pos += vectors[i].size;
+        }
+
+      *bytes_written = total;
+      return TRUE;
+    }
+
+  /* Otherwise write the buffered data and the vectors to the base stream
+   * together, rather than copying the vectors through the buffer */
+  gather = g_new (GOutputVector, n_vectors + 1);
+  n_gather = 0;
+  if (priv->pos > 0)
+    {
+      gather[n_gather].buffer = priv->buffer;
+      gather[n_gather].size = priv->pos;
+      n_gather++;
+    }
+  memcpy (gather + n_gather, vectors, n_vectors * sizeof (GOutputVector));
+  n_gather += n_vectors;
+
+  buffered = priv->pos;
+  n_written = 0;
+  res = g_output_stream_writev_all (base_stream, gather, n_gather,
+                                    &n_written, cancellable, error);
+  g_free (gather);
+
+  n_flushed = MIN (n_written, buffered);
+  if (buffered - n_flushed > 0)
+    memmove (priv->buffer, priv->buffer + n_flushed, buffered - n_flushed);
+  priv->pos -= n_flushed;
+
+  *bytes_written = n_written - n_flushed;
+
+  /* An error after some of the vectors were written is a short write */
+  if (!res && *bytes_written > 0)
+    {
+      g_clear_error (error);
+      return TRUE;
+    }
+
+  return res;
+}
+
 static gboolean
 g_buffered_output_stream_flush (GOutputStream  *stream,
                                 GCancellable   *cancellable,
@@ -55,8 +55,35 @@ struct _GCancellablePrivate
 
   guint fd_refcount;
   GWakeup *wakeup;
+
+  /* Handlers added with g_cancellable_connect(). They don’t change while
+   * cancelled_running is set, so they can be run without the lock. */
+  GArray *handlers;  /* (element-type CancellableHandler) (nullable) */
+
+  GCancellable *parent;  /* (nullable) (not owned) */
+  GSList *children;  /* (element-type GCancellable) (not owned) */
 };
 
+typedef struct
+{
+  gulong id;
+  GCallback callback;
+  gpointer data;
+  GDestroyNotify data_destroy_func;
+} CancellableHandler;
+
+/* IDs of handlers added with g_cancellable_connect() have the top bit set,
+ * which keeps them apart from signal handler IDs */
+#define HANDLER_ID_INLINE ((gulong) 1 << (sizeof (gulong) * 8 - 1))
+static gulong last_handler_id;  /* protected by cancellable_mutex */
+
+/* Wakeups are kept for reuse when their cancellable is done with them,
+ * rather than creating and closing an eventfd each time a cancellable is
+ * polled. Protected by cancellable_mutex. */
+#define MAX_SPARE_WAKEUPS 16
+static GWakeup *spare_wakeups[MAX_SPARE_WAKEUPS];
+static guint n_spare_wakeups;
+
 static guint signals[LAST_SIGNAL] = { 0 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (GCancellable, g_cancellable, G_TYPE_OBJECT)
@@ -65,13 +92,87 @@ static GPrivate current_cancellable;
 static GMutex cancellable_mutex;
 static GCond cancellable_cond;
 
+/* Called with cancellable_mutex held */
+static GWakeup *
+wakeup_acquire (void)
+{
+  if (n_spare_wakeups > 0)
+    return spare_wakeups[--n_spare_wakeups];
+
+  return GLIB_PRIVATE_CALL (g_wakeup_new) ();
+}
+
+/* Called with cancellable_mutex held */
+static void
+wakeup_release (GWakeup  *wakeup,
+                gboolean  signalled)
+{
+  if (n_spare_wakeups == MAX_SPARE_WAKEUPS)
+    {
+      GLIB_PRIVATE_CALL (g_wakeup_free) (wakeup);
+      return;
+    }
+
+  if (signalled)
+    GLIB_PRIVATE_CALL (g_wakeup_acknowledge) (wakeup);
+
+  spare_wakeups[n_spare_wakeups++] = wakeup;
+}
+
+static void
+g_cancellable_dispose (GObject *object)
+{
+  GCancellable *cancellable = G_CANCELLABLE (object);
+  GCancellablePrivate *priv = cancellable->priv;
+  GArray *handlers;
+
+  g_mutex_lock (&cancellable_mutex);
+
+  if (priv->parent != NULL)
+    {
+      priv->parent->priv->children =
+        g_slist_remove (priv->parent->priv->children, cancellable);
+      priv->parent = NULL;
+    }
+
+  handlers = g_steal_pointer (&priv->handlers);
+
+  g_mutex_unlock (&cancellable_mutex);
+
+  /* Like signal handlers, these go away when the object is disposed */
+  if (handlers != NULL)
+    {
+      for (guint i = 0; i < handlers->len; i++)
+        {
+          CancellableHandler *handler = &g_array_index (handlers, CancellableHandler, i);
+
+          if (handler->data_destroy_func)
+            handler->data_destroy_func (handler->data);
+        }
+
+      g_array_unref (handlers);
+    }
+
+  G_OBJECT_CLASS (g_cancellable_parent_class)->dispose (object);
+}
+
 static void
 g_cancellable_finalize (GObject *object)
 {
   GCancellable *cancellable = G_CANCELLABLE (object);
+  GCancellablePrivate *priv = cancellable->priv;
+  GSList *l;
+
+  g_mutex_lock (&cancellable_mutex);
+
+  for (l = priv->children; l != NULL; l = l->next)
+    G_CANCELLABLE (l->data)->priv->parent = NULL;
+  g_clear_pointer (&priv->children, g_slist_free);
+
+  if (priv->wakeup)
+    wakeup_release (priv->wakeup, g_atomic_int_get (&priv->cancelled));
 
-  if (cancellable->priv->wakeup)
-    GLIB_PRIVATE_CALL (g_wakeup_free) (cancellable->priv->wakeup);
+  g_mutex_unlock (&cancellable_mutex);
 
   G_OBJECT_CLASS (g_cancellable_parent_class)->finalize (object);
 }
@@ -81,6 +182,7 @@ g_cancellable_class_init (GCancellableClass *klass)
 {
   GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
 
+  gobject_class->dispose = g_cancellable_dispose;
   gobject_class->finalize = g_cancellable_finalize;
 
   /**
@@ -176,6 +278,48 @@ g_cancellable_new (void)
   return g_object_new (G_TYPE_CANCELLABLE, NULL);
 }
 
+/**
+ * g_cancellable_new_child:
+ * @parent: a #GCancellable
+ *
+ * Creates a new #GCancellable which is cancelled whenever @parent is,
+ * as well as when g_cancellable_cancel() is called on it directly.
+ * Cancelling the child doesn’t affect @parent.
+ *
+ * This is meant for operations made of several sub-operations, which can
+ * then be cancelled individually or all at once, without connecting a
+ * handler to @parent for each of them. If @parent is already cancelled,
+ * the new cancellable starts out cancelled.
+ *
+ * The child doesn’t keep @parent alive, and resetting @parent with
+ * g_cancellable_reset() doesn’t reset its children.
+ *
+ * Returns: (transfer full): a new #GCancellable
+ *
+ * Since: 2.82
+ */
+GCancellable *
+g_cancellable_new_child (GCancellable *parent)
+{
+  GCancellable *cancellable;
+
+  g_return_val_if_fail (G_IS_CANCELLABLE (parent), NULL);
+
+  cancellable = g_cancellable_new ();
+
+  g_mutex_lock (&cancellable_mutex);
+
+  if (g_atomic_int_get (&parent->priv->cancelled))
+    g_atomic_int_set (&cancellable->priv->cancelled, TRUE);
+
+  cancellable->priv->parent = parent;
+  parent->priv->children = g_slist_prepend (parent->priv->children, cancellable);
+
+  g_mutex_unlock (&cancellable_mutex);
+
+  return cancellable;
+}
+
 /**
  * g_cancellable_push_current:
  * @cancellable: a #GCancellable object
@@ -320,10 +464,11 @@ g_cancellable_set_error_if_cancelled (GCancellable  *cancellable,
 {
   if (g_cancellable_is_cancelled (cancellable))
     {
-      g_set_error_literal (error,
-                           G_IO_ERROR,
-                           G_IO_ERROR_CANCELLED,
-                           _("Operation was cancelled"));
+      /* Translations live as long as the program, so needn't be copied */
+      g_set_error_literal_static (error,
+                                  G_IO_ERROR,
+                                  G_IO_ERROR_CANCELLED,
+                                  _("Operation was cancelled"));
       return TRUE;
     }
 
@@ -415,7 +560,7 @@ g_cancellable_make_pollfd (GCancellable *cancellable, GPollFD *pollfd)
 
   if (cancellable->priv->wakeup == NULL)
     {
-      cancellable->priv->wakeup = GLIB_PRIVATE_CALL (g_wakeup_new) ();
+      cancellable->priv->wakeup = wakeup_acquire ();
 
       if (g_atomic_int_get (&cancellable->priv->cancelled))
         GLIB_PRIVATE_CALL (g_wakeup_signal) (cancellable->priv->wakeup);
@@ -462,7 +607,7 @@ g_cancellable_release_fd (GCancellable *cancellable)
   priv->fd_refcount--;
   if (priv->fd_refcount == 0)
     {
-      GLIB_PRIVATE_CALL (g_wakeup_free) (priv->wakeup);
+      wakeup_release (priv->wakeup, g_atomic_int_get (&priv->cancelled));
       priv->wakeup = NULL;
     }
 
@@ -494,6 +639,7 @@ void
 g_cancellable_cancel (GCancellable *cancellable)
 {
   GCancellablePrivate *priv;
+  GSList *children = NULL, *l;
 
   if (cancellable == NULL || g_cancellable_is_cancelled (cancellable))
     return;
@@ -513,11 +659,31 @@ g_cancellable_cancel (GCancellable *cancellable)
   if (priv->wakeup)
     GLIB_PRIVATE_CALL (g_wakeup_signal) (priv->wakeup);
 
+  /* A child being disposed unlinks itself under the lock, so it’s safe
+   * to take a reference while it’s still linked */
+  for (l = priv->children; l != NULL; l = l->next)
+    children = g_slist_prepend (children, g_object_ref (l->data));
+
   g_mutex_unlock (&cancellable_mutex);
 
   g_object_ref (cancellable);
+
+  if (priv->handlers != NULL)
+    {
+      for (guint i = 0; i < priv->handlers->len; i++)
+        {
+          CancellableHandler *handler = &g_array_index (priv->handlers, CancellableHandler, i);
+
+          ((void (*) (GCancellable *, gpointer)) handler->callback) (cancellable, handler->data);
+        }
+    }
+
   g_signal_emit (cancellable, signals[CANCELLED], 0);
 
+  for (l = children; l != NULL; l = l->next)
+    g_cancellable_cancel (l->data);
+  g_slist_free_full (children, g_object_unref);
+
   g_mutex_lock (&cancellable_mutex);
 
   priv->cancelled_running = FALSE;
@@ -556,7 +722,11 @@ g_cancellable_cancel (GCancellable *cancellable)
  * earlier GLib versions which now makes it easier to write cleanup
  * code that unconditionally invokes e.g. g_cancellable_cancel().
  *
- * Returns: The id of the signal handler or 0 if @cancellable has already
+ * Since GLib 2.82, @callback isn’t connected to the signal itself, so
+ * the returned ID can only be passed to g_cancellable_disconnect(), not
+ * to g_signal_handler_disconnect().
+ *
+ * Returns: The id of the handler or 0 if @cancellable has already
  *          been cancelled.
  *
  * Since: 2.22
@@ -601,10 +771,18 @@ g_cancellable_connect (GCancellable   *cancellable,
     }
   else
     {
-      id = g_signal_connect_data (cancellable, "cancelled",
-                                  callback, data,
-                                  (GClosureNotify) data_destroy_func,
-                                  G_CONNECT_DEFAULT);
+      CancellableHandler handler;
+
+      /* Stored without a closure, as there are often many of these */
+      handler.id = HANDLER_ID_INLINE | (++last_handler_id & ~HANDLER_ID_INLINE);
+      handler.callback = callback;
+      handler.data = data;
+      handler.data_destroy_func = data_destroy_func;
+      id = handler.id;
+
+      if (cancellable->priv->handlers == NULL)
+        cancellable->priv->handlers = g_array_new (FALSE, FALSE, sizeof (CancellableHandler));
+      g_array_append_val (cancellable->priv->handlers, handler);
 
       g_mutex_unlock (&cancellable_mutex);
     }
@@ -659,6 +837,31 @@ g_cancellable_disconnect (GCancellable  *cancellable,
       g_cond_wait (&cancellable_cond, &cancellable_mutex);
     }
 
+  if (handler_id & HANDLER_ID_INLINE)
+    {
+      CancellableHandler handler = { 0, };
+
+      for (guint i = 0; priv->handlers != NULL && i < priv->handlers->len; i++)
+        {
+          if (g_array_index (priv->handlers, CancellableHandler, i).id == handler_id)
+            {
+              handler = g_array_index (priv->handlers, CancellableHandler, i);
+              g_array_remove_index (priv->handlers, i);
+              break;
+            }
+        }
+
+      g_mutex_unlock (&cancellable_mutex);
+
+      if (handler.id == 0)
+        g_critical ("%s: instance '%p' has no handler with id '%lu'",
+                    G_STRFUNC, cancellable, handler_id);
+      else if (handler.data_destroy_func)
+        handler.data_destroy_func (handler.data);
+
+      return;
+    }
+
   g_signal_handler_disconnect (cancellable, handler_id);
 
   g_mutex_unlock (&cancellable_mutex);
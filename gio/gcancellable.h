@@ -69,6 +69,8 @@ GType         g_cancellable_get_type               (void) G_GNUC_CONST;
 
 GIO_AVAILABLE_IN_ALL
 GCancellable *g_cancellable_new                    (void);
+GIO_AVAILABLE_IN_2_82
+GCancellable *g_cancellable_new_child              (GCancellable  *parent);
 
 /* These are only safe to call inside a cancellable op */
 GIO_AVAILABLE_IN_ALL
@@ -28,6 +28,7 @@
 
 #include "ginitable.h"
 #include "gioerror.h"
+#include "glib-private.h"
 #include "glibintl.h"
 
 
@@ -72,10 +73,10 @@ g_charset_converter_finalize (GObject *object)
 
   conv = G_CHARSET_CONVERTER (object);
 
+  if (conv->iconv)
+    GLIB_PRIVATE_CALL (g_iconv_cache_give) (conv->to, conv->from, conv->iconv);
   g_free (conv->from);
   g_free (conv->to);
-  if (conv->iconv)
-    g_iconv_close (conv->iconv);
 
   G_OBJECT_CLASS (g_charset_converter_parent_class)->finalize (object);
 }
@@ -458,7 +459,7 @@ g_charset_converter_initable_init (GInitable     *initable,
       return FALSE;
     }
 
-  conv->iconv = g_iconv_open (conv->to, conv->from);
+  conv->iconv = GLIB_PRIVATE_CALL (g_iconv_cache_take) (conv->to, conv->from);
   errsv = errno;
 
   if (conv->iconv == (GIConv)-1)
@@ -470,6 +470,39 @@ load_comment_for_mime (const char *mimetype)
   return g_strdup_printf (_("%s type"), mimetype);
 }
 
+/* Descriptions loaded by g_content_type_get_description(); protected by
+ * gio_xdgmime. They are registered with g_mem_cache_register(), so they are
+ * dropped on low memory warnings. */
+static GHashTable *type_comment_cache = NULL;
+static gsize type_comment_cache_size = 0;
+
+static gsize
+type_comment_cache_trim (guint    level,
+                         gpointer user_data)
+{
+  gsize freed;
+
+  G_LOCK (gio_xdgmime);
+  freed = type_comment_cache_size;
+  g_hash_table_remove_all (type_comment_cache);
+  type_comment_cache_size = 0;
+  G_UNLOCK (gio_xdgmime);
+
+  return freed;
+}
+
+static gsize
+type_comment_cache_get_size (gpointer user_data)
+{
+  gsize size;
+
+  G_LOCK (gio_xdgmime);
+  size = type_comment_cache_size;
+  G_UNLOCK (gio_xdgmime);
+
+  return size;
+}
+
 /**
  * g_content_type_get_description:
  * @type: a content type string
@@ -482,7 +515,6 @@ load_comment_for_mime (const char *mimetype)
 gchar *
 g_content_type_get_description (const gchar *type)
 {
-  static GHashTable *type_comment_cache = NULL;
   gchar *type_copy = NULL;
   gchar *comment;
 
@@ -494,7 +526,14 @@ g_content_type_get_description (const gchar *type)
   g_end_ignore_leaks ();
 
   if (type_comment_cache == NULL)
-    type_comment_cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+    {
+      type_comment_cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+      g_mem_cache_register ("gio-content-type-descriptions",
+                            G_MEMORY_MONITOR_WARNING_LEVEL_LOW,
+                            type_comment_cache_trim,
+                            type_comment_cache_get_size,
+                            NULL);
+    }
 
   comment = g_hash_table_lookup (type_comment_cache, type);
   comment = g_strdup (comment);
@@ -511,6 +550,8 @@ g_content_type_get_description (const gchar *type)
   comment = load_comment_for_mime (type_copy);
   G_LOCK (gio_xdgmime);
 
+  if (!g_hash_table_contains (type_comment_cache, type_copy))
+    type_comment_cache_size += strlen (type_copy) + strlen (comment) + 2;
   g_hash_table_insert (type_comment_cache,
                        g_steal_pointer (&type_copy),
                        g_strdup (comment));
@@ -740,27 +781,12 @@ g_content_type_from_mime_type (const gchar *mime_type)
   return umime;
 }
 
-/**
- * g_content_type_guess:
- * @filename: (nullable) (type filename): a path, or %NULL
- * @data: (nullable) (array length=data_size): a stream of data, or %NULL
- * @data_size: the size of @data
- * @result_uncertain: (out) (optional): return location for the certainty
- *     of the result, or %NULL
- *
- * Guesses the content type based on example data. If the function is
- * uncertain, @result_uncertain will be set to %TRUE. Either @filename
- * or @data may be %NULL, in which case the guess will be based solely
- * on the other argument.
- *
- * Returns: a string indicating a guessed content type for the
- *     given data. Free with g_free()
- */
-gchar *
-g_content_type_guess (const gchar  *filename,
-                      const guchar *data,
-                      gsize         data_size,
-                      gboolean     *result_uncertain)
+/* Must be called with the gio_xdgmime lock held */
+static gchar *
+content_type_guess_locked (const gchar  *filename,
+                           const guchar *data,
+                           gsize         data_size,
+                           gboolean     *result_uncertain)
 {
   char *basename;
   const char *name_mimetypes[10], *sniffed_mimetype;
@@ -776,13 +802,6 @@ g_content_type_guess (const gchar  *filename,
   if (result_uncertain)
     *result_uncertain = FALSE;
 
-  /* our test suite and potentially other code used -1 in the past, which is
-   * not documented and not allowed; guard against that */
-  g_return_val_if_fail (data_size != (gsize) -1, g_strdup (XDG_MIME_TYPE_UNKNOWN));
-
-  G_LOCK (gio_xdgmime);
-  g_begin_ignore_leaks ();
-
   if (filename)
     {
       i = strlen (filename);
@@ -804,12 +823,7 @@ g_content_type_guess (const gchar  *filename,
 
   /* Got an extension match, and no conflicts. This is it. */
   if (n_name_mimetypes == 1)
-    {
-      gchar *s = g_strdup (name_mimetypes[0]);
-      g_end_ignore_leaks ();
-      G_UNLOCK (gio_xdgmime);
-      return s;
-    }
+    return g_strdup (name_mimetypes[0]);
 
   if (data)
     {
@@ -875,12 +889,104 @@ g_content_type_guess (const gchar  *filename,
         }
     }
 
+  return mimetype;
+}
+
+/**
+ * g_content_type_guess:
+ * @filename: (nullable) (type filename): a path, or %NULL
+ * @data: (nullable) (array length=data_size): a stream of data, or %NULL
+ * @data_size: the size of @data
+ * @result_uncertain: (out) (optional): return location for the certainty
+ *     of the result, or %NULL
+ *
+ * Guesses the content type based on example data. If the function is
+ * uncertain, @result_uncertain will be set to %TRUE. Either @filename
+ * or @data may be %NULL, in which case the guess will be based solely
+ * on the other argument.
+ *
+ * Returns: a string indicating a guessed content type for the
+ *     given data. Free with g_free()
+ */
+gchar *
+g_content_type_guess (const gchar  *filename,
+                      const guchar *data,
+                      gsize         data_size,
+                      gboolean     *result_uncertain)
+{
+  gchar *mimetype;
+
+  /* our test suite and potentially other code used -1 in the past, which is
+   * not documented and not allowed; guard against that */
+  g_return_val_if_fail (data_size != (gsize) -1, g_strdup (XDG_MIME_TYPE_UNKNOWN));
+
+  G_LOCK (gio_xdgmime);
+  g_begin_ignore_leaks ();
+  mimetype = content_type_guess_locked (filename, data, data_size, result_uncertain);
   g_end_ignore_leaks ();
   G_UNLOCK (gio_xdgmime);
 
   return mimetype;
 }
 
+/* The number of names guessed by g_content_types_guess_many() per
+ * acquisition of the xdgmime lock, so that a large batch does not block
+ * other threads for its whole duration */
+#define CONTENT_TYPES_GUESS_BATCH 256
+
+/**
+ * g_content_types_guess_many:
+ * @filenames: (array zero-terminated=1) (element-type filename): a
+ *     %NULL-terminated array of paths
+ * @results_uncertain: (array) (nullable): return location for the
+ *     certainty of each result, with as many elements as @filenames, or
+ *     %NULL
+ *
+ * Guesses the content types of several files based on their names only.
+ *
+ * This gives the same results as calling g_content_type_guess() with
+ * no data for each element of @filenames, but is faster for large
+ * numbers of files, as the shared MIME database is only locked once
+ * for many names.
+ *
+ * Returns: (transfer full) (array zero-terminated=1): a %NULL-terminated
+ *     array with the guessed content type of each element of @filenames.
+ *     Free with g_strfreev()
+ *
+ * Since: 2.82
+ */
+gchar **
+g_content_types_guess_many (const gchar * const *filenames,
+                            gboolean            *results_uncertain)
+{
+  gchar **types;
+  gsize n_filenames, i;
+
+  g_return_val_if_fail (filenames != NULL, NULL);
+
+  n_filenames = g_strv_length ((gchar **) filenames);
+  types = g_new (gchar *, n_filenames + 1);
+
+  for (i = 0; i < n_filenames; )
+    {
+      gsize end = MIN (i + CONTENT_TYPES_GUESS_BATCH, n_filenames);
+
+      G_LOCK (gio_xdgmime);
+      g_begin_ignore_leaks ();
+
+      for (; i < end; i++)
+        types[i] = content_type_guess_locked (filenames[i], NULL, 0,
+                                              results_uncertain ? &results_uncertain[i] : NULL);
+
+      g_end_ignore_leaks ();
+      G_UNLOCK (gio_xdgmime);
+    }
+
+  types[n_filenames] = NULL;
+
+  return types;
+}
+
 static void
 enumerate_mimetypes_subdir (const char *dir,
                             const char *prefix,
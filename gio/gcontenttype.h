@@ -65,6 +65,10 @@ gchar *  g_content_type_guess             (const gchar  *filename,
                                            gsize         data_size,
                                            gboolean     *result_uncertain);
 
+GIO_AVAILABLE_IN_2_82
+gchar ** g_content_types_guess_many       (const gchar * const *filenames,
+                                           gboolean            *results_uncertain);
+
 GIO_AVAILABLE_IN_ALL
 gchar ** g_content_type_guess_for_tree    (GFile        *root);
 
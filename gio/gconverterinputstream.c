@@ -26,9 +26,12 @@
 
 #include "gconverterinputstream.h"
 #include "gpollableinputstream.h"
+#include "gbufferedinputstream.h"
+#include "gmemoryinputstream.h"
 #include "gcancellable.h"
 #include "gioenumtypes.h"
 #include "gioerror.h"
+#include "gioprivate.h"
 #include "glibintl.h"
 
 
@@ -376,6 +379,53 @@ fill_input_buffer (GConverterInputStream  *stream,
   return nread;
 }
 
+/* If the base stream keeps its data in memory, returns the data which can
+ * be read from it next, so that it can be converted without first being
+ * copied to the input buffer. In blocking mode, an empty buffered base
+ * stream is refilled first.
+ *
+ * Returns: the size of the data, 0 if there is none or at the end of the
+ *   base stream, or -1 on error */
+static gssize
+peek_base_stream (GConverterInputStream  *stream,
+                  const char            **data,
+                  gboolean                blocking,
+                  GCancellable           *cancellable,
+                  GError                **error)
+{
+  GInputStream *base_stream;
+  gsize size = 0;
+  gssize nread;
+
+  base_stream = G_FILTER_INPUT_STREAM (stream)->base_stream;
+  *data = NULL;
+
+  if (g_input_stream_is_closed (base_stream) ||
+      g_input_stream_has_pending (base_stream))
+    return 0;
+
+  if (G_IS_BUFFERED_INPUT_STREAM (base_stream))
+    {
+      GBufferedInputStream *buffered = G_BUFFERED_INPUT_STREAM (base_stream);
+
+      if (g_buffered_input_stream_get_available (buffered) == 0 && blocking)
+        {
+          nread = g_buffered_input_stream_fill (buffered, -1, cancellable, error);
+          if (nread < 0)
+            return -1;
+          if (nread == 0)
+            stream->priv->at_input_end = TRUE;
+        }
+
+      *data = g_buffered_input_stream_peek_buffer (buffered, &size);
+    }
+  else if (G_IS_MEMORY_INPUT_STREAM (base_stream))
+    {
+      *data = g_memory_input_stream_peek (G_MEMORY_INPUT_STREAM (base_stream), &size);
+    }
+
+  return size;
+}
 
 static gssize
 read_internal (GInputStream *stream,
@@ -417,6 +467,53 @@ read_internal (GInputStream *stream,
   buffer = (char *) buffer + available;
   count -= available;
 
+  /* Convert straight from the base stream's memory to the user buffer,
+   * skipping the copy to our input buffer */
+  while (buffer_data_size (&priv->input_buffer) == 0 &&
+         total_bytes_read == 0 &&
+         !priv->at_input_end &&
+         !priv->finished)
+    {
+      const char *data;
+      gssize size;
+
+      size = peek_base_stream (cstream, &data, blocking, cancellable, error);
+      if (size < 0)
+        return -1;
+      if (size == 0)
+        break;
+
+      my_error = NULL;
+      res = g_converter_convert (priv->converter,
+                                 data, size,
+                                 buffer, count,
+                                 0,
+                                 &bytes_read,
+                                 &bytes_written,
+                                 &my_error);
+      if (res == G_CONVERTER_ERROR)
+        {
+          /* Let the buffered code below handle this */
+          g_error_free (my_error);
+          break;
+        }
+
+      g_input_stream_skip (G_FILTER_INPUT_STREAM (stream)->base_stream,
+                           bytes_read, NULL, NULL);
+      total_bytes_read += bytes_written;
+
+      if (res == G_CONVERTER_FINISHED)
+        priv->finished = TRUE;
+
+      if (total_bytes_read > 0 || priv->finished)
+        return total_bytes_read;
+
+      /* Stop if the converter did not consume anything, as it would not
+       * do better on another attempt */
+      if (bytes_read == 0)
+        break;
+    }
+
   /* If there is no data to convert, and no pre-converted data,
      do some i/o for more input */
   if (buffer_data_size (&priv->input_buffer) == 0 &&
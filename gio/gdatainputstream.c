@@ -624,10 +624,8 @@ scan_for_newline (GDataInputStream *stream,
   GBufferedInputStream *bstream;
   GDataInputStreamPrivate *priv;
   const char *buffer;
-  gsize start, end, peeked;
-  gsize i;
-  gssize found_pos;
-  int newline_len;
+  const char *p, *cr, *lf;
+  gsize start, peeked;
   gsize available, checked;
   gboolean last_saw_cr;
 
@@ -637,82 +635,135 @@ scan_for_newline (GDataInputStream *stream,
 
   checked = *checked_out;
   last_saw_cr = *last_saw_cr_out;
-  found_pos = -1;
-  newline_len = 0;
-  
+
+  /* Only the bytes added since the last call need to be looked at, and
+   * memchr() is much faster than a byte-wise loop on long lines */
   start = checked;
   buffer = (const char*)g_buffered_input_stream_peek_buffer (bstream, &available) + start;
-  end = available;
-  peeked = end - start;
+  peeked = available - start;
+
+  if (peeked == 0)
+    return -1;
 
-  for (i = 0; checked < available && i < peeked; i++)
+  switch (priv->newline_type)
     {
-      switch (priv->newline_type)
-	{
-	case G_DATA_STREAM_NEWLINE_TYPE_LF:
-	  if (buffer[i] == 10)
-	    {
-	      found_pos = start + i;
-	      newline_len = 1;
-	    }
-	  break;
-	case G_DATA_STREAM_NEWLINE_TYPE_CR:
-	  if (buffer[i] == 13)
-	    {
-	      found_pos = start + i;
-	      newline_len = 1;
-	    }
-	  break;
-	case G_DATA_STREAM_NEWLINE_TYPE_CR_LF:
-	  if (last_saw_cr && buffer[i] == 10)
-	    {
-	      found_pos = start + i - 1;
-	      newline_len = 2;
-	    }
-	  break;
-	default:
-	case G_DATA_STREAM_NEWLINE_TYPE_ANY:
-	  if (buffer[i] == 10) /* LF */
-	    {
-	      if (last_saw_cr)
-		{
-		  /* CR LF */
-		  found_pos = start + i - 1;
-		  newline_len = 2;
-		}
-	      else
-		{
-		  /* LF */
-		  found_pos = start + i;
-		  newline_len = 1;
-		}
-	    }
-	  else if (last_saw_cr)
-	    {
-	      /* Last was cr, this is not LF, end is CR */
-	      found_pos = start + i - 1;
-	      newline_len = 1;
-	    }
-	  /* Don't check for CR here, instead look at last_saw_cr on next byte */
-	  break;
-	}
-	
-      last_saw_cr = (buffer[i] == 13);
+    case G_DATA_STREAM_NEWLINE_TYPE_LF:
+      p = memchr (buffer, 10, peeked);
+      if (p != NULL)
+        {
+          *newline_len_out = 1;
+          return start + (p - buffer);
+        }
+      break;
+
+    case G_DATA_STREAM_NEWLINE_TYPE_CR:
+      p = memchr (buffer, 13, peeked);
+      if (p != NULL)
+        {
+          *newline_len_out = 1;
+          return start + (p - buffer);
+        }
+      break;
+
+    case G_DATA_STREAM_NEWLINE_TYPE_CR_LF:
+      if (last_saw_cr && buffer[0] == 10)
+        {
+          *newline_len_out = 2;
+          return start - 1;
+        }
+
+      p = buffer;
+      while ((p = memchr (p, 10, peeked - (p - buffer))) != NULL)
+        {
+          if (p > buffer && p[-1] == 13)
+            {
+              *newline_len_out = 2;
+              return start + (p - buffer) - 1;
+            }
+          p++;
+        }
+      break;
+
+    default:
+    case G_DATA_STREAM_NEWLINE_TYPE_ANY:
+      if (last_saw_cr)
+        {
+          /* CR LF, or a lone CR if anything else follows it */
+          *newline_len_out = (buffer[0] == 10) ? 2 : 1;
+          return start - 1;
+        }
+
+      lf = memchr (buffer, 10, peeked);
+      cr = memchr (buffer, 13, lf ? (gsize) (lf - buffer) : peeked);
+
+      if (cr == NULL && lf != NULL)
+        {
+          *newline_len_out = 1;
+          return start + (lf - buffer);
+        }
+      else if (cr != NULL && (gsize) (cr - buffer) + 1 < peeked)
+        {
+          *newline_len_out = (cr[1] == 10) ? 2 : 1;
+          return start + (cr - buffer);
+        }
+      /* Otherwise there is either no newline, or a CR at the very end
+       * of the buffer, and we need to see the next byte to know whether
+       * it is followed by a LF */
+      break;
+    }
+
+  *last_saw_cr_out = (buffer[peeked - 1] == 13);
+  *checked_out = available;
+  return -1;
+}
+
+/* Fills the buffer until it contains a whole line, and returns the length
+ * of that line, with the length of its line ending in @newline_len_out.
+ * Returns -1 on error, or at the end of the stream without setting @error. */
+static gssize
+fill_for_line (GDataInputStream  *stream,
+               int               *newline_len_out,
+               GCancellable      *cancellable,
+               GError           **error)
+{
+  GBufferedInputStream *bstream;
+  gsize checked;
+  gboolean last_saw_cr;
+  gssize found_pos;
+  gssize res;
+  int newline_len;
+
+  bstream = G_BUFFERED_INPUT_STREAM (stream);
 
-      if (found_pos != -1)
+  newline_len = 0;
+  checked = 0;
+  last_saw_cr = FALSE;
+
+  while ((found_pos = scan_for_newline (stream, &checked, &last_saw_cr, &newline_len)) == -1)
+    {
+      if (g_buffered_input_stream_get_available (bstream) ==
+	  g_buffered_input_stream_get_buffer_size (bstream))
+	g_buffered_input_stream_set_buffer_size (bstream,
+						 2 * g_buffered_input_stream_get_buffer_size (bstream));
+
+      res = g_buffered_input_stream_fill (bstream, -1, cancellable, error);
+      if (res < 0)
+	return -1;
+      if (res == 0)
 	{
-	  *newline_len_out = newline_len;
-	  return found_pos;
+	  /* End of stream */
+	  if (g_buffered_input_stream_get_available (bstream) == 0)
+	    return -1;
+
+	  found_pos = checked;
+	  newline_len = 0;
+	  break;
 	}
     }
 
-  checked = end;
-
-  *checked_out = checked;
-  *last_saw_cr_out = last_saw_cr;
-  return -1;
+  *newline_len_out = newline_len;
+  return found_pos;
 }
-		  
 
 /**
  * g_data_input_stream_read_line:
@@ -742,9 +793,6 @@ g_data_input_stream_read_line (GDataInputStream  *stream,
 			       GCancellable      *cancellable,
 			       GError           **error)
 {
-  GBufferedInputStream *bstream;
-  gsize checked;
-  gboolean last_saw_cr;
   gssize found_pos;
   gssize res;
   int newline_len;
@@ -752,38 +800,12 @@ g_data_input_stream_read_line (GDataInputStream  *stream,
   
   g_return_val_if_fail (G_IS_DATA_INPUT_STREAM (stream), NULL);  
 
-  bstream = G_BUFFERED_INPUT_STREAM (stream);
-
-  newline_len = 0;
-  checked = 0;
-  last_saw_cr = FALSE;
-
-  while ((found_pos = scan_for_newline (stream, &checked, &last_saw_cr, &newline_len)) == -1)
+  found_pos = fill_for_line (stream, &newline_len, cancellable, error);
+  if (found_pos < 0)
     {
-      if (g_buffered_input_stream_get_available (bstream) ==
-	  g_buffered_input_stream_get_buffer_size (bstream))
-	g_buffered_input_stream_set_buffer_size (bstream,
-						 2 * g_buffered_input_stream_get_buffer_size (bstream));
-
-      res = g_buffered_input_stream_fill (bstream, -1, cancellable, error);
-      if (res < 0)
-	return NULL;
-      if (res == 0)
-	{
-	  /* End of stream */
-	  if (g_buffered_input_stream_get_available (bstream) == 0)
-	    {
-	      if (length)
-		*length = 0;
-	      return NULL;
-	    }
-	  else
-	    {
-	      found_pos = checked;
-	      newline_len = 0;
-	      break;
-	    }
-	}
+      if (length)
+        *length = 0;
+      return NULL;
     }
 
   line = g_malloc (found_pos + newline_len + 1);
@@ -846,6 +868,68 @@ g_data_input_stream_read_line_utf8 (GDataInputStream  *stream,
   return res;
 }
 
+/**
+ * g_data_input_stream_read_line_borrowed:
+ * @stream: a given #GDataInputStream.
+ * @length: (out) (optional): a #gsize to get the length of the data read in.
+ * @cancellable: (nullable): optional #GCancellable object, %NULL to ignore.
+ * @error: #GError for error reporting.
+ *
+ * Reads a line from the data input stream, like
+ * g_data_input_stream_read_line(), but without copying it.
+ *
+ * The returned data points into the internal buffer of @stream and is
+ * only valid until the next operation on @stream. It is not NUL
+ * terminated, and does not include the newline. As with
+ * g_data_input_stream_read_line(), no encoding checks are performed.
+ *
+ * This is useful to iterate over large numbers of lines without
+ * allocating a string for each of them.
+ *
+ * Returns: (nullable) (transfer none) (array length=length) (element-type guint8):
+ *  the line that was read in, or %NULL if there's no content to read
+ *  or on error, in which case @error will be set.
+ *
+ * Since: 2.82
+ **/
+const char *
+g_data_input_stream_read_line_borrowed (GDataInputStream  *stream,
+                                        gsize             *length,
+                                        GCancellable      *cancellable,
+                                        GError           **error)
+{
+  GBufferedInputStream *bstream;
+  gssize found_pos;
+  gssize res;
+  int newline_len;
+  const char *line;
+
+  g_return_val_if_fail (G_IS_DATA_INPUT_STREAM (stream), NULL);
+
+  bstream = G_BUFFERED_INPUT_STREAM (stream);
+
+  found_pos = fill_for_line (stream, &newline_len, cancellable, error);
+  if (found_pos < 0)
+    {
+      if (length)
+        *length = 0;
+      return NULL;
+    }
+
+  line = g_buffered_input_stream_peek_buffer (bstream, NULL);
+
+  /* The whole line is buffered, so this only advances the read position
+   * and leaves the buffer contents alone */
+  res = g_input_stream_skip (G_INPUT_STREAM (stream),
+                             found_pos + newline_len,
+                             NULL, NULL);
+  if (length)
+    *length = (gsize)found_pos;
+  g_warn_if_fail (res == found_pos + newline_len);
+
+  return line;
+}
+
 static gssize
 scan_for_chars (GDataInputStream *stream,
 		gsize            *checked_out,
@@ -853,35 +937,41 @@ scan_for_chars (GDataInputStream *stream,
                 gsize             stop_chars_len)
 {
   GBufferedInputStream *bstream;
-  const char *buffer;
-  gsize start, end, peeked;
+  const guint8 *buffer;
+  const guint8 *p;
+  gsize start, peeked;
   gsize i;
-  gsize available, checked;
-  const char *stop_char;
-  const char *stop_end;
+  gsize available;
+  guint32 is_stop_char[256 / 32] = { 0, };
 
   bstream = G_BUFFERED_INPUT_STREAM (stream);
-  stop_end = stop_chars + stop_chars_len;
-
-  checked = *checked_out;
 
-  start = checked;
-  buffer = (const char *)g_buffered_input_stream_peek_buffer (bstream, &available) + start;
-  end = available;
-  peeked = end - start;
+  start = *checked_out;
+  buffer = (const guint8 *)g_buffered_input_stream_peek_buffer (bstream, &available) + start;
+  peeked = available - start;
 
-  for (i = 0; checked < available && i < peeked; i++)
+  if (stop_chars_len == 1)
     {
-      for (stop_char = stop_chars; stop_char != stop_end; stop_char++)
-	{
-	  if (buffer[i] == *stop_char)
-	    return (start + i);
-	}
+      p = memchr (buffer, stop_chars[0], peeked);
+      if (p != NULL)
+        return start + (p - buffer);
     }
+  else
+    {
+      for (i = 0; i < stop_chars_len; i++)
+        {
+          guint8 c = stop_chars[i];
+          is_stop_char[c / 32] |= 1u << (c % 32);
+        }
 
-  checked = end;
+      for (i = 0; i < peeked; i++)
+        {
+          if (is_stop_char[buffer[i] / 32] & (1u << (buffer[i] % 32)))
+            return (start + i);
+        }
+    }
 
-  *checked_out = checked;
+  *checked_out = available;
   return -1;
 }
 
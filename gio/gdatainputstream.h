@@ -115,6 +115,11 @@ char *                 g_data_input_stream_read_line_utf8       (GDataInputStrea
 								 gsize                   *length,
 								 GCancellable            *cancellable,
 								 GError                 **error);
+GIO_AVAILABLE_IN_2_82
+const char *           g_data_input_stream_read_line_borrowed   (GDataInputStream        *stream,
+                                                                 gsize                   *length,
+                                                                 GCancellable            *cancellable,
+                                                                 GError                 **error);
 GIO_AVAILABLE_IN_ALL
 void                   g_data_input_stream_read_line_async      (GDataInputStream        *stream,
                                                                  gint                     io_priority,
@@ -1455,6 +1455,7 @@ class CodeGenerator:
         glib_min_required,
         symbol_decoration_define,
         outfile,
+        fast_marshalling=False,
     ):
         self.ifaces = ifaces
         self.namespace, self.ns_upper, self.ns_lower = generate_namespace(namespace)
@@ -1465,10 +1466,107 @@ class CodeGenerator:
         self.glib_min_required = glib_min_required
         self.symbol_decoration_define = symbol_decoration_define
         self.outfile = outfile
+        self.fast_marshalling = fast_marshalling
         self.marshallers = set()
 
     # ----------------------------------------------------------------------------------------------------
 
+    # Type-specific GVariant constructors and getters for each GVariant format
+    # used by the arguments, see generate_tuple_new() and
+    # generate_tuple_get(). Arguments not in here are GVariants already.
+    FAST_MARSHALLING_FUNCS = {
+        "b": ("g_variant_new_boolean ({0})", "g_variant_get_boolean ({0})"),
+        "y": ("g_variant_new_byte ({0})", "g_variant_get_byte ({0})"),
+        "n": ("g_variant_new_int16 ({0})", "g_variant_get_int16 ({0})"),
+        "q": ("g_variant_new_uint16 ({0})", "g_variant_get_uint16 ({0})"),
+        "i": ("g_variant_new_int32 ({0})", "g_variant_get_int32 ({0})"),
+        "u": ("g_variant_new_uint32 ({0})", "g_variant_get_uint32 ({0})"),
+        "x": ("g_variant_new_int64 ({0})", "g_variant_get_int64 ({0})"),
+        "t": ("g_variant_new_uint64 ({0})", "g_variant_get_uint64 ({0})"),
+        "d": ("g_variant_new_double ({0})", "g_variant_get_double ({0})"),
+        "s": ("g_variant_new_string ({0})", "g_variant_dup_string ({0}, NULL)"),
+        "o": ("g_variant_new_object_path ({0})", "g_variant_dup_string ({0}, NULL)"),
+        "g": ("g_variant_new_signature ({0})", "g_variant_dup_string ({0}, NULL)"),
+        "^ay": (
+            "g_variant_new_bytestring ({0})",
+            "g_variant_dup_bytestring ({0}, NULL)",
+        ),
+        "^as": ("g_variant_new_strv ({0}, -1)", "g_variant_dup_strv ({0}, NULL)"),
+        "^ao": ("g_variant_new_objv ({0}, -1)", "g_variant_dup_objv ({0}, NULL)"),
+        "^aay": (
+            "g_variant_new_bytestring_array ({0}, -1)",
+            "g_variant_dup_bytestring_array ({0}, NULL)",
+        ),
+    }
+
+    def generate_tuple_new(self, args, prefix):
+        """Writes an expression creating a floating tuple GVariant from the C
+        variables for @args, which are named @prefix followed by the argument
+        name.
+
+        With --c-generate-fast-marshalling, this uses the type-specific
+        constructors rather than g_variant_new(), which has to parse its
+        format string at runtime."""
+        if not self.fast_marshalling:
+            self.outfile.write('g_variant_new ("(')
+            for a in args:
+                self.outfile.write("%s" % (a.format_in))
+            self.outfile.write(')"')
+            for a in args:
+                self.outfile.write(",\n                   %s%s" % (prefix, a.name))
+            self.outfile.write(")")
+            return
+
+        if len(args) == 0:
+            self.outfile.write("g_variant_new_tuple (NULL, 0)")
+            return
+
+        self.outfile.write("g_variant_new_tuple ((GVariant *[]) {")
+        for n, a in enumerate(args):
+            funcs = self.FAST_MARSHALLING_FUNCS.get(a.format_in)
+            value = prefix + a.name
+            if funcs is not None:
+                value = funcs[0].format(value)
+            self.outfile.write(
+                "\n                   %s%s" % (value, "," if n + 1 < len(args) else "")
+            )
+        self.outfile.write("}, %d)" % len(args))
+
+    def generate_tuple_get(self, args, prefix):
+        """Writes statements storing the children of the tuple GVariant
+        `_ret` into the return locations for @args, which are named @prefix
+        followed by the argument name and may be %NULL."""
+        if not self.fast_marshalling:
+            self.outfile.write("  g_variant_get (_ret,\n" '                 "(')
+            for a in args:
+                self.outfile.write("%s" % (a.format_out))
+            self.outfile.write(')"')
+            for a in args:
+                self.outfile.write(",\n                 %s%s" % (prefix, a.name))
+            self.outfile.write(");\n")
+            return
+
+        for n, a in enumerate(args):
+            funcs = self.FAST_MARSHALLING_FUNCS.get(a.format_out)
+            if funcs is None:
+                self.outfile.write(
+                    "  if (%s%s != NULL)\n"
+                    "    *%s%s = g_variant_get_child_value (_ret, %d);\n"
+                    % (prefix, a.name, prefix, a.name, n)
+                )
+            else:
+                self.outfile.write(
+                    "  if (%s%s != NULL)\n"
+                    "    {\n"
+                    "      GVariant *_child = g_variant_get_child_value (_ret, %d);\n"
+                    "      *%s%s = %s;\n"
+                    "      g_variant_unref (_child);\n"
+                    "    }\n"
+                    % (prefix, a.name, n, prefix, a.name, funcs[1].format("_child"))
+                )
+
+    # ----------------------------------------------------------------------------------------------------
+
     def generate_body_preamble(self):
         basenames = ", ".join(self.input_files_basenames)
         self.outfile.write(LICENSE_STR.format(config.VERSION, basenames))
@@ -2805,13 +2903,9 @@ class CodeGenerator:
                 )
             else:
                 self.outfile.write("  g_dbus_proxy_call (G_DBUS_PROXY (proxy),\n")
-            self.outfile.write('    "%s",\n' '    g_variant_new ("(' % (m.name))
-            for a in m.in_args:
-                self.outfile.write("%s" % (a.format_in))
-            self.outfile.write(')"')
-            for a in m.in_args:
-                self.outfile.write(",\n                   arg_%s" % (a.name))
-            self.outfile.write("),\n")
+            self.outfile.write('    "%s",\n    ' % (m.name))
+            self.generate_tuple_new(m.in_args, "arg_")
+            self.outfile.write(",\n")
             if self.glib_min_required >= (2, 64):
                 self.outfile.write("    call_flags,\n" "    timeout_msec,\n")
             else:
@@ -2875,13 +2969,8 @@ class CodeGenerator:
                     "  _ret = g_dbus_proxy_call_finish (G_DBUS_PROXY (proxy), res, error);\n"
                 )
             self.outfile.write("  if (_ret == NULL)\n" "    goto _out;\n")
-            self.outfile.write("  g_variant_get (_ret,\n" '                 "(')
-            for a in m.out_args:
-                self.outfile.write("%s" % (a.format_out))
-            self.outfile.write(')"')
-            for a in m.out_args:
-                self.outfile.write(",\n                 out_%s" % (a.name))
-            self.outfile.write(");\n" "  g_variant_unref (_ret);\n")
+            self.generate_tuple_get(m.out_args, "out_")
+            self.outfile.write("  g_variant_unref (_ret);\n")
             self.outfile.write("_out:\n" "  return _ret != NULL;\n" "}\n" "\n")
 
             # sync
@@ -2962,13 +3051,9 @@ class CodeGenerator:
                 self.outfile.write(
                     "  _ret = g_dbus_proxy_call_sync (G_DBUS_PROXY (proxy),\n"
                 )
-            self.outfile.write('    "%s",\n' '    g_variant_new ("(' % (m.name))
-            for a in m.in_args:
-                self.outfile.write("%s" % (a.format_in))
-            self.outfile.write(')"')
-            for a in m.in_args:
-                self.outfile.write(",\n                   arg_%s" % (a.name))
-            self.outfile.write("),\n")
+            self.outfile.write('    "%s",\n    ' % (m.name))
+            self.generate_tuple_new(m.in_args, "arg_")
+            self.outfile.write(",\n")
             if self.glib_min_required >= (2, 64):
                 self.outfile.write("    call_flags,\n" "    timeout_msec,\n")
             else:
@@ -2981,13 +3066,8 @@ class CodeGenerator:
                 "  if (_ret == NULL)\n"
                 "    goto _out;\n"
             )
-            self.outfile.write("  g_variant_get (_ret,\n" '                 "(')
-            for a in m.out_args:
-                self.outfile.write("%s" % (a.format_out))
-            self.outfile.write(')"')
-            for a in m.out_args:
-                self.outfile.write(",\n                 out_%s" % (a.name))
-            self.outfile.write(");\n" "  g_variant_unref (_ret);\n")
+            self.generate_tuple_get(m.out_args, "out_")
+            self.outfile.write("  g_variant_unref (_ret);\n")
             self.outfile.write("_out:\n" "  return _ret != NULL;\n" "}\n" "\n")
 
     # ---------------------------------------------------------------------------------------------------
@@ -3034,22 +3114,17 @@ class CodeGenerator:
             if m.unix_fd:
                 self.outfile.write(
                     "  g_dbus_method_invocation_return_value_with_unix_fd_list (invocation,\n"
-                    '    g_variant_new ("('
+                    "    "
                 )
             else:
                 self.outfile.write(
-                    "  g_dbus_method_invocation_return_value (invocation,\n"
-                    '    g_variant_new ("('
+                    "  g_dbus_method_invocation_return_value (invocation,\n" "    "
                 )
-            for a in m.out_args:
-                self.outfile.write("%s" % (a.format_in))
-            self.outfile.write(')"')
-            for a in m.out_args:
-                self.outfile.write(",\n                   %s" % (a.name))
+            self.generate_tuple_new(m.out_args, "")
             if m.unix_fd:
-                self.outfile.write("),\n    fd_list);\n")
+                self.outfile.write(",\n    fd_list);\n")
             else:
-                self.outfile.write("));\n")
+                self.outfile.write(");\n")
             self.outfile.write("}\n" "\n")
 
     # ---------------------------------------------------------------------------------------------------
@@ -4052,15 +4127,9 @@ class CodeGenerator:
                 "  connections = g_dbus_interface_skeleton_get_connections (G_DBUS_INTERFACE_SKELETON (skeleton));\n"
                 % (i.camel_name, i.ns_upper, i.name_upper)
             )
-            self.outfile.write(
-                "\n" '  signal_variant = g_variant_ref_sink (g_variant_new ("('
-            )
-            for a in s.args:
-                self.outfile.write("%s" % (a.format_in))
-            self.outfile.write(')"')
-            for a in s.args:
-                self.outfile.write(",\n                   arg_%s" % (a.name))
-            self.outfile.write("));\n")
+            self.outfile.write("\n" "  signal_variant = g_variant_ref_sink (")
+            self.generate_tuple_new(s.args, "arg_")
+            self.outfile.write(");\n")
 
             self.outfile.write(
                 "  for (l = connections; l != NULL; l = l->next)\n"
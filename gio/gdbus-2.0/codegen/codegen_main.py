@@ -214,6 +214,12 @@ def codegen_main():
         action="store_true",
         help="Generate a GDBusObjectManagerClient subclass when generating C code",
     )
+    arg_parser.add_argument(
+        "--c-generate-fast-marshalling",
+        action="store_true",
+        help="Pack and unpack method and signal arguments with type-specific "
+        "GVariant functions instead of format strings",
+    )
     arg_parser.add_argument(
         "--c-generate-autocleanup",
         choices=["none", "objects", "all"],
@@ -494,6 +500,7 @@ def codegen_main():
                 glib_min_required,
                 args.symbol_decorator_define,
                 outfile,
+                fast_marshalling=args.c_generate_fast_marshalling,
             )
             gen.generate()
 
@@ -32,6 +32,17 @@ g_dbus_action_group_sync (GDBusActionGroup  *group,
                           GCancellable      *cancellable,
                           GError           **error);
 
+/* Split version of g_dbus_action_group_sync() for callers that send
+ * the DescribeAll call themselves: subscribe before sending it, then
+ * pass the reply to g_dbus_action_group_sync_from_reply().
+ */
+void
+g_dbus_action_group_subscribe (GDBusActionGroup *group);
+
+void
+g_dbus_action_group_sync_from_reply (GDBusActionGroup *group,
+                                     GVariant         *reply);
+
 G_END_DECLS
 
 #endif 
@@ -507,6 +507,32 @@ g_dbus_action_group_get (GDBusConnection *connection,
   return group;
 }
 
+void
+g_dbus_action_group_subscribe (GDBusActionGroup *group)
+{
+  g_assert (group->subscription_id == 0);
+
+  group->subscription_id =
+    g_dbus_connection_signal_subscribe (group->connection, group->bus_name, "org.gtk.Actions", "Changed", group->object_path,
+                                        NULL, G_DBUS_SIGNAL_FLAGS_NONE, g_dbus_action_group_changed, group, NULL);
+}
+
+void
+g_dbus_action_group_sync_from_reply (GDBusActionGroup *group,
+                                     GVariant         *reply)
+{
+  GVariantIter *iter;
+  ActionInfo *action;
+
+  g_assert (group->actions == NULL);
+  group->actions = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, action_info_free);
+
+  g_variant_get (reply, "(a{s(bgav)})", &iter);
+  while ((action = action_info_new_from_iter (iter)))
+    g_hash_table_insert (group->actions, action->name, action);
+  g_variant_iter_free (iter);
+}
+
 gboolean
 g_dbus_action_group_sync (GDBusActionGroup  *group,
                           GCancellable      *cancellable,
@@ -514,11 +540,7 @@ g_dbus_action_group_sync (GDBusActionGroup  *group,
 {
   GVariant *reply;
 
-  g_assert (group->subscription_id == 0);
-
-  group->subscription_id =
-    g_dbus_connection_signal_subscribe (group->connection, group->bus_name, "org.gtk.Actions", "Changed", group->object_path,
-                                        NULL, G_DBUS_SIGNAL_FLAGS_NONE, g_dbus_action_group_changed, group, NULL);
+  g_dbus_action_group_subscribe (group);
 
   reply = g_dbus_connection_call_sync (group->connection, group->bus_name, group->object_path, "org.gtk.Actions",
                                        "DescribeAll", NULL, G_VARIANT_TYPE ("(a{s(bgav)})"),
@@ -526,16 +548,7 @@ g_dbus_action_group_sync (GDBusActionGroup  *group,
 
   if (reply != NULL)
     {
-      GVariantIter *iter;
-      ActionInfo *action;
-
-      g_assert (group->actions == NULL);
-      group->actions = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, action_info_free);
-
-      g_variant_get (reply, "(a{s(bgav)})", &iter);
-      while ((action = action_info_new_from_iter (iter)))
-        g_hash_table_insert (group->actions, action->name, action);
-      g_variant_iter_free (iter);
+      g_dbus_action_group_sync_from_reply (group, reply);
       g_variant_unref (reply);
     }
 
@@ -114,6 +114,7 @@
 #include "gasyncresult.h"
 #include "gtask.h"
 #include "gmarshal-internal.h"
+#include "gtrace-private.h"
 
 #ifdef G_OS_UNIX
 #include "gunixconnection.h"
@@ -128,7 +129,8 @@
    G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_ALLOW_ANONYMOUS | \
    G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION | \
    G_DBUS_CONNECTION_FLAGS_DELAY_MESSAGE_PROCESSING | \
-   G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_REQUIRE_SAME_USER)
+   G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_REQUIRE_SAME_USER | \
+   G_DBUS_CONNECTION_FLAGS_WORKER_POOL)
 
 /**
  * GDBusConnection:
@@ -359,6 +361,9 @@ struct SignalData
   GDBusSignalFlags flags;
   GPtrArray *subscribers;  /* (owned) (element-type SignalSubscriber) */
 
+  /* Order in which SignalData were added to their SignalDataIndex */
+  guint64 index_serial;
+
   /*
    * If the sender is a well-known name, this is an unowned SignalData
    * representing the NameOwnerChanged signal that tracks its owner.
@@ -432,6 +437,114 @@ signal_data_free (SignalData *signal_data)
   g_free (signal_data);
 }
 
+/*
+ * The SignalData expecting signals from one sender, split up by what they
+ * match on so that only the ones which can possibly match a signal have to
+ * be looked at: SignalData with an object path are indexed by it, the
+ * others by their member if they have one. Everything else is in @others.
+ * Each SignalData is in exactly one of the arrays, which are all in the
+ * order the SignalData were added.
+ */
+typedef struct
+{
+  GHashTable *by_object_path;  /* (owned) object path (gchar*) -> GPtrArray* of SignalData */
+  GHashTable *by_member;       /* (owned) member (gchar*) -> GPtrArray* of SignalData */
+  GPtrArray *others;           /* (owned) (element-type SignalData) */
+  guint n_signal_data;
+  guint64 next_serial;
+} SignalDataIndex;
+
+static SignalDataIndex *
+signal_data_index_new (void)
+{
+  SignalDataIndex *data_index = g_new0 (SignalDataIndex, 1);
+
+  data_index->by_object_path = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                      g_free, (GDestroyNotify) g_ptr_array_unref);
+  data_index->by_member = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                 g_free, (GDestroyNotify) g_ptr_array_unref);
+  data_index->others = g_ptr_array_new ();
+  return data_index;
+}
+
+static void
+signal_data_index_free (SignalDataIndex *data_index)
+{
+  g_hash_table_unref (data_index->by_object_path);
+  g_hash_table_unref (data_index->by_member);
+  g_ptr_array_unref (data_index->others);
+  g_free (data_index);
+}
+
+static void
+signal_data_index_add (SignalDataIndex *data_index,
+                       SignalData      *signal_data)
+{
+  GHashTable *table = NULL;
+  const gchar *key = NULL;
+  GPtrArray *array;
+
+  if (signal_data->object_path != NULL)
+    {
+      table = data_index->by_object_path;
+      key = signal_data->object_path;
+    }
+  else if (signal_data->member != NULL)
+    {
+      table = data_index->by_member;
+      key = signal_data->member;
+    }
+
+  if (table == NULL)
+    {
+      array = data_index->others;
+    }
+  else
+    {
+      array = g_hash_table_lookup (table, key);
+      if (array == NULL)
+        {
+          array = g_ptr_array_new ();
+          g_hash_table_insert (table, g_strdup (key), array);
+        }
+    }
+
+  signal_data->index_serial = data_index->next_serial++;
+  g_ptr_array_add (array, signal_data);
+  data_index->n_signal_data++;
+}
+
+/* Returns %TRUE if @data_index is empty afterwards */
+static gboolean
+signal_data_index_remove (SignalDataIndex *data_index,
+                          SignalData      *signal_data)
+{
+  GHashTable *table = NULL;
+  const gchar *key = NULL;
+  GPtrArray *array;
+
+  if (signal_data->object_path != NULL)
+    {
+      table = data_index->by_object_path;
+      key = signal_data->object_path;
+    }
+  else if (signal_data->member != NULL)
+    {
+      table = data_index->by_member;
+      key = signal_data->member;
+    }
+
+  array = table != NULL ? g_hash_table_lookup (table, key) : data_index->others;
+  g_return_val_if_fail (array != NULL, FALSE);
+  g_return_val_if_fail (g_ptr_array_remove (array, signal_data), FALSE);
+  data_index->n_signal_data--;
+
+  if (table != NULL && array->len == 0)
+    g_hash_table_remove (table, key);
+
+  return data_index->n_signal_data == 0;
+}
+
 /* ---------------------------------------------------------------------------------------------------- */
 
 #ifdef G_OS_WIN32
@@ -557,7 +670,7 @@ struct _GDBusConnection
   /* Maps used for managing signal subscription, protected by @lock */
   GHashTable *map_rule_to_signal_data;                      /* match rule (gchar*)    -> SignalData */
   GHashTable *map_id_to_signal_data;                        /* id (guint)             -> SignalData */
-  GHashTable *map_sender_unique_name_to_signal_data_array;  /* unique sender (gchar*) -> GPtrArray* of SignalData */
+  GHashTable *map_sender_unique_name_to_signal_data_index;  /* unique sender (gchar*) -> SignalDataIndex* */
 
   /* Maps used for managing exported objects and subtrees,
    * protected by @lock
@@ -573,6 +686,15 @@ struct _GDBusConnection
   /* Structure used for message filters, protected by @lock */
   GPtrArray *filters;
 
+  /* Message statistics, see g_dbus_connection_set_statistics_enabled().
+   * @statistics_enabled may be read at any time, the maps are protected
+   * by @statistics_lock and are %NULL until statistics are first enabled.
+   */
+  gint statistics_enabled;  /* (atomic) */
+  GMutex statistics_lock;
+  GHashTable *map_member_to_statistics;  /* "interface.member" (gchar*) -> MessageStatistics* */
+  GHashTable *map_peer_to_statistics;    /* unique name (gchar*)        -> MessageStatistics* */
+
   /* Capabilities negotiated during authentication
    * Read-only after initable_init(), so it may be read without holding a
    * lock, if you check for initialization first.
@@ -805,7 +927,7 @@ g_dbus_connection_finalize (GObject *object)
 
   g_hash_table_unref (connection->map_rule_to_signal_data);
   g_hash_table_unref (connection->map_id_to_signal_data);
-  g_hash_table_unref (connection->map_sender_unique_name_to_signal_data_array);
+  g_hash_table_unref (connection->map_sender_unique_name_to_signal_data_index);
 
   g_hash_table_unref (connection->map_id_to_ei);
   g_hash_table_unref (connection->map_object_path_to_eo);
@@ -818,6 +940,10 @@ g_dbus_connection_finalize (GObject *object)
 
   g_free (connection->machine_id);
 
+  g_clear_pointer (&connection->map_member_to_statistics, g_hash_table_unref);
+  g_clear_pointer (&connection->map_peer_to_statistics, g_hash_table_unref);
+  g_mutex_clear (&connection->statistics_lock);
+
   g_mutex_clear (&connection->init_lock);
   g_mutex_clear (&connection->lock);
 
@@ -1186,6 +1312,7 @@ g_dbus_connection_init (GDBusConnection *connection)
 {
   g_mutex_init (&connection->lock);
   g_mutex_init (&connection->init_lock);
+  g_mutex_init (&connection->statistics_lock);
 
   connection->map_method_serial_to_task = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_object_unref);
   connection->map_method_serial_to_name_watcher = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, NULL);
@@ -1194,10 +1321,10 @@ g_dbus_connection_init (GDBusConnection *connection)
                                                           g_str_equal);
   connection->map_id_to_signal_data = g_hash_table_new (g_direct_hash,
                                                         g_direct_equal);
-  connection->map_sender_unique_name_to_signal_data_array = g_hash_table_new_full (g_str_hash,
+  connection->map_sender_unique_name_to_signal_data_index = g_hash_table_new_full (g_str_hash,
                                                                                    g_str_equal,
                                                                                    g_free,
-                                                                                   (GDestroyNotify) g_ptr_array_unref);
+                                                                                   (GDestroyNotify) signal_data_index_free);
 
   connection->map_object_path_to_eo = g_hash_table_new_full (g_str_hash,
                                                              g_str_equal,
@@ -1722,6 +1849,287 @@ g_dbus_connection_get_last_serial (GDBusConnection *connection)
 
 /* ---------------------------------------------------------------------------------------------------- */
 
+typedef struct
+{
+  guint64 messages_in;
+  guint64 bytes_in;
+  guint64 messages_out;
+  guint64 bytes_out;
+  guint64 handler_calls;
+  guint64 handler_time;       /* microseconds, summed over handler_calls */
+  guint64 queue_latency;      /* microseconds, summed over handler_calls */
+  guint64 max_queue_latency;  /* microseconds */
+} MessageStatistics;
+
+static inline gboolean
+statistics_enabled (GDBusConnection *connection)
+{
+  return G_UNLIKELY (g_atomic_int_get (&connection->statistics_enabled));
+}
+
+/* called with @statistics_lock held; @key is owned by the caller */
+static MessageStatistics *
+statistics_lookup_unlocked (GHashTable  *map,
+                            const gchar *key)
+{
+  MessageStatistics *stats;
+
+  stats = g_hash_table_lookup (map, key);
+  if (stats == NULL)
+    {
+      stats = g_new0 (MessageStatistics, 1);
+      g_hash_table_insert (map, g_strdup (key), stats);
+    }
+
+  return stats;
+}
+
+static gchar *
+statistics_member_key (const gchar *interface_name,
+                       const gchar *member)
+{
+  if (interface_name == NULL)
+    return g_strdup (member);
+  return g_strconcat (interface_name, ".", member, NULL);
+}
+
+/* Called in any thread, with @lock possibly held.
+ *
+ * Incoming messages are counted against their sender, outgoing ones against
+ * their destination. Replies and errors have no member, so they only count
+ * towards the peer. */
+static void
+statistics_record_message (GDBusConnection *connection,
+                           GDBusMessage    *message,
+                           gsize            size,
+                           gboolean         incoming)
+{
+  const gchar *member;
+  const gchar *peer;
+  gchar *member_key = NULL;
+
+  member = g_dbus_message_get_member (message);
+  peer = incoming ? g_dbus_message_get_sender (message) : g_dbus_message_get_destination (message);
+
+  if (member != NULL)
+    member_key = statistics_member_key (g_dbus_message_get_interface (message), member);
+
+  g_mutex_lock (&connection->statistics_lock);
+  if (connection->map_member_to_statistics != NULL)
+    {
+      MessageStatistics *stats[2] = { NULL, NULL };
+      gsize n;
+
+      if (member_key != NULL)
+        stats[0] = statistics_lookup_unlocked (connection->map_member_to_statistics, member_key);
+      if (peer != NULL)
+        stats[1] = statistics_lookup_unlocked (connection->map_peer_to_statistics, peer);
+
+      for (n = 0; n < G_N_ELEMENTS (stats); n++)
+        {
+          if (stats[n] == NULL)
+            continue;
+          if (incoming)
+            {
+              stats[n]->messages_in++;
+              stats[n]->bytes_in += size;
+            }
+          else
+            {
+              stats[n]->messages_out++;
+              stats[n]->bytes_out += size;
+            }
+        }
+    }
+  g_mutex_unlock (&connection->statistics_lock);
+
+  g_free (member_key);
+}
+
+/* Called in the thread the handler ran in, with no locks held. @queued_time
+ * is when the message was scheduled for dispatch in the worker thread, and
+ * @start_time and @end_time bracket the handler, all in monotonic time. */
+static void
+statistics_record_handler (GDBusConnection *connection,
+                           const gchar     *sender,
+                           const gchar     *interface_name,
+                           const gchar     *member,
+                           gint64           queued_time,
+                           gint64           start_time,
+                           gint64           end_time)
+{
+  gchar *member_key;
+  guint64 latency;
+
+  member_key = statistics_member_key (interface_name, member);
+  latency = start_time > queued_time ? start_time - queued_time : 0;
+
+  g_mutex_lock (&connection->statistics_lock);
+  if (connection->map_member_to_statistics != NULL)
+    {
+      MessageStatistics *stats[2] = { NULL, NULL };
+      gsize n;
+
+      stats[0] = statistics_lookup_unlocked (connection->map_member_to_statistics, member_key);
+      if (sender != NULL)
+        stats[1] = statistics_lookup_unlocked (connection->map_peer_to_statistics, sender);
+
+      for (n = 0; n < G_N_ELEMENTS (stats); n++)
+        {
+          if (stats[n] == NULL)
+            continue;
+          stats[n]->handler_calls++;
+          stats[n]->handler_time += end_time - start_time;
+          stats[n]->queue_latency += latency;
+          stats[n]->max_queue_latency = MAX (stats[n]->max_queue_latency, latency);
+        }
+    }
+  g_mutex_unlock (&connection->statistics_lock);
+
+  g_free (member_key);
+}
+
+/* called with @statistics_lock held */
+static GVariant *
+statistics_map_to_variant_unlocked (GHashTable *map)
+{
+  GVariantBuilder builder;
+  GHashTableIter iter;
+  const gchar *key;
+  MessageStatistics *stats;
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sa{st}}"));
+
+  if (map != NULL)
+    {
+      g_hash_table_iter_init (&iter, map);
+      while (g_hash_table_iter_next (&iter, (gpointer *) &key, (gpointer *) &stats))
+        {
+          g_variant_builder_open (&builder, G_VARIANT_TYPE ("{sa{st}}"));
+          g_variant_builder_add (&builder, "s", key);
+          g_variant_builder_open (&builder, G_VARIANT_TYPE ("a{st}"));
+          g_variant_builder_add (&builder, "{st}", "messages-in", stats->messages_in);
+          g_variant_builder_add (&builder, "{st}", "bytes-in", stats->bytes_in);
+          g_variant_builder_add (&builder, "{st}", "messages-out", stats->messages_out);
+          g_variant_builder_add (&builder, "{st}", "bytes-out", stats->bytes_out);
+          g_variant_builder_add (&builder, "{st}", "handler-calls", stats->handler_calls);
+          g_variant_builder_add (&builder, "{st}", "handler-time", stats->handler_time);
+          g_variant_builder_add (&builder, "{st}", "queue-latency", stats->queue_latency);
+          g_variant_builder_add (&builder, "{st}", "max-queue-latency", stats->max_queue_latency);
+          g_variant_builder_close (&builder);
+          g_variant_builder_close (&builder);
+        }
+    }
+
+  return g_variant_builder_end (&builder);
+}
+
+/**
+ * g_dbus_connection_set_statistics_enabled:
+ * @connection: a #GDBusConnection
+ * @enabled: whether to collect message statistics
+ *
+ * Sets whether @connection collects statistics about the messages it sends
+ * and receives, which can be retrieved with
+ * g_dbus_connection_get_statistics().
+ *
+ * Enabling statistics discards any previously collected ones. Disabling
+ * them stops the collection but keeps the current values available.
+ *
+ * Collecting statistics adds a small cost to every message, so it is
+ * disabled by default. A #GDebugControllerDBus enables it on its connection
+ * while debug output is enabled.
+ *
+ * Since: 2.82
+ */
+void
+g_dbus_connection_set_statistics_enabled (GDBusConnection *connection,
+                                          gboolean         enabled)
+{
+  g_return_if_fail (G_IS_DBUS_CONNECTION (connection));
+
+  enabled = !!enabled;
+
+  g_mutex_lock (&connection->statistics_lock);
+  if (enabled && !g_atomic_int_get (&connection->statistics_enabled))
+    {
+      g_clear_pointer (&connection->map_member_to_statistics, g_hash_table_unref);
+      g_clear_pointer (&connection->map_peer_to_statistics, g_hash_table_unref);
+      connection->map_member_to_statistics = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+      connection->map_peer_to_statistics = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+    }
+  g_atomic_int_set (&connection->statistics_enabled, enabled);
+  g_mutex_unlock (&connection->statistics_lock);
+}
+
+/**
+ * g_dbus_connection_get_statistics_enabled:
+ * @connection: a #GDBusConnection
+ *
+ * Gets whether @connection collects message statistics. See
+ * g_dbus_connection_set_statistics_enabled().
+ *
+ * Returns: %TRUE if statistics are being collected
+ *
+ * Since: 2.82
+ */
+gboolean
+g_dbus_connection_get_statistics_enabled (GDBusConnection *connection)
+{
+  g_return_val_if_fail (G_IS_DBUS_CONNECTION (connection), FALSE);
+
+  return g_atomic_int_get (&connection->statistics_enabled);
+}
+
+/**
+ * g_dbus_connection_get_statistics:
+ * @connection: a #GDBusConnection
+ *
+ * Gets the message statistics collected since they were last enabled with
+ * g_dbus_connection_set_statistics_enabled().
+ *
+ * The result is a dictionary of type `a{sv}` with two entries of type
+ * `a{sa{st}}`: `members`, keyed by `interface.member`, and `peers`, keyed
+ * by the unique name of the remote peer. Each of them maps to a dictionary
+ * with the following counters:
+ *
+ * - `messages-in`, `bytes-in`: messages received and their size
+ * - `messages-out`, `bytes-out`: messages sent and their size
+ * - `handler-calls`: number of method handlers and signal callbacks run
+ * - `handler-time`: total time spent in them, in microseconds
+ * - `queue-latency`: total time between a message being received and its
+ *   handler being run, in microseconds
+ * - `max-queue-latency`: the largest such time, in microseconds
+ *
+ * Method replies and errors have no member, so they only appear under
+ * `peers`. Messages on peer-to-peer connections have no sender or
+ * destination, so they only appear under `members`.
+ *
+ * Returns: (transfer floating): the statistics
+ *
+ * Since: 2.82
+ */
+GVariant *
+g_dbus_connection_get_statistics (GDBusConnection *connection)
+{
+  GVariantBuilder builder;
+
+  g_return_val_if_fail (G_IS_DBUS_CONNECTION (connection), NULL);
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
+
+  g_mutex_lock (&connection->statistics_lock);
+  g_variant_builder_add (&builder, "{sv}", "members",
+                         statistics_map_to_variant_unlocked (connection->map_member_to_statistics));
+  g_variant_builder_add (&builder, "{sv}", "peers",
+                         statistics_map_to_variant_unlocked (connection->map_peer_to_statistics));
+  g_mutex_unlock (&connection->statistics_lock);
+
+  return g_variant_builder_end (&builder);
+}
+
+/* ---------------------------------------------------------------------------------------------------- */
+
 /* Can be called by any thread, with the connection lock held */
 static gboolean
 g_dbus_connection_send_message_unlocked (GDBusConnection   *connection,
@@ -1761,6 +2169,9 @@ g_dbus_connection_send_message_unlocked (GDBusConnection   *connection,
   if (blob == NULL)
     return FALSE;
 
+  if (statistics_enabled (connection))
+    statistics_record_message (connection, message, blob_size, FALSE);
+
   if (flags & G_DBUS_SEND_MESSAGE_FLAGS_PRESERVE_SERIAL)
     serial_to_use = g_dbus_message_get_serial (message);
   else
@@ -1882,6 +2293,12 @@ typedef struct
   GSource *timeout_source;  /* (owned) (nullable) */
 
   gboolean delivered;
+
+#ifdef HAVE_SYSPROF
+  /* For the span from sending the call to its reply */
+  gint64 begin_time_nsec;
+  GDBusMessage *message;  /* (owned) */
+#endif
 } SendMessageData;
 
 /* Can be called from any thread with or without lock held */
@@ -1892,9 +2309,38 @@ send_message_data_free (SendMessageData *data)
   g_assert (data->timeout_source == NULL);
   g_assert (data->cancellable_handler_id == 0);
 
+#ifdef HAVE_SYSPROF
+  g_clear_object (&data->message);
+#endif
+
   g_slice_free (SendMessageData, data);
 }
 
+/* Can be called from any thread with or without lock held */
+static void
+send_message_data_trace (SendMessageData *data,
+                         const char      *outcome)
+{
+#ifdef HAVE_SYSPROF
+  const char *interface_name;
+
+  /* Only method calls are traced */
+  if (data->message == NULL)
+    return;
+
+  interface_name = g_dbus_message_get_interface (data->message);
+  g_trace_mark (data->begin_time_nsec, G_TRACE_CURRENT_TIME - data->begin_time_nsec,
+                "GIO", "GDBusConnection.call",
+                "%s%s%s on %s ⇒ %s",
+                interface_name ? interface_name : "",
+                interface_name ? "." : "",
+                g_dbus_message_get_member (data->message),
+                g_dbus_message_get_path (data->message),
+                outcome);
+  g_clear_object (&data->message);
+#endif
+}
+
 /* ---------------------------------------------------------------------------------------------------- */
 
 /* can be called from any thread with lock held; @task is (transfer none) */
@@ -1946,6 +2392,10 @@ send_message_data_deliver_reply_unlocked (GTask           *task,
   if (data->delivered)
     goto out;
 
+  send_message_data_trace (data,
+                           g_dbus_message_get_message_type (reply) == G_DBUS_MESSAGE_TYPE_ERROR ?
+                           g_dbus_message_get_error_name (reply) : "reply");
+
   g_task_return_pointer (task, g_object_ref (reply), g_object_unref);
 
   send_message_with_reply_cleanup (task, TRUE);
@@ -1978,6 +2428,8 @@ send_message_data_deliver_error (GTask      *task,
   send_message_with_reply_cleanup (task, TRUE);
   CONNECTION_UNLOCK (connection);
 
+  send_message_data_trace (data, message);
+
   g_task_return_new_error_literal (task, domain, code, message);
   g_object_unref (task);
 }
@@ -2053,6 +2505,11 @@ g_dbus_connection_send_message_with_reply_unlocked (GDBusConnection     *connect
     timeout_msec = 25 * 1000;
 
   data = g_slice_new0 (SendMessageData);
+#ifdef HAVE_SYSPROF
+  data->begin_time_nsec = G_TRACE_CURRENT_TIME;
+  if (g_dbus_message_get_message_type (message) == G_DBUS_MESSAGE_TYPE_METHOD_CALL)
+    data->message = g_object_ref (message);
+#endif
   task = g_task_new (connection, cancellable, callback, user_data);
   g_task_set_source_tag (task,
                          g_dbus_connection_send_message_with_reply_unlocked);
@@ -2593,6 +3050,9 @@ on_worker_message_received (GDBusWorker  *worker,
 
   //g_debug ("in on_worker_message_received");
 
+  if (statistics_enabled (connection))
+    statistics_record_message (connection, message, _g_dbus_message_get_blob_size (message), TRUE);
+
   g_object_ref (message);
   g_dbus_message_lock (message);
 
@@ -2742,6 +3202,8 @@ cancel_method_on_close (gpointer key, gpointer value, gpointer user_data)
   if (data->delivered)
     return FALSE;
 
+  send_message_data_trace (data, "closed");
+
   g_task_return_new_error_literal (task,
                                    G_IO_ERROR,
                                    G_IO_ERROR_CLOSED,
@@ -2951,6 +3413,7 @@ initable_init (GInitable     *initable,
   connection->worker = _g_dbus_worker_new (connection->stream,
                                            connection->capabilities,
                                            ((connection->flags & G_DBUS_CONNECTION_FLAGS_DELAY_MESSAGE_PROCESSING) != 0),
+                                           ((connection->flags & G_DBUS_CONNECTION_FLAGS_WORKER_POOL) != 0),
                                            on_worker_message_received,
                                            on_worker_message_about_to_be_sent,
                                            on_worker_closed,
@@ -3729,7 +4192,7 @@ add_signal_data (GDBusConnection *connection,
                  SignalData      *signal_data,
                  const char      *sender_unique_name)
 {
-  GPtrArray *signal_data_array;
+  SignalDataIndex *signal_data_index;
 
   g_hash_table_insert (connection->map_rule_to_signal_data,
                        signal_data->rule,
@@ -3746,16 +4209,16 @@ add_signal_data (GDBusConnection *connection,
         add_match_rule (connection, signal_data->rule);
     }
 
-  signal_data_array = g_hash_table_lookup (connection->map_sender_unique_name_to_signal_data_array,
+  signal_data_index = g_hash_table_lookup (connection->map_sender_unique_name_to_signal_data_index,
                                            sender_unique_name);
-  if (signal_data_array == NULL)
+  if (signal_data_index == NULL)
     {
-      signal_data_array = g_ptr_array_new ();
-      g_hash_table_insert (connection->map_sender_unique_name_to_signal_data_array,
+      signal_data_index = signal_data_index_new ();
+      g_hash_table_insert (connection->map_sender_unique_name_to_signal_data_index,
                            g_strdup (sender_unique_name),
-                           signal_data_array);
+                           signal_data_index);
     }
-  g_ptr_array_add (signal_data_array, signal_data);
+  signal_data_index_add (signal_data_index, signal_data);
 }
 
 /* ---------------------------------------------------------------------------------------------------- */
@@ -3992,7 +4455,7 @@ remove_signal_data_if_unused (GDBusConnection *connection,
                               SignalData *signal_data)
 {
   const gchar *sender_unique_name;
-  GPtrArray *signal_data_array;
+  SignalDataIndex *signal_data_index;
 
   /* Cannot remove while there are still subscribers */
   if (signal_data->subscribers->len != 0)
@@ -4012,14 +4475,14 @@ remove_signal_data_if_unused (GDBusConnection *connection,
 
   g_warn_if_fail (g_hash_table_remove (connection->map_rule_to_signal_data, signal_data->rule));
 
-  signal_data_array = g_hash_table_lookup (connection->map_sender_unique_name_to_signal_data_array,
+  signal_data_index = g_hash_table_lookup (connection->map_sender_unique_name_to_signal_data_index,
                                            sender_unique_name);
-  g_warn_if_fail (signal_data_array != NULL);
-  g_warn_if_fail (g_ptr_array_remove (signal_data_array, signal_data));
+  g_warn_if_fail (signal_data_index != NULL);
 
-  if (signal_data_array->len == 0)
+  if (signal_data_index != NULL &&
+      signal_data_index_remove (signal_data_index, signal_data))
     {
-      g_warn_if_fail (g_hash_table_remove (connection->map_sender_unique_name_to_signal_data_array,
+      g_warn_if_fail (g_hash_table_remove (connection->map_sender_unique_name_to_signal_data_index,
                                            sender_unique_name));
     }
 
@@ -4144,6 +4607,7 @@ typedef struct
   const gchar         *path;
   const gchar         *interface;
   const gchar         *member;
+  gint64               queued_time;  /* 0 unless statistics are enabled */
 } SignalInstance;
 
 /* called on delivery thread (e.g. where g_dbus_connection_signal_subscribe() was called) with
@@ -4186,13 +4650,29 @@ emit_signal_instance_in_idle_cb (gpointer data)
   CONNECTION_UNLOCK (signal_instance->connection);
 
   if (has_subscription)
-    signal_instance->subscriber->callback (signal_instance->connection,
-                                           signal_instance->sender,
-                                           signal_instance->path,
-                                           signal_instance->interface,
-                                           signal_instance->member,
-                                           parameters,
-                                           signal_instance->subscriber->user_data);
+    {
+      gint64 start_time = 0;
+
+      if (signal_instance->queued_time != 0)
+        start_time = g_get_monotonic_time ();
+
+      signal_instance->subscriber->callback (signal_instance->connection,
+                                             signal_instance->sender,
+                                             signal_instance->path,
+                                             signal_instance->interface,
+                                             signal_instance->member,
+                                             parameters,
+                                             signal_instance->subscriber->user_data);
+
+      if (signal_instance->queued_time != 0)
+        statistics_record_handler (signal_instance->connection,
+                                   signal_instance->sender,
+                                   signal_instance->interface,
+                                   signal_instance->member,
+                                   signal_instance->queued_time,
+                                   start_time,
+                                   g_get_monotonic_time ());
+    }
 
   g_variant_unref (parameters);
 
@@ -4245,27 +4725,147 @@ path_rule_matches (const gchar *path_a,
   return memcmp (path_a, path_b, MIN (len_a, len_b)) == 0;
 }
 
+/* called in GDBusWorker thread WITH lock held
+ *
+ * @sender is (nullable) for peer-to-peer connections */
+static void
+schedule_callbacks_for_signal_data (GDBusConnection *connection,
+                                    SignalData      *signal_data,
+                                    GDBusMessage    *message,
+                                    const gchar     *sender,
+                                    const gchar     *interface,
+                                    const gchar     *member,
+                                    const gchar     *path,
+                                    const gchar     *arg0,
+                                    const gchar     *arg0_path)
+{
+  guint m;
+  gint64 queued_time = 0;
+
+  if (signal_data->interface_name != NULL && g_strcmp0 (signal_data->interface_name, interface) != 0)
+    return;
+
+  if (signal_data->member != NULL && g_strcmp0 (signal_data->member, member) != 0)
+    return;
+
+  if (signal_data->object_path != NULL && g_strcmp0 (signal_data->object_path, path) != 0)
+    return;
+
+  if (signal_data->shared_name_watcher != NULL)
+    {
+      /* We want signals from a specified well-known name, which means
+       * the signal's sender needs to be the unique name that currently
+       * owns that well-known name, and we will have found this
+       * SignalData in
+       * connection->map_sender_unique_name_to_signal_data_index[""]. */
+      const WatchedName *watched_name;
+      const char *current_owner;
+
+      g_assert (signal_data->sender != NULL);
+      /* Invariant: We never need to watch for the owner of a unique
+       * name, or for the owner of DBUS_SERVICE_DBUS, either of which
+       * is always its own owner */
+      g_assert (!g_dbus_is_unique_name (signal_data->sender));
+      g_assert (g_strcmp0 (signal_data->sender, DBUS_SERVICE_DBUS) != 0);
+
+      watched_name = signal_data->shared_name_watcher->watched_name;
+      g_assert (watched_name != NULL);
+      current_owner = watched_name->owner;
+
+      /* Skip the signal if the actual sender is not known to own
+       * the required name */
+      if (current_owner == NULL || g_strcmp0 (current_owner, sender) != 0)
+        return;
+    }
+  else if (signal_data->sender != NULL)
+    {
+      /* We want signals from a unique name or o.fd.DBus... */
+      g_assert (g_dbus_is_unique_name (signal_data->sender)
+                || g_str_equal (signal_data->sender, DBUS_SERVICE_DBUS));
+
+      /* ... which means we must have found this SignalData in
+       * connection->map_sender_unique_name_to_signal_data_index[signal_data->sender],
+       * therefore we would only have found it if the signal's
+       * actual sender matches the required signal_data->sender */
+      g_assert (g_strcmp0 (signal_data->sender, sender) == 0);
+    }
+  /* else the sender is unspecified and we will accept anything */
+
+  if (signal_data->arg0 != NULL)
+    {
+      if (signal_data->flags & G_DBUS_SIGNAL_FLAGS_MATCH_ARG0_NAMESPACE)
+        {
+          if (arg0 == NULL || !namespace_rule_matches (signal_data->arg0, arg0))
+            return;
+        }
+      else if (signal_data->flags & G_DBUS_SIGNAL_FLAGS_MATCH_ARG0_PATH)
+        {
+          if ((arg0 == NULL || !path_rule_matches (signal_data->arg0, arg0)) &&
+              (arg0_path == NULL || !path_rule_matches (signal_data->arg0, arg0_path)))
+            return;
+        }
+      else if (arg0 == NULL || !g_str_equal (signal_data->arg0, arg0))
+        return;
+    }
+
+  if (signal_data->watched_name != NULL)
+    {
+      /* Invariant: SignalData should only have a watched_name if it
+       * represents the NameOwnerChanged signal */
+      g_assert (g_strcmp0 (sender, DBUS_SERVICE_DBUS) == 0);
+      g_assert (g_strcmp0 (interface, DBUS_INTERFACE_DBUS) == 0);
+      g_assert (g_strcmp0 (path, DBUS_PATH_DBUS) == 0);
+      g_assert (g_strcmp0 (member, "NameOwnerChanged") == 0);
+      name_watcher_deliver_name_owner_changed_unlocked (signal_data, message);
+    }
+
+  if (statistics_enabled (connection))
+    queued_time = g_get_monotonic_time ();
+
+  for (m = 0; m < signal_data->subscribers->len; m++)
+    {
+      SignalSubscriber *subscriber = signal_data->subscribers->pdata[m];
+      GSource *idle_source;
+      SignalInstance *signal_instance;
+
+      signal_instance = g_new0 (SignalInstance, 1);
+      signal_instance->subscriber = signal_subscriber_ref (subscriber);
+      signal_instance->message = g_object_ref (message);
+      signal_instance->connection = g_object_ref (connection);
+      signal_instance->sender = sender;
+      signal_instance->path = path;
+      signal_instance->interface = interface;
+      signal_instance->member = member;
+      signal_instance->queued_time = queued_time;
+
+      idle_source = g_idle_source_new ();
+      g_source_set_priority (idle_source, G_PRIORITY_DEFAULT);
+      g_source_set_callback (idle_source,
+                             emit_signal_instance_in_idle_cb,
+                             signal_instance,
+                             (GDestroyNotify) signal_instance_free);
+      g_source_set_static_name (idle_source, "[gio] emit_signal_instance_in_idle_cb");
+      g_source_attach (idle_source, subscriber->context);
+      g_source_unref (idle_source);
+    }
+}
+
 /* called in GDBusWorker thread WITH lock held
  *
  * @sender is (nullable) for peer-to-peer connections */
 static void
 schedule_callbacks (GDBusConnection *connection,
-                    GPtrArray       *signal_data_array,
+                    SignalDataIndex *signal_data_index,
                     GDBusMessage    *message,
                     const gchar     *sender)
 {
-  guint n, m;
   const gchar *interface;
   const gchar *member;
   const gchar *path;
   const gchar *arg0;
   const gchar *arg0_path;
-
-  interface = NULL;
-  member = NULL;
-  path = NULL;
-  arg0 = NULL;
-  arg0_path = NULL;
+  GPtrArray *arrays[3];
+  guint positions[3] = { 0, };
 
   interface = g_dbus_message_get_interface (message);
   member = g_dbus_message_get_member (message);
@@ -4276,129 +4876,40 @@ schedule_callbacks (GDBusConnection *connection,
   /* These two are mutually exclusive through the type system. */
   g_assert (arg0 == NULL || arg0_path == NULL);
 
-#if 0
-  g_print ("In schedule_callbacks:\n"
-           "  sender    = '%s'\n"
-           "  interface = '%s'\n"
-           "  member    = '%s'\n"
-           "  path      = '%s'\n"
-           "  arg0      = '%s'\n",
-           sender,
-           interface,
-           member,
-           path,
-           arg0);
-#endif
+  /* Only these SignalData can match, see SignalDataIndex */
+  arrays[0] = path != NULL ? g_hash_table_lookup (signal_data_index->by_object_path, path) : NULL;
+  arrays[1] = member != NULL ? g_hash_table_lookup (signal_data_index->by_member, member) : NULL;
+  arrays[2] = signal_data_index->others;
 
-  /* TODO: if this is slow, then we can change signal_data_array into
-   *       map_object_path_to_signal_data_array or something.
-   */
-  for (n = 0; n < signal_data_array->len; n++)
+  /* Merge the arrays, so that callbacks are still scheduled in the order
+   * the SignalData were added */
+  while (TRUE)
     {
-      SignalData *signal_data = signal_data_array->pdata[n];
+      SignalData *next = NULL;
+      guint next_array = 0;
+      guint i;
 
-      if (signal_data->interface_name != NULL && g_strcmp0 (signal_data->interface_name, interface) != 0)
-        continue;
-
-      if (signal_data->member != NULL && g_strcmp0 (signal_data->member, member) != 0)
-        continue;
-
-      if (signal_data->object_path != NULL && g_strcmp0 (signal_data->object_path, path) != 0)
-        continue;
-
-      if (signal_data->shared_name_watcher != NULL)
+      for (i = 0; i < G_N_ELEMENTS (arrays); i++)
         {
-          /* We want signals from a specified well-known name, which means
-           * the signal's sender needs to be the unique name that currently
-           * owns that well-known name, and we will have found this
-           * SignalData in
-           * connection->map_sender_unique_name_to_signal_data_array[""]. */
-          const WatchedName *watched_name;
-          const char *current_owner;
-
-          g_assert (signal_data->sender != NULL);
-          /* Invariant: We never need to watch for the owner of a unique
-           * name, or for the owner of DBUS_SERVICE_DBUS, either of which
-           * is always its own owner */
-          g_assert (!g_dbus_is_unique_name (signal_data->sender));
-          g_assert (g_strcmp0 (signal_data->sender, DBUS_SERVICE_DBUS) != 0);
-
-          watched_name = signal_data->shared_name_watcher->watched_name;
-          g_assert (watched_name != NULL);
-          current_owner = watched_name->owner;
-
-          /* Skip the signal if the actual sender is not known to own
-           * the required name */
-          if (current_owner == NULL || g_strcmp0 (current_owner, sender) != 0)
+          SignalData *signal_data;
+
+          if (arrays[i] == NULL || positions[i] >= arrays[i]->len)
             continue;
-        }
-      else if (signal_data->sender != NULL)
-        {
-          /* We want signals from a unique name or o.fd.DBus... */
-          g_assert (g_dbus_is_unique_name (signal_data->sender)
-                    || g_str_equal (signal_data->sender, DBUS_SERVICE_DBUS));
-
-          /* ... which means we must have found this SignalData in
-           * connection->map_sender_unique_name_to_signal_data_array[signal_data->sender],
-           * therefore we would only have found it if the signal's
-           * actual sender matches the required signal_data->sender */
-          g_assert (g_strcmp0 (signal_data->sender, sender) == 0);
-        }
-      /* else the sender is unspecified and we will accept anything */
 
-      if (signal_data->arg0 != NULL)
-        {
-          if (signal_data->flags & G_DBUS_SIGNAL_FLAGS_MATCH_ARG0_NAMESPACE)
-            {
-              if (arg0 == NULL || !namespace_rule_matches (signal_data->arg0, arg0))
-                continue;
-            }
-          else if (signal_data->flags & G_DBUS_SIGNAL_FLAGS_MATCH_ARG0_PATH)
+          signal_data = arrays[i]->pdata[positions[i]];
+          if (next == NULL || signal_data->index_serial < next->index_serial)
             {
-              if ((arg0 == NULL || !path_rule_matches (signal_data->arg0, arg0)) &&
-                  (arg0_path == NULL || !path_rule_matches (signal_data->arg0, arg0_path)))
-                continue;
+              next = signal_data;
+              next_array = i;
             }
-          else if (arg0 == NULL || !g_str_equal (signal_data->arg0, arg0))
-            continue;
         }
 
-      if (signal_data->watched_name != NULL)
-        {
-          /* Invariant: SignalData should only have a watched_name if it
-           * represents the NameOwnerChanged signal */
-          g_assert (g_strcmp0 (sender, DBUS_SERVICE_DBUS) == 0);
-          g_assert (g_strcmp0 (interface, DBUS_INTERFACE_DBUS) == 0);
-          g_assert (g_strcmp0 (path, DBUS_PATH_DBUS) == 0);
-          g_assert (g_strcmp0 (member, "NameOwnerChanged") == 0);
-          name_watcher_deliver_name_owner_changed_unlocked (signal_data, message);
-        }
+      if (next == NULL)
+        break;
 
-      for (m = 0; m < signal_data->subscribers->len; m++)
-        {
-          SignalSubscriber *subscriber = signal_data->subscribers->pdata[m];
-          GSource *idle_source;
-          SignalInstance *signal_instance;
-
-          signal_instance = g_new0 (SignalInstance, 1);
-          signal_instance->subscriber = signal_subscriber_ref (subscriber);
-          signal_instance->message = g_object_ref (message);
-          signal_instance->connection = g_object_ref (connection);
-          signal_instance->sender = sender;
-          signal_instance->path = path;
-          signal_instance->interface = interface;
-          signal_instance->member = member;
-
-          idle_source = g_idle_source_new ();
-          g_source_set_priority (idle_source, G_PRIORITY_DEFAULT);
-          g_source_set_callback (idle_source,
-                                 emit_signal_instance_in_idle_cb,
-                                 signal_instance,
-                                 (GDestroyNotify) signal_instance_free);
-          g_source_set_static_name (idle_source, "[gio] emit_signal_instance_in_idle_cb");
-          g_source_attach (idle_source, subscriber->context);
-          g_source_unref (idle_source);
-        }
+      positions[next_array]++;
+      schedule_callbacks_for_signal_data (connection, next, message, sender,
+                                          interface, member, path, arg0, arg0_path);
     }
 }
 
@@ -4407,7 +4918,7 @@ static void
 distribute_signals (GDBusConnection *connection,
                     GDBusMessage    *message)
 {
-  GPtrArray *signal_data_array;
+  SignalDataIndex *signal_data_index;
   const gchar *sender, *interface, *member, *path;
 
   g_assert (g_dbus_message_get_message_type (message) == G_DBUS_MESSAGE_TYPE_SIGNAL);
@@ -4440,15 +4951,15 @@ distribute_signals (GDBusConnection *connection,
   /* collect subscribers that match on sender */
   if (sender != NULL)
     {
-      signal_data_array = g_hash_table_lookup (connection->map_sender_unique_name_to_signal_data_array, sender);
-      if (signal_data_array != NULL)
-        schedule_callbacks (connection, signal_data_array, message, sender);
+      signal_data_index = g_hash_table_lookup (connection->map_sender_unique_name_to_signal_data_index, sender);
+      if (signal_data_index != NULL)
+        schedule_callbacks (connection, signal_data_index, message, sender);
     }
 
   /* collect subscribers not matching on sender, or matching a well-known name */
-  signal_data_array = g_hash_table_lookup (connection->map_sender_unique_name_to_signal_data_array, "");
-  if (signal_data_array != NULL)
-    schedule_callbacks (connection, signal_data_array, message, sender);
+  signal_data_index = g_hash_table_lookup (connection->map_sender_unique_name_to_signal_data_index, "");
+  if (signal_data_index != NULL)
+    schedule_callbacks (connection, signal_data_index, message, sender);
 }
 
 /* ---------------------------------------------------------------------------------------------------- */
@@ -5431,6 +5942,8 @@ call_in_idle_cb (gpointer user_data)
   guint subtree_registration_id;
   ExportedInterface *ei = NULL;
   ExportedSubtree *es = NULL;
+  const gint64 *queued_time;
+  gint64 start_time = 0;
 
   registration_id = GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (invocation), "g-dbus-registration-id"));
   subtree_registration_id = GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (invocation), "g-dbus-subtree-registration-id"));
@@ -5455,6 +5968,10 @@ call_in_idle_cb (gpointer user_data)
   vtable = g_object_get_data (G_OBJECT (invocation), "g-dbus-interface-vtable");
   g_assert (vtable != NULL && vtable->method_call != NULL);
 
+  queued_time = g_object_get_data (G_OBJECT (invocation), "g-dbus-queued-time");
+  if (queued_time != NULL)
+    start_time = g_get_monotonic_time ();
+
   vtable->method_call (g_dbus_method_invocation_get_connection (invocation),
                        g_dbus_method_invocation_get_sender (invocation),
                        g_dbus_method_invocation_get_object_path (invocation),
@@ -5464,6 +5981,15 @@ call_in_idle_cb (gpointer user_data)
                        g_object_ref (invocation),
                        g_dbus_method_invocation_get_user_data (invocation));
 
+  if (queued_time != NULL)
+    statistics_record_handler (g_dbus_method_invocation_get_connection (invocation),
+                               g_dbus_method_invocation_get_sender (invocation),
+                               g_dbus_method_invocation_get_interface_name (invocation),
+                               g_dbus_method_invocation_get_method_name (invocation),
+                               *queued_time,
+                               start_time,
+                               g_get_monotonic_time ());
+
  out:
   g_clear_pointer (&ei, exported_interface_unref);
   g_clear_pointer (&es, exported_subtree_unref);
@@ -5505,6 +6031,13 @@ schedule_method_call (GDBusConnection            *connection,
   g_object_set_data (G_OBJECT (invocation), "g-dbus-registration-id", GUINT_TO_POINTER (registration_id));
   g_object_set_data (G_OBJECT (invocation), "g-dbus-subtree-registration-id", GUINT_TO_POINTER (subtree_registration_id));
 
+  if (statistics_enabled (connection))
+    {
+      gint64 queued_time = g_get_monotonic_time ();
+      g_object_set_data_full (G_OBJECT (invocation), "g-dbus-queued-time",
+                              g_memdup2 (&queued_time, sizeof (queued_time)), g_free);
+    }
+
   idle_source = g_idle_source_new ();
   g_source_set_priority (idle_source, G_PRIORITY_DEFAULT);
   g_source_set_callback (idle_source,
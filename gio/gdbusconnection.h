@@ -685,6 +685,16 @@ void  g_dbus_connection_remove_filter (GDBusConnection    *connection,
 
 /* ---------------------------------------------------------------------------------------------------- */
 
+GIO_AVAILABLE_IN_2_82
+void      g_dbus_connection_set_statistics_enabled (GDBusConnection *connection,
+                                                    gboolean         enabled);
+GIO_AVAILABLE_IN_2_82
+gboolean  g_dbus_connection_get_statistics_enabled (GDBusConnection *connection);
+GIO_AVAILABLE_IN_2_82
+GVariant *g_dbus_connection_get_statistics         (GDBusConnection *connection);
+
+/* ---------------------------------------------------------------------------------------------------- */
+
 
 G_END_DECLS
 
@@ -53,6 +53,12 @@ struct _GDBusInterfaceSkeletonPrivate
   GSList                     *connections;   /* List of ConnectionData */
   gchar                      *object_path;   /* The object path for this skeleton */
   GDBusInterfaceVTable       *hooked_vtable;
+
+  /* Method invocations handled in threads, see
+   * g_dbus_interface_skeleton_set_max_threads() */
+  GThreadPool                *dispatch_pool;  /* (owned) (nullable) */
+  GHashTable                 *sender_queues;  /* (owned) (nullable) sender (gchar*) -> GQueue* of DispatchData */
+  gint                        num_pending_invocations;  /* (atomic) */
 };
 
 typedef struct
@@ -90,6 +96,11 @@ static void     skeleton_intercept_handle_method_call              (GDBusConnect
                                                                     GDBusMethodInvocation  *invocation,
                                                                     gpointer                user_data);
 
+typedef struct _DispatchData DispatchData;
+static void     dispatch_data_unref                                (DispatchData           *data);
+static void     dispatch_in_pool_func                              (gpointer                data,
+                                                                    gpointer                user_data);
+
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (GDBusInterfaceSkeleton, g_dbus_interface_skeleton, G_TYPE_OBJECT,
                                   G_ADD_PRIVATE (GDBusInterfaceSkeleton)
@@ -116,6 +127,12 @@ g_dbus_interface_skeleton_finalize (GObject *object)
 
   g_free (interface->priv->hooked_vtable);
 
+  /* Queued invocations hold a reference on the skeleton, so the pool and
+   * the sender queues are idle by now */
+  if (interface->priv->dispatch_pool != NULL)
+    g_thread_pool_free (interface->priv->dispatch_pool, TRUE, FALSE);
+  g_clear_pointer (&interface->priv->sender_queues, g_hash_table_unref);
+
   if (interface->priv->object != NULL)
     g_object_remove_weak_pointer (G_OBJECT (interface->priv->object), (gpointer *) &interface->priv->object);
 
@@ -312,6 +329,80 @@ g_dbus_interface_skeleton_set_flags (GDBusInterfaceSkeleton      *interface_,
     }
 }
 
+/**
+ * g_dbus_interface_skeleton_set_max_threads:
+ * @interface_: A #GDBusInterfaceSkeleton.
+ * @max_threads: the maximum number of threads, or 0
+ *
+ * Sets how many method invocations of @interface_ may be handled in
+ * threads at the same time.
+ *
+ * Method invocations are handled in threads if the
+ * %G_DBUS_INTERFACE_SKELETON_FLAGS_HANDLE_METHOD_INVOCATIONS_IN_THREAD flag
+ * is set, or if the #GDBusInterfaceSkeleton::g-authorize-method signal has
+ * to be emitted. By default they share the thread pool used by
+ * g_task_run_in_thread() with the rest of the process. Once @max_threads is
+ * set, @interface_ gets a thread pool of its own, so bursts of invocations
+ * neither wait behind unrelated tasks nor hold up other users of that pool.
+ * Passing 0 goes back to the default.
+ *
+ * Since: 2.82
+ */
+void
+g_dbus_interface_skeleton_set_max_threads (GDBusInterfaceSkeleton *interface_,
+                                           guint                   max_threads)
+{
+  GThreadPool *old_pool = NULL;
+
+  g_return_if_fail (G_IS_DBUS_INTERFACE_SKELETON (interface_));
+  g_return_if_fail (max_threads <= G_MAXINT);
+
+  g_mutex_lock (&interface_->priv->lock);
+  if (max_threads == 0)
+    {
+      old_pool = g_steal_pointer (&interface_->priv->dispatch_pool);
+    }
+  else if (interface_->priv->dispatch_pool == NULL)
+    {
+      interface_->priv->dispatch_pool = g_thread_pool_new_full (dispatch_in_pool_func,
+                                                                NULL,
+                                                                (GDestroyNotify) dispatch_data_unref,
+                                                                max_threads,
+                                                                FALSE,
+                                                                NULL);
+    }
+  else
+    {
+      g_thread_pool_set_max_threads (interface_->priv->dispatch_pool, max_threads, NULL);
+    }
+  g_mutex_unlock (&interface_->priv->lock);
+
+  /* Invocations already queued in the old pool are still handled */
+  if (old_pool != NULL)
+    g_thread_pool_free (old_pool, FALSE, FALSE);
+}
+
+/**
+ * g_dbus_interface_skeleton_get_num_pending_invocations:
+ * @interface_: A #GDBusInterfaceSkeleton.
+ *
+ * Gets the number of method invocations of @interface_ which are queued
+ * or being handled in threads, see
+ * g_dbus_interface_skeleton_set_max_threads(). This does not include
+ * invocations which have been returned to the context they arrived in.
+ *
+ * Returns: the number of pending method invocations
+ *
+ * Since: 2.82
+ */
+guint
+g_dbus_interface_skeleton_get_num_pending_invocations (GDBusInterfaceSkeleton *interface_)
+{
+  g_return_val_if_fail (G_IS_DBUS_INTERFACE_SKELETON (interface_), 0);
+
+  return g_atomic_int_get (&interface_->priv->num_pending_invocations);
+}
+
 /**
  * g_dbus_interface_skeleton_get_info:
  * @interface_: A #GDBusInterfaceSkeleton.
@@ -456,12 +547,15 @@ dbus_interface_interface_init (GDBusInterfaceIface *iface)
 
 /* ---------------------------------------------------------------------------------------------------- */
 
-typedef struct
+struct _DispatchData
 {
   gint ref_count;  /* (atomic) */
+  GDBusInterfaceSkeleton       *interface;  /* (owned) */
   GDBusInterfaceMethodCallFunc  method_call_func;
   GDBusMethodInvocation        *invocation;  /* (owned) */
-} DispatchData;
+  GMainContext                 *context;  /* (owned) context the invocation arrived in */
+  gboolean                      drain_sender_queue;  /* see dispatch_invocations_in_thread() */
+};
 
 static void
 dispatch_data_unref (DispatchData *data)
@@ -469,6 +563,8 @@ dispatch_data_unref (DispatchData *data)
   if (g_atomic_int_dec_and_test (&data->ref_count))
     {
       g_clear_object (&data->invocation);
+      g_main_context_unref (data->context);
+      g_object_unref (data->interface);
       g_slice_free (DispatchData, data);
     }
 }
@@ -495,14 +591,11 @@ dispatch_invoke_in_context_func (gpointer user_data)
   return FALSE;
 }
 
+/* called in a worker thread */
 static void
-dispatch_in_thread_func (GTask        *task,
-                         gpointer      source_object,
-                         gpointer      task_data,
-                         GCancellable *cancellable)
+dispatch_in_thread (DispatchData *data)
 {
-  DispatchData *data = task_data;
-  GDBusInterfaceSkeleton *interface = g_task_get_source_object (task);
+  GDBusInterfaceSkeleton *interface = data->interface;
   GDBusInterfaceSkeletonFlags flags;
   GDBusObject *object;
   gboolean authorized;
@@ -552,8 +645,8 @@ dispatch_in_thread_func (GTask        *task,
       else
         {
           /* bah, back to original context */
-          g_main_context_invoke_full (g_task_get_context (task),
-                                      g_task_get_priority (task),
+          g_main_context_invoke_full (data->context,
+                                      G_PRIORITY_DEFAULT,
                                       dispatch_invoke_in_context_func,
                                       dispatch_data_ref (data),
                                       (GDestroyNotify) dispatch_data_unref);
@@ -566,10 +659,96 @@ dispatch_in_thread_func (GTask        *task,
 
   if (object != NULL)
     g_object_unref (object);
+}
+
+/* called in a worker thread
+ *
+ * With %G_DBUS_INTERFACE_SKELETON_FLAGS_SERIALIZE_PER_SENDER, invocations
+ * from a sender arriving while one of its invocations is being handled are
+ * queued, and are handled afterwards in the same thread.
+ */
+static void
+dispatch_invocations_in_thread (DispatchData *data)
+{
+  GDBusInterfaceSkeletonPrivate *priv = data->interface->priv;
+  const gchar *sender = g_dbus_method_invocation_get_sender (data->invocation);
+  const gchar *sender_key = sender != NULL ? sender : "";
+
+  dispatch_in_thread (data);
+  g_atomic_int_add (&priv->num_pending_invocations, -1);
+
+  while (data->drain_sender_queue)
+    {
+      DispatchData *next;
+
+      g_mutex_lock (&priv->lock);
+      next = g_queue_pop_head (g_hash_table_lookup (priv->sender_queues, sender_key));
+      if (next == NULL)
+        g_hash_table_remove (priv->sender_queues, sender_key);
+      g_mutex_unlock (&priv->lock);
 
+      if (next == NULL)
+        break;
+
+      dispatch_in_thread (next);
+      g_atomic_int_add (&priv->num_pending_invocations, -1);
+      dispatch_data_unref (next);
+    }
+}
+
+static void
+dispatch_in_thread_func (GTask        *task,
+                         gpointer      source_object,
+                         gpointer      task_data,
+                         GCancellable *cancellable)
+{
+  dispatch_invocations_in_thread (task_data);
   g_task_return_boolean (task, TRUE);
 }
 
+static void
+dispatch_in_pool_func (gpointer data,
+                       gpointer user_data)
+{
+  dispatch_invocations_in_thread (data);
+  dispatch_data_unref (data);
+}
+
+/* Returns %FALSE if @data was queued behind another invocation from the
+ * same sender, see dispatch_invocations_in_thread() */
+static gboolean
+dispatch_data_start_serialized (DispatchData *data)
+{
+  GDBusInterfaceSkeletonPrivate *priv = data->interface->priv;
+  const gchar *sender = g_dbus_method_invocation_get_sender (data->invocation);
+  const gchar *sender_key = sender != NULL ? sender : "";
+  GQueue *queue;
+  gboolean start = TRUE;
+
+  g_mutex_lock (&priv->lock);
+  if (priv->flags & G_DBUS_INTERFACE_SKELETON_FLAGS_SERIALIZE_PER_SENDER)
+    {
+      if (priv->sender_queues == NULL)
+        priv->sender_queues = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                     g_free, (GDestroyNotify) g_queue_free);
+
+      queue = g_hash_table_lookup (priv->sender_queues, sender_key);
+      if (queue == NULL)
+        {
+          g_hash_table_insert (priv->sender_queues, g_strdup (sender_key), g_queue_new ());
+          data->drain_sender_queue = TRUE;
+        }
+      else
+        {
+          g_queue_push_tail (queue, data);
+          start = FALSE;
+        }
+    }
+  g_mutex_unlock (&priv->lock);
+
+  return start;
+}
+
 static void
 g_dbus_interface_method_dispatch_helper (GDBusInterfaceSkeleton       *interface,
                                          GDBusInterfaceMethodCallFunc  method_call_func,
@@ -626,20 +805,40 @@ g_dbus_interface_method_dispatch_helper (GDBusInterfaceSkeleton       *interface
     }
   else
     {
-      GTask *task;
       DispatchData *data;
 
       data = g_slice_new0 (DispatchData);
+      data->interface = g_object_ref (interface);
       data->method_call_func = method_call_func;
       data->invocation = g_object_ref (invocation);
+      data->context = g_main_context_ref_thread_default ();
       data->ref_count = 1;
 
-      task = g_task_new (interface, NULL, NULL, NULL);
-      g_task_set_source_tag (task, g_dbus_interface_method_dispatch_helper);
-      g_task_set_name (task, "[gio] D-Bus interface method dispatch");
-      g_task_set_task_data (task, data, (GDestroyNotify) dispatch_data_unref);
-      g_task_run_in_thread (task, dispatch_in_thread_func);
-      g_object_unref (task);
+      g_atomic_int_inc (&interface->priv->num_pending_invocations);
+
+      /* otherwise @data is now owned by a sender queue */
+      if (dispatch_data_start_serialized (data))
+        {
+          GThreadPool *pool;
+
+          g_mutex_lock (&interface->priv->lock);
+          pool = interface->priv->dispatch_pool;
+          if (pool != NULL)
+            g_thread_pool_push (pool, data, NULL);
+          g_mutex_unlock (&interface->priv->lock);
+
+          if (pool == NULL)
+            {
+              GTask *task;
+
+              task = g_task_new (interface, NULL, NULL, NULL);
+              g_task_set_source_tag (task, g_dbus_interface_method_dispatch_helper);
+              g_task_set_name (task, "[gio] D-Bus interface method dispatch");
+              g_task_set_task_data (task, data, (GDestroyNotify) dispatch_data_unref);
+              g_task_run_in_thread (task, dispatch_in_thread_func);
+              g_object_unref (task);
+            }
+        }
     }
 
   if (object != NULL)
@@ -86,6 +86,11 @@ GDBusInterfaceSkeletonFlags  g_dbus_interface_skeleton_get_flags       (GDBusInt
 GIO_AVAILABLE_IN_ALL
 void                         g_dbus_interface_skeleton_set_flags       (GDBusInterfaceSkeleton      *interface_,
                                                                         GDBusInterfaceSkeletonFlags  flags);
+GIO_AVAILABLE_IN_2_82
+void                         g_dbus_interface_skeleton_set_max_threads (GDBusInterfaceSkeleton      *interface_,
+                                                                        guint                        max_threads);
+GIO_AVAILABLE_IN_2_82
+guint        g_dbus_interface_skeleton_get_num_pending_invocations (GDBusInterfaceSkeleton      *interface_);
 GIO_AVAILABLE_IN_ALL
 GDBusInterfaceInfo          *g_dbus_interface_skeleton_get_info        (GDBusInterfaceSkeleton      *interface_);
 GIO_AVAILABLE_IN_ALL
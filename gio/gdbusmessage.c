@@ -73,6 +73,7 @@ struct _GMemoryBuffer
   gsize pos;
   gchar *data;
   GDataStreamByteOrder byte_order;
+  GBytes *bytes;  /* (nullable) holding @data, when reading */
 };
 
 static gboolean
@@ -502,6 +503,7 @@ struct _GDBusMessage
 #ifdef G_OS_UNIX
   GUnixFDList *fd_list;
 #endif
+  gsize blob_size;  /* 0 unless created from a blob */
 };
 
 enum
@@ -1659,6 +1661,11 @@ read_bytes (GMemoryBuffer  *mbuf,
   return result;
 }
 
+/* Arrays of fixed-size values at least this big are not copied out of
+ * messages parsed with g_dbus_message_new_from_bytes(). Below that, copying
+ * is cheaper than allocating another #GBytes. */
+#define ZERO_COPY_ARRAY_MIN_SIZE 4096
+
 /* if just_align==TRUE, don't read a value, just align the input stream wrt padding */
 
 /* returns a non-floating GVariant! */
@@ -1967,13 +1974,27 @@ parse_value_from_blob (GMemoryBuffer       *buf,
               if (array_data == NULL)
                 goto fail;
 
-              ret = g_variant_new_fixed_array (element_type, array_data, array_len / fixed_size, fixed_size);
+              /* Large arrays reference the message rather than being copied,
+               * unless they need swapping */
+              if (buf->bytes != NULL &&
+                  array_len >= ZERO_COPY_ARRAY_MIN_SIZE &&
+                  (fixed_size == 1 || !g_memory_buffer_is_byteswapped (buf)))
+                {
+                  GBytes *array_bytes;
 
-              if (g_memory_buffer_is_byteswapped (buf))
+                  array_bytes = g_bytes_new_from_bytes (buf->bytes,
+                                                        (const gchar *) array_data - buf->data,
+                                                        array_len);
+                  ret = g_variant_new_from_bytes (type, array_bytes, TRUE);
+                  g_bytes_unref (array_bytes);
+                }
+              else
                 {
-                  GVariant *tmp = g_variant_ref_sink (ret);
-                  ret = g_variant_byteswap (tmp);
-                  g_variant_unref (tmp);
+                  ret = g_variant_new_fixed_array (element_type, array_data, array_len / fixed_size, fixed_size);
+
+                  /* The array data was copied, so it can be swapped in place */
+                  if (g_memory_buffer_is_byteswapped (buf))
+                    ret = g_variant_byteswap_take (ret);
                 }
             }
           else
@@ -2314,30 +2335,12 @@ g_dbus_message_bytes_needed (guchar  *blob,
 
 /* ---------------------------------------------------------------------------------------------------- */
 
-/**
- * g_dbus_message_new_from_blob:
- * @blob: (array length=blob_len) (element-type guint8): A blob representing a binary D-Bus message.
- * @blob_len: The length of @blob.
- * @capabilities: A #GDBusCapabilityFlags describing what protocol features are supported.
- * @error: Return location for error or %NULL.
- *
- * Creates a new #GDBusMessage from the data stored at @blob. The byte
- * order that the message was in can be retrieved using
- * g_dbus_message_get_byte_order().
- *
- * If the @blob cannot be parsed, contains invalid fields, or contains invalid
- * headers, %G_IO_ERROR_INVALID_ARGUMENT will be returned.
- *
- * Returns: A new #GDBusMessage or %NULL if @error is set. Free with
- * g_object_unref().
- *
- * Since: 2.26
- */
-GDBusMessage *
-g_dbus_message_new_from_blob (guchar                *blob,
-                              gsize                  blob_len,
-                              GDBusCapabilityFlags   capabilities,
-                              GError               **error)
+static GDBusMessage *
+dbus_message_new_from_data (const guchar          *blob,
+                            gsize                  blob_len,
+                            GBytes                *bytes,
+                            GDBusCapabilityFlags   capabilities,
+                            GError               **error)
 {
   GError *local_error = NULL;
   GMemoryBuffer mbuf;
@@ -2352,14 +2355,12 @@ g_dbus_message_new_from_blob (guchar                *blob,
 
   /* TODO: check against @capabilities */
 
-  g_return_val_if_fail (blob != NULL, NULL);
-  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
-
   message = g_dbus_message_new ();
 
   memset (&mbuf, 0, sizeof (mbuf));
   mbuf.data = (gchar *)blob;
   mbuf.len = mbuf.valid_len = blob_len;
+  mbuf.bytes = bytes;
 
   endianness = g_memory_buffer_read_byte (&mbuf, &local_error);
   if (local_error)
@@ -2537,6 +2538,8 @@ g_dbus_message_new_from_blob (guchar                *blob,
       goto fail;
     }
 
+  message->blob_size = blob_len;
+
   return message;
 
 fail:
@@ -2545,6 +2548,72 @@ fail:
   return NULL;
 }
 
+/**
+ * g_dbus_message_new_from_blob:
+ * @blob: (array length=blob_len) (element-type guint8): A blob representing a binary D-Bus message.
+ * @blob_len: The length of @blob.
+ * @capabilities: A #GDBusCapabilityFlags describing what protocol features are supported.
+ * @error: Return location for error or %NULL.
+ *
+ * Creates a new #GDBusMessage from the data stored at @blob. The byte
+ * order that the message was in can be retrieved using
+ * g_dbus_message_get_byte_order().
+ *
+ * If the @blob cannot be parsed, contains invalid fields, or contains invalid
+ * headers, %G_IO_ERROR_INVALID_ARGUMENT will be returned.
+ *
+ * Returns: A new #GDBusMessage or %NULL if @error is set. Free with
+ * g_object_unref().
+ *
+ * Since: 2.26
+ */
+GDBusMessage *
+g_dbus_message_new_from_blob (guchar                *blob,
+                              gsize                  blob_len,
+                              GDBusCapabilityFlags   capabilities,
+                              GError               **error)
+{
+  g_return_val_if_fail (blob != NULL, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  return dbus_message_new_from_data (blob, blob_len, NULL, capabilities, error);
+}
+
+/**
+ * g_dbus_message_new_from_bytes:
+ * @bytes: A #GBytes holding a binary D-Bus message.
+ * @capabilities: A #GDBusCapabilityFlags describing what protocol features are supported.
+ * @error: Return location for error or %NULL.
+ *
+ * Creates a new #GDBusMessage from the data stored in @bytes, like
+ * g_dbus_message_new_from_blob().
+ *
+ * Large arrays of fixed-size values in the body of the message, such as
+ * `ay`, reference @bytes rather than being copied, as long as they don’t
+ * need to be byteswapped. This keeps @bytes alive for as long as the
+ * message body, or values taken from it, are.
+ *
+ * Returns: A new #GDBusMessage or %NULL if @error is set. Free with
+ * g_object_unref().
+ *
+ * Since: 2.82
+ */
+GDBusMessage *
+g_dbus_message_new_from_bytes (GBytes                *bytes,
+                               GDBusCapabilityFlags   capabilities,
+                               GError               **error)
+{
+  gconstpointer data;
+  gsize size;
+
+  g_return_val_if_fail (bytes != NULL, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  data = g_bytes_get_data (bytes, &size);
+
+  return dbus_message_new_from_data (data, size, bytes, capabilities, error);
+}
+
 /* ---------------------------------------------------------------------------------------------------- */
 
 static gsize
@@ -4035,3 +4104,15 @@ g_dbus_message_copy (GDBusMessage  *message,
 #endif
   return ret;
 }
+
+/* ---------------------------------------------------------------------------------------------------- */
+
+/* Used by the connection's message statistics. Returns the size of the blob
+ * @message was deserialized from, or 0 if it was constructed directly. */
+gsize
+_g_dbus_message_get_blob_size (GDBusMessage *message)
+{
+  g_return_val_if_fail (G_IS_DBUS_MESSAGE (message), 0);
+
+  return message->blob_size;
+}
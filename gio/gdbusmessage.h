@@ -184,6 +184,10 @@ GDBusMessage             *g_dbus_message_new_from_blob      (guchar
                                                              gsize                     blob_len,
                                                              GDBusCapabilityFlags      capabilities,
                                                              GError                  **error);
+GIO_AVAILABLE_IN_2_82
+GDBusMessage             *g_dbus_message_new_from_bytes     (GBytes                   *bytes,
+                                                             GDBusCapabilityFlags      capabilities,
+                                                             GError                  **error);
 
 GIO_AVAILABLE_IN_ALL
 gssize                    g_dbus_message_bytes_needed       (guchar                   *blob,
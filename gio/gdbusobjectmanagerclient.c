@@ -93,6 +93,19 @@
  * name owner (e.g. `:1.42`) and `NULL` even in the case where
  * the name of interest is atomically replaced
  *
+ * Creating proxies for every object up front can be slow for services
+ * exporting a large number of objects. With
+ * `G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_LAZY_PROXIES`, the reply to
+ * `GetManagedObjects()` is kept as is, and the proxies for an object are only
+ * created when it is first looked up, with
+ * [method@Gio.DBusObjectManager.get_object] or similar, or when a signal for it
+ * is received. [method@Gio.DBusObjectManager.get_objects] still creates all of
+ * them. Objects which are created this way don’t cause
+ * [signal@Gio.DBusObjectManager::object-added] signals, and the ones which
+ * have not been created yet don’t cause
+ * [signal@Gio.DBusObjectManager::object-removed] signals when the name owner
+ * vanishes. Since 2.82.
+ *
  * Ultimately, `GDBusObjectManagerClient` is used to obtain
  * [class@Gio.DBusProxy] instances. All signals (including the
  * `org.freedesktop.DBus.Properties::PropertiesChanged` signal)
@@ -142,6 +155,12 @@ struct _GDBusObjectManagerClientPrivate
 
   GHashTable *map_object_path_to_object_proxy;
 
+  /* With G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_LAZY_PROXIES: the objects from
+   * the GetManagedObjects() reply which have no proxies yet, and the name
+   * owner which sent it */
+  GHashTable *map_object_path_to_pending;  /* gchar* -> GVariant* of type a{sa{sv}} */
+  gchar *pending_name_owner;
+
   guint signal_subscription_id;
   gchar *match_rule;
 
@@ -199,6 +218,9 @@ static void process_get_all_result (GDBusObjectManagerClient *manager,
                                     GVariant          *value,
                                     const gchar       *name_owner);
 
+static GDBusObjectProxy *lookup_object_proxy_unlocked (GDBusObjectManagerClient *manager,
+                                                       const gchar              *object_path);
+
 static void
 g_dbus_object_manager_client_dispose (GObject *object)
 {
@@ -221,6 +243,8 @@ g_dbus_object_manager_client_finalize (GObject *object)
   maybe_unsubscribe_signals (manager);
 
   g_hash_table_unref (manager->priv->map_object_path_to_object_proxy);
+  g_clear_pointer (&manager->priv->map_object_path_to_pending, g_hash_table_unref);
+  g_free (manager->priv->pending_name_owner);
 
   if (manager->priv->control_proxy != NULL && manager->priv->signal_signal_id != 0)
     g_signal_handler_disconnect (manager->priv->control_proxy,
@@ -1014,7 +1038,7 @@ signal_cb (GDBusConnection *connection,
   GDBusInterface *interface;
 
   g_mutex_lock (&manager->priv->lock);
-  object_proxy = g_hash_table_lookup (manager->priv->map_object_path_to_object_proxy, object_path);
+  object_proxy = lookup_object_proxy_unlocked (manager, object_path);
   if (object_proxy == NULL)
     {
       g_mutex_unlock (&manager->priv->lock);
@@ -1345,6 +1369,8 @@ on_notify_g_name_owner (GObject    *object,
       /* remote manager changed; nuke all local proxies  */
       proxies = g_hash_table_steal_all_values (
         manager->priv->map_object_path_to_object_proxy);
+      g_clear_pointer (&manager->priv->map_object_path_to_pending, g_hash_table_unref);
+      g_clear_pointer (&manager->priv->pending_name_owner, g_free);
 
       g_mutex_unlock (&manager->priv->lock);
 
@@ -1513,28 +1539,28 @@ async_initable_iface_init (GAsyncInitableIface *async_initable_iface)
 
 /* ---------------------------------------------------------------------------------------------------- */
 
-static void
-add_interfaces (GDBusObjectManagerClient *manager,
-                const gchar       *object_path,
-                GVariant          *ifaces_and_properties,
-                const gchar       *name_owner)
+/* Called with @lock held. Returns the (unowned) object proxy for
+ * @object_path, creating it if needed. If @out_interface_added_signals is
+ * not %NULL, the interface proxies added to an existing object are
+ * appended to it, with a reference. */
+static GDBusObjectProxy *
+add_interfaces_unlocked (GDBusObjectManagerClient  *manager,
+                         const gchar               *object_path,
+                         GVariant                  *ifaces_and_properties,
+                         const gchar               *name_owner,
+                         gboolean                  *out_added,
+                         GList                    **out_interface_added_signals)
 {
   GDBusObjectProxy *op;
   gboolean added;
   GVariantIter iter;
   const gchar *interface_name;
   GVariant *properties;
-  GList *interface_added_signals, *l;
   GDBusProxy *interface_proxy;
 
-  g_return_if_fail (name_owner == NULL || g_dbus_is_unique_name (name_owner));
-
-  g_mutex_lock (&manager->priv->lock);
-
-  interface_added_signals = NULL;
   added = FALSE;
 
-  op = g_hash_table_lookup (manager->priv->map_object_path_to_object_proxy, object_path);
+  op = lookup_object_proxy_unlocked (manager, object_path);
   if (op == NULL)
     {
       GType object_proxy_type;
@@ -1554,9 +1580,11 @@ add_interfaces (GDBusObjectManagerClient *manager,
                          "g-connection", manager->priv->connection,
                          "g-object-path", object_path,
                          NULL);
+      g_hash_table_insert (manager->priv->map_object_path_to_object_proxy,
+                           g_strdup (object_path),
+                           op);
       added = TRUE;
     }
-  g_object_ref (op);
 
   g_variant_iter_init (&iter, ifaces_and_properties);
   while (g_variant_iter_next (&iter,
@@ -1626,19 +1654,42 @@ add_interfaces (GDBusObjectManagerClient *manager,
             }
 
           _g_dbus_object_proxy_add_interface (op, interface_proxy);
-          if (!added)
-            interface_added_signals = g_list_append (interface_added_signals, g_object_ref (interface_proxy));
+          if (!added && out_interface_added_signals != NULL)
+            *out_interface_added_signals = g_list_append (*out_interface_added_signals, g_object_ref (interface_proxy));
           g_object_unref (interface_proxy);
         }
       g_variant_unref (properties);
     }
 
-  if (added)
-    {
-      g_hash_table_insert (manager->priv->map_object_path_to_object_proxy,
-                           g_strdup (object_path),
-                           op);
-    }
+  if (out_added != NULL)
+    *out_added = added;
+
+  return op;
+}
+
+static void
+add_interfaces (GDBusObjectManagerClient *manager,
+                const gchar       *object_path,
+                GVariant          *ifaces_and_properties,
+                const gchar       *name_owner)
+{
+  GDBusObjectProxy *op;
+  gboolean added;
+  GList *interface_added_signals, *l;
+  GDBusProxy *interface_proxy;
+
+  g_return_if_fail (name_owner == NULL || g_dbus_is_unique_name (name_owner));
+
+  g_mutex_lock (&manager->priv->lock);
+
+  interface_added_signals = NULL;
+  op = add_interfaces_unlocked (manager,
+                                object_path,
+                                ifaces_and_properties,
+                                name_owner,
+                                &added,
+                                &interface_added_signals);
+  g_object_ref (op);
 
   g_mutex_unlock (&manager->priv->lock);
 
@@ -1659,6 +1710,39 @@ add_interfaces (GDBusObjectManagerClient *manager,
   g_object_unref (op);
 }
 
+/* Called with @lock held. Returns the (unowned) object proxy for
+ * @object_path, or %NULL if there is no such object. Objects still pending
+ * from a GetManagedObjects() reply get their proxies created here, without
+ * any signals being emitted. */
+static GDBusObjectProxy *
+lookup_object_proxy_unlocked (GDBusObjectManagerClient *manager,
+                              const gchar              *object_path)
+{
+  GDBusObjectProxy *op;
+  GVariant *ifaces_and_properties;
+
+  op = g_hash_table_lookup (manager->priv->map_object_path_to_object_proxy, object_path);
+  if (op != NULL || manager->priv->map_object_path_to_pending == NULL)
+    return op;
+
+  ifaces_and_properties = g_hash_table_lookup (manager->priv->map_object_path_to_pending, object_path);
+  if (ifaces_and_properties == NULL)
+    return NULL;
+
+  g_variant_ref (ifaces_and_properties);
+  g_hash_table_remove (manager->priv->map_object_path_to_pending, object_path);
+
+  op = add_interfaces_unlocked (manager,
+                                object_path,
+                                ifaces_and_properties,
+                                manager->priv->pending_name_owner,
+                                NULL,
+                                NULL);
+  g_variant_unref (ifaces_and_properties);
+
+  return op;
+}
+
 static void
 remove_interfaces (GDBusObjectManagerClient   *manager,
                    const gchar         *object_path,
@@ -1672,7 +1756,7 @@ remove_interfaces (GDBusObjectManagerClient   *manager,
 
   g_mutex_lock (&manager->priv->lock);
 
-  op = g_hash_table_lookup (manager->priv->map_object_path_to_object_proxy, object_path);
+  op = lookup_object_proxy_unlocked (manager, object_path);
   if (op == NULL)
     {
       g_debug ("%s: Processing InterfaceRemoved signal for path %s but no object proxy exists",
@@ -1737,8 +1821,34 @@ process_get_all_result (GDBusObjectManagerClient *manager,
                               &object_path,
                               &ifaces_and_properties))
     {
-      add_interfaces (manager, object_path, ifaces_and_properties, name_owner);
-      g_variant_unref (ifaces_and_properties);
+      gboolean deferred = FALSE;
+
+      /* The children reference the reply’s serialised data rather than
+       * copying it, so retaining them is cheap. */
+      if (manager->priv->flags & G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_LAZY_PROXIES)
+        {
+          g_mutex_lock (&manager->priv->lock);
+          if (!g_hash_table_contains (manager->priv->map_object_path_to_object_proxy, object_path))
+            {
+              if (manager->priv->map_object_path_to_pending == NULL)
+                {
+                  manager->priv->map_object_path_to_pending =
+                    g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_variant_unref);
+                  manager->priv->pending_name_owner = g_strdup (name_owner);
+                }
+              g_hash_table_replace (manager->priv->map_object_path_to_pending,
+                                    g_strdup (object_path),
+                                    g_steal_pointer (&ifaces_and_properties));
+              deferred = TRUE;
+            }
+          g_mutex_unlock (&manager->priv->lock);
+        }
+
+      if (!deferred)
+        {
+          add_interfaces (manager, object_path, ifaces_and_properties, name_owner);
+          g_variant_unref (ifaces_and_properties);
+        }
     }
   g_variant_unref (arg0);
 }
@@ -1801,7 +1911,7 @@ g_dbus_object_manager_client_get_object (GDBusObjectManager *_manager,
   GDBusObject *ret;
 
   g_mutex_lock (&manager->priv->lock);
-  ret = g_hash_table_lookup (manager->priv->map_object_path_to_object_proxy, object_path);
+  ret = (GDBusObject *) lookup_object_proxy_unlocked (manager, object_path);
   if (ret != NULL)
     g_object_ref (ret);
   g_mutex_unlock (&manager->priv->lock);
@@ -1838,6 +1948,24 @@ g_dbus_object_manager_client_get_objects (GDBusObjectManager *_manager)
   g_return_val_if_fail (G_IS_DBUS_OBJECT_MANAGER_CLIENT (manager), NULL);
 
   g_mutex_lock (&manager->priv->lock);
+  if (manager->priv->map_object_path_to_pending != NULL)
+    {
+      GHashTable *pending = g_steal_pointer (&manager->priv->map_object_path_to_pending);
+      GHashTableIter iter;
+      const gchar *object_path;
+      GVariant *ifaces_and_properties;
+
+      g_hash_table_iter_init (&iter, pending);
+      while (g_hash_table_iter_next (&iter, (gpointer *) &object_path, (gpointer *) &ifaces_and_properties))
+        add_interfaces_unlocked (manager,
+                                 object_path,
+                                 ifaces_and_properties,
+                                 manager->priv->pending_name_owner,
+                                 NULL,
+                                 NULL);
+      g_hash_table_unref (pending);
+      g_clear_pointer (&manager->priv->pending_name_owner, g_free);
+    }
   ret = g_hash_table_get_values (manager->priv->map_object_path_to_object_proxy);
   g_list_foreach (ret, (GFunc) g_object_ref, NULL);
   g_mutex_unlock (&manager->priv->lock);
@@ -292,22 +292,111 @@ gdbus_shared_thread_func (gpointer user_data)
 /* ---------------------------------------------------------------------------------------------------- */
 
 static SharedThreadData *
-_g_dbus_shared_thread_ref (void)
+shared_thread_data_new (const gchar *thread_name)
+{
+  SharedThreadData *data;
+
+  data = g_new0 (SharedThreadData, 1);
+  data->refcount = 0;
+
+  data->context = g_main_context_new ();
+  data->loop = g_main_loop_new (data->context, FALSE);
+  data->thread = g_thread_new (thread_name,
+                               gdbus_shared_thread_func,
+                               data);
+  return data;
+}
+
+/* How long, in milliseconds, the action group and menu exporters gather
+ * changes before sending them in a single `Changed` signal, from the
+ * `GDBUS_EXPORT_FLUSH_INTERVAL` environment variable. Zero, the default,
+ * sends them from an idle callback, as soon as the main loop is idle. */
+guint
+_g_dbus_get_export_flush_interval (void)
+{
+  static gsize interval_initialized = 0;
+  static guint interval = 0;
+
+  if (g_once_init_enter (&interval_initialized))
+    {
+      const gchar *env = g_getenv ("GDBUS_EXPORT_FLUSH_INTERVAL");
+      guint64 value = 0;
+
+      if (env != NULL &&
+          g_ascii_string_to_unsigned (env, 10, 0, G_MAXINT, &value, NULL))
+        interval = value;
+
+      g_once_init_leave (&interval_initialized, 1);
+    }
+
+  return interval;
+}
+
+/* Threads used by connections with %G_DBUS_CONNECTION_FLAGS_WORKER_POOL,
+ * created on demand up to the number of processors, or to the number given
+ * in the `GDBUS_WORKER_THREADS` environment variable. Like the shared
+ * thread, they are never destroyed. */
+G_LOCK_DEFINE_STATIC (worker_pool);
+static SharedThreadData **worker_pool = NULL;
+static guint worker_pool_len = 0;
+static guint worker_pool_max_len = 0;
+
+static SharedThreadData *
+worker_pool_ref (void)
+{
+  SharedThreadData *data = NULL;
+  guint i;
+
+  G_LOCK (worker_pool);
+
+  if (worker_pool == NULL)
+    {
+      const gchar *env = g_getenv ("GDBUS_WORKER_THREADS");
+      guint64 n_threads = 0;
+
+      if (env == NULL ||
+          !g_ascii_string_to_unsigned (env, 10, 1, 1024, &n_threads, NULL))
+        n_threads = g_get_num_processors ();
+
+      worker_pool_max_len = n_threads;
+      worker_pool = g_new0 (SharedThreadData *, worker_pool_max_len);
+    }
+
+  /* Use the least busy thread, unless there are idle threads to spare */
+  for (i = 0; i < worker_pool_len; i++)
+    {
+      if (data == NULL ||
+          g_atomic_int_get (&worker_pool[i]->refcount) < g_atomic_int_get (&data->refcount))
+        data = worker_pool[i];
+    }
+
+  if ((data == NULL || g_atomic_int_get (&data->refcount) > 0) &&
+      worker_pool_len < worker_pool_max_len)
+    {
+      data = shared_thread_data_new ("gdbus-worker");
+      worker_pool[worker_pool_len++] = data;
+    }
+
+  g_atomic_int_inc (&data->refcount);
+
+  G_UNLOCK (worker_pool);
+
+  return data;
+}
+
+static SharedThreadData *
+_g_dbus_shared_thread_ref (gboolean use_worker_pool)
 {
   static SharedThreadData *shared_thread_data = 0;
 
+  if (use_worker_pool)
+    return worker_pool_ref ();
+
   if (g_once_init_enter_pointer (&shared_thread_data))
     {
       SharedThreadData *data;
 
-      data = g_new0 (SharedThreadData, 1);
-      data->refcount = 0;
-      
-      data->context = g_main_context_new ();
-      data->loop = g_main_loop_new (data->context, FALSE);
-      data->thread = g_thread_new ("gdbus",
-                                   gdbus_shared_thread_func,
-                                   data);
+      data = shared_thread_data_new ("gdbus");
       /* We can cast between gsize and gpointer safely */
       g_once_init_leave_pointer (&shared_thread_data, data);
     }
@@ -319,6 +408,9 @@ _g_dbus_shared_thread_ref (void)
 static void
 _g_dbus_shared_thread_unref (SharedThreadData *data)
 {
+  /* Only keeps the load of the worker pool threads up to date */
+  g_atomic_int_add (&data->refcount, -1);
+
   /* TODO: actually destroy the shared thread here */
 #if 0
   g_assert (data != NULL);
@@ -341,6 +433,14 @@ typedef enum {
     PENDING_CLOSE
 } OutputPending;
 
+/* Limits on how many queued messages are written to a socket together */
+#define WRITE_BATCH_MAX_MESSAGES 64
+#define WRITE_BATCH_MAX_SIZE (64 * 1024)
+
+/* Size of the buffer reused for reading messages. Bigger messages are read
+ * into a buffer of their own, which is handed over to the message. */
+#define READ_BUFFER_MIN_SIZE 4096
+
 struct GDBusWorker
 {
   gint                                ref_count;  /* (atomic) */
@@ -390,6 +490,14 @@ struct GDBusWorker
   GQueue                             *write_queue;
   /* protected by write_lock */
   guint64                             write_num_messages_written;
+  /* number of messages being written by the pending write;
+   * protected by write_lock
+   */
+  guint                               write_num_messages_in_flight;
+  /* number of writes, each of which may have written several messages;
+   * protected by write_lock
+   */
+  guint64                             write_num_writes;
   /* number of messages we'd written out last time we flushed;
    * protected by write_lock
    */
@@ -603,27 +711,26 @@ _g_dbus_worker_do_read_cb (GInputStream  *input_stream,
 #ifdef G_OS_UNIX
           else if (G_IS_UNIX_FD_MESSAGE (control_message))
             {
-              GUnixFDMessage *fd_message;
-              gint *fds;
-              gint num_fds;
+              GUnixFDList *fd_list;
 
-              fd_message = G_UNIX_FD_MESSAGE (control_message);
-              fds = g_unix_fd_message_steal_fds (fd_message, &num_fds);
+              fd_list = g_unix_fd_message_get_fd_list (G_UNIX_FD_MESSAGE (control_message));
               if (worker->read_fd_list == NULL)
                 {
-                  worker->read_fd_list = g_unix_fd_list_new_from_array (fds, num_fds);
+                  /* The message is dropped below, so its list can be
+                   * adopted as it is */
+                  worker->read_fd_list = g_object_ref (fd_list);
                 }
               else
                 {
+                  gint *fds;
+                  gint num_fds;
                   gint n;
+
+                  fds = g_unix_fd_list_steal_fds (fd_list, &num_fds);
                   for (n = 0; n < num_fds; n++)
-                    {
-                      /* TODO: really want a append_steal() */
-                      g_unix_fd_list_append (worker->read_fd_list, fds[n], NULL);
-                      (void) g_close (fds[n], NULL);
-                    }
+                    g_unix_fd_list_append_take (worker->read_fd_list, fds[n]);
+                  g_free (fds);
                 }
-              g_free (fds);
             }
           else if (G_IS_UNIX_CREDENTIALS_MESSAGE (control_message))
             {
@@ -745,26 +852,46 @@ _g_dbus_worker_do_read_cb (GInputStream  *input_stream,
       else
         {
           GDBusMessage *message;
+          GBytes *bytes = NULL;
+          const gchar *data = worker->read_buffer;
+          gsize size = worker->read_buffer_cur_size;
           error = NULL;
 
           /* TODO: use connection->priv->auth to decode the message */
 
-          message = g_dbus_message_new_from_blob ((guchar *) worker->read_buffer,
-                                                  worker->read_buffer_cur_size,
-                                                  worker->capabilities,
-                                                  &error);
+          /* A message bigger than the default buffer was read into a
+           * buffer of its own size, so hand that over to the message and
+           * let large arrays in the body reference it, rather than copy
+           * them. The next read allocates a new buffer. */
+          if (size > READ_BUFFER_MIN_SIZE)
+            {
+              bytes = g_bytes_new_take (g_steal_pointer (&worker->read_buffer), size);
+              worker->read_buffer_allocated_size = 0;
+              message = g_dbus_message_new_from_bytes (bytes,
+                                                       worker->capabilities,
+                                                       &error);
+            }
+          else
+            {
+              message = g_dbus_message_new_from_blob ((guchar *) data,
+                                                      size,
+                                                      worker->capabilities,
+                                                      &error);
+            }
+
           if (message == NULL)
             {
               gchar *s;
-              s = _g_dbus_hexdump (worker->read_buffer, worker->read_buffer_cur_size, 2);
+              s = _g_dbus_hexdump (data, size, 2);
               g_warning ("Error decoding D-Bus message of %" G_GSIZE_FORMAT " bytes\n"
                          "The error is: %s\n"
                          "The payload is as follows:\n"
                          "%s",
-                         worker->read_buffer_cur_size,
+                         size,
                          error->message,
                          s);
               g_free (s);
+              g_clear_pointer (&bytes, g_bytes_unref);
               _g_dbus_worker_emit_disconnected (worker, FALSE, error);
               g_error_free (error);
               goto out;
@@ -786,19 +913,21 @@ _g_dbus_worker_do_read_cb (GInputStream  *input_stream,
               g_print ("========================================================================\n"
                        "GDBus-debug:Message:\n"
                        "  <<<< RECEIVED D-Bus message (%" G_GSIZE_FORMAT " bytes)\n",
-                       worker->read_buffer_cur_size);
+                       size);
               s = g_dbus_message_print (message, 2);
               g_print ("%s", s);
               g_free (s);
               if (G_UNLIKELY (_g_dbus_debug_payload ()))
                 {
-                  s = _g_dbus_hexdump (worker->read_buffer, worker->read_buffer_cur_size, 2);
+                  s = _g_dbus_hexdump (data, size, 2);
                   g_print ("%s\n", s);
                   g_free (s);
                 }
               _g_dbus_debug_print_unlock ();
             }
 
+          g_clear_pointer (&bytes, g_bytes_unref);
+
           /* yay, got a message, go deliver it */
           _g_dbus_worker_queue_or_deliver_received_message (worker, g_steal_pointer (&message));
 
@@ -842,8 +971,7 @@ _g_dbus_worker_do_read_unlocked (GDBusWorker *worker)
   /* ensure we have a (big enough) buffer */
   if (worker->read_buffer == NULL || worker->read_buffer_bytes_wanted > worker->read_buffer_allocated_size)
     {
-      /* TODO: 4096 is randomly chosen; might want a better chosen default minimum */
-      worker->read_buffer_allocated_size = MAX (worker->read_buffer_bytes_wanted, 4096);
+      worker->read_buffer_allocated_size = MAX (worker->read_buffer_bytes_wanted, READ_BUFFER_MIN_SIZE);
       worker->read_buffer = g_realloc (worker->read_buffer, worker->read_buffer_allocated_size);
     }
 
@@ -891,6 +1019,13 @@ struct _MessageToWriteData
   gchar        *blob;
   gsize         blob_size;
 
+  gboolean      filtered;  /* whether the about-to-be-sent filters have run */
+
+  /* (owned) (nullable) (element-type MessageToWriteData): messages
+   * written along with this one, in a single write on the socket */
+  GPtrArray    *batch;
+  gsize         write_size;  /* @blob_size plus the sizes of @batch */
+
   gsize         total_written;
   GTask        *task;  /* (owned) and (nullable) before writing starts and after g_task_return_*() is called */
 };
@@ -901,6 +1036,7 @@ message_to_write_data_free (MessageToWriteData *data)
   _g_dbus_worker_unref (data->worker);
   g_clear_object (&data->message);
   g_free (data->blob);
+  g_clear_pointer (&data->batch, g_ptr_array_unref);
 
   /* The task must either not have been created, or have been created, returned
    * and finalised by now. */
@@ -909,6 +1045,38 @@ message_to_write_data_free (MessageToWriteData *data)
   g_slice_free (MessageToWriteData, data);
 }
 
+#ifdef G_OS_UNIX
+/* Fills @vectors with the parts of @data and its batch which haven’t been
+ * written yet, and returns how many of them were used */
+static guint
+message_to_write_data_get_vectors (MessageToWriteData *data,
+                                   GOutputVector       vectors[WRITE_BATCH_MAX_MESSAGES])
+{
+  guint n_messages = 1 + (data->batch != NULL ? data->batch->len : 0);
+  gsize skip = data->total_written;
+  guint n_vectors = 0;
+  guint i;
+
+  for (i = 0; i < n_messages; i++)
+    {
+      MessageToWriteData *message_data = i == 0 ? data : g_ptr_array_index (data->batch, i - 1);
+
+      if (skip >= message_data->blob_size)
+        {
+          skip -= message_data->blob_size;
+          continue;
+        }
+
+      vectors[n_vectors].buffer = message_data->blob + skip;
+      vectors[n_vectors].size = message_data->blob_size - skip;
+      n_vectors++;
+      skip = 0;
+    }
+
+  return n_vectors;
+}
+#endif
+
 /* ---------------------------------------------------------------------------------------------------- */
 
 static void write_message_continue_writing (MessageToWriteData *data);
@@ -950,8 +1118,8 @@ write_message_async_cb (GObject      *source_object,
   write_message_print_transport_debug (bytes_written, data);
 
   data->total_written += bytes_written;
-  g_assert (data->total_written <= data->blob_size);
-  if (data->total_written == data->blob_size)
+  g_assert (data->total_written <= data->write_size);
+  if (data->total_written == data->write_size)
     {
       GTask *task = g_steal_pointer (&data->task);
       g_task_return_boolean (task, TRUE);
@@ -1008,24 +1176,29 @@ write_message_continue_writing (MessageToWriteData *data)
 #endif
 
   g_assert (!g_output_stream_has_pending (ostream));
-  g_assert_cmpint (data->total_written, <, data->blob_size);
+  g_assert_cmpint (data->total_written, <, data->write_size);
 
   if (FALSE)
     {
     }
 #ifdef G_OS_UNIX
-  else if (G_IS_SOCKET_OUTPUT_STREAM (ostream) && data->total_written == 0)
+  /* A batch of messages is written with g_socket_send_message() until it
+   * is done, everything else only starts that way */
+  else if (G_IS_SOCKET_OUTPUT_STREAM (ostream) &&
+           (data->total_written == 0 || data->batch != NULL))
     {
-      GOutputVector vector;
+      GOutputVector vectors[WRITE_BATCH_MAX_MESSAGES];
+      guint n_vectors;
       GSocketControlMessage *control_message;
       gssize bytes_written;
       GError *error;
 
-      vector.buffer = data->blob;
-      vector.size = data->blob_size;
+      n_vectors = message_to_write_data_get_vectors (data, vectors);
 
+      /* Only the first message of a batch may have file descriptors, which
+       * are sent along with its first byte */
       control_message = NULL;
-      if (fd_list != NULL && g_unix_fd_list_get_length (fd_list) > 0)
+      if (data->total_written == 0 && fd_list != NULL && g_unix_fd_list_get_length (fd_list) > 0)
         {
           if (!(data->worker->capabilities & G_DBUS_CAPABILITY_FLAGS_UNIX_FD_PASSING))
             {
@@ -1045,8 +1218,8 @@ write_message_continue_writing (MessageToWriteData *data)
       error = NULL;
       bytes_written = g_socket_send_message (data->worker->socket,
                                              NULL, /* address */
-                                             &vector,
-                                             1,
+                                             vectors,
+                                             n_vectors,
                                              control_message != NULL ? &control_message : NULL,
                                              control_message != NULL ? 1 : 0,
                                              G_SOCKET_MSG_NONE,
@@ -1086,8 +1259,8 @@ write_message_continue_writing (MessageToWriteData *data)
       write_message_print_transport_debug (bytes_written, data);
 
       data->total_written += bytes_written;
-      g_assert (data->total_written <= data->blob_size);
-      if (data->total_written == data->blob_size)
+      g_assert (data->total_written <= data->write_size);
+      if (data->total_written == data->write_size)
         {
           GTask *task = g_steal_pointer (&data->task);
           g_task_return_boolean (task, TRUE);
@@ -1142,10 +1315,15 @@ write_message_async (GDBusWorker         *worker,
                      GAsyncReadyCallback  callback,
                      gpointer             user_data)
 {
+  guint i;
+
   data->task = g_task_new (NULL, NULL, callback, user_data);
   g_task_set_source_tag (data->task, write_message_async);
   g_task_set_name (data->task, "[gio] D-Bus write message");
   data->total_written = 0;
+  data->write_size = data->blob_size;
+  for (i = 0; data->batch != NULL && i < data->batch->len; i++)
+    data->write_size += ((MessageToWriteData *) g_ptr_array_index (data->batch, i))->blob_size;
   write_message_continue_writing (g_steal_pointer (&data));
 }
 
@@ -1344,10 +1522,12 @@ write_message_cb (GObject       *source_object,
 {
   MessageToWriteData *data = user_data;
   GError *error;
+  guint i;
 
   g_mutex_lock (&data->worker->write_lock);
   g_assert (data->worker->output_pending == PENDING_WRITE);
   data->worker->output_pending = PENDING_NONE;
+  data->worker->write_num_messages_in_flight = 0;
 
   error = NULL;
   if (!write_message_finish (res, &error))
@@ -1362,6 +1542,9 @@ write_message_cb (GObject       *source_object,
     }
 
   message_written_unlocked (data->worker, data);
+  for (i = 0; data->batch != NULL && i < data->batch->len; i++)
+    message_written_unlocked (data->worker, g_ptr_array_index (data->batch, i));
+  data->worker->write_num_writes += 1;
 
   g_mutex_unlock (&data->worker->write_lock);
 
@@ -1439,6 +1622,139 @@ iostream_close_cb (GObject      *source_object,
   _g_dbus_worker_unref (worker);
 }
 
+/* called in private thread shared by all GDBusConnection instances
+ *
+ * write-lock is not held on entry
+ *
+ * Runs the about-to-be-sent filters on @data, unless that already happened.
+ * Returns %FALSE if the filters dropped the message.
+ */
+static gboolean
+filter_message_to_write (GDBusWorker        *worker,
+                         MessageToWriteData *data)
+{
+  GDBusMessage *old_message;
+  guchar *new_blob;
+  gsize new_blob_size;
+  GError *error;
+
+  if (data->filtered)
+    return TRUE;
+  data->filtered = TRUE;
+
+  old_message = data->message;
+  data->message = _g_dbus_worker_emit_message_about_to_be_sent (worker, data->message);
+  if (data->message == old_message)
+    {
+      /* filters had no effect - do nothing */
+    }
+  else if (data->message == NULL)
+    {
+      /* filters dropped message */
+      return FALSE;
+    }
+  else
+    {
+      /* filters altered the message -> re-encode */
+      error = NULL;
+      new_blob = g_dbus_message_to_blob (data->message,
+                                         &new_blob_size,
+                                         worker->capabilities,
+                                         &error);
+      if (new_blob == NULL)
+        {
+          /* if filter make the GDBusMessage unencodeable, just complain on stderr and send
+           * the old message instead
+           */
+          g_warning ("Error encoding GDBusMessage with serial %d altered by filter function: %s",
+                     g_dbus_message_get_serial (data->message),
+                     error->message);
+          g_error_free (error);
+        }
+      else
+        {
+          g_free (data->blob);
+          data->blob = (gchar *) new_blob;
+          data->blob_size = new_blob_size;
+        }
+    }
+
+  return TRUE;
+}
+
+#ifdef G_OS_UNIX
+static gboolean
+message_to_write_data_has_fds (MessageToWriteData *data)
+{
+  GUnixFDList *fd_list = g_dbus_message_get_unix_fd_list (data->message);
+
+  return fd_list != NULL && g_unix_fd_list_get_length (fd_list) > 0;
+}
+
+/* called in private thread shared by all GDBusConnection instances
+ *
+ * write-lock is not held on entry
+ * output_pending must be PENDING_WRITE on entry
+ *
+ * Moves messages from the head of the write queue into the batch of @data
+ * so that they can all be written with a single g_socket_send_message().
+ * This only works on sockets, and only the first message of a batch can
+ * carry file descriptors. A flush or close request ends the batch, as
+ * those expect the messages queued before them to be written first.
+ */
+static void
+collect_write_batch (GDBusWorker        *worker,
+                     MessageToWriteData *data)
+{
+  gsize batch_size = data->blob_size;
+
+  if (worker->socket == NULL)
+    return;
+
+  while (data->batch == NULL || data->batch->len + 1 < WRITE_BATCH_MAX_MESSAGES)
+    {
+      MessageToWriteData *next;
+
+      g_mutex_lock (&worker->write_lock);
+      next = g_queue_peek_head (worker->write_queue);
+      if (next == NULL ||
+          worker->write_pending_flushes != NULL ||
+          worker->pending_close_attempts != NULL ||
+          batch_size + next->blob_size > WRITE_BATCH_MAX_SIZE ||
+          message_to_write_data_has_fds (next))
+        {
+          g_mutex_unlock (&worker->write_lock);
+          break;
+        }
+      g_queue_pop_head (worker->write_queue);
+      worker->write_num_messages_in_flight += 1;
+      g_mutex_unlock (&worker->write_lock);
+
+      if (!filter_message_to_write (worker, next))
+        {
+          message_to_write_data_free (next);
+          continue;
+        }
+
+      /* the filters may have added file descriptors, so leave the message
+       * at the head of the queue for the next write */
+      if (message_to_write_data_has_fds (next))
+        {
+          g_mutex_lock (&worker->write_lock);
+          g_queue_push_head (worker->write_queue, next);
+          worker->write_num_messages_in_flight -= 1;
+          g_mutex_unlock (&worker->write_lock);
+          break;
+        }
+
+      if (data->batch == NULL)
+        data->batch = g_ptr_array_new_with_free_func ((GDestroyNotify) message_to_write_data_free);
+      g_ptr_array_add (data->batch, next);
+      batch_size += next->blob_size;
+    }
+}
+#endif
+
 /* called in private thread shared by all GDBusConnection instances
  *
  * write-lock is not held on entry
@@ -1483,7 +1799,10 @@ continue_writing (GDBusWorker *worker)
           data = g_queue_pop_head (worker->write_queue);
 
           if (data != NULL)
-            worker->output_pending = PENDING_WRITE;
+            {
+              worker->output_pending = PENDING_WRITE;
+              worker->write_num_messages_in_flight = 1;
+            }
         }
     }
 
@@ -1505,51 +1824,19 @@ continue_writing (GDBusWorker *worker)
     }
   else if (data != NULL)
     {
-      GDBusMessage *old_message;
-      guchar *new_blob;
-      gsize new_blob_size;
-      GError *error;
-
-      old_message = data->message;
-      data->message = _g_dbus_worker_emit_message_about_to_be_sent (worker, data->message);
-      if (data->message == old_message)
+      if (!filter_message_to_write (worker, data))
         {
-          /* filters had no effect - do nothing */
-        }
-      else if (data->message == NULL)
-        {
-          /* filters dropped message */
           g_mutex_lock (&worker->write_lock);
           worker->output_pending = PENDING_NONE;
+          worker->write_num_messages_in_flight = 0;
           g_mutex_unlock (&worker->write_lock);
           message_to_write_data_free (data);
           goto write_next;
         }
-      else
-        {
-          /* filters altered the message -> re-encode */
-          error = NULL;
-          new_blob = g_dbus_message_to_blob (data->message,
-                                             &new_blob_size,
-                                             worker->capabilities,
-                                             &error);
-          if (new_blob == NULL)
-            {
-              /* if filter make the GDBusMessage unencodeable, just complain on stderr and send
-               * the old message instead
-               */
-              g_warning ("Error encoding GDBusMessage with serial %d altered by filter function: %s",
-                         g_dbus_message_get_serial (data->message),
-                         error->message);
-              g_error_free (error);
-            }
-          else
-            {
-              g_free (data->blob);
-              data->blob = (gchar *) new_blob;
-              data->blob_size = new_blob_size;
-            }
-        }
+
+#ifdef G_OS_UNIX
+      collect_write_batch (worker, data);
+#endif
 
       write_message_async (worker,
                            data,
@@ -1670,6 +1957,7 @@ GDBusWorker *
 _g_dbus_worker_new (GIOStream                              *stream,
                     GDBusCapabilityFlags                    capabilities,
                     gboolean                                initially_frozen,
+                    gboolean                                use_worker_pool,
                     GDBusWorkerMessageReceivedCallback      message_received_callback,
                     GDBusWorkerMessageAboutToBeSentCallback message_about_to_be_sent_callback,
                     GDBusWorkerDisconnectedCallback         disconnected_callback,
@@ -1705,7 +1993,7 @@ _g_dbus_worker_new (GIOStream                              *stream,
   if (G_IS_SOCKET_CONNECTION (worker->stream))
     worker->socket = g_socket_connection_get_socket (G_SOCKET_CONNECTION (worker->stream));
 
-  worker->shared_thread_data = _g_dbus_shared_thread_ref ();
+  worker->shared_thread_data = _g_dbus_shared_thread_ref (use_worker_pool);
 
   /* begin reading */
   idle_source = g_idle_source_new ();
@@ -1803,7 +2091,7 @@ _g_dbus_worker_flush_sync (GDBusWorker    *worker,
    * flush operation that follows it
    */
   if (worker->output_pending == PENDING_WRITE)
-    pending_writes += 1;
+    pending_writes += worker->write_num_messages_in_flight;
 
   if (pending_writes > 0 ||
       worker->write_num_messages_written != worker->write_num_messages_flushed)
@@ -2540,6 +2828,13 @@ write_message_print_transport_debug (gssize bytes_written,
            data->blob_size,
            data->total_written,
            g_type_name (G_TYPE_FROM_INSTANCE (g_io_stream_get_output_stream (data->worker->stream))));
+  if (data->batch != NULL)
+    g_print ("       along with %u more messages, %" G_GSIZE_FORMAT " bytes in total\n"
+             "       (%" G_GUINT64_FORMAT " messages in %" G_GUINT64_FORMAT " writes so far)\n",
+             data->batch->len,
+             data->write_size,
+             data->worker->write_num_messages_written,
+             data->worker->write_num_writes);
   _g_dbus_debug_print_unlock ();
  out:
   ;
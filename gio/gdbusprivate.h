@@ -91,6 +91,7 @@ typedef void (*GDBusWorkerDisconnectedCallback)    (GDBusWorker   *worker,
 GDBusWorker *_g_dbus_worker_new          (GIOStream                          *stream,
                                           GDBusCapabilityFlags                capabilities,
                                           gboolean                            initially_frozen,
+                                          gboolean                            use_worker_pool,
                                           GDBusWorkerMessageReceivedCallback  message_received_callback,
                                           GDBusWorkerMessageAboutToBeSentCallback message_about_to_be_sent_callback,
                                           GDBusWorkerDisconnectedCallback     disconnected_callback,
@@ -132,6 +133,8 @@ gboolean _g_dbus_debug_emission (void);
 gboolean _g_dbus_debug_address (void);
 gboolean _g_dbus_debug_proxy (void);
 
+guint    _g_dbus_get_export_flush_interval (void);
+
 void     _g_dbus_debug_print_lock (void);
 void     _g_dbus_debug_print_unlock (void);
 
@@ -195,6 +198,9 @@ void _g_dbus_object_proxy_remove_interface (GDBusObjectProxy *proxy,
 gchar *_g_dbus_hexencode (const gchar *str,
                           gsize        str_len);
 
+/* Implemented in gdbusmessage.c */
+gsize _g_dbus_message_get_blob_size (GDBusMessage *message);
+
 /* Implemented in gdbusconnection.c */
 GDBusConnection *_g_bus_get_singleton_if_exists (GBusType bus_type);
 void             _g_bus_forget_singleton        (GBusType bus_type);
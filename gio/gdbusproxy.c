@@ -144,6 +144,11 @@ struct _GDBusProxyPrivate
   /* gchar* -> GVariant*, protected by properties_lock */
   GHashTable *properties;
 
+  /* With G_DBUS_PROXY_FLAGS_LAZY_PROPERTIES, the a{sv} from the GetAll()
+   * reply, not decoded into @properties yet. @properties is empty while
+   * this is set. Protected by properties_lock */
+  GVariant *pending_properties;
+
   /* mutable, protected by properties_lock */
   GDBusInterfaceInfo *expected_interface;
 
@@ -183,6 +188,8 @@ static void dbus_interface_iface_init (GDBusInterfaceIface *dbus_interface_iface
 static void initable_iface_init       (GInitableIface *initable_iface);
 static void async_initable_iface_init (GAsyncInitableIface *async_initable_iface);
 
+static void decode_pending_properties (GDBusProxy *proxy);
+
 G_DEFINE_TYPE_WITH_CODE (GDBusProxy, g_dbus_proxy, G_TYPE_OBJECT,
                          G_ADD_PRIVATE (GDBusProxy)
                          G_IMPLEMENT_INTERFACE (G_TYPE_DBUS_INTERFACE, dbus_interface_iface_init)
@@ -216,6 +223,7 @@ g_dbus_proxy_finalize (GObject *object)
   g_free (proxy->priv->interface_name);
   if (proxy->priv->properties != NULL)
     g_hash_table_unref (proxy->priv->properties);
+  g_clear_pointer (&proxy->priv->pending_properties, g_variant_unref);
 
   if (proxy->priv->expected_interface != NULL)
     {
@@ -641,14 +649,30 @@ g_dbus_proxy_get_cached_property_names (GDBusProxy  *proxy)
   G_LOCK (properties_lock);
 
   names = NULL;
-  if (g_hash_table_size (proxy->priv->properties) == 0)
-    goto out;
+  if (proxy->priv->pending_properties != NULL)
+    {
+      GVariantIter pending_iter;
 
-  p = g_ptr_array_new ();
+      if (g_variant_n_children (proxy->priv->pending_properties) == 0)
+        goto out;
 
-  g_hash_table_iter_init (&iter, proxy->priv->properties);
-  while (g_hash_table_iter_next (&iter, (gpointer) &key, NULL))
-    g_ptr_array_add (p, g_strdup (key));
+      p = g_ptr_array_new ();
+
+      g_variant_iter_init (&pending_iter, proxy->priv->pending_properties);
+      while (g_variant_iter_next (&pending_iter, "{sv}", &key, NULL))
+        g_ptr_array_add (p, (gchar *) key);
+    }
+  else
+    {
+      if (g_hash_table_size (proxy->priv->properties) == 0)
+        goto out;
+
+      p = g_ptr_array_new ();
+
+      g_hash_table_iter_init (&iter, proxy->priv->properties);
+      while (g_hash_table_iter_next (&iter, (gpointer) &key, NULL))
+        g_ptr_array_add (p, g_strdup (key));
+    }
   g_ptr_array_sort_values (p, (GCompareFunc) g_strcmp0);
   g_ptr_array_add (p, NULL);
 
@@ -701,13 +725,24 @@ g_dbus_proxy_get_cached_property (GDBusProxy   *proxy,
 {
   const GDBusPropertyInfo *info;
   GVariant *value;
+  GVariant *lazy_value = NULL;
 
   g_return_val_if_fail (G_IS_DBUS_PROXY (proxy), NULL);
   g_return_val_if_fail (property_name != NULL, NULL);
 
   G_LOCK (properties_lock);
 
-  value = g_hash_table_lookup (proxy->priv->properties, property_name);
+  if (proxy->priv->pending_properties != NULL)
+    {
+      /* Returns a new reference, which is dropped below once checked */
+      value = g_variant_lookup_value (proxy->priv->pending_properties, property_name, NULL);
+      if (value != NULL)
+        lazy_value = value;
+    }
+  else
+    {
+      value = g_hash_table_lookup (proxy->priv->properties, property_name);
+    }
   if (value == NULL)
     goto out;
 
@@ -731,6 +766,7 @@ g_dbus_proxy_get_cached_property (GDBusProxy   *proxy,
 
  out:
   G_UNLOCK (properties_lock);
+  g_clear_pointer (&lazy_value, g_variant_unref);
   return value;
 }
 
@@ -788,6 +824,8 @@ g_dbus_proxy_set_cached_property (GDBusProxy   *proxy,
 
   G_LOCK (properties_lock);
 
+  decode_pending_properties (proxy);
+
   if (value != NULL)
     {
       info = lookup_property_info (proxy, property_name);
@@ -884,12 +922,47 @@ on_signal_received (GDBusConnection *connection,
 
 /* ---------------------------------------------------------------------------------------------------- */
 
+static void insert_property_checked (GDBusProxy *proxy,
+                                     gchar      *property_name,
+                                     GVariant   *value);
+
+/* must hold properties_lock
+ *
+ * Decodes the retained GetAll() reply into @properties, so that it can be
+ * modified. This is a no-op unless %G_DBUS_PROXY_FLAGS_LAZY_PROPERTIES is
+ * used and nothing has been changed since the reply was received. */
+static void
+decode_pending_properties (GDBusProxy *proxy)
+{
+  GVariant *pending;
+  GVariantIter iter;
+  gchar *key;
+  GVariant *value;
+
+  if (G_LIKELY (proxy->priv->pending_properties == NULL))
+    return;
+
+  pending = g_steal_pointer (&proxy->priv->pending_properties);
+
+  g_variant_iter_init (&iter, pending);
+  while (g_variant_iter_next (&iter, "{sv}", &key, &value))
+    {
+      insert_property_checked (proxy,
+                               key, /* adopts string */
+                               value); /* adopts value */
+    }
+
+  g_variant_unref (pending);
+}
+
 /* must hold properties_lock */
 static void
 insert_property_checked (GDBusProxy  *proxy,
 			 gchar *property_name,
 			 GVariant *value)
 {
+  decode_pending_properties (proxy);
+
   if (proxy->priv->expected_interface != NULL)
     {
       const GDBusPropertyInfo *info;
@@ -1073,6 +1146,7 @@ on_properties_changed (GDBusConnection *connection,
   else
     {
       emit_g_signal = TRUE;
+      decode_pending_properties (proxy);
       for (n = 0; invalidated_properties[n] != NULL; n++)
         {
           g_hash_table_remove (proxy->priv->properties, invalidated_properties[n]);
@@ -1115,16 +1189,29 @@ process_get_all_reply (GDBusProxy *proxy,
 
   G_LOCK (properties_lock);
 
-  g_variant_get (result, "(a{sv})", &iter);
-  while (g_variant_iter_next (iter, "{sv}", &key, &value))
+  if ((proxy->priv->flags & G_DBUS_PROXY_FLAGS_LAZY_PROPERTIES) &&
+      proxy->priv->pending_properties == NULL &&
+      g_hash_table_size (proxy->priv->properties) == 0)
     {
-      insert_property_checked (proxy,
-			       key, /* adopts string */
-			       value); /* adopts value */
+      /* Keep the reply as is. The child shares the reply’s serialised data,
+       * and values are only unpacked when looked up. Their types are checked
+       * against the expected interface then too. */
+      proxy->priv->pending_properties = g_variant_get_child_value (result, 0);
+      num_properties = g_variant_n_children (proxy->priv->pending_properties);
     }
-  g_variant_iter_free (iter);
+  else
+    {
+      g_variant_get (result, "(a{sv})", &iter);
+      while (g_variant_iter_next (iter, "{sv}", &key, &value))
+        {
+          insert_property_checked (proxy,
+                                   key, /* adopts string */
+                                   value); /* adopts value */
+        }
+      g_variant_iter_free (iter);
 
-  num_properties = g_hash_table_size (proxy->priv->properties);
+      num_properties = g_hash_table_size (proxy->priv->properties);
+    }
   G_UNLOCK (properties_lock);
 
   /* Synthesize ::g-properties-changed changed */
@@ -1198,6 +1285,7 @@ on_name_owner_changed_get_all_cb (GDBusConnection *connection,
       g_free (data->proxy->priv->name_owner);
       data->proxy->priv->name_owner = g_steal_pointer (&data->name_owner);
       g_hash_table_remove_all (data->proxy->priv->properties);
+      g_clear_pointer (&data->proxy->priv->pending_properties, g_variant_unref);
       G_UNLOCK (properties_lock);
       if (result != NULL)
         {
@@ -1254,6 +1342,8 @@ on_name_owner_changed (GDBusConnection *connection,
       g_free (proxy->priv->name_owner);
       proxy->priv->name_owner = NULL;
 
+      decode_pending_properties (proxy);
+
       /* Synthesize ::g-properties-changed changed */
       if (!(proxy->priv->flags & G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES) &&
           g_hash_table_size (proxy->priv->properties) > 0)
@@ -1307,6 +1397,7 @@ on_name_owner_changed (GDBusConnection *connection,
           proxy->priv->name_owner = g_strdup (new_owner);
 
           g_hash_table_remove_all (proxy->priv->properties);
+          g_clear_pointer (&proxy->priv->pending_properties, g_variant_unref);
           G_UNLOCK (properties_lock);
           g_object_notify (G_OBJECT (proxy), "g-name-owner");
         }
@@ -3126,6 +3217,175 @@ g_dbus_proxy_call_with_unix_fd_list_sync (GDBusProxy      *proxy,
 
 /* ---------------------------------------------------------------------------------------------------- */
 
+typedef struct
+{
+  GTask *task;  /* (owned) */
+  GDBusProxy *proxy;  /* (owned) */
+} LoadPropertiesCallData;
+
+/* The number of outstanding GetAll() calls is the task data. All callbacks
+ * run in the same #GMainContext, so it needs no locking. */
+static void
+load_properties_complete_one (GTask *task)
+{
+  guint *n_pending = g_task_get_task_data (task);
+
+  if (--(*n_pending) > 0)
+    return;
+
+  if (!g_task_return_error_if_cancelled (task))
+    g_task_return_boolean (task, TRUE);
+}
+
+static void
+load_properties_get_all_cb (GDBusConnection *connection,
+                            GAsyncResult    *res,
+                            gpointer         user_data)
+{
+  LoadPropertiesCallData *data = user_data;
+  GVariant *result;
+  GError *error = NULL;
+
+  result = g_dbus_connection_call_finish (connection, res, &error);
+  if (result != NULL)
+    {
+      process_get_all_reply (data->proxy, result);
+      g_variant_unref (result);
+    }
+  else
+    {
+      /* Ignored, as when initializing the proxy */
+      if (G_UNLIKELY (_g_dbus_debug_proxy ()))
+        {
+          g_debug ("error: %d %d %s",
+                   error->domain,
+                   error->code,
+                   error->message);
+        }
+      g_error_free (error);
+    }
+
+  load_properties_complete_one (data->task);
+
+  g_object_unref (data->task);
+  g_object_unref (data->proxy);
+  g_free (data);
+}
+
+/**
+ * g_dbus_proxy_load_properties_batch:
+ * @proxies: (array length=n_proxies): the proxies to load properties for
+ * @n_proxies: the number of elements in @proxies
+ * @cancellable: (nullable): A #GCancellable or %NULL.
+ * @callback: (nullable): A #GAsyncReadyCallback to call when all the
+ *   properties have been loaded.
+ * @user_data: The data to pass to @callback.
+ *
+ * Loads the properties of all of @proxies into their caches, as if they had
+ * been constructed without %G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES.
+ *
+ * All the `GetAll()` calls are sent before waiting for any reply, so
+ * loading the properties of many proxies for objects on the same peer costs
+ * about one round trip rather than one per proxy. Construct the proxies with
+ * %G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES to avoid loading them twice.
+ * Note that such proxies do not track `PropertiesChanged` signals, so the
+ * loaded values are a snapshot.
+ *
+ * #GDBusProxy::g-properties-changed is emitted on each proxy as its reply is
+ * processed, in the thread-default main context of the caller. As when
+ * constructing a proxy, failing to get the properties of one of @proxies is
+ * not an error.
+ *
+ * Since: 2.82
+ */
+void
+g_dbus_proxy_load_properties_batch (GDBusProxy * const  *proxies,
+                                    gsize                n_proxies,
+                                    GCancellable        *cancellable,
+                                    GAsyncReadyCallback  callback,
+                                    gpointer             user_data)
+{
+  GTask *task;
+  guint *n_pending;
+  gsize n;
+
+  g_return_if_fail (proxies != NULL || n_proxies == 0);
+  g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+  for (n = 0; n < n_proxies; n++)
+    g_return_if_fail (G_IS_DBUS_PROXY (proxies[n]));
+
+  task = g_task_new (NULL, cancellable, callback, user_data);
+  g_task_set_source_tag (task, g_dbus_proxy_load_properties_batch);
+
+  /* Hold one extra count until all calls have been sent */
+  n_pending = g_new (guint, 1);
+  *n_pending = 1;
+  g_task_set_task_data (task, n_pending, g_free);
+
+  for (n = 0; n < n_proxies; n++)
+    {
+      GDBusProxy *proxy = proxies[n];
+      LoadPropertiesCallData *data;
+      gchar *destination = NULL;
+
+      /* Like at construction, there is nothing to load from an unowned name */
+      G_LOCK (properties_lock);
+      if (proxy->priv->name_owner != NULL || proxy->priv->name == NULL)
+        destination = g_strdup (proxy->priv->name_owner);
+      G_UNLOCK (properties_lock);
+
+      if (destination == NULL && proxy->priv->name != NULL)
+        continue;
+
+      data = g_new0 (LoadPropertiesCallData, 1);
+      data->task = g_object_ref (task);
+      data->proxy = g_object_ref (proxy);
+      (*n_pending)++;
+
+      g_dbus_connection_call (proxy->priv->connection,
+                              destination,
+                              proxy->priv->object_path,
+                              DBUS_INTERFACE_PROPERTIES,
+                              "GetAll",
+                              g_variant_new ("(s)", proxy->priv->interface_name),
+                              G_VARIANT_TYPE ("(a{sv})"),
+                              G_DBUS_CALL_FLAGS_NONE,
+                              -1,           /* timeout */
+                              cancellable,
+                              (GAsyncReadyCallback) load_properties_get_all_cb,
+                              data);
+      g_free (destination);
+    }
+
+  load_properties_complete_one (task);
+  g_object_unref (task);
+}
+
+/**
+ * g_dbus_proxy_load_properties_batch_finish:
+ * @res: A #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *   g_dbus_proxy_load_properties_batch().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with g_dbus_proxy_load_properties_batch().
+ *
+ * Returns: %TRUE on success, %FALSE if the operation was cancelled
+ *
+ * Since: 2.82
+ */
+gboolean
+g_dbus_proxy_load_properties_batch_finish (GAsyncResult  *res,
+                                           GError       **error)
+{
+  g_return_val_if_fail (g_task_is_valid (res, NULL), FALSE);
+  g_return_val_if_fail (g_async_result_is_tagged (res, g_dbus_proxy_load_properties_batch), FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+/* ---------------------------------------------------------------------------------------------------- */
+
 static GDBusInterfaceInfo *
 _g_dbus_proxy_get_info (GDBusInterface *interface)
 {
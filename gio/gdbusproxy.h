@@ -207,6 +207,16 @@ GVariant        *g_dbus_proxy_call_with_unix_fd_list_sync   (GDBusProxy
 
 #endif /* G_OS_UNIX */
 
+GIO_AVAILABLE_IN_2_82
+void             g_dbus_proxy_load_properties_batch        (GDBusProxy * const  *proxies,
+                                                            gsize                n_proxies,
+                                                            GCancellable        *cancellable,
+                                                            GAsyncReadyCallback  callback,
+                                                            gpointer             user_data);
+GIO_AVAILABLE_IN_2_82
+gboolean         g_dbus_proxy_load_properties_batch_finish (GAsyncResult        *res,
+                                                            GError             **error);
+
 G_END_DECLS
 
 #endif /* __G_DBUS_PROXY_H__ */
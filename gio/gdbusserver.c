@@ -60,7 +60,8 @@
 #define G_DBUS_SERVER_FLAGS_ALL \
   (G_DBUS_SERVER_FLAGS_RUN_IN_THREAD | \
    G_DBUS_SERVER_FLAGS_AUTHENTICATION_ALLOW_ANONYMOUS | \
-   G_DBUS_SERVER_FLAGS_AUTHENTICATION_REQUIRE_SAME_USER)
+   G_DBUS_SERVER_FLAGS_AUTHENTICATION_REQUIRE_SAME_USER | \
+   G_DBUS_SERVER_FLAGS_WORKER_POOL)
 
 /**
  * GDBusServer:
@@ -1017,6 +1018,8 @@ on_run (GSocketService    *service,
     connection_flags |= G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_ALLOW_ANONYMOUS;
   if (server->flags & G_DBUS_SERVER_FLAGS_AUTHENTICATION_REQUIRE_SAME_USER)
     connection_flags |= G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_REQUIRE_SAME_USER;
+  if (server->flags & G_DBUS_SERVER_FLAGS_WORKER_POOL)
+    connection_flags |= G_DBUS_CONNECTION_FLAGS_WORKER_POOL;
 
   connection = g_dbus_connection_new_sync (G_IO_STREAM (socket_connection),
                                            server->guid,
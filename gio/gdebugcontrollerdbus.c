@@ -48,6 +48,12 @@
  * [property@Gio.DebugController:debug-enabled] and, by default,
  * [func@GLib.log_get_debug_enabled].
  *
+ * While debug output is enabled, message statistics are also collected on
+ * [property@Gio.DebugControllerDBus:connection] (see
+ * [method@Gio.DBusConnection.set_statistics_enabled]). Remote processes can
+ * retrieve them by calling `org.gtk.Debugging.GetStatistics()`, which returns
+ * the result of [method@Gio.DBusConnection.get_statistics]. Since 2.82.
+ *
  * By default, no processes are allowed to call `SetDebugEnabled()` unless a
  * [signal@Gio.DebugControllerDBus::authorize] signal handler is installed. This
  * is because the process may be privileged, or might expose sensitive
@@ -154,6 +160,9 @@ static const gchar org_gtk_Debugging_xml[] =
       "<method name='SetDebugEnabled'>"
         "<arg type='b' name='debug-enabled' direction='in'/>"
       "</method>"
+      "<method name='GetStatistics'>"
+        "<arg type='a{sv}' name='statistics' direction='out'/>"
+      "</method>"
     "</interface>"
   "</node>";
 
@@ -232,6 +241,9 @@ set_debug_enabled (GDebugControllerDBus *self,
       /* Change the default log writer’s behaviour in GLib. */
       g_log_set_debug_enabled (debug_enabled);
 
+      /* Collect message statistics for GetStatistics() while debugging. */
+      g_dbus_connection_set_statistics_enabled (priv->connection, debug_enabled);
+
       /* Notify internally and externally of the property change. */
       g_object_notify (G_OBJECT (self), "debug-enabled");
 
@@ -345,10 +357,11 @@ authorize_cb (GObject      *object,
               gpointer      user_data)
 {
   GDebugControllerDBus *self = G_DEBUG_CONTROLLER_DBUS (object);
-  GDebugControllerDBusPrivate *priv G_GNUC_UNUSED  /* when compiling with G_DISABLE_ASSERT */;
+  GDebugControllerDBusPrivate *priv;
   GTask *task = G_TASK (result);
   GDBusMethodInvocation *invocation = g_task_get_task_data (task);
   GVariant *parameters = g_dbus_method_invocation_get_parameters (invocation);
+  const gchar *method_name = g_dbus_method_invocation_get_method_name (invocation);
   gboolean enabled = FALSE;
   gboolean authorized;
 
@@ -358,9 +371,18 @@ authorize_cb (GObject      *object,
   if (!authorized)
     {
       GError *local_error = g_error_new (G_DBUS_ERROR, G_DBUS_ERROR_ACCESS_DENIED,
-                                         _("Not authorized to change debug settings"));
+                                         g_str_equal (method_name, "GetStatistics") ?
+                                           _("Not authorized to read debug statistics") :
+                                           _("Not authorized to change debug settings"));
       g_dbus_method_invocation_take_error (invocation, g_steal_pointer (&local_error));
     }
+  else if (g_str_equal (method_name, "GetStatistics"))
+    {
+      GVariant *statistics = g_dbus_connection_get_statistics (priv->connection);
+
+      g_dbus_method_invocation_return_value (invocation,
+                                             g_variant_new_tuple (&statistics, 1));
+    }
   else
     {
       /* Update the property value. */
@@ -392,7 +414,8 @@ dbus_method_call (GDBusConnection       *connection,
   GDebugControllerDBusClass *klass = G_DEBUG_CONTROLLER_DBUS_GET_CLASS (self);
 
   /* Only on the org.gtk.Debugging interface */
-  if (g_str_equal (method_name, "SetDebugEnabled"))
+  if (g_str_equal (method_name, "SetDebugEnabled") ||
+      g_str_equal (method_name, "GetStatistics"))
     {
       GTask *task = NULL;
 
@@ -576,8 +599,10 @@ g_debug_controller_dbus_class_init (GDebugControllerDBusClass *klass)
    * @controller: The #GDebugControllerDBus emitting the signal.
    * @invocation: A #GDBusMethodInvocation.
    *
-   * Emitted when a D-Bus peer is trying to change the debug settings and used
-   * to determine if that is authorized.
+   * Emitted when a D-Bus peer is trying to change the debug settings, or
+   * to read the message statistics, and used to determine if that is
+   * authorized. Use g_dbus_method_invocation_get_method_name() on
+   * @invocation to tell the two apart.
    *
    * This signal is emitted in a dedicated worker thread, so handlers are
    * allowed to perform blocking I/O. This means that, for example, it is
@@ -57,6 +57,8 @@
 #include "gappinfoprivate.h"
 #include "glocalfilemonitor.h"
 #include "gutilsprivate.h"
+#include "gvdb/gvdb-builder.h"
+#include "gvdb/gvdb-reader.h"
 
 #ifdef G_OS_UNIX
 #include "gdocumentportal.h"
@@ -1162,11 +1164,253 @@ memory_index_new (void)
   return g_hash_table_new_full (g_str_hash, g_str_equal, g_free, memory_index_entry_free);
 }
 
+/* The search index of each directory is cached on disk as a GVDB table,
+ * so that searching does not need to parse every desktop file in the
+ * directory on each start of an application.
+ *
+ * The table contains the search tokens as "t:token" and the Implements=
+ * tokens as "i:token", each mapping to an a(si) array of (app name, match
+ * category) pairs, and a "stamp" string which summarises the directory
+ * contents the index was built from.  A cache whose stamp does not match
+ * the current contents of the directory is ignored and rewritten.
+ */
+#define DESKTOP_FILE_INDEX_VERSION    1
+#define DESKTOP_FILE_INDEX_STAMP_KEY  "stamp"
+#define DESKTOP_FILE_INDEX_TOKEN      "t:"
+#define DESKTOP_FILE_INDEX_IMPLEMENTS "i:"
+
+static gchar *
+desktop_file_dir_get_index_cache_path (DesktopFileDir *dir)
+{
+  const gchar * const *languages;
+  GChecksum *checksum;
+  gchar *path;
+  gsize i;
+
+  /* Localised keys are indexed, so the cache depends on the language */
+  checksum = g_checksum_new (G_CHECKSUM_SHA256);
+  g_checksum_update (checksum, (const guchar *) dir->path, -1);
+
+  languages = g_get_language_names_with_category ("LC_MESSAGES");
+  for (i = 0; languages[i]; i++)
+    {
+      g_checksum_update (checksum, (const guchar *) "\n", 1);
+      g_checksum_update (checksum, (const guchar *) languages[i], -1);
+    }
+
+  path = g_build_filename (g_get_user_cache_dir (), "glib-2.0", "desktop-index",
+                           g_checksum_get_string (checksum), NULL);
+  g_checksum_free (checksum);
+
+  return path;
+}
+
+static gchar *
+desktop_file_dir_get_index_stamp (DesktopFileDir *dir)
+{
+  GChecksum *checksum;
+  GPtrArray *apps;
+  GHashTableIter iter;
+  gpointer app;
+  gchar *stamp;
+  guint i;
+
+  apps = g_ptr_array_new ();
+  g_hash_table_iter_init (&iter, dir->app_names);
+  while (g_hash_table_iter_next (&iter, &app, NULL))
+    if (!desktop_file_dir_app_name_is_masked (dir, app))
+      g_ptr_array_add (apps, app);
+  g_ptr_array_sort_values (apps, (GCompareFunc) strcmp);
+
+  checksum = g_checksum_new (G_CHECKSUM_SHA256);
+  g_checksum_update (checksum, (const guchar *) G_STRINGIFY (DESKTOP_FILE_INDEX_VERSION), -1);
+
+  for (i = 0; i < apps->len; i++)
+    {
+      const gchar *path = g_hash_table_lookup (dir->app_names, apps->pdata[i]);
+      GStatBuf buf;
+      gint64 mtime_nsec = 0;
+      gchar *line;
+
+      if (g_stat (path, &buf) != 0)
+        memset (&buf, 0, sizeof buf);
+
+#if defined (HAVE_STRUCT_STAT_ST_MTIMENSEC)
+      mtime_nsec = buf.st_mtimensec;
+#elif defined (HAVE_STRUCT_STAT_ST_MTIM_TV_NSEC)
+      mtime_nsec = buf.st_mtim.tv_nsec;
+#endif
+
+      line = g_strdup_printf ("\n%s\t%s\t%" G_GINT64_FORMAT ".%09" G_GINT64_FORMAT "\t%" G_GUINT64_FORMAT,
+                              (const gchar *) apps->pdata[i], path,
+                              (gint64) buf.st_mtime, mtime_nsec, (guint64) buf.st_size);
+      g_checksum_update (checksum, (const guchar *) line, -1);
+      g_free (line);
+    }
+
+  stamp = g_strdup (g_checksum_get_string (checksum));
+  g_checksum_free (checksum);
+  g_ptr_array_unref (apps);
+
+  return stamp;
+}
+
+static gboolean
+desktop_file_dir_load_index_cache (DesktopFileDir *dir,
+                                   const gchar    *cache_path,
+                                   const gchar    *stamp)
+{
+  GvdbTable *table;
+  GVariant *value;
+  gchar **names;
+  gsize n_names, i;
+  gboolean valid;
+
+  table = gvdb_table_new (cache_path, FALSE, NULL);
+  if (table == NULL)
+    return FALSE;
+
+  value = gvdb_table_get_value (table, DESKTOP_FILE_INDEX_STAMP_KEY);
+  valid = value != NULL &&
+          g_variant_is_of_type (value, G_VARIANT_TYPE_STRING) &&
+          g_str_equal (g_variant_get_string (value, NULL), stamp);
+  g_clear_pointer (&value, g_variant_unref);
+
+  if (!valid)
+    {
+      gvdb_table_free (table);
+      return FALSE;
+    }
+
+  names = gvdb_table_get_names (table, &n_names);
+
+  for (i = 0; valid && i < n_names; i++)
+    {
+      MemoryIndex *mi;
+      const gchar *token;
+      GVariantIter iter;
+      const gchar *app_name;
+      gint match_category;
+
+      if (g_str_has_prefix (names[i], DESKTOP_FILE_INDEX_TOKEN))
+        mi = dir->memory_index;
+      else if (g_str_has_prefix (names[i], DESKTOP_FILE_INDEX_IMPLEMENTS))
+        mi = dir->memory_implementations;
+      else
+        continue;
+
+      token = names[i] + 2;
+
+      value = gvdb_table_get_value (table, names[i]);
+      if (value == NULL || !g_variant_is_of_type (value, G_VARIANT_TYPE ("a(si)")))
+        {
+          g_clear_pointer (&value, g_variant_unref);
+          valid = FALSE;
+          break;
+        }
+
+      g_variant_iter_init (&iter, value);
+      while (g_variant_iter_next (&iter, "(&si)", &app_name, &match_category))
+        {
+          gpointer key;
+
+          /* The index must only refer to apps which are in the directory,
+           * as it stores pointers to the app_names keys */
+          if (!g_hash_table_lookup_extended (dir->app_names, app_name, &key, NULL))
+            {
+              valid = FALSE;
+              break;
+            }
+
+          memory_index_add_token (mi, token, match_category, key);
+        }
+
+      g_variant_unref (value);
+    }
+
+  g_strfreev (names);
+  gvdb_table_free (table);
+
+  if (!valid)
+    {
+      g_hash_table_remove_all (dir->memory_index);
+      g_hash_table_remove_all (dir->memory_implementations);
+    }
+
+  return valid;
+}
+
+static void
+desktop_file_dir_add_index_to_table (GHashTable  *table,
+                                     MemoryIndex *mi,
+                                     const gchar *prefix)
+{
+  GHashTableIter iter;
+  gpointer key, value;
+
+  g_hash_table_iter_init (&iter, mi);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+      MemoryIndexEntry *mie;
+      GVariantBuilder builder;
+      GvdbItem *item;
+      gchar *name;
+
+      g_variant_builder_init (&builder, G_VARIANT_TYPE ("a(si)"));
+      for (mie = value; mie; mie = mie->next)
+        g_variant_builder_add (&builder, "(si)", mie->app_name, mie->match_category);
+
+      name = g_strconcat (prefix, key, NULL);
+      item = gvdb_hash_table_insert (table, name);
+      gvdb_item_set_value (item, g_variant_builder_end (&builder));
+      g_free (name);
+    }
+}
+
+static void
+desktop_file_dir_save_index_cache (DesktopFileDir *dir,
+                                   const gchar    *cache_path,
+                                   const gchar    *stamp)
+{
+  GHashTable *table;
+  gchar *cache_dir;
+  GError *error = NULL;
+
+  cache_dir = g_path_get_dirname (cache_path);
+  if (g_mkdir_with_parents (cache_dir, 0700) != 0)
+    {
+      int errsv = errno;
+
+      g_debug ("Failed to create desktop file index cache directory %s: %s",
+               cache_dir, g_strerror (errsv));
+      g_free (cache_dir);
+      return;
+    }
+  g_free (cache_dir);
+
+  table = gvdb_hash_table_new (NULL, NULL);
+  gvdb_hash_table_insert_string (table, DESKTOP_FILE_INDEX_STAMP_KEY, stamp);
+  desktop_file_dir_add_index_to_table (table, dir->memory_index, DESKTOP_FILE_INDEX_TOKEN);
+  desktop_file_dir_add_index_to_table (table, dir->memory_implementations, DESKTOP_FILE_INDEX_IMPLEMENTS);
+
+  /* The cache is only an optimisation, so failing to write it is fine */
+  if (!gvdb_table_write_contents (table, cache_path, G_BYTE_ORDER != G_LITTLE_ENDIAN, &error))
+    {
+      g_debug ("Failed to write desktop file index cache %s: %s",
+               cache_path, error->message);
+      g_clear_error (&error);
+    }
+
+  g_hash_table_unref (table);
+}
+
 static void
 desktop_file_dir_unindexed_setup_search (DesktopFileDir *dir)
 {
   GHashTableIter iter;
   gpointer app, path;
+  gchar *cache_path;
+  gchar *stamp;
 
   dir->memory_index = memory_index_new ();
   dir->memory_implementations = memory_index_new ();
@@ -1175,6 +1419,16 @@ desktop_file_dir_unindexed_setup_search (DesktopFileDir *dir)
   if (dir->app_names == NULL)
     return;
 
+  cache_path = desktop_file_dir_get_index_cache_path (dir);
+  stamp = desktop_file_dir_get_index_stamp (dir);
+
+  if (desktop_file_dir_load_index_cache (dir, cache_path, stamp))
+    {
+      g_free (stamp);
+      g_free (cache_path);
+      return;
+    }
+
   g_hash_table_iter_init (&iter, dir->app_names);
   while (g_hash_table_iter_next (&iter, &app, &path))
     {
@@ -1185,7 +1439,7 @@ desktop_file_dir_unindexed_setup_search (DesktopFileDir *dir)
 
       key_file = g_key_file_new ();
 
-      if (g_key_file_load_from_file (key_file, path, G_KEY_FILE_NONE, NULL) &&
+      if (g_key_file_load_from_file (key_file, path, G_KEY_FILE_LAZY_GROUPS, NULL) &&
           !g_key_file_get_boolean (key_file, "Desktop Entry", "Hidden", NULL))
         {
           /* Index the interesting keys... */
@@ -1237,6 +1491,11 @@ desktop_file_dir_unindexed_setup_search (DesktopFileDir *dir)
 
       g_key_file_free (key_file);
     }
+
+  desktop_file_dir_save_index_cache (dir, cache_path, stamp);
+
+  g_free (stamp);
+  g_free (cache_path);
 }
 
 static void
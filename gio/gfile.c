@@ -27,9 +27,11 @@
 #ifdef __linux__
 #include <sys/ioctl.h>
 #include <errno.h>
-/* See linux.git/fs/btrfs/ioctl.h */
-#define BTRFS_IOCTL_MAGIC 0x94
-#define BTRFS_IOC_CLONE _IOW(BTRFS_IOCTL_MAGIC, 9, int)
+/* See linux.git/include/uapi/linux/fs.h; this started out as the Btrfs
+ * specific BTRFS_IOC_CLONE before other file systems implemented it */
+#ifndef FICLONE
+#define FICLONE _IOW(0x94, 9, int)
+#endif
 #endif
 
 #ifdef HAVE_SPLICE
@@ -53,6 +55,10 @@
 
 #endif
 
+#ifdef HAVE_POSIX_FADVISE
+#include <fcntl.h>
+#endif
+
 #include <string.h>
 #include <sys/types.h>
 
@@ -3283,14 +3289,14 @@ splice_stream_with_progress (GInputStream           *in,
 
 #ifdef __linux__
 static gboolean
-btrfs_reflink_with_progress (GInputStream           *in,
-                             GFileInfo              *in_info,
-                             GOutputStream          *out,
-                             GFileInfo              *info,
-                             GCancellable           *cancellable,
-                             GFileProgressCallback   progress_callback,
-                             gpointer                progress_callback_data,
-                             GError                **error)
+reflink_with_progress (GInputStream           *in,
+                       GFileInfo              *in_info,
+                       GOutputStream          *out,
+                       GFileInfo              *info,
+                       GCancellable           *cancellable,
+                       GFileProgressCallback   progress_callback,
+                       gpointer                progress_callback_data,
+                       GError                **error)
 {
   goffset total_size;
   int fd_in, fd_out;
@@ -3310,13 +3316,13 @@ btrfs_reflink_with_progress (GInputStream           *in,
   if (total_size == -1)
     total_size = 0;
 
-  /* Btrfs clone ioctl properties:
-   *  - Works at the inode level
+  /* Clone ioctl properties (Btrfs, XFS, bcachefs, OCFS2, ...):
+   *  - Works at the inode level, sharing all the extents of the source
    *  - Doesn't work with directories
    *  - Always follows symlinks (source and destination)
    *
    * By the time we get here, *in and *out are both regular files */
-  ret = ioctl (fd_out, BTRFS_IOC_CLONE, fd_in);
+  ret = ioctl (fd_out, FICLONE, fd_in);
   errsv = errno;
 
   if (ret < 0)
@@ -3334,8 +3340,8 @@ btrfs_reflink_with_progress (GInputStream           *in,
 	g_set_error_literal (error, G_IO_ERROR,
 			     G_IO_ERROR_NOT_SUPPORTED,
 			     _("Copy (reflink/clone) is not supported or didn’t work"));
-      /* We retry with fallback for all error cases because Btrfs is currently
-       * unstable, and so we can't trust it to do clone properly.
+      /* We retry with fallback for all error cases because file systems
+       * refuse clones for all sorts of reasons (alignment, quotas, ...).
        * In addition, any hard errors here would cause the same failure in the
        * fallback manual copy as well. */
       return FALSE;
@@ -3518,15 +3524,17 @@ file_copy_fallback (GFile                  *source,
     goto out;
 
 #ifdef __linux__
-  if (G_IS_FILE_DESCRIPTOR_BASED (in) && G_IS_FILE_DESCRIPTOR_BASED (out))
+  if (!(flags & G_FILE_COPY_NO_REFLINK) &&
+      G_IS_FILE_DESCRIPTOR_BASED (in) && G_IS_FILE_DESCRIPTOR_BASED (out))
     {
       GError *reflink_err = NULL;
 
-      if (!btrfs_reflink_with_progress (in, info, out, info, cancellable,
-                                        progress_callback, progress_callback_data,
-                                        &reflink_err))
+      if (!reflink_with_progress (in, info, out, info, cancellable,
+                                  progress_callback, progress_callback_data,
+                                  &reflink_err))
         {
-          if (g_error_matches (reflink_err, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED))
+          if (g_error_matches (reflink_err, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED) &&
+              !(flags & G_FILE_COPY_REFLINK_ONLY))
             {
               g_clear_error (&reflink_err);
             }
@@ -3544,6 +3552,13 @@ file_copy_fallback (GFile                  *source,
     }
 #endif
 
+  if (flags & G_FILE_COPY_REFLINK_ONLY)
+    {
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                           _("Copy (reflink/clone) is not supported"));
+      goto out;
+    }
+
 #ifdef HAVE_COPY_FILE_RANGE
   if (G_IS_FILE_DESCRIPTOR_BASED (in) && G_IS_FILE_DESCRIPTOR_BASED (out))
     {
@@ -3611,6 +3626,21 @@ file_copy_fallback (GFile                  *source,
       g_object_unref (in);
     }
 
+  if (out && !ret && (flags & G_FILE_COPY_REFLINK_ONLY))
+    {
+      GCancellable *abort_cancellable = g_cancellable_new ();
+
+      /* Nothing was copied; closing cancelled drops the temporary file
+       * when replacing, so an existing destination is left untouched */
+      g_cancellable_cancel (abort_cancellable);
+      (void) g_output_stream_close (out, abort_cancellable, NULL);
+      g_object_unref (abort_cancellable);
+      g_clear_object (&out);
+
+      if (!(flags & G_FILE_COPY_OVERWRITE))
+        (void) g_file_delete (destination, NULL, NULL);
+    }
+
   if (out)
     {
       /* But write errors on close are bad! */
@@ -3661,6 +3691,12 @@ file_copy_fallback (GFile                  *source,
  * that is possible to copy is copied, not just the default subset (which,
  * for instance, does not include the owner, see #GFileInfo).
  *
+ * On file systems which support it, the data of @source is shared with
+ * @destination (a reflink or clone) rather than copied, unless
+ * %G_FILE_COPY_NO_REFLINK is specified. With %G_FILE_COPY_REFLINK_ONLY,
+ * the copy fails with %G_IO_ERROR_NOT_SUPPORTED if that isn't possible.
+ * Those two flags can't be combined.
+ *
  * If @cancellable is not %NULL, then the operation can be cancelled by
  * triggering the cancellable object from another thread. If the operation
  * was cancelled, the error %G_IO_ERROR_CANCELLED will be returned.
@@ -3706,9 +3742,18 @@ g_file_copy (GFile                  *source,
   g_return_val_if_fail (G_IS_FILE (source), FALSE);
   g_return_val_if_fail (G_IS_FILE (destination), FALSE);
 
+  g_return_val_if_fail ((flags & (G_FILE_COPY_NO_REFLINK | G_FILE_COPY_REFLINK_ONLY)) !=
+                        (G_FILE_COPY_NO_REFLINK | G_FILE_COPY_REFLINK_ONLY), FALSE);
+
   if (g_cancellable_set_error_if_cancelled (cancellable, error))
     return FALSE;
 
+  /* Backends don't know how to honour %G_FILE_COPY_REFLINK_ONLY */
+  if (flags & G_FILE_COPY_REFLINK_ONLY)
+    return file_copy_fallback (source, destination, flags, cancellable,
+                               progress_callback, progress_callback_data,
+                               error);
+
   iface = G_FILE_GET_IFACE (destination);
   if (iface->copy)
     {
@@ -4731,8 +4776,601 @@ g_file_delete_finish (GFile         *file,
   if (g_async_result_legacy_propagate_error (result, error))
     return FALSE;
 
-  iface = G_FILE_GET_IFACE (file);
-  return (* iface->delete_file_finish) (file, result, error);
+  iface = G_FILE_GET_IFACE (file);
+  return (* iface->delete_file_finish) (file, result, error);
+}
+
+/* Recursive copies and deletions: every file is a node processed on a
+ * thread pool, and a directory node completes once all its children have.
+ * Deleting a directory, or copying its attributes, happens then. */
+
+typedef enum {
+  TREE_OP_COPY,
+  TREE_OP_DELETE,
+} TreeOp;
+
+typedef struct _TreeNode TreeNode;
+
+struct _TreeNode
+{
+  TreeNode *parent;
+  GFile *file;
+  GFile *destination;  /* copies only */
+  GFileType type;      /* G_FILE_TYPE_UNKNOWN until known */
+  gint pending;        /* the node itself, plus its unfinished children */
+};
+
+typedef struct
+{
+  TreeOp op;
+  GFileCopyFlags flags;
+  GTask *task;
+  GThreadPool *pool;
+
+  /* Cancelled by the caller's cancellable, or on the first error */
+  GCancellable *cancellable;
+  GCancellable *caller_cancellable;
+  gulong cancelled_id;
+
+  GMutex lock;
+  GError *error;
+  goffset current_num_bytes;
+  goffset total_num_bytes;
+  gboolean progress_changed;
+
+  /* Progress is coalesced into one callback per interval, in the
+   * task’s main context */
+  GFileProgressCallback progress_callback;
+  gpointer progress_callback_data;
+  GSource *progress_source;
+} TreeJob;
+
+#define TREE_PROGRESS_INTERVAL_MS 100
+
+static TreeNode *
+tree_node_new (TreeNode  *parent,
+               GFile     *file,
+               GFile     *destination,
+               GFileType  type)
+{
+  TreeNode *node;
+
+  node = g_new0 (TreeNode, 1);
+  node->parent = parent;
+  node->file = g_object_ref (file);
+  node->destination = destination ? g_object_ref (destination) : NULL;
+  node->type = type;
+  node->pending = 1;
+
+  return node;
+}
+
+static void
+tree_node_free (TreeNode *node)
+{
+  g_object_unref (node->file);
+  g_clear_object (&node->destination);
+  g_free (node);
+}
+
+static void
+tree_job_fail (TreeJob *job,
+               GError  *error)
+{
+  g_mutex_lock (&job->lock);
+  /* Later errors are mostly fallout from cancelling the job */
+  if (job->error == NULL)
+    job->error = g_steal_pointer (&error);
+  g_mutex_unlock (&job->lock);
+
+  g_clear_error (&error);
+  g_cancellable_cancel (job->cancellable);
+}
+
+static void
+tree_job_add_progress (TreeJob *job,
+                       goffset  current,
+                       goffset  total)
+{
+  if (job->progress_callback == NULL)
+    return;
+
+  g_mutex_lock (&job->lock);
+  job->current_num_bytes += current;
+  job->total_num_bytes += total;
+  job->progress_changed = TRUE;
+  g_mutex_unlock (&job->lock);
+}
+
+static gboolean
+tree_job_report_progress (gpointer user_data)
+{
+  TreeJob *job = user_data;
+  goffset current, total;
+  gboolean changed;
+
+  g_mutex_lock (&job->lock);
+  current = job->current_num_bytes;
+  total = job->total_num_bytes;
+  changed = job->progress_changed;
+  job->progress_changed = FALSE;
+  g_mutex_unlock (&job->lock);
+
+  if (changed)
+    job->progress_callback (current, total, job->progress_callback_data);
+
+  return G_SOURCE_CONTINUE;
+}
+
+typedef struct
+{
+  TreeJob *job;
+  goffset last_num_bytes;
+} TreeCopyProgress;
+
+static void
+tree_copy_progress_cb (goffset  current_num_bytes,
+                       goffset  total_num_bytes,
+                       gpointer user_data)
+{
+  TreeCopyProgress *progress = user_data;
+
+  tree_job_add_progress (progress->job, current_num_bytes - progress->last_num_bytes, 0);
+  progress->last_num_bytes = current_num_bytes;
+}
+
+static GFileQueryInfoFlags
+tree_job_query_flags (TreeJob *job)
+{
+  /* Never delete what symlinks point to */
+  if (job->op == TREE_OP_DELETE || (job->flags & G_FILE_COPY_NOFOLLOW_SYMLINKS))
+    return G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS;
+
+  return G_FILE_QUERY_INFO_NONE;
+}
+
+static gboolean
+tree_node_enumerate (TreeJob   *job,
+                     TreeNode  *node,
+                     GError   **error)
+{
+  GFileEnumerator *enumerator;
+  GFileInfo *info;
+  GFile *child;
+  gboolean ret = FALSE;
+
+  enumerator = g_file_enumerate_children (node->file,
+                                          G_FILE_ATTRIBUTE_STANDARD_NAME ","
+                                          G_FILE_ATTRIBUTE_STANDARD_TYPE ","
+                                          G_FILE_ATTRIBUTE_STANDARD_SIZE,
+                                          tree_job_query_flags (job),
+                                          job->cancellable, error);
+  if (enumerator == NULL)
+    return FALSE;
+
+  while (TRUE)
+    {
+      TreeNode *child_node;
+      GFile *child_destination = NULL;
+
+      if (!g_file_enumerator_iterate (enumerator, &info, &child, job->cancellable, error))
+        goto out;
+      if (info == NULL)
+        break;
+
+      if (node->destination != NULL)
+        child_destination = g_file_get_child (node->destination, g_file_info_get_name (info));
+
+      child_node = tree_node_new (node, child, child_destination,
+                                  g_file_info_get_file_type (info));
+      g_clear_object (&child_destination);
+
+      if (child_node->type == G_FILE_TYPE_REGULAR)
+        tree_job_add_progress (job, 0, g_file_info_get_size (info));
+
+      g_atomic_int_inc (&node->pending);
+      g_thread_pool_push (job->pool, child_node, NULL);
+    }
+
+  ret = TRUE;
+
+ out:
+  g_object_unref (enumerator);
+
+  return ret;
+}
+
+static gboolean
+tree_node_make_directory (TreeJob   *job,
+                          TreeNode  *node,
+                          GError   **error)
+{
+  GError *local_error = NULL;
+
+  if (g_file_make_directory (node->destination, job->cancellable, &local_error))
+    return TRUE;
+
+  /* With G_FILE_COPY_OVERWRITE, directories are merged */
+  if (g_error_matches (local_error, G_IO_ERROR, G_IO_ERROR_EXISTS) &&
+      (job->flags & G_FILE_COPY_OVERWRITE) &&
+      g_file_query_file_type (node->destination, G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS,
+                              job->cancellable) == G_FILE_TYPE_DIRECTORY)
+    {
+      g_clear_error (&local_error);
+      return TRUE;
+    }
+
+  g_propagate_error (error, local_error);
+  return FALSE;
+}
+
+static void
+tree_job_complete (TreeJob *job);
+
+/* Drops a reference on @node, completing it and then its parents as
+ * they run out of pending work */
+static void
+tree_node_done (TreeJob  *job,
+                TreeNode *node)
+{
+  while (node != NULL && g_atomic_int_dec_and_test (&node->pending))
+    {
+      TreeNode *parent = node->parent;
+      GError *error = NULL;
+
+      if (node->type == G_FILE_TYPE_DIRECTORY &&
+          !g_cancellable_is_cancelled (job->cancellable))
+        {
+          if (job->op == TREE_OP_DELETE)
+            {
+              if (!g_file_delete (node->file, job->cancellable, &error))
+                tree_job_fail (job, g_steal_pointer (&error));
+            }
+          else
+            {
+              /* Like g_file_copy(), failing to copy metadata is not fatal */
+              (void) g_file_copy_attributes (node->file, node->destination,
+                                             job->flags, job->cancellable, NULL);
+            }
+        }
+
+      tree_node_free (node);
+
+      if (parent == NULL)
+        tree_job_complete (job);
+
+      node = parent;
+    }
+}
+
+static void
+tree_node_process (gpointer data,
+                   gpointer user_data)
+{
+  TreeNode *node = data;
+  TreeJob *job = user_data;
+  GError *error = NULL;
+
+  if (g_cancellable_is_cancelled (job->cancellable))
+    goto out;
+
+  if (node->type == G_FILE_TYPE_UNKNOWN)
+    {
+      GFileInfo *info;
+
+      info = g_file_query_info (node->file,
+                                G_FILE_ATTRIBUTE_STANDARD_TYPE ","
+                                G_FILE_ATTRIBUTE_STANDARD_SIZE,
+                                tree_job_query_flags (job),
+                                job->cancellable, &error);
+      if (info == NULL)
+        goto out;
+
+      node->type = g_file_info_get_file_type (info);
+      if (node->type == G_FILE_TYPE_REGULAR)
+        tree_job_add_progress (job, 0, g_file_info_get_size (info));
+      g_object_unref (info);
+    }
+
+  if (node->type == G_FILE_TYPE_DIRECTORY)
+    {
+      if (job->op == TREE_OP_COPY &&
+          !tree_node_make_directory (job, node, &error))
+        goto out;
+
+      tree_node_enumerate (job, node, &error);
+    }
+  else if (job->op == TREE_OP_COPY)
+    {
+      TreeCopyProgress progress = { job, 0 };
+
+      g_file_copy (node->file, node->destination, job->flags, job->cancellable,
+                   job->progress_callback ? tree_copy_progress_cb : NULL, &progress,
+                   &error);
+    }
+  else
+    {
+      g_file_delete (node->file, job->cancellable, &error);
+    }
+
+ out:
+  if (error != NULL)
+    tree_job_fail (job, g_steal_pointer (&error));
+
+  tree_node_done (job, node);
+}
+
+static void
+tree_job_free (TreeJob *job)
+{
+  g_clear_error (&job->error);
+  g_clear_object (&job->cancellable);
+  g_clear_object (&job->caller_cancellable);
+  g_mutex_clear (&job->lock);
+  g_free (job);
+}
+
+static gboolean
+tree_job_return (gpointer user_data)
+{
+  TreeJob *job = user_data;
+  GTask *task = g_steal_pointer (&job->task);
+
+  /* Waits for the last worker to return */
+  g_thread_pool_free (job->pool, FALSE, TRUE);
+
+  if (job->progress_source != NULL)
+    {
+      g_source_destroy (job->progress_source);
+      g_clear_pointer (&job->progress_source, g_source_unref);
+      tree_job_report_progress (job);
+    }
+
+  g_cancellable_disconnect (job->caller_cancellable, job->cancelled_id);
+
+  if (job->error == NULL)
+    g_cancellable_set_error_if_cancelled (job->cancellable, &job->error);
+
+  if (job->error != NULL)
+    g_task_return_error (task, g_steal_pointer (&job->error));
+  else
+    g_task_return_boolean (task, TRUE);
+
+  tree_job_free (job);
+  g_object_unref (task);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+tree_job_complete (TreeJob *job)
+{
+  GSource *source;
+
+  /* The thread pool can’t be freed from one of its threads, so always
+   * return from the task’s main context rather than directly */
+  source = g_idle_source_new ();
+  g_source_set_priority (source, g_task_get_priority (job->task));
+  g_source_set_callback (source, tree_job_return, job, NULL);
+  g_source_set_static_name (source, "[gio] tree job return");
+  g_source_attach (source, g_task_get_context (job->task));
+  g_source_unref (source);
+}
+
+static void
+tree_job_cancelled_cb (GCancellable *cancellable,
+                       gpointer      user_data)
+{
+  g_cancellable_cancel (G_CANCELLABLE (user_data));
+}
+
+static void
+tree_job_start (TreeOp                 op,
+                GFile                 *file,
+                GFile                 *destination,
+                GFileCopyFlags         flags,
+                guint                  max_threads,
+                int                    io_priority,
+                GCancellable          *cancellable,
+                GFileProgressCallback  progress_callback,
+                gpointer               progress_callback_data,
+                gpointer               source_tag,
+                GAsyncReadyCallback    callback,
+                gpointer               user_data)
+{
+  TreeJob *job;
+
+  job = g_new0 (TreeJob, 1);
+  job->op = op;
+  job->flags = flags;
+  job->progress_callback = progress_callback;
+  job->progress_callback_data = progress_callback_data;
+  g_mutex_init (&job->lock);
+
+  job->task = g_task_new (file, cancellable, callback, user_data);
+  g_task_set_source_tag (job->task, source_tag);
+  g_task_set_priority (job->task, io_priority);
+  /* Errors, cancellation included, are reported by the job */
+  g_task_set_check_cancellable (job->task, FALSE);
+
+  job->cancellable = g_cancellable_new ();
+  if (cancellable != NULL)
+    {
+      job->caller_cancellable = g_object_ref (cancellable);
+      job->cancelled_id = g_cancellable_connect (cancellable,
+                                                 G_CALLBACK (tree_job_cancelled_cb),
+                                                 g_object_ref (job->cancellable),
+                                                 g_object_unref);
+    }
+
+  if (progress_callback != NULL)
+    {
+      job->progress_source = g_timeout_source_new (TREE_PROGRESS_INTERVAL_MS);
+      g_source_set_priority (job->progress_source, io_priority);
+      g_source_set_callback (job->progress_source, tree_job_report_progress, job, NULL);
+      g_source_set_static_name (job->progress_source, "[gio] tree job progress");
+      g_source_attach (job->progress_source, g_task_get_context (job->task));
+    }
+
+  if (max_threads == 0)
+    max_threads = g_get_num_processors ();
+
+  job->pool = g_thread_pool_new (tree_node_process, job, max_threads, FALSE, NULL);
+  g_thread_pool_push (job->pool,
+                      tree_node_new (NULL, file, destination, G_FILE_TYPE_UNKNOWN),
+                      NULL);
+}
+
+/**
+ * g_file_delete_tree_async:
+ * @file: input #GFile
+ * @max_threads: the maximum number of files to delete at the same time,
+ *   or 0 for one per processor
+ * @io_priority: the [I/O priority](iface.AsyncResult.html#io-priority)
+ *   of the request
+ * @cancellable: (nullable): optional #GCancellable object,
+ *   %NULL to ignore
+ * @callback: (scope async) (closure user_data): a #GAsyncReadyCallback
+ *   to call when the request is satisfied
+ * @user_data: the data to pass to callback function
+ *
+ * Asynchronously deletes @file and, if it is a directory, everything
+ * below it. Symbolic links are deleted, not followed.
+ *
+ * Subdirectories are processed in parallel, on up to @max_threads
+ * threads, which is much faster than deleting one file after the other
+ * on file systems with a high latency per operation.
+ *
+ * The operation stops at the first error, which is then reported by
+ * g_file_delete_tree_finish(); some files may have been deleted already.
+ *
+ * Since: 2.82
+ */
+void
+g_file_delete_tree_async (GFile               *file,
+                          guint                max_threads,
+                          int                  io_priority,
+                          GCancellable        *cancellable,
+                          GAsyncReadyCallback  callback,
+                          gpointer             user_data)
+{
+  g_return_if_fail (G_IS_FILE (file));
+  g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+  tree_job_start (TREE_OP_DELETE, file, NULL, G_FILE_COPY_NONE, max_threads,
+                  io_priority, cancellable, NULL, NULL,
+                  g_file_delete_tree_async, callback, user_data);
+}
+
+/**
+ * g_file_delete_tree_finish:
+ * @file: input #GFile
+ * @result: a #GAsyncResult
+ * @error: a #GError, or %NULL
+ *
+ * Finishes an operation started with g_file_delete_tree_async().
+ *
+ * Returns: %TRUE if the whole tree was deleted, %FALSE otherwise.
+ *
+ * Since: 2.82
+ */
+gboolean
+g_file_delete_tree_finish (GFile         *file,
+                           GAsyncResult  *result,
+                           GError       **error)
+{
+  g_return_val_if_fail (G_IS_FILE (file), FALSE);
+  g_return_val_if_fail (g_task_is_valid (result, file), FALSE);
+  g_return_val_if_fail (g_async_result_is_tagged (result, g_file_delete_tree_async), FALSE);
+
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+/**
+ * g_file_copy_tree_async:
+ * @source: input #GFile
+ * @destination: destination #GFile
+ * @flags: set of #GFileCopyFlags
+ * @max_threads: the maximum number of files to copy at the same time,
+ *   or 0 for one per processor
+ * @io_priority: the [I/O priority](iface.AsyncResult.html#io-priority)
+ *   of the request
+ * @cancellable: (nullable): optional #GCancellable object,
+ *   %NULL to ignore
+ * @progress_callback: (nullable) (scope notified) (closure progress_callback_data):
+ *   function to callback with progress information, or %NULL if
+ *   progress information is not needed
+ * @progress_callback_data: user data to pass to @progress_callback
+ * @callback: (scope async) (closure user_data): a #GAsyncReadyCallback
+ *   to call when the request is satisfied
+ * @user_data: the data to pass to callback function
+ *
+ * Asynchronously copies @source to @destination and, if @source is a
+ * directory, everything below it. Each file is copied as by g_file_copy()
+ * with @flags, so the same fast paths are used, such as sharing the data
+ * of the files on file systems which support reflinks.
+ *
+ * Subdirectories are processed in parallel, on up to @max_threads
+ * threads. The attributes of directories are copied once everything
+ * in them has been.
+ *
+ * If %G_FILE_COPY_OVERWRITE is specified, existing directories in
+ * @destination are merged with the copied ones, and existing files are
+ * overwritten. Otherwise the operation fails with %G_IO_ERROR_EXISTS.
+ *
+ * @progress_callback is called in the [thread-default main context][g-main-context-push-thread-default]
+ * of the calling thread, at most every 100 milliseconds. `total_num_bytes`
+ * is the size of the files found so far, so it grows while directories are
+ * being read.
+ *
+ * The operation stops at the first error, which is then reported by
+ * g_file_copy_tree_finish(); some files may have been copied already.
+ *
+ * Since: 2.82
+ */
+void
+g_file_copy_tree_async (GFile                  *source,
+                        GFile                  *destination,
+                        GFileCopyFlags          flags,
+                        guint                   max_threads,
+                        int                     io_priority,
+                        GCancellable           *cancellable,
+                        GFileProgressCallback   progress_callback,
+                        gpointer                progress_callback_data,
+                        GAsyncReadyCallback     callback,
+                        gpointer                user_data)
+{
+  g_return_if_fail (G_IS_FILE (source));
+  g_return_if_fail (G_IS_FILE (destination));
+  g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+  tree_job_start (TREE_OP_COPY, source, destination, flags, max_threads,
+                  io_priority, cancellable, progress_callback, progress_callback_data,
+                  g_file_copy_tree_async, callback, user_data);
+}
+
+/**
+ * g_file_copy_tree_finish:
+ * @file: input #GFile
+ * @result: a #GAsyncResult
+ * @error: a #GError, or %NULL
+ *
+ * Finishes an operation started with g_file_copy_tree_async().
+ *
+ * Returns: %TRUE if the whole tree was copied, %FALSE otherwise.
+ *
+ * Since: 2.82
+ */
+gboolean
+g_file_copy_tree_finish (GFile         *file,
+                         GAsyncResult  *result,
+                         GError       **error)
+{
+  g_return_val_if_fail (G_IS_FILE (file), FALSE);
+  g_return_val_if_fail (g_task_is_valid (result, file), FALSE);
+  g_return_val_if_fail (g_async_result_is_tagged (result, g_file_copy_tree_async), FALSE);
+
+  return g_task_propagate_boolean (G_TASK (result), error);
 }
 
 /**
@@ -9431,7 +10069,9 @@ g_file_supports_thread_contexts (GFile *file)
  * Loads the contents of @file and returns it as #GBytes.
  *
  * If @file is a resource:// based URI, the resulting bytes will reference the
- * embedded resource instead of a copy. Otherwise, this is equivalent to calling
+ * embedded resource instead of a copy. If @file is a local file, it is loaded
+ * with g_file_get_contents_bytes(), so large files may be mapped into memory
+ * rather than read. Otherwise, this is equivalent to calling
  * g_file_load_contents() and g_bytes_new_take().
  *
  * For resources, @etag_out will be set to %NULL.
@@ -9475,6 +10115,44 @@ g_file_load_bytes (GFile         *file,
       return bytes;
     }
 
+  if (G_IS_LOCAL_FILE (file))
+    {
+      GBytes *bytes;
+      GError *local_error = NULL;
+
+      if (g_cancellable_set_error_if_cancelled (cancellable, error))
+        return NULL;
+
+      bytes = g_file_get_contents_bytes (g_file_peek_path (file), &local_error);
+
+      if (bytes == NULL)
+        {
+          g_set_error_literal (error, G_IO_ERROR,
+                               g_io_error_from_file_error (local_error->code),
+                               local_error->message);
+          g_error_free (local_error);
+          return NULL;
+        }
+
+      if (etag_out != NULL)
+        {
+          GFileInfo *info;
+
+          info = g_file_query_info (file, G_FILE_ATTRIBUTE_ETAG_VALUE,
+                                    G_FILE_QUERY_INFO_NONE, cancellable, error);
+          if (info == NULL)
+            {
+              g_bytes_unref (bytes);
+              return NULL;
+            }
+
+          *etag_out = g_strdup (g_file_info_get_etag (info));
+          g_object_unref (info);
+        }
+
+      return bytes;
+    }
+
   /* contents is guaranteed to be \0 terminated */
   if (g_file_load_contents (file, cancellable, &contents, &len, etag_out, error))
     return g_bytes_new_take (g_steal_pointer (&contents), len);
@@ -9607,3 +10285,491 @@ g_file_load_bytes_finish (GFile         *file,
 
   return bytes;
 }
+
+/* Checksumming: reads are double-buffered, with the hashing of one chunk
+ * done on a second thread while the next chunk is read. Files which fit
+ * in one chunk are hashed directly. */
+
+#define CHECKSUM_CHUNK_SIZE (256 * 1024)
+
+typedef struct
+{
+  guint8 *data;
+  gsize size;  /* < CHECKSUM_CHUNK_SIZE for the last chunk */
+} ChecksumChunk;
+
+typedef struct
+{
+  GChecksum **checksums;
+  gsize n_checksums;
+  GAsyncQueue *filled;  /* (element-type ChecksumChunk) */
+  GAsyncQueue *empty;   /* (element-type ChecksumChunk) */
+} ChecksumHasher;
+
+static void
+checksums_update (GChecksum    **checksums,
+                  gsize          n_checksums,
+                  const guint8  *data,
+                  gsize          size)
+{
+  gsize i;
+
+  for (i = 0; i < n_checksums; i++)
+    g_checksum_update (checksums[i], data, size);
+}
+
+static gpointer
+checksum_hasher_thread (gpointer user_data)
+{
+  ChecksumHasher *hasher = user_data;
+  gboolean done = FALSE;
+
+  while (!done)
+    {
+      ChecksumChunk *chunk = g_async_queue_pop (hasher->filled);
+
+      checksums_update (hasher->checksums, hasher->n_checksums, chunk->data, chunk->size);
+      done = chunk->size < CHECKSUM_CHUNK_SIZE;
+      g_async_queue_push (hasher->empty, chunk);
+    }
+
+  return NULL;
+}
+
+static gboolean
+checksums_read_stream (GInputStream  *stream,
+                       GChecksum    **checksums,
+                       gsize          n_checksums,
+                       GCancellable  *cancellable,
+                       GError       **error)
+{
+  ChecksumChunk chunks[2];
+  ChecksumHasher hasher;
+  GThread *thread;
+  gsize size;
+  gboolean ret = TRUE;
+
+  chunks[0].data = g_malloc (CHECKSUM_CHUNK_SIZE);
+  chunks[1].data = NULL;
+
+  if (!g_input_stream_read_all (stream, chunks[0].data, CHECKSUM_CHUNK_SIZE,
+                                &chunks[0].size, cancellable, error))
+    {
+      g_free (chunks[0].data);
+      return FALSE;
+    }
+
+  /* Small files are not worth a thread */
+  if (chunks[0].size < CHECKSUM_CHUNK_SIZE)
+    {
+      checksums_update (checksums, n_checksums, chunks[0].data, chunks[0].size);
+      g_free (chunks[0].data);
+      return TRUE;
+    }
+
+  chunks[1].data = g_malloc (CHECKSUM_CHUNK_SIZE);
+
+  hasher.checksums = checksums;
+  hasher.n_checksums = n_checksums;
+  hasher.filled = g_async_queue_new ();
+  hasher.empty = g_async_queue_new ();
+  g_async_queue_push (hasher.filled, &chunks[0]);
+  g_async_queue_push (hasher.empty, &chunks[1]);
+
+  thread = g_thread_new ("[gio] checksum", checksum_hasher_thread, &hasher);
+
+  do
+    {
+      ChecksumChunk *chunk = g_async_queue_pop (hasher.empty);
+
+      if (!g_input_stream_read_all (stream, chunk->data, CHECKSUM_CHUNK_SIZE,
+                                    &size, cancellable, error))
+        {
+          /* A short chunk also stops the hasher */
+          size = 0;
+          ret = FALSE;
+        }
+
+      chunk->size = size;
+      g_async_queue_push (hasher.filled, chunk);
+    }
+  while (size == CHECKSUM_CHUNK_SIZE);
+
+  g_thread_join (thread);
+
+  g_async_queue_unref (hasher.filled);
+  g_async_queue_unref (hasher.empty);
+  g_free (chunks[0].data);
+  g_free (chunks[1].data);
+
+  return ret;
+}
+
+/**
+ * g_file_compute_checksum:
+ * @file: input #GFile
+ * @checksum_types: (array length=n_checksum_types): the checksums to compute
+ * @n_checksum_types: the length of @checksum_types, which must be non-zero
+ * @cancellable: (nullable): optional #GCancellable object,
+ *   %NULL to ignore
+ * @error: a #GError, or %NULL
+ *
+ * Computes checksums of the contents of @file, in a single pass over it.
+ *
+ * This is more efficient than reading the file and calling
+ * g_checksum_update() in a loop: the file is read in large chunks, with
+ * the kernel told that it is read sequentially where that is possible,
+ * and each chunk is hashed on a second thread while the next one is read.
+ *
+ * If @cancellable is not %NULL, then the operation can be cancelled by
+ * triggering the cancellable object from another thread. If the operation
+ * was cancelled, the error %G_IO_ERROR_CANCELLED will be returned.
+ *
+ * Returns: (transfer full) (array zero-terminated=1): the checksums of
+ *   @file as hexadecimal strings, in the order of @checksum_types, or
+ *   %NULL on error
+ *
+ * Since: 2.82
+ */
+gchar **
+g_file_compute_checksum (GFile               *file,
+                         const GChecksumType *checksum_types,
+                         gsize                n_checksum_types,
+                         GCancellable        *cancellable,
+                         GError             **error)
+{
+  GFileInputStream *stream;
+  GChecksum **checksums;
+  gchar **digests = NULL;
+  gsize i;
+
+  g_return_val_if_fail (G_IS_FILE (file), NULL);
+  g_return_val_if_fail (checksum_types != NULL, NULL);
+  g_return_val_if_fail (n_checksum_types > 0, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  for (i = 0; i < n_checksum_types; i++)
+    g_return_val_if_fail (g_checksum_type_get_length (checksum_types[i]) > 0, NULL);
+
+  stream = g_file_read (file, cancellable, error);
+  if (stream == NULL)
+    return NULL;
+
+#if defined(HAVE_POSIX_FADVISE) && defined(POSIX_FADV_SEQUENTIAL)
+  /* More readahead; this is only a hint, so failure is not an error */
+  if (G_IS_FILE_DESCRIPTOR_BASED (stream))
+    (void) posix_fadvise (g_file_descriptor_based_get_fd (G_FILE_DESCRIPTOR_BASED (stream)),
+                          0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+  checksums = g_new (GChecksum *, n_checksum_types);
+  for (i = 0; i < n_checksum_types; i++)
+    checksums[i] = g_checksum_new (checksum_types[i]);
+
+  if (checksums_read_stream (G_INPUT_STREAM (stream), checksums, n_checksum_types,
+                             cancellable, error))
+    {
+      digests = g_new (gchar *, n_checksum_types + 1);
+      for (i = 0; i < n_checksum_types; i++)
+        digests[i] = g_strdup (g_checksum_get_string (checksums[i]));
+      digests[n_checksum_types] = NULL;
+    }
+
+  for (i = 0; i < n_checksum_types; i++)
+    g_checksum_free (checksums[i]);
+  g_free (checksums);
+
+  /* Reading is done, so failing to close doesn’t change the checksums */
+  (void) g_input_stream_close (G_INPUT_STREAM (stream), NULL, NULL);
+  g_object_unref (stream);
+
+  return digests;
+}
+
+typedef struct
+{
+  GChecksumType *checksum_types;
+  gsize n_checksum_types;
+} ChecksumData;
+
+static void
+checksum_data_free (ChecksumData *data)
+{
+  g_free (data->checksum_types);
+  g_free (data);
+}
+
+static ChecksumData *
+checksum_data_new (const GChecksumType *checksum_types,
+                   gsize                n_checksum_types)
+{
+  ChecksumData *data;
+
+  data = g_new0 (ChecksumData, 1);
+  data->checksum_types = g_memdup2 (checksum_types, n_checksum_types * sizeof (GChecksumType));
+  data->n_checksum_types = n_checksum_types;
+
+  return data;
+}
+
+static void
+compute_checksum_thread (GTask        *task,
+                         gpointer      object,
+                         gpointer      task_data,
+                         GCancellable *cancellable)
+{
+  ChecksumData *data = task_data;
+  GError *error = NULL;
+  gchar **digests;
+
+  digests = g_file_compute_checksum (G_FILE (object), data->checksum_types,
+                                     data->n_checksum_types, cancellable, &error);
+  if (digests == NULL)
+    g_task_return_error (task, g_steal_pointer (&error));
+  else
+    g_task_return_pointer (task, g_steal_pointer (&digests), (GDestroyNotify) g_strfreev);
+}
+
+/**
+ * g_file_compute_checksum_async:
+ * @file: input #GFile
+ * @checksum_types: (array length=n_checksum_types): the checksums to compute
+ * @n_checksum_types: the length of @checksum_types, which must be non-zero
+ * @io_priority: the [I/O priority](iface.AsyncResult.html#io-priority) of the request
+ * @cancellable: (nullable): optional #GCancellable object,
+ *   %NULL to ignore
+ * @callback: (scope async) (closure user_data): a #GAsyncReadyCallback
+ *   to call when the request is satisfied
+ * @user_data: the data to pass to callback function
+ *
+ * Asynchronously computes checksums of the contents of @file.
+ *
+ * See g_file_compute_checksum() for details. To checksum many files, see
+ * g_file_compute_checksums_async().
+ *
+ * Since: 2.82
+ */
+void
+g_file_compute_checksum_async (GFile               *file,
+                               const GChecksumType *checksum_types,
+                               gsize                n_checksum_types,
+                               int                  io_priority,
+                               GCancellable        *cancellable,
+                               GAsyncReadyCallback  callback,
+                               gpointer             user_data)
+{
+  GTask *task;
+
+  g_return_if_fail (G_IS_FILE (file));
+  g_return_if_fail (checksum_types != NULL);
+  g_return_if_fail (n_checksum_types > 0);
+  g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+  task = g_task_new (file, cancellable, callback, user_data);
+  g_task_set_source_tag (task, g_file_compute_checksum_async);
+  g_task_set_priority (task, io_priority);
+  g_task_set_task_data (task, checksum_data_new (checksum_types, n_checksum_types),
+                        (GDestroyNotify) checksum_data_free);
+  g_task_run_in_thread (task, compute_checksum_thread);
+  g_object_unref (task);
+}
+
+/**
+ * g_file_compute_checksum_finish:
+ * @file: input #GFile
+ * @result: a #GAsyncResult
+ * @error: a #GError, or %NULL
+ *
+ * Finishes an operation started with g_file_compute_checksum_async().
+ *
+ * Returns: (transfer full) (array zero-terminated=1): the checksums of
+ *   @file as hexadecimal strings, in the order they were requested in, or
+ *   %NULL on error
+ *
+ * Since: 2.82
+ */
+gchar **
+g_file_compute_checksum_finish (GFile         *file,
+                                GAsyncResult  *result,
+                                GError       **error)
+{
+  g_return_val_if_fail (G_IS_FILE (file), NULL);
+  g_return_val_if_fail (g_task_is_valid (result, file), NULL);
+  g_return_val_if_fail (g_async_result_is_tagged (result, g_file_compute_checksum_async), NULL);
+
+  return g_task_propagate_pointer (G_TASK (result), error);
+}
+
+/* Checksumming many files: one job per file on a thread pool, completing
+ * the task once all of them have run */
+typedef struct
+{
+  GTask *task;
+  GThreadPool *pool;
+  GFile **files;  /* (owned) (array length=n_files) */
+  gsize n_files;
+  ChecksumData *data;
+  GPtrArray *results;  /* (element-type GStrv) (nullable elements) */
+  gint pending;
+} ChecksumBatch;
+
+static void
+checksum_batch_free (ChecksumBatch *batch)
+{
+  gsize i;
+
+  for (i = 0; i < batch->n_files; i++)
+    g_object_unref (batch->files[i]);
+  g_free (batch->files);
+  checksum_data_free (batch->data);
+  g_clear_pointer (&batch->results, g_ptr_array_unref);
+  g_free (batch);
+}
+
+static gboolean
+checksum_batch_return (gpointer user_data)
+{
+  ChecksumBatch *batch = user_data;
+  GTask *task = g_steal_pointer (&batch->task);
+
+  /* Waits for the last worker to return */
+  g_thread_pool_free (batch->pool, FALSE, TRUE);
+
+  g_task_return_pointer (task, g_steal_pointer (&batch->results),
+                         (GDestroyNotify) g_ptr_array_unref);
+
+  checksum_batch_free (batch);
+  g_object_unref (task);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+checksum_batch_process (gpointer data,
+                        gpointer user_data)
+{
+  ChecksumBatch *batch = user_data;
+  gsize index = GPOINTER_TO_SIZE (data) - 1;
+  GCancellable *cancellable = g_task_get_cancellable (batch->task);
+
+  if (!g_cancellable_is_cancelled (cancellable))
+    batch->results->pdata[index] =
+      g_file_compute_checksum (batch->files[index], batch->data->checksum_types,
+                               batch->data->n_checksum_types, cancellable, NULL);
+
+  if (g_atomic_int_dec_and_test (&batch->pending))
+    {
+      GSource *source;
+
+      /* The thread pool can’t be freed from one of its threads */
+      source = g_idle_source_new ();
+      g_source_set_priority (source, g_task_get_priority (batch->task));
+      g_source_set_callback (source, checksum_batch_return, batch, NULL);
+      g_source_set_static_name (source, "[gio] checksum batch return");
+      g_source_attach (source, g_task_get_context (batch->task));
+      g_source_unref (source);
+    }
+}
+
+/**
+ * g_file_compute_checksums_async:
+ * @files: (array length=n_files): the files to checksum
+ * @n_files: the length of @files
+ * @checksum_types: (array length=n_checksum_types): the checksums to compute
+ *   for each file
+ * @n_checksum_types: the length of @checksum_types, which must be non-zero
+ * @max_threads: the maximum number of files to checksum at the same time,
+ *   or 0 for the number of processors
+ * @io_priority: the [I/O priority](iface.AsyncResult.html#io-priority) of the request
+ * @cancellable: (nullable): optional #GCancellable object,
+ *   %NULL to ignore
+ * @callback: (scope async) (closure user_data): a #GAsyncReadyCallback
+ *   to call when the request is satisfied
+ * @user_data: the data to pass to callback function
+ *
+ * Asynchronously computes checksums of the contents of many files, like
+ * g_file_compute_checksum() does for each, spread over up to
+ * @max_threads threads.
+ *
+ * Files which cannot be read do not fail the whole operation: their
+ * entry in the result of g_file_compute_checksums_finish() is %NULL, and
+ * g_file_compute_checksum() can be used to find out why.
+ *
+ * Since: 2.82
+ */
+void
+g_file_compute_checksums_async (GFile               **files,
+                                gsize                 n_files,
+                                const GChecksumType  *checksum_types,
+                                gsize                 n_checksum_types,
+                                guint                 max_threads,
+                                int                   io_priority,
+                                GCancellable         *cancellable,
+                                GAsyncReadyCallback   callback,
+                                gpointer              user_data)
+{
+  ChecksumBatch *batch;
+  gsize i;
+
+  g_return_if_fail (files != NULL || n_files == 0);
+  g_return_if_fail (checksum_types != NULL);
+  g_return_if_fail (n_checksum_types > 0);
+  g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+  batch = g_new0 (ChecksumBatch, 1);
+  batch->task = g_task_new (NULL, cancellable, callback, user_data);
+  g_task_set_source_tag (batch->task, g_file_compute_checksums_async);
+  g_task_set_priority (batch->task, io_priority);
+
+  batch->results = g_ptr_array_new_full (n_files, (GDestroyNotify) g_strfreev);
+  g_ptr_array_set_size (batch->results, n_files);
+
+  if (n_files == 0)
+    {
+      GTask *task = g_steal_pointer (&batch->task);
+
+      g_task_return_pointer (task, g_steal_pointer (&batch->results),
+                             (GDestroyNotify) g_ptr_array_unref);
+      g_free (batch);
+      g_object_unref (task);
+      return;
+    }
+
+  batch->files = g_new (GFile *, n_files);
+  for (i = 0; i < n_files; i++)
+    batch->files[i] = g_object_ref (files[i]);
+  batch->n_files = n_files;
+  batch->data = checksum_data_new (checksum_types, n_checksum_types);
+  batch->pending = n_files;
+
+  if (max_threads == 0)
+    max_threads = g_get_num_processors ();
+
+  batch->pool = g_thread_pool_new (checksum_batch_process, batch, max_threads, FALSE, NULL);
+  for (i = 0; i < n_files; i++)
+    g_thread_pool_push (batch->pool, GSIZE_TO_POINTER (i + 1), NULL);
+}
+
+/**
+ * g_file_compute_checksums_finish:
+ * @result: a #GAsyncResult
+ * @error: a #GError, or %NULL
+ *
+ * Finishes an operation started with g_file_compute_checksums_async().
+ *
+ * Returns: (transfer full) (element-type GStrv): for each file in the
+ *   order they were given in, its checksums as returned by
+ *   g_file_compute_checksum(), or %NULL if it could not be read; or %NULL
+ *   if the operation was cancelled
+ *
+ * Since: 2.82
+ */
+GPtrArray *
+g_file_compute_checksums_finish (GAsyncResult  *result,
+                                 GError       **error)
+{
+  g_return_val_if_fail (g_task_is_valid (result, NULL), NULL);
+  g_return_val_if_fail (g_async_result_is_tagged (result, g_file_compute_checksums_async), NULL);
+
+  return g_task_propagate_pointer (G_TASK (result), error);
+}
@@ -909,6 +909,18 @@ gboolean                g_file_delete_finish              (GFile
 							   GAsyncResult               *result,
 							   GError                    **error);
 
+GIO_AVAILABLE_IN_2_82
+void                    g_file_delete_tree_async          (GFile                      *file,
+                                                           guint                       max_threads,
+                                                           int                         io_priority,
+                                                           GCancellable               *cancellable,
+                                                           GAsyncReadyCallback         callback,
+                                                           gpointer                    user_data);
+GIO_AVAILABLE_IN_2_82
+gboolean                g_file_delete_tree_finish         (GFile                      *file,
+                                                           GAsyncResult               *result,
+                                                           GError                    **error);
+
 GIO_AVAILABLE_IN_ALL
 gboolean                g_file_trash                      (GFile                      *file,
 							   GCancellable               *cancellable,
@@ -956,6 +968,21 @@ GIO_AVAILABLE_IN_ALL
 gboolean                g_file_copy_finish                (GFile                      *file,
 							   GAsyncResult               *res,
 							   GError                    **error);
+GIO_AVAILABLE_IN_2_82
+void                    g_file_copy_tree_async            (GFile                      *source,
+                                                           GFile                      *destination,
+                                                           GFileCopyFlags              flags,
+                                                           guint                       max_threads,
+                                                           int                         io_priority,
+                                                           GCancellable               *cancellable,
+                                                           GFileProgressCallback       progress_callback,
+                                                           gpointer                    progress_callback_data,
+                                                           GAsyncReadyCallback         callback,
+                                                           gpointer                    user_data);
+GIO_AVAILABLE_IN_2_82
+gboolean                g_file_copy_tree_finish           (GFile                      *file,
+                                                           GAsyncResult               *result,
+                                                           GError                    **error);
 GIO_AVAILABLE_IN_ALL
 gboolean                g_file_move                       (GFile                      *source,
 							   GFile                      *destination,
@@ -1360,6 +1387,38 @@ GBytes  *g_file_load_bytes_finish            (GFile                  *file,
                                               gchar                 **etag_out,
                                               GError                **error);
 
+GIO_AVAILABLE_IN_2_82
+gchar  **g_file_compute_checksum             (GFile                  *file,
+                                              const GChecksumType    *checksum_types,
+                                              gsize                   n_checksum_types,
+                                              GCancellable           *cancellable,
+                                              GError                **error);
+GIO_AVAILABLE_IN_2_82
+void     g_file_compute_checksum_async       (GFile                  *file,
+                                              const GChecksumType    *checksum_types,
+                                              gsize                   n_checksum_types,
+                                              int                     io_priority,
+                                              GCancellable           *cancellable,
+                                              GAsyncReadyCallback     callback,
+                                              gpointer                user_data);
+GIO_AVAILABLE_IN_2_82
+gchar  **g_file_compute_checksum_finish      (GFile                  *file,
+                                              GAsyncResult           *result,
+                                              GError                **error);
+GIO_AVAILABLE_IN_2_82
+void     g_file_compute_checksums_async      (GFile                 **files,
+                                              gsize                   n_files,
+                                              const GChecksumType    *checksum_types,
+                                              gsize                   n_checksum_types,
+                                              guint                   max_threads,
+                                              int                     io_priority,
+                                              GCancellable           *cancellable,
+                                              GAsyncReadyCallback     callback,
+                                              gpointer                user_data);
+GIO_AVAILABLE_IN_2_82
+GPtrArray *g_file_compute_checksums_finish   (GAsyncResult           *result,
+                                              GError                **error);
+
 G_END_DECLS
 
 #endif /* __G_FILE_H__ */
@@ -158,5 +158,15 @@ void               _g_file_info_set_attribute_stringv_by_id     (GFileInfo
                                                                  guint32                attribute,
 							         char                 **attr_value);
 
+typedef void     (* GFileInfoResolveFunc)                       (GFileInfo             *info,
+                                                                 gpointer               user_data);
+
+void               _g_file_info_defer_attributes                (GFileInfo             *info,
+                                                                 GFileAttributeMatcher *mask,
+                                                                 const guint32         *attributes,
+                                                                 guint                  n_attributes,
+                                                                 GFileInfoResolveFunc   func,
+                                                                 gpointer               user_data,
+                                                                 GDestroyNotify         notify);
 
 #endif /* __G_FILE_INFO_PRIV_H__ */
@@ -86,8 +86,20 @@ struct _GFileInfo
 
   GArray *attributes;
   GFileAttributeMatcher *mask;
+
+  /* Attributes computed on first use, see _g_file_info_defer_attributes() */
+  GPtrArray *deferred;
 };
 
+typedef struct {
+  guint32 *attributes;
+  guint n_attributes;
+  GFileAttributeMatcher *mask;
+  GFileInfoResolveFunc func;
+  gpointer user_data;
+  GDestroyNotify notify;
+} GFileInfoDeferred;
+
 struct _GFileInfoClass
 {
   GObjectClass parent_class;
@@ -107,6 +119,17 @@ static GHashTable *ns_hash = NULL;
 static GHashTable *attribute_hash = NULL;
 static char ***global_attributes = NULL;
 
+/* The well-known attributes registered in ensure_attribute_hash() get
+ * a bit each, so matchers can test them without walking their
+ * sub-matchers. The tables are written once, under the lock, before
+ * any matcher can exist. */
+#define KNOWN_NS_MAX 16
+#define KNOWN_ID_MAX 32
+#define KNOWN_MAX 128
+static guint8 known_attribute_bits[KNOWN_NS_MAX][KNOWN_ID_MAX]; /* bit + 1, or 0 */
+static guint32 known_attribute_ids[KNOWN_MAX];
+static guint n_known_attributes = 0;
+
 /* Attribute ids are 32bit, we split it up like this:
  * |------------|--------------------|
  *   12 bit          20 bit
@@ -180,6 +203,29 @@ _lookup_attribute (const char *attribute)
   return attr_id;
 }
 
+static void
+register_known_attribute (guint32 attr_id)
+{
+  g_assert (GET_NS (attr_id) < KNOWN_NS_MAX);
+  g_assert (GET_ID (attr_id) < KNOWN_ID_MAX);
+  g_assert (n_known_attributes < KNOWN_MAX);
+
+  known_attribute_ids[n_known_attributes] = attr_id;
+  known_attribute_bits[GET_NS (attr_id)][GET_ID (attr_id)] = ++n_known_attributes;
+}
+
+static inline gint
+get_known_attribute_bit (guint32 attr_id)
+{
+  guint32 ns = GET_NS (attr_id);
+  guint32 id = GET_ID (attr_id);
+
+  if (ns >= KNOWN_NS_MAX || id >= KNOWN_ID_MAX)
+    return -1;
+
+  return (gint) known_attribute_bits[ns][id] - 1;
+}
+
 static void
 ensure_attribute_hash (void)
 {
@@ -194,6 +240,7 @@ ensure_attribute_hash (void)
   _u = _lookup_attribute (G_FILE_ATTRIBUTE_ ## name); \
   /* use for generating the ID: g_print ("#define G_FILE_ATTRIBUTE_ID_%s (%u + %u)\n", #name + 17, _u & ~ID_MASK, _u & ID_MASK); */ \
   g_assert (_u == G_FILE_ATTRIBUTE_ID_ ## name); \
+  register_known_attribute (_u); \
 }G_STMT_END
 
   REGISTER_ATTRIBUTE (STANDARD_TYPE);
@@ -341,6 +388,114 @@ lookup_attribute (const char *attribute)
   return attr_id;
 }
 
+static guint matcher_count_known (GFileAttributeMatcher *matcher);
+
+static void
+g_file_info_deferred_free (GFileInfoDeferred *deferred)
+{
+  if (deferred->notify)
+    deferred->notify (deferred->user_data);
+  if (deferred->mask != NO_ATTRIBUTE_MASK)
+    g_file_attribute_matcher_unref (deferred->mask);
+  g_free (deferred->attributes);
+  g_free (deferred);
+}
+
+static gboolean
+g_file_info_deferred_has (GFileInfoDeferred *deferred,
+                          guint32            attr_id)
+{
+  guint i;
+
+  for (i = 0; i < deferred->n_attributes; i++)
+    {
+      if (deferred->attributes[i] == attr_id)
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
+/* Runs the resolvers providing @attr_id, or all of them if @attr_id is 0 */
+static void
+g_file_info_resolve_deferred (GFileInfo *info,
+                              guint32    attr_id)
+{
+  GFileInfoDeferred *deferred;
+  GFileAttributeMatcher *saved_mask;
+  guint i;
+
+  i = 0;
+  while (info->deferred != NULL && i < info->deferred->len)
+    {
+      deferred = g_ptr_array_index (info->deferred, i);
+
+      if (attr_id != 0 && !g_file_info_deferred_has (deferred, attr_id))
+        {
+          i++;
+          continue;
+        }
+
+      /* Take it out first, the resolver sets attributes on @info */
+      g_ptr_array_steal_index (info->deferred, i);
+      if (info->deferred->len == 0)
+        g_clear_pointer (&info->deferred, g_ptr_array_unref);
+
+      /* Only let in what was asked for when the attributes were deferred */
+      saved_mask = info->mask;
+      info->mask = deferred->mask;
+      deferred->func (info, deferred->user_data);
+      info->mask = saved_mask;
+
+      g_file_info_deferred_free (deferred);
+    }
+}
+
+/*
+ * _g_file_info_defer_attributes:
+ * @info: a #GFileInfo
+ * @mask: (nullable): the attribute mask @func runs with
+ * @attributes: (array length=n_attributes): the attribute ids @func sets
+ * @n_attributes: length of @attributes
+ * @func: function setting the attributes on @info
+ * @user_data: data for @func
+ * @notify: (nullable): function to free @user_data
+ *
+ * Arranges for @func to be called the first time any of @attributes is
+ * read, written or removed, or @info is copied or listed, so that
+ * backends can put off computing expensive attributes until somebody
+ * actually needs them. The attributes @func sets are filtered by
+ * @mask, rather than by whichever mask @info has at that point.
+ *
+ * @func runs in the thread that touches @info, which may block on I/O.
+ */
+void
+_g_file_info_defer_attributes (GFileInfo             *info,
+                               GFileAttributeMatcher *mask,
+                               const guint32         *attributes,
+                               guint                  n_attributes,
+                               GFileInfoResolveFunc   func,
+                               gpointer               user_data,
+                               GDestroyNotify         notify)
+{
+  GFileInfoDeferred *deferred;
+
+  g_return_if_fail (G_IS_FILE_INFO (info));
+  g_return_if_fail (func != NULL);
+
+  deferred = g_new0 (GFileInfoDeferred, 1);
+  deferred->attributes = g_memdup2 (attributes, n_attributes * sizeof (guint32));
+  deferred->n_attributes = n_attributes;
+  deferred->mask = mask ? g_file_attribute_matcher_ref (mask) : NO_ATTRIBUTE_MASK;
+  deferred->func = func;
+  deferred->user_data = user_data;
+  deferred->notify = notify;
+
+  if (info->deferred == NULL)
+    info->deferred = g_ptr_array_new_with_free_func ((GDestroyNotify) g_file_info_deferred_free);
+  g_ptr_array_add (info->deferred, deferred);
+}
+
 static void
 g_file_info_finalize (GObject *object)
 {
@@ -350,6 +505,8 @@ g_file_info_finalize (GObject *object)
 
   info = G_FILE_INFO (object);
 
+  g_clear_pointer (&info->deferred, g_ptr_array_unref);
+
   attrs = (GFileAttribute *)info->attributes->data;
   for (i = 0; i < info->attributes->len; i++)
     _g_file_attribute_value_clear (&attrs[i].value);
@@ -408,6 +565,9 @@ g_file_info_copy_into (GFileInfo *src_info,
   g_return_if_fail (G_IS_FILE_INFO (src_info));
   g_return_if_fail (G_IS_FILE_INFO (dest_info));
 
+  g_file_info_resolve_deferred (src_info, 0);
+  g_clear_pointer (&dest_info->deferred, g_ptr_array_unref);
+
   dest = (GFileAttribute *)dest_info->attributes->data;
   for (i = 0; i < dest_info->attributes->len; i++)
     _g_file_attribute_value_clear (&dest[i].value);
@@ -472,10 +632,27 @@ g_file_info_set_attribute_mask (GFileInfo             *info,
 
   if (mask != info->mask)
     {
+      g_file_info_resolve_deferred (info, 0);
+
       if (info->mask != NO_ATTRIBUTE_MASK)
 	g_file_attribute_matcher_unref (info->mask);
       info->mask = g_file_attribute_matcher_ref (mask);
 
+      /* Size the storage for what the mask lets in up front, so that
+       * filling a fresh info doesn't keep growing the array. "*" is
+       * left alone, most backends only set a fraction of everything. */
+      if (info->attributes->len == 0 && mask != NULL)
+        {
+          guint n = matcher_count_known (mask);
+
+          if (n > 0)
+            {
+              g_array_unref (info->attributes);
+              info->attributes = g_array_sized_new (FALSE, FALSE,
+                                                    sizeof (GFileAttribute), n);
+            }
+        }
+
       /* Remove non-matching attributes */
       for (i = 0; i < info->attributes->len; i++)
 	{
@@ -565,6 +742,9 @@ g_file_info_find_value (GFileInfo *info,
   GFileAttribute *attrs;
   guint i;
 
+  if (G_UNLIKELY (info->deferred != NULL))
+    g_file_info_resolve_deferred (info, attr_id);
+
   i = g_file_info_find_place (info, attr_id);
   attrs = (GFileAttribute *)info->attributes->data;
   if (i < info->attributes->len &&
@@ -633,6 +813,8 @@ g_file_info_has_namespace (GFileInfo  *info,
 
   ns_id = lookup_namespace (name_space);
 
+  g_file_info_resolve_deferred (info, 0);
+
   attrs = (GFileAttribute *)info->attributes->data;
   for (i = 0; i < info->attributes->len; i++)
     {
@@ -667,6 +849,8 @@ g_file_info_list_attributes (GFileInfo  *info,
 
   g_return_val_if_fail (G_IS_FILE_INFO (info), NULL);
 
+  g_file_info_resolve_deferred (info, 0);
+
   names = g_ptr_array_new ();
   attrs = (GFileAttribute *)info->attributes->data;
   for (i = 0; i < info->attributes->len; i++)
@@ -719,6 +903,9 @@ g_file_info_remove_value (GFileInfo *info,
       !_g_file_attribute_matcher_matches_id (info->mask, attr_id))
     return;
 
+  if (G_UNLIKELY (info->deferred != NULL))
+    g_file_info_resolve_deferred (info, attr_id);
+
   i = g_file_info_find_place (info, attr_id);
 
   attrs = (GFileAttribute *)info->attributes->data;
@@ -1145,6 +1332,10 @@ g_file_info_create_value (GFileInfo *info,
       !_g_file_attribute_matcher_matches_id (info->mask, attr_id))
     return NULL;
 
+  /* Resolve first, so a later resolution doesn't overwrite this value */
+  if (G_UNLIKELY (info->deferred != NULL))
+    g_file_info_resolve_deferred (info, attr_id);
+
   i = g_file_info_find_place (info, attr_id);
 
   attrs = (GFileAttribute *)info->attributes->data;
@@ -2597,6 +2788,9 @@ struct _GFileAttributeMatcher {
 
   GArray *sub_matchers;
 
+  /* One bit per well-known attribute, see matcher_compile() */
+  guint64 known_mask[KNOWN_MAX / 64];
+
   /* Iterator */
   guint32 iterator_ns;
   gint iterator_pos;
@@ -2632,6 +2826,61 @@ sub_matcher_matches (SubMatcher *matcher,
   return matcher->id == (submatcher->id & matcher->mask);
 }
 
+static gboolean matcher_matches_id (GFileAttributeMatcher *matcher,
+                                    guint32                id);
+
+/* Precomputes the result of matching every well-known attribute, so
+ * that checking one of them is a single bit test.
+ */
+static void
+matcher_compile (GFileAttributeMatcher *matcher)
+{
+  guint i;
+
+  memset (matcher->known_mask, 0, sizeof (matcher->known_mask));
+
+  for (i = 0; i < n_known_attributes; i++)
+    {
+      if (matcher_matches_id (matcher, known_attribute_ids[i]))
+        matcher->known_mask[i / 64] |= G_GUINT64_CONSTANT (1) << (i % 64);
+    }
+}
+
+static inline gboolean
+matcher_matches_id_fast (GFileAttributeMatcher *matcher,
+                         guint32                id)
+{
+  gint bit;
+
+  bit = get_known_attribute_bit (id);
+  if (bit >= 0)
+    return (matcher->known_mask[bit / 64] >> (bit % 64)) & 1;
+
+  return matcher_matches_id (matcher, id);
+}
+
+static guint
+matcher_count_known (GFileAttributeMatcher *matcher)
+{
+  guint i, n = 0;
+
+  if (matcher->all)
+    return 0;
+
+  for (i = 0; i < G_N_ELEMENTS (matcher->known_mask); i++)
+    {
+      guint64 v = matcher->known_mask[i];
+
+      while (v != 0)
+        {
+          v &= v - 1;
+          n++;
+        }
+    }
+
+  return n;
+}
+
 /* Call this function after modifying a matcher.
  * It will ensure all the invariants other functions rely on.
  */
@@ -2681,6 +2930,8 @@ matcher_optimize (GFileAttributeMatcher *matcher)
 
   g_array_set_size (matcher->sub_matchers, j + 1);
 
+  matcher_compile (matcher);
+
   return matcher;
 }
 
@@ -2944,7 +3195,7 @@ _g_file_attribute_matcher_matches_id (GFileAttributeMatcher *matcher,
   if (matcher->all)
     return TRUE;
 
-  return matcher_matches_id (matcher, id);
+  return matcher_matches_id_fast (matcher, id);
 }
 
 /**
@@ -2971,7 +3222,7 @@ g_file_attribute_matcher_matches (GFileAttributeMatcher *matcher,
   if (matcher->all)
     return TRUE;
 
-  return matcher_matches_id (matcher, lookup_attribute (attribute));
+  return matcher_matches_id_fast (matcher, lookup_attribute (attribute));
 }
 
 /* return TRUE -> all */
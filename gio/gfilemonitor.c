@@ -53,6 +53,7 @@
 struct _GFileMonitorPrivate
 {
   gboolean cancelled;
+  gboolean batching;
 };
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (GFileMonitor, g_file_monitor, G_TYPE_OBJECT)
@@ -61,10 +62,12 @@ enum
 {
   PROP_0,
   PROP_RATE_LIMIT,
-  PROP_CANCELLED
+  PROP_CANCELLED,
+  PROP_BATCHING
 };
 
 static guint g_file_monitor_changed_signal;
+static guint g_file_monitor_changed_batch_signal;
 
 static void
 g_file_monitor_set_property (GObject      *object,
@@ -82,6 +85,10 @@ g_file_monitor_set_property (GObject      *object,
       /* not supported by default */
       break;
 
+    case PROP_BATCHING:
+      g_file_monitor_set_batching (G_FILE_MONITOR (object), g_value_get_boolean (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -107,6 +114,10 @@ g_file_monitor_get_property (GObject    *object,
       //g_mutex_unlock (&fms->lock);
       break;
 
+    case PROP_BATCHING:
+      g_value_set_boolean (value, G_FILE_MONITOR (object)->priv->batching);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -188,6 +199,33 @@ g_file_monitor_class_init (GFileMonitorClass *klass)
                               G_TYPE_FROM_CLASS (klass),
                               _g_cclosure_marshal_VOID__OBJECT_OBJECT_ENUMv);
 
+  /**
+   * GFileMonitor::changed-batch:
+   * @monitor: a #GFileMonitor.
+   * @changes: (element-type GFileMonitorChange): the changes
+   *
+   * Emitted instead of #GFileMonitor::changed when
+   * #GFileMonitor:batching is enabled, with all the changes that were
+   * ready at once.
+   *
+   * Each element of @changes has the same meaning as the arguments of
+   * #GFileMonitor::changed, and the elements are in the order in which
+   * #GFileMonitor::changed would have been emitted.  Monitors may also
+   * coalesce the changes of a batch which are redundant for a single
+   * file, such as %G_FILE_MONITOR_EVENT_CHANGED right after
+   * %G_FILE_MONITOR_EVENT_CREATED.
+   *
+   * Since: 2.82
+   **/
+  g_file_monitor_changed_batch_signal = g_signal_new (I_("changed-batch"),
+                                                      G_TYPE_FILE_MONITOR,
+                                                      G_SIGNAL_RUN_LAST,
+                                                      0,
+                                                      NULL, NULL,
+                                                      g_cclosure_marshal_VOID__BOXED,
+                                                      G_TYPE_NONE, 1,
+                                                      G_TYPE_ARRAY | G_SIGNAL_TYPE_STATIC_SCOPE);
+
   /**
    * GFileMonitor:rate-limit:
    *
@@ -206,6 +244,19 @@ g_file_monitor_class_init (GFileMonitorClass *klass)
   g_object_class_install_property (object_class, PROP_CANCELLED,
                                    g_param_spec_boolean ("cancelled", NULL, NULL,
                                                          FALSE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GFileMonitor:batching:
+   *
+   * Whether changes are reported with #GFileMonitor::changed-batch
+   * rather than #GFileMonitor::changed.
+   *
+   * Since: 2.82
+   */
+  g_object_class_install_property (object_class, PROP_BATCHING,
+                                   g_param_spec_boolean ("batching", NULL, NULL,
+                                                         FALSE, G_PARAM_READWRITE |
+                                                         G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS));
 }
 
 /**
@@ -268,6 +319,54 @@ g_file_monitor_set_rate_limit (GFileMonitor *monitor,
   g_object_set (monitor, "rate-limit", limit_msecs, NULL);
 }
 
+/**
+ * g_file_monitor_set_batching:
+ * @monitor: a #GFileMonitor.
+ * @batching: whether to report changes in batches
+ *
+ * Sets whether @monitor reports changes with one emission of
+ * #GFileMonitor::changed-batch for all the changes which are ready at
+ * once, rather than one emission of #GFileMonitor::changed per change.
+ *
+ * Batching is much cheaper when a lot of files change in a short time,
+ * for instance during a checkout of a large source tree.
+ *
+ * Since: 2.82
+ */
+void
+g_file_monitor_set_batching (GFileMonitor *monitor,
+                             gboolean      batching)
+{
+  g_return_if_fail (G_IS_FILE_MONITOR (monitor));
+
+  batching = !!batching;
+
+  if (monitor->priv->batching != batching)
+    {
+      monitor->priv->batching = batching;
+      g_object_notify (G_OBJECT (monitor), "batching");
+    }
+}
+
+/**
+ * g_file_monitor_get_batching:
+ * @monitor: a #GFileMonitor.
+ *
+ * Gets whether @monitor reports changes in batches, see
+ * g_file_monitor_set_batching().
+ *
+ * Returns: %TRUE if changes are reported with #GFileMonitor::changed-batch
+ *
+ * Since: 2.82
+ */
+gboolean
+g_file_monitor_get_batching (GFileMonitor *monitor)
+{
+  g_return_val_if_fail (G_IS_FILE_MONITOR (monitor), FALSE);
+
+  return monitor->priv->batching;
+}
+
 /**
  * g_file_monitor_emit_event:
  * @monitor: a #GFileMonitor.
@@ -296,5 +395,62 @@ g_file_monitor_emit_event (GFileMonitor      *monitor,
   if (monitor->priv->cancelled)
     return;
 
+  if (monitor->priv->batching)
+    {
+      GFileMonitorChange change = { child, other_file, event_type };
+      GArray *changes;
+
+      changes = g_array_sized_new (FALSE, FALSE, sizeof (GFileMonitorChange), 1);
+      g_array_append_val (changes, change);
+      g_signal_emit (monitor, g_file_monitor_changed_batch_signal, 0, changes);
+      g_array_unref (changes);
+
+      return;
+    }
+
   g_signal_emit (monitor, g_file_monitor_changed_signal, 0, child, other_file, event_type);
 }
+
+/**
+ * g_file_monitor_emit_changes:
+ * @monitor: a #GFileMonitor.
+ * @changes: (element-type GFileMonitorChange): the changes to report
+ *
+ * Emits #GFileMonitor::changed-batch for @changes if batching is
+ * enabled on @monitor, or #GFileMonitor::changed for each of them
+ * otherwise.  Should be called from file monitor implementations only,
+ * from the same context as g_file_monitor_emit_event().
+ *
+ * Since: 2.82
+ **/
+void
+g_file_monitor_emit_changes (GFileMonitor *monitor,
+                             GArray       *changes)
+{
+  guint i;
+
+  g_return_if_fail (G_IS_FILE_MONITOR (monitor));
+  g_return_if_fail (changes != NULL);
+
+  if (monitor->priv->cancelled || changes->len == 0)
+    return;
+
+  if (monitor->priv->batching)
+    {
+      g_signal_emit (monitor, g_file_monitor_changed_batch_signal, 0, changes);
+      return;
+    }
+
+  g_object_ref (monitor);
+
+  /* a handler may cancel the monitor */
+  for (i = 0; i < changes->len && !monitor->priv->cancelled; i++)
+    {
+      GFileMonitorChange *change = &g_array_index (changes, GFileMonitorChange, i);
+
+      g_signal_emit (monitor, g_file_monitor_changed_signal, 0,
+                     change->file, change->other_file, change->event_type);
+    }
+
+  g_object_unref (monitor);
+}
@@ -40,6 +40,26 @@ G_BEGIN_DECLS
 
 typedef struct _GFileMonitorClass       GFileMonitorClass;
 typedef struct _GFileMonitorPrivate	GFileMonitorPrivate;
+typedef struct _GFileMonitorChange      GFileMonitorChange;
+
+/**
+ * GFileMonitorChange:
+ * @file: the file that changed
+ * @other_file: (nullable): the other file of a move or rename, or %NULL
+ * @event_type: the type of change
+ *
+ * One of the changes reported by #GFileMonitor::changed-batch.  The
+ * fields have the same meaning as the arguments of
+ * #GFileMonitor::changed.
+ *
+ * Since: 2.82
+ */
+struct _GFileMonitorChange
+{
+  GFile             *file;
+  GFile             *other_file;
+  GFileMonitorEvent  event_type;
+};
 
 struct _GFileMonitor
 {
@@ -81,6 +101,11 @@ gboolean g_file_monitor_is_cancelled   (GFileMonitor      *monitor);
 GIO_AVAILABLE_IN_ALL
 void     g_file_monitor_set_rate_limit (GFileMonitor      *monitor,
                                         gint               limit_msecs);
+GIO_AVAILABLE_IN_2_82
+void     g_file_monitor_set_batching   (GFileMonitor      *monitor,
+                                        gboolean           batching);
+GIO_AVAILABLE_IN_2_82
+gboolean g_file_monitor_get_batching   (GFileMonitor      *monitor);
 
 
 /* For implementations */
@@ -89,6 +114,9 @@ void     g_file_monitor_emit_event     (GFileMonitor      *monitor,
                                         GFile             *child,
                                         GFile             *other_file,
                                         GFileMonitorEvent  event_type);
+GIO_AVAILABLE_IN_2_82
+void     g_file_monitor_emit_changes   (GFileMonitor      *monitor,
+                                        GArray            *changes);
 
 G_END_DECLS
 
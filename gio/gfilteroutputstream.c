@@ -58,6 +58,12 @@ static gssize   g_filter_output_stream_write        (GOutputStream *stream,
                                                      gsize          count,
                                                      GCancellable  *cancellable,
                                                      GError       **error);
+static gboolean g_filter_output_stream_writev       (GOutputStream        *stream,
+                                                     const GOutputVector  *vectors,
+                                                     gsize                 n_vectors,
+                                                     gsize                *bytes_written,
+                                                     GCancellable         *cancellable,
+                                                     GError              **error);
 static gboolean g_filter_output_stream_flush        (GOutputStream    *stream,
                                                      GCancellable  *cancellable,
                                                      GError          **error);
@@ -85,6 +91,7 @@ g_filter_output_stream_class_init (GFilterOutputStreamClass *klass)
     
   ostream_class = G_OUTPUT_STREAM_CLASS (klass);
   ostream_class->write_fn = g_filter_output_stream_write;
+  ostream_class->writev_fn = g_filter_output_stream_writev;
   ostream_class->flush = g_filter_output_stream_flush;
   ostream_class->close_fn = g_filter_output_stream_close;
 
@@ -277,6 +284,30 @@ g_filter_output_stream_write (GOutputStream  *stream,
   return nwritten;
 }
 
+static gboolean
+g_filter_output_stream_writev (GOutputStream        *stream,
+                               const GOutputVector  *vectors,
+                               gsize                 n_vectors,
+                               gsize                *bytes_written,
+                               GCancellable         *cancellable,
+                               GError              **error)
+{
+  GFilterOutputStream *filter_stream;
+
+  /* Subclasses which transform the data in write_fn, such as
+   * GConverterOutputStream, must see every write */
+  if (G_OUTPUT_STREAM_GET_CLASS (stream)->write_fn != g_filter_output_stream_write)
+    return G_OUTPUT_STREAM_CLASS (g_filter_output_stream_parent_class)->writev_fn (stream, vectors, n_vectors,
+                                                                                 bytes_written, cancellable, error);
+
+  filter_stream = G_FILTER_OUTPUT_STREAM (stream);
+
+  return g_output_stream_writev (filter_stream->base_stream,
+                                 vectors, n_vectors,
+                                 bytes_written,
+                                 cancellable, error);
+}
+
 static gboolean
 g_filter_output_stream_flush (GOutputStream  *stream,
                               GCancellable   *cancellable,
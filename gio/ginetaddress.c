@@ -894,3 +894,444 @@ g_inet_address_equal (GInetAddress *address,
 
   return TRUE;
 }
+
+/* GInetAddressBytes */
+
+/* These follow the rules of inet_pton() and inet_ntop() as implemented
+ * by glibc, so that they accept and produce the same strings as
+ * g_inet_address_new_from_string() and g_inet_address_to_string() on
+ * Linux, but they work on a length-delimited string and never allocate.
+ */
+static gboolean
+parse_ipv4 (const gchar *str,
+            const gchar *end,
+            guint8      *bytes)
+{
+  guint octets = 0, value = 0, n_digits = 0;
+
+  for (; str < end; str++)
+    {
+      guint digit = (guint) (*str - '0');
+
+      if (digit <= 9)
+        {
+          /* No leading zeros, as they'd mean octal to some parsers */
+          if (n_digits > 0 && value == 0)
+            return FALSE;
+          value = value * 10 + digit;
+          if (value > 255)
+            return FALSE;
+          n_digits++;
+        }
+      else if (*str == '.' && n_digits > 0 && octets < 3)
+        {
+          bytes[octets++] = value;
+          value = 0;
+          n_digits = 0;
+        }
+      else
+        return FALSE;
+    }
+
+  if (n_digits == 0 || octets != 3)
+    return FALSE;
+
+  bytes[3] = value;
+  return TRUE;
+}
+
+static gboolean
+parse_ipv6 (const gchar *str,
+            const gchar *end,
+            guint8      *bytes)
+{
+  guint8 tmp[16] = { 0, };
+  gsize pos = 0, gap = G_MAXSIZE;
+  const gchar *group = str;
+  guint value = 0, n_digits = 0;
+
+  if (str == end)
+    return FALSE;
+
+  /* A leading colon has to be part of "::" */
+  if (*str == ':')
+    {
+      str++;
+      if (str == end || *str != ':')
+        return FALSE;
+    }
+
+  while (str < end)
+    {
+      gchar c = *str++;
+      gint digit = g_ascii_xdigit_value (c);
+
+      if (digit >= 0)
+        {
+          if (n_digits == 4)
+            return FALSE;
+          value = (value << 4) | digit;
+          n_digits++;
+        }
+      else if (c == ':')
+        {
+          group = str;
+          if (n_digits == 0)
+            {
+              if (gap != G_MAXSIZE)
+                return FALSE;
+              gap = pos;
+              continue;
+            }
+          else if (str == end || pos + 2 > 16)
+            return FALSE;
+
+          tmp[pos++] = value >> 8;
+          tmp[pos++] = value & 0xff;
+          value = 0;
+          n_digits = 0;
+        }
+      else if (c == '.' && pos + 4 <= 16 && parse_ipv4 (group, end, tmp + pos))
+        {
+          pos += 4;
+          n_digits = 0;
+          break;
+        }
+      else
+        return FALSE;
+    }
+
+  if (n_digits > 0)
+    {
+      if (pos + 2 > 16)
+        return FALSE;
+      tmp[pos++] = value >> 8;
+      tmp[pos++] = value & 0xff;
+    }
+
+  if (gap != G_MAXSIZE)
+    {
+      gsize n_after = pos - gap;
+
+      if (pos == 16)
+        return FALSE;
+      memmove (tmp + 16 - n_after, tmp + gap, n_after);
+      memset (tmp + gap, 0, 16 - n_after - gap);
+      pos = 16;
+    }
+
+  if (pos != 16)
+    return FALSE;
+
+  memcpy (bytes, tmp, 16);
+  return TRUE;
+}
+
+static gsize
+format_ipv4 (const guint8 *bytes,
+             gchar        *buffer)
+{
+  gchar *p = buffer;
+  guint i;
+
+  for (i = 0; i < 4; i++)
+    {
+      guint8 octet = bytes[i];
+
+      if (i > 0)
+        *p++ = '.';
+      if (octet >= 100)
+        *p++ = '0' + octet / 100;
+      if (octet >= 10)
+        *p++ = '0' + (octet / 10) % 10;
+      *p++ = '0' + octet % 10;
+    }
+
+  *p = '\0';
+  return p - buffer;
+}
+
+static gsize
+format_ipv6 (const guint8 *bytes,
+             gchar        *buffer)
+{
+  static const gchar hex[] = "0123456789abcdef";
+  guint16 words[8];
+  gint best_base = -1, best_len = 0, cur_base = -1, cur_len = 0;
+  gchar *p = buffer;
+  gint i;
+
+  for (i = 0; i < 8; i++)
+    words[i] = (bytes[2 * i] << 8) | bytes[2 * i + 1];
+
+  /* Find the longest run of zero words to replace with "::" */
+  for (i = 0; i < 8; i++)
+    {
+      if (words[i] == 0)
+        {
+          if (cur_base == -1)
+            {
+              cur_base = i;
+              cur_len = 1;
+            }
+          else
+            cur_len++;
+        }
+      else if (cur_base != -1)
+        {
+          if (best_base == -1 || cur_len > best_len)
+            {
+              best_base = cur_base;
+              best_len = cur_len;
+            }
+          cur_base = -1;
+        }
+    }
+
+  if (cur_base != -1 && (best_base == -1 || cur_len > best_len))
+    {
+      best_base = cur_base;
+      best_len = cur_len;
+    }
+
+  if (best_base != -1 && best_len < 2)
+    best_base = -1;
+
+  for (i = 0; i < 8; i++)
+    {
+      guint16 word = words[i];
+      gboolean started = FALSE;
+      gint shift;
+
+      if (best_base != -1 && i >= best_base && i < best_base + best_len)
+        {
+          if (i == best_base)
+            *p++ = ':';
+          continue;
+        }
+
+      if (i != 0)
+        *p++ = ':';
+
+      /* IPv4-compatible and IPv4-mapped addresses */
+      if (i == 6 && best_base == 0 &&
+          (best_len == 6 || (best_len == 5 && words[5] == 0xffff)))
+        {
+          p += format_ipv4 (bytes + 12, p);
+          return p - buffer;
+        }
+
+      for (shift = 12; shift >= 0; shift -= 4)
+        {
+          guint nibble = (word >> shift) & 0xf;
+
+          if (nibble != 0 || started || shift == 0)
+            {
+              *p++ = hex[nibble];
+              started = TRUE;
+            }
+        }
+    }
+
+  if (best_base != -1 && best_base + best_len == 8)
+    *p++ = ':';
+
+  *p = '\0';
+  return p - buffer;
+}
+
+static GInetAddressBytes *
+g_inet_address_bytes_copy (const GInetAddressBytes *address)
+{
+  return g_memdup2 (address, sizeof (GInetAddressBytes));
+}
+
+G_DEFINE_BOXED_TYPE (GInetAddressBytes, g_inet_address_bytes,
+                     g_inet_address_bytes_copy, g_free)
+
+/**
+ * GInetAddressBytes:
+ * @family: the address family, %G_SOCKET_FAMILY_IPV4 or
+ *   %G_SOCKET_FAMILY_IPV6
+ * @bytes: the address in network byte order; only the first four
+ *   bytes are used for IPv4 addresses
+ *
+ * A plain value holding an IPv4 or IPv6 address.
+ *
+ * Unlike #GInetAddress, this is not an object: it can be kept on the
+ * stack or in arrays, and parsing and formatting it never allocates.
+ * This makes it suitable for handling large numbers of addresses, for
+ * example when analysing logs. Use g_inet_address_new_from_address_bytes()
+ * and g_inet_address_get_address_bytes() to convert between the two.
+ *
+ * Since: 2.82
+ */
+
+/**
+ * G_INET_ADDRESS_BYTES_STRING_SIZE:
+ *
+ * The size of a buffer large enough for any string produced by
+ * g_inet_address_bytes_to_string(), including the terminating nul.
+ *
+ * Since: 2.82
+ */
+
+/**
+ * g_inet_address_bytes_parse:
+ * @string: (array length=length) (element-type gchar): a string
+ *   representation of an IP address
+ * @length: the length of @string in bytes, or -1 if it is nul-terminated
+ * @address: (out caller-allocates): return location for the address
+ *
+ * Parses @string as an IPv4 or IPv6 address, without allocating.
+ *
+ * This accepts the same strings as g_inet_address_new_from_string()
+ * does on Linux: IPv4 addresses in dotted-quad notation without
+ * leading zeros, and IPv6 addresses in any of the textual forms of
+ * RFC 4291, including an embedded IPv4 address. Scope IDs are not
+ * accepted. Since @length may be given, @string does not need to be
+ * nul-terminated, so addresses can be parsed in place, for example
+ * from a line of a log file.
+ *
+ * Returns: %TRUE if @string was parsed successfully, %FALSE otherwise
+ *   (in which case @address is unchanged)
+ *
+ * Since: 2.82
+ */
+gboolean
+g_inet_address_bytes_parse (const gchar       *string,
+                            gssize             length,
+                            GInetAddressBytes *address)
+{
+  const gchar *end;
+  guint8 bytes[16];
+  gssize i;
+
+  g_return_val_if_fail (string != NULL || length == 0, FALSE);
+  g_return_val_if_fail (address != NULL, FALSE);
+
+  if (length < 0)
+    length = strlen (string);
+  end = string + length;
+
+  /* An IPv6 address always contains a colon within its first five
+   * characters, and an IPv4 address never does.
+   */
+  for (i = 0; i < length && i < 5; i++)
+    {
+      if (string[i] == ':')
+        {
+          if (!parse_ipv6 (string, end, bytes))
+            return FALSE;
+
+          address->family = G_SOCKET_FAMILY_IPV6;
+          memcpy (address->bytes, bytes, 16);
+          return TRUE;
+        }
+    }
+
+  if (!parse_ipv4 (string, end, bytes))
+    return FALSE;
+
+  address->family = G_SOCKET_FAMILY_IPV4;
+  memcpy (address->bytes, bytes, 4);
+  memset (address->bytes + 4, 0, sizeof (address->bytes) - 4);
+  return TRUE;
+}
+
+/**
+ * g_inet_address_bytes_to_string:
+ * @address: a #GInetAddressBytes
+ * @buffer: (out caller-allocates) (array fixed-size=46): return location
+ *   for the string, at least %G_INET_ADDRESS_BYTES_STRING_SIZE bytes
+ *
+ * Formats @address into @buffer, without allocating. The result is
+ * the same as that of g_inet_address_to_string() on Linux.
+ *
+ * Returns: the length of the string written to @buffer, not including
+ *   the terminating nul
+ *
+ * Since: 2.82
+ */
+gsize
+g_inet_address_bytes_to_string (const GInetAddressBytes *address,
+                                gchar                   *buffer)
+{
+  g_return_val_if_fail (address != NULL, 0);
+  g_return_val_if_fail (buffer != NULL, 0);
+  g_return_val_if_fail (G_INET_ADDRESS_FAMILY_IS_VALID (address->family), 0);
+
+  if (address->family == G_SOCKET_FAMILY_IPV4)
+    return format_ipv4 (address->bytes, buffer);
+  else
+    return format_ipv6 (address->bytes, buffer);
+}
+
+/**
+ * g_inet_address_bytes_equal:
+ * @address: a #GInetAddressBytes
+ * @other_address: another #GInetAddressBytes
+ *
+ * Checks if two addresses are equal.
+ *
+ * Returns: %TRUE if @address and @other_address are the same address
+ *
+ * Since: 2.82
+ */
+gboolean
+g_inet_address_bytes_equal (const GInetAddressBytes *address,
+                            const GInetAddressBytes *other_address)
+{
+  g_return_val_if_fail (address != NULL, FALSE);
+  g_return_val_if_fail (other_address != NULL, FALSE);
+
+  if (address->family != other_address->family)
+    return FALSE;
+
+  return memcmp (address->bytes, other_address->bytes,
+                 address->family == G_SOCKET_FAMILY_IPV4 ? 4 : 16) == 0;
+}
+
+/**
+ * g_inet_address_new_from_address_bytes:
+ * @address: a #GInetAddressBytes
+ *
+ * Creates a new #GInetAddress for @address.
+ *
+ * Returns: (transfer full): a new #GInetAddress. Free the returned
+ *   object with g_object_unref().
+ *
+ * Since: 2.82
+ */
+GInetAddress *
+g_inet_address_new_from_address_bytes (const GInetAddressBytes *address)
+{
+  g_return_val_if_fail (address != NULL, NULL);
+
+  return g_inet_address_new_from_bytes (address->bytes, address->family);
+}
+
+/**
+ * g_inet_address_get_address_bytes:
+ * @address: a #GInetAddress
+ * @bytes: (out caller-allocates): return location for the address
+ *
+ * Stores the family and raw address of @address in @bytes.
+ *
+ * Since: 2.82
+ */
+void
+g_inet_address_get_address_bytes (GInetAddress      *address,
+                                   GInetAddressBytes *bytes)
+{
+  gsize size;
+
+  g_return_if_fail (G_IS_INET_ADDRESS (address));
+  g_return_if_fail (bytes != NULL);
+
+  size = g_inet_address_get_native_size (address);
+
+  memset (bytes, 0, sizeof (*bytes));
+  bytes->family = g_inet_address_get_family (address);
+  memcpy (bytes->bytes, g_inet_address_to_bytes (address), size);
+}
@@ -120,6 +120,35 @@ gboolean              g_inet_address_get_is_mc_org_local  (GInetAddress
 GIO_AVAILABLE_IN_ALL
 gboolean              g_inet_address_get_is_mc_site_local (GInetAddress         *address);
 
+struct _GInetAddressBytes
+{
+  GSocketFamily family;
+  guint8        bytes[16];
+};
+
+#define G_INET_ADDRESS_BYTES_STRING_SIZE 46 GIO_AVAILABLE_MACRO_IN_2_82
+
+#define G_TYPE_INET_ADDRESS_BYTES (g_inet_address_bytes_get_type ())
+GIO_AVAILABLE_IN_2_82
+GType                 g_inet_address_bytes_get_type       (void) G_GNUC_CONST;
+
+GIO_AVAILABLE_IN_2_82
+gboolean              g_inet_address_bytes_parse          (const gchar             *string,
+                                                           gssize                   length,
+                                                           GInetAddressBytes       *address);
+GIO_AVAILABLE_IN_2_82
+gsize                 g_inet_address_bytes_to_string      (const GInetAddressBytes *address,
+                                                           gchar                   *buffer);
+GIO_AVAILABLE_IN_2_82
+gboolean              g_inet_address_bytes_equal          (const GInetAddressBytes *address,
+                                                           const GInetAddressBytes *other_address);
+
+GIO_AVAILABLE_IN_2_82
+GInetAddress *        g_inet_address_new_from_address_bytes (const GInetAddressBytes *address);
+GIO_AVAILABLE_IN_2_82
+void                  g_inet_address_get_address_bytes    (GInetAddress            *address,
+                                                           GInetAddressBytes       *bytes);
+
 G_END_DECLS
 
 #endif /* __G_INET_ADDRESS_H__ */
@@ -481,3 +481,328 @@ g_inet_address_mask_equal (GInetAddressMask  *mask,
   return ((mask->priv->length == mask2->priv->length) &&
 	  g_inet_address_equal (mask->priv->addr, mask2->priv->addr));
 }
+
+/**
+ * g_inet_address_mask_matches_bytes:
+ * @mask: a #GInetAddressMask
+ * @address: a #GInetAddressBytes
+ *
+ * Tests if @address falls within the range described by @mask, like
+ * g_inet_address_mask_matches(), without needing a #GInetAddress.
+ *
+ * Returns: whether @address falls within the range described by
+ * @mask.
+ *
+ * Since: 2.82
+ */
+gboolean
+g_inet_address_mask_matches_bytes (GInetAddressMask        *mask,
+                                   const GInetAddressBytes *address)
+{
+  const guint8 *maskbytes;
+  int nbytes, nbits;
+
+  g_return_val_if_fail (G_IS_INET_ADDRESS_MASK (mask), FALSE);
+  g_return_val_if_fail (address != NULL, FALSE);
+
+  if (g_inet_address_get_family (mask->priv->addr) != address->family)
+    return FALSE;
+
+  if (mask->priv->length == 0)
+    return TRUE;
+
+  maskbytes = g_inet_address_to_bytes (mask->priv->addr);
+
+  nbytes = mask->priv->length / 8;
+  if (nbytes != 0 && memcmp (maskbytes, address->bytes, nbytes) != 0)
+    return FALSE;
+
+  nbits = mask->priv->length % 8;
+  if (nbits == 0)
+    return TRUE;
+
+  return maskbytes[nbytes] == (address->bytes[nbytes] & (0xFF << (8 - nbits)));
+}
+
+/* GInetAddressMaskSet */
+
+/**
+ * GInetAddressMaskSet:
+ *
+ * `GInetAddressMaskSet` is a set of address ranges, like a list of
+ * [class@Gio.InetAddressMask]s, which can tell quickly whether an
+ * address falls within any of them.
+ *
+ * The ranges are kept in a binary trie per address family, so a lookup
+ * takes at most one step per bit of the address, however many ranges
+ * the set contains.
+ *
+ * A `GInetAddressMaskSet` may be looked up from several threads at once,
+ * but must not be modified while that happens.
+ *
+ * Since: 2.82
+ */
+
+typedef struct
+{
+  guint32 children[2];  /* indexes into nodes; 0 if there is no child */
+  gboolean terminal;    /* a range ends here, so everything below matches */
+} MaskSetNode;
+
+struct _GInetAddressMaskSet
+{
+  gatomicrefcount ref_count;
+  GArray *nodes;  /* (element-type MaskSetNode); 0 is the IPv4 root, 1 the IPv6 root */
+};
+
+G_DEFINE_BOXED_TYPE (GInetAddressMaskSet, g_inet_address_mask_set,
+                     g_inet_address_mask_set_ref, g_inet_address_mask_set_unref)
+
+/**
+ * g_inet_address_mask_set_new:
+ *
+ * Creates a new, empty #GInetAddressMaskSet.
+ *
+ * Returns: (transfer full): a new #GInetAddressMaskSet
+ *
+ * Since: 2.82
+ */
+GInetAddressMaskSet *
+g_inet_address_mask_set_new (void)
+{
+  GInetAddressMaskSet *set;
+  MaskSetNode roots[2] = { { { 0, 0 }, FALSE }, { { 0, 0 }, FALSE } };
+
+  set = g_new0 (GInetAddressMaskSet, 1);
+  g_atomic_ref_count_init (&set->ref_count);
+  set->nodes = g_array_new (FALSE, FALSE, sizeof (MaskSetNode));
+  g_array_append_vals (set->nodes, roots, G_N_ELEMENTS (roots));
+
+  return set;
+}
+
+/**
+ * g_inet_address_mask_set_ref:
+ * @set: a #GInetAddressMaskSet
+ *
+ * Increases the reference count of @set.
+ *
+ * Returns: (transfer full): @set
+ *
+ * Since: 2.82
+ */
+GInetAddressMaskSet *
+g_inet_address_mask_set_ref (GInetAddressMaskSet *set)
+{
+  g_return_val_if_fail (set != NULL, NULL);
+
+  g_atomic_ref_count_inc (&set->ref_count);
+
+  return set;
+}
+
+/**
+ * g_inet_address_mask_set_unref:
+ * @set: (transfer full): a #GInetAddressMaskSet
+ *
+ * Decreases the reference count of @set, freeing it when it drops to
+ * zero.
+ *
+ * Since: 2.82
+ */
+void
+g_inet_address_mask_set_unref (GInetAddressMaskSet *set)
+{
+  g_return_if_fail (set != NULL);
+
+  if (g_atomic_ref_count_dec (&set->ref_count))
+    {
+      g_array_unref (set->nodes);
+      g_free (set);
+    }
+}
+
+static void
+mask_set_insert (GInetAddressMaskSet *set,
+                 GSocketFamily        family,
+                 const guint8        *bytes,
+                 guint                length)
+{
+  guint32 index = family == G_SOCKET_FAMILY_IPV4 ? 0 : 1;
+  guint i;
+
+  for (i = 0; i < length; i++)
+    {
+      MaskSetNode *node = &g_array_index (set->nodes, MaskSetNode, index);
+      guint bit = (bytes[i / 8] >> (7 - i % 8)) & 1;
+
+      /* Already covered by a shorter range */
+      if (node->terminal)
+        return;
+
+      if (node->children[bit] == 0)
+        {
+          MaskSetNode child = { { 0, 0 }, FALSE };
+
+          node->children[bit] = set->nodes->len;
+          g_array_append_val (set->nodes, child);
+        }
+
+      /* The append may have moved the array, so look the node up again */
+      index = g_array_index (set->nodes, MaskSetNode, index).children[bit];
+    }
+
+  /* Everything below this node now matches, so drop it */
+  g_array_index (set->nodes, MaskSetNode, index).terminal = TRUE;
+  g_array_index (set->nodes, MaskSetNode, index).children[0] = 0;
+  g_array_index (set->nodes, MaskSetNode, index).children[1] = 0;
+}
+
+/**
+ * g_inet_address_mask_set_add:
+ * @set: a #GInetAddressMaskSet
+ * @mask: a #GInetAddressMask
+ *
+ * Adds the range described by @mask to @set.
+ *
+ * Since: 2.82
+ */
+void
+g_inet_address_mask_set_add (GInetAddressMaskSet *set,
+                             GInetAddressMask    *mask)
+{
+  g_return_if_fail (set != NULL);
+  g_return_if_fail (G_IS_INET_ADDRESS_MASK (mask));
+
+  mask_set_insert (set,
+                   g_inet_address_get_family (mask->priv->addr),
+                   g_inet_address_to_bytes (mask->priv->addr),
+                   mask->priv->length);
+}
+
+/**
+ * g_inet_address_mask_set_add_string:
+ * @set: a #GInetAddressMaskSet
+ * @mask_string: an IP address or address/length string
+ * @error: return location for #GError, or %NULL
+ *
+ * Parses @mask_string like g_inet_address_mask_new_from_string() does
+ * and adds the range it describes to @set, without creating a
+ * #GInetAddressMask.
+ *
+ * Returns: %TRUE on success, %FALSE if @mask_string is not a valid
+ *   mask
+ *
+ * Since: 2.82
+ */
+gboolean
+g_inet_address_mask_set_add_string (GInetAddressMaskSet  *set,
+                                    const gchar          *mask_string,
+                                    GError              **error)
+{
+  GInetAddressBytes address;
+  const gchar *slash;
+  guint addrlen, length, i;
+
+  g_return_val_if_fail (set != NULL, FALSE);
+  g_return_val_if_fail (mask_string != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  slash = strchr (mask_string, '/');
+  if (!g_inet_address_bytes_parse (mask_string, slash ? slash - mask_string : -1, &address))
+    goto parse_error;
+
+  addrlen = address.family == G_SOCKET_FAMILY_IPV4 ? 4 : 16;
+
+  if (slash)
+    {
+      gchar *end;
+
+      length = strtoul (slash + 1, &end, 10);
+      if (*end || !*(slash + 1))
+        goto parse_error;
+
+      if (length > addrlen * 8)
+        {
+          g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                       _("Length %u is too long for address"),
+                       length);
+          return FALSE;
+        }
+    }
+  else
+    length = addrlen * 8;
+
+  /* Make sure all the bits after @length are 0 */
+  for (i = length; i < addrlen * 8; i++)
+    {
+      if (address.bytes[i / 8] & (0x80 >> (i % 8)))
+        {
+          g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                               _("Address has bits set beyond prefix length"));
+          return FALSE;
+        }
+    }
+
+  mask_set_insert (set, address.family, address.bytes, length);
+
+  return TRUE;
+
+parse_error:
+  g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+               _("Could not parse “%s” as IP address mask"),
+               mask_string);
+  return FALSE;
+}
+
+/**
+ * g_inet_address_mask_set_contains:
+ * @set: a #GInetAddressMaskSet
+ * @address: a #GInetAddressBytes
+ *
+ * Tests if @address falls within any of the ranges in @set.
+ *
+ * Returns: %TRUE if @address is in @set
+ *
+ * Since: 2.82
+ */
+gboolean
+g_inet_address_mask_set_contains (GInetAddressMaskSet     *set,
+                                  const GInetAddressBytes *address)
+{
+  const MaskSetNode *nodes;
+  guint32 index;
+  guint i, n_bits;
+
+  g_return_val_if_fail (set != NULL, FALSE);
+  g_return_val_if_fail (address != NULL, FALSE);
+
+  if (address->family == G_SOCKET_FAMILY_IPV4)
+    {
+      index = 0;
+      n_bits = 32;
+    }
+  else if (address->family == G_SOCKET_FAMILY_IPV6)
+    {
+      index = 1;
+      n_bits = 128;
+    }
+  else
+    return FALSE;
+
+  nodes = (const MaskSetNode *) set->nodes->data;
+
+  for (i = 0; i < n_bits; i++)
+    {
+      guint bit = (address->bytes[i / 8] >> (7 - i % 8)) & 1;
+
+      if (nodes[index].terminal)
+        return TRUE;
+
+      index = nodes[index].children[bit];
+      if (index == 0)
+        return FALSE;
+    }
+
+  return nodes[index].terminal;
+}
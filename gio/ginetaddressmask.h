@@ -81,6 +81,32 @@ GIO_AVAILABLE_IN_2_32
 gboolean          g_inet_address_mask_equal           (GInetAddressMask  *mask,
 						       GInetAddressMask  *mask2);
 
+GIO_AVAILABLE_IN_2_82
+gboolean          g_inet_address_mask_matches_bytes   (GInetAddressMask        *mask,
+						       const GInetAddressBytes *address);
+
+#define G_TYPE_INET_ADDRESS_MASK_SET (g_inet_address_mask_set_get_type ())
+GIO_AVAILABLE_IN_2_82
+GType                g_inet_address_mask_set_get_type   (void) G_GNUC_CONST;
+
+GIO_AVAILABLE_IN_2_82
+GInetAddressMaskSet *g_inet_address_mask_set_new        (void);
+GIO_AVAILABLE_IN_2_82
+GInetAddressMaskSet *g_inet_address_mask_set_ref        (GInetAddressMaskSet      *set);
+GIO_AVAILABLE_IN_2_82
+void                 g_inet_address_mask_set_unref      (GInetAddressMaskSet      *set);
+
+GIO_AVAILABLE_IN_2_82
+void                 g_inet_address_mask_set_add        (GInetAddressMaskSet      *set,
+                                                         GInetAddressMask         *mask);
+GIO_AVAILABLE_IN_2_82
+gboolean             g_inet_address_mask_set_add_string (GInetAddressMaskSet      *set,
+                                                         const gchar              *mask_string,
+                                                         GError                  **error);
+GIO_AVAILABLE_IN_2_82
+gboolean             g_inet_address_mask_set_contains   (GInetAddressMaskSet      *set,
+                                                         const GInetAddressBytes  *address);
+
 G_END_DECLS
 
 #endif /* __G_INET_ADDRESS_MASK_H__ */
@@ -415,10 +415,25 @@ g_inet_socket_address_new_from_string (const char *address,
   struct addrinfo *res;
   gint status;
 
-  if (strchr (address, ':'))
+  if (strchr (address, ':') && !strchr (address, '%'))
     {
-      /* IPv6 address (or it's invalid). We use getaddrinfo() because
-       * it will handle parsing a scope_id as well.
+      GInetAddressBytes bytes;
+
+      /* IPv6 address without a scope_id (or it's invalid), which we can
+       * parse without going through getaddrinfo().
+       */
+      if (!g_inet_address_bytes_parse (address, -1, &bytes) ||
+          bytes.family != G_SOCKET_FAMILY_IPV6)
+        return NULL;
+
+      iaddr = g_inet_address_new_from_address_bytes (&bytes);
+      saddr = g_inet_socket_address_new (iaddr, port);
+      g_object_unref (iaddr);
+    }
+  else if (strchr (address, ':'))
+    {
+      /* IPv6 address with a scope_id (or it's invalid). We use
+       * getaddrinfo() because it will handle parsing the scope_id.
        */
 
       if (G_UNLIKELY (g_once_init_enter_pointer (&hints)))
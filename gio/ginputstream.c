@@ -26,11 +26,13 @@
 
 #include "ginputstream.h"
 #include "gioprivate.h"
+#include "gbufferedinputstream.h"
 #include "gseekable.h"
 #include "gcancellable.h"
 #include "gasyncresult.h"
 #include "gioerror.h"
 #include "gpollableinputstream.h"
+#include "gsocket.h"
 
 /**
  * GInputStream:
@@ -58,6 +60,9 @@ struct _GInputStreamPrivate {
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (GInputStream, g_input_stream, G_TYPE_OBJECT)
 
+/* See g_input_stream_set_splice_socket() */
+static GQuark splice_socket_quark;
+
 static gssize   g_input_stream_real_skip         (GInputStream         *stream,
 						  gsize                 count,
 						  GCancellable         *cancellable,
@@ -118,6 +123,8 @@ g_input_stream_class_init (GInputStreamClass *klass)
   klass->skip_finish = g_input_stream_real_skip_finish;
   klass->close_async = g_input_stream_real_close_async;
   klass->close_finish = g_input_stream_real_close_finish;
+
+  splice_socket_quark = g_quark_from_static_string ("gio-input-stream-splice-socket");
 }
 
 static void
@@ -321,6 +328,16 @@ g_input_stream_read_bytes (GInputStream  *stream,
   guchar *buf;
   gssize nread;
 
+  if (G_IS_BUFFERED_INPUT_STREAM (stream))
+    {
+      GBytes *bytes = NULL;
+
+      if (g_buffered_input_stream_read_bytes_internal (G_BUFFERED_INPUT_STREAM (stream),
+                                                       count, cancellable,
+                                                       &bytes, error))
+        return bytes;
+    }
+
   buf = g_malloc (count);
   nread = g_input_stream_read (stream, buf, count, cancellable, error);
   if (nread == -1)
@@ -337,6 +354,58 @@ g_input_stream_read_bytes (GInputStream  *stream,
     return g_bytes_new_take (buf, nread);
 }
 
+/**
+ * g_input_stream_read_bytes_pooled:
+ * @stream: a #GInputStream.
+ * @pool: the #GBufferPool to read into
+ * @cancellable: (nullable): optional #GCancellable object, %NULL to ignore.
+ * @error: location to store the error occurring, or %NULL to ignore
+ *
+ * Like g_input_stream_read_bytes(), this reads from the stream in a
+ * blocking fashion and returns the data as a #GBytes, but it reads up to
+ * g_buffer_pool_get_buffer_size() bytes into a buffer from @pool rather
+ * than into a newly allocated one. The returned #GBytes goes back to
+ * @pool when its last reference is dropped, so a reader which keeps a
+ * bounded number of them alive does not allocate once the pool is warm.
+ *
+ * A zero-length #GBytes is returned on end of file, but never otherwise.
+ *
+ * If @cancellable is not %NULL, then the operation can be cancelled by
+ * triggering the cancellable object from another thread. If the operation
+ * was cancelled, the error %G_IO_ERROR_CANCELLED will be returned. If an
+ * operation was partially finished when the operation was cancelled the
+ * partial result will be returned, without an error.
+ *
+ * On error %NULL is returned and @error is set accordingly.
+ *
+ * Returns: (transfer full): a new #GBytes, or %NULL on error
+ *
+ * Since: 2.82
+ **/
+GBytes *
+g_input_stream_read_bytes_pooled (GInputStream  *stream,
+                                  GBufferPool   *pool,
+                                  GCancellable  *cancellable,
+                                  GError       **error)
+{
+  gpointer buf;
+  gssize nread;
+
+  g_return_val_if_fail (G_IS_INPUT_STREAM (stream), NULL);
+  g_return_val_if_fail (pool != NULL, NULL);
+
+  buf = g_buffer_pool_acquire (pool);
+  nread = g_input_stream_read (stream, buf, g_buffer_pool_get_buffer_size (pool),
+                               cancellable, error);
+  if (nread == -1)
+    {
+      g_buffer_pool_release (pool, buf);
+      return NULL;
+    }
+
+  return g_buffer_pool_new_bytes (pool, buf, nread);
+}
+
 /**
  * g_input_stream_skip:
  * @stream: a #GInputStream.
@@ -1317,6 +1386,41 @@ g_input_stream_async_close_is_via_threads (GInputStream *stream)
   return class->close_async == g_input_stream_real_close_async;
 }
 
+/*< internal >
+ * g_input_stream_set_splice_socket:
+ * @stream: a #GInputStream
+ * @socket: the socket which data read from @stream comes from, unchanged
+ *
+ * Lets the default implementation of g_output_stream_splice() move data
+ * from @socket with `splice()`, instead of calling g_input_stream_read().
+ */
+void
+g_input_stream_set_splice_socket (GInputStream *stream,
+                                  GSocket      *socket)
+{
+  g_return_if_fail (G_IS_INPUT_STREAM (stream));
+  g_return_if_fail (G_IS_SOCKET (socket));
+
+  g_object_set_qdata_full (G_OBJECT (stream), splice_socket_quark,
+                           g_object_ref (socket), g_object_unref);
+}
+
+/*< internal >
+ * g_input_stream_get_splice_socket:
+ * @stream: a #GInputStream
+ *
+ * Gets the socket set with g_input_stream_set_splice_socket(), if any.
+ *
+ * Returns: (transfer none) (nullable): the splice socket of @stream
+ */
+GSocket *
+g_input_stream_get_splice_socket (GInputStream *stream)
+{
+  g_return_val_if_fail (G_IS_INPUT_STREAM (stream), NULL);
+
+  return g_object_get_qdata (G_OBJECT (stream), splice_socket_quark);
+}
+
 /********************************************
  *   Default implementation of async ops    *
  ********************************************/
@@ -127,6 +127,11 @@ GBytes  *g_input_stream_read_bytes    (GInputStream          *stream,
 				       gsize                  count,
 				       GCancellable          *cancellable,
 				       GError               **error);
+GIO_AVAILABLE_IN_2_82
+GBytes  *g_input_stream_read_bytes_pooled (GInputStream      *stream,
+                                           GBufferPool       *pool,
+                                           GCancellable      *cancellable,
+                                           GError           **error);
 GIO_AVAILABLE_IN_ALL
 gssize   g_input_stream_skip          (GInputStream          *stream,
 				       gsize                  count,
@@ -129,6 +129,7 @@ G_DEFINE_AUTOPTR_CLEANUP_FUNC(GSocketAddress, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GSocketClient, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GSocketConnectable, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GSocketConnection, g_object_unref)
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(GSocketConnectionPool, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GSocketControlMessage, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GSocket, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GSocketListener, g_object_unref)
@@ -150,10 +151,13 @@ G_DEFINE_AUTOPTR_CLEANUP_FUNC(GTlsFileDatabase, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GTlsInteraction, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GTlsPassword, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GTlsServerConnection, g_object_unref)
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(GUdpSegmentMessage, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GVfs, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GVolume, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GVolumeMonitor, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GZlibCompressor, g_object_unref)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GZlibDecompressor, g_object_unref)
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(GZstdCompressor, g_object_unref)
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(GZstdDecompressor, g_object_unref)
 
 #endif /* __GI_SCANNER__ */
@@ -148,6 +148,7 @@
 #include <gio/gsocketclient.h>
 #include <gio/gsocketconnectable.h>
 #include <gio/gsocketconnection.h>
+#include <gio/gsocketconnectionpool.h>
 #include <gio/gsocketcontrolmessage.h>
 #include <gio/gsocketlistener.h>
 #include <gio/gsocketservice.h>
@@ -169,6 +170,7 @@
 #include <gio/gtlsinteraction.h>
 #include <gio/gtlspassword.h>
 #include <gio/gtlsserverconnection.h>
+#include <gio/gudpsegmentmessage.h>
 #include <gio/gunixconnection.h>
 #include <gio/gunixcredentialsmessage.h>
 #include <gio/gunixfdlist.h>
@@ -178,6 +180,8 @@
 #include <gio/gvolumemonitor.h>
 #include <gio/gzlibcompressor.h>
 #include <gio/gzlibdecompressor.h>
+#include <gio/gzstdcompressor.h>
+#include <gio/gzstddecompressor.h>
 
 #include <gio/gio-autocleanups.h>
 
@@ -181,12 +181,19 @@ typedef enum {
  * GFileQueryInfoFlags:
  * @G_FILE_QUERY_INFO_NONE: No flags set.
  * @G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS: Don't follow symlinks.
+ * @G_FILE_QUERY_INFO_LAZY: Compute expensive attributes, such as a content
+ *   type that needs the file to be sniffed, icons and thumbnail information,
+ *   the first time they are read from the returned #GFileInfo instead of up
+ *   front. They are then computed in whichever thread reads them, and reflect
+ *   the file at that time. Backends which don't support this ignore it.
+ *   Since 2.82
  *
  * Flags used when querying a #GFileInfo.
  */
 typedef enum {
   G_FILE_QUERY_INFO_NONE              = 0,
-  G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS = (1 << 0)   /*< nick=nofollow-symlinks >*/
+  G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS = (1 << 0),  /*< nick=nofollow-symlinks >*/
+  G_FILE_QUERY_INFO_LAZY GIO_AVAILABLE_ENUMERATOR_IN_2_82 = (1 << 1)
 } GFileQueryInfoFlags;
 
 
@@ -229,6 +236,11 @@ typedef enum {
  *   sizes of other file types are not specified in a standard way.
  * @G_FILE_MEASURE_NO_XDEV: Do not cross mount point boundaries.
  *   Compare with `du -x`.
+ * @G_FILE_MEASURE_DEDUPLICATE_HARDLINKS: Count files with several hard
+ *   links only once, like `du` does unless `-l` is given. Since 2.82
+ * @G_FILE_MEASURE_PARALLEL: Measure subdirectories on several threads.
+ *   The progress callback is still only called from the thread doing the
+ *   measurement. Since 2.82
  *
  * Flags that can be used with g_file_measure_disk_usage().
  *
@@ -238,7 +250,9 @@ typedef enum {
   G_FILE_MEASURE_NONE                 = 0,
   G_FILE_MEASURE_REPORT_ANY_ERROR     = (1 << 1),
   G_FILE_MEASURE_APPARENT_SIZE        = (1 << 2),
-  G_FILE_MEASURE_NO_XDEV              = (1 << 3)
+  G_FILE_MEASURE_NO_XDEV              = (1 << 3),
+  G_FILE_MEASURE_DEDUPLICATE_HARDLINKS GIO_AVAILABLE_ENUMERATOR_IN_2_82 = (1 << 4),
+  G_FILE_MEASURE_PARALLEL GIO_AVAILABLE_ENUMERATOR_IN_2_82 = (1 << 5)
 } GFileMeasureFlags;
 
 /**
@@ -316,6 +330,13 @@ typedef enum {
  * @G_FILE_COPY_TARGET_DEFAULT_PERMS: Leaves target file with default perms, instead of setting the source file perms.
  * @G_FILE_COPY_TARGET_DEFAULT_MODIFIED_TIME: Use default modification
  *     timestamps instead of copying them from the source file. Since 2.80
+ * @G_FILE_COPY_NO_REFLINK: Don't try to share the data of the source file
+ *     with the copy (a reflink or clone) on file systems which support it,
+ *     always copy it instead. Since 2.82
+ * @G_FILE_COPY_REFLINK_ONLY: Only copy the file if its data can be shared
+ *     with the copy (a reflink or clone), which takes the same time whatever
+ *     the size of the file. Otherwise fail with %G_IO_ERROR_NOT_SUPPORTED,
+ *     leaving an existing destination untouched. Since 2.82
  *
  * Flags used when copying or moving files.
  */
@@ -328,6 +349,8 @@ typedef enum {
   G_FILE_COPY_NO_FALLBACK_FOR_MOVE = (1 << 4),
   G_FILE_COPY_TARGET_DEFAULT_PERMS = (1 << 5),
   G_FILE_COPY_TARGET_DEFAULT_MODIFIED_TIME GIO_AVAILABLE_ENUMERATOR_IN_2_80 = (1 << 6),
+  G_FILE_COPY_NO_REFLINK GIO_AVAILABLE_ENUMERATOR_IN_2_82 = (1 << 7),
+  G_FILE_COPY_REFLINK_ONLY GIO_AVAILABLE_ENUMERATOR_IN_2_82 = (1 << 8),
 } GFileCopyFlags;
 
 
@@ -347,6 +370,12 @@ typedef enum {
  *   monitored directory.  This causes %G_FILE_MONITOR_EVENT_RENAMED,
  *   %G_FILE_MONITOR_EVENT_MOVED_IN and %G_FILE_MONITOR_EVENT_MOVED_OUT
  *   events to be emitted when possible.  Since: 2.46.
+ * @G_FILE_MONITOR_WATCH_RECURSIVE: Watch for changes anywhere below a
+ *   monitored directory, not only to its direct children. The file
+ *   passed to #GFileMonitor::changed may then be a descendant of the
+ *   directory. Only supported by some backends, such as fanotify on
+ *   Linux, and monitoring fails with %G_IO_ERROR_NOT_SUPPORTED
+ *   otherwise. Since: 2.82.
  *
  * Flags used to set what a #GFileMonitor will watch for.
  */
@@ -355,7 +384,8 @@ typedef enum {
   G_FILE_MONITOR_WATCH_MOUNTS     = (1 << 0),
   G_FILE_MONITOR_SEND_MOVED       = (1 << 1),
   G_FILE_MONITOR_WATCH_HARD_LINKS = (1 << 2),
-  G_FILE_MONITOR_WATCH_MOVES      = (1 << 3)
+  G_FILE_MONITOR_WATCH_MOVES      = (1 << 3),
+  G_FILE_MONITOR_WATCH_RECURSIVE GIO_AVAILABLE_ENUMERATOR_IN_2_82 = (1 << 4)
 } GFileMonitorFlags;
 
 
@@ -796,6 +826,8 @@ typedef enum {
  * GResourceFlags:
  * @G_RESOURCE_FLAGS_NONE: No flags set.
  * @G_RESOURCE_FLAGS_COMPRESSED: The file is compressed.
+ * @G_RESOURCE_FLAGS_COMPRESSED_ZSTD: The file is compressed with Zstandard.
+ *   Since: 2.82
  *
  * GResourceFlags give information about a particular file inside a resource
  * bundle.
@@ -804,7 +836,8 @@ typedef enum {
  **/
 typedef enum {
   G_RESOURCE_FLAGS_NONE       = 0,
-  G_RESOURCE_FLAGS_COMPRESSED = (1<<0)
+  G_RESOURCE_FLAGS_COMPRESSED = (1<<0),
+  G_RESOURCE_FLAGS_COMPRESSED_ZSTD GIO_AVAILABLE_ENUMERATOR_IN_2_82 = (1<<1)
 } GResourceFlags;
 
 /**
@@ -1037,6 +1070,10 @@ typedef enum
  * @G_DBUS_PROXY_FLAGS_NO_MATCH_RULE: Don't actually send the AddMatch D-Bus
  *    call for this signal subscription. This gives you more control
  *    over which match rules you add (but you must add them manually). (Since: 2.72)
+ * @G_DBUS_PROXY_FLAGS_LAZY_PROPERTIES: Keep the reply to the initial
+ *    `GetAll()` call as is and only look properties up in it when they are
+ *    requested, instead of decoding all of them into the cache up front. The
+ *    cache is only fully decoded once a property changes. (Since: 2.82)
  *
  * Flags used when constructing an instance of a #GDBusProxy derived class.
  *
@@ -1050,7 +1087,8 @@ typedef enum
   G_DBUS_PROXY_FLAGS_DO_NOT_AUTO_START = (1<<2),
   G_DBUS_PROXY_FLAGS_GET_INVALIDATED_PROPERTIES = (1<<3),
   G_DBUS_PROXY_FLAGS_DO_NOT_AUTO_START_AT_CONSTRUCTION = (1<<4),
-  G_DBUS_PROXY_FLAGS_NO_MATCH_RULE GIO_AVAILABLE_ENUMERATOR_IN_2_72 = (1<<5)
+  G_DBUS_PROXY_FLAGS_NO_MATCH_RULE GIO_AVAILABLE_ENUMERATOR_IN_2_72 = (1<<5),
+  G_DBUS_PROXY_FLAGS_LAZY_PROPERTIES GIO_AVAILABLE_ENUMERATOR_IN_2_82 = (1<<6)
 } GDBusProxyFlags;
 
 /**
@@ -1231,6 +1269,12 @@ typedef enum
  *  affects client-side `EXTERNAL` authentication, for which this flag makes
  *  connections to a server in another user namespace succeed, but causes
  *  a deadlock when connecting to a GDBus server older than 2.73.3. Since: 2.74
+ * @G_DBUS_CONNECTION_FLAGS_WORKER_POOL: Do message I/O and (de)serialization
+ *  for the connection in one of a pool of worker threads instead of the
+ *  thread shared by all other connections, so that processes with many busy
+ *  connections can use several cores. Connections are spread over up to one
+ *  thread per processor, or as many as the `GDBUS_WORKER_THREADS`
+ *  environment variable says. Since: 2.82
  *
  * Flags used when creating a new #GDBusConnection.
  *
@@ -1244,7 +1288,8 @@ typedef enum {
   G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION = (1<<3),
   G_DBUS_CONNECTION_FLAGS_DELAY_MESSAGE_PROCESSING = (1<<4),
   G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_REQUIRE_SAME_USER GIO_AVAILABLE_ENUMERATOR_IN_2_68 = (1<<5),
-  G_DBUS_CONNECTION_FLAGS_CROSS_NAMESPACE GIO_AVAILABLE_ENUMERATOR_IN_2_74 = (1<<6)
+  G_DBUS_CONNECTION_FLAGS_CROSS_NAMESPACE GIO_AVAILABLE_ENUMERATOR_IN_2_74 = (1<<6),
+  G_DBUS_CONNECTION_FLAGS_WORKER_POOL GIO_AVAILABLE_ENUMERATOR_IN_2_82 = (1<<7)
 } GDBusConnectionFlags;
 
 /**
@@ -1397,6 +1442,8 @@ typedef enum
  * authentication method.
  * @G_DBUS_SERVER_FLAGS_AUTHENTICATION_REQUIRE_SAME_USER: Require the UID of the
  * peer to be the same as the UID of the server when authenticating. (Since: 2.68)
+ * @G_DBUS_SERVER_FLAGS_WORKER_POOL: Create the connections with
+ * %G_DBUS_CONNECTION_FLAGS_WORKER_POOL. (Since: 2.82)
  *
  * Flags used when creating a #GDBusServer.
  *
@@ -1407,7 +1454,8 @@ typedef enum
   G_DBUS_SERVER_FLAGS_NONE = 0,
   G_DBUS_SERVER_FLAGS_RUN_IN_THREAD = (1<<0),
   G_DBUS_SERVER_FLAGS_AUTHENTICATION_ALLOW_ANONYMOUS = (1<<1),
-  G_DBUS_SERVER_FLAGS_AUTHENTICATION_REQUIRE_SAME_USER GIO_AVAILABLE_ENUMERATOR_IN_2_68 = (1<<2)
+  G_DBUS_SERVER_FLAGS_AUTHENTICATION_REQUIRE_SAME_USER GIO_AVAILABLE_ENUMERATOR_IN_2_68 = (1<<2),
+  G_DBUS_SERVER_FLAGS_WORKER_POOL GIO_AVAILABLE_ENUMERATOR_IN_2_82 = (1<<3)
 } GDBusServerFlags;
 
 /**
@@ -1535,6 +1583,15 @@ typedef enum
  * @G_APPLICATION_REPLACE: Take over from another instance. This flag is
  *     usually set by passing `--gapplication-replace` on the commandline.
  *     Since: 2.60
+ * @G_APPLICATION_DEFER_DBUS_REGISTRATION: Connect to the session bus
+ *     and export the application's D-Bus objects in the background
+ *     instead of during g_application_register(), so that startup does
+ *     not wait for the bus.  Until the connection is up,
+ *     g_application_get_dbus_connection() returns %NULL and
+ *     #GApplicationClass.dbus_register has not been called.  Only has an
+ *     effect together with %G_APPLICATION_NON_UNIQUE, since a unique
+ *     application has to own its name before it can start up.
+ *     Since: 2.82
  *
  * Flags used to define the behaviour of a #GApplication.
  *
@@ -1555,7 +1612,8 @@ typedef enum /*< prefix=G_APPLICATION >*/
 
   G_APPLICATION_CAN_OVERRIDE_APP_ID =  (1 << 6),
   G_APPLICATION_ALLOW_REPLACEMENT   =  (1 << 7),
-  G_APPLICATION_REPLACE             =  (1 << 8)
+  G_APPLICATION_REPLACE             =  (1 << 8),
+  G_APPLICATION_DEFER_DBUS_REGISTRATION GIO_AVAILABLE_ENUMERATOR_IN_2_82 = (1 << 9)
 } GApplicationFlags;
 
 /**
@@ -1797,6 +1855,10 @@ typedef enum {
  *   a thread dedicated to the invocation. This means that the method implementation can use blocking IO
  *   without blocking any other part of the process. It also means that the method implementation must
  *   use locking to access data structures used by other threads.
+ * @G_DBUS_INTERFACE_SKELETON_FLAGS_SERIALIZE_PER_SENDER: Method invocations
+ *   handled in threads are handled one after the other for each sender, in
+ *   the order they arrived, while invocations from different senders are
+ *   still handled concurrently. Since: 2.82
  *
  * Flags describing the behavior of a #GDBusInterfaceSkeleton instance.
  *
@@ -1805,7 +1867,8 @@ typedef enum {
 typedef enum
 {
   G_DBUS_INTERFACE_SKELETON_FLAGS_NONE = 0,
-  G_DBUS_INTERFACE_SKELETON_FLAGS_HANDLE_METHOD_INVOCATIONS_IN_THREAD = (1<<0)
+  G_DBUS_INTERFACE_SKELETON_FLAGS_HANDLE_METHOD_INVOCATIONS_IN_THREAD = (1<<0),
+  G_DBUS_INTERFACE_SKELETON_FLAGS_SERIALIZE_PER_SENDER GIO_AVAILABLE_ENUMERATOR_IN_2_82 = (1<<1)
 } GDBusInterfaceSkeletonFlags;
 
 /**
@@ -1815,6 +1878,11 @@ typedef enum
  *   manager is for a well-known name, then request the bus to launch
  *   an owner for the name if no-one owns the name. This flag can only
  *   be used in managers for well-known names.
+ * @G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_LAZY_PROXIES: Keep the reply to
+ *   `GetManagedObjects()` and only create the object and interface proxies
+ *   for an object when it is first accessed. No
+ *   #GDBusObjectManager::object-added signals are emitted for such objects.
+ *   Since: 2.82
  *
  * Flags used when constructing a #GDBusObjectManagerClient.
  *
@@ -1823,7 +1891,8 @@ typedef enum
 typedef enum
 {
   G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_NONE = 0,
-  G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_DO_NOT_AUTO_START = (1<<0)
+  G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_DO_NOT_AUTO_START = (1<<0),
+  G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_LAZY_PROXIES GIO_AVAILABLE_ENUMERATOR_IN_2_82 = (1<<1)
 } GDBusObjectManagerClientFlags;
 
 /**
@@ -1903,6 +1972,27 @@ typedef enum {
   G_TLS_PROTOCOL_VERSION_DTLS_1_2 = 202,
 } GTlsProtocolVersion;
 
+/**
+ * GTlsKernelOffloadFlags:
+ * @G_TLS_KERNEL_OFFLOAD_NONE: No direction is handled by the kernel
+ * @G_TLS_KERNEL_OFFLOAD_SEND: Records sent on the connection are encrypted
+ *   by the kernel
+ * @G_TLS_KERNEL_OFFLOAD_RECEIVE: Records received on the connection are
+ *   decrypted by the kernel
+ *
+ * The directions of a #GTlsConnection for which record encryption has been
+ * handed to the operating system kernel. See
+ * g_tls_connection_get_kernel_offload().
+ *
+ * Since: 2.82
+ */
+GIO_AVAILABLE_TYPE_IN_2_82
+typedef enum {
+  G_TLS_KERNEL_OFFLOAD_NONE = 0,
+  G_TLS_KERNEL_OFFLOAD_SEND = (1 << 0),
+  G_TLS_KERNEL_OFFLOAD_RECEIVE = (1 << 1),
+} GTlsKernelOffloadFlags;
+
 /**
  * GIOModuleScopeFlags:
  * @G_IO_MODULE_SCOPE_NONE: No module scan flags
@@ -33,6 +33,7 @@
 #include "giomodule.h"
 #include "giomodule-priv.h"
 #include "glib-private.h"
+#include "gtrace-private.h"
 #include "glocalfilemonitor.h"
 #include "gnativevolumemonitor.h"
 #include "gproxyresolver.h"
@@ -342,6 +343,7 @@ g_io_module_load_module (GTypeModule *gmodule)
 {
   GIOModule *module = G_IO_MODULE (gmodule);
   GError *error = NULL;
+  gint64 begin_time_nsec G_GNUC_UNUSED;
 
   if (!module->filename)
     {
@@ -349,6 +351,8 @@ g_io_module_load_module (GTypeModule *gmodule)
       return FALSE;
     }
 
+  begin_time_nsec = G_TRACE_CURRENT_TIME;
+
   module->library = g_module_open_full (module->filename, G_MODULE_BIND_LAZY | G_MODULE_BIND_LOCAL, &error);
 
   if (!module->library)
@@ -371,6 +375,10 @@ g_io_module_load_module (GTypeModule *gmodule)
   module->load (module);
   module->initialized = TRUE;
 
+  g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                "GIO", "load module",
+                "%s", module->filename);
+
   return TRUE;
 }
 
@@ -713,6 +721,26 @@ g_io_modules_load_all_in_directory (const char *dirname)
   return g_io_modules_load_all_in_directory_with_scope (dirname, NULL);
 }
 
+/* Looks up the extension named by an environment variable. Extensions which
+ * are already registered, such as the built-in ones, are checked first, so
+ * that choosing one of them doesn’t load every module for @ep. */
+static GIOExtension *
+get_preferred_extension (GIOExtensionPoint *ep,
+                         const char        *name)
+{
+  GList *l;
+
+  for (l = ep->extensions; l != NULL; l = l->next)
+    {
+      GIOExtension *e = l->data;
+
+      if (e->name != NULL && strcmp (e->name, name) == 0)
+        return e;
+    }
+
+  return g_io_extension_point_get_extension_by_name (ep, name);
+}
+
 static gpointer
 try_class (GIOExtension *extension,
            guint         is_supported_offset)
@@ -837,7 +865,7 @@ _g_io_module_get_default_type (const gchar *extension_point,
 
   if (use_this)
     {
-      preferred = g_io_extension_point_get_extension_by_name (ep, use_this);
+      preferred = get_preferred_extension (ep, use_this);
       if (preferred)
         {
           impl = try_class (preferred, is_supported_offset);
@@ -954,6 +982,7 @@ _g_io_module_get_default (const gchar         *extension_point,
   GIOExtension *extension = NULL, *preferred;
   gpointer impl, value;
   GWeakRef *impl_weak_ref = NULL;
+  gint64 begin_time_nsec G_GNUC_UNUSED;
 
   g_rec_mutex_lock (&default_modules_lock);
   if (default_modules)
@@ -981,6 +1010,8 @@ _g_io_module_get_default (const gchar         *extension_point,
                                                g_free, (GDestroyNotify) weak_ref_free);
     }
 
+  begin_time_nsec = G_TRACE_CURRENT_TIME;
+
   _g_io_modules_ensure_loaded ();
   ep = g_io_extension_point_lookup (extension_point);
 
@@ -1005,7 +1036,7 @@ _g_io_module_get_default (const gchar         *extension_point,
 
   if (use_this)
     {
-      preferred = g_io_extension_point_get_extension_by_name (ep, use_this);
+      preferred = get_preferred_extension (ep, use_this);
       if (preferred)
 	{
 	  impl = try_implementation (extension_point, preferred, verify_func);
@@ -1047,6 +1078,11 @@ _g_io_module_get_default (const gchar         *extension_point,
 
   g_rec_mutex_unlock (&default_modules_lock);
 
+  g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                "GIO", "default implementation",
+                "%s: %s", extension_point,
+                impl != NULL ? G_OBJECT_TYPE_NAME (impl) : "none");
+
   if (impl != NULL)
     {
       g_assert (extension != NULL);
@@ -1061,6 +1097,7 @@ _g_io_module_get_default (const gchar         *extension_point,
   return g_steal_pointer (&impl);
 }
 
+extern GType g_fanotify_file_monitor_get_type (void);
 extern GType g_inotify_file_monitor_get_type (void);
 extern GType g_kqueue_file_monitor_get_type (void);
 extern GType g_win32_file_monitor_get_type (void);
@@ -1193,6 +1230,9 @@ _g_io_modules_ensure_extension_points_registered (void)
       ep = g_io_extension_point_register (G_NFS_FILE_MONITOR_EXTENSION_POINT_NAME);
       g_io_extension_point_set_required_type (ep, G_TYPE_LOCAL_FILE_MONITOR);
 
+      ep = g_io_extension_point_register (G_RECURSIVE_FILE_MONITOR_EXTENSION_POINT_NAME);
+      g_io_extension_point_set_required_type (ep, G_TYPE_LOCAL_FILE_MONITOR);
+
       ep = g_io_extension_point_register (G_VOLUME_MONITOR_EXTENSION_POINT_NAME);
       g_io_extension_point_set_required_type (ep, G_TYPE_VOLUME_MONITOR);
       
@@ -1339,6 +1379,9 @@ _g_io_modules_ensure_loaded (void)
 #if defined(HAVE_INOTIFY_INIT1)
       g_type_ensure (g_inotify_file_monitor_get_type ());
 #endif
+#if defined(HAVE_FANOTIFY_DFID_NAME)
+      g_type_ensure (g_fanotify_file_monitor_get_type ());
+#endif
 #if defined(HAVE_KQUEUE)
       g_type_ensure (g_kqueue_file_monitor_get_type ());
 #endif
@@ -25,6 +25,7 @@
 #include "goutputstream.h"
 #include "gsocketconnection.h"
 #include "gsocketaddress.h"
+#include "gsocketlistener.h"
 
 G_BEGIN_DECLS
 
@@ -34,9 +35,60 @@ gboolean g_output_stream_async_write_is_via_threads (GOutputStream *stream);
 gboolean g_output_stream_async_writev_is_via_threads (GOutputStream *stream);
 gboolean g_output_stream_async_close_is_via_threads (GOutputStream *stream);
 
+void g_input_stream_set_splice_socket (GInputStream *stream,
+                                       GSocket      *socket);
+GSocket *g_input_stream_get_splice_socket (GInputStream *stream);
+gboolean g_output_stream_splice_counted_async (GOutputStream       *stream,
+                                               GInputStream        *source,
+                                               gsize                buffer_size,
+                                               guint64             *n_spliced,
+                                               int                  io_priority,
+                                               GCancellable        *cancellable,
+                                               GAsyncReadyCallback  callback,
+                                               gpointer             user_data);
+const void *g_memory_input_stream_peek (GMemoryInputStream *stream,
+                                        gsize              *size);
+gboolean g_buffered_input_stream_read_bytes_internal (GBufferedInputStream  *stream,
+                                                      gsize                  count,
+                                                      GCancellable          *cancellable,
+                                                      GBytes               **bytes,
+                                                      GError               **error);
+void g_output_stream_set_splice_socket (GOutputStream *stream,
+                                        GSocket       *socket);
+
+GSocketConnection *g_socket_connection_pool_take (GSocketConnectionPool *pool,
+                                                  const char            *key);
+void g_socket_connection_pool_track (GSocketConnectionPool *pool,
+                                     const char            *key,
+                                     GSocketConnection     *connection);
+void g_socket_connection_pool_resume_tls_session (GSocketConnectionPool *pool,
+                                                  const char            *key,
+                                                  GTlsClientConnection  *connection);
+
 void g_socket_connection_set_cached_remote_address (GSocketConnection *connection,
                                                     GSocketAddress    *address);
 
+gboolean g_socket_set_reuse_port (GSocket  *socket,
+                                  gboolean  reuse_port);
+
+gboolean g_socket_can_use_io_uring (GSocket *socket);
+void g_socket_receive_io_uring (GSocket *socket,
+                                void    *buffer,
+                                gsize    size,
+                                GTask   *task);
+void g_socket_send_io_uring (GSocket    *socket,
+                             const void *buffer,
+                             gsize       size,
+                             GTask      *task);
+
+typedef void (*GSocketListenerShardFunc) (GSocketListener *listener,
+                                          GSocket         *socket,
+                                          GObject         *source_object);
+
+void g_socket_listener_set_accept_shards_separately (GSocketListener *listener);
+GList *g_socket_listener_add_shard_sources (GSocketListener          *listener,
+                                            GSocketListenerShardFunc  func);
+
 /* POSIX defines IOV_MAX/UIO_MAXIOV as the maximum number of iovecs that can
  * be sent in one go. We define our own version of it here as there are two
  * possible names, and also define a fall-back value if none of the constants
@@ -698,6 +698,10 @@ typedef struct
   GCancellable *op2_cancellable;
   guint completed;
   GError *error;
+  guint64 n_spliced1;  /* from stream1 to stream2 */
+  guint64 n_spliced2;  /* from stream2 to stream1 */
+  gboolean counted1;
+  gboolean counted2;
 } SpliceContext;
 
 static void
@@ -764,8 +768,18 @@ splice_cb (GObject      *ostream,
   GTask *task = user_data;
   SpliceContext *ctx = g_task_get_task_data (task);
   GError *error = NULL;
+  gssize n_spliced;
 
-  g_output_stream_splice_finish (G_OUTPUT_STREAM (ostream), res, &error);
+  n_spliced = g_output_stream_splice_finish (G_OUTPUT_STREAM (ostream), res, &error);
+
+  /* Streams which override splicing only report the count on success */
+  if (n_spliced >= 0)
+    {
+      if (ostream == G_OBJECT (g_io_stream_get_output_stream (ctx->stream2)) && !ctx->counted1)
+        ctx->n_spliced1 = n_spliced;
+      else if (ostream == G_OBJECT (g_io_stream_get_output_stream (ctx->stream1)) && !ctx->counted2)
+        ctx->n_spliced2 = n_spliced;
+    }
 
   ctx->completed++;
 
@@ -867,6 +881,52 @@ g_io_stream_splice_async (GIOStream            *stream1,
                           GCancellable         *cancellable,
                           GAsyncReadyCallback   callback,
                           gpointer              user_data)
+{
+  g_io_stream_splice_full_async (stream1, stream2, flags, 0, io_priority,
+                                 cancellable, callback, user_data);
+}
+
+/**
+ * g_io_stream_splice_full_async:
+ * @stream1: a #GIOStream.
+ * @stream2: a #GIOStream.
+ * @flags: a set of #GIOStreamSpliceFlags.
+ * @buffer_size: the size of the buffer used for each direction, or 0 for
+ *   the default
+ * @io_priority: the io priority of the request.
+ * @cancellable: (nullable): optional #GCancellable object, %NULL to ignore.
+ * @callback: (scope async): a #GAsyncReadyCallback
+ *   to call when the request is satisfied
+ * @user_data: the data to pass to callback function
+ *
+ * Like g_io_stream_splice_async(), but lets you choose the size of the
+ * buffer that data is copied through, and count the bytes moved in each
+ * direction.
+ *
+ * Each direction only reads more data once everything it read before has
+ * been written, so a slow peer slows down the other side rather than
+ * making data pile up in memory. A larger @buffer_size means fewer reads
+ * and writes, and fewer main context iterations, for bulk transfers.
+ *
+ * Where both ends of a direction are backed by file descriptors, such as
+ * sockets, the data is moved inside the kernel with `splice()` on a
+ * worker thread instead, and @buffer_size does not matter.
+ *
+ * When the operation is finished @callback will be called. You can then
+ * call g_io_stream_splice_full_finish() to get the result of the operation
+ * and the byte counts.
+ *
+ * Since: 2.82
+ */
+void
+g_io_stream_splice_full_async (GIOStream            *stream1,
+                               GIOStream            *stream2,
+                               GIOStreamSpliceFlags  flags,
+                               gsize                 buffer_size,
+                               int                   io_priority,
+                               GCancellable         *cancellable,
+                               GAsyncReadyCallback   callback,
+                               gpointer              user_data)
 {
   GTask *task;
   SpliceContext *ctx;
@@ -904,13 +964,15 @@ g_io_stream_splice_async (GIOStream            *stream1,
 
   istream = g_io_stream_get_input_stream (stream1);
   ostream = g_io_stream_get_output_stream (stream2);
-  g_output_stream_splice_async (ostream, istream, G_OUTPUT_STREAM_SPLICE_NONE,
+  ctx->counted1 = g_output_stream_splice_counted_async (ostream, istream,
+      buffer_size, &ctx->n_spliced1,
       io_priority, ctx->op1_cancellable, splice_cb,
       g_object_ref (task));
 
   istream = g_io_stream_get_input_stream (stream2);
   ostream = g_io_stream_get_output_stream (stream1);
-  g_output_stream_splice_async (ostream, istream, G_OUTPUT_STREAM_SPLICE_NONE,
+  ctx->counted2 = g_output_stream_splice_counted_async (ostream, istream,
+      buffer_size, &ctx->n_spliced2,
       io_priority, ctx->op2_cancellable, splice_cb,
       g_object_ref (task));
 
@@ -937,3 +999,43 @@ g_io_stream_splice_finish (GAsyncResult  *result,
 
   return g_task_propagate_boolean (G_TASK (result), error);
 }
+
+/**
+ * g_io_stream_splice_full_finish:
+ * @result: a #GAsyncResult.
+ * @bytes_1_to_2: (out) (optional): return location for the number of bytes
+ *   moved from @stream1 to @stream2
+ * @bytes_2_to_1: (out) (optional): return location for the number of bytes
+ *   moved from @stream2 to @stream1
+ * @error: a #GError location to store the error occurring, or %NULL to
+ * ignore.
+ *
+ * Finishes an operation started with g_io_stream_splice_full_async().
+ *
+ * The byte counts are set even if the operation failed or was cancelled,
+ * to the number of bytes which were written before that.
+ *
+ * Returns: %TRUE on success, %FALSE otherwise.
+ *
+ * Since: 2.82
+ */
+gboolean
+g_io_stream_splice_full_finish (GAsyncResult  *result,
+                                guint64       *bytes_1_to_2,
+                                guint64       *bytes_2_to_1,
+                                GError       **error)
+{
+  SpliceContext *ctx;
+
+  g_return_val_if_fail (g_task_is_valid (result, NULL), FALSE);
+  g_return_val_if_fail (g_async_result_is_tagged (result, g_io_stream_splice_async), FALSE);
+
+  /* There is no context if the operation was cancelled before it started */
+  ctx = g_task_get_task_data (G_TASK (result));
+  if (bytes_1_to_2 != NULL)
+    *bytes_1_to_2 = (ctx != NULL) ? ctx->n_spliced1 : 0;
+  if (bytes_2_to_1 != NULL)
+    *bytes_2_to_1 = (ctx != NULL) ? ctx->n_spliced2 : 0;
+
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
@@ -101,6 +101,22 @@ GIO_AVAILABLE_IN_ALL
 gboolean       g_io_stream_splice_finish     (GAsyncResult         *result,
                                               GError              **error);
 
+GIO_AVAILABLE_IN_2_82
+void           g_io_stream_splice_full_async  (GIOStream            *stream1,
+                                               GIOStream            *stream2,
+                                               GIOStreamSpliceFlags  flags,
+                                               gsize                 buffer_size,
+                                               int                   io_priority,
+                                               GCancellable         *cancellable,
+                                               GAsyncReadyCallback   callback,
+                                               gpointer              user_data);
+
+GIO_AVAILABLE_IN_2_82
+gboolean       g_io_stream_splice_full_finish (GAsyncResult         *result,
+                                               guint64              *bytes_1_to_2,
+                                               guint64              *bytes_2_to_1,
+                                               GError              **error);
+
 GIO_AVAILABLE_IN_ALL
 gboolean       g_io_stream_close             (GIOStream            *stream,
 					      GCancellable         *cancellable,
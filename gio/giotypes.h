@@ -47,6 +47,8 @@ typedef struct _GDataInputStream              GDataInputStream;
 typedef struct _GSimplePermission             GSimplePermission;
 typedef struct _GZlibCompressor               GZlibCompressor;
 typedef struct _GZlibDecompressor             GZlibDecompressor;
+typedef struct _GZstdCompressor               GZstdCompressor;
+typedef struct _GZstdDecompressor             GZstdDecompressor;
 
 typedef struct _GSimpleActionGroup            GSimpleActionGroup;
 typedef struct _GRemoteActionGroup            GRemoteActionGroup;
@@ -91,7 +93,9 @@ typedef struct _GFilenameCompleter            GFilenameCompleter;
 
 typedef struct _GIcon                         GIcon; /* Dummy typedef */
 typedef struct _GInetAddress                  GInetAddress;
+typedef struct _GInetAddressBytes             GInetAddressBytes;
 typedef struct _GInetAddressMask              GInetAddressMask;
+typedef struct _GInetAddressMaskSet           GInetAddressMaskSet;
 typedef struct _GInetSocketAddress            GInetSocketAddress;
 typedef struct _GNativeSocketAddress          GNativeSocketAddress;
 typedef struct _GInputStream                  GInputStream;
@@ -136,6 +140,7 @@ typedef struct _GSocket                       GSocket;
 typedef struct _GSocketControlMessage         GSocketControlMessage;
 typedef struct _GSocketClient                               GSocketClient;
 typedef struct _GSocketConnection                           GSocketConnection;
+typedef struct _GSocketConnectionPool                       GSocketConnectionPool;
 typedef struct _GSocketListener                             GSocketListener;
 typedef struct _GSocketService                              GSocketService;
 typedef struct _GSocketAddress                GSocketAddress;
@@ -462,6 +467,7 @@ struct _GOutputMessage {
 };
 
 typedef struct _GCredentials                  GCredentials;
+typedef struct _GUdpSegmentMessage            GUdpSegmentMessage;
 typedef struct _GUnixCredentialsMessage       GUnixCredentialsMessage;
 typedef struct _GUnixFDList                   GUnixFDList;
 typedef struct _GDBusMessage                  GDBusMessage;
@@ -0,0 +1,790 @@
+/*
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* An io_uring instance per GMainContext, used by GSocket and the local file
+ * streams for asynchronous reads and writes when GIO_USE_IO_URING=1 is set.
+ *
+ * The ring is a GSource polling the ring fd, which is readable while there
+ * are completions. Operations are queued in the submission ring and all of
+ * those queued during an iteration are submitted with a single
+ * io_uring_enter() from prepare(). Completions are reaped in dispatch(),
+ * which calls the operations’ callbacks.
+ *
+ * The kernel has to support IORING_FEAT_FAST_POLL, so that reads and writes
+ * on non-blocking sockets wait for readiness instead of failing with EAGAIN
+ * straight away. Otherwise, or if io_uring is not available at all (because
+ * of seccomp filters, for example), g_io_uring_get_for_context() returns
+ * %NULL and callers use poll() instead.
+ */
+
+#include "config.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+#include "giouring-private.h"
+#include "gcancellable.h"
+#include "gioerror.h"
+#include "glibintl.h"
+
+/* Number of submission queue entries. If more operations than this are
+ * queued in one iteration, they are submitted early. The completion queue
+ * is bigger as operations can stay in flight over many iterations, and
+ * with IORING_FEAT_NODROP the kernel keeps overflowing completions. */
+#define SQ_ENTRIES 256
+#define CQ_ENTRIES 4096
+
+struct _GIOUringOp
+{
+  GIOUringCallback callback;
+  gpointer user_data;
+  int result;
+  GIOUringOp *next;
+};
+
+struct _GIOUring
+{
+  GSource source;
+
+  GMainContext *context;  /* (unowned) */
+
+  GMutex lock;
+  int fd;
+
+  void *rings;
+  gsize rings_size;
+  struct io_uring_sqe *sqes;
+  gsize sqes_size;
+
+  unsigned *sq_head;
+  unsigned *sq_tail;
+  unsigned *sq_flags;
+  unsigned *sq_array;
+  unsigned sq_mask;
+  unsigned sq_entries;
+
+  unsigned *cq_head;
+  unsigned *cq_tail;
+  unsigned cq_mask;
+  struct io_uring_cqe *cqes;
+
+  /* Operations which could not be submitted, to be completed from
+   * dispatch() */
+  GIOUringOp *failed;  /* (owned) (nullable) */
+};
+
+G_LOCK_DEFINE_STATIC (rings);
+static GHashTable *rings = NULL;  /* (element-type GMainContext GIOUring) (owned) (nullable) */
+static gboolean rings_unavailable = FALSE;
+
+static int
+sys_io_uring_setup (unsigned                entries,
+                    struct io_uring_params *params)
+{
+#ifdef __NR_io_uring_setup
+  return syscall (__NR_io_uring_setup, entries, params);
+#else
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+
+static int
+sys_io_uring_enter (int      fd,
+                    unsigned to_submit,
+                    unsigned min_complete,
+                    unsigned flags)
+{
+#ifdef __NR_io_uring_enter
+  return syscall (__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+#else
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+
+static gboolean
+ring_completions_pending (GIOUring *ring)
+{
+  return (unsigned) g_atomic_int_get ((gint *) ring->cq_tail) != *ring->cq_head ||
+         (g_atomic_int_get ((gint *) ring->sq_flags) & IORING_SQ_CQ_OVERFLOW) != 0 ||
+         ring->failed != NULL;
+}
+
+/* Submits all queued entries. If the kernel refuses them for anything but
+ * a lack of resources, they are failed with the same error. */
+static void
+ring_submit_unlocked (GIOUring *ring)
+{
+  unsigned head, tail, i;
+  int ret, errsv;
+
+  tail = *ring->sq_tail;
+  head = (unsigned) g_atomic_int_get ((gint *) ring->sq_head);
+  if (tail == head)
+    return;
+
+  do
+    ret = sys_io_uring_enter (ring->fd, tail - head, 0, 0);
+  while (ret < 0 && errno == EINTR);
+
+  if (ret >= 0)
+    return;
+
+  /* EBUSY means completions have to be reaped first */
+  errsv = errno;
+  if (errsv == EAGAIN || errsv == EBUSY)
+    return;
+
+  /* The kernel only reads the tail in io_uring_enter(), so the unsubmitted
+   * entries can be taken back */
+  head = (unsigned) g_atomic_int_get ((gint *) ring->sq_head);
+  for (i = head; i != tail; i++)
+    {
+      struct io_uring_sqe *sqe = &ring->sqes[ring->sq_array[i & ring->sq_mask]];
+      GIOUringOp *op = (GIOUringOp *) (guintptr) sqe->user_data;
+
+      /* Cancellations have no operation */
+      if (op != NULL)
+        {
+          op->result = -errsv;
+          op->next = ring->failed;
+          ring->failed = op;
+        }
+    }
+
+  g_atomic_int_set ((gint *) ring->sq_tail, (gint) head);
+}
+
+static struct io_uring_sqe *
+ring_get_sqe_unlocked (GIOUring *ring)
+{
+  struct io_uring_sqe *sqe;
+  unsigned head, tail, index;
+
+  tail = *ring->sq_tail;
+  head = (unsigned) g_atomic_int_get ((gint *) ring->sq_head);
+
+  if (tail - head >= ring->sq_entries)
+    {
+      ring_submit_unlocked (ring);
+
+      tail = *ring->sq_tail;
+      head = (unsigned) g_atomic_int_get ((gint *) ring->sq_head);
+      if (tail - head >= ring->sq_entries)
+        return NULL;
+    }
+
+  index = tail & ring->sq_mask;
+  sqe = &ring->sqes[index];
+  memset (sqe, 0, sizeof (*sqe));
+  ring->sq_array[index] = index;
+
+  return sqe;
+}
+
+/* Makes the entry returned by ring_get_sqe_unlocked() visible to the next
+ * io_uring_enter() */
+static void
+ring_push_sqe_unlocked (GIOUring *ring)
+{
+  g_atomic_int_set ((gint *) ring->sq_tail, (gint) (*ring->sq_tail + 1));
+}
+
+/* Makes sure an iteration of the context runs soon to submit what was
+ * queued, if the calling thread isn’t the one iterating it */
+static void
+ring_wakeup (GIOUring *ring)
+{
+  if (!g_main_context_is_owner (ring->context))
+    g_main_context_wakeup (ring->context);
+}
+
+static gboolean
+ring_prepare (GSource *source,
+              gint    *timeout)
+{
+  GIOUring *ring = (GIOUring *) source;
+  gboolean ready;
+
+  g_mutex_lock (&ring->lock);
+  ring_submit_unlocked (ring);
+  ready = ring_completions_pending (ring);
+  g_mutex_unlock (&ring->lock);
+
+  *timeout = -1;
+
+  return ready;
+}
+
+static gboolean
+ring_check (GSource *source)
+{
+  GIOUring *ring = (GIOUring *) source;
+  gboolean ready;
+
+  g_mutex_lock (&ring->lock);
+  ready = ring_completions_pending (ring);
+  g_mutex_unlock (&ring->lock);
+
+  return ready;
+}
+
+static gboolean
+ring_dispatch (GSource     *source,
+               GSourceFunc  callback,
+               gpointer     user_data)
+{
+  GIOUring *ring = (GIOUring *) source;
+  GIOUringOp *completed = NULL;
+  GIOUringOp **last = &completed;
+
+  g_mutex_lock (&ring->lock);
+
+  while (TRUE)
+    {
+      unsigned head = *ring->cq_head;
+      unsigned tail = (unsigned) g_atomic_int_get ((gint *) ring->cq_tail);
+
+      for (; head != tail; head++)
+        {
+          struct io_uring_cqe *cqe = &ring->cqes[head & ring->cq_mask];
+          GIOUringOp *op = (GIOUringOp *) (guintptr) cqe->user_data;
+
+          if (op != NULL)
+            {
+              op->result = cqe->res;
+              *last = op;
+              last = &op->next;
+            }
+        }
+
+      g_atomic_int_set ((gint *) ring->cq_head, (gint) head);
+
+      /* Have the kernel move overflowed completions into the ring */
+      if ((g_atomic_int_get ((gint *) ring->sq_flags) & IORING_SQ_CQ_OVERFLOW) == 0 ||
+          sys_io_uring_enter (ring->fd, 0, 0, IORING_ENTER_GETEVENTS) < 0)
+        break;
+    }
+
+  *last = g_steal_pointer (&ring->failed);
+
+  g_mutex_unlock (&ring->lock);
+
+  /* Callbacks may queue new operations */
+  while (completed != NULL)
+    {
+      GIOUringOp *op = completed;
+
+      completed = op->next;
+      op->callback (op->result, op->user_data);
+      g_free (op);
+    }
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+ring_finalize (GSource *source)
+{
+  GIOUring *ring = (GIOUring *) source;
+
+  G_LOCK (rings);
+  if (rings != NULL && g_hash_table_lookup (rings, ring->context) == ring)
+    g_hash_table_remove (rings, ring->context);
+  G_UNLOCK (rings);
+
+  /* Closing the ring cancels whatever is still in flight */
+  munmap (ring->sqes, ring->sqes_size);
+  munmap (ring->rings, ring->rings_size);
+  close (ring->fd);
+
+  g_mutex_clear (&ring->lock);
+}
+
+static GSourceFuncs ring_source_funcs = {
+  ring_prepare,
+  ring_check,
+  ring_dispatch,
+  ring_finalize,
+  NULL,
+  NULL,
+};
+
+/* Returns %NULL with errno set on failure */
+static GIOUring *
+ring_new (GMainContext *context)
+{
+  const unsigned required = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL |
+                            IORING_FEAT_RW_CUR_POS;
+  struct io_uring_params params;
+  GIOUring *ring;
+  void *ptr, *sqes;
+  gsize size, sqes_size;
+  int fd;
+
+  memset (&params, 0, sizeof (params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = CQ_ENTRIES;
+
+  fd = sys_io_uring_setup (SQ_ENTRIES, &params);
+  if (fd < 0)
+    return NULL;
+
+  if ((params.features & required) != required)
+    {
+      close (fd);
+      errno = ENOSYS;
+      return NULL;
+    }
+
+  size = MAX (params.sq_off.array + params.sq_entries * sizeof (unsigned),
+              params.cq_off.cqes + params.cq_entries * sizeof (struct io_uring_cqe));
+  ptr = mmap (NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+              fd, IORING_OFF_SQ_RING);
+  if (ptr == MAP_FAILED)
+    {
+      int errsv = errno;
+
+      close (fd);
+      errno = errsv;
+      return NULL;
+    }
+
+  sqes_size = params.sq_entries * sizeof (struct io_uring_sqe);
+  sqes = mmap (NULL, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+               fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED)
+    {
+      int errsv = errno;
+
+      munmap (ptr, size);
+      close (fd);
+      errno = errsv;
+      return NULL;
+    }
+
+  ring = (GIOUring *) g_source_new (&ring_source_funcs, sizeof (GIOUring));
+  g_source_set_static_name ((GSource *) ring, "[gio] io_uring");
+
+  ring->context = context;
+  g_mutex_init (&ring->lock);
+  ring->fd = fd;
+  ring->rings = ptr;
+  ring->rings_size = size;
+  ring->sqes = sqes;
+  ring->sqes_size = sqes_size;
+
+  ring->sq_head = (unsigned *) ((guint8 *) ptr + params.sq_off.head);
+  ring->sq_tail = (unsigned *) ((guint8 *) ptr + params.sq_off.tail);
+  ring->sq_flags = (unsigned *) ((guint8 *) ptr + params.sq_off.flags);
+  ring->sq_array = (unsigned *) ((guint8 *) ptr + params.sq_off.array);
+  ring->sq_mask = *(unsigned *) ((guint8 *) ptr + params.sq_off.ring_mask);
+  ring->sq_entries = params.sq_entries;
+
+  ring->cq_head = (unsigned *) ((guint8 *) ptr + params.cq_off.head);
+  ring->cq_tail = (unsigned *) ((guint8 *) ptr + params.cq_off.tail);
+  ring->cq_mask = *(unsigned *) ((guint8 *) ptr + params.cq_off.ring_mask);
+  ring->cqes = (struct io_uring_cqe *) ((guint8 *) ptr + params.cq_off.cqes);
+
+  g_source_add_unix_fd ((GSource *) ring, fd, G_IO_IN);
+
+  return ring;
+}
+
+/*
+ * g_io_uring_get_for_context:
+ * @context: (nullable): a #GMainContext, or %NULL for the global default
+ *   context
+ *
+ * Gets the ring of @context, creating and attaching it the first time.
+ *
+ * Returns: (transfer none) (nullable): the ring, or %NULL if io_uring is
+ *   not enabled or not available
+ */
+GIOUring *
+g_io_uring_get_for_context (GMainContext *context)
+{
+  static gsize enabled = 0;
+  GIOUring *ring = NULL;
+
+  if (g_once_init_enter (&enabled))
+    g_once_init_leave (&enabled, g_strcmp0 (g_getenv ("GIO_USE_IO_URING"), "1") == 0 ? 1 : 2);
+
+  if (enabled != 1)
+    return NULL;
+
+  if (context == NULL)
+    context = g_main_context_default ();
+
+  G_LOCK (rings);
+
+  if (!rings_unavailable)
+    {
+      if (rings == NULL)
+        rings = g_hash_table_new (NULL, NULL);
+
+      ring = g_hash_table_lookup (rings, context);
+      if (ring == NULL)
+        {
+          ring = ring_new (context);
+          if (ring != NULL)
+            {
+              g_hash_table_insert (rings, context, ring);
+              g_source_attach ((GSource *) ring, context);
+              g_source_unref ((GSource *) ring);
+            }
+          else if (errno == ENOSYS || errno == EPERM || errno == EACCES || errno == EINVAL)
+            {
+              /* Not supported or not allowed, so don’t try again. Other
+               * errors, such as running out of fds, may be temporary. */
+              rings_unavailable = TRUE;
+            }
+        }
+    }
+
+  G_UNLOCK (rings);
+
+  return ring;
+}
+
+static GIOUringOp *
+ring_queue (GIOUring         *ring,
+            guint8            opcode,
+            int               fd,
+            gconstpointer     buffer,
+            gsize             size,
+            guint64           offset,
+            int               flags,
+            GIOUringCallback  callback,
+            gpointer          user_data)
+{
+  struct io_uring_sqe *sqe;
+  GIOUringOp *op;
+
+  g_mutex_lock (&ring->lock);
+
+  sqe = ring_get_sqe_unlocked (ring);
+  if (sqe == NULL)
+    {
+      g_mutex_unlock (&ring->lock);
+      return NULL;
+    }
+
+  op = g_new0 (GIOUringOp, 1);
+  op->callback = callback;
+  op->user_data = user_data;
+
+  sqe->opcode = opcode;
+  sqe->fd = fd;
+  sqe->addr = (guintptr) buffer;
+  /* The result is an int */
+  sqe->len = MIN (size, G_MAXINT);
+  sqe->off = offset;
+  sqe->msg_flags = flags;
+  sqe->user_data = (guintptr) op;
+  ring_push_sqe_unlocked (ring);
+
+  g_mutex_unlock (&ring->lock);
+
+  ring_wakeup (ring);
+
+  return op;
+}
+
+/*
+ * g_io_uring_recv:
+ * @ring: a #GIOUring
+ * @fd: a socket
+ * @buffer: (out caller-allocates): buffer to read into, which has to stay
+ *   valid until @callback is called
+ * @size: size of @buffer
+ * @flags: flags for recv()
+ * @callback: function to call with the result
+ * @user_data: data for @callback
+ *
+ * Queues a recv() on @fd, which is submitted the next time the ring’s
+ * context is iterated.
+ *
+ * Returns: (transfer none) (nullable): the operation, valid until @callback
+ *   is called, or %NULL if the submission queue is full
+ */
+GIOUringOp *
+g_io_uring_recv (GIOUring         *ring,
+                 int               fd,
+                 void             *buffer,
+                 gsize             size,
+                 int               flags,
+                 GIOUringCallback  callback,
+                 gpointer          user_data)
+{
+  return ring_queue (ring, IORING_OP_RECV, fd, buffer, size, 0, flags, callback, user_data);
+}
+
+/*
+ * g_io_uring_send:
+ *
+ * Like g_io_uring_recv(), but for send().
+ */
+GIOUringOp *
+g_io_uring_send (GIOUring         *ring,
+                 int               fd,
+                 const void       *buffer,
+                 gsize             size,
+                 int               flags,
+                 GIOUringCallback  callback,
+                 gpointer          user_data)
+{
+  return ring_queue (ring, IORING_OP_SEND, fd, buffer, size, 0, flags, callback, user_data);
+}
+
+/*
+ * g_io_uring_cancel:
+ * @ring: a #GIOUring
+ * @op: an operation of @ring whose callback hasn’t been called yet
+ *
+ * Asks the kernel to cancel @op. If it’s not too late, its callback is
+ * called with `-ECANCELED`.
+ */
+void
+g_io_uring_cancel (GIOUring   *ring,
+                   GIOUringOp *op)
+{
+  struct io_uring_sqe *sqe;
+
+  g_mutex_lock (&ring->lock);
+
+  sqe = ring_get_sqe_unlocked (ring);
+  if (sqe != NULL)
+    {
+      sqe->opcode = IORING_OP_ASYNC_CANCEL;
+      sqe->fd = -1;
+      sqe->addr = (guintptr) op;
+      ring_push_sqe_unlocked (ring);
+    }
+
+  g_mutex_unlock (&ring->lock);
+
+  ring_wakeup (ring);
+}
+
+/* The file position is used and updated, like read() and write() do */
+#define CURRENT_POSITION ((guint64) -1)
+
+typedef struct
+{
+  GIOUring *ring;
+  GTask *task;  /* (owned) */
+  gboolean is_write;
+  gulong cancelled_id;
+
+  GMutex lock;
+  GIOUringOp *op;  /* (nullable) */
+  gboolean cancel_requested;
+} FileRequest;
+
+static void
+file_request_complete_error (GTask    *task,
+                             gboolean  is_write,
+                             int       errsv)
+{
+  if (g_task_return_error_if_cancelled (task))
+    return;
+
+  g_task_return_new_error (task, G_IO_ERROR, g_io_error_from_errno (errsv),
+                           is_write ? _("Error writing to file: %s")
+                                    : _("Error reading from file: %s"),
+                           g_strerror (errsv));
+}
+
+static void
+file_request_complete (int      result,
+                       gpointer user_data)
+{
+  FileRequest *request = user_data;
+  GTask *task = request->task;
+
+  g_mutex_lock (&request->lock);
+  request->op = NULL;
+  g_mutex_unlock (&request->lock);
+
+  /* Waits for a handler running in another thread */
+  g_cancellable_disconnect (g_task_get_cancellable (task), request->cancelled_id);
+
+  if (result >= 0)
+    g_task_return_int (task, result);
+  else
+    file_request_complete_error (task, request->is_write, -result);
+
+  g_mutex_clear (&request->lock);
+  g_object_unref (task);
+  g_free (request);
+}
+
+static void
+file_request_cancelled (GCancellable *cancellable,
+                        gpointer      user_data)
+{
+  FileRequest *request = user_data;
+
+  /* Reads of regular files which have already started run to completion,
+   * so this only helps for those still queued, or on pipes */
+  g_mutex_lock (&request->lock);
+  request->cancel_requested = TRUE;
+  if (request->op != NULL)
+    g_io_uring_cancel (request->ring, request->op);
+  g_mutex_unlock (&request->lock);
+}
+
+typedef struct
+{
+  gboolean is_write;
+  int fd;
+  gpointer buffer;
+  gsize size;
+} FileThreadData;
+
+static void
+file_request_thread (GTask        *task,
+                     gpointer      source_object,
+                     gpointer      task_data,
+                     GCancellable *cancellable)
+{
+  FileThreadData *data = task_data;
+  gssize res;
+
+  do
+    {
+      if (data->is_write)
+        res = write (data->fd, data->buffer, data->size);
+      else
+        res = read (data->fd, data->buffer, data->size);
+    }
+  while (res == -1 && errno == EINTR);
+
+  if (res >= 0)
+    g_task_return_int (task, res);
+  else
+    file_request_complete_error (task, data->is_write, errno);
+}
+
+static void
+file_request_start (GIOUring   *ring,
+                    gboolean    is_write,
+                    int         fd,
+                    gpointer    buffer,
+                    gsize       size,
+                    GTask      *task)
+{
+  FileRequest *request;
+  FileThreadData *data;
+  GCancellable *cancellable;
+  GIOUringOp *op = NULL;
+
+  if (g_task_return_error_if_cancelled (task))
+    return;
+
+  request = g_new0 (FileRequest, 1);
+  request->ring = ring;
+  request->task = g_object_ref (task);
+  request->is_write = is_write;
+  g_mutex_init (&request->lock);
+
+  /* Connect first, so the operation can’t complete before the handler ID
+   * is known. If already cancelled, the handler runs straight away. */
+  cancellable = g_task_get_cancellable (task);
+  if (cancellable != NULL)
+    request->cancelled_id = g_cancellable_connect (cancellable,
+                                                   G_CALLBACK (file_request_cancelled),
+                                                   request, NULL);
+
+  g_mutex_lock (&request->lock);
+  if (!request->cancel_requested)
+    {
+      op = ring_queue (ring, is_write ? IORING_OP_WRITE : IORING_OP_READ,
+                       fd, buffer, size, CURRENT_POSITION, 0,
+                       file_request_complete, request);
+      request->op = op;
+    }
+  g_mutex_unlock (&request->lock);
+
+  if (op != NULL)
+    return;
+
+  g_cancellable_disconnect (cancellable, request->cancelled_id);
+  g_mutex_clear (&request->lock);
+  g_object_unref (request->task);
+  g_free (request);
+
+  if (g_task_return_error_if_cancelled (task))
+    return;
+
+  /* The submission queue is full, so do it the way it’s done without a
+   * ring rather than waiting for a slot */
+  data = g_new0 (FileThreadData, 1);
+  data->is_write = is_write;
+  data->fd = fd;
+  data->buffer = buffer;
+  data->size = size;
+  g_task_set_task_data (task, data, g_free);
+  g_task_run_in_thread (task, file_request_thread);
+}
+
+/*
+ * g_io_uring_file_read:
+ * @ring: a #GIOUring
+ * @fd: a file descriptor
+ * @buffer: (out caller-allocates): buffer to read into, which has to stay
+ *   valid until @task returns
+ * @size: size of @buffer
+ * @task: the task to return the number of bytes read, or an error, to
+ *
+ * Reads from @fd at its current position, like read(), and returns the
+ * result with @task from the ring’s context. @task is cancelled through
+ * its #GCancellable.
+ *
+ * If the submission queue is full, the read is done in a thread of the
+ * #GTask pool instead.
+ */
+void
+g_io_uring_file_read (GIOUring *ring,
+                      int       fd,
+                      void     *buffer,
+                      gsize     size,
+                      GTask    *task)
+{
+  file_request_start (ring, FALSE, fd, buffer, size, task);
+}
+
+/*
+ * g_io_uring_file_write:
+ *
+ * Like g_io_uring_file_read(), but for write().
+ */
+void
+g_io_uring_file_write (GIOUring   *ring,
+                       int         fd,
+                       const void *buffer,
+                       gsize       size,
+                       GTask      *task)
+{
+  file_request_start (ring, TRUE, fd, (gpointer) buffer, size, task);
+}
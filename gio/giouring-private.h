@@ -0,0 +1,64 @@
+/*
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <glib.h>
+
+#include "gtask.h"
+
+G_BEGIN_DECLS
+
+typedef struct _GIOUring GIOUring;
+typedef struct _GIOUringOp GIOUringOp;
+
+/* Called from the ring’s main context with the result of the operation:
+ * a byte count, or a negated errno value */
+typedef void (*GIOUringCallback) (int      result,
+                                  gpointer user_data);
+
+GIOUring   *g_io_uring_get_for_context (GMainContext     *context);
+
+GIOUringOp *g_io_uring_recv            (GIOUring         *ring,
+                                        int               fd,
+                                        void             *buffer,
+                                        gsize             size,
+                                        int               flags,
+                                        GIOUringCallback  callback,
+                                        gpointer          user_data);
+GIOUringOp *g_io_uring_send            (GIOUring         *ring,
+                                        int               fd,
+                                        const void       *buffer,
+                                        gsize             size,
+                                        int               flags,
+                                        GIOUringCallback  callback,
+                                        gpointer          user_data);
+void        g_io_uring_cancel          (GIOUring         *ring,
+                                        GIOUringOp       *op);
+
+void        g_io_uring_file_read       (GIOUring         *ring,
+                                        int               fd,
+                                        void             *buffer,
+                                        gsize             size,
+                                        GTask            *task);
+void        g_io_uring_file_write      (GIOUring         *ring,
+                                        int               fd,
+                                        const void       *buffer,
+                                        gsize             size,
+                                        GTask            *task);
+
+G_END_DECLS
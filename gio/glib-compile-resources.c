@@ -39,6 +39,7 @@
 #include <gio/gioenums.h>
 #include <gio/gmemoryoutputstream.h>
 #include <gio/gzlibcompressor.h>
+#include <gio/gzstdcompressor.h>
 #include <gio/gconverteroutputstream.h>
 
 #include <glib.h>
@@ -47,18 +48,34 @@
 #include "gconstructor_as_data.h"
 #include "glib/glib-private.h"
 
-typedef struct
+typedef enum
+{
+  PREPROCESS_XML_STRIPBLANKS = 1 << 0,
+  PREPROCESS_JSON_STRIPBLANKS = 1 << 1,
+  PREPROCESS_TO_PIXDATA = 1 << 2,
+} PreprocessFlags;
+
+typedef struct _FileData FileData;
+
+struct _FileData
 {
   char *filename;
-  char *content;
-  gsize content_size;
+  PreprocessFlags preprocess;
+  GResourceFlags compression;
+
+  /* Set by process_files() */
+  char *checksum;  /* of the source contents and the options above */
+  char *content;  /* source contents, kept only if there is no preprocessing */
   gsize size;
-  guint32 flags;
-} FileData;
+  FileData *duplicate_of;  /* (nullable) (unowned) identical file whose value is reused */
+  GVariant *value;  /* (nullable) (owned) the (uuay) entry stored in the resource */
+  GError *error;
+};
 
 typedef struct
 {
   GHashTable *table; /* resource path -> FileData */
+  GPtrArray *files;  /* (element-type FileData) (unowned) in document order */
 
   gboolean collect_data;
 
@@ -67,7 +84,7 @@ typedef struct
 
   /* per file */
   char *alias;
-  gboolean compressed;
+  GResourceFlags compression;
   char *preproc_options;
 
   GString *string;  /* non-NULL when accepting text */
@@ -77,15 +94,59 @@ static gchar **sourcedirs = NULL;
 static gchar *xmllint = NULL;
 static gchar *jsonformat = NULL;
 static gchar *gdk_pixbuf_pixdata = NULL;
+static gchar *cache_dir = NULL;
+static gint n_jobs = 0;
 
 static void
 file_data_free (FileData *data)
 {
   g_free (data->filename);
+  g_free (data->checksum);
   g_free (data->content);
+  g_clear_pointer (&data->value, g_variant_unref);
+  g_clear_error (&data->error);
   g_free (data);
 }
 
+/* Parses the “compressed” attribute of a file, which is either a boolean
+ * as accepted by GMarkup, selecting zlib, or the name of the algorithm */
+static gboolean
+parse_compression (const gchar     *value,
+                   GResourceFlags  *compression,
+                   GError         **error)
+{
+  const char * const false_values[] = { "false", "f", "no", "n", "0", NULL };
+  const char * const true_values[] = { "true", "t", "yes", "y", "1", "zlib", NULL };
+  gsize i;
+
+  *compression = G_RESOURCE_FLAGS_NONE;
+
+  if (value == NULL)
+    return TRUE;
+
+  if (g_ascii_strcasecmp (value, "zstd") == 0)
+    {
+      *compression = G_RESOURCE_FLAGS_COMPRESSED_ZSTD;
+      return TRUE;
+    }
+
+  for (i = 0; true_values[i] != NULL; i++)
+    if (g_ascii_strcasecmp (value, true_values[i]) == 0)
+      {
+        *compression = G_RESOURCE_FLAGS_COMPRESSED;
+        return TRUE;
+      }
+
+  for (i = 0; false_values[i] != NULL; i++)
+    if (g_ascii_strcasecmp (value, false_values[i]) == 0)
+      return TRUE;
+
+  g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+               _("Invalid compression “%s”, expected a boolean, “zlib” or “zstd”"),
+               value);
+  return FALSE;
+}
+
 static void
 start_element (GMarkupParseContext  *context,
 	       const gchar          *element_name,
@@ -129,9 +190,16 @@ start_element (GMarkupParseContext  *context,
     {
       if (strcmp (element_name, "file") == 0)
 	{
-	  COLLECT (OPTIONAL | STRDUP, "alias", &state->alias,
-		   OPTIONAL | BOOL, "compressed", &state->compressed,
-                   OPTIONAL | STRDUP, "preprocess", &state->preproc_options);
+	  const gchar *compressed = NULL;
+
+	  if (!COLLECT (OPTIONAL | STRDUP, "alias", &state->alias,
+			OPTIONAL | STRING, "compressed", &compressed,
+			OPTIONAL | STRDUP, "preprocess", &state->preproc_options))
+	    return;
+
+	  if (!parse_compression (compressed, &state->compression, error))
+	    return;
+
 	  state->string = g_string_new ("");
 	  return;
 	}
@@ -204,7 +272,6 @@ end_element (GMarkupParseContext  *context,
 	     GError              **error)
 {
   ParseState *state = user_data;
-  GError *my_error = NULL;
 
   if (strcmp (element_name, "gresource") == 0)
     {
@@ -217,8 +284,8 @@ end_element (GMarkupParseContext  *context,
       gchar *file;
       gchar *real_file = NULL;
       gchar *key;
-      FileData *data = NULL;
-      char *tmp_file = NULL;
+      FileData *data;
+      PreprocessFlags preprocess = 0;
 
       file = state->string->str;
       key = file;
@@ -263,29 +330,21 @@ end_element (GMarkupParseContext  *context,
       if (real_file == NULL)
         real_file = g_strdup (file);
 
-      data = g_new0 (FileData, 1);
-      data->filename = g_strdup (real_file);
-      if (!state->collect_data)
-        goto done;
-
       if (state->preproc_options)
         {
           gchar **options;
           guint i;
-          gboolean xml_stripblanks = FALSE;
-          gboolean json_stripblanks = FALSE;
-          gboolean to_pixdata = FALSE;
 
           options = g_strsplit (state->preproc_options, ",", -1);
 
           for (i = 0; options[i]; i++)
             {
               if (!strcmp (options[i], "xml-stripblanks"))
-                xml_stripblanks = TRUE;
+                preprocess |= PREPROCESS_XML_STRIPBLANKS;
               else if (!strcmp (options[i], "to-pixdata"))
-                to_pixdata = TRUE;
+                preprocess |= PREPROCESS_TO_PIXDATA;
               else if (!strcmp (options[i], "json-stripblanks"))
-                json_stripblanks = TRUE;
+                preprocess |= PREPROCESS_JSON_STRIPBLANKS;
               else
                 {
                   g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
@@ -295,209 +354,89 @@ end_element (GMarkupParseContext  *context,
                 }
             }
           g_strfreev (options);
+        }
 
-          if (xml_stripblanks)
+      /* The preprocessors only run on the thread pool in process_files(),
+       * but whether they are available is checked here, in document order */
+      if (state->collect_data)
+        {
+          if ((preprocess & PREPROCESS_XML_STRIPBLANKS) && xmllint == NULL)
             {
+              static gboolean xmllint_warned = FALSE;
+
               /* This is not fatal: pretty-printed XML is still valid XML */
-              if (xmllint == NULL)
+              if (!xmllint_warned)
                 {
-                  static gboolean xmllint_warned = FALSE;
-
-                  if (!xmllint_warned)
-                    {
-                      /* Translators: the first %s is a gresource XML attribute,
-                       * the second %s is an environment variable, and the third
-                       * %s is a command line tool
-                       */
-                      char *warn = g_strdup_printf (_("%s preprocessing requested, but %s is not set, and %s is not in PATH"),
-                                                    "xml-stripblanks",
-                                                    "XMLLINT",
-                                                    "xmllint");
-                      g_printerr ("%s\n", warn);
-                      g_free (warn);
-
-                      /* Only warn once */
-                      xmllint_warned = TRUE;
-                    }
+                  /* Translators: the first %s is a gresource XML attribute,
+                   * the second %s is an environment variable, and the third
+                   * %s is a command line tool
+                   */
+                  char *warn = g_strdup_printf (_("%s preprocessing requested, but %s is not set, and %s is not in PATH"),
+                                                "xml-stripblanks",
+                                                "XMLLINT",
+                                                "xmllint");
+                  g_printerr ("%s\n", warn);
+                  g_free (warn);
+
+                  /* Only warn once */
+                  xmllint_warned = TRUE;
                 }
-              else
-                {
-                  GSubprocess *proc;
-                  int fd;
-
-                  fd = g_file_open_tmp ("resource-XXXXXXXX", &tmp_file, error);
-                  if (fd < 0)
-                    goto cleanup;
-
-                  close (fd);
-
-                  proc = g_subprocess_new (G_SUBPROCESS_FLAGS_STDOUT_SILENCE, error,
-                                           xmllint, "--nonet", "--noblanks", "--output", tmp_file, real_file, NULL);
-                  g_free (real_file);
-                  real_file = NULL;
 
-                  if (!proc)
-                    goto cleanup;
-
-                  if (!g_subprocess_wait_check (proc, NULL, error))
-                    {
-                      g_object_unref (proc);
-                      goto cleanup;
-                    }
-
-                  g_object_unref (proc);
-
-                  real_file = g_strdup (tmp_file);
-                }
+              preprocess &= ~PREPROCESS_XML_STRIPBLANKS;
             }
 
-          if (json_stripblanks)
+          if ((preprocess & PREPROCESS_JSON_STRIPBLANKS) && jsonformat == NULL)
             {
+              static gboolean jsonformat_warned = FALSE;
+
               /* As above, this is not fatal: pretty-printed JSON is still
                * valid JSON
                */
-              if (jsonformat == NULL)
-                {
-                  static gboolean jsonformat_warned = FALSE;
-
-                  if (!jsonformat_warned)
-                    {
-                      /* Translators: the first %s is a gresource XML attribute,
-                       * the second %s is an environment variable, and the third
-                       * %s is a command line tool
-                       */
-                      char *warn = g_strdup_printf (_("%s preprocessing requested, but %s is not set, and %s is not in PATH"),
-                                                    "json-stripblanks",
-                                                    "JSON_GLIB_FORMAT",
-                                                    "json-glib-format");
-                      g_printerr ("%s\n", warn);
-                      g_free (warn);
-
-                      /* Only warn once */
-                      jsonformat_warned = TRUE;
-                    }
-                }
-              else
-                {
-                  GSubprocess *proc;
-                  int fd;
-
-                  fd = g_file_open_tmp ("resource-XXXXXXXX", &tmp_file, error);
-                  if (fd < 0)
-                    goto cleanup;
-
-                  close (fd);
-
-                  proc = g_subprocess_new (G_SUBPROCESS_FLAGS_STDOUT_SILENCE, error,
-                                           jsonformat, "--output", tmp_file, real_file, NULL);
-                  g_free (real_file);
-                  real_file = NULL;
-
-                  if (!proc)
-                    goto cleanup;
-
-                  if (!g_subprocess_wait_check (proc, NULL, error))
-                    {
-                      g_object_unref (proc);
-                      goto cleanup;
-                    }
-
-                  g_object_unref (proc);
-
-                  real_file = g_strdup (tmp_file);
-                }
-            }
-
-          if (to_pixdata)
-            {
-	      GSubprocess *proc;
-              int fd;
-
-              /* This is a fatal error: if to-pixdata is used it means that
-               * the code loading the GResource expects a specific data format
-               */
-              if (gdk_pixbuf_pixdata == NULL)
+              if (!jsonformat_warned)
                 {
                   /* Translators: the first %s is a gresource XML attribute,
                    * the second %s is an environment variable, and the third
                    * %s is a command line tool
                    */
-                  g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED,
-                               _("%s preprocessing requested, but %s is not set, and %s is not in PATH"),
-                               "to-pixdata",
-                               "GDK_PIXBUF_PIXDATA",
-                               "gdk-pixbuf-pixdata");
-                  goto cleanup;
+                  char *warn = g_strdup_printf (_("%s preprocessing requested, but %s is not set, and %s is not in PATH"),
+                                                "json-stripblanks",
+                                                "JSON_GLIB_FORMAT",
+                                                "json-glib-format");
+                  g_printerr ("%s\n", warn);
+                  g_free (warn);
+
+                  /* Only warn once */
+                  jsonformat_warned = TRUE;
                 }
 
-              fd = g_file_open_tmp ("resource-XXXXXXXX", &tmp_file, error);
-              if (fd < 0)
-                goto cleanup;
-
-              close (fd);
-
-              proc = g_subprocess_new (G_SUBPROCESS_FLAGS_STDOUT_SILENCE, error,
-                                       gdk_pixbuf_pixdata, real_file, tmp_file, NULL);
-              g_free (real_file);
-              real_file = NULL;
-
-	      if (!g_subprocess_wait_check (proc, NULL, error))
-		{
-		  g_object_unref (proc);
-                  goto cleanup;
-		}
-
-	      g_object_unref (proc);
-
-              real_file = g_strdup (tmp_file);
+              preprocess &= ~PREPROCESS_JSON_STRIPBLANKS;
             }
-	}
 
-      if (!g_file_get_contents (real_file, &data->content, &data->size, &my_error))
-	{
-	  g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
-		       _("Error reading file %s: %s"),
-		       real_file, my_error->message);
-	  g_clear_error (&my_error);
-	  goto cleanup;
-	}
-      /* Include zero termination in content_size for uncompressed files (but not in size) */
-      data->content_size = data->size + 1;
-
-      if (state->compressed)
-	{
-	  GOutputStream *out = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
-	  GZlibCompressor *compressor =
-	    g_zlib_compressor_new (G_ZLIB_COMPRESSOR_FORMAT_ZLIB, 9);
-	  GOutputStream *out2 = g_converter_output_stream_new (out, G_CONVERTER (compressor));
-
-	  if (!g_output_stream_write_all (out2, data->content, data->size,
-					  NULL, NULL, NULL) ||
-	      !g_output_stream_close (out2, NULL, NULL))
-	    {
-	      g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
-			   _("Error compressing file %s"),
-			   real_file);
-              g_object_unref (compressor);
-              g_object_unref (out);
-              g_object_unref (out2);
+          /* This is a fatal error: if to-pixdata is used it means that
+           * the code loading the GResource expects a specific data format
+           */
+          if ((preprocess & PREPROCESS_TO_PIXDATA) && gdk_pixbuf_pixdata == NULL)
+            {
+              /* Translators: the first %s is a gresource XML attribute,
+               * the second %s is an environment variable, and the third
+               * %s is a command line tool
+               */
+              g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED,
+                           _("%s preprocessing requested, but %s is not set, and %s is not in PATH"),
+                           "to-pixdata",
+                           "GDK_PIXBUF_PIXDATA",
+                           "gdk-pixbuf-pixdata");
               goto cleanup;
-	    }
-
-	  g_free (data->content);
-	  data->content_size = g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (out));
-	  data->content = g_memory_output_stream_steal_data (G_MEMORY_OUTPUT_STREAM (out));
-
-	  g_object_unref (compressor);
-	  g_object_unref (out);
-	  g_object_unref (out2);
+            }
+        }
 
-	  data->flags |= G_RESOURCE_FLAGS_COMPRESSED;
-	}
+      data = g_new0 (FileData, 1);
+      data->filename = g_steal_pointer (&real_file);
+      data->preprocess = preprocess;
+      data->compression = state->compression;
 
-done:
-      g_hash_table_insert (state->table, key, data);
-      data = NULL;
+      g_hash_table_insert (state->table, g_steal_pointer (&key), data);
+      g_ptr_array_add (state->files, data);
 
     cleanup:
       /* Cleanup */
@@ -510,15 +449,7 @@ done:
       state->preproc_options = NULL;
 
       g_free (real_file);
-
-      if (tmp_file)
-        {
-          unlink (tmp_file);
-          g_free (tmp_file);
-        }
-
-      if (data != NULL)
-        file_data_free (data);
+      g_free (key);
     }
 }
 
@@ -547,6 +478,321 @@ text (GMarkupParseContext  *context,
       }
 }
 
+/* Runs one preprocessing @step over *@input, and replaces *@input by the
+ * temporary file holding the result */
+static gboolean
+preprocess_step (PreprocessFlags   step,
+                 gchar           **input,
+                 gboolean         *input_is_tmp,
+                 GError          **error)
+{
+  const gchar *argv[7] = { NULL, };
+  GSubprocess *proc;
+  gchar *output;
+  int fd;
+
+  fd = g_file_open_tmp ("resource-XXXXXXXX", &output, error);
+  if (fd < 0)
+    return FALSE;
+
+  close (fd);
+
+  switch (step)
+    {
+    case PREPROCESS_XML_STRIPBLANKS:
+      argv[0] = xmllint;
+      argv[1] = "--nonet";
+      argv[2] = "--noblanks";
+      argv[3] = "--output";
+      argv[4] = output;
+      argv[5] = *input;
+      break;
+    case PREPROCESS_JSON_STRIPBLANKS:
+      argv[0] = jsonformat;
+      argv[1] = "--output";
+      argv[2] = output;
+      argv[3] = *input;
+      break;
+    case PREPROCESS_TO_PIXDATA:
+      argv[0] = gdk_pixbuf_pixdata;
+      argv[1] = *input;
+      argv[2] = output;
+      break;
+    default:
+      g_assert_not_reached ();
+    }
+
+  proc = g_subprocess_newv (argv, G_SUBPROCESS_FLAGS_STDOUT_SILENCE, error);
+  if (proc == NULL || !g_subprocess_wait_check (proc, NULL, error))
+    {
+      g_clear_object (&proc);
+      g_unlink (output);
+      g_free (output);
+      return FALSE;
+    }
+
+  g_object_unref (proc);
+
+  if (*input_is_tmp)
+    g_unlink (*input);
+  g_free (*input);
+  *input = output;
+  *input_is_tmp = TRUE;
+
+  return TRUE;
+}
+
+/* Reads the source file of @data, and computes the checksum which
+ * identifies its processed contents. Runs on the thread pool. */
+static void
+checksum_file (gpointer job_data,
+               gpointer user_data)
+{
+  FileData *data = job_data;
+  GError *my_error = NULL;
+  GChecksum *checksum;
+  guint32 options[3];
+  gchar *content;
+  gsize size;
+
+  if (!g_file_get_contents (data->filename, &content, &size, &my_error))
+    {
+      g_set_error (&data->error, G_IO_ERROR, G_IO_ERROR_FAILED,
+                   _("Error reading file %s: %s"),
+                   data->filename, my_error->message);
+      g_clear_error (&my_error);
+      return;
+    }
+
+  /* Bump the version whenever the processing of the files changes, so
+   * that stale entries in the cache directory are not used */
+  options[0] = GUINT32_TO_LE (1);
+  options[1] = GUINT32_TO_LE (data->preprocess);
+  options[2] = GUINT32_TO_LE (data->compression);
+
+  checksum = g_checksum_new (G_CHECKSUM_SHA256);
+  g_checksum_update (checksum, (const guchar *) options, sizeof (options));
+  g_checksum_update (checksum, (const guchar *) content, size);
+  data->checksum = g_strdup (g_checksum_get_string (checksum));
+  g_checksum_free (checksum);
+
+  if (data->preprocess == 0)
+    {
+      data->content = content;
+      data->size = size;
+    }
+  else
+    g_free (content);
+}
+
+/* Preprocesses and compresses the file of @data into its resource entry,
+ * unless the entry is found in the cache directory. Runs on the thread
+ * pool. */
+static void
+process_file (gpointer job_data,
+              gpointer user_data)
+{
+  FileData *data = job_data;
+  GError *my_error = NULL;
+  gchar *cache_file = NULL;
+  gchar *content;
+  gsize content_size, size;
+  GVariant *value;
+
+  if (cache_dir != NULL)
+    {
+      cache_file = g_build_filename (cache_dir, data->checksum, NULL);
+
+      if (g_file_get_contents (cache_file, &content, &content_size, NULL))
+        {
+          value = g_variant_new_from_data (G_VARIANT_TYPE ("(uuay)"),
+                                           content, content_size, FALSE,
+                                           g_free, content);
+          data->value = g_variant_ref_sink (value);
+          g_clear_pointer (&data->content, g_free);
+          g_free (cache_file);
+          return;
+        }
+    }
+
+  if (data->preprocess != 0)
+    {
+      const PreprocessFlags steps[] = {
+        PREPROCESS_XML_STRIPBLANKS,
+        PREPROCESS_JSON_STRIPBLANKS,
+        PREPROCESS_TO_PIXDATA,
+      };
+      gchar *input = g_strdup (data->filename);
+      gboolean input_is_tmp = FALSE;
+      gboolean success = TRUE;
+      gsize i;
+
+      for (i = 0; i < G_N_ELEMENTS (steps) && success; i++)
+        if (data->preprocess & steps[i])
+          success = preprocess_step (steps[i], &input, &input_is_tmp, &data->error);
+
+      if (success &&
+          !g_file_get_contents (input, &data->content, &data->size, &my_error))
+        {
+          g_set_error (&data->error, G_IO_ERROR, G_IO_ERROR_FAILED,
+                       _("Error reading file %s: %s"),
+                       input, my_error->message);
+          g_clear_error (&my_error);
+        }
+
+      if (input_is_tmp)
+        g_unlink (input);
+      g_free (input);
+
+      if (data->error != NULL)
+        {
+          g_free (cache_file);
+          return;
+        }
+    }
+
+  content = g_steal_pointer (&data->content);
+  size = data->size;
+  /* Include zero termination in content_size for uncompressed files (but not in size) */
+  content_size = size + 1;
+
+  if (data->compression != G_RESOURCE_FLAGS_NONE)
+    {
+      GOutputStream *out = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+      GConverter *compressor;
+      GOutputStream *out2;
+
+      if (data->compression == G_RESOURCE_FLAGS_COMPRESSED_ZSTD)
+        compressor = G_CONVERTER (g_zstd_compressor_new (19, NULL));
+      else
+        compressor = G_CONVERTER (g_zlib_compressor_new (G_ZLIB_COMPRESSOR_FORMAT_ZLIB, 9));
+      out2 = g_converter_output_stream_new (out, compressor);
+
+      if (!g_output_stream_write_all (out2, content, size,
+                                      NULL, NULL, &my_error) ||
+          !g_output_stream_close (out2, NULL, &my_error))
+        {
+          g_set_error (&data->error, G_IO_ERROR, G_IO_ERROR_FAILED,
+                       _("Error compressing file %s: %s"),
+                       data->filename, my_error->message);
+          g_clear_error (&my_error);
+          g_object_unref (compressor);
+          g_object_unref (out);
+          g_object_unref (out2);
+          g_free (content);
+          g_free (cache_file);
+          return;
+        }
+
+      g_free (content);
+      content_size = g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (out));
+      content = g_memory_output_stream_steal_data (G_MEMORY_OUTPUT_STREAM (out));
+
+      g_object_unref (compressor);
+      g_object_unref (out);
+      g_object_unref (out2);
+    }
+
+  value = g_variant_new ("(uu@ay)",
+                         (guint32) size, /* Size */
+                         (guint32) data->compression, /* Flags */
+                         g_variant_new_from_data (G_VARIANT_TYPE_BYTESTRING,
+                                                  content, content_size, TRUE,
+                                                  g_free, content));
+  data->value = g_variant_ref_sink (value);
+
+  /* Failing to fill the cache is not an error; g_file_set_contents()
+   * renames the file into place, so concurrent builds sharing the
+   * cache directory only ever see complete entries */
+  if (cache_file != NULL)
+    g_file_set_contents (cache_file,
+                         g_variant_get_data (data->value),
+                         g_variant_get_size (data->value),
+                         NULL);
+
+  g_free (cache_file);
+}
+
+static void
+run_jobs (GPtrArray *files,
+          GFunc      func)
+{
+  GThreadPool *pool;
+  guint i;
+
+  pool = g_thread_pool_new (func, NULL,
+                            n_jobs > 0 ? n_jobs : (gint) g_get_num_processors (),
+                            FALSE, NULL);
+
+  for (i = 0; i < files->len; i++)
+    {
+      FileData *data = g_ptr_array_index (files, i);
+
+      if (data->duplicate_of == NULL && data->error == NULL)
+        g_thread_pool_push (pool, data, NULL);
+    }
+
+  g_thread_pool_free (pool, FALSE, TRUE);
+}
+
+static gboolean
+propagate_file_error (GPtrArray  *files,
+                      GError    **error)
+{
+  guint i;
+
+  /* Report the first failure in document order, regardless of the order
+   * in which the jobs finished */
+  for (i = 0; i < files->len; i++)
+    {
+      FileData *data = g_ptr_array_index (files, i);
+
+      if (data->error != NULL)
+        {
+          g_propagate_error (error, g_steal_pointer (&data->error));
+          return FALSE;
+        }
+    }
+
+  return TRUE;
+}
+
+/* Computes the resource entries of all @files. Files are read, then
+ * preprocessed and compressed, on a thread pool. Files with the same
+ * contents and options are only processed once, and share their entry. */
+static gboolean
+process_files (GPtrArray  *files,
+               GError    **error)
+{
+  GHashTable *checksums;
+  guint i;
+
+  run_jobs (files, checksum_file);
+  if (!propagate_file_error (files, error))
+    return FALSE;
+
+  checksums = g_hash_table_new (g_str_hash, g_str_equal);
+  for (i = 0; i < files->len; i++)
+    {
+      FileData *data = g_ptr_array_index (files, i);
+      FileData *first;
+
+      first = g_hash_table_lookup (checksums, data->checksum);
+      if (first != NULL)
+        {
+          data->duplicate_of = first;
+          g_clear_pointer (&data->content, g_free);
+        }
+      else
+        g_hash_table_insert (checksums, data->checksum, data);
+    }
+  g_hash_table_unref (checksums);
+
+  run_jobs (files, process_file);
+
+  return propagate_file_error (files, error);
+}
+
 static GHashTable *
 parse_resource_file (const gchar *filename,
                      gboolean     collect_data,
@@ -569,6 +815,7 @@ parse_resource_file (const gchar *filename,
 
   state.collect_data = collect_data;
   state.table = g_hash_table_ref (files);
+  state.files = g_ptr_array_new ();
 
   context = g_markup_parse_context_new (&parser,
 					G_MARKUP_TREAT_CDATA_AS_TEXT |
@@ -581,6 +828,11 @@ parse_resource_file (const gchar *filename,
       g_printerr ("%s: %s.\n", filename, error->message);
       g_clear_error (&error);
     }
+  else if (collect_data && !process_files (state.files, &error))
+    {
+      g_printerr ("%s: %s.\n", filename, error->message);
+      g_clear_error (&error);
+    }
   else
     {
       GHashTableIter iter;
@@ -588,8 +840,6 @@ parse_resource_file (const gchar *filename,
       char *mykey;
       gsize key_len;
       FileData *data;
-      GVariant *v_data;
-      GVariantBuilder builder;
       GvdbItem *item;
 
       table = gvdb_hash_table_new (NULL, NULL);
@@ -606,22 +856,21 @@ parse_resource_file (const gchar *filename,
 
 	  g_free (mykey);
 
-	  g_variant_builder_init (&builder, G_VARIANT_TYPE ("(uuay)"));
+	  if (data->duplicate_of != NULL)
+	    data = data->duplicate_of;
 
-	  g_variant_builder_add (&builder, "u", data->size); /* Size */
-	  g_variant_builder_add (&builder, "u", data->flags); /* Flags */
-
-	  v_data = g_variant_new_from_data (G_VARIANT_TYPE("ay"),
-					    data->content, data->content_size, TRUE,
-					    g_free, data->content);
-	  g_variant_builder_add_value (&builder, v_data);
-	  data->content = NULL; /* Take ownership */
-
-	  gvdb_item_set_value (item,
-			       g_variant_builder_end (&builder));
+	  if (data->value != NULL)
+	    gvdb_item_set_value (item, data->value);
+	  else
+	    gvdb_item_set_value (item,
+				 g_variant_new ("(uu@ay)", 0, 0,
+						g_variant_new_from_data (G_VARIANT_TYPE_BYTESTRING,
+									 NULL, 0, TRUE,
+									 NULL, NULL)));
 	}
     }
 
+  g_ptr_array_unref (state.files);
   g_hash_table_unref (state.table);
   g_markup_parse_context_free (context);
   g_free (contents);
@@ -832,6 +1081,8 @@ main (int argc, char **argv)
     { "external-data", 0, 0, G_OPTION_ARG_NONE, &external_data, N_("Don’t embed resource data in the C file; assume it's linked externally instead"), NULL },
     { "c-name", 0, 0, G_OPTION_ARG_STRING, &c_name, N_("C identifier name used for the generated source code"), N_("IDENTIFIER") },
     { "compiler", 'C', 0, G_OPTION_ARG_STRING, &compiler, N_("The target C compiler (default: the CC environment variable)"), N_("COMMAND") },
+    { "cache-dir", 0, 0, G_OPTION_ARG_FILENAME, &cache_dir, N_("Directory in which to keep processed files for later runs"), N_("DIRECTORY") },
+    { "jobs", 'j', 0, G_OPTION_ARG_INT, &n_jobs, N_("Number of files to process in parallel (default: number of processors)"), N_("N") },
     G_OPTION_ENTRY_NULL
   };
 
@@ -919,6 +1170,16 @@ main (int argc, char **argv)
   if (gdk_pixbuf_pixdata == NULL)
     gdk_pixbuf_pixdata = g_find_program_in_path ("gdk-pixbuf-pixdata");
 
+  if (cache_dir != NULL && g_mkdir_with_parents (cache_dir, 0755) != 0)
+    {
+      int errsv = errno;
+
+      g_printerr (_("Failed to create cache directory “%s”: %s\n"),
+                  cache_dir, g_strerror (errsv));
+      g_free (c_name);
+      return 1;
+    }
+
   if (target == NULL)
     {
       char *dirname = g_path_get_dirname (srcfile);
@@ -1326,6 +1587,7 @@ main (int argc, char **argv)
   g_hash_table_destroy (table);
   g_free (xmllint);
   g_free (jsonformat);
+  g_free (cache_dir);
   g_free (c_name);
   g_hash_table_unref (files);
 
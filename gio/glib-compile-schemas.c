@@ -1765,15 +1765,177 @@ write_to_file (GHashTable   *schema_table,
   return success;
 }
 
+/* Input files {{{1 */
+typedef struct
+{
+  const gchar *filename;
+  gchar       *contents;
+  gsize        size;
+  gchar       *checksum;  /* of the contents */
+  GError      *error;
+} InputFile;
+
+static void
+input_file_clear (InputFile *file)
+{
+  g_free (file->contents);
+  g_free (file->checksum);
+  g_clear_error (&file->error);
+}
+
+static void
+read_input_file (gpointer data,
+                 gpointer user_data)
+{
+  InputFile *file = data;
+
+  if (g_file_get_contents (file->filename, &file->contents, &file->size, &file->error))
+    file->checksum = g_compute_checksum_for_data (G_CHECKSUM_SHA256,
+                                                  (const guchar *) file->contents,
+                                                  file->size);
+}
+
+/* Reads all of @files, in parallel, into a new array of InputFiles in
+ * the same order.  Read errors are stored in the InputFiles, and are
+ * reported by the caller when it processes each file. */
+static InputFile *
+read_input_files (gchar **files,
+                  gsize  *n_files)
+{
+  GThreadPool *pool;
+  InputFile *inputs;
+  gsize i, n;
+
+  n = files ? g_strv_length (files) : 0;
+  inputs = g_new0 (InputFile, n);
+
+  pool = g_thread_pool_new (read_input_file, NULL, g_get_num_processors (), FALSE, NULL);
+  for (i = 0; i < n; i++)
+    {
+      inputs[i].filename = files[i];
+      g_thread_pool_push (pool, &inputs[i], NULL);
+    }
+  g_thread_pool_free (pool, FALSE, TRUE);
+
+  *n_files = n;
+
+  return inputs;
+}
+
+static void
+free_input_files (InputFile *inputs,
+                  gsize      n_files)
+{
+  gsize i;
+
+  for (i = 0; i < n_files; i++)
+    input_file_clear (&inputs[i]);
+  g_free (inputs);
+}
+
+/* The fingerprint of a compilation covers everything the output depends
+ * on: the version of this program, the options, and the names and
+ * contents of all the input files.  It is stored in a file next to the
+ * output, together with the size and modification time of the output
+ * so that a modified or replaced output file is never mistaken for an
+ * up to date one. */
+static gchar *
+compute_fingerprint (InputFile *schemas,
+                     gsize      n_schemas,
+                     InputFile *overrides,
+                     gsize      n_overrides,
+                     gboolean   strict)
+{
+  GChecksum *checksum;
+  gchar *fingerprint;
+  gsize i;
+
+  checksum = g_checksum_new (G_CHECKSUM_SHA256);
+  g_checksum_update (checksum, (const guchar *) PACKAGE_VERSION, -1);
+  g_checksum_update (checksum, (const guchar *) (strict ? "s" : "-"), 1);
+  g_checksum_update (checksum, (const guchar *) (allow_any_name ? "a" : "-"), 1);
+
+  for (i = 0; i < n_schemas + n_overrides; i++)
+    {
+      InputFile *file = i < n_schemas ? &schemas[i] : &overrides[i - n_schemas];
+
+      g_checksum_update (checksum, (const guchar *) (i < n_schemas ? "S" : "O"), 1);
+      g_checksum_update (checksum, (const guchar *) file->filename, strlen (file->filename) + 1);
+      if (file->checksum != NULL)
+        g_checksum_update (checksum, (const guchar *) file->checksum, -1);
+    }
+
+  fingerprint = g_strdup (g_checksum_get_string (checksum));
+  g_checksum_free (checksum);
+
+  return fingerprint;
+}
+
+static gchar *
+get_stamp_contents (const gchar *target,
+                    const gchar *fingerprint)
+{
+  GStatBuf buf;
+
+  if (g_stat (target, &buf) != 0)
+    return NULL;
+
+  return g_strdup_printf ("%s %" G_GINT64_FORMAT " %" G_GINT64_FORMAT "\n",
+                          fingerprint, (gint64) buf.st_size, (gint64) buf.st_mtime);
+}
+
+static gboolean
+is_up_to_date (const gchar *target,
+               const gchar *stamp,
+               const gchar *fingerprint)
+{
+  gchar *expected, *contents = NULL;
+  gboolean up_to_date;
+
+  expected = get_stamp_contents (target, fingerprint);
+  up_to_date = expected != NULL &&
+               g_file_get_contents (stamp, &contents, NULL, NULL) &&
+               strcmp (contents, expected) == 0;
+
+  g_free (expected);
+  g_free (contents);
+
+  return up_to_date;
+}
+
+static void
+write_stamp (const gchar *target,
+             const gchar *stamp,
+             const gchar *fingerprint)
+{
+  GError *error = NULL;
+  gchar *contents;
+
+  contents = get_stamp_contents (target, fingerprint);
+
+  /* Not fatal: the next run with --incremental just does all the work */
+  if (contents == NULL ||
+      !g_file_set_contents (stamp, contents, -1, &error))
+    {
+      if (error != NULL)
+        fprintf (stderr, "%s\n", error->message);
+      g_clear_error (&error);
+      g_unlink (stamp);
+    }
+
+  g_free (contents);
+}
+
 /* Parser driver {{{1 */
 static GHashTable *
-parse_gschema_files (gchar    **files,
+parse_gschema_files (InputFile *files,
+                     gsize      n_files,
                      gboolean   strict)
 {
   GMarkupParser parser = { start_element, end_element, text, NULL, NULL };
   ParseState state = { 0, };
-  const gchar *filename;
   GError *error = NULL;
+  gsize i;
 
   state.strict = strict;
 
@@ -1786,17 +1948,17 @@ parse_gschema_files (gchar    **files,
   state.schema_table = g_hash_table_new_full (g_str_hash, g_str_equal,
                                               g_free, schema_state_free);
 
-  while ((filename = *files++) != NULL)
+  for (i = 0; i < n_files; i++)
     {
       GMarkupParseContext *context;
-      gchar *contents;
-      gsize size;
+      const gchar *filename = files[i].filename;
+      const gchar *contents = files[i].contents;
+      gsize size = files[i].size;
       gint line, col;
 
-      if (!g_file_get_contents (filename, &contents, &size, &error))
+      if (files[i].error != NULL)
         {
-          fprintf (stderr, "%s\n", error->message);
-          g_clear_error (&error);
+          fprintf (stderr, "%s\n", files[i].error->message);
           continue;
         }
 
@@ -1836,8 +1998,6 @@ parse_gschema_files (gchar    **files,
               g_hash_table_unref (state.flags_table);
               g_hash_table_unref (state.enum_table);
 
-              g_free (contents);
-
               return NULL;
             }
           else
@@ -1847,7 +2007,6 @@ parse_gschema_files (gchar    **files,
         }
 
       /* cleanup */
-      g_free (contents);
       g_markup_parse_context_free (context);
       g_slist_free (state.this_file_schemas);
       g_slist_free (state.this_file_flagss);
@@ -2164,8 +2323,15 @@ main (int argc, char **argv)
   gchar *target = NULL;
   gboolean dry_run = FALSE;
   gboolean strict = FALSE;
+  gboolean incremental = FALSE;
   gchar **schema_files = NULL;
   gchar **override_files = NULL;
+  InputFile *schema_inputs = NULL;
+  InputFile *override_inputs = NULL;
+  gsize n_schema_inputs = 0;
+  gsize n_override_inputs = 0;
+  gchar *stamp = NULL;
+  gchar *fingerprint = NULL;
   GOptionContext *context = NULL;
   gint retval;
   GOptionEntry entries[] = {
@@ -2174,6 +2340,7 @@ main (int argc, char **argv)
     { "strict", 0, 0, G_OPTION_ARG_NONE, &strict, N_("Abort on any errors in schemas"), NULL },
     { "dry-run", 0, 0, G_OPTION_ARG_NONE, &dry_run, N_("Do not write the gschema.compiled file"), NULL },
     { "allow-any-name", 0, 0, G_OPTION_ARG_NONE, &allow_any_name, N_("Do not enforce key name restrictions"), NULL },
+    { "incremental", 0, 0, G_OPTION_ARG_NONE, &incremental, N_("Do nothing if no schema or override file changed since the last run with this option"), NULL },
 
     /* These options are only for use in the gschema-compile tests */
     { "schema-file", 0, G_OPTION_FLAG_HIDDEN, G_OPTION_ARG_FILENAME_ARRAY, &schema_files, NULL, NULL },
@@ -2302,7 +2469,25 @@ main (int argc, char **argv)
       override_files = (gchar **) g_ptr_array_free (overrides, FALSE);
     }
 
-  if ((table = parse_gschema_files (schema_files, strict)) == NULL)
+  schema_inputs = read_input_files (schema_files, &n_schema_inputs);
+
+  if (incremental && !dry_run)
+    {
+      override_inputs = read_input_files (override_files, &n_override_inputs);
+      fingerprint = compute_fingerprint (schema_inputs, n_schema_inputs,
+                                         override_inputs, n_override_inputs,
+                                         strict);
+      stamp = g_strconcat (target, ".stamp", NULL);
+
+      if (is_up_to_date (target, stamp, fingerprint))
+        {
+          g_debug ("%s is up to date", target);
+          retval = 0;
+          goto done;
+        }
+    }
+
+  if ((table = parse_gschema_files (schema_inputs, n_schema_inputs, strict)) == NULL)
     {
       retval = 1;
       goto done;
@@ -2322,6 +2507,9 @@ main (int argc, char **argv)
       goto done;
     }
 
+  if (stamp != NULL)
+    write_stamp (target, stamp, fingerprint);
+
   /* Success. */
   retval = 0;
 
@@ -2331,6 +2519,10 @@ done:
   g_clear_pointer (&dir, g_dir_close);
   g_free (targetdir);
   g_free (target);
+  g_free (stamp);
+  g_free (fingerprint);
+  free_input_files (schema_inputs, n_schema_inputs);
+  free_input_files (override_inputs, n_override_inputs);
   g_strfreev (schema_files);
   g_strfreev (override_files);
   g_option_context_free (context);
@@ -105,6 +105,9 @@ G_DEFINE_INTERFACE (GListModel, g_list_model, G_TYPE_OBJECT)
  * @get_item_type: the virtual function pointer for g_list_model_get_item_type()
  * @get_n_items: the virtual function pointer for g_list_model_get_n_items()
  * @get_item: the virtual function pointer for g_list_model_get_item()
+ * @get_items: the virtual function pointer for g_list_model_get_items();
+ *   it is optional, and implemented by calling @get_item repeatedly if
+ *   not overridden. Since: 2.82
  *
  * The virtual function table for #GListModel.
  *
@@ -129,11 +132,79 @@ G_DEFINE_INTERFACE (GListModel, g_list_model, G_TYPE_OBJECT)
  * Since: 2.44
  */
 
+/**
+ * GListModelInterface::get_items:
+ * @list: a #GListModel
+ * @position: the position of the first item to fetch
+ * @n_items: the maximum number of items to fetch
+ * @items: (array length=n_items) (out caller-allocates): return location
+ *   for the items
+ *
+ * Stores up to @n_items items, starting at @position, into @items, and
+ * returns how many were stored. Fewer than @n_items are only returned
+ * if the end of the list is reached.
+ *
+ * Returns: the number of items stored in @items
+ *
+ * Since: 2.82
+ */
+
 static guint g_list_model_changed_signal;
 
+/* A pending change, in the coordinates of the list as it was when
+ * g_list_model_freeze_items_changed() was first called */
+typedef struct
+{
+  guint position;
+  guint removed;
+  guint added;
+} ItemsChange;
+
+typedef struct
+{
+  guint freeze_count;
+
+  /* (element-type ItemsChange): sorted, disjoint and not adjacent */
+  GArray *changes;
+} ItemsChangedFreeze;
+
+static GQuark items_changed_freeze_quark;
+
+static void
+items_changed_freeze_free (gpointer data)
+{
+  ItemsChangedFreeze *freeze = data;
+
+  g_array_unref (freeze->changes);
+  g_free (freeze);
+}
+
+static guint
+g_list_model_real_get_items (GListModel *list,
+                             guint       position,
+                             guint       n_items,
+                             gpointer   *items)
+{
+  GListModelInterface *iface = G_LIST_MODEL_GET_IFACE (list);
+  guint i;
+
+  for (i = 0; i < n_items; i++)
+    {
+      if (position + i < position ||
+          (items[i] = iface->get_item (list, position + i)) == NULL)
+        break;
+    }
+
+  return i;
+}
+
 static void
 g_list_model_default_init (GListModelInterface *iface)
 {
+  iface->get_items = g_list_model_real_get_items;
+
+  items_changed_freeze_quark = g_quark_from_static_string ("g-list-model-items-changed-freeze");
+
   /**
    * GListModel::items-changed:
    * @list: the #GListModel that changed
@@ -238,6 +309,43 @@ g_list_model_get_item (GListModel *list,
   return G_LIST_MODEL_GET_IFACE (list)->get_item (list, position);
 }
 
+/**
+ * g_list_model_get_items: (skip)
+ * @list: a #GListModel
+ * @position: the position of the first item to fetch
+ * @n_items: the maximum number of items to fetch
+ * @items: (array length=n_items) (out caller-allocates): return location
+ *   for the items
+ *
+ * Gets up to @n_items consecutive items, starting at @position.
+ *
+ * This is equivalent to calling g_list_model_get_item() for each of the
+ * positions, but implementations can provide a faster way to retrieve
+ * many items at once than through a function call per item.
+ *
+ * A reference is returned for every stored item, which must be released
+ * with g_object_unref() when no longer needed. Fewer than @n_items items
+ * are only stored if the end of the list is reached.
+ *
+ * Returns: the number of items stored in @items
+ *
+ * Since: 2.82
+ */
+guint
+g_list_model_get_items (GListModel *list,
+                        guint       position,
+                        guint       n_items,
+                        gpointer   *items)
+{
+  g_return_val_if_fail (G_IS_LIST_MODEL (list), 0);
+  g_return_val_if_fail (items != NULL || n_items == 0, 0);
+
+  if (n_items == 0)
+    return 0;
+
+  return G_LIST_MODEL_GET_IFACE (list)->get_items (list, position, n_items, items);
+}
+
 /**
  * g_list_model_get_object: (rename-to g_list_model_get_item)
  * @list: a #GListModel
@@ -273,6 +381,72 @@ g_list_model_get_object (GListModel *list,
   return G_OBJECT (item);
 }
 
+/* Records into @freeze that @removed items at @position, in the current
+ * coordinates of the list, were replaced by @added items.
+ *
+ * The pending changes map the list as it was when frozen to its current
+ * contents; the new change is merged with every pending change whose
+ * range of added items it overlaps or touches, and the others are left
+ * alone.
+ */
+static void
+items_changed_freeze_add (ItemsChangedFreeze *freeze,
+                          guint               position,
+                          guint               removed,
+                          guint               added)
+{
+  GArray *changes = freeze->changes;
+  gint64 start = position, end = (gint64) position + removed;
+  gint64 shift_before = 0, shift_merged = 0;
+  guint first, last;
+  ItemsChange merged;
+
+  if (removed == 0 && added == 0)
+    return;
+
+  /* Skip the changes that end before the new one starts */
+  for (first = 0; first < changes->len; first++)
+    {
+      const ItemsChange *change = &g_array_index (changes, ItemsChange, first);
+      gint64 change_end = change->position + shift_before + change->added;
+
+      if (change_end >= start)
+        break;
+
+      shift_before += (gint64) change->added - change->removed;
+    }
+
+  /* …and merge the ones that overlap it or touch it */
+  for (last = first; last < changes->len; last++)
+    {
+      const ItemsChange *change = &g_array_index (changes, ItemsChange, last);
+      gint64 change_start = change->position + shift_before + shift_merged;
+      gint64 change_end = change_start + change->added;
+
+      if (change_start > end)
+        break;
+
+      start = MIN (start, change_start);
+      end = MAX (end, change_end);
+      shift_merged += (gint64) change->added - change->removed;
+    }
+
+  /* The merged range spans [start, end) in the current list; in the
+   * original list, it starts before all the merged changes' shifts */
+  merged.position = (guint) (start - shift_before);
+  merged.removed = (guint) (end - start - shift_merged);
+  merged.added = (guint) (end - start - removed + added);
+
+  /* The changes are kept in the original coordinates, so the ones after
+   * the merged range need no adjustment */
+  if (last > first)
+    g_array_remove_range (changes, first, last - first);
+
+  /* An insertion removed again cancels out */
+  if (merged.removed > 0 || merged.added > 0)
+    g_array_insert_val (changes, first, merged);
+}
+
 /**
  * g_list_model_items_changed:
  * @list: a #GListModel
@@ -301,6 +475,10 @@ g_list_model_get_object (GListModel *list,
  * mainloop, and without calling other code, will continue to view the
  * same contents of the model.
  *
+ * While the signal is frozen with g_list_model_freeze_items_changed(),
+ * the change is recorded and emitted, together with the other ones, by
+ * g_list_model_thaw_items_changed().
+ *
  * Since: 2.44
  */
 void
@@ -309,7 +487,110 @@ g_list_model_items_changed (GListModel *list,
                             guint       removed,
                             guint       added)
 {
+  ItemsChangedFreeze *freeze;
+
   g_return_if_fail (G_IS_LIST_MODEL (list));
 
+  freeze = g_object_get_qdata (G_OBJECT (list), items_changed_freeze_quark);
+  if (freeze != NULL && freeze->freeze_count > 0)
+    {
+      items_changed_freeze_add (freeze, position, removed, added);
+      return;
+    }
+
   g_signal_emit (list, g_list_model_changed_signal, 0, position, removed, added);
 }
+
+/**
+ * g_list_model_freeze_items_changed:
+ * @list: a #GListModel
+ *
+ * Increases the freeze count on @list, stopping the emission of the
+ * #GListModel::items-changed signal.
+ *
+ * The changes reported with g_list_model_items_changed() while @list is
+ * frozen are recorded, and once the freeze count drops back to zero in
+ * g_list_model_thaw_items_changed(), they are emitted as the smallest set
+ * of signals describing them: overlapping and adjacent changes are
+ * merged into one, so that, for instance, a sequence of single item
+ * insertions at consecutive positions results in a single emission.
+ *
+ * This is useful for implementations, or their users, that make many
+ * changes at once and want to avoid consumers reacting to each of them.
+ * Keep in mind that until the model is thawed, its consumers see a list
+ * that no longer matches its contents, so the model should not be
+ * accessed by them in the meantime.
+ *
+ * Since: 2.82
+ */
+void
+g_list_model_freeze_items_changed (GListModel *list)
+{
+  ItemsChangedFreeze *freeze;
+
+  g_return_if_fail (G_IS_LIST_MODEL (list));
+
+  freeze = g_object_get_qdata (G_OBJECT (list), items_changed_freeze_quark);
+  if (freeze == NULL)
+    {
+      freeze = g_new0 (ItemsChangedFreeze, 1);
+      freeze->changes = g_array_new (FALSE, FALSE, sizeof (ItemsChange));
+      g_object_set_qdata_full (G_OBJECT (list), items_changed_freeze_quark,
+                               freeze, items_changed_freeze_free);
+    }
+
+  g_return_if_fail (freeze->freeze_count < G_MAXUINT);
+
+  freeze->freeze_count++;
+}
+
+/**
+ * g_list_model_thaw_items_changed:
+ * @list: a #GListModel
+ *
+ * Reverts the effect of a previous call to
+ * g_list_model_freeze_items_changed().
+ *
+ * When the freeze count drops to zero, the changes recorded in the
+ * meantime are emitted, in order of position.
+ *
+ * Since: 2.82
+ */
+void
+g_list_model_thaw_items_changed (GListModel *list)
+{
+  ItemsChangedFreeze *freeze;
+  GArray *changes;
+  gint64 shift = 0;
+  guint i;
+
+  g_return_if_fail (G_IS_LIST_MODEL (list));
+
+  freeze = g_object_get_qdata (G_OBJECT (list), items_changed_freeze_quark);
+
+  g_return_if_fail (freeze != NULL && freeze->freeze_count > 0);
+
+  if (--freeze->freeze_count > 0 || freeze->changes->len == 0)
+    return;
+
+  /* Handlers may freeze the model again, so emit from a private copy */
+  changes = g_steal_pointer (&freeze->changes);
+  freeze->changes = g_array_new (FALSE, FALSE, sizeof (ItemsChange));
+
+  g_object_ref (list);
+
+  /* Each change shifts the ones after it by the difference between the
+   * items it added and removed */
+  for (i = 0; i < changes->len; i++)
+    {
+      const ItemsChange *change = &g_array_index (changes, ItemsChange, i);
+
+      g_signal_emit (list, g_list_model_changed_signal, 0,
+                     (guint) (change->position + shift),
+                     change->removed, change->added);
+      shift += (gint64) change->added - change->removed;
+    }
+
+  g_object_unref (list);
+  g_array_unref (changes);
+}
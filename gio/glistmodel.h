@@ -47,6 +47,11 @@ struct _GListModelInterface
 
   gpointer  (* get_item)        (GListModel *list,
                                  guint       position);
+
+  guint     (* get_items)       (GListModel *list,
+                                 guint       position,
+                                 guint       n_items,
+                                 gpointer   *items);
 };
 
 GIO_AVAILABLE_IN_2_44
@@ -63,12 +68,23 @@ GIO_AVAILABLE_IN_2_44
 GObject *               g_list_model_get_object                         (GListModel *list,
                                                                          guint       position);
 
+GIO_AVAILABLE_IN_2_82
+guint                   g_list_model_get_items                          (GListModel *list,
+                                                                         guint       position,
+                                                                         guint       n_items,
+                                                                         gpointer   *items);
+
 GIO_AVAILABLE_IN_2_44
 void                    g_list_model_items_changed                      (GListModel *list,
                                                                          guint       position,
                                                                          guint       removed,
                                                                          guint       added);
 
+GIO_AVAILABLE_IN_2_82
+void                    g_list_model_freeze_items_changed               (GListModel *list);
+GIO_AVAILABLE_IN_2_82
+void                    g_list_model_thaw_items_changed                 (GListModel *list);
+
 G_END_DECLS
 
 #endif /* __G_LIST_MODEL_H__ */
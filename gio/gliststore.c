@@ -24,6 +24,8 @@
 
 #include "config.h"
 
+#include <string.h>
+
 #include "gliststore.h"
 #include "glistmodel.h"
 
@@ -37,16 +39,58 @@
  * with a fast path for the common case of iterating the list linearly.
  */
 
+/* The items are kept in a B+tree whose branches count the items below each
+ * child, so that positions can be found in logarithmic time, and whose
+ * leaves hold runs of items in arrays and are linked to each other, so
+ * that walking the list is mostly sequential. */
+
+#define ITEM_TREE_LEAF_SIZE 64
+#define ITEM_TREE_BRANCH_SIZE 32
+
+typedef struct _ItemTreeNode ItemTreeNode;
+typedef struct _ItemTreeLeaf ItemTreeLeaf;
+typedef struct _ItemTreeBranch ItemTreeBranch;
+
+struct _ItemTreeNode
+{
+  ItemTreeBranch *parent;
+  guint n_children;  /* items, for a leaf */
+  gboolean is_leaf;
+};
+
+struct _ItemTreeLeaf
+{
+  ItemTreeNode node;
+  ItemTreeLeaf *prev;
+  ItemTreeLeaf *next;
+  gpointer items[ITEM_TREE_LEAF_SIZE];
+};
+
+struct _ItemTreeBranch
+{
+  ItemTreeNode node;
+  guint counts[ITEM_TREE_BRANCH_SIZE];
+  ItemTreeNode *children[ITEM_TREE_BRANCH_SIZE];
+};
+
+typedef struct
+{
+  ItemTreeNode *root;
+  ItemTreeLeaf *first;
+  guint n_items;
+} ItemTree;
+
 struct _GListStore
 {
   GObject parent_instance;
 
   GType item_type;
-  GSequence *items;
+  ItemTree items;
 
   /* cache */
   guint last_position;
-  GSequenceIter *last_iter;
+  ItemTreeLeaf *last_leaf;
+  guint last_index;
   gboolean last_position_valid;
 };
 
@@ -65,19 +109,314 @@ G_DEFINE_TYPE_WITH_CODE (GListStore, g_list_store, G_TYPE_OBJECT,
 
 static GParamSpec *properties[N_PROPERTIES] = { NULL, };
 
+static void
+item_tree_init (ItemTree *tree)
+{
+  ItemTreeLeaf *leaf = g_new0 (ItemTreeLeaf, 1);
+
+  leaf->node.is_leaf = TRUE;
+  tree->root = &leaf->node;
+  tree->first = leaf;
+  tree->n_items = 0;
+}
+
+static void
+item_tree_free_node (ItemTreeNode *node)
+{
+  if (!node->is_leaf)
+    {
+      ItemTreeBranch *branch = (ItemTreeBranch *) node;
+      guint i;
+
+      for (i = 0; i < node->n_children; i++)
+        item_tree_free_node (branch->children[i]);
+    }
+
+  g_free (node);
+}
+
+/* Unrefs all the items; the tree must be initialised again to be reused */
+static void
+item_tree_clear (ItemTree *tree)
+{
+  ItemTreeLeaf *leaf;
+  ItemTreeNode *root = tree->root;
+
+  if (root == NULL)
+    return;
+
+  tree->root = NULL;
+  tree->first = NULL;
+  tree->n_items = 0;
+
+  for (leaf = (ItemTreeLeaf *) root; !leaf->node.is_leaf; )
+    leaf = (ItemTreeLeaf *) ((ItemTreeBranch *) leaf)->children[0];
+
+  for (; leaf != NULL; leaf = leaf->next)
+    {
+      guint i;
+
+      for (i = 0; i < leaf->node.n_children; i++)
+        g_object_unref (leaf->items[i]);
+    }
+
+  item_tree_free_node (root);
+}
+
+/* Finds the leaf holding @position, adding @delta to the counts on the way
+ * down, and turns @position into an index in the leaf. */
+static ItemTreeLeaf *
+item_tree_descend (ItemTree *tree,
+                   guint    *position,
+                   gint      delta)
+{
+  ItemTreeNode *node = tree->root;
+
+  while (!node->is_leaf)
+    {
+      ItemTreeBranch *branch = (ItemTreeBranch *) node;
+      guint i;
+
+      for (i = 0; i + 1 < node->n_children && *position >= branch->counts[i]; i++)
+        *position -= branch->counts[i];
+
+      branch->counts[i] += delta;
+      node = branch->children[i];
+    }
+
+  return (ItemTreeLeaf *) node;
+}
+
+static guint
+item_tree_child_index (ItemTreeBranch *branch,
+                       ItemTreeNode   *child)
+{
+  guint i;
+
+  for (i = 0; branch->children[i] != child; i++)
+    ;
+
+  return i;
+}
+
+/* Puts @sibling after @node in their parent, splitting the parent if it is
+ * full; the parent's counts above must already include the items of both. */
+static void
+item_tree_add_sibling (ItemTree     *tree,
+                       ItemTreeNode *node,
+                       guint         node_count,
+                       ItemTreeNode *sibling,
+                       guint         sibling_count)
+{
+  ItemTreeBranch *parent = node->parent;
+  guint i;
+
+  if (parent == NULL)
+    {
+      parent = g_new0 (ItemTreeBranch, 1);
+      parent->node.n_children = 1;
+      parent->children[0] = node;
+      node->parent = parent;
+      tree->root = &parent->node;
+    }
+
+  if (parent->node.n_children == ITEM_TREE_BRANCH_SIZE)
+    {
+      ItemTreeBranch *other = g_new0 (ItemTreeBranch, 1);
+      guint half = ITEM_TREE_BRANCH_SIZE / 2;
+      guint low = 0, high = 0;
+
+      for (i = 0; i < half; i++)
+        low += parent->counts[i];
+
+      for (i = half; i < ITEM_TREE_BRANCH_SIZE; i++)
+        {
+          other->children[i - half] = parent->children[i];
+          other->counts[i - half] = parent->counts[i];
+          other->children[i - half]->parent = other;
+          high += parent->counts[i];
+        }
+
+      parent->node.n_children = half;
+      other->node.n_children = ITEM_TREE_BRANCH_SIZE - half;
+
+      item_tree_add_sibling (tree, &parent->node, low, &other->node, high);
+      parent = node->parent;
+    }
+
+  i = item_tree_child_index (parent, node);
+  memmove (&parent->children[i + 2], &parent->children[i + 1],
+           (parent->node.n_children - i - 1) * sizeof (ItemTreeNode *));
+  memmove (&parent->counts[i + 2], &parent->counts[i + 1],
+           (parent->node.n_children - i - 1) * sizeof (guint));
+  parent->children[i + 1] = sibling;
+  parent->counts[i] = node_count;
+  parent->counts[i + 1] = sibling_count;
+  parent->node.n_children++;
+  sibling->parent = parent;
+}
+
+/* Takes ownership of @item */
+static void
+item_tree_insert (ItemTree *tree,
+                  guint     position,
+                  gpointer  item)
+{
+  ItemTreeLeaf *leaf;
+  guint index = position;
+
+  leaf = item_tree_descend (tree, &index, 1);
+
+  if (leaf->node.n_children == ITEM_TREE_LEAF_SIZE)
+    {
+      ItemTreeLeaf *other = g_new0 (ItemTreeLeaf, 1);
+      guint half = ITEM_TREE_LEAF_SIZE / 2;
+
+      other->node.is_leaf = TRUE;
+      other->node.n_children = ITEM_TREE_LEAF_SIZE - half;
+      memcpy (other->items, &leaf->items[half], other->node.n_children * sizeof (gpointer));
+      leaf->node.n_children = half;
+
+      other->prev = leaf;
+      other->next = leaf->next;
+      if (leaf->next != NULL)
+        leaf->next->prev = other;
+      leaf->next = other;
+
+      item_tree_add_sibling (tree,
+                             &leaf->node, half + (index <= half ? 1 : 0),
+                             &other->node, other->node.n_children + (index > half ? 1 : 0));
+
+      if (index > half)
+        {
+          index -= half;
+          leaf = other;
+        }
+    }
+
+  memmove (&leaf->items[index + 1], &leaf->items[index],
+           (leaf->node.n_children - index) * sizeof (gpointer));
+  leaf->items[index] = item;
+  leaf->node.n_children++;
+  tree->n_items++;
+}
+
+static void
+item_tree_remove_node (ItemTree     *tree,
+                       ItemTreeNode *node)
+{
+  ItemTreeBranch *parent = node->parent;
+  guint i;
+
+  if (node->is_leaf)
+    {
+      ItemTreeLeaf *leaf = (ItemTreeLeaf *) node;
+
+      if (leaf->prev != NULL)
+        leaf->prev->next = leaf->next;
+      else
+        tree->first = leaf->next;
+      if (leaf->next != NULL)
+        leaf->next->prev = leaf->prev;
+    }
+
+  i = item_tree_child_index (parent, node);
+  g_free (node);
+
+  memmove (&parent->children[i], &parent->children[i + 1],
+           (parent->node.n_children - i - 1) * sizeof (ItemTreeNode *));
+  memmove (&parent->counts[i], &parent->counts[i + 1],
+           (parent->node.n_children - i - 1) * sizeof (guint));
+  parent->node.n_children--;
+
+  if (parent->node.n_children == 0)
+    item_tree_remove_node (tree, &parent->node);
+}
+
+/* Returns the removed item, which the caller then owns */
+static gpointer
+item_tree_remove (ItemTree *tree,
+                  guint     position)
+{
+  ItemTreeLeaf *leaf, *next;
+  gpointer item;
+  guint index = position;
+
+  leaf = item_tree_descend (tree, &index, -1);
+
+  item = leaf->items[index];
+  leaf->node.n_children--;
+  memmove (&leaf->items[index], &leaf->items[index + 1],
+           (leaf->node.n_children - index) * sizeof (gpointer));
+  tree->n_items--;
+
+  /* Keep leaves reasonably full by merging mostly empty neighbours */
+  next = leaf->next;
+  if (next != NULL && next->node.parent == leaf->node.parent &&
+      leaf->node.n_children + next->node.n_children <= ITEM_TREE_LEAF_SIZE / 2)
+    {
+      ItemTreeBranch *parent = leaf->node.parent;
+      guint i = item_tree_child_index (parent, &leaf->node);
+
+      memcpy (&leaf->items[leaf->node.n_children], next->items,
+              next->node.n_children * sizeof (gpointer));
+      leaf->node.n_children += next->node.n_children;
+      parent->counts[i] += parent->counts[i + 1];
+      parent->counts[i + 1] = 0;
+      next->node.n_children = 0;
+    }
+  else if (leaf->node.n_children == 0 && leaf->node.parent != NULL)
+    {
+      next = leaf;
+    }
+  else
+    {
+      next = NULL;
+    }
+
+  if (next != NULL)
+    item_tree_remove_node (tree, &next->node);
+
+  /* Drop branches with a single child from the top */
+  while (!tree->root->is_leaf && tree->root->n_children == 1)
+    {
+      ItemTreeNode *root = ((ItemTreeBranch *) tree->root)->children[0];
+
+      g_free (tree->root);
+      root->parent = NULL;
+      tree->root = root;
+    }
+
+  return item;
+}
+
+static gpointer
+item_tree_get (ItemTree      *tree,
+               guint          position,
+               ItemTreeLeaf **out_leaf,
+               guint         *out_index)
+{
+  ItemTreeLeaf *leaf;
+  guint index = position;
+
+  leaf = item_tree_descend (tree, &index, 0);
+  *out_leaf = leaf;
+  *out_index = index;
+
+  return leaf->items[index];
+}
+
 static void
 g_list_store_items_changed (GListStore *store,
                             guint       position,
                             guint       removed,
                             guint       added)
 {
-  /* check if the iter cache may have been invalidated */
-  if (position <= store->last_position)
-    {
-      store->last_iter = NULL;
-      store->last_position = 0;
-      store->last_position_valid = FALSE;
-    }
+  /* Leaves may have been split or merged anywhere, so always drop the
+   * iteration cache */
+  store->last_leaf = NULL;
+  store->last_position = 0;
+  store->last_position_valid = FALSE;
 
   g_list_model_items_changed (G_LIST_MODEL (store), position, removed, added);
   if (removed != added)
@@ -89,7 +428,7 @@ g_list_store_dispose (GObject *object)
 {
   GListStore *store = G_LIST_STORE (object);
 
-  g_clear_pointer (&store->items, g_sequence_free);
+  item_tree_clear (&store->items);
 
   G_OBJECT_CLASS (g_list_store_parent_class)->dispose (object);
 }
@@ -109,7 +448,7 @@ g_list_store_get_property (GObject    *object,
       break;
 
     case PROP_N_ITEMS:
-      g_value_set_uint (value, g_sequence_get_length (store->items));
+      g_value_set_uint (value, store->items.n_items);
       break;
 
     default:
@@ -185,7 +524,7 @@ g_list_store_get_n_items (GListModel *list)
 {
   GListStore *store = G_LIST_STORE (list);
 
-  return g_sequence_get_length (store->items);
+  return store->items.n_items;
 }
 
 static gpointer
@@ -193,29 +532,79 @@ g_list_store_get_item (GListModel *list,
                        guint       position)
 {
   GListStore *store = G_LIST_STORE (list);
-  GSequenceIter *it = NULL;
+  ItemTreeLeaf *leaf = NULL;
+  guint index = 0;
+
+  if (store->items.root == NULL || position >= store->items.n_items)
+    return NULL;
 
   if (store->last_position_valid)
     {
+      leaf = store->last_leaf;
+      index = store->last_index;
+
       if (position < G_MAXUINT && store->last_position == position + 1)
-        it = g_sequence_iter_prev (store->last_iter);
+        {
+          if (index > 0)
+            index--;
+          else if ((leaf = leaf->prev) != NULL)
+            index = leaf->node.n_children - 1;
+        }
       else if (position > 0 && store->last_position == position - 1)
-        it = g_sequence_iter_next (store->last_iter);
-      else if (store->last_position == position)
-        it = store->last_iter;
+        {
+          if (++index == leaf->node.n_children)
+            {
+              leaf = leaf->next;
+              index = 0;
+            }
+        }
+      else if (store->last_position != position)
+        leaf = NULL;
     }
 
-  if (it == NULL)
-    it = g_sequence_get_iter_at_pos (store->items, position);
+  if (leaf == NULL)
+    item_tree_get (&store->items, position, &leaf, &index);
 
-  store->last_iter = it;
+  store->last_leaf = leaf;
+  store->last_index = index;
   store->last_position = position;
   store->last_position_valid = TRUE;
 
-  if (g_sequence_iter_is_end (it))
-    return NULL;
-  else
-    return g_object_ref (g_sequence_get (it));
+  return g_object_ref (leaf->items[index]);
+}
+
+static guint
+g_list_store_get_items (GListModel *list,
+                        guint       position,
+                        guint       n_items,
+                        gpointer   *items)
+{
+  GListStore *store = G_LIST_STORE (list);
+  ItemTreeLeaf *leaf;
+  guint index, n = 0;
+
+  if (store->items.root == NULL || position >= store->items.n_items)
+    return 0;
+
+  n_items = MIN (n_items, store->items.n_items - position);
+
+  /* Walk the leaves directly, copying a run of items from each */
+  item_tree_get (&store->items, position, &leaf, &index);
+
+  while (n < n_items)
+    {
+      guint run = MIN (leaf->node.n_children - index, n_items - n);
+      guint i;
+
+      for (i = 0; i < run; i++)
+        items[n + i] = g_object_ref (leaf->items[index + i]);
+
+      n += run;
+      leaf = leaf->next;
+      index = 0;
+    }
+
+  return n;
 }
 
 static void
@@ -224,12 +613,13 @@ g_list_store_iface_init (GListModelInterface *iface)
   iface->get_item_type = g_list_store_get_item_type;
   iface->get_n_items = g_list_store_get_n_items;
   iface->get_item = g_list_store_get_item;
+  iface->get_items = g_list_store_get_items;
 }
 
 static void
 g_list_store_init (GListStore *store)
 {
-  store->items = g_sequence_new (g_object_unref);
+  item_tree_init (&store->items);
   store->last_position = 0;
   store->last_position_valid = FALSE;
 }
@@ -279,14 +669,11 @@ g_list_store_insert (GListStore *store,
                      guint       position,
                      gpointer    item)
 {
-  GSequenceIter *it;
-
   g_return_if_fail (G_IS_LIST_STORE (store));
   g_return_if_fail (g_type_is_a (G_OBJECT_TYPE (item), store->item_type));
-  g_return_if_fail (position <= (guint) g_sequence_get_length (store->items));
+  g_return_if_fail (position <= store->items.n_items);
 
-  it = g_sequence_get_iter_at_pos (store->items, position);
-  g_sequence_insert_before (it, g_object_ref (item));
+  item_tree_insert (&store->items, position, g_object_ref (item));
 
   g_list_store_items_changed (store, position, 0, 1);
 }
@@ -317,21 +704,50 @@ g_list_store_insert_sorted (GListStore       *store,
                             GCompareDataFunc  compare_func,
                             gpointer          user_data)
 {
-  GSequenceIter *it;
-  guint position;
+  guint position, end;
 
   g_return_val_if_fail (G_IS_LIST_STORE (store), 0);
   g_return_val_if_fail (g_type_is_a (G_OBJECT_TYPE (item), store->item_type), 0);
   g_return_val_if_fail (compare_func != NULL, 0);
 
-  it = g_sequence_insert_sorted (store->items, g_object_ref (item), compare_func, user_data);
-  position = g_sequence_iter_get_position (it);
+  /* Insert after any equal items */
+  position = 0;
+  end = store->items.n_items;
+  while (position < end)
+    {
+      guint mid = position + (end - position) / 2;
+      ItemTreeLeaf *leaf;
+      guint index;
+
+      if (compare_func (item_tree_get (&store->items, mid, &leaf, &index), item, user_data) > 0)
+        end = mid;
+      else
+        position = mid + 1;
+    }
+
+  item_tree_insert (&store->items, position, g_object_ref (item));
 
   g_list_store_items_changed (store, position, 0, 1);
 
   return position;
 }
 
+typedef struct
+{
+  GCompareDataFunc compare_func;
+  gpointer user_data;
+} SortData;
+
+static gint
+sort_compare (gconstpointer a,
+              gconstpointer b,
+              gpointer      user_data)
+{
+  SortData *data = user_data;
+
+  return data->compare_func (*(gpointer *) a, *(gpointer *) b, data->user_data);
+}
+
 /**
  * g_list_store_sort:
  * @store: a #GListStore
@@ -347,14 +763,33 @@ g_list_store_sort (GListStore       *store,
                    GCompareDataFunc  compare_func,
                    gpointer          user_data)
 {
-  gint n_items;
+  SortData data = { compare_func, user_data };
+  ItemTreeLeaf *leaf;
+  gpointer *items;
+  guint n_items, i;
 
   g_return_if_fail (G_IS_LIST_STORE (store));
   g_return_if_fail (compare_func != NULL);
 
-  g_sequence_sort (store->items, compare_func, user_data);
+  /* Sort a flat copy, and put the items back into the same leaves */
+  n_items = store->items.n_items;
+  items = g_new (gpointer, n_items);
+  for (leaf = store->items.first, i = 0; leaf != NULL; leaf = leaf->next)
+    {
+      memcpy (&items[i], leaf->items, leaf->node.n_children * sizeof (gpointer));
+      i += leaf->node.n_children;
+    }
+
+  g_qsort_with_data (items, n_items, sizeof (gpointer), sort_compare, &data);
+
+  for (leaf = store->items.first, i = 0; leaf != NULL; leaf = leaf->next)
+    {
+      memcpy (leaf->items, &items[i], leaf->node.n_children * sizeof (gpointer));
+      i += leaf->node.n_children;
+    }
+
+  g_free (items);
 
-  n_items = g_sequence_get_length (store->items);
   g_list_store_items_changed (store, 0, n_items, n_items);
 }
 
@@ -381,8 +816,8 @@ g_list_store_append (GListStore *store,
   g_return_if_fail (G_IS_LIST_STORE (store));
   g_return_if_fail (g_type_is_a (G_OBJECT_TYPE (item), store->item_type));
 
-  n_items = g_sequence_get_length (store->items);
-  g_sequence_append (store->items, g_object_ref (item));
+  n_items = store->items.n_items;
+  item_tree_insert (&store->items, n_items, g_object_ref (item));
 
   g_list_store_items_changed (store, n_items, 0, 1);
 }
@@ -404,14 +839,10 @@ void
 g_list_store_remove (GListStore *store,
                      guint       position)
 {
-  GSequenceIter *it;
-
   g_return_if_fail (G_IS_LIST_STORE (store));
+  g_return_if_fail (position < store->items.n_items);
 
-  it = g_sequence_get_iter_at_pos (store->items, position);
-  g_return_if_fail (!g_sequence_iter_is_end (it));
-
-  g_sequence_remove (it);
+  g_object_unref (item_tree_remove (&store->items, position));
   g_list_store_items_changed (store, position, 1, 0);
 }
 
@@ -430,9 +861,9 @@ g_list_store_remove_all (GListStore *store)
 
   g_return_if_fail (G_IS_LIST_STORE (store));
 
-  n_items = g_sequence_get_length (store->items);
-  g_sequence_remove_range (g_sequence_get_begin_iter (store->items),
-                           g_sequence_get_end_iter (store->items));
+  n_items = store->items.n_items;
+  item_tree_clear (&store->items);
+  item_tree_init (&store->items);
 
   g_list_store_items_changed (store, 0, n_items, 0);
 }
@@ -468,42 +899,27 @@ g_list_store_splice (GListStore *store,
                      gpointer   *additions,
                      guint       n_additions)
 {
-  GSequenceIter *it;
-  guint n_items;
+  guint n_items, i;
 
   g_return_if_fail (G_IS_LIST_STORE (store));
   g_return_if_fail (position + n_removals >= position); /* overflow */
 
-  n_items = g_sequence_get_length (store->items);
+  n_items = store->items.n_items;
   g_return_if_fail (position + n_removals <= n_items);
 
-  it = g_sequence_get_iter_at_pos (store->items, position);
+  for (i = 0; i < n_removals; i++)
+    g_object_unref (item_tree_remove (&store->items, position));
 
-  if (n_removals)
+  for (i = 0; i < n_additions; i++)
     {
-      GSequenceIter *end;
-
-      end = g_sequence_iter_move (it, n_removals);
-      g_sequence_remove_range (it, end);
-
-      it = end;
-    }
-
-  if (n_additions)
-    {
-      guint i;
-
-      for (i = 0; i < n_additions; i++)
+      if G_UNLIKELY (!g_type_is_a (G_OBJECT_TYPE (additions[i]), store->item_type))
         {
-          if G_UNLIKELY (!g_type_is_a (G_OBJECT_TYPE (additions[i]), store->item_type))
-            {
-              g_critical ("%s: item %d is a %s instead of a %s.  GListStore is now in an undefined state.",
-                          G_STRFUNC, i, G_OBJECT_TYPE_NAME (additions[i]), g_type_name (store->item_type));
-              return;
-            }
-
-          g_sequence_insert_before (it, g_object_ref (additions[i]));
+          g_critical ("%s: item %d is a %s instead of a %s.  GListStore is now in an undefined state.",
+                      G_STRFUNC, i, G_OBJECT_TYPE_NAME (additions[i]), g_type_name (store->item_type));
+          return;
         }
+
+      item_tree_insert (&store->items, position + i, g_object_ref (additions[i]));
     }
 
   g_list_store_items_changed (store, position, n_removals, n_additions);
@@ -577,32 +993,31 @@ g_list_store_find_with_equal_func_full (GListStore     *store,
                                         gpointer        user_data,
                                         guint          *position)
 {
-  GSequenceIter *iter, *begin, *end;
+  ItemTreeLeaf *leaf;
+  guint offset;
 
   g_return_val_if_fail (G_IS_LIST_STORE (store), FALSE);
   g_return_val_if_fail (item == NULL || g_type_is_a (G_OBJECT_TYPE (item), store->item_type),
                         FALSE);
   g_return_val_if_fail (equal_func != NULL, FALSE);
 
-  /* NOTE: We can't use g_sequence_lookup() or g_sequence_search(), because we
-   * can't assume the sequence is sorted. */
-  begin = g_sequence_get_begin_iter (store->items);
-  end = g_sequence_get_end_iter (store->items);
-
-  iter = begin;
-  while (iter != end)
+  /* NOTE: We can't do a binary search, because we can't assume the store
+   * is sorted. */
+  for (leaf = store->items.first, offset = 0; leaf != NULL; leaf = leaf->next)
     {
-      gpointer iter_item;
+      guint i;
 
-      iter_item = g_sequence_get (iter);
-      if (equal_func (iter_item, item, user_data))
+      for (i = 0; i < leaf->node.n_children; i++)
         {
-          if (position)
-            *position = g_sequence_iter_get_position (iter);
-          return TRUE;
+          if (equal_func (leaf->items[i], item, user_data))
+            {
+              if (position)
+                *position = offset + i;
+              return TRUE;
+            }
         }
 
-      iter = g_sequence_iter_next (iter);
+      offset += leaf->node.n_children;
     }
 
   return FALSE;
@@ -111,6 +111,7 @@ struct _GLocalFile
 {
   GObject parent_instance;
 
+  /* Canonical, as a GRefString so that it can be shared by g_file_dup() */
   char *filename;
 };
 
@@ -132,7 +133,7 @@ g_local_file_finalize (GObject *object)
 
   local = G_LOCAL_FILE (object);
 
-  g_free (local->filename);
+  g_ref_string_release (local->filename);
 
   G_OBJECT_CLASS (g_local_file_parent_class)->finalize (object);
 }
@@ -225,17 +226,113 @@ _g_local_file_get_filename (GLocalFile *file)
   return file->filename;
 }
 
-GFile *
-_g_local_file_new (const char *filename)
+/* Takes ownership of @filename, a canonical GRefString */
+static GFile *
+g_local_file_new_canonical (char *filename)
 {
   GLocalFile *local;
 
   local = g_object_new (G_TYPE_LOCAL_FILE, NULL);
-  local->filename = g_canonicalize_filename (filename, NULL);
-  
+  local->filename = filename;
+
   return G_FILE (local);
 }
 
+/* Whether g_canonicalize_filename() would return @filename unchanged,
+ * which is the case for most of the paths built by GLib itself and
+ * is a lot cheaper to check than to canonicalize again */
+static gboolean
+filename_is_canonical (const char *filename)
+{
+#ifdef G_OS_WIN32
+  /* Separators and drive letters are normalized as well */
+  return FALSE;
+#else
+  const char *p;
+
+  if (filename[0] != '/')
+    return FALSE;
+
+  for (p = filename; (p = strchr (p, '/')) != NULL; p++)
+    {
+      /* Empty, "." or ".." components, or a trailing separator */
+      if (p[1] == '/' || (p[1] == '\0' && p != filename))
+        return FALSE;
+      if (p[1] == '.' && (p[2] == '/' || p[2] == '\0'))
+        return FALSE;
+      if (p[1] == '.' && p[2] == '.' && (p[3] == '/' || p[3] == '\0'))
+        return FALSE;
+    }
+
+  return TRUE;
+#endif
+}
+
+/* Whether @name is a single path component which can be appended to a
+ * canonical path without making it non-canonical */
+static gboolean
+name_is_simple (const char *name)
+{
+  if (name[0] == '\0' || strchr (name, '/') != NULL)
+    return FALSE;
+#ifdef G_OS_WIN32
+  if (strchr (name, '\\') != NULL || strchr (name, ':') != NULL)
+    return FALSE;
+#endif
+
+  return !g_str_equal (name, ".") && !g_str_equal (name, "..");
+}
+
+/* Like g_build_filename() for a canonical @dirname and a simple
+ * @basename, but building the GRefString without an intermediate copy
+ * for most paths */
+static char *
+ref_string_build_filename (const char *dirname,
+                           const char *basename)
+{
+  gsize dirname_len = strlen (dirname);
+  gsize basename_len = strlen (basename);
+  gboolean separator;
+  char stack_buffer[1024];
+  char *buffer;
+  char *filename;
+  gsize len;
+
+  separator = dirname_len == 0 || !G_IS_DIR_SEPARATOR (dirname[dirname_len - 1]);
+  len = dirname_len + (separator ? 1 : 0) + basename_len;
+
+  buffer = len < sizeof (stack_buffer) ? stack_buffer : g_malloc (len + 1);
+
+  memcpy (buffer, dirname, dirname_len);
+  if (separator)
+    buffer[dirname_len] = G_DIR_SEPARATOR;
+  memcpy (buffer + len - basename_len, basename, basename_len);
+  buffer[len] = '\0';
+
+  filename = g_ref_string_new_len (buffer, len);
+
+  if (buffer != stack_buffer)
+    g_free (buffer);
+
+  return filename;
+}
+
+GFile *
+_g_local_file_new (const char *filename)
+{
+  char *canonical;
+  GFile *file;
+
+  if (filename_is_canonical (filename))
+    return g_local_file_new_canonical (g_ref_string_new (filename));
+
+  canonical = g_canonicalize_filename (filename, NULL);
+  file = g_local_file_new_canonical (g_ref_string_new (canonical));
+  g_free (canonical);
+
+  return file;
+}
+
 /*< internal >
  * g_local_file_new_from_dirname_and_basename:
  * @dirname: an absolute, canonical directory name
@@ -257,15 +354,10 @@ GFile *
 g_local_file_new_from_dirname_and_basename (const gchar *dirname,
                                             const gchar *basename)
 {
-  GLocalFile *local;
-
   g_return_val_if_fail (dirname != NULL, NULL);
   g_return_val_if_fail (basename && basename[0] && !strchr (basename, '/'), NULL);
 
-  local = g_object_new (G_TYPE_LOCAL_FILE, NULL);
-  local->filename = g_build_filename (dirname, basename, NULL);
-
-  return G_FILE (local);
+  return g_local_file_new_canonical (ref_string_build_filename (dirname, basename));
 }
 
 static gboolean
@@ -443,8 +535,9 @@ g_local_file_get_parent (GFile *file)
   if (*non_root == 0)
     return NULL;
 
+  /* The parent of a canonical path is canonical as well */
   dirname = g_path_get_dirname (local->filename);
-  parent = _g_local_file_new (dirname);
+  parent = g_local_file_new_canonical (g_ref_string_new (dirname));
   g_free (dirname);
   return parent;
 }
@@ -454,7 +547,7 @@ g_local_file_dup (GFile *file)
 {
   GLocalFile *local = G_LOCAL_FILE (file);
 
-  return _g_local_file_new (local->filename);
+  return g_local_file_new_canonical (g_ref_string_acquire (local->filename));
 }
 
 static guint
@@ -472,7 +565,8 @@ g_local_file_equal (GFile *file1,
   GLocalFile *local1 = G_LOCAL_FILE (file1);
   GLocalFile *local2 = G_LOCAL_FILE (file2);
 
-  return g_str_equal (local1->filename, local2->filename);
+  return local1->filename == local2->filename ||
+         g_str_equal (local1->filename, local2->filename);
 }
 
 static const char *
@@ -533,7 +627,11 @@ g_local_file_resolve_relative_path (GFile      *file,
 
   if (g_path_is_absolute (relative_path))
     return _g_local_file_new (relative_path);
-  
+
+  /* The common case of g_file_get_child() */
+  if (name_is_simple (relative_path))
+    return g_local_file_new_canonical (ref_string_build_filename (local->filename, relative_path));
+
   filename = g_build_filename (local->filename, relative_path, NULL);
   child = _g_local_file_new (filename);
   g_free (filename);
@@ -1246,7 +1344,7 @@ g_local_file_query_info (GFile                *file,
   _g_local_file_info_get_parent_info (dirname, matcher, &parent_info);
   g_free (dirname);
   
-  info = _g_local_file_info_get (basename, local->filename,
+  info = _g_local_file_info_get (basename, local->filename, -1,
 				 matcher, flags, &parent_info,
 				 error);
   
@@ -2814,6 +2912,8 @@ g_local_file_measure_size_error (GFileMeasureFlags   flags,
     return TRUE;
 }
 
+typedef struct _MeasureShared MeasureShared;
+
 typedef struct
 {
   GFileMeasureFlags  flags;
@@ -2828,8 +2928,74 @@ typedef struct
   guint64 num_files;
 
   guint64 last_progress_report;
+
+  /* (dev, ino) of the files with several links seen so far, for
+   * %G_FILE_MEASURE_DEDUPLICATE_HARDLINKS */
+  GHashTable *inodes;
+
+  /* For %G_FILE_MEASURE_PARALLEL, or %NULL */
+  MeasureShared *shared;
 } MeasureState;
 
+/* With %G_FILE_MEASURE_PARALLEL, every directory below the toplevel is
+ * measured as a separate job on a thread pool */
+struct _MeasureShared
+{
+  GThreadPool *pool;
+  MeasureState *root_state;
+
+  GMutex lock;
+  GCond cond;
+  guint pending;
+  GError *error;
+  guint64 disk_usage;
+  guint64 num_dirs;
+  guint64 num_files;
+};
+
+typedef struct
+{
+  guint64 dev;
+  guint64 ino;
+} MeasureInode;
+
+static guint
+measure_inode_hash (gconstpointer key)
+{
+  const MeasureInode *inode = key;
+
+  return (guint) (inode->ino ^ (inode->ino >> 32) ^ (inode->dev * 31));
+}
+
+static gboolean
+measure_inode_equal (gconstpointer a,
+                     gconstpointer b)
+{
+  const MeasureInode *inode_a = a;
+  const MeasureInode *inode_b = b;
+
+  return inode_a->ino == inode_b->ino && inode_a->dev == inode_b->dev;
+}
+
+/* Returns %TRUE if the file was already counted through another link */
+static gboolean
+measure_seen_inode (MeasureState         *state,
+                    const GLocalFileStat *buf)
+{
+  MeasureInode inode = { _g_stat_dev (buf), _g_stat_ino (buf) };
+  gboolean added;
+
+  if (state->shared)
+    g_mutex_lock (&state->shared->lock);
+
+  added = g_hash_table_add (state->inodes, g_memdup2 (&inode, sizeof (inode)));
+
+  if (state->shared)
+    g_mutex_unlock (&state->shared->lock);
+
+  return !added;
+}
+
 static gboolean
 g_local_file_measure_size_of_contents (gint           fd,
                                        GSList        *dir_name,
@@ -2919,6 +3085,13 @@ g_local_file_measure_size_of_file (gint           parent_fd,
       state->contained_on = _g_stat_dev (&buf);
     }
 
+#ifndef G_OS_WIN32
+  if ((state->flags & G_FILE_MEASURE_DEDUPLICATE_HARDLINKS) &&
+      !S_ISDIR (_g_stat_mode (&buf)) && _g_stat_nlink (&buf) > 1 &&
+      measure_seen_inode (state, &buf))
+    return TRUE;
+#endif
+
 #if defined (G_OS_WIN32)
   if (~state->flags & G_FILE_MEASURE_APPARENT_SIZE)
     state->disk_usage += buf.allocated_size;
@@ -2977,6 +3150,20 @@ g_local_file_measure_size_of_file (gint           parent_fd,
         return FALSE;
 
 #ifdef AT_FDCWD
+      if (state->shared != NULL)
+        {
+          /* Hand the directory over to the pool; the name is copied as
+           * the list lives on our stack */
+          g_mutex_lock (&state->shared->lock);
+          state->shared->pending++;
+          g_mutex_unlock (&state->shared->lock);
+
+          g_thread_pool_push (state->shared->pool,
+                              g_slist_copy_deep (name, (GCopyFunc) g_strdup, NULL),
+                              NULL);
+          return TRUE;
+        }
+
 #ifdef HAVE_OPEN_O_DIRECTORY
       dir_fd = openat (parent_fd, name->data, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
 #else
@@ -3051,6 +3238,128 @@ g_local_file_measure_size_of_contents (gint           fd,
   return success;
 }
 
+#ifdef AT_FDCWD
+static void
+g_local_file_measure_directory_thread (gpointer data,
+                                       gpointer user_data)
+{
+  GSList *name = data;
+  MeasureShared *shared = user_data;
+  MeasureState state = { 0, };
+  GError *error = NULL;
+  gboolean success = TRUE;
+
+  state.flags = shared->root_state->flags;
+  state.contained_on = shared->root_state->contained_on;
+  state.cancellable = shared->root_state->cancellable;
+  state.inodes = shared->root_state->inodes;
+  state.shared = shared;
+
+  if (!g_cancellable_set_error_if_cancelled (state.cancellable, &error))
+    {
+      GString *path;
+      GSList *node;
+      int dir_fd;
+
+      /* The name list runs from the directory up to the toplevel */
+      path = g_string_new (NULL);
+      for (node = name; node; node = node->next)
+        {
+          if (node != name)
+            g_string_prepend_c (path, G_DIR_SEPARATOR);
+          g_string_prepend (path, node->data);
+        }
+
+#ifdef HAVE_OPEN_O_DIRECTORY
+      dir_fd = open (path->str, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+#else
+      dir_fd = open (path->str, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+#endif
+      if (dir_fd < 0)
+        {
+          int errsv = errno;
+          success = g_local_file_measure_size_error (state.flags, errsv, name, &error);
+        }
+      else
+        success = g_local_file_measure_size_of_contents (dir_fd, name, &state, &error);
+
+      g_string_free (path, TRUE);
+    }
+  else
+    success = FALSE;
+
+  g_mutex_lock (&shared->lock);
+  shared->disk_usage += state.disk_usage;
+  shared->num_dirs += state.num_dirs;
+  shared->num_files += state.num_files;
+  if (!success && shared->error == NULL)
+    shared->error = g_steal_pointer (&error);
+  if (--shared->pending == 0)
+    g_cond_signal (&shared->cond);
+  g_mutex_unlock (&shared->lock);
+
+  /* Stop the other jobs */
+  if (!success)
+    g_cancellable_cancel (state.cancellable);
+
+  g_clear_error (&error);
+  g_slist_free_full (name, g_free);
+}
+
+static void
+g_local_file_measure_cancelled_cb (GCancellable *cancellable,
+                                   gpointer      user_data)
+{
+  g_cancellable_cancel (G_CANCELLABLE (user_data));
+}
+
+/* Waits for the pool to measure everything below the toplevel, reporting
+ * progress from this thread */
+static gboolean
+g_local_file_measure_wait (MeasureState  *state,
+                           MeasureShared *shared,
+                           GError       **error)
+{
+  gint64 next_report;
+  gboolean success;
+
+  next_report = g_get_monotonic_time () + 200 * G_TIME_SPAN_MILLISECOND;
+
+  g_mutex_lock (&shared->lock);
+  while (shared->pending > 0)
+    {
+      if (!g_cond_wait_until (&shared->cond, &shared->lock, next_report) &&
+          state->progress_callback)
+        {
+          guint64 disk_usage = state->disk_usage + shared->disk_usage;
+          guint64 num_dirs = state->num_dirs + shared->num_dirs;
+          guint64 num_files = state->num_files + shared->num_files;
+
+          g_mutex_unlock (&shared->lock);
+          (* state->progress_callback) (TRUE, disk_usage, num_dirs, num_files,
+                                        state->progress_data);
+          g_mutex_lock (&shared->lock);
+        }
+
+      if (g_get_monotonic_time () >= next_report)
+        next_report = g_get_monotonic_time () + 200 * G_TIME_SPAN_MILLISECOND;
+    }
+  g_mutex_unlock (&shared->lock);
+
+  g_thread_pool_free (shared->pool, FALSE, TRUE);
+
+  state->disk_usage += shared->disk_usage;
+  state->num_dirs += shared->num_dirs;
+  state->num_files += shared->num_files;
+
+  success = shared->error == NULL;
+  if (!success)
+    g_propagate_error (error, g_steal_pointer (&shared->error));
+
+  return success;
+}
+#endif  /* AT_FDCWD */
+
 static gboolean
 g_local_file_measure_disk_usage (GFile                         *file,
                                  GFileMeasureFlags              flags,
@@ -3066,20 +3375,71 @@ g_local_file_measure_disk_usage (GFile                         *file,
   MeasureState state = { 0, };
   gint root_fd = -1;
   GSList node;
+  gboolean success;
+#ifdef AT_FDCWD
+  MeasureShared shared = { 0, };
+  GCancellable *shared_cancellable = NULL;
+  gulong cancelled_id = 0;
+#endif
 
   state.flags = flags;
   state.cancellable = cancellable;
   state.progress_callback = progress_callback;
   state.progress_data = progress_data;
 
+  if (flags & G_FILE_MEASURE_DEDUPLICATE_HARDLINKS)
+    state.inodes = g_hash_table_new_full (measure_inode_hash, measure_inode_equal,
+                                          g_free, NULL);
+
 #ifdef AT_FDCWD
   root_fd = AT_FDCWD;
+
+  if (flags & G_FILE_MEASURE_PARALLEL)
+    {
+      /* Cancelled by @cancellable, or by the first error */
+      shared_cancellable = g_cancellable_new ();
+      if (cancellable)
+        cancelled_id = g_cancellable_connect (cancellable,
+                                              G_CALLBACK (g_local_file_measure_cancelled_cb),
+                                              g_object_ref (shared_cancellable),
+                                              g_object_unref);
+
+      g_mutex_init (&shared.lock);
+      g_cond_init (&shared.cond);
+      shared.root_state = &state;
+      shared.pool = g_thread_pool_new (g_local_file_measure_directory_thread, &shared,
+                                       g_get_num_processors (), FALSE, NULL);
+
+      state.cancellable = shared_cancellable;
+      state.shared = &shared;
+    }
 #endif
 
   node.data = local_file->filename;
   node.next = NULL;
 
-  if (!g_local_file_measure_size_of_file (root_fd, &node, &state, error))
+  success = g_local_file_measure_size_of_file (root_fd, &node, &state, error);
+
+#ifdef AT_FDCWD
+  if (state.shared != NULL)
+    {
+      /* Even on failure, the jobs already queued have to finish */
+      if (!success)
+        g_cancellable_cancel (shared_cancellable);
+
+      if (!g_local_file_measure_wait (&state, &shared, success ? error : NULL))
+        success = FALSE;
+
+      g_cancellable_disconnect (cancellable, cancelled_id);
+      g_object_unref (shared_cancellable);
+      g_mutex_clear (&shared.lock);
+      g_cond_clear (&shared.cond);
+    }
+#endif
+
+  g_clear_pointer (&state.inodes, g_hash_table_unref);
+
+  if (!success)
     return FALSE;
 
   if (disk_usage)
@@ -375,6 +375,7 @@ g_local_file_enumerator_next_file (GFileEnumerator  *enumerator,
   GFileInfo *info;
   GError *my_error;
   GFileType file_type;
+  int dir_fd;
 
   if (!local->got_parent_info)
     {
@@ -390,8 +391,11 @@ g_local_file_enumerator_next_file (GFileEnumerator  *enumerator,
 #ifdef USE_GDIR
   filename = g_dir_read_name (local->dir);
   file_type = G_FILE_TYPE_UNKNOWN;
+  dir_fd = -1;
 #else
   filename = next_file_helper (local, &file_type);
+  /* Stat entries relative to the directory rather than by full path */
+  dir_fd = dirfd (local->dir);
 #endif
 
   if (filename == NULL)
@@ -402,7 +406,7 @@ g_local_file_enumerator_next_file (GFileEnumerator  *enumerator,
   if (file_type == G_FILE_TYPE_UNKNOWN ||
       (file_type == G_FILE_TYPE_SYMBOLIC_LINK && !(local->flags & G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS)))
     {
-      info = _g_local_file_info_get (filename, path,
+      info = _g_local_file_info_get (filename, path, dir_fd,
                                      local->matcher,
                                      local->flags,
                                      &local->parent_info,
@@ -410,7 +414,7 @@ g_local_file_enumerator_next_file (GFileEnumerator  *enumerator,
     }
   else
     {
-      info = _g_local_file_info_get (filename, path,
+      info = _g_local_file_info_get (filename, path, dir_fd,
                                      local->reduced_matcher,
                                      local->flags,
                                      &local->parent_info,
@@ -1891,9 +1891,298 @@ get_icon (const char *path,
   return icon;
 }
 
+/* Stats the file at @path, or @basename inside @dir_fd if that is not -1,
+ * which saves the kernel from walking the whole path again */
+static int
+stat_file (int                  dir_fd,
+           const char          *basename,
+           const char          *path,
+           gboolean             follow_symlinks,
+           GLocalFileStatField  mask,
+           GLocalFileStatField  mask_required,
+           GLocalFileStat      *statbuf)
+{
+#if !defined(G_OS_WIN32) && defined(AT_FDCWD)
+  if (dir_fd != -1 && basename != NULL)
+    {
+      int flags = follow_symlinks ? 0 : AT_SYMLINK_NOFOLLOW;
+
+#ifdef HAVE_STATX
+      flags |= AT_NO_AUTOMOUNT | AT_STATX_SYNC_AS_STAT;
+#endif
+
+      return g_local_file_fstatat (dir_fd, basename, flags, mask, mask_required, statbuf);
+    }
+#endif
+
+  if (follow_symlinks)
+    return g_local_file_stat (path, mask, mask_required, statbuf);
+  else
+    return g_local_file_lstat (path, mask, mask_required, statbuf);
+}
+
+static void
+get_content_type_attributes (GFileInfo             *info,
+                             const char            *basename,
+                             const char            *path,
+                             GLocalFileStat        *statbuf,
+                             gboolean               is_symlink,
+                             gboolean               symlink_broken,
+                             GFileQueryInfoFlags    flags,
+                             GFileAttributeMatcher *attribute_matcher)
+{
+  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
+					    G_FILE_ATTRIBUTE_ID_STANDARD_CONTENT_TYPE) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher,
+					    G_FILE_ATTRIBUTE_ID_STANDARD_ICON) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher,
+					    G_FILE_ATTRIBUTE_ID_STANDARD_SYMBOLIC_ICON))
+    {
+      char *content_type = get_content_type (basename, path, statbuf, is_symlink, symlink_broken, flags, FALSE);
+
+      if (content_type)
+	{
+	  g_file_info_set_content_type (info, content_type);
+
+	  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
+                                                     G_FILE_ATTRIBUTE_ID_STANDARD_ICON)
+               || _g_file_attribute_matcher_matches_id (attribute_matcher,
+                                                        G_FILE_ATTRIBUTE_ID_STANDARD_SYMBOLIC_ICON))
+	    {
+	      GIcon *icon;
+
+              /* non symbolic icon */
+              icon = get_icon (path, content_type, FALSE);
+              if (icon != NULL)
+                {
+                  g_file_info_set_icon (info, icon);
+                  g_object_unref (icon);
+                }
+
+              /* symbolic icon */
+              icon = get_icon (path, content_type, TRUE);
+              if (icon != NULL)
+                {
+                  g_file_info_set_symbolic_icon (info, icon);
+                  g_object_unref (icon);
+                }
+
+	    }
+	  
+	  g_free (content_type);
+	}
+    }
+}
+
+static void
+get_all_thumbnail_attributes (GFileInfo             *info,
+                              const char            *path,
+                              const GLocalFileStat  *statbuf,
+                              GFileAttributeMatcher *attribute_matcher)
+{
+  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED))
+    {
+      get_thumbnail_attributes (path, info, statbuf, THUMBNAIL_SIZE_AUTO);
+    }
+
+  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH_NORMAL) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID_NORMAL) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED_NORMAL))
+    {
+      get_thumbnail_attributes (path, info, statbuf, THUMBNAIL_SIZE_NORMAL);
+    }
+
+  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH_LARGE) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID_LARGE) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED_LARGE))
+    {
+      get_thumbnail_attributes (path, info, statbuf, THUMBNAIL_SIZE_LARGE);
+    }
+
+  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH_XLARGE) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID_XLARGE) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED_XLARGE))
+    {
+      get_thumbnail_attributes (path, info, statbuf, THUMBNAIL_SIZE_XLARGE);
+    }
+
+  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH_XXLARGE) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID_XXLARGE) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher,
+                                            G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED_XXLARGE))
+    {
+      get_thumbnail_attributes (path, info, statbuf, THUMBNAIL_SIZE_XXLARGE);
+    }
+}
+
+/* Everything needed to compute the deferred attributes later on */
+typedef struct {
+  char *basename;
+  char *path;
+  GLocalFileStat statbuf;
+  gboolean stat_ok;
+  gboolean is_symlink;
+  gboolean symlink_broken;
+  GFileQueryInfoFlags flags;
+  GFileAttributeMatcher *attribute_matcher;
+} DeferredData;
+
+static void
+deferred_data_clear (gpointer data)
+{
+  DeferredData *deferred = data;
+
+  g_free (deferred->basename);
+  g_free (deferred->path);
+  g_file_attribute_matcher_unref (deferred->attribute_matcher);
+}
+
+static void
+deferred_data_release (gpointer data)
+{
+  g_atomic_rc_box_release_full (data, deferred_data_clear);
+}
+
+static void
+resolve_content_type_attributes (GFileInfo *info,
+                                 gpointer   user_data)
+{
+  DeferredData *deferred = user_data;
+
+  get_content_type_attributes (info, deferred->basename, deferred->path,
+                               deferred->stat_ok ? &deferred->statbuf : NULL,
+                               deferred->is_symlink, deferred->symlink_broken,
+                               deferred->flags, deferred->attribute_matcher);
+}
+
+static void
+resolve_thumbnail_attributes (GFileInfo *info,
+                              gpointer   user_data)
+{
+  DeferredData *deferred = user_data;
+
+  get_all_thumbnail_attributes (info, deferred->path,
+                                deferred->stat_ok ? &deferred->statbuf : NULL,
+                                deferred->attribute_matcher);
+}
+
+static const guint32 content_type_attributes[] = {
+  G_FILE_ATTRIBUTE_ID_STANDARD_CONTENT_TYPE,
+  G_FILE_ATTRIBUTE_ID_STANDARD_ICON,
+  G_FILE_ATTRIBUTE_ID_STANDARD_SYMBOLIC_ICON,
+};
+
+static const guint32 thumbnail_attributes[] = {
+  G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH,
+  G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID,
+  G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED,
+  G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH_NORMAL,
+  G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID_NORMAL,
+  G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED_NORMAL,
+  G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH_LARGE,
+  G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID_LARGE,
+  G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED_LARGE,
+  G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH_XLARGE,
+  G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID_XLARGE,
+  G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED_XLARGE,
+  G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH_XXLARGE,
+  G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID_XXLARGE,
+  G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED_XXLARGE,
+};
+
+static gboolean
+matches_any (GFileAttributeMatcher *attribute_matcher,
+             const guint32         *attributes,
+             gsize                  n_attributes)
+{
+  gsize i;
+
+  for (i = 0; i < n_attributes; i++)
+    {
+      if (_g_file_attribute_matcher_matches_id (attribute_matcher, attributes[i]))
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
+/* For %G_FILE_QUERY_INFO_LAZY: sniffing the content type and looking up
+ * icons and thumbnails is left until @info is asked for them */
+static void
+defer_attributes (GFileInfo             *info,
+                  const char            *basename,
+                  const char            *path,
+                  GLocalFileStat        *statbuf,
+                  gboolean               is_symlink,
+                  gboolean               symlink_broken,
+                  GFileQueryInfoFlags    flags,
+                  GFileAttributeMatcher *attribute_matcher)
+{
+  gboolean want_content_type, want_thumbnails;
+  DeferredData *deferred;
+
+  want_content_type = matches_any (attribute_matcher, content_type_attributes,
+                                   G_N_ELEMENTS (content_type_attributes));
+  want_thumbnails = matches_any (attribute_matcher, thumbnail_attributes,
+                                 G_N_ELEMENTS (thumbnail_attributes));
+
+  if (!want_content_type && !want_thumbnails)
+    return;
+
+  deferred = g_atomic_rc_box_new0 (DeferredData);
+  deferred->basename = g_strdup (basename);
+  deferred->path = g_strdup (path);
+  if (statbuf != NULL)
+    {
+      deferred->statbuf = *statbuf;
+      deferred->stat_ok = TRUE;
+    }
+  deferred->is_symlink = is_symlink;
+  deferred->symlink_broken = symlink_broken;
+  deferred->flags = flags;
+  deferred->attribute_matcher = g_file_attribute_matcher_ref (attribute_matcher);
+
+  if (want_content_type)
+    _g_file_info_defer_attributes (info, attribute_matcher,
+                                   content_type_attributes,
+                                   G_N_ELEMENTS (content_type_attributes),
+                                   resolve_content_type_attributes,
+                                   g_atomic_rc_box_acquire (deferred),
+                                   deferred_data_release);
+
+  if (want_thumbnails)
+    _g_file_info_defer_attributes (info, attribute_matcher,
+                                   thumbnail_attributes,
+                                   G_N_ELEMENTS (thumbnail_attributes),
+                                   resolve_thumbnail_attributes,
+                                   g_atomic_rc_box_acquire (deferred),
+                                   deferred_data_release);
+
+  deferred_data_release (deferred);
+}
+
+/* @dir_fd is a file descriptor for the directory containing @basename, or
+ * -1 to look the file up by @path */
 GFileInfo *
 _g_local_file_info_get (const char             *basename,
 			const char             *path,
+			int                     dir_fd,
 			GFileAttributeMatcher  *attribute_matcher,
 			GFileQueryInfoFlags     flags,
 			GLocalParentFileInfo   *parent_info,
@@ -1909,6 +2198,7 @@ _g_local_file_info_get (const char             *basename,
   GVfs *vfs;
   GVfsClass *class;
   guint64 device;
+  GLocalFileStatField stat_mask;
 
   info = g_file_info_new ();
 
@@ -1923,10 +2213,17 @@ _g_local_file_info_get (const char             *basename,
       return info;
     }
 
-  res = g_local_file_lstat (path,
-                            G_LOCAL_FILE_STAT_FIELD_BASIC_STATS | G_LOCAL_FILE_STAT_FIELD_BTIME,
-                            G_LOCAL_FILE_STAT_FIELD_ALL & (~G_LOCAL_FILE_STAT_FIELD_BTIME) & (~G_LOCAL_FILE_STAT_FIELD_ATIME),
-                            &statbuf);
+  /* The creation time can be expensive to get on some file systems */
+  stat_mask = G_LOCAL_FILE_STAT_FIELD_BASIC_STATS;
+  if (_g_file_attribute_matcher_matches_id (attribute_matcher, G_FILE_ATTRIBUTE_ID_TIME_CREATED) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher, G_FILE_ATTRIBUTE_ID_TIME_CREATED_USEC) ||
+      _g_file_attribute_matcher_matches_id (attribute_matcher, G_FILE_ATTRIBUTE_ID_TIME_CREATED_NSEC))
+    stat_mask |= G_LOCAL_FILE_STAT_FIELD_BTIME;
+
+  res = stat_file (dir_fd, basename, path, FALSE,
+                   stat_mask,
+                   G_LOCAL_FILE_STAT_FIELD_ALL & (~G_LOCAL_FILE_STAT_FIELD_BTIME) & (~G_LOCAL_FILE_STAT_FIELD_ATIME),
+                   &statbuf);
 
   if (res == -1)
     {
@@ -1973,10 +2270,10 @@ _g_local_file_info_get (const char             *basename,
       /* Unless NOFOLLOW was set we default to following symlinks */
       if (!(flags & G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS))
 	{
-          res = g_local_file_stat (path,
-                                   G_LOCAL_FILE_STAT_FIELD_BASIC_STATS | G_LOCAL_FILE_STAT_FIELD_BTIME,
-                                   G_LOCAL_FILE_STAT_FIELD_ALL & (~G_LOCAL_FILE_STAT_FIELD_BTIME) & (~G_LOCAL_FILE_STAT_FIELD_ATIME),
-                                   &statbuf2);
+          res = stat_file (dir_fd, basename, path, TRUE,
+                           stat_mask,
+                           G_LOCAL_FILE_STAT_FIELD_ALL & (~G_LOCAL_FILE_STAT_FIELD_BTIME) & (~G_LOCAL_FILE_STAT_FIELD_ATIME),
+                           &statbuf2);
 
 	  /* Report broken links as symlinks */
 	  if (res != -1)
@@ -2043,47 +2340,12 @@ _g_local_file_info_get (const char             *basename,
         g_file_info_set_symlink_target (info, symlink_target);
     }
 
-  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
-					    G_FILE_ATTRIBUTE_ID_STANDARD_CONTENT_TYPE) ||
-      _g_file_attribute_matcher_matches_id (attribute_matcher,
-					    G_FILE_ATTRIBUTE_ID_STANDARD_ICON) ||
-      _g_file_attribute_matcher_matches_id (attribute_matcher,
-					    G_FILE_ATTRIBUTE_ID_STANDARD_SYMBOLIC_ICON))
-    {
-      char *content_type = get_content_type (basename, path, stat_ok ? &statbuf : NULL, is_symlink, symlink_broken, flags, FALSE);
-
-      if (content_type)
-	{
-	  g_file_info_set_content_type (info, content_type);
-
-	  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
-                                                     G_FILE_ATTRIBUTE_ID_STANDARD_ICON)
-               || _g_file_attribute_matcher_matches_id (attribute_matcher,
-                                                        G_FILE_ATTRIBUTE_ID_STANDARD_SYMBOLIC_ICON))
-	    {
-	      GIcon *icon;
-
-              /* non symbolic icon */
-              icon = get_icon (path, content_type, FALSE);
-              if (icon != NULL)
-                {
-                  g_file_info_set_icon (info, icon);
-                  g_object_unref (icon);
-                }
-
-              /* symbolic icon */
-              icon = get_icon (path, content_type, TRUE);
-              if (icon != NULL)
-                {
-                  g_file_info_set_symbolic_icon (info, icon);
-                  g_object_unref (icon);
-                }
-
-	    }
-	  
-	  g_free (content_type);
-	}
-    }
+  if (flags & G_FILE_QUERY_INFO_LAZY)
+    defer_attributes (info, basename, path, stat_ok ? &statbuf : NULL,
+                      is_symlink, symlink_broken, flags, attribute_matcher);
+  else
+    get_content_type_attributes (info, basename, path, stat_ok ? &statbuf : NULL,
+                                 is_symlink, symlink_broken, flags, attribute_matcher);
 
   if (_g_file_attribute_matcher_matches_id (attribute_matcher,
 					    G_FILE_ATTRIBUTE_ID_STANDARD_FAST_CONTENT_TYPE))
@@ -2157,55 +2419,8 @@ _g_local_file_info_get (const char             *basename,
   get_xattrs (path, TRUE, info, attribute_matcher, (flags & G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS) == 0);
   get_xattrs (path, FALSE, info, attribute_matcher, (flags & G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS) == 0);
 
-  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH) ||
-      _g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID) ||
-      _g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED))
-    {
-      get_thumbnail_attributes (path, info, stat_ok ? &statbuf : NULL, THUMBNAIL_SIZE_AUTO);
-    }
-
-  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH_NORMAL) ||
-      _g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID_NORMAL) ||
-      _g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED_NORMAL))
-    {
-      get_thumbnail_attributes (path, info, stat_ok ? &statbuf : NULL, THUMBNAIL_SIZE_NORMAL);
-    }
-
-  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH_LARGE) ||
-      _g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID_LARGE) ||
-      _g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED_LARGE))
-    {
-      get_thumbnail_attributes (path, info, stat_ok ? &statbuf : NULL, THUMBNAIL_SIZE_LARGE);
-    }
-
-  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH_XLARGE) ||
-      _g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID_XLARGE) ||
-      _g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED_XLARGE))
-    {
-      get_thumbnail_attributes (path, info, stat_ok ? &statbuf : NULL, THUMBNAIL_SIZE_XLARGE);
-    }
-
-  if (_g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_PATH_XXLARGE) ||
-      _g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAIL_IS_VALID_XXLARGE) ||
-      _g_file_attribute_matcher_matches_id (attribute_matcher,
-                                            G_FILE_ATTRIBUTE_ID_THUMBNAILING_FAILED_XXLARGE))
-    {
-      get_thumbnail_attributes (path, info, stat_ok ? &statbuf : NULL, THUMBNAIL_SIZE_XXLARGE);
-    }
+  if (!(flags & G_FILE_QUERY_INFO_LAZY))
+    get_all_thumbnail_attributes (info, path, stat_ok ? &statbuf : NULL, attribute_matcher);
 
   vfs = g_vfs_get_default ();
   class = G_VFS_GET_CLASS (vfs);
@@ -362,6 +362,7 @@ void       _g_local_file_info_get_nostat      (GFileInfo              *info,
                                                GFileAttributeMatcher  *attribute_matcher);
 GFileInfo *_g_local_file_info_get             (const char             *basename,
                                                const char             *path,
+                                               int                     dir_fd,
                                                GFileAttributeMatcher  *attribute_matcher,
                                                GFileQueryInfoFlags     flags,
                                                GLocalParentFileInfo   *parent_info,
@@ -45,6 +45,10 @@
 #include <io.h>
 #endif
 
+#ifdef HAVE_LINUX_IO_URING_H
+#include "giouring-private.h"
+#endif
+
 struct _GLocalFileInputStreamPrivate {
   int fd;
   guint do_close : 1;
@@ -73,6 +77,15 @@ static gssize     g_local_file_input_stream_read       (GInputStream      *strea
 static gboolean   g_local_file_input_stream_close      (GInputStream      *stream,
 							GCancellable      *cancellable,
 							GError           **error);
+#ifdef HAVE_LINUX_IO_URING_H
+static void       g_local_file_input_stream_read_async (GInputStream      *stream,
+							void              *buffer,
+							gsize              count,
+							int                io_priority,
+							GCancellable      *cancellable,
+							GAsyncReadyCallback callback,
+							gpointer           user_data);
+#endif
 static goffset    g_local_file_input_stream_tell       (GFileInputStream  *stream);
 static gboolean   g_local_file_input_stream_can_seek   (GFileInputStream  *stream);
 static gboolean   g_local_file_input_stream_seek       (GFileInputStream  *stream,
@@ -103,6 +116,9 @@ g_local_file_input_stream_class_init (GLocalFileInputStreamClass *klass)
 
   stream_class->read_fn = g_local_file_input_stream_read;
   stream_class->close_fn = g_local_file_input_stream_close;
+#ifdef HAVE_LINUX_IO_URING_H
+  stream_class->read_async = g_local_file_input_stream_read_async;
+#endif
   file_stream_class->tell = g_local_file_input_stream_tell;
   file_stream_class->can_seek = g_local_file_input_stream_can_seek;
   file_stream_class->seek = g_local_file_input_stream_seek;
@@ -172,6 +188,38 @@ g_local_file_input_stream_read (GInputStream  *stream,
   return res;
 }
 
+#ifdef HAVE_LINUX_IO_URING_H
+static void
+g_local_file_input_stream_read_async (GInputStream        *stream,
+                                      void                *buffer,
+                                      gsize                count,
+                                      int                  io_priority,
+                                      GCancellable        *cancellable,
+                                      GAsyncReadyCallback  callback,
+                                      gpointer             user_data)
+{
+  GLocalFileInputStream *file = G_LOCAL_FILE_INPUT_STREAM (stream);
+  GIOUring *ring;
+  GTask *task;
+
+  /* Without io_uring, read in a thread of the GTask pool */
+  ring = g_io_uring_get_for_context (g_main_context_get_thread_default ());
+  if (ring == NULL)
+    {
+      G_INPUT_STREAM_CLASS (g_local_file_input_stream_parent_class)->
+        read_async (stream, buffer, count, io_priority, cancellable, callback, user_data);
+      return;
+    }
+
+  task = g_task_new (stream, cancellable, callback, user_data);
+  g_task_set_source_tag (task, g_local_file_input_stream_read_async);
+  g_task_set_priority (task, io_priority);
+
+  g_io_uring_file_read (ring, file->priv->fd, buffer, count, task);
+  g_object_unref (task);
+}
+#endif
+
 static gboolean
 g_local_file_input_stream_close (GInputStream  *stream,
 				 GCancellable  *cancellable,
@@ -221,6 +221,25 @@ g_file_monitor_source_remove_pending_change (GFileMonitorSource *fms,
   g_sequence_remove (iter);
 }
 
+/* With %G_FILE_MONITOR_WATCH_RECURSIVE, @child may be a relative path
+ * rather than a basename */
+static GFile *
+g_file_monitor_source_new_child (const gchar *dirname,
+                                 const gchar *child)
+{
+  gchar *filename;
+  GFile *file;
+
+  if (strchr (child, G_DIR_SEPARATOR) == NULL)
+    return g_local_file_new_from_dirname_and_basename (dirname, child);
+
+  filename = g_build_filename (dirname, child, NULL);
+  file = _g_local_file_new (filename);
+  g_free (filename);
+
+  return file;
+}
+
 static void
 g_file_monitor_source_queue_event (GFileMonitorSource *fms,
                                    GFileMonitorEvent   event_type,
@@ -232,7 +251,7 @@ g_file_monitor_source_queue_event (GFileMonitorSource *fms,
   event = g_slice_new (QueuedEvent);
   event->event_type = event_type;
   if (child != NULL && fms->dirname != NULL)
-    event->child = g_local_file_new_from_dirname_and_basename (fms->dirname, child);
+    event->child = g_file_monitor_source_new_child (fms->dirname, child);
   else if (child != NULL)
     {
       gchar *dirname = g_path_get_dirname (fms->filename);
@@ -509,6 +528,104 @@ g_file_monitor_source_set_rate_limit (GFileMonitorSource *fms,
   return changed;
 }
 
+static void
+file_monitor_change_clear (gpointer data)
+{
+  GFileMonitorChange *change = data;
+
+  g_clear_object (&change->file);
+  g_clear_object (&change->other_file);
+}
+
+/* Turns the queued events into an array of changes, dropping the ones
+ * which tell nothing new about a file already in the batch:
+ *
+ *  - CHANGED right after CREATED or CHANGED
+ *  - a repeated CHANGES_DONE_HINT or ATTRIBUTE_CHANGED
+ *  - CREATED right followed by DELETED, which are both dropped
+ *
+ * Events involving another file (moves and renames) are kept as they
+ * are, and end the run of events of their file.
+ */
+static GArray *
+g_file_monitor_source_coalesce_events (GQueue *event_queue)
+{
+  GHashTable *last_change;
+  GArray *changes;
+  QueuedEvent *event;
+  guint i, j;
+
+  changes = g_array_sized_new (FALSE, FALSE, sizeof (GFileMonitorChange), event_queue->length);
+
+  /* child -> index of its last change in @changes, plus one */
+  last_change = g_hash_table_new (g_file_hash, (GEqualFunc) g_file_equal);
+
+  while ((event = g_queue_pop_head (event_queue)))
+    {
+      GFileMonitorChange change = { event->child, event->other, event->event_type };
+      GFileMonitorChange *last = NULL;
+      guint index;
+
+      g_slice_free (QueuedEvent, event);
+
+      index = GPOINTER_TO_UINT (g_hash_table_lookup (last_change, change.file));
+      if (index > 0)
+        last = &g_array_index (changes, GFileMonitorChange, index - 1);
+
+      if (last != NULL && change.other_file == NULL &&
+          ((change.event_type == G_FILE_MONITOR_EVENT_CHANGED &&
+            (last->event_type == G_FILE_MONITOR_EVENT_CREATED ||
+             last->event_type == G_FILE_MONITOR_EVENT_CHANGED)) ||
+           (change.event_type == G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT &&
+            last->event_type == G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT) ||
+           (change.event_type == G_FILE_MONITOR_EVENT_ATTRIBUTE_CHANGED &&
+            last->event_type == G_FILE_MONITOR_EVENT_ATTRIBUTE_CHANGED)))
+        {
+          file_monitor_change_clear (&change);
+          continue;
+        }
+
+      if (last != NULL && change.other_file == NULL &&
+          change.event_type == G_FILE_MONITOR_EVENT_DELETED &&
+          last->event_type == G_FILE_MONITOR_EVENT_CREATED)
+        {
+          /* keep the key alive until it is removed from the table */
+          g_hash_table_remove (last_change, change.file);
+          file_monitor_change_clear (last);
+          file_monitor_change_clear (&change);
+          continue;
+        }
+
+      g_array_append_val (changes, change);
+
+      if (change.other_file == NULL)
+        g_hash_table_replace (last_change, change.file, GUINT_TO_POINTER (changes->len));
+      else
+        g_hash_table_remove (last_change, change.file);
+    }
+
+  g_hash_table_unref (last_change);
+
+  /* Squeeze out the dropped pairs */
+  for (i = 0, j = 0; i < changes->len; i++)
+    {
+      GFileMonitorChange *change = &g_array_index (changes, GFileMonitorChange, i);
+
+      if (change->file == NULL)
+        continue;
+
+      if (i != j)
+        g_array_index (changes, GFileMonitorChange, j) = *change;
+      j++;
+    }
+
+  /* Only set now, as the moved entries must not be cleared again */
+  g_array_set_size (changes, j);
+  g_array_set_clear_func (changes, file_monitor_change_clear);
+
+  return changes;
+}
+
 static gboolean
 g_file_monitor_source_dispatch (GSource     *source,
                                 GSourceFunc  callback,
@@ -571,6 +688,20 @@ g_file_monitor_source_dispatch (GSource     *source,
   g_file_monitor_source_update_ready_time (fms);
 
   g_mutex_unlock (&fms->lock);
+
+  /* With batching, deliver everything in one emission */
+  if (g_file_monitor_get_batching (instance))
+    {
+      GArray *changes;
+
+      changes = g_file_monitor_source_coalesce_events (&event_queue);
+      g_file_monitor_emit_changes (instance, changes);
+      g_array_unref (changes);
+      g_clear_object (&instance);
+
+      return TRUE;
+    }
+
   g_clear_object (&instance);
 
   /* We now have our list of events to deliver */
@@ -859,12 +990,31 @@ static void g_local_file_monitor_class_init (GLocalFileMonitorClass *class)
 }
 
 static GLocalFileMonitor *
-g_local_file_monitor_new (gboolean   is_remote_fs,
-                          gboolean   is_directory,
-                          GError   **error)
+g_local_file_monitor_new (gboolean            is_remote_fs,
+                          gboolean            is_directory,
+                          GFileMonitorFlags   flags,
+                          GError            **error)
 {
   GType type = G_TYPE_INVALID;
 
+  /* Only some backends can watch a whole tree, and there is no sensible
+   * fallback short of watching every directory */
+  if (is_directory && (flags & G_FILE_MONITOR_WATCH_RECURSIVE))
+    {
+      type = _g_io_module_get_default_type (G_RECURSIVE_FILE_MONITOR_EXTENSION_POINT_NAME,
+                                            "GIO_USE_FILE_MONITOR",
+                                            G_STRUCT_OFFSET (GLocalFileMonitorClass, is_supported));
+
+      if (type == G_TYPE_INVALID)
+        {
+          g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                               _("Recursive file monitoring is not supported"));
+          return NULL;
+        }
+
+      return g_object_new (type, NULL);
+    }
+
   if (is_remote_fs)
     type = _g_io_module_get_default_type (G_NFS_FILE_MONITOR_EXTENSION_POINT_NAME,
                                           "GIO_USE_FILE_MONITOR",
@@ -897,7 +1047,7 @@ g_local_file_monitor_new_for_path (const gchar        *pathname,
 
   is_remote_fs = g_local_file_is_nfs_home (pathname);
 
-  monitor = g_local_file_monitor_new (is_remote_fs, is_directory, error);
+  monitor = g_local_file_monitor_new (is_remote_fs, is_directory, flags, error);
 
   if (monitor)
     g_local_file_monitor_start (monitor, pathname, is_directory, flags, g_main_context_get_thread_default ());
@@ -919,7 +1069,7 @@ g_local_file_monitor_new_in_worker (const gchar           *pathname,
 
   is_remote_fs = g_local_file_is_nfs_home (pathname);
 
-  monitor = g_local_file_monitor_new (is_remote_fs, is_directory, error);
+  monitor = g_local_file_monitor_new (is_remote_fs, is_directory, flags, error);
 
   if (monitor)
     {
@@ -51,6 +51,10 @@
 #include "glib-private.h"
 #include "gioprivate.h"
 
+#ifdef HAVE_LINUX_IO_URING_H
+#include "giouring-private.h"
+#endif
+
 #ifdef G_OS_WIN32
 #include <io.h>
 #ifndef S_ISDIR
@@ -119,6 +123,15 @@ static gboolean   g_local_file_output_stream_writev       (GOutputStream       *
 static gboolean   g_local_file_output_stream_close        (GOutputStream      *stream,
 							   GCancellable       *cancellable,
 							   GError            **error);
+#ifdef HAVE_LINUX_IO_URING_H
+static void       g_local_file_output_stream_write_async  (GOutputStream      *stream,
+							   const void         *buffer,
+							   gsize               count,
+							   int                 io_priority,
+							   GCancellable       *cancellable,
+							   GAsyncReadyCallback callback,
+							   gpointer            user_data);
+#endif
 static GFileInfo *g_local_file_output_stream_query_info   (GFileOutputStream  *stream,
 							   const char         *attributes,
 							   GCancellable       *cancellable,
@@ -169,6 +182,9 @@ g_local_file_output_stream_class_init (GLocalFileOutputStreamClass *klass)
   stream_class->writev_fn = g_local_file_output_stream_writev;
 #endif
   stream_class->close_fn = g_local_file_output_stream_close;
+#ifdef HAVE_LINUX_IO_URING_H
+  stream_class->write_async = g_local_file_output_stream_write_async;
+#endif
   file_stream_class->query_info = g_local_file_output_stream_query_info;
   file_stream_class->get_etag = g_local_file_output_stream_get_etag;
   file_stream_class->tell = g_local_file_output_stream_tell;
@@ -229,6 +245,38 @@ g_local_file_output_stream_write (GOutputStream  *stream,
   return res;
 }
 
+#ifdef HAVE_LINUX_IO_URING_H
+static void
+g_local_file_output_stream_write_async (GOutputStream       *stream,
+                                        const void          *buffer,
+                                        gsize                count,
+                                        int                  io_priority,
+                                        GCancellable        *cancellable,
+                                        GAsyncReadyCallback  callback,
+                                        gpointer             user_data)
+{
+  GLocalFileOutputStream *file = G_LOCAL_FILE_OUTPUT_STREAM (stream);
+  GIOUring *ring;
+  GTask *task;
+
+  /* Without io_uring, write in a thread of the GTask pool */
+  ring = g_io_uring_get_for_context (g_main_context_get_thread_default ());
+  if (ring == NULL)
+    {
+      G_OUTPUT_STREAM_CLASS (g_local_file_output_stream_parent_class)->
+        write_async (stream, buffer, count, io_priority, cancellable, callback, user_data);
+      return;
+    }
+
+  task = g_task_new (stream, cancellable, callback, user_data);
+  g_task_set_source_tag (task, g_local_file_output_stream_write_async);
+  g_task_set_priority (task, io_priority);
+
+  g_io_uring_file_write (ring, file->priv->fd, buffer, count, task);
+  g_object_unref (task);
+}
+#endif
+
 /* On Windows there is no equivalent API for files. The closest API to that is
  * WriteFileGather() but it is useless in general: it requires, among other
  * things, that each chunk is the size of a whole page and in memory aligned
@@ -28,6 +28,7 @@
 #include "string.h"
 #include "gtask.h"
 #include "gioerror.h"
+#include "gioprivate.h"
 #include "glibintl.h"
 
 
@@ -41,10 +42,18 @@
  * [iface@Gio.PollableInputStream].
  */
 
+typedef struct {
+  GBytes       *bytes;
+  const guint8 *data;
+  gsize         size;
+  gsize         offset; /* Position of the first byte in the stream */
+} Chunk;
+
 struct _GMemoryInputStreamPrivate {
-  GSList *chunks;
+  GArray *chunks; /* (element-type Chunk), never empty ones */
   gsize   len;
   gsize   pos;
+  guint   cursor; /* Index of the chunk last read from */
 };
 
 static gssize   g_memory_input_stream_read         (GInputStream         *stream,
@@ -136,7 +145,7 @@ g_memory_input_stream_finalize (GObject *object)
   stream = G_MEMORY_INPUT_STREAM (object);
   priv = stream->priv;
 
-  g_slist_free_full (priv->chunks, (GDestroyNotify)g_bytes_unref);
+  g_array_unref (priv->chunks);
 
   G_OBJECT_CLASS (g_memory_input_stream_parent_class)->finalize (object);
 }
@@ -158,10 +167,20 @@ g_memory_input_stream_pollable_iface_init (GPollableInputStreamInterface *iface)
   iface->create_source = g_memory_input_stream_create_source;
 }
 
+static void
+chunk_clear (gpointer data)
+{
+  Chunk *chunk = data;
+
+  g_bytes_unref (chunk->bytes);
+}
+
 static void
 g_memory_input_stream_init (GMemoryInputStream *stream)
 {
   stream->priv = g_memory_input_stream_get_instance_private (stream);
+  stream->priv->chunks = g_array_new (FALSE, FALSE, sizeof (Chunk));
+  g_array_set_clear_func (stream->priv->chunks, chunk_clear);
 }
 
 /**
@@ -274,14 +293,110 @@ g_memory_input_stream_add_bytes (GMemoryInputStream *stream,
 				 GBytes             *bytes)
 {
   GMemoryInputStreamPrivate *priv;
+  Chunk chunk;
  
   g_return_if_fail (G_IS_MEMORY_INPUT_STREAM (stream));
   g_return_if_fail (bytes != NULL);
 
   priv = stream->priv;
 
-  priv->chunks = g_slist_append (priv->chunks, g_bytes_ref (bytes));
-  priv->len += g_bytes_get_size (bytes);
+  chunk.data = g_bytes_get_data (bytes, &chunk.size);
+  if (chunk.size == 0)
+    return;
+
+  chunk.bytes = g_bytes_ref (bytes);
+  chunk.offset = priv->len;
+  g_array_append_val (priv->chunks, chunk);
+  priv->len += chunk.size;
+}
+
+static void
+chain_unref (gpointer data)
+{
+  g_bytes_chain_unref (data);
+}
+
+/**
+ * g_memory_input_stream_add_bytes_chain:
+ * @stream: a #GMemoryInputStream
+ * @chain: input data
+ *
+ * Appends all the data in @chain to data that can be read from the input
+ * stream, without copying it.
+ *
+ * This is equivalent to, but cheaper than, calling
+ * g_memory_input_stream_add_bytes() for each chunk of @chain.
+ *
+ * Since: 2.82
+ */
+void
+g_memory_input_stream_add_bytes_chain (GMemoryInputStream *stream,
+                                       GBytesChain        *chain)
+{
+  GMemoryInputStreamPrivate *priv;
+  const GBytesChainVector *vectors;
+  gsize n_vectors, i;
+  Chunk chunk;
+
+  g_return_if_fail (G_IS_MEMORY_INPUT_STREAM (stream));
+  g_return_if_fail (chain != NULL);
+
+  priv = stream->priv;
+
+  vectors = g_bytes_chain_get_vectors (chain, &n_vectors);
+
+  /* Each chunk keeps the whole chain alive */
+  for (i = 0; i < n_vectors; i++)
+    {
+      chunk.data = vectors[i].buffer;
+      chunk.size = vectors[i].size;
+      chunk.bytes = g_bytes_new_with_free_func (chunk.data, chunk.size,
+                                                chain_unref,
+                                                g_bytes_chain_ref (chain));
+      chunk.offset = priv->len;
+      g_array_append_val (priv->chunks, chunk);
+      priv->len += chunk.size;
+    }
+}
+
+/* Returns the index of the chunk holding the byte at the current position,
+ * which must be before the end of the stream. Reads usually continue in
+ * the chunk last read from, or the one after it, so those are tried before
+ * searching all chunks. */
+static guint
+find_chunk (GMemoryInputStreamPrivate *priv)
+{
+  Chunk *chunks = (Chunk *) priv->chunks->data;
+  guint low, high, mid;
+
+  g_assert (priv->pos < priv->len);
+
+  if (priv->cursor < priv->chunks->len &&
+      chunks[priv->cursor].offset <= priv->pos)
+    {
+      if (priv->pos < chunks[priv->cursor].offset + chunks[priv->cursor].size)
+        return priv->cursor;
+
+      if (priv->cursor + 1 < priv->chunks->len &&
+          priv->pos < chunks[priv->cursor + 1].offset + chunks[priv->cursor + 1].size)
+        return ++priv->cursor;
+    }
+
+  /* Find the last chunk starting at or before the position */
+  low = 0;
+  high = priv->chunks->len - 1;
+  while (low < high)
+    {
+      mid = low + (high - low + 1) / 2;
+      if (chunks[mid].offset <= priv->pos)
+        low = mid;
+      else
+        high = mid - 1;
+    }
+
+  priv->cursor = low;
+
+  return low;
 }
 
 static gssize
@@ -293,46 +408,37 @@ g_memory_input_stream_read (GInputStream  *stream,
 {
   GMemoryInputStream *memory_stream;
   GMemoryInputStreamPrivate *priv;
-  GSList *l;
-  GBytes *chunk;
-  gsize len;
-  gsize offset, start, rest, size;
+  Chunk *chunk;
+  gsize start, rest, size;
+  guint i;
 
   memory_stream = G_MEMORY_INPUT_STREAM (stream);
   priv = memory_stream->priv;
 
   count = MIN (count, priv->len - priv->pos);
+  if (count == 0)
+    return 0;
 
-  offset = 0;
-  for (l = priv->chunks; l; l = l->next) 
-    {
-      chunk = (GBytes *)l->data;
-      len = g_bytes_get_size (chunk);
-
-      if (offset + len > priv->pos)
-        break;
-
-      offset += len;
-    }
-  
-  start = priv->pos - offset;
+  i = find_chunk (priv);
+  chunk = &g_array_index (priv->chunks, Chunk, i);
+  start = priv->pos - chunk->offset;
   rest = count;
 
-  for (; l && rest > 0; l = l->next)
+  while (TRUE)
     {
-      const guint8* chunk_data;
-      chunk = (GBytes *)l->data;
-
-      chunk_data = g_bytes_get_data (chunk, &len);
+      size = MIN (rest, chunk->size - start);
 
-      size = MIN (rest, len - start);
-
-      memcpy ((guint8 *)buffer + (count - rest), chunk_data + start, size);
+      memcpy ((guint8 *)buffer + (count - rest), chunk->data + start, size);
       rest -= size;
 
+      if (rest == 0)
+        break;
+
+      chunk = &g_array_index (priv->chunks, Chunk, ++i);
       start = 0;
     }
 
+  priv->cursor = i;
   priv->pos += count;
 
   return count;
@@ -356,6 +462,39 @@ g_memory_input_stream_skip (GInputStream  *stream,
   return count;
 }
 
+/*
+ * g_memory_input_stream_peek:
+ * @stream: a #GMemoryInputStream
+ * @size: (out): return location for the size of the data
+ *
+ * Returns the data that the next read from @stream will return, up to the
+ * end of the current chunk, without consuming it. Use g_input_stream_skip()
+ * to consume it afterwards.
+ *
+ * Returns: (nullable): the data, or %NULL if there is none, or if @stream
+ *   is a subclass which overrides reading
+ */
+const void *
+g_memory_input_stream_peek (GMemoryInputStream *stream,
+                            gsize              *size)
+{
+  GMemoryInputStreamPrivate *priv;
+  Chunk *chunk;
+
+  priv = stream->priv;
+  *size = 0;
+
+  if (G_INPUT_STREAM_GET_CLASS (stream)->read_fn != g_memory_input_stream_read ||
+      G_INPUT_STREAM_GET_CLASS (stream)->skip != g_memory_input_stream_skip ||
+      priv->pos >= priv->len)
+    return NULL;
+
+  chunk = &g_array_index (priv->chunks, Chunk, find_chunk (priv));
+  *size = chunk->offset + chunk->size - priv->pos;
+
+  return chunk->data + (priv->pos - chunk->offset);
+}
+
 static gboolean
 g_memory_input_stream_close (GInputStream  *stream,
                              GCancellable  *cancellable,
@@ -81,6 +81,9 @@ void           g_memory_input_stream_add_data      (GMemoryInputStream *stream,
 GIO_AVAILABLE_IN_2_34
 void           g_memory_input_stream_add_bytes     (GMemoryInputStream     *stream,
 						    GBytes                 *bytes);
+GIO_AVAILABLE_IN_2_82
+void           g_memory_input_stream_add_bytes_chain (GMemoryInputStream   *stream,
+                                                      GBytesChain          *chain);
 
 G_END_DECLS
 
@@ -59,6 +59,10 @@
  * See [type@Gio.MemoryMonitorWarningLevel] for details on the various warning
  * levels.
  *
+ * Caches registered with [func@GLib.mem_cache_register], including some of
+ * GIO’s own, are trimmed by the default handler of the signal, as long as the
+ * application holds a reference to the default `GMemoryMonitor`.
+ *
  * ```c
  * static void
  * warning_cb (GMemoryMonitor *m, GMemoryMonitorWarningLevel level)
@@ -123,9 +127,21 @@ g_memory_monitor_dup_default (void)
                                                  NULL));
 }
 
+static void
+g_memory_monitor_real_low_memory_warning (GMemoryMonitor             *monitor,
+                                          GMemoryMonitorWarningLevel  level)
+{
+  /* Cached type instances are only there for speed */
+  g_type_trim_instance_caches ();
+
+  g_mem_cache_trim (level);
+}
+
 static void
 g_memory_monitor_default_init (GMemoryMonitorInterface *iface)
 {
+  iface->low_memory_warning = g_memory_monitor_real_low_memory_warning;
+
   /**
    * GMemoryMonitor::low-memory-warning:
    * @monitor: a #GMemoryMonitor
@@ -136,6 +152,11 @@ g_memory_monitor_default_init (GMemoryMonitorInterface *iface)
    * warning level. See the #GMemoryMonitorWarningLevel documentation for
    * details.
    *
+   * The default handler frees the instances cached through
+   * g_type_set_instance_cache_size(), and trims the caches registered with
+   * g_mem_cache_register() whose priority is at most @level. This includes
+   * caches within GIO, such as the decompressed data of #GResource files.
+   *
    * Since: 2.64
    */
   signals[LOW_MEMORY_WARNING] =
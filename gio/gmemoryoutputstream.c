@@ -33,6 +33,12 @@
 #include "glibintl.h"
 #include "gutilsprivate.h"
 
+#if defined(HAVE_MMAP) && defined(HAVE_MREMAP)
+#include <sys/mman.h>
+#include <unistd.h>
+#define USE_MREMAP 1
+#endif
+
 
 /**
  * GMemoryOutputStream:
@@ -46,6 +52,12 @@
 
 #define MIN_ARRAY_SIZE  16
 
+/* Resizable streams using the default allocator switch to anonymous
+ * mappings once they grow this large. Mappings are grown with mremap(),
+ * which moves pages instead of copying them, and the kernel zero-fills
+ * new pages lazily, so untouched capacity does not use memory. */
+#define MAP_THRESHOLD   (1024 * 1024)
+
 enum {
   PROP_0,
   PROP_DATA,
@@ -65,6 +77,9 @@ struct _GMemoryOutputStreamPrivate
 
   GReallocFunc   realloc_fn;
   GDestroyNotify destroy;
+
+  gsize          map_len; /* Size of the mapping @data points to, or 0 if
+                             @data was allocated with @realloc_fn */
 };
 
 static void     g_memory_output_stream_set_property (GObject      *object,
@@ -77,6 +92,11 @@ static void     g_memory_output_stream_get_property (GObject      *object,
                                                      GParamSpec   *pspec);
 static void     g_memory_output_stream_finalize     (GObject      *object);
 
+static gboolean array_resize (GMemoryOutputStream  *ostream,
+                              gsize                 size,
+                              gboolean              allow_partial,
+                              GError              **error);
+
 static gssize   g_memory_output_stream_write       (GOutputStream *stream,
                                                     const void    *buffer,
                                                     gsize          count,
@@ -293,7 +313,14 @@ g_memory_output_stream_finalize (GObject *object)
   stream = G_MEMORY_OUTPUT_STREAM (object);
   priv = stream->priv;
   
-  if (priv->destroy)
+  if (priv->map_len > 0)
+    {
+#ifdef USE_MREMAP
+      if (priv->data != NULL)
+        munmap (priv->data, priv->map_len);
+#endif
+    }
+  else if (priv->destroy)
     priv->destroy (priv->data);
 
   G_OBJECT_CLASS (g_memory_output_stream_parent_class)->finalize (object);
@@ -472,6 +499,54 @@ g_memory_output_stream_get_data_size (GMemoryOutputStream *ostream)
   return ostream->priv->valid_len;
 }
 
+/**
+ * g_memory_output_stream_reserve:
+ * @ostream: a #GMemoryOutputStream
+ * @size: the number of bytes to reserve
+ * @error: a #GError location to store the error occurring, or %NULL to
+ *     ignore
+ *
+ * Makes sure that @size bytes can be written at the current position of
+ * @ostream without the stream having to grow its buffer.
+ *
+ * Growing a buffer may move its contents, so if the final size of the
+ * data is known in advance, reserving it first avoids repeated copies.
+ *
+ * If @ostream is fixed-sized and smaller than needed, or the memory
+ * cannot be allocated, %G_IO_ERROR_NO_SPACE is returned.
+ *
+ * Returns: %TRUE on success, %FALSE on error
+ *
+ * Since: 2.82
+ */
+gboolean
+g_memory_output_stream_reserve (GMemoryOutputStream  *ostream,
+                                gsize                 size,
+                                GError              **error)
+{
+  GMemoryOutputStreamPrivate *priv;
+
+  g_return_val_if_fail (G_IS_MEMORY_OUTPUT_STREAM (ostream), FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  priv = ostream->priv;
+
+  if (priv->pos + size < priv->pos)
+    {
+      g_set_error_literal (error,
+                           G_IO_ERROR,
+                           G_IO_ERROR_NO_SPACE,
+                           _("Amount of memory required to process the write is "
+                             "larger than available address space"));
+      return FALSE;
+    }
+
+  if (priv->pos + size <= priv->len)
+    return TRUE;
+
+  return array_resize (ostream, priv->pos + size, FALSE, error);
+}
+
 /**
  * g_memory_output_stream_steal_data:
  * @ostream: a #GMemoryOutputStream
@@ -483,6 +558,10 @@ g_memory_output_stream_get_data_size (GMemoryOutputStream *ostream)
  *
  * @ostream must be closed before calling this function.
  *
+ * Large streams using the default allocator may keep their data in
+ * memory which cannot be freed with g_free(), in which case it is copied
+ * here. Use g_memory_output_stream_steal_as_bytes() to avoid that.
+ *
  * Returns: (transfer full): the stream's data, or %NULL if it has previously
  *    been stolen
  *
@@ -499,9 +578,105 @@ g_memory_output_stream_steal_data (GMemoryOutputStream *ostream)
   data = ostream->priv->data;
   ostream->priv->data = NULL;
 
+#ifdef USE_MREMAP
+  if (ostream->priv->map_len > 0 && data != NULL)
+    {
+      gpointer mapping = data;
+
+      /* The caller frees the data with g_free(), so it has to be copied
+       * out of the mapping; g_memory_output_stream_steal_as_bytes()
+       * avoids this */
+      data = g_malloc (ostream->priv->valid_len + 1);
+      memcpy (data, mapping, ostream->priv->valid_len);
+      ((guint8 *) data)[ostream->priv->valid_len] = 0;
+      munmap (mapping, ostream->priv->map_len);
+      ostream->priv->map_len = 0;
+    }
+#endif
+
   return data;
 }
 
+#ifdef USE_MREMAP
+typedef struct
+{
+  gpointer data;
+  gsize size;
+} Mapping;
+
+static void
+mapping_free (gpointer user_data)
+{
+  Mapping *mapping = user_data;
+
+  munmap (mapping->data, mapping->size);
+  g_free (mapping);
+}
+
+static gsize
+round_to_pages (gsize size)
+{
+  static gsize page_size = 0;
+
+  if (page_size == 0)
+    page_size = sysconf (_SC_PAGESIZE);
+
+  return (size + page_size - 1) & ~(page_size - 1);
+}
+
+/* Moves the stream's data into a mapping of at least @size bytes, or
+ * resizes the existing one. New memory in the mapping reads as zeroes. */
+static gboolean
+mapping_resize (GMemoryOutputStreamPrivate *priv,
+                gsize                       size)
+{
+  gsize map_len;
+  gpointer data;
+
+  if (size == 0)
+    {
+      munmap (priv->data, priv->map_len);
+      priv->data = NULL;
+      priv->map_len = 0;
+      return TRUE;
+    }
+
+  map_len = round_to_pages (size);
+  if (map_len < size)
+    return FALSE;
+
+  if (priv->map_len == 0)
+    {
+      data = mmap (NULL, map_len, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (data == MAP_FAILED)
+        return FALSE;
+
+      if (priv->data != NULL)
+        memcpy (data, priv->data, MIN (priv->len, size));
+      priv->destroy (priv->data);
+    }
+  else if (map_len != priv->map_len)
+    {
+      data = mremap (priv->data, priv->map_len, map_len, MREMAP_MAYMOVE);
+      if (data == MAP_FAILED)
+        return FALSE;
+    }
+  else
+    data = priv->data;
+
+  /* Bytes past the old length which were already mapped may hold data
+   * that was truncated away */
+  if (size > priv->len && priv->map_len > priv->len)
+    memset ((guint8 *) data + priv->len, 0, MIN (size, priv->map_len) - priv->len);
+
+  priv->data = data;
+  priv->map_len = map_len;
+
+  return TRUE;
+}
+#endif
+
 /**
  * g_memory_output_stream_steal_as_bytes:
  * @ostream: a #GMemoryOutputStream
@@ -509,6 +684,8 @@ g_memory_output_stream_steal_data (GMemoryOutputStream *ostream)
  * Returns data from the @ostream as a #GBytes. @ostream must be
  * closed before calling this function.
  *
+ * The data is not copied, whichever allocator the stream uses.
+ *
  * Returns: (transfer full): the stream's data
  *
  * Since: 2.34
@@ -521,6 +698,33 @@ g_memory_output_stream_steal_as_bytes (GMemoryOutputStream *ostream)
   g_return_val_if_fail (G_IS_MEMORY_OUTPUT_STREAM (ostream), NULL);
   g_return_val_if_fail (g_output_stream_is_closed (G_OUTPUT_STREAM (ostream)), NULL);
 
+#ifdef USE_MREMAP
+  if (ostream->priv->map_len > 0 && ostream->priv->data != NULL)
+    {
+      Mapping *mapping;
+      gsize map_len;
+
+      mapping = g_new (Mapping, 1);
+      mapping->data = ostream->priv->data;
+      mapping->size = ostream->priv->map_len;
+
+      /* Give back the unused capacity; shrinking never moves the mapping */
+      map_len = round_to_pages (MAX (ostream->priv->valid_len, 1));
+      if (map_len < mapping->size &&
+          mremap (mapping->data, mapping->size, map_len, 0) != MAP_FAILED)
+        mapping->size = map_len;
+
+      result = g_bytes_new_with_free_func (mapping->data,
+                                           ostream->priv->valid_len,
+                                           mapping_free,
+                                           mapping);
+      ostream->priv->data = NULL;
+      ostream->priv->map_len = 0;
+
+      return result;
+    }
+#endif
+
   result = g_bytes_new_with_free_func (ostream->priv->data,
                                        ostream->priv->valid_len,
                                        ostream->priv->destroy,
@@ -558,6 +762,34 @@ array_resize (GMemoryOutputStream  *ostream,
       return FALSE;
     }
 
+#ifdef USE_MREMAP
+  if (priv->map_len > 0 ||
+      (size >= MAP_THRESHOLD &&
+       priv->realloc_fn == g_realloc &&
+       priv->destroy == g_free))
+    {
+      if (!mapping_resize (priv, size))
+        {
+          if (allow_partial &&
+              priv->pos < priv->len)
+            return TRUE; /* Short write */
+
+          g_set_error_literal (error,
+                               G_IO_ERROR,
+                               G_IO_ERROR_NO_SPACE,
+                               _("Failed to resize memory output stream"));
+          return FALSE;
+        }
+
+      priv->len = size;
+
+      if (priv->len < priv->valid_len)
+        priv->valid_len = priv->len;
+
+      return TRUE;
+    }
+#endif
+
   len = priv->len;
   data = priv->realloc_fn (priv->data, size);
 
@@ -95,6 +95,10 @@ GIO_AVAILABLE_IN_ALL
 gsize          g_memory_output_stream_get_data_size (GMemoryOutputStream *ostream);
 GIO_AVAILABLE_IN_ALL
 gpointer       g_memory_output_stream_steal_data    (GMemoryOutputStream *ostream);
+GIO_AVAILABLE_IN_2_82
+gboolean       g_memory_output_stream_reserve       (GMemoryOutputStream *ostream,
+                                                     gsize                size,
+                                                     GError             **error);
 
 GIO_AVAILABLE_IN_2_34
 GBytes *       g_memory_output_stream_steal_as_bytes (GMemoryOutputStream *ostream);
@@ -26,6 +26,7 @@
 #include "gdbusmethodinvocation.h"
 #include "gdbusintrospection.h"
 #include "gdbusnamewatching.h"
+#include "gdbusprivate.h"
 #include "gdbuserror.h"
 
 /* {{{1 D-Bus Interface description */
@@ -553,6 +554,7 @@ g_menu_exporter_remote_new (GMenuExporter *exporter,
 struct _GMenuExporter
 {
   GDBusConnection *connection;
+  GMainContext *context;
   gchar *object_path;
   guint registration_id;
   GHashTable *groups;
@@ -561,6 +563,11 @@ struct _GMenuExporter
   GMenuExporterMenu *root;
   GMenuExporterRemote *peer_remote;
   GHashTable *remotes;
+
+  /* (element-type GVariant): changes not sent yet, in order */
+  GPtrArray *pending_reports;
+  GSource *pending_source;
+  guint flush_interval;
 };
 
 static void
@@ -650,23 +657,69 @@ g_menu_exporter_unsubscribe (GMenuExporter *exporter,
     }
 }
 
-static void
-g_menu_exporter_report (GMenuExporter *exporter,
-                        GVariant      *report)
+static gboolean
+g_menu_exporter_dispatch_reports (gpointer user_data)
 {
+  GMenuExporter *exporter = user_data;
   GVariantBuilder builder;
+  guint i;
 
   g_variant_builder_init (&builder, G_VARIANT_TYPE_TUPLE);
-  g_variant_builder_open (&builder, G_VARIANT_TYPE_ARRAY);
-  g_variant_builder_add_value (&builder, report);
+  g_variant_builder_open (&builder, G_VARIANT_TYPE ("a(uuuuaa{sv})"));
+  for (i = 0; i < exporter->pending_reports->len; i++)
+    g_variant_builder_add_value (&builder, g_ptr_array_index (exporter->pending_reports, i));
   g_variant_builder_close (&builder);
 
+  g_ptr_array_set_size (exporter->pending_reports, 0);
+
   g_dbus_connection_emit_signal (exporter->connection,
                                  NULL,
                                  exporter->object_path,
                                  "org.gtk.Menus", "Changed",
                                  g_variant_builder_end (&builder),
                                  NULL);
+
+  exporter->pending_source = NULL;
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Sends the pending changes right away; this must be done before
+ * replying to a subscription, whose reply already contains them */
+static void
+g_menu_exporter_flush_reports (GMenuExporter *exporter)
+{
+  if (exporter->pending_source)
+    {
+      g_source_destroy (exporter->pending_source);
+      g_menu_exporter_dispatch_reports (exporter);
+      g_assert (exporter->pending_source == NULL);
+    }
+}
+
+/* Queues @report, so that all the changes made to the menus until the
+ * main context is idle, or until the flush interval has passed, are sent
+ * in a single Changed signal, in the order they were made */
+static void
+g_menu_exporter_report (GMenuExporter *exporter,
+                        GVariant      *report)
+{
+  g_ptr_array_add (exporter->pending_reports, g_variant_ref_sink (report));
+
+  if (exporter->pending_source == NULL)
+    {
+      GSource *source;
+
+      if (exporter->flush_interval > 0)
+        source = g_timeout_source_new (exporter->flush_interval);
+      else
+        source = g_idle_source_new ();
+      exporter->pending_source = source;
+      g_source_set_callback (source, g_menu_exporter_dispatch_reports, exporter, NULL);
+      g_source_set_static_name (source, "[gio] g_menu_exporter_dispatch_reports");
+      g_source_attach (source, exporter->context);
+      g_source_unref (source);
+    }
 }
 
 static void
@@ -713,6 +766,10 @@ g_menu_exporter_free (GMenuExporter *exporter)
   g_clear_pointer (&exporter->peer_remote, g_menu_exporter_remote_free);
   g_hash_table_unref (exporter->remotes);
   g_hash_table_unref (exporter->groups);
+  if (exporter->pending_source)
+    g_source_destroy (exporter->pending_source);
+  g_ptr_array_unref (exporter->pending_reports);
+  g_main_context_unref (exporter->context);
   g_object_unref (exporter->connection);
   g_free (exporter->object_path);
 
@@ -734,6 +791,8 @@ g_menu_exporter_method_call (GDBusConnection       *connection,
 
   group_ids = g_variant_get_child_value (parameters, 0);
 
+  g_menu_exporter_flush_reports (exporter);
+
   if (g_str_equal (method_name, "Start"))
     g_dbus_method_invocation_return_value (invocation, g_menu_exporter_subscribe (exporter, sender, group_ids));
 
@@ -771,6 +830,13 @@ g_menu_exporter_method_call (GDBusConnection       *connection,
  * %G_MENU_EXPORTER_MAX_SECTION_SIZE items is not supported and results in
  * undefined behavior.
  *
+ * Menus are only walked once a client subscribes to them, and changes to
+ * them are sent in batches from the thread default main context at the
+ * time of this call, either once it is idle or, if the
+ * `GDBUS_EXPORT_FLUSH_INTERVAL` environment variable is set to a number
+ * of milliseconds, after that interval has passed since the first pending
+ * change.
+ *
  * You can unexport the menu model using
  * g_dbus_connection_unexport_menu_model() with the return value of
  * this function.
@@ -793,7 +859,10 @@ g_dbus_connection_export_menu_model (GDBusConnection  *connection,
 
   exporter = g_slice_new0 (GMenuExporter);
   exporter->connection = g_object_ref (connection);
+  exporter->context = g_main_context_ref_thread_default ();
   exporter->object_path = g_strdup (object_path);
+  exporter->pending_reports = g_ptr_array_new_with_free_func ((GDestroyNotify) g_variant_unref);
+  exporter->flush_interval = _g_dbus_get_export_flush_interval ();
   exporter->groups = g_hash_table_new (NULL, NULL);
   exporter->remotes = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_menu_exporter_remote_free);
 
@@ -20,6 +20,8 @@
 
 #include "config.h"
 
+#include <string.h>
+
 #include "gnetworkmonitorbase.h"
 #include "ginetaddress.h"
 #include "ginetaddressmask.h"
@@ -45,24 +47,41 @@ enum
   PROP_CONNECTIVITY
 };
 
+/* Key for the networks tree: networks are ordered by family, then prefix
+ * length, then (masked) address, so that looking up whether an address is
+ * in a network of a given prefix length is a single O(log n) tree search. */
+typedef struct
+{
+  guint8 family_index;  /* 0 for IPv4, 1 for IPv6 */
+  guint8 length;
+  guint8 bytes[16];
+} NetworkKey;
+
 struct _GNetworkMonitorBasePrivate
 {
-  GHashTable   *networks  /* (element-type GInetAddressMask) (owned) */;
+  GTree        *networks  /* (element-type NetworkKey GInetAddressMask) (owned) */;
+  /* Number of networks with each prefix length, for each family */
+  guint         n_networks_by_length[2][129];
   gboolean      have_ipv4_default_route;
   gboolean      have_ipv6_default_route;
   gboolean      is_available;
 
   GMainContext *context;
   GSource      *network_changed_source;
+  guint         n_pending_changes;
+  guint64       n_coalesced_changes;
   gboolean      initializing;
 };
 
 static guint network_changed_signal = 0;
 
 static void queue_network_changed (GNetworkMonitorBase *monitor);
-static guint inet_address_mask_hash (gconstpointer key);
-static gboolean inet_address_mask_equal (gconstpointer a,
-                                         gconstpointer b);
+static gboolean network_key_init (NetworkKey      *key,
+                                  GInetAddress    *address,
+                                  guint            length);
+static gint network_key_compare (gconstpointer a,
+                                 gconstpointer b,
+                                 gpointer      user_data);
 
 G_DEFINE_TYPE_WITH_CODE (GNetworkMonitorBase, g_network_monitor_base, G_TYPE_OBJECT,
                          G_ADD_PRIVATE (GNetworkMonitorBase)
@@ -80,9 +99,8 @@ static void
 g_network_monitor_base_init (GNetworkMonitorBase *monitor)
 {
   monitor->priv = g_network_monitor_base_get_instance_private (monitor);
-  monitor->priv->networks = g_hash_table_new_full (inet_address_mask_hash,
-                                                   inet_address_mask_equal,
-                                                   g_object_unref, NULL);
+  monitor->priv->networks = g_tree_new_full (network_key_compare, NULL,
+                                             g_free, g_object_unref);
   monitor->priv->context = g_main_context_get_thread_default ();
   if (monitor->priv->context)
     g_main_context_ref (monitor->priv->context);
@@ -156,7 +174,7 @@ g_network_monitor_base_finalize (GObject *object)
 {
   GNetworkMonitorBase *monitor = G_NETWORK_MONITOR_BASE (object);
 
-  g_hash_table_unref (monitor->priv->networks);
+  g_tree_unref (monitor->priv->networks);
   if (monitor->priv->network_changed_source)
     {
       g_source_destroy (monitor->priv->network_changed_source);
@@ -187,18 +205,26 @@ g_network_monitor_base_can_reach_sockaddr (GNetworkMonitorBase *base,
                                            GSocketAddress *sockaddr)
 {
   GInetAddress *iaddr;
-  GHashTableIter iter;
-  gpointer key;
+  const guint *n_networks_by_length;
+  guint length, max_length;
+  NetworkKey key;
 
   if (!G_IS_INET_SOCKET_ADDRESS (sockaddr))
     return FALSE;
 
   iaddr = g_inet_socket_address_get_address (G_INET_SOCKET_ADDRESS (sockaddr));
-  g_hash_table_iter_init (&iter, base->priv->networks);
-  while (g_hash_table_iter_next (&iter, &key, NULL))
+  max_length = g_inet_address_get_native_size (iaddr) * 8;
+
+  /* Rather than matching against every network, look the address up among
+   * the networks of each prefix length in use */
+  for (length = 0; length <= max_length; length++)
     {
-      GInetAddressMask *mask = key;
-      if (g_inet_address_mask_matches (mask, iaddr))
+      if (!network_key_init (&key, iaddr, length))
+        return FALSE;
+
+      n_networks_by_length = base->priv->n_networks_by_length[key.family_index];
+      if (n_networks_by_length[length] > 0 &&
+          g_tree_lookup (base->priv->networks, &key) != NULL)
         return TRUE;
     }
 
@@ -215,7 +241,7 @@ g_network_monitor_base_can_reach (GNetworkMonitor      *monitor,
   GSocketAddressEnumerator *enumerator;
   GSocketAddress *addr;
 
-  if (g_hash_table_size (base->priv->networks) == 0)
+  if (g_tree_nnodes (base->priv->networks) == 0)
     {
       g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NETWORK_UNREACHABLE,
                            _("Network unreachable"));
@@ -320,7 +346,7 @@ g_network_monitor_base_can_reach_async (GNetworkMonitor     *monitor,
   task = g_task_new (monitor, cancellable, callback, user_data);
   g_task_set_source_tag (task, g_network_monitor_base_can_reach_async);
 
-  if (g_hash_table_size (G_NETWORK_MONITOR_BASE (monitor)->priv->networks) == 0)
+  if (g_tree_nnodes (G_NETWORK_MONITOR_BASE (monitor)->priv->networks) == 0)
     {
       g_task_return_new_error_literal (task, G_IO_ERROR, G_IO_ERROR_NETWORK_UNREACHABLE,
                                        _("Network unreachable"));
@@ -372,58 +398,76 @@ g_network_monitor_base_initable_iface_init (GInitableIface *iface)
   iface->init = g_network_monitor_base_initable_init;
 }
 
-static guint
-inet_address_mask_hash (gconstpointer key)
+/* Fills in @key for the network of prefix @length containing @address.
+ * Returns %FALSE if @address is not an IPv4 or IPv6 address. */
+static gboolean
+network_key_init (NetworkKey   *key,
+                  GInetAddress *address,
+                  guint         length)
 {
-  GInetAddressMask *mask = G_INET_ADDRESS_MASK (key);
-  guint addr_hash;
-  guint mask_length = g_inet_address_mask_get_length (mask);
-  GInetAddress *addr = g_inet_address_mask_get_address (mask);
-  const guint8 *bytes = g_inet_address_to_bytes (addr);
-  gsize bytes_length = g_inet_address_get_native_size (addr);
-
-  union
-    {
-      const guint8 *bytes;
-      guint32 *hash32;
-      guint64 *hash64;
-    } integerifier;
-
-  /* If we can fit the entire address into the hash key, do it. Don’t worry
-   * about endianness; the address should always be in network endianness. */
-  if (bytes_length == sizeof (guint32))
-    {
-      integerifier.bytes = bytes;
-      addr_hash = *integerifier.hash32;
-    }
-  else if (bytes_length == sizeof (guint64))
+  const guint8 *bytes = g_inet_address_to_bytes (address);
+  gsize native_size = g_inet_address_get_native_size (address);
+  gsize i;
+
+  switch (g_inet_address_get_family (address))
     {
-      integerifier.bytes = bytes;
-      addr_hash = *integerifier.hash64;
+    case G_SOCKET_FAMILY_IPV4:
+      key->family_index = 0;
+      break;
+    case G_SOCKET_FAMILY_IPV6:
+      key->family_index = 1;
+      break;
+    default:
+      return FALSE;
     }
-  else
+
+  g_assert (native_size <= sizeof (key->bytes));
+  g_assert (length <= native_size * 8);
+
+  key->length = length;
+  memset (key->bytes, 0, sizeof (key->bytes));
+  for (i = 0; i < native_size && length > 0; i++)
     {
-      gsize i;
-
-      /* Otherwise, fall back to adding the bytes together. We do this, rather
-       * than XORing them, as routes often have repeated tuples which would
-       * cancel out under XOR. */
-      addr_hash = 0;
-      for (i = 0; i < bytes_length; i++)
-        addr_hash += bytes[i];
+      if (length >= 8)
+        {
+          key->bytes[i] = bytes[i];
+          length -= 8;
+        }
+      else
+        {
+          key->bytes[i] = bytes[i] & (0xff << (8 - length));
+          length = 0;
+        }
     }
 
-  return addr_hash + mask_length;;
+  return TRUE;
 }
 
-static gboolean
-inet_address_mask_equal (gconstpointer a,
-                         gconstpointer b)
+static NetworkKey *
+network_key_new (GInetAddressMask *network)
 {
-  GInetAddressMask *mask_a = G_INET_ADDRESS_MASK (a);
-  GInetAddressMask *mask_b = G_INET_ADDRESS_MASK (b);
+  NetworkKey *key = g_new (NetworkKey, 1);
 
-  return g_inet_address_mask_equal (mask_a, mask_b);
+  if (!network_key_init (key, g_inet_address_mask_get_address (network),
+                         g_inet_address_mask_get_length (network)))
+    g_clear_pointer (&key, g_free);
+
+  return key;
+}
+
+static gint
+network_key_compare (gconstpointer a,
+                     gconstpointer b,
+                     gpointer      user_data)
+{
+  const NetworkKey *key_a = a, *key_b = b;
+
+  if (key_a->family_index != key_b->family_index)
+    return (key_a->family_index < key_b->family_index) ? -1 : 1;
+  if (key_a->length != key_b->length)
+    return (key_a->length < key_b->length) ? -1 : 1;
+
+  return memcmp (key_a->bytes, key_b->bytes, sizeof (key_a->bytes));
 }
 
 static gboolean
@@ -445,6 +489,14 @@ emit_network_changed (gpointer user_data)
       g_object_notify (G_OBJECT (monitor), "network-available");
     }
 
+  /* Every change after the first one in this batch would have been an
+   * emission of its own without coalescing */
+  monitor->priv->n_coalesced_changes += monitor->priv->n_pending_changes - 1;
+  g_debug ("GNetworkMonitorBase: emitting network-changed for %u changes "
+           "(%" G_GUINT64_FORMAT " coalesced in total)",
+           monitor->priv->n_pending_changes, monitor->priv->n_coalesced_changes);
+  monitor->priv->n_pending_changes = 0;
+
   g_signal_emit (monitor, network_changed_signal, 0, is_available);
 
   g_source_unref (monitor->priv->network_changed_source);
@@ -475,6 +527,9 @@ queue_network_changed (GNetworkMonitorBase *monitor)
       monitor->priv->network_changed_source = source;
     }
 
+  if (monitor->priv->network_changed_source)
+    monitor->priv->n_pending_changes++;
+
   /* Normally we wait to update is_available until we emit the signal,
    * to keep things consistent. But when we're first creating the
    * object, we want it to be correct right away.
@@ -499,9 +554,21 @@ void
 g_network_monitor_base_add_network (GNetworkMonitorBase *monitor,
                                     GInetAddressMask    *network)
 {
-  if (!g_hash_table_add (monitor->priv->networks, g_object_ref (network)))
+  NetworkKey *key;
+
+  key = network_key_new (network);
+  if (key == NULL)
     return;
 
+  if (g_tree_lookup (monitor->priv->networks, key) != NULL)
+    {
+      g_free (key);
+      return;
+    }
+
+  monitor->priv->n_networks_by_length[key->family_index][key->length]++;
+  g_tree_insert (monitor->priv->networks, key, g_object_ref (network));
+
   if (g_inet_address_mask_get_length (network) == 0)
     {
       switch (g_inet_address_mask_get_family (network))
@@ -540,9 +607,15 @@ void
 g_network_monitor_base_remove_network (GNetworkMonitorBase *monitor,
                                        GInetAddressMask    *network)
 {
-  if (!g_hash_table_remove (monitor->priv->networks, network))
+  NetworkKey key;
+
+  if (!network_key_init (&key, g_inet_address_mask_get_address (network),
+                         g_inet_address_mask_get_length (network)) ||
+      !g_tree_remove (monitor->priv->networks, &key))
     return;
 
+  monitor->priv->n_networks_by_length[key.family_index][key.length]--;
+
   if (g_inet_address_mask_get_length (network) == 0)
     {
       switch (g_inet_address_mask_get_family (network))
@@ -561,6 +634,25 @@ g_network_monitor_base_remove_network (GNetworkMonitorBase *monitor,
   queue_network_changed (monitor);
 }
 
+typedef struct
+{
+  GTree *new_networks;  /* (unowned) */
+  GPtrArray *removed;  /* (unowned) */
+} CollectRemovedData;
+
+static gboolean
+collect_removed_network (gpointer key,
+                         gpointer value,
+                         gpointer user_data)
+{
+  CollectRemovedData *data = user_data;
+
+  if (g_tree_lookup (data->new_networks, key) == NULL)
+    g_ptr_array_add (data->removed, g_object_ref (value));
+
+  return FALSE;
+}
+
 /**
  * g_network_monitor_base_set_networks:
  * @monitor: the #GNetworkMonitorBase
@@ -569,17 +661,38 @@ g_network_monitor_base_remove_network (GNetworkMonitorBase *monitor,
  *
  * Drops @monitor's current list of available networks and replaces
  * it with @networks.
+ *
+ * Only the differences between the two lists are applied, so if they are
+ * the same, #GNetworkMonitor::network-changed is not emitted.
  */
 void
 g_network_monitor_base_set_networks (GNetworkMonitorBase  *monitor,
                                      GInetAddressMask    **networks,
                                      gint                  length)
 {
+  GTree *new_networks;
+  GPtrArray *removed;
+  CollectRemovedData data;
   int i;
+  guint j;
+
+  new_networks = g_tree_new_full (network_key_compare, NULL, g_free, NULL);
+  for (i = 0; i < length; i++)
+    {
+      NetworkKey *key = network_key_new (networks[i]);
+
+      if (key != NULL)
+        g_tree_insert (new_networks, key, networks[i]);
+    }
 
-  g_hash_table_remove_all (monitor->priv->networks);
-  monitor->priv->have_ipv4_default_route = FALSE;
-  monitor->priv->have_ipv6_default_route = FALSE;
+  removed = g_ptr_array_new_with_free_func (g_object_unref);
+  data.new_networks = new_networks;
+  data.removed = removed;
+  g_tree_foreach (monitor->priv->networks, collect_removed_network, &data);
+  for (j = 0; j < removed->len; j++)
+    g_network_monitor_base_remove_network (monitor, removed->pdata[j]);
+  g_ptr_array_unref (removed);
+  g_tree_unref (new_networks);
 
   for (i = 0; i < length; i++)
     g_network_monitor_base_add_network (monitor, networks[i]);
@@ -45,13 +45,29 @@ static GInitableIface *initable_parent_iface;
 static void g_network_monitor_netlink_iface_init (GNetworkMonitorInterface *iface);
 static void g_network_monitor_netlink_initable_iface_init (GInitableIface *iface);
 
+/* How long to collect route changes for before applying them together, so
+ * that a burst of changes (for example a VPN adding thousands of routes)
+ * results in one #GNetworkMonitor::network-changed emission per batch */
+#define BATCH_INTERVAL_MS 100
+
+/* Maximum number of queued netlink messages to handle in one dispatch */
+#define MAX_MESSAGES_PER_DISPATCH 64
+
+typedef struct
+{
+  GInetAddressMask *network;  /* (owned) */
+  gboolean added;
+} PendingChange;
+
 struct _GNetworkMonitorNetlinkPrivate
 {
   GSocket *sock;
-  GSource *source, *dump_source;
+  GSource *source, *dump_source, *batch_source;
   GMainContext *context;
 
-  GPtrArray *dump_networks;
+  /* Both keyed by the network as a string */
+  GHashTable *dump_networks;  /* (element-type utf8 GInetAddressMask) (nullable) (owned) */
+  GHashTable *pending_changes;  /* (element-type utf8 PendingChange) (owned) */
 };
 
 static gboolean read_netlink_messages (GNetworkMonitorNetlink  *nl,
@@ -75,10 +91,19 @@ G_DEFINE_TYPE_WITH_CODE (GNetworkMonitorNetlink, g_network_monitor_netlink, G_TY
                                                          "netlink",
                                                          20))
 
+static void
+pending_change_free (PendingChange *change)
+{
+  g_object_unref (change->network);
+  g_free (change);
+}
+
 static void
 g_network_monitor_netlink_init (GNetworkMonitorNetlink *nl)
 {
   nl->priv = g_network_monitor_netlink_get_instance_private (nl);
+  nl->priv->pending_changes = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                                     (GDestroyNotify) pending_change_free);
 }
 
 static gboolean
@@ -186,7 +211,8 @@ request_dump (GNetworkMonitorNetlink  *nl,
       return FALSE;
     }
 
-  nl->priv->dump_networks = g_ptr_array_new_with_free_func (g_object_unref);
+  nl->priv->dump_networks = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                   g_free, g_object_unref);
   return TRUE;
 }
 
@@ -240,6 +266,64 @@ create_inet_address_mask (GSocketFamily  family,
   return network;
 }
 
+static void
+cancel_batch (GNetworkMonitorNetlink *nl)
+{
+  if (nl->priv->batch_source)
+    {
+      g_source_destroy (nl->priv->batch_source);
+      g_clear_pointer (&nl->priv->batch_source, g_source_unref);
+    }
+
+  g_hash_table_remove_all (nl->priv->pending_changes);
+}
+
+static gboolean
+apply_batch (gpointer user_data)
+{
+  GNetworkMonitorNetlink *nl = user_data;
+  GNetworkMonitorBase *base = G_NETWORK_MONITOR_BASE (nl);
+  GHashTableIter iter;
+  PendingChange *change;
+
+  g_hash_table_iter_init (&iter, nl->priv->pending_changes);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &change))
+    {
+      if (change->added)
+        g_network_monitor_base_add_network (base, change->network);
+      else
+        g_network_monitor_base_remove_network (base, change->network);
+    }
+
+  cancel_batch (nl);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Records a route change to be applied with the rest of its batch; a later
+ * change to the same network replaces an earlier one */
+static void
+queue_change (GNetworkMonitorNetlink *nl,
+              GInetAddressMask       *network,
+              gboolean                added)
+{
+  PendingChange *change;
+
+  change = g_new (PendingChange, 1);
+  change->network = g_object_ref (network);
+  change->added = added;
+  g_hash_table_replace (nl->priv->pending_changes,
+                        g_inet_address_mask_to_string (network), change);
+
+  if (!nl->priv->batch_source)
+    {
+      nl->priv->batch_source = g_timeout_source_new (BATCH_INTERVAL_MS);
+      g_source_set_callback (nl->priv->batch_source, apply_batch, nl, NULL);
+      g_source_set_static_name (nl->priv->batch_source, "[gio] apply_batch");
+      g_source_attach (nl->priv->batch_source, nl->priv->context);
+    }
+}
+
 static void
 add_network (GNetworkMonitorNetlink *nl,
              GSocketFamily           family,
@@ -250,9 +334,11 @@ add_network (GNetworkMonitorNetlink *nl,
   g_return_if_fail (network != NULL);
 
   if (nl->priv->dump_networks)
-    g_ptr_array_add (nl->priv->dump_networks, g_object_ref (network));
+    g_hash_table_replace (nl->priv->dump_networks,
+                          g_inet_address_mask_to_string (network),
+                          g_object_ref (network));
   else
-    g_network_monitor_base_add_network (G_NETWORK_MONITOR_BASE (nl), network);
+    queue_change (nl, network, TRUE);
 
   g_object_unref (network);
 }
@@ -268,18 +354,13 @@ remove_network (GNetworkMonitorNetlink *nl,
 
   if (nl->priv->dump_networks)
     {
-      GInetAddressMask **dump_networks = (GInetAddressMask **)nl->priv->dump_networks->pdata;
-      guint i;
-
-      for (i = 0; i < nl->priv->dump_networks->len; i++)
-        {
-          if (g_inet_address_mask_equal (network, dump_networks[i]))
-            g_ptr_array_remove_index_fast (nl->priv->dump_networks, i--);
-        }
+      char *key = g_inet_address_mask_to_string (network);
+      g_hash_table_remove (nl->priv->dump_networks, key);
+      g_free (key);
     }
   else
     {
-      g_network_monitor_base_remove_network (G_NETWORK_MONITOR_BASE (nl), network);
+      queue_change (nl, network, FALSE);
     }
 
   g_object_unref (network);
@@ -288,11 +369,18 @@ remove_network (GNetworkMonitorNetlink *nl,
 static void
 finish_dump (GNetworkMonitorNetlink *nl)
 {
+  GPtrArray *networks;
+
+  /* The dump reflects every change received before it, so any batch still
+   * pending is out of date */
+  cancel_batch (nl);
+
+  networks = g_hash_table_get_values_as_ptr_array (nl->priv->dump_networks);
   g_network_monitor_base_set_networks (G_NETWORK_MONITOR_BASE (nl),
-                                       (GInetAddressMask **)nl->priv->dump_networks->pdata,
-                                       nl->priv->dump_networks->len);
-  g_ptr_array_free (nl->priv->dump_networks, TRUE);
-  nl->priv->dump_networks = NULL;
+                                       (GInetAddressMask **) networks->pdata,
+                                       networks->len);
+  g_ptr_array_unref (networks);
+  g_clear_pointer (&nl->priv->dump_networks, g_hash_table_unref);
 }
 
 static gboolean
@@ -461,8 +549,11 @@ g_network_monitor_netlink_finalize (GObject *object)
       g_object_unref (nl->priv->sock);
     }
 
+  cancel_batch (nl);
+  g_hash_table_unref (nl->priv->pending_changes);
+
   g_clear_pointer (&nl->priv->context, g_main_context_unref);
-  g_clear_pointer (&nl->priv->dump_networks, g_ptr_array_unref);
+  g_clear_pointer (&nl->priv->dump_networks, g_hash_table_unref);
 
   G_OBJECT_CLASS (g_network_monitor_netlink_parent_class)->finalize (object);
 }
@@ -474,12 +565,21 @@ read_netlink_messages_callback (GSocket      *socket,
 {
   GError *error = NULL;
   GNetworkMonitorNetlink *nl = G_NETWORK_MONITOR_NETLINK (user_data);
-
-  if (!read_netlink_messages (nl, &error))
+  guint i;
+
+  /* Handle all the messages already queued, up to a limit, rather than
+   * going back to the main loop for each one */
+  for (i = 0;
+       i < MAX_MESSAGES_PER_DISPATCH &&
+       (i == 0 || g_socket_condition_check (socket, G_IO_IN) != 0);
+       i++)
     {
-      g_warning ("Error reading netlink message: %s", error->message);
-      g_clear_error (&error);
-      return FALSE;
+      if (!read_netlink_messages (nl, &error))
+        {
+          g_warning ("Error reading netlink message: %s", error->message);
+          g_clear_error (&error);
+          return FALSE;
+        }
     }
 
   return TRUE;
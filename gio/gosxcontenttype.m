@@ -594,6 +594,26 @@ g_content_type_guess (const gchar  *filename,
   return create_cstr_from_cfstring (uti);
 }
 
+gchar **
+g_content_types_guess_many (const gchar * const *filenames,
+                            gboolean            *results_uncertain)
+{
+  gchar **types;
+  gsize n_filenames, i;
+
+  g_return_val_if_fail (filenames != NULL, NULL);
+
+  n_filenames = g_strv_length ((gchar **) filenames);
+  types = g_new (gchar *, n_filenames + 1);
+
+  for (i = 0; i < n_filenames; i++)
+    types[i] = g_content_type_guess (filenames[i], NULL, 0,
+                                     results_uncertain ? &results_uncertain[i] : NULL);
+  types[n_filenames] = NULL;
+
+  return types;
+}
+
 GList *
 g_content_types_get_registered (void)
 {
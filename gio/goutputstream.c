@@ -31,6 +31,19 @@
 #include "gioprivate.h"
 #include "glibintl.h"
 #include "gpollableoutputstream.h"
+#include "gsocket.h"
+
+#ifdef HAVE_SPLICE
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifdef HAVE_SYS_SENDFILE_H
+#include <sys/sendfile.h>
+#endif
+#include "glib-unix.h"
+#include "gfiledescriptorbased.h"
+#endif
 
 /**
  * GOutputStream:
@@ -63,6 +76,9 @@ struct _GOutputStreamPrivate {
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (GOutputStream, g_output_stream, G_TYPE_OBJECT)
 
+/* See g_output_stream_set_splice_socket() */
+static GQuark splice_socket_quark;
+
 static gssize   g_output_stream_real_splice        (GOutputStream             *stream,
 						    GInputStream              *source,
 						    GOutputStreamSpliceFlags   flags,
@@ -105,6 +121,15 @@ static void     g_output_stream_real_splice_async  (GOutputStream             *s
 static gssize   g_output_stream_real_splice_finish (GOutputStream             *stream,
 						    GAsyncResult              *result,
 						    GError                   **error);
+static void     real_splice_async_internal         (GOutputStream             *stream,
+						    GInputStream              *source,
+						    GOutputStreamSpliceFlags   flags,
+						    gsize                      buffer_size,
+						    guint64                   *n_spliced,
+						    int                        io_priority,
+						    GCancellable              *cancellable,
+						    GAsyncReadyCallback        callback,
+						    gpointer                   data);
 static void     g_output_stream_real_flush_async   (GOutputStream             *stream,
 						    int                        io_priority,
 						    GCancellable              *cancellable,
@@ -153,6 +178,8 @@ g_output_stream_class_init (GOutputStreamClass *klass)
 
   gobject_class->dispose = g_output_stream_dispose;
 
+  splice_socket_quark = g_quark_from_static_string ("gio-output-stream-splice-socket");
+
   klass->splice = g_output_stream_real_splice;
   
   klass->write_async = g_output_stream_real_write_async;
@@ -321,6 +348,11 @@ g_output_stream_write_all (GOutputStream  *stream,
   return TRUE;
 }
 
+/* GBytesChainVector arrays can be passed as GOutputVector arrays */
+G_STATIC_ASSERT (sizeof (GBytesChainVector) == sizeof (GOutputVector));
+G_STATIC_ASSERT (G_STRUCT_OFFSET (GBytesChainVector, buffer) == G_STRUCT_OFFSET (GOutputVector, buffer));
+G_STATIC_ASSERT (G_STRUCT_OFFSET (GBytesChainVector, size) == G_STRUCT_OFFSET (GOutputVector, size));
+
 /**
  * g_output_stream_writev: (virtual writev_fn)
  * @stream: a #GOutputStream.
@@ -757,17 +789,301 @@ g_output_stream_splice (GOutputStream             *stream,
   return bytes_copied;
 }
 
+#ifdef HAVE_SPLICE
+/* Returns the fd which data written to @stream goes to unchanged, or -1 */
+static int
+get_splice_output_fd (GOutputStream  *stream,
+                      GSocket       **socket_out)
+{
+  GSocket *socket = g_object_get_qdata (G_OBJECT (stream), splice_socket_quark);
+
+  *socket_out = socket;
+  if (socket != NULL)
+    return g_socket_get_fd (socket);
+  if (G_IS_FILE_DESCRIPTOR_BASED (stream))
+    return g_file_descriptor_based_get_fd (G_FILE_DESCRIPTOR_BASED (stream));
+
+  return -1;
+}
+
+/* Returns the fd which data read from @source comes from unchanged, or -1 */
+static int
+get_splice_input_fd (GInputStream  *source,
+                     GSocket      **socket_out)
+{
+  GSocket *socket = g_input_stream_get_splice_socket (source);
+
+  *socket_out = socket;
+  if (socket != NULL)
+    return g_socket_get_fd (socket);
+  if (G_IS_FILE_DESCRIPTOR_BASED (source))
+    return g_file_descriptor_based_get_fd (G_FILE_DESCRIPTOR_BASED (source));
+
+  return -1;
+}
+
+static gboolean
+can_splice_fds (GOutputStream *stream,
+                GInputStream  *source)
+{
+  GSocket *in_socket, *out_socket;
+
+  return get_splice_input_fd (source, &in_socket) >= 0 &&
+         get_splice_output_fd (stream, &out_socket) >= 0;
+}
+
+/* Waits for @fd, which may be non-blocking, to be ready for @condition */
+static gboolean
+wait_for_fd (int            fd,
+             GSocket       *socket,
+             GIOCondition   condition,
+             GCancellable  *cancellable,
+             GError       **error)
+{
+  GPollFD poll_fds[2];
+  guint n_fds = 1;
+  int result, errsv;
+
+  /* Honour the socket’s timeout */
+  if (socket != NULL)
+    return g_socket_condition_wait (socket, condition, cancellable, error);
+
+  poll_fds[0].fd = fd;
+  poll_fds[0].events = condition;
+  if (g_cancellable_make_pollfd (cancellable, &poll_fds[1]))
+    n_fds++;
+
+  do
+    {
+      result = g_poll (poll_fds, n_fds, -1);
+      errsv = errno;
+    }
+  while (result == -1 && errsv == EINTR);
+
+  if (n_fds > 1)
+    g_cancellable_release_fd (cancellable);
+
+  if (result == -1)
+    {
+      g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+                   _("Error splicing file: %s"), g_strerror (errsv));
+      return FALSE;
+    }
+
+  return !g_cancellable_set_error_if_cancelled (cancellable, error);
+}
+
+typedef enum
+{
+  SPLICE_METHOD_COPY_FILE_RANGE,
+  SPLICE_METHOD_SENDFILE,
+  SPLICE_METHOD_PIPE,
+} SpliceMethod;
+
+/* Size of each kernel copy; cancellation is checked in between */
+#define SPLICE_CHUNK_SIZE (1024 * 1024)
+
+/* Moves the rest of @in_fd from its current position to @out_fd inside the
+ * kernel. Fails with %G_IO_ERROR_NOT_SUPPORTED before consuming anything if
+ * @method can’t be used with these fds. */
 static gssize
-g_output_stream_real_splice (GOutputStream             *stream,
-                             GInputStream              *source,
-                             GOutputStreamSpliceFlags   flags,
-                             GCancellable              *cancellable,
-                             GError                   **error)
+splice_fds_with_method (SpliceMethod   method,
+                        int            in_fd,
+                        GSocket       *in_socket,
+                        int            out_fd,
+                        GSocket       *out_socket,
+                        guint64       *n_spliced,
+                        GCancellable  *cancellable,
+                        GError       **error)
+{
+  int pipe_fds[2] = { -1, -1 };
+  gsize bytes_copied = 0;
+  gsize n_buffered = 0;  /* bytes read into the pipe but not written yet */
+  gssize ret = -1;
+
+  if (method == SPLICE_METHOD_PIPE &&
+      !g_unix_open_pipe (pipe_fds, O_CLOEXEC, error))
+    return -1;
+
+  while (TRUE)
+    {
+      gssize n;
+      int errsv, wait_fd;
+      GSocket *wait_socket;
+      GIOCondition wait_condition;
+
+      if (g_cancellable_set_error_if_cancelled (cancellable, error))
+        goto out;
+
+      switch (method)
+        {
+#ifdef HAVE_COPY_FILE_RANGE
+        case SPLICE_METHOD_COPY_FILE_RANGE:
+          n = copy_file_range (in_fd, NULL, out_fd, NULL, SPLICE_CHUNK_SIZE, 0);
+          break;
+#endif
+#ifdef HAVE_SYS_SENDFILE_H
+        case SPLICE_METHOD_SENDFILE:
+          n = sendfile (out_fd, in_fd, NULL, SPLICE_CHUNK_SIZE);
+          break;
+#endif
+        case SPLICE_METHOD_PIPE:
+          if (n_buffered == 0)
+            n = splice (in_fd, NULL, pipe_fds[1], NULL, SPLICE_CHUNK_SIZE, SPLICE_F_MORE);
+          else
+            n = splice (pipe_fds[0], NULL, out_fd, NULL, n_buffered, SPLICE_F_MORE);
+          break;
+        default:
+          g_assert_not_reached ();
+        }
+      errsv = errno;
+
+      if (n > 0 && method == SPLICE_METHOD_PIPE && n_buffered == 0)
+        {
+          n_buffered = n;
+          continue;
+        }
+      else if (n > 0)
+        {
+          if (method == SPLICE_METHOD_PIPE)
+            n_buffered -= n;
+          bytes_copied = MIN (bytes_copied + n, G_MAXSSIZE);
+          if (n_spliced != NULL)
+            *n_spliced += n;
+          continue;
+        }
+      else if (n == 0)
+        break;
+
+      if (errsv == EINTR)
+        continue;
+
+      if (errsv == EAGAIN || errsv == EWOULDBLOCK)
+        {
+          /* Only the pipe method reads from non-regular files */
+          if (method == SPLICE_METHOD_PIPE && n_buffered == 0)
+            {
+              wait_fd = in_fd;
+              wait_socket = in_socket;
+              wait_condition = G_IO_IN;
+            }
+          else
+            {
+              wait_fd = out_fd;
+              wait_socket = out_socket;
+              wait_condition = G_IO_OUT;
+            }
+
+          if (!wait_for_fd (wait_fd, wait_socket, wait_condition, cancellable, error))
+            goto out;
+          continue;
+        }
+
+      if (bytes_copied == 0 && n_buffered == 0 &&
+          (errsv == EINVAL || errsv == ENOSYS || errsv == EOPNOTSUPP || errsv == EXDEV))
+        g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                             _("Splice not supported"));
+      else
+        g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+                     _("Error splicing file: %s"), g_strerror (errsv));
+      goto out;
+    }
+
+  ret = bytes_copied;
+
+ out:
+  if (pipe_fds[0] != -1)
+    g_close (pipe_fds[0], NULL);
+  if (pipe_fds[1] != -1)
+    g_close (pipe_fds[1], NULL);
+
+  return ret;
+}
+
+/* Moves the rest of @source to @stream inside the kernel, using the best
+ * method for the types of their fds. Fails with %G_IO_ERROR_NOT_SUPPORTED
+ * before consuming anything if none can be used. */
+static gssize
+splice_fds (GOutputStream  *stream,
+            GInputStream   *source,
+            guint64        *n_spliced,
+            GCancellable   *cancellable,
+            GError        **error)
+{
+  GSocket *in_socket, *out_socket;
+  int in_fd = get_splice_input_fd (source, &in_socket);
+  int out_fd = get_splice_output_fd (stream, &out_socket);
+  struct stat in_buf, out_buf;
+  SpliceMethod methods[3];
+  guint n_methods = 0, i;
+
+  if (fstat (in_fd, &in_buf) != 0 || fstat (out_fd, &out_buf) != 0)
+    {
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                           _("Splice not supported"));
+      return -1;
+    }
+
+#ifdef HAVE_COPY_FILE_RANGE
+  /* Lets the file system share extents, or copy server-side */
+  if (S_ISREG (in_buf.st_mode) && S_ISREG (out_buf.st_mode))
+    methods[n_methods++] = SPLICE_METHOD_COPY_FILE_RANGE;
+#endif
+#ifdef HAVE_SYS_SENDFILE_H
+  /* Reads straight from the page cache */
+  if (S_ISREG (in_buf.st_mode))
+    methods[n_methods++] = SPLICE_METHOD_SENDFILE;
+#endif
+  /* splice() can’t write to a file opened for appending */
+  if (!(fcntl (out_fd, F_GETFL) & O_APPEND))
+    methods[n_methods++] = SPLICE_METHOD_PIPE;
+
+  for (i = 0; i < n_methods; i++)
+    {
+      GError *local_error = NULL;
+      gssize n_copied;
+
+      n_copied = splice_fds_with_method (methods[i], in_fd, in_socket,
+                                         out_fd, out_socket, n_spliced,
+                                         cancellable, &local_error);
+      if (n_copied >= 0 ||
+          !g_error_matches (local_error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED))
+        {
+          if (local_error != NULL)
+            g_propagate_error (error, local_error);
+          return n_copied;
+        }
+
+      g_clear_error (&local_error);
+    }
+
+  g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                       _("Splice not supported"));
+  return -1;
+}
+#endif  /* HAVE_SPLICE */
+
+/* Size of the buffer used to splice through userspace, unless the caller
+ * asks for another one */
+#define SPLICE_BUFFER_SIZE 8192
+
+/* The default implementation of g_output_stream_splice(), copying through
+ * a buffer of @buffer_size bytes. If @n_spliced is not %NULL, it is
+ * increased by each byte written to @stream, even if the splice fails. */
+static gssize
+splice_internal (GOutputStream             *stream,
+                 GInputStream              *source,
+                 GOutputStreamSpliceFlags   flags,
+                 gsize                      buffer_size,
+                 guint64                   *n_spliced,
+                 GCancellable              *cancellable,
+                 GError                   **error)
 {
   GOutputStreamClass *class = G_OUTPUT_STREAM_GET_CLASS (stream);
   gssize n_read, n_written;
   gsize bytes_copied;
-  char buffer[8192], *p;
+  char stack_buffer[SPLICE_BUFFER_SIZE];
+  char *buffer = stack_buffer, *p;
   gboolean res;
 
   bytes_copied = 0;
@@ -776,13 +1092,43 @@ g_output_stream_real_splice (GOutputStream             *stream,
       g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
                            _("Output stream doesn’t implement write"));
       res = FALSE;
-      goto notsupported;
+      goto out;
     }
 
   res = TRUE;
+
+#ifdef HAVE_SPLICE
+  if (can_splice_fds (stream, source))
+    {
+      GError *local_error = NULL;
+      gssize n_sent;
+
+      n_sent = splice_fds (stream, source, n_spliced, cancellable, &local_error);
+      if (n_sent >= 0)
+        {
+          bytes_copied = n_sent;
+          goto out;
+        }
+      else if (!g_error_matches (local_error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED))
+        {
+          g_propagate_error (error, local_error);
+          res = FALSE;
+          goto out;
+        }
+
+      /* Copy through userspace instead */
+      g_clear_error (&local_error);
+    }
+#endif
+
+  if (buffer_size > sizeof (stack_buffer))
+    buffer = g_malloc (buffer_size);
+  else
+    buffer_size = sizeof (stack_buffer);
+
   do
     {
-      n_read = g_input_stream_read (source, buffer, sizeof (buffer), cancellable, error);
+      n_read = g_input_stream_read (source, buffer, buffer_size, cancellable, error);
       if (n_read == -1)
 	{
 	  res = FALSE;
@@ -805,6 +1151,8 @@ g_output_stream_real_splice (GOutputStream             *stream,
 	  p += n_written;
 	  n_read -= n_written;
 	  bytes_copied += n_written;
+	  if (n_spliced != NULL)
+	    *n_spliced += n_written;
 	}
 
       if (bytes_copied > G_MAXSSIZE)
@@ -812,7 +1160,10 @@ g_output_stream_real_splice (GOutputStream             *stream,
     }
   while (res);
 
- notsupported:
+  if (buffer != stack_buffer)
+    g_free (buffer);
+
+ out:
   if (!res)
     error = NULL; /* Ignore further errors */
 
@@ -835,6 +1186,17 @@ g_output_stream_real_splice (GOutputStream             *stream,
   return -1;
 }
 
+static gssize
+g_output_stream_real_splice (GOutputStream             *stream,
+                             GInputStream              *source,
+                             GOutputStreamSpliceFlags   flags,
+                             GCancellable              *cancellable,
+                             GError                   **error)
+{
+  return splice_internal (stream, source, flags, SPLICE_BUFFER_SIZE, NULL,
+                          cancellable, error);
+}
+
 /* Must always be called inside
  * g_output_stream_set_pending()/g_output_stream_clear_pending(). */
 static gboolean
@@ -1784,6 +2146,87 @@ g_output_stream_splice_async (GOutputStream            *stream,
                        async_ready_splice_callback_wrapper, task);
 }
 
+/*
+ * g_output_stream_splice_counted_async:
+ * @stream: a #GOutputStream
+ * @source: a #GInputStream
+ * @buffer_size: size of the buffer to copy through, or 0 for the default
+ * @n_spliced: (out caller-allocates): location to add the number of bytes
+ *   written to @stream to
+ * @io_priority: the io priority of the request
+ * @cancellable: (nullable): optional #GCancellable object, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback
+ * @user_data: the data to pass to callback function
+ *
+ * Like g_output_stream_splice_async() with no flags, but lets the caller
+ * choose the size of the buffer used when the data has to be copied
+ * through userspace, and adds the number of bytes written to @n_spliced as
+ * they are written, so that it is accurate even if the splice fails or is
+ * cancelled. @n_spliced must only be read once the operation is finished,
+ * which g_output_stream_splice_finish() does.
+ *
+ * If @stream overrides splicing, the buffer size is ignored and this
+ * returns %FALSE: @n_spliced is not updated, and the caller has to use
+ * the return value of g_output_stream_splice_finish() instead.
+ *
+ * Returns: %TRUE if @n_spliced will be updated
+ */
+gboolean
+g_output_stream_splice_counted_async (GOutputStream       *stream,
+                                      GInputStream        *source,
+                                      gsize                buffer_size,
+                                      guint64             *n_spliced,
+                                      int                  io_priority,
+                                      GCancellable        *cancellable,
+                                      GAsyncReadyCallback  callback,
+                                      gpointer             user_data)
+{
+  GOutputStreamClass *class;
+  GTask *task;
+  GError *error = NULL;
+
+  g_return_val_if_fail (G_IS_OUTPUT_STREAM (stream), FALSE);
+  g_return_val_if_fail (G_IS_INPUT_STREAM (source), FALSE);
+  g_return_val_if_fail (n_spliced != NULL, FALSE);
+
+  class = G_OUTPUT_STREAM_GET_CLASS (stream);
+  if (class->splice != g_output_stream_real_splice ||
+      class->splice_async != g_output_stream_real_splice_async)
+    {
+      g_output_stream_splice_async (stream, source, G_OUTPUT_STREAM_SPLICE_NONE,
+                                    io_priority, cancellable, callback, user_data);
+      return FALSE;
+    }
+
+  task = g_task_new (stream, cancellable, callback, user_data);
+  g_task_set_source_tag (task, g_output_stream_splice_async);
+  g_task_set_priority (task, io_priority);
+  g_task_set_task_data (task, g_object_ref (source), g_object_unref);
+
+  if (g_input_stream_is_closed (source))
+    {
+      g_task_return_new_error_literal (task,
+                                       G_IO_ERROR, G_IO_ERROR_CLOSED,
+                                       _("Source stream is already closed"));
+      g_object_unref (task);
+      return TRUE;
+    }
+
+  if (!g_output_stream_set_pending (stream, &error))
+    {
+      g_task_return_error (task, error);
+      g_object_unref (task);
+      return TRUE;
+    }
+
+  real_splice_async_internal (stream, source, G_OUTPUT_STREAM_SPLICE_NONE,
+                              buffer_size > 0 ? buffer_size : SPLICE_BUFFER_SIZE,
+                              n_spliced, io_priority, cancellable,
+                              async_ready_splice_callback_wrapper, task);
+
+  return TRUE;
+}
+
 /**
  * g_output_stream_splice_finish:
  * @stream: a #GOutputStream.
@@ -2301,6 +2744,26 @@ g_output_stream_async_close_is_via_threads (GOutputStream *stream)
   return class->close_async == g_output_stream_real_close_async;
 }
 
+/*< internal >
+ * g_output_stream_set_splice_socket:
+ * @stream: a #GOutputStream
+ * @socket: the socket which data written to @stream goes to, unchanged
+ *
+ * Lets the default implementation of g_output_stream_splice() move data
+ * to @socket inside the kernel, with `sendfile()` or `splice()`, instead of
+ * reading it and calling #GOutputStreamClass.write_fn.
+ */
+void
+g_output_stream_set_splice_socket (GOutputStream *stream,
+                                   GSocket       *socket)
+{
+  g_return_if_fail (G_IS_OUTPUT_STREAM (stream));
+  g_return_if_fail (G_IS_SOCKET (socket));
+
+  g_object_set_qdata_full (G_OBJECT (stream), splice_socket_quark,
+                           g_object_ref (socket), g_object_unref);
+}
+
 /********************************************
  *   Default implementation of sync ops    *
  ********************************************/
@@ -2660,6 +3123,8 @@ typedef struct {
   gsize bytes_copied;
   GError *error;
   guint8 *buffer;
+  gsize buffer_size;
+  guint64 *n_spliced;  /* (nullable) */
 } SpliceData;
 
 static void
@@ -2782,6 +3247,8 @@ real_splice_async_write_cb (GObject      *source,
   op->bytes_copied += ret;
   if (op->bytes_copied > G_MAXSSIZE)
     op->bytes_copied = G_MAXSSIZE;
+  if (op->n_spliced != NULL)
+    *op->n_spliced += ret;
 
   if (op->n_written < op->n_read)
     {
@@ -2794,7 +3261,7 @@ real_splice_async_write_cb (GObject      *source,
       return;
     }
 
-  g_input_stream_read_async (op->source, op->buffer, 8192,
+  g_input_stream_read_async (op->source, op->buffer, op->buffer_size,
                              g_task_get_priority (task),
                              g_task_get_cancellable (task),
                              real_splice_async_read_cb, task);
@@ -2842,11 +3309,21 @@ splice_async_thread (GTask        *task,
 
   class = G_OUTPUT_STREAM_GET_CLASS (stream);
   
-  bytes_copied = class->splice (stream,
-                                op->source,
-                                op->flags,
-                                cancellable,
-                                &error);
+  /* Only the default implementation supports these */
+  if (op->n_spliced != NULL || op->buffer_size != SPLICE_BUFFER_SIZE)
+    bytes_copied = splice_internal (stream,
+                                    op->source,
+                                    op->flags,
+                                    op->buffer_size,
+                                    op->n_spliced,
+                                    cancellable,
+                                    &error);
+  else
+    bytes_copied = class->splice (stream,
+                                  op->source,
+                                  op->flags,
+                                  cancellable,
+                                  &error);
   if (bytes_copied == -1)
     g_task_return_error (task, error);
   else
@@ -2854,13 +3331,15 @@ splice_async_thread (GTask        *task,
 }
 
 static void
-g_output_stream_real_splice_async (GOutputStream             *stream,
-                                   GInputStream              *source,
-                                   GOutputStreamSpliceFlags   flags,
-                                   int                        io_priority,
-                                   GCancellable              *cancellable,
-                                   GAsyncReadyCallback        callback,
-                                   gpointer                   user_data)
+real_splice_async_internal (GOutputStream             *stream,
+                            GInputStream              *source,
+                            GOutputStreamSpliceFlags   flags,
+                            gsize                      buffer_size,
+                            guint64                   *n_spliced,
+                            int                        io_priority,
+                            GCancellable              *cancellable,
+                            GAsyncReadyCallback        callback,
+                            gpointer                   user_data)
 {
   GTask *task;
   SpliceData *op;
@@ -2870,23 +3349,42 @@ g_output_stream_real_splice_async (GOutputStream             *stream,
   g_task_set_task_data (task, op, (GDestroyNotify)free_splice_data);
   op->flags = flags;
   op->source = g_object_ref (source);
-
-  if (g_input_stream_async_read_is_via_threads (source) &&
-      g_output_stream_async_write_is_via_threads (stream))
+  op->buffer_size = buffer_size;
+  op->n_spliced = n_spliced;
+
+  if ((g_input_stream_async_read_is_via_threads (source) &&
+       g_output_stream_async_write_is_via_threads (stream))
+#ifdef HAVE_SPLICE
+      || can_splice_fds (stream, source)
+#endif
+      )
     {
       g_task_run_in_thread (task, splice_async_thread);
       g_object_unref (task);
     }
   else
     {
-      op->buffer = g_malloc (8192);
-      g_input_stream_read_async (op->source, op->buffer, 8192,
+      op->buffer = g_malloc (op->buffer_size);
+      g_input_stream_read_async (op->source, op->buffer, op->buffer_size,
                                  g_task_get_priority (task),
                                  g_task_get_cancellable (task),
                                  real_splice_async_read_cb, task);
     }
 }
 
+static void
+g_output_stream_real_splice_async (GOutputStream             *stream,
+                                   GInputStream              *source,
+                                   GOutputStreamSpliceFlags   flags,
+                                   int                        io_priority,
+                                   GCancellable              *cancellable,
+                                   GAsyncReadyCallback        callback,
+                                   gpointer                   user_data)
+{
+  real_splice_async_internal (stream, source, flags, SPLICE_BUFFER_SIZE, NULL,
+                              io_priority, cancellable, callback, user_data);
+}
+
 static gssize
 g_output_stream_real_splice_finish (GOutputStream  *stream,
                                     GAsyncResult   *result,
@@ -157,8 +157,8 @@ g_pollable_input_stream_default_read_nonblocking (GPollableInputStream  *stream,
 {
   if (!g_pollable_input_stream_is_readable (stream))
     {
-      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK,
-                           g_strerror (EAGAIN));
+      g_set_error_literal_static (error, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK,
+                                  g_strerror (EAGAIN));
       return -1;
     }
 
@@ -25,12 +25,32 @@
 #include "giomodule-priv.h"
 #include "gportalsupport.h"
 #include "gproxyresolverportal.h"
+#include "gnetworkmonitor.h"
+#include "guri.h"
+
+/* Proxy configuration (and PAC scripts in particular) rarely changes,
+ * so remember the portal's answer per destination for a while instead
+ * of making a D-Bus call for every connection.  The cache is dropped
+ * whenever the network changes.
+ */
+#define PROXY_CACHE_TTL_USEC (60 * G_USEC_PER_SEC)
+#define PROXY_CACHE_MAX_ENTRIES 256
+
+typedef struct {
+  gchar  **proxies;
+  gint64   expires;  /* monotonic time */
+} ProxyCacheEntry;
 
 struct _GProxyResolverPortal {
   GObject parent_instance;
 
   GXdpProxyResolver *resolver;
   gboolean network_available;
+
+  GMutex cache_lock;
+  GHashTable *cache;  /* (owned) (nullable) "scheme://host:port" → ProxyCacheEntry */
+  GNetworkMonitor *network_monitor;  /* (owned) (nullable) */
+  gulong network_changed_id;
 };
 
 static void g_proxy_resolver_portal_iface_init (GProxyResolverInterface *iface);
@@ -68,6 +88,118 @@ ensure_resolver_proxy (GProxyResolverPortal *resolver)
 static void
 g_proxy_resolver_portal_init (GProxyResolverPortal *resolver)
 {
+  g_mutex_init (&resolver->cache_lock);
+}
+
+static void
+proxy_cache_entry_free (gpointer data)
+{
+  ProxyCacheEntry *entry = data;
+
+  g_strfreev (entry->proxies);
+  g_free (entry);
+}
+
+/* Returns the cache key for @uri, or %NULL if it can't be cached.
+ * PAC scripts may in theory look at the whole URI, but in practice
+ * they only look at the host, and browsers have stopped passing them
+ * the path for privacy reasons anyway.
+ */
+static gchar *
+proxy_cache_key (const gchar *uri)
+{
+  gchar *scheme = NULL, *host = NULL;
+  gint port;
+  gchar *key = NULL;
+
+  if (g_uri_split_network (uri, G_URI_FLAGS_NONE, &scheme, &host, &port, NULL) &&
+      scheme != NULL && host != NULL)
+    {
+      gchar *scheme_down = g_ascii_strdown (scheme, -1);
+      gchar *host_down = g_ascii_strdown (host, -1);
+
+      key = g_strdup_printf ("%s://%s:%d", scheme_down, host_down, port);
+
+      g_free (scheme_down);
+      g_free (host_down);
+    }
+
+  g_free (scheme);
+  g_free (host);
+
+  return key;
+}
+
+static gchar **
+proxy_cache_lookup (GProxyResolverPortal *resolver,
+                    const gchar          *key)
+{
+  ProxyCacheEntry *entry;
+  gchar **proxies = NULL;
+
+  g_mutex_lock (&resolver->cache_lock);
+
+  entry = resolver->cache != NULL ? g_hash_table_lookup (resolver->cache, key) : NULL;
+  if (entry != NULL)
+    {
+      if (entry->expires > g_get_monotonic_time ())
+        proxies = g_strdupv (entry->proxies);
+      else
+        g_hash_table_remove (resolver->cache, key);
+    }
+
+  g_mutex_unlock (&resolver->cache_lock);
+
+  return proxies;
+}
+
+static void
+network_changed_cb (GNetworkMonitor *monitor,
+                    gboolean         network_available,
+                    gpointer         user_data)
+{
+  GProxyResolverPortal *resolver = user_data;
+
+  g_mutex_lock (&resolver->cache_lock);
+  if (resolver->cache != NULL)
+    g_hash_table_remove_all (resolver->cache);
+  g_mutex_unlock (&resolver->cache_lock);
+}
+
+static void
+proxy_cache_insert (GProxyResolverPortal *resolver,
+                    const gchar          *key,
+                    gchar               **proxies)
+{
+  ProxyCacheEntry *entry;
+  gboolean watch_network = FALSE;
+
+  entry = g_new0 (ProxyCacheEntry, 1);
+  entry->proxies = g_strdupv (proxies);
+  entry->expires = g_get_monotonic_time () + PROXY_CACHE_TTL_USEC;
+
+  g_mutex_lock (&resolver->cache_lock);
+
+  if (resolver->cache == NULL)
+    {
+      resolver->cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, proxy_cache_entry_free);
+      watch_network = TRUE;
+    }
+
+  /* Not worth an LRU: entries expire quickly anyway */
+  if (g_hash_table_size (resolver->cache) >= PROXY_CACHE_MAX_ENTRIES)
+    g_hash_table_remove_all (resolver->cache);
+
+  g_hash_table_replace (resolver->cache, g_strdup (key), entry);
+
+  g_mutex_unlock (&resolver->cache_lock);
+
+  if (watch_network)
+    {
+      resolver->network_monitor = g_object_ref (g_network_monitor_get_default ());
+      resolver->network_changed_id = g_signal_connect (resolver->network_monitor, "network-changed",
+                                                       G_CALLBACK (network_changed_cb), resolver);
+    }
 }
 
 static gboolean
@@ -97,16 +229,32 @@ g_proxy_resolver_portal_lookup (GProxyResolver *proxy_resolver,
 {
   GProxyResolverPortal *resolver = G_PROXY_RESOLVER_PORTAL (proxy_resolver);
   char **proxy = NULL;
+  gchar *key;
 
   ensure_resolver_proxy (resolver);
   g_assert (resolver->resolver);
 
-  if (!gxdp_proxy_resolver_call_lookup_sync (resolver->resolver,
-                                             uri,
-                                             &proxy,
-                                             cancellable,
-                                             error))
-    return NULL;
+  key = proxy_cache_key (uri);
+  if (key != NULL)
+    proxy = proxy_cache_lookup (resolver, key);
+
+  if (proxy == NULL)
+    {
+      if (!gxdp_proxy_resolver_call_lookup_sync (resolver->resolver,
+                                                 uri,
+                                                 &proxy,
+                                                 cancellable,
+                                                 error))
+        {
+          g_free (key);
+          return NULL;
+        }
+
+      if (key != NULL)
+        proxy_cache_insert (resolver, key, proxy);
+    }
+
+  g_free (key);
 
   if (!resolver->network_available)
     {
@@ -123,6 +271,8 @@ lookup_done (GObject      *source,
              gpointer      data)
 {
   GTask *task = data;
+  GProxyResolverPortal *resolver = g_task_get_source_object (task);
+  const gchar *key = g_task_get_task_data (task);
   GError *error = NULL;
   gchar **proxies = NULL;
 
@@ -132,7 +282,11 @@ lookup_done (GObject      *source,
                                                &error))
     g_task_return_error (task, error);
   else
-    g_task_return_pointer (task, proxies, NULL);
+    {
+      if (key != NULL)
+        proxy_cache_insert (resolver, key, proxies);
+      g_task_return_pointer (task, proxies, NULL);
+    }
 
   g_object_unref (task);
 }
@@ -146,11 +300,27 @@ g_proxy_resolver_portal_lookup_async (GProxyResolver      *proxy_resolver,
 {
   GProxyResolverPortal *resolver = G_PROXY_RESOLVER_PORTAL (proxy_resolver);
   GTask *task;
+  gchar **proxies = NULL;
+  gchar *key;
 
   ensure_resolver_proxy (resolver);
   g_assert (resolver->resolver);
 
   task = g_task_new (proxy_resolver, cancellable, callback, user_data);
+
+  key = proxy_cache_key (uri);
+  if (key != NULL)
+    proxies = proxy_cache_lookup (resolver, key);
+
+  if (proxies != NULL)
+    {
+      g_task_return_pointer (task, proxies, NULL);
+      g_object_unref (task);
+      g_free (key);
+      return;
+    }
+
+  g_task_set_task_data (task, key, g_free);
   gxdp_proxy_resolver_call_lookup (resolver->resolver,
                                    uri,
                                    cancellable,
@@ -188,6 +358,11 @@ g_proxy_resolver_portal_finalize (GObject *object)
 
   g_clear_object (&resolver->resolver);
 
+  g_clear_signal_handler (&resolver->network_changed_id, resolver->network_monitor);
+  g_clear_object (&resolver->network_monitor);
+  g_clear_pointer (&resolver->cache, g_hash_table_unref);
+  g_mutex_clear (&resolver->cache_lock);
+
   G_OBJECT_CLASS (g_proxy_resolver_portal_parent_class)->finalize (object);
 }
 
@@ -68,9 +68,10 @@
 
 typedef enum {
   PROP_TIMEOUT = 1,
+  PROP_CACHE_TTL,
 } GResolverProperty;
 
-static GParamSpec *props[PROP_TIMEOUT + 1] = { NULL, };
+static GParamSpec *props[PROP_CACHE_TTL + 1] = { NULL, };
 
 enum {
   RELOAD,
@@ -81,6 +82,7 @@ static guint signals[LAST_SIGNAL] = { 0 };
 
 struct _GResolverPrivate {
   unsigned timeout_ms;
+  unsigned cache_ttl_s;
 
 #ifdef G_OS_UNIX
   GMutex mutex;
@@ -170,6 +172,9 @@ g_resolver_get_property (GObject    *object,
     case PROP_TIMEOUT:
       g_value_set_uint (value, g_resolver_get_timeout (self));
       break;
+    case PROP_CACHE_TTL:
+      g_value_set_uint (value, g_resolver_get_cache_ttl (self));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -188,6 +193,9 @@ g_resolver_set_property (GObject      *object,
     case PROP_TIMEOUT:
       g_resolver_set_timeout (self, g_value_get_uint (value));
       break;
+    case PROP_CACHE_TTL:
+      g_resolver_set_cache_ttl (self, g_value_get_uint (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -240,6 +248,32 @@ g_resolver_class_init (GResolverClass *resolver_class)
                        0, G_MAXUINT, 0,
                        G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * GResolver:cache-ttl:
+   *
+   * The longest time for which the results of name and record lookups may be
+   * cached by the resolver, in seconds.
+   *
+   * Failures to find a name are cached too, but temporary failures are not.
+   * Where the DNS records for a result give a shorter time to live, that is
+   * used instead. Cached results are dropped when #GResolver::reload is
+   * emitted, or when #GNetworkMonitor::network-changed is emitted by the
+   * default network monitor.
+   *
+   * This may be changed through the lifetime of the #GResolver. The new
+   * value will apply to results of lookups started after the change.
+   *
+   * If this is `0`, no caching is done. Resolver implementations which don’t
+   * support caching ignore this property; #GThreadedResolver (the default
+   * resolver on most platforms) supports it.
+   *
+   * Since: 2.82
+   */
+  props[PROP_CACHE_TTL] =
+    g_param_spec_uint ("cache-ttl", NULL, NULL,
+                       0, G_MAXUINT, 0,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, G_N_ELEMENTS (props), props);
 
   /**
@@ -1357,6 +1391,52 @@ g_resolver_set_timeout (GResolver *resolver,
   g_object_notify_by_pspec (G_OBJECT (resolver), props[PROP_TIMEOUT]);
 }
 
+/**
+ * g_resolver_get_cache_ttl:
+ * @resolver: a #GResolver
+ *
+ * Get the longest time for which lookup results may be cached. See
+ * #GResolver:cache-ttl.
+ *
+ * Returns: the cache time to live, in seconds, or `0` for no caching
+ *
+ * Since: 2.82
+ */
+unsigned
+g_resolver_get_cache_ttl (GResolver *resolver)
+{
+  GResolverPrivate *priv = g_resolver_get_instance_private (resolver);
+
+  g_return_val_if_fail (G_IS_RESOLVER (resolver), 0);
+
+  return priv->cache_ttl_s;
+}
+
+/**
+ * g_resolver_set_cache_ttl:
+ * @resolver: a #GResolver
+ * @cache_ttl_s: cache time to live in seconds, or `0` to disable caching
+ *
+ * Set the longest time for which lookup results may be cached. See
+ * #GResolver:cache-ttl.
+ *
+ * Since: 2.82
+ */
+void
+g_resolver_set_cache_ttl (GResolver *resolver,
+                          unsigned   cache_ttl_s)
+{
+  GResolverPrivate *priv = g_resolver_get_instance_private (resolver);
+
+  g_return_if_fail (G_IS_RESOLVER (resolver));
+
+  if (priv->cache_ttl_s == cache_ttl_s)
+    return;
+
+  priv->cache_ttl_s = cache_ttl_s;
+  g_object_notify_by_pspec (G_OBJECT (resolver), props[PROP_CACHE_TTL]);
+}
+
 /**
  * g_resolver_error_quark:
  *
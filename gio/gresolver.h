@@ -282,6 +282,11 @@ unsigned   g_resolver_get_timeout                      (GResolver
 GIO_AVAILABLE_IN_2_78
 void       g_resolver_set_timeout                      (GResolver                 *resolver,
                                                         unsigned                   timeout_ms);
+GIO_AVAILABLE_IN_2_82
+unsigned   g_resolver_get_cache_ttl                    (GResolver                 *resolver);
+GIO_AVAILABLE_IN_2_82
+void       g_resolver_set_cache_ttl                    (GResolver                 *resolver,
+                                                        unsigned                   cache_ttl_s);
 
 /**
  * G_RESOLVER_ERROR:
@@ -32,15 +32,37 @@
 #include <gio/gioerror.h>
 #include <gio/gmemoryinputstream.h>
 #include <gio/gzlibdecompressor.h>
+#include <gio/gzstddecompressor.h>
 #include <gio/gconverterinputstream.h>
 
 #include "glib-private.h"
 
+/* Decompressed data of compressed entries is kept in a small LRU cache per
+ * resource, so that repeated lookups of the same file don’t decompress it
+ * again. Entries bigger than a quarter of the budget are never cached. The
+ * cache is registered with g_mem_cache_register(), so it is dropped on low
+ * memory warnings. */
+#define RESOURCE_CACHE_MAX_SIZE (1024 * 1024)
+#define RESOURCE_CACHE_MAX_ENTRY_SIZE (RESOURCE_CACHE_MAX_SIZE / 4)
+
+typedef struct
+{
+  char *path;
+  GBytes *bytes;
+  GList lru_link;
+} ResourceCacheEntry;
+
 struct _GResource
 {
   int ref_count;
 
   GvdbTable *table;
+
+  GMutex cache_lock;
+  GHashTable *cache;  /* (owned) (nullable) (element-type utf8 ResourceCacheEntry) */
+  GQueue cache_lru;  /* most recently used first; links are embedded in the entries */
+  gsize cache_size;  /* total size of the cached data, in bytes */
+  guint cache_id;  /* from g_mem_cache_register() */
 };
 
 static void register_lazy_static_resources (void);
@@ -71,6 +93,9 @@ G_DEFINE_BOXED_TYPE (GResource, g_resource, g_resource_ref, g_resource_unref)
  * in the resource bundle in a compressed form, but will be automatically
  * uncompressed when the resource is used. This is very useful e.g. for larger
  * text files that are parsed once (or rarely) and then thrown away.
+ * Setting `compressed="true"` uses zlib. Since 2.82, `compressed="zstd"`
+ * selects Zstandard instead, which decompresses considerably faster; it
+ * requires GLib to be built with Zstandard support.
  *
  * Resource files can also be marked to be preprocessed, by setting the value of the
  * `preprocess` attribute to a comma-separated list of preprocessing options.
@@ -551,11 +576,125 @@ g_resource_unref (GResource *resource)
 {
   if (g_atomic_int_dec_and_test (&resource->ref_count))
     {
+      g_mem_cache_unregister (resource->cache_id);
+      g_clear_pointer (&resource->cache, g_hash_table_unref);
+      g_mutex_clear (&resource->cache_lock);
       gvdb_table_free (resource->table);
       g_free (resource);
     }
 }
 
+static void
+resource_cache_entry_free (ResourceCacheEntry *entry)
+{
+  g_free (entry->path);
+  g_bytes_unref (entry->bytes);
+  g_free (entry);
+}
+
+/* Returns a new reference to the cached data for @path, or %NULL */
+static GBytes *
+resource_cache_lookup (GResource   *resource,
+                       const gchar *path)
+{
+  ResourceCacheEntry *entry = NULL;
+  GBytes *bytes = NULL;
+
+  g_mutex_lock (&resource->cache_lock);
+
+  if (resource->cache != NULL)
+    entry = g_hash_table_lookup (resource->cache, path);
+
+  if (entry != NULL)
+    {
+      g_queue_unlink (&resource->cache_lru, &entry->lru_link);
+      g_queue_push_head_link (&resource->cache_lru, &entry->lru_link);
+      bytes = g_bytes_ref (entry->bytes);
+    }
+
+  g_mutex_unlock (&resource->cache_lock);
+
+  return bytes;
+}
+
+static void
+resource_cache_insert (GResource   *resource,
+                       const gchar *path,
+                       GBytes      *bytes)
+{
+  ResourceCacheEntry *entry;
+  gsize size = g_bytes_get_size (bytes);
+
+  if (size > RESOURCE_CACHE_MAX_ENTRY_SIZE)
+    return;
+
+  g_mutex_lock (&resource->cache_lock);
+
+  if (resource->cache == NULL)
+    resource->cache = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
+                                             (GDestroyNotify) resource_cache_entry_free);
+
+  /* Another thread may have decompressed the same file concurrently */
+  if (g_hash_table_contains (resource->cache, path))
+    {
+      g_mutex_unlock (&resource->cache_lock);
+      return;
+    }
+
+  while (resource->cache_size + size > RESOURCE_CACHE_MAX_SIZE)
+    {
+      GList *oldest = g_queue_pop_tail_link (&resource->cache_lru);
+
+      entry = oldest->data;
+      resource->cache_size -= g_bytes_get_size (entry->bytes);
+      g_hash_table_remove (resource->cache, entry->path);
+    }
+
+  entry = g_new0 (ResourceCacheEntry, 1);
+  entry->path = g_strdup (path);
+  entry->bytes = g_bytes_ref (bytes);
+  entry->lru_link.data = entry;
+
+  g_hash_table_insert (resource->cache, entry->path, entry);
+  g_queue_push_head_link (&resource->cache_lru, &entry->lru_link);
+  resource->cache_size += size;
+
+  g_mutex_unlock (&resource->cache_lock);
+}
+
+static gsize
+resource_cache_trim (guint    level,
+                     gpointer user_data)
+{
+  GResource *resource = user_data;
+  gsize freed;
+
+  g_mutex_lock (&resource->cache_lock);
+
+  freed = resource->cache_size;
+  if (resource->cache != NULL)
+    g_hash_table_remove_all (resource->cache);
+  g_queue_init (&resource->cache_lru);
+  resource->cache_size = 0;
+
+  g_mutex_unlock (&resource->cache_lock);
+
+  return freed;
+}
+
+static gsize
+resource_cache_get_size (gpointer user_data)
+{
+  GResource *resource = user_data;
+  gsize size;
+
+  g_mutex_lock (&resource->cache_lock);
+  size = resource->cache_size;
+  g_mutex_unlock (&resource->cache_lock);
+
+  return size;
+}
+
 /*< internal >
  * g_resource_new_from_table:
  * @table: (transfer full): a GvdbTable
@@ -567,9 +706,16 @@ g_resource_new_from_table (GvdbTable *table)
 {
   GResource *resource;
 
-  resource = g_new (GResource, 1);
+  resource = g_new0 (GResource, 1);
   resource->ref_count = 1;
   resource->table = table;
+  g_mutex_init (&resource->cache_lock);
+  g_queue_init (&resource->cache_lru);
+  resource->cache_id = g_mem_cache_register ("gio-resource-data",
+                                             G_MEMORY_MONITOR_WARNING_LEVEL_LOW,
+                                             resource_cache_trim,
+                                             resource_cache_get_size,
+                                             resource);
 
   return resource;
 }
@@ -728,7 +874,7 @@ do_lookup (GResource             *resource,
       if (data_size)
         {
           /* Don't report trailing newline that non-compressed files has */
-          if (_flags & G_RESOURCE_FLAGS_COMPRESSED)
+          if (_flags & (G_RESOURCE_FLAGS_COMPRESSED | G_RESOURCE_FLAGS_COMPRESSED_ZSTD))
             *data_size = g_variant_get_size (array);
           else
             *data_size = g_variant_get_size (array) - 1;
@@ -743,6 +889,19 @@ do_lookup (GResource             *resource,
   return res;
 }
 
+/* Returns a converter for the data of a resource with @flags, or %NULL if
+ * it is not compressed */
+static GConverter *
+create_decompressor (guint32 flags)
+{
+  if (flags & G_RESOURCE_FLAGS_COMPRESSED_ZSTD)
+    return G_CONVERTER (g_zstd_decompressor_new (NULL));
+  else if (flags & G_RESOURCE_FLAGS_COMPRESSED)
+    return G_CONVERTER (g_zlib_decompressor_new (G_ZLIB_COMPRESSOR_FORMAT_ZLIB));
+  else
+    return NULL;
+}
+
 /**
  * g_resource_open_stream:
  * @resource: A #GResource
@@ -770,6 +929,7 @@ g_resource_open_stream (GResource             *resource,
   gsize data_size;
   guint32 flags;
   GInputStream *stream, *stream2;
+  GConverter *decompressor;
 
   if (!do_lookup (resource, path, lookup_flags, NULL, &flags, &data, &data_size, error))
     return NULL;
@@ -779,12 +939,10 @@ g_resource_open_stream (GResource             *resource,
                           g_resource_ref (resource),
                           (GDestroyNotify)g_resource_unref);
 
-  if (flags & G_RESOURCE_FLAGS_COMPRESSED)
+  decompressor = create_decompressor (flags);
+  if (decompressor != NULL)
     {
-      GZlibDecompressor *decompressor =
-        g_zlib_decompressor_new (G_ZLIB_COMPRESSOR_FORMAT_ZLIB);
-
-      stream2 = g_converter_input_stream_new (stream, G_CONVERTER (decompressor));
+      stream2 = g_converter_input_stream_new (stream, decompressor);
       g_object_unref (decompressor);
       g_object_unref (stream);
       stream = stream2;
@@ -810,8 +968,11 @@ g_resource_open_stream (GResource             *resource,
  *
  * For uncompressed resource files this is a pointer directly into
  * the resource bundle, which is typically in some readonly data section
- * in the program binary. For compressed files we allocate memory on
- * the heap and automatically uncompress the data.
+ * in the program binary, or the memory mapping of the file passed to
+ * g_resource_load(). No copy is made. For compressed files we allocate
+ * memory on the heap and automatically uncompress the data. Since GLib
+ * 2.82 the uncompressed data of small files is cached, so looking up the
+ * same compressed file again may return the same data.
  *
  * @lookup_flags controls the behaviour of the lookup.
  *
@@ -830,13 +991,19 @@ g_resource_lookup_data (GResource             *resource,
   guint32 flags;
   gsize data_size;
   gsize size;
+  GConverter *decompressor;
+  GBytes *bytes;
+
+  bytes = resource_cache_lookup (resource, path);
+  if (bytes != NULL)
+    return bytes;
 
   if (!do_lookup (resource, path, lookup_flags, &size, &flags, &data, &data_size, error))
     return NULL;
 
   if (size == 0)
     return g_bytes_new_with_free_func ("", 0, (GDestroyNotify) g_resource_unref, g_resource_ref (resource));
-  else if (flags & G_RESOURCE_FLAGS_COMPRESSED)
+  else if ((decompressor = create_decompressor (flags)) != NULL)
     {
       char *uncompressed, *d;
       const char *s;
@@ -844,10 +1011,6 @@ g_resource_lookup_data (GResource             *resource,
       gsize d_size, s_size;
       gsize bytes_read, bytes_written;
 
-
-      GZlibDecompressor *decompressor =
-        g_zlib_decompressor_new (G_ZLIB_COMPRESSOR_FORMAT_ZLIB);
-
       uncompressed = g_malloc (size + 1);
 
       s = data;
@@ -857,7 +1020,7 @@ g_resource_lookup_data (GResource             *resource,
 
       do
         {
-          res = g_converter_convert (G_CONVERTER (decompressor),
+          res = g_converter_convert (decompressor,
                                      s, s_size,
                                      d, d_size,
                                      G_CONVERTER_INPUT_AT_END,
@@ -886,7 +1049,10 @@ g_resource_lookup_data (GResource             *resource,
 
       g_object_unref (decompressor);
 
-      return g_bytes_new_take (uncompressed, size);
+      bytes = g_bytes_new_take (uncompressed, size);
+      resource_cache_insert (resource, path, bytes);
+
+      return bytes;
     }
   else
     return g_bytes_new_with_free_func (data, data_size, (GDestroyNotify)g_resource_unref, g_resource_ref (resource));
@@ -1016,14 +1182,121 @@ g_resource_enumerate_children (GResource             *resource,
 static GRWLock resources_lock;
 static GList *registered_resources;
 
+/* Maps the path of every file in the registered resources to the first
+ * resource in @registered_resources which has it, so lookups don’t have
+ * to try each resource in turn. Directories aren’t in it. Protected by
+ * @resources_lock. */
+static GHashTable *resources_index;  /* (element-type filename GResource) (nullable) */
+
 /* This is updated atomically, so we can append to it and check for NULL outside the
    lock, but all other accesses are done under the write lock */
 static GStaticResource *lazy_register_resources;
 
+static inline gboolean
+is_directory_name (const gchar *name)
+{
+  gsize len = strlen (name);
+
+  return len > 0 && name[len - 1] == '/';
+}
+
+/* @resource has just been prepended to @registered_resources, so it
+ * takes precedence for all of its files */
+static void
+resources_index_add_unlocked (GResource *resource)
+{
+  gchar **names;
+  gsize n_names, i;
+
+  if (resources_index == NULL)
+    resources_index = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  names = gvdb_table_get_names (resource->table, &n_names);
+
+  for (i = 0; i < n_names; i++)
+    {
+      if (names[i] == NULL || is_directory_name (names[i]))
+        g_free (names[i]);
+      else
+        g_hash_table_replace (resources_index, names[i], resource);
+    }
+
+  g_free (names);
+}
+
+/* @resource_link is about to be removed from @registered_resources; its
+ * files now come from the next resource which has them, if any */
+static void
+resources_index_remove_unlocked (GList *resource_link)
+{
+  GResource *resource = resource_link->data;
+  gchar **names;
+  gsize n_names, i;
+
+  names = gvdb_table_get_names (resource->table, &n_names);
+
+  for (i = 0; i < n_names; i++)
+    {
+      GResource *next = NULL;
+      GList *l;
+
+      if (names[i] == NULL ||
+          g_hash_table_lookup (resources_index, names[i]) != resource)
+        {
+          g_free (names[i]);
+          continue;
+        }
+
+      for (l = registered_resources; l != NULL; l = l->next)
+        {
+          GResource *r = l->data;
+
+          if (l != resource_link && gvdb_table_has_value (r->table, names[i]))
+            {
+              next = r;
+              break;
+            }
+        }
+
+      if (next != NULL)
+        g_hash_table_insert (resources_index, names[i], next);
+      else
+        {
+          g_hash_table_remove (resources_index, names[i]);
+          g_free (names[i]);
+        }
+    }
+
+  g_free (names);
+}
+
+/* Returns the registered resource which has the file at @path, or %NULL */
+static GResource *
+resources_index_lookup_unlocked (const gchar *path)
+{
+  gchar *free_path = NULL;
+  GResource *resource;
+  gsize path_len;
+
+  if (resources_index == NULL)
+    return NULL;
+
+  /* Drop any trailing slash, like do_lookup() does. */
+  path_len = strlen (path);
+  if (path_len >= 1 && path[path_len-1] == '/')
+    path = free_path = g_strndup (path, path_len - 1);
+
+  resource = g_hash_table_lookup (resources_index, path);
+  g_free (free_path);
+
+  return resource;
+}
+
 static void
 g_resources_register_unlocked (GResource *resource)
 {
   registered_resources = g_list_prepend (registered_resources, g_resource_ref (resource));
+  resources_index_add_unlocked (resource);
 }
 
 static void
@@ -1037,6 +1310,7 @@ g_resources_unregister_unlocked (GResource *resource)
     }
   else
     {
+      resources_index_remove_unlocked (resource_link);
       g_resource_unref (resource_link->data);
       registered_resources = g_list_delete_link (registered_resources, resource_link);
     }
@@ -1099,8 +1373,7 @@ g_resources_open_stream (const gchar           *path,
                          GError               **error)
 {
   GInputStream *res = NULL;
-  GList *l;
-  GInputStream *stream;
+  GResource *r;
 
   if (g_resource_find_overlay (path, open_overlay_stream, &res))
     return res;
@@ -1109,27 +1382,10 @@ g_resources_open_stream (const gchar           *path,
 
   g_rw_lock_reader_lock (&resources_lock);
 
-  for (l = registered_resources; l != NULL; l = l->next)
-    {
-      GResource *r = l->data;
-      GError *my_error = NULL;
-
-      stream = g_resource_open_stream (r, path, lookup_flags, &my_error);
-      if (stream == NULL &&
-          g_error_matches (my_error, G_RESOURCE_ERROR, G_RESOURCE_ERROR_NOT_FOUND))
-        {
-          g_clear_error (&my_error);
-        }
-      else
-        {
-          if (stream == NULL)
-            g_propagate_error (error, my_error);
-          res = stream;
-          break;
-        }
-    }
-
-  if (l == NULL)
+  r = resources_index_lookup_unlocked (path);
+  if (r != NULL)
+    res = g_resource_open_stream (r, path, lookup_flags, error);
+  else
     g_set_error (error, G_RESOURCE_ERROR, G_RESOURCE_ERROR_NOT_FOUND,
                  _("The resource at “%s” does not exist"),
                  path);
@@ -1155,8 +1411,11 @@ g_resources_open_stream (const gchar           *path,
  *
  * For uncompressed resource files this is a pointer directly into
  * the resource bundle, which is typically in some readonly data section
- * in the program binary. For compressed files we allocate memory on
- * the heap and automatically uncompress the data.
+ * in the program binary, or the memory mapping of the file passed to
+ * g_resource_load(). No copy is made. For compressed files we allocate
+ * memory on the heap and automatically uncompress the data. Since GLib
+ * 2.82 the uncompressed data of small files is cached, so looking up the
+ * same compressed file again may return the same data.
  *
  * @lookup_flags controls the behaviour of the lookup.
  *
@@ -1171,8 +1430,7 @@ g_resources_lookup_data (const gchar           *path,
                          GError               **error)
 {
   GBytes *res = NULL;
-  GList *l;
-  GBytes *data;
+  GResource *r;
 
   if (g_resource_find_overlay (path, get_overlay_bytes, &res))
     return res;
@@ -1181,27 +1439,10 @@ g_resources_lookup_data (const gchar           *path,
 
   g_rw_lock_reader_lock (&resources_lock);
 
-  for (l = registered_resources; l != NULL; l = l->next)
-    {
-      GResource *r = l->data;
-      GError *my_error = NULL;
-
-      data = g_resource_lookup_data (r, path, lookup_flags, &my_error);
-      if (data == NULL &&
-          g_error_matches (my_error, G_RESOURCE_ERROR, G_RESOURCE_ERROR_NOT_FOUND))
-        {
-          g_clear_error (&my_error);
-        }
-      else
-        {
-          if (data == NULL)
-            g_propagate_error (error, my_error);
-          res = data;
-          break;
-        }
-    }
-
-  if (l == NULL)
+  r = resources_index_lookup_unlocked (path);
+  if (r != NULL)
+    res = g_resource_lookup_data (r, path, lookup_flags, error);
+  else
     g_set_error (error, G_RESOURCE_ERROR, G_RESOURCE_ERROR_NOT_FOUND,
                  _("The resource at “%s” does not exist"),
                  path);
@@ -1318,8 +1559,7 @@ g_resources_get_info (const gchar           *path,
                       GError               **error)
 {
   gboolean res = FALSE;
-  GList *l;
-  gboolean r_res;
+  GResource *r;
   InfoData info;
 
   if (g_resource_find_overlay (path, get_overlay_info, &info))
@@ -1336,27 +1576,10 @@ g_resources_get_info (const gchar           *path,
 
   g_rw_lock_reader_lock (&resources_lock);
 
-  for (l = registered_resources; l != NULL; l = l->next)
-    {
-      GResource *r = l->data;
-      GError *my_error = NULL;
-
-      r_res = g_resource_get_info (r, path, lookup_flags, size, flags, &my_error);
-      if (!r_res &&
-          g_error_matches (my_error, G_RESOURCE_ERROR, G_RESOURCE_ERROR_NOT_FOUND))
-        {
-          g_clear_error (&my_error);
-        }
-      else
-        {
-          if (!r_res)
-            g_propagate_error (error, my_error);
-          res = r_res;
-          break;
-        }
-    }
-
-  if (l == NULL)
+  r = resources_index_lookup_unlocked (path);
+  if (r != NULL)
+    res = g_resource_get_info (r, path, lookup_flags, size, flags, error);
+  else
     g_set_error (error, G_RESOURCE_ERROR, G_RESOURCE_ERROR_NOT_FOUND,
                  _("The resource at “%s” does not exist"),
                  path);
@@ -517,7 +517,7 @@ g_resource_file_query_info (GFile                *file,
       g_file_info_set_size (info, size);
 
       if ((_g_file_attribute_matcher_matches_id (matcher, G_FILE_ATTRIBUTE_ID_STANDARD_CONTENT_TYPE) ||
-           ((~resource_flags & G_RESOURCE_FLAGS_COMPRESSED) && 
+           ((~resource_flags & (G_RESOURCE_FLAGS_COMPRESSED | G_RESOURCE_FLAGS_COMPRESSED_ZSTD)) && 
             _g_file_attribute_matcher_matches_id (matcher, G_FILE_ATTRIBUTE_ID_STANDARD_FAST_CONTENT_TYPE))) &&
           (bytes = g_resources_lookup_data (resource->path, 0, NULL)))
         {
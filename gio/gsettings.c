@@ -338,6 +338,20 @@ struct _GSettingsPrivate
   GSettingsBackend *backend;
   GSettingsSchema *schema;
   gchar *path;
+
+  /* Values returned by g_settings_get_value(), dropped by the backend’s
+   * change notifications.  These are received through a second watch
+   * without a main context, so that they arrive before any write to the
+   * backend returns. */
+  GMutex cache_lock;
+  GHashTable *cache;  /* (owned) (nullable) (element-type utf8 GVariant) */
+  guint cache_generation;  /* incremented by each invalidation */
+
+  /* Only accessed from main_context */
+  gboolean coalesce_changes;
+  GSource *coalesce_source;  /* (owned) (nullable) */
+  GArray *pending_changes;  /* (owned) (nullable) (element-type GQuark) */
+  gboolean pending_all_changed;
 };
 
 enum
@@ -412,6 +426,83 @@ g_settings_real_writable_change_event (GSettings *settings,
   return FALSE;
 }
 
+static gboolean
+g_settings_flush_change_events (gpointer user_data)
+{
+  GSettings *settings = user_data;
+  GSettingsPrivate *priv = settings->priv;
+  GArray *keys = g_steal_pointer (&priv->pending_changes);
+  gboolean all_changed = priv->pending_all_changed;
+  gboolean ignore_this;
+
+  g_clear_pointer (&priv->coalesce_source, g_source_unref);
+  priv->pending_all_changed = FALSE;
+
+  if (all_changed)
+    g_signal_emit (settings, g_settings_signals[SIGNAL_CHANGE_EVENT],
+                   0, NULL, 0, &ignore_this);
+  else if (keys != NULL && keys->len > 0)
+    g_signal_emit (settings, g_settings_signals[SIGNAL_CHANGE_EVENT],
+                   0, (GQuark *) keys->data, (gint) keys->len, &ignore_this);
+
+  g_clear_pointer (&keys, g_array_unref);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Emits #GSettings::change-event for @keys, or for all keys if @keys is
+ * %NULL.  If changes are coalesced, the keys are queued, and a single
+ * event is emitted for all of them from an idle source instead. */
+static void
+g_settings_emit_change_event (GSettings    *settings,
+                              const GQuark *keys,
+                              gint          n_keys)
+{
+  GSettingsPrivate *priv = settings->priv;
+  gboolean ignore_this;
+  gint i;
+
+  if (!priv->coalesce_changes || G_IS_DELAYED_SETTINGS_BACKEND (priv->backend))
+    {
+      g_signal_emit (settings, g_settings_signals[SIGNAL_CHANGE_EVENT],
+                     0, keys, n_keys, &ignore_this);
+      return;
+    }
+
+  if (keys == NULL)
+    {
+      priv->pending_all_changed = TRUE;
+      g_clear_pointer (&priv->pending_changes, g_array_unref);
+    }
+  else if (!priv->pending_all_changed)
+    {
+      if (priv->pending_changes == NULL)
+        priv->pending_changes = g_array_new (FALSE, FALSE, sizeof (GQuark));
+
+      for (i = 0; i < n_keys; i++)
+        {
+          guint j;
+
+          for (j = 0; j < priv->pending_changes->len; j++)
+            if (g_array_index (priv->pending_changes, GQuark, j) == keys[i])
+              break;
+
+          if (j == priv->pending_changes->len)
+            g_array_append_val (priv->pending_changes, keys[i]);
+        }
+    }
+
+  if (priv->coalesce_source == NULL)
+    {
+      priv->coalesce_source = g_idle_source_new ();
+      g_source_set_priority (priv->coalesce_source, G_PRIORITY_DEFAULT);
+      g_source_set_callback (priv->coalesce_source, g_settings_flush_change_events,
+                             g_object_ref (settings), g_object_unref);
+      g_source_set_static_name (priv->coalesce_source, "[gio] GSettings change events");
+      g_source_attach (priv->coalesce_source, priv->main_context);
+    }
+}
+
 static void
 settings_backend_changed (GObject             *target,
                           GSettingsBackend    *backend,
@@ -419,7 +510,6 @@ settings_backend_changed (GObject             *target,
                           gpointer             origin_tag)
 {
   GSettings *settings = G_SETTINGS (target);
-  gboolean ignore_this;
   gint i;
 
   /* We used to assert here:
@@ -442,8 +532,7 @@ settings_backend_changed (GObject             *target,
       GQuark quark;
 
       quark = g_quark_from_string (key + i);
-      g_signal_emit (settings, g_settings_signals[SIGNAL_CHANGE_EVENT],
-                     0, &quark, 1, &ignore_this);
+      g_settings_emit_change_event (settings, &quark, 1);
     }
 }
 
@@ -454,11 +543,9 @@ settings_backend_path_changed (GObject          *target,
                                gpointer          origin_tag)
 {
   GSettings *settings = G_SETTINGS (target);
-  gboolean ignore_this;
 
   if (g_str_has_prefix (settings->priv->path, path))
-    g_signal_emit (settings, g_settings_signals[SIGNAL_CHANGE_EVENT],
-                   0, NULL, 0, &ignore_this);
+    g_settings_emit_change_event (settings, NULL, 0);
 }
 
 static void
@@ -469,7 +556,6 @@ settings_backend_keys_changed (GObject             *target,
                                const gchar * const *items)
 {
   GSettings *settings = G_SETTINGS (target);
-  gboolean ignore_this;
   gint i;
 
   for (i = 0; settings->priv->path[i] &&
@@ -498,8 +584,7 @@ settings_backend_keys_changed (GObject             *target,
          }
 
       if (l > 0)
-        g_signal_emit (settings, g_settings_signals[SIGNAL_CHANGE_EVENT],
-                       0, quarks, l, &ignore_this);
+        g_settings_emit_change_event (settings, quarks, l);
     }
 }
 
@@ -533,6 +618,137 @@ settings_backend_path_writable_changed (GObject          *target,
                    0, (GQuark) 0, &ignore_this);
 }
 
+/* Value cache {{{1 */
+/* Drops @key, relative to the path of @settings, from the cache of
+ * @settings, or all keys if @key is %NULL */
+static void
+g_settings_cache_invalidate (GSettings   *settings,
+                             const gchar *key)
+{
+  GSettingsPrivate *priv = settings->priv;
+
+  g_mutex_lock (&priv->cache_lock);
+  priv->cache_generation++;
+  if (priv->cache != NULL)
+    {
+      if (key != NULL)
+        g_hash_table_remove (priv->cache, key);
+      else
+        g_hash_table_remove_all (priv->cache);
+    }
+  g_mutex_unlock (&priv->cache_lock);
+}
+
+/* Returns a new reference to the cached value of @key, or %NULL.  In
+ * that case, @generation is set to the generation to give to
+ * g_settings_cache_insert() once the value has been read. */
+static GVariant *
+g_settings_cache_lookup (GSettings   *settings,
+                         const gchar *key,
+                         guint       *generation)
+{
+  GSettingsPrivate *priv = settings->priv;
+  GVariant *value = NULL;
+
+  g_mutex_lock (&priv->cache_lock);
+  if (priv->cache != NULL)
+    value = g_hash_table_lookup (priv->cache, key);
+  if (value != NULL)
+    g_variant_ref (value);
+  *generation = priv->cache_generation;
+  g_mutex_unlock (&priv->cache_lock);
+
+  return value;
+}
+
+static void
+g_settings_cache_insert (GSettings   *settings,
+                         const gchar *key,
+                         GVariant    *value,
+                         guint        generation)
+{
+  GSettingsPrivate *priv = settings->priv;
+
+  g_mutex_lock (&priv->cache_lock);
+
+  /* Don’t store a value which may have changed while it was being read */
+  if (priv->cache_generation == generation)
+    {
+      if (priv->cache == NULL)
+        priv->cache = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                             g_free, (GDestroyNotify) g_variant_unref);
+      g_hash_table_replace (priv->cache, g_strdup (key), g_variant_ref (value));
+    }
+
+  g_mutex_unlock (&priv->cache_lock);
+}
+
+static void
+settings_cache_changed (GObject          *target,
+                        GSettingsBackend *backend,
+                        const gchar      *key,
+                        gpointer          origin_tag)
+{
+  GSettings *settings = G_SETTINGS (target);
+
+  if (g_str_has_prefix (key, settings->priv->path))
+    g_settings_cache_invalidate (settings, key + strlen (settings->priv->path));
+}
+
+static void
+settings_cache_path_changed (GObject          *target,
+                             GSettingsBackend *backend,
+                             const gchar      *path,
+                             gpointer          origin_tag)
+{
+  GSettings *settings = G_SETTINGS (target);
+
+  if (g_str_has_prefix (settings->priv->path, path))
+    g_settings_cache_invalidate (settings, NULL);
+}
+
+static void
+settings_cache_keys_changed (GObject             *target,
+                             GSettingsBackend    *backend,
+                             const gchar         *path,
+                             gpointer             origin_tag,
+                             const gchar * const *items)
+{
+  gint i;
+
+  for (i = 0; items[i]; i++)
+    {
+      gchar *key = g_strconcat (path, items[i], NULL);
+      settings_cache_changed (target, backend, key, origin_tag);
+      g_free (key);
+    }
+}
+
+/* Locking a key may change its value to the default one */
+static void
+settings_cache_writable_changed (GObject          *target,
+                                 GSettingsBackend *backend,
+                                 const gchar      *key)
+{
+  settings_cache_changed (target, backend, key, NULL);
+}
+
+static void
+settings_cache_path_writable_changed (GObject          *target,
+                                      GSettingsBackend *backend,
+                                      const gchar      *path)
+{
+  settings_cache_path_changed (target, backend, path, NULL);
+}
+
+static const GSettingsListenerVTable cache_listener_vtable = {
+  settings_cache_changed,
+  settings_cache_path_changed,
+  settings_cache_keys_changed,
+  settings_cache_writable_changed,
+  settings_cache_path_writable_changed
+};
+
 /* Properties, Construction, Destruction {{{1 */
 static void
 g_settings_set_property (GObject      *object,
@@ -675,6 +891,11 @@ g_settings_constructed (GObject *object)
   if (settings->priv->backend == NULL)
     settings->priv->backend = g_settings_backend_get_default ();
 
+  /* Watches are notified in the order they were added, and the cache
+   * must be invalidated before the signals are emitted */
+  g_settings_backend_watch (settings->priv->backend,
+                            &cache_listener_vtable, G_OBJECT (settings),
+                            NULL);
   g_settings_backend_watch (settings->priv->backend,
                             &listener_vtable, G_OBJECT (settings),
                             settings->priv->main_context);
@@ -693,6 +914,9 @@ g_settings_finalize (GObject *object)
   g_object_unref (settings->priv->backend);
   g_settings_schema_unref (settings->priv->schema);
   g_free (settings->priv->path);
+  g_clear_pointer (&settings->priv->cache, g_hash_table_unref);
+  g_mutex_clear (&settings->priv->cache_lock);
+  g_clear_pointer (&settings->priv->pending_changes, g_array_unref);
 
   G_OBJECT_CLASS (g_settings_parent_class)->finalize (object);
 }
@@ -702,6 +926,7 @@ g_settings_init (GSettings *settings)
 {
   settings->priv = g_settings_get_instance_private (settings);
   settings->priv->main_context = g_main_context_ref_thread_default ();
+  g_mutex_init (&settings->priv->cache_lock);
 }
 
 static void
@@ -1186,6 +1411,9 @@ g_settings_read_from_backend (GSettings          *settings,
  * It is a programmer error to give a @key that isn't contained in the
  * schema for @settings.
  *
+ * Since GLib 2.82, the value is cached by @settings until the backend
+ * signals a change to @key, so reading the same key repeatedly is cheap.
+ *
  * Returns: (not nullable) (transfer full): a new #GVariant
  *
  * Since: 2.26
@@ -1196,21 +1424,99 @@ g_settings_get_value (GSettings   *settings,
 {
   GSettingsSchemaKey skey;
   GVariant *value;
+  guint generation;
+  gboolean cacheable;
 
   g_return_val_if_fail (G_IS_SETTINGS (settings), NULL);
   g_return_val_if_fail (key != NULL, NULL);
 
+  value = g_settings_cache_lookup (settings, key, &generation);
+  if (value != NULL)
+    return value;
+
   g_settings_schema_key_init (&skey, settings->priv->schema, key);
   value = g_settings_read_from_backend (settings, &skey, FALSE, FALSE);
 
+  /* Translated defaults depend on the current locale */
+  cacheable = value != NULL || skey.lc_char == '\0';
+
   if (value == NULL)
     value = g_settings_schema_key_get_default_value (&skey);
 
+  if (cacheable)
+    g_settings_cache_insert (settings, key, value, generation);
+
   g_settings_schema_key_clear (&skey);
 
   return value;
 }
 
+/**
+ * g_settings_get_many:
+ * @settings: a #GSettings object
+ * @keys: (array zero-terminated=1): the keys to get the values for
+ *
+ * Gets the values of several keys at once, as a tuple which contains
+ * the value of each of @keys, in order.  This is equivalent to calling
+ * g_settings_get_value() for each of @keys, but the values which are
+ * already cached are all fetched at once.
+ *
+ * The values can be unpacked with g_variant_get(), for example:
+ * |[<!-- language="C" -->
+ *   const gchar * const keys[] = { "font-name", "scaling-factor", NULL };
+ *   g_autoptr(GVariant) values = g_settings_get_many (settings, keys);
+ *   g_autofree gchar *font_name = NULL;
+ *   guint scaling_factor;
+ *
+ *   g_variant_get (values, "(su)", &font_name, &scaling_factor);
+ * ]|
+ *
+ * It is a programmer error to give a key that isn't contained in the
+ * schema for @settings.
+ *
+ * Returns: (not nullable) (transfer full): a new tuple #GVariant
+ *
+ * Since: 2.82
+ */
+GVariant *
+g_settings_get_many (GSettings           *settings,
+                     const gchar * const *keys)
+{
+  GSettingsPrivate *priv;
+  GVariant **values;
+  GVariant *result;
+  gsize n_keys, i;
+
+  g_return_val_if_fail (G_IS_SETTINGS (settings), NULL);
+  g_return_val_if_fail (keys != NULL, NULL);
+
+  priv = settings->priv;
+  n_keys = g_strv_length ((gchar **) keys);
+  values = g_new0 (GVariant *, n_keys);
+
+  g_mutex_lock (&priv->cache_lock);
+  if (priv->cache != NULL)
+    for (i = 0; i < n_keys; i++)
+      {
+        values[i] = g_hash_table_lookup (priv->cache, keys[i]);
+        if (values[i] != NULL)
+          g_variant_ref (values[i]);
+      }
+  g_mutex_unlock (&priv->cache_lock);
+
+  for (i = 0; i < n_keys; i++)
+    if (values[i] == NULL)
+      values[i] = g_settings_get_value (settings, keys[i]);
+
+  result = g_variant_ref_sink (g_variant_new_tuple (values, n_keys));
+
+  for (i = 0; i < n_keys; i++)
+    g_variant_unref (values[i]);
+  g_free (values);
+
+  return result;
+}
+
 /**
  * g_settings_get_user_value:
  * @settings: a #GSettings object
@@ -2245,13 +2551,19 @@ g_settings_delay (GSettings *settings)
   delayed = g_delayed_settings_backend_new (settings->priv->backend,
                                             settings,
                                             settings->priv->main_context);
+  /* Drop both the signal and the cache watches */
+  g_settings_backend_unwatch (settings->priv->backend, G_OBJECT (settings));
   g_settings_backend_unwatch (settings->priv->backend, G_OBJECT (settings));
   g_object_unref (settings->priv->backend);
 
   settings->priv->backend = G_SETTINGS_BACKEND (delayed);
+  g_settings_backend_watch (settings->priv->backend,
+                            &cache_listener_vtable, G_OBJECT (settings),
+                            NULL);
   g_settings_backend_watch (settings->priv->backend,
                             &listener_vtable, G_OBJECT (settings),
                             settings->priv->main_context);
+  g_settings_cache_invalidate (settings, NULL);
 
   g_object_notify (G_OBJECT (settings), "delay-apply");
 }
@@ -2321,6 +2633,57 @@ g_settings_get_has_unapplied (GSettings *settings)
            G_DELAYED_SETTINGS_BACKEND (settings->priv->backend));
 }
 
+/**
+ * g_settings_set_coalesce_changes:
+ * @settings: a #GSettings object
+ * @coalesce_changes: whether to coalesce change notifications
+ *
+ * Sets whether change notifications for @settings are coalesced.
+ *
+ * By default, #GSettings::change-event and #GSettings::changed are
+ * emitted as soon as the backend reports each change.  If changes are
+ * coalesced, all the keys which change during an iteration of the
+ * main context of @settings are reported in a single
+ * #GSettings::change-event, emitted from an idle source in the next
+ * iteration, and #GSettings::changed is emitted once per key.  This
+ * avoids redundant work when many keys change in a burst, for example
+ * when a whole directory of keys is reset.
+ *
+ * Changes are never coalesced while @settings is in 'delay-apply'
+ * mode; see g_settings_delay().
+ *
+ * This must be called from the thread which created @settings.
+ *
+ * Since: 2.82
+ */
+void
+g_settings_set_coalesce_changes (GSettings *settings,
+                                 gboolean   coalesce_changes)
+{
+  g_return_if_fail (G_IS_SETTINGS (settings));
+
+  settings->priv->coalesce_changes = !!coalesce_changes;
+}
+
+/**
+ * g_settings_get_coalesce_changes:
+ * @settings: a #GSettings object
+ *
+ * Gets whether change notifications for @settings are coalesced. See
+ * g_settings_set_coalesce_changes().
+ *
+ * Returns: %TRUE if change notifications are coalesced
+ *
+ * Since: 2.82
+ */
+gboolean
+g_settings_get_coalesce_changes (GSettings *settings)
+{
+  g_return_val_if_fail (G_IS_SETTINGS (settings), FALSE);
+
+  return settings->priv->coalesce_changes;
+}
+
 /* Extra API (reset, sync, get_child, is_writable, list_*, ranges) {{{1 */
 /**
  * g_settings_reset:
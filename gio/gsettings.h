@@ -111,6 +111,9 @@ gboolean                g_settings_set_value                            (GSettin
 GIO_AVAILABLE_IN_ALL
 GVariant *              g_settings_get_value                            (GSettings          *settings,
                                                                          const gchar        *key);
+GIO_AVAILABLE_IN_2_82
+GVariant *              g_settings_get_many                             (GSettings          *settings,
+                                                                         const gchar * const *keys);
 
 GIO_AVAILABLE_IN_2_40
 GVariant *              g_settings_get_user_value                       (GSettings          *settings,
@@ -219,6 +222,11 @@ GIO_AVAILABLE_IN_ALL
 void                    g_settings_revert                               (GSettings          *settings);
 GIO_AVAILABLE_IN_ALL
 gboolean                g_settings_get_has_unapplied                    (GSettings          *settings);
+GIO_AVAILABLE_IN_2_82
+void                    g_settings_set_coalesce_changes                 (GSettings          *settings,
+                                                                         gboolean            coalesce_changes);
+GIO_AVAILABLE_IN_2_82
+gboolean                g_settings_get_coalesce_changes                 (GSettings          *settings);
 GIO_AVAILABLE_IN_ALL
 void                    g_settings_sync                                 (void);
 
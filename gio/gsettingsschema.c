@@ -21,6 +21,7 @@
 #include "config.h"
 
 #include "glib-private.h"
+#include "gtrace-private.h"
 #include "gsettingsschema-internal.h"
 #include "gsettings.h"
 
@@ -153,6 +154,13 @@ struct _GSettingsSchema
 
   GSettingsSchema *extends;
 
+  /* Values of the keys looked up so far if @extends is set, so that
+   * each key is only searched for in the chain of GVDB tables once.
+   * Schemas without @extends look keys up in their own table, which
+   * needs no lock. */
+  GMutex values_lock;
+  GHashTable *values;  /* (owned) (nullable) (element-type utf8 GVariant) */
+
   gint ref_count;
 };
 
@@ -188,10 +196,17 @@ struct _GSettingsSchemaSource
   GvdbTable *table;
   GHashTable **text_tables;
 
+  /* Schemas already looked up in this source, shared by all the
+   * lookups.  Only used for the default sources, which are never
+   * freed: each schema holds a reference on its source. */
+  gboolean cache_schemas;
+  GHashTable *schemas;  /* (owned) (nullable) (element-type utf8 GSettingsSchema), protected by schema_cache */
+
   gint ref_count;
 };
 
 static GSettingsSchemaSource *schema_sources;
+G_LOCK_DEFINE_STATIC (schema_cache);
 
 /**
  * g_settings_schema_source_ref:
@@ -306,6 +321,8 @@ g_settings_schema_source_new_from_directory (const gchar            *directory,
   source->parent = parent ? g_settings_schema_source_ref (parent) : NULL;
   source->text_tables = NULL;
   source->table = table;
+  source->cache_schemas = FALSE;
+  source->schemas = NULL;
   source->ref_count = 1;
 
   return source;
@@ -315,12 +332,20 @@ static void
 try_prepend_dir (const gchar *directory)
 {
   GSettingsSchemaSource *source;
+  gint64 begin_time_nsec G_GNUC_UNUSED = G_TRACE_CURRENT_TIME;
 
   source = g_settings_schema_source_new_from_directory (directory, schema_sources, TRUE, NULL);
 
+  g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                "GIO", "settings schema source",
+                "%s: %s", directory, source != NULL ? "loaded" : "not found");
+
   /* If we successfully created it then prepend it to the global list */
   if (source != NULL)
-    schema_sources = source;
+    {
+      source->cache_schemas = TRUE;
+      schema_sources = source;
+    }
 }
 
 static void
@@ -346,6 +371,7 @@ initialise_schema_sources (void)
       const gchar *path;
       gchar **extra_schema_dirs;
       gint i;
+      gint64 begin_time_nsec G_GNUC_UNUSED = G_TRACE_CURRENT_TIME;
 
       /* iterate in reverse: count up, then count down */
       dirs = g_get_system_data_dirs ();
@@ -369,6 +395,9 @@ initialise_schema_sources (void)
           g_strfreev (extra_schema_dirs);
         }
 
+      g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                    "GIO", "settings schema sources", "Initialised default schema sources");
+
       g_once_init_leave (&initialised, TRUE);
     }
 }
@@ -423,6 +452,55 @@ g_settings_schema_source_get_default (void)
  *
  * Since: 2.32
  **/
+static GSettingsSchema *
+schema_cache_lookup (GSettingsSchemaSource *source,
+                     const gchar           *schema_id)
+{
+  GSettingsSchema *schema = NULL;
+
+  if (!source->cache_schemas)
+    return NULL;
+
+  G_LOCK (schema_cache);
+  if (source->schemas != NULL)
+    schema = g_hash_table_lookup (source->schemas, schema_id);
+  if (schema != NULL)
+    g_settings_schema_ref (schema);
+  G_UNLOCK (schema_cache);
+
+  return schema;
+}
+
+/* Returns @schema, or the schema with the same id which another thread
+ * added to the cache of @source in the meantime */
+static GSettingsSchema *
+schema_cache_insert (GSettingsSchemaSource *source,
+                     GSettingsSchema       *schema)
+{
+  GSettingsSchema *cached;
+
+  if (!source->cache_schemas)
+    return schema;
+
+  G_LOCK (schema_cache);
+  if (source->schemas == NULL)
+    source->schemas = g_hash_table_new (g_str_hash, g_str_equal);
+
+  cached = g_hash_table_lookup (source->schemas, schema->id);
+  if (cached == NULL)
+    g_hash_table_insert (source->schemas, schema->id, g_settings_schema_ref (schema));
+  else
+    g_settings_schema_ref (cached);
+  G_UNLOCK (schema_cache);
+
+  if (cached == NULL)
+    return schema;
+
+  g_settings_schema_unref (schema);
+
+  return cached;
+}
+
 GSettingsSchema *
 g_settings_schema_source_lookup (GSettingsSchemaSource *source,
                                  const gchar           *schema_id,
@@ -435,12 +513,20 @@ g_settings_schema_source_lookup (GSettingsSchemaSource *source,
   g_return_val_if_fail (source != NULL, NULL);
   g_return_val_if_fail (schema_id != NULL, NULL);
 
+  if ((schema = schema_cache_lookup (source, schema_id)))
+    return schema;
+
   table = gvdb_table_get_table (source->table, schema_id);
 
   if (table == NULL && recursive)
     for (source = source->parent; source; source = source->parent)
-      if ((table = gvdb_table_get_table (source->table, schema_id)))
-        break;
+      {
+        if ((schema = schema_cache_lookup (source, schema_id)))
+          return schema;
+
+        if ((table = gvdb_table_get_table (source->table, schema_id)))
+          break;
+      }
 
   if (table == NULL)
     return NULL;
@@ -448,6 +534,7 @@ g_settings_schema_source_lookup (GSettingsSchemaSource *source,
   schema = g_slice_new0 (GSettingsSchema);
   schema->source = g_settings_schema_source_ref (source);
   schema->ref_count = 1;
+  g_mutex_init (&schema->values_lock);
   schema->id = g_strdup (schema_id);
   schema->table = table;
   schema->path = g_settings_schema_get_string (schema, ".path");
@@ -464,7 +551,7 @@ g_settings_schema_source_lookup (GSettingsSchemaSource *source,
         g_warning ("Schema '%s' extends schema '%s' but we could not find it", schema_id, extends);
     }
 
-  return schema;
+  return schema_cache_insert (source, schema);
 }
 
 typedef struct
@@ -783,6 +870,7 @@ g_settings_schema_source_list_schemas (GSettingsSchemaSource   *source,
 {
   GHashTable *single, *reloc;
   GSettingsSchemaSource *s;
+  gint64 begin_time_nsec G_GNUC_UNUSED = G_TRACE_CURRENT_TIME;
 
   /* We use hash tables to avoid duplicate listings for schemas that
    * appear in more than one file.
@@ -844,6 +932,9 @@ g_settings_schema_source_list_schemas (GSettingsSchemaSource   *source,
 
   g_hash_table_unref (single);
   g_hash_table_unref (reloc);
+
+  g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                "GIO", "settings schema list", "%s", recursive ? "recursive" : "");
 }
 
 static gchar **non_relocatable_schema_list;
@@ -945,6 +1036,8 @@ g_settings_schema_unref (GSettingsSchema *schema)
         g_settings_schema_unref (schema->extends);
 
       g_settings_schema_source_unref (schema->source);
+      g_clear_pointer (&schema->values, g_hash_table_unref);
+      g_mutex_clear (&schema->values_lock);
       gvdb_table_free (schema->table);
       g_free (schema->items);
       g_free (schema->id);
@@ -987,19 +1080,55 @@ g_settings_schema_get_child_schema (GSettingsSchema *schema,
   return g_settings_schema_source_lookup (schema->source, child_id, TRUE);
 }
 
+/* Looks @key up in the tables of @schema and the schemas it extends,
+ * remembering the result. Returns a new reference, or %NULL. */
+static GVariant *
+g_settings_schema_get_inherited_value (GSettingsSchema *schema,
+                                       const gchar     *key)
+{
+  GSettingsSchema *s;
+  GVariant *value = NULL;
+
+  g_mutex_lock (&schema->values_lock);
+  if (schema->values != NULL)
+    value = g_hash_table_lookup (schema->values, key);
+  if (value != NULL)
+    g_variant_ref (value);
+  g_mutex_unlock (&schema->values_lock);
+
+  if (value != NULL)
+    return value;
+
+  for (s = schema; s; s = s->extends)
+    if ((value = gvdb_table_get_raw_value (s->table, key)))
+      break;
+
+  if (value == NULL)
+    return NULL;
+
+  g_mutex_lock (&schema->values_lock);
+  if (schema->values == NULL)
+    schema->values = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                            g_free, (GDestroyNotify) g_variant_unref);
+  g_hash_table_replace (schema->values, g_strdup (key), g_variant_ref (value));
+  g_mutex_unlock (&schema->values_lock);
+
+  return value;
+}
+
 GVariantIter *
 g_settings_schema_get_value (GSettingsSchema *schema,
                              const gchar     *key)
 {
-  GSettingsSchema *s = schema;
   GVariantIter *iter;
-  GVariant *value = NULL;
+  GVariant *value;
 
   g_return_val_if_fail (schema != NULL, NULL);
 
-  for (s = schema; s; s = s->extends)
-    if ((value = gvdb_table_get_raw_value (s->table, key)))
-      break;
+  if (schema->extends == NULL)
+    value = gvdb_table_get_raw_value (schema->table, key);
+  else
+    value = g_settings_schema_get_inherited_value (schema, key);
 
   if G_UNLIKELY (value == NULL || !g_variant_is_of_type (value, G_VARIANT_TYPE_TUPLE))
     g_error ("Settings schema '%s' does not contain a key named '%s'", schema->id, key);
@@ -1145,11 +1274,13 @@ const GQuark *
 g_settings_schema_list (GSettingsSchema *schema,
                         gint            *n_items)
 {
-  if (schema->items == NULL)
+  /* Schemas from the default sources are shared between threads */
+  if (g_once_init_enter_pointer (&schema->items))
     {
       GSettingsSchema *s;
       GHashTableIter iter;
       GHashTable *items;
+      GQuark *quarks;
       gpointer name;
       gint len;
       gint i;
@@ -1227,18 +1358,21 @@ g_settings_schema_list (GSettingsSchema *schema,
             gvdb_table_free (child_table);
           }
 
-      /* Now create the list */
+      /* Now create the list; it is never %NULL, even when empty */
       len = g_hash_table_size (items);
-      schema->items = g_new (GQuark, len);
+      quarks = g_new (GQuark, len + 1);
       i = 0;
       g_hash_table_iter_init (&iter, items);
 
       while (g_hash_table_iter_next (&iter, &name, NULL))
-        schema->items[i++] = g_quark_from_string (name);
+        quarks[i++] = g_quark_from_string (name);
+      quarks[i] = 0;
       schema->n_items = i;
       g_assert (i == len);
 
       g_hash_table_unref (items);
+
+      g_once_init_leave_pointer (&schema->items, quarks);
     }
 
   *n_items = schema->n_items;
@@ -1263,11 +1397,7 @@ static inline void
 endian_fixup (GVariant **value)
 {
 #if G_BYTE_ORDER == G_BIG_ENDIAN
-  GVariant *tmp;
-
-  tmp = g_variant_byteswap (*value);
-  g_variant_unref (*value);
-  *value = tmp;
+  *value = g_variant_byteswap_take (*value);
 #endif
 }
 
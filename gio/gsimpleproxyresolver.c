@@ -47,18 +47,15 @@
  * Since: 2.36
  */
 
-typedef struct {
-  gchar        *name;
-  gsize          length;
-  gushort       port;
-} GSimpleProxyResolverDomain;
-
 struct _GSimpleProxyResolverPrivate {
   gchar *default_proxy, **ignore_hosts;
   GHashTable *uri_proxies;
 
   GPtrArray *ignore_ips;
-  GSimpleProxyResolverDomain *ignore_domains;
+  /* Lowercased domain name → GArray of ports (0 meaning any), so that
+   * a host is matched by looking up each of its parent domains rather
+   * than comparing it against every entry. */
+  GHashTable *ignore_domains;
 };
 
 static void g_simple_proxy_resolver_iface_init (GProxyResolverInterface *iface);
@@ -152,30 +149,25 @@ reparse_ignore_hosts (GSimpleProxyResolver *resolver)
 {
   GSimpleProxyResolverPrivate *priv = resolver->priv;
   GPtrArray *ignore_ips;
-  GArray *ignore_domains;
+  GHashTable *ignore_domains;
   gchar *host, *tmp, *colon, *bracket;
   GInetAddress *iaddr;
   GInetAddressMask *mask;
-  GSimpleProxyResolverDomain domain;
+  GArray *ports;
   gushort port;
   int i;
 
   if (priv->ignore_ips)
     g_ptr_array_free (priv->ignore_ips, TRUE);
-  if (priv->ignore_domains)
-    {
-      for (i = 0; priv->ignore_domains[i].name; i++)
-	g_free (priv->ignore_domains[i].name);
-      g_free (priv->ignore_domains);
-    }
+  g_clear_pointer (&priv->ignore_domains, g_hash_table_unref);
   priv->ignore_ips = NULL;
-  priv->ignore_domains = NULL;
 
   if (!priv->ignore_hosts || !priv->ignore_hosts[0])
     return;
 
   ignore_ips = g_ptr_array_new_with_free_func (g_object_unref);
-  ignore_domains = g_array_new (TRUE, FALSE, sizeof (GSimpleProxyResolverDomain));
+  ignore_domains = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                          (GDestroyNotify) g_array_unref);
 
   for (i = 0; priv->ignore_hosts[i]; i++)
     {
@@ -229,11 +221,19 @@ reparse_ignore_hosts (GSimpleProxyResolver *resolver)
             host++;
         }
 
-      memset (&domain, 0, sizeof (domain));
-      domain.name = g_strdup (host);
-      domain.length = strlen (domain.name);
-      domain.port = port;
-      g_array_append_val (ignore_domains, domain);
+      if (*host == '\0')
+        continue;
+
+      host = g_ascii_strdown (host, -1);
+      ports = g_hash_table_lookup (ignore_domains, host);
+      if (ports == NULL)
+        {
+          ports = g_array_new (FALSE, FALSE, sizeof (gushort));
+          g_hash_table_insert (ignore_domains, host, ports);
+        }
+      else
+        g_free (host);
+      g_array_append_val (ports, port);
       continue;
 
     bad:
@@ -245,9 +245,10 @@ reparse_ignore_hosts (GSimpleProxyResolver *resolver)
   else
     g_ptr_array_free (ignore_ips, TRUE);
 
-  if (ignore_domains->len)
-    priv->ignore_domains = (GSimpleProxyResolverDomain *)ignore_domains->data;
-  g_array_free (ignore_domains, ignore_domains->len == 0);
+  if (g_hash_table_size (ignore_domains))
+    priv->ignore_domains = ignore_domains;
+  else
+    g_hash_table_unref (ignore_domains);
 }
 
 static gboolean
@@ -258,7 +259,6 @@ ignore_host (GSimpleProxyResolver *resolver,
   GSimpleProxyResolverPrivate *priv = resolver->priv;
   gchar *ascii_host = NULL;
   gboolean ignore = FALSE;
-  gsize offset, length;
   guint i;
 
   if (priv->ignore_ips)
@@ -287,29 +287,36 @@ ignore_host (GSimpleProxyResolver *resolver,
 
   if (priv->ignore_domains)
     {
-      length = 0;
+      gchar *lower_host = NULL;
+      const gchar *suffix;
+
       if (g_hostname_is_non_ascii (host))
         host = ascii_host = g_hostname_to_ascii (host);
       if (host)
-        length = strlen (host);
+        lower_host = g_ascii_strdown (host, -1);
 
-      for (i = 0; length > 0 && priv->ignore_domains[i].length; i++)
+      /* Try the host itself and then each of its parent domains */
+      for (suffix = lower_host; !ignore && suffix != NULL && *suffix != '\0'; )
 	{
-	  GSimpleProxyResolverDomain *domain = &priv->ignore_domains[i];
-
-          if (domain->length > length)
-            continue;
+	  GArray *ports = g_hash_table_lookup (priv->ignore_domains, suffix);
 
-	  offset = length - domain->length;
-	  if ((domain->port == 0 || domain->port == port) &&
-	      (offset == 0 || (offset > 0 && host[offset - 1] == '.')) &&
-	      (g_ascii_strcasecmp (domain->name, host + offset) == 0))
+	  for (i = 0; ports != NULL && i < ports->len; i++)
 	    {
-	      ignore = TRUE;
-	      break;
+	      gushort domain_port = g_array_index (ports, gushort, i);
+
+	      if (domain_port == 0 || domain_port == port)
+		{
+		  ignore = TRUE;
+		  break;
+		}
 	    }
+
+	  suffix = strchr (suffix, '.');
+	  if (suffix != NULL)
+	    suffix++;
 	}
 
+      g_free (lower_host);
       g_free (ascii_host);
     }
 
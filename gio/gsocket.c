@@ -54,6 +54,10 @@
 # include <sys/filio.h>
 #endif
 
+#ifdef HAVE_LINUX_ERRQUEUE_H
+#include <linux/errqueue.h>
+#endif
+
 #ifdef G_OS_UNIX
 #include <sys/uio.h>
 #endif
@@ -82,6 +86,10 @@
 #include "giowin32-afunix.h"
 #endif
 
+#ifdef HAVE_LINUX_IO_URING_H
+#include "giouring-private.h"
+#endif
+
 /**
  * GSocket:
  *
@@ -243,6 +251,39 @@ enum
 /* Size of the receiver cache for g_socket_receive_from() */
 #define RECV_ADDR_CACHE_SIZE 8
 
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+#define HAVE_ZEROCOPY 1
+
+typedef enum
+{
+  ZEROCOPY_UNKNOWN = 0,
+  ZEROCOPY_ENABLED,
+  ZEROCOPY_UNSUPPORTED,
+} ZerocopyState;
+
+typedef struct
+{
+  guint32 id;
+  GBytes *bytes;  /* (owned) */
+} ZerocopySend;
+#endif
+
+#ifdef HAVE_LINUX_IO_URING_H
+typedef struct
+{
+  GSocket *socket;  /* (owned) */
+  GTask *task;  /* (owned) */
+  GIOUring *ring;  /* (unowned) */
+  GIOUringOp *op;  /* (nullable) */
+  gboolean is_send;
+  gpointer buffer;
+  gsize size;
+  gulong cancelled_id;
+  gboolean cancel_requested;
+  gboolean closed;
+} IOUringRequest;
+#endif
+
 struct _GSocketPrivate
 {
   GSocketFamily   family;
@@ -251,6 +292,7 @@ struct _GSocketPrivate
   gint            fd;
   gint            listen_backlog;
   guint           timeout;
+  guint           busy_poll_us;
   GError         *construct_error;
   GSocketAddress *remote_address;
   guint           inited : 1;
@@ -262,6 +304,8 @@ struct _GSocketPrivate
   guint           listening : 1;
   guint           timed_out : 1;
   guint           connect_pending : 1;
+  guint           reuse_port : 1;
+  guint           quickack : 1;
 #ifdef G_OS_WIN32
   WSAEVENT        event;
   gboolean        waiting;
@@ -280,6 +324,22 @@ struct _GSocketPrivate
     gsize native_len;
     guint64 last_used;
   } recv_addr_cache[RECV_ADDR_CACHE_SIZE];
+
+#ifdef HAVE_ZEROCOPY
+  /* Buffers sent with g_socket_send_zerocopy() which the kernel may still
+   * be reading from, in the order they were sent */
+  GMutex          zerocopy_lock;
+  GQueue          zerocopy_sends;  /* (element-type ZerocopySend) (owned) */
+  guint32         zerocopy_next_id;
+  GSource        *zerocopy_source;  /* (owned) (nullable) */
+  ZerocopyState   zerocopy_state;
+#endif
+
+#ifdef HAVE_LINUX_IO_URING_H
+  /* Reads and writes in flight in an io_uring */
+  GMutex          io_uring_lock;
+  GList          *io_uring_requests;  /* (element-type IOUringRequest) (unowned) */
+#endif
 };
 
 _G_DEFINE_TYPE_EXTENDED_WITH_PRELUDE (GSocket, g_socket, G_TYPE_OBJECT, 0,
@@ -347,7 +407,7 @@ socket_strerror (int err)
         const char *__strerr = socket_strerror (__errsv);               \
                                                                         \
         if (__code == G_IO_ERROR_WOULD_BLOCK)                           \
-          g_set_error_literal (__err, G_IO_ERROR, __code, __strerr);    \
+          g_set_error_literal_static (__err, G_IO_ERROR, __code, __strerr); \
         else                                                            \
           g_set_error (__err, G_IO_ERROR, __code, fmt, __strerr);       \
       }                                                                 \
@@ -945,6 +1005,19 @@ g_socket_finalize (GObject *object)
         }
     }
 
+#ifdef HAVE_ZEROCOPY
+  /* Released by g_socket_close(), and the source holds a reference */
+  g_assert (g_queue_is_empty (&socket->priv->zerocopy_sends));
+  g_assert (socket->priv->zerocopy_source == NULL);
+  g_mutex_clear (&socket->priv->zerocopy_lock);
+#endif
+
+#ifdef HAVE_LINUX_IO_URING_H
+  /* Requests hold a reference */
+  g_assert (socket->priv->io_uring_requests == NULL);
+  g_mutex_clear (&socket->priv->io_uring_lock);
+#endif
+
   if (G_OBJECT_CLASS (g_socket_parent_class)->finalize)
     (*G_OBJECT_CLASS (g_socket_parent_class)->finalize) (object);
 }
@@ -1198,6 +1271,13 @@ g_socket_init (GSocket *socket)
   g_mutex_init (&socket->priv->win32_source_lock);
   g_cond_init (&socket->priv->win32_source_cond);
 #endif
+#ifdef HAVE_ZEROCOPY
+  g_mutex_init (&socket->priv->zerocopy_lock);
+  g_queue_init (&socket->priv->zerocopy_sends);
+#endif
+#ifdef HAVE_LINUX_IO_URING_H
+  g_mutex_init (&socket->priv->io_uring_lock);
+#endif
 }
 
 static gboolean
@@ -1525,6 +1605,174 @@ g_socket_get_keepalive (GSocket *socket)
   return socket->priv->keepalive;
 }
 
+/**
+ * g_socket_set_busy_poll:
+ * @socket: a #GSocket.
+ * @busy_poll_us: how long to busy poll for, in microseconds, or 0 to disable
+ *   busy polling
+ * @error: #GError for error reporting, or %NULL to ignore.
+ *
+ * Enables busy polling on @socket, trading CPU time for lower receive
+ * latency.
+ *
+ * This sets the `SO_BUSY_POLL` option, so that the kernel polls the network
+ * device receive queue for up to @busy_poll_us microseconds when there is no
+ * data waiting, rather than waiting for an interrupt. Where supported,
+ * `SO_PREFER_BUSY_POLL` is also set; that requires `CAP_NET_ADMIN`, and
+ * failure to set it is ignored.
+ *
+ * In addition, blocking or timed receives on @socket, such as
+ * g_socket_receive_with_blocking(), spin retrying the receive for up to
+ * @busy_poll_us microseconds before going to sleep in poll().
+ *
+ * Raising the busy poll time above the system-wide
+ * `net.core.busy_read` setting requires `CAP_NET_ADMIN`; otherwise
+ * %G_IO_ERROR_PERMISSION_DENIED is returned. On platforms without
+ * `SO_BUSY_POLL`, %G_IO_ERROR_NOT_SUPPORTED is returned.
+ *
+ * Returns: %TRUE on success, %FALSE on error
+ *
+ * Since: 2.82
+ */
+gboolean
+g_socket_set_busy_poll (GSocket  *socket,
+                        guint     busy_poll_us,
+                        GError  **error)
+{
+  g_return_val_if_fail (G_IS_SOCKET (socket), FALSE);
+  g_return_val_if_fail (busy_poll_us <= G_MAXINT, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+#ifdef SO_BUSY_POLL
+  if (!g_socket_set_option (socket, SOL_SOCKET, SO_BUSY_POLL, busy_poll_us, error))
+    return FALSE;
+
+#ifdef SO_PREFER_BUSY_POLL
+  g_socket_set_option (socket, SOL_SOCKET, SO_PREFER_BUSY_POLL, busy_poll_us > 0, NULL);
+#endif
+
+  socket->priv->busy_poll_us = busy_poll_us;
+  return TRUE;
+#else
+  g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                       _("Busy polling is not supported on this platform"));
+  return FALSE;
+#endif
+}
+
+/**
+ * g_socket_get_busy_poll:
+ * @socket: a #GSocket.
+ *
+ * Gets the busy poll time of @socket. For details on this, see
+ * g_socket_set_busy_poll().
+ *
+ * Returns: the busy poll time in microseconds, or 0 if busy polling is
+ *   disabled
+ *
+ * Since: 2.82
+ */
+guint
+g_socket_get_busy_poll (GSocket *socket)
+{
+  g_return_val_if_fail (G_IS_SOCKET (socket), 0);
+
+  return socket->priv->busy_poll_us;
+}
+
+/**
+ * g_socket_set_low_latency:
+ * @socket: a #GSocket.
+ * @low_latency: whether to enable the low latency options
+ * @error: #GError for error reporting, or %NULL to ignore.
+ *
+ * Sets the TCP options for low latency on a %G_SOCKET_PROTOCOL_TCP socket.
+ *
+ * This sets `TCP_NODELAY` (which #GSocket sets by default anyway) and, where
+ * supported, `TCP_QUICKACK`, so that received data is acknowledged
+ * immediately rather than waiting to piggyback the acknowledgement on
+ * outgoing data. Because Linux may turn `TCP_QUICKACK` back off on its own,
+ * #GSocket sets it again after each receive while this is enabled.
+ *
+ * Disabling this turns `TCP_QUICKACK` off again, but leaves `TCP_NODELAY`
+ * alone.
+ *
+ * Returns: %TRUE on success, %FALSE on error
+ *
+ * Since: 2.82
+ */
+gboolean
+g_socket_set_low_latency (GSocket   *socket,
+                          gboolean   low_latency,
+                          GError   **error)
+{
+  g_return_val_if_fail (G_IS_SOCKET (socket), FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  if (socket->priv->type != G_SOCKET_TYPE_STREAM ||
+      (socket->priv->family != G_SOCKET_FAMILY_IPV4 &&
+       socket->priv->family != G_SOCKET_FAMILY_IPV6) ||
+      (socket->priv->protocol != G_SOCKET_PROTOCOL_DEFAULT &&
+       socket->priv->protocol != G_SOCKET_PROTOCOL_TCP))
+    {
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                           _("Low latency options are only supported on TCP sockets"));
+      return FALSE;
+    }
+
+  low_latency = !!low_latency;
+
+  if (low_latency &&
+      !g_socket_set_option (socket, IPPROTO_TCP, TCP_NODELAY, TRUE, error))
+    return FALSE;
+
+#ifdef TCP_QUICKACK
+  if (!g_socket_set_option (socket, IPPROTO_TCP, TCP_QUICKACK, low_latency, error))
+    return FALSE;
+
+  socket->priv->quickack = low_latency;
+#endif
+
+  return TRUE;
+}
+
+/**
+ * g_socket_get_incoming_cpu:
+ * @socket: a #GSocket.
+ * @error: #GError for error reporting, or %NULL to ignore.
+ *
+ * Gets the CPU which processed the packets most recently received on
+ * @socket, using the `SO_INCOMING_CPU` option. This can be used to
+ * schedule the thread handling @socket on the same CPU, for better cache
+ * locality.
+ *
+ * On platforms without `SO_INCOMING_CPU`, %G_IO_ERROR_NOT_SUPPORTED is
+ * returned.
+ *
+ * Returns: the CPU number, or -1 on error
+ *
+ * Since: 2.82
+ */
+gint
+g_socket_get_incoming_cpu (GSocket  *socket,
+                           GError  **error)
+{
+  gint cpu = -1;
+
+  g_return_val_if_fail (G_IS_SOCKET (socket), -1);
+  g_return_val_if_fail (error == NULL || *error == NULL, -1);
+
+#ifdef SO_INCOMING_CPU
+  if (!g_socket_get_option (socket, SOL_SOCKET, SO_INCOMING_CPU, &cpu, error))
+    return -1;
+#else
+  g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                       _("Querying the incoming CPU is not supported on this platform"));
+#endif
+
+  return cpu;
+}
+
 /**
  * g_socket_get_listen_backlog:
  * @socket: a #GSocket.
@@ -1573,6 +1821,32 @@ g_socket_set_listen_backlog (GSocket *socket,
     }
 }
 
+/*
+ * g_socket_set_reuse_port:
+ * @socket: a #GSocket.
+ * @reuse_port: whether to set `SO_REUSEPORT`
+ *
+ * Makes a later g_socket_bind() with @reuse_address set also set
+ * `SO_REUSEPORT` on a stream socket, so that several listening sockets can
+ * share a port and the kernel balances incoming connections between them.
+ * (It is always set for datagram sockets.)
+ *
+ * Returns: %FALSE if `SO_REUSEPORT` isn’t supported on this platform
+ */
+gboolean
+g_socket_set_reuse_port (GSocket  *socket,
+                         gboolean  reuse_port)
+{
+  g_return_val_if_fail (G_IS_SOCKET (socket), FALSE);
+
+#ifdef SO_REUSEPORT
+  socket->priv->reuse_port = !!reuse_port;
+  return TRUE;
+#else
+  return !reuse_port;
+#endif
+}
+
 /**
  * g_socket_get_timeout:
  * @socket: a #GSocket.
@@ -2261,7 +2535,8 @@ g_socket_bind (GSocket         *socket,
 #endif
 
 #ifdef SO_REUSEPORT
-  so_reuseport = reuse_address && (socket->priv->type == G_SOCKET_TYPE_DATAGRAM);
+  so_reuseport = reuse_address &&
+                 (socket->priv->type == G_SOCKET_TYPE_DATAGRAM || socket->priv->reuse_port);
 #endif
 
   /* Ignore errors here, the only likely error is "not supported", and
@@ -3264,6 +3539,17 @@ g_socket_get_available_bytes (GSocket *socket)
   return avail;
 }
 
+/* Linux clears TCP_QUICKACK again as it sees fit, so set it again after
+ * each receive while g_socket_set_low_latency() is enabled */
+static inline void
+rearm_quickack (GSocket *socket)
+{
+#ifdef TCP_QUICKACK
+  if (G_UNLIKELY (socket->priv->quickack))
+    g_socket_set_option (socket, IPPROTO_TCP, TCP_QUICKACK, TRUE, NULL);
+#endif
+}
+
 /* Block on a timed wait for @condition until (@start_time + @timeout).
  * Return %G_IO_ERROR_TIMED_OUT if the timeout is reached; otherwise %TRUE.
  */
@@ -3276,14 +3562,15 @@ block_on_timeout (GSocket       *socket,
                   GError       **error)
 {
   gint64 wait_timeout = -1;
+  gint64 elapsed;
 
   g_return_val_if_fail (timeout_us != 0, TRUE);
 
+  elapsed = g_get_monotonic_time () - start_time;
+
   /* check if we've timed out or how much time to wait at most */
   if (timeout_us >= 0)
     {
-      gint64 elapsed = g_get_monotonic_time () - start_time;
-
       if (elapsed >= timeout_us)
         {
           g_set_error_literal (error,
@@ -3295,6 +3582,11 @@ block_on_timeout (GSocket       *socket,
       wait_timeout = timeout_us - elapsed;
     }
 
+  /* When busy polling, have the caller retry its receive straight away until
+   * the busy poll time is used up, rather than sleeping in poll() */
+  if ((condition & G_IO_IN) && elapsed < socket->priv->busy_poll_us)
+    return !g_cancellable_set_error_if_cancelled (cancellable, error);
+
   return g_socket_condition_timed_wait (socket, condition, wait_timeout,
                                         cancellable, error);
 }
@@ -3362,6 +3654,8 @@ g_socket_receive_with_timeout (GSocket       *socket,
       break;
     }
 
+  rearm_quickack (socket);
+
   return ret;
 }
 
@@ -3588,6 +3882,76 @@ g_socket_receive_bytes_from (GSocket         *socket,
   return g_steal_pointer (&buf);
 }
 
+/**
+ * g_socket_receive_bytes_from_pool:
+ * @socket: a #GSocket
+ * @pool: the [struct@GLib.BufferPool] to receive into
+ * @address: (out) (optional): return location for a #GSocketAddress
+ * @timeout_us: the timeout to wait for, in microseconds, or `-1` to block
+ *   indefinitely
+ * @cancellable: (nullable): a #GCancellable, or `NULL`
+ * @error: return location for a #GError, or `NULL`
+ *
+ * Receives data (up to the buffer size of @pool) from a socket into a
+ * buffer from @pool.
+ *
+ * This function is a variant of [method@Gio.Socket.receive_bytes_from]
+ * which does not allocate a new buffer for every call: the returned
+ * [struct@GLib.Bytes] goes back to @pool when its last reference is
+ * dropped. It is meant for receiving at a high rate, for example from a
+ * datagram socket, where the pool’s buffer size is the largest datagram
+ * expected. As with [method@Gio.Socket.receive], the part of a datagram
+ * which does not fit is discarded.
+ *
+ * If @address is non-%NULL then @address will be set equal to the
+ * source address of the received packet.
+ *
+ * See [method@Gio.Socket.receive_bytes] for the meaning of @timeout_us.
+ *
+ * Returns: (transfer full): a bytes buffer containing the
+ *   received bytes, or `NULL` on error
+ * Since: 2.82
+ */
+GBytes *
+g_socket_receive_bytes_from_pool (GSocket         *socket,
+                                  GBufferPool     *pool,
+                                  GSocketAddress **address,
+                                  gint64           timeout_us,
+                                  GCancellable    *cancellable,
+                                  GError         **error)
+{
+  GInputVector v;
+  gssize res;
+
+  g_return_val_if_fail (G_IS_SOCKET (socket), NULL);
+  g_return_val_if_fail (pool != NULL, NULL);
+  g_return_val_if_fail (address == NULL || *address == NULL, NULL);
+  g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  v.buffer = g_buffer_pool_acquire (pool);
+  v.size = g_buffer_pool_get_buffer_size (pool);
+
+  if (address == NULL)
+    res = g_socket_receive_with_timeout (socket, v.buffer, v.size,
+                                         timeout_us, cancellable, error);
+  else
+    res = g_socket_receive_message_with_timeout (socket,
+                                                 address,
+                                                 &v, 1,
+                                                 NULL, 0, NULL,
+                                                 timeout_us,
+                                                 cancellable,
+                                                 error);
+  if (res < 0)
+    {
+      g_buffer_pool_release (pool, v.buffer);
+      return NULL;
+    }
+
+  return g_buffer_pool_new_bytes (pool, v.buffer, (gsize) res);
+}
+
 /**
  * g_socket_receive_from:
  * @socket: a #GSocket
@@ -3773,6 +4137,601 @@ g_socket_send_with_blocking (GSocket       *socket,
                                      blocking ? -1 : 0, cancellable, error);
 }
 
+#ifdef HAVE_ZEROCOPY
+static gboolean
+zerocopy_enable (GSocket *socket)
+{
+  if (socket->priv->zerocopy_state == ZEROCOPY_UNKNOWN)
+    {
+      int value = 1;
+
+      if (setsockopt (socket->priv->fd, SOL_SOCKET, SO_ZEROCOPY, &value, sizeof (value)) == 0)
+        socket->priv->zerocopy_state = ZEROCOPY_ENABLED;
+      else
+        socket->priv->zerocopy_state = ZEROCOPY_UNSUPPORTED;
+    }
+
+  return socket->priv->zerocopy_state == ZEROCOPY_ENABLED;
+}
+
+/* Releases the buffers of the sends numbered @lo to @hi, inclusive. The
+ * kernel numbers sends with a wrapping 32-bit counter. */
+static void
+zerocopy_complete_unlocked (GSocket *socket,
+                            guint32  lo,
+                            guint32  hi)
+{
+  GList *l = socket->priv->zerocopy_sends.head;
+
+  while (l != NULL)
+    {
+      ZerocopySend *pending = l->data;
+      GList *next = l->next;
+
+      if ((guint32) (pending->id - lo) <= (guint32) (hi - lo))
+        {
+          g_queue_delete_link (&socket->priv->zerocopy_sends, l);
+          g_bytes_unref (pending->bytes);
+          g_free (pending);
+        }
+
+      l = next;
+    }
+}
+
+/* Reads the completion notifications from the socket’s error queue. Returns
+ * whether there were any. */
+static gboolean
+zerocopy_reap_unlocked (GSocket *socket)
+{
+  gboolean reaped = FALSE;
+
+  while (!g_queue_is_empty (&socket->priv->zerocopy_sends))
+    {
+      union {
+        struct cmsghdr align;
+        char buf[CMSG_SPACE (sizeof (struct sock_extended_err) + sizeof (struct sockaddr_in6))];
+      } control;
+      struct msghdr msg = { 0, };
+      struct cmsghdr *cmsg;
+
+      msg.msg_control = control.buf;
+      msg.msg_controllen = sizeof (control.buf);
+
+      if (recvmsg (socket->priv->fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+        {
+          if (get_socket_errno () == EINTR)
+            continue;
+          break;
+        }
+
+      for (cmsg = CMSG_FIRSTHDR (&msg); cmsg != NULL; cmsg = CMSG_NXTHDR (&msg, cmsg))
+        {
+          struct sock_extended_err serr;
+
+          if (!((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+                (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)))
+            continue;
+
+          memcpy (&serr, CMSG_DATA (cmsg), sizeof (serr));
+          if (serr.ee_errno != 0 || serr.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+            continue;
+
+          zerocopy_complete_unlocked (socket, serr.ee_info, serr.ee_data);
+          reaped = TRUE;
+        }
+    }
+
+  return reaped;
+}
+
+static gboolean
+zerocopy_source_cb (GSocket      *socket,
+                    GIOCondition  condition,
+                    gpointer      user_data)
+{
+  gboolean reaped;
+
+  g_mutex_lock (&socket->priv->zerocopy_lock);
+
+  reaped = zerocopy_reap_unlocked (socket);
+
+  /* The socket also polls as %G_IO_ERR for a pending socket error or
+   * %G_IO_HUP once the peer is gone, which would make this spin. The
+   * remaining buffers are then released by the next send or on close. */
+  if (!reaped || g_queue_is_empty (&socket->priv->zerocopy_sends))
+    {
+      g_clear_pointer (&socket->priv->zerocopy_source, g_source_unref);
+      g_mutex_unlock (&socket->priv->zerocopy_lock);
+      return G_SOURCE_REMOVE;
+    }
+
+  g_mutex_unlock (&socket->priv->zerocopy_lock);
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+zerocopy_release_all (GSocket *socket)
+{
+  ZerocopySend *pending;
+  GSource *source;
+
+  g_mutex_lock (&socket->priv->zerocopy_lock);
+
+  source = g_steal_pointer (&socket->priv->zerocopy_source);
+  while ((pending = g_queue_pop_head (&socket->priv->zerocopy_sends)) != NULL)
+    {
+      g_bytes_unref (pending->bytes);
+      g_free (pending);
+    }
+
+  g_mutex_unlock (&socket->priv->zerocopy_lock);
+
+  /* Outside the lock, as it drops the source’s reference on @socket */
+  if (source != NULL)
+    {
+      g_source_destroy (source);
+      g_source_unref (source);
+    }
+}
+
+static gssize
+g_socket_send_zerocopy_internal (GSocket       *socket,
+                                 GBytes        *bytes,
+                                 gint64         timeout_us,
+                                 GCancellable  *cancellable,
+                                 gboolean      *fallback,
+                                 GError       **error)
+{
+  ZerocopySend *pending;
+  gconstpointer data;
+  gsize size;
+  gssize ret;
+  gint64 start_time;
+
+  data = g_bytes_get_data (bytes, &size);
+  start_time = g_get_monotonic_time ();
+
+  /* Queue the buffer before sending, so that the completion can’t be seen
+   * before it’s there. Sends on a socket aren’t concurrent, so it’s still
+   * the last one if the send fails. */
+  pending = g_new0 (ZerocopySend, 1);
+  pending->bytes = g_bytes_ref (bytes);
+
+  g_mutex_lock (&socket->priv->zerocopy_lock);
+  pending->id = socket->priv->zerocopy_next_id;
+  g_queue_push_tail (&socket->priv->zerocopy_sends, pending);
+  g_mutex_unlock (&socket->priv->zerocopy_lock);
+
+  while (1)
+    {
+      if ((ret = send (socket->priv->fd, data, size, G_SOCKET_DEFAULT_SEND_FLAGS | MSG_ZEROCOPY)) < 0)
+        {
+          int errsv = get_socket_errno ();
+
+          if (errsv == EINTR)
+            continue;
+
+          if ((errsv == EWOULDBLOCK || errsv == EAGAIN) && timeout_us != 0)
+            {
+              if (block_on_timeout (socket, G_IO_OUT, timeout_us, start_time,
+                                    cancellable, error))
+                continue;
+            }
+          else if (errsv == ENOBUFS)
+            {
+              /* Out of memory for pinning pages; copying still works */
+              *fallback = TRUE;
+            }
+          else
+            {
+              socket_set_error_lazy (error, errsv, _("Error sending data: %s"));
+            }
+
+          g_mutex_lock (&socket->priv->zerocopy_lock);
+          g_queue_pop_tail (&socket->priv->zerocopy_sends);
+          g_mutex_unlock (&socket->priv->zerocopy_lock);
+
+          g_bytes_unref (pending->bytes);
+          g_free (pending);
+
+          return -1;
+        }
+      break;
+    }
+
+  g_mutex_lock (&socket->priv->zerocopy_lock);
+
+  socket->priv->zerocopy_next_id++;
+
+  /* Check for completions of earlier sends, in case the source gave up */
+  zerocopy_reap_unlocked (socket);
+
+  if (socket->priv->zerocopy_source == NULL &&
+      !g_queue_is_empty (&socket->priv->zerocopy_sends))
+    {
+      socket->priv->zerocopy_source = g_socket_create_source (socket, G_IO_ERR, NULL);
+      g_source_set_callback (socket->priv->zerocopy_source,
+                             (GSourceFunc) zerocopy_source_cb, NULL, NULL);
+      g_source_set_static_name (socket->priv->zerocopy_source, "[gio] zerocopy_source_cb");
+      g_source_attach (socket->priv->zerocopy_source, g_main_context_get_thread_default ());
+    }
+
+  g_mutex_unlock (&socket->priv->zerocopy_lock);
+
+  return ret;
+}
+#endif
+
+/**
+ * g_socket_send_zerocopy:
+ * @socket: a #GSocket
+ * @bytes: the data to send
+ * @cancellable: (nullable): a %GCancellable or %NULL
+ * @error: #GError for error reporting, or %NULL to ignore.
+ *
+ * Tries to send @bytes on the socket like g_socket_send(), but without
+ * copying the data into the kernel where that is supported. This is worth
+ * it for large buffers, of hundreds of kilobytes or more, as the kernel
+ * has to pin the memory and notify completion separately.
+ *
+ * The kernel keeps reading from @bytes after this returns, so it is kept
+ * referenced until the kernel reports that it’s done with it. These reports
+ * are processed by a #GSource in the thread-default main context of the
+ * thread calling this function, so that context must be iterated for the
+ * memory to be released. If the socket is closed first, all references are
+ * dropped then. To know when the data is released, create @bytes with
+ * g_bytes_new_with_free_func().
+ *
+ * Zero-copy sends are only supported for TCP and UDP sockets on Linux; this
+ * falls back to a normal send otherwise, releasing @bytes straight away.
+ * The kernel may also decide to copy the data, for example over the
+ * loopback interface.
+ *
+ * As with g_socket_send(), fewer bytes than the size of @bytes may be sent.
+ * Use g_bytes_new_from_bytes() to send the rest.
+ *
+ * Returns: Number of bytes written (which may be less than the size of
+ *   @bytes), or -1 on error
+ *
+ * Since: 2.82
+ */
+gssize
+g_socket_send_zerocopy (GSocket       *socket,
+                        GBytes        *bytes,
+                        GCancellable  *cancellable,
+                        GError       **error)
+{
+  gconstpointer data;
+  gsize size;
+
+  g_return_val_if_fail (G_IS_SOCKET (socket), -1);
+  g_return_val_if_fail (bytes != NULL, -1);
+  g_return_val_if_fail (error == NULL || *error == NULL, -1);
+
+  data = g_bytes_get_data (bytes, &size);
+
+#ifdef HAVE_ZEROCOPY
+  if (size > 0)
+    {
+      gboolean fallback = FALSE;
+      gssize ret;
+
+      if (!check_socket (socket, error))
+        return -1;
+
+      if (!check_timeout (socket, error))
+        return -1;
+
+      if (g_cancellable_set_error_if_cancelled (cancellable, error))
+        return -1;
+
+      if (zerocopy_enable (socket))
+        {
+          ret = g_socket_send_zerocopy_internal (socket, bytes,
+                                                 socket->priv->blocking ? -1 : 0,
+                                                 cancellable, &fallback, error);
+          if (!fallback)
+            return ret;
+        }
+    }
+#endif
+
+  return g_socket_send_with_timeout (socket, (data != NULL) ? data : (const guint8 *) "", size,
+                                     socket->priv->blocking ? -1 : 0,
+                                     cancellable, error);
+}
+
+#ifdef HAVE_LINUX_IO_URING_H
+static void
+io_uring_request_return (IOUringRequest *request,
+                         gssize          result,
+                         GError         *error)
+{
+  g_cancellable_disconnect (g_task_get_cancellable (request->task),
+                            request->cancelled_id);
+
+  if (error != NULL)
+    g_task_return_error (request->task, error);
+  else
+    g_task_return_int (request->task, result);
+
+  g_object_unref (request->task);
+  g_object_unref (request->socket);
+  g_free (request);
+}
+
+/* Used when an operation can’t go through the ring */
+static gboolean
+io_uring_request_ready (GSocket      *socket,
+                        GIOCondition  condition,
+                        gpointer      user_data)
+{
+  IOUringRequest *request = user_data;
+  GError *error = NULL;
+  gssize ret;
+
+  if (g_cancellable_set_error_if_cancelled (g_task_get_cancellable (request->task), &error))
+    {
+      io_uring_request_return (request, -1, error);
+      return G_SOURCE_REMOVE;
+    }
+
+  if (request->is_send)
+    ret = g_socket_send_with_blocking (socket, request->buffer, request->size,
+                                       FALSE, NULL, &error);
+  else
+    ret = g_socket_receive_with_blocking (socket, request->buffer, request->size,
+                                          FALSE, NULL, &error);
+
+  if (ret < 0 && g_error_matches (error, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK))
+    {
+      g_error_free (error);
+      return G_SOURCE_CONTINUE;
+    }
+
+  io_uring_request_return (request, ret, error);
+  return G_SOURCE_REMOVE;
+}
+
+static void
+io_uring_request_wait (IOUringRequest *request)
+{
+  GSource *source;
+
+  source = g_socket_create_source (request->socket,
+                                   request->is_send ? G_IO_OUT : G_IO_IN,
+                                   g_task_get_cancellable (request->task));
+  g_source_set_callback (source, (GSourceFunc) io_uring_request_ready, request, NULL);
+  g_source_set_priority (source, g_task_get_priority (request->task));
+  g_source_set_static_name (source, "[gio] io_uring_request_ready");
+  g_source_attach (source, g_task_get_context (request->task));
+  g_source_unref (source);
+}
+
+static void
+io_uring_request_complete (int      result,
+                           gpointer user_data)
+{
+  IOUringRequest *request = user_data;
+  GSocket *socket = request->socket;
+  GError *error = NULL;
+  gboolean closed;
+
+  g_mutex_lock (&socket->priv->io_uring_lock);
+  request->op = NULL;
+  closed = request->closed;
+  socket->priv->io_uring_requests = g_list_remove (socket->priv->io_uring_requests, request);
+  g_mutex_unlock (&socket->priv->io_uring_lock);
+
+  /* Kernels without IORING_FEAT_FAST_POLL aren’t used, but be safe */
+  if (result == -EAGAIN && !closed)
+    {
+      io_uring_request_wait (request);
+      return;
+    }
+
+  if (result >= 0)
+    {
+      io_uring_request_return (request, result, NULL);
+      return;
+    }
+
+  if (closed)
+    g_set_error_literal (&error, G_IO_ERROR, G_IO_ERROR_CLOSED,
+                         _("Socket is already closed"));
+  else if (!g_cancellable_set_error_if_cancelled (g_task_get_cancellable (request->task), &error))
+    {
+      if (request->is_send)
+        socket_set_error_lazy (&error, -result, _("Error sending data: %s"));
+      else
+        socket_set_error_lazy (&error, -result, _("Error receiving data: %s"));
+    }
+
+  io_uring_request_return (request, -1, error);
+}
+
+static void
+io_uring_request_cancelled (GCancellable *cancellable,
+                            gpointer      user_data)
+{
+  IOUringRequest *request = user_data;
+  GSocket *socket = request->socket;
+
+  g_mutex_lock (&socket->priv->io_uring_lock);
+  request->cancel_requested = TRUE;
+  if (request->op != NULL)
+    g_io_uring_cancel (request->ring, request->op);
+  g_mutex_unlock (&socket->priv->io_uring_lock);
+}
+
+static void
+io_uring_request_start (GSocket  *socket,
+                        GTask    *task,
+                        gboolean  is_send,
+                        gpointer  buffer,
+                        gsize     size)
+{
+  IOUringRequest *request;
+  GCancellable *cancellable;
+  GIOUringOp *op = NULL;
+  GError *error = NULL;
+  gboolean cancelled, closed;
+
+  if (!check_socket (socket, &error))
+    {
+      g_task_return_error (task, error);
+      return;
+    }
+
+  if (g_task_return_error_if_cancelled (task))
+    return;
+
+  request = g_new0 (IOUringRequest, 1);
+  request->socket = g_object_ref (socket);
+  request->task = g_object_ref (task);
+  request->ring = g_io_uring_get_for_context (g_task_get_context (task));
+  request->is_send = is_send;
+  request->buffer = buffer;
+  request->size = size;
+
+  /* Checked by g_socket_can_use_io_uring(), and rings last as long as
+   * their context */
+  g_assert (request->ring != NULL);
+
+  /* Connect first, so the operation can’t complete before the handler ID
+   * is known. If already cancelled, the handler runs straight away. */
+  cancellable = g_task_get_cancellable (task);
+  if (cancellable != NULL)
+    request->cancelled_id = g_cancellable_connect (cancellable,
+                                                   G_CALLBACK (io_uring_request_cancelled),
+                                                   request, NULL);
+
+  g_mutex_lock (&socket->priv->io_uring_lock);
+
+  cancelled = request->cancel_requested;
+  closed = socket->priv->closed;
+  if (!cancelled && !closed)
+    {
+      if (is_send)
+        op = g_io_uring_send (request->ring, socket->priv->fd, buffer, size,
+                              G_SOCKET_DEFAULT_SEND_FLAGS,
+                              io_uring_request_complete, request);
+      else
+        op = g_io_uring_recv (request->ring, socket->priv->fd, buffer, size, 0,
+                              io_uring_request_complete, request);
+    }
+
+  /* Once unlocked, @request may be completed and freed at any time */
+  if (op != NULL)
+    {
+      request->op = op;
+      socket->priv->io_uring_requests = g_list_prepend (socket->priv->io_uring_requests, request);
+    }
+
+  g_mutex_unlock (&socket->priv->io_uring_lock);
+
+  if (op == NULL)
+    {
+      /* Cancelled or closed from another thread, which
+       * io_uring_request_ready() reports, or the submission queue is full */
+      if (cancelled || closed)
+        io_uring_request_ready (socket, 0, request);
+      else
+        io_uring_request_wait (request);
+    }
+}
+
+static void
+io_uring_cancel_all (GSocket *socket)
+{
+  GList *l;
+
+  g_mutex_lock (&socket->priv->io_uring_lock);
+
+  for (l = socket->priv->io_uring_requests; l != NULL; l = l->next)
+    {
+      IOUringRequest *request = l->data;
+
+      request->closed = TRUE;
+      g_io_uring_cancel (request->ring, request->op);
+    }
+
+  g_mutex_unlock (&socket->priv->io_uring_lock);
+}
+#endif
+
+/*
+ * g_socket_can_use_io_uring:
+ * @socket: a #GSocket
+ *
+ * Checks whether g_socket_receive_io_uring() and g_socket_send_io_uring()
+ * can be used for asynchronous I/O on @socket from the thread-default main
+ * context of the calling thread. That needs `GIO_USE_IO_URING=1`, a recent
+ * Linux kernel, and no timeout on @socket, as timeouts are only implemented
+ * by sources from g_socket_create_source().
+ *
+ * Returns: %TRUE if the io_uring functions can be used
+ */
+gboolean
+g_socket_can_use_io_uring (GSocket *socket)
+{
+#ifdef HAVE_LINUX_IO_URING_H
+  return socket->priv->inited &&
+         !socket->priv->closed &&
+         socket->priv->timeout == 0 &&
+         g_io_uring_get_for_context (g_main_context_get_thread_default ()) != NULL;
+#else
+  return FALSE;
+#endif
+}
+
+/*
+ * g_socket_receive_io_uring:
+ * @socket: a #GSocket
+ * @buffer: buffer to read into, which has to stay valid until @task returns
+ * @size: the size of @buffer
+ * @task: task to return the number of bytes read on, as an int
+ *
+ * Reads from @socket using the io_uring of the context of @task. The read
+ * is submitted the next time the context is iterated, along with all other
+ * operations queued in the meantime.
+ *
+ * Only call this if g_socket_can_use_io_uring() returned %TRUE in the thread
+ * which created @task.
+ */
+void
+g_socket_receive_io_uring (GSocket *socket,
+                           void    *buffer,
+                           gsize    size,
+                           GTask   *task)
+{
+#ifdef HAVE_LINUX_IO_URING_H
+  io_uring_request_start (socket, task, FALSE, buffer, size);
+#else
+  g_assert_not_reached ();
+#endif
+}
+
+/*
+ * g_socket_send_io_uring:
+ *
+ * Like g_socket_receive_io_uring(), but writes to @socket.
+ */
+void
+g_socket_send_io_uring (GSocket    *socket,
+                        const void *buffer,
+                        gsize       size,
+                        GTask      *task)
+{
+#ifdef HAVE_LINUX_IO_URING_H
+  io_uring_request_start (socket, task, TRUE, (gpointer) buffer, size);
+#else
+  g_assert_not_reached ();
+#endif
+}
+
 /**
  * g_socket_send_to:
  * @socket: a #GSocket
@@ -3944,6 +4903,14 @@ g_socket_close (GSocket  *socket,
   if (!check_socket (socket, error))
     return FALSE;
 
+#ifdef HAVE_ZEROCOPY
+  zerocopy_release_all (socket);
+#endif
+
+#ifdef HAVE_LINUX_IO_URING_H
+  io_uring_cancel_all (socket);
+#endif
+
   while (1)
     {
 #ifdef G_OS_WIN32
@@ -5745,6 +6712,8 @@ g_socket_receive_message_with_timeout (GSocket                 *socket,
 	break;
       }
 
+    rearm_quickack (socket);
+
     input_message_from_msghdr (&msg, &input_message, socket);
 
     if (flags != NULL)
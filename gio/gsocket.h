@@ -107,6 +107,19 @@ void                   g_socket_set_keepalive           (GSocket
 							 gboolean                 keepalive);
 GIO_AVAILABLE_IN_ALL
 gboolean               g_socket_get_keepalive           (GSocket                 *socket);
+GIO_AVAILABLE_IN_2_82
+gboolean               g_socket_set_busy_poll           (GSocket                 *socket,
+                                                         guint                    busy_poll_us,
+                                                         GError                 **error);
+GIO_AVAILABLE_IN_2_82
+guint                  g_socket_get_busy_poll           (GSocket                 *socket);
+GIO_AVAILABLE_IN_2_82
+gboolean               g_socket_set_low_latency         (GSocket                 *socket,
+                                                         gboolean                 low_latency,
+                                                         GError                 **error);
+GIO_AVAILABLE_IN_2_82
+gint                   g_socket_get_incoming_cpu        (GSocket                 *socket,
+                                                         GError                 **error);
 GIO_AVAILABLE_IN_ALL
 gint                   g_socket_get_listen_backlog      (GSocket                 *socket);
 GIO_AVAILABLE_IN_ALL
@@ -230,12 +243,24 @@ GBytes *               g_socket_receive_bytes_from      (GSocket
                                                          gint64                   timeout_us,
                                                          GCancellable            *cancellable,
                                                          GError                 **error);
+GIO_AVAILABLE_IN_2_82
+GBytes *               g_socket_receive_bytes_from_pool (GSocket                 *socket,
+                                                         GBufferPool             *pool,
+                                                         GSocketAddress         **address,
+                                                         gint64                   timeout_us,
+                                                         GCancellable            *cancellable,
+                                                         GError                 **error);
 GIO_AVAILABLE_IN_ALL
 gssize                 g_socket_send                    (GSocket                 *socket,
 							 const gchar             *buffer,
 							 gsize                    size,
 							 GCancellable            *cancellable,
 							 GError                 **error);
+GIO_AVAILABLE_IN_2_82
+gssize                 g_socket_send_zerocopy           (GSocket                 *socket,
+                                                         GBytes                  *bytes,
+                                                         GCancellable            *cancellable,
+                                                         GError                 **error);
 GIO_AVAILABLE_IN_ALL
 gssize                 g_socket_send_to                 (GSocket                 *socket,
 							 GSocketAddress          *address,
@@ -37,6 +37,7 @@
 #include <gio/gsocketaddressenumerator.h>
 #include <gio/gsocketconnectable.h>
 #include <gio/gsocketconnection.h>
+#include <gio/gsocketconnectionpool.h>
 #include <gio/gioprivate.h>
 #include <gio/gproxyaddressenumerator.h>
 #include <gio/gproxyaddress.h>
@@ -105,7 +106,8 @@ enum
   PROP_ENABLE_PROXY,
   PROP_TLS,
   PROP_TLS_VALIDATION_FLAGS,
-  PROP_PROXY_RESOLVER
+  PROP_PROXY_RESOLVER,
+  PROP_CONNECTION_POOL
 };
 
 struct _GSocketClientPrivate
@@ -120,6 +122,7 @@ struct _GSocketClientPrivate
   gboolean tls;
   GTlsCertificateFlags tls_validation_flags;
   GProxyResolver *proxy_resolver;
+  GSocketConnectionPool *connection_pool;
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (GSocketClient, g_socket_client, G_TYPE_OBJECT)
@@ -245,6 +248,7 @@ g_socket_client_finalize (GObject *object)
 
   g_clear_object (&client->priv->local_address);
   g_clear_object (&client->priv->proxy_resolver);
+  g_clear_object (&client->priv->connection_pool);
 
   G_OBJECT_CLASS (g_socket_client_parent_class)->finalize (object);
 
@@ -299,6 +303,10 @@ G_GNUC_END_IGNORE_DEPRECATIONS
 	g_value_set_object (value, g_socket_client_get_proxy_resolver (client));
 	break;
 
+      case PROP_CONNECTION_POOL:
+	g_value_set_object (value, g_socket_client_get_connection_pool (client));
+	break;
+
       default:
 	G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -352,6 +360,10 @@ G_GNUC_END_IGNORE_DEPRECATIONS
       g_socket_client_set_proxy_resolver (client, g_value_get_object (value));
       break;
 
+    case PROP_CONNECTION_POOL:
+      g_socket_client_set_connection_pool (client, g_value_get_object (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -785,6 +797,84 @@ g_socket_client_set_proxy_resolver (GSocketClient  *client,
     g_object_ref (client->priv->proxy_resolver);
 }
 
+/**
+ * g_socket_client_get_connection_pool:
+ * @client: a #GSocketClient.
+ *
+ * Gets the #GSocketConnectionPool used by @client, if any. See
+ * g_socket_client_set_connection_pool().
+ *
+ * Returns: (transfer none) (nullable): the connection pool of @client, or
+ *   %NULL
+ *
+ * Since: 2.82
+ */
+GSocketConnectionPool *
+g_socket_client_get_connection_pool (GSocketClient *client)
+{
+  g_return_val_if_fail (G_IS_SOCKET_CLIENT (client), NULL);
+
+  return client->priv->connection_pool;
+}
+
+/**
+ * g_socket_client_set_connection_pool:
+ * @client: a #GSocketClient.
+ * @pool: (nullable): a #GSocketConnectionPool, or %NULL
+ *
+ * Sets a #GSocketConnectionPool for @client to take idle connections from.
+ *
+ * When a pool is set, connecting to a #GSocketConnectable first checks
+ * @pool for an idle connection made with the same settings to the same
+ * destination, and returns that if there is one. In that case, the only
+ * #GSocketClient::event emitted is %G_SOCKET_CLIENT_COMPLETE. Connections
+ * made by @client can be given back to @pool with
+ * g_socket_connection_pool_release() for reuse, and TLS connections
+ * resume the TLS session of the latest connection to the same destination.
+ *
+ * Since: 2.82
+ */
+void
+g_socket_client_set_connection_pool (GSocketClient         *client,
+                                     GSocketConnectionPool *pool)
+{
+  g_return_if_fail (G_IS_SOCKET_CLIENT (client));
+  g_return_if_fail (pool == NULL || G_IS_SOCKET_CONNECTION_POOL (pool));
+
+  if (g_set_object (&client->priv->connection_pool, pool))
+    g_object_notify (G_OBJECT (client), "connection-pool");
+}
+
+/* Returns the key under which connections to @connectable made with the
+ * current settings of @client are pooled, or %NULL if they can’t be */
+static char *
+connection_pool_key (GSocketClient      *client,
+                     GSocketConnectable *connectable)
+{
+  GSocketClientPrivate *priv = client->priv;
+  char *connectable_str, *local_str = NULL, *key;
+
+  if (priv->connection_pool == NULL ||
+      G_SOCKET_CONNECTABLE_GET_IFACE (connectable)->to_string == NULL)
+    return NULL;
+
+  connectable_str = g_socket_connectable_to_string (connectable);
+  if (priv->local_address != NULL)
+    local_str = g_socket_connectable_to_string (G_SOCKET_CONNECTABLE (priv->local_address));
+
+  key = g_strdup_printf ("%s %s %s %d %d %d %d %u %d %p",
+                         G_OBJECT_TYPE_NAME (connectable), connectable_str,
+                         (local_str != NULL) ? local_str : "",
+                         priv->family, priv->type, priv->protocol,
+                         priv->tls, priv->tls_validation_flags,
+                         can_use_proxy (client), priv->proxy_resolver);
+
+  g_free (local_str);
+  g_free (connectable_str);
+
+  return key;
+}
+
 static void
 g_socket_client_class_init (GSocketClientClass *class)
 {
@@ -1013,6 +1103,20 @@ g_socket_client_class_init (GSocketClientClass *class)
                                                         G_PARAM_CONSTRUCT |
                                                         G_PARAM_READWRITE |
                                                         G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GSocketClient:connection-pool:
+   *
+   * The #GSocketConnectionPool to reuse idle connections from, if any.
+   * See g_socket_client_set_connection_pool().
+   *
+   * Since: 2.82
+   */
+  g_object_class_install_property (gobject_class, PROP_CONNECTION_POOL,
+                                   g_param_spec_object ("connection-pool", NULL, NULL,
+                                                        G_TYPE_SOCKET_CONNECTION_POOL,
+                                                        G_PARAM_READWRITE |
+                                                        G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -1131,6 +1235,21 @@ g_socket_client_connect (GSocketClient       *client,
   GSocketAddressEnumerator *enumerator = NULL;
   SocketClientErrorInfo *error_info;
   gboolean ever_resolved = FALSE;
+  char *pool_key;
+
+  pool_key = connection_pool_key (client, connectable);
+  if (pool_key != NULL)
+    {
+      GSocketConnection *pooled;
+
+      pooled = g_socket_connection_pool_take (client->priv->connection_pool, pool_key);
+      if (pooled != NULL)
+        {
+          g_free (pool_key);
+          g_socket_client_emit_event (client, G_SOCKET_CLIENT_COMPLETE, connectable, G_IO_STREAM (pooled));
+          return pooled;
+        }
+    }
 
   error_info = socket_client_error_info_new ();
 
@@ -1285,6 +1404,9 @@ G_GNUC_BEGIN_IGNORE_DEPRECATIONS
 	      g_tls_client_connection_set_validation_flags (G_TLS_CLIENT_CONNECTION (tlsconn),
                                                             client->priv->tls_validation_flags);
 G_GNUC_END_IGNORE_DEPRECATIONS
+              if (pool_key != NULL)
+                g_socket_connection_pool_resume_tls_session (client->priv->connection_pool, pool_key,
+                                                             G_TLS_CLIENT_CONNECTION (tlsconn));
 	      g_socket_client_emit_event (client, G_SOCKET_CLIENT_TLS_HANDSHAKING, connectable, connection);
 	      if (g_tls_connection_handshake (G_TLS_CONNECTION (tlsconn),
 					      cancellable, &error_info->tmp_error))
@@ -1320,7 +1442,11 @@ G_GNUC_END_IGNORE_DEPRECATIONS
 
   if (!connection)
     g_propagate_error (error, g_steal_pointer (&error_info->best_error));
+  else if (pool_key != NULL)
+    g_socket_connection_pool_track (client->priv->connection_pool, pool_key,
+                                    G_SOCKET_CONNECTION (connection));
   socket_client_error_info_free (error_info);
+  g_free (pool_key);
 
   g_socket_client_emit_event (client, G_SOCKET_CLIENT_COMPLETE, connectable, connection);
   return G_SOCKET_CONNECTION (connection);
@@ -1494,6 +1620,7 @@ typedef struct
   GSocketClient *client;
 
   GSocketConnectable *connectable;
+  char *pool_key;  /* (nullable) (owned) */
   GSocketAddressEnumerator *enumerator;
   GCancellable *enumeration_cancellable;
   GCancellable *enumeration_parent_cancellable;  /* (nullable) (owned) */
@@ -1519,6 +1646,7 @@ g_socket_client_async_connect_data_free (GSocketClientAsyncConnectData *data)
 {
   data->task = NULL;
   g_clear_object (&data->connectable);
+  g_clear_pointer (&data->pool_key, g_free);
   g_clear_object (&data->enumerator);
 
   g_cancellable_disconnect (data->enumeration_parent_cancellable, data->enumeration_cancelled_id);
@@ -1647,6 +1775,9 @@ g_socket_client_async_connect_complete (ConnectionAttempt *attempt)
   else
     {
       g_debug ("GSocketClient: Connection successful!");
+      if (data->pool_key != NULL)
+        g_socket_connection_pool_track (data->client->priv->connection_pool, data->pool_key,
+                                        G_SOCKET_CONNECTION (attempt->connection));
       g_socket_client_emit_event (data->client, G_SOCKET_CLIENT_COMPLETE, data->connectable, attempt->connection);
       g_task_return_pointer (data->task, g_steal_pointer (&attempt->connection), g_object_unref);
     }
@@ -1733,6 +1864,9 @@ G_GNUC_BEGIN_IGNORE_DEPRECATIONS
       g_tls_client_connection_set_validation_flags (G_TLS_CLIENT_CONNECTION (tlsconn),
                                                     data->client->priv->tls_validation_flags);
 G_GNUC_END_IGNORE_DEPRECATIONS
+      if (data->pool_key != NULL)
+        g_socket_connection_pool_resume_tls_session (data->client->priv->connection_pool, data->pool_key,
+                                                     G_TLS_CLIENT_CONNECTION (tlsconn));
       g_socket_client_emit_event (data->client, G_SOCKET_CLIENT_TLS_HANDSHAKING, data->connectable, G_IO_STREAM (tlsconn));
 
       /* This operation will time out if the underlying #GSocket times out on
@@ -2153,6 +2287,7 @@ g_socket_client_connect_async (GSocketClient       *client,
   data = g_slice_new0 (GSocketClientAsyncConnectData);
   data->client = client;
   data->connectable = g_object_ref (connectable);
+  data->pool_key = connection_pool_key (client, connectable);
   data->error_info = socket_client_error_info_new ();
 
   if (can_use_proxy (client))
@@ -2206,6 +2341,22 @@ g_socket_client_connect_async (GSocketClient       *client,
   g_task_set_source_tag (data->task, g_socket_client_connect_async);
   g_task_set_task_data (data->task, data, (GDestroyNotify)g_socket_client_async_connect_data_free);
 
+  if (data->pool_key != NULL)
+    {
+      GSocketConnection *pooled;
+
+      pooled = g_socket_connection_pool_take (client->priv->connection_pool, data->pool_key);
+      if (pooled != NULL)
+        {
+          g_debug ("GSocketClient: Reusing pooled connection");
+          data->completed = TRUE;
+          g_socket_client_emit_event (client, G_SOCKET_CLIENT_COMPLETE, connectable, G_IO_STREAM (pooled));
+          g_task_return_pointer (data->task, pooled, g_object_unref);
+          g_object_unref (data->task);
+          return;
+        }
+    }
+
   data->enumeration_cancellable = g_cancellable_new ();
   if (cancellable)
     {
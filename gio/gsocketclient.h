@@ -122,6 +122,11 @@ GProxyResolver         *g_socket_client_get_proxy_resolver              (GSocket
 GIO_AVAILABLE_IN_2_36
 void                    g_socket_client_set_proxy_resolver              (GSocketClient        *client,
                                                                          GProxyResolver       *proxy_resolver);
+GIO_AVAILABLE_IN_2_82
+GSocketConnectionPool  *g_socket_client_get_connection_pool             (GSocketClient        *client);
+GIO_AVAILABLE_IN_2_82
+void                    g_socket_client_set_connection_pool             (GSocketClient        *client,
+                                                                         GSocketConnectionPool *pool);
 
 GIO_AVAILABLE_IN_ALL
 GSocketConnection *     g_socket_client_connect                         (GSocketClient        *client,
@@ -0,0 +1,681 @@
+/* GIO - GLib Input, Output and Streaming Library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gsocketconnectionpool.h"
+
+#include "gioprivate.h"
+#include "giostream.h"
+#include "gsocket.h"
+#include "gsocketconnection.h"
+#include "gtcpwrapperconnection.h"
+#include "gtlsclientconnection.h"
+
+/**
+ * GSocketConnectionPool:
+ *
+ * `GSocketConnectionPool` keeps idle connections made by a
+ * [class@Gio.SocketClient] so that later connections to the same destination
+ * can reuse them, instead of resolving, connecting and doing a TLS handshake
+ * again.
+ *
+ * Set a pool on one or more clients with
+ * [method@Gio.SocketClient.set_connection_pool]. When the application has
+ * finished with a connection, and it is in a state where it can be used for
+ * another request (for example, after a complete HTTP/1.1 keep-alive
+ * response), it gives it back with [method@Gio.SocketConnectionPool.release].
+ * The next connection made by a client with the same settings to the same
+ * [iface@Gio.SocketConnectable] then returns the idle connection.
+ *
+ * Connections are keyed by the connectable (as given by
+ * [method@Gio.SocketConnectable.to_string]) and the client’s socket, TLS and
+ * proxy settings. Connectables which don’t implement
+ * [vfunc@Gio.SocketConnectable.to_string] aren’t pooled. Idle connections are
+ * checked before they are reused, and dropped if the peer has closed them
+ * or sent unexpected data. At most
+ * [property@Gio.SocketConnectionPool:max-idle] idle connections are kept for
+ * each key, each for at most
+ * [property@Gio.SocketConnectionPool:idle-timeout].
+ *
+ * For TLS connections, the pool also remembers the latest connection for
+ * each key, and new connections for the same key try to resume its TLS
+ * session (see [method@Gio.TlsClientConnection.copy_session_state]) so that
+ * their handshakes are abbreviated.
+ *
+ * `GSocketConnectionPool` is thread-safe.
+ *
+ * Since: 2.82
+ */
+
+#define DEFAULT_MAX_IDLE 4
+#define DEFAULT_IDLE_TIMEOUT 60
+
+/* Stop remembering TLS sessions for lots of hosts */
+#define MAX_TLS_SESSIONS 256
+
+struct _GSocketConnectionPool
+{
+  GObject parent_instance;
+
+  GMutex lock;
+  guint max_idle;  /* protected by @lock */
+  guint idle_timeout;  /* seconds; protected by @lock */
+  GHashTable *idle;  /* (owned) (element-type utf8 GQueue<IdleConnection>); protected by @lock */
+  GHashTable *tls_sessions;  /* (owned) (element-type utf8 GTlsClientConnection); protected by @lock */
+};
+
+typedef struct _GSocketConnectionPoolClass GSocketConnectionPoolClass;
+
+struct _GSocketConnectionPoolClass
+{
+  GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE (GSocketConnectionPool, g_socket_connection_pool, G_TYPE_OBJECT)
+
+typedef enum
+{
+  PROP_MAX_IDLE = 1,
+  PROP_IDLE_TIMEOUT,
+} GSocketConnectionPoolProperty;
+
+static GParamSpec *props[PROP_IDLE_TIMEOUT + 1] = { NULL, };
+
+/* Set on connections made through the pool, so that they can be released
+ * to it */
+typedef struct
+{
+  GWeakRef pool;
+  char *key;  /* (owned) */
+} PoolTag;
+
+static GQuark pool_tag_quark;
+
+/* An idle connection. If it has a @timeout_source, that owns the
+ * IdleConnection and frees it when destroyed. */
+typedef struct
+{
+  GSocketConnectionPool *pool;  /* (unowned) */
+  char *key;  /* (owned) */
+  GSocketConnection *connection;  /* (owned) (nullable); %NULL once taken */
+  GSource *timeout_source;  /* (owned) (nullable) */
+} IdleConnection;
+
+static void
+pool_tag_free (PoolTag *tag)
+{
+  g_weak_ref_clear (&tag->pool);
+  g_free (tag->key);
+  g_free (tag);
+}
+
+static void
+close_connection (GSocketConnection *connection)
+{
+  /* The connection is idle, so there’s nothing to flush */
+  g_io_stream_close (G_IO_STREAM (connection), NULL, NULL);
+  g_object_unref (connection);
+}
+
+static void
+idle_connection_free (IdleConnection *idle)
+{
+  g_clear_pointer (&idle->connection, close_connection);
+  g_clear_pointer (&idle->timeout_source, g_source_unref);
+  g_free (idle->key);
+  g_free (idle);
+}
+
+/* Destroys @idle’s timeout source, which frees it. Must be called with
+ * neither @idle in the pool nor the lock held. */
+static void
+idle_connection_discard (IdleConnection *idle)
+{
+  if (idle->timeout_source != NULL)
+    g_source_destroy (idle->timeout_source);
+  else
+    idle_connection_free (idle);
+}
+
+static void
+idle_queue_free (GQueue *queue)
+{
+  g_queue_free_full (queue, (GDestroyNotify) idle_connection_discard);
+}
+
+static gboolean
+idle_timeout_cb (gpointer user_data)
+{
+  IdleConnection *idle = user_data;
+  GSocketConnectionPool *pool = idle->pool;
+  GSocketConnection *connection = NULL;
+  GQueue *queue;
+
+  g_mutex_lock (&pool->lock);
+
+  /* The connection may have been taken while this was being dispatched */
+  queue = g_hash_table_lookup (pool->idle, idle->key);
+  if (queue != NULL && g_queue_remove (queue, idle))
+    {
+      connection = g_steal_pointer (&idle->connection);
+      if (g_queue_is_empty (queue))
+        g_hash_table_remove (pool->idle, idle->key);
+    }
+
+  g_mutex_unlock (&pool->lock);
+
+  g_clear_pointer (&connection, close_connection);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+g_socket_connection_pool_init (GSocketConnectionPool *pool)
+{
+  g_mutex_init (&pool->lock);
+  pool->max_idle = DEFAULT_MAX_IDLE;
+  pool->idle_timeout = DEFAULT_IDLE_TIMEOUT;
+  pool->idle = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                      (GDestroyNotify) idle_queue_free);
+  pool->tls_sessions = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                              g_object_unref);
+}
+
+static void
+g_socket_connection_pool_finalize (GObject *object)
+{
+  GSocketConnectionPool *pool = G_SOCKET_CONNECTION_POOL (object);
+
+  g_hash_table_unref (pool->idle);
+  g_hash_table_unref (pool->tls_sessions);
+  g_mutex_clear (&pool->lock);
+
+  G_OBJECT_CLASS (g_socket_connection_pool_parent_class)->finalize (object);
+}
+
+static void
+g_socket_connection_pool_get_property (GObject    *object,
+                                       guint       prop_id,
+                                       GValue     *value,
+                                       GParamSpec *pspec)
+{
+  GSocketConnectionPool *pool = G_SOCKET_CONNECTION_POOL (object);
+
+  switch ((GSocketConnectionPoolProperty) prop_id)
+    {
+    case PROP_MAX_IDLE:
+      g_value_set_uint (value, g_socket_connection_pool_get_max_idle (pool));
+      break;
+    case PROP_IDLE_TIMEOUT:
+      g_value_set_uint (value, g_socket_connection_pool_get_idle_timeout (pool));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+    }
+}
+
+static void
+g_socket_connection_pool_set_property (GObject      *object,
+                                       guint         prop_id,
+                                       const GValue *value,
+                                       GParamSpec   *pspec)
+{
+  GSocketConnectionPool *pool = G_SOCKET_CONNECTION_POOL (object);
+
+  switch ((GSocketConnectionPoolProperty) prop_id)
+    {
+    case PROP_MAX_IDLE:
+      g_socket_connection_pool_set_max_idle (pool, g_value_get_uint (value));
+      break;
+    case PROP_IDLE_TIMEOUT:
+      g_socket_connection_pool_set_idle_timeout (pool, g_value_get_uint (value));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+    }
+}
+
+static void
+g_socket_connection_pool_class_init (GSocketConnectionPoolClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->get_property = g_socket_connection_pool_get_property;
+  object_class->set_property = g_socket_connection_pool_set_property;
+  object_class->finalize = g_socket_connection_pool_finalize;
+
+  pool_tag_quark = g_quark_from_static_string ("gio-socket-connection-pool-tag");
+
+  /**
+   * GSocketConnectionPool:max-idle:
+   *
+   * The largest number of idle connections kept for each destination.
+   *
+   * If this is `0`, released connections are always closed, but TLS
+   * sessions are still remembered.
+   *
+   * Since: 2.82
+   */
+  props[PROP_MAX_IDLE] =
+    g_param_spec_uint ("max-idle", NULL, NULL,
+                       0, G_MAXUINT, DEFAULT_MAX_IDLE,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * GSocketConnectionPool:idle-timeout:
+   *
+   * The time after which an idle connection is closed, in seconds.
+   *
+   * The timeout is run in the thread-default main context of the thread
+   * which released the connection. If this is `0`, idle connections are kept
+   * until they are reused or the pool is cleared.
+   *
+   * Changing this doesn’t affect connections which are already idle.
+   *
+   * Since: 2.82
+   */
+  props[PROP_IDLE_TIMEOUT] =
+    g_param_spec_uint ("idle-timeout", NULL, NULL,
+                       0, G_MAXUINT, DEFAULT_IDLE_TIMEOUT,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  g_object_class_install_properties (object_class, G_N_ELEMENTS (props), props);
+}
+
+/**
+ * g_socket_connection_pool_new:
+ *
+ * Creates a new, empty #GSocketConnectionPool.
+ *
+ * Returns: (transfer full): a new #GSocketConnectionPool
+ *
+ * Since: 2.82
+ */
+GSocketConnectionPool *
+g_socket_connection_pool_new (void)
+{
+  return g_object_new (G_TYPE_SOCKET_CONNECTION_POOL, NULL);
+}
+
+/**
+ * g_socket_connection_pool_get_max_idle:
+ * @pool: a #GSocketConnectionPool
+ *
+ * Gets the largest number of idle connections kept for each destination.
+ * See #GSocketConnectionPool:max-idle.
+ *
+ * Returns: the maximum number of idle connections per destination
+ *
+ * Since: 2.82
+ */
+guint
+g_socket_connection_pool_get_max_idle (GSocketConnectionPool *pool)
+{
+  guint max_idle;
+
+  g_return_val_if_fail (G_IS_SOCKET_CONNECTION_POOL (pool), 0);
+
+  g_mutex_lock (&pool->lock);
+  max_idle = pool->max_idle;
+  g_mutex_unlock (&pool->lock);
+
+  return max_idle;
+}
+
+/**
+ * g_socket_connection_pool_set_max_idle:
+ * @pool: a #GSocketConnectionPool
+ * @max_idle: the maximum number of idle connections per destination
+ *
+ * Sets the largest number of idle connections kept for each destination.
+ * See #GSocketConnectionPool:max-idle.
+ *
+ * Since: 2.82
+ */
+void
+g_socket_connection_pool_set_max_idle (GSocketConnectionPool *pool,
+                                       guint                  max_idle)
+{
+  gboolean changed;
+
+  g_return_if_fail (G_IS_SOCKET_CONNECTION_POOL (pool));
+
+  g_mutex_lock (&pool->lock);
+  changed = (pool->max_idle != max_idle);
+  pool->max_idle = max_idle;
+  g_mutex_unlock (&pool->lock);
+
+  if (changed)
+    g_object_notify_by_pspec (G_OBJECT (pool), props[PROP_MAX_IDLE]);
+}
+
+/**
+ * g_socket_connection_pool_get_idle_timeout:
+ * @pool: a #GSocketConnectionPool
+ *
+ * Gets the time after which idle connections are closed. See
+ * #GSocketConnectionPool:idle-timeout.
+ *
+ * Returns: the idle timeout, in seconds, or `0` for no timeout
+ *
+ * Since: 2.82
+ */
+guint
+g_socket_connection_pool_get_idle_timeout (GSocketConnectionPool *pool)
+{
+  guint idle_timeout;
+
+  g_return_val_if_fail (G_IS_SOCKET_CONNECTION_POOL (pool), 0);
+
+  g_mutex_lock (&pool->lock);
+  idle_timeout = pool->idle_timeout;
+  g_mutex_unlock (&pool->lock);
+
+  return idle_timeout;
+}
+
+/**
+ * g_socket_connection_pool_set_idle_timeout:
+ * @pool: a #GSocketConnectionPool
+ * @idle_timeout: the idle timeout, in seconds, or `0` for no timeout
+ *
+ * Sets the time after which idle connections are closed. See
+ * #GSocketConnectionPool:idle-timeout.
+ *
+ * Since: 2.82
+ */
+void
+g_socket_connection_pool_set_idle_timeout (GSocketConnectionPool *pool,
+                                           guint                  idle_timeout)
+{
+  gboolean changed;
+
+  g_return_if_fail (G_IS_SOCKET_CONNECTION_POOL (pool));
+
+  g_mutex_lock (&pool->lock);
+  changed = (pool->idle_timeout != idle_timeout);
+  pool->idle_timeout = idle_timeout;
+  g_mutex_unlock (&pool->lock);
+
+  if (changed)
+    g_object_notify_by_pspec (G_OBJECT (pool), props[PROP_IDLE_TIMEOUT]);
+}
+
+static gboolean
+connection_is_tls (GSocketConnection *connection)
+{
+  return G_IS_TCP_WRAPPER_CONNECTION (connection) &&
+         G_IS_TLS_CONNECTION (g_tcp_wrapper_connection_get_base_io_stream (G_TCP_WRAPPER_CONNECTION (connection)));
+}
+
+/* Checks that an idle connection can still be used, without blocking */
+static gboolean
+connection_is_reusable (GSocketConnection *connection)
+{
+  GSocket *socket = g_socket_connection_get_socket (connection);
+  GIOCondition condition;
+  guint8 byte;
+  GInputVector vector = { &byte, 1 };
+  int flags = G_SOCKET_MSG_PEEK;
+
+  if (g_io_stream_is_closed (G_IO_STREAM (connection)) ||
+      g_io_stream_has_pending (G_IO_STREAM (connection)) ||
+      !g_socket_is_connected (socket))
+    return FALSE;
+
+  condition = g_socket_condition_check (socket, G_IO_IN | G_IO_ERR | G_IO_HUP);
+  if (condition & (G_IO_ERR | G_IO_HUP))
+    return FALSE;
+  if (!(condition & G_IO_IN))
+    return TRUE;
+
+  /* The peer has either closed the connection, or sent something. Plain
+   * connections shouldn’t get anything between requests, but TLS servers
+   * may send post-handshake messages such as session tickets. */
+  if (g_socket_receive_message (socket, NULL, &vector, 1, NULL, NULL,
+                                &flags, NULL, NULL) <= 0)
+    return FALSE;
+
+  return connection_is_tls (connection);
+}
+
+/*< internal >
+ * g_socket_connection_pool_take:
+ * @pool: a #GSocketConnectionPool
+ * @key: the key for the connection settings and destination
+ *
+ * Takes a reusable idle connection for @key out of @pool, closing any
+ * which turn out to be unusable.
+ *
+ * Returns: (transfer full) (nullable): an idle connection, or %NULL
+ */
+GSocketConnection *
+g_socket_connection_pool_take (GSocketConnectionPool *pool,
+                               const char            *key)
+{
+  while (TRUE)
+    {
+      IdleConnection *idle = NULL;
+      GSocketConnection *connection;
+      GQueue *queue;
+
+      g_mutex_lock (&pool->lock);
+
+      queue = g_hash_table_lookup (pool->idle, key);
+      if (queue != NULL)
+        {
+          /* Use the most recently released connection, as it’s the least
+           * likely to have been closed by the server */
+          idle = g_queue_pop_tail (queue);
+          if (g_queue_is_empty (queue))
+            g_hash_table_remove (pool->idle, key);
+        }
+
+      connection = (idle != NULL) ? g_steal_pointer (&idle->connection) : NULL;
+
+      g_mutex_unlock (&pool->lock);
+
+      if (idle == NULL)
+        return NULL;
+
+      idle_connection_discard (idle);
+
+      if (connection_is_reusable (connection))
+        return connection;
+
+      close_connection (connection);
+    }
+}
+
+/*< internal >
+ * g_socket_connection_pool_track:
+ * @pool: a #GSocketConnectionPool
+ * @key: the key for the connection settings and destination
+ * @connection: a newly made connection
+ *
+ * Marks @connection as able to be released to @pool under @key, and if
+ * it’s a TLS connection, remembers it for resuming TLS sessions for @key.
+ */
+void
+g_socket_connection_pool_track (GSocketConnectionPool *pool,
+                                const char            *key,
+                                GSocketConnection     *connection)
+{
+  PoolTag *tag;
+
+  tag = g_new0 (PoolTag, 1);
+  g_weak_ref_init (&tag->pool, pool);
+  tag->key = g_strdup (key);
+  g_object_set_qdata_full (G_OBJECT (connection), pool_tag_quark,
+                           tag, (GDestroyNotify) pool_tag_free);
+
+  if (connection_is_tls (connection))
+    {
+      GIOStream *tls_connection;
+
+      tls_connection = g_tcp_wrapper_connection_get_base_io_stream (G_TCP_WRAPPER_CONNECTION (connection));
+      if (!G_IS_TLS_CLIENT_CONNECTION (tls_connection))
+        return;
+
+      g_mutex_lock (&pool->lock);
+      if (g_hash_table_size (pool->tls_sessions) >= MAX_TLS_SESSIONS &&
+          !g_hash_table_contains (pool->tls_sessions, key))
+        g_hash_table_remove_all (pool->tls_sessions);
+      g_hash_table_replace (pool->tls_sessions, g_strdup (key),
+                            g_object_ref (tls_connection));
+      g_mutex_unlock (&pool->lock);
+    }
+}
+
+/*< internal >
+ * g_socket_connection_pool_resume_tls_session:
+ * @pool: a #GSocketConnectionPool
+ * @key: the key for the connection settings and destination
+ * @connection: a TLS connection which hasn’t done its handshake yet
+ *
+ * Copies the TLS session state of the latest connection for @key to
+ * @connection, if there is one.
+ */
+void
+g_socket_connection_pool_resume_tls_session (GSocketConnectionPool *pool,
+                                             const char            *key,
+                                             GTlsClientConnection  *connection)
+{
+  GTlsClientConnection *source;
+
+  g_mutex_lock (&pool->lock);
+  source = g_hash_table_lookup (pool->tls_sessions, key);
+  if (source != NULL)
+    g_object_ref (source);
+  g_mutex_unlock (&pool->lock);
+
+  if (source != NULL)
+    {
+      g_tls_client_connection_copy_session_state (connection, source);
+      g_object_unref (source);
+    }
+}
+
+/**
+ * g_socket_connection_pool_release:
+ * @pool: a #GSocketConnectionPool
+ * @connection: a connection made by a #GSocketClient using @pool
+ *
+ * Gives @connection back to @pool, to be reused by a later connection to
+ * the same destination.
+ *
+ * Only release a connection when it is idle at the application protocol
+ * level, with no outstanding requests or unread responses. The caller must
+ * not use @connection afterwards, although it should still drop its own
+ * reference.
+ *
+ * If @connection wasn’t made through @pool, has been closed, isn’t usable
+ * any more, or there are already #GSocketConnectionPool:max-idle idle
+ * connections to the same destination, it is closed instead.
+ *
+ * Since: 2.82
+ */
+void
+g_socket_connection_pool_release (GSocketConnectionPool *pool,
+                                  GSocketConnection     *connection)
+{
+  PoolTag *tag;
+  GSocketConnectionPool *tag_pool = NULL;
+  IdleConnection *idle = NULL;
+
+  g_return_if_fail (G_IS_SOCKET_CONNECTION_POOL (pool));
+  g_return_if_fail (G_IS_SOCKET_CONNECTION (connection));
+
+  tag = g_object_get_qdata (G_OBJECT (connection), pool_tag_quark);
+  if (tag != NULL)
+    tag_pool = g_weak_ref_get (&tag->pool);
+
+  if (tag_pool == pool && connection_is_reusable (connection))
+    {
+      GQueue *queue;
+
+      g_mutex_lock (&pool->lock);
+
+      queue = g_hash_table_lookup (pool->idle, tag->key);
+      if (pool->max_idle > 0 &&
+          (queue == NULL || g_queue_get_length (queue) < pool->max_idle))
+        {
+          if (queue == NULL)
+            {
+              queue = g_queue_new ();
+              g_hash_table_insert (pool->idle, g_strdup (tag->key), queue);
+            }
+
+          idle = g_new0 (IdleConnection, 1);
+          idle->pool = pool;
+          idle->key = g_strdup (tag->key);
+          idle->connection = g_object_ref (connection);
+
+          if (pool->idle_timeout > 0)
+            {
+              GMainContext *context = g_main_context_ref_thread_default ();
+
+              idle->timeout_source = g_timeout_source_new_seconds (pool->idle_timeout);
+              g_source_set_static_name (idle->timeout_source, "[gio] GSocketConnectionPool idle timeout");
+              g_source_set_callback (idle->timeout_source, idle_timeout_cb,
+                                     idle, (GDestroyNotify) idle_connection_free);
+              g_source_attach (idle->timeout_source, context);
+              g_main_context_unref (context);
+            }
+
+          g_queue_push_tail (queue, idle);
+        }
+
+      g_mutex_unlock (&pool->lock);
+    }
+
+  g_clear_object (&tag_pool);
+
+  if (idle == NULL)
+    g_io_stream_close (G_IO_STREAM (connection), NULL, NULL);
+}
+
+/**
+ * g_socket_connection_pool_clear:
+ * @pool: a #GSocketConnectionPool
+ *
+ * Closes all the idle connections in @pool, and forgets the TLS sessions
+ * it was keeping for resumption.
+ *
+ * This is useful when the network configuration has changed.
+ *
+ * Since: 2.82
+ */
+void
+g_socket_connection_pool_clear (GSocketConnectionPool *pool)
+{
+  GHashTable *idle;
+
+  g_return_if_fail (G_IS_SOCKET_CONNECTION_POOL (pool));
+
+  g_mutex_lock (&pool->lock);
+  idle = g_steal_pointer (&pool->idle);
+  pool->idle = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                      (GDestroyNotify) idle_queue_free);
+  g_hash_table_remove_all (pool->tls_sessions);
+  g_mutex_unlock (&pool->lock);
+
+  /* Close the connections outside the lock, as that may block */
+  g_hash_table_unref (idle);
+}
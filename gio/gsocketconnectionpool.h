@@ -0,0 +1,61 @@
+/* GIO - GLib Input, Output and Streaming Library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __G_SOCKET_CONNECTION_POOL_H__
+#define __G_SOCKET_CONNECTION_POOL_H__
+
+#if !defined (__GIO_GIO_H_INSIDE__) && !defined (GIO_COMPILATION)
+#error "Only <gio/gio.h> can be included directly."
+#endif
+
+#include <gio/giotypes.h>
+
+G_BEGIN_DECLS
+
+#define G_TYPE_SOCKET_CONNECTION_POOL                       (g_socket_connection_pool_get_type ())
+#define G_SOCKET_CONNECTION_POOL(inst)                      (G_TYPE_CHECK_INSTANCE_CAST ((inst),                     \
+                                                             G_TYPE_SOCKET_CONNECTION_POOL, GSocketConnectionPool))
+#define G_IS_SOCKET_CONNECTION_POOL(inst)                   (G_TYPE_CHECK_INSTANCE_TYPE ((inst),                     \
+                                                             G_TYPE_SOCKET_CONNECTION_POOL))
+
+GIO_AVAILABLE_IN_2_82
+GType                   g_socket_connection_pool_get_type               (void) G_GNUC_CONST;
+
+GIO_AVAILABLE_IN_2_82
+GSocketConnectionPool * g_socket_connection_pool_new                    (void);
+
+GIO_AVAILABLE_IN_2_82
+guint                   g_socket_connection_pool_get_max_idle           (GSocketConnectionPool *pool);
+GIO_AVAILABLE_IN_2_82
+void                    g_socket_connection_pool_set_max_idle           (GSocketConnectionPool *pool,
+                                                                         guint                  max_idle);
+GIO_AVAILABLE_IN_2_82
+guint                   g_socket_connection_pool_get_idle_timeout       (GSocketConnectionPool *pool);
+GIO_AVAILABLE_IN_2_82
+void                    g_socket_connection_pool_set_idle_timeout       (GSocketConnectionPool *pool,
+                                                                         guint                  idle_timeout);
+
+GIO_AVAILABLE_IN_2_82
+void                    g_socket_connection_pool_release                (GSocketConnectionPool *pool,
+                                                                         GSocketConnection     *connection);
+GIO_AVAILABLE_IN_2_82
+void                    g_socket_connection_pool_clear                  (GSocketConnectionPool *pool);
+
+G_END_DECLS
+
+#endif /* __G_SOCKET_CONNECTION_POOL_H__ */
@@ -31,6 +31,8 @@
 #include "gpollableinputstream.h"
 #include "gioerror.h"
 #include "gfiledescriptorbased.h"
+#include "gioprivate.h"
+#include "gtask.h"
 
 struct _GSocketInputStreamPrivate
 {
@@ -130,6 +132,35 @@ g_socket_input_stream_read (GInputStream  *stream,
 					 cancellable, error);
 }
 
+static void
+g_socket_input_stream_read_async (GInputStream        *stream,
+                                  void                *buffer,
+                                  gsize                count,
+                                  int                  io_priority,
+                                  GCancellable        *cancellable,
+                                  GAsyncReadyCallback  callback,
+                                  gpointer             user_data)
+{
+  GSocketInputStream *input_stream = G_SOCKET_INPUT_STREAM (stream);
+  GTask *task;
+
+  /* Without io_uring, wait for the socket to be readable with poll() */
+  if (!g_socket_can_use_io_uring (input_stream->priv->socket))
+    {
+      G_INPUT_STREAM_CLASS (g_socket_input_stream_parent_class)->
+        read_async (stream, buffer, count, io_priority, cancellable, callback, user_data);
+      return;
+    }
+
+  task = g_task_new (stream, cancellable, callback, user_data);
+  g_task_set_source_tag (task, g_socket_input_stream_read_async);
+  g_task_set_priority (task, io_priority);
+
+  g_socket_receive_io_uring (input_stream->priv->socket, buffer, count, task);
+
+  g_object_unref (task);
+}
+
 static gboolean
 g_socket_input_stream_pollable_is_readable (GPollableInputStream *pollable)
 {
@@ -189,6 +220,7 @@ g_socket_input_stream_class_init (GSocketInputStreamClass *klass)
   gobject_class->set_property = g_socket_input_stream_set_property;
 
   ginputstream_class->read_fn = g_socket_input_stream_read;
+  ginputstream_class->read_async = g_socket_input_stream_read_async;
 
   g_object_class_install_property (gobject_class, PROP_SOCKET,
 				   g_param_spec_object ("socket", NULL, NULL,
@@ -221,5 +253,10 @@ g_socket_input_stream_init (GSocketInputStream *stream)
 GSocketInputStream *
 _g_socket_input_stream_new (GSocket *socket)
 {
-  return g_object_new (G_TYPE_SOCKET_INPUT_STREAM, "socket", socket, NULL);
+  GSocketInputStream *stream;
+
+  stream = g_object_new (G_TYPE_SOCKET_INPUT_STREAM, "socket", socket, NULL);
+  g_input_stream_set_splice_socket (G_INPUT_STREAM (stream), socket);
+
+  return stream;
 }
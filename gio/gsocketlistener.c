@@ -37,6 +37,7 @@
 #include <gio/gsocket.h>
 #include <gio/gsocketconnection.h>
 #include <gio/ginetsocketaddress.h>
+#include "gioprivate.h"
 #include "glibintl.h"
 #include "gmarshal-internal.h"
 
@@ -78,6 +79,7 @@ enum
 static guint signals[LAST_SIGNAL] = { 0 };
 
 static GQuark source_quark = 0;
+static GQuark shard_context_quark = 0;
 
 struct _GSocketListenerPrivate
 {
@@ -85,6 +87,7 @@ struct _GSocketListenerPrivate
   GMainContext        *main_context;
   int                 listen_backlog;
   guint               closed : 1;
+  guint               accept_shards_separately : 1;
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (GSocketListener, g_socket_listener, G_TYPE_OBJECT)
@@ -197,6 +200,7 @@ g_socket_listener_class_init (GSocketListenerClass *klass)
                               _g_cclosure_marshal_VOID__ENUM_OBJECTv);
 
   source_quark = g_quark_from_static_string ("g-socket-listener-source");
+  shard_context_quark = g_quark_from_static_string ("g-socket-listener-shard-context");
 }
 
 static void
@@ -601,6 +605,181 @@ g_socket_listener_add_inet_port (GSocketListener  *listener,
   return TRUE;
 }
 
+static GSocket *
+create_shard_socket (GSocketListener  *listener,
+                     GSocketFamily     family,
+                     guint16           port,
+                     GError          **error)
+{
+  GInetAddress *inet_address;
+  GSocketAddress *address;
+  GSocket *socket;
+
+  socket = g_socket_new (family,
+                         G_SOCKET_TYPE_STREAM,
+                         G_SOCKET_PROTOCOL_DEFAULT,
+                         error);
+  if (socket == NULL)
+    return NULL;
+
+  if (!g_socket_set_reuse_port (socket, TRUE))
+    {
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                           _("Sharing a port between sockets is not supported on this platform"));
+      g_object_unref (socket);
+      return NULL;
+    }
+
+  g_socket_set_listen_backlog (socket, listener->priv->listen_backlog);
+
+  inet_address = g_inet_address_new_any (family);
+  address = g_inet_socket_address_new (inet_address, port);
+  g_object_unref (inet_address);
+
+  g_signal_emit (listener, signals[EVENT], 0,
+                 G_SOCKET_LISTENER_BINDING, socket);
+
+  if (!g_socket_bind (socket, address, TRUE, error))
+    {
+      g_object_unref (address);
+      g_object_unref (socket);
+      return NULL;
+    }
+
+  g_object_unref (address);
+
+  g_signal_emit (listener, signals[EVENT], 0,
+                 G_SOCKET_LISTENER_BOUND, socket);
+  g_signal_emit (listener, signals[EVENT], 0,
+                 G_SOCKET_LISTENER_LISTENING, socket);
+
+  if (!g_socket_listen (socket, error))
+    {
+      g_object_unref (socket);
+      return NULL;
+    }
+
+  g_signal_emit (listener, signals[EVENT], 0,
+                 G_SOCKET_LISTENER_LISTENED, socket);
+
+  return socket;
+}
+
+/**
+ * g_socket_listener_add_sharded_inet_port:
+ * @listener: a #GSocketListener
+ * @port: an IP port number, or 0 to pick any available port
+ * @contexts: (array length=n_contexts) (nullable): the main contexts to
+ *   accept connections in, %NULL entries meaning the global default
+ *   main context
+ * @n_contexts: the number of entries in @contexts, which must be non-zero
+ * @source_object: (nullable): Optional #GObject identifying this source
+ * @error: #GError for error reporting, or %NULL to ignore.
+ *
+ * Listens for TCP connections on @port on all interfaces, with one
+ * listening socket per entry of @contexts. The sockets all share the port
+ * using `SO_REUSEPORT`, and the kernel balances incoming connections
+ * between them, so each socket has its own accept queue.
+ *
+ * A #GSocketService accepts connections on each of these sockets
+ * independently, in the corresponding main context, and emits
+ * [signal@Gio.SocketService::incoming] there. The contexts must be
+ * iterated by other threads for this to scale past a single accept loop,
+ * and the signal handlers must then be thread-safe. The other accept
+ * functions of #GSocketListener treat the sockets like any other.
+ *
+ * A dual-stack IPv6 socket is used for each shard if supported, and IPv4
+ * otherwise.
+ *
+ * Call g_socket_listener_close() to stop listening on @port.
+ *
+ * Returns: the port number, or 0 in case of failure. The error is
+ *   %G_IO_ERROR_NOT_SUPPORTED if the platform can’t share ports.
+ *
+ * Since: 2.82
+ */
+guint16
+g_socket_listener_add_sharded_inet_port (GSocketListener     *listener,
+                                         guint16              port,
+                                         GMainContext * const *contexts,
+                                         guint                n_contexts,
+                                         GObject             *source_object,
+                                         GError             **error)
+{
+  GSocketFamily family = G_SOCKET_FAMILY_IPV6;
+  GPtrArray *shards;
+  guint i;
+
+  g_return_val_if_fail (G_IS_SOCKET_LISTENER (listener), 0);
+  g_return_val_if_fail (n_contexts > 0, 0);
+  g_return_val_if_fail (error == NULL || *error == NULL, 0);
+
+  if (!check_listener (listener, error))
+    return 0;
+
+  shards = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (i = 0; i < n_contexts; i++)
+    {
+      GMainContext *context = (contexts != NULL) ? contexts[i] : NULL;
+      GSocket *socket = NULL;
+
+      /* As in g_socket_listener_add_inet_port(), prefer IPv6, but only if
+       * one socket can take both families */
+      if (i == 0)
+        {
+          socket = create_shard_socket (listener, G_SOCKET_FAMILY_IPV6, port, NULL);
+          if (socket != NULL && !g_socket_speaks_ipv4 (socket))
+            g_clear_object (&socket);
+          if (socket == NULL)
+            family = G_SOCKET_FAMILY_IPV4;
+        }
+
+      if (socket == NULL)
+        socket = create_shard_socket (listener, family, port, error);
+      if (socket == NULL)
+        {
+          g_ptr_array_unref (shards);
+          return 0;
+        }
+
+      if (port == 0)
+        {
+          GSocketAddress *address;
+
+          address = g_socket_get_local_address (socket, error);
+          if (address == NULL)
+            {
+              g_object_unref (socket);
+              g_ptr_array_unref (shards);
+              return 0;
+            }
+
+          port = g_inet_socket_address_get_port (G_INET_SOCKET_ADDRESS (address));
+          g_object_unref (address);
+        }
+
+      g_object_set_qdata_full (G_OBJECT (socket), shard_context_quark,
+                               g_main_context_ref (context != NULL ? context : g_main_context_default ()),
+                               (GDestroyNotify) g_main_context_unref);
+      if (source_object)
+        g_object_set_qdata_full (G_OBJECT (socket), source_quark,
+                                 g_object_ref (source_object),
+                                 g_object_unref);
+
+      g_ptr_array_add (shards, socket);
+    }
+
+  for (i = 0; i < shards->len; i++)
+    g_ptr_array_add (listener->priv->sockets, g_object_ref (shards->pdata[i]));
+  g_ptr_array_unref (shards);
+
+  if (G_SOCKET_LISTENER_GET_CLASS (listener)->changed)
+    G_SOCKET_LISTENER_GET_CLASS (listener)->changed (listener);
+
+  return port;
+}
+
 static GList *
 add_sources (GSocketListener   *listener,
 	     GSocketSourceFunc  callback,
@@ -618,6 +797,10 @@ add_sources (GSocketListener   *listener,
     {
       socket = listener->priv->sockets->pdata[i];
 
+      if (listener->priv->accept_shards_separately &&
+          g_object_get_qdata (G_OBJECT (socket), shard_context_quark) != NULL)
+        continue;
+
       source = g_socket_create_source (socket, G_IO_IN, cancellable);
       g_source_set_callback (source,
                              (GSourceFunc) callback,
@@ -643,6 +826,95 @@ free_sources (GList *sources)
     }
 }
 
+/* Used by #GSocketService to accept on the sockets added with
+ * g_socket_listener_add_sharded_inet_port() in their own contexts, rather
+ * than through g_socket_listener_accept_async(). */
+void
+g_socket_listener_set_accept_shards_separately (GSocketListener *listener)
+{
+  listener->priv->accept_shards_separately = TRUE;
+}
+
+typedef struct
+{
+  GSocketListener *listener;  /* (owned) */
+  GSocketListenerShardFunc func;
+} ShardSourceData;
+
+static void
+shard_source_data_free (ShardSourceData *data)
+{
+  g_object_unref (data->listener);
+  g_free (data);
+}
+
+static gboolean
+shard_accept_ready (GSocket      *accept_socket,
+                    GIOCondition  condition,
+                    gpointer      user_data)
+{
+  ShardSourceData *data = user_data;
+  GError *error = NULL;
+  GSocket *socket;
+
+  socket = g_socket_accept (accept_socket, NULL, &error);
+  if (socket == NULL)
+    {
+      if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CLOSED))
+        {
+          g_error_free (error);
+          return G_SOURCE_REMOVE;
+        }
+
+      g_warning ("Error accepting connection: %s", error->message);
+      g_error_free (error);
+      return G_SOURCE_CONTINUE;
+    }
+
+  data->func (data->listener, socket,
+              g_object_get_qdata (G_OBJECT (accept_socket), source_quark));
+  g_object_unref (socket);
+
+  return G_SOURCE_CONTINUE;
+}
+
+/* Attaches a source to the context of each sharded socket, which accepts
+ * connections until it’s destroyed and passes them to @func in that
+ * context. Each source holds a reference on @listener. */
+GList *
+g_socket_listener_add_shard_sources (GSocketListener          *listener,
+                                     GSocketListenerShardFunc  func)
+{
+  GList *sources = NULL;
+  guint i;
+
+  for (i = 0; i < listener->priv->sockets->len; i++)
+    {
+      GSocket *socket = listener->priv->sockets->pdata[i];
+      GMainContext *context;
+      ShardSourceData *data;
+      GSource *source;
+
+      context = g_object_get_qdata (G_OBJECT (socket), shard_context_quark);
+      if (context == NULL)
+        continue;
+
+      data = g_new0 (ShardSourceData, 1);
+      data->listener = g_object_ref (listener);
+      data->func = func;
+
+      source = g_socket_create_source (socket, G_IO_IN, NULL);
+      g_source_set_callback (source, (GSourceFunc) shard_accept_ready,
+                             data, (GDestroyNotify) shard_source_data_free);
+      g_source_set_static_name (source, "[gio] shard_accept_ready");
+      g_source_attach (source, context);
+
+      sources = g_list_prepend (sources, source);
+    }
+
+  return sources;
+}
+
 struct AcceptData {
   GMainLoop *loop;
   GSocket *socket;
@@ -113,6 +113,13 @@ GIO_AVAILABLE_IN_ALL
 guint16                 g_socket_listener_add_any_inet_port             (GSocketListener     *listener,
 									 GObject             *source_object,
 									 GError             **error);
+GIO_AVAILABLE_IN_2_82
+guint16                 g_socket_listener_add_sharded_inet_port         (GSocketListener     *listener,
+                                                                         guint16              port,
+                                                                         GMainContext * const *contexts,
+                                                                         guint                n_contexts,
+                                                                         GObject             *source_object,
+                                                                         GError             **error);
 
 GIO_AVAILABLE_IN_ALL
 GSocket *               g_socket_listener_accept_socket                 (GSocketListener      *listener,
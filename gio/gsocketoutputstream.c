@@ -36,6 +36,7 @@
 #include "glibintl.h"
 #include "gfiledescriptorbased.h"
 #include "gioprivate.h"
+#include "gtask.h"
 
 struct _GSocketOutputStreamPrivate
 {
@@ -164,6 +165,35 @@ g_socket_output_stream_writev (GOutputStream        *stream,
   return res == G_POLLABLE_RETURN_OK;
 }
 
+static void
+g_socket_output_stream_write_async (GOutputStream       *stream,
+                                    const void          *buffer,
+                                    gsize                count,
+                                    int                  io_priority,
+                                    GCancellable        *cancellable,
+                                    GAsyncReadyCallback  callback,
+                                    gpointer             user_data)
+{
+  GSocketOutputStream *output_stream = G_SOCKET_OUTPUT_STREAM (stream);
+  GTask *task;
+
+  /* Without io_uring, wait for the socket to be writable with poll() */
+  if (!g_socket_can_use_io_uring (output_stream->priv->socket))
+    {
+      G_OUTPUT_STREAM_CLASS (g_socket_output_stream_parent_class)->
+        write_async (stream, buffer, count, io_priority, cancellable, callback, user_data);
+      return;
+    }
+
+  task = g_task_new (stream, cancellable, callback, user_data);
+  g_task_set_source_tag (task, g_socket_output_stream_write_async);
+  g_task_set_priority (task, io_priority);
+
+  g_socket_send_io_uring (output_stream->priv->socket, buffer, count, task);
+
+  g_object_unref (task);
+}
+
 static gboolean
 g_socket_output_stream_pollable_is_writable (GPollableOutputStream *pollable)
 {
@@ -245,6 +275,7 @@ g_socket_output_stream_class_init (GSocketOutputStreamClass *klass)
 
   goutputstream_class->write_fn = g_socket_output_stream_write;
   goutputstream_class->writev_fn = g_socket_output_stream_writev;
+  goutputstream_class->write_async = g_socket_output_stream_write_async;
 
   g_object_class_install_property (gobject_class, PROP_SOCKET,
 				   g_param_spec_object ("socket", NULL, NULL,
@@ -278,5 +309,10 @@ g_socket_output_stream_init (GSocketOutputStream *stream)
 GSocketOutputStream *
 _g_socket_output_stream_new (GSocket *socket)
 {
-  return g_object_new (G_TYPE_SOCKET_OUTPUT_STREAM, "socket", socket, NULL);
+  GSocketOutputStream *stream;
+
+  stream = g_object_new (G_TYPE_SOCKET_OUTPUT_STREAM, "socket", socket, NULL);
+  g_output_stream_set_splice_socket (G_OUTPUT_STREAM (stream), socket);
+
+  return stream;
 }
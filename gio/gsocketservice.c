@@ -52,6 +52,11 @@
  * stop the service are thread-safe so these can be used from threads that
  * handle incoming clients.
  *
+ * Sockets added with [method@Gio.SocketListener.add_sharded_inet_port] are
+ * the exception: connections on them are accepted in the main context given
+ * for each socket, and [signal@Gio.SocketService::incoming] is emitted
+ * there.
+ *
  * Since: 2.22
  */
 
@@ -61,12 +66,14 @@
 #include <gio/gio.h>
 #include "gsocketlistener.h"
 #include "gsocketconnection.h"
+#include "gioprivate.h"
 #include "glibintl.h"
 #include "gmarshal-internal.h"
 
 struct _GSocketServicePrivate
 {
   GCancellable *cancellable;
+  GList *shard_sources;  /* (element-type GSource) (owned) */
   guint active : 1;
   guint outstanding_accept : 1;
 };
@@ -101,6 +108,15 @@ g_socket_service_init (GSocketService *service)
   service->priv = g_socket_service_get_instance_private (service);
   service->priv->cancellable = g_cancellable_new ();
   service->priv->active = TRUE;
+
+  g_socket_listener_set_accept_shards_separately (G_SOCKET_LISTENER (service));
+}
+
+static void
+destroy_source (gpointer data)
+{
+  g_source_destroy (data);
+  g_source_unref (data);
 }
 
 static void
@@ -109,11 +125,41 @@ g_socket_service_finalize (GObject *object)
   GSocketService *service = G_SOCKET_SERVICE (object);
 
   g_object_unref (service->priv->cancellable);
+  g_list_free_full (service->priv->shard_sources, destroy_source);
 
   G_OBJECT_CLASS (g_socket_service_parent_class)
     ->finalize (object);
 }
 
+static gboolean g_socket_service_incoming (GSocketService    *service,
+                                           GSocketConnection *connection,
+                                           GObject           *source_object);
+
+/* Called in the shard’s context */
+static void
+shard_incoming (GSocketListener *listener,
+                GSocket         *socket,
+                GObject         *source_object)
+{
+  GSocketConnection *connection;
+
+  connection = g_socket_connection_factory_create_connection (socket);
+  g_socket_service_incoming (G_SOCKET_SERVICE (listener), connection, source_object);
+  g_object_unref (connection);
+}
+
+/* Sockets added with g_socket_listener_add_sharded_inet_port() are accepted
+ * on in their own contexts, for as long as the service is active. */
+static void
+update_shard_sources_unlocked (GSocketService *service)
+{
+  g_list_free_full (g_steal_pointer (&service->priv->shard_sources), destroy_source);
+
+  if (service->priv->active)
+    service->priv->shard_sources =
+      g_socket_listener_add_shard_sources (G_SOCKET_LISTENER (service), shard_incoming);
+}
+
 static void
 do_accept (GSocketService  *service)
 {
@@ -161,6 +207,8 @@ set_active (GSocketService *service, gboolean active)
           if (service->priv->outstanding_accept)
             g_cancellable_cancel (service->priv->cancellable);
         }
+
+      update_shard_sources_unlocked (service);
     }
 
   G_UNLOCK (active);
@@ -220,6 +268,8 @@ g_socket_service_changed (GSocketListener *listener)
 	g_cancellable_cancel (service->priv->cancellable);
       else
 	do_accept (service);
+
+      update_shard_sources_unlocked (service);
     }
 
   G_UNLOCK (active);
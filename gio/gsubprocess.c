@@ -1313,7 +1313,28 @@ g_subprocess_set_launcher (GSubprocess         *subprocess,
  * communicate operation.  We have to be careful that we don't report
  * the task completion more than once, though, so we keep a flag for
  * that.
+ *
+ * Output which is returned to the caller is read straight into a single
+ * buffer, each read asking for all of its free space.  The buffer grows
+ * geometrically (up to a step of COMMUNICATE_BUFFER_MAX_STEP), so large
+ * outputs take few reads, and the data is never copied in userspace:
+ * g_realloc() can move large blocks by remapping them, and the buffer is
+ * handed over to the returned GBytes.  Output which goes to a stream
+ * given by the caller is spliced into it, inside the kernel where both
+ * ends are file descriptors.
  */
+#define COMMUNICATE_BUFFER_MIN_STEP (64 * 1024)
+#define COMMUNICATE_BUFFER_MAX_STEP (16 * 1024 * 1024)
+
+typedef struct
+{
+  GInputStream *pipe;  /* (unowned) */
+  guint8 *data;
+  gsize len;
+  gsize allocated;
+  gboolean discard;
+} CommunicateBuffer;
+
 typedef struct
 {
   const gchar *stdin_data;
@@ -1323,8 +1344,10 @@ typedef struct
   gboolean add_nul;
 
   GInputStream *stdin_buf;
-  GMemoryOutputStream *stdout_buf;
-  GMemoryOutputStream *stderr_buf;
+  CommunicateBuffer *stdout_buf;
+  CommunicateBuffer *stderr_buf;
+  GOutputStream *stdout_stream;
+  GOutputStream *stderr_stream;
 
   GCancellable *cancellable;
   GSource      *cancellable_source;
@@ -1333,12 +1356,97 @@ typedef struct
   gboolean      reported_error;
 } CommunicateState;
 
+static void g_subprocess_communicate_made_progress (GObject      *source_object,
+                                                    GAsyncResult *result,
+                                                    gpointer      user_data);
+
+static CommunicateBuffer *
+communicate_buffer_new (GInputStream *pipe,
+                        gboolean      discard)
+{
+  CommunicateBuffer *buffer;
+
+  buffer = g_new0 (CommunicateBuffer, 1);
+  buffer->pipe = pipe;
+  buffer->discard = discard;
+
+  return buffer;
+}
+
+static void
+communicate_buffer_free (CommunicateBuffer *buffer)
+{
+  g_free (buffer->data);
+  g_free (buffer);
+}
+
+/* Makes room for at least one more byte at the end of @buffer */
+static void
+communicate_buffer_reserve (CommunicateBuffer *buffer)
+{
+  if (buffer->len < buffer->allocated)
+    return;
+
+  buffer->allocated += CLAMP (buffer->allocated,
+                              COMMUNICATE_BUFFER_MIN_STEP,
+                              COMMUNICATE_BUFFER_MAX_STEP);
+  buffer->data = g_realloc (buffer->data, buffer->allocated);
+}
+
+static void
+communicate_buffer_read (CommunicateBuffer *buffer,
+                         GTask             *task)
+{
+  CommunicateState *state = g_task_get_task_data (task);
+
+  /* Output nobody wants only needs a buffer to be read into */
+  if (buffer->discard)
+    buffer->len = 0;
+
+  communicate_buffer_reserve (buffer);
+  g_input_stream_read_async (buffer->pipe,
+                             buffer->data + buffer->len,
+                             buffer->allocated - buffer->len,
+                             G_PRIORITY_DEFAULT, state->cancellable,
+                             g_subprocess_communicate_made_progress,
+                             g_object_ref (task));
+  state->outstanding_ops++;
+}
+
+/* Returns the data read into @buffer, shrinking the allocation to fit,
+ * and its length in @len, if non-%NULL. Free it with g_free(). */
+static guint8 *
+communicate_buffer_steal_data (CommunicateBuffer *buffer,
+                               gsize             *len)
+{
+  guint8 *data;
+
+  data = g_realloc (g_steal_pointer (&buffer->data), buffer->len);
+  if (len != NULL)
+    *len = buffer->len;
+  buffer->len = buffer->allocated = 0;
+
+  return data;
+}
+
+static GBytes *
+communicate_buffer_steal_as_bytes (CommunicateBuffer *buffer)
+{
+  guint8 *data;
+  gsize len;
+
+  data = communicate_buffer_steal_data (buffer, &len);
+
+  return g_bytes_new_take (data, len);
+}
+
 static void
 g_subprocess_communicate_made_progress (GObject      *source_object,
                                         GAsyncResult *result,
                                         gpointer      user_data)
 {
   CommunicateState *state;
+  CommunicateBuffer *buffer = NULL;
   GSubprocess *subprocess;
   GError *error = NULL;
   gpointer source;
@@ -1353,30 +1461,43 @@ g_subprocess_communicate_made_progress (GObject      *source_object,
 
   state->outstanding_ops--;
 
-  if (source == subprocess->stdin_pipe ||
-      source == state->stdout_buf ||
-      source == state->stderr_buf)
+  if (state->stdout_buf != NULL && source == state->stdout_buf->pipe)
+    buffer = state->stdout_buf;
+  else if (state->stderr_buf != NULL && source == state->stderr_buf->pipe)
+    buffer = state->stderr_buf;
+
+  if (buffer != NULL)
     {
-      if (g_output_stream_splice_finish ((GOutputStream*) source, result, &error) == -1)
+      gssize n_read;
+
+      n_read = g_input_stream_read_finish (buffer->pipe, result, &error);
+      if (n_read == -1)
         goto out;
 
-      if (source == state->stdout_buf ||
-          source == state->stderr_buf)
+      if (n_read > 0)
+        {
+          buffer->len += n_read;
+          if (!state->reported_error)
+            communicate_buffer_read (buffer, task);
+        }
+      else
         {
-          /* This is a memory stream, so it can't be cancelled or return
-           * an error really.
-           */
           if (state->add_nul)
             {
-              gsize bytes_written;
-              if (!g_output_stream_write_all (source, "\0", 1, &bytes_written,
-                                              NULL, &error))
-                goto out;
+              communicate_buffer_reserve (buffer);
+              buffer->data[buffer->len++] = '\0';
             }
-          if (!g_output_stream_close (source, NULL, &error))
+          if (!g_input_stream_close (buffer->pipe, NULL, &error))
             goto out;
         }
     }
+  else if (source == subprocess->stdin_pipe ||
+           source == state->stdout_stream ||
+           source == state->stderr_stream)
+    {
+      if (g_output_stream_splice_finish ((GOutputStream*) source, result, &error) == -1)
+        goto out;
+    }
   else if (source == subprocess)
     {
       (void) g_subprocess_wait_finish (subprocess, result, &error);
@@ -1428,8 +1549,10 @@ g_subprocess_communicate_state_free (gpointer data)
 
   g_clear_object (&state->cancellable);
   g_clear_object (&state->stdin_buf);
-  g_clear_object (&state->stdout_buf);
-  g_clear_object (&state->stderr_buf);
+  g_clear_pointer (&state->stdout_buf, communicate_buffer_free);
+  g_clear_pointer (&state->stderr_buf, communicate_buffer_free);
+  g_clear_object (&state->stdout_stream);
+  g_clear_object (&state->stderr_stream);
 
   if (state->cancellable_source)
     {
@@ -1440,10 +1563,15 @@ g_subprocess_communicate_state_free (gpointer data)
   g_slice_free (CommunicateState, state);
 }
 
+/* If @to_streams is set, output is written to @stdout_stream and
+ * @stderr_stream, or discarded if they are %NULL, rather than returned. */
 static CommunicateState *
 g_subprocess_communicate_internal (GSubprocess         *subprocess,
                                    gboolean             add_nul,
                                    GBytes              *stdin_buf,
+                                   gboolean             to_streams,
+                                   GOutputStream       *stdout_stream,
+                                   GOutputStream       *stderr_stream,
                                    GCancellable        *cancellable,
                                    GAsyncReadyCallback  callback,
                                    gpointer             user_data)
@@ -1498,25 +1626,35 @@ g_subprocess_communicate_internal (GSubprocess         *subprocess,
       state->outstanding_ops++;
     }
 
-  if (subprocess->stdout_pipe)
+  if (subprocess->stdout_pipe && stdout_stream != NULL)
     {
-      state->stdout_buf = (GMemoryOutputStream*)g_memory_output_stream_new_resizable ();
-      g_output_stream_splice_async ((GOutputStream*)state->stdout_buf, subprocess->stdout_pipe,
+      state->stdout_stream = g_object_ref (stdout_stream);
+      g_output_stream_splice_async (state->stdout_stream, subprocess->stdout_pipe,
                                     G_OUTPUT_STREAM_SPLICE_CLOSE_SOURCE,
                                     G_PRIORITY_DEFAULT, state->cancellable,
                                     g_subprocess_communicate_made_progress, g_object_ref (task));
       state->outstanding_ops++;
     }
+  else if (subprocess->stdout_pipe)
+    {
+      state->stdout_buf = communicate_buffer_new (subprocess->stdout_pipe, to_streams);
+      communicate_buffer_read (state->stdout_buf, task);
+    }
 
-  if (subprocess->stderr_pipe)
+  if (subprocess->stderr_pipe && stderr_stream != NULL)
     {
-      state->stderr_buf = (GMemoryOutputStream*)g_memory_output_stream_new_resizable ();
-      g_output_stream_splice_async ((GOutputStream*)state->stderr_buf, subprocess->stderr_pipe,
+      state->stderr_stream = g_object_ref (stderr_stream);
+      g_output_stream_splice_async (state->stderr_stream, subprocess->stderr_pipe,
                                     G_OUTPUT_STREAM_SPLICE_CLOSE_SOURCE,
                                     G_PRIORITY_DEFAULT, state->cancellable,
                                     g_subprocess_communicate_made_progress, g_object_ref (task));
       state->outstanding_ops++;
     }
+  else if (subprocess->stderr_pipe)
+    {
+      state->stderr_buf = communicate_buffer_new (subprocess->stderr_pipe, to_streams);
+      communicate_buffer_read (state->stderr_buf, task);
+    }
 
   g_subprocess_wait_async (subprocess, state->cancellable,
                            g_subprocess_communicate_made_progress, g_object_ref (task));
@@ -1598,7 +1736,8 @@ g_subprocess_communicate (GSubprocess   *subprocess,
   g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
 
   g_subprocess_sync_setup ();
-  g_subprocess_communicate_internal (subprocess, FALSE, stdin_buf, cancellable,
+  g_subprocess_communicate_internal (subprocess, FALSE, stdin_buf,
+                                     FALSE, NULL, NULL, cancellable,
                                      g_subprocess_sync_done, &result);
   g_subprocess_sync_complete (&result);
   success = g_subprocess_communicate_finish (subprocess, result, stdout_buf, stderr_buf, error);
@@ -1629,7 +1768,8 @@ g_subprocess_communicate_async (GSubprocess         *subprocess,
   g_return_if_fail (stdin_buf == NULL || (subprocess->flags & G_SUBPROCESS_FLAGS_STDIN_PIPE));
   g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
 
-  g_subprocess_communicate_internal (subprocess, FALSE, stdin_buf, cancellable, callback, user_data);
+  g_subprocess_communicate_internal (subprocess, FALSE, stdin_buf, FALSE, NULL, NULL,
+                                     cancellable, callback, user_data);
 }
 
 /**
@@ -1664,15 +1804,143 @@ g_subprocess_communicate_finish (GSubprocess   *subprocess,
   if (success)
     {
       if (stdout_buf)
-        *stdout_buf = (state->stdout_buf != NULL) ? g_memory_output_stream_steal_as_bytes (state->stdout_buf) : NULL;
+        *stdout_buf = (state->stdout_buf != NULL) ? communicate_buffer_steal_as_bytes (state->stdout_buf) : NULL;
       if (stderr_buf)
-        *stderr_buf = (state->stderr_buf != NULL) ? g_memory_output_stream_steal_as_bytes (state->stderr_buf) : NULL;
+        *stderr_buf = (state->stderr_buf != NULL) ? communicate_buffer_steal_as_bytes (state->stderr_buf) : NULL;
     }
 
   g_object_unref (result);
   return success;
 }
 
+/**
+ * g_subprocess_communicate_to_streams:
+ * @subprocess: a #GSubprocess
+ * @stdin_buf: (nullable): data to send to the stdin of the subprocess, or %NULL
+ * @stdout_stream: (nullable): stream to write the stdout of the subprocess to,
+ *   or %NULL to discard it
+ * @stderr_stream: (nullable): stream to write the stderr of the subprocess to,
+ *   or %NULL to discard it
+ * @cancellable: (nullable): a #GCancellable
+ * @error: a pointer to a %NULL #GError pointer, or %NULL
+ *
+ * Like g_subprocess_communicate(), but rather than collecting the output
+ * of the subprocess in memory, forwards it to @stdout_stream and
+ * @stderr_stream as it arrives.  This is suited to output which is too
+ * large to be held in memory, or which is only going to be written out
+ * again.
+ *
+ * Where the given stream is backed by a file descriptor, such as a
+ * #GUnixOutputStream or the stream of a local file, the output is
+ * moved into it by the kernel with `splice()`, without being copied into
+ * userspace.
+ *
+ * If the subprocess was created with %G_SUBPROCESS_FLAGS_STDOUT_PIPE and
+ * @stdout_stream is %NULL, its stdout is read and discarded, so that the
+ * subprocess does not block writing to it.  Similar provisions apply to
+ * @stderr_stream and %G_SUBPROCESS_FLAGS_STDERR_PIPE.  @stdout_stream and
+ * @stderr_stream are not closed, and must not be the same stream; use
+ * %G_SUBPROCESS_FLAGS_STDERR_MERGE to get both outputs in one stream.
+ *
+ * In case of any error (including cancellation), %FALSE will be
+ * returned with @error set.  Some or all of the output may have been
+ * written to the streams.
+ *
+ * Returns: %TRUE if successful
+ *
+ * Since: 2.82
+ **/
+gboolean
+g_subprocess_communicate_to_streams (GSubprocess    *subprocess,
+                                     GBytes         *stdin_buf,
+                                     GOutputStream  *stdout_stream,
+                                     GOutputStream  *stderr_stream,
+                                     GCancellable   *cancellable,
+                                     GError        **error)
+{
+  GAsyncResult *result = NULL;
+  gboolean success;
+
+  g_return_val_if_fail (G_IS_SUBPROCESS (subprocess), FALSE);
+  g_return_val_if_fail (stdin_buf == NULL || (subprocess->flags & G_SUBPROCESS_FLAGS_STDIN_PIPE), FALSE);
+  g_return_val_if_fail (stdout_stream == NULL || G_IS_OUTPUT_STREAM (stdout_stream), FALSE);
+  g_return_val_if_fail (stderr_stream == NULL || G_IS_OUTPUT_STREAM (stderr_stream), FALSE);
+  g_return_val_if_fail (stdout_stream == NULL || stdout_stream != stderr_stream, FALSE);
+  g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  g_subprocess_sync_setup ();
+  g_subprocess_communicate_internal (subprocess, FALSE, stdin_buf,
+                                     TRUE, stdout_stream, stderr_stream, cancellable,
+                                     g_subprocess_sync_done, &result);
+  g_subprocess_sync_complete (&result);
+  success = g_subprocess_communicate_to_streams_finish (subprocess, result, error);
+  g_object_unref (result);
+
+  return success;
+}
+
+/**
+ * g_subprocess_communicate_to_streams_async:
+ * @subprocess: a #GSubprocess
+ * @stdin_buf: (nullable): data to send to the stdin of the subprocess, or %NULL
+ * @stdout_stream: (nullable): stream to write the stdout of the subprocess to,
+ *   or %NULL to discard it
+ * @stderr_stream: (nullable): stream to write the stderr of the subprocess to,
+ *   or %NULL to discard it
+ * @cancellable: (nullable): a #GCancellable
+ * @callback: a #GAsyncReadyCallback to call when the operation is complete
+ * @user_data: the data to pass to @callback
+ *
+ * Asynchronous version of g_subprocess_communicate_to_streams().  Complete
+ * invocation with g_subprocess_communicate_to_streams_finish().
+ *
+ * Since: 2.82
+ */
+void
+g_subprocess_communicate_to_streams_async (GSubprocess         *subprocess,
+                                           GBytes              *stdin_buf,
+                                           GOutputStream       *stdout_stream,
+                                           GOutputStream       *stderr_stream,
+                                           GCancellable        *cancellable,
+                                           GAsyncReadyCallback  callback,
+                                           gpointer             user_data)
+{
+  g_return_if_fail (G_IS_SUBPROCESS (subprocess));
+  g_return_if_fail (stdin_buf == NULL || (subprocess->flags & G_SUBPROCESS_FLAGS_STDIN_PIPE));
+  g_return_if_fail (stdout_stream == NULL || G_IS_OUTPUT_STREAM (stdout_stream));
+  g_return_if_fail (stderr_stream == NULL || G_IS_OUTPUT_STREAM (stderr_stream));
+  g_return_if_fail (stdout_stream == NULL || stdout_stream != stderr_stream);
+  g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+  g_subprocess_communicate_internal (subprocess, FALSE, stdin_buf, TRUE, stdout_stream, stderr_stream,
+                                     cancellable, callback, user_data);
+}
+
+/**
+ * g_subprocess_communicate_to_streams_finish:
+ * @subprocess: a #GSubprocess
+ * @result: a #GAsyncResult
+ * @error: a pointer to a %NULL #GError pointer, or %NULL
+ *
+ * Complete an invocation of g_subprocess_communicate_to_streams_async().
+ *
+ * Returns: %TRUE if successful
+ *
+ * Since: 2.82
+ */
+gboolean
+g_subprocess_communicate_to_streams_finish (GSubprocess   *subprocess,
+                                            GAsyncResult  *result,
+                                            GError       **error)
+{
+  g_return_val_if_fail (G_IS_SUBPROCESS (subprocess), FALSE);
+  g_return_val_if_fail (g_task_is_valid (result, subprocess), FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
+
 /**
  * g_subprocess_communicate_utf8:
  * @subprocess: a #GSubprocess
@@ -1711,7 +1979,8 @@ g_subprocess_communicate_utf8 (GSubprocess   *subprocess,
   stdin_bytes = g_bytes_new (stdin_buf, stdin_buf_len);
 
   g_subprocess_sync_setup ();
-  g_subprocess_communicate_internal (subprocess, TRUE, stdin_bytes, cancellable,
+  g_subprocess_communicate_internal (subprocess, TRUE, stdin_bytes,
+                                     FALSE, NULL, NULL, cancellable,
                                      g_subprocess_sync_done, &result);
   g_subprocess_sync_complete (&result);
   success = g_subprocess_communicate_utf8_finish (subprocess, result, stdout_buf, stderr_buf, error);
@@ -1750,7 +2019,8 @@ g_subprocess_communicate_utf8_async (GSubprocess         *subprocess,
     stdin_buf_len = strlen (stdin_buf);
   stdin_bytes = g_bytes_new (stdin_buf, stdin_buf_len);
 
-  g_subprocess_communicate_internal (subprocess, TRUE, stdin_bytes, cancellable, callback, user_data);
+  g_subprocess_communicate_internal (subprocess, TRUE, stdin_bytes, FALSE, NULL, NULL,
+                                     cancellable, callback, user_data);
 
   g_bytes_unref (stdin_bytes);
 }
@@ -1758,7 +2028,7 @@ g_subprocess_communicate_utf8_async (GSubprocess         *subprocess,
 static gboolean
 communicate_result_validate_utf8 (const char            *stream_name,
                                   char                 **return_location,
-                                  GMemoryOutputStream   *buffer,
+                                  CommunicateBuffer     *buffer,
                                   GError               **error)
 {
   if (return_location == NULL)
@@ -1767,7 +2037,8 @@ communicate_result_validate_utf8 (const char            *stream_name,
   if (buffer)
     {
       const char *end;
-      *return_location = g_memory_output_stream_steal_data (buffer);
+
+      *return_location = (char *) communicate_buffer_steal_data (buffer, NULL);
       if (!g_utf8_validate (*return_location, -1, &end))
         {
           g_free (*return_location);
@@ -164,6 +164,27 @@ gboolean        g_subprocess_communicate_utf8_finish    (GSubprocess          *s
                                                          char                **stderr_buf,
                                                          GError              **error);
 
+GIO_AVAILABLE_IN_2_82
+gboolean        g_subprocess_communicate_to_streams     (GSubprocess          *subprocess,
+                                                         GBytes               *stdin_buf,
+                                                         GOutputStream        *stdout_stream,
+                                                         GOutputStream        *stderr_stream,
+                                                         GCancellable         *cancellable,
+                                                         GError              **error);
+GIO_AVAILABLE_IN_2_82
+void            g_subprocess_communicate_to_streams_async (GSubprocess        *subprocess,
+                                                           GBytes             *stdin_buf,
+                                                           GOutputStream      *stdout_stream,
+                                                           GOutputStream      *stderr_stream,
+                                                           GCancellable       *cancellable,
+                                                           GAsyncReadyCallback callback,
+                                                           gpointer            user_data);
+
+GIO_AVAILABLE_IN_2_82
+gboolean        g_subprocess_communicate_to_streams_finish (GSubprocess       *subprocess,
+                                                            GAsyncResult      *result,
+                                                            GError           **error);
+
 G_END_DECLS
 
 #endif /* __G_SUBPROCESS_H__ */
@@ -571,6 +571,9 @@ struct _GTask {
 
   GMainContext *context;
   gint64 creation_time;
+#ifdef HAVE_SYSPROF
+  gint64 trace_begin_time_nsec;  /* for the span up to the callback */
+#endif
   gint priority;
   GCancellable *cancellable;
 
@@ -601,6 +604,9 @@ struct _GTask {
   guint synchronous : 1;
   guint blocking_other_task : 1;
   guint name_is_static : 1;
+  guint cpu_bound : 1;
+  GThreadPool *thread_pool;  /* (nullable) (not owned) */
+  gint64 queue_time;
 
   GError *error;
   union {
@@ -623,30 +629,63 @@ typedef enum
   PROP_COMPLETED = 1,
 } GTaskProperty;
 
+static GParamSpec *task_props[PROP_COMPLETED + 1] = { NULL, };
+
 static void g_task_async_result_iface_init (GAsyncResultIface *iface);
 static void g_task_thread_pool_init (void);
+static gint g_task_compare_priority (gconstpointer a,
+                                    gconstpointer b,
+                                    gpointer      user_data);
 
 G_DEFINE_TYPE_WITH_CODE (GTask, g_task, G_TYPE_OBJECT,
                          G_IMPLEMENT_INTERFACE (G_TYPE_ASYNC_RESULT,
                                                 g_task_async_result_iface_init);
                          g_task_thread_pool_init ();)
 
-static GThreadPool *task_pool;
+/* Tasks run in one of two pools, or “lanes”: one for tasks which mostly
+ * block on I/O, which is the default, and one for tasks marked with
+ * g_task_set_cpu_bound(), which is sized to the number of processors. This
+ * way a burst of slow file operations can’t hold up short computations,
+ * and vice versa. Tasks given their own pool with g_task_set_thread_pool()
+ * aren’t managed at all. */
+typedef enum
+{
+  TASK_LANE_BLOCKING,
+  TASK_LANE_CPU,
+  N_TASK_LANES
+} TaskLaneId;
+
+typedef struct
+{
+  GThreadPool *pool;
+  GSource *manager;
+  gint base_size;
+  gint running;
+  guint64 wait_time;
+  gint64 average_wait;  /* of the tasks started lately, in µs */
+  gint64 last_start_time;
+
+  guint max_counter;
+  guint running_counter;
+  guint depth_counter;
+  guint wait_counter;
+} TaskLane;
+
+static TaskLane task_lanes[N_TASK_LANES];
 static GMutex task_pool_mutex;
 static GPrivate task_private = G_PRIVATE_INIT (NULL);
-static GSource *task_pool_manager;
-static guint64 task_wait_time;
-static gint tasks_running;
 
-static guint task_pool_max_counter;
-static guint tasks_running_counter;
-
-/* When the task pool fills up and blocks, and the program keeps
- * queueing more tasks, we will slowly add more threads to the pool
- * (in case the existing tasks are trying to queue subtasks of their
- * own) until tasks start completing again. These "overflow" threads
- * will only run one task apiece, and then exit, so the pool will
- * eventually get back down to its base size.
+/* When a lane fills up and tasks wait in its queue for longer than
+ * the lane’s wait time, we will slowly add more threads to it (in case
+ * the existing tasks are trying to queue subtasks of their own) until
+ * tasks start completing again. These "overflow" threads will only run
+ * one task apiece, and then exit, so the lane will eventually get back
+ * down to its base size.
+ *
+ * How long tasks wait is measured as they leave the queue; while no task
+ * leaves it, the time since one last did counts instead, so a lane which
+ * is completely blocked still grows. A full lane which is working through
+ * its queue quickly doesn’t grow.
  *
  * The base and multiplier below gives us 10 extra threads after about
  * a second of blocking, 30 after 5 seconds, 100 after a minute, and
@@ -836,6 +875,10 @@ g_task_new (gpointer              source_object,
   if (source)
     task->creation_time = g_source_get_time (source);
 
+#ifdef HAVE_SYSPROF
+  task->trace_begin_time_nsec = G_TRACE_CURRENT_TIME;
+#endif
+
   TRACE (GIO_TASK_NEW (task, source_object, cancellable,
                        callback, callback_data));
 
@@ -1354,6 +1397,18 @@ g_task_return_now (GTask *task)
   TRACE (GIO_TASK_BEFORE_RETURN (task, task->source_object, task->callback,
                                  task->callback_data));
 
+#ifdef HAVE_SYSPROF
+  /* The span covers the whole asynchronous operation, up to the point
+   * where its result is handed to the callback */
+  if (task->name != NULL)
+    g_trace_mark (task->trace_begin_time_nsec, G_TRACE_CURRENT_TIME - task->trace_begin_time_nsec,
+                  "GIO", "GTask", "%s%s", task->name, task->had_error ? " ⇒ error" : "");
+  else
+    g_trace_mark (task->trace_begin_time_nsec, G_TRACE_CURRENT_TIME - task->trace_begin_time_nsec,
+                  "GIO", "GTask", "source tag %p%s", task->source_tag,
+                  task->had_error ? " ⇒ error" : "");
+#endif
+
   g_main_context_push_thread_default (task->context);
 
   if (task->callback != NULL)
@@ -1364,17 +1419,143 @@ g_task_return_now (GTask *task)
     }
 
   task->completed = TRUE;
-  g_object_notify (G_OBJECT (task), "completed");
+  g_object_notify_by_pspec (G_OBJECT (task), task_props[PROP_COMPLETED]);
 
   g_main_context_pop_thread_default (task->context);
 }
 
+/* Tasks which can’t complete straight away are queued on a source shared
+ * by all tasks of the same #GMainContext and priority, rather than each
+ * getting an idle source of its own, which is most of the cost of
+ * returning a task for programs which run a lot of small ones. The
+ * sources stay attached until their context is destroyed. Tasks keep
+ * their context alive, so a source can be looked up by context without a
+ * reference being held on it. */
+typedef struct
+{
+  GSource source;
+  GMainContext *context;  /* (not owned) */
+
+  GMutex lock;
+  GQueue tasks;  /* (element-type GTask) (owned) */
+} CompletionSource;
+
+G_LOCK_DEFINE_STATIC (completion_sources);
+static GHashTable *completion_sources;  /* (element-type GMainContext GSList<CompletionSource>) */
+
 static gboolean
-complete_in_idle_cb (gpointer task)
+completion_source_dispatch (GSource     *source,
+                            GSourceFunc  callback,
+                            gpointer     user_data)
+{
+  CompletionSource *completion = (CompletionSource *) source;
+  guint n_tasks;
+
+  /* Tasks returned from the callbacks are only completed in the next
+   * iteration, as they would be with a new idle source. The source can
+   * recurse, so callbacks may run a nested main loop and still see the
+   * remaining tasks complete. */
+  g_mutex_lock (&completion->lock);
+  n_tasks = completion->tasks.length;
+  g_mutex_unlock (&completion->lock);
+
+  while (n_tasks-- > 0)
+    {
+      GTask *task;
+
+      g_mutex_lock (&completion->lock);
+      task = g_queue_pop_head (&completion->tasks);
+      g_mutex_unlock (&completion->lock);
+
+      if (task == NULL)
+        break;
+
+      g_task_return_now (task);
+      g_object_unref (task);
+    }
+
+  g_mutex_lock (&completion->lock);
+  g_source_set_ready_time (source, completion->tasks.length > 0 ? 0 : -1);
+  g_mutex_unlock (&completion->lock);
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+completion_source_finalize (GSource *source)
 {
-  g_task_return_now (task);
-  g_object_unref (task);
-  return FALSE;
+  CompletionSource *completion = (CompletionSource *) source;
+  GSList *sources;
+
+  G_LOCK (completion_sources);
+  sources = g_hash_table_lookup (completion_sources, completion->context);
+  sources = g_slist_remove (sources, completion);
+  if (sources != NULL)
+    g_hash_table_insert (completion_sources, completion->context, sources);
+  else
+    g_hash_table_remove (completion_sources, completion->context);
+  G_UNLOCK (completion_sources);
+
+  g_queue_clear_full (&completion->tasks, g_object_unref);
+  g_mutex_clear (&completion->lock);
+}
+
+static GSourceFuncs completion_source_funcs = {
+  NULL, /* prepare */
+  NULL, /* check */
+  completion_source_dispatch,
+  completion_source_finalize,
+  NULL, /* closure */
+  NULL  /* marshal */
+};
+
+/* Takes ownership of @task */
+static void
+complete_in_idle (GTask *task)
+{
+  CompletionSource *completion = NULL;
+  GSList *sources, *l;
+
+  G_LOCK (completion_sources);
+
+  if (completion_sources == NULL)
+    completion_sources = g_hash_table_new (NULL, NULL);
+
+  sources = g_hash_table_lookup (completion_sources, task->context);
+  for (l = sources; l != NULL; l = l->next)
+    {
+      if (g_source_get_priority (l->data) == task->priority)
+        {
+          completion = l->data;
+          break;
+        }
+    }
+
+  if (completion == NULL)
+    {
+      GSource *source;
+
+      source = g_source_new (&completion_source_funcs, sizeof (CompletionSource));
+      completion = (CompletionSource *) source;
+      completion->context = task->context;
+      g_mutex_init (&completion->lock);
+      g_source_set_static_name (source, "[gio] GTask completion");
+      g_source_set_priority (source, task->priority);
+      g_source_set_can_recurse (source, TRUE);
+      g_source_set_ready_time (source, -1);
+      g_source_attach (source, task->context);
+      g_source_unref (source);
+
+      g_hash_table_insert (completion_sources, task->context,
+                           g_slist_prepend (sources, completion));
+    }
+
+  g_mutex_lock (&completion->lock);
+  g_queue_push_tail (&completion->tasks, task);
+  g_source_set_ready_time ((GSource *) completion, 0);
+  g_mutex_unlock (&completion->lock);
+
+  G_UNLOCK (completion_sources);
 }
 
 typedef enum {
@@ -1435,25 +1616,7 @@ g_task_return (GTask           *task,
     }
 
   /* Otherwise, complete in the next iteration */
-  source = g_idle_source_new ();
-
-  /* Note: in case the task name is NULL we set it as a const string instead
-   * of going through the concat path which is more expensive and may show in the
-   * profiler if g_task_return is called very often
-   */
-  if (task->name == NULL)
-    g_source_set_static_name (source, "[gio] (unnamed) complete_in_idle_cb");
-  else
-    {
-      gchar *source_name;
-
-      source_name = g_strconcat ("[gio] ", task->name, " complete_in_idle_cb", NULL);
-      g_source_set_name (source, source_name);
-      g_free (source_name);
-    }
-
-  g_task_attach_source (task, source, complete_in_idle_cb);
-  g_source_unref (source);
+  complete_in_idle (task);
 }
 
 
@@ -1516,57 +1679,94 @@ g_task_thread_complete (GTask *task)
 static gboolean
 task_pool_manager_timeout (gpointer user_data)
 {
+  TaskLane *lane = user_data;
+  gint64 now = g_get_monotonic_time ();
+  gint64 latency = 0;
+
   g_mutex_lock (&task_pool_mutex);
-  g_thread_pool_set_max_threads (task_pool, tasks_running + 1, NULL);
-  g_trace_set_int64_counter (task_pool_max_counter, tasks_running + 1);
-  g_source_set_ready_time (task_pool_manager, -1);
+
+  if (g_thread_pool_unprocessed (lane->pool) > 0)
+    latency = MAX (lane->average_wait, now - lane->last_start_time);
+
+  if (latency >= (gint64) lane->wait_time)
+    {
+      g_thread_pool_set_max_threads (lane->pool, lane->running + 1, NULL);
+      g_trace_set_int64_counter (lane->max_counter, lane->running + 1);
+      g_source_set_ready_time (lane->manager, -1);
+    }
+  else if (latency > 0)
+    g_source_set_ready_time (lane->manager, now + lane->wait_time - latency);
+  else
+    g_source_set_ready_time (lane->manager, -1);
+
   g_mutex_unlock (&task_pool_mutex);
 
   return TRUE;
 }
 
 static void
-g_task_thread_setup (void)
+g_task_thread_setup (TaskLane *lane,
+                     GTask    *task)
 {
+  gint64 now;
+
   g_private_set (&task_private, GUINT_TO_POINTER (TRUE));
+
+  if (lane == NULL)
+    return;
+
+  now = g_get_monotonic_time ();
+
   g_mutex_lock (&task_pool_mutex);
-  tasks_running++;
+  lane->running++;
+  lane->last_start_time = now;
+  lane->average_wait += (now - task->queue_time - lane->average_wait) / 8;
 
-  g_trace_set_int64_counter (tasks_running_counter, tasks_running);
+  g_trace_set_int64_counter (lane->running_counter, lane->running);
+  g_trace_set_int64_counter (lane->depth_counter, g_thread_pool_unprocessed (lane->pool));
+  g_trace_set_int64_counter (lane->wait_counter, lane->average_wait);
 
-  if (tasks_running == G_TASK_POOL_SIZE)
-    task_wait_time = G_TASK_WAIT_TIME_BASE;
-  else if (tasks_running > G_TASK_POOL_SIZE && tasks_running < G_TASK_WAIT_TIME_MAX_POOL_SIZE)
-    task_wait_time *= G_TASK_WAIT_TIME_MULTIPLIER;
+  if (lane->running == lane->base_size)
+    lane->wait_time = G_TASK_WAIT_TIME_BASE;
+  else if (lane->running > lane->base_size && lane->running < G_TASK_WAIT_TIME_MAX_POOL_SIZE)
+    lane->wait_time *= G_TASK_WAIT_TIME_MULTIPLIER;
 
-  if (tasks_running >= G_TASK_POOL_SIZE)
-    g_source_set_ready_time (task_pool_manager, g_get_monotonic_time () + task_wait_time);
+  if (lane->running >= lane->base_size &&
+      g_source_get_ready_time (lane->manager) == -1)
+    g_source_set_ready_time (lane->manager, now + lane->wait_time);
 
   g_mutex_unlock (&task_pool_mutex);
 }
 
 static void
-g_task_thread_cleanup (void)
+g_task_thread_cleanup (TaskLane *lane)
 {
   gint tasks_pending;
 
+  if (lane == NULL)
+    {
+      g_private_set (&task_private, GUINT_TO_POINTER (FALSE));
+      return;
+    }
+
   g_mutex_lock (&task_pool_mutex);
-  tasks_pending = g_thread_pool_unprocessed (task_pool);
+  tasks_pending = g_thread_pool_unprocessed (lane->pool);
 
-  if (tasks_running > G_TASK_POOL_SIZE)
+  if (lane->running > lane->base_size)
     {
-      g_thread_pool_set_max_threads (task_pool, tasks_running - 1, NULL);
-      g_trace_set_int64_counter (task_pool_max_counter, tasks_running - 1);
+      g_thread_pool_set_max_threads (lane->pool, lane->running - 1, NULL);
+      g_trace_set_int64_counter (lane->max_counter, lane->running - 1);
     }
-  else if (tasks_running + tasks_pending < G_TASK_POOL_SIZE)
-    g_source_set_ready_time (task_pool_manager, -1);
+  else if (lane->running + tasks_pending < lane->base_size)
+    g_source_set_ready_time (lane->manager, -1);
 
-  if (tasks_running > G_TASK_POOL_SIZE && tasks_running < G_TASK_WAIT_TIME_MAX_POOL_SIZE)
-    task_wait_time /= G_TASK_WAIT_TIME_MULTIPLIER;
+  if (lane->running > lane->base_size && lane->running < G_TASK_WAIT_TIME_MAX_POOL_SIZE)
+    lane->wait_time /= G_TASK_WAIT_TIME_MULTIPLIER;
 
-  tasks_running--;
+  lane->running--;
 
-  g_trace_set_int64_counter (tasks_running_counter, tasks_running);
+  g_trace_set_int64_counter (lane->running_counter, lane->running);
+  g_trace_set_int64_counter (lane->depth_counter, tasks_pending);
 
   g_mutex_unlock (&task_pool_mutex);
   g_private_set (&task_private, GUINT_TO_POINTER (FALSE));
@@ -1577,15 +1777,16 @@ g_task_thread_pool_thread (gpointer thread_data,
                            gpointer pool_data)
 {
   GTask *task = thread_data;
+  TaskLane *lane = pool_data;
 
-  g_task_thread_setup ();
+  g_task_thread_setup (lane, task);
 
   task->task_func (task, task->source_object, task->task_data,
                    task->cancellable);
   g_task_thread_complete (task);
   g_object_unref (task);
 
-  g_task_thread_cleanup ();
+  g_task_thread_cleanup (lane);
 }
 
 static void
@@ -1597,7 +1798,7 @@ task_thread_cancelled (GCancellable *cancellable,
   /* Move this task to the front of the queue - no need for
    * a complete resorting of the queue.
    */
-  g_thread_pool_move_to_front (task_pool, task);
+  g_thread_pool_move_to_front (task->thread_pool, task);
 
   g_mutex_lock (&task->lock);
   task->thread_cancelled = TRUE;
@@ -1623,10 +1824,32 @@ task_thread_cancelled_disconnect_notify (gpointer  task,
   g_object_unref (task);
 }
 
+static void
+g_task_thread_pool_push (TaskLane *lane,
+                         GTask    *task)
+{
+  task->queue_time = g_get_monotonic_time ();
+  g_thread_pool_push (task->thread_pool, g_object_ref (task), NULL);
+
+  if (lane != NULL)
+    {
+      g_trace_set_int64_counter (lane->depth_counter,
+                                 g_thread_pool_unprocessed (lane->pool));
+    }
+}
+
 static void
 g_task_start_task_thread (GTask           *task,
                           GTaskThreadFunc  task_func)
 {
+  TaskLane *lane = NULL;
+
+  if (task->thread_pool == NULL)
+    {
+      lane = &task_lanes[task->cpu_bound ? TASK_LANE_CPU : TASK_LANE_BLOCKING];
+      task->thread_pool = lane->pool;
+    }
+
   g_mutex_init (&task->lock);
   g_cond_init (&task->cond);
 
@@ -1644,7 +1867,7 @@ g_task_start_task_thread (GTask           *task,
         {
           task->thread_cancelled = task->thread_complete = TRUE;
           TRACE (GIO_TASK_AFTER_RUN_IN_THREAD (task, task->thread_cancelled));
-          g_thread_pool_push (task_pool, g_object_ref (task), NULL);
+          g_task_thread_pool_push (lane, task);
           return;
         }
 
@@ -1665,7 +1888,7 @@ g_task_start_task_thread (GTask           *task,
 
   if (g_private_get (&task_private))
     task->blocking_other_task = TRUE;
-  g_thread_pool_push (task_pool, g_object_ref (task), NULL);
+  g_task_thread_pool_push (lane, task);
 }
 
 /**
@@ -1691,7 +1914,11 @@ g_task_start_task_thread (GTask           *task,
  * and enough of them (around 10) execute in a dependency chain, as that will
  * exhaust the thread pool. If this situation is possible, consider using a
  * separate worker thread or thread pool explicitly, rather than using
- * g_task_run_in_thread().
+ * g_task_run_in_thread(), or give the tasks their own pool with
+ * g_task_set_thread_pool().
+ *
+ * Tasks which compute rather than block on I/O should be marked with
+ * g_task_set_cpu_bound(), so they run in a pool of their own.
  *
  * Since: 2.36
  */
@@ -1764,11 +1991,124 @@ g_task_run_in_thread_sync (GTask           *task,
 
   /* Notify of completion in this thread. */
   task->completed = TRUE;
-  g_object_notify (G_OBJECT (task), "completed");
+  g_object_notify_by_pspec (G_OBJECT (task), task_props[PROP_COMPLETED]);
 
   g_object_unref (task);
 }
 
+/**
+ * g_task_set_cpu_bound:
+ * @task: a #GTask
+ * @cpu_bound: whether @task’s #GTaskThreadFunc mostly computes, rather than
+ *   waiting for I/O
+ *
+ * Sets whether @task is CPU-bound, which decides which thread pool
+ * g_task_run_in_thread() and g_task_run_in_thread_sync() run it in.
+ *
+ * By default, tasks are assumed to spend most of their time blocked on
+ * I/O, and run in a pool which grows when tasks wait too long for a
+ * thread. CPU-bound tasks run in a separate pool sized to the number of
+ * processors, so that they aren’t held up behind slow I/O, and don’t slow
+ * it down by running too many computations at once.
+ *
+ * This has no effect on tasks which have been given a pool with
+ * g_task_set_thread_pool(), and must be called before @task is run.
+ *
+ * Since: 2.82
+ */
+void
+g_task_set_cpu_bound (GTask    *task,
+                      gboolean  cpu_bound)
+{
+  g_return_if_fail (G_IS_TASK (task));
+  g_return_if_fail (task->task_func == NULL);
+
+  task->cpu_bound = !!cpu_bound;
+}
+
+/**
+ * g_task_get_cpu_bound:
+ * @task: a #GTask
+ *
+ * Gets whether @task is CPU-bound. See g_task_set_cpu_bound().
+ *
+ * Returns: %TRUE if @task is CPU-bound
+ *
+ * Since: 2.82
+ */
+gboolean
+g_task_get_cpu_bound (GTask *task)
+{
+  g_return_val_if_fail (G_IS_TASK (task), FALSE);
+
+  return task->cpu_bound ? TRUE : FALSE;
+}
+
+/**
+ * g_task_thread_pool_new:
+ * @max_threads: the maximal number of threads to execute concurrently in
+ *   the new thread pool, `-1` means no limit
+ * @exclusive: should this thread pool be exclusive?
+ * @error: return location for error, or %NULL
+ *
+ * Creates a #GThreadPool which runs tasks given to it with
+ * g_task_set_thread_pool(), for example to limit how many tasks of one
+ * kind run at once, or to keep them from competing with other tasks for
+ * GIO’s own pools. See g_thread_pool_new() for the meaning of the
+ * arguments.
+ *
+ * Tasks are taken from the pool’s queue by priority, as in GIO’s own
+ * pools. The pool doesn’t grow on its own; use
+ * g_thread_pool_set_max_threads() to change its size.
+ *
+ * Free the pool with g_thread_pool_free(), passing %FALSE for `immediate`
+ * so that tasks still queued are run rather than never returning.
+ *
+ * Returns: (transfer full): the new #GThreadPool, or %NULL if @exclusive
+ *   is %TRUE and starting its threads failed
+ *
+ * Since: 2.82
+ */
+GThreadPool *
+g_task_thread_pool_new (gint       max_threads,
+                        gboolean   exclusive,
+                        GError   **error)
+{
+  GThreadPool *pool;
+
+  pool = g_thread_pool_new (g_task_thread_pool_thread, NULL,
+                            max_threads, exclusive, error);
+  if (pool != NULL)
+    g_thread_pool_set_sort_function (pool, g_task_compare_priority, NULL);
+
+  return pool;
+}
+
+/**
+ * g_task_set_thread_pool:
+ * @task: a #GTask
+ * @pool: (nullable): a #GThreadPool created with g_task_thread_pool_new(),
+ *   or %NULL to use GIO’s own pools
+ *
+ * Sets the thread pool that g_task_run_in_thread() and
+ * g_task_run_in_thread_sync() run @task in. @pool must stay alive until
+ * @task has run.
+ *
+ * This must be called before @task is run.
+ *
+ * Since: 2.82
+ */
+void
+g_task_set_thread_pool (GTask       *task,
+                        GThreadPool *pool)
+{
+  g_return_if_fail (G_IS_TASK (task));
+  g_return_if_fail (task->task_func == NULL);
+  g_return_if_fail (pool == NULL || pool->func == g_task_thread_pool_thread);
+
+  task->thread_pool = pool;
+}
+
 /**
  * g_task_attach_source:
  * @task: a #GTask
@@ -2405,22 +2745,34 @@ GSourceFuncs trivial_source_funcs = {
   NULL  /* marshal */
 };
 
+static void
+task_lane_init (TaskLane   *lane,
+                gint        base_size,
+                const char *manager_name)
+{
+  lane->base_size = base_size;
+  lane->pool = g_thread_pool_new (g_task_thread_pool_thread, lane,
+                                  base_size, FALSE, NULL);
+  g_assert (lane->pool != NULL);
+
+  g_thread_pool_set_sort_function (lane->pool, g_task_compare_priority, NULL);
+
+  lane->manager = g_source_new (&trivial_source_funcs, sizeof (GSource));
+  g_source_set_static_name (lane->manager, manager_name);
+  g_source_set_callback (lane->manager, task_pool_manager_timeout, lane, NULL);
+  g_source_set_ready_time (lane->manager, -1);
+  g_source_attach (lane->manager,
+                   GLIB_PRIVATE_CALL (g_get_worker_context ()));
+  g_source_unref (lane->manager);
+}
+
 static void
 g_task_thread_pool_init (void)
 {
-  task_pool = g_thread_pool_new (g_task_thread_pool_thread, NULL,
-                                 G_TASK_POOL_SIZE, FALSE, NULL);
-  g_assert (task_pool != NULL);
-
-  g_thread_pool_set_sort_function (task_pool, g_task_compare_priority, NULL);
-
-  task_pool_manager = g_source_new (&trivial_source_funcs, sizeof (GSource));
-  g_source_set_static_name (task_pool_manager, "GTask thread pool manager");
-  g_source_set_callback (task_pool_manager, task_pool_manager_timeout, NULL, NULL);
-  g_source_set_ready_time (task_pool_manager, -1);
-  g_source_attach (task_pool_manager,
-                   GLIB_PRIVATE_CALL (g_get_worker_context ()));
-  g_source_unref (task_pool_manager);
+  task_lane_init (&task_lanes[TASK_LANE_BLOCKING], G_TASK_POOL_SIZE,
+                  "GTask thread pool manager");
+  task_lane_init (&task_lanes[TASK_LANE_CPU], MAX (g_get_num_processors (), 2),
+                  "GTask CPU thread pool manager");
 }
 
 static void
@@ -2474,18 +2826,32 @@ g_task_class_init (GTaskClass *klass)
    *
    * Since: 2.44
    */
-  g_object_class_install_property (gobject_class, PROP_COMPLETED,
+  task_props[PROP_COMPLETED] =
     g_param_spec_boolean ("completed", NULL, NULL,
-                          FALSE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+                          FALSE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
-  if (G_UNLIKELY (task_pool_max_counter == 0))
+  g_object_class_install_properties (gobject_class, G_N_ELEMENTS (task_props), task_props);
+
+  if (G_UNLIKELY (task_lanes[TASK_LANE_BLOCKING].max_counter == 0))
     {
-      /* We use two counters to track characteristics of the GTask thread pool.
+      TaskLane *blocking = &task_lanes[TASK_LANE_BLOCKING];
+      TaskLane *cpu = &task_lanes[TASK_LANE_CPU];
+
+      /* We use four counters to track characteristics of each GTask lane.
        * task pool max size - the value of g_thread_pool_set_max_threads()
        * tasks running - the number of running threads
+       * task queue depth - the number of tasks waiting for a thread
+       * task queue wait time - how long tasks have been waiting lately
        */
-      task_pool_max_counter = g_trace_define_int64_counter ("GIO", "task pool max size", "Maximum number of threads allowed in the GTask thread pool; see g_thread_pool_set_max_threads()");
-      tasks_running_counter = g_trace_define_int64_counter ("GIO", "tasks running", "Number of currently running tasks in the GTask thread pool");
+      blocking->max_counter = g_trace_define_int64_counter ("GIO", "task pool max size", "Maximum number of threads allowed in the GTask thread pool; see g_thread_pool_set_max_threads()");
+      blocking->running_counter = g_trace_define_int64_counter ("GIO", "tasks running", "Number of currently running tasks in the GTask thread pool");
+      blocking->depth_counter = g_trace_define_int64_counter ("GIO", "task queue depth", "Number of tasks waiting for a thread of the GTask thread pool");
+      blocking->wait_counter = g_trace_define_int64_counter ("GIO", "task queue wait time", "Average time, in microseconds, recent tasks waited for a thread of the GTask thread pool");
+
+      cpu->max_counter = g_trace_define_int64_counter ("GIO", "CPU task pool max size", "Maximum number of threads allowed in the GTask thread pool for CPU-bound tasks");
+      cpu->running_counter = g_trace_define_int64_counter ("GIO", "CPU tasks running", "Number of currently running tasks in the GTask thread pool for CPU-bound tasks");
+      cpu->depth_counter = g_trace_define_int64_counter ("GIO", "CPU task queue depth", "Number of tasks waiting for a thread of the GTask thread pool for CPU-bound tasks");
+      cpu->wait_counter = g_trace_define_int64_counter ("GIO", "CPU task queue wait time", "Average time, in microseconds, recent tasks waited for a thread of the GTask thread pool for CPU-bound tasks");
     }
 }
 
@@ -137,6 +137,18 @@ void          g_task_run_in_thread        (GTask           *task,
 GIO_AVAILABLE_IN_2_36
 void          g_task_run_in_thread_sync   (GTask           *task,
                                            GTaskThreadFunc  task_func);
+GIO_AVAILABLE_IN_2_82
+void          g_task_set_cpu_bound        (GTask           *task,
+                                           gboolean         cpu_bound);
+GIO_AVAILABLE_IN_2_82
+gboolean      g_task_get_cpu_bound        (GTask           *task);
+GIO_AVAILABLE_IN_2_82
+GThreadPool  *g_task_thread_pool_new      (gint             max_threads,
+                                           gboolean         exclusive,
+                                           GError         **error);
+GIO_AVAILABLE_IN_2_82
+void          g_task_set_thread_pool      (GTask           *task,
+                                           GThreadPool     *pool);
 GIO_AVAILABLE_IN_2_36
 gboolean      g_task_set_return_on_cancel (GTask           *task,
                                            gboolean         return_on_cancel);
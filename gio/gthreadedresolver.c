@@ -36,6 +36,7 @@
 #include "gcancellable.h"
 #include "ginetaddress.h"
 #include "ginetsocketaddress.h"
+#include "gnetworkmonitor.h"
 #include "gtask.h"
 #include "gsocketaddress.h"
 #include "gsrvtarget.h"
@@ -79,13 +80,52 @@
  * This is similar to what
  * [libasyncns](http://git.0pointer.net/libasyncns.git/tree/libasyncns/asyncns.h)
  * and other multi-threaded users of `getaddrinfo()` do.
+ *
+ * If #GResolver:cache-ttl is non-zero, the results of name and record lookups
+ * are cached in #GThreadedResolver.cache, keyed by the lookup parameters.
+ * Cache hits are returned without going to the thread pool. A lookup which
+ * finds an entry still being resolved by another worker waits for it rather
+ * than calling `getaddrinfo()` again, so bursts of lookups for the same name
+ * only cost one call. `getaddrinfo()` doesn’t give the DNS time to live of its
+ * results, so name lookups are cached for the whole #GResolver:cache-ttl;
+ * record lookups use the smallest time to live of the returned records, if
+ * that’s shorter.
  */
 
+/* A cached lookup result. Entries are added to the cache before the lookup is
+ * done, with @resolved set to %FALSE, so that concurrent lookups for the same
+ * key can wait for it on #GThreadedResolver.cache_cond. */
+typedef struct {
+  gatomicrefcount ref_count;
+
+  /* These must be accessed with GThreadedResolver.cache_lock held. */
+  gboolean resolved;
+  gint64 expiry_time;  /* monotonic time, in microseconds */
+  gboolean is_records;  /* whether @result is a list of #GVariants rather than #GInetAddresses */
+  GList *result;  /* (owned) (nullable) */
+  GError *error;  /* (owned) (nullable) */
+} CacheEntry;
+
+/* Avoid the cache growing without bound if the process looks up lots of
+ * different names */
+#define CACHE_MAX_ENTRIES 1024
+
+/* Rough size of one result (a #GInetAddress or a record #GVariant), for the
+ * estimate reported to g_mem_cache_register() */
+#define CACHE_RESULT_SIZE 64
+
 struct _GThreadedResolver
 {
   GResolver parent_instance;
 
   GThreadPool *thread_pool;  /* (owned) */
+
+  GMutex cache_lock;
+  GCond cache_cond;  /* signalled when an entry is resolved */
+  GHashTable *cache;  /* (owned) (element-type utf8 CacheEntry); protected by cache_lock */
+  GNetworkMonitor *network_monitor;  /* (owned) (nullable); protected by cache_lock */
+  gulong network_changed_id;  /* protected by cache_lock */
+  guint cache_id;  /* from g_mem_cache_register() */
 };
 
 G_DEFINE_TYPE (GThreadedResolver, g_threaded_resolver, G_TYPE_RESOLVER)
@@ -96,6 +136,10 @@ static void run_task_in_thread_pool_sync (GThreadedResolver *self,
                                           GTask             *task);
 static void threaded_resolver_worker_cb (gpointer task_data,
                                          gpointer user_data);
+static void cache_entry_unref (CacheEntry *entry);
+static gsize cache_trim (guint    level,
+                         gpointer user_data);
+static gsize cache_get_size (gpointer user_data);
 
 static void
 g_threaded_resolver_init (GThreadedResolver *self)
@@ -106,6 +150,14 @@ g_threaded_resolver_init (GThreadedResolver *self)
                                               20,
                                               FALSE,
                                               NULL);
+
+  g_mutex_init (&self->cache_lock);
+  g_cond_init (&self->cache_cond);
+  self->cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                       (GDestroyNotify) cache_entry_unref);
+  self->cache_id = g_mem_cache_register ("gio-resolver-cache",
+                                         G_MEMORY_MONITOR_WARNING_LEVEL_LOW,
+                                         cache_trim, cache_get_size, self);
 }
 
 static void
@@ -113,9 +165,18 @@ g_threaded_resolver_finalize (GObject *object)
 {
   GThreadedResolver *self = G_THREADED_RESOLVER (object);
 
+  g_mem_cache_unregister (self->cache_id);
+
   g_thread_pool_free (self->thread_pool, TRUE, FALSE);
   self->thread_pool = NULL;
 
+  if (self->network_monitor != NULL)
+    g_clear_signal_handler (&self->network_changed_id, self->network_monitor);
+  g_clear_object (&self->network_monitor);
+  g_clear_pointer (&self->cache, g_hash_table_unref);
+  g_cond_clear (&self->cache_cond);
+  g_mutex_clear (&self->cache_lock);
+
   G_OBJECT_CLASS (g_threaded_resolver_parent_class)->finalize (object);
 }
 
@@ -934,18 +995,22 @@ g_resolver_record_type_to_rrtype (GResolverRecordType type)
   g_return_val_if_reached (-1);
 }
 
-GList *
-g_resolver_records_from_res_query (const gchar      *rrname,
-                                   gint              rrtype,
-                                   const guint8     *answer,
-                                   gssize            len,
-                                   gint              herr,
-                                   GError          **error)
+/* On success, if @ttl_out is non-%NULL, it’s set to the smallest time to
+ * live of the returned records, in seconds. */
+static GList *
+records_from_res_query (const gchar      *rrname,
+                        gint              rrtype,
+                        const guint8     *answer,
+                        gssize            len,
+                        gint              herr,
+                        guint32          *ttl_out,
+                        GError          **error)
 {
   uint16_t count;
   gchar namebuf[1024];
   const guint8 *end, *p;
   guint16 type, qclass, rdlength;
+  guint32 ttl, min_ttl = G_MAXUINT32;
   const HEADER *header;
   GList *records;
   GVariant *record;
@@ -1037,7 +1102,7 @@ g_resolver_records_from_res_query (const gchar      *rrname,
       p += expand_result;
       GETSHORT (type, p);
       GETSHORT (qclass, p);
-      p += 4; /* ignore the ttl (type=long) value */
+      GETLONG (ttl, p);
       GETSHORT (rdlength, p);
 
       if (end - p < rdlength)
@@ -1079,7 +1144,10 @@ g_resolver_records_from_res_query (const gchar      *rrname,
         }
 
       if (record != NULL)
-        records = g_list_prepend (records, record);
+        {
+          records = g_list_prepend (records, record);
+          min_ttl = MIN (min_ttl, ttl);
+        }
 
       if (parsing_error != NULL)
         break;
@@ -1099,7 +1167,22 @@ g_resolver_records_from_res_query (const gchar      *rrname,
       return NULL;
     }
   else
-    return records;
+    {
+      if (ttl_out != NULL)
+        *ttl_out = min_ttl;
+      return records;
+    }
+}
+
+GList *
+g_resolver_records_from_res_query (const gchar      *rrname,
+                                   gint              rrtype,
+                                   const guint8     *answer,
+                                   gssize            len,
+                                   gint              herr,
+                                   GError          **error)
+{
+  return records_from_res_query (rrname, rrtype, answer, len, herr, NULL, error);
 }
 
 #elif defined(G_OS_WIN32)
@@ -1181,11 +1264,13 @@ g_resolver_records_from_DnsQuery (const gchar  *rrname,
                                   WORD          dnstype,
                                   DNS_STATUS    status,
                                   DNS_RECORDA  *results,
+                                  guint32      *ttl_out,
                                   GError      **error)
 {
   DNS_RECORDA *rec;
   gpointer record;
   GList *records;
+  guint32 min_ttl = G_MAXUINT32;
 
   if (status != ERROR_SUCCESS)
     {
@@ -1236,7 +1321,10 @@ g_resolver_records_from_DnsQuery (const gchar  *rrname,
           break;
         }
       if (record != NULL)
-        records = g_list_prepend (records, g_variant_ref_sink (record));
+        {
+          records = g_list_prepend (records, g_variant_ref_sink (record));
+          min_ttl = MIN (min_ttl, rec->dwTtl);
+        }
     }
 
   if (records == NULL)
@@ -1247,7 +1335,10 @@ g_resolver_records_from_DnsQuery (const gchar  *rrname,
       return NULL;
     }
   else
-    return records;
+    {
+      *ttl_out = min_ttl;
+      return records;
+    }
 }
 
 #endif
@@ -1267,9 +1358,12 @@ int res_query(const char *, int, int, u_char *, int);
 #endif
 #endif
 
+/* On success, @ttl_out is set to the time to live of the returned records, in
+ * seconds */
 static GList *
 do_lookup_records (const gchar          *rrname,
                    GResolverRecordType   record_type,
+                   guint32              *ttl_out,
                    GCancellable         *cancellable,
                    GError              **error)
 {
@@ -1325,7 +1419,7 @@ do_lookup_records (const gchar          *rrname,
     }
 
   herr = h_errno;
-  records = g_resolver_records_from_res_query (rrname, rrtype, answer->data, len, herr, error);
+  records = records_from_res_query (rrname, rrtype, answer->data, len, herr, ttl_out, error);
   g_byte_array_free (answer, TRUE);
 
 #ifdef HAVE_RES_NQUERY
@@ -1355,7 +1449,7 @@ do_lookup_records (const gchar          *rrname,
 
   dnstype = g_resolver_record_type_to_dnstype (record_type);
   status = DnsQuery_UTF8 (rrname, dnstype, DNS_QUERY_STANDARD, NULL, (PDNS_RECORD_UTF8_*)&results, NULL);
-  records = g_resolver_records_from_DnsQuery (rrname, dnstype, status, results, error);
+  records = g_resolver_records_from_DnsQuery (rrname, dnstype, status, results, ttl_out, error);
   if (results != NULL)
     DnsRecordListFree (results, DnsFreeRecordList);
 
@@ -1425,6 +1519,361 @@ lookup_records_finish (GResolver     *resolver,
   return g_task_propagate_pointer (G_TASK (result), error);
 }
 
+static CacheEntry *
+cache_entry_new (gboolean is_records)
+{
+  CacheEntry *entry = g_new0 (CacheEntry, 1);
+  g_atomic_ref_count_init (&entry->ref_count);
+  entry->is_records = is_records;
+  return g_steal_pointer (&entry);
+}
+
+static CacheEntry *
+cache_entry_ref (CacheEntry *entry)
+{
+  g_atomic_ref_count_inc (&entry->ref_count);
+  return entry;
+}
+
+static void
+cache_entry_unref (CacheEntry *entry)
+{
+  if (!g_atomic_ref_count_dec (&entry->ref_count))
+    return;
+
+  if (entry->is_records)
+    g_clear_pointer (&entry->result, free_records);
+  else
+    g_clear_pointer (&entry->result, g_resolver_free_addresses);
+  g_clear_error (&entry->error);
+  g_free (entry);
+}
+
+static GList *
+copy_result (GList    *result,
+             gboolean  is_records)
+{
+  if (is_records)
+    return g_list_copy_deep (result, (GCopyFunc) g_variant_ref, NULL);
+  else
+    return g_list_copy_deep (result, (GCopyFunc) g_object_ref, NULL);
+}
+
+/* Must be called with GThreadedResolver.cache_lock held, on a resolved entry.
+ * Each caller gets its own copy, as GResolver modifies the returned lists. */
+static GList *
+cache_entry_copy_result (CacheEntry  *entry,
+                         GError     **error)
+{
+  g_assert (entry->resolved);
+
+  if (entry->error != NULL)
+    {
+      g_propagate_error (error, g_error_copy (entry->error));
+      return NULL;
+    }
+
+  return copy_result (entry->result, entry->is_records);
+}
+
+/* Returns the key to cache the result of @data under, or %NULL if it’s not
+ * to be cached. */
+static char *
+cache_key_for_lookup (GThreadedResolver *self,
+                      LookupData        *data)
+{
+  char *name, *key;
+
+  if (g_resolver_get_cache_ttl (G_RESOLVER (self)) == 0)
+    return NULL;
+
+  switch (data->lookup_type) {
+  case LOOKUP_BY_NAME:
+    name = g_ascii_strdown (data->lookup_by_name.hostname, -1);
+    key = g_strdup_printf ("name:%d:%s", data->lookup_by_name.address_family, name);
+    break;
+  case LOOKUP_RECORDS:
+    name = g_ascii_strdown (data->lookup_records.rrname, -1);
+    key = g_strdup_printf ("records:%d:%s", data->lookup_records.record_type, name);
+    break;
+  case LOOKUP_BY_ADDRESS:
+    return NULL;
+  default:
+    g_assert_not_reached ();
+  }
+
+  g_free (name);
+
+  return g_steal_pointer (&key);
+}
+
+static gboolean
+cache_entry_is_expired_cb (gpointer key,
+                           gpointer value,
+                           gpointer user_data)
+{
+  CacheEntry *entry = value;
+  const gint64 *now = user_data;
+
+  return entry->resolved && *now >= entry->expiry_time;
+}
+
+static gboolean
+cache_entry_is_resolved_cb (gpointer key,
+                            gpointer value,
+                            gpointer user_data)
+{
+  CacheEntry *entry = value;
+
+  return entry->resolved;
+}
+
+/* Must be called with GThreadedResolver.cache_lock held */
+static void
+cache_make_room_unlocked (GThreadedResolver *self,
+                          gint64             now)
+{
+  if (g_hash_table_size (self->cache) < CACHE_MAX_ENTRIES)
+    return;
+
+  g_hash_table_foreach_remove (self->cache, cache_entry_is_expired_cb, &now);
+
+  /* If it’s still full, start again rather than tracking which entries were
+   * least recently used. Entries which are still being resolved are kept for
+   * the lookups waiting on them. */
+  if (g_hash_table_size (self->cache) >= CACHE_MAX_ENTRIES)
+    g_hash_table_foreach_remove (self->cache, cache_entry_is_resolved_cb, NULL);
+}
+
+static void
+cache_clear (GThreadedResolver *self)
+{
+  g_mutex_lock (&self->cache_lock);
+  g_hash_table_remove_all (self->cache);
+  g_mutex_unlock (&self->cache_lock);
+}
+
+/* Must be called with GThreadedResolver.cache_lock held */
+static gsize
+cache_get_size_unlocked (GThreadedResolver *self)
+{
+  GHashTableIter iter;
+  gpointer key, value;
+  gsize size = 0;
+
+  g_hash_table_iter_init (&iter, self->cache);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+      CacheEntry *entry = value;
+
+      size += sizeof (CacheEntry) + strlen (key) + 1;
+      size += g_list_length (entry->result) * (sizeof (GList) + CACHE_RESULT_SIZE);
+    }
+
+  return size;
+}
+
+static gsize
+cache_get_size (gpointer user_data)
+{
+  GThreadedResolver *self = user_data;
+  gsize size;
+
+  g_mutex_lock (&self->cache_lock);
+  size = cache_get_size_unlocked (self);
+  g_mutex_unlock (&self->cache_lock);
+
+  return size;
+}
+
+/* Lookups still in progress are dropped too; their waiters hold their own
+ * references, as when the network changes */
+static gsize
+cache_trim (guint    level,
+            gpointer user_data)
+{
+  GThreadedResolver *self = user_data;
+  gsize freed;
+
+  g_mutex_lock (&self->cache_lock);
+  freed = cache_get_size_unlocked (self);
+  g_hash_table_remove_all (self->cache);
+  g_mutex_unlock (&self->cache_lock);
+
+  return freed;
+}
+
+static void
+network_changed_cb (GNetworkMonitor *monitor,
+                    gboolean         network_available,
+                    gpointer         user_data)
+{
+  GThreadedResolver *self = G_THREADED_RESOLVER (user_data);
+
+  /* Names may resolve differently on the new network, for example if it has
+   * a split-horizon DNS server */
+  cache_clear (self);
+}
+
+static void
+cache_watch_network (GThreadedResolver *self)
+{
+  g_mutex_lock (&self->cache_lock);
+
+  if (self->network_monitor == NULL)
+    {
+      self->network_monitor = g_object_ref (g_network_monitor_get_default ());
+      self->network_changed_id = g_signal_connect (self->network_monitor, "network-changed",
+                                                   G_CALLBACK (network_changed_cb), self);
+    }
+
+  g_mutex_unlock (&self->cache_lock);
+}
+
+/* Called from the thread which started the lookup, so that cache hits don’t
+ * have to go through the thread pool. Returns %TRUE and sets @result_out or
+ * @error on a hit. */
+static gboolean
+cache_lookup (GThreadedResolver  *self,
+              LookupData         *data,
+              GList             **result_out,
+              GError            **error)
+{
+  char *key;
+  CacheEntry *entry;
+  gboolean hit = FALSE;
+
+  key = cache_key_for_lookup (self, data);
+  if (key == NULL)
+    return FALSE;
+
+  g_mutex_lock (&self->cache_lock);
+
+  entry = g_hash_table_lookup (self->cache, key);
+  if (entry != NULL && entry->resolved && g_get_monotonic_time () < entry->expiry_time)
+    {
+      *result_out = cache_entry_copy_result (entry, error);
+      hit = TRUE;
+    }
+
+  g_mutex_unlock (&self->cache_lock);
+
+  g_free (key);
+
+  return hit;
+}
+
+/* @ttl_out is left unchanged if the lookup doesn’t give a time to live */
+static GList *
+do_lookup_uncached (LookupData    *data,
+                    guint32       *ttl_out,
+                    GCancellable  *cancellable,
+                    GError       **error)
+{
+  switch (data->lookup_type) {
+  case LOOKUP_BY_NAME:
+    return do_lookup_by_name (data->lookup_by_name.hostname,
+                              data->lookup_by_name.address_family,
+                              cancellable,
+                              error);
+  case LOOKUP_RECORDS:
+    return do_lookup_records (data->lookup_records.rrname,
+                              data->lookup_records.record_type,
+                              ttl_out,
+                              cancellable,
+                              error);
+  case LOOKUP_BY_ADDRESS:
+  default:
+    g_assert_not_reached ();
+  }
+}
+
+/* Called in a thread pool thread to do a name or records lookup, using and
+ * filling the cache if it’s enabled. */
+static GList *
+do_lookup_cached (GThreadedResolver  *self,
+                  LookupData         *data,
+                  GCancellable       *cancellable,
+                  GError            **error)
+{
+  char *key;
+  CacheEntry *entry;
+  GList *result;
+  GError *local_error = NULL;
+  guint32 ttl = G_MAXUINT32;  /* unknown */
+  gint64 now;
+
+  key = cache_key_for_lookup (self, data);
+  if (key == NULL)
+    return do_lookup_uncached (data, &ttl, cancellable, error);
+
+  g_mutex_lock (&self->cache_lock);
+
+  now = g_get_monotonic_time ();
+  entry = g_hash_table_lookup (self->cache, key);
+  if (entry != NULL && (!entry->resolved || now < entry->expiry_time))
+    {
+      /* Another worker is doing this lookup already, or finished it after this
+       * task was queued. Share its result. */
+      cache_entry_ref (entry);
+      while (!entry->resolved)
+        g_cond_wait (&self->cache_cond, &self->cache_lock);
+      result = cache_entry_copy_result (entry, error);
+      g_mutex_unlock (&self->cache_lock);
+
+      cache_entry_unref (entry);
+      g_free (key);
+
+      return result;
+    }
+
+  cache_make_room_unlocked (self, now);
+  entry = cache_entry_new (data->lookup_type == LOOKUP_RECORDS);
+  g_hash_table_replace (self->cache, g_strdup (key), cache_entry_ref (entry));
+
+  g_mutex_unlock (&self->cache_lock);
+
+  result = do_lookup_uncached (data, &ttl, cancellable, &local_error);
+
+  g_mutex_lock (&self->cache_lock);
+
+  entry->resolved = TRUE;
+  entry->result = copy_result (result, entry->is_records);
+  entry->error = (local_error != NULL) ? g_error_copy (local_error) : NULL;
+
+  /* The entry may have been dropped by cache_clear() in the meantime, in
+   * which case it’s only used by the lookups already waiting on it */
+  if (g_hash_table_lookup (self->cache, key) == entry)
+    {
+      ttl = MIN (ttl, g_resolver_get_cache_ttl (G_RESOLVER (self)));
+
+      /* Temporary failures are not cached, so the next lookup tries again */
+      if (ttl > 0 &&
+          (result != NULL ||
+           g_error_matches (local_error, G_RESOLVER_ERROR, G_RESOLVER_ERROR_NOT_FOUND)))
+        entry->expiry_time = g_get_monotonic_time () + (gint64) ttl * G_USEC_PER_SEC;
+      else
+        g_hash_table_remove (self->cache, key);
+    }
+
+  g_cond_broadcast (&self->cache_cond);
+  g_mutex_unlock (&self->cache_lock);
+
+  cache_entry_unref (entry);
+  g_free (key);
+
+  if (local_error != NULL)
+    g_propagate_error (error, g_steal_pointer (&local_error));
+
+  return result;
+}
+
+static void
+threaded_resolver_reload (GResolver *resolver)
+{
+  cache_clear (G_THREADED_RESOLVER (resolver));
+}
+
 /* Will be called in the GLib worker thread, so must lock all accesses to shared
  * data. */
 static gboolean
@@ -1518,6 +1967,29 @@ run_task_in_thread_pool_async (GThreadedResolver *self,
   LookupData *data = g_task_get_task_data (task);
   guint timeout_ms = g_resolver_get_timeout (G_RESOLVER (self));
   GCancellable *cancellable = g_task_get_cancellable (task);
+  GList *result = NULL;
+  GError *local_error = NULL;
+
+  if (g_resolver_get_cache_ttl (G_RESOLVER (self)) != 0)
+    {
+      cache_watch_network (self);
+
+      if (cache_lookup (self, data, &result, &local_error))
+        {
+          /* Nothing else can have seen the task yet, so this needs no locking */
+          data->will_return = COMPLETED;
+          data->has_returned = TRUE;
+
+          if (result != NULL && data->lookup_type == LOOKUP_RECORDS)
+            g_task_return_pointer (task, g_steal_pointer (&result), (GDestroyNotify) free_records);
+          else if (result != NULL)
+            g_task_return_pointer (task, g_steal_pointer (&result), (GDestroyNotify) g_resolver_free_addresses);
+          else
+            g_task_return_error (task, g_steal_pointer (&local_error));
+
+          return;
+        }
+    }
 
   g_mutex_lock (&data->lock);
 
@@ -1566,6 +2038,7 @@ static void
 threaded_resolver_worker_cb (gpointer task_data,
                              gpointer user_data)
 {
+  GThreadedResolver *self = G_THREADED_RESOLVER (user_data);
   GTask *task = G_TASK (g_steal_pointer (&task_data));
   LookupData *data = g_task_get_task_data (task);
   GCancellable *cancellable = g_task_get_cancellable (task);
@@ -1575,10 +2048,7 @@ threaded_resolver_worker_cb (gpointer task_data,
   switch (data->lookup_type) {
   case LOOKUP_BY_NAME:
     {
-      GList *addresses = do_lookup_by_name (data->lookup_by_name.hostname,
-                                            data->lookup_by_name.address_family,
-                                            cancellable,
-                                            &local_error);
+      GList *addresses = do_lookup_cached (self, data, cancellable, &local_error);
 
       g_mutex_lock (&data->lock);
       should_return = g_atomic_int_compare_and_exchange (&data->will_return, NOT_YET, COMPLETED);
@@ -1620,10 +2090,7 @@ threaded_resolver_worker_cb (gpointer task_data,
     break;
   case LOOKUP_RECORDS:
     {
-      GList *records = do_lookup_records (data->lookup_records.rrname,
-                                          data->lookup_records.record_type,
-                                          cancellable,
-                                          &local_error);
+      GList *records = do_lookup_cached (self, data, cancellable, &local_error);
 
       g_mutex_lock (&data->lock);
       should_return = g_atomic_int_compare_and_exchange (&data->will_return, NOT_YET, COMPLETED);
@@ -1662,6 +2129,7 @@ g_threaded_resolver_class_init (GThreadedResolverClass *threaded_class)
 
   object_class->finalize = g_threaded_resolver_finalize;
 
+  resolver_class->reload                           = threaded_resolver_reload;
   resolver_class->lookup_by_name                   = lookup_by_name;
   resolver_class->lookup_by_name_async             = lookup_by_name_async;
   resolver_class->lookup_by_name_finish            = lookup_by_name_finish;
@@ -42,6 +42,21 @@
  * [signal@Gio.ThreadedSocketService::run], or subclass and override the default
  * handler.
  *
+ * Since GLib 2.82, a service created with
+ * [ctor@Gio.ThreadedSocketService.new_with_io_threads] (or with
+ * [property@Gio.ThreadedSocketService:io-threads] set) uses an event loop
+ * per thread instead of a thread per connection. It starts a fixed number
+ * of I/O threads, each iterating its own [struct@GLib.MainContext], and
+ * hands incoming connections to them in turn. The
+ * [signal@Gio.ThreadedSocketService::run] signal is then emitted in the
+ * I/O thread, with its context as the
+ * [thread-default main context](main-loop.html#thread-default-contexts), and
+ * must not block: the handler should start asynchronous operations on the
+ * connection and return. All callbacks of those operations are dispatched in
+ * the same I/O thread, so the per-connection state needs no locking. This
+ * scales to many more concurrent connections than the thread pool, and the
+ * service is never stopped because of the number of connections.
+ *
  * Since: 2.22
  */
 
@@ -51,11 +66,24 @@
 #include "glibintl.h"
 #include "gmarshal-internal.h"
 
+typedef struct
+{
+  GMainContext *context;  /* (owned) */
+  GMainLoop *loop;  /* (owned) */
+  GThread *thread;  /* (owned) */
+} GThreadedSocketServiceIOThread;
+
 struct _GThreadedSocketServicePrivate
 {
   GThreadPool *thread_pool;
   int max_threads;
   gint job_count;
+
+  /* Only used in event loop mode, when io_threads != 0 */
+  int io_threads;
+  GThreadedSocketServiceIOThread *io_thread_array;  /* (owned) (array length=n_io_threads) */
+  guint n_io_threads;
+  gint next_io_thread;  /* (atomic) */
 };
 
 static guint g_threaded_socket_service_run_signal;
@@ -67,6 +95,7 @@ G_DEFINE_TYPE_WITH_PRIVATE (GThreadedSocketService,
 typedef enum
 {
   PROP_MAX_THREADS = 1,
+  PROP_IO_THREADS,
 } GThreadedSocketServiceProperty;
 
 G_LOCK_DEFINE_STATIC(job_count);
@@ -105,6 +134,130 @@ g_threaded_socket_service_func (gpointer job_data,
   g_threaded_socket_service_data_free (data);
 }
 
+static gboolean
+g_threaded_socket_service_io_thread_dispatch (gpointer user_data)
+{
+  GThreadedSocketServiceData *data = user_data;
+  gboolean result;
+
+  g_signal_emit (data->service, g_threaded_socket_service_run_signal,
+                 0, data->connection, data->source_object, &result);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gpointer
+g_threaded_socket_service_io_thread_func (gpointer user_data)
+{
+  GThreadedSocketServiceIOThread *io_thread = user_data;
+  GMainContext *context = g_main_context_ref (io_thread->context);
+  GMainLoop *loop = g_main_loop_ref (io_thread->loop);
+
+  /* @io_thread must not be used after this point: it’s freed without
+   * waiting for this thread if the service is finalized from it. */
+  g_main_context_push_thread_default (context);
+  g_main_loop_run (loop);
+  g_main_context_pop_thread_default (context);
+
+  g_main_loop_unref (loop);
+  g_main_context_unref (context);
+
+  return NULL;
+}
+
+static gboolean
+g_threaded_socket_service_io_thread_quit (gpointer user_data)
+{
+  g_main_loop_quit (user_data);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+g_threaded_socket_service_start_io_threads (GThreadedSocketService *service)
+{
+  GThreadedSocketServicePrivate *priv = service->priv;
+  guint i;
+
+  priv->n_io_threads = (priv->io_threads < 0) ? g_get_num_processors () : (guint) priv->io_threads;
+  priv->io_thread_array = g_new0 (GThreadedSocketServiceIOThread, priv->n_io_threads);
+
+  for (i = 0; i < priv->n_io_threads; i++)
+    {
+      GThreadedSocketServiceIOThread *io_thread = &priv->io_thread_array[i];
+      char name[16];
+
+      g_snprintf (name, sizeof (name), "gio-io-%u", i);
+
+      io_thread->context = g_main_context_new ();
+      io_thread->loop = g_main_loop_new (io_thread->context, FALSE);
+      io_thread->thread = g_thread_new (name, g_threaded_socket_service_io_thread_func, io_thread);
+    }
+}
+
+static void
+g_threaded_socket_service_stop_io_threads (GThreadedSocketService *service)
+{
+  GThreadedSocketServicePrivate *priv = service->priv;
+  guint i;
+
+  /* Quit the loops from inside, as g_main_loop_quit() is lost if the loop
+   * hasn’t started running yet. */
+  for (i = 0; i < priv->n_io_threads; i++)
+    {
+      GThreadedSocketServiceIOThread *io_thread = &priv->io_thread_array[i];
+      GSource *source;
+
+      source = g_idle_source_new ();
+      g_source_set_callback (source, g_threaded_socket_service_io_thread_quit,
+                             g_main_loop_ref (io_thread->loop),
+                             (GDestroyNotify) g_main_loop_unref);
+      g_source_set_static_name (source, "[gio] g_threaded_socket_service_io_thread_quit");
+      g_source_attach (source, io_thread->context);
+      g_source_unref (source);
+    }
+
+  for (i = 0; i < priv->n_io_threads; i++)
+    {
+      GThreadedSocketServiceIOThread *io_thread = &priv->io_thread_array[i];
+
+      /* The last reference may be dropped by a handler running in one of
+       * the I/O threads, which can’t join itself. It exits once the handler
+       * returns and the quit source is dispatched. */
+      if (io_thread->thread == g_thread_self ())
+        g_thread_unref (io_thread->thread);
+      else
+        g_thread_join (io_thread->thread);
+
+      g_main_loop_unref (io_thread->loop);
+      g_main_context_unref (io_thread->context);
+    }
+
+  g_clear_pointer (&priv->io_thread_array, g_free);
+  priv->n_io_threads = 0;
+}
+
+static void
+g_threaded_socket_service_dispatch_to_io_thread (GThreadedSocketService     *service,
+                                                 GThreadedSocketServiceData *data)
+{
+  GThreadedSocketServicePrivate *priv = service->priv;
+  GThreadedSocketServiceIOThread *io_thread;
+  GSource *source;
+
+  /* Connections may be accepted in several contexts if the service has
+   * sharded sockets */
+  io_thread = &priv->io_thread_array[(guint) g_atomic_int_add (&priv->next_io_thread, 1) % priv->n_io_threads];
+
+  source = g_idle_source_new ();
+  g_source_set_priority (source, G_PRIORITY_DEFAULT);
+  g_source_set_callback (source, g_threaded_socket_service_io_thread_dispatch,
+                         data, (GDestroyNotify) g_threaded_socket_service_data_free);
+  g_source_set_static_name (source, "[gio] g_threaded_socket_service_io_thread_dispatch");
+  g_source_attach (source, io_thread->context);
+  g_source_unref (source);
+}
+
 static gboolean
 g_threaded_socket_service_incoming (GSocketService    *service,
                                     GSocketConnection *connection,
@@ -121,6 +274,12 @@ g_threaded_socket_service_incoming (GSocketService    *service,
   data->connection = g_object_ref (connection);
   data->source_object = (source_object != NULL) ? g_object_ref (source_object) : NULL;
 
+  if (threaded->priv->n_io_threads > 0)
+    {
+      g_threaded_socket_service_dispatch_to_io_thread (threaded, data);
+      return FALSE;
+    }
+
   G_LOCK (job_count);
   if (++threaded->priv->job_count == threaded->priv->max_threads)
     g_socket_service_stop (service);
@@ -149,6 +308,12 @@ g_threaded_socket_service_constructed (GObject *object)
 {
   GThreadedSocketService *service = G_THREADED_SOCKET_SERVICE (object);
 
+  if (service->priv->io_threads != 0)
+    {
+      g_threaded_socket_service_start_io_threads (service);
+      return;
+    }
+
   service->priv->thread_pool =
     g_thread_pool_new  (g_threaded_socket_service_func,
 			NULL,
@@ -164,8 +329,11 @@ g_threaded_socket_service_finalize (GObject *object)
   GThreadedSocketService *service = G_THREADED_SOCKET_SERVICE (object);
 
   /* All jobs in the pool hold a reference to this #GThreadedSocketService, so
-   * this should only be called once the pool is empty: */
-  g_thread_pool_free (service->priv->thread_pool, FALSE, FALSE);
+   * this should only be called once the pool is empty. The same goes for
+   * the connections waiting to be dispatched to an I/O thread. */
+  if (service->priv->thread_pool != NULL)
+    g_thread_pool_free (service->priv->thread_pool, FALSE, FALSE);
+  g_threaded_socket_service_stop_io_threads (service);
 
   G_OBJECT_CLASS (g_threaded_socket_service_parent_class)
     ->finalize (object);
@@ -185,6 +353,10 @@ g_threaded_socket_service_get_property (GObject    *object,
 	g_value_set_int (value, service->priv->max_threads);
 	break;
 
+      case PROP_IO_THREADS:
+	g_value_set_int (value, service->priv->io_threads);
+	break;
+
       default:
 	G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -204,6 +376,10 @@ g_threaded_socket_service_set_property (GObject      *object,
 	service->priv->max_threads = g_value_get_int (value);
 	break;
 
+      case PROP_IO_THREADS:
+	service->priv->io_threads = g_value_get_int (value);
+	break;
+
       default:
 	G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -234,6 +410,11 @@ g_threaded_socket_service_class_init (GThreadedSocketServiceClass *class)
    * @connection and may perform blocking IO. The signal handler need
    * not return until the connection is closed.
    *
+   * If [property@Gio.ThreadedSocketService:io-threads] is non-zero, the
+   * signal is instead emitted in one of the I/O threads, with its main
+   * context pushed as the thread-default. The handler must not block, and
+   * should handle @connection with asynchronous operations.
+   *
    * Returns: %TRUE to stop further signal handlers from being called
    */
   g_threaded_socket_service_run_signal =
@@ -281,3 +462,27 @@ g_threaded_socket_service_new (int max_threads)
 		       "max-threads", max_threads,
 		       NULL);
 }
+
+/**
+ * g_threaded_socket_service_new_with_io_threads:
+ * @n_io_threads: the number of I/O threads, or -1 for one per processor
+ *
+ * Creates a new #GThreadedSocketService with no listeners, which handles
+ * connections with an event loop per thread rather than a thread per
+ * connection. See [property@Gio.ThreadedSocketService:io-threads].
+ *
+ * Listeners must be added with one of the #GSocketListener "add" methods.
+ *
+ * Returns: a new #GSocketService.
+ *
+ * Since: 2.82
+ */
+GSocketService *
+g_threaded_socket_service_new_with_io_threads (int n_io_threads)
+{
+  g_return_val_if_fail (n_io_threads != 0 && n_io_threads >= -1, NULL);
+
+  return g_object_new (G_TYPE_THREADED_SOCKET_SERVICE,
+		       "io-threads", n_io_threads,
+		       NULL);
+}
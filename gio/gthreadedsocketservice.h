@@ -77,6 +77,8 @@ GIO_AVAILABLE_IN_ALL
 GType                   g_threaded_socket_service_get_type              (void);
 GIO_AVAILABLE_IN_ALL
 GSocketService *        g_threaded_socket_service_new                   (int max_threads);
+GIO_AVAILABLE_IN_2_82
+GSocketService *        g_threaded_socket_service_new_with_io_threads   (int n_io_threads);
 
 G_END_DECLS
 
@@ -32,6 +32,16 @@
 #include "gtlsinteraction.h"
 #include "glibintl.h"
 #include "gmarshal-internal.h"
+#include "gioprivate.h"
+#include "gtcpconnection.h"
+
+#ifdef HAVE_LINUX_TLS_H
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <linux/tls.h>
+#endif
 
 /**
  * GTlsConnection:
@@ -47,7 +57,15 @@
  * Since: 2.28
  */
 
-G_DEFINE_ABSTRACT_TYPE (GTlsConnection, g_tls_connection, G_TYPE_IO_STREAM)
+struct _GTlsConnectionPrivate
+{
+  GMutex lock;
+  gboolean allow_kernel_offload;
+  GTlsKernelOffloadFlags kernel_offload;
+  GSocket *kernel_offload_socket;  /* (owned) (nullable) */
+};
+
+G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (GTlsConnection, g_tls_connection, G_TYPE_IO_STREAM)
 
 static void g_tls_connection_get_property (GObject    *object,
 					   guint       prop_id,
@@ -83,6 +101,17 @@ enum {
   PROP_CIPHERSUITE_NAME,
 };
 
+static void
+g_tls_connection_finalize (GObject *object)
+{
+  GTlsConnection *conn = G_TLS_CONNECTION (object);
+
+  g_clear_object (&conn->priv->kernel_offload_socket);
+  g_mutex_clear (&conn->priv->lock);
+
+  G_OBJECT_CLASS (g_tls_connection_parent_class)->finalize (object);
+}
+
 static void
 g_tls_connection_class_init (GTlsConnectionClass *klass)
 {
@@ -90,6 +119,7 @@ g_tls_connection_class_init (GTlsConnectionClass *klass)
 
   gobject_class->get_property = g_tls_connection_get_property;
   gobject_class->set_property = g_tls_connection_set_property;
+  gobject_class->finalize = g_tls_connection_finalize;
 
   /**
    * GTlsConnection:base-io-stream:
@@ -382,6 +412,8 @@ g_tls_connection_class_init (GTlsConnectionClass *klass)
 static void
 g_tls_connection_init (GTlsConnection *conn)
 {
+  conn->priv = g_tls_connection_get_instance_private (conn);
+  g_mutex_init (&conn->priv->lock);
 }
 
 static void
@@ -1091,6 +1123,117 @@ g_tls_connection_get_ciphersuite_name (GTlsConnection *conn)
   return g_steal_pointer (&ciphersuite_name);
 }
 
+/**
+ * g_tls_connection_set_allow_kernel_offload:
+ * @conn: a #GTlsConnection
+ * @allow_kernel_offload: whether the backend may hand record encryption to
+ *   the kernel
+ *
+ * Sets whether the TLS backend may hand the keys negotiated by the
+ * handshake to the operating system kernel, so that the kernel encrypts and
+ * decrypts records on the underlying socket. This is only supported on
+ * Linux with the `tls` kernel module, for connections over a TCP
+ * #GSocketConnection, and only by backends which call
+ * g_tls_connection_offload_to_kernel(). Whether it happened can be checked
+ * with g_tls_connection_get_kernel_offload() after the handshake.
+ *
+ * Once sending is offloaded, g_output_stream_splice() from a file to the
+ * connection’s output stream sends the file with `sendfile()`, without
+ * copying it through userspace. This has to be set before the handshake.
+ *
+ * Since: 2.82
+ */
+void
+g_tls_connection_set_allow_kernel_offload (GTlsConnection *conn,
+                                           gboolean        allow_kernel_offload)
+{
+  g_return_if_fail (G_IS_TLS_CONNECTION (conn));
+
+  g_mutex_lock (&conn->priv->lock);
+  conn->priv->allow_kernel_offload = !!allow_kernel_offload;
+  g_mutex_unlock (&conn->priv->lock);
+}
+
+/**
+ * g_tls_connection_get_allow_kernel_offload:
+ * @conn: a #GTlsConnection
+ *
+ * Gets whether @conn allows handing record encryption to the kernel. See
+ * g_tls_connection_set_allow_kernel_offload().
+ *
+ * Returns: %TRUE if kernel offload is allowed
+ *
+ * Since: 2.82
+ */
+gboolean
+g_tls_connection_get_allow_kernel_offload (GTlsConnection *conn)
+{
+  gboolean allow_kernel_offload;
+
+  g_return_val_if_fail (G_IS_TLS_CONNECTION (conn), FALSE);
+
+  g_mutex_lock (&conn->priv->lock);
+  allow_kernel_offload = conn->priv->allow_kernel_offload;
+  g_mutex_unlock (&conn->priv->lock);
+
+  return allow_kernel_offload;
+}
+
+/**
+ * g_tls_connection_get_kernel_offload:
+ * @conn: a #GTlsConnection
+ *
+ * Gets the directions of @conn whose records are encrypted or decrypted by
+ * the kernel. For those directions, data can be written to or read from
+ * the socket returned by g_tls_connection_get_kernel_offload_socket()
+ * directly, as long as nothing else is reading or writing @conn at the
+ * same time.
+ *
+ * Returns: the offloaded directions
+ *
+ * Since: 2.82
+ */
+GTlsKernelOffloadFlags
+g_tls_connection_get_kernel_offload (GTlsConnection *conn)
+{
+  GTlsKernelOffloadFlags kernel_offload;
+
+  g_return_val_if_fail (G_IS_TLS_CONNECTION (conn), G_TLS_KERNEL_OFFLOAD_NONE);
+
+  g_mutex_lock (&conn->priv->lock);
+  kernel_offload = conn->priv->kernel_offload;
+  g_mutex_unlock (&conn->priv->lock);
+
+  return kernel_offload;
+}
+
+/**
+ * g_tls_connection_get_kernel_offload_socket:
+ * @conn: a #GTlsConnection
+ *
+ * Gets the socket which encrypts or decrypts records of @conn in the
+ * kernel, if g_tls_connection_get_kernel_offload() returns anything but
+ * %G_TLS_KERNEL_OFFLOAD_NONE.
+ *
+ * Returns: (transfer none) (nullable): the socket, or %NULL
+ *
+ * Since: 2.82
+ */
+GSocket *
+g_tls_connection_get_kernel_offload_socket (GTlsConnection *conn)
+{
+  GSocket *socket;
+
+  g_return_val_if_fail (G_IS_TLS_CONNECTION (conn), NULL);
+
+  /* Never changes once set */
+  g_mutex_lock (&conn->priv->lock);
+  socket = conn->priv->kernel_offload_socket;
+  g_mutex_unlock (&conn->priv->lock);
+
+  return socket;
+}
+
 /**
  * g_tls_error_quark:
  *
@@ -1127,3 +1270,132 @@ g_tls_connection_emit_accept_certificate (GTlsConnection       *conn,
 		 peer_cert, errors, &accept);
   return accept;
 }
+
+/**
+ * g_tls_connection_offload_to_kernel:
+ * @conn: a #GTlsConnection
+ * @direction: either %G_TLS_KERNEL_OFFLOAD_SEND or
+ *   %G_TLS_KERNEL_OFFLOAD_RECEIVE
+ * @crypto_info: (array length=crypto_info_size) (element-type guint8): the
+ *   keys and sequence number for @direction, as a Linux
+ *   `struct tls12_crypto_info_*`
+ * @crypto_info_size: the size of @crypto_info
+ * @error: return location for a #GError, or %NULL
+ *
+ * Used by #GTlsConnection implementations to hand record encryption in
+ * @direction to the kernel, if g_tls_connection_get_allow_kernel_offload()
+ * returns %TRUE. This sets up the `tls` upper layer protocol on the socket
+ * of the #GTlsConnection:base-io-stream and passes @crypto_info to it.
+ *
+ * The implementation must have flushed everything it buffered for
+ * @direction first. Afterwards it has to write or read plaintext on the
+ * socket for @direction, and send any other record types, such as alerts,
+ * with a `TLS_SET_RECORD_TYPE` control message.
+ *
+ * Returns: %TRUE on success. If kernel offload isn’t allowed or supported,
+ *   %FALSE with %G_IO_ERROR_NOT_SUPPORTED, in which case the implementation
+ *   should keep encrypting records itself.
+ *
+ * Since: 2.82
+ */
+gboolean
+g_tls_connection_offload_to_kernel (GTlsConnection          *conn,
+                                    GTlsKernelOffloadFlags   direction,
+                                    gconstpointer            crypto_info,
+                                    gsize                    crypto_info_size,
+                                    GError                 **error)
+{
+#ifdef HAVE_LINUX_TLS_H
+  GIOStream *base_io_stream = NULL;
+  GSocket *socket;
+  int fd;
+#endif
+
+  g_return_val_if_fail (G_IS_TLS_CONNECTION (conn), FALSE);
+  g_return_val_if_fail (direction == G_TLS_KERNEL_OFFLOAD_SEND ||
+                        direction == G_TLS_KERNEL_OFFLOAD_RECEIVE, FALSE);
+  g_return_val_if_fail (crypto_info != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  if (!g_tls_connection_get_allow_kernel_offload (conn))
+    {
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                           _("Kernel TLS offload is not allowed on this connection"));
+      return FALSE;
+    }
+
+#ifdef HAVE_LINUX_TLS_H
+  g_return_val_if_fail ((g_tls_connection_get_kernel_offload (conn) & direction) == 0, FALSE);
+
+  g_object_get (conn, "base-io-stream", &base_io_stream, NULL);
+  if (!G_IS_TCP_CONNECTION (base_io_stream))
+    {
+      g_clear_object (&base_io_stream);
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                           _("Kernel TLS offload needs a TCP connection"));
+      return FALSE;
+    }
+
+  socket = g_socket_connection_get_socket (G_SOCKET_CONNECTION (base_io_stream));
+  fd = g_socket_get_fd (socket);
+
+  /* Set up the upper layer protocol for the first direction only */
+  if (g_tls_connection_get_kernel_offload (conn) == G_TLS_KERNEL_OFFLOAD_NONE &&
+      setsockopt (fd, IPPROTO_TCP, TCP_ULP, "tls", sizeof ("tls")) < 0 &&
+      errno != EEXIST)
+    {
+      int errsv = errno;
+
+      g_clear_object (&base_io_stream);
+
+      /* ENOENT if the module isn’t available */
+      if (errsv == ENOENT || errsv == ENOPROTOOPT || errsv == EOPNOTSUPP)
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                     _("Kernel TLS offload is not supported: %s"), g_strerror (errsv));
+      else
+        g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+                     _("Could not set up kernel TLS offload: %s"), g_strerror (errsv));
+      return FALSE;
+    }
+
+  if (setsockopt (fd, SOL_TLS, direction == G_TLS_KERNEL_OFFLOAD_SEND ? TLS_TX : TLS_RX,
+                  crypto_info, crypto_info_size) < 0)
+    {
+      int errsv = errno;
+
+      g_clear_object (&base_io_stream);
+
+      /* The cipher isn’t supported by the kernel */
+      if (errsv == EINVAL || errsv == ENOPROTOOPT || errsv == EOPNOTSUPP)
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                     _("Kernel TLS offload is not supported: %s"), g_strerror (errsv));
+      else
+        g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+                     _("Could not set up kernel TLS offload: %s"), g_strerror (errsv));
+      return FALSE;
+    }
+
+  g_mutex_lock (&conn->priv->lock);
+  conn->priv->kernel_offload |= direction;
+  if (conn->priv->kernel_offload_socket == NULL)
+    conn->priv->kernel_offload_socket = g_object_ref (socket);
+  g_mutex_unlock (&conn->priv->lock);
+
+  /* Let g_output_stream_splice() move data straight to and from the
+   * socket, which encrypts and decrypts it in the kernel */
+  if (direction == G_TLS_KERNEL_OFFLOAD_SEND)
+    g_output_stream_set_splice_socket (g_io_stream_get_output_stream (G_IO_STREAM (conn)),
+                                       socket);
+  else
+    g_input_stream_set_splice_socket (g_io_stream_get_input_stream (G_IO_STREAM (conn)),
+                                      socket);
+
+  g_clear_object (&base_io_stream);
+
+  return TRUE;
+#else
+  g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                       _("Kernel TLS offload is not supported on this platform"));
+  return FALSE;
+#endif
+}
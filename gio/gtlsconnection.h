@@ -179,6 +179,16 @@ GTlsProtocolVersion   g_tls_connection_get_protocol_version        (GTlsConnecti
 GIO_AVAILABLE_IN_2_70
 gchar *               g_tls_connection_get_ciphersuite_name        (GTlsConnection       *conn);
 
+GIO_AVAILABLE_IN_2_82
+void                  g_tls_connection_set_allow_kernel_offload    (GTlsConnection       *conn,
+                                                                    gboolean              allow_kernel_offload);
+GIO_AVAILABLE_IN_2_82
+gboolean              g_tls_connection_get_allow_kernel_offload    (GTlsConnection       *conn);
+GIO_AVAILABLE_IN_2_82
+GTlsKernelOffloadFlags g_tls_connection_get_kernel_offload         (GTlsConnection       *conn);
+GIO_AVAILABLE_IN_2_82
+GSocket              *g_tls_connection_get_kernel_offload_socket   (GTlsConnection       *conn);
+
 /**
  * G_TLS_ERROR:
  *
@@ -208,6 +218,12 @@ GIO_AVAILABLE_IN_ALL
 gboolean              g_tls_connection_emit_accept_certificate     (GTlsConnection       *conn,
 								    GTlsCertificate      *peer_cert,
 								    GTlsCertificateFlags  errors);
+GIO_AVAILABLE_IN_2_82
+gboolean              g_tls_connection_offload_to_kernel           (GTlsConnection         *conn,
+                                                                    GTlsKernelOffloadFlags  direction,
+                                                                    gconstpointer           crypto_info,
+                                                                    gsize                   crypto_info_size,
+                                                                    GError                **error);
 
 G_END_DECLS
 
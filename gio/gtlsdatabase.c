@@ -30,8 +30,11 @@
 #include "gsocketconnectable.h"
 #include "gtask.h"
 #include "gtlscertificate.h"
+#include "gtlsfiledatabase.h"
 #include "gtlsinteraction.h"
 
+#include <string.h>
+
 /**
  * GTlsDatabase:
  *
@@ -42,6 +45,10 @@
  * A `GTlsDatabase` may be accessed from multiple threads by the TLS backend.
  * All implementations are required to be fully thread-safe.
  *
+ * Successful verifications can be remembered across connections by
+ * enabling the verification cache with
+ * [method@Gio.TlsDatabase.set_verify_cache_size].
+ *
  * Most common client applications will not directly interact with
  * `GTlsDatabase`. It is used internally by [class@Gio.TlsConnection].
  *
@@ -84,7 +91,35 @@
  * Since: 2.30
  */
 
-G_DEFINE_ABSTRACT_TYPE (GTlsDatabase, g_tls_database, G_TYPE_OBJECT)
+/* Successful results are never trusted for longer than this, so that
+ * revocation information the backend consults is picked up eventually.
+ */
+#define VERIFY_CACHE_MAX_AGE_USEC G_TIME_SPAN_HOUR
+
+/* Chains longer than this are not cached (and are most likely bogus). */
+#define VERIFY_CACHE_MAX_CHAIN_LENGTH 16
+
+typedef struct
+{
+  gchar  *key;      /* hex SHA-256 of the chain and verification parameters */
+  gint64  expires;  /* real time, in microseconds */
+  GList   link;     /* in verify_cache_lru */
+} VerifyCacheEntry;
+
+/* An entry and its key, as reported to g_mem_cache_register() */
+#define VERIFY_CACHE_ENTRY_SIZE (sizeof (VerifyCacheEntry) + 2 * 32 + 1)
+
+struct _GTlsDatabasePrivate
+{
+  GMutex      verify_cache_lock;
+  GHashTable *verify_cache;      /* (owned) (nullable) key → VerifyCacheEntry */
+  GQueue      verify_cache_lru;  /* most recently used first */
+  guint       verify_cache_size; /* (atomic) maximum number of entries */
+  guint       verify_cache_id;   /* from g_mem_cache_register() */
+  gulong      anchors_notify_id;
+};
+
+G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (GTlsDatabase, g_tls_database, G_TYPE_OBJECT)
 
 enum {
   UNLOCK_REQUIRED,
@@ -107,9 +142,210 @@ enum {
  */
 
 static void
-g_tls_database_init (GTlsDatabase *cert)
+verify_cache_entry_free (gpointer data)
+{
+  VerifyCacheEntry *entry = data;
+
+  g_free (entry->key);
+  g_free (entry);
+}
+
+/* Computes the cache key for a verification, and the time until which
+ * a successful result may be reused.  Returns %NULL if the chain can't
+ * be cached.
+ */
+static gchar *
+verify_cache_key (GTlsCertificate         *chain,
+                  const gchar             *purpose,
+                  GSocketConnectable      *identity,
+                  GTlsDatabaseVerifyFlags  flags,
+                  gint64                  *expires)
+{
+  GChecksum *checksum;
+  GTlsCertificate *cert;
+  gchar *identity_str;
+  guint32 flags32 = flags;
+  guint length = 0;
+  gchar *key;
+
+  checksum = g_checksum_new (G_CHECKSUM_SHA256);
+  *expires = g_get_real_time () + VERIFY_CACHE_MAX_AGE_USEC;
+
+  for (cert = chain; cert != NULL; cert = g_tls_certificate_get_issuer (cert))
+    {
+      GByteArray *der = NULL;
+      GDateTime *not_valid_after;
+      guint32 der_len;
+
+      g_object_get (cert, "certificate", &der, NULL);
+      if (der == NULL || ++length > VERIFY_CACHE_MAX_CHAIN_LENGTH)
+        {
+          g_clear_pointer (&der, g_byte_array_unref);
+          g_checksum_free (checksum);
+          return NULL;
+        }
+
+      der_len = der->len;
+      g_checksum_update (checksum, (const guchar *) &der_len, sizeof (der_len));
+      g_checksum_update (checksum, der->data, der->len);
+      g_byte_array_unref (der);
+
+      not_valid_after = g_tls_certificate_get_not_valid_after (cert);
+      if (not_valid_after != NULL)
+        {
+          *expires = MIN (*expires, g_date_time_to_unix_usec (not_valid_after));
+          g_date_time_unref (not_valid_after);
+        }
+    }
+
+  identity_str = identity != NULL ? g_socket_connectable_to_string (identity) : g_strdup ("");
+
+  /* Include the terminating nuls so the fields can't run into each other */
+  g_checksum_update (checksum, (const guchar *) purpose, strlen (purpose) + 1);
+  g_checksum_update (checksum, (const guchar *) identity_str, strlen (identity_str) + 1);
+  g_checksum_update (checksum, (const guchar *) &flags32, sizeof (flags32));
+
+  key = g_strdup (g_checksum_get_string (checksum));
+
+  g_free (identity_str);
+  g_checksum_free (checksum);
+
+  return key;
+}
+
+static gboolean
+verify_cache_lookup (GTlsDatabase *self,
+                     const gchar  *key)
+{
+  GTlsDatabasePrivate *priv = g_tls_database_get_instance_private (self);
+  VerifyCacheEntry *entry;
+  gboolean found = FALSE;
+
+  g_mutex_lock (&priv->verify_cache_lock);
+
+  entry = priv->verify_cache != NULL ? g_hash_table_lookup (priv->verify_cache, key) : NULL;
+  if (entry != NULL)
+    {
+      g_queue_unlink (&priv->verify_cache_lru, &entry->link);
+
+      if (entry->expires > g_get_real_time ())
+        {
+          g_queue_push_head_link (&priv->verify_cache_lru, &entry->link);
+          found = TRUE;
+        }
+      else
+        g_hash_table_remove (priv->verify_cache, key);
+    }
+
+  g_mutex_unlock (&priv->verify_cache_lock);
+
+  return found;
+}
+
+static void
+verify_cache_insert (GTlsDatabase *self,
+                     const gchar  *key,
+                     gint64        expires)
+{
+  GTlsDatabasePrivate *priv = g_tls_database_get_instance_private (self);
+  VerifyCacheEntry *entry;
+  guint max_entries;
+
+  if (expires <= g_get_real_time ())
+    return;
+
+  g_mutex_lock (&priv->verify_cache_lock);
+
+  max_entries = g_atomic_int_get (&priv->verify_cache_size);
+  if (priv->verify_cache == NULL || max_entries == 0)
+    {
+      g_mutex_unlock (&priv->verify_cache_lock);
+      return;
+    }
+
+  entry = g_hash_table_lookup (priv->verify_cache, key);
+  if (entry != NULL)
+    {
+      g_queue_unlink (&priv->verify_cache_lru, &entry->link);
+    }
+  else
+    {
+      entry = g_new0 (VerifyCacheEntry, 1);
+      entry->key = g_strdup (key);
+      entry->link.data = entry;
+      g_hash_table_insert (priv->verify_cache, entry->key, entry);
+    }
+
+  entry->expires = expires;
+  g_queue_push_head_link (&priv->verify_cache_lru, &entry->link);
+
+  while (priv->verify_cache_lru.length > max_entries)
+    {
+      GList *oldest = g_queue_pop_tail_link (&priv->verify_cache_lru);
+      VerifyCacheEntry *old_entry = oldest->data;
+
+      g_hash_table_remove (priv->verify_cache, old_entry->key);
+    }
+
+  g_mutex_unlock (&priv->verify_cache_lock);
+}
+
+static gsize
+verify_cache_trim (guint    level,
+                   gpointer user_data)
+{
+  GTlsDatabasePrivate *priv = user_data;
+  gsize freed = 0;
+
+  g_mutex_lock (&priv->verify_cache_lock);
+
+  if (priv->verify_cache != NULL)
+    {
+      freed = g_hash_table_size (priv->verify_cache) * VERIFY_CACHE_ENTRY_SIZE;
+      g_hash_table_remove_all (priv->verify_cache);
+    }
+  g_queue_init (&priv->verify_cache_lru);
+
+  g_mutex_unlock (&priv->verify_cache_lock);
+
+  return freed;
+}
+
+static gsize
+verify_cache_get_size (gpointer user_data)
+{
+  GTlsDatabasePrivate *priv = user_data;
+  gsize size = 0;
+
+  g_mutex_lock (&priv->verify_cache_lock);
+  if (priv->verify_cache != NULL)
+    size = g_hash_table_size (priv->verify_cache) * VERIFY_CACHE_ENTRY_SIZE;
+  g_mutex_unlock (&priv->verify_cache_lock);
+
+  return size;
+}
+
+static void
+g_tls_database_finalize (GObject *object)
 {
+  GTlsDatabase *self = G_TLS_DATABASE (object);
+  GTlsDatabasePrivate *priv = g_tls_database_get_instance_private (self);
+
+  if (priv->verify_cache_id != 0)
+    g_mem_cache_unregister (priv->verify_cache_id);
+  g_clear_pointer (&priv->verify_cache, g_hash_table_unref);
+  g_mutex_clear (&priv->verify_cache_lock);
 
+  G_OBJECT_CLASS (g_tls_database_parent_class)->finalize (object);
+}
+
+static void
+g_tls_database_init (GTlsDatabase *self)
+{
+  GTlsDatabasePrivate *priv = g_tls_database_get_instance_private (self);
+
+  g_mutex_init (&priv->verify_cache_lock);
+  g_queue_init (&priv->verify_cache_lru);
 }
 
 typedef struct _AsyncVerifyChain {
@@ -433,6 +669,10 @@ g_tls_database_real_lookup_certificates_issued_by_finish (GTlsDatabase
 static void
 g_tls_database_class_init (GTlsDatabaseClass *klass)
 {
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->finalize = g_tls_database_finalize;
+
   klass->verify_chain_async = g_tls_database_real_verify_chain_async;
   klass->verify_chain_finish = g_tls_database_real_verify_chain_finish;
   klass->lookup_certificate_for_handle_async = g_tls_database_real_lookup_certificate_for_handle_async;
@@ -512,6 +752,12 @@ g_tls_database_class_init (GTlsDatabaseClass *klass)
  * to the chain. This may involve HTTP requests to download missing
  * certificates.
  *
+ * If the verification cache is enabled with
+ * g_tls_database_set_verify_cache_size(), a successful result for the
+ * same chain, @purpose, @identity and @flags is reused without asking
+ * the backend again until a certificate in the chain expires, the
+ * database is invalidated or an hour has passed.
+ *
  * This function can block. Use g_tls_database_verify_chain_async() to
  * perform the verification operation asynchronously.
  *
@@ -530,6 +776,12 @@ g_tls_database_verify_chain (GTlsDatabase           *self,
                              GCancellable           *cancellable,
                              GError                **error)
 {
+  GTlsDatabasePrivate *priv;
+  GTlsCertificateFlags result;
+  GError *local_error = NULL;
+  gchar *key = NULL;
+  gint64 expires = 0;
+
   g_return_val_if_fail (G_IS_TLS_DATABASE (self), G_TLS_CERTIFICATE_GENERIC_ERROR);
   g_return_val_if_fail (G_IS_TLS_CERTIFICATE (chain),
                         G_TLS_CERTIFICATE_GENERIC_ERROR);
@@ -543,14 +795,77 @@ g_tls_database_verify_chain (GTlsDatabase           *self,
   g_return_val_if_fail (G_TLS_DATABASE_GET_CLASS (self)->verify_chain,
                         G_TLS_CERTIFICATE_GENERIC_ERROR);
 
-  return G_TLS_DATABASE_GET_CLASS (self)->verify_chain (self,
-                                                        chain,
-                                                        purpose,
-                                                        identity,
-                                                        interaction,
-                                                        flags,
-                                                        cancellable,
-                                                        error);
+  priv = g_tls_database_get_instance_private (self);
+  if (g_atomic_int_get (&priv->verify_cache_size) > 0)
+    {
+      key = verify_cache_key (chain, purpose, identity, flags, &expires);
+      if (key != NULL && verify_cache_lookup (self, key))
+        {
+          g_free (key);
+          return 0;
+        }
+    }
+
+  result = G_TLS_DATABASE_GET_CLASS (self)->verify_chain (self,
+                                                          chain,
+                                                          purpose,
+                                                          identity,
+                                                          interaction,
+                                                          flags,
+                                                          cancellable,
+                                                          &local_error);
+
+  if (key != NULL && result == 0 && local_error == NULL)
+    verify_cache_insert (self, key, expires);
+
+  g_free (key);
+
+  if (local_error != NULL)
+    g_propagate_error (error, local_error);
+
+  return result;
+}
+
+typedef struct
+{
+  gchar  *key;
+  gint64  expires;
+} VerifyChainCacheData;
+
+static void
+verify_chain_cache_data_free (gpointer data)
+{
+  VerifyChainCacheData *cache_data = data;
+
+  g_free (cache_data->key);
+  g_free (cache_data);
+}
+
+static void
+verify_chain_cached_cb (GObject      *source,
+                        GAsyncResult *result,
+                        gpointer      user_data)
+{
+  GTlsDatabase *self = G_TLS_DATABASE (source);
+  GTask *task = user_data;
+  VerifyChainCacheData *cache_data = g_task_get_task_data (task);
+  GTlsCertificateFlags verify_result;
+  GError *error = NULL;
+
+  verify_result = G_TLS_DATABASE_GET_CLASS (self)->verify_chain_finish (self, result, &error);
+
+  if (error != NULL)
+    {
+      g_task_return_error (task, error);
+    }
+  else
+    {
+      if (verify_result == 0)
+        verify_cache_insert (self, cache_data->key, cache_data->expires);
+      g_task_return_int (task, (gssize) verify_result);
+    }
+
+  g_object_unref (task);
 }
 
 /**
@@ -582,6 +897,8 @@ g_tls_database_verify_chain_async (GTlsDatabase           *self,
                                    GAsyncReadyCallback     callback,
                                    gpointer                user_data)
 {
+  GTlsDatabasePrivate *priv;
+
   g_return_if_fail (G_IS_TLS_DATABASE (self));
   g_return_if_fail (G_IS_TLS_CERTIFICATE (chain));
   g_return_if_fail (purpose != NULL);
@@ -591,6 +908,47 @@ g_tls_database_verify_chain_async (GTlsDatabase           *self,
   g_return_if_fail (callback != NULL);
 
   g_return_if_fail (G_TLS_DATABASE_GET_CLASS (self)->verify_chain_async);
+
+  priv = g_tls_database_get_instance_private (self);
+  if (g_atomic_int_get (&priv->verify_cache_size) > 0)
+    {
+      VerifyChainCacheData *cache_data;
+      GTask *task;
+      gint64 expires;
+      gchar *key;
+
+      key = verify_cache_key (chain, purpose, identity, flags, &expires);
+      if (key != NULL)
+        {
+          task = g_task_new (self, cancellable, callback, user_data);
+          g_task_set_source_tag (task, g_tls_database_verify_chain_async);
+
+          if (verify_cache_lookup (self, key))
+            {
+              g_free (key);
+              g_task_return_int (task, 0);
+              g_object_unref (task);
+              return;
+            }
+
+          cache_data = g_new0 (VerifyChainCacheData, 1);
+          cache_data->key = g_steal_pointer (&key);
+          cache_data->expires = expires;
+          g_task_set_task_data (task, cache_data, verify_chain_cache_data_free);
+
+          G_TLS_DATABASE_GET_CLASS (self)->verify_chain_async (self,
+                                                               chain,
+                                                               purpose,
+                                                               identity,
+                                                               interaction,
+                                                               flags,
+                                                               cancellable,
+                                                               verify_chain_cached_cb,
+                                                               task);
+          return;
+        }
+    }
+
   G_TLS_DATABASE_GET_CLASS (self)->verify_chain_async (self,
                                                        chain,
                                                        purpose,
@@ -635,11 +993,141 @@ g_tls_database_verify_chain_finish (GTlsDatabase          *self,
   g_return_val_if_fail (error == NULL || *error == NULL, G_TLS_CERTIFICATE_GENERIC_ERROR);
   g_return_val_if_fail (G_TLS_DATABASE_GET_CLASS (self)->verify_chain_finish,
                         G_TLS_CERTIFICATE_GENERIC_ERROR);
+
+  if (g_async_result_is_tagged (result, g_tls_database_verify_chain_async))
+    {
+      GTlsCertificateFlags verify_result;
+      GError *local_error = NULL;
+
+      verify_result = g_task_propagate_int (G_TASK (result), &local_error);
+      if (local_error != NULL)
+        {
+          g_propagate_error (error, local_error);
+          return G_TLS_CERTIFICATE_GENERIC_ERROR;
+        }
+
+      return verify_result;
+    }
+
   return G_TLS_DATABASE_GET_CLASS (self)->verify_chain_finish (self,
                                                                result,
                                                                error);
 }
 
+static void
+anchors_notify_cb (GObject    *object,
+                   GParamSpec *pspec,
+                   gpointer    user_data)
+{
+  g_tls_database_invalidate_verify_cache (G_TLS_DATABASE (object));
+}
+
+/**
+ * g_tls_database_set_verify_cache_size:
+ * @self: a #GTlsDatabase
+ * @max_entries: the maximum number of verification results to keep,
+ *   or 0 to disable the cache
+ *
+ * Enables or disables the verification cache of @self.
+ *
+ * While the cache is enabled, g_tls_database_verify_chain() and
+ * g_tls_database_verify_chain_async() remember chains which were
+ * verified successfully, keyed by the certificates in the chain, the
+ * purpose, the identity and the verify flags. Verifying the same chain
+ * again returns the remembered result without calling into the TLS
+ * backend. This is useful for programs which open many connections to
+ * the same peers.
+ *
+ * Failed verifications are never cached. A cached result expires
+ * when the first certificate in the chain stops being valid, or after
+ * an hour. After that the backend is asked again, so that it can apply
+ * any revocation checks it does. The least recently used entries are
+ * dropped when there are more than @max_entries.
+ *
+ * The cache is cleared when the #GTlsFileDatabase:anchors of @self
+ * change. If the trust information of @self changes in another way,
+ * call g_tls_database_invalidate_verify_cache().
+ *
+ * The cache is emptied when #GMemoryMonitor reports that memory is
+ * moderately low; see g_mem_cache_register().
+ *
+ * The cache is disabled by default.
+ *
+ * Since: 2.82
+ */
+void
+g_tls_database_set_verify_cache_size (GTlsDatabase *self,
+                                      guint         max_entries)
+{
+  GTlsDatabasePrivate *priv;
+
+  g_return_if_fail (G_IS_TLS_DATABASE (self));
+
+  priv = g_tls_database_get_instance_private (self);
+
+  g_mutex_lock (&priv->verify_cache_lock);
+
+  if (max_entries > 0 && priv->verify_cache == NULL)
+    {
+      priv->verify_cache = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, verify_cache_entry_free);
+
+      /* Verifying chains again is relatively expensive, so the cache is
+       * only dropped once memory is moderately low */
+      priv->verify_cache_id = g_mem_cache_register ("gio-tls-verify-cache",
+                                                    G_MEMORY_MONITOR_WARNING_LEVEL_MEDIUM,
+                                                    verify_cache_trim,
+                                                    verify_cache_get_size,
+                                                    priv);
+    }
+
+  g_atomic_int_set (&priv->verify_cache_size, max_entries);
+
+  while (priv->verify_cache_lru.length > max_entries)
+    {
+      GList *oldest = g_queue_pop_tail_link (&priv->verify_cache_lru);
+      VerifyCacheEntry *entry = oldest->data;
+
+      g_hash_table_remove (priv->verify_cache, entry->key);
+    }
+
+  g_mutex_unlock (&priv->verify_cache_lock);
+
+  if (max_entries > 0 && priv->anchors_notify_id == 0 && G_IS_TLS_FILE_DATABASE (self))
+    priv->anchors_notify_id = g_signal_connect (self, "notify::anchors",
+                                                G_CALLBACK (anchors_notify_cb), NULL);
+}
+
+/**
+ * g_tls_database_invalidate_verify_cache:
+ * @self: a #GTlsDatabase
+ *
+ * Drops all verification results cached by @self.
+ *
+ * TLS backends and applications should call this when the trust
+ * information in @self changes, for example when anchors are added or
+ * removed, so that chains are verified against the new information.
+ * See g_tls_database_set_verify_cache_size().
+ *
+ * Since: 2.82
+ */
+void
+g_tls_database_invalidate_verify_cache (GTlsDatabase *self)
+{
+  GTlsDatabasePrivate *priv;
+
+  g_return_if_fail (G_IS_TLS_DATABASE (self));
+
+  priv = g_tls_database_get_instance_private (self);
+
+  g_mutex_lock (&priv->verify_cache_lock);
+
+  if (priv->verify_cache != NULL)
+    g_hash_table_remove_all (priv->verify_cache);
+  g_queue_init (&priv->verify_cache_lru);
+
+  g_mutex_unlock (&priv->verify_cache_lock);
+}
+
 /**
  * g_tls_database_create_certificate_handle:
  * @self: a #GTlsDatabase
@@ -244,6 +244,12 @@ GList*               g_tls_database_lookup_certificates_issued_by_finish   (GTls
                                                                             GAsyncResult            *result,
                                                                             GError                 **error);
 
+GIO_AVAILABLE_IN_2_82
+void                 g_tls_database_set_verify_cache_size                 (GTlsDatabase            *self,
+                                                                           guint                    max_entries);
+GIO_AVAILABLE_IN_2_82
+void                 g_tls_database_invalidate_verify_cache               (GTlsDatabase            *self);
+
 G_END_DECLS
 
 #endif /* __G_TLS_DATABASE_H__ */
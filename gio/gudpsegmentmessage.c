@@ -0,0 +1,324 @@
+/* GIO - GLib Input, Output and Streaming Library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * GUdpSegmentMessage:
+ *
+ * This [class@Gio.SocketControlMessage] carries the segment size for UDP
+ * segmentation offload.
+ *
+ * Sending one large buffer with a `GUdpSegmentMessage` attached, using
+ * [method@Gio.Socket.send_message] or [method@Gio.Socket.send_messages],
+ * has the kernel split it into datagrams of
+ * [property@Gio.UdpSegmentMessage:segment-size] bytes each (the last one may
+ * be shorter). This costs a single trip through the network stack instead of
+ * one per datagram. All the datagrams go to the same destination.
+ *
+ * In the other direction, once enabled with
+ * [func@Gio.UdpSegmentMessage.enable_gro], the kernel may coalesce
+ * consecutive datagrams of the same size from the same sender into one
+ * buffer returned by [method@Gio.Socket.receive_message] or
+ * [method@Gio.Socket.receive_messages]. A `GUdpSegmentMessage` is then
+ * returned among the control messages, giving the size of the original
+ * datagrams, so the receive buffer must be split accordingly. Receive
+ * buffers should be 64 KiB to make the most of this.
+ *
+ * Both are only supported on Linux; see
+ * [func@Gio.UdpSegmentMessage.is_supported].
+ *
+ * Since: 2.82
+ */
+
+#include "config.h"
+
+#include <string.h>
+
+#include "gudpsegmentmessage.h"
+#include "gioerror.h"
+#include "gnetworkingprivate.h"
+#include "gsocket.h"
+
+#ifndef G_OS_WIN32
+#include <netinet/udp.h>
+#endif
+
+#include "glibintl.h"
+
+#if defined (UDP_SEGMENT) && defined (UDP_GRO)
+#define G_UDP_SEGMENT_MESSAGE_SUPPORTED 1
+#else
+#define G_UDP_SEGMENT_MESSAGE_SUPPORTED 0
+#endif
+
+struct _GUdpSegmentMessagePrivate
+{
+  guint16 segment_size;
+};
+
+enum
+{
+  PROP_SEGMENT_SIZE = 1,
+};
+
+G_DEFINE_TYPE_WITH_PRIVATE (GUdpSegmentMessage, g_udp_segment_message, G_TYPE_SOCKET_CONTROL_MESSAGE)
+
+static gsize
+g_udp_segment_message_get_size (GSocketControlMessage *message)
+{
+#if G_UDP_SEGMENT_MESSAGE_SUPPORTED
+  return sizeof (guint16);
+#else
+  return 0;
+#endif
+}
+
+static int
+g_udp_segment_message_get_level (GSocketControlMessage *message)
+{
+#if G_UDP_SEGMENT_MESSAGE_SUPPORTED
+  return IPPROTO_UDP;
+#else
+  return 0;
+#endif
+}
+
+static int
+g_udp_segment_message_get_msg_type (GSocketControlMessage *message)
+{
+#if G_UDP_SEGMENT_MESSAGE_SUPPORTED
+  return UDP_SEGMENT;
+#else
+  return 0;
+#endif
+}
+
+static GSocketControlMessage *
+g_udp_segment_message_deserialize (gint     level,
+                                   gint     type,
+                                   gsize    size,
+                                   gpointer data)
+{
+#if G_UDP_SEGMENT_MESSAGE_SUPPORTED
+  int segment_size;
+
+  /* The kernel reports the size of coalesced datagrams as an int, which is
+   * different from what’s sent */
+  if (level != IPPROTO_UDP || type != UDP_GRO)
+    return NULL;
+
+  if (size != sizeof (int))
+    {
+      g_warning ("Expected a segment size of %" G_GSIZE_FORMAT " bytes but "
+                 "got %" G_GSIZE_FORMAT " bytes of data",
+                 sizeof (int), size);
+      return NULL;
+    }
+
+  memcpy (&segment_size, data, sizeof (segment_size));
+  if (segment_size <= 0 || segment_size > G_MAXUINT16)
+    return NULL;
+
+  return g_udp_segment_message_new (segment_size);
+#else
+  return NULL;
+#endif
+}
+
+static void
+g_udp_segment_message_serialize (GSocketControlMessage *_message,
+                                 gpointer               data)
+{
+#if G_UDP_SEGMENT_MESSAGE_SUPPORTED
+  GUdpSegmentMessage *message = G_UDP_SEGMENT_MESSAGE (_message);
+
+  memcpy (data, &message->priv->segment_size, sizeof (message->priv->segment_size));
+#endif
+}
+
+static void
+g_udp_segment_message_init (GUdpSegmentMessage *message)
+{
+  message->priv = g_udp_segment_message_get_instance_private (message);
+}
+
+static void
+g_udp_segment_message_get_property (GObject    *object,
+                                    guint       prop_id,
+                                    GValue     *value,
+                                    GParamSpec *pspec)
+{
+  GUdpSegmentMessage *message = G_UDP_SEGMENT_MESSAGE (object);
+
+  switch (prop_id)
+    {
+    case PROP_SEGMENT_SIZE:
+      g_value_set_uint (value, message->priv->segment_size);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+    }
+}
+
+static void
+g_udp_segment_message_set_property (GObject      *object,
+                                    guint         prop_id,
+                                    const GValue *value,
+                                    GParamSpec   *pspec)
+{
+  GUdpSegmentMessage *message = G_UDP_SEGMENT_MESSAGE (object);
+
+  switch (prop_id)
+    {
+    case PROP_SEGMENT_SIZE:
+      message->priv->segment_size = g_value_get_uint (value);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+    }
+}
+
+static void
+g_udp_segment_message_class_init (GUdpSegmentMessageClass *class)
+{
+  GSocketControlMessageClass *scm_class;
+  GObjectClass *gobject_class;
+
+  gobject_class = G_OBJECT_CLASS (class);
+  gobject_class->get_property = g_udp_segment_message_get_property;
+  gobject_class->set_property = g_udp_segment_message_set_property;
+
+  scm_class = G_SOCKET_CONTROL_MESSAGE_CLASS (class);
+  scm_class->get_size = g_udp_segment_message_get_size;
+  scm_class->get_level = g_udp_segment_message_get_level;
+  scm_class->get_type = g_udp_segment_message_get_msg_type;
+  scm_class->serialize = g_udp_segment_message_serialize;
+  scm_class->deserialize = g_udp_segment_message_deserialize;
+
+  /**
+   * GUdpSegmentMessage:segment-size:
+   *
+   * The size of each datagram, in bytes.
+   *
+   * Since: 2.82
+   */
+  g_object_class_install_property (gobject_class,
+                                   PROP_SEGMENT_SIZE,
+                                   g_param_spec_uint ("segment-size", NULL, NULL,
+                                                      1, G_MAXUINT16, 1,
+                                                      G_PARAM_READWRITE |
+                                                      G_PARAM_CONSTRUCT_ONLY |
+                                                      G_PARAM_STATIC_STRINGS));
+}
+
+/**
+ * g_udp_segment_message_is_supported:
+ *
+ * Checks if UDP segmentation offload is supported on this platform. The
+ * running kernel may still reject it, in which case sending or
+ * g_udp_segment_message_enable_gro() fails.
+ *
+ * Returns: %TRUE if supported, %FALSE otherwise
+ *
+ * Since: 2.82
+ */
+gboolean
+g_udp_segment_message_is_supported (void)
+{
+#if G_UDP_SEGMENT_MESSAGE_SUPPORTED
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
+/**
+ * g_udp_segment_message_new:
+ * @segment_size: the size of each datagram, in bytes
+ *
+ * Creates a new #GUdpSegmentMessage, to split a buffer sent on a UDP
+ * socket into datagrams of @segment_size bytes.
+ *
+ * Returns: (transfer full): a new #GUdpSegmentMessage
+ *
+ * Since: 2.82
+ */
+GSocketControlMessage *
+g_udp_segment_message_new (guint16 segment_size)
+{
+  g_return_val_if_fail (segment_size > 0, NULL);
+  g_return_val_if_fail (g_udp_segment_message_is_supported (), NULL);
+
+  return g_object_new (G_TYPE_UDP_SEGMENT_MESSAGE,
+                       "segment-size", (guint) segment_size,
+                       NULL);
+}
+
+/**
+ * g_udp_segment_message_get_segment_size:
+ * @message: a #GUdpSegmentMessage
+ *
+ * Gets the size of each datagram.
+ *
+ * Returns: the segment size, in bytes
+ *
+ * Since: 2.82
+ */
+guint16
+g_udp_segment_message_get_segment_size (GUdpSegmentMessage *message)
+{
+  g_return_val_if_fail (G_IS_UDP_SEGMENT_MESSAGE (message), 0);
+
+  return message->priv->segment_size;
+}
+
+/**
+ * g_udp_segment_message_enable_gro:
+ * @socket: a UDP #GSocket
+ * @enabled: whether to coalesce received datagrams
+ * @error: #GError for error reporting, or %NULL to ignore.
+ *
+ * Sets whether the kernel may coalesce datagrams received on @socket (UDP
+ * generic receive offload). When it does, a #GUdpSegmentMessage is returned
+ * with the received data, so the control messages must be requested when
+ * receiving on a socket with this enabled.
+ *
+ * Returns: %TRUE on success, %FALSE on error, which is
+ *   %G_IO_ERROR_NOT_SUPPORTED if the platform doesn’t support it
+ *
+ * Since: 2.82
+ */
+gboolean
+g_udp_segment_message_enable_gro (GSocket   *socket,
+                                  gboolean   enabled,
+                                  GError   **error)
+{
+  g_return_val_if_fail (G_IS_SOCKET (socket), FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+#if G_UDP_SEGMENT_MESSAGE_SUPPORTED
+  return g_socket_set_option (socket, IPPROTO_UDP, UDP_GRO, !!enabled, error);
+#else
+  g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                       _("UDP segmentation offload is not supported on this platform"));
+  return FALSE;
+#endif
+}
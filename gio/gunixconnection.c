@@ -57,6 +57,10 @@ G_DEFINE_TYPE_WITH_CODE (GUnixConnection, g_unix_connection,
 					     G_SOCKET_PROTOCOL_DEFAULT);
 			 );
 
+/* Linux refuses SCM_RIGHTS messages with more than SCM_MAX_FD (253)
+ * file descriptors, so larger batches are split. */
+#define FDS_PER_MESSAGE 253
+
 /**
  * g_unix_connection_send_fd:
  * @connection: a #GUnixConnection
@@ -83,34 +87,10 @@ g_unix_connection_send_fd (GUnixConnection  *connection,
                            GError          **error)
 {
 #ifdef G_OS_UNIX
-  GSocketControlMessage *scm;
-  GSocket *socket;
-
   g_return_val_if_fail (G_IS_UNIX_CONNECTION (connection), FALSE);
   g_return_val_if_fail (fd >= 0, FALSE);
 
-  scm = g_unix_fd_message_new ();
-
-  if (!g_unix_fd_message_append_fd (G_UNIX_FD_MESSAGE (scm), fd, error))
-    {
-      g_object_unref (scm);
-      return FALSE;
-    }
-
-  g_object_get (connection, "socket", &socket, NULL);
-  if (g_socket_send_message (socket, NULL, NULL, 0, &scm, 1, 0, cancellable, error) != 1)
-    /* XXX could it 'fail' with zero? */
-    {
-      g_object_unref (socket);
-      g_object_unref (scm);
-
-      return FALSE;
-    }
-
-  g_object_unref (socket);
-  g_object_unref (scm);
-
-  return TRUE;
+  return g_unix_connection_send_fds (connection, &fd, 1, cancellable, error);
 #else
   g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
                        _("Sending FD is not supported"));
@@ -233,6 +213,181 @@ g_unix_connection_receive_fd (GUnixConnection  *connection,
 #endif
 }
 
+/**
+ * g_unix_connection_send_fds:
+ * @connection: a #GUnixConnection
+ * @fds: (array length=n_fds): the file descriptors to send
+ * @n_fds: the number of elements in @fds, at least 1
+ * @cancellable: (nullable): optional #GCancellable object, %NULL to ignore.
+ * @error: (nullable): #GError for error reporting, or %NULL to ignore.
+ *
+ * Passes several file descriptors to the receiving side of the
+ * connection, with as few messages as possible.  The receiving end has
+ * to call g_unix_connection_receive_fds() to accept them.
+ *
+ * The file descriptors are not duplicated on the sending side: you keep
+ * ownership of @fds.
+ *
+ * Operating systems limit the number of file descriptors in a single
+ * message (253 on Linux), so larger arrays are sent as several messages,
+ * each of which has to be received with its own call to
+ * g_unix_connection_receive_fds().  As with g_unix_connection_send_fd(),
+ * a single byte is written to the stream for each message.
+ *
+ * If an error occurs, some of the messages may have been sent already.
+ *
+ * Returns: %TRUE on success, %FALSE on error.
+ *
+ * Since: 2.82
+ */
+gboolean
+g_unix_connection_send_fds (GUnixConnection  *connection,
+                            const gint       *fds,
+                            gint              n_fds,
+                            GCancellable     *cancellable,
+                            GError          **error)
+{
+#ifdef G_OS_UNIX
+  GSocket *socket;
+  gint sent;
+
+  g_return_val_if_fail (G_IS_UNIX_CONNECTION (connection), FALSE);
+  g_return_val_if_fail (fds != NULL, FALSE);
+  g_return_val_if_fail (n_fds > 0, FALSE);
+
+  socket = g_socket_connection_get_socket (G_SOCKET_CONNECTION (connection));
+
+  for (sent = 0; sent < n_fds; sent += FDS_PER_MESSAGE)
+    {
+      GSocketControlMessage *scm;
+      GUnixFDList *list;
+      gssize result;
+
+      /* The kernel duplicates the fds while sending them, so the list
+       * only borrows them and hands them back afterwards instead of
+       * holding dup()s of its own. */
+      list = g_unix_fd_list_new_from_array (fds + sent, MIN (n_fds - sent, FDS_PER_MESSAGE));
+      scm = g_unix_fd_message_new_with_fd_list (list);
+
+      result = g_socket_send_message (socket, NULL, NULL, 0, &scm, 1, 0, cancellable, error);
+
+      g_free (g_unix_fd_list_steal_fds (list, NULL));
+      g_object_unref (scm);
+      g_object_unref (list);
+
+      if (result != 1)
+        return FALSE;
+    }
+
+  return TRUE;
+#else
+  g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                       _("Sending FD is not supported"));
+  return FALSE;
+#endif
+}
+
+/**
+ * g_unix_connection_receive_fds:
+ * @connection: a #GUnixConnection
+ * @n_fds: (out): return location for the number of file descriptors
+ * @cancellable: (nullable): optional #GCancellable object, %NULL to ignore
+ * @error: (nullable): #GError for error reporting, or %NULL to ignore
+ *
+ * Receives the file descriptors of one message from the sending end of
+ * the connection, which has to use g_unix_connection_send_fds() or
+ * g_unix_connection_send_fd().
+ *
+ * g_unix_connection_send_fds() splits large arrays into several
+ * messages, so call this function until you have received as many file
+ * descriptors as were sent.
+ *
+ * The returned file descriptors are set to close-on-exec.  You must
+ * close them and free the array with g_free().  The array is also
+ * terminated with -1.
+ *
+ * Returns: (array length=n_fds) (transfer full) (nullable): the received
+ *     file descriptors, or %NULL on error
+ *
+ * Since: 2.82
+ */
+gint *
+g_unix_connection_receive_fds (GUnixConnection  *connection,
+                               gint             *n_fds,
+                               GCancellable     *cancellable,
+                               GError          **error)
+{
+#ifdef G_OS_UNIX
+  GSocketControlMessage **scms;
+  GUnixFDList *list = NULL;
+  GSocket *socket;
+  gssize result;
+  gint nscm, i;
+  gint *fds;
+
+  g_return_val_if_fail (G_IS_UNIX_CONNECTION (connection), NULL);
+  g_return_val_if_fail (n_fds != NULL, NULL);
+
+  *n_fds = 0;
+
+  socket = g_socket_connection_get_socket (G_SOCKET_CONNECTION (connection));
+  result = g_socket_receive_message (socket, NULL, NULL, 0,
+                                     &scms, &nscm, NULL, cancellable, error);
+  if (result < 0)
+    return NULL;
+
+  if (result == 0)
+    {
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_CONNECTION_CLOSED,
+                           _("Unexpected early end-of-stream"));
+      return NULL;
+    }
+
+  for (i = 0; i < nscm; i++)
+    {
+      if (G_IS_UNIX_FD_MESSAGE (scms[i]))
+        {
+          GUnixFDList *fd_list = g_unix_fd_message_get_fd_list (G_UNIX_FD_MESSAGE (scms[i]));
+
+          /* Adopt the first list, and move the fds of any further ones
+           * into it */
+          if (list == NULL)
+            {
+              list = g_object_ref (fd_list);
+            }
+          else
+            {
+              gint nfd, j;
+
+              fds = g_unix_fd_list_steal_fds (fd_list, &nfd);
+              for (j = 0; j < nfd; j++)
+                g_unix_fd_list_append_take (list, fds[j]);
+              g_free (fds);
+            }
+        }
+
+      g_object_unref (scms[i]);
+    }
+  g_free (scms);
+
+  if (list == NULL)
+    {
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_FAILED,
+                           _("Unexpected type of ancillary data"));
+      return NULL;
+    }
+
+  fds = g_unix_fd_list_steal_fds (list, n_fds);
+  g_object_unref (list);
+
+  return fds;
+#else
+  g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                       _("Receiving FD is not supported"));
+  return NULL;
+#endif
+}
+
 static void
 g_unix_connection_init (GUnixConnection *connection)
 {
@@ -253,10 +408,6 @@ void                    g_unix_connection_send_fd_async                 (GUnixCo
 gboolean                g_unix_connection_send_fd_finish                (GUnixConnection      *connection,
                                                                          GError              **error);
 
-gboolean                g_unix_connection_send_fds                      (GUnixConnection      *connection,
-                                                                         gint                 *fds,
-                                                                         gint                  nfds,
-                                                                         GError              **error);
 void                    g_unix_connection_send_fds_async                (GUnixConnection      *connection,
                                                                          gint                 *fds,
                                                                          gint                  nfds,
@@ -68,6 +68,17 @@ GIO_AVAILABLE_IN_ALL
 gint                    g_unix_connection_receive_fd                    (GUnixConnection      *connection,
                                                                          GCancellable         *cancellable,
                                                                          GError              **error);
+GIO_AVAILABLE_IN_2_82
+gboolean                g_unix_connection_send_fds                      (GUnixConnection      *connection,
+                                                                         const gint           *fds,
+                                                                         gint                  n_fds,
+                                                                         GCancellable         *cancellable,
+                                                                         GError              **error);
+GIO_AVAILABLE_IN_2_82
+gint                   *g_unix_connection_receive_fds                   (GUnixConnection      *connection,
+                                                                         gint                 *n_fds,
+                                                                         GCancellable         *cancellable,
+                                                                         GError              **error);
 
 GIO_AVAILABLE_IN_ALL
 gboolean                g_unix_connection_send_credentials              (GUnixConnection      *connection,
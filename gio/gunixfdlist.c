@@ -49,10 +49,16 @@
 #include <io.h>
 #endif
 
+#ifdef HAVE_MEMFD_CREATE
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 struct _GUnixFDListPrivate
 {
   gint *fds;
   gint nfd;
+  gint allocated;  /* size of @fds, including the -1 terminator */
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (GUnixFDList, g_unix_fd_list, G_TYPE_OBJECT)
@@ -148,6 +154,27 @@ dup_close_on_exec_fd (gint     fd,
   return new_fd;
 }
 
+/* Appends @fd, which @list takes ownership of, growing @fds
+ * geometrically so that appending many fds stays linear. */
+static gint
+g_unix_fd_list_push (GUnixFDList *list,
+                     gint         fd)
+{
+  GUnixFDListPrivate *priv = list->priv;
+
+  if (priv->nfd + 2 > priv->allocated)
+    {
+      priv->allocated = MAX (priv->allocated * 2, priv->nfd + 2);
+      priv->allocated = MAX (priv->allocated, 8);
+      priv->fds = g_renew (gint, priv->fds, priv->allocated);
+    }
+
+  priv->fds[priv->nfd++] = fd;
+  priv->fds[priv->nfd] = -1;
+
+  return priv->nfd - 1;
+}
+
 /**
  * g_unix_fd_list_new:
  *
@@ -195,6 +222,7 @@ g_unix_fd_list_new_from_array (const gint *fds,
   list = g_object_new (G_TYPE_UNIX_FD_LIST, NULL);
   list->priv->fds = g_new (gint, n_fds + 1);
   list->priv->nfd = n_fds;
+  list->priv->allocated = n_fds + 1;
 
   if (n_fds > 0)
     memcpy (list->priv->fds, fds, sizeof (gint) * n_fds);
@@ -247,6 +275,7 @@ g_unix_fd_list_steal_fds (GUnixFDList *list,
       list->priv->fds = g_new (gint, 1);
       list->priv->fds[0] = -1;
       list->priv->nfd = 0;
+      list->priv->allocated = 1;
     }
 
   if (length)
@@ -255,6 +284,7 @@ g_unix_fd_list_steal_fds (GUnixFDList *list,
 
   list->priv->fds = NULL;
   list->priv->nfd = 0;
+  list->priv->allocated = 0;
 
   return result;
 }
@@ -296,6 +326,7 @@ g_unix_fd_list_peek_fds (GUnixFDList *list,
       list->priv->fds = g_new (gint, 1);
       list->priv->fds[0] = -1;
       list->priv->nfd = 0;
+      list->priv->allocated = 1;
     }
 
   if (length)
@@ -342,13 +373,204 @@ g_unix_fd_list_append (GUnixFDList  *list,
   if ((new_fd = dup_close_on_exec_fd (fd, error)) < 0)
     return -1;
 
-  list->priv->fds = g_realloc (list->priv->fds,
-                                  sizeof (gint) *
-                                   (list->priv->nfd + 2));
-  list->priv->fds[list->priv->nfd++] = new_fd;
-  list->priv->fds[list->priv->nfd] = -1;
+  return g_unix_fd_list_push (list, new_fd);
+}
+
+/**
+ * g_unix_fd_list_append_take:
+ * @list: a #GUnixFDList
+ * @fd: (transfer full): a valid open file descriptor
+ *
+ * Adds a file descriptor to @list, taking ownership of it.
+ *
+ * Unlike g_unix_fd_list_append(), @fd is not duplicated: it is closed
+ * when @list is finalized, and you must not use or close it yourself
+ * afterwards.  This cannot fail, which makes it the cheaper choice when
+ * passing on many file descriptors which are not needed any more, for
+ * example ones that were just received.
+ *
+ * @fd should be set to close-on-exec.
+ *
+ * Returns: the index of the appended fd
+ *
+ * Since: 2.82
+ */
+gint
+g_unix_fd_list_append_take (GUnixFDList *list,
+                            gint         fd)
+{
+  g_return_val_if_fail (G_IS_UNIX_FD_LIST (list), -1);
+  g_return_val_if_fail (fd >= 0, -1);
+
+  return g_unix_fd_list_push (list, fd);
+}
+
+#if defined (HAVE_MEMFD_CREATE) && defined (F_ADD_SEALS)
+#define BYTES_SEALS (F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL)
+#endif
+
+/**
+ * g_unix_fd_list_append_bytes:
+ * @list: a #GUnixFDList
+ * @bytes: the data to add
+ * @error: a #GError pointer
+ *
+ * Copies @bytes into a new sealed memory file descriptor and adds that to
+ * @list.
+ *
+ * This is useful for passing large amounts of data over D-Bus: put the
+ * returned index into the message as a `h` handle instead of putting the
+ * data itself into the body as `ay`, so that it is neither copied through
+ * the socket nor serialized. The receiving side gets the data back with
+ * g_unix_fd_list_map_bytes(). As the file descriptor is sealed, the
+ * receiver can rely on its contents not changing.
+ *
+ * This needs `memfd_create()` with file sealing, which is only available
+ * on Linux. It fails with %G_IO_ERROR_NOT_SUPPORTED elsewhere.
+ *
+ * Returns: the index of the appended fd in case of success, else -1
+ *          (and @error is set)
+ *
+ * Since: 2.82
+ */
+gint
+g_unix_fd_list_append_bytes (GUnixFDList  *list,
+                             GBytes       *bytes,
+                             GError      **error)
+{
+#ifdef BYTES_SEALS
+  const guint8 *data;
+  gsize size;
+  gint fd;
+
+  g_return_val_if_fail (G_IS_UNIX_FD_LIST (list), -1);
+  g_return_val_if_fail (bytes != NULL, -1);
+  g_return_val_if_fail (error == NULL || *error == NULL, -1);
+
+  fd = memfd_create ("gio-bytes", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fd < 0)
+    {
+      int errsv = errno;
+
+      g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+                   "memfd_create: %s", g_strerror (errsv));
+      return -1;
+    }
+
+  data = g_bytes_get_data (bytes, &size);
+  while (size > 0)
+    {
+      gssize written = write (fd, data, size);
+
+      if (written < 0)
+        {
+          int errsv = errno;
+
+          if (errsv == EINTR)
+            continue;
+
+          g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+                       "write: %s", g_strerror (errsv));
+          g_close (fd, NULL);
+          return -1;
+        }
+
+      data += written;
+      size -= written;
+    }
+
+  if (fcntl (fd, F_ADD_SEALS, BYTES_SEALS) < 0)
+    {
+      int errsv = errno;
+
+      g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+                   "fcntl: %s", g_strerror (errsv));
+      g_close (fd, NULL);
+      return -1;
+    }
+
+  /* Hand over @fd rather than duplicating it like g_unix_fd_list_append() */
+  return g_unix_fd_list_push (list, fd);
+#else
+  g_return_val_if_fail (G_IS_UNIX_FD_LIST (list), -1);
+  g_return_val_if_fail (bytes != NULL, -1);
+  g_return_val_if_fail (error == NULL || *error == NULL, -1);
+
+  g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                       "Sealed memory file descriptors are not supported on this platform");
+  return -1;
+#endif
+}
 
-  return list->priv->nfd - 1;
+/**
+ * g_unix_fd_list_map_bytes:
+ * @list: a #GUnixFDList
+ * @index_: the index into the list
+ * @error: a #GError pointer
+ *
+ * Maps the contents of a file descriptor added with
+ * g_unix_fd_list_append_bytes() into memory, usually on the other end
+ * of a D-Bus connection.
+ *
+ * The file descriptor must be sealed against writing and shrinking, so
+ * that the returned data can't change or disappear while it is used.
+ * Otherwise this fails with %G_IO_ERROR_INVALID_DATA. It is a programmer
+ * error for @index_ to be out of range.
+ *
+ * The returned #GBytes can be turned into a `ay` #GVariant without
+ * copying with g_variant_new_from_bytes().
+ *
+ * Returns: (transfer full): the contents, or %NULL on error
+ *
+ * Since: 2.82
+ */
+GBytes *
+g_unix_fd_list_map_bytes (GUnixFDList  *list,
+                          gint          index_,
+                          GError      **error)
+{
+#ifdef BYTES_SEALS
+  GMappedFile *mapped_file;
+  GError *local_error = NULL;
+  GBytes *bytes;
+  gint seals;
+
+  g_return_val_if_fail (G_IS_UNIX_FD_LIST (list), NULL);
+  g_return_val_if_fail (index_ >= 0 && index_ < list->priv->nfd, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  seals = fcntl (list->priv->fds[index_], F_GET_SEALS);
+  if (seals < 0 ||
+      (seals & (F_SEAL_SHRINK | F_SEAL_WRITE)) != (F_SEAL_SHRINK | F_SEAL_WRITE))
+    {
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                           "File descriptor is not a sealed memory file");
+      return NULL;
+    }
+
+  mapped_file = g_mapped_file_new_from_fd (list->priv->fds[index_], FALSE, &local_error);
+  if (mapped_file == NULL)
+    {
+      g_set_error_literal (error, G_IO_ERROR,
+                           g_io_error_from_file_error (local_error->code),
+                           local_error->message);
+      g_error_free (local_error);
+      return NULL;
+    }
+
+  bytes = g_mapped_file_get_bytes (mapped_file);
+  g_mapped_file_unref (mapped_file);
+
+  return bytes;
+#else
+  g_return_val_if_fail (G_IS_UNIX_FD_LIST (list), NULL);
+  g_return_val_if_fail (index_ >= 0 && index_ < list->priv->nfd, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                       "Sealed memory file descriptors are not supported on this platform");
+  return NULL;
+#endif
 }
 
 /**
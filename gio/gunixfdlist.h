@@ -76,6 +76,20 @@ gint                    g_unix_fd_list_append                           (GUnixFD
                                                                          gint          fd,
                                                                          GError      **error);
 
+GIO_AVAILABLE_IN_2_82
+gint                    g_unix_fd_list_append_take                      (GUnixFDList  *list,
+                                                                         gint          fd);
+
+GIO_AVAILABLE_IN_2_82
+gint                    g_unix_fd_list_append_bytes                     (GUnixFDList  *list,
+                                                                         GBytes       *bytes,
+                                                                         GError      **error);
+
+GIO_AVAILABLE_IN_2_82
+GBytes *                g_unix_fd_list_map_bytes                        (GUnixFDList  *list,
+                                                                         gint          index_,
+                                                                         GError      **error);
+
 GIO_AVAILABLE_IN_ALL
 gint                    g_unix_fd_list_get_length                       (GUnixFDList  *list);
 
@@ -0,0 +1,37 @@
+/* GIO - GLib Input, Output and Streaming Library
+ *
+ * Copyright (C) 2006-2007 Red Hat, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __G_UNIX_MOUNTS_PRIVATE_H__
+#define __G_UNIX_MOUNTS_PRIVATE_H__
+
+#include <gio/gio.h>
+#include <gio/gunixmounts.h>
+
+G_BEGIN_DECLS
+
+/* Used for a private test API */
+/*< private >*/
+GIO_AVAILABLE_IN_ALL
+void g_unix_mount_monitors_queue_changes (GPtrArray *added,
+                                          GPtrArray *removed);
+
+G_END_DECLS
+
+#endif /* __G_UNIX_MOUNTS_PRIVATE_H__ */
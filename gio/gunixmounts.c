@@ -75,6 +75,7 @@ extern char* hasmntopt(const struct mntent* mnt, const char* opt);
 #endif
 
 #include "gunixmounts.h"
+#include "gunixmounts-private.h"
 #include "gfile.h"
 #include "gfilemonitor.h"
 #include "glibintl.h"
@@ -204,6 +205,8 @@ static GSource *proc_mounts_watch_source = NULL;
 #ifdef HAVE_LIBMOUNT
 /* Protected by proc_mounts_source lock */
 static struct libmnt_monitor *proc_mounts_monitor = NULL;
+/* The mount table as of the last change, to diff the next one against */
+static struct libmnt_table *proc_mounts_table = NULL;
 #endif
 
 static gboolean
@@ -501,13 +504,40 @@ create_unix_mount_point (const char *device_path,
  */
 #define PROC_MOUNTINFO_PATH "/proc/self/mountinfo"
 
+static GUnixMountEntry *
+create_unix_mount_entry_for_fs (struct libmnt_fs *fs)
+{
+  const char *device_path = NULL;
+  char *mount_options = NULL;
+  unsigned long mount_flags = 0;
+  gboolean is_read_only = FALSE;
+
+  device_path = mnt_fs_get_source (fs);
+  if (g_strcmp0 (device_path, "/dev/root") == 0)
+    device_path = _resolve_dev_root ();
+
+  mount_options = mnt_fs_strdup_options (fs);
+  if (mount_options)
+    {
+      mnt_optstr_get_flags (mount_options, &mount_flags, mnt_get_builtin_optmap (MNT_LINUX_MAP));
+      g_free (mount_options);
+    }
+  is_read_only = (mount_flags & MS_RDONLY) ? TRUE : FALSE;
+
+  return create_unix_mount_entry (device_path,
+                                  mnt_fs_get_target (fs),
+                                  mnt_fs_get_root (fs),
+                                  mnt_fs_get_fstype (fs),
+                                  mnt_fs_get_options (fs),
+                                  is_read_only);
+}
+
 static GList *
 _g_get_unix_mounts (void)
 {
   struct libmnt_table *table = NULL;
   struct libmnt_iter* iter = NULL;
   struct libmnt_fs *fs = NULL;
-  GUnixMountEntry *mount_entry = NULL;
   GList *return_list = NULL;
 
   table = mnt_new_table ();
@@ -516,33 +546,7 @@ _g_get_unix_mounts (void)
 
   iter = mnt_new_iter (MNT_ITER_FORWARD);
   while (mnt_table_next_fs (table, iter, &fs) == 0)
-    {
-      const char *device_path = NULL;
-      char *mount_options = NULL;
-      unsigned long mount_flags = 0;
-      gboolean is_read_only = FALSE;
-
-      device_path = mnt_fs_get_source (fs);
-      if (g_strcmp0 (device_path, "/dev/root") == 0)
-        device_path = _resolve_dev_root ();
-
-      mount_options = mnt_fs_strdup_options (fs);
-      if (mount_options)
-        {
-          mnt_optstr_get_flags (mount_options, &mount_flags, mnt_get_builtin_optmap (MNT_LINUX_MAP));
-          g_free (mount_options);
-        }
-      is_read_only = (mount_flags & MS_RDONLY) ? TRUE : FALSE;
-
-      mount_entry = create_unix_mount_entry (device_path,
-                                             mnt_fs_get_target (fs),
-                                             mnt_fs_get_root (fs),
-                                             mnt_fs_get_fstype (fs),
-                                             mnt_fs_get_options (fs),
-                                             is_read_only);
-
-      return_list = g_list_prepend (return_list, mount_entry);
-    }
+    return_list = g_list_prepend (return_list, create_unix_mount_entry_for_fs (fs));
   mnt_free_iter (iter);
 
  out:
@@ -1803,6 +1807,7 @@ g_unix_mount_points_changed_since (guint64 time)
 enum {
   MOUNTS_CHANGED,
   MOUNTPOINTS_CHANGED,
+  MOUNTS_CHANGED_DETAIL,
   LAST_SIGNAL
 };
 
@@ -1812,10 +1817,17 @@ struct _GUnixMountMonitor {
   GObject parent;
 
   GMainContext *context;
+
+  /* Changes not reported by #GUnixMountMonitor::mounts-changed-detail yet,
+   * protected by the mount_monitors lock */
+  GPtrArray *pending_added;
+  GPtrArray *pending_removed;
 };
 
 struct _GUnixMountMonitorClass {
   GObjectClass parent_class;
+
+  void (* mounts_changed) (GUnixMountMonitor *monitor);
 };
 
 
@@ -1827,6 +1839,10 @@ static GFileMonitor          *mtab_monitor;
 static GList                 *mount_poller_mounts;
 static guint                  mtab_file_changed_id;
 
+/* All live monitors, to queue the changes of the mount table for */
+G_LOCK_DEFINE_STATIC (mount_monitors);
+static GList                 *mount_monitors;
+
 /* Called with proc_mounts_source lock held. */
 static gboolean
 proc_mounts_watch_is_running (void)
@@ -1893,6 +1909,143 @@ mtab_file_changed (GFileMonitor      *monitor,
   g_source_unref (source);
 }
 
+/* Removes the entry equal to @entry from @entries, if there is one */
+static gboolean
+mount_entries_remove (GPtrArray       *entries,
+                      GUnixMountEntry *entry)
+{
+  guint i;
+
+  for (i = 0; i < entries->len; i++)
+    {
+      if (g_unix_mount_compare (g_ptr_array_index (entries, i), entry) == 0)
+        {
+          g_ptr_array_remove_index_fast (entries, i);
+          return TRUE;
+        }
+    }
+
+  return FALSE;
+}
+
+/* Queues the given changes for every monitor, to be reported by the next
+ * #GUnixMountMonitor::mounts-changed-detail. Changes which have not been
+ * reported yet and are undone by these cancel out.
+ *
+ * Exported as a private API for the tests. */
+void
+g_unix_mount_monitors_queue_changes (GPtrArray *added,
+                                     GPtrArray *removed)
+{
+  GList *l;
+  guint i;
+
+  G_LOCK (mount_monitors);
+
+  for (l = mount_monitors; l != NULL; l = l->next)
+    {
+      GUnixMountMonitor *monitor = l->data;
+
+      if (monitor->pending_added == NULL)
+        {
+          monitor->pending_added = g_ptr_array_new_with_free_func ((GDestroyNotify) g_unix_mount_free);
+          monitor->pending_removed = g_ptr_array_new_with_free_func ((GDestroyNotify) g_unix_mount_free);
+        }
+
+      for (i = 0; i < removed->len; i++)
+        {
+          GUnixMountEntry *entry = g_ptr_array_index (removed, i);
+
+          if (!mount_entries_remove (monitor->pending_added, entry))
+            g_ptr_array_add (monitor->pending_removed, g_unix_mount_copy (entry));
+        }
+
+      for (i = 0; i < added->len; i++)
+        {
+          GUnixMountEntry *entry = g_ptr_array_index (added, i);
+
+          if (!mount_entries_remove (monitor->pending_removed, entry))
+            g_ptr_array_add (monitor->pending_added, g_unix_mount_copy (entry));
+        }
+    }
+
+  G_UNLOCK (mount_monitors);
+}
+
+#ifdef HAVE_LIBMOUNT
+/* Re-reads the mount table, and queues what changed since the last time
+ * for the monitors. Unchanged mounts are never turned into
+ * #GUnixMountEntry, which matters on hosts with many thousands of them.
+ *
+ * Called with proc_mounts_source lock held. */
+static void
+proc_mounts_queue_changes (void)
+{
+  struct libmnt_table *table;
+  struct libmnt_tabdiff *diff;
+  struct libmnt_iter *iter;
+  struct libmnt_fs *old_fs, *new_fs;
+  GPtrArray *added, *removed;
+  int oper;
+
+  if (proc_mounts_table == NULL)
+    return;
+
+  table = mnt_new_table ();
+  if (mnt_table_parse_mtab (table, NULL) < 0)
+    {
+      mnt_unref_table (table);
+      return;
+    }
+
+  added = g_ptr_array_new_with_free_func ((GDestroyNotify) g_unix_mount_free);
+  removed = g_ptr_array_new_with_free_func ((GDestroyNotify) g_unix_mount_free);
+
+  diff = mnt_new_tabdiff ();
+  iter = mnt_new_iter (MNT_ITER_FORWARD);
+
+  if (mnt_diff_tables (diff, proc_mounts_table, table) >= 0)
+    {
+      while (mnt_tabdiff_next_change (diff, iter, &old_fs, &new_fs, &oper) == 0)
+        {
+          GUnixMountEntry *old_entry = NULL, *new_entry = NULL;
+
+          if (old_fs != NULL)
+            old_entry = create_unix_mount_entry_for_fs (old_fs);
+          if (new_fs != NULL)
+            new_entry = create_unix_mount_entry_for_fs (new_fs);
+
+          /* Remounts and moves are reported as a removal and an addition,
+           * unless nothing a #GUnixMountEntry tells about changed */
+          if (old_entry != NULL && new_entry != NULL &&
+              g_unix_mount_compare (old_entry, new_entry) == 0)
+            {
+              g_unix_mount_free (old_entry);
+              g_unix_mount_free (new_entry);
+              continue;
+            }
+
+          if (old_entry != NULL)
+            g_ptr_array_add (removed, old_entry);
+          if (new_entry != NULL)
+            g_ptr_array_add (added, new_entry);
+        }
+    }
+
+  mnt_free_iter (iter);
+  mnt_free_tabdiff (diff);
+
+  mnt_unref_table (proc_mounts_table);
+  proc_mounts_table = table;
+
+  if (added->len > 0 || removed->len > 0)
+    g_unix_mount_monitors_queue_changes (added, removed);
+
+  g_ptr_array_unref (added);
+  g_ptr_array_unref (removed);
+}
+#endif
+
 static gboolean
 proc_mounts_changed (GIOChannel   *channel,
                      GIOCondition  cond,
@@ -1918,6 +2071,9 @@ proc_mounts_changed (GIOChannel   *channel,
 
           if (ret < 0)
             g_debug ("mnt_monitor_next_change failed: %s", g_strerror (-ret));
+
+          if (has_changed)
+            proc_mounts_queue_changes ();
         }
       G_UNLOCK (proc_mounts_source);
     }
@@ -1994,6 +2150,7 @@ mount_monitor_stop (void)
 
 #ifdef HAVE_LIBMOUNT
   g_clear_pointer (&proc_mounts_monitor, mnt_unref_monitor);
+  g_clear_pointer (&proc_mounts_table, mnt_unref_table);
 #endif
   G_UNLOCK (proc_mounts_source);
 
@@ -2062,6 +2219,10 @@ mount_monitor_start (void)
           if (ret >= 0)
             {
               proc_mounts_channel = g_io_channel_unix_new (ret);
+
+              proc_mounts_table = mnt_new_table ();
+              if (mnt_table_parse_mtab (proc_mounts_table, NULL) < 0)
+                g_clear_pointer (&proc_mounts_table, mnt_unref_table);
             }
           else
             {
@@ -2143,15 +2304,42 @@ g_unix_mount_monitor_finalize (GObject *object)
 
   g_context_specific_group_remove (&mount_monitor_group, monitor->context, monitor, mount_monitor_stop);
 
+  G_LOCK (mount_monitors);
+  mount_monitors = g_list_remove (mount_monitors, monitor);
+  g_clear_pointer (&monitor->pending_added, g_ptr_array_unref);
+  g_clear_pointer (&monitor->pending_removed, g_ptr_array_unref);
+  G_UNLOCK (mount_monitors);
+
   G_OBJECT_CLASS (g_unix_mount_monitor_parent_class)->finalize (object);
 }
 
+static void
+g_unix_mount_monitor_real_mounts_changed (GUnixMountMonitor *monitor)
+{
+  GPtrArray *added, *removed;
+
+  G_LOCK (mount_monitors);
+  added = g_steal_pointer (&monitor->pending_added);
+  removed = g_steal_pointer (&monitor->pending_removed);
+  G_UNLOCK (mount_monitors);
+
+  if (added == NULL)
+    return;
+
+  if (added->len > 0 || removed->len > 0)
+    g_signal_emit (monitor, signals[MOUNTS_CHANGED_DETAIL], 0, added, removed);
+
+  g_ptr_array_unref (added);
+  g_ptr_array_unref (removed);
+}
+
 static void
 g_unix_mount_monitor_class_init (GUnixMountMonitorClass *klass)
 {
   GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
 
   gobject_class->finalize = g_unix_mount_monitor_finalize;
+  klass->mounts_changed = g_unix_mount_monitor_real_mounts_changed;
  
   /**
    * GUnixMountMonitor::mounts-changed:
@@ -2161,12 +2349,46 @@ g_unix_mount_monitor_class_init (GUnixMountMonitorClass *klass)
    */ 
   signals[MOUNTS_CHANGED] =
     g_signal_new (I_("mounts-changed"),
+		  G_TYPE_FROM_CLASS (klass),
+		  G_SIGNAL_RUN_FIRST,
+		  G_STRUCT_OFFSET (GUnixMountMonitorClass, mounts_changed),
+		  NULL, NULL,
+		  NULL,
+		  G_TYPE_NONE, 0);
+
+  /**
+   * GUnixMountMonitor::mounts-changed-detail:
+   * @monitor: the object on which the signal is emitted
+   * @added: (element-type GUnixMountEntry): the mounts which were added
+   * @removed: (element-type GUnixMountEntry): the mounts which were removed
+   *
+   * Emitted with the changes to the unix mounts, right before
+   * #GUnixMountMonitor::mounts-changed, when they are known.
+   *
+   * A mount whose options changed, or which was moved, is reported as
+   * removed with its old details and added with its new ones. Changes
+   * which were undone before the signal could be emitted are not
+   * reported.
+   *
+   * This signal is currently only emitted on Linux when GLib is built
+   * with libmount, where the mount table is diffed against its previous
+   * state rather than processed in full. Elsewhere, and whenever the
+   * changes are not known, only #GUnixMountMonitor::mounts-changed is
+   * emitted, and the mounts have to be listed again with
+   * g_unix_mounts_get().
+   *
+   * Since: 2.82
+   */
+  signals[MOUNTS_CHANGED_DETAIL] =
+    g_signal_new (I_("mounts-changed-detail"),
 		  G_TYPE_FROM_CLASS (klass),
 		  G_SIGNAL_RUN_LAST,
 		  0,
 		  NULL, NULL,
 		  NULL,
-		  G_TYPE_NONE, 0);
+		  G_TYPE_NONE, 2,
+		  G_TYPE_PTR_ARRAY,
+		  G_TYPE_PTR_ARRAY);
 
   /**
    * GUnixMountMonitor::mountpoints-changed:
@@ -2187,6 +2409,9 @@ g_unix_mount_monitor_class_init (GUnixMountMonitorClass *klass)
 static void
 g_unix_mount_monitor_init (GUnixMountMonitor *monitor)
 {
+  G_LOCK (mount_monitors);
+  mount_monitors = g_list_prepend (mount_monitors, monitor);
+  G_UNLOCK (mount_monitors);
 }
 
 /**
@@ -45,6 +45,9 @@ struct _GUnixVolumeMonitor {
 
   GList *last_mountpoints;
   GList *last_mounts;
+  /* Set when mounts-changed-detail already brought last_mounts up to date
+   * for the mounts-changed emission which follows it */
+  gboolean mounts_up_to_date;
 
   GList *volumes;
   GList *mounts;
@@ -54,6 +57,10 @@ static void mountpoints_changed      (GUnixMountMonitor  *mount_monitor,
                                       gpointer            user_data);
 static void mounts_changed           (GUnixMountMonitor  *mount_monitor,
                                       gpointer            user_data);
+static void mounts_changed_detail    (GUnixMountMonitor  *mount_monitor,
+                                      GPtrArray          *added,
+                                      GPtrArray          *removed,
+                                      gpointer            user_data);
 static void update_volumes           (GUnixVolumeMonitor *monitor);
 static void update_mounts            (GUnixVolumeMonitor *monitor);
 
@@ -73,6 +80,7 @@ g_unix_volume_monitor_finalize (GObject *object)
 
   g_signal_handlers_disconnect_by_func (monitor->mount_monitor, mountpoints_changed, monitor);
   g_signal_handlers_disconnect_by_func (monitor->mount_monitor, mounts_changed, monitor);
+  g_signal_handlers_disconnect_by_func (monitor->mount_monitor, mounts_changed_detail, monitor);
 					
   g_object_unref (monitor->mount_monitor);
 
@@ -208,6 +216,12 @@ mounts_changed (GUnixMountMonitor *mount_monitor,
 {
   GUnixVolumeMonitor *unix_monitor = user_data;
 
+  if (unix_monitor->mounts_up_to_date)
+    {
+      unix_monitor->mounts_up_to_date = FALSE;
+      return;
+    }
+
   _g_unix_volume_monitor_update (unix_monitor);
 }
 
@@ -220,6 +234,10 @@ g_unix_volume_monitor_init (GUnixVolumeMonitor *unix_monitor)
   g_signal_connect (unix_monitor->mount_monitor,
 		    "mounts-changed", G_CALLBACK (mounts_changed),
 		    unix_monitor);
+
+  g_signal_connect (unix_monitor->mount_monitor,
+		    "mounts-changed-detail", G_CALLBACK (mounts_changed_detail),
+		    unix_monitor);
   
   g_signal_connect (unix_monitor->mount_monitor,
 		    "mountpoints-changed", G_CALLBACK (mountpoints_changed),
@@ -366,15 +384,48 @@ update_volumes (GUnixVolumeMonitor *monitor)
   monitor->last_mountpoints = new_mountpoints;
 }
 
+static void
+mount_entry_removed (GUnixVolumeMonitor *monitor,
+                     GUnixMountEntry    *mount_entry)
+{
+  GUnixMount *mount;
+
+  mount = find_mount_by_mountpath (monitor, g_unix_mount_get_mount_path (mount_entry));
+  if (mount)
+    {
+      _g_unix_mount_unmounted (mount);
+      monitor->mounts = g_list_remove (monitor->mounts, mount);
+      g_signal_emit_by_name (monitor, "mount-removed", mount);
+      g_signal_emit_by_name (mount, "unmounted");
+      g_object_unref (mount);
+    }
+}
+
+static void
+mount_entry_added (GUnixVolumeMonitor *monitor,
+                   GUnixMountEntry    *mount_entry)
+{
+  GUnixMount *mount;
+  GUnixVolume *volume;
+  const char *mount_path;
+
+  mount_path = g_unix_mount_get_mount_path (mount_entry);
+
+  volume = _g_unix_volume_monitor_lookup_volume_for_mount_path (monitor, mount_path);
+  mount = _g_unix_mount_new (G_VOLUME_MONITOR (monitor), mount_entry, volume);
+  if (mount)
+    {
+      monitor->mounts = g_list_prepend (monitor->mounts, mount);
+      g_signal_emit_by_name (monitor, "mount-added", mount);
+    }
+}
+
 static void
 update_mounts (GUnixVolumeMonitor *monitor)
 {
   GList *new_mounts;
   GList *removed, *added;
   GList *l;
-  GUnixMount *mount;
-  GUnixVolume *volume;
-  const char *mount_path;
   
   new_mounts = g_unix_mounts_get (NULL);
   
@@ -385,37 +436,61 @@ update_mounts (GUnixVolumeMonitor *monitor)
 		     &added, &removed);
   
   for (l = removed; l != NULL; l = l->next)
-    {
-      GUnixMountEntry *mount_entry = l->data;
-      
-      mount = find_mount_by_mountpath (monitor, g_unix_mount_get_mount_path (mount_entry));
-      if (mount)
-	{
-	  _g_unix_mount_unmounted (mount);
-	  monitor->mounts = g_list_remove (monitor->mounts, mount);
-	  g_signal_emit_by_name (monitor, "mount-removed", mount);
-	  g_signal_emit_by_name (mount, "unmounted");
-	  g_object_unref (mount);
-	}
-    }
+    mount_entry_removed (monitor, l->data);
   
   for (l = added; l != NULL; l = l->next)
-    {
-      GUnixMountEntry *mount_entry = l->data;
-
-      mount_path = g_unix_mount_get_mount_path (mount_entry);
-      
-      volume = _g_unix_volume_monitor_lookup_volume_for_mount_path (monitor, mount_path);
-      mount = _g_unix_mount_new (G_VOLUME_MONITOR (monitor), mount_entry, volume);
-      if (mount)
-	{
-	  monitor->mounts = g_list_prepend (monitor->mounts, mount);
-	  g_signal_emit_by_name (monitor, "mount-added", mount);
-	}
-    }
+    mount_entry_added (monitor, l->data);
   
   g_list_free (added);
   g_list_free (removed);
   g_list_free_full (monitor->last_mounts, (GDestroyNotify) g_unix_mount_free);
   monitor->last_mounts = new_mounts;
 }
+
+/* Applies the changes reported by the mount monitor to last_mounts, rather
+ * than listing and diffing all the mounts again. The changes may already
+ * be part of last_mounts if it was listed after they happened, so they are
+ * only applied where they make a difference. */
+static void
+mounts_changed_detail (GUnixMountMonitor *mount_monitor,
+                       GPtrArray         *added,
+                       GPtrArray         *removed,
+                       gpointer           user_data)
+{
+  GUnixVolumeMonitor *monitor = user_data;
+  guint i;
+
+  /* Make sure volumes are created before mounts */
+  update_volumes (monitor);
+
+  for (i = 0; i < removed->len; i++)
+    {
+      GUnixMountEntry *mount_entry = g_ptr_array_index (removed, i);
+      GList *link;
+
+      link = g_list_find_custom (monitor->last_mounts, mount_entry,
+                                 (GCompareFunc) g_unix_mount_compare);
+      if (link == NULL)
+        continue;
+
+      mount_entry_removed (monitor, link->data);
+      g_unix_mount_free (link->data);
+      monitor->last_mounts = g_list_delete_link (monitor->last_mounts, link);
+    }
+
+  for (i = 0; i < added->len; i++)
+    {
+      GUnixMountEntry *mount_entry = g_ptr_array_index (added, i);
+
+      if (g_list_find_custom (monitor->last_mounts, mount_entry,
+                              (GCompareFunc) g_unix_mount_compare) != NULL)
+        continue;
+
+      mount_entry = g_unix_mount_copy (mount_entry);
+      monitor->last_mounts = g_list_insert_sorted (monitor->last_mounts, mount_entry,
+                                                   (GCompareFunc) g_unix_mount_compare);
+      mount_entry_added (monitor, mount_entry);
+    }
+
+  monitor->mounts_up_to_date = TRUE;
+}
@@ -39,9 +39,30 @@ enum {
   PROP_0,
   PROP_FORMAT,
   PROP_LEVEL,
-  PROP_FILE_INFO
+  PROP_FILE_INFO,
+  PROP_THREADS
 };
 
+/* Size of the blocks compressed independently in parallel mode, and of the
+ * window of the previous block used to prime each of them */
+#define BLOCK_SIZE (128 * 1024)
+#define DICTIONARY_SIZE (32 * 1024)
+
+typedef struct
+{
+  GBytes *input;
+  GBytes *dictionary;
+  int level;
+  gboolean last;
+
+  /* Set by the worker thread */
+  gint done;  /* (atomic) */
+  GByteArray *output;
+  guint32 check;
+
+  gsize output_pos;
+} Block;
+
 /**
  * GZlibCompressor:
  *
@@ -60,6 +81,19 @@ struct _GZlibCompressor
   z_stream zstream;
   gz_header gzheader;
   GFileInfo *file_info;
+
+  /* Parallel mode, see GZlibCompressor:threads */
+  guint threads;
+  GThreadPool *pool;
+  GMutex lock;
+  GCond cond;
+  GQueue blocks;  /* (element-type Block), in stream order */
+  GByteArray *current;
+  GBytes *previous;
+  guint32 check;
+  guint32 total_in;
+  gboolean started;
+  gboolean input_finished;
 };
 
 static void
@@ -93,6 +127,273 @@ G_DEFINE_TYPE_WITH_CODE (GZlibCompressor, g_zlib_compressor, G_TYPE_OBJECT,
 			 G_IMPLEMENT_INTERFACE (G_TYPE_CONVERTER,
 						g_zlib_compressor_iface_init))
 
+static void
+block_free (Block *block)
+{
+  g_clear_pointer (&block->input, g_bytes_unref);
+  g_clear_pointer (&block->dictionary, g_bytes_unref);
+  g_clear_pointer (&block->output, g_byte_array_unref);
+  g_free (block);
+}
+
+/* A block of literal output, such as the header or trailer */
+static Block *
+block_new_literal (const guint8 *data,
+                   gsize         len)
+{
+  Block *block;
+
+  block = g_new0 (Block, 1);
+  block->output = g_byte_array_sized_new (len);
+  g_byte_array_append (block->output, data, len);
+  block->done = TRUE;
+
+  return block;
+}
+
+/* Runs in the thread pool. Each block is deflated on its own, primed with
+ * the end of the previous block so that the ratio barely suffers, and
+ * ends with a sync flush so that the results can simply be concatenated */
+static void
+compress_block (gpointer data,
+                gpointer user_data)
+{
+  GZlibCompressor *compressor = user_data;
+  Block *block = data;
+  z_stream zstream = { 0, };
+  const guint8 *input;
+  gsize input_len;
+  gsize chunk, used;
+  int res;
+
+  input = g_bytes_get_data (block->input, &input_len);
+
+  res = deflateInit2 (&zstream, block->level, Z_DEFLATED,
+                      -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+  if (res == Z_MEM_ERROR)
+    g_error ("GZlibCompressor: Not enough memory for zlib use");
+
+  if (block->dictionary != NULL)
+    {
+      const guint8 *dictionary;
+      gsize dictionary_len;
+
+      dictionary = g_bytes_get_data (block->dictionary, &dictionary_len);
+      deflateSetDictionary (&zstream, dictionary, dictionary_len);
+    }
+
+  zstream.next_in = (Bytef *) input;
+  zstream.avail_in = input_len;
+
+  chunk = deflateBound (&zstream, input_len) + 16;
+  block->output = g_byte_array_sized_new (chunk);
+
+  do
+    {
+      used = block->output->len;
+      g_byte_array_set_size (block->output, used + chunk);
+      zstream.next_out = block->output->data + used;
+      zstream.avail_out = chunk;
+
+      res = deflate (&zstream, block->last ? Z_FINISH : Z_SYNC_FLUSH);
+      if (res == Z_STREAM_ERROR)
+        g_warning ("unexpected zlib error: %s", zstream.msg);
+
+      g_byte_array_set_size (block->output, used + chunk - zstream.avail_out);
+    }
+  while (zstream.avail_out == 0);
+
+  deflateEnd (&zstream);
+
+  if (compressor->format == G_ZLIB_COMPRESSOR_FORMAT_GZIP)
+    block->check = crc32 (0, input, input_len);
+  else if (compressor->format == G_ZLIB_COMPRESSOR_FORMAT_ZLIB)
+    block->check = adler32 (1, input, input_len);
+
+  g_mutex_lock (&compressor->lock);
+  g_atomic_int_set (&block->done, TRUE);
+  g_cond_broadcast (&compressor->cond);
+  g_mutex_unlock (&compressor->lock);
+}
+
+static void
+wait_for_block (GZlibCompressor *compressor,
+                Block           *block)
+{
+  g_mutex_lock (&compressor->lock);
+  while (!g_atomic_int_get (&block->done))
+    g_cond_wait (&compressor->cond, &compressor->lock);
+  g_mutex_unlock (&compressor->lock);
+}
+
+static void
+submit_block (GZlibCompressor *compressor,
+              gboolean         last)
+{
+  Block *block;
+  gsize len, offset;
+
+  block = g_new0 (Block, 1);
+  block->input = g_byte_array_free_to_bytes (g_steal_pointer (&compressor->current));
+  block->level = compressor->level;
+  block->last = last;
+
+  if (compressor->previous != NULL)
+    {
+      len = g_bytes_get_size (compressor->previous);
+      offset = len > DICTIONARY_SIZE ? len - DICTIONARY_SIZE : 0;
+      if (len > 0)
+        block->dictionary = g_bytes_new_from_bytes (compressor->previous, offset, len - offset);
+      g_bytes_unref (compressor->previous);
+    }
+  compressor->previous = g_bytes_ref (block->input);
+  compressor->current = g_byte_array_sized_new (BLOCK_SIZE);
+
+  g_queue_push_tail (&compressor->blocks, block);
+  g_thread_pool_push (compressor->pool, block, NULL);
+}
+
+static void
+queue_header (GZlibCompressor *compressor)
+{
+  guint8 header[10];
+  int level;
+
+  level = compressor->level == -1 ? 6 : compressor->level;
+
+  if (compressor->format == G_ZLIB_COMPRESSOR_FORMAT_GZIP)
+    {
+      const char *filename = NULL;
+      guint32 mtime = 0;
+      Block *block;
+
+      if (compressor->file_info != NULL)
+        {
+          filename = g_file_info_get_name (compressor->file_info);
+          mtime = (guint32) g_file_info_get_attribute_uint64 (compressor->file_info,
+                                                              G_FILE_ATTRIBUTE_TIME_MODIFIED);
+        }
+
+      header[0] = 0x1f;
+      header[1] = 0x8b;
+      header[2] = Z_DEFLATED;
+      header[3] = filename != NULL ? 0x08 : 0;  /* FNAME */
+      header[4] = mtime & 0xff;
+      header[5] = (mtime >> 8) & 0xff;
+      header[6] = (mtime >> 16) & 0xff;
+      header[7] = (mtime >> 24) & 0xff;
+      header[8] = level == 9 ? 2 : (level == 1 ? 4 : 0);
+      header[9] = 0x03;  /* Unix */
+
+      block = block_new_literal (header, 10);
+      if (filename != NULL)
+        g_byte_array_append (block->output, (const guint8 *) filename, strlen (filename) + 1);
+      g_queue_push_tail (&compressor->blocks, block);
+
+      compressor->check = crc32 (0, NULL, 0);
+    }
+  else if (compressor->format == G_ZLIB_COMPRESSOR_FORMAT_ZLIB)
+    {
+      guint16 value;
+      guint level_flags;
+
+      /* As written by deflate() */
+      if (level < 2)
+        level_flags = 0;
+      else if (level < 6)
+        level_flags = 1;
+      else if (level == 6)
+        level_flags = 2;
+      else
+        level_flags = 3;
+
+      value = ((Z_DEFLATED + ((MAX_WBITS - 8) << 4)) << 8) | (level_flags << 6);
+      value += 31 - (value % 31);
+
+      header[0] = value >> 8;
+      header[1] = value & 0xff;
+      g_queue_push_tail (&compressor->blocks, block_new_literal (header, 2));
+
+      compressor->check = adler32 (0, NULL, 0);
+    }
+
+  compressor->started = TRUE;
+}
+
+static void
+queue_trailer (GZlibCompressor *compressor)
+{
+  guint8 trailer[8];
+  guint32 check = compressor->check;
+  guint32 total_in = compressor->total_in;
+
+  if (compressor->format == G_ZLIB_COMPRESSOR_FORMAT_GZIP)
+    {
+      trailer[0] = check & 0xff;
+      trailer[1] = (check >> 8) & 0xff;
+      trailer[2] = (check >> 16) & 0xff;
+      trailer[3] = (check >> 24) & 0xff;
+      trailer[4] = total_in & 0xff;
+      trailer[5] = (total_in >> 8) & 0xff;
+      trailer[6] = (total_in >> 16) & 0xff;
+      trailer[7] = (total_in >> 24) & 0xff;
+      g_queue_push_tail (&compressor->blocks, block_new_literal (trailer, 8));
+    }
+  else if (compressor->format == G_ZLIB_COMPRESSOR_FORMAT_ZLIB)
+    {
+      trailer[0] = (check >> 24) & 0xff;
+      trailer[1] = (check >> 16) & 0xff;
+      trailer[2] = (check >> 8) & 0xff;
+      trailer[3] = check & 0xff;
+      g_queue_push_tail (&compressor->blocks, block_new_literal (trailer, 4));
+    }
+}
+
+/* Called once all of the output of @block has been written */
+static void
+finish_block (GZlibCompressor *compressor,
+              Block           *block)
+{
+  gsize len;
+
+  if (block->input != NULL)
+    {
+      len = g_bytes_get_size (block->input);
+
+      if (compressor->format == G_ZLIB_COMPRESSOR_FORMAT_GZIP)
+        compressor->check = crc32_combine (compressor->check, block->check, len);
+      else if (compressor->format == G_ZLIB_COMPRESSOR_FORMAT_ZLIB)
+        compressor->check = adler32_combine (compressor->check, block->check, len);
+
+      /* The gzip trailer stores the size modulo 2^32 */
+      compressor->total_in += (guint32) len;
+    }
+
+  if (block->last)
+    queue_trailer (compressor);
+
+  block_free (block);
+}
+
+static void
+clear_blocks (GZlibCompressor *compressor)
+{
+  Block *block;
+
+  while ((block = g_queue_pop_head (&compressor->blocks)) != NULL)
+    {
+      wait_for_block (compressor, block);
+      block_free (block);
+    }
+
+  g_clear_pointer (&compressor->previous, g_bytes_unref);
+  g_byte_array_set_size (compressor->current, 0);
+  compressor->check = 0;
+  compressor->total_in = 0;
+  compressor->started = FALSE;
+  compressor->input_finished = FALSE;
+}
+
 static void
 g_zlib_compressor_finalize (GObject *object)
 {
@@ -102,6 +403,16 @@ g_zlib_compressor_finalize (GObject *object)
 
   deflateEnd (&compressor->zstream);
 
+  if (compressor->pool)
+    {
+      g_thread_pool_free (compressor->pool, FALSE, TRUE);
+      clear_blocks (compressor);
+      g_byte_array_unref (compressor->current);
+    }
+
+  g_mutex_clear (&compressor->lock);
+  g_cond_clear (&compressor->cond);
+
   if (compressor->file_info)
     g_object_unref (compressor->file_info);
 
@@ -133,6 +444,10 @@ g_zlib_compressor_set_property (GObject      *object,
       g_zlib_compressor_set_file_info (compressor, g_value_get_object (value));
       break;
 
+    case PROP_THREADS:
+      compressor->threads = g_value_get_uint (value);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -164,6 +479,10 @@ g_zlib_compressor_get_property (GObject    *object,
       g_value_set_object (value, compressor->file_info);
       break;
 
+    case PROP_THREADS:
+      g_value_set_uint (value, compressor->threads);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -173,6 +492,9 @@ g_zlib_compressor_get_property (GObject    *object,
 static void
 g_zlib_compressor_init (GZlibCompressor *compressor)
 {
+  g_mutex_init (&compressor->lock);
+  g_cond_init (&compressor->cond);
+  g_queue_init (&compressor->blocks);
 }
 
 static void
@@ -209,6 +531,16 @@ g_zlib_compressor_constructed (GObject *object)
     g_warning ("unexpected zlib error: %s", compressor->zstream.msg);
 
   g_zlib_compressor_set_gzheader (compressor);
+
+  if (compressor->threads == 0)
+    compressor->threads = g_get_num_processors ();
+
+  if (compressor->threads > 1)
+    {
+      compressor->pool = g_thread_pool_new (compress_block, compressor,
+                                            compressor->threads, FALSE, NULL);
+      compressor->current = g_byte_array_sized_new (BLOCK_SIZE);
+    }
 }
 
 static void
@@ -268,6 +600,32 @@ g_zlib_compressor_class_init (GZlibCompressorClass *klass)
                                                        G_TYPE_FILE_INFO,
                                                        G_PARAM_READWRITE |
                                                        G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GZlibCompressor:threads:
+   *
+   * The number of threads to compress with, or `0` to use one per
+   * processor.
+   *
+   * With more than one thread, the input is split into blocks of 128 KiB
+   * which are compressed independently on a thread pool, each primed with
+   * the end of the previous block. The output is a single standard stream
+   * in the chosen format, slightly larger than with a single thread.
+   *
+   * In this mode the compressor buffers input until a block is complete,
+   * and output is produced as blocks finish, so a %G_CONVERTER_FLUSH
+   * waits for all pending blocks.
+   *
+   * Since: 2.82
+   */
+  g_object_class_install_property (gobject_class,
+                                   PROP_THREADS,
+                                   g_param_spec_uint ("threads", NULL, NULL,
+                                                      0, G_MAXUINT,
+                                                      1,
+                                                      G_PARAM_READWRITE |
+                                                      G_PARAM_CONSTRUCT_ONLY |
+                                                      G_PARAM_STATIC_STRINGS));
 }
 
 /**
@@ -354,6 +712,9 @@ g_zlib_compressor_reset (GConverter *converter)
   GZlibCompressor *compressor = G_ZLIB_COMPRESSOR (converter);
   int res;
 
+  if (compressor->pool)
+    clear_blocks (compressor);
+
   res = deflateReset (&compressor->zstream);
   if (res != Z_OK)
     g_warning ("unexpected zlib error: %s", compressor->zstream.msg);
@@ -362,6 +723,114 @@ g_zlib_compressor_reset (GConverter *converter)
   g_zlib_compressor_set_gzheader (compressor);
 }
 
+static GConverterResult
+g_zlib_compressor_convert_parallel (GZlibCompressor *compressor,
+                                    const guint8    *inbuf,
+                                    gsize            inbuf_size,
+                                    guint8          *outbuf,
+                                    gsize            outbuf_size,
+                                    GConverterFlags  flags,
+                                    gsize           *bytes_read,
+                                    gsize           *bytes_written,
+                                    GError         **error)
+{
+  gsize read = 0, written = 0;
+  Block *block;
+  gsize n;
+
+  if (!compressor->started)
+    queue_header (compressor);
+
+  while (TRUE)
+    {
+      /* Copy out the output of finished blocks, in stream order */
+      while (written < outbuf_size &&
+             (block = g_queue_peek_head (&compressor->blocks)) != NULL &&
+             g_atomic_int_get (&block->done))
+        {
+          n = MIN (outbuf_size - written, block->output->len - block->output_pos);
+          memcpy (outbuf + written, block->output->data + block->output_pos, n);
+          block->output_pos += n;
+          written += n;
+
+          if (block->output_pos == block->output->len)
+            finish_block (compressor, g_queue_pop_head (&compressor->blocks));
+        }
+
+      if (written == outbuf_size)
+        break;
+
+      if (read < inbuf_size)
+        {
+          /* Bound the memory used by blocks waiting to be written out */
+          if (g_queue_get_length (&compressor->blocks) >= 2 * compressor->threads)
+            {
+              if (written > 0)
+                break;
+              wait_for_block (compressor, g_queue_peek_head (&compressor->blocks));
+              continue;
+            }
+
+          n = MIN (inbuf_size - read, BLOCK_SIZE - compressor->current->len);
+          g_byte_array_append (compressor->current, inbuf + read, n);
+          read += n;
+
+          if (compressor->current->len == BLOCK_SIZE)
+            submit_block (compressor, FALSE);
+
+          continue;
+        }
+
+      if (!(flags & (G_CONVERTER_INPUT_AT_END | G_CONVERTER_FLUSH)))
+        break;
+
+      if ((flags & G_CONVERTER_INPUT_AT_END) && !compressor->input_finished)
+        {
+          submit_block (compressor, TRUE);
+          compressor->input_finished = TRUE;
+          continue;
+        }
+
+      if ((flags & G_CONVERTER_FLUSH) && compressor->current->len > 0)
+        {
+          submit_block (compressor, FALSE);
+          continue;
+        }
+
+      block = g_queue_peek_head (&compressor->blocks);
+      if (block == NULL)
+        {
+          *bytes_read = read;
+          *bytes_written = written;
+
+          if (flags & G_CONVERTER_INPUT_AT_END)
+            return G_CONVERTER_FINISHED;
+          return G_CONVERTER_FLUSHED;
+        }
+
+      if (written > 0)
+        break;
+
+      wait_for_block (compressor, block);
+    }
+
+  if (read == 0 && written == 0)
+    {
+      if (outbuf_size == 0)
+        g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NO_SPACE,
+                             _("Not enough space in destination"));
+      else
+        g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_PARTIAL_INPUT,
+                             _("Need more input"));
+      return G_CONVERTER_ERROR;
+    }
+
+  *bytes_read = read;
+  *bytes_written = written;
+
+  return G_CONVERTER_CONVERTED;
+}
+
 static GConverterResult
 g_zlib_compressor_convert (GConverter *converter,
 			   const void *inbuf,
@@ -379,6 +848,12 @@ g_zlib_compressor_convert (GConverter *converter,
 
   compressor = G_ZLIB_COMPRESSOR (converter);
 
+  if (compressor->pool)
+    return g_zlib_compressor_convert_parallel (compressor, inbuf, inbuf_size,
+                                               outbuf, outbuf_size, flags,
+                                               bytes_read, bytes_written,
+                                               error);
+
   compressor->zstream.next_in = (void *)inbuf;
   compressor->zstream.avail_in = inbuf_size;
 
@@ -0,0 +1,330 @@
+/* GIO - GLib Input, Output and Streaming Library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gzstdcompressor.h"
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "gioerror.h"
+#include "glibintl.h"
+
+
+enum {
+  PROP_0,
+  PROP_LEVEL,
+  PROP_DICTIONARY
+};
+
+/**
+ * GZstdCompressor:
+ *
+ * `GZstdCompressor` is an implementation of [iface@Gio.Converter] that
+ * compresses data using [Zstandard](https://facebook.github.io/zstd/).
+ *
+ * The output is a standard Zstandard frame with a content checksum, which
+ * can be decompressed with [class@Gio.ZstdDecompressor] or the `zstd`
+ * command line tool.
+ *
+ * Zstandard support is optional at build time. If GLib was built without
+ * it, converting data fails with %G_IO_ERROR_NOT_SUPPORTED.
+ *
+ * Since: 2.82
+ */
+
+static void g_zstd_compressor_iface_init          (GConverterIface *iface);
+
+struct _GZstdCompressor
+{
+  GObject parent_instance;
+
+  int level;
+  GBytes *dictionary;
+#ifdef HAVE_ZSTD
+  ZSTD_CCtx *cctx;
+#endif
+};
+
+G_DEFINE_TYPE_WITH_CODE (GZstdCompressor, g_zstd_compressor, G_TYPE_OBJECT,
+			 G_IMPLEMENT_INTERFACE (G_TYPE_CONVERTER,
+						g_zstd_compressor_iface_init))
+
+static void
+g_zstd_compressor_finalize (GObject *object)
+{
+  GZstdCompressor *compressor;
+
+  compressor = G_ZSTD_COMPRESSOR (object);
+
+#ifdef HAVE_ZSTD
+  ZSTD_freeCCtx (compressor->cctx);
+#endif
+
+  g_clear_pointer (&compressor->dictionary, g_bytes_unref);
+
+  G_OBJECT_CLASS (g_zstd_compressor_parent_class)->finalize (object);
+}
+
+static void
+g_zstd_compressor_set_property (GObject      *object,
+                                guint         prop_id,
+                                const GValue *value,
+                                GParamSpec   *pspec)
+{
+  GZstdCompressor *compressor;
+
+  compressor = G_ZSTD_COMPRESSOR (object);
+
+  switch (prop_id)
+    {
+    case PROP_LEVEL:
+      compressor->level = g_value_get_int (value);
+      break;
+
+    case PROP_DICTIONARY:
+      compressor->dictionary = g_value_dup_boxed (value);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+    }
+}
+
+static void
+g_zstd_compressor_get_property (GObject    *object,
+                                guint       prop_id,
+                                GValue     *value,
+                                GParamSpec *pspec)
+{
+  GZstdCompressor *compressor;
+
+  compressor = G_ZSTD_COMPRESSOR (object);
+
+  switch (prop_id)
+    {
+    case PROP_LEVEL:
+      g_value_set_int (value, compressor->level);
+      break;
+
+    case PROP_DICTIONARY:
+      g_value_set_boxed (value, compressor->dictionary);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+    }
+}
+
+static void
+g_zstd_compressor_init (GZstdCompressor *compressor)
+{
+}
+
+static void
+g_zstd_compressor_constructed (GObject *object)
+{
+#ifdef HAVE_ZSTD
+  GZstdCompressor *compressor;
+  size_t res;
+
+  compressor = G_ZSTD_COMPRESSOR (object);
+
+  compressor->cctx = ZSTD_createCCtx ();
+  if (compressor->cctx == NULL)
+    g_error ("GZstdCompressor: Not enough memory for zstd use");
+
+  res = ZSTD_CCtx_setParameter (compressor->cctx, ZSTD_c_compressionLevel,
+                                compressor->level);
+  if (!ZSTD_isError (res))
+    res = ZSTD_CCtx_setParameter (compressor->cctx, ZSTD_c_checksumFlag, 1);
+  if (!ZSTD_isError (res) && compressor->dictionary != NULL)
+    res = ZSTD_CCtx_loadDictionary (compressor->cctx,
+                                    g_bytes_get_data (compressor->dictionary, NULL),
+                                    g_bytes_get_size (compressor->dictionary));
+
+  if (ZSTD_isError (res))
+    g_warning ("unexpected zstd error: %s", ZSTD_getErrorName (res));
+#endif
+
+  G_OBJECT_CLASS (g_zstd_compressor_parent_class)->constructed (object);
+}
+
+static void
+g_zstd_compressor_class_init (GZstdCompressorClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->finalize = g_zstd_compressor_finalize;
+  gobject_class->constructed = g_zstd_compressor_constructed;
+  gobject_class->get_property = g_zstd_compressor_get_property;
+  gobject_class->set_property = g_zstd_compressor_set_property;
+
+  /**
+   * GZstdCompressor:level:
+   *
+   * The level of compression, from `-131072` (fastest) to `22` (most
+   * compression). Negative levels trade compression ratio for speed.
+   * `0` selects the default level.
+   *
+   * Since: 2.82
+   */
+  g_object_class_install_property (gobject_class,
+                                   PROP_LEVEL,
+                                   g_param_spec_int ("level", NULL, NULL,
+                                                     -131072, 22,
+                                                     0,
+                                                     G_PARAM_READWRITE |
+                                                     G_PARAM_CONSTRUCT_ONLY |
+                                                     G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GZstdCompressor:dictionary:
+   *
+   * A dictionary to prime the compressor with, or %NULL. The same
+   * dictionary must be given to the [class@Gio.ZstdDecompressor] used to
+   * decompress the data.
+   *
+   * Dictionaries greatly improve the compression ratio of small inputs
+   * which share a lot of content, such as records of a cache.
+   *
+   * Since: 2.82
+   */
+  g_object_class_install_property (gobject_class,
+                                   PROP_DICTIONARY,
+                                   g_param_spec_boxed ("dictionary", NULL, NULL,
+                                                       G_TYPE_BYTES,
+                                                       G_PARAM_READWRITE |
+                                                       G_PARAM_CONSTRUCT_ONLY |
+                                                       G_PARAM_STATIC_STRINGS));
+}
+
+/**
+ * g_zstd_compressor_new:
+ * @level: compression level, `0` for default
+ * @dictionary: (nullable): a dictionary to compress with, or %NULL
+ *
+ * Creates a new #GZstdCompressor.
+ *
+ * Returns: a new #GZstdCompressor
+ *
+ * Since: 2.82
+ **/
+GZstdCompressor *
+g_zstd_compressor_new (int     level,
+                       GBytes *dictionary)
+{
+  GZstdCompressor *compressor;
+
+  compressor = g_object_new (G_TYPE_ZSTD_COMPRESSOR,
+                             "level", level,
+                             "dictionary", dictionary,
+                             NULL);
+
+  return compressor;
+}
+
+static void
+g_zstd_compressor_reset (GConverter *converter)
+{
+#ifdef HAVE_ZSTD
+  GZstdCompressor *compressor = G_ZSTD_COMPRESSOR (converter);
+
+  /* Keeps the parameters and the dictionary */
+  ZSTD_CCtx_reset (compressor->cctx, ZSTD_reset_session_only);
+#endif
+}
+
+static GConverterResult
+g_zstd_compressor_convert (GConverter *converter,
+                           const void *inbuf,
+                           gsize       inbuf_size,
+                           void       *outbuf,
+                           gsize       outbuf_size,
+                           GConverterFlags flags,
+                           gsize      *bytes_read,
+                           gsize      *bytes_written,
+                           GError    **error)
+{
+#ifdef HAVE_ZSTD
+  GZstdCompressor *compressor;
+  ZSTD_inBuffer input = { inbuf, inbuf_size, 0 };
+  ZSTD_outBuffer output = { outbuf, outbuf_size, 0 };
+  ZSTD_EndDirective mode;
+  size_t res;
+
+  compressor = G_ZSTD_COMPRESSOR (converter);
+
+  mode = ZSTD_e_continue;
+  if (flags & G_CONVERTER_INPUT_AT_END)
+    mode = ZSTD_e_end;
+  else if (flags & G_CONVERTER_FLUSH)
+    mode = ZSTD_e_flush;
+
+  res = ZSTD_compressStream2 (compressor->cctx, &output, &input, mode);
+
+  if (ZSTD_isError (res))
+    {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED,
+                   _("Internal error: %s"), ZSTD_getErrorName (res));
+      return G_CONVERTER_ERROR;
+    }
+
+  *bytes_read = input.pos;
+  *bytes_written = output.pos;
+
+  /* For flushes and the end of the frame, @res is the number of bytes
+   * still waiting for space in the output buffer */
+  if (mode == ZSTD_e_end && res == 0)
+    return G_CONVERTER_FINISHED;
+  if (mode == ZSTD_e_flush && res == 0)
+    return G_CONVERTER_FLUSHED;
+
+  if (input.pos == 0 && output.pos == 0)
+    {
+      if (mode != ZSTD_e_continue || inbuf_size > 0)
+        {
+          g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NO_SPACE,
+                               _("Not enough space in destination"));
+          return G_CONVERTER_ERROR;
+        }
+
+      /* Everything given so far has been buffered */
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_PARTIAL_INPUT,
+                           _("Need more input"));
+      return G_CONVERTER_ERROR;
+    }
+
+  return G_CONVERTER_CONVERTED;
+#else
+  g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                       _("Zstandard compression is not supported"));
+  return G_CONVERTER_ERROR;
+#endif
+}
+
+static void
+g_zstd_compressor_iface_init (GConverterIface *iface)
+{
+  iface->convert = g_zstd_compressor_convert;
+  iface->reset = g_zstd_compressor_reset;
+}
@@ -0,0 +1,280 @@
+/* GIO - GLib Input, Output and Streaming Library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gzstddecompressor.h"
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "gioerror.h"
+#include "glibintl.h"
+
+
+enum {
+  PROP_0,
+  PROP_DICTIONARY
+};
+
+/**
+ * GZstdDecompressor:
+ *
+ * `GZstdDecompressor` is an implementation of [iface@Gio.Converter] that
+ * decompresses data compressed with [Zstandard](https://facebook.github.io/zstd/).
+ *
+ * Zstandard support is optional at build time. If GLib was built without
+ * it, converting data fails with %G_IO_ERROR_NOT_SUPPORTED.
+ *
+ * Since: 2.82
+ */
+
+static void g_zstd_decompressor_iface_init          (GConverterIface *iface);
+
+struct _GZstdDecompressor
+{
+  GObject parent_instance;
+
+  GBytes *dictionary;
+#ifdef HAVE_ZSTD
+  ZSTD_DCtx *dctx;
+#endif
+};
+
+G_DEFINE_TYPE_WITH_CODE (GZstdDecompressor, g_zstd_decompressor, G_TYPE_OBJECT,
+			 G_IMPLEMENT_INTERFACE (G_TYPE_CONVERTER,
+						g_zstd_decompressor_iface_init))
+
+static void
+g_zstd_decompressor_finalize (GObject *object)
+{
+  GZstdDecompressor *decompressor;
+
+  decompressor = G_ZSTD_DECOMPRESSOR (object);
+
+#ifdef HAVE_ZSTD
+  ZSTD_freeDCtx (decompressor->dctx);
+#endif
+
+  g_clear_pointer (&decompressor->dictionary, g_bytes_unref);
+
+  G_OBJECT_CLASS (g_zstd_decompressor_parent_class)->finalize (object);
+}
+
+static void
+g_zstd_decompressor_set_property (GObject      *object,
+                                  guint         prop_id,
+                                  const GValue *value,
+                                  GParamSpec   *pspec)
+{
+  GZstdDecompressor *decompressor;
+
+  decompressor = G_ZSTD_DECOMPRESSOR (object);
+
+  switch (prop_id)
+    {
+    case PROP_DICTIONARY:
+      decompressor->dictionary = g_value_dup_boxed (value);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+    }
+}
+
+static void
+g_zstd_decompressor_get_property (GObject    *object,
+                                  guint       prop_id,
+                                  GValue     *value,
+                                  GParamSpec *pspec)
+{
+  GZstdDecompressor *decompressor;
+
+  decompressor = G_ZSTD_DECOMPRESSOR (object);
+
+  switch (prop_id)
+    {
+    case PROP_DICTIONARY:
+      g_value_set_boxed (value, decompressor->dictionary);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+    }
+}
+
+static void
+g_zstd_decompressor_init (GZstdDecompressor *decompressor)
+{
+}
+
+static void
+g_zstd_decompressor_constructed (GObject *object)
+{
+#ifdef HAVE_ZSTD
+  GZstdDecompressor *decompressor;
+  size_t res;
+
+  decompressor = G_ZSTD_DECOMPRESSOR (object);
+
+  decompressor->dctx = ZSTD_createDCtx ();
+  if (decompressor->dctx == NULL)
+    g_error ("GZstdDecompressor: Not enough memory for zstd use");
+
+  if (decompressor->dictionary != NULL)
+    {
+      res = ZSTD_DCtx_loadDictionary (decompressor->dctx,
+                                      g_bytes_get_data (decompressor->dictionary, NULL),
+                                      g_bytes_get_size (decompressor->dictionary));
+      if (ZSTD_isError (res))
+        g_warning ("unexpected zstd error: %s", ZSTD_getErrorName (res));
+    }
+#endif
+
+  G_OBJECT_CLASS (g_zstd_decompressor_parent_class)->constructed (object);
+}
+
+static void
+g_zstd_decompressor_class_init (GZstdDecompressorClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->finalize = g_zstd_decompressor_finalize;
+  gobject_class->constructed = g_zstd_decompressor_constructed;
+  gobject_class->get_property = g_zstd_decompressor_get_property;
+  gobject_class->set_property = g_zstd_decompressor_set_property;
+
+  /**
+   * GZstdDecompressor:dictionary:
+   *
+   * The dictionary the data was compressed with, or %NULL.
+   *
+   * Since: 2.82
+   */
+  g_object_class_install_property (gobject_class,
+                                   PROP_DICTIONARY,
+                                   g_param_spec_boxed ("dictionary", NULL, NULL,
+                                                       G_TYPE_BYTES,
+                                                       G_PARAM_READWRITE |
+                                                       G_PARAM_CONSTRUCT_ONLY |
+                                                       G_PARAM_STATIC_STRINGS));
+}
+
+/**
+ * g_zstd_decompressor_new:
+ * @dictionary: (nullable): the dictionary the data was compressed with,
+ *   or %NULL
+ *
+ * Creates a new #GZstdDecompressor.
+ *
+ * Returns: a new #GZstdDecompressor
+ *
+ * Since: 2.82
+ **/
+GZstdDecompressor *
+g_zstd_decompressor_new (GBytes *dictionary)
+{
+  GZstdDecompressor *decompressor;
+
+  decompressor = g_object_new (G_TYPE_ZSTD_DECOMPRESSOR,
+                               "dictionary", dictionary,
+                               NULL);
+
+  return decompressor;
+}
+
+static void
+g_zstd_decompressor_reset (GConverter *converter)
+{
+#ifdef HAVE_ZSTD
+  GZstdDecompressor *decompressor = G_ZSTD_DECOMPRESSOR (converter);
+
+  /* Keeps the dictionary */
+  ZSTD_DCtx_reset (decompressor->dctx, ZSTD_reset_session_only);
+#endif
+}
+
+static GConverterResult
+g_zstd_decompressor_convert (GConverter *converter,
+                             const void *inbuf,
+                             gsize       inbuf_size,
+                             void       *outbuf,
+                             gsize       outbuf_size,
+                             GConverterFlags flags,
+                             gsize      *bytes_read,
+                             gsize      *bytes_written,
+                             GError    **error)
+{
+#ifdef HAVE_ZSTD
+  GZstdDecompressor *decompressor;
+  ZSTD_inBuffer input = { inbuf, inbuf_size, 0 };
+  ZSTD_outBuffer output = { outbuf, outbuf_size, 0 };
+  size_t res;
+
+  decompressor = G_ZSTD_DECOMPRESSOR (converter);
+
+  res = ZSTD_decompressStream (decompressor->dctx, &output, &input);
+
+  if (ZSTD_isError (res))
+    {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                   _("Invalid compressed data: %s"), ZSTD_getErrorName (res));
+      return G_CONVERTER_ERROR;
+    }
+
+  *bytes_read = input.pos;
+  *bytes_written = output.pos;
+
+  /* A frame has been completely decoded and flushed */
+  if (res == 0)
+    return G_CONVERTER_FINISHED;
+
+  if (input.pos == 0 && output.pos == 0)
+    {
+      if (inbuf_size > 0)
+        {
+          g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NO_SPACE,
+                               _("Not enough space in destination"));
+          return G_CONVERTER_ERROR;
+        }
+
+      if (flags & G_CONVERTER_FLUSH)
+        return G_CONVERTER_FLUSHED;
+
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_PARTIAL_INPUT,
+                           _("Need more input"));
+      return G_CONVERTER_ERROR;
+    }
+
+  return G_CONVERTER_CONVERTED;
+#else
+  g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                       _("Zstandard compression is not supported"));
+  return G_CONVERTER_ERROR;
+#endif
+}
+
+static void
+g_zstd_decompressor_iface_init (GConverterIface *iface)
+{
+  iface->convert = g_zstd_decompressor_convert;
+  iface->reset = g_zstd_decompressor_reset;
+}
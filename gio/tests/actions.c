@@ -1069,6 +1069,20 @@ test_dbus_export (void)
 
   g_assert_true (compare_action_groups (G_ACTION_GROUP (group), G_ACTION_GROUP (proxy)));
 
+  /* A state that changes back before being sent is not sent at all */
+  n_actions_state_changed = 0;
+  n_actions_enabled_changed = 0;
+  g_simple_action_set_state (action, g_variant_new_boolean (TRUE));
+  g_simple_action_set_state (action, g_variant_new_boolean (FALSE));
+  action = G_SIMPLE_ACTION (g_simple_action_group_lookup (group, "cut"));
+  g_simple_action_set_enabled (action, TRUE);
+
+  while (n_actions_enabled_changed == 0)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpuint (n_actions_state_changed, ==, 0);
+  g_assert_true (compare_action_groups (G_ACTION_GROUP (group), G_ACTION_GROUP (proxy)));
+
   g_simple_action_group_remove (group, "italic");
 
   while (n_actions_removed == 0)
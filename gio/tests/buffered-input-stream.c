@@ -533,6 +533,89 @@ test_seek (void)
   g_object_unref (base);
 }
 
+static void
+check_pattern (GBytes *bytes,
+               gsize   offset)
+{
+  const guint8 *data;
+  gsize i, size;
+
+  data = g_bytes_get_data (bytes, &size);
+  for (i = 0; i < size; i++)
+    g_assert_cmpint (data[i], ==, (offset + i) % 251);
+}
+
+static void
+test_read_bytes (void)
+{
+  GInputStream *base;
+  GInputStream *in;
+  guint8 *data;
+  GBytes *first, *second, *third, *small;
+  const void *peek;
+  gsize available;
+  gsize i;
+  GError *error = NULL;
+
+  data = g_malloc (10000);
+  for (i = 0; i < 10000; i++)
+    data[i] = i % 251;
+
+  base = g_memory_input_stream_new_from_data (data, 10000, g_free);
+  in = g_buffered_input_stream_new_sized (base, 4096);
+
+  /* Fills the buffer and hands out a slice of it */
+  first = g_input_stream_read_bytes (in, 2048, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (g_bytes_get_size (first), ==, 2048);
+  check_pattern (first, 0);
+
+  peek = g_buffered_input_stream_peek_buffer (G_BUFFERED_INPUT_STREAM (in), &available);
+  g_assert_cmpuint (available, ==, 2048);
+  g_assert_true ((const guint8 *) g_bytes_get_data (first, NULL) + 2048 == peek);
+
+  /* Only returns what is buffered */
+  second = g_input_stream_read_bytes (in, 4096, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (g_bytes_get_size (second), ==, 2048);
+  check_pattern (second, 2048);
+
+  /* Refilling must not clobber the slices handed out so far */
+  third = g_input_stream_read_bytes (in, 3000, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (g_bytes_get_size (third), ==, 3000);
+  check_pattern (third, 4096);
+  check_pattern (first, 0);
+  check_pattern (second, 2048);
+
+  /* Small reads are copied */
+  small = g_input_stream_read_bytes (in, 100, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (g_bytes_get_size (small), ==, 100);
+  check_pattern (small, 7096);
+  g_bytes_unref (small);
+
+  /* Compacting the buffer must not clobber them either */
+  g_assert_cmpint (g_buffered_input_stream_fill (G_BUFFERED_INPUT_STREAM (in), 4096, NULL, &error), >, 0);
+  g_assert_no_error (error);
+  check_pattern (third, 4096);
+
+  g_bytes_unref (first);
+  g_bytes_unref (second);
+  g_bytes_unref (third);
+
+  g_assert_cmpint (g_input_stream_skip (in, 10000 - 7196, NULL, &error), ==, 10000 - 7196);
+  g_assert_no_error (error);
+
+  first = g_input_stream_read_bytes (in, 2048, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (g_bytes_get_size (first), ==, 0);
+  g_bytes_unref (first);
+
+  g_object_unref (in);
+  g_object_unref (base);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -548,6 +631,7 @@ main (int   argc,
   g_test_add_func ("/buffered-input-stream/skip", test_skip);
   g_test_add_func ("/buffered-input-stream/skip-async", test_skip_async);
   g_test_add_func ("/buffered-input-stream/seek", test_seek);
+  g_test_add_func ("/buffered-input-stream/read-bytes", test_read_bytes);
   g_test_add_func ("/filter-input-stream/close", test_close);
 
   return g_test_run();
@@ -40,6 +40,47 @@ test_write (void)
   g_object_unref (base);
 }
 
+static void
+test_writev (void)
+{
+  GOutputStream *base;
+  GOutputStream *out;
+  GError *error = NULL;
+  gsize bytes_written;
+  const gchar buffer[] = "abcdefghijklmnopqrstuvwxyz";
+  GOutputVector vectors[3];
+
+  base = g_memory_output_stream_new_resizable ();
+  out = g_buffered_output_stream_new_sized (base, 16);
+
+  /* Small vectors are coalesced in the buffer */
+  vectors[0].buffer = buffer;
+  vectors[0].size = 2;
+  vectors[1].buffer = buffer + 2;
+  vectors[1].size = 4;
+  g_assert_true (g_output_stream_writev (out, vectors, 2, &bytes_written, NULL, &error));
+  g_assert_no_error (error);
+  g_assert_cmpuint (bytes_written, ==, 6);
+  g_assert_cmpint (g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (base)), ==, 0);
+
+  /* Vectors which don’t fit are written along with the buffered data */
+  vectors[0].buffer = buffer + 6;
+  vectors[0].size = 4;
+  vectors[1].buffer = buffer + 10;
+  vectors[1].size = 12;
+  vectors[2].buffer = buffer + 22;
+  vectors[2].size = 0;
+  g_assert_true (g_output_stream_writev (out, vectors, 3, &bytes_written, NULL, &error));
+  g_assert_no_error (error);
+  g_assert_cmpuint (bytes_written, ==, 16);
+  g_assert_cmpint (g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (base)), ==, 22);
+  g_assert_cmpmem (g_memory_output_stream_get_data (G_MEMORY_OUTPUT_STREAM (base)), 22,
+                   buffer, 22);
+
+  g_object_unref (out);
+  g_object_unref (base);
+}
+
 static void
 test_grow (void)
 {
@@ -320,6 +361,7 @@ main (int argc, char *argv[])
   g_test_init (&argc, &argv, NULL);
 
   g_test_add_func ("/buffered-output-stream/write", test_write);
+  g_test_add_func ("/buffered-output-stream/writev", test_writev);
   g_test_add_func ("/buffered-output-stream/grow", test_grow);
   g_test_add_func ("/buffered-output-stream/seek", test_seek);
   g_test_add_func ("/buffered-output-stream/truncate", test_truncate);
@@ -370,6 +370,99 @@ test_cancellable_poll_fd (void)
   g_object_unref (cancellable);
 }
 
+static void
+test_cancellable_poll_fd_reused (void)
+{
+  GCancellable *cancellable;
+  GPollFD pollfd = {.fd = -1};
+  int fd;
+
+#ifdef G_OS_WIN32
+  g_test_skip ("Platform not supported");
+  return;
+#endif
+
+  g_test_summary ("Test that the fd of a cancellable is reused by the next "
+                  "cancellable, and isn’t readable any more");
+
+  cancellable = g_cancellable_new ();
+  fd = g_cancellable_get_fd (cancellable);
+  g_assert_cmpint (fd, >, 0);
+  g_cancellable_cancel (cancellable);
+  g_cancellable_release_fd (cancellable);
+  g_object_unref (cancellable);
+
+  cancellable = g_cancellable_new ();
+  g_assert_true (g_cancellable_make_pollfd (cancellable, &pollfd));
+  g_assert_cmpint (pollfd.fd, ==, fd);
+
+  pollfd.events = G_IO_IN;
+  g_assert_cmpint (g_poll (&pollfd, 1, 0), ==, 0);
+
+  g_cancellable_cancel (cancellable);
+  g_assert_cmpint (g_poll (&pollfd, 1, 0), ==, 1);
+
+  g_cancellable_release_fd (cancellable);
+  g_object_unref (cancellable);
+}
+
+static void
+count_cancelled (GCancellable *cancellable,
+                 gpointer      user_data)
+{
+  guint *n_cancelled = user_data;
+
+  (*n_cancelled)++;
+}
+
+static void
+test_cancellable_child (void)
+{
+  GCancellable *parent, *child, *grandchild, *late_child;
+  guint n_parent = 0, n_child = 0, n_grandchild = 0;
+  gulong id;
+
+  g_test_summary ("Test that cancelling a cancellable cancels its children, "
+                  "but not the other way around");
+
+  parent = g_cancellable_new ();
+  child = g_cancellable_new_child (parent);
+  grandchild = g_cancellable_new_child (child);
+
+  g_cancellable_connect (parent, G_CALLBACK (count_cancelled), &n_parent, NULL);
+  g_cancellable_connect (child, G_CALLBACK (count_cancelled), &n_child, NULL);
+  id = g_cancellable_connect (grandchild, G_CALLBACK (count_cancelled), &n_grandchild, NULL);
+  g_assert_cmpuint (id, !=, 0);
+
+  /* Upwards, nothing happens */
+  g_cancellable_cancel (grandchild);
+  g_assert_true (g_cancellable_is_cancelled (grandchild));
+  g_assert_false (g_cancellable_is_cancelled (child));
+  g_assert_false (g_cancellable_is_cancelled (parent));
+  g_assert_cmpuint (n_grandchild, ==, 1);
+  g_cancellable_reset (grandchild);
+  g_cancellable_disconnect (grandchild, id);
+
+  /* Downwards, the whole tree is cancelled */
+  g_cancellable_cancel (parent);
+  g_assert_true (g_cancellable_is_cancelled (parent));
+  g_assert_true (g_cancellable_is_cancelled (child));
+  g_assert_true (g_cancellable_is_cancelled (grandchild));
+  g_assert_cmpuint (n_parent, ==, 1);
+  g_assert_cmpuint (n_child, ==, 1);
+  g_assert_cmpuint (n_grandchild, ==, 1);
+
+  /* Children of a cancelled cancellable start out cancelled */
+  late_child = g_cancellable_new_child (parent);
+  g_assert_true (g_cancellable_is_cancelled (late_child));
+
+  /* Children and parents don’t keep each other alive */
+  g_object_unref (child);
+  g_assert_finalize_object (parent);
+  g_assert_finalize_object (grandchild);
+  g_assert_finalize_object (late_child);
+}
+
 static void
 test_cancellable_cancelled_poll_fd (void)
 {
@@ -807,6 +900,8 @@ main (int argc, char *argv[])
   g_test_add_func ("/cancellable/resets-on-cancel-callback-hangs", test_cancellable_reset_on_cancelled_callback_hangs);
   g_test_add_func ("/cancellable/poll-fd", test_cancellable_poll_fd);
   g_test_add_func ("/cancellable/poll-fd-cancelled", test_cancellable_cancelled_poll_fd);
+  g_test_add_func ("/cancellable/poll-fd-reused", test_cancellable_poll_fd_reused);
+  g_test_add_func ("/cancellable/child", test_cancellable_child);
   g_test_add_func ("/cancellable/poll-fd-cancelled-threaded", test_cancellable_cancelled_poll_fd_threaded);
   g_test_add_func ("/cancellable/cancel-reset-races", test_cancellable_cancel_reset_races);
   g_test_add_func ("/cancellable/cancel-reset-connect-races", test_cancellable_cancel_reset_connect_races);
@@ -945,6 +945,57 @@ G_END_DECLS
         self.assertEqual(result.out.strip().count("GDBusCallFlags call_flags,"), 2)
         self.assertEqual(result.out.strip().count("gint timeout_msec,"), 2)
 
+    def test_fast_marshalling(self):
+        """Test that --c-generate-fast-marshalling packs and unpacks arguments
+        with the type-specific GVariant functions, and only then."""
+        interface_xml = """
+            <node>
+              <interface name="org.project.UsefulInterface">
+                <method name="UsefulMethod">
+                  <arg name="count" type="i" direction="in"/>
+                  <arg name="name" type="s" direction="in"/>
+                  <arg name="names" type="as" direction="out"/>
+                  <arg name="pair" type="(ii)" direction="out"/>
+                </method>
+                <signal name="UsefulSignal">
+                  <arg name="data" type="ay"/>
+                </signal>
+              </interface>
+            </node>"""
+
+        result = self.runCodegenWithInterface(
+            interface_xml, "--output", "-", "--body"
+        )
+        self.assertEqual("", result.err)
+        self.assertEqual(result.out.strip().count("g_variant_new_tuple ("), 0)
+        self.assertEqual(result.out.strip().count('g_variant_new ("(is)"'), 2)
+
+        result = self.runCodegenWithInterface(
+            interface_xml,
+            "--output",
+            "-",
+            "--body",
+            "--c-generate-fast-marshalling",
+        )
+        self.assertEqual("", result.err)
+        self.assertEqual(result.out.strip().count('g_variant_new ("(is)"'), 0)
+        self.assertEqual(result.out.strip().count('g_variant_get (_ret,'), 0)
+        # two method calls, the completer and the signal
+        self.assertEqual(result.out.strip().count("g_variant_new_tuple ("), 4)
+        self.assertEqual(
+            result.out.strip().count("g_variant_new_int32 (arg_count)"), 2
+        )
+        self.assertEqual(
+            result.out.strip().count("g_variant_dup_strv (_child, NULL)"), 2
+        )
+        self.assertEqual(
+            result.out.strip().count("*out_pair = g_variant_get_child_value (_ret, 1)"),
+            2,
+        )
+        self.assertEqual(
+            result.out.strip().count("g_variant_new_bytestring (arg_data)"), 1
+        )
+
     def test_generate_signal_id_simple_signal(self):
         """Test that signals IDs are used to emit signals"""
         interface_xml = """
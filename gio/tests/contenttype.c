@@ -147,6 +147,46 @@ test_guess (void)
 #endif /* G_OS_WIN32 */
 }
 
+static void
+test_guess_many (void)
+{
+  const gchar *filenames[] = {
+    "foo.txt",
+    "/some/where/image.png",
+    "some-dir/",
+    "no-extension",
+    "archive.tar.gz",
+    NULL,
+  };
+  gboolean uncertain[G_N_ELEMENTS (filenames) - 1];
+  gchar **types;
+  gsize i;
+
+  g_test_summary ("Test that g_content_types_guess_many() gives the same "
+                  "results as g_content_type_guess() on each name");
+
+  types = g_content_types_guess_many (filenames, uncertain);
+  g_assert_cmpuint (g_strv_length (types), ==, G_N_ELEMENTS (filenames) - 1);
+
+  for (i = 0; filenames[i] != NULL; i++)
+    {
+      gboolean expected_uncertain;
+      gchar *expected;
+
+      expected = g_content_type_guess (filenames[i], NULL, 0, &expected_uncertain);
+      g_assert_cmpstr (types[i], ==, expected);
+      g_assert_cmpint (uncertain[i], ==, expected_uncertain);
+      g_free (expected);
+    }
+
+  g_strfreev (types);
+
+  types = g_content_types_guess_many ((const gchar * const *) &filenames[G_N_ELEMENTS (filenames) - 1], NULL);
+  g_assert_nonnull (types);
+  g_assert_null (types[0]);
+  g_strfreev (types);
+}
+
 static void
 test_unknown (void)
 {
@@ -528,6 +568,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/contenttype/guess", test_guess);
   g_test_add_func ("/contenttype/guess_svg_from_data", test_guess_svg_from_data);
   g_test_add_func ("/contenttype/mime_from_content", test_mime_from_content);
+  g_test_add_func ("/contenttype/guess-many", test_guess_many);
   g_test_add_func ("/contenttype/unknown", test_unknown);
   g_test_add_func ("/contenttype/subtype", test_subtype);
   g_test_add_func ("/contenttype/list", test_list);
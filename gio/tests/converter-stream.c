@@ -808,6 +808,248 @@ test_roundtrip (gconstpointer data)
   g_free (data0);
 }
 
+static void
+test_direct_base (void)
+{
+  GError *error = NULL;
+  GString *text;
+  GByteArray *compressed;
+  GInputStream *base, *buffered, *cistream;
+  GOutputStream *ostream, *costream;
+  GConverter *compressor, *decompressor;
+  GString *result;
+  char buf[100];
+  gssize res;
+  guint i;
+
+  text = g_string_new (NULL);
+  for (i = 0; i < 10000; i++)
+    g_string_append_printf (text, "line %u\n", i);
+
+  ostream = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+  compressor = G_CONVERTER (g_zlib_compressor_new (G_ZLIB_COMPRESSOR_FORMAT_GZIP, -1));
+  costream = g_converter_output_stream_new (ostream, compressor);
+  g_output_stream_write_all (costream, text->str, text->len, NULL, NULL, &error);
+  g_assert_no_error (error);
+  g_output_stream_close (costream, NULL, &error);
+  g_assert_no_error (error);
+
+  compressed = g_byte_array_new ();
+  g_byte_array_append (compressed,
+                       g_memory_output_stream_get_data (G_MEMORY_OUTPUT_STREAM (ostream)),
+                       g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (ostream)));
+  g_byte_array_append (compressed, (const guint8 *) "trailer", 7);
+  g_object_unref (costream);
+  g_object_unref (compressor);
+  g_object_unref (ostream);
+
+  /* Decompress in small reads from a buffered base stream; the data is
+   * converted straight out of the base stream's buffer, so the converter
+   * stream must only consume what the decompressor needs */
+  base = g_memory_input_stream_new_from_data (compressed->data, compressed->len, NULL);
+  buffered = g_buffered_input_stream_new_sized (base, 1000);
+  decompressor = G_CONVERTER (g_zlib_decompressor_new (G_ZLIB_COMPRESSOR_FORMAT_GZIP));
+  cistream = g_converter_input_stream_new (buffered, decompressor);
+
+  result = g_string_new (NULL);
+  do
+    {
+      res = g_input_stream_read (cistream, buf, sizeof (buf), NULL, &error);
+      g_assert_no_error (error);
+      g_string_append_len (result, buf, res);
+    }
+  while (res > 0);
+
+  g_assert_cmpmem (result->str, result->len, text->str, text->len);
+
+  res = g_input_stream_read (buffered, buf, sizeof (buf), NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpmem (buf, res, "trailer", 7);
+
+  g_object_unref (cistream);
+  g_object_unref (decompressor);
+  g_object_unref (buffered);
+  g_object_unref (base);
+  g_byte_array_unref (compressed);
+  g_string_free (result, TRUE);
+  g_string_free (text, TRUE);
+}
+
+static void
+test_roundtrip_threaded (gconstpointer data)
+{
+  const CompressorTest *test = data;
+  GError *error = NULL;
+  GString *text;
+  GInputStream *istream1, *cistream1;
+  GOutputStream *ostream1, *ostream2, *costream1;
+  GConverter *compressor, *decompressor;
+  GFileInfo *info;
+  gsize data1_size;
+  gpointer data1;
+  guint threads;
+  guint i;
+
+  /* Several blocks worth, and not a multiple of the block size */
+  text = g_string_new (NULL);
+  for (i = 0; i < 40000; i++)
+    g_string_append_printf (text, "%u: %08x\n", i, g_random_int_range (0, 1000));
+
+  ostream1 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+  compressor = g_object_new (G_TYPE_ZLIB_COMPRESSOR,
+                             "format", test->format,
+                             "level", test->level,
+                             "threads", 4,
+                             NULL);
+  g_object_get (compressor, "threads", &threads, NULL);
+  g_assert_cmpuint (threads, ==, 4);
+
+  info = g_file_info_new ();
+  g_file_info_set_name (info, "foo");
+  g_zlib_compressor_set_file_info (G_ZLIB_COMPRESSOR (compressor), info);
+  g_object_unref (info);
+
+  costream1 = g_converter_output_stream_new (ostream1, compressor);
+
+  /* Write in odd sized pieces, with a flush in the middle */
+  for (i = 0; i < text->len; i += MIN (text->len - i, 77777))
+    {
+      g_output_stream_write_all (costream1, text->str + i, MIN (text->len - i, 77777),
+                                 NULL, NULL, &error);
+      g_assert_no_error (error);
+
+      if (i == 77777 * 2)
+        {
+          g_output_stream_flush (costream1, NULL, &error);
+          g_assert_no_error (error);
+        }
+    }
+  g_output_stream_close (costream1, NULL, &error);
+  g_assert_no_error (error);
+  g_object_unref (costream1);
+  g_object_unref (compressor);
+
+  data1 = g_memory_output_stream_steal_data (G_MEMORY_OUTPUT_STREAM (ostream1));
+  data1_size = g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (ostream1));
+  g_assert_cmpuint (data1_size, <, text->len / 2);
+  g_object_unref (ostream1);
+
+  istream1 = g_memory_input_stream_new_from_data (data1, data1_size, g_free);
+  decompressor = G_CONVERTER (g_zlib_decompressor_new (test->format));
+  cistream1 = g_converter_input_stream_new (istream1, decompressor);
+  ostream2 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+
+  g_output_stream_splice (ostream2, cistream1, 0, NULL, &error);
+  g_assert_no_error (error);
+
+  g_assert_cmpmem (text->str, text->len,
+                   g_memory_output_stream_get_data (G_MEMORY_OUTPUT_STREAM (ostream2)),
+                   g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (ostream2)));
+
+  if (test->format == G_ZLIB_COMPRESSOR_FORMAT_GZIP)
+    {
+      info = g_zlib_decompressor_get_file_info (G_ZLIB_DECOMPRESSOR (decompressor));
+      g_assert_nonnull (info);
+      g_assert_cmpstr (g_file_info_get_name (info), ==, "foo");
+    }
+
+  g_object_unref (cistream1);
+  g_object_unref (istream1);
+  g_object_unref (ostream2);
+  g_object_unref (decompressor);
+  g_string_free (text, TRUE);
+}
+
+static void
+test_zstd_roundtrip (void)
+{
+  GError *error = NULL;
+  GString *text;
+  GBytes *dictionary;
+  GInputStream *istream0, *istream1, *cistream1;
+  GOutputStream *ostream1, *ostream2, *costream1;
+  GConverter *compressor, *decompressor;
+  gsize data1_size;
+  gpointer data1;
+  GBytes *dict;
+  gint lvl;
+  guint i;
+
+  text = g_string_new (NULL);
+  for (i = 0; i < 10000; i++)
+    g_string_append_printf (text, "line %u: the quick brown fox jumps over the lazy dog\n", i);
+  dictionary = g_bytes_new_static ("the quick brown fox jumps over the lazy dog", 43);
+
+  istream0 = g_memory_input_stream_new_from_data (text->str, text->len, NULL);
+  ostream1 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+  compressor = G_CONVERTER (g_zstd_compressor_new (3, dictionary));
+  costream1 = g_converter_output_stream_new (ostream1, compressor);
+
+  g_output_stream_splice (costream1, istream0, 0, NULL, &error);
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED))
+    {
+      g_test_skip ("GLib was built without Zstandard support");
+      g_clear_error (&error);
+      g_object_unref (costream1);
+      g_object_unref (compressor);
+      g_object_unref (ostream1);
+      g_object_unref (istream0);
+      g_bytes_unref (dictionary);
+      g_string_free (text, TRUE);
+      return;
+    }
+  g_assert_no_error (error);
+  g_object_unref (costream1);
+
+  g_object_get (compressor, "level", &lvl, "dictionary", &dict, NULL);
+  g_assert_cmpint (lvl, ==, 3);
+  g_assert_true (dict == dictionary);
+  g_bytes_unref (dict);
+  g_object_unref (compressor);
+
+  data1 = g_memory_output_stream_steal_data (G_MEMORY_OUTPUT_STREAM (ostream1));
+  data1_size = g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (ostream1));
+  g_assert_cmpuint (data1_size, <, text->len / 4);
+  g_object_unref (ostream1);
+  g_object_unref (istream0);
+
+  istream1 = g_memory_input_stream_new_from_data (data1, data1_size, NULL);
+  decompressor = G_CONVERTER (g_zstd_decompressor_new (dictionary));
+  cistream1 = g_converter_input_stream_new (istream1, decompressor);
+  ostream2 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+
+  g_output_stream_splice (ostream2, cistream1, 0, NULL, &error);
+  g_assert_no_error (error);
+
+  g_assert_cmpmem (text->str, text->len,
+                   g_memory_output_stream_get_data (G_MEMORY_OUTPUT_STREAM (ostream2)),
+                   g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (ostream2)));
+
+  g_object_unref (cistream1);
+  g_object_unref (istream1);
+  g_object_unref (ostream2);
+
+  /* Without the dictionary, the data cannot be decompressed */
+  g_converter_reset (decompressor);
+  g_object_unref (decompressor);
+  decompressor = G_CONVERTER (g_zstd_decompressor_new (NULL));
+  istream1 = g_memory_input_stream_new_from_data (data1, data1_size, NULL);
+  cistream1 = g_converter_input_stream_new (istream1, decompressor);
+  ostream2 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+
+  g_output_stream_splice (ostream2, cistream1, 0, NULL, &error);
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+  g_clear_error (&error);
+
+  g_object_unref (cistream1);
+  g_object_unref (istream1);
+  g_object_unref (ostream2);
+  g_object_unref (decompressor);
+  g_free (data1);
+  g_bytes_unref (dictionary);
+  g_string_free (text, TRUE);
+}
+
 typedef struct {
   const gchar *path;
   const gchar *charset_in;
@@ -1201,6 +1443,11 @@ main (int   argc,
     { "/converter-output-stream/roundtrip/raw-0", G_ZLIB_COMPRESSOR_FORMAT_RAW, 0 },
     { "/converter-output-stream/roundtrip/raw-9", G_ZLIB_COMPRESSOR_FORMAT_RAW, 9 },
   };
+  CompressorTest threaded_tests[] = {
+    { "/converter-output-stream/roundtrip-threaded/zlib", G_ZLIB_COMPRESSOR_FORMAT_ZLIB, 6 },
+    { "/converter-output-stream/roundtrip-threaded/gzip", G_ZLIB_COMPRESSOR_FORMAT_GZIP, 6 },
+    { "/converter-output-stream/roundtrip-threaded/raw", G_ZLIB_COMPRESSOR_FORMAT_RAW, 6 },
+  };
   CompressorTest truncation_tests[] = {
     { "/converter-input-stream/truncation/zlib", G_ZLIB_COMPRESSOR_FORMAT_ZLIB, 0 },
     { "/converter-input-stream/truncation/gzip", G_ZLIB_COMPRESSOR_FORMAT_GZIP, 0 },
@@ -1219,16 +1466,21 @@ main (int   argc,
   g_test_add_func ("/converter/basics", test_converter_basics);
   g_test_add_func ("/converter-input-stream/expander", test_expander);
   g_test_add_func ("/converter-input-stream/compressor", test_compressor);
+  g_test_add_func ("/converter-input-stream/direct-base", test_direct_base);
 
   for (i = 0; i < G_N_ELEMENTS (compressor_tests); i++)
     g_test_add_data_func (compressor_tests[i].path, &compressor_tests[i], test_roundtrip);
 
+  for (i = 0; i < G_N_ELEMENTS (threaded_tests); i++)
+    g_test_add_data_func (threaded_tests[i].path, &threaded_tests[i], test_roundtrip_threaded);
+
   for (i = 0; i < G_N_ELEMENTS (truncation_tests); i++)
     g_test_add_data_func (truncation_tests[i].path, &truncation_tests[i], test_truncation);
 
   for (i = 0; i < G_N_ELEMENTS (charset_tests); i++)
     g_test_add_data_func (charset_tests[i].path, &charset_tests[i], test_charset);
 
+  g_test_add_func ("/converter-output-stream/roundtrip/zstd", test_zstd_roundtrip);
   g_test_add_func ("/converter-stream/pollable", test_converter_pollable);
   g_test_add_func ("/converter-stream/leftover", test_converter_leftover);
 
@@ -152,6 +152,54 @@ test_read_lines_any (void)
   test_read_lines (G_DATA_STREAM_NEWLINE_TYPE_ANY);
 }
 
+static void
+test_read_line_borrowed (void)
+{
+  const struct {
+    GDataStreamNewlineType newline_type;
+    const char *data;
+    const char *lines[7];
+  } tests[] = {
+    { G_DATA_STREAM_NEWLINE_TYPE_LF, "ab\ncd\r\n\nefghi", { "ab", "cd\r", "", "efghi", NULL } },
+    { G_DATA_STREAM_NEWLINE_TYPE_CR, "ab\rcd\n\r\refghi\r", { "ab", "cd\n", "", "efghi", NULL } },
+    { G_DATA_STREAM_NEWLINE_TYPE_CR_LF, "ab\r\ncd\re\nf\r\r\n\r\n", { "ab", "cd\re\nf\r", "", NULL } },
+    { G_DATA_STREAM_NEWLINE_TYPE_ANY, "ab\r\ncd\ref\n\r\rgh\r", { "ab", "cd", "ef", "", "", "gh\r", NULL } },
+  };
+  gsize i, j;
+
+  for (i = 0; i < G_N_ELEMENTS (tests); i++)
+    {
+      GInputStream *base_stream;
+      GDataInputStream *stream;
+      GError *error = NULL;
+      const char *line;
+      gsize length;
+
+      base_stream = g_memory_input_stream_new_from_data (tests[i].data, -1, NULL);
+      stream = g_data_input_stream_new (base_stream);
+      g_data_input_stream_set_newline_type (stream, tests[i].newline_type);
+
+      /* A tiny buffer makes line endings straddle fills */
+      g_buffered_input_stream_set_buffer_size (G_BUFFERED_INPUT_STREAM (stream), 2);
+
+      for (j = 0; tests[i].lines[j] != NULL; j++)
+        {
+          line = g_data_input_stream_read_line_borrowed (stream, &length, NULL, &error);
+          g_assert_no_error (error);
+          g_assert_nonnull (line);
+          g_assert_cmpmem (line, length, tests[i].lines[j], strlen (tests[i].lines[j]));
+        }
+
+      line = g_data_input_stream_read_line_borrowed (stream, &length, NULL, &error);
+      g_assert_no_error (error);
+      g_assert_null (line);
+      g_assert_cmpuint (length, ==, 0);
+
+      g_object_unref (stream);
+      g_object_unref (base_stream);
+    }
+}
+
 static void
 test_read_lines_LF_valid_utf8 (void)
 {
@@ -501,6 +549,7 @@ main (int   argc,
   g_test_add_func ("/data-input-stream/read-lines-CR", test_read_lines_CR);
   g_test_add_func ("/data-input-stream/read-lines-CR-LF", test_read_lines_CR_LF);
   g_test_add_func ("/data-input-stream/read-lines-any", test_read_lines_any);
+  g_test_add_func ("/data-input-stream/read-line-borrowed", test_read_line_borrowed);
   g_test_add_func ("/data-input-stream/read-until", test_read_until);
   g_test_add_func ("/data-input-stream/read-upto", test_read_upto);
   g_test_add_func ("/data-input-stream/read-int", test_read_int);
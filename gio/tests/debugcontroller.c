@@ -384,6 +384,131 @@ test_dbus_properties (void)
   g_clear_object (&bus);
 }
 
+static GVariant *
+call_get_statistics (GDBusConnection  *remote_connection,
+                     GDBusConnection  *controller_connection,
+                     GError          **error)
+{
+  GAsyncResult *result = NULL;
+  GVariant *reply;
+
+  g_dbus_connection_call (remote_connection,
+                          g_dbus_connection_get_unique_name (controller_connection),
+                          "/org/gtk/Debugging",
+                          "org.gtk.Debugging",
+                          "GetStatistics",
+                          NULL,
+                          G_VARIANT_TYPE ("(a{sv})"),
+                          G_DBUS_CALL_FLAGS_NONE,
+                          -1,
+                          NULL,
+                          async_result_cb,
+                          &result);
+
+  while (result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+
+  reply = g_dbus_connection_call_finish (remote_connection, result, error);
+  g_clear_object (&result);
+
+  return reply;
+}
+
+static void
+test_dbus_statistics (void)
+{
+  GTestDBus *bus;
+  GDBusConnection *controller_connection = NULL;
+  GDBusConnection *remote_connection = NULL;
+  GDebugControllerDBus *controller = NULL;
+  GVariant *reply = NULL;
+  GVariant *statistics = NULL;
+  GVariant *members = NULL;
+  GVariant *peers = NULL;
+  GVariant *counters = NULL;
+  guint64 value;
+  GError *local_error = NULL;
+  gulong handler_id;
+
+  g_test_summary ("Test retrieving message statistics from a #GDebugControllerDBus.");
+
+  bus = g_test_dbus_new (G_TEST_DBUS_NONE);
+  g_test_dbus_up (bus);
+
+  controller_connection = g_bus_get_sync (G_BUS_TYPE_SESSION, NULL, &local_error);
+  g_assert_no_error (local_error);
+
+  remote_connection = g_dbus_connection_new_for_address_sync (g_test_dbus_get_bus_address (bus),
+                                                              G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT |
+                                                              G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION,
+                                                              NULL,
+                                                              NULL,
+                                                              &local_error);
+  g_assert_no_error (local_error);
+
+  controller = g_debug_controller_dbus_new (controller_connection, NULL, &local_error);
+  g_assert_no_error (local_error);
+
+  /* Statistics follow the debug-enabled property. */
+  g_assert_false (g_dbus_connection_get_statistics_enabled (controller_connection));
+  g_debug_controller_set_debug_enabled (G_DEBUG_CONTROLLER (controller), TRUE);
+  g_assert_true (g_dbus_connection_get_statistics_enabled (controller_connection));
+
+  /* Reading them needs authorisation too. */
+  reply = call_get_statistics (remote_connection, controller_connection, &local_error);
+  g_assert_error (local_error, G_DBUS_ERROR, G_DBUS_ERROR_ACCESS_DENIED);
+  g_assert_null (reply);
+  g_clear_error (&local_error);
+
+  handler_id = g_signal_connect (controller, "authorize", G_CALLBACK (authorize_true_cb), NULL);
+
+  reply = call_get_statistics (remote_connection, controller_connection, &local_error);
+  g_assert_no_error (local_error);
+  g_variant_get (reply, "(@a{sv})", &statistics);
+
+  /* Both calls have been received, and the first one has been handled. */
+  members = g_variant_lookup_value (statistics, "members", G_VARIANT_TYPE ("a{sa{st}}"));
+  g_assert_nonnull (members);
+  counters = g_variant_lookup_value (members, "org.gtk.Debugging.GetStatistics", G_VARIANT_TYPE ("a{st}"));
+  g_assert_nonnull (counters);
+  g_assert_true (g_variant_lookup (counters, "messages-in", "t", &value));
+  g_assert_cmpuint (value, ==, 2);
+  g_assert_true (g_variant_lookup (counters, "bytes-in", "t", &value));
+  g_assert_cmpuint (value, >, 0);
+  g_assert_true (g_variant_lookup (counters, "handler-calls", "t", &value));
+  g_assert_cmpuint (value, >=, 1);
+  g_clear_pointer (&counters, g_variant_unref);
+
+  peers = g_variant_lookup_value (statistics, "peers", G_VARIANT_TYPE ("a{sa{st}}"));
+  g_assert_nonnull (peers);
+  counters = g_variant_lookup_value (peers, g_dbus_connection_get_unique_name (remote_connection), G_VARIANT_TYPE ("a{st}"));
+  g_assert_nonnull (counters);
+  g_assert_true (g_variant_lookup (counters, "messages-in", "t", &value));
+  g_assert_cmpuint (value, ==, 2);
+  g_assert_true (g_variant_lookup (counters, "messages-out", "t", &value));
+  g_assert_cmpuint (value, >=, 1);
+  g_clear_pointer (&counters, g_variant_unref);
+
+  g_clear_pointer (&peers, g_variant_unref);
+  g_clear_pointer (&members, g_variant_unref);
+  g_clear_pointer (&statistics, g_variant_unref);
+  g_clear_pointer (&reply, g_variant_unref);
+
+  g_signal_handler_disconnect (controller, handler_id);
+
+  g_debug_controller_set_debug_enabled (G_DEBUG_CONTROLLER (controller), FALSE);
+  g_assert_false (g_dbus_connection_get_statistics_enabled (controller_connection));
+
+  g_debug_controller_dbus_stop (controller);
+  while (g_main_context_iteration (NULL, FALSE));
+  g_assert_finalize_object (controller);
+  g_clear_object (&controller_connection);
+  g_clear_object (&remote_connection);
+
+  g_test_dbus_down (bus);
+  g_clear_object (&bus);
+}
+
 static GLogWriterOutput
 noop_log_writer_cb (GLogLevelFlags   log_level,
                     const GLogField *fields,
@@ -407,6 +532,7 @@ main (int   argc,
   g_test_add_func ("/debug-controller/dbus/basic", test_dbus_basic);
   g_test_add_func ("/debug-controller/dbus/duplicate", test_dbus_duplicate);
   g_test_add_func ("/debug-controller/dbus/properties", test_dbus_properties);
+  g_test_add_func ("/debug-controller/dbus/statistics", test_dbus_statistics);
 
   return g_test_run ();
 }
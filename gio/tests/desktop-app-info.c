@@ -890,6 +890,8 @@ assert_implementations (const gchar *interface,
 static void
 test_search (void)
 {
+  gchar *cache_dir;
+
   assert_list ("", FALSE, FALSE, NULL, NULL);
   assert_list (ALL_USR_APPS, TRUE, FALSE, NULL, NULL);
   assert_list (ALL_HOME_APPS, FALSE, TRUE, NULL, NULL);
@@ -992,6 +994,12 @@ test_search (void)
   /* the user's eog.desktop has no translations... */
   assert_search ("foliumi", "nautilus.desktop\n"
                             "kde4-konqbrowser.desktop\n", TRUE, TRUE, "en_US.UTF-8", "eo");
+
+  /* Most of the searches above were answered from the on-disk index
+   * written by the first search of each directory */
+  cache_dir = g_build_filename (g_get_user_cache_dir (), "glib-2.0", "desktop-index", NULL);
+  g_assert_true (g_file_test (cache_dir, G_FILE_TEST_IS_DIR));
+  g_free (cache_dir);
 }
 
 static void
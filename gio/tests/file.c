@@ -9,6 +9,7 @@
 #include <glib/gstdio.h>
 #ifdef G_OS_UNIX
 #include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 typedef struct
@@ -122,6 +123,61 @@ test_child (void)
   g_object_unref (file);
 }
 
+static void
+test_canonical_path (void)
+{
+#ifdef G_OS_UNIX
+  const struct {
+    const gchar *path;
+    const gchar *child;
+    const gchar *expected_path;
+    const gchar *expected_child;
+  } tests[] = {
+    { "/", "a", "/", "/a" },
+    { "/a/b", "c", "/a/b", "/a/b/c" },
+    { "/a/./b/../c", "d", "/a/c", "/a/c/d" },
+    { "/a//b/", ".", "/a/b", "/a/b" },
+    { "/a/b", "..", "/a/b", "/a" },
+    { "/a/b", ".hidden", "/a/b", "/a/b/.hidden" },
+    { "/a/b", "c/../d", "/a/b", "/a/b/d" },
+  };
+  gsize i;
+
+  g_test_summary ("Check that paths are canonical whether or not the "
+                  "canonicalization is skipped for simple cases");
+
+  for (i = 0; i < G_N_ELEMENTS (tests); i++)
+    {
+      GFile *file, *child, *dup, *parent;
+
+      file = g_file_new_for_path (tests[i].path);
+      g_assert_cmpstr (g_file_peek_path (file), ==, tests[i].expected_path);
+
+      child = g_file_get_child (file, tests[i].child);
+      g_assert_cmpstr (g_file_peek_path (child), ==, tests[i].expected_child);
+
+      dup = g_file_dup (child);
+      g_assert_true (g_file_equal (dup, child));
+      g_assert_cmpstr (g_file_peek_path (dup), ==, tests[i].expected_child);
+
+      parent = g_file_get_parent (child);
+      if (parent != NULL)
+        {
+          gchar *expected_parent = g_path_get_dirname (tests[i].expected_child);
+          g_assert_cmpstr (g_file_peek_path (parent), ==, expected_parent);
+          g_free (expected_parent);
+        }
+
+      g_clear_object (&parent);
+      g_object_unref (dup);
+      g_object_unref (child);
+      g_object_unref (file);
+    }
+#else
+  g_test_skip ("Canonical paths are only tested on Unix");
+#endif
+}
+
 static void
 test_empty_path (void)
 {
@@ -2607,6 +2663,327 @@ test_copy_progress (void)
   g_clear_object (&dest_tmpfile);
 }
 
+static void
+test_copy_reflink (void)
+{
+  GFile *src_tmpfile = NULL;
+  GFile *dest_tmpfile = NULL;
+  GFileIOStream *iostream;
+  GError *local_error = NULL;
+  const char *content = "reflink me";
+  const char *existing = "keep me";
+  char *contents = NULL;
+  gsize length;
+  gboolean res;
+
+  g_test_summary ("Test G_FILE_COPY_NO_REFLINK and G_FILE_COPY_REFLINK_ONLY");
+
+  src_tmpfile = g_file_new_tmp ("tmp-copy-reflinkXXXXXX",
+                                &iostream, &local_error);
+  g_assert_no_error (local_error);
+  g_clear_object (&iostream);
+
+  g_file_replace_contents (src_tmpfile, content, strlen (content), NULL, FALSE,
+                           G_FILE_CREATE_NONE, NULL, NULL, &local_error);
+  g_assert_no_error (local_error);
+
+  dest_tmpfile = g_file_new_tmp ("tmp-copy-reflinkXXXXXX",
+                                 &iostream, &local_error);
+  g_assert_no_error (local_error);
+  g_clear_object (&iostream);
+
+  /* Always copies the data */
+  g_file_copy (src_tmpfile, dest_tmpfile,
+               G_FILE_COPY_OVERWRITE | G_FILE_COPY_NO_REFLINK,
+               NULL, NULL, NULL, &local_error);
+  g_assert_no_error (local_error);
+
+  g_file_load_contents (dest_tmpfile, NULL, &contents, &length, NULL, &local_error);
+  g_assert_no_error (local_error);
+  g_assert_cmpmem (contents, length, content, strlen (content));
+  g_free (contents);
+
+  /* Whether this works depends on the file system of the temporary
+   * directory, but failing must not touch the destination */
+  g_file_replace_contents (dest_tmpfile, existing, strlen (existing), NULL, FALSE,
+                           G_FILE_CREATE_NONE, NULL, NULL, &local_error);
+  g_assert_no_error (local_error);
+
+  res = g_file_copy (src_tmpfile, dest_tmpfile,
+                     G_FILE_COPY_OVERWRITE | G_FILE_COPY_REFLINK_ONLY,
+                     NULL, NULL, NULL, &local_error);
+
+  g_file_load_contents (dest_tmpfile, NULL, &contents, &length, NULL, NULL);
+  if (res)
+    {
+      g_assert_no_error (local_error);
+      g_assert_cmpmem (contents, length, content, strlen (content));
+    }
+  else
+    {
+      g_assert_error (local_error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED);
+      g_clear_error (&local_error);
+      g_assert_cmpmem (contents, length, existing, strlen (existing));
+      g_test_message ("Reflinks are not supported in the temporary directory");
+    }
+  g_free (contents);
+
+  (void) g_file_delete (src_tmpfile, NULL, NULL);
+  (void) g_file_delete (dest_tmpfile, NULL, NULL);
+
+  g_clear_object (&src_tmpfile);
+  g_clear_object (&dest_tmpfile);
+}
+
+static void
+tree_async_cb (GObject      *object,
+               GAsyncResult *result,
+               gpointer      user_data)
+{
+  GAsyncResult **result_out = user_data;
+
+  *result_out = g_object_ref (result);
+  g_main_context_wakeup (NULL);
+}
+
+static void
+tree_progress_cb (goffset  current_num_bytes,
+                  goffset  total_num_bytes,
+                  gpointer user_data)
+{
+  goffset *last_num_bytes = user_data;
+
+  g_assert_cmpint (current_num_bytes, >=, *last_num_bytes);
+  *last_num_bytes = current_num_bytes;
+}
+
+static void
+test_copy_delete_tree (void)
+{
+  GFile *src, *dest, *child;
+  GAsyncResult *result = NULL;
+  GError *error = NULL;
+  gchar *tmp_dir, *contents;
+  goffset last_num_bytes = 0;
+  gsize length;
+  const struct {
+    const char *path;
+    const char *contents;  /* NULL for directories */
+  } tree[] = {
+    { "a", "first file" },
+    { "b", NULL },
+    { "b/c", "second file" },
+    { "b/d", NULL },
+    { "b/d/e", "third file" },
+    { "b/empty", NULL },
+  };
+
+  g_test_summary ("Test g_file_copy_tree_async() and g_file_delete_tree_async()");
+
+  tmp_dir = g_dir_make_tmp ("gio-test-tree_XXXXXX", &error);
+  g_assert_no_error (error);
+
+  src = g_file_new_build_filename (tmp_dir, "src", NULL);
+  dest = g_file_new_build_filename (tmp_dir, "dest", NULL);
+  g_file_make_directory (src, NULL, &error);
+  g_assert_no_error (error);
+
+  for (gsize i = 0; i < G_N_ELEMENTS (tree); i++)
+    {
+      child = g_file_resolve_relative_path (src, tree[i].path);
+      if (tree[i].contents != NULL)
+        g_file_replace_contents (child, tree[i].contents, strlen (tree[i].contents),
+                                 NULL, FALSE, G_FILE_CREATE_NONE, NULL, NULL, &error);
+      else
+        g_file_make_directory (child, NULL, &error);
+      g_assert_no_error (error);
+      g_object_unref (child);
+    }
+
+#ifdef G_OS_UNIX
+  child = g_file_get_child (src, "link");
+  g_file_make_symbolic_link (child, "b/c", NULL, &error);
+  g_assert_no_error (error);
+  g_object_unref (child);
+#endif
+
+  g_file_copy_tree_async (src, dest, G_FILE_COPY_NOFOLLOW_SYMLINKS, 4,
+                          G_PRIORITY_DEFAULT, NULL,
+                          tree_progress_cb, &last_num_bytes,
+                          tree_async_cb, &result);
+  while (result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+  g_assert_true (g_file_copy_tree_finish (src, result, &error));
+  g_assert_no_error (error);
+  g_clear_object (&result);
+
+  g_assert_cmpint (last_num_bytes, ==, strlen ("first file") + strlen ("second file") + strlen ("third file"));
+
+  for (gsize i = 0; i < G_N_ELEMENTS (tree); i++)
+    {
+      child = g_file_resolve_relative_path (dest, tree[i].path);
+      if (tree[i].contents != NULL)
+        {
+          g_file_load_contents (child, NULL, &contents, &length, NULL, &error);
+          g_assert_no_error (error);
+          g_assert_cmpmem (contents, length, tree[i].contents, strlen (tree[i].contents));
+          g_free (contents);
+        }
+      else
+        {
+          g_assert_cmpint (g_file_query_file_type (child, G_FILE_QUERY_INFO_NONE, NULL),
+                           ==, G_FILE_TYPE_DIRECTORY);
+        }
+      g_object_unref (child);
+    }
+
+#ifdef G_OS_UNIX
+  child = g_file_get_child (dest, "link");
+  g_assert_cmpint (g_file_query_file_type (child, G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS, NULL),
+                   ==, G_FILE_TYPE_SYMBOLIC_LINK);
+  g_object_unref (child);
+#endif
+
+  /* Copying again needs G_FILE_COPY_OVERWRITE */
+  g_file_copy_tree_async (src, dest, G_FILE_COPY_NONE, 0, G_PRIORITY_DEFAULT, NULL,
+                          NULL, NULL, tree_async_cb, &result);
+  while (result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+  g_assert_false (g_file_copy_tree_finish (src, result, &error));
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_EXISTS);
+  g_clear_error (&error);
+  g_clear_object (&result);
+
+  g_file_copy_tree_async (src, dest, G_FILE_COPY_OVERWRITE | G_FILE_COPY_NOFOLLOW_SYMLINKS, 0,
+                          G_PRIORITY_DEFAULT, NULL, NULL, NULL, tree_async_cb, &result);
+  while (result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+  g_assert_true (g_file_copy_tree_finish (src, result, &error));
+  g_assert_no_error (error);
+  g_clear_object (&result);
+
+  /* Deleting doesn’t follow the symlink into the source */
+  g_file_delete_tree_async (dest, 4, G_PRIORITY_DEFAULT, NULL, tree_async_cb, &result);
+  while (result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+  g_assert_true (g_file_delete_tree_finish (dest, result, &error));
+  g_assert_no_error (error);
+  g_clear_object (&result);
+
+  g_assert_false (g_file_query_exists (dest, NULL));
+  child = g_file_resolve_relative_path (src, "b/c");
+  g_assert_true (g_file_query_exists (child, NULL));
+  g_object_unref (child);
+
+  g_file_delete_tree_async (src, 0, G_PRIORITY_DEFAULT, NULL, tree_async_cb, &result);
+  while (result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+  g_assert_true (g_file_delete_tree_finish (src, result, &error));
+  g_assert_no_error (error);
+  g_clear_object (&result);
+
+  g_assert_false (g_file_query_exists (src, NULL));
+
+  g_assert_cmpint (g_rmdir (tmp_dir), ==, 0);
+
+  g_object_unref (src);
+  g_object_unref (dest);
+  g_free (tmp_dir);
+}
+
+static void
+test_compute_checksum (void)
+{
+  const GChecksumType types[] = { G_CHECKSUM_SHA256, G_CHECKSUM_MD5 };
+  GFile *files[3];
+  GFileIOStream *iostream;
+  GAsyncResult *result = NULL;
+  GError *error = NULL;
+  GPtrArray *results;
+  gchar **digests;
+  guint8 *contents;
+  gchar *expected_sha256, *expected_md5;
+  gsize size, i;
+
+  g_test_summary ("Test g_file_compute_checksum() and its async variants");
+
+  /* Big enough to be hashed in several chunks */
+  size = 3 * 256 * 1024 + 17;
+  contents = g_malloc (size);
+  for (i = 0; i < size; i++)
+    contents[i] = i * 7;
+  expected_sha256 = g_compute_checksum_for_data (G_CHECKSUM_SHA256, contents, size);
+  expected_md5 = g_compute_checksum_for_data (G_CHECKSUM_MD5, contents, size);
+
+  files[0] = g_file_new_tmp ("g_file_compute_checksum_XXXXXX", &iostream, &error);
+  g_assert_no_error (error);
+  g_object_unref (iostream);
+  g_file_replace_contents (files[0], (const char *) contents, size, NULL, FALSE,
+                           G_FILE_CREATE_NONE, NULL, NULL, &error);
+  g_assert_no_error (error);
+
+  files[1] = g_file_new_tmp ("g_file_compute_checksum_XXXXXX", &iostream, &error);
+  g_assert_no_error (error);
+  g_object_unref (iostream);
+
+  files[2] = g_file_get_child (files[1], "not-a-directory");
+
+  digests = g_file_compute_checksum (files[0], types, G_N_ELEMENTS (types), NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (g_strv_length (digests), ==, 2);
+  g_assert_cmpstr (digests[0], ==, expected_sha256);
+  g_assert_cmpstr (digests[1], ==, expected_md5);
+  g_strfreev (digests);
+
+  /* Empty files */
+  digests = g_file_compute_checksum (files[1], types, 1, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (digests[0], ==, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  g_strfreev (digests);
+
+  digests = g_file_compute_checksum (files[2], types, 1, NULL, &error);
+  g_assert_nonnull (error);
+  g_assert_null (digests);
+  g_clear_error (&error);
+
+  g_file_compute_checksum_async (files[0], types, G_N_ELEMENTS (types),
+                                 G_PRIORITY_DEFAULT, NULL, tree_async_cb, &result);
+  while (result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+  digests = g_file_compute_checksum_finish (files[0], result, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (digests[0], ==, expected_sha256);
+  g_assert_cmpstr (digests[1], ==, expected_md5);
+  g_strfreev (digests);
+  g_clear_object (&result);
+
+  /* Unreadable files don’t fail the batch */
+  g_file_compute_checksums_async (files, G_N_ELEMENTS (files), types, 1, 2,
+                                  G_PRIORITY_DEFAULT, NULL, tree_async_cb, &result);
+  while (result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+  results = g_file_compute_checksums_finish (result, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (results->len, ==, 3);
+  g_assert_cmpstr (((gchar **) results->pdata[0])[0], ==, expected_sha256);
+  g_assert_nonnull (results->pdata[1]);
+  g_assert_null (results->pdata[2]);
+  g_ptr_array_unref (results);
+  g_clear_object (&result);
+
+  for (i = 0; i < 2; i++)
+    {
+      g_file_delete (files[i], NULL, &error);
+      g_assert_no_error (error);
+    }
+  for (i = 0; i < G_N_ELEMENTS (files); i++)
+    g_object_unref (files[i]);
+
+  g_free (expected_md5);
+  g_free (expected_sha256);
+  g_free (contents);
+}
+
 typedef struct
 {
   GError *error;
@@ -2754,6 +3131,99 @@ test_measure (void)
   g_free (path);
 }
 
+static void
+test_measure_parallel (void)
+{
+  GFile *file;
+  guint64 num_bytes;
+  guint64 num_dirs;
+  guint64 num_files;
+  GError *error = NULL;
+  gboolean ok;
+  gchar *path;
+
+  path = g_test_build_filename (G_TEST_DIST, "desktop-files", NULL);
+  file = g_file_new_for_path (path);
+
+  ok = g_file_measure_disk_usage (file,
+                                  G_FILE_MEASURE_APPARENT_SIZE |
+                                  G_FILE_MEASURE_PARALLEL |
+                                  G_FILE_MEASURE_REPORT_ANY_ERROR,
+                                  NULL,
+                                  NULL,
+                                  NULL,
+                                  &num_bytes,
+                                  &num_dirs,
+                                  &num_files,
+                                  &error);
+  g_assert_true (ok);
+  g_assert_no_error (error);
+
+  g_assert_cmpuint (num_bytes, ==, 74469);
+  g_assert_cmpuint (num_dirs, ==, 6);
+  g_assert_cmpuint (num_files, ==, 32);
+
+  g_object_unref (file);
+  g_free (path);
+}
+
+static void
+test_measure_hardlinks (void)
+{
+#ifdef G_OS_UNIX
+  GFile *dir;
+  guint64 num_bytes;
+  guint64 num_files;
+  GError *error = NULL;
+  gchar *tmp_dir, *first, *second;
+  gboolean ok;
+
+  tmp_dir = g_dir_make_tmp ("gio-test-measure-hardlinks_XXXXXX", &error);
+  g_assert_no_error (error);
+
+  first = g_build_filename (tmp_dir, "first", NULL);
+  second = g_build_filename (tmp_dir, "second", NULL);
+  g_file_set_contents (first, "0123456789", -1, &error);
+  g_assert_no_error (error);
+  if (link (first, second) != 0)
+    {
+      g_test_skip ("Hard links not supported in the temporary directory");
+      goto out;
+    }
+
+  dir = g_file_new_for_path (tmp_dir);
+
+  ok = g_file_measure_disk_usage (dir, G_FILE_MEASURE_APPARENT_SIZE, NULL, NULL, NULL,
+                                  &num_bytes, NULL, &num_files, &error);
+  g_assert_no_error (error);
+  g_assert_true (ok);
+  g_assert_cmpuint (num_bytes, ==, 20);
+  g_assert_cmpuint (num_files, ==, 2);
+
+  ok = g_file_measure_disk_usage (dir,
+                                  G_FILE_MEASURE_APPARENT_SIZE |
+                                  G_FILE_MEASURE_DEDUPLICATE_HARDLINKS,
+                                  NULL, NULL, NULL,
+                                  &num_bytes, NULL, &num_files, &error);
+  g_assert_no_error (error);
+  g_assert_true (ok);
+  g_assert_cmpuint (num_bytes, ==, 10);
+  g_assert_cmpuint (num_files, ==, 1);
+
+  g_object_unref (dir);
+
+ out:
+  g_remove (second);
+  g_remove (first);
+  g_rmdir (tmp_dir);
+  g_free (second);
+  g_free (first);
+  g_free (tmp_dir);
+#else
+  g_test_skip ("Hard links not supported on this platform");
+#endif
+}
+
 typedef struct {
   guint64 expected_bytes;
   guint64 expected_dirs;
@@ -3126,6 +3596,112 @@ test_writev_helper (GOutputVector *vectors,
   g_object_unref (file);
 }
 
+static void
+io_uring_async_cb (GObject      *source,
+                   GAsyncResult *result,
+                   gpointer      user_data)
+{
+  GAsyncResult **result_out = user_data;
+
+  *result_out = g_object_ref (result);
+}
+
+/* Test asynchronous reads and writes of local file streams with
+ * GIO_USE_IO_URING=1, including that the file position advances */
+static void
+test_read_write_async_io_uring (void)
+{
+  GFile *file = NULL;
+  GFileIOStream *iostream = NULL;
+  GInputStream *in;
+  GOutputStream *out;
+  GAsyncResult *result = NULL;
+  GError *error = NULL;
+  char buffer[32];
+  gssize len;
+  guint i;
+
+  if (!g_test_subprocess ())
+    {
+      char **envp = g_get_environ ();
+
+      envp = g_environ_setenv (envp, "GIO_USE_IO_URING", "1", TRUE);
+      g_test_trap_subprocess_with_envp (NULL, (const char * const *) envp, 0,
+                                        G_TEST_SUBPROCESS_DEFAULT);
+      g_test_trap_assert_passed ();
+      g_strfreev (envp);
+      return;
+    }
+
+  g_test_summary ("Test asynchronous reads and writes on local file streams "
+                  "with GIO_USE_IO_URING=1, which fall back to threads where "
+                  "io_uring isn’t available");
+
+  file = g_file_new_tmp ("g_file_read_write_async_XXXXXX", &iostream, &error);
+  g_assert_no_error (error);
+  g_object_unref (iostream);
+
+  iostream = g_file_replace_readwrite (file, NULL, FALSE, G_FILE_CREATE_NONE,
+                                       NULL, &error);
+  g_assert_no_error (error);
+  out = g_io_stream_get_output_stream (G_IO_STREAM (iostream));
+
+  /* Two writes, which must land one after the other */
+  for (i = 0; i < 2; i++)
+    {
+      g_output_stream_write_async (out, i == 0 ? "hello " : "world", i == 0 ? 6 : 5,
+                                   G_PRIORITY_DEFAULT, NULL, io_uring_async_cb, &result);
+      while (result == NULL)
+        g_main_context_iteration (NULL, TRUE);
+
+      len = g_output_stream_write_finish (out, result, &error);
+      g_assert_no_error (error);
+      g_assert_cmpint (len, ==, i == 0 ? 6 : 5);
+      g_clear_object (&result);
+    }
+
+  g_io_stream_close (G_IO_STREAM (iostream), NULL, &error);
+  g_assert_no_error (error);
+  g_object_unref (iostream);
+
+  in = G_INPUT_STREAM (g_file_read (file, NULL, &error));
+  g_assert_no_error (error);
+
+  /* Two reads, which must continue from the current position */
+  g_input_stream_read_async (in, buffer, 6, G_PRIORITY_DEFAULT,
+                             NULL, io_uring_async_cb, &result);
+  while (result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+  len = g_input_stream_read_finish (in, result, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (len, ==, 6);
+  g_clear_object (&result);
+
+  g_input_stream_read_async (in, buffer + 6, sizeof (buffer) - 6, G_PRIORITY_DEFAULT,
+                             NULL, io_uring_async_cb, &result);
+  while (result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+  len = g_input_stream_read_finish (in, result, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (len, ==, 5);
+  g_clear_object (&result);
+  g_assert_cmpmem (buffer, 11, "hello world", 11);
+
+  /* End of file */
+  g_input_stream_read_async (in, buffer, sizeof (buffer), G_PRIORITY_DEFAULT,
+                             NULL, io_uring_async_cb, &result);
+  while (result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+  len = g_input_stream_read_finish (in, result, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (len, ==, 0);
+  g_clear_object (&result);
+
+  g_object_unref (in);
+  g_file_delete (file, NULL, NULL);
+  g_object_unref (file);
+}
+
 /* Test that writev() on local file output streams works on a non-empty vector */
 static void
 test_writev (void)
@@ -4306,6 +4882,148 @@ test_enumerator_cancellation (void)
   g_object_unref (dir);
 }
 
+static void
+test_enumerator_stat (void)
+{
+#ifdef G_OS_UNIX
+  GFileEnumerator *enumerator;
+  GFileInfo *info, *queried;
+  GFile *dir, *child;
+  GError *error = NULL;
+  gchar *tmp_dir;
+  guint n_files = 0;
+  const char *attributes = G_FILE_ATTRIBUTE_STANDARD_NAME ","
+                           G_FILE_ATTRIBUTE_STANDARD_TYPE ","
+                           G_FILE_ATTRIBUTE_STANDARD_SIZE ","
+                           G_FILE_ATTRIBUTE_STANDARD_IS_SYMLINK ","
+                           G_FILE_ATTRIBUTE_UNIX_INODE;
+
+  g_test_summary ("Test that enumerated files have the same info as when queried on their own");
+
+  tmp_dir = g_dir_make_tmp ("gio-test-enumerator-stat_XXXXXX", &error);
+  g_assert_no_error (error);
+
+  dir = g_file_new_for_path (tmp_dir);
+  child = g_file_get_child (dir, "file");
+  g_file_set_contents (g_file_peek_path (child), "content", -1, &error);
+  g_assert_no_error (error);
+  g_object_unref (child);
+
+  child = g_file_get_child (dir, "link");
+  g_file_make_symbolic_link (child, "file", NULL, &error);
+  g_assert_no_error (error);
+  g_object_unref (child);
+
+  child = g_file_get_child (dir, "broken-link");
+  g_file_make_symbolic_link (child, "missing", NULL, &error);
+  g_assert_no_error (error);
+  g_object_unref (child);
+
+  /* Relative symlinks must be resolved relative to the enumerated directory,
+   * not the current one */
+  enumerator = g_file_enumerate_children (dir, attributes, G_FILE_QUERY_INFO_NONE,
+                                          NULL, &error);
+  g_assert_no_error (error);
+
+  while ((info = g_file_enumerator_next_file (enumerator, NULL, &error)) != NULL)
+    {
+      child = g_file_enumerator_get_child (enumerator, info);
+      queried = g_file_query_info (child, attributes, G_FILE_QUERY_INFO_NONE, NULL, &error);
+      g_assert_no_error (error);
+
+      g_assert_cmpint (g_file_info_get_file_type (info), ==, g_file_info_get_file_type (queried));
+      g_assert_cmpint (g_file_info_get_size (info), ==, g_file_info_get_size (queried));
+      g_assert_cmpint (g_file_info_get_is_symlink (info), ==, g_file_info_get_is_symlink (queried));
+      g_assert_cmpuint (g_file_info_get_attribute_uint64 (info, G_FILE_ATTRIBUTE_UNIX_INODE), ==,
+                        g_file_info_get_attribute_uint64 (queried, G_FILE_ATTRIBUTE_UNIX_INODE));
+
+      if (g_str_equal (g_file_info_get_name (info), "link"))
+        g_assert_cmpint (g_file_info_get_size (info), ==, strlen ("content"));
+
+      n_files++;
+      g_object_unref (queried);
+      g_object_unref (child);
+      g_object_unref (info);
+    }
+  g_assert_no_error (error);
+  g_assert_cmpuint (n_files, ==, 3);
+
+  g_object_unref (enumerator);
+
+  for (gsize i = 0; i < 3; i++)
+    {
+      const char *names[] = { "broken-link", "link", "file" };
+
+      child = g_file_get_child (dir, names[i]);
+      g_file_delete (child, NULL, &error);
+      g_assert_no_error (error);
+      g_object_unref (child);
+    }
+  g_file_delete (dir, NULL, &error);
+  g_assert_no_error (error);
+
+  g_object_unref (dir);
+  g_free (tmp_dir);
+#else
+  g_test_skip ("Symbolic links not supported on this platform");
+#endif
+}
+
+static void
+test_query_info_lazy (void)
+{
+  GFileInfo *eager, *lazy, *copy;
+  GFile *file;
+  GFileIOStream *iostream;
+  GError *error = NULL;
+  const char *attributes = G_FILE_ATTRIBUTE_STANDARD_SIZE ","
+                           G_FILE_ATTRIBUTE_STANDARD_CONTENT_TYPE ","
+                           G_FILE_ATTRIBUTE_STANDARD_ICON;
+  const char *content = "<?xml version=\"1.0\"?>\n<data/>\n";
+
+  g_test_summary ("Test that G_FILE_QUERY_INFO_LAZY returns the same attributes as an eager query");
+
+  file = g_file_new_tmp ("g_file_query_info_lazy_XXXXXX", &iostream, &error);
+  g_assert_no_error (error);
+  g_object_unref (iostream);
+
+  g_file_replace_contents (file, content, strlen (content), NULL, FALSE,
+                           G_FILE_CREATE_NONE, NULL, NULL, &error);
+  g_assert_no_error (error);
+
+  eager = g_file_query_info (file, attributes, G_FILE_QUERY_INFO_NONE, NULL, &error);
+  g_assert_no_error (error);
+
+  lazy = g_file_query_info (file, attributes, G_FILE_QUERY_INFO_LAZY, NULL, &error);
+  g_assert_no_error (error);
+
+  g_assert_cmpint (g_file_info_get_size (lazy), ==, strlen (content));
+  g_assert_true (g_file_info_has_attribute (lazy, G_FILE_ATTRIBUTE_STANDARD_CONTENT_TYPE));
+  g_assert_cmpstr (g_file_info_get_content_type (lazy), ==,
+                   g_file_info_get_content_type (eager));
+  g_assert_true (g_icon_equal (g_file_info_get_icon (lazy), g_file_info_get_icon (eager)));
+  g_object_unref (lazy);
+
+  /* Copies and explicitly set values must not lose out to the deferred ones */
+  lazy = g_file_query_info (file, attributes, G_FILE_QUERY_INFO_LAZY, NULL, &error);
+  g_assert_no_error (error);
+
+  copy = g_file_info_dup (lazy);
+  g_assert_cmpstr (g_file_info_get_content_type (copy), ==,
+                   g_file_info_get_content_type (eager));
+
+  g_file_info_set_content_type (lazy, "application/x-test");
+  g_assert_cmpstr (g_file_info_get_content_type (lazy), ==, "application/x-test");
+
+  g_object_unref (copy);
+  g_object_unref (lazy);
+  g_object_unref (eager);
+
+  g_file_delete (file, NULL, &error);
+  g_assert_no_error (error);
+  g_object_unref (file);
+}
+
 static void
 test_path_from_uri_helper (const gchar *uri,
 			   const gchar *expected_path)
@@ -4357,6 +5075,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/file/build-filenamev", test_build_filenamev);
   g_test_add_func ("/file/parent", test_parent);
   g_test_add_func ("/file/child", test_child);
+  g_test_add_func ("/file/canonical-path", test_canonical_path);
   g_test_add_func ("/file/empty-path", test_empty_path);
   g_test_add_func ("/file/type", test_type);
   g_test_add_func ("/file/parse-name", test_parse_name);
@@ -4377,14 +5096,20 @@ main (int argc, char *argv[])
   g_test_add_func ("/file/async-make-symlink", test_async_make_symlink);
   g_test_add_func ("/file/copy-preserve-mode", test_copy_preserve_mode);
   g_test_add_func ("/file/copy/progress", test_copy_progress);
+  g_test_add_func ("/file/copy/reflink", test_copy_reflink);
+  g_test_add_func ("/file/copy-delete-tree", test_copy_delete_tree);
+  g_test_add_func ("/file/compute-checksum", test_compute_checksum);
   g_test_add_func ("/file/copy-async-with-closures", test_copy_async_with_closures);
   g_test_add_func ("/file/measure", test_measure);
   g_test_add_func ("/file/measure-async", test_measure_async);
+  g_test_add_func ("/file/measure-parallel", test_measure_parallel);
+  g_test_add_func ("/file/measure-hardlinks", test_measure_hardlinks);
   g_test_add_func ("/file/load-bytes", test_load_bytes);
   g_test_add_func ("/file/load-bytes-async", test_load_bytes_async);
   g_test_add_func ("/file/load-bytes-4gb", test_load_bytes_4gb);
   g_test_add_func ("/file/load-contents-4gb", test_load_contents_4gb);
   g_test_add_func ("/file/load-contents-4gb-async", test_load_contents_4gb_async);
+  g_test_add_func ("/file/read-write-async/io-uring", test_read_write_async_io_uring);
   g_test_add_func ("/file/writev", test_writev);
   g_test_add_func ("/file/writev/no-bytes-written", test_writev_no_bytes_written);
   g_test_add_func ("/file/writev/no-vectors", test_writev_no_vectors);
@@ -4405,6 +5130,8 @@ main (int argc, char *argv[])
   g_test_add_func ("/file/query-default-handler-uri", test_query_default_handler_uri);
   g_test_add_func ("/file/query-default-handler-uri-async", test_query_default_handler_uri_async);
   g_test_add_func ("/file/enumerator-cancellation", test_enumerator_cancellation);
+  g_test_add_func ("/file/enumerator-stat", test_enumerator_stat);
+  g_test_add_func ("/file/query-info-lazy", test_query_info_lazy);
   g_test_add_func ("/file/from-uri/ignores-query-string", test_from_uri_ignores_query_string);
   g_test_add_func ("/file/from-uri/ignores-fragment", test_from_uri_ignores_fragment);
 
@@ -149,6 +149,52 @@ test_subtract (void)
     }
 }
 
+static void
+test_matches (void)
+{
+  struct {
+    const char *attributes;
+    const char *attribute;
+    gboolean matches;
+  } matches[] = {
+    { "standard::*", G_FILE_ATTRIBUTE_STANDARD_NAME, TRUE },
+    { "standard::*", G_FILE_ATTRIBUTE_UNIX_MODE, FALSE },
+    { "standard::*", "standard::not-well-known", TRUE },
+    { "standard::name", G_FILE_ATTRIBUTE_STANDARD_NAME, TRUE },
+    { "standard::name", G_FILE_ATTRIBUTE_STANDARD_TYPE, FALSE },
+    { "standard::name,unix::*", G_FILE_ATTRIBUTE_UNIX_INODE, TRUE },
+    { "standard::name,unix::*", G_FILE_ATTRIBUTE_TIME_MODIFIED, FALSE },
+    { "time::*,trash::*", G_FILE_ATTRIBUTE_TRASH_DELETION_DATE, TRUE },
+    { "time::*,trash::*", G_FILE_ATTRIBUTE_TIME_CREATED_NSEC, TRUE },
+    { "xattr::*", "xattr::user.foo", TRUE },
+    { "xattr::*", G_FILE_ATTRIBUTE_STANDARD_NAME, FALSE },
+    { "a::b,standard::size", G_FILE_ATTRIBUTE_STANDARD_SIZE, TRUE },
+    { "a::b,standard::size", "a::b", TRUE },
+    { "a::b,standard::size", "a::c", FALSE },
+  };
+
+  GFileAttributeMatcher *matcher, *subtract, *result;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (matches); i++)
+    {
+      matcher = g_file_attribute_matcher_new (matches[i].attributes);
+      g_assert_cmpint (g_file_attribute_matcher_matches (matcher, matches[i].attribute),
+                       ==, matches[i].matches);
+      g_file_attribute_matcher_unref (matcher);
+    }
+
+  /* Subtracting must recompute which well-known attributes match */
+  matcher = g_file_attribute_matcher_new ("standard::name,standard::type");
+  subtract = g_file_attribute_matcher_new ("standard::name");
+  result = g_file_attribute_matcher_subtract (matcher, subtract);
+  g_assert_false (g_file_attribute_matcher_matches (result, G_FILE_ATTRIBUTE_STANDARD_NAME));
+  g_assert_true (g_file_attribute_matcher_matches (result, G_FILE_ATTRIBUTE_STANDARD_TYPE));
+  g_file_attribute_matcher_unref (matcher);
+  g_file_attribute_matcher_unref (subtract);
+  g_file_attribute_matcher_unref (result);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -157,6 +203,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/fileattributematcher/exact", test_exact);
   g_test_add_func ("/fileattributematcher/equality", test_equality);
   g_test_add_func ("/fileattributematcher/subtract", test_subtract);
+  g_test_add_func ("/fileattributematcher/matches", test_matches);
 
   return g_test_run ();
 }
@@ -1411,6 +1411,48 @@ test_dbus_activate (void)
   g_clear_object (&bus);
 }
 
+static void
+test_dbus_deferred_registration (void)
+{
+  GTestDBus *bus = NULL;
+  GApplication *app = NULL;
+  GError *local_error = NULL;
+
+  g_test_summary ("Test that G_APPLICATION_DEFER_DBUS_REGISTRATION exports "
+                  "the application once the bus connection is up");
+
+  bus = g_test_dbus_new (G_TEST_DBUS_NONE);
+  g_test_dbus_up (bus);
+
+  app = g_application_new ("org.gtk.TestApplication.Deferred",
+                           G_APPLICATION_NON_UNIQUE | G_APPLICATION_DEFER_DBUS_REGISTRATION);
+  g_application_register (app, NULL, &local_error);
+  g_assert_no_error (local_error);
+  g_assert_false (g_application_get_is_remote (app));
+
+  /* Nothing is exported until the main loop runs */
+  g_assert_null (g_application_get_dbus_connection (app));
+  g_assert_null (g_application_get_dbus_object_path (app));
+
+  while (g_application_get_dbus_connection (app) == NULL)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpstr (g_application_get_dbus_object_path (app), ==, "/org/gtk/TestApplication/Deferred");
+  g_clear_object (&app);
+
+  /* Dropping the application before the connection is up must be safe */
+  app = g_application_new ("org.gtk.TestApplication.Deferred",
+                           G_APPLICATION_NON_UNIQUE | G_APPLICATION_DEFER_DBUS_REGISTRATION);
+  g_application_register (app, NULL, &local_error);
+  g_assert_no_error (local_error);
+  g_clear_object (&app);
+
+  while (g_main_context_iteration (NULL, FALSE));
+
+  g_test_dbus_down (bus);
+  g_clear_object (&bus);
+}
+
 static void
 dbus_activate_noop_cb (GApplication *app,
                        gpointer      user_data)
@@ -1950,6 +1992,7 @@ main (int argc, char **argv)
   g_test_add_func ("/gapplication/dbus/command-line", test_dbus_command_line);
   g_test_add_func ("/gapplication/dbus/command-line-done", test_dbus_command_line_done);
   g_test_add_func ("/gapplication/dbus/activate-action", test_dbus_activate_action);
+  g_test_add_func ("/gapplication/dbus/deferred-registration", test_dbus_deferred_registration);
 
   return g_test_run ();
 }
@@ -101,7 +101,7 @@ overflow_on_500ms_later_func (gpointer user_data)
 }
 
 static void
-test_overflow (void)
+test_overflow_with_flags (GDBusConnectionFlags extra_flags)
 {
   gint sv[2];
   gint n;
@@ -123,7 +123,7 @@ test_overflow (void)
   g_object_unref (socket);
   producer = g_dbus_connection_new_sync (G_IO_STREAM (socket_connection),
 					 NULL, /* guid */
-					 G_DBUS_CONNECTION_FLAGS_NONE,
+					 extra_flags,
 					 NULL, /* GDBusAuthObserver */
 					 NULL, /* GCancellable */
 
@@ -167,7 +167,7 @@ test_overflow (void)
   g_object_unref (socket);
   consumer = g_dbus_connection_new_sync (G_IO_STREAM (socket_connection),
 					 NULL, /* guid */
-					 G_DBUS_CONNECTION_FLAGS_DELAY_MESSAGE_PROCESSING,
+					 G_DBUS_CONNECTION_FLAGS_DELAY_MESSAGE_PROCESSING | extra_flags,
 					 NULL, /* GDBusAuthObserver */
 					 NULL, /* GCancellable */
 					 &error);
@@ -192,12 +192,24 @@ test_overflow (void)
 }
 #else
 static void
-test_overflow (void)
+test_overflow_with_flags (GDBusConnectionFlags extra_flags)
 {
   /* TODO: test this with e.g. GWin32InputStream/GWin32OutputStream */
 }
 #endif
 
+static void
+test_overflow (void)
+{
+  test_overflow_with_flags (G_DBUS_CONNECTION_FLAGS_NONE);
+}
+
+static void
+test_overflow_worker_pool (void)
+{
+  test_overflow_with_flags (G_DBUS_CONNECTION_FLAGS_WORKER_POOL);
+}
+
 /* ---------------------------------------------------------------------------------------------------- */
 
 
@@ -229,6 +241,7 @@ main (int   argc,
   loop = g_main_loop_new (NULL, FALSE);
 
   g_test_add_func ("/gdbus/overflow", test_overflow);
+  g_test_add_func ("/gdbus/overflow/worker-pool", test_overflow_worker_pool);
 
   ret = g_test_run();
 
@@ -373,6 +373,87 @@ test_object_manager (Test *test,
   g_free (number1_path);
 }
 
+static void
+test_object_manager_lazy (Test *test,
+                          gconstpointer test_data)
+{
+  GDBusObjectManager *client;
+  GDBusObjectManagerServer *server;
+  MockInterface *mock;
+  GDBusObjectSkeleton *skeleton;
+  GError *error = NULL;
+  GDBusObject *object;
+  GDBusInterface *proxy;
+  GVariant *prop;
+  GList *objects;
+  guint n;
+
+  g_test_summary ("Test that proxies are created on first access with "
+                  "G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_LAZY_PROXIES");
+
+  server = g_dbus_object_manager_server_new ("/objects");
+
+  for (n = 1; n <= 3; n++)
+    {
+      gchar *path = g_strdup_printf ("/objects/number_%u", n);
+
+      mock = g_object_new (mock_interface_get_type (), NULL);
+      mock->number = n;
+      skeleton = g_dbus_object_skeleton_new (path);
+      g_dbus_object_skeleton_add_interface (skeleton, G_DBUS_INTERFACE_SKELETON (mock));
+      g_dbus_object_manager_server_export (server, skeleton);
+      g_object_unref (skeleton);
+      g_object_unref (mock);
+      g_free (path);
+    }
+
+  g_dbus_object_manager_server_set_connection (server, test->server);
+
+  g_dbus_object_manager_client_new (test->client,
+                                    G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_DO_NOT_AUTO_START |
+                                    G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_LAZY_PROXIES,
+                                    NULL, "/objects", NULL, NULL, NULL, NULL, on_result, test);
+
+  g_main_loop_run (test->loop);
+  client = g_dbus_object_manager_client_new_finish (test->result, &error);
+  g_assert_no_error (error);
+  g_clear_object (&test->result);
+
+  /* Looking up a single object creates its proxies from the retained reply */
+  object = g_dbus_object_manager_get_object (client, "/objects/number_2");
+  g_assert_nonnull (object);
+  proxy = g_dbus_object_get_interface (object, "org.mock.Interface");
+  g_assert_nonnull (proxy);
+  prop = g_dbus_proxy_get_cached_property (G_DBUS_PROXY (proxy), "Number");
+  g_assert_nonnull (prop);
+  g_assert_cmpint (g_variant_get_int32 (prop), ==, 2);
+  g_variant_unref (prop);
+  g_object_unref (proxy);
+
+  /* and is stable across lookups */
+  g_assert_true (g_dbus_object_manager_get_object (client, "/objects/number_2") == object);
+  g_object_unref (object);
+  g_object_unref (object);
+
+  g_assert_null (g_dbus_object_manager_get_object (client, "/objects/number_4"));
+
+  /* Enumerating creates all the remaining ones */
+  objects = g_dbus_object_manager_get_objects (client);
+  g_assert_cmpuint (g_list_length (objects), ==, 3);
+  g_list_free_full (objects, g_object_unref);
+
+  proxy = g_dbus_object_manager_get_interface (client, "/objects/number_3", "org.mock.Interface");
+  g_assert_nonnull (proxy);
+  prop = g_dbus_proxy_get_cached_property (G_DBUS_PROXY (proxy), "Number");
+  g_assert_nonnull (prop);
+  g_assert_cmpint (g_variant_get_int32 (prop), ==, 3);
+  g_variant_unref (prop);
+  g_object_unref (proxy);
+
+  g_object_unref (server);
+  g_object_unref (client);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -383,6 +464,8 @@ main (int   argc,
               setup, test_object_manager, teardown);
   g_test_add ("/gdbus/peer-object-manager/root", Test, "/",
               setup, test_object_manager, teardown);
+  g_test_add ("/gdbus/peer-object-manager/lazy", Test, NULL,
+              setup, test_object_manager_lazy, teardown);
 
   return g_test_run();
 }
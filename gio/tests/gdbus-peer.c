@@ -1876,6 +1876,399 @@ test_credentials (void)
   g_object_unref (c2);
 }
 
+/* ---------------------------------------------------------------------------------------------------- */
+/* Test that bursts of messages, some carrying file descriptors, survive
+ * being written in batches which the socket only partially accepts */
+/* ---------------------------------------------------------------------------------------------------- */
+
+#ifdef G_OS_UNIX
+
+/* Chosen to be big enough to fill the socket buffers */
+#define WRITE_BATCH_NUM_MESSAGES 512
+#define WRITE_BATCH_NUM_BEFORE_FLUSH 480
+#define WRITE_BATCH_PAYLOAD_SIZE 4096
+#define WRITE_BATCH_FD_EVERY 5
+
+typedef struct
+{
+  GDBusConnection *producer;
+  GDBusConnection *consumer;
+
+  GMutex mutex;
+  GCond cond;
+  gboolean blocked;  /* (mutex mutex) */
+  gboolean released;  /* (mutex mutex) */
+
+  gint n_sent;  /* (atomic) */
+  gint n_received;  /* (atomic) */
+  gboolean flushed;
+
+  struct stat fd_stat;
+} WriteBatchData;
+
+static void
+write_batch_connection_cb (GObject      *source,
+                           GAsyncResult *result,
+                           gpointer      user_data)
+{
+  GDBusConnection **connection = user_data;
+  GError *error = NULL;
+
+  *connection = g_dbus_connection_new_finish (result, &error);
+  g_assert_no_error (error);
+}
+
+static GDBusMessage *
+write_batch_count_sent (GDBusConnection *connection,
+                        GDBusMessage    *message,
+                        gboolean         incoming,
+                        gpointer         user_data)
+{
+  WriteBatchData *data = user_data;
+
+  if (!incoming)
+    g_atomic_int_inc (&data->n_sent);
+
+  return message;
+}
+
+/* Called in the worker thread of the consumer */
+static GDBusMessage *
+write_batch_check_received (GDBusConnection *connection,
+                            GDBusMessage    *message,
+                            gboolean         incoming,
+                            gpointer         user_data)
+{
+  WriteBatchData *data = user_data;
+  GUnixFDList *fd_list;
+  guint32 seq;
+
+  if (!incoming)
+    return message;
+
+  g_variant_get_child (g_dbus_message_get_body (message), 0, "u", &seq);
+  g_assert_cmpuint (seq, ==, (guint) g_atomic_int_get (&data->n_received));
+
+  fd_list = g_dbus_message_get_unix_fd_list (message);
+  if (seq % WRITE_BATCH_FD_EVERY == 0)
+    {
+      struct stat buf;
+
+      g_assert_nonnull (fd_list);
+      g_assert_cmpint (g_unix_fd_list_get_length (fd_list), ==, 1);
+      g_assert_no_errno (fstat (g_unix_fd_list_peek_fds (fd_list, NULL)[0], &buf));
+      g_assert_cmpuint (buf.st_dev, ==, data->fd_stat.st_dev);
+      g_assert_cmpuint (buf.st_ino, ==, data->fd_stat.st_ino);
+    }
+  else
+    g_assert_null (fd_list);
+
+  g_atomic_int_inc (&data->n_received);
+
+  /* Stop reading after the first message until the test says so, so that
+   * the socket buffers fill up and the producer can only write part of a
+   * batch */
+  if (seq == 0)
+    {
+      g_mutex_lock (&data->mutex);
+      data->blocked = TRUE;
+      g_cond_broadcast (&data->cond);
+      while (!data->released)
+        g_cond_wait (&data->cond, &data->mutex);
+      g_mutex_unlock (&data->mutex);
+    }
+
+  return message;
+}
+
+static void
+write_batch_send (WriteBatchData *data,
+                  guint32         seq,
+                  gint            fd,
+                  const gchar    *payload)
+{
+  GDBusMessage *message;
+  GError *error = NULL;
+
+  message = g_dbus_message_new_signal ("/org/gtk/GDBus/WriteBatch",
+                                       "org.gtk.GDBus.WriteBatch",
+                                       "Burst");
+
+  if (seq % WRITE_BATCH_FD_EVERY == 0)
+    {
+      GUnixFDList *fd_list = g_unix_fd_list_new ();
+
+      g_unix_fd_list_append (fd_list, fd, &error);
+      g_assert_no_error (error);
+      g_dbus_message_set_unix_fd_list (message, fd_list);
+      g_dbus_message_set_body (message, g_variant_new ("(ush)", seq, payload, 0));
+      g_object_unref (fd_list);
+    }
+  else
+    g_dbus_message_set_body (message, g_variant_new ("(us)", seq, payload));
+
+  g_dbus_connection_send_message (data->producer, message,
+                                  G_DBUS_SEND_MESSAGE_FLAGS_NONE,
+                                  NULL, &error);
+  g_assert_no_error (error);
+  g_object_unref (message);
+}
+
+static void
+write_batch_flush_cb (GObject      *source,
+                      GAsyncResult *result,
+                      gpointer      user_data)
+{
+  WriteBatchData *data = user_data;
+  GError *error = NULL;
+
+  g_dbus_connection_flush_finish (G_DBUS_CONNECTION (source), result, &error);
+  g_assert_no_error (error);
+
+  /* Every message queued before the flush has been written */
+  g_assert_cmpint (g_atomic_int_get (&data->n_sent), >=, WRITE_BATCH_NUM_BEFORE_FLUSH);
+
+  data->flushed = TRUE;
+}
+
+static void
+test_write_batch (void)
+{
+  WriteBatchData data = { 0, };
+  GSocketConnection *stream;
+  GSocket *socket;
+  GError *error = NULL;
+  gchar *payload;
+  gchar *path;
+  gchar *guid;
+  guint32 seq;
+  gint pair[2];
+  gint fd;
+
+  g_assert_no_errno (socketpair (AF_UNIX, SOCK_STREAM, 0, pair));
+
+  socket = g_socket_new_from_fd (pair[0], &error);
+  g_assert_no_error (error);
+  stream = g_socket_connection_factory_create_connection (socket);
+  guid = g_dbus_generate_guid ();
+  g_dbus_connection_new (G_IO_STREAM (stream), guid,
+                         G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_SERVER |
+                         G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_ALLOW_ANONYMOUS,
+                         NULL, NULL, write_batch_connection_cb, &data.producer);
+  g_object_unref (stream);
+  g_object_unref (socket);
+  g_free (guid);
+
+  /* The consumer gets a worker thread of its own, so that blocking it
+   * doesn't block the producer */
+  socket = g_socket_new_from_fd (pair[1], &error);
+  g_assert_no_error (error);
+  stream = g_socket_connection_factory_create_connection (socket);
+  g_dbus_connection_new (G_IO_STREAM (stream), NULL,
+                         G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT |
+                         G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_ALLOW_ANONYMOUS |
+                         G_DBUS_CONNECTION_FLAGS_WORKER_POOL,
+                         NULL, NULL, write_batch_connection_cb, &data.consumer);
+  g_object_unref (stream);
+  g_object_unref (socket);
+
+  while (data.producer == NULL || data.consumer == NULL)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpint (g_dbus_connection_get_capabilities (data.producer) &
+                   G_DBUS_CAPABILITY_FLAGS_UNIX_FD_PASSING, !=, 0);
+
+  g_mutex_init (&data.mutex);
+  g_cond_init (&data.cond);
+  g_dbus_connection_add_filter (data.producer, write_batch_count_sent, &data, NULL);
+  g_dbus_connection_add_filter (data.consumer, write_batch_check_received, &data, NULL);
+
+  fd = g_file_open_tmp ("gdbus-test-write-batch-XXXXXX", &path, &error);
+  g_assert_no_error (error);
+  g_assert_no_errno (fstat (fd, &data.fd_stat));
+  payload = g_strnfill (WRITE_BATCH_PAYLOAD_SIZE, 'x');
+
+  write_batch_send (&data, 0, fd, payload);
+
+  g_mutex_lock (&data.mutex);
+  while (!data.blocked)
+    g_cond_wait (&data.cond, &data.mutex);
+  g_mutex_unlock (&data.mutex);
+
+  /* Queue a burst with a flush part way through it */
+  for (seq = 1; seq < WRITE_BATCH_NUM_BEFORE_FLUSH; seq++)
+    write_batch_send (&data, seq, fd, payload);
+  g_dbus_connection_flush (data.producer, NULL, write_batch_flush_cb, &data);
+  for (; seq < WRITE_BATCH_NUM_MESSAGES; seq++)
+    write_batch_send (&data, seq, fd, payload);
+
+  /* Nothing is read, so the flush can't complete */
+  g_usleep (200 * G_TIME_SPAN_MILLISECOND);
+  while (g_main_context_iteration (NULL, FALSE));
+  g_assert_false (data.flushed);
+  g_assert_cmpint (g_atomic_int_get (&data.n_sent), <, WRITE_BATCH_NUM_MESSAGES);
+
+  g_mutex_lock (&data.mutex);
+  data.released = TRUE;
+  g_cond_broadcast (&data.cond);
+  g_mutex_unlock (&data.mutex);
+
+  while (!data.flushed)
+    g_main_context_iteration (NULL, TRUE);
+  while (g_atomic_int_get (&data.n_received) < WRITE_BATCH_NUM_MESSAGES)
+    g_thread_yield ();
+
+  g_assert_cmpint (g_atomic_int_get (&data.n_sent), ==, WRITE_BATCH_NUM_MESSAGES);
+
+  g_object_unref (data.consumer);
+  g_object_unref (data.producer);
+  g_mutex_clear (&data.mutex);
+  g_cond_clear (&data.cond);
+  g_free (payload);
+  g_close (fd, NULL);
+  g_unlink (path);
+  g_free (path);
+}
+
+#else
+
+static void
+test_write_batch (void)
+{
+  g_test_skip ("File descriptor passing is only supported on Unix");
+}
+
+#endif
+
+/* ---------------------------------------------------------------------------------------------------- */
+/* Test that signal callbacks are called in the order of the subscriptions,
+ * however the subscriptions are indexed */
+/* ---------------------------------------------------------------------------------------------------- */
+
+#ifdef G_OS_UNIX
+
+#define SIGNAL_ORDER_PATH "/org/gtk/GDBus/SignalOrder"
+#define SIGNAL_ORDER_INTERFACE "org.gtk.GDBus.SignalOrder"
+
+typedef struct
+{
+  const gchar *object_path;
+  const gchar *interface_name;
+  const gchar *member;
+  GString *fired;  /* (unowned) */
+  gchar name;
+} SignalOrderSubscription;
+
+static void
+signal_order_cb (GDBusConnection *connection,
+                 const gchar     *sender_name,
+                 const gchar     *object_path,
+                 const gchar     *interface_name,
+                 const gchar     *signal_name,
+                 GVariant        *parameters,
+                 gpointer         user_data)
+{
+  SignalOrderSubscription *subscription = user_data;
+
+  g_string_append_c (subscription->fired, subscription->name);
+}
+
+static void
+test_signal_order (void)
+{
+  SignalOrderSubscription subscriptions[] = {
+    /* member only */
+    { NULL, NULL, "Ping", NULL, 'a' },
+    /* catch-all */
+    { NULL, NULL, NULL, NULL, 'b' },
+    /* path */
+    { SIGNAL_ORDER_PATH, NULL, NULL, NULL, 'c' },
+    /* member and interface */
+    { NULL, SIGNAL_ORDER_INTERFACE, "Ping", NULL, 'd' },
+    /* interface only */
+    { NULL, SIGNAL_ORDER_INTERFACE, NULL, NULL, 'e' },
+    /* path and member */
+    { SIGNAL_ORDER_PATH, NULL, "Ping", NULL, 'f' },
+    /* another path */
+    { "/org/gtk/GDBus/SignalOrder/Other", NULL, NULL, NULL, 'g' },
+  };
+  guint ids[G_N_ELEMENTS (subscriptions)];
+  GDBusConnection *connections[2];
+  GString *fired;
+  GError *error = NULL;
+  gint pair[2];
+  gsize i;
+
+  g_assert_no_errno (socketpair (AF_UNIX, SOCK_STREAM, 0, pair));
+
+  for (i = 0; i < G_N_ELEMENTS (connections); i++)
+    {
+      GSocketConnection *stream;
+      GSocket *socket;
+
+      socket = g_socket_new_from_fd (pair[i], &error);
+      g_assert_no_error (error);
+      stream = g_socket_connection_factory_create_connection (socket);
+      connections[i] = g_dbus_connection_new_sync (G_IO_STREAM (stream), NULL,
+                                                   G_DBUS_CONNECTION_FLAGS_NONE,
+                                                   NULL, NULL, &error);
+      g_assert_no_error (error);
+      g_object_unref (stream);
+      g_object_unref (socket);
+    }
+
+  fired = g_string_new (NULL);
+
+  for (i = 0; i < G_N_ELEMENTS (subscriptions); i++)
+    {
+      subscriptions[i].fired = fired;
+      ids[i] = g_dbus_connection_signal_subscribe (connections[1],
+                                                   NULL,
+                                                   subscriptions[i].interface_name,
+                                                   subscriptions[i].member,
+                                                   subscriptions[i].object_path,
+                                                   NULL,
+                                                   G_DBUS_SIGNAL_FLAGS_NONE,
+                                                   signal_order_cb,
+                                                   &subscriptions[i],
+                                                   NULL);
+    }
+
+  g_dbus_connection_emit_signal (connections[0], NULL, SIGNAL_ORDER_PATH,
+                                 SIGNAL_ORDER_INTERFACE, "Ping", NULL, &error);
+  g_assert_no_error (error);
+
+  while (fired->len < 6)
+    g_main_context_iteration (NULL, TRUE);
+  g_assert_cmpstr (fired->str, ==, "abcdef");
+
+  /* Only matches the catch-all, interface and other path subscriptions */
+  g_dbus_connection_emit_signal (connections[0], NULL, "/org/gtk/GDBus/SignalOrder/Other",
+                                 SIGNAL_ORDER_INTERFACE, "Pong", NULL, &error);
+  g_assert_no_error (error);
+
+  while (fired->len < 9)
+    g_main_context_iteration (NULL, TRUE);
+  g_assert_cmpstr (fired->str, ==, "abcdefbeg");
+
+  for (i = 0; i < G_N_ELEMENTS (ids); i++)
+    g_dbus_connection_signal_unsubscribe (connections[1], ids[i]);
+
+  g_object_unref (connections[0]);
+  g_object_unref (connections[1]);
+  g_string_free (fired, TRUE);
+}
+
+#else
+
+static void
+test_signal_order (void)
+{
+  g_test_skip ("Socket pairs are only supported on Unix");
+}
+
+#endif
+
 /* ---------------------------------------------------------------------------------------------------- */
 
 static gboolean
@@ -2257,6 +2650,8 @@ main (int   argc,
 
   g_test_add_func ("/gdbus/tcp-anonymous", test_tcp_anonymous);
   g_test_add_func ("/gdbus/credentials", test_credentials);
+  g_test_add_func ("/gdbus/peer-to-peer/write-batch", test_write_batch);
+  g_test_add_func ("/gdbus/peer-to-peer/signal-order", test_signal_order);
   g_test_add_func ("/gdbus/codegen-peer-to-peer", codegen_test_peer);
 
   ret = g_test_run ();
@@ -928,6 +928,85 @@ test_no_properties (void)
   g_object_unref (proxy);
 }
 
+static void
+test_lazy_properties (void)
+{
+  test_proxy_with_flags (G_DBUS_PROXY_FLAGS_LAZY_PROPERTIES);
+}
+
+static void
+load_properties_batch_cb (GObject      *source,
+                          GAsyncResult *result,
+                          gpointer      user_data)
+{
+  GError *error = NULL;
+
+  g_assert_null (source);
+  g_assert_true (g_dbus_proxy_load_properties_batch_finish (result, &error));
+  g_assert_no_error (error);
+
+  g_main_loop_quit (loop);
+}
+
+static void
+test_load_properties_batch (void)
+{
+  GDBusConnection *connection;
+  GDBusProxy *proxies[3];
+  GVariant *variant;
+  GError *error = NULL;
+  gsize n;
+
+  g_test_summary ("Test loading the properties of several proxies at once");
+
+  connection = g_bus_get_sync (G_BUS_TYPE_SESSION, NULL, &error);
+  g_assert_no_error (error);
+
+  for (n = 0; n < G_N_ELEMENTS (proxies); n++)
+    {
+      proxies[n] = g_dbus_proxy_new_sync (connection,
+                                          G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES,
+                                          NULL,                      /* GDBusInterfaceInfo */
+                                          "com.example.TestService", /* name */
+                                          "/com/example/TestObject", /* object path */
+                                          "com.example.Frob",        /* interface */
+                                          NULL, /* GCancellable */
+                                          &error);
+      g_assert_no_error (error);
+    }
+
+  /* this is safe; we explicitly kill the service later on */
+  g_assert_true (g_spawn_command_line_async (g_test_get_filename (G_TEST_BUILT, "gdbus-testserver", NULL), NULL));
+
+  for (n = 0; n < G_N_ELEMENTS (proxies); n++)
+    {
+      gchar *owner = g_dbus_proxy_get_name_owner (proxies[n]);
+
+      if (owner == NULL)
+        _g_assert_property_notify (proxies[n], "g-name-owner");
+      g_free (owner);
+
+      g_assert_null (g_dbus_proxy_get_cached_property (proxies[n], "y"));
+    }
+
+  g_dbus_proxy_load_properties_batch (proxies, G_N_ELEMENTS (proxies), NULL,
+                                      load_properties_batch_cb, NULL);
+  g_main_loop_run (loop);
+
+  for (n = 0; n < G_N_ELEMENTS (proxies); n++)
+    {
+      variant = g_dbus_proxy_get_cached_property (proxies[n], "y");
+      g_assert_nonnull (variant);
+      g_variant_unref (variant);
+    }
+
+  kill_test_service (connection);
+
+  for (n = 0; n < G_N_ELEMENTS (proxies); n++)
+    g_object_unref (proxies[n]);
+  g_object_unref (connection);
+}
+
 static void
 check_error (GObject      *source,
              GAsyncResult *result,
@@ -1038,6 +1117,8 @@ main (int   argc,
   g_test_add_func ("/gdbus/proxy/wellknown-noauto", test_wellknown_noauto);
   g_test_add_func ("/gdbus/proxy/async", test_async);
   g_test_add_func ("/gdbus/proxy/no-match-rule", test_proxy_no_match_rule);
+  g_test_add_func ("/gdbus/proxy/lazy-properties", test_lazy_properties);
+  g_test_add_func ("/gdbus/proxy/load-properties-batch", test_load_properties_batch);
 
   ret = session_bus_run();
 
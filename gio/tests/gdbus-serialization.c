@@ -1682,6 +1682,75 @@ test_message_parse_truncated (void)
   g_free (blob);
 }
 
+static void
+test_message_parse_from_bytes (void)
+{
+  const GDBusMessageByteOrder byte_orders[] = {
+    G_DBUS_MESSAGE_BYTE_ORDER_LITTLE_ENDIAN,
+    G_DBUS_MESSAGE_BYTE_ORDER_BIG_ENDIAN,
+  };
+  guint8 *bytes_data;
+  guint32 *uints;
+  GVariant *body;
+  gsize i;
+
+  bytes_data = g_malloc (65536);
+  for (i = 0; i < 65536; i++)
+    bytes_data[i] = i % 251;
+  uints = g_new (guint32, 8192);
+  for (i = 0; i < 8192; i++)
+    uints[i] = i * 1000003;
+
+  body = g_variant_ref_sink (g_variant_new ("(@ays@au)",
+                                            g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE, bytes_data, 65536, 1),
+                                            "frame",
+                                            g_variant_new_fixed_array (G_VARIANT_TYPE_UINT32, uints, 8192, 4)));
+
+  for (i = 0; i < G_N_ELEMENTS (byte_orders); i++)
+    {
+      GDBusMessage *message, *message2;
+      GBytes *bytes;
+      guchar *blob;
+      gsize size;
+      gconstpointer blob_data;
+      GVariant *ay;
+      gconstpointer ay_data;
+      GError *error = NULL;
+
+      message = g_dbus_message_new_signal ("/foo", "org.example.Foo", "Frame");
+      g_dbus_message_set_byte_order (message, byte_orders[i]);
+      g_dbus_message_set_body (message, body);
+
+      blob = g_dbus_message_to_blob (message, &size, G_DBUS_CAPABILITY_FLAGS_NONE, &error);
+      g_assert_no_error (error);
+      bytes = g_bytes_new_take (blob, size);
+      blob_data = g_bytes_get_data (bytes, NULL);
+
+      message2 = g_dbus_message_new_from_bytes (bytes, G_DBUS_CAPABILITY_FLAGS_NONE, &error);
+      g_assert_no_error (error);
+      g_assert_true (g_variant_equal (g_dbus_message_get_body (message2), body));
+
+      /* The byte array references the message, whatever the byte order */
+      ay = g_variant_get_child_value (g_dbus_message_get_body (message2), 0);
+      ay_data = g_variant_get_data (ay);
+      g_assert_true ((const guint8 *) ay_data >= (const guint8 *) blob_data &&
+                     (const guint8 *) ay_data < (const guint8 *) blob_data + size);
+      g_variant_unref (ay);
+
+      /* The body outlives the message and the caller’s reference to @bytes */
+      g_bytes_unref (bytes);
+      g_object_unref (message);
+      g_variant_unref (body);
+      body = g_variant_ref (g_dbus_message_get_body (message2));
+      g_object_unref (message2);
+      g_assert_cmpuint (g_variant_get_size (body), >=, 65536 + 8192 * 4);
+    }
+
+  g_variant_unref (body);
+  g_free (uints);
+  g_free (bytes_data);
+}
+
 static void
 test_message_parse_empty_structure (void)
 {
@@ -1913,6 +1982,8 @@ main (int   argc,
   g_test_add_func ("/gdbus/message-serialize/empty-structure",
                    test_message_serialize_empty_structure);
 
+  g_test_add_func ("/gdbus/message-parse/from-bytes",
+                   test_message_parse_from_bytes);
   g_test_add_func ("/gdbus/message-parse/empty-arrays-of-arrays",
                    test_message_parse_empty_arrays_of_arrays);
   g_test_add_func ("/gdbus/message-parse/non-signature-header",
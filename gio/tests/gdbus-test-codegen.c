@@ -453,6 +453,7 @@ static FooiGenAuthorize *exported_authorize_object = NULL;
 static GDBusObjectSkeleton *authorize_enclosing_object = NULL;
 static FooiGenMethodThreads *exported_thread_object_1 = NULL;
 static FooiGenMethodThreads *exported_thread_object_2 = NULL;
+static FooiGenMethodThreads *exported_thread_object_3 = NULL;
 
 static void
 unexport_objects (void)
@@ -462,6 +463,7 @@ unexport_objects (void)
   g_dbus_interface_skeleton_unexport (G_DBUS_INTERFACE_SKELETON (exported_authorize_object));
   g_dbus_interface_skeleton_unexport (G_DBUS_INTERFACE_SKELETON (exported_thread_object_1));
   g_dbus_interface_skeleton_unexport (G_DBUS_INTERFACE_SKELETON (exported_thread_object_2));
+  g_dbus_interface_skeleton_unexport (G_DBUS_INTERFACE_SKELETON (exported_thread_object_3));
   g_dbus_interface_skeleton_unexport (G_DBUS_INTERFACE_SKELETON (exported_fd_passing_object));
 }
 
@@ -604,6 +606,27 @@ on_bus_acquired (GDBusConnection *connection,
 
   g_assert_cmpint (g_dbus_interface_skeleton_get_flags (G_DBUS_INTERFACE_SKELETON (exported_thread_object_2)), ==, G_DBUS_INTERFACE_SKELETON_FLAGS_NONE);
 
+  /* object 3 handles method invocations in a thread pool of its own */
+  exported_thread_object_3 = foo_igen_method_threads_skeleton_new ();
+#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_82
+  g_dbus_interface_skeleton_set_flags (G_DBUS_INTERFACE_SKELETON (exported_thread_object_3),
+                                       G_DBUS_INTERFACE_SKELETON_FLAGS_HANDLE_METHOD_INVOCATIONS_IN_THREAD |
+                                       G_DBUS_INTERFACE_SKELETON_FLAGS_SERIALIZE_PER_SENDER);
+  g_dbus_interface_skeleton_set_max_threads (G_DBUS_INTERFACE_SKELETON (exported_thread_object_3), 2);
+#else
+  g_dbus_interface_skeleton_set_flags (G_DBUS_INTERFACE_SKELETON (exported_thread_object_3),
+                                       G_DBUS_INTERFACE_SKELETON_FLAGS_HANDLE_METHOD_INVOCATIONS_IN_THREAD);
+#endif
+  g_dbus_interface_skeleton_export (G_DBUS_INTERFACE_SKELETON (exported_thread_object_3),
+                                    connection,
+                                    "/method_threads_3",
+                                    &error);
+  g_assert_no_error (error);
+  g_signal_connect (exported_thread_object_3,
+                    "handle-get-self",
+                    G_CALLBACK (on_handle_get_self),
+                    NULL);
+
   exported_fd_passing_object = foo_igen_test_fdpassing_skeleton_new ();
   g_dbus_interface_skeleton_export (G_DBUS_INTERFACE_SKELETON (exported_fd_passing_object),
                                     connection,
@@ -1359,13 +1382,21 @@ get_self_via_proxy (FooiGenMethodThreads *proxy_1)
 static void
 check_thread_proxies (FooiGenMethodThreads *proxy_1,
                       FooiGenMethodThreads *proxy_2,
+                      FooiGenMethodThreads *proxy_3,
                       GMainLoop            *thread_loop)
 {
+  guint n;
+
   /* proxy_1 is indeed using threads so should never get the handler thread */
   g_assert (get_self_via_proxy (proxy_1) != method_handler_thread);
 
   /* proxy_2 is not using threads so should get the handler thread */
   g_assert (get_self_via_proxy (proxy_2) == method_handler_thread);
+
+  /* proxy_3 uses a thread pool, which must keep working for more calls than
+   * it has threads */
+  for (n = 0; n < 5; n++)
+    g_assert (get_self_via_proxy (proxy_3) != method_handler_thread);
 }
 
 /* ---------------------------------------------------------------------------------------------------- */
@@ -1383,6 +1414,7 @@ check_proxies_in_thread (gpointer user_data)
   FooiGenAuthorize *authorize_proxy;
   FooiGenMethodThreads *thread_proxy_1;
   FooiGenMethodThreads *thread_proxy_2;
+  FooiGenMethodThreads *thread_proxy_3;
 
   thread_context = g_main_context_new ();
   thread_loop = g_main_loop_new (thread_context, FALSE);
@@ -1437,9 +1469,17 @@ check_proxies_in_thread (gpointer user_data)
                                                                    NULL, /* GCancellable* */
                                                                    &error);
   g_assert_no_error (error);
-  check_thread_proxies (thread_proxy_1, thread_proxy_2, thread_loop);
+  thread_proxy_3 = foo_igen_method_threads_proxy_new_for_bus_sync (G_BUS_TYPE_SESSION,
+                                                                   G_DBUS_PROXY_FLAGS_NONE,
+                                                                   "org.gtk.GDBus.BindingsTool.Test",
+                                                                   "/method_threads_3",
+                                                                   NULL, /* GCancellable* */
+                                                                   &error);
+  g_assert_no_error (error);
+  check_thread_proxies (thread_proxy_1, thread_proxy_2, thread_proxy_3, thread_loop);
   g_object_unref (thread_proxy_1);
   g_object_unref (thread_proxy_2);
+  g_object_unref (thread_proxy_3);
 
    fd_passing_proxy = foo_igen_test_fdpassing_proxy_new_for_bus_sync (G_BUS_TYPE_SESSION,
                                                                       G_DBUS_PROXY_FLAGS_NONE,
@@ -92,7 +92,7 @@ main (int argc, char **argv)
 
       if (g_str_equal (argv[i], "--help"))
         {
-          g_print ("usage: du [--progress] [--async] [-x] [-h] [-h] [--apparent-size] [--any-error] [--] files...\n");
+          g_print ("usage: du [--progress] [--async] [-x] [-h] [-h] [--apparent-size] [--any-error] [--dedupe] [--parallel] [--] files...\n");
 #ifdef G_OS_WIN32
           g_strfreev (argv);
 #endif
@@ -106,6 +106,10 @@ main (int argc, char **argv)
         flags |= G_FILE_MEASURE_APPARENT_SIZE;
       else if (g_str_equal (argv[i], "--any-error"))
         flags |= G_FILE_MEASURE_REPORT_ANY_ERROR;
+      else if (g_str_equal (argv[i], "--dedupe"))
+        flags |= G_FILE_MEASURE_DEDUPLICATE_HARDLINKS;
+      else if (g_str_equal (argv[i], "--parallel"))
+        flags |= G_FILE_MEASURE_PARALLEL;
       else if (g_str_equal (argv[i], "--async"))
         option_use_async = TRUE;
       else if (g_str_equal (argv[i], "--progress"))
@@ -118,7 +122,7 @@ main (int argc, char **argv)
 
   if (!argv[i])
     {
-      g_printerr ("usage: du [--progress] [--async] [-x] [-h] [-h] [--apparent-size] [--any-error] [--] files...\n");
+      g_printerr ("usage: du [--progress] [--async] [-x] [-h] [-h] [--apparent-size] [--any-error] [--dedupe] [--parallel] [--] files...\n");
 #ifdef G_OS_WIN32
       g_strfreev (argv);
 #endif
@@ -88,12 +88,12 @@ test_store_boundaries (void)
   item = g_menu_item_new (NULL, NULL);
 
   /* remove an item from an empty list */
-  g_test_expect_message (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL, "*g_sequence*");
+  g_test_expect_message (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL, "*position*");
   g_list_store_remove (store, 0);
   g_test_assert_expected_messages ();
 
   /* don't allow inserting an item past the end ... */
-  g_test_expect_message (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL, "*g_sequence*");
+  g_test_expect_message (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL, "*position*");
   g_list_store_insert (store, 1, item);
   assert_cmpitems (store, ==, 0);
   g_test_assert_expected_messages ();
@@ -103,7 +103,7 @@ test_store_boundaries (void)
   assert_cmpitems (store, ==, 1);
 
   /* remove a non-existing item at exactly the end of the list */
-  g_test_expect_message (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL, "*g_sequence*");
+  g_test_expect_message (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL, "*position*");
   g_list_store_remove (store, 1);
   g_test_assert_expected_messages ();
 
@@ -428,6 +428,97 @@ model_array_equal (GListModel *model, GPtrArray *array)
   return TRUE;
 }
 
+/* Test random splices on a store large enough to need several levels of
+ * nodes internally, checking it against a plain array */
+static void
+test_store_large (void)
+{
+  GListStore *store;
+  GListModel *model;
+  GPtrArray *array;
+  GObject *items[100];
+  guint i, j, position;
+
+  store = g_list_store_new (G_TYPE_OBJECT);
+  model = G_LIST_MODEL (store);
+  array = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (i = 0; i < 3000; i++)
+    {
+      guint n_items = array->len;
+      guint n_removals, n_additions;
+
+      /* Grow for a while, then shrink back */
+      position = g_test_rand_int_range (0, n_items + 1);
+      n_removals = g_test_rand_int_range (0, MIN (n_items - position, i < 2000 ? 40 : 120) + 1);
+      n_additions = g_test_rand_int_range (0, G_N_ELEMENTS (items));
+
+      for (j = 0; j < n_additions; j++)
+        items[j] = g_object_new (G_TYPE_OBJECT, NULL);
+
+      g_list_store_splice (store, position, n_removals, (gpointer *) items, n_additions);
+
+      g_ptr_array_remove_range (array, position, n_removals);
+      for (j = 0; j < n_additions; j++)
+        g_ptr_array_insert (array, position + j, items[j]);
+
+      if (i % 500 == 0)
+        g_assert_true (model_array_equal (model, array));
+    }
+
+  g_assert_true (model_array_equal (model, array));
+
+  /* Fetch ranges in bulk, across leaves and past the end */
+  for (i = 0; i < 100; i++)
+    {
+      guint n;
+
+      position = g_test_rand_int_range (0, array->len + 1);
+      n = g_list_model_get_items (model, position, G_N_ELEMENTS (items), (gpointer *) items);
+      g_assert_cmpuint (n, ==, MIN (G_N_ELEMENTS (items), array->len - position));
+
+      for (j = 0; j < n; j++)
+        {
+          g_assert_true (items[j] == g_ptr_array_index (array, position + j));
+          g_object_unref (items[j]);
+        }
+    }
+
+  /* Walk backwards, which goes through the cache too */
+  for (i = array->len; i > 0; i--)
+    {
+      GObject *item = list_model_get (model, i - 1);
+      g_assert_true (item == g_ptr_array_index (array, i - 1));
+      g_object_unref (item);
+    }
+
+  /* Random access and lookups */
+  for (i = 0; i < 1000 && array->len > 0; i++)
+    {
+      GObject *item;
+
+      j = g_test_rand_int_range (0, array->len);
+      item = list_model_get (model, j);
+      g_assert_true (item == g_ptr_array_index (array, j));
+      g_assert_true (g_list_store_find (store, item, &position));
+      g_assert_cmpuint (position, ==, j);
+      g_object_unref (item);
+    }
+
+  /* Remove items one at a time from the middle */
+  while (array->len > 0)
+    {
+      position = array->len / 2;
+      g_list_store_remove (store, position);
+      g_ptr_array_remove_index (array, position);
+    }
+
+  assert_cmpitems (store, ==, 0);
+
+  g_object_unref (store);
+  g_ptr_array_unref (array);
+}
+
 /* Test that using splice() to remove multiple items at different
  * positions works */
 static void
@@ -807,6 +898,89 @@ test_store_signal_items_changed (void)
   g_object_unref (store);
 }
 
+static void
+on_items_changed_record (GListModel *model,
+                         guint       position,
+                         guint       removed,
+                         guint       added,
+                         GArray     *changes)
+{
+  guint change[3] = { position, removed, added };
+
+  g_array_append_vals (changes, change, 3);
+}
+
+static void
+assert_changes (GArray      *changes,
+                const guint *expected,
+                guint        n_expected)
+{
+  g_assert_cmpmem (changes->data, changes->len * sizeof (guint),
+                   expected, n_expected * sizeof (guint));
+  g_array_set_size (changes, 0);
+}
+
+/* Test that changes made while frozen are merged when thawing */
+static void
+test_store_freeze_items_changed (void)
+{
+  GListStore *store;
+  GListModel *model;
+  GArray *changes;
+  GObject *items[10];
+  guint i;
+
+  store = g_list_store_new (G_TYPE_OBJECT);
+  model = G_LIST_MODEL (store);
+  changes = g_array_new (FALSE, FALSE, sizeof (guint));
+  g_signal_connect (model, "items-changed", G_CALLBACK (on_items_changed_record), changes);
+
+  for (i = 0; i < G_N_ELEMENTS (items); i++)
+    items[i] = g_object_new (G_TYPE_OBJECT, NULL);
+
+  /* Consecutive appends are merged into one change */
+  g_list_model_freeze_items_changed (model);
+  for (i = 0; i < 5; i++)
+    g_list_store_append (store, items[i]);
+  g_assert_cmpuint (changes->len, ==, 0);
+  g_list_model_thaw_items_changed (model);
+  assert_changes (changes, (guint[]) { 0, 0, 5 }, 3);
+
+  /* Nested freezes only emit on the last thaw; disjoint changes are
+   * emitted separately, in order and with shifted positions, and an
+   * insertion that is removed again cancels out */
+  g_list_model_freeze_items_changed (model);
+  g_list_model_freeze_items_changed (model);
+  g_list_store_remove (store, 4);
+  g_list_store_insert (store, 0, items[5]);
+  g_list_store_insert (store, 3, items[6]);
+  g_list_store_remove (store, 3);
+  g_list_model_thaw_items_changed (model);
+  g_assert_cmpuint (changes->len, ==, 0);
+  g_list_model_thaw_items_changed (model);
+  assert_changes (changes, (guint[]) { 0, 0, 1, 5, 1, 0 }, 6);
+
+  /* Changes spanning several pending ones merge them all */
+  g_list_model_freeze_items_changed (model);
+  g_list_store_remove (store, 0);
+  g_list_store_insert (store, 2, items[7]);
+  g_list_store_splice (store, 0, 4, (gpointer *) &items[8], 2);
+  g_list_model_thaw_items_changed (model);
+  assert_changes (changes, (guint[]) { 0, 4, 2 }, 3);
+
+  /* Nothing is emitted if nothing changed */
+  g_list_model_freeze_items_changed (model);
+  g_list_model_thaw_items_changed (model);
+  g_assert_cmpuint (changes->len, ==, 0);
+
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 3);
+
+  for (i = 0; i < G_N_ELEMENTS (items); i++)
+    g_object_unref (items[i]);
+  g_array_unref (changes);
+  g_object_unref (store);
+}
+
 /* Due to an overflow in the list store last-iter optimization,
  * the sequence 'lookup 0; lookup MAXUINT' was returning the
  * same item twice, and not NULL for the second lookup.
@@ -955,8 +1129,11 @@ int main (int argc, char *argv[])
                    test_store_get_item_cache);
   g_test_add_func ("/glistmodel/store/items-changed",
                    test_store_signal_items_changed);
+  g_test_add_func ("/glistmodel/store/freeze-items-changed",
+                   test_store_freeze_items_changed);
   g_test_add_func ("/glistmodel/store/past-end", test_store_past_end);
   g_test_add_func ("/glistmodel/store/find", test_store_find);
+  g_test_add_func ("/glistmodel/store/large", test_store_large);
 
   return g_test_run ();
 }
@@ -465,6 +465,133 @@ test_changes (void)
   g_object_unref (settings);
 }
 
+/* Test that values are cached, and that the cache follows changes made
+ * through other #GSettings objects.
+ */
+static void
+test_cached_values (void)
+{
+  GSettings *settings;
+  GSettings *settings2;
+
+  settings = g_settings_new ("org.gtk.test.basic-types");
+  settings2 = g_settings_new ("org.gtk.test.basic-types");
+
+  g_assert_cmpint (g_settings_get_int (settings, "test-int32"), ==, -123456);
+  g_assert_cmpint (g_settings_get_int (settings, "test-int32"), ==, -123456);
+
+  g_settings_set_int (settings2, "test-int32", 42);
+  g_assert_cmpint (g_settings_get_int (settings, "test-int32"), ==, 42);
+
+  g_settings_set_int (settings, "test-int32", 43);
+  g_assert_cmpint (g_settings_get_int (settings, "test-int32"), ==, 43);
+  g_assert_cmpint (g_settings_get_int (settings2, "test-int32"), ==, 43);
+
+  g_settings_reset (settings2, "test-int32");
+  g_assert_cmpint (g_settings_get_int (settings, "test-int32"), ==, -123456);
+
+  g_object_unref (settings2);
+  g_object_unref (settings);
+}
+
+static void
+test_get_many (void)
+{
+  const gchar * const keys[] = { "test-boolean", "test-int32", "test-string", NULL };
+  GSettings *settings;
+  GVariant *values;
+  gboolean b;
+  gint32 i;
+  gchar *str;
+
+  settings = g_settings_new ("org.gtk.test.basic-types");
+
+  g_settings_set_int (settings, "test-int32", 7);
+  /* Cache one of the values but not the others */
+  g_assert_true (g_settings_get_boolean (settings, "test-boolean"));
+
+  values = g_settings_get_many (settings, keys);
+  g_assert_true (g_variant_is_of_type (values, G_VARIANT_TYPE ("(bis)")));
+  g_variant_get (values, "(bis)", &b, &i, &str);
+  g_assert_true (b);
+  g_assert_cmpint (i, ==, 7);
+  g_assert_cmpstr (str, ==, "a string, it seems");
+
+  g_free (str);
+  g_variant_unref (values);
+  g_settings_reset (settings, "test-int32");
+  g_object_unref (settings);
+}
+
+static gboolean
+count_change_event_cb (GSettings    *settings,
+                       const GQuark *keys,
+                       gint          n_keys,
+                       gpointer      user_data)
+{
+  gint *n_events = user_data;
+
+  g_assert_cmpint (n_keys, ==, 2);
+  (*n_events)++;
+
+  return FALSE;
+}
+
+static void
+count_changed_cb (GSettings   *settings,
+                  const gchar *key,
+                  gpointer     user_data)
+{
+  gint *n_changed = user_data;
+
+  (*n_changed)++;
+}
+
+/* Test that a burst of changes results in a single change-event when
+ * changes are coalesced, and that #GSettings::changed is still emitted
+ * once per key.
+ */
+static void
+test_coalesce_changes (void)
+{
+  GSettings *settings;
+  gint n_events = 0;
+  gint n_changed = 0;
+
+  settings = g_settings_new ("org.gtk.test.basic-types");
+  g_assert_false (g_settings_get_coalesce_changes (settings));
+  g_settings_set_coalesce_changes (settings, TRUE);
+  g_assert_true (g_settings_get_coalesce_changes (settings));
+
+  g_signal_connect (settings, "change-event",
+                    G_CALLBACK (count_change_event_cb), &n_events);
+  g_signal_connect (settings, "changed",
+                    G_CALLBACK (count_changed_cb), &n_changed);
+
+  g_settings_set_int (settings, "test-int32", 1);
+  g_settings_set_int (settings, "test-int32", 2);
+  g_settings_set_boolean (settings, "test-boolean", FALSE);
+  g_assert_cmpint (n_events, ==, 0);
+
+  /* The new values are visible straight away */
+  g_assert_cmpint (g_settings_get_int (settings, "test-int32"), ==, 2);
+
+  while (n_events == 0)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpint (n_events, ==, 1);
+  g_assert_cmpint (n_changed, ==, 2);
+
+  g_signal_handlers_disconnect_by_data (settings, &n_events);
+  g_signal_handlers_disconnect_by_data (settings, &n_changed);
+  g_settings_reset (settings, "test-int32");
+  g_settings_reset (settings, "test-boolean");
+
+  while (g_main_context_iteration (NULL, FALSE));
+
+  g_object_unref (settings);
+}
+
 static gboolean changed_cb_called2;
 
 static void
@@ -2816,7 +2943,7 @@ test_schema_source (void)
   GSettingsSchemaSource *parent;
   GSettingsSchemaSource *source;
   GSettingsBackend *backend;
-  GSettingsSchema *schema;
+  GSettingsSchema *schema, *schema2;
   GError *error = NULL;
   GSettings *settings, *child;
   gboolean enabled;
@@ -2850,6 +2977,11 @@ test_schema_source (void)
   /* check recursive lookups are working */
   schema = g_settings_schema_source_lookup (source, "org.gtk.test", TRUE);
   g_assert_nonnull (schema);
+
+  /* schemas from the default sources are shared */
+  schema2 = g_settings_schema_source_lookup (parent, "org.gtk.test", TRUE);
+  g_assert_true (schema2 == schema);
+  g_settings_schema_unref (schema2);
   g_settings_schema_unref (schema);
 
   /* check recursive lookups for non-existent schemas */
@@ -3248,6 +3380,45 @@ test_extended_schema (void)
   g_settings_schema_unref (schema);
 }
 
+/* Values of schemas which extend others are remembered after the first
+ * lookup, so look each key up repeatedly */
+static void
+test_extended_schema_values (void)
+{
+  GSettings *base, *extended;
+  guint i;
+
+  base = g_settings_new_with_path ("org.gtk.test.extends.base", "/test/extends-values/base/");
+  extended = g_settings_new_with_path ("org.gtk.test.extends.extended", "/test/extends-values/extended/");
+
+  for (i = 0; i < 3; i++)
+    {
+      GSettingsSchema *schema;
+      GSettingsSchemaKey *key;
+
+      g_assert_cmpint (g_settings_get_int (extended, "int32"), ==, 42);
+      g_assert_cmpint (g_settings_get_int (extended, "another-int32"), ==, 0);
+      check_and_free (g_settings_get_value (extended, "string"), "''");
+      g_assert_cmpint (g_settings_get_int (base, "int32"), ==, 0);
+
+      g_object_get (extended, "settings-schema", &schema, NULL);
+      key = g_settings_schema_get_key (schema, "string");
+      g_assert_true (g_variant_type_equal (g_settings_schema_key_get_value_type (key),
+                                           G_VARIANT_TYPE_STRING));
+      check_and_free (g_settings_schema_key_get_default_value (key), "''");
+      g_settings_schema_key_unref (key);
+      g_settings_schema_unref (schema);
+    }
+
+  g_settings_set_int (extended, "int32", 7);
+  g_assert_cmpint (g_settings_get_int (extended, "int32"), ==, 7);
+  g_settings_reset (extended, "int32");
+  g_assert_cmpint (g_settings_get_int (extended, "int32"), ==, 42);
+
+  g_object_unref (extended);
+  g_object_unref (base);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -3366,6 +3537,9 @@ main (int argc, char *argv[])
   g_test_add_func ("/gsettings/basic-types", test_basic_types);
   g_test_add_func ("/gsettings/complex-types", test_complex_types);
   g_test_add_func ("/gsettings/changes", test_changes);
+  g_test_add_func ("/gsettings/cached-values", test_cached_values);
+  g_test_add_func ("/gsettings/get-many", test_get_many);
+  g_test_add_func ("/gsettings/coalesce-changes", test_coalesce_changes);
 
   g_test_add_func ("/gsettings/l10n", test_l10n);
   g_test_add_func ("/gsettings/l10n-context", test_l10n_context);
@@ -3429,6 +3603,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/gsettings/memory-backend", test_memory_backend);
   g_test_add_func ("/gsettings/read-descriptions", test_read_descriptions);
   g_test_add_func ("/gsettings/test-extended-schema", test_extended_schema);
+  g_test_add_func ("/gsettings/test-extended-schema-values", test_extended_schema_values);
   g_test_add_func ("/gsettings/default-value", test_default_value);
   g_test_add_func ("/gsettings/per-desktop", test_per_desktop);
   g_test_add_func ("/gsettings/per-desktop/subprocess", test_per_desktop_subprocess);
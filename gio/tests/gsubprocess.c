@@ -1229,6 +1229,88 @@ test_communicate_nothing (void)
   g_object_unref (proc);
 }
 
+/* Test that output much larger than the read buffers is returned whole. */
+static void
+test_communicate_large (void)
+{
+  GError *error = NULL;
+  GPtrArray *args;
+  GSubprocess *proc;
+  guint8 *data;
+  gsize data_len = 3 * 1024 * 1024 + 1;
+  GBytes *input, *stdout_bytes = NULL;
+
+  data = g_malloc (data_len);
+  memset (data, 'x', data_len);
+  input = g_bytes_new_take (data, data_len);
+
+  args = get_test_subprocess_args ("cat", NULL);
+  proc = g_subprocess_newv ((const gchar* const*)args->pdata,
+                            G_SUBPROCESS_FLAGS_STDIN_PIPE | G_SUBPROCESS_FLAGS_STDOUT_PIPE,
+                            &error);
+  g_assert_no_error (error);
+  g_ptr_array_free (args, TRUE);
+
+  g_subprocess_communicate (proc, input, NULL, &stdout_bytes, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_true (g_bytes_equal (stdout_bytes, input));
+
+  g_bytes_unref (stdout_bytes);
+  g_bytes_unref (input);
+  g_object_unref (proc);
+}
+
+static void
+test_communicate_to_streams (void)
+{
+  GError *error = NULL;
+  GPtrArray *args;
+  GSubprocess *proc;
+  guint8 *data;
+  gsize data_len = 1024 * 1024;
+  GBytes *input, *output;
+  GOutputStream *stdout_stream;
+
+  data = g_malloc (data_len);
+  memset (data, 'x', data_len);
+  input = g_bytes_new_take (data, data_len);
+
+  args = get_test_subprocess_args ("cat", NULL);
+  proc = g_subprocess_newv ((const gchar* const*)args->pdata,
+                            G_SUBPROCESS_FLAGS_STDIN_PIPE | G_SUBPROCESS_FLAGS_STDOUT_PIPE,
+                            &error);
+  g_assert_no_error (error);
+  g_ptr_array_free (args, TRUE);
+
+  stdout_stream = g_memory_output_stream_new_resizable ();
+  g_subprocess_communicate_to_streams (proc, input, stdout_stream, NULL, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_true (g_subprocess_get_successful (proc));
+
+  g_output_stream_close (stdout_stream, NULL, &error);
+  g_assert_no_error (error);
+  output = g_memory_output_stream_steal_as_bytes (G_MEMORY_OUTPUT_STREAM (stdout_stream));
+  g_assert_true (g_bytes_equal (output, input));
+  g_bytes_unref (output);
+  g_object_unref (stdout_stream);
+  g_object_unref (proc);
+
+  /* Output without a stream is drained and discarded */
+  args = get_test_subprocess_args ("cat", NULL);
+  proc = g_subprocess_newv ((const gchar* const*)args->pdata,
+                            G_SUBPROCESS_FLAGS_STDIN_PIPE | G_SUBPROCESS_FLAGS_STDOUT_PIPE,
+                            &error);
+  g_assert_no_error (error);
+  g_ptr_array_free (args, TRUE);
+
+  g_subprocess_communicate_to_streams (proc, input, NULL, NULL, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_true (g_subprocess_get_successful (proc));
+
+  g_bytes_unref (input);
+  g_object_unref (proc);
+}
+
 static void
 test_communicate_utf8_async_invalid (void)
 {
@@ -2243,6 +2325,8 @@ main (int argc, char **argv)
   g_test_add_func ("/gsubprocess/communicate/utf8/async/invalid", test_communicate_utf8_async_invalid);
   g_test_add_func ("/gsubprocess/communicate/utf8/invalid", test_communicate_utf8_invalid);
   g_test_add_func ("/gsubprocess/communicate/nothing", test_communicate_nothing);
+  g_test_add_func ("/gsubprocess/communicate/large", test_communicate_large);
+  g_test_add_func ("/gsubprocess/communicate/to-streams", test_communicate_to_streams);
   g_test_add_func ("/gsubprocess/terminate", test_terminate);
   g_test_add_func ("/gsubprocess/env", test_env);
   g_test_add_func ("/gsubprocess/env/inherit", test_env_inherit);
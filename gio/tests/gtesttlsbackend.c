@@ -148,6 +148,13 @@ g_test_tls_certificate_get_property (GObject    *object,
 
   switch (prop_id)
     {
+    case PROP_CERT_CERTIFICATE:
+      /* Not DER, but unique per certificate, which is all the tests need */
+      if (cert->cert_pem != NULL)
+        g_value_take_boxed (value, g_byte_array_append (g_byte_array_new (),
+                                                        (const guint8 *) cert->cert_pem,
+                                                        strlen (cert->cert_pem)));
+      break;
     case PROP_CERT_CERTIFICATE_PEM:
       g_value_set_string (value, cert->cert_pem);
       break;
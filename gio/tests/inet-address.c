@@ -408,6 +408,154 @@ test_mask_match (void)
 
 }
 
+static void
+test_address_bytes (void)
+{
+  const gchar *valid[] = {
+    "0.0.0.0",
+    "204.152.189.116",
+    "255.255.255.255",
+    "::",
+    "::1",
+    "1::8",
+    "1:0:0:0:0:0:0:8",
+    "fe80::1:2:3",
+    "::ffff:204.152.189.116",
+    "0:0:0:0:0:FFFF:204.152.189.116",
+    "1:2:3:4:5:6:7::",
+    "::2:3:4:5:6:7:8",
+  };
+  const gchar *invalid[] = {
+    "",
+    "1.2.3",
+    "1.2.3.4.5",
+    "1.2.3.256",
+    "01.2.3.4",
+    "1.2.3.4 ",
+    "1..2.3",
+    ":",
+    ":1::2",
+    "::1::2",
+    "1:2:3:4:5:6:7:8:9",
+    "1:2:3:4:5:6:7:8::",
+    "12345::",
+    "1:",
+    "[::1]",
+    "fe80::1%1",
+    "::ffff:1.2.3",
+  };
+  GInetAddressBytes bytes, bytes2;
+  gchar buffer[G_INET_ADDRESS_BYTES_STRING_SIZE];
+  gsize i;
+
+  for (i = 0; i < G_N_ELEMENTS (valid); i++)
+    {
+      GInetAddress *addr;
+      gchar *expected;
+
+      g_test_message ("Parsing “%s”", valid[i]);
+      g_assert_true (g_inet_address_bytes_parse (valid[i], -1, &bytes));
+
+      /* Parsing and formatting agree with GInetAddress */
+      addr = g_inet_address_new_from_string (valid[i]);
+      g_assert_nonnull (addr);
+      g_inet_address_get_address_bytes (addr, &bytes2);
+      g_assert_true (g_inet_address_bytes_equal (&bytes, &bytes2));
+
+      expected = g_inet_address_to_string (addr);
+      g_assert_cmpuint (g_inet_address_bytes_to_string (&bytes, buffer), ==, strlen (expected));
+      g_assert_cmpstr (buffer, ==, expected);
+
+      g_free (expected);
+      g_object_unref (addr);
+    }
+
+  for (i = 0; i < G_N_ELEMENTS (invalid); i++)
+    {
+      g_test_message ("Parsing “%s”", invalid[i]);
+      g_assert_false (g_inet_address_bytes_parse (invalid[i], -1, &bytes));
+    }
+
+  /* The string need not be nul-terminated */
+  g_assert_true (g_inet_address_bytes_parse ("10.0.0.1 - - [01/Jan/2024]", 8, &bytes));
+  g_assert_cmpint (bytes.family, ==, G_SOCKET_FAMILY_IPV4);
+  g_inet_address_bytes_to_string (&bytes, buffer);
+  g_assert_cmpstr (buffer, ==, "10.0.0.1");
+}
+
+static void
+test_mask_set (void)
+{
+  GInetAddressMaskSet *set;
+  GInetAddressMask *mask;
+  GInetAddressBytes bytes;
+  GError *error = NULL;
+  gsize i;
+  const struct {
+    const gchar *address;
+    gboolean contained;
+  } tests[] = {
+    { "10.1.2.3", TRUE },
+    { "11.0.0.0", FALSE },
+    { "192.168.1.1", TRUE },
+    { "192.168.2.1", FALSE },
+    { "172.16.0.1", TRUE },
+    { "172.17.0.1", FALSE },
+    { "1.2.3.4", TRUE },
+    { "1.2.3.5", FALSE },
+    { "fe80::1", TRUE },
+    { "fec0::1", FALSE },
+    { "::1", FALSE },
+    { "::ffff:10.1.2.3", FALSE },
+  };
+
+  set = g_inet_address_mask_set_new ();
+
+  g_assert_true (g_inet_address_mask_set_add_string (set, "10.0.0.0/8", &error));
+  g_assert_no_error (error);
+  g_assert_true (g_inet_address_mask_set_add_string (set, "192.168.1.0/24", &error));
+  g_assert_true (g_inet_address_mask_set_add_string (set, "1.2.3.4", &error));
+  /* Already covered by 10.0.0.0/8 */
+  g_assert_true (g_inet_address_mask_set_add_string (set, "10.1.0.0/16", &error));
+  g_assert_true (g_inet_address_mask_set_add_string (set, "fe80::/10", &error));
+  g_assert_no_error (error);
+
+  mask = g_inet_address_mask_new_from_string ("172.16.0.0/16", NULL);
+  g_inet_address_mask_set_add (set, mask);
+
+  g_assert_false (g_inet_address_mask_set_add_string (set, "10.0.0.1/8", &error));
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT);
+  g_clear_error (&error);
+  g_assert_false (g_inet_address_mask_set_add_string (set, "10.0.0.0/33", &error));
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT);
+  g_clear_error (&error);
+  g_assert_false (g_inet_address_mask_set_add_string (set, "10.0.0.0/", &error));
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT);
+  g_clear_error (&error);
+
+  for (i = 0; i < G_N_ELEMENTS (tests); i++)
+    {
+      g_assert_true (g_inet_address_bytes_parse (tests[i].address, -1, &bytes));
+      g_assert_cmpint (g_inet_address_mask_set_contains (set, &bytes), ==, tests[i].contained);
+    }
+
+  g_assert_true (g_inet_address_bytes_parse ("172.16.5.5", -1, &bytes));
+  g_assert_true (g_inet_address_mask_matches_bytes (mask, &bytes));
+  g_assert_true (g_inet_address_bytes_parse ("172.17.5.5", -1, &bytes));
+  g_assert_false (g_inet_address_mask_matches_bytes (mask, &bytes));
+  g_object_unref (mask);
+
+  /* A zero-length mask matches everything of its family */
+  g_assert_true (g_inet_address_mask_set_add_string (set, "::/0", &error));
+  g_assert_no_error (error);
+  g_assert_true (g_inet_address_bytes_parse ("::1", -1, &bytes));
+  g_assert_true (g_inet_address_mask_set_contains (set, &bytes));
+  g_assert_true (g_inet_address_bytes_parse ("11.0.0.0", -1, &bytes));
+  g_assert_false (g_inet_address_mask_set_contains (set, &bytes));
+
+  g_inet_address_mask_set_unref (set);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -417,6 +565,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/inet-address/any", test_any);
   g_test_add_func ("/inet-address/loopback", test_loopback);
   g_test_add_func ("/inet-address/bytes", test_bytes);
+  g_test_add_func ("/inet-address/address-bytes", test_address_bytes);
   g_test_add_func ("/inet-address/property", test_property);
   g_test_add_func ("/socket-address/basic", test_socket_address);
   g_test_add_func ("/socket-address/to-string", test_socket_address_to_string);
@@ -424,6 +573,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/address-mask/property", test_mask_property);
   g_test_add_func ("/address-mask/equal", test_mask_equal);
   g_test_add_func ("/address-mask/match", test_mask_match);
+  g_test_add_func ("/address-mask/set", test_mask_set);
 
   return g_test_run ();
 }
@@ -100,6 +100,67 @@ test_copy_chunks (void)
   g_main_loop_unref (data.main_loop);
 }
 
+static void
+splice_full_done (GObject      *source,
+                  GAsyncResult *result,
+                  gpointer      user_data)
+{
+  GAsyncResult **result_out = user_data;
+
+  *result_out = g_object_ref (result);
+}
+
+static void
+test_splice_full (void)
+{
+  const gchar *data1 = "abcdefghijklmnopqrstuvwxyz";
+  const gchar *data2 = "0123456789";
+  GIOStream *iostream1, *iostream2;
+  GInputStream *istream;
+  GOutputStream *ostream1, *ostream2;
+  GAsyncResult *result = NULL;
+  GError *error = NULL;
+  guint64 bytes_1_to_2, bytes_2_to_1;
+  gboolean res;
+
+  istream = g_memory_input_stream_new_from_data (data1, -1, NULL);
+  ostream1 = g_memory_output_stream_new_resizable ();
+  iostream1 = g_simple_io_stream_new (istream, ostream1);
+  g_object_unref (istream);
+
+  istream = g_memory_input_stream_new_from_data (data2, -1, NULL);
+  ostream2 = g_memory_output_stream_new_resizable ();
+  iostream2 = g_simple_io_stream_new (istream, ostream2);
+  g_object_unref (istream);
+
+  /* A tiny buffer, so that each direction takes several reads */
+  g_io_stream_splice_full_async (iostream1, iostream2,
+                                 G_IO_STREAM_SPLICE_WAIT_FOR_BOTH, 3,
+                                 G_PRIORITY_DEFAULT, NULL,
+                                 splice_full_done, &result);
+  while (result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+
+  res = g_io_stream_splice_full_finish (result, &bytes_1_to_2, &bytes_2_to_1, &error);
+  g_assert_no_error (error);
+  g_assert_true (res);
+  g_assert_cmpuint (bytes_1_to_2, ==, strlen (data1));
+  g_assert_cmpuint (bytes_2_to_1, ==, strlen (data2));
+
+  g_assert_cmpmem (g_memory_output_stream_get_data (G_MEMORY_OUTPUT_STREAM (ostream2)),
+                   g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (ostream2)),
+                   data1, strlen (data1));
+  g_assert_cmpmem (g_memory_output_stream_get_data (G_MEMORY_OUTPUT_STREAM (ostream1)),
+                   g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (ostream1)),
+                   data2, strlen (data2));
+
+  g_object_unref (result);
+  g_object_unref (ostream1);
+  g_object_unref (ostream2);
+  g_object_unref (iostream1);
+  g_object_unref (iostream2);
+}
+
 static void
 close_async_done (GObject *source,
                   GAsyncResult *result,
@@ -166,6 +227,7 @@ main (int   argc,
   g_test_init (&argc, &argv, NULL);
 
   g_test_add_func ("/io-stream/copy-chunks", test_copy_chunks);
+  g_test_add_func ("/io-stream/splice-full", test_splice_full);
   g_test_add_func ("/io-stream/close/async/memory", test_close_memory);
   g_test_add_func ("/io-stream/close/async/file", test_close_file);
 
@@ -265,6 +265,43 @@ test_read_bytes (void)
   g_object_unref (stream);
 }
 
+static void
+test_read_bytes_pooled (void)
+{
+  const char *data1 = "abcdefghijklmnopqrstuvwxyz";
+  GInputStream *stream;
+  GBufferPool *pool;
+  GError *error = NULL;
+  GBytes *bytes;
+  gconstpointer data, first_data;
+  gsize size;
+
+  stream = g_memory_input_stream_new_from_data (data1, -1, NULL);
+  pool = g_buffer_pool_new (16, 1);
+
+  bytes = g_input_stream_read_bytes_pooled (stream, pool, NULL, &error);
+  g_assert_no_error (error);
+  first_data = data = g_bytes_get_data (bytes, &size);
+  g_assert_cmpmem (data, size, data1, 16);
+  g_bytes_unref (bytes);
+
+  /* The buffer of the first read is reused */
+  bytes = g_input_stream_read_bytes_pooled (stream, pool, NULL, &error);
+  g_assert_no_error (error);
+  data = g_bytes_get_data (bytes, &size);
+  g_assert_true (data == first_data);
+  g_assert_cmpmem (data, size, data1 + 16, 10);
+  g_bytes_unref (bytes);
+
+  bytes = g_input_stream_read_bytes_pooled (stream, pool, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (g_bytes_get_size (bytes), ==, 0);
+  g_bytes_unref (bytes);
+
+  g_buffer_pool_unref (pool);
+  g_object_unref (stream);
+}
+
 static void
 test_from_bytes (void)
 {
@@ -287,6 +324,70 @@ test_from_bytes (void)
   g_bytes_unref (bytes);
 }
 
+static void
+test_many_chunks (void)
+{
+  GBytesChain *chain;
+  GInputStream *stream;
+  GError *error = NULL;
+  gchar buffer[10];
+  gchar *text;
+  gssize n;
+  guint i, pos;
+
+  /* 1000 chunks holding "0000" to "0999", with some added as a chain */
+  stream = g_memory_input_stream_new ();
+  chain = g_bytes_chain_new ();
+  for (i = 0; i < 1000; i++)
+    {
+      GBytes *bytes;
+
+      text = g_strdup_printf ("%04u", i);
+      bytes = g_bytes_new_take (text, 4);
+      if (i >= 500)
+        g_bytes_chain_append (chain, bytes);
+      else
+        g_memory_input_stream_add_bytes (G_MEMORY_INPUT_STREAM (stream), bytes);
+      g_bytes_unref (bytes);
+    }
+  g_memory_input_stream_add_data (G_MEMORY_INPUT_STREAM (stream), "", 0, NULL);
+  g_memory_input_stream_add_bytes_chain (G_MEMORY_INPUT_STREAM (stream), chain);
+  g_bytes_chain_unref (chain);
+
+  /* Reads spanning chunks, at positions all over the stream */
+  for (i = 0; i < 2000; i++)
+    {
+      pos = (i * 7919) % 3990;
+
+      g_seekable_seek (G_SEEKABLE (stream), pos, G_SEEK_SET, NULL, &error);
+      g_assert_no_error (error);
+
+      n = g_input_stream_read (stream, buffer, 10, NULL, &error);
+      g_assert_no_error (error);
+      g_assert_cmpint (n, ==, 10);
+
+      text = g_strdup_printf ("%04u%04u%04u%04u",
+                              pos / 4, pos / 4 + 1, pos / 4 + 2, pos / 4 + 3);
+      g_assert_cmpmem (buffer, 10, text + pos % 4, 10);
+      g_free (text);
+    }
+
+  /* Sequential reads to the end */
+  g_seekable_seek (G_SEEKABLE (stream), 3990, G_SEEK_SET, NULL, &error);
+  g_assert_no_error (error);
+  n = g_input_stream_read (stream, buffer, 8, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpmem (buffer, n, "97099809", 8);
+  n = g_input_stream_read (stream, buffer, 8, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpmem (buffer, n, "99", 2);
+  n = g_input_stream_read (stream, buffer, 8, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (n, ==, 0);
+
+  g_object_unref (stream);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -298,7 +399,9 @@ main (int   argc,
   g_test_add_func ("/memory-input-stream/seek", test_seek);
   g_test_add_func ("/memory-input-stream/truncate", test_truncate);
   g_test_add_func ("/memory-input-stream/read-bytes", test_read_bytes);
+  g_test_add_func ("/memory-input-stream/read-bytes-pooled", test_read_bytes_pooled);
   g_test_add_func ("/memory-input-stream/from-bytes", test_from_bytes);
+  g_test_add_func ("/memory-input-stream/many-chunks", test_many_chunks);
 
   return g_test_run();
 }
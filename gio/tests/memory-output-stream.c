@@ -451,6 +451,78 @@ test_steal_as_bytes (void)
   g_object_unref (o);
 }
 
+static void
+test_large (void)
+{
+  GOutputStream *mo;
+  GError *error = NULL;
+  guint8 *chunk;
+  const guint8 *data;
+  GBytes *bytes;
+  gsize size, i;
+  gboolean stolen;
+
+  chunk = g_malloc (256 * 1024);
+  for (i = 0; i < 256 * 1024; i++)
+    chunk[i] = i % 251;
+
+  for (stolen = FALSE; stolen <= TRUE; stolen++)
+    {
+      mo = g_memory_output_stream_new_resizable ();
+
+      g_memory_output_stream_reserve (G_MEMORY_OUTPUT_STREAM (mo), 100, &error);
+      g_assert_no_error (error);
+      g_assert_cmpuint (g_memory_output_stream_get_size (G_MEMORY_OUTPUT_STREAM (mo)), >=, 100);
+      g_assert_cmpuint (g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (mo)), ==, 0);
+
+      /* Grow well past the point where large streams change how they
+       * allocate memory */
+      for (i = 0; i < 12; i++)
+        {
+          g_output_stream_write_all (mo, chunk, 256 * 1024, NULL, NULL, &error);
+          g_assert_no_error (error);
+        }
+
+      g_memory_output_stream_reserve (G_MEMORY_OUTPUT_STREAM (mo), 8 * 1024 * 1024, &error);
+      g_assert_no_error (error);
+      g_assert_cmpuint (g_memory_output_stream_get_size (G_MEMORY_OUTPUT_STREAM (mo)), >=, 11 * 1024 * 1024);
+
+      /* Truncated data must read back as zeroes when the stream grows again */
+      g_seekable_truncate (G_SEEKABLE (mo), 3 * 1024 * 1024 - 10, NULL, &error);
+      g_assert_no_error (error);
+      g_seekable_seek (G_SEEKABLE (mo), 3 * 1024 * 1024, G_SEEK_SET, NULL, &error);
+      g_assert_no_error (error);
+      g_output_stream_write_all (mo, "end", 3, NULL, NULL, &error);
+      g_assert_no_error (error);
+
+      g_output_stream_close (mo, NULL, &error);
+      g_assert_no_error (error);
+
+      if (stolen)
+        {
+          size = g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (mo));
+          data = g_memory_output_stream_steal_data (G_MEMORY_OUTPUT_STREAM (mo));
+          bytes = g_bytes_new_take ((gpointer) data, size);
+        }
+      else
+        bytes = g_memory_output_stream_steal_as_bytes (G_MEMORY_OUTPUT_STREAM (mo));
+      g_object_unref (mo);
+
+      data = g_bytes_get_data (bytes, &size);
+      g_assert_cmpuint (size, ==, 3 * 1024 * 1024 + 3);
+      for (i = 0; i < 3 * 1024 * 1024 - 10; i += 256 * 1024)
+        g_assert_cmpmem (data + i, MIN (256 * 1024, 3 * 1024 * 1024 - 10 - i),
+                         chunk, MIN (256 * 1024, 3 * 1024 * 1024 - 10 - i));
+      for (i = 3 * 1024 * 1024 - 10; i < 3 * 1024 * 1024; i++)
+        g_assert_cmpuint (data[i], ==, 0);
+      g_assert_cmpmem (data + 3 * 1024 * 1024, 3, "end", 3);
+
+      g_bytes_unref (bytes);
+    }
+
+  g_free (chunk);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -467,6 +539,7 @@ main (int   argc,
   g_test_add_func ("/memory-output-stream/writev", test_writev);
   g_test_add_func ("/memory-output-stream/writev_nonblocking", test_writev_nonblocking);
   g_test_add_func ("/memory-output-stream/steal_as_bytes", test_steal_as_bytes);
+  g_test_add_func ("/memory-output-stream/large", test_large);
 
   return g_test_run();
 }
@@ -354,6 +354,35 @@ test_scope_id (GSocketConnectable *addr)
 #endif
 }
 
+static void
+test_resolver_cache_ttl (void)
+{
+  GResolver *resolver;
+  GList *addrs;
+  GError *error = NULL;
+  guint i;
+
+  g_test_summary ("Test that GResolver:cache-ttl can be set, and lookups "
+                  "still return a new list each time with caching enabled");
+
+  resolver = g_resolver_get_default ();
+  g_assert_cmpuint (g_resolver_get_cache_ttl (resolver), ==, 0);
+
+  g_resolver_set_cache_ttl (resolver, 60);
+  g_assert_cmpuint (g_resolver_get_cache_ttl (resolver), ==, 60);
+
+  for (i = 0; i < 2; i++)
+    {
+      addrs = g_resolver_lookup_by_name (resolver, "localhost", NULL, &error);
+      g_assert_no_error (error);
+      g_assert_nonnull (addrs);
+      g_resolver_free_addresses (addrs);
+    }
+
+  g_resolver_set_cache_ttl (resolver, 0);
+  g_object_unref (resolver);
+}
+
 static void
 test_host_scope_id (void)
 {
@@ -1289,6 +1318,7 @@ main (int argc, char *argv[])
       g_free (path);
     }
 
+  g_test_add_func ("/network-address/resolver-cache-ttl", test_resolver_cache_ttl);
   g_test_add_func ("/network-address/scope-id", test_host_scope_id);
   g_test_add_func ("/network-address/uri-scope-id", test_uri_scope_id);
   g_test_add_func ("/network-address/loopback/basic", test_loopback_basic);
@@ -456,6 +456,52 @@ test_remove_networks (void)
   g_object_unref (monitor);
 }
 
+static void
+test_set_networks (void)
+{
+  GNetworkMonitor *monitor;
+  GError *error = NULL;
+  GInetAddressMask *networks[3];
+
+  monitor = g_initable_new (G_TYPE_NETWORK_MONITOR_BASE, NULL, &error, NULL);
+  g_assert_no_error (error);
+  assert_signals (monitor, FALSE, FALSE, TRUE);
+
+  networks[0] = net127.mask;
+  networks[1] = net10.mask;
+  networks[2] = netlocal6.mask;
+  g_network_monitor_base_set_networks (G_NETWORK_MONITOR_BASE (monitor),
+                                       networks, 3);
+  assert_signals (monitor, TRUE, TRUE, FALSE);
+  run_tests (monitor, net127.addresses, TRUE);
+  run_tests (monitor, net10.addresses, TRUE);
+  run_tests (monitor, net192.addresses, FALSE);
+  run_tests (monitor, netlocal6.addresses, TRUE);
+  run_tests (monitor, netfe80.addresses, FALSE);
+  run_tests (monitor, unmatched, FALSE);
+
+  /* Setting the same networks again, in any order, is not a change */
+  networks[0] = netlocal6.mask;
+  networks[2] = net127.mask;
+  g_network_monitor_base_set_networks (G_NETWORK_MONITOR_BASE (monitor),
+                                       networks, 3);
+  assert_signals (monitor, FALSE, FALSE, FALSE);
+
+  /* Only the differences are applied, and result in a single emission */
+  networks[1] = net192.mask;
+  g_network_monitor_base_set_networks (G_NETWORK_MONITOR_BASE (monitor),
+                                       networks, 3);
+  assert_signals (monitor, FALSE, TRUE, FALSE);
+  run_tests (monitor, net127.addresses, TRUE);
+  run_tests (monitor, net10.addresses, FALSE);
+  run_tests (monitor, net192.addresses, TRUE);
+  run_tests (monitor, netlocal6.addresses, TRUE);
+  run_tests (monitor, netfe80.addresses, FALSE);
+  run_tests (monitor, unmatched, FALSE);
+
+  g_object_unref (monitor);
+}
+
 
 static void
 init_test (TestMask *test)
@@ -567,6 +613,7 @@ main (int argc, char **argv)
   g_test_add_func ("/network-monitor/remove_default", test_remove_default);
   g_test_add_func ("/network-monitor/add_networks", test_add_networks);
   g_test_add_func ("/network-monitor/remove_networks", test_remove_networks);
+  g_test_add_func ("/network-monitor/set_networks", test_set_networks);
 
   ret = g_test_run ();
 
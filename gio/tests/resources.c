@@ -20,6 +20,7 @@
 
 #include <string.h>
 #include <gio/gio.h>
+#include <glib/gstdio.h>
 #include <glibconfig.h>
 #include "gconstructor.h"
 #include "test_resources2.h"
@@ -583,6 +584,132 @@ test_resource_automatic (void)
   g_bytes_unref (data);
 }
 
+static void
+test_resource_registered_overlapping (void)
+{
+  GResource *first, *second;
+  GError *error = NULL;
+  GBytes *data;
+
+  g_test_summary ("Test that files shared by several registered resources "
+                  "are still found after one of them is unregistered");
+
+  first = g_resource_load (g_test_get_filename (G_TEST_BUILT, "test.gresource", NULL), &error);
+  g_assert_no_error (error);
+  second = g_resource_load (g_test_get_filename (G_TEST_BUILT, "test.gresource", NULL), &error);
+  g_assert_no_error (error);
+
+  g_resources_register (first);
+  g_resources_register (second);
+
+  data = g_resources_lookup_data ("/test1.txt", G_RESOURCE_LOOKUP_FLAGS_NONE, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (g_bytes_get_data (data, NULL), ==, "test1\n");
+  g_bytes_unref (data);
+
+  /* Directories aren’t files */
+  data = g_resources_lookup_data ("/a_prefix/", G_RESOURCE_LOOKUP_FLAGS_NONE, &error);
+  g_assert_error (error, G_RESOURCE_ERROR, G_RESOURCE_ERROR_NOT_FOUND);
+  g_assert_null (data);
+  g_clear_error (&error);
+
+  g_resources_unregister (second);
+
+  data = g_resources_lookup_data ("/a_prefix/test2.txt", G_RESOURCE_LOOKUP_FLAGS_NONE, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (g_bytes_get_data (data, NULL), ==, "test2\n");
+  g_bytes_unref (data);
+
+  g_resources_unregister (first);
+
+  data = g_resources_lookup_data ("/test1.txt", G_RESOURCE_LOOKUP_FLAGS_NONE, &error);
+  g_assert_error (error, G_RESOURCE_ERROR, G_RESOURCE_ERROR_NOT_FOUND);
+  g_assert_null (data);
+  g_clear_error (&error);
+
+  g_resource_unref (first);
+  g_resource_unref (second);
+}
+
+static void
+test_resource_compressed_cache (void)
+{
+  GResource *resource;
+  GError *error = NULL;
+  GBytes *data, *data2;
+
+  g_test_summary ("Test that compressed files are decompressed only once");
+
+  resource = g_resource_load (g_test_get_filename (G_TEST_BUILT, "test.gresource", NULL), &error);
+  g_assert_no_error (error);
+
+  data = g_resource_lookup_data (resource, "/test1.txt", G_RESOURCE_LOOKUP_FLAGS_NONE, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (g_bytes_get_data (data, NULL), ==, "test1\n");
+
+  data2 = g_resource_lookup_data (resource, "/test1.txt", G_RESOURCE_LOOKUP_FLAGS_NONE, &error);
+  g_assert_no_error (error);
+  g_assert_true (g_bytes_get_data (data2, NULL) == g_bytes_get_data (data, NULL));
+  g_bytes_unref (data2);
+  g_bytes_unref (data);
+
+  /* The cached data outlives the caller’s references */
+  data = g_resource_lookup_data (resource, "/test1.txt", G_RESOURCE_LOOKUP_FLAGS_NONE, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (g_bytes_get_data (data, NULL), ==, "test1\n");
+  g_bytes_unref (data);
+
+  g_resource_unref (resource);
+}
+
+static void
+resource_cache_size_cb (const gchar *name,
+                        guint        priority,
+                        gsize        size,
+                        gpointer     user_data)
+{
+  gsize *total = user_data;
+
+  if (g_str_equal (name, "gio-resource-data"))
+    *total += size;
+}
+
+static void
+test_resource_compressed_cache_trim (void)
+{
+  GResource *resource;
+  GError *error = NULL;
+  GBytes *data, *data2;
+  gsize cache_size = 0;
+
+  g_test_summary ("Test that cached decompressed data is dropped by g_mem_cache_trim()");
+
+  resource = g_resource_load (g_test_get_filename (G_TEST_BUILT, "test.gresource", NULL), &error);
+  g_assert_no_error (error);
+
+  data = g_resource_lookup_data (resource, "/test1.txt", G_RESOURCE_LOOKUP_FLAGS_NONE, &error);
+  g_assert_no_error (error);
+
+  g_mem_cache_foreach (resource_cache_size_cb, &cache_size);
+  g_assert_cmpuint (cache_size, >=, g_bytes_get_size (data));
+
+  g_assert_cmpuint (g_mem_cache_trim (G_MEMORY_MONITOR_WARNING_LEVEL_LOW), >=, g_bytes_get_size (data));
+
+  cache_size = 0;
+  g_mem_cache_foreach (resource_cache_size_cb, &cache_size);
+  g_assert_cmpuint (cache_size, ==, 0);
+
+  /* The data is decompressed again */
+  data2 = g_resource_lookup_data (resource, "/test1.txt", G_RESOURCE_LOOKUP_FLAGS_NONE, &error);
+  g_assert_no_error (error);
+  g_assert_true (g_bytes_get_data (data2, NULL) != g_bytes_get_data (data, NULL));
+  g_assert_cmpstr (g_bytes_get_data (data2, NULL), ==, "test1\n");
+  g_bytes_unref (data2);
+  g_bytes_unref (data);
+
+  g_resource_unref (resource);
+}
+
 static void
 test_resource_manual (void)
 {
@@ -1046,6 +1173,160 @@ test_overlay (void)
   g_test_trap_assert_passed ();
 }
 
+static void
+compile_resources (const gchar *dir,
+                   const gchar *target,
+                   const gchar *extra_arg1,
+                   const gchar *extra_arg2)
+{
+  GSubprocess *proc;
+  GError *error = NULL;
+  gchar *sourcedir_arg = g_strconcat ("--sourcedir=", dir, NULL);
+  gchar *target_arg = g_strconcat ("--target=", target, NULL);
+  gchar *xml = g_build_filename (dir, "test.gresource.xml", NULL);
+  const gchar *argv[] = {
+    GLIB_COMPILE_RESOURCES, sourcedir_arg, target_arg, xml, extra_arg1, extra_arg2, NULL
+  };
+
+  proc = g_subprocess_newv (argv, G_SUBPROCESS_FLAGS_NONE, &error);
+  g_assert_no_error (error);
+  g_subprocess_wait_check (proc, NULL, &error);
+  g_assert_no_error (error);
+
+  g_object_unref (proc);
+  g_free (xml);
+  g_free (target_arg);
+  g_free (sourcedir_arg);
+}
+
+static void
+test_compile_jobs_cache (void)
+{
+  const gchar *xml =
+    "<gresources>"
+    "  <gresource prefix=\"/jobs\">"
+    "    <file>plain.txt</file>"
+    "    <file compressed=\"true\">compressed.txt</file>"
+    "  </gresource>"
+    "</gresources>";
+  GError *error = NULL;
+  gchar *dir, *cache_dir, *cache_arg, *path;
+  gchar *plain_target, *jobs_target, *cached_target;
+  gchar *plain_data, *jobs_data;
+  gsize plain_size, jobs_size;
+  GResource *resource;
+  GBytes *data;
+  GDir *cache;
+  const gchar *name;
+  guint n_entries = 0;
+
+  g_test_summary ("Test that glib-compile-resources --jobs and --cache-dir "
+                  "give the same output as a plain run, and reuse cached entries");
+
+  if (!g_file_test (GLIB_COMPILE_RESOURCES, G_FILE_TEST_IS_EXECUTABLE))
+    {
+      g_test_skip ("glib-compile-resources is not available");
+      return;
+    }
+
+  dir = g_dir_make_tmp ("gresource-jobs-XXXXXX", &error);
+  g_assert_no_error (error);
+  cache_dir = g_build_filename (dir, "cache", NULL);
+  cache_arg = g_strconcat ("--cache-dir=", cache_dir, NULL);
+  plain_target = g_build_filename (dir, "plain.gresource", NULL);
+  jobs_target = g_build_filename (dir, "jobs.gresource", NULL);
+  cached_target = g_build_filename (dir, "cached.gresource", NULL);
+
+  path = g_build_filename (dir, "test.gresource.xml", NULL);
+  g_file_set_contents (path, xml, -1, &error);
+  g_assert_no_error (error);
+  g_free (path);
+  path = g_build_filename (dir, "plain.txt", NULL);
+  g_file_set_contents (path, "plain contents\n", -1, &error);
+  g_assert_no_error (error);
+  g_free (path);
+  path = g_build_filename (dir, "compressed.txt", NULL);
+  g_file_set_contents (path, "compressed compressed compressed\n", -1, &error);
+  g_assert_no_error (error);
+  g_free (path);
+
+  /* Processing in parallel and filling the cache doesn’t change the output */
+  compile_resources (dir, plain_target, "--jobs=1", NULL);
+  compile_resources (dir, jobs_target, "--jobs=2", cache_arg);
+
+  g_file_get_contents (plain_target, &plain_data, &plain_size, &error);
+  g_assert_no_error (error);
+  g_file_get_contents (jobs_target, &jobs_data, &jobs_size, &error);
+  g_assert_no_error (error);
+  g_assert_cmpmem (plain_data, plain_size, jobs_data, jobs_size);
+  g_free (plain_data);
+  g_free (jobs_data);
+
+  /* Replace every cache entry, so the next run shows whether it used them */
+  cache = g_dir_open (cache_dir, 0, &error);
+  g_assert_no_error (error);
+  while ((name = g_dir_read_name (cache)) != NULL)
+    {
+      GVariant *entry;
+
+      entry = g_variant_new ("(uu@ay)", 6, G_RESOURCE_FLAGS_NONE,
+                             g_variant_new_from_data (G_VARIANT_TYPE_BYTESTRING,
+                                                      "cached", 7, TRUE, NULL, NULL));
+      path = g_build_filename (cache_dir, name, NULL);
+      g_file_set_contents (path, g_variant_get_data (entry),
+                           g_variant_get_size (entry), &error);
+      g_assert_no_error (error);
+      g_variant_unref (g_variant_ref_sink (entry));
+      g_free (path);
+      n_entries++;
+    }
+  g_dir_close (cache);
+  g_assert_cmpuint (n_entries, ==, 2);
+
+  compile_resources (dir, cached_target, "--jobs=2", cache_arg);
+
+  resource = g_resource_load (cached_target, &error);
+  g_assert_no_error (error);
+  data = g_resource_lookup_data (resource, "/jobs/plain.txt",
+                                 G_RESOURCE_LOOKUP_FLAGS_NONE, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (g_bytes_get_data (data, NULL), ==, "cached");
+  g_bytes_unref (data);
+  g_resource_unref (resource);
+
+  cache = g_dir_open (cache_dir, 0, &error);
+  g_assert_no_error (error);
+  while ((name = g_dir_read_name (cache)) != NULL)
+    {
+      path = g_build_filename (cache_dir, name, NULL);
+      g_remove (path);
+      g_free (path);
+    }
+  g_dir_close (cache);
+  g_rmdir (cache_dir);
+
+  g_remove (plain_target);
+  g_remove (jobs_target);
+  g_remove (cached_target);
+  path = g_build_filename (dir, "test.gresource.xml", NULL);
+  g_remove (path);
+  g_free (path);
+  path = g_build_filename (dir, "plain.txt", NULL);
+  g_remove (path);
+  g_free (path);
+  path = g_build_filename (dir, "compressed.txt", NULL);
+  g_remove (path);
+  g_free (path);
+  g_rmdir (dir);
+
+  g_free (cached_target);
+  g_free (jobs_target);
+  g_free (plain_target);
+  g_free (cache_arg);
+  g_free (cache_dir);
+  g_free (dir);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -1062,6 +1343,9 @@ main (int   argc,
   g_test_add_func ("/resource/data-corrupt", test_resource_data_corrupt);
   g_test_add_func ("/resource/data-empty", test_resource_data_empty);
   g_test_add_func ("/resource/registered", test_resource_registered);
+  g_test_add_func ("/resource/registered-overlapping", test_resource_registered_overlapping);
+  g_test_add_func ("/resource/compressed-cache", test_resource_compressed_cache);
+  g_test_add_func ("/resource/compressed-cache/trim", test_resource_compressed_cache_trim);
   g_test_add_func ("/resource/manual", test_resource_manual);
   g_test_add_func ("/resource/manual2", test_resource_manual2);
 #ifdef G_HAS_CONSTRUCTORS
@@ -1075,6 +1359,7 @@ main (int   argc,
   g_test_add_func ("/resource/64k", test_resource_64k);
   g_test_add_func ("/resource/overlay", test_overlay);
   g_test_add_func ("/resource/digits", test_resource_digits);
+  g_test_add_func ("/resource/compile/jobs-cache", test_compile_jobs_cache);
 
   return g_test_run();
 }
@@ -198,6 +198,9 @@ static const char *ignore_hosts[] = {
   "*.ccc.xx",
   "ddd.xx",
   "*.eee.xx:8000",
+  "fff.xx:8000",
+  "fff.xx:9000",
+  "*.GGG.xx",
   "127.0.0.0/24",
   "10.0.0.1:8000",
   "::1",
@@ -239,6 +242,14 @@ static const struct {
   { "http://www.eee.xx/",      	 "http://localhost:8080" },
   { "http://www.eee.xx:8000/", 	 "direct://" },
   { "https://eee.xx/",         	 "http://localhost:8080" },
+  { "http://fff.xx/",          	 "http://localhost:8080" },
+  { "http://fff.xx:8000/",     	 "direct://" },
+  { "http://www.fff.xx:9000/", 	 "direct://" },
+  { "http://fff.xx:10000/",    	 "http://localhost:8080" },
+  { "http://ggg.xx/",          	 "direct://" },
+  { "http://WWW.Ggg.XX/",      	 "direct://" },
+  { "http://WWW.BBB.XX/",      	 "direct://" },
+  { "http://gggg.xx/",         	 "http://localhost:8080" },
   { "http://1.2.3.4/",         	 "http://localhost:8080" },
   { "http://127.0.0.1/",       	 "direct://" },
   { "http://127.0.0.2/",       	 "direct://" },
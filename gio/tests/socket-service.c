@@ -242,6 +242,258 @@ test_threaded_712570 (void)
   g_mutex_unlock (&mutex_712570);
 }
 
+typedef struct
+{
+  GMutex mutex;
+  GHashTable *contexts;  /* (element-type GMainContext guint) */
+  guint n_connections;  /* (atomic) */
+} IOThreadsData;
+
+static gboolean
+io_threads_run_cb (GThreadedSocketService *service,
+                   GSocketConnection      *connection,
+                   GObject                *source_object,
+                   gpointer                user_data)
+{
+  IOThreadsData *data = user_data;
+  GMainContext *context = g_main_context_get_thread_default ();
+  guint count;
+
+  /* Emitted in an I/O thread which owns its own context */
+  g_assert_nonnull (context);
+  g_assert_true (context != g_main_context_default ());
+  g_assert_true (g_main_context_is_owner (context));
+
+  g_mutex_lock (&data->mutex);
+  count = GPOINTER_TO_UINT (g_hash_table_lookup (data->contexts, context));
+  g_hash_table_insert (data->contexts, context, GUINT_TO_POINTER (count + 1));
+  g_mutex_unlock (&data->mutex);
+
+  g_atomic_int_inc (&data->n_connections);
+  g_main_context_wakeup (NULL);
+
+  return FALSE;
+}
+
+static void
+test_threaded_io_threads (void)
+{
+  GSocketService *service;
+  GSocketAddress *addr, *listening_addr;
+  GSocketClient *client;
+  IOThreadsData data;
+  GHashTableIter iter;
+  gpointer value;
+  int io_threads;
+  guint i;
+  GError *error = NULL;
+
+  g_mutex_init (&data.mutex);
+  data.contexts = g_hash_table_new (NULL, NULL);
+  data.n_connections = 0;
+
+  service = g_threaded_socket_service_new_with_io_threads (2);
+  g_object_get (service, "io-threads", &io_threads, NULL);
+  g_assert_cmpint (io_threads, ==, 2);
+
+  addr = g_inet_socket_address_new_from_string ("127.0.0.1", 0);
+  g_socket_listener_add_address (G_SOCKET_LISTENER (service),
+                                 addr,
+                                 G_SOCKET_TYPE_STREAM,
+                                 G_SOCKET_PROTOCOL_TCP,
+                                 NULL,
+                                 &listening_addr,
+                                 &error);
+  g_assert_no_error (error);
+  g_object_unref (addr);
+
+  g_signal_connect (service, "run", G_CALLBACK (io_threads_run_cb), &data);
+
+  client = g_socket_client_new ();
+  for (i = 0; i < 4; i++)
+    g_socket_client_connect_async (client,
+                                   G_SOCKET_CONNECTABLE (listening_addr),
+                                   NULL,
+                                   client_connected_cb, NULL);
+  g_object_unref (client);
+  g_object_unref (listening_addr);
+
+  while (g_atomic_int_get (&data.n_connections) < 4)
+    g_main_context_iteration (NULL, TRUE);
+
+  /* The connections are handed to the two threads in turn */
+  g_mutex_lock (&data.mutex);
+  g_assert_cmpuint (g_hash_table_size (data.contexts), ==, 2);
+  g_hash_table_iter_init (&iter, data.contexts);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    g_assert_cmpuint (GPOINTER_TO_UINT (value), ==, 2);
+  g_mutex_unlock (&data.mutex);
+
+  g_socket_service_stop (service);
+  g_signal_handlers_disconnect_by_func (service, io_threads_run_cb, &data);
+  g_object_unref (service);
+
+  g_hash_table_unref (data.contexts);
+  g_mutex_clear (&data.mutex);
+}
+
+typedef struct
+{
+  GMainContext *contexts[2];
+  GThread *threads[2];
+  guint n_connections;  /* (atomic) */
+} ShardedData;
+
+gboolean shard_threads_quit;  /* (atomic) */
+
+static gpointer
+shard_thread_func (gpointer user_data)
+{
+  GMainContext *context = user_data;
+
+  g_main_context_push_thread_default (context);
+  while (!g_atomic_int_get (&shard_threads_quit))
+    g_main_context_iteration (context, TRUE);
+  g_main_context_pop_thread_default (context);
+
+  return NULL;
+}
+
+static gboolean
+sharded_incoming_cb (GSocketService    *service,
+                     GSocketConnection *connection,
+                     GObject           *source_object,
+                     gpointer           user_data)
+{
+  ShardedData *data = user_data;
+
+  /* Accepted in one of the shard contexts */
+  g_assert_true (g_main_context_is_owner (data->contexts[0]) ||
+                 g_main_context_is_owner (data->contexts[1]));
+  g_assert_true (source_object == G_OBJECT (service));
+
+  g_atomic_int_inc (&data->n_connections);
+  g_main_context_wakeup (NULL);
+
+  return FALSE;
+}
+
+static void
+test_connection_pool (void)
+{
+  GSocketListener *listener;
+  GSocketConnectable *connectable;
+  GSocketConnectionPool *pool;
+  GSocketClient *client;
+  GSocketConnection *conn, *conn2, *server_conn;
+  guint16 port;
+  GError *error = NULL;
+
+  listener = g_socket_listener_new ();
+  port = g_socket_listener_add_any_inet_port (listener, NULL, &error);
+  g_assert_no_error (error);
+
+  pool = g_socket_connection_pool_new ();
+  client = g_socket_client_new ();
+  g_socket_client_set_connection_pool (client, pool);
+  g_assert_true (g_socket_client_get_connection_pool (client) == pool);
+  connectable = g_network_address_new_loopback (port);
+
+  conn = g_socket_client_connect (client, connectable, NULL, &error);
+  g_assert_no_error (error);
+  server_conn = g_socket_listener_accept (listener, NULL, NULL, &error);
+  g_assert_no_error (error);
+
+  /* A released connection is handed out again for the same destination */
+  g_socket_connection_pool_release (pool, conn);
+  conn2 = g_socket_client_connect (client, connectable, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_true (conn2 == conn);
+  g_object_unref (conn);
+
+  /* Once the peer has closed it, it is dropped rather than reused */
+  g_socket_connection_pool_release (pool, conn2);
+  g_io_stream_close (G_IO_STREAM (server_conn), NULL, &error);
+  g_assert_no_error (error);
+  g_object_unref (server_conn);
+
+  conn = g_socket_client_connect (client, connectable, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_true (conn != conn2);
+  g_object_unref (conn2);
+  server_conn = g_socket_listener_accept (listener, NULL, NULL, &error);
+  g_assert_no_error (error);
+
+  g_object_unref (server_conn);
+  g_object_unref (conn);
+  g_object_unref (connectable);
+  g_object_unref (client);
+  g_object_unref (pool);
+  g_socket_listener_close (listener);
+  g_object_unref (listener);
+}
+
+static void
+test_sharded_inet_port (void)
+{
+  GSocketService *service;
+  GSocketConnectable *connectable;
+  GSocketClient *client;
+  ShardedData data = { 0, };
+  guint16 port;
+  guint i;
+  GError *error = NULL;
+
+  data.contexts[0] = g_main_context_new ();
+  data.contexts[1] = g_main_context_new ();
+
+  service = g_socket_service_new ();
+  g_signal_connect (service, "incoming", G_CALLBACK (sharded_incoming_cb), &data);
+
+  port = g_socket_listener_add_sharded_inet_port (G_SOCKET_LISTENER (service), 0,
+                                                  data.contexts, G_N_ELEMENTS (data.contexts),
+                                                  G_OBJECT (service), &error);
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED))
+    {
+      g_test_skip (error->message);
+      g_clear_error (&error);
+      g_object_unref (service);
+      g_main_context_unref (data.contexts[0]);
+      g_main_context_unref (data.contexts[1]);
+      return;
+    }
+  g_assert_no_error (error);
+  g_assert_cmpuint (port, !=, 0);
+
+  /* Start the threads only now, as the shard sources were attached above */
+  data.threads[0] = g_thread_new ("shard-0", shard_thread_func, data.contexts[0]);
+  data.threads[1] = g_thread_new ("shard-1", shard_thread_func, data.contexts[1]);
+
+  connectable = g_network_address_new_loopback (port);
+  client = g_socket_client_new ();
+  for (i = 0; i < 8; i++)
+    g_socket_client_connect_async (client, connectable, NULL,
+                                   client_connected_cb, NULL);
+  g_object_unref (client);
+  g_object_unref (connectable);
+
+  while (g_atomic_int_get (&data.n_connections) < 8)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_socket_service_stop (service);
+  g_socket_listener_close (G_SOCKET_LISTENER (service));
+
+  g_atomic_int_set (&shard_threads_quit, TRUE);
+  for (i = 0; i < G_N_ELEMENTS (data.threads); i++)
+    {
+      g_main_context_wakeup (data.contexts[i]);
+      g_thread_join (data.threads[i]);
+      g_main_context_unref (data.contexts[i]);
+    }
+
+  g_object_unref (service);
+}
+
 static void
 closed_read_write_async_cb (GSocketConnection *conn,
                             GAsyncResult      *result,
@@ -561,6 +813,9 @@ main (int   argc,
 
   g_test_add_func ("/socket-service/start-stop", test_start_stop);
   g_test_add_func ("/socket-service/threaded/712570", test_threaded_712570);
+  g_test_add_func ("/socket-service/threaded/io-threads", test_threaded_io_threads);
+  g_test_add_func ("/socket-service/sharded-inet-port", test_sharded_inet_port);
+  g_test_add_func ("/socket-service/connection-pool", test_connection_pool);
   g_test_add_func ("/socket-service/read_write_async", test_read_write_async);
   g_test_add_func ("/socket-service/read_writev_async", test_read_writev_async);
 
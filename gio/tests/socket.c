@@ -27,6 +27,7 @@
 
 #ifdef G_OS_UNIX
 #include <errno.h>
+#include <fcntl.h>
 #include <sys/wait.h>
 #include <string.h>
 #include <stdlib.h>
@@ -1143,6 +1144,93 @@ test_ipv6_v4mapped (void)
 }
 #endif
 
+static void
+test_low_latency (void)
+{
+  IPTestData *data;
+  GError *error = NULL;
+  GSocket *client, *udp;
+  GSocketAddress *addr;
+  gchar buf[128];
+  gssize len;
+  gint value;
+
+  data = create_server (G_SOCKET_FAMILY_IPV4, echo_server_thread, FALSE, &error);
+  if (error != NULL)
+    {
+      g_test_skip_printf ("Failed to create server: %s", error->message);
+      g_clear_error (&error);
+      return;
+    }
+
+  addr = g_socket_get_local_address (data->server, &error);
+  g_assert_no_error (error);
+
+  client = g_socket_new (G_SOCKET_FAMILY_IPV4,
+                         G_SOCKET_TYPE_STREAM,
+                         G_SOCKET_PROTOCOL_DEFAULT,
+                         &error);
+  g_assert_no_error (error);
+
+  g_socket_connect (client, addr, NULL, &error);
+  g_assert_no_error (error);
+  g_object_unref (addr);
+
+  g_socket_set_low_latency (client, TRUE, &error);
+  g_assert_no_error (error);
+  g_socket_get_option (client, IPPROTO_TCP, TCP_NODELAY, &value, &error);
+  g_assert_no_error (error);
+  g_assert_true (value);
+
+  /* Raising the busy poll time needs privileges in most environments */
+  g_assert_cmpuint (g_socket_get_busy_poll (client), ==, 0);
+  if (g_socket_set_busy_poll (client, 50, &error))
+    g_assert_cmpuint (g_socket_get_busy_poll (client), ==, 50);
+  else
+    {
+      g_assert_true (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_PERMISSION_DENIED) ||
+                     g_error_matches (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED));
+      g_assert_cmpuint (g_socket_get_busy_poll (client), ==, 0);
+      g_clear_error (&error);
+    }
+
+  len = g_socket_send (client, testbuf, strlen (testbuf) + 1, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (len, ==, strlen (testbuf) + 1);
+
+  len = g_socket_receive_with_blocking (client, buf, sizeof (buf), TRUE, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (len, ==, strlen (testbuf) + 1);
+  g_assert_cmpstr (testbuf, ==, buf);
+
+#ifdef SO_INCOMING_CPU
+  g_assert_cmpint (g_socket_get_incoming_cpu (client, &error), >=, 0);
+  g_assert_no_error (error);
+#endif
+
+  udp = g_socket_new (G_SOCKET_FAMILY_IPV4,
+                      G_SOCKET_TYPE_DATAGRAM,
+                      G_SOCKET_PROTOCOL_DEFAULT,
+                      &error);
+  g_assert_no_error (error);
+  g_assert_false (g_socket_set_low_latency (udp, TRUE, &error));
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED);
+  g_clear_error (&error);
+  g_object_unref (udp);
+
+  g_socket_close (client, &error);
+  g_assert_no_error (error);
+
+  g_thread_join (data->thread);
+
+  g_socket_close (data->server, &error);
+  g_assert_no_error (error);
+
+  g_object_unref (client);
+
+  ip_test_data_free (data);
+}
+
 static void
 test_timed_wait (void)
 {
@@ -1534,6 +1622,242 @@ test_unix_connection_ancillary_data (void)
    * g_unix_connection_receive_credentials().
    */
 }
+
+static void
+test_unix_connection_send_fds (void)
+{
+  GSocketConnection *sender, *receiver;
+  GError *err = NULL;
+  gint fds[300];
+  gint *received;
+  const gint n_sent = G_N_ELEMENTS (fds);
+  gint sv[2], status, fd, n_fds, total, i;
+
+  status = socketpair (PF_UNIX, SOCK_STREAM, 0, sv);
+  g_assert_cmpint (status, ==, 0);
+  sender = create_connection_for_fd (sv[0]);
+  receiver = create_connection_for_fd (sv[1]);
+
+  fd = open ("/dev/null", O_RDONLY | O_CLOEXEC);
+  g_assert_cmpint (fd, >=, 0);
+  for (i = 0; i < n_sent; i++)
+    fds[i] = fd;
+
+  g_unix_connection_send_fds (G_UNIX_CONNECTION (sender), fds, n_sent,
+                              NULL, &err);
+  g_assert_no_error (err);
+
+  /* The sender keeps its fd */
+  g_assert_cmpint (fcntl (fd, F_GETFD), >=, 0);
+  close (fd);
+
+  /* More fds than fit in one message arrive in several */
+  for (total = 0; total < n_sent; total += n_fds)
+    {
+      received = g_unix_connection_receive_fds (G_UNIX_CONNECTION (receiver), &n_fds,
+                                                NULL, &err);
+      g_assert_no_error (err);
+      g_assert_nonnull (received);
+      g_assert_cmpint (n_fds, >, 0);
+      g_assert_cmpint (n_fds, <, n_sent);
+      g_assert_cmpint (received[n_fds], ==, -1);
+
+      for (i = 0; i < n_fds; i++)
+        {
+          g_assert_cmpint (fcntl (received[i], F_GETFD) & FD_CLOEXEC, !=, 0);
+          close (received[i]);
+        }
+      g_free (received);
+    }
+  g_assert_cmpint (total, ==, n_sent);
+
+  g_object_unref (sender);
+  g_object_unref (receiver);
+}
+
+static void
+io_uring_async_cb (GObject      *source,
+                   GAsyncResult *result,
+                   gpointer      user_data)
+{
+  GAsyncResult **result_out = user_data;
+
+  *result_out = g_object_ref (result);
+}
+
+static void
+test_unix_connection_io_uring (void)
+{
+  GSocketConnection *connections[2];
+  GInputStream *in;
+  GOutputStream *out;
+  GCancellable *cancellable;
+  GAsyncResult *read_result = NULL, *write_result = NULL;
+  GError *error = NULL;
+  char buffer[64];
+  gssize len;
+  int sv[2];
+
+  if (!g_test_subprocess ())
+    {
+      char **envp = g_get_environ ();
+
+      /* The ring is per process, and only enabled through the environment */
+      envp = g_environ_setenv (envp, "GIO_USE_IO_URING", "1", TRUE);
+      g_test_trap_subprocess_with_envp (NULL, (const char * const *) envp, 0,
+                                        G_TEST_SUBPROCESS_DEFAULT);
+      g_test_trap_assert_passed ();
+      g_strfreev (envp);
+      return;
+    }
+
+  g_test_summary ("Test asynchronous reads and writes on sockets with "
+                  "GIO_USE_IO_URING=1, which fall back to poll() where io_uring "
+                  "isn’t available");
+
+  g_assert_cmpint (socketpair (PF_UNIX, SOCK_STREAM, 0, sv), ==, 0);
+  connections[0] = create_connection_for_fd (sv[0]);
+  connections[1] = create_connection_for_fd (sv[1]);
+  in = g_io_stream_get_input_stream (G_IO_STREAM (connections[0]));
+  out = g_io_stream_get_output_stream (G_IO_STREAM (connections[1]));
+
+  /* Read before there is anything to read */
+  g_input_stream_read_async (in, buffer, sizeof (buffer), G_PRIORITY_DEFAULT,
+                             NULL, io_uring_async_cb, &read_result);
+  g_output_stream_write_async (out, TEST_DATA, sizeof (TEST_DATA), G_PRIORITY_DEFAULT,
+                               NULL, io_uring_async_cb, &write_result);
+
+  while (read_result == NULL || write_result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+
+  len = g_output_stream_write_finish (out, write_result, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (len, ==, sizeof (TEST_DATA));
+  len = g_input_stream_read_finish (in, read_result, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (len, ==, sizeof (TEST_DATA));
+  g_assert_cmpstr (buffer, ==, TEST_DATA);
+  g_clear_object (&read_result);
+  g_clear_object (&write_result);
+
+  /* Cancel a pending read */
+  cancellable = g_cancellable_new ();
+  g_input_stream_read_async (in, buffer, sizeof (buffer), G_PRIORITY_DEFAULT,
+                             cancellable, io_uring_async_cb, &read_result);
+  g_main_context_iteration (NULL, FALSE);
+  g_cancellable_cancel (cancellable);
+
+  while (read_result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+
+  len = g_input_stream_read_finish (in, read_result, &error);
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+  g_assert_cmpint (len, ==, -1);
+  g_clear_error (&error);
+  g_clear_object (&read_result);
+  g_object_unref (cancellable);
+
+  /* Close the socket under a pending read */
+  g_input_stream_read_async (in, buffer, sizeof (buffer), G_PRIORITY_DEFAULT,
+                             NULL, io_uring_async_cb, &read_result);
+  g_main_context_iteration (NULL, FALSE);
+  g_socket_close (g_socket_connection_get_socket (connections[0]), &error);
+  g_assert_no_error (error);
+
+  while (read_result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+
+  len = g_input_stream_read_finish (in, read_result, &error);
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_CLOSED);
+  g_assert_cmpint (len, ==, -1);
+  g_clear_error (&error);
+  g_clear_object (&read_result);
+
+  g_object_unref (connections[0]);
+  g_object_unref (connections[1]);
+}
+
+static gpointer
+splice_file_read_thread (gpointer user_data)
+{
+  GInputStream *in = user_data;
+  GByteArray *received = g_byte_array_new ();
+  guint8 buffer[4096];
+  gssize len;
+  GError *error = NULL;
+
+  while ((len = g_input_stream_read (in, buffer, sizeof (buffer), NULL, &error)) > 0)
+    g_byte_array_append (received, buffer, len);
+  g_assert_no_error (error);
+
+  return received;
+}
+
+static void
+test_unix_connection_splice_file (void)
+{
+  GSocketConnection *connections[2];
+  GFile *file;
+  GFileIOStream *iostream;
+  GFileInputStream *file_in;
+  GOutputStream *out;
+  GThread *thread;
+  GByteArray *received;
+  GError *error = NULL;
+  guint8 *data;
+  gsize data_len = 1024 * 1024 + 17;
+  gssize len;
+  gsize i;
+  int sv[2];
+
+  g_test_summary ("Test splicing a file to a socket, which uses sendfile() "
+                  "where available");
+
+  data = g_malloc (data_len);
+  for (i = 0; i < data_len; i++)
+    data[i] = i % 251;
+
+  file = g_file_new_tmp ("splice-file-XXXXXX", &iostream, &error);
+  g_assert_no_error (error);
+  g_output_stream_write_all (g_io_stream_get_output_stream (G_IO_STREAM (iostream)),
+                             data, data_len, NULL, NULL, &error);
+  g_assert_no_error (error);
+  g_object_unref (iostream);
+
+  file_in = g_file_read (file, NULL, &error);
+  g_assert_no_error (error);
+
+  /* Start part of the way through the file */
+  g_seekable_seek (G_SEEKABLE (file_in), 5, G_SEEK_SET, NULL, &error);
+  g_assert_no_error (error);
+
+  g_assert_cmpint (socketpair (PF_UNIX, SOCK_STREAM, 0, sv), ==, 0);
+  connections[0] = create_connection_for_fd (sv[0]);
+  connections[1] = create_connection_for_fd (sv[1]);
+  out = g_io_stream_get_output_stream (G_IO_STREAM (connections[1]));
+
+  thread = g_thread_new ("splice-file-reader", splice_file_read_thread,
+                         g_io_stream_get_input_stream (G_IO_STREAM (connections[0])));
+
+  len = g_output_stream_splice (out, G_INPUT_STREAM (file_in),
+                                G_OUTPUT_STREAM_SPLICE_CLOSE_SOURCE, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (len, ==, data_len - 5);
+
+  g_socket_shutdown (g_socket_connection_get_socket (connections[1]), FALSE, TRUE, &error);
+  g_assert_no_error (error);
+
+  received = g_thread_join (thread);
+  g_assert_cmpmem (received->data, received->len, data + 5, data_len - 5);
+
+  g_byte_array_unref (received);
+  g_object_unref (connections[0]);
+  g_object_unref (connections[1]);
+  g_object_unref (file_in);
+  g_file_delete (file, NULL, NULL);
+  g_object_unref (file);
+  g_free (data);
+}
 #endif
 
 #ifdef G_OS_WIN32
@@ -2442,6 +2766,215 @@ test_receive_bytes (void)
   ip_test_data_free (data);
 }
 
+static void
+test_udp_segmentation (void)
+{
+  GSocket *sender, *receiver;
+  GInetAddress *iaddr;
+  GSocketAddress *addr;
+  GSocketControlMessage *segment_message;
+  GOutputVector output_vector;
+  GOutputMessage output_message = { 0, };
+  gchar send_buf[300];
+  gsize received = 0;
+  gint n;
+  GError *error = NULL;
+
+  g_test_summary ("Test sending and receiving with UDP segmentation offload");
+
+  if (!g_udp_segment_message_is_supported ())
+    {
+      g_test_skip ("UDP segmentation offload not supported");
+      return;
+    }
+
+  receiver = g_socket_new (G_SOCKET_FAMILY_IPV4, G_SOCKET_TYPE_DATAGRAM,
+                           G_SOCKET_PROTOCOL_DEFAULT, &error);
+  g_assert_no_error (error);
+  sender = g_socket_new (G_SOCKET_FAMILY_IPV4, G_SOCKET_TYPE_DATAGRAM,
+                         G_SOCKET_PROTOCOL_DEFAULT, &error);
+  g_assert_no_error (error);
+  g_socket_set_timeout (receiver, 10);
+
+  iaddr = g_inet_address_new_loopback (G_SOCKET_FAMILY_IPV4);
+  addr = g_inet_socket_address_new (iaddr, 0);
+  g_object_unref (iaddr);
+  g_socket_bind (receiver, addr, TRUE, &error);
+  g_assert_no_error (error);
+  g_object_unref (addr);
+
+  addr = g_socket_get_local_address (receiver, &error);
+  g_assert_no_error (error);
+
+  if (!g_udp_segment_message_enable_gro (receiver, TRUE, &error))
+    {
+      g_test_skip_printf ("UDP GRO not supported by the kernel: %s", error->message);
+      g_clear_error (&error);
+      g_object_unref (addr);
+      g_object_unref (sender);
+      g_object_unref (receiver);
+      return;
+    }
+
+  /* One buffer, split into three datagrams of 100 bytes */
+  memset (send_buf, 'x', sizeof (send_buf));
+  output_vector.buffer = send_buf;
+  output_vector.size = sizeof (send_buf);
+
+  segment_message = g_udp_segment_message_new (100);
+  output_message.address = addr;
+  output_message.vectors = &output_vector;
+  output_message.num_vectors = 1;
+  output_message.control_messages = &segment_message;
+  output_message.num_control_messages = 1;
+
+  n = g_socket_send_messages (sender, &output_message, 1, 0, NULL, &error);
+  if (n < 0)
+    {
+      /* Kernels before 4.18 reject UDP_SEGMENT */
+      g_test_skip_printf ("UDP GSO not supported by the kernel: %s", error->message);
+      g_clear_error (&error);
+    }
+  else
+    {
+      g_assert_cmpint (n, ==, 1);
+      g_assert_cmpuint (output_message.bytes_sent, ==, sizeof (send_buf));
+    }
+
+  /* The datagrams arrive either coalesced, with their size attached, or
+   * separately */
+  while (n > 0 && received < sizeof (send_buf))
+    {
+      gchar recv_buf[1024];
+      GInputVector input_vector = { recv_buf, sizeof (recv_buf) };
+      GSocketControlMessage **messages = NULL;
+      guint num_messages = 0;
+      GInputMessage input_message = { 0, };
+      guint i;
+
+      input_message.vectors = &input_vector;
+      input_message.num_vectors = 1;
+      input_message.control_messages = &messages;
+      input_message.num_control_messages = &num_messages;
+
+      n = g_socket_receive_messages (receiver, &input_message, 1, 0, NULL, &error);
+      g_assert_no_error (error);
+      g_assert_cmpint (n, ==, 1);
+
+      if (num_messages == 0)
+        g_assert_cmpuint (input_message.bytes_received, ==, 100);
+
+      for (i = 0; i < num_messages; i++)
+        {
+          g_assert_true (G_IS_UDP_SEGMENT_MESSAGE (messages[i]));
+          g_assert_cmpuint (g_udp_segment_message_get_segment_size (G_UDP_SEGMENT_MESSAGE (messages[i])), ==, 100);
+          g_assert_cmpuint (input_message.bytes_received % 100, ==, 0);
+          g_object_unref (messages[i]);
+        }
+      g_free (messages);
+
+      received += input_message.bytes_received;
+    }
+
+  g_object_unref (segment_message);
+  g_object_unref (addr);
+  g_object_unref (sender);
+  g_object_unref (receiver);
+}
+
+static void
+zerocopy_bytes_released_cb (gpointer user_data)
+{
+  gboolean *released = user_data;
+
+  *released = TRUE;
+}
+
+static void
+test_send_zerocopy (void)
+{
+  IPTestData *data;
+  GError *error = NULL;
+  GSocket *client;
+  GSocketAddress *addr;
+  GBytes *bytes;
+  gboolean released = FALSE;
+  gssize len;
+  gchar buf[128];
+
+  g_test_summary ("Test that g_socket_send_zerocopy() sends the data and "
+                  "releases it once the kernel is done with it");
+
+  data = create_server (G_SOCKET_FAMILY_IPV4, echo_server_thread, FALSE, &error);
+  if (error != NULL)
+    {
+      g_test_skip_printf ("Failed to create server: %s", error->message);
+      g_clear_error (&error);
+      return;
+    }
+
+  addr = g_socket_get_local_address (data->server, &error);
+  g_assert_no_error (error);
+
+  client = g_socket_new (G_SOCKET_FAMILY_IPV4,
+                         G_SOCKET_TYPE_STREAM,
+                         G_SOCKET_PROTOCOL_DEFAULT,
+                         &error);
+  g_assert_no_error (error);
+
+  g_socket_set_blocking (client, TRUE);
+  g_socket_set_timeout (client, 10);
+
+  g_socket_connect (client, addr, NULL, &error);
+  g_assert_no_error (error);
+  g_object_unref (addr);
+
+  bytes = g_bytes_new_with_free_func (testbuf, strlen (testbuf) + 1,
+                                      zerocopy_bytes_released_cb, &released);
+  len = g_socket_send_zerocopy (client, bytes, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (len, ==, strlen (testbuf) + 1);
+  g_bytes_unref (bytes);
+
+  len = g_socket_receive (client, buf, sizeof (buf), NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (len, ==, strlen (testbuf) + 1);
+  g_assert_cmpstr (testbuf, ==, buf);
+
+  /* The completion is processed in the thread-default main context, or the
+   * data was released straight away if zero-copy isn’t supported */
+  while (!released)
+    g_main_context_iteration (NULL, TRUE);
+
+  /* Closing releases anything still pending */
+  bytes = g_bytes_new_with_free_func (testbuf, strlen (testbuf) + 1,
+                                      zerocopy_bytes_released_cb, &released);
+  released = FALSE;
+  len = g_socket_send_zerocopy (client, bytes, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (len, ==, strlen (testbuf) + 1);
+  g_bytes_unref (bytes);
+
+  len = g_socket_receive (client, buf, sizeof (buf), NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (len, ==, strlen (testbuf) + 1);
+
+  g_socket_shutdown (client, FALSE, TRUE, &error);
+  g_assert_no_error (error);
+  g_thread_join (data->thread);
+
+  g_socket_close (client, &error);
+  g_assert_no_error (error);
+  g_assert_true (released);
+
+  g_socket_close (data->server, &error);
+  g_assert_no_error (error);
+
+  g_object_unref (client);
+
+  ip_test_data_free (data);
+}
+
 static void
 test_receive_bytes_from (void)
 {
@@ -2571,6 +3104,8 @@ main (int   argc,
   g_test_add_func ("/socket/ipv4_async", test_ipv4_async);
   g_test_add_func ("/socket/ipv6_sync", test_ipv6_sync);
   g_test_add_func ("/socket/ipv6_async", test_ipv6_async);
+  g_test_add_func ("/socket/send-zerocopy", test_send_zerocopy);
+  g_test_add_func ("/socket/udp-segmentation", test_udp_segmentation);
   g_test_add_func ("/socket/ipv4_sync/datagram", test_ipv4_sync_dgram);
   g_test_add_func ("/socket/ipv4_sync/datagram/timeouts", test_ipv4_sync_dgram_timeouts);
   g_test_add_func ("/socket/ipv6_sync/datagram", test_ipv6_sync_dgram);
@@ -2580,12 +3115,16 @@ main (int   argc,
 #endif
   g_test_add_func ("/socket/close_graceful", test_close_graceful);
   g_test_add_func ("/socket/timed_wait", test_timed_wait);
+  g_test_add_func ("/socket/low-latency", test_low_latency);
   g_test_add_func ("/socket/fd_reuse", test_fd_reuse);
   g_test_add_func ("/socket/address", test_sockaddr);
   g_test_add_func ("/socket/unix-from-fd", test_unix_from_fd);
   g_test_add_func ("/socket/unix-connection", test_unix_connection);
 #ifdef G_OS_UNIX
   g_test_add_func ("/socket/unix-connection-ancillary-data", test_unix_connection_ancillary_data);
+  g_test_add_func ("/socket/unix-connection-send-fds", test_unix_connection_send_fds);
+  g_test_add_func ("/socket/unix-connection-io-uring", test_unix_connection_io_uring);
+  g_test_add_func ("/socket/unix-connection-splice-file", test_unix_connection_splice_file);
 #endif
 #ifdef G_OS_WIN32
   g_test_add_func ("/socket/win32-handle-not-socket", test_handle_not_socket);
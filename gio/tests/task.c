@@ -557,6 +557,55 @@ test_no_callback (void)
   g_assert_null (task);
 }
 
+/* test_return_nested_loop: a callback running a nested main loop still
+ * sees the other tasks returned in the same iteration complete.
+ */
+
+static void
+nested_loop_callback (GObject      *object,
+                      GAsyncResult *result,
+                      gpointer      user_data)
+{
+  gboolean *completed = user_data;
+
+  g_assert_true (g_task_propagate_boolean (G_TASK (result), NULL));
+  completed[0] = TRUE;
+
+  while (!completed[1])
+    g_main_context_iteration (NULL, TRUE);
+}
+
+static void
+sibling_callback (GObject      *object,
+                  GAsyncResult *result,
+                  gpointer      user_data)
+{
+  gboolean *completed = user_data;
+
+  g_assert_true (g_task_propagate_boolean (G_TASK (result), NULL));
+  completed[1] = TRUE;
+}
+
+static void
+test_return_nested_loop (void)
+{
+  GTask *task;
+  gboolean completed[2] = { FALSE, FALSE };
+
+  task = g_task_new (NULL, NULL, nested_loop_callback, completed);
+  g_task_return_boolean (task, TRUE);
+  g_object_unref (task);
+
+  task = g_task_new (NULL, NULL, sibling_callback, completed);
+  g_task_return_boolean (task, TRUE);
+  g_object_unref (task);
+
+  while (!completed[0])
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_true (completed[1]);
+}
+
 /* test_report_error */
 
 static void test_report_error (void);
@@ -1430,6 +1479,81 @@ test_run_in_thread_nested (void)
   unclog_thread_pool ();
 }
 
+/* test_run_in_thread_cpu_bound: CPU-bound tasks don’t wait behind
+ * tasks blocked on I/O.
+ */
+static void
+test_run_in_thread_cpu_bound (void)
+{
+  GTask *task;
+  int seq = 0;
+
+  clog_up_thread_pool ();
+
+  task = g_task_new (NULL, NULL, quit_main_loop_callback, NULL);
+  g_assert_false (g_task_get_cpu_bound (task));
+  g_task_set_cpu_bound (task, TRUE);
+  g_assert_true (g_task_get_cpu_bound (task));
+  g_task_set_task_data (task, &seq, NULL);
+  g_task_run_in_thread (task, set_sequence_number_thread);
+  g_object_unref (task);
+
+  /* The default pool is still full */
+  g_main_loop_run (loop);
+  g_assert_cmpint (seq, !=, 0);
+
+  g_mutex_unlock (&last_fake_task_mutex);
+  unclog_thread_pool ();
+}
+
+/* test_run_in_thread_pool: tasks can be run in a pool of their own,
+ * which runs them by priority.
+ */
+static void
+test_run_in_thread_pool (void)
+{
+  GThreadPool *pool;
+  GTask *task;
+  GMutex mutex;
+  GError *error = NULL;
+  int seq_a, seq_b;
+
+  pool = g_task_thread_pool_new (1, FALSE, &error);
+  g_assert_no_error (error);
+
+  g_mutex_init (&mutex);
+  g_mutex_lock (&mutex);
+
+  /* Keep the only thread busy */
+  task = g_task_new (NULL, NULL, NULL, NULL);
+  g_task_set_task_data (task, &mutex, NULL);
+  g_task_set_thread_pool (task, pool);
+  g_task_run_in_thread (task, fake_task_thread);
+  g_object_unref (task);
+
+  task = g_task_new (NULL, NULL, quit_main_loop_callback, NULL);
+  g_task_set_task_data (task, &seq_a, NULL);
+  g_task_set_priority (task, G_PRIORITY_LOW);
+  g_task_set_thread_pool (task, pool);
+  g_task_run_in_thread (task, set_sequence_number_thread);
+  g_object_unref (task);
+
+  task = g_task_new (NULL, NULL, NULL, NULL);
+  g_task_set_task_data (task, &seq_b, NULL);
+  g_task_set_priority (task, G_PRIORITY_HIGH);
+  g_task_set_thread_pool (task, pool);
+  g_task_run_in_thread (task, set_sequence_number_thread);
+  g_object_unref (task);
+
+  g_mutex_unlock (&mutex);
+  g_main_loop_run (loop);
+
+  g_assert_cmpint (seq_b, <, seq_a);
+
+  g_thread_pool_free (pool, FALSE, TRUE);
+  g_mutex_clear (&mutex);
+}
+
 /* test_run_in_thread_overflow: if you queue lots and lots and lots of
  * tasks, they won't all run at once.
  */
@@ -2586,6 +2710,7 @@ main (int argc, char **argv)
   g_test_add_func ("/gtask/return-from-anon-thread", test_return_from_anon_thread);
   g_test_add_func ("/gtask/return-from-wrong-thread", test_return_from_wrong_thread);
   g_test_add_func ("/gtask/no-callback", test_no_callback);
+  g_test_add_func ("/gtask/return-nested-loop", test_return_nested_loop);
   g_test_add_func ("/gtask/report-error", test_report_error);
   g_test_add_func ("/gtask/priority", test_priority);
   g_test_add_func ("/gtask/name", test_name);
@@ -2598,6 +2723,8 @@ main (int argc, char **argv)
   g_test_add_func ("/gtask/run-in-thread-sync", test_run_in_thread_sync);
   g_test_add_func ("/gtask/run-in-thread-priority", test_run_in_thread_priority);
   g_test_add_func ("/gtask/run-in-thread-nested", test_run_in_thread_nested);
+  g_test_add_func ("/gtask/run-in-thread-cpu-bound", test_run_in_thread_cpu_bound);
+  g_test_add_func ("/gtask/run-in-thread-pool", test_run_in_thread_pool);
   g_test_add_func ("/gtask/run-in-thread-overflow", test_run_in_thread_overflow);
   g_test_add_func ("/gtask/return-on-cancel", test_return_on_cancel);
   g_test_add_func ("/gtask/return-on-cancel-sync", test_return_on_cancel_sync);
@@ -1117,6 +1117,201 @@ test_root (Fixture       *fixture,
   g_clear_object (&file);
 }
 
+typedef struct
+{
+  GFile *expected;
+  gboolean seen;
+  gboolean timed_out;
+} RecursiveData;
+
+static void
+recursive_changed_cb (GFileMonitor      *monitor,
+                      GFile             *file,
+                      GFile             *other_file,
+                      GFileMonitorEvent  event_type,
+                      gpointer           user_data)
+{
+  RecursiveData *data = user_data;
+
+  if (event_type == G_FILE_MONITOR_EVENT_CREATED && g_file_equal (file, data->expected))
+    data->seen = TRUE;
+}
+
+static gboolean
+recursive_timeout_cb (gpointer user_data)
+{
+  RecursiveData *data = user_data;
+
+  data->timed_out = TRUE;
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+test_dir_recursive (Fixture       *fixture,
+                    gconstpointer  user_data)
+{
+  GFileMonitor *monitor = NULL;
+  GFile *subdir = NULL;
+  RecursiveData data = { NULL, FALSE, FALSE };
+  GError *local_error = NULL;
+  guint timeout_id;
+
+  g_test_summary ("Test that a directory monitor with G_FILE_MONITOR_WATCH_RECURSIVE "
+                  "reports files created in its subdirectories.");
+
+  monitor = g_file_monitor_directory (fixture->tmp_dir, G_FILE_MONITOR_WATCH_RECURSIVE,
+                                      NULL, &local_error);
+  if (g_error_matches (local_error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED))
+    {
+      g_test_skip ("Recursive file monitoring is not supported");
+      g_clear_error (&local_error);
+      return;
+    }
+  g_assert_no_error (local_error);
+
+  subdir = g_file_get_child (fixture->tmp_dir, "subdir");
+  g_file_make_directory (subdir, NULL, &local_error);
+  g_assert_no_error (local_error);
+
+  data.expected = g_file_get_child (subdir, "file");
+  g_signal_connect (monitor, "changed", G_CALLBACK (recursive_changed_cb), &data);
+
+  g_file_replace_contents (data.expected, "hello", 5, NULL, FALSE,
+                           G_FILE_CREATE_NONE, NULL, NULL, &local_error);
+  g_assert_no_error (local_error);
+
+  timeout_id = g_timeout_add_seconds (5, recursive_timeout_cb, &data);
+  while (!data.seen && !data.timed_out)
+    g_main_context_iteration (NULL, TRUE);
+  if (!data.timed_out)
+    g_source_remove (timeout_id);
+
+  g_assert_true (data.seen);
+
+  g_file_monitor_cancel (monitor);
+  g_file_delete (data.expected, NULL, &local_error);
+  g_assert_no_error (local_error);
+  g_file_delete (subdir, NULL, &local_error);
+  g_assert_no_error (local_error);
+
+  g_clear_object (&data.expected);
+  g_clear_object (&subdir);
+  g_clear_object (&monitor);
+}
+
+typedef struct
+{
+  guint n_batches;
+  guint n_created;
+  guint n_changed;
+  gboolean timed_out;
+} BatchingData;
+
+static void
+batching_changed_cb (GFileMonitor      *monitor,
+                     GFile             *file,
+                     GFile             *other_file,
+                     GFileMonitorEvent  event_type,
+                     gpointer           user_data)
+{
+  BatchingData *data = user_data;
+
+  data->n_changed++;
+}
+
+static void
+batching_changed_batch_cb (GFileMonitor *monitor,
+                           GArray       *changes,
+                           gpointer      user_data)
+{
+  BatchingData *data = user_data;
+  guint i;
+
+  data->n_batches++;
+
+  for (i = 0; i < changes->len; i++)
+    {
+      GFileMonitorChange *change = &g_array_index (changes, GFileMonitorChange, i);
+
+      g_assert_true (G_IS_FILE (change->file));
+      if (change->event_type == G_FILE_MONITOR_EVENT_CREATED)
+        data->n_created++;
+    }
+}
+
+static gboolean
+batching_timeout_cb (gpointer user_data)
+{
+  BatchingData *data = user_data;
+
+  data->timed_out = TRUE;
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+test_dir_batching (Fixture       *fixture,
+                   gconstpointer  user_data)
+{
+  GFileMonitor *monitor = NULL;
+  BatchingData data = { 0, 0, 0, FALSE };
+  GError *local_error = NULL;
+  GFile *files[10];
+  guint timeout_id;
+  gsize i;
+
+  g_test_summary ("Test that a monitor with batching enabled reports changes "
+                  "with GFileMonitor::changed-batch only.");
+
+  if (skip_win32 ())
+    return;
+
+  monitor = g_file_monitor_directory (fixture->tmp_dir, G_FILE_MONITOR_NONE, NULL, &local_error);
+  g_assert_no_error (local_error);
+
+  g_assert_false (g_file_monitor_get_batching (monitor));
+  g_file_monitor_set_batching (monitor, TRUE);
+  g_assert_true (g_file_monitor_get_batching (monitor));
+
+  g_signal_connect (monitor, "changed", G_CALLBACK (batching_changed_cb), &data);
+  g_signal_connect (monitor, "changed-batch", G_CALLBACK (batching_changed_batch_cb), &data);
+
+  for (i = 0; i < G_N_ELEMENTS (files); i++)
+    {
+      gchar *name = g_strdup_printf ("file%" G_GSIZE_FORMAT, i);
+      GFileOutputStream *stream;
+
+      files[i] = g_file_get_child (fixture->tmp_dir, name);
+      stream = g_file_create (files[i], G_FILE_CREATE_NONE, NULL, &local_error);
+      g_assert_no_error (local_error);
+      g_object_unref (stream);
+      g_free (name);
+    }
+
+  timeout_id = g_timeout_add_seconds (5, batching_timeout_cb, &data);
+  while (data.n_created < G_N_ELEMENTS (files) && !data.timed_out)
+    g_main_context_iteration (NULL, TRUE);
+  if (!data.timed_out)
+    g_source_remove (timeout_id);
+
+  g_assert_cmpuint (data.n_created, ==, G_N_ELEMENTS (files));
+  g_assert_cmpuint (data.n_batches, >, 0);
+  g_assert_cmpuint (data.n_batches, <=, data.n_created);
+  g_assert_cmpuint (data.n_changed, ==, 0);
+
+  g_file_monitor_cancel (monitor);
+
+  for (i = 0; i < G_N_ELEMENTS (files); i++)
+    {
+      g_file_delete (files[i], NULL, &local_error);
+      g_assert_no_error (local_error);
+      g_object_unref (files[i]);
+    }
+
+  g_clear_object (&monitor);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1130,6 +1325,8 @@ main (int argc, char *argv[])
   g_test_add ("/monitor/file/hard-links", Fixture, NULL, setup, test_file_hard_links, teardown);
   g_test_add ("/monitor/finalize-in-callback", Fixture, NULL, setup, test_finalize_in_callback, teardown);
   g_test_add ("/monitor/root", Fixture, NULL, setup, test_root, teardown);
+  g_test_add ("/monitor/dir-recursive", Fixture, NULL, setup, test_dir_recursive, teardown);
+  g_test_add ("/monitor/dir-batching", Fixture, NULL, setup, test_dir_batching, teardown);
 
   return g_test_run ();
 }
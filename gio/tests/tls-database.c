@@ -62,6 +62,135 @@ set_default_database (void)
   g_free (path);
 }
 
+/* A database which counts how often the backend is asked to verify */
+typedef struct
+{
+  GTlsDatabase parent_instance;
+  guint n_verifications;  /* (atomic) */
+  GTlsCertificateFlags result;
+} CountingTlsDatabase;
+
+typedef GTlsDatabaseClass CountingTlsDatabaseClass;
+
+static GType counting_tls_database_get_type (void);
+G_DEFINE_TYPE (CountingTlsDatabase, counting_tls_database, G_TYPE_TLS_DATABASE)
+
+static GTlsCertificateFlags
+counting_tls_database_verify_chain (GTlsDatabase            *database,
+                                    GTlsCertificate         *chain,
+                                    const gchar             *purpose,
+                                    GSocketConnectable      *identity,
+                                    GTlsInteraction         *interaction,
+                                    GTlsDatabaseVerifyFlags  flags,
+                                    GCancellable            *cancellable,
+                                    GError                 **error)
+{
+  CountingTlsDatabase *self = (CountingTlsDatabase *) database;
+
+  g_atomic_int_inc (&self->n_verifications);
+
+  return self->result;
+}
+
+static void
+counting_tls_database_class_init (CountingTlsDatabaseClass *klass)
+{
+  klass->verify_chain = counting_tls_database_verify_chain;
+}
+
+static void
+counting_tls_database_init (CountingTlsDatabase *self)
+{
+}
+
+static void
+verify_cache_async_cb (GObject      *source,
+                       GAsyncResult *result,
+                       gpointer      user_data)
+{
+  GTlsCertificateFlags *flags_out = user_data;
+  GError *error = NULL;
+
+  *flags_out = g_tls_database_verify_chain_finish (G_TLS_DATABASE (source), result, &error);
+  g_assert_no_error (error);
+}
+
+static void
+verify_cache (void)
+{
+  CountingTlsDatabase *counting;
+  GTlsDatabase *database;
+  GTlsCertificate *cert;
+  GSocketConnectable *identity, *other_identity;
+  GTlsCertificateFlags flags = G_TLS_CERTIFICATE_GENERIC_ERROR;
+  GError *error = NULL;
+  gchar *path;
+
+  path = g_test_build_filename (G_TEST_DIST, "cert-tests", "cert1.pem", NULL);
+  cert = g_tls_certificate_new_from_file (path, &error);
+  g_assert_no_error (error);
+  g_free (path);
+
+  identity = g_network_address_new ("server.example.com", 443);
+  other_identity = g_network_address_new ("other.example.com", 443);
+
+  database = g_object_new (counting_tls_database_get_type (), NULL);
+  counting = (CountingTlsDatabase *) database;
+
+#define VERIFY(id) \
+  g_tls_database_verify_chain (database, cert, G_TLS_DATABASE_PURPOSE_AUTHENTICATE_SERVER, \
+                               (id), NULL, G_TLS_DATABASE_VERIFY_NONE, NULL, &error)
+
+  /* Disabled by default */
+  g_assert_cmpint (VERIFY (identity), ==, 0);
+  g_assert_cmpint (VERIFY (identity), ==, 0);
+  g_assert_no_error (error);
+  g_assert_cmpuint (counting->n_verifications, ==, 2);
+
+  /* Successful results are reused for the same chain and identity */
+  g_tls_database_set_verify_cache_size (database, 4);
+  g_assert_cmpint (VERIFY (identity), ==, 0);
+  g_assert_cmpint (VERIFY (identity), ==, 0);
+  g_assert_cmpuint (counting->n_verifications, ==, 3);
+
+  g_assert_cmpint (VERIFY (other_identity), ==, 0);
+  g_assert_cmpint (VERIFY (NULL), ==, 0);
+  g_assert_cmpuint (counting->n_verifications, ==, 5);
+
+  /* Failures are not */
+  counting->result = G_TLS_CERTIFICATE_UNKNOWN_CA;
+  g_tls_database_invalidate_verify_cache (database);
+  g_assert_cmpint (VERIFY (identity), ==, G_TLS_CERTIFICATE_UNKNOWN_CA);
+  g_assert_cmpint (VERIFY (identity), ==, G_TLS_CERTIFICATE_UNKNOWN_CA);
+  g_assert_cmpuint (counting->n_verifications, ==, 7);
+  g_assert_no_error (error);
+
+  /* The async variant shares the cache */
+  counting->result = 0;
+  g_assert_cmpint (VERIFY (identity), ==, 0);
+  g_assert_cmpuint (counting->n_verifications, ==, 8);
+
+  g_tls_database_verify_chain_async (database, cert, G_TLS_DATABASE_PURPOSE_AUTHENTICATE_SERVER,
+                                     identity, NULL, G_TLS_DATABASE_VERIFY_NONE, NULL,
+                                     verify_cache_async_cb, &flags);
+  while (flags == G_TLS_CERTIFICATE_GENERIC_ERROR)
+    g_main_context_iteration (NULL, TRUE);
+  g_assert_cmpint (flags, ==, 0);
+  g_assert_cmpuint (counting->n_verifications, ==, 8);
+
+  /* Disabling the cache drops everything */
+  g_tls_database_set_verify_cache_size (database, 0);
+  g_assert_cmpint (VERIFY (identity), ==, 0);
+  g_assert_cmpuint (counting->n_verifications, ==, 9);
+
+#undef VERIFY
+
+  g_object_unref (database);
+  g_object_unref (other_identity);
+  g_object_unref (identity);
+  g_object_unref (cert);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -72,6 +201,8 @@ main (int   argc,
 
   g_test_add_func ("/tls-backend/set-default-database",
                    set_default_database);
+  g_test_add_func ("/tls-database/verify-cache",
+                   verify_cache);
 
   return g_test_run();
 }
@@ -292,6 +292,92 @@ G_GNUC_END_IGNORE_DEPRECATIONS
 #endif
 }
 
+static void
+test_fd_list_bytes (void)
+{
+  GUnixFDList *list;
+  GBytes *bytes, *mapped;
+  GError *error = NULL;
+  guint8 *data;
+  gsize i;
+  gint index_;
+  gint fd;
+
+  data = g_malloc (100000);
+  for (i = 0; i < 100000; i++)
+    data[i] = i % 251;
+  bytes = g_bytes_new_take (data, 100000);
+
+  list = g_unix_fd_list_new ();
+  index_ = g_unix_fd_list_append_bytes (list, bytes, &error);
+  if (index_ < 0)
+    {
+      g_assert_error (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED);
+      g_test_skip (error->message);
+      g_clear_error (&error);
+      g_object_unref (list);
+      g_bytes_unref (bytes);
+      return;
+    }
+  g_assert_no_error (error);
+  g_assert_cmpint (index_, ==, 0);
+
+  mapped = g_unix_fd_list_map_bytes (list, index_, &error);
+  g_assert_no_error (error);
+  g_assert_true (g_bytes_equal (bytes, mapped));
+  g_bytes_unref (mapped);
+
+  /* The sealed contents cannot be changed */
+  fd = g_unix_fd_list_get (list, index_, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (write (fd, "x", 1), ==, -1);
+  g_close (fd, NULL);
+
+  /* Plain file descriptors are refused */
+  fd = g_open ("/dev/null", O_RDONLY, 0);
+  g_assert_cmpint (fd, >=, 0);
+  g_assert_cmpint (g_unix_fd_list_append (list, fd, &error), ==, 1);
+  g_assert_no_error (error);
+  g_close (fd, NULL);
+  mapped = g_unix_fd_list_map_bytes (list, 1, &error);
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+  g_assert_null (mapped);
+  g_clear_error (&error);
+
+  g_object_unref (list);
+  g_bytes_unref (bytes);
+}
+
+static void
+test_fd_list_take (void)
+{
+  GUnixFDList *list;
+  const gint *peek;
+  gint fd_list[40];
+  gint fds[100];
+  gint i, n;
+
+  create_fd_list (fd_list);
+
+  list = g_unix_fd_list_new ();
+  for (i = 0; i < 100; i++)
+    {
+      fds[i] = dup (0);
+      g_assert_cmpint (fds[i], >=, 0);
+      g_assert_cmpint (g_unix_fd_list_append_take (list, fds[i]), ==, i);
+    }
+
+  /* The fds are owned by the list, not duplicated */
+  peek = g_unix_fd_list_peek_fds (list, &n);
+  g_assert_cmpint (n, ==, 100);
+  for (i = 0; i < 100; i++)
+    g_assert_cmpint (peek[i], ==, fds[i]);
+  g_assert_cmpint (peek[100], ==, -1);
+
+  g_object_unref (list);
+  check_fd_list (fd_list);
+}
+
 int
 main (int argc, char **argv)
 {
@@ -299,6 +385,8 @@ main (int argc, char **argv)
 
   g_test_add_func ("/unix-fd/fd-list", test_fd_list);
   g_test_add_func ("/unix-fd/scm", test_scm);
+  g_test_add_func ("/unix-fd/fd-list-bytes", test_fd_list_bytes);
+  g_test_add_func ("/unix-fd/fd-list-take", test_fd_list_take);
 
   return g_test_run();
 }
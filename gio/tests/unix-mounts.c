@@ -30,6 +30,8 @@
 #include <gio/gio.h>
 #include <gio/gunixmounts.h>
 
+#include "gunixmounts-private.h"
+
 static void
 test_is_system_fs_type (void)
 {
@@ -50,6 +52,139 @@ test_is_system_device_path (void)
   g_assert_false (g_unix_is_system_device_path ("/"));
 }
 
+static void
+test_monitor_signals (void)
+{
+  GSignalQuery query;
+
+  g_test_summary ("Test the flags and parameters of the GUnixMountMonitor signals");
+
+  g_signal_query (g_signal_lookup ("mounts-changed", G_TYPE_UNIX_MOUNT_MONITOR), &query);
+  g_assert_cmpuint (query.signal_id, !=, 0);
+  g_assert_true (query.signal_flags & G_SIGNAL_RUN_FIRST);
+  g_assert_cmpuint (query.n_params, ==, 0);
+
+  g_signal_query (g_signal_lookup ("mounts-changed-detail", G_TYPE_UNIX_MOUNT_MONITOR), &query);
+  g_assert_cmpuint (query.signal_id, !=, 0);
+  g_assert_true (query.signal_flags & G_SIGNAL_RUN_LAST);
+  g_assert_cmpuint (query.n_params, ==, 2);
+  g_assert_cmpuint (query.param_types[0], ==, G_TYPE_PTR_ARRAY);
+  g_assert_cmpuint (query.param_types[1], ==, G_TYPE_PTR_ARRAY);
+}
+
+typedef struct
+{
+  GString *emissions;
+  guint n_added;
+  guint n_removed;
+} MonitorEmissions;
+
+static void
+mounts_changed_cb (GUnixMountMonitor *monitor,
+                   gpointer           user_data)
+{
+  MonitorEmissions *emissions = user_data;
+
+  g_string_append (emissions->emissions, "changed;");
+}
+
+static void
+mounts_changed_detail_cb (GUnixMountMonitor *monitor,
+                          GPtrArray         *added,
+                          GPtrArray         *removed,
+                          gpointer           user_data)
+{
+  MonitorEmissions *emissions = user_data;
+
+  g_string_append (emissions->emissions, "detail;");
+  emissions->n_added = added->len;
+  emissions->n_removed = removed->len;
+}
+
+static void
+queue_change (GUnixMountEntry *added,
+              GUnixMountEntry *removed)
+{
+  GPtrArray *added_array = g_ptr_array_new ();
+  GPtrArray *removed_array = g_ptr_array_new ();
+
+  if (added != NULL)
+    g_ptr_array_add (added_array, added);
+  if (removed != NULL)
+    g_ptr_array_add (removed_array, removed);
+
+  g_unix_mount_monitors_queue_changes (added_array, removed_array);
+
+  g_ptr_array_unref (added_array);
+  g_ptr_array_unref (removed_array);
+}
+
+static void
+test_monitor_changed_detail (void)
+{
+  GUnixMountMonitor *monitor;
+  MonitorEmissions emissions = { NULL, 0, 0 };
+  GList *mounts;
+  GUnixMountEntry *entry;
+
+  g_test_summary ("Test that queued mount changes are emitted in "
+                  "GUnixMountMonitor::mounts-changed-detail before "
+                  "GUnixMountMonitor::mounts-changed");
+
+  mounts = g_unix_mounts_get (NULL);
+  if (mounts == NULL)
+    {
+      g_test_skip ("No mounts to report changes of");
+      return;
+    }
+  entry = mounts->data;
+
+  monitor = g_unix_mount_monitor_get ();
+  emissions.emissions = g_string_new (NULL);
+  g_signal_connect (monitor, "mounts-changed",
+                    G_CALLBACK (mounts_changed_cb), &emissions);
+  g_signal_connect (monitor, "mounts-changed-detail",
+                    G_CALLBACK (mounts_changed_detail_cb), &emissions);
+
+  /* Without any known changes, only ::mounts-changed is emitted */
+  g_signal_emit_by_name (monitor, "mounts-changed");
+  g_assert_cmpstr (emissions.emissions->str, ==, "changed;");
+
+  /* Known changes come first, from the class handler */
+  g_string_truncate (emissions.emissions, 0);
+  queue_change (entry, NULL);
+  g_signal_emit_by_name (monitor, "mounts-changed");
+  g_assert_cmpstr (emissions.emissions->str, ==, "detail;changed;");
+  g_assert_cmpuint (emissions.n_added, ==, 1);
+  g_assert_cmpuint (emissions.n_removed, ==, 0);
+
+  /* They are only reported once */
+  g_string_truncate (emissions.emissions, 0);
+  g_signal_emit_by_name (monitor, "mounts-changed");
+  g_assert_cmpstr (emissions.emissions->str, ==, "changed;");
+
+  /* Changes which are undone before being reported cancel out */
+  g_string_truncate (emissions.emissions, 0);
+  queue_change (entry, NULL);
+  queue_change (NULL, entry);
+  g_signal_emit_by_name (monitor, "mounts-changed");
+  g_assert_cmpstr (emissions.emissions->str, ==, "changed;");
+
+  g_string_truncate (emissions.emissions, 0);
+  queue_change (NULL, entry);
+  queue_change (entry, NULL);
+  queue_change (NULL, entry);
+  g_signal_emit_by_name (monitor, "mounts-changed");
+  g_assert_cmpstr (emissions.emissions->str, ==, "detail;changed;");
+  g_assert_cmpuint (emissions.n_added, ==, 0);
+  g_assert_cmpuint (emissions.n_removed, ==, 1);
+
+  g_signal_handlers_disconnect_by_data (monitor, &emissions);
+  g_object_unref (monitor);
+  g_string_free (emissions.emissions, TRUE);
+  g_list_free_full (mounts, (GDestroyNotify) g_unix_mount_free);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -60,6 +195,8 @@ main (int   argc,
 
   g_test_add_func ("/unix-mounts/is-system-fs-type", test_is_system_fs_type);
   g_test_add_func ("/unix-mounts/is-system-device-path", test_is_system_device_path);
+  g_test_add_func ("/unix-mounts/monitor/signals", test_monitor_signals);
+  g_test_add_func ("/unix-mounts/monitor/changed-detail", test_monitor_changed_detail);
 
   return g_test_run ();
 }
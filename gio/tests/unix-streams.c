@@ -26,6 +26,7 @@
 #include <gio/gunixoutputstream.h>
 #include <glib.h>
 #include <glib/glib-unix.h>
+#include <glib/gstdio.h>
 #include <signal.h>
 #include <stdlib.h>
 #include <string.h>
@@ -360,6 +361,78 @@ test_basic (void)
   g_object_unref (os);
 }
 
+static void
+test_splice_fds (void)
+{
+  GInputStream *is;
+  GOutputStream *os;
+  GError *error = NULL;
+  gchar *in_path, *out_path, *contents;
+  gint in_fd, out_fd, pipe_fds[2];
+  gsize len;
+  gssize n_spliced;
+  guint8 *data;
+  gsize size = 256 * 1024, i;
+
+  data = g_malloc (size);
+  for (i = 0; i < size; i++)
+    data[i] = i % 251;
+
+  /* File to file */
+  in_fd = g_file_open_tmp ("unix-streams-splice-in-XXXXXX", &in_path, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (write (in_fd, data, size), ==, size);
+  g_assert_cmpint (lseek (in_fd, 0, SEEK_SET), ==, 0);
+  out_fd = g_file_open_tmp ("unix-streams-splice-out-XXXXXX", &out_path, &error);
+  g_assert_no_error (error);
+
+  is = g_unix_input_stream_new (in_fd, TRUE);
+  os = g_unix_output_stream_new (out_fd, TRUE);
+  n_spliced = g_output_stream_splice (os, is,
+                                      G_OUTPUT_STREAM_SPLICE_CLOSE_SOURCE |
+                                      G_OUTPUT_STREAM_SPLICE_CLOSE_TARGET,
+                                      NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (n_spliced, ==, size);
+  g_object_unref (is);
+  g_object_unref (os);
+
+  g_file_get_contents (out_path, &contents, &len, &error);
+  g_assert_no_error (error);
+  g_assert_cmpmem (contents, len, data, size);
+  g_free (contents);
+
+  /* Pipe to file */
+  g_unix_open_pipe (pipe_fds, O_CLOEXEC, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (write (pipe_fds[1], data, 4096), ==, 4096);
+  close (pipe_fds[1]);
+  out_fd = g_open (out_path, O_WRONLY | O_TRUNC, 0);
+  g_assert_cmpint (out_fd, >=, 0);
+
+  is = g_unix_input_stream_new (pipe_fds[0], TRUE);
+  os = g_unix_output_stream_new (out_fd, TRUE);
+  n_spliced = g_output_stream_splice (os, is,
+                                      G_OUTPUT_STREAM_SPLICE_CLOSE_SOURCE |
+                                      G_OUTPUT_STREAM_SPLICE_CLOSE_TARGET,
+                                      NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (n_spliced, ==, 4096);
+  g_object_unref (is);
+  g_object_unref (os);
+
+  g_file_get_contents (out_path, &contents, &len, &error);
+  g_assert_no_error (error);
+  g_assert_cmpmem (contents, len, data, 4096);
+  g_free (contents);
+
+  g_unlink (in_path);
+  g_unlink (out_path);
+  g_free (in_path);
+  g_free (out_path);
+  g_free (data);
+}
+
 typedef struct {
   GInputStream *is;
   GOutputStream *os;
@@ -849,6 +922,7 @@ main (int   argc,
   g_test_init (&argc, &argv, NULL);
 
   g_test_add_func ("/unix-streams/basic", test_basic);
+  g_test_add_func ("/unix-streams/splice-fds", test_splice_fds);
   g_test_add_data_func ("/unix-streams/pipe-io-test",
 			GINT_TO_POINTER (FALSE),
 			test_pipe_io);
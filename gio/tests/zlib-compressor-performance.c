@@ -0,0 +1,128 @@
+/* GIO - GLib Input, Output and Streaming Library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gio/gio.h>
+
+#include "../../gobject/tests/performance/performance-report.h"
+
+/* Throughput of GZlibCompressor by number of threads, on log-like input */
+
+static guint8 *input;
+static gsize input_len;
+
+static void
+perform (gconstpointer data)
+{
+  guint threads = GPOINTER_TO_UINT (data);
+  gdouble *results;
+  gint i;
+
+  results = g_new (gdouble, perf_report_repeat);
+
+  for (i = 0; i < perf_report_repeat; i++)
+    {
+      GOutputStream *out, *cout;
+      GConverter *compressor;
+      GError *error = NULL;
+      gdouble time_elapsed;
+
+      out = g_memory_output_stream_new_resizable ();
+      compressor = g_object_new (G_TYPE_ZLIB_COMPRESSOR,
+                                 "format", G_ZLIB_COMPRESSOR_FORMAT_GZIP,
+                                 "level", 6,
+                                 "threads", threads,
+                                 NULL);
+      cout = g_converter_output_stream_new (out, compressor);
+
+      g_test_timer_start ();
+
+      g_output_stream_write_all (cout, input, input_len, NULL, NULL, &error);
+      g_assert_no_error (error);
+      g_output_stream_close (cout, NULL, &error);
+      g_assert_no_error (error);
+
+      time_elapsed = g_test_timer_elapsed ();
+
+      results[i] = ((gdouble) input_len / time_elapsed) * 1.0e-6;
+
+      g_object_unref (cout);
+      g_object_unref (compressor);
+      g_object_unref (out);
+    }
+
+  perf_report_add (g_test_get_path (), "MB/s", TRUE, results, perf_report_repeat);
+
+  /* Sorted by perf_report_add() */
+  g_test_maximized_result (results[perf_report_repeat / 2], "%7.1f MB/s",
+                           results[perf_report_repeat / 2]);
+
+  g_free (results);
+}
+
+int
+main (int argc, char **argv)
+{
+  GOptionContext *context;
+  GError *error = NULL;
+  GString *text;
+  GRand *rand;
+  const guint thread_counts[] = { 1, 2, 4, 8 };
+  gsize i;
+  int ret;
+
+  g_test_init (&argc, &argv, NULL);
+
+  /* GTest writes TAP to stdout, so use --output for the JSON results */
+  context = g_option_context_new (NULL);
+  g_option_context_add_main_entries (context, perf_report_entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error) ||
+      !perf_report_init (&error))
+    {
+      g_printerr ("%s: %s\n", argv[0], error->message);
+      return 1;
+    }
+  g_option_context_free (context);
+
+  /* Fixed seed so that runs are comparable */
+  rand = g_rand_new_with_seed (42);
+  text = g_string_new (NULL);
+  while (text->len < (g_test_perf () ? 64 : 1) * 1024 * 1024)
+    g_string_append_printf (text, "2024-01-01 12:%02u:%02u worker-%u: request %08x took %u ms\n",
+                            g_rand_int_range (rand, 0, 60),
+                            g_rand_int_range (rand, 0, 60),
+                            g_rand_int_range (rand, 0, 16),
+                            g_rand_int (rand),
+                            g_rand_int_range (rand, 0, 1000));
+  g_rand_free (rand);
+  input_len = text->len;
+  input = (guint8 *) g_string_free (text, FALSE);
+
+  for (i = 0; i < G_N_ELEMENTS (thread_counts); i++)
+    {
+      char *path = g_strdup_printf ("/zlib-compressor/perf/gzip/threads-%u", thread_counts[i]);
+      g_test_add_data_func (path, GUINT_TO_POINTER (thread_counts[i]), perform);
+      g_free (path);
+    }
+
+  ret = g_test_run ();
+  ret |= perf_report_finish ();
+
+  g_free (input);
+
+  return ret;
+}
@@ -320,6 +320,11 @@ GIBaseInfo * gi_info_new_full   (GIInfoType    type,
                                  GITypelib    *typelib,
                                  uint32_t      offset);
 
+GIBaseInfo * gi_repository_get_interned_info (GIRepository *repository,
+                                              GIInfoType    type,
+                                              GITypelib    *typelib,
+                                              uint32_t      offset);
+
 GITypeInfo * gi_type_info_new   (GIBaseInfo *container,
                                  GITypelib  *typelib,
                                  uint32_t    offset);
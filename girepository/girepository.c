@@ -32,11 +32,13 @@
 #include <glib.h>
 #include <glib-private.h>
 #include <glib/gprintf.h>
+#include <glib/gstdio.h>
 #include <gmodule.h>
 #include "gibaseinfo-private.h"
 #include "girepository.h"
 #include "gitypelib-internal.h"
 #include "girepository-private.h"
+#include "gtrace-private.h"
 
 /**
  * GIRepository:
@@ -131,10 +133,31 @@ struct _GIRepository
 
   char **cached_shared_libraries;  /* (owned) (nullable) (array zero-terminated=1) */
   size_t cached_n_shared_libraries;  /* length of @cached_shared_libraries, not including NULL terminator */
+
+  GHashTable *typelib_dir_listings;  /* (owned) (element-type filename TypelibDirListing) */
+
+  /* Top-level infos are immutable, so each one is only created once */
+  GHashTable *interned_infos;  /* (owned) GITypelib -> (uint32_t offset -> GIBaseInfo) */
 };
 
+/* The `.typelib` files in a search path directory, so that requiring
+ * several namespaces doesn't list or probe the directory again as long as
+ * its modification time is unchanged. */
+typedef struct
+{
+  int64_t mtime_nsec;  /* of the directory when listed, or -1 to not reuse */
+  GHashTable *typelibs;  /* (owned) (element-type filename) set of file names */
+} TypelibDirListing;
+
 G_DEFINE_TYPE (GIRepository, gi_repository, G_TYPE_OBJECT);
 
+static void
+typelib_dir_listing_free (TypelibDirListing *listing)
+{
+  g_hash_table_unref (listing->typelibs);
+  g_free (listing);
+}
+
 #ifdef G_PLATFORM_WIN32
 #include <windows.h>
 
@@ -328,6 +351,15 @@ gi_repository_init (GIRepository *repository)
                              (GDestroyNotify) NULL,
                              (GDestroyNotify) gtype_interface_cache_free);
   repository->unknown_gtypes = g_hash_table_new (NULL, NULL);
+
+  repository->typelib_dir_listings
+    = g_hash_table_new_full (g_str_hash, g_str_equal,
+                             (GDestroyNotify) g_free,
+                             (GDestroyNotify) typelib_dir_listing_free);
+  repository->interned_infos
+    = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                             (GDestroyNotify) NULL,
+                             (GDestroyNotify) g_hash_table_unref);
 }
 
 static void
@@ -335,6 +367,9 @@ gi_repository_finalize (GObject *object)
 {
   GIRepository *repository = GI_REPOSITORY (object);
 
+  /* Drop the interned infos before the typelibs they point into */
+  g_hash_table_destroy (repository->interned_infos);
+
   g_hash_table_destroy (repository->typelibs);
   g_ptr_array_unref (repository->ordered_typelibs);
   g_hash_table_destroy (repository->lazy_typelibs);
@@ -344,6 +379,7 @@ gi_repository_finalize (GObject *object)
   g_hash_table_destroy (repository->info_by_error_domain);
   g_hash_table_destroy (repository->interfaces_for_gtype);
   g_hash_table_destroy (repository->unknown_gtypes);
+  g_hash_table_destroy (repository->typelib_dir_listings);
 
   g_clear_pointer (&repository->cached_shared_libraries, g_strfreev);
 
@@ -1024,9 +1060,50 @@ gi_repository_get_info (GIRepository *repository,
   entry = gi_typelib_get_dir_entry (typelib, idx + 1);
   g_return_val_if_fail (entry != NULL, NULL);
 
-  return gi_info_new_full (gi_typelib_blob_type_to_info_type (entry->blob_type),
-                           repository,
-                           NULL, typelib, entry->offset);
+  return gi_repository_get_interned_info (repository,
+                                          gi_typelib_blob_type_to_info_type (entry->blob_type),
+                                          typelib, entry->offset);
+}
+
+/*< private >
+ * gi_repository_get_interned_info:
+ * @repository: A #GIRepository
+ * @type: type of the info
+ * @typelib: typelib containing the info
+ * @offset: offset of the info’s blob in @typelib
+ *
+ * Gets the info for a top-level blob, such as a directory entry, without a
+ * container.  All lookups of the same blob share one instance, rather than
+ * allocating a new info each time.
+ *
+ * Returns: (transfer full): the info
+ */
+GIBaseInfo *
+gi_repository_get_interned_info (GIRepository *repository,
+                                 GIInfoType    type,
+                                 GITypelib    *typelib,
+                                 uint32_t      offset)
+{
+  GHashTable *infos;
+  GIBaseInfo *info;
+
+  infos = g_hash_table_lookup (repository->interned_infos, typelib);
+  if (infos == NULL)
+    {
+      infos = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                     (GDestroyNotify) NULL,
+                                     (GDestroyNotify) gi_base_info_unref);
+      g_hash_table_insert (repository->interned_infos, typelib, infos);
+    }
+
+  info = g_hash_table_lookup (infos, GUINT_TO_POINTER (offset));
+  if (info == NULL)
+    {
+      info = gi_info_new_full (type, repository, NULL, typelib, offset);
+      g_hash_table_insert (infos, GUINT_TO_POINTER (offset), info);
+    }
+
+  return gi_base_info_ref (info);
 }
 
 static DirEntry *
@@ -1122,9 +1199,9 @@ gi_repository_find_by_gtype (GIRepository *repository,
 
   if (entry != NULL)
     {
-      cached = gi_info_new_full (gi_typelib_blob_type_to_info_type (entry->blob_type),
-                                 repository,
-                                 NULL, result_typelib, entry->offset);
+      cached = gi_repository_get_interned_info (repository,
+                                                gi_typelib_blob_type_to_info_type (entry->blob_type),
+                                                result_typelib, entry->offset);
 
       g_hash_table_insert (repository->info_by_gtype,
                            (gpointer) gtype,
@@ -1171,9 +1248,9 @@ gi_repository_find_by_name (GIRepository *repository,
   entry = gi_typelib_get_dir_entry_by_name (typelib, name);
   if (entry == NULL)
     return NULL;
-  return gi_info_new_full (gi_typelib_blob_type_to_info_type (entry->blob_type),
-                           repository,
-                           NULL, typelib, entry->offset);
+  return gi_repository_get_interned_info (repository,
+                                          gi_typelib_blob_type_to_info_type (entry->blob_type),
+                                          typelib, entry->offset);
 }
 
 static DirEntry *
@@ -1237,9 +1314,9 @@ gi_repository_find_by_error_domain (GIRepository *repository,
 
   if (result != NULL)
     {
-      cached = (GIEnumInfo *) gi_info_new_full (gi_typelib_blob_type_to_info_type (result->blob_type),
-                                                repository,
-                                                NULL, result_typelib, result->offset);
+      cached = (GIEnumInfo *) gi_repository_get_interned_info (repository,
+                                                               gi_typelib_blob_type_to_info_type (result->blob_type),
+                                                               result_typelib, result->offset);
 
       g_hash_table_insert (repository->info_by_error_domain,
                            GUINT_TO_POINTER (domain),
@@ -1554,10 +1631,70 @@ gi_repository_get_typelib_path (GIRepository *repository,
   return ((char*)orig_key) + strlen ((char *) orig_key) + 1;
 }
 
+/* Returns: (transfer none) (nullable): the set of `.typelib` file names in
+ * @dirname, or `NULL` if it couldn't be listed */
+static GHashTable *
+get_typelib_dir_listing (GIRepository *repository,
+                         const char   *dirname)
+{
+  TypelibDirListing *listing;
+  GStatBuf buf;
+  int64_t mtime_nsec;
+  GDir *dir;
+  const char *entry;
+
+  if (g_stat (dirname, &buf) != 0)
+    {
+      g_hash_table_remove (repository->typelib_dir_listings, dirname);
+      return NULL;
+    }
+
+  mtime_nsec = (int64_t) buf.st_mtime * G_GINT64_CONSTANT (1000000000);
+#if defined (HAVE_STRUCT_STAT_ST_MTIMENSEC)
+  mtime_nsec += buf.st_mtimensec;
+#elif defined (HAVE_STRUCT_STAT_ST_MTIM_TV_NSEC)
+  mtime_nsec += buf.st_mtim.tv_nsec;
+#endif
+
+  listing = g_hash_table_lookup (repository->typelib_dir_listings, dirname);
+  if (listing != NULL && listing->mtime_nsec == mtime_nsec)
+    return listing->typelibs;
+
+  dir = g_dir_open (dirname, 0, NULL);
+  if (dir == NULL)
+    {
+      g_hash_table_remove (repository->typelib_dir_listings, dirname);
+      return NULL;
+    }
+
+  listing = g_new0 (TypelibDirListing, 1);
+  listing->typelibs = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  while ((entry = g_dir_read_name (dir)) != NULL)
+    {
+      if (g_str_has_suffix (entry, ".typelib"))
+        g_hash_table_add (listing->typelibs, g_strdup (entry));
+    }
+  g_dir_close (dir);
+
+  /* With coarse timestamps, the directory could still change in the
+   * second it was listed in without its modification time changing, so
+   * only reuse listings of directories which were last modified earlier */
+  if ((int64_t) buf.st_mtime < g_get_real_time () / G_USEC_PER_SEC)
+    listing->mtime_nsec = mtime_nsec;
+  else
+    listing->mtime_nsec = -1;
+
+  g_hash_table_replace (repository->typelib_dir_listings, g_strdup (dirname), listing);
+
+  return listing->typelibs;
+}
+
 /* This simple search function looks for a specified namespace-version;
    it's faster than the full directory listing required for latest version. */
 static GMappedFile *
-find_namespace_version (const char          *namespace,
+find_namespace_version (GIRepository        *repository,
+                        const char          *namespace,
                         const char          *version,
                         const char * const  *search_paths,
                         size_t               n_search_paths,
@@ -1581,9 +1718,18 @@ find_namespace_version (const char          *namespace,
 
   for (size_t i = 0; i < n_search_paths; ++i)
     {
-      char *path = g_build_filename (search_paths[i], fname, NULL);
+      GHashTable *listing;
+      char *path;
+
+      /* Don't probe directories which are known not to contain the file */
+      listing = get_typelib_dir_listing (repository, search_paths[i]);
+      if (listing != NULL && !g_hash_table_contains (listing, fname))
+        continue;
 
-      mfile = g_mapped_file_new (path, FALSE, &error);
+      path = g_build_filename (search_paths[i], fname, NULL);
+      /* Most of the typelib is going to be needed, so read it in now
+       * rather than faulting it in page by page */
+      mfile = g_mapped_file_new_with_flags (path, G_MAPPED_FILE_FLAGS_POPULATE, &error);
       if (error)
         {
           g_free (path);
@@ -1691,7 +1837,8 @@ free_candidate (struct NamespaceVersionCandidadate *candidate)
 }
 
 static GSList *
-enumerate_namespace_versions (const char         *namespace,
+enumerate_namespace_versions (GIRepository       *repository,
+                              const char         *namespace,
                               const char * const *search_paths,
                               size_t              n_search_paths)
 {
@@ -1708,23 +1855,23 @@ enumerate_namespace_versions (const char         *namespace,
   index = 0;
   for (size_t i = 0; i < n_search_paths; ++i)
     {
-      GDir *dir;
+      GHashTable *listing;
+      GHashTableIter iter;
       const char *dirname;
       const char *entry;
 
       dirname = search_paths[i];
-      dir = g_dir_open (dirname, 0, NULL);
-      if (dir == NULL)
+      listing = get_typelib_dir_listing (repository, dirname);
+      if (listing == NULL)
         continue;
-      while ((entry = g_dir_read_name (dir)) != NULL)
+
+      g_hash_table_iter_init (&iter, listing);
+      while (g_hash_table_iter_next (&iter, (gpointer *) &entry, NULL))
         {
           GMappedFile *mfile;
           char *path, *version;
           struct NamespaceVersionCandidadate *candidate;
 
-          if (!g_str_has_suffix (entry, ".typelib"))
-            continue;
-
           if (g_str_has_prefix (entry, namespace_dash))
             {
               const char *last_dash;
@@ -1775,7 +1922,6 @@ enumerate_namespace_versions (const char         *namespace,
           candidates = g_slist_prepend (candidates, candidate);
           g_hash_table_add (found_versions, version);
         }
-      g_dir_close (dir);
       index++;
     }
 
@@ -1787,7 +1933,8 @@ enumerate_namespace_versions (const char         *namespace,
 }
 
 static GMappedFile *
-find_namespace_latest (const char          *namespace,
+find_namespace_latest (GIRepository        *repository,
+                       const char          *namespace,
                        const char * const  *search_paths,
                        size_t               n_search_paths,
                        char               **version_ret,
@@ -1799,7 +1946,7 @@ find_namespace_latest (const char          *namespace,
   *version_ret = NULL;
   *path_ret = NULL;
 
-  candidates = enumerate_namespace_versions (namespace, search_paths, n_search_paths);
+  candidates = enumerate_namespace_versions (repository, namespace, search_paths, n_search_paths);
 
   if (candidates != NULL)
     {
@@ -1810,7 +1957,14 @@ find_namespace_latest (const char          *namespace,
       /* Remove the elected one so we don't try to free its contents */
       candidates = g_slist_delete_link (candidates, candidates);
 
-      result = elected->mfile;
+      /* The candidates were only mapped to check they can be read; map
+       * the elected one again, reading it in as find_namespace_version()
+       * does */
+      result = g_mapped_file_new_with_flags (elected->path, G_MAPPED_FILE_FLAGS_POPULATE, NULL);
+      if (result != NULL)
+        g_mapped_file_unref (elected->mfile);
+      else
+        result = elected->mfile;
       *path_ret = elected->path;
       *version_ret = elected->version;
       g_slice_free (struct NamespaceVersionCandidadate, elected); /* just free the container */
@@ -1847,7 +2001,7 @@ gi_repository_enumerate_versions (GIRepository *repository,
 
   g_return_val_if_fail (GI_IS_REPOSITORY (repository), NULL);
 
-  candidates = enumerate_namespace_versions (namespace_,
+  candidates = enumerate_namespace_versions (repository, namespace_,
                                              (const char * const *) repository->typelib_search_path->pdata,
                                              repository->typelib_search_path->len);
 
@@ -1905,6 +2059,7 @@ require_internal (GIRepository           *repository,
   char *version_conflict = NULL;
   char *path = NULL;
   char *tmp_version = NULL;
+  int64_t begin_time_nsec G_GNUC_UNUSED;
 
   g_return_val_if_fail (GI_IS_REPOSITORY (repository), NULL);
   g_return_val_if_fail (namespace != NULL, NULL);
@@ -1923,15 +2078,17 @@ require_internal (GIRepository           *repository,
       return NULL;
     }
 
+  begin_time_nsec = G_TRACE_CURRENT_TIME;
+
   if (version != NULL)
     {
-      mfile = find_namespace_version (namespace, version, search_paths,
+      mfile = find_namespace_version (repository, namespace, version, search_paths,
                                       n_search_paths, &path);
       tmp_version = g_strdup (version);
     }
   else
     {
-      mfile = find_namespace_latest (namespace, search_paths, n_search_paths,
+      mfile = find_namespace_latest (repository, namespace, search_paths, n_search_paths,
                                      &tmp_version, &path);
     }
 
@@ -1999,6 +2156,11 @@ require_internal (GIRepository           *repository,
     goto out;
   ret = typelib;
  out:
+  g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                "GIRepository", "require",
+                "%s-%s: %s", namespace, version != NULL ? version : "(latest)",
+                ret != NULL ? path : "not loaded");
+
   g_clear_pointer (&typelib_owned, gi_typelib_unref);
   g_free (tmp_version);
   g_free (path);
@@ -35,7 +35,7 @@
 #define ALIGN_VALUE(this, boundary) \
   (( ((unsigned long)(this)) + (((unsigned long)(boundary)) -1)) & (~(((unsigned long)(boundary))-1)))
 
-#define NUM_SECTIONS 2
+#define NUM_SECTIONS 3
 
 /*< private >
  * gi_ir_module_new:
@@ -323,6 +323,68 @@ add_directory_index_section (uint8_t *data, GIIrModule *module, uint32_t *offset
   return data;
 }
 
+static uint8_t *
+add_gtype_name_index_section (uint8_t *data, GIIrModule *module, uint32_t *offset2)
+{
+  DirEntry *entry;
+  Header *header = (Header*)data;
+  GITypelibHashBuilder *gtype_builder;
+  uint16_t n_interfaces;
+  uint32_t n_gtypes = 0;
+  uint32_t required_size;
+  uint32_t new_offset;
+
+  gtype_builder = gi_typelib_hash_builder_new ();
+
+  n_interfaces = ((Header *)data)->n_local_entries;
+
+  for (uint16_t i = 0; i < n_interfaces; i++)
+    {
+      RegisteredTypeBlob *blob;
+      const char *str;
+
+      entry = (DirEntry *)&data[header->directory + (i * header->entry_blob_size)];
+      if (!BLOB_IS_REGISTERED_TYPE (entry))
+        continue;
+
+      blob = (RegisteredTypeBlob *)&data[entry->offset];
+      if (!blob->gtype_name)
+        continue;
+
+      str = (const char *) (&data[blob->gtype_name]);
+      gi_typelib_hash_builder_add_string (gtype_builder, str, i);
+      n_gtypes++;
+    }
+
+  /* As for the directory index, leave the section out if there is
+   * nothing to index or CMPH couldn't create a perfect hash.
+   */
+  if (n_gtypes == 0 || !gi_typelib_hash_builder_prepare (gtype_builder))
+    {
+      gi_typelib_hash_builder_destroy (gtype_builder);
+      return data;
+    }
+
+  alloc_section (data, GI_SECTION_GTYPE_NAME_INDEX, *offset2);
+
+  /* The number of hashed names comes first, as unlike for the directory
+   * index it can't be derived from the header */
+  required_size = gi_typelib_hash_builder_get_buffer_size (gtype_builder);
+  required_size = ALIGN_VALUE (required_size, 4);
+
+  new_offset = *offset2 + sizeof (uint32_t) + required_size;
+
+  data = g_realloc (data, new_offset);
+
+  *((uint32_t *) &data[*offset2]) = n_gtypes;
+  gi_typelib_hash_builder_pack (gtype_builder, ((uint8_t*)data) + *offset2 + sizeof (uint32_t), required_size);
+
+  *offset2 = new_offset;
+
+  gi_typelib_hash_builder_destroy (gtype_builder);
+  return data;
+}
+
 GITypelib *
 gi_ir_module_build_typelib (GIIrModule *module)
 {
@@ -466,8 +528,8 @@ gi_ir_module_build_typelib (GIIrModule *module)
   header->sections = offset2;
 
   /* Initialize all the sections to _END/0; we fill them in later using
-   * alloc_section().  (Right now there's just the directory index
-   * though, note)
+   * alloc_section().  (Right now there's just the directory index and
+   * the GType name index though, note)
    */
   for (i = 0; i < NUM_SECTIONS; i++)
     {
@@ -581,6 +643,9 @@ gi_ir_module_build_typelib (GIIrModule *module)
   data = add_directory_index_section (data, module, &offset2);
   header = (Header *)data;
 
+  data = add_gtype_name_index_section (data, module, &offset2);
+  header = (Header *)data;
+
   length = header->size = offset2;
 
   bytes = g_bytes_new_take (g_steal_pointer (&data), length);
@@ -335,6 +335,9 @@ typedef struct {
  * SectionType:
  * @GI_SECTION_END: TODO
  * @GI_SECTION_DIRECTORY_INDEX: TODO
+ * @GI_SECTION_GTYPE_NAME_INDEX: Perfect hash from the GType names of the
+ *   registered types to their directory indexes, preceded by the number of
+ *   hashed names as a `uint32_t`. (Since: 2.82)
  *
  * TODO
  *
@@ -342,7 +345,8 @@ typedef struct {
  */
 typedef enum {
   GI_SECTION_END = 0,
-  GI_SECTION_DIRECTORY_INDEX = 1
+  GI_SECTION_DIRECTORY_INDEX = 1,
+  GI_SECTION_GTYPE_NAME_INDEX = 2,
 } SectionType;
 
 /**
@@ -352,7 +356,7 @@ typedef enum {
  *
  * A section is a blob of data that's (at least theoretically) optional,
  * and may or may not be present in the typelib.  Presently, just used
- * for the directory index.  This allows a form of dynamic extensibility
+ * for the directory index and the GType name index.  This allows a form of dynamic extensibility
  * with different tradeoffs from the format minor version.
  *
  * Since: 2.80
@@ -249,6 +249,33 @@ gi_typelib_get_dir_entry_by_gtype_name (GITypelib   *typelib,
                                         const char  *gtype_name)
 {
   Header *header = (Header *)typelib->data;
+  Section *gtype_index;
+
+  gtype_index = get_section_by_id (typelib, GI_SECTION_GTYPE_NAME_INDEX);
+
+  if (gtype_index != NULL)
+    {
+      uint8_t *hash = (uint8_t *) &typelib->data[gtype_index->offset + sizeof (uint32_t)];
+      uint32_t n_gtypes = *((uint32_t *) &typelib->data[gtype_index->offset]);
+      RegisteredTypeBlob *blob;
+      DirEntry *entry;
+      uint16_t index;
+
+      /* The hash gives some index for any name, so check it */
+      index = gi_typelib_hash_search (hash, gtype_name, n_gtypes);
+      if (index >= header->n_local_entries)
+        return NULL;
+
+      entry = gi_typelib_get_dir_entry (typelib, index + 1);
+      if (!BLOB_IS_REGISTERED_TYPE (entry))
+        return NULL;
+
+      blob = (RegisteredTypeBlob *)(&typelib->data[entry->offset]);
+      if (blob->gtype_name &&
+          strcmp (gi_typelib_get_string (typelib, blob->gtype_name), gtype_name) == 0)
+        return entry;
+      return NULL;
+    }
 
   for (size_t i = 1; i <= header->n_local_entries; i++)
     {
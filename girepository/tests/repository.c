@@ -32,6 +32,7 @@
 
 #include "gio.h"
 #include "girepository.h"
+#include "gitypelib-internal.h"
 #include "glib.h"
 #include "test-common.h"
 
@@ -802,6 +803,44 @@ test_repository_vfunc_info_with_invoker_on_object (RepositoryFixture *fx,
   g_clear_pointer (&invoker_info, gi_base_info_unref);
 }
 
+static void
+test_repository_interned_info (RepositoryFixture *fx,
+                               const void        *unused)
+{
+  GIBaseInfo *info1 = NULL, *info2 = NULL;
+  GIObjectInfo *object_info = NULL;
+  GIFunctionInfo *method_info = NULL;
+  GITypeInfo *type_info = NULL;
+  GIBaseInfo *interface_info = NULL;
+
+  g_test_summary ("Test that repeated lookups of a top-level info share one instance");
+
+  info1 = gi_repository_find_by_name (fx->repository, "GObject", "Object");
+  info2 = gi_repository_find_by_name (fx->repository, "GObject", "Object");
+  g_assert_nonnull (info1);
+  g_assert_true (info1 == info2);
+  g_clear_pointer (&info2, gi_base_info_unref);
+
+  info2 = gi_repository_find_by_gtype (fx->repository, G_TYPE_OBJECT);
+  g_assert_true (info1 == info2);
+  g_clear_pointer (&info2, gi_base_info_unref);
+
+  /* Infos reached through a type are the same instance too */
+  object_info = (GIObjectInfo *) gi_repository_find_by_name (fx->repository, "GObject", "Binding");
+  g_assert_nonnull (object_info);
+  method_info = gi_object_info_find_method (object_info, "get_source");
+  g_assert_nonnull (method_info);
+  type_info = gi_callable_info_get_return_type (GI_CALLABLE_INFO (method_info));
+  interface_info = gi_type_info_get_interface (type_info);
+  g_assert_true (interface_info == info1);
+
+  g_clear_pointer (&interface_info, gi_base_info_unref);
+  g_clear_pointer (&type_info, gi_base_info_unref);
+  g_clear_pointer (&method_info, gi_base_info_unref);
+  g_clear_pointer (&object_info, gi_base_info_unref);
+  g_clear_pointer (&info1, gi_base_info_unref);
+}
+
 static void
 test_repository_find_by_gtype (RepositoryFixture *fx,
                                const void        *unused)
@@ -863,6 +902,140 @@ test_repository_find_by_gtype (RepositoryFixture *fx,
   }
 }
 
+static GBytes *
+read_typelib (RepositoryFixture *fx,
+              const char        *filename)
+{
+  char *path, *contents;
+  size_t length;
+  GError *local_error = NULL;
+
+  path = g_build_filename (fx->gobject_typelib_dir, filename, NULL);
+  g_file_get_contents (path, &contents, &length, &local_error);
+  g_assert_no_error (local_error);
+  g_free (path);
+
+  return g_bytes_new_take (contents, length);
+}
+
+static Section *
+find_typelib_section (uint8_t     *data,
+                      SectionType  id)
+{
+  Header *header = (Header *) data;
+
+  if (header->sections == 0)
+    return NULL;
+
+  for (Section *section = (Section *) &data[header->sections];
+       section->id != GI_SECTION_END;
+       section++)
+    {
+      if (section->id == id)
+        return section;
+    }
+
+  return NULL;
+}
+
+/* A GType with a prefix which matches the GObject and Gio typelibs, but
+ * which is in neither */
+static GType
+not_in_any_typelib_get_type (void)
+{
+  static GType type = 0;
+
+  if (type == 0)
+    type = g_type_register_static_simple (G_TYPE_OBJECT, "GNotInAnyTypelib",
+                                          sizeof (GObjectClass), NULL,
+                                          sizeof (GObject), NULL, 0);
+
+  return type;
+}
+
+static void
+assert_found_by_gtype (GIRepository *repository,
+                       GType         gtype,
+                       const char   *expected_namespace,
+                       const char   *expected_name)
+{
+  GIBaseInfo *info;
+
+  info = gi_repository_find_by_gtype (repository, gtype);
+  g_assert_nonnull (info);
+  g_assert_true (GI_IS_REGISTERED_TYPE_INFO (info));
+  g_assert_cmpstr (gi_base_info_get_namespace (info), ==, expected_namespace);
+  g_assert_cmpstr (gi_base_info_get_name (info), ==, expected_name);
+  gi_base_info_unref (info);
+}
+
+static void
+test_repository_find_by_gtype_name_index (RepositoryFixture *fx,
+                                          const void        *unused)
+{
+  GBytes *bytes;
+  Section *section;
+
+  g_test_summary ("Test finding GTypes through the GType name index of a typelib");
+
+  /* The compiler writes the index for typelibs with registered types */
+  bytes = read_typelib (fx, "Gio-2.0.typelib");
+  section = find_typelib_section ((uint8_t *) g_bytes_get_data (bytes, NULL),
+                                  GI_SECTION_GTYPE_NAME_INDEX);
+  g_assert_nonnull (section);
+  g_assert_cmpuint (*(uint32_t *) ((uint8_t *) g_bytes_get_data (bytes, NULL) + section->offset), >, 0);
+  g_bytes_unref (bytes);
+
+  /* Objects, interfaces, boxed types, enums and flags are all indexed */
+  assert_found_by_gtype (fx->repository, G_TYPE_CANCELLABLE, "Gio", "Cancellable");
+  assert_found_by_gtype (fx->repository, G_TYPE_APPLICATION, "Gio", "Application");
+  assert_found_by_gtype (fx->repository, G_TYPE_FILE, "Gio", "File");
+  assert_found_by_gtype (fx->repository, G_TYPE_FILE_ATTRIBUTE_MATCHER, "Gio", "FileAttributeMatcher");
+  assert_found_by_gtype (fx->repository, G_TYPE_FILE_TYPE, "Gio", "FileType");
+  assert_found_by_gtype (fx->repository, G_TYPE_FILE_QUERY_INFO_FLAGS, "Gio", "FileQueryInfoFlags");
+  assert_found_by_gtype (fx->repository, G_TYPE_OBJECT, "GObject", "Object");
+
+  /* The index gives some entry for any name, which must not be taken as a
+   * match */
+  g_assert_null (gi_repository_find_by_gtype (fx->repository, not_in_any_typelib_get_type ()));
+}
+
+static void
+test_repository_find_by_gtype_no_name_index (RepositoryFixture *fx,
+                                             const void        *unused)
+{
+  GBytes *bytes;
+  uint8_t *data;
+  size_t length;
+  Section *section;
+  GITypelib *typelib;
+  GError *local_error = NULL;
+
+  g_test_summary ("Test finding GTypes in a typelib without a GType name index");
+
+  /* Hide the index, as in typelibs from older compilers */
+  bytes = read_typelib (fx, "GObject-2.0.typelib");
+  data = g_bytes_unref_to_data (bytes, &length);
+  section = find_typelib_section (data, GI_SECTION_GTYPE_NAME_INDEX);
+  g_assert_nonnull (section);
+  section->id = G_MAXUINT32;
+  g_assert_null (find_typelib_section (data, GI_SECTION_GTYPE_NAME_INDEX));
+
+  bytes = g_bytes_new_take (data, length);
+  typelib = gi_typelib_new_from_bytes (bytes, &local_error);
+  g_assert_no_error (local_error);
+  g_bytes_unref (bytes);
+  g_assert_cmpstr (gi_repository_load_typelib (fx->repository, typelib, 0, &local_error), ==, "GObject");
+  g_assert_no_error (local_error);
+
+  assert_found_by_gtype (fx->repository, G_TYPE_OBJECT, "GObject", "Object");
+  assert_found_by_gtype (fx->repository, G_TYPE_BINDING, "GObject", "Binding");
+  assert_found_by_gtype (fx->repository, G_TYPE_BINDING_FLAGS, "GObject", "BindingFlags");
+  g_assert_null (gi_repository_find_by_gtype (fx->repository, not_in_any_typelib_get_type ()));
+
+  gi_typelib_unref (typelib);
+}
+
 static void
 test_repository_loaded_namespaces (RepositoryFixture *fx,
                                    const void        *unused)
@@ -920,6 +1093,9 @@ main (int   argc,
   ADD_REPOSITORY_TEST ("/repository/vfunc-info-with-invoker-on-interface", test_repository_vfunc_info_with_invoker_on_interface, &typelib_load_spec_gio);
   ADD_REPOSITORY_TEST ("/repository/vfunc-info-with-invoker-on-object", test_repository_vfunc_info_with_invoker_on_object, &typelib_load_spec_gio);
   ADD_REPOSITORY_TEST ("/repository/find-by-gtype", test_repository_find_by_gtype, &typelib_load_spec_gio_platform);
+  ADD_REPOSITORY_TEST ("/repository/find-by-gtype/name-index", test_repository_find_by_gtype_name_index, &typelib_load_spec_gio);
+  ADD_REPOSITORY_TEST ("/repository/find-by-gtype/no-name-index", test_repository_find_by_gtype_no_name_index, NULL);
+  ADD_REPOSITORY_TEST ("/repository/interned-info", test_repository_interned_info, &typelib_load_spec_gobject);
   ADD_REPOSITORY_TEST ("/repository/loaded-namespaces", test_repository_loaded_namespaces, &typelib_load_spec_gio_platform);
 
   return g_test_run ();
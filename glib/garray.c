@@ -40,13 +40,21 @@
 #include "ghash.h"
 #include "gslice.h"
 #include "gmem.h"
+#include "gmemarena.h"
+#include "gstrfuncs.h"
 #include "gtestutils.h"
 #include "gthread.h"
 #include "gmessages.h"
 #include "gqsort.h"
+#include "gqsortprivate.h"
 #include "grefcount.h"
 #include "gutilsprivate.h"
 
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PTR_ARRAY_FIND_SSE2
+#endif
+
 #define MIN_ARRAY_SIZE  16
 
 typedef struct _GRealArray  GRealArray;
@@ -68,10 +76,19 @@ struct _GRealArray
   guint   elt_size;
   guint   zero_terminated : 1;
   guint   clear : 1;
+  guint   in_arena : 1;
   gatomicrefcount ref_count;
   GDestroyNotify clear_func;
 };
 
+/* Arrays created in a #GMemArena are allocated with the arena pointer
+ * after the usual struct, so other arrays don't pay for it */
+typedef struct
+{
+  GRealArray  array;
+  GMemArena  *arena;
+} GRealArenaArray;
+
 /**
  * g_array_index:
  * @a: a #GArray
@@ -303,6 +320,9 @@ g_array_steal (GArray *array,
   rarray = (GRealArray *) array;
   segment = (gpointer) rarray->data;
 
+  if (rarray->in_arena && segment != NULL)
+    segment = g_memdup2 (segment, g_array_elt_len (rarray, rarray->len + rarray->zero_terminated));
+
   if (len != NULL)
     *len = rarray->len;
 
@@ -333,21 +353,68 @@ g_array_sized_new (gboolean zero_terminated,
                    gboolean clear,
                    guint    elt_size,
                    guint    reserved_size)
+{
+  return g_array_new_in_arena (NULL, zero_terminated, clear, elt_size, reserved_size);
+}
+
+/**
+ * g_array_new_in_arena:
+ * @arena: (nullable): the #GMemArena to allocate the array in
+ * @zero_terminated: %TRUE if the array should have an extra element at
+ *     the end with all bits cleared
+ * @clear_: %TRUE if all bits in the array should be cleared to 0 on
+ *     allocation
+ * @element_size: size of each element in the array
+ * @reserved_size: number of elements preallocated
+ *
+ * Creates a new #GArray like g_array_sized_new(), whose structure and
+ * element data are allocated from @arena.
+ *
+ * Growing such an array is cheap, as it takes memory from the arena
+ * rather than from the system allocator. The array must not be used
+ * once @arena has been reset or freed; its memory is only released
+ * then, even once its last reference is dropped. Dropping the last
+ * reference still calls the clear function on the elements. Functions
+ * which transfer the element data to the caller, such as g_array_free()
+ * with @free_segment set to %FALSE and g_array_steal(), return a
+ * g_malloc()-allocated copy.
+ *
+ * If @arena is %NULL this is equivalent to g_array_sized_new().
+ *
+ * Returns: (transfer full): the new #GArray
+ *
+ * Since: 2.82
+ */
+GArray *
+g_array_new_in_arena (GMemArena *arena,
+                      gboolean   zero_terminated,
+                      gboolean   clear,
+                      guint      elt_size,
+                      guint      reserved_size)
 {
   GRealArray *array;
-  
+
   g_return_val_if_fail (elt_size > 0, NULL);
 #if (UINT_WIDTH / 8) >= GLIB_SIZEOF_SIZE_T
   g_return_val_if_fail (elt_size <= G_MAXSIZE / 2 - 1, NULL);
 #endif
 
-  array = g_slice_new (GRealArray);
+  if (arena != NULL)
+    {
+      GRealArenaArray *arena_array = g_mem_arena_alloc (arena, sizeof (GRealArenaArray));
+
+      arena_array->arena = arena;
+      array = &arena_array->array;
+    }
+  else
+    array = g_slice_new (GRealArray);
 
   array->data            = NULL;
   array->len             = 0;
   array->elt_capacity = 0;
   array->zero_terminated = (zero_terminated ? 1 : 0);
   array->clear           = (clear ? 1 : 0);
+  array->in_arena        = (arena != NULL);
   array->elt_size        = elt_size;
   array->clear_func      = NULL;
 
@@ -541,9 +608,12 @@ array_free (GRealArray     *array,
             array->clear_func (g_array_elt_pos (array, i));
         }
 
-      g_free (array->data);
+      if (!array->in_arena)
+        g_free (array->data);
       segment = NULL;
     }
+  else if (array->in_arena && array->data != NULL)
+    segment = g_memdup2 (array->data, g_array_elt_len (array, array->len + array->zero_terminated));
   else
     segment = (gchar*) array->data;
 
@@ -553,7 +623,7 @@ array_free (GRealArray     *array,
       array->len             = 0;
       array->elt_capacity = 0;
     }
-  else
+  else if (!array->in_arena)
     {
       g_slice_free1 (sizeof (GRealArray), array);
     }
@@ -964,6 +1034,66 @@ g_array_sort_with_data (GArray           *farray,
                        user_data);
 }
 
+/**
+ * g_array_sort_parallel:
+ * @array: a #GArray
+ * @compare_func: (scope call): comparison function, which must be safe to
+ *   call from several threads at once
+ * @user_data: data to pass to @compare_func
+ *
+ * Like g_array_sort_with_data(), but large arrays are sorted using several
+ * threads from the shared #GThreadPool threads.
+ *
+ * This is a stable sort.
+ *
+ * Since: 2.82
+ */
+void
+g_array_sort_parallel (GArray           *farray,
+                       GCompareDataFunc  compare_func,
+                       gpointer          user_data)
+{
+  GRealArray *array = (GRealArray*) farray;
+
+  g_return_if_fail (array != NULL);
+
+  if (array->len > 0)
+    g_qsort_with_data_parallel (array->data,
+                                array->len,
+                                array->elt_size,
+                                compare_func,
+                                user_data);
+}
+
+/**
+ * g_array_sort_integers:
+ * @array: a #GArray of integers
+ * @is_signed: whether the elements are signed
+ *
+ * Sorts a #GArray whose elements are 8, 16, 32 or 64-bit integers into
+ * ascending numerical order.
+ *
+ * This uses a radix sort rather than comparisons, so it is much faster than
+ * g_array_sort() with a comparison function for the same ordering. Equal
+ * integers are indistinguishable, so the question of stability doesn't
+ * arise.
+ *
+ * Since: 2.82
+ */
+void
+g_array_sort_integers (GArray   *farray,
+                       gboolean  is_signed)
+{
+  GRealArray *array = (GRealArray*) farray;
+
+  g_return_if_fail (array != NULL);
+  g_return_if_fail (array->elt_size == 1 || array->elt_size == 2 ||
+                    array->elt_size == 4 || array->elt_size == 8);
+
+  if (array->len > 0)
+    g_sort_integers (array->data, array->len, array->elt_size, is_signed);
+}
+
 /**
  * g_array_binary_search:
  * @array: a #GArray.
@@ -1003,48 +1133,178 @@ g_array_sort_with_data (GArray           *farray,
  *
  * Since: 2.62
  */
+/* Index of the first element of the sorted @data which is not less than
+ * @target. The loop is branch free, as the direction taken at each step of
+ * a binary search is unpredictable. */
+static gsize
+array_lower_bound (const guint8  *data,
+                   gsize          len,
+                   gsize          elt_size,
+                   gconstpointer  target,
+                   GCompareFunc   compare_func)
+{
+  const guint8 *base = data;
+
+  while (len > 1)
+    {
+      gsize half = len / 2;
+
+      base = (compare_func (base + half * elt_size, target) < 0) ? base + half * elt_size : base;
+      len -= half;
+    }
+
+  return (base - data) / elt_size + (compare_func (base, target) < 0);
+}
+
 gboolean
 g_array_binary_search (GArray        *array,
                        gconstpointer  target,
                        GCompareFunc   compare_func,
                        guint         *out_match_index)
 {
-  gboolean result = FALSE;
   GRealArray *_array = (GRealArray *) array;
-  guint left, middle = 0, right;
-  gint val;
+  gsize index;
 
   g_return_val_if_fail (_array != NULL, FALSE);
   g_return_val_if_fail (compare_func != NULL, FALSE);
 
-  if (G_LIKELY(_array->len))
-    {
-      left = 0;
-      right = _array->len - 1;
+  if (_array->len == 0)
+    return FALSE;
 
-      while (left <= right)
-        {
-          middle = left + (right - left) / 2;
+  index = array_lower_bound (_array->data, _array->len, _array->elt_size, target, compare_func);
+  if (index == _array->len ||
+      compare_func (_array->data + _array->elt_size * index, target) != 0)
+    return FALSE;
 
-          val = compare_func (_array->data + (_array->elt_size * middle), target);
-          if (val == 0)
-            {
-              result = TRUE;
-              break;
-            }
-          else if (val < 0)
-            left = middle + 1;
-          else if (/* val > 0 && */ middle > 0)
-            right = middle - 1;
-          else
-            break;  /* element not found */
-        }
+  if (out_match_index != NULL)
+    *out_match_index = index;
+
+  return TRUE;
+}
+
+#if defined (__GNUC__) || defined (__clang__)
+#define ARRAY_PREFETCH(addr) __builtin_prefetch (addr)
+#else
+#define ARRAY_PREFETCH(addr)
+#endif
+
+/* Same as array_lower_bound(), for integers. Both elements which may be
+ * compared at the next step are prefetched, as large arrays are memory
+ * bound. */
+#define DEFINE_INTEGER_LOWER_BOUND(type) \
+static gsize \
+array_lower_bound_##type (const type *data, \
+                          gsize       len, \
+                          type        target) \
+{ \
+  const type *base = data; \
+ \
+  while (len > 1) \
+    { \
+      gsize half = len / 2; \
+ \
+      ARRAY_PREFETCH (base + half / 2); \
+      ARRAY_PREFETCH (base + half + half / 2); \
+      base = (base[half] < target) ? base + half : base; \
+      len -= half; \
+    } \
+ \
+  return (base - data) + (*base < target); \
+}
+
+DEFINE_INTEGER_LOWER_BOUND (gint8)
+DEFINE_INTEGER_LOWER_BOUND (guint8)
+DEFINE_INTEGER_LOWER_BOUND (gint16)
+DEFINE_INTEGER_LOWER_BOUND (guint16)
+DEFINE_INTEGER_LOWER_BOUND (gint32)
+DEFINE_INTEGER_LOWER_BOUND (guint32)
+DEFINE_INTEGER_LOWER_BOUND (gint64)
+DEFINE_INTEGER_LOWER_BOUND (guint64)
+
+#undef DEFINE_INTEGER_LOWER_BOUND
+
+/**
+ * g_array_binary_search_integers:
+ * @array: a #GArray of integers
+ * @target: (not nullable): a pointer to the integer to look up
+ * @is_signed: whether the elements are signed
+ * @out_match_index: (optional) (out): return location
+ *    for the index of the element, if found.
+ *
+ * Checks whether @target exists in @array, whose elements are 8, 16, 32
+ * or 64-bit integers sorted into ascending numerical order, for example by
+ * g_array_sort_integers(). If the element is found, %TRUE is returned and
+ * the index of its first instance is returned in @out_match_index (if
+ * non-%NULL). Otherwise, %FALSE is returned and @out_match_index is
+ * undefined.
+ *
+ * This is much faster than g_array_binary_search() with a comparison
+ * function for the same ordering, as the comparisons are inlined.
+ *
+ * Returns: %TRUE if @target is one of the elements of @array, %FALSE otherwise.
+ *
+ * Since: 2.82
+ */
+gboolean
+g_array_binary_search_integers (GArray        *array,
+                                gconstpointer  target,
+                                gboolean       is_signed,
+                                guint         *out_match_index)
+{
+  GRealArray *_array = (GRealArray *) array;
+  gsize index;
+  gboolean found;
+
+  g_return_val_if_fail (_array != NULL, FALSE);
+  g_return_val_if_fail (target != NULL, FALSE);
+  g_return_val_if_fail (_array->elt_size == 1 || _array->elt_size == 2 ||
+                        _array->elt_size == 4 || _array->elt_size == 8, FALSE);
+
+  if (_array->len == 0)
+    return FALSE;
+
+#define LOWER_BOUND(type) \
+  G_STMT_START { \
+    type t; \
+    memcpy (&t, target, sizeof (t)); \
+    index = array_lower_bound_##type ((const type *) _array->data, _array->len, t); \
+    found = index < _array->len && ((const type *) _array->data)[index] == t; \
+  } G_STMT_END
+
+  switch (_array->elt_size)
+    {
+    case 1:
+      if (is_signed)
+        LOWER_BOUND (gint8);
+      else
+        LOWER_BOUND (guint8);
+      break;
+    case 2:
+      if (is_signed)
+        LOWER_BOUND (gint16);
+      else
+        LOWER_BOUND (guint16);
+      break;
+    case 4:
+      if (is_signed)
+        LOWER_BOUND (gint32);
+      else
+        LOWER_BOUND (guint32);
+      break;
+    default:
+      if (is_signed)
+        LOWER_BOUND (gint64);
+      else
+        LOWER_BOUND (guint64);
+      break;
     }
 
-  if (result && out_match_index != NULL)
-    *out_match_index = middle;
+#undef LOWER_BOUND
 
-  return result;
+  if (found && out_match_index != NULL)
+    *out_match_index = index;
+
+  return found;
 }
 
 static void
@@ -1071,7 +1331,15 @@ g_array_maybe_expand (GRealArray *array,
       g_assert (want_alloc >= g_array_elt_len (array, want_len));
       want_alloc = MAX (want_alloc, MIN_ARRAY_SIZE);
 
-      array->data = g_realloc (array->data, want_alloc);
+      if (G_UNLIKELY (array->in_arena))
+        array->data = g_mem_arena_realloc (((GRealArenaArray *) array)->arena, array->data,
+                                           g_array_elt_len (array, array->elt_capacity),
+                                           want_alloc);
+      else
+        {
+          array->data = g_realloc (array->data, want_alloc);
+          g_mem_advise_large (array->data, want_alloc);
+        }
 
       if (G_UNLIKELY (g_mem_gc_friendly))
         memset (g_array_elt_pos (array, array->elt_capacity), 0,
@@ -1098,9 +1366,17 @@ struct _GRealPtrArray
   guint           alloc;
   gatomicrefcount ref_count;
   guint8          null_terminated : 1; /* always either 0 or 1, so it can be added to array lengths */
+  guint8          in_arena : 1;
   GDestroyNotify  element_free_func;
 };
 
+/* See GRealArenaArray */
+typedef struct
+{
+  GRealPtrArray  array;
+  GMemArena     *arena;
+} GRealArenaPtrArray;
+
 /**
  * g_ptr_array_index:
  * @array: a #GPtrArray
@@ -1125,18 +1401,28 @@ ptr_array_maybe_null_terminate (GRealPtrArray *rarray)
 }
 
 static GPtrArray *
-ptr_array_new (guint reserved_size,
+ptr_array_new (GMemArena *arena,
+               guint reserved_size,
                GDestroyNotify element_free_func,
                gboolean null_terminated)
 {
   GRealPtrArray *array;
 
-  array = g_slice_new (GRealPtrArray);
+  if (arena != NULL)
+    {
+      GRealArenaPtrArray *arena_array = g_mem_arena_alloc (arena, sizeof (GRealArenaPtrArray));
+
+      arena_array->arena = arena;
+      array = &arena_array->array;
+    }
+  else
+    array = g_slice_new (GRealPtrArray);
 
   array->pdata = NULL;
   array->len = 0;
   array->alloc = 0;
   array->null_terminated = null_terminated ? 1 : 0;
+  array->in_arena = (arena != NULL);
   array->element_free_func = element_free_func;
 
   g_atomic_ref_count_init (&array->ref_count);
@@ -1172,7 +1458,7 @@ ptr_array_new (guint reserved_size,
 GPtrArray*
 g_ptr_array_new (void)
 {
-  return ptr_array_new (0, NULL, FALSE);
+  return ptr_array_new (NULL, 0, NULL, FALSE);
 }
 
 /**
@@ -1214,7 +1500,7 @@ g_ptr_array_new_take (gpointer       *data,
   g_return_val_if_fail (data != NULL || len == 0, NULL);
   g_return_val_if_fail (len <= G_MAXUINT, NULL);
 
-  array = ptr_array_new (0, element_free_func, FALSE);
+  array = ptr_array_new (NULL, 0, element_free_func, FALSE);
   rarray = (GRealPtrArray *)array;
 
   rarray->pdata = g_steal_pointer (&data);
@@ -1289,7 +1575,7 @@ ptr_array_new_from_array (gpointer       *data,
   g_assert (data != NULL || len == 0);
   g_assert (len <= G_MAXUINT);
 
-  array = ptr_array_new (len, element_free_func, null_terminated);
+  array = ptr_array_new (NULL, len, element_free_func, null_terminated);
   rarray = (GRealPtrArray *)array;
 
   if (copy_func != NULL)
@@ -1473,6 +1759,9 @@ g_ptr_array_steal (GPtrArray *array,
   rarray = (GRealPtrArray *) array;
   segment = (gpointer *) rarray->pdata;
 
+  if (rarray->in_arena && segment != NULL)
+    segment = g_memdup2 (segment, sizeof (gpointer) * (rarray->len + rarray->null_terminated));
+
   if (len != NULL)
     *len = rarray->len;
 
@@ -1517,7 +1806,7 @@ g_ptr_array_copy (GPtrArray *array,
 
   g_return_val_if_fail (array != NULL, NULL);
 
-  new_array = ptr_array_new (0,
+  new_array = ptr_array_new (NULL, 0,
                              rarray->element_free_func,
                              rarray->null_terminated);
 
@@ -1563,7 +1852,7 @@ g_ptr_array_copy (GPtrArray *array,
 GPtrArray*
 g_ptr_array_sized_new (guint reserved_size)
 {
-  return ptr_array_new (reserved_size, NULL, FALSE);
+  return ptr_array_new (NULL, reserved_size, NULL, FALSE);
 }
 
 /**
@@ -1614,7 +1903,7 @@ g_array_copy (GArray *array)
 GPtrArray*
 g_ptr_array_new_with_free_func (GDestroyNotify element_free_func)
 {
-  return ptr_array_new (0, element_free_func, FALSE);
+  return ptr_array_new (NULL, 0, element_free_func, FALSE);
 }
 
 /**
@@ -1639,7 +1928,7 @@ GPtrArray*
 g_ptr_array_new_full (guint          reserved_size,
                       GDestroyNotify element_free_func)
 {
-  return ptr_array_new (reserved_size, element_free_func, FALSE);
+  return ptr_array_new (NULL, reserved_size, element_free_func, FALSE);
 }
 
 /**
@@ -1677,7 +1966,40 @@ g_ptr_array_new_null_terminated (guint          reserved_size,
                                  GDestroyNotify element_free_func,
                                  gboolean       null_terminated)
 {
-  return ptr_array_new (reserved_size, element_free_func, null_terminated);
+  return ptr_array_new (NULL, reserved_size, element_free_func, null_terminated);
+}
+
+/**
+ * g_ptr_array_new_in_arena:
+ * @arena: (nullable): the #GMemArena to allocate the array in
+ * @reserved_size: number of pointers preallocated
+ * @element_free_func: (nullable): A function to free elements with
+ *     destroy @array or %NULL
+ *
+ * Creates a new #GPtrArray like g_ptr_array_new_full(), whose structure
+ * and pointer data are allocated from @arena.
+ *
+ * Growing such an array is cheap, as it takes memory from the arena
+ * rather than from the system allocator. The array must not be used
+ * once @arena has been reset or freed; its memory is only released
+ * then, even once its last reference is dropped. Dropping the last
+ * reference still calls @element_free_func on the elements. Functions
+ * which transfer the pointer data to the caller, such as
+ * g_ptr_array_free() with @free_segment set to %FALSE and
+ * g_ptr_array_steal(), return a g_malloc()-allocated copy.
+ *
+ * If @arena is %NULL this is equivalent to g_ptr_array_new_full().
+ *
+ * Returns: (transfer full): A new #GPtrArray
+ *
+ * Since: 2.82
+ */
+GPtrArray *
+g_ptr_array_new_in_arena (GMemArena      *arena,
+                          guint           reserved_size,
+                          GDestroyNotify  element_free_func)
+{
+  return ptr_array_new (arena, reserved_size, element_free_func, FALSE);
 }
 
 /**
@@ -1849,12 +2171,15 @@ ptr_array_free (GPtrArray      *array,
             rarray->element_free_func (stolen_pdata[i]);
         }
 
-      g_free (stolen_pdata);
+      if (!rarray->in_arena)
+        g_free (stolen_pdata);
       segment = NULL;
     }
   else
     {
       segment = rarray->pdata;
+      if (rarray->in_arena && segment != NULL)
+        segment = g_memdup2 (segment, sizeof (gpointer) * (rarray->len + rarray->null_terminated));
       if (!segment && rarray->null_terminated)
         segment = (gpointer *) g_new0 (char *, 1);
     }
@@ -1865,7 +2190,7 @@ ptr_array_free (GPtrArray      *array,
       rarray->len = 0;
       rarray->alloc = 0;
     }
-  else
+  else if (!rarray->in_arena)
     {
       g_slice_free1 (sizeof (GRealPtrArray), rarray);
     }
@@ -1895,7 +2220,11 @@ g_ptr_array_maybe_expand (GRealPtrArray *array,
       gsize want_alloc = g_nearest_pow (sizeof (gpointer) * (array->len + len));
       want_alloc = MAX (want_alloc, MIN_ARRAY_SIZE);
       array->alloc = MIN (want_alloc / sizeof (gpointer), G_MAXUINT);
-      array->pdata = g_realloc (array->pdata, want_alloc);
+      if (G_UNLIKELY (array->in_arena))
+        array->pdata = g_mem_arena_realloc (((GRealArenaPtrArray *) array)->arena, array->pdata,
+                                            sizeof (gpointer) * old_alloc, want_alloc);
+      else
+        array->pdata = g_realloc (array->pdata, want_alloc);
       if (G_UNLIKELY (g_mem_gc_friendly))
         for ( ; old_alloc < array->alloc; old_alloc++)
           array->pdata [old_alloc] = NULL;
@@ -1952,6 +2281,64 @@ g_ptr_array_set_size  (GPtrArray *array,
     g_ptr_array_remove_range (array, length_unsigned, rarray->len - length_unsigned);
 }
 
+#ifdef PTR_ARRAY_FIND_SSE2
+/* Lanes of the vector at @p which are equal to @needle, all set if they are.
+ * A 64-bit pointer matches if both of its 32-bit halves do. */
+static inline __m128i
+ptr_array_match (gpointer const *p,
+                 __m128i         needle)
+{
+  __m128i eq = _mm_cmpeq_epi32 (_mm_loadu_si128 ((const __m128i *) p), needle);
+
+#if GLIB_SIZEOF_VOID_P == 8
+  eq = _mm_and_si128 (eq, _mm_shuffle_epi32 (eq, _MM_SHUFFLE (2, 3, 0, 1)));
+#endif
+
+  return eq;
+}
+#endif
+
+/* Index of the first occurrence of @needle in @pdata, or @len if there is
+ * none. Blocks of 64 bytes are compared at once with SSE2 where available,
+ * and the first match found in one of them with plain comparisons. */
+static guint
+ptr_array_find_pointer (gpointer const *pdata,
+                        guint           len,
+                        gconstpointer   needle)
+{
+  guint i = 0;
+
+#ifdef PTR_ARRAY_FIND_SSE2
+  {
+    const guint per_vector = sizeof (__m128i) / sizeof (gpointer);
+#if GLIB_SIZEOF_VOID_P == 8
+    __m128i n = _mm_set1_epi64x ((gint64) (guintptr) needle);
+#else
+    __m128i n = _mm_set1_epi32 ((gint32) (guintptr) needle);
+#endif
+
+    for (; i + 4 * per_vector <= len; i += 4 * per_vector)
+      {
+        __m128i eq = _mm_or_si128 (_mm_or_si128 (ptr_array_match (pdata + i, n),
+                                                 ptr_array_match (pdata + i + per_vector, n)),
+                                   _mm_or_si128 (ptr_array_match (pdata + i + 2 * per_vector, n),
+                                                 ptr_array_match (pdata + i + 3 * per_vector, n)));
+
+        if (_mm_movemask_epi8 (eq) != 0)
+          break;
+      }
+  }
+#endif
+
+  for (; i < len; i++)
+    {
+      if (pdata[i] == needle)
+        break;
+    }
+
+  return i;
+}
+
 static gpointer
 ptr_array_remove_index (GPtrArray *array,
                         guint      index_,
@@ -2151,16 +2538,12 @@ g_ptr_array_remove (GPtrArray *array,
   g_return_val_if_fail (array, FALSE);
   g_return_val_if_fail (array->len == 0 || (array->len != 0 && array->pdata != NULL), FALSE);
 
-  for (i = 0; i < array->len; i += 1)
-    {
-      if (array->pdata[i] == data)
-        {
-          g_ptr_array_remove_index (array, i);
-          return TRUE;
-        }
-    }
+  i = ptr_array_find_pointer (array->pdata, array->len, data);
+  if (i == array->len)
+    return FALSE;
 
-  return FALSE;
+  g_ptr_array_remove_index (array, i);
+  return TRUE;
 }
 
 /**
@@ -2189,16 +2572,100 @@ g_ptr_array_remove_fast (GPtrArray *array,
   g_return_val_if_fail (rarray, FALSE);
   g_return_val_if_fail (rarray->len == 0 || (rarray->len != 0 && rarray->pdata != NULL), FALSE);
 
-  for (i = 0; i < rarray->len; i += 1)
+  i = ptr_array_find_pointer (rarray->pdata, rarray->len, data);
+  if (i == rarray->len)
+    return FALSE;
+
+  g_ptr_array_remove_index_fast (array, i);
+  return TRUE;
+}
+
+/* Up to this many pointers, g_ptr_array_remove_fast_many() looks for each
+ * of them in turn rather than building a table of them */
+#define REMOVE_MANY_MIN_TABLE 8
+
+/**
+ * g_ptr_array_remove_fast_many:
+ * @array: a #GPtrArray
+ * @data: (array length=n_data): the pointers to remove
+ * @n_data: the number of pointers in @data
+ *
+ * Removes the first occurrence of each of the pointers in @data from the
+ * pointer array, like calling g_ptr_array_remove_fast() for each of them,
+ * but in a single pass over @array when there are more than a few. A
+ * pointer which is in @data several times is removed as many times. This
+ * function does not preserve the order of the array. If @array has a
+ * non-%NULL #GDestroyNotify function it is called for the removed
+ * elements.
+ *
+ * Returns: the number of pointers removed
+ *
+ * Since: 2.82
+ */
+guint
+g_ptr_array_remove_fast_many (GPtrArray *array,
+                              gpointer  *data,
+                              guint      n_data)
+{
+  GRealPtrArray *rarray = (GRealPtrArray *) array;
+  GHashTable *pending;
+  guint old_len, i, j;
+
+  g_return_val_if_fail (rarray, 0);
+  g_return_val_if_fail (rarray->len == 0 || (rarray->len != 0 && rarray->pdata != NULL), 0);
+  g_return_val_if_fail (data != NULL || n_data == 0, 0);
+
+  if (n_data <= REMOVE_MANY_MIN_TABLE)
     {
-      if (rarray->pdata[i] == data)
+      guint n_removed = 0;
+
+      for (i = 0; i < n_data; i++)
+        n_removed += g_ptr_array_remove_fast (array, data[i]);
+
+      return n_removed;
+    }
+
+  /* Number of occurrences left to remove, by pointer */
+  pending = g_hash_table_new (NULL, NULL);
+  for (i = 0; i < n_data; i++)
+    {
+      guint count = GPOINTER_TO_UINT (g_hash_table_lookup (pending, data[i]));
+      g_hash_table_insert (pending, data[i], GUINT_TO_POINTER (count + 1));
+    }
+
+  old_len = rarray->len;
+  for (i = 0, j = 0; i < old_len; i++)
+    {
+      gpointer element = rarray->pdata[i];
+      guint count = GPOINTER_TO_UINT (g_hash_table_lookup (pending, element));
+
+      if (count == 0)
         {
-          g_ptr_array_remove_index_fast (array, i);
-          return TRUE;
+          rarray->pdata[j++] = element;
+          continue;
         }
+
+      if (count == 1)
+        g_hash_table_remove (pending, element);
+      else
+        g_hash_table_insert (pending, element, GUINT_TO_POINTER (count - 1));
+
+      if (rarray->element_free_func != NULL)
+        rarray->element_free_func (element);
     }
 
-  return FALSE;
+  g_hash_table_unref (pending);
+
+  rarray->len = j;
+  if (G_UNLIKELY (g_mem_gc_friendly))
+    {
+      for (; j < old_len; j++)
+        rarray->pdata[j] = NULL;
+    }
+  else
+    ptr_array_maybe_null_terminate (rarray);
+
+  return old_len - rarray->len;
 }
 
 /**
@@ -2317,6 +2784,8 @@ g_ptr_array_extend_and_steal (GPtrArray  *array_to_extend,
   pdata = g_steal_pointer (&array->pdata);
   array->len = 0;
   ((GRealPtrArray *) array)->alloc = 0;
+  if (((GRealPtrArray *) array)->in_arena)
+    pdata = NULL;
   g_ptr_array_unref (array);
   g_free (pdata);
 }
@@ -2500,6 +2969,37 @@ g_ptr_array_sort_with_data (GPtrArray        *array,
                        user_data);
 }
 
+/**
+ * g_ptr_array_sort_parallel:
+ * @array: a #GPtrArray
+ * @compare_func: (scope call): comparison function, which must be safe to
+ *   call from several threads at once
+ * @user_data: data to pass to @compare_func
+ *
+ * Like g_ptr_array_sort_with_data(), but large arrays are sorted using
+ * several threads from the shared #GThreadPool threads. As with
+ * g_ptr_array_sort_with_data(), @compare_func is passed pointers to the
+ * pointers in the array.
+ *
+ * This is a stable sort.
+ *
+ * Since: 2.82
+ */
+void
+g_ptr_array_sort_parallel (GPtrArray        *array,
+                           GCompareDataFunc  compare_func,
+                           gpointer          user_data)
+{
+  g_return_if_fail (array != NULL);
+
+  if (array->len > 0)
+    g_qsort_with_data_parallel (array->pdata,
+                                array->len,
+                                sizeof (gpointer),
+                                compare_func,
+                                user_data);
+}
+
 static inline gint
 compare_ptr_array_values (gconstpointer a, gconstpointer b, gpointer user_data)
 {
@@ -2657,8 +3157,16 @@ g_ptr_array_find_with_equal_func (GPtrArray     *haystack,
 
   g_return_val_if_fail (haystack != NULL, FALSE);
 
-  if (equal_func == NULL)
-    equal_func = g_direct_equal;
+  if (equal_func == NULL || equal_func == g_direct_equal)
+    {
+      i = ptr_array_find_pointer (haystack->pdata, haystack->len, needle);
+      if (i == haystack->len)
+        return FALSE;
+
+      if (index_ != NULL)
+        *index_ = i;
+      return TRUE;
+    }
 
   for (i = 0; i < haystack->len; i++)
     {
@@ -2915,6 +3423,29 @@ g_byte_array_set_size (GByteArray *array,
   return array;
 }
 
+/**
+ * g_byte_array_reserve:
+ * @array: a #GByteArray
+ * @len: the number of bytes to make room for
+ *
+ * Makes sure that @array has room for at least @len bytes without having to
+ * be reallocated. The length of @array is not changed.
+ *
+ * Use this before appending a large amount of data whose size is known in
+ * advance, to avoid repeatedly growing (and copying) the buffer.
+ *
+ * Since: 2.82
+ */
+void
+g_byte_array_reserve (GByteArray *array,
+                      guint       len)
+{
+  g_return_if_fail (array != NULL);
+
+  if (len > array->len)
+    g_array_maybe_expand ((GRealArray *) array, len - array->len);
+}
+
 /**
  * g_byte_array_remove_index:
  * @array: a #GByteArray
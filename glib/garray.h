@@ -32,6 +32,7 @@
 #endif
 
 #include <glib/gtypes.h>
+#include <glib/gmemarena.h>
 
 G_BEGIN_DECLS
 
@@ -89,6 +90,12 @@ GArray* g_array_sized_new         (gboolean          zero_terminated,
 				   gboolean          clear_,
 				   guint             element_size,
 				   guint             reserved_size);
+GLIB_AVAILABLE_IN_2_82
+GArray* g_array_new_in_arena      (GMemArena        *arena,
+                                   gboolean          zero_terminated,
+                                   gboolean          clear_,
+                                   guint             element_size,
+                                   guint             reserved_size);
 GLIB_AVAILABLE_IN_2_62
 GArray* g_array_copy              (GArray           *array);
 GLIB_AVAILABLE_IN_ALL
@@ -133,11 +140,23 @@ GLIB_AVAILABLE_IN_ALL
 void    g_array_sort_with_data    (GArray           *array,
 				   GCompareDataFunc  compare_func,
 				   gpointer          user_data);
+GLIB_AVAILABLE_IN_2_82
+void    g_array_sort_parallel     (GArray           *array,
+				   GCompareDataFunc  compare_func,
+				   gpointer          user_data);
+GLIB_AVAILABLE_IN_2_82
+void    g_array_sort_integers     (GArray           *array,
+				   gboolean          is_signed);
 GLIB_AVAILABLE_IN_2_62
 gboolean g_array_binary_search    (GArray           *array,
                                    gconstpointer     target,
                                    GCompareFunc      compare_func,
                                    guint            *out_match_index);
+GLIB_AVAILABLE_IN_2_82
+gboolean g_array_binary_search_integers (GArray        *array,
+                                         gconstpointer  target,
+                                         gboolean       is_signed,
+                                         guint         *out_match_index);
 GLIB_AVAILABLE_IN_ALL
 void    g_array_set_clear_func    (GArray           *array,
                                    GDestroyNotify    clear_func);
@@ -177,6 +196,10 @@ GLIB_AVAILABLE_IN_2_74
 GPtrArray* g_ptr_array_new_null_terminated (guint          reserved_size,
                                             GDestroyNotify element_free_func,
                                             gboolean       null_terminated);
+GLIB_AVAILABLE_IN_2_82
+GPtrArray* g_ptr_array_new_in_arena       (GMemArena        *arena,
+                                           guint             reserved_size,
+                                           GDestroyNotify    element_free_func);
 GLIB_AVAILABLE_IN_2_76
 GPtrArray* g_ptr_array_new_take_null_terminated  (gpointer       *data,
                                                   GDestroyNotify  element_free_func);
@@ -216,6 +239,10 @@ gboolean   g_ptr_array_remove             (GPtrArray        *array,
 GLIB_AVAILABLE_IN_ALL
 gboolean   g_ptr_array_remove_fast        (GPtrArray        *array,
 					   gpointer          data);
+GLIB_AVAILABLE_IN_2_82
+guint      g_ptr_array_remove_fast_many   (GPtrArray        *array,
+					   gpointer         *data,
+					   guint             n_data);
 GLIB_AVAILABLE_IN_ALL
 GPtrArray *g_ptr_array_remove_range       (GPtrArray        *array,
 					   guint             index_,
@@ -242,6 +269,10 @@ GLIB_AVAILABLE_IN_ALL
 void       g_ptr_array_sort_with_data     (GPtrArray        *array,
 					   GCompareDataFunc  compare_func,
 					   gpointer          user_data);
+GLIB_AVAILABLE_IN_2_82
+void       g_ptr_array_sort_parallel      (GPtrArray        *array,
+                                           GCompareDataFunc  compare_func,
+                                           gpointer          user_data);
 GLIB_AVAILABLE_IN_2_76
 void       g_ptr_array_sort_values        (GPtrArray        *array,
                                            GCompareFunc      compare_func);
@@ -300,6 +331,9 @@ GByteArray* g_byte_array_prepend           (GByteArray       *array,
 GLIB_AVAILABLE_IN_ALL
 GByteArray* g_byte_array_set_size          (GByteArray       *array,
 					    guint             length);
+GLIB_AVAILABLE_IN_2_82
+void        g_byte_array_reserve           (GByteArray       *array,
+					    guint             len);
 GLIB_AVAILABLE_IN_ALL
 GByteArray* g_byte_array_remove_index      (GByteArray       *array,
 					    guint             index_);
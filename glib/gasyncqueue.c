@@ -44,6 +44,29 @@
  *
  * It should only be accessed through the `g_async_queue_*` functions.
  */
+/* Bounded queues keep their items in a ring of cells, each with a sequence
+ * number telling at which position it can next be pushed to or popped from
+ * (Dmitry Vyukov’s bounded MPMC queue). Pushing and popping don’t take the
+ * mutex unless a thread has to wait, or one has to be woken up. */
+typedef struct
+{
+  gsize sequence;  /* (atomic) */
+  gpointer data;
+} GAsyncQueueCell;
+
+typedef struct
+{
+  gsize head;  /* (atomic) position of the next pop */
+  gchar head_padding[64 - sizeof (gsize)];
+  gsize tail;  /* (atomic) position of the next push */
+  gchar tail_padding[64 - sizeof (gsize)];
+  gint waiting_pop;   /* (atomic) */
+  gint waiting_push;  /* (atomic) */
+  GCond not_full;
+  gsize mask;
+  GAsyncQueueCell *cells;
+} GAsyncQueueRing;
+
 struct _GAsyncQueue
 {
   GMutex mutex;
@@ -52,6 +75,7 @@ struct _GAsyncQueue
   GDestroyNotify item_free_func;
   guint waiting_threads;
   gint ref_count;
+  GAsyncQueueRing *ring;  /* (nullable) for bounded queues */
 };
 
 typedef struct
@@ -97,10 +121,252 @@ g_async_queue_new_full (GDestroyNotify item_free_func)
   queue->waiting_threads = 0;
   queue->ref_count = 1;
   queue->item_free_func = item_free_func;
+  queue->ring = NULL;
 
   return queue;
 }
 
+/**
+ * g_async_queue_new_bounded: (constructor)
+ * @capacity: the minimum number of items the queue can hold
+ * @item_free_func: (nullable): function to free queue elements
+ *
+ * Creates a new asynchronous queue which holds a fixed number of items,
+ * like g_async_queue_new_full() does otherwise.
+ *
+ * @capacity is rounded up to a power of two. Once that many items are in
+ * the queue, g_async_queue_push() blocks until another thread pops one,
+ * and g_async_queue_try_push() fails.
+ *
+ * The items are kept in a preallocated ring, which is pushed to and popped
+ * from without locking, so many threads can use the queue concurrently.
+ * Threads only sleep when the queue is empty (or full, when pushing).
+ * g_async_queue_push_many() and g_async_queue_pop_many() can be used to
+ * further reduce the overhead of waking those threads up.
+ *
+ * The queue keeps the items in the order they were pushed, so
+ * g_async_queue_push_sorted(), g_async_queue_sort(),
+ * g_async_queue_remove() and g_async_queue_push_front() can’t be used with
+ * it. The other functions, including the `_unlocked()` ones, can; they are
+ * ordered with respect to each other by the queue’s lock as usual.
+ *
+ * Returns: (transfer full): a new #GAsyncQueue. Free with g_async_queue_unref()
+ *
+ * Since: 2.82
+ */
+GAsyncQueue *
+g_async_queue_new_bounded (guint          capacity,
+                           GDestroyNotify item_free_func)
+{
+  GAsyncQueue *queue;
+  GAsyncQueueRing *ring;
+  gsize size, i;
+
+  g_return_val_if_fail (capacity > 0 && capacity <= (1U << 30), NULL);
+
+  /* A ring of one cell can’t tell full from empty */
+  for (size = 2; size < capacity; size *= 2)
+    ;
+
+  ring = g_aligned_alloc0 (1, sizeof (GAsyncQueueRing), 64);
+  ring->mask = size - 1;
+  ring->cells = g_new (GAsyncQueueCell, size);
+  for (i = 0; i < size; i++)
+    ring->cells[i].sequence = i;
+  g_cond_init (&ring->not_full);
+
+  queue = g_async_queue_new_full (item_free_func);
+  queue->ring = ring;
+
+  return queue;
+}
+
+static gboolean
+g_async_queue_ring_try_push (GAsyncQueueRing *ring,
+                             gpointer         data)
+{
+  GAsyncQueueCell *cell;
+  gsize pos = g_atomic_pointer_get (&ring->tail);
+
+  while (TRUE)
+    {
+      gssize diff;
+
+      cell = &ring->cells[pos & ring->mask];
+      diff = (gssize) (g_atomic_pointer_get (&cell->sequence) - pos);
+
+      if (diff == 0)
+        {
+          /* The cell is free; claim it */
+          if (g_atomic_pointer_compare_and_exchange_full (&ring->tail, pos, pos + 1, &pos))
+            break;
+        }
+      else if (diff < 0)
+        return FALSE;  /* full */
+      else
+        pos = g_atomic_pointer_get (&ring->tail);
+    }
+
+  cell->data = data;
+  g_atomic_pointer_set (&cell->sequence, pos + 1);
+
+  return TRUE;
+}
+
+static gpointer
+g_async_queue_ring_try_pop (GAsyncQueueRing *ring)
+{
+  GAsyncQueueCell *cell;
+  gpointer data;
+  gsize pos = g_atomic_pointer_get (&ring->head);
+
+  while (TRUE)
+    {
+      gssize diff;
+
+      cell = &ring->cells[pos & ring->mask];
+      diff = (gssize) (g_atomic_pointer_get (&cell->sequence) - (pos + 1));
+
+      if (diff == 0)
+        {
+          /* The cell has been pushed to; claim it */
+          if (g_atomic_pointer_compare_and_exchange_full (&ring->head, pos, pos + 1, &pos))
+            break;
+        }
+      else if (diff < 0)
+        return NULL;  /* empty */
+      else
+        pos = g_atomic_pointer_get (&ring->head);
+    }
+
+  data = cell->data;
+  g_atomic_pointer_set (&cell->sequence, pos + ring->mask + 1);
+
+  return data;
+}
+
+/* Wakes up threads waiting on @cond, if @waiting says that there are any.
+ * This pairs with waiters incrementing @waiting before checking the ring
+ * again, so either they see the change, or we see them. */
+static void
+g_async_queue_ring_wake (GAsyncQueue *queue,
+                         gint        *waiting,
+                         GCond       *cond,
+                         gboolean     locked,
+                         gboolean     all)
+{
+  if (g_atomic_int_get (waiting) == 0)
+    return;
+
+  if (!locked)
+    g_mutex_lock (&queue->mutex);
+
+  if (all)
+    g_cond_broadcast (cond);
+  else
+    g_cond_signal (cond);
+
+  if (!locked)
+    g_mutex_unlock (&queue->mutex);
+}
+
+/* Pushes @data, waiting while the ring is full; doesn’t wake poppers */
+static void
+g_async_queue_ring_push_wait (GAsyncQueue *queue,
+                              gpointer     data,
+                              gboolean     locked)
+{
+  GAsyncQueueRing *ring = queue->ring;
+
+  if (g_async_queue_ring_try_push (ring, data))
+    return;
+
+  if (!locked)
+    g_mutex_lock (&queue->mutex);
+
+  g_atomic_int_inc (&ring->waiting_push);
+  while (!g_async_queue_ring_try_push (ring, data))
+    g_cond_wait (&ring->not_full, &queue->mutex);
+  g_atomic_int_add (&ring->waiting_push, -1);
+
+  if (!locked)
+    g_mutex_unlock (&queue->mutex);
+}
+
+/* Pops an item, waiting until @end_time if @wait; doesn’t wake pushers */
+static gpointer
+g_async_queue_ring_pop_wait (GAsyncQueue *queue,
+                             gboolean     locked,
+                             gboolean     wait,
+                             gint64       end_time)
+{
+  GAsyncQueueRing *ring = queue->ring;
+  gpointer retval;
+
+  retval = g_async_queue_ring_try_pop (ring);
+  if (retval != NULL || !wait)
+    return retval;
+
+  if (!locked)
+    g_mutex_lock (&queue->mutex);
+
+  g_atomic_int_inc (&ring->waiting_pop);
+  while ((retval = g_async_queue_ring_try_pop (ring)) == NULL)
+    {
+      if (end_time == -1)
+        g_cond_wait (&queue->cond, &queue->mutex);
+      else if (!g_cond_wait_until (&queue->cond, &queue->mutex, end_time))
+        {
+          retval = g_async_queue_ring_try_pop (ring);
+          break;
+        }
+    }
+  g_atomic_int_add (&ring->waiting_pop, -1);
+
+  if (!locked)
+    g_mutex_unlock (&queue->mutex);
+
+  return retval;
+}
+
+static void
+g_async_queue_ring_push (GAsyncQueue *queue,
+                         gpointer     data,
+                         gboolean     locked)
+{
+  g_async_queue_ring_push_wait (queue, data, locked);
+  g_async_queue_ring_wake (queue, &queue->ring->waiting_pop, &queue->cond, locked, FALSE);
+}
+
+static gpointer
+g_async_queue_ring_pop (GAsyncQueue *queue,
+                        gboolean     locked,
+                        gboolean     wait,
+                        gint64       end_time)
+{
+  gpointer retval = g_async_queue_ring_pop_wait (queue, locked, wait, end_time);
+
+  if (retval != NULL)
+    g_async_queue_ring_wake (queue, &queue->ring->waiting_push, &queue->ring->not_full, locked, FALSE);
+
+  return retval;
+}
+
+static void
+g_async_queue_ring_free (GAsyncQueue *queue)
+{
+  GAsyncQueueRing *ring = queue->ring;
+  gpointer data;
+
+  while ((data = g_async_queue_ring_try_pop (ring)) != NULL)
+    if (queue->item_free_func)
+      queue->item_free_func (data);
+
+  g_cond_clear (&ring->not_full);
+  g_free (ring->cells);
+  g_aligned_free (ring);
+}
+
 /**
  * g_async_queue_ref:
  * @queue: a #GAsyncQueue
@@ -179,6 +445,8 @@ g_async_queue_unref (GAsyncQueue *queue)
   if (g_atomic_int_dec_and_test (&queue->ref_count))
     {
       g_return_if_fail (queue->waiting_threads == 0);
+      if (queue->ring)
+        g_async_queue_ring_free (queue);
       g_mutex_clear (&queue->mutex);
       g_cond_clear (&queue->cond);
       if (queue->item_free_func)
@@ -236,6 +504,9 @@ g_async_queue_unlock (GAsyncQueue *queue)
  * Pushes the @data into the @queue.
  *
  * The @data parameter must not be %NULL.
+ *
+ * If @queue is a bounded queue which is full, this blocks until there is
+ * room for @data.
  */
 void
 g_async_queue_push (GAsyncQueue *queue,
@@ -244,6 +515,12 @@ g_async_queue_push (GAsyncQueue *queue,
   g_return_if_fail (queue);
   g_return_if_fail (data);
 
+  if (queue->ring)
+    {
+      g_async_queue_ring_push (queue, data, FALSE);
+      return;
+    }
+
   g_mutex_lock (&queue->mutex);
   g_async_queue_push_unlocked (queue, data);
   g_mutex_unlock (&queue->mutex);
@@ -267,6 +544,12 @@ g_async_queue_push_unlocked (GAsyncQueue *queue,
   g_return_if_fail (queue);
   g_return_if_fail (data);
 
+  if (queue->ring)
+    {
+      g_async_queue_ring_push (queue, data, TRUE);
+      return;
+    }
+
   g_queue_push_head (&queue->queue, data);
   if (queue->waiting_threads > 0)
     g_cond_signal (&queue->cond);
@@ -299,6 +582,7 @@ g_async_queue_push_sorted (GAsyncQueue      *queue,
                            gpointer          user_data)
 {
   g_return_if_fail (queue != NULL);
+  g_return_if_fail (queue->ring == NULL);
 
   g_mutex_lock (&queue->mutex);
   g_async_queue_push_sorted_unlocked (queue, data, func, user_data);
@@ -347,6 +631,7 @@ g_async_queue_push_sorted_unlocked (GAsyncQueue      *queue,
   SortData sd;
 
   g_return_if_fail (queue != NULL);
+  g_return_if_fail (queue->ring == NULL);
 
   sd.func = func;
   sd.user_data = user_data;
@@ -366,6 +651,9 @@ g_async_queue_pop_intern_unlocked (GAsyncQueue *queue,
 {
   gpointer retval;
 
+  if (queue->ring)
+    return g_async_queue_ring_pop (queue, TRUE, wait, end_time);
+
   if (!g_queue_peek_tail_link (&queue->queue) && wait)
     {
       queue->waiting_threads++;
@@ -405,6 +693,9 @@ g_async_queue_pop (GAsyncQueue *queue)
 
   g_return_val_if_fail (queue, NULL);
 
+  if (queue->ring)
+    return g_async_queue_ring_pop (queue, FALSE, TRUE, -1);
+
   g_mutex_lock (&queue->mutex);
   retval = g_async_queue_pop_intern_unlocked (queue, TRUE, -1);
   g_mutex_unlock (&queue->mutex);
@@ -448,6 +739,9 @@ g_async_queue_try_pop (GAsyncQueue *queue)
 
   g_return_val_if_fail (queue, NULL);
 
+  if (queue->ring)
+    return g_async_queue_ring_pop (queue, FALSE, FALSE, -1);
+
   g_mutex_lock (&queue->mutex);
   retval = g_async_queue_pop_intern_unlocked (queue, FALSE, -1);
   g_mutex_unlock (&queue->mutex);
@@ -497,6 +791,9 @@ g_async_queue_timeout_pop (GAsyncQueue *queue,
 
   g_return_val_if_fail (queue != NULL, NULL);
 
+  if (queue->ring)
+    return g_async_queue_ring_pop (queue, FALSE, TRUE, end_time);
+
   g_mutex_lock (&queue->mutex);
   retval = g_async_queue_pop_intern_unlocked (queue, TRUE, end_time);
   g_mutex_unlock (&queue->mutex);
@@ -637,6 +934,9 @@ g_async_queue_length (GAsyncQueue *queue)
 
   g_return_val_if_fail (queue, 0);
 
+  if (queue->ring)
+    return g_async_queue_length_unlocked (queue);
+
   g_mutex_lock (&queue->mutex);
   retval = queue->queue.length - queue->waiting_threads;
   g_mutex_unlock (&queue->mutex);
@@ -666,6 +966,16 @@ g_async_queue_length_unlocked (GAsyncQueue *queue)
 {
   g_return_val_if_fail (queue, 0);
 
+  if (queue->ring)
+    {
+      gsize head = g_atomic_pointer_get (&queue->ring->head);
+      gsize tail = g_atomic_pointer_get (&queue->ring->tail);
+
+      /* The two positions are read separately, so may be slightly apart */
+      return (gint) MAX ((gssize) (tail - head), 0) -
+             g_atomic_int_get (&queue->ring->waiting_pop);
+    }
+
   return queue->queue.length - queue->waiting_threads;
 }
 
@@ -706,6 +1016,7 @@ g_async_queue_sort (GAsyncQueue      *queue,
                     gpointer          user_data)
 {
   g_return_if_fail (queue != NULL);
+  g_return_if_fail (queue->ring == NULL);
   g_return_if_fail (func != NULL);
 
   g_mutex_lock (&queue->mutex);
@@ -739,6 +1050,7 @@ g_async_queue_sort_unlocked (GAsyncQueue      *queue,
   SortData sd;
 
   g_return_if_fail (queue != NULL);
+  g_return_if_fail (queue->ring == NULL);
   g_return_if_fail (func != NULL);
 
   sd.func = func;
@@ -767,6 +1079,7 @@ g_async_queue_remove (GAsyncQueue *queue,
   gboolean ret;
 
   g_return_val_if_fail (queue != NULL, FALSE);
+  g_return_val_if_fail (queue->ring == NULL, FALSE);
   g_return_val_if_fail (item != NULL, FALSE);
 
   g_mutex_lock (&queue->mutex);
@@ -794,6 +1107,7 @@ g_async_queue_remove_unlocked (GAsyncQueue *queue,
                                gpointer     item)
 {
   g_return_val_if_fail (queue != NULL, FALSE);
+  g_return_val_if_fail (queue->ring == NULL, FALSE);
   g_return_val_if_fail (item != NULL, FALSE);
 
   return g_queue_remove (&queue->queue, item);
@@ -816,6 +1130,7 @@ g_async_queue_push_front (GAsyncQueue *queue,
                           gpointer     item)
 {
   g_return_if_fail (queue != NULL);
+  g_return_if_fail (queue->ring == NULL);
   g_return_if_fail (item != NULL);
 
   g_mutex_lock (&queue->mutex);
@@ -842,6 +1157,7 @@ g_async_queue_push_front_unlocked (GAsyncQueue *queue,
                                    gpointer     item)
 {
   g_return_if_fail (queue != NULL);
+  g_return_if_fail (queue->ring == NULL);
   g_return_if_fail (item != NULL);
 
   g_queue_push_tail (&queue->queue, item);
@@ -849,6 +1165,206 @@ g_async_queue_push_front_unlocked (GAsyncQueue *queue,
     g_cond_signal (&queue->cond);
 }
 
+/**
+ * g_async_queue_try_push:
+ * @queue: a #GAsyncQueue
+ * @data: (not nullable): data to push onto the @queue
+ *
+ * Pushes the @data into the @queue, unless it is a bounded queue which is
+ * full, in which case this returns %FALSE without blocking.
+ *
+ * The @data parameter must not be %NULL.
+ *
+ * Returns: %TRUE if @data was pushed, %FALSE if @queue was full
+ *
+ * Since: 2.82
+ */
+gboolean
+g_async_queue_try_push (GAsyncQueue *queue,
+                        gpointer     data)
+{
+  g_return_val_if_fail (queue, FALSE);
+  g_return_val_if_fail (data, FALSE);
+
+  if (queue->ring)
+    {
+      if (!g_async_queue_ring_try_push (queue->ring, data))
+        return FALSE;
+
+      g_async_queue_ring_wake (queue, &queue->ring->waiting_pop, &queue->cond, FALSE, FALSE);
+      return TRUE;
+    }
+
+  g_async_queue_push (queue, data);
+
+  return TRUE;
+}
+
+/**
+ * g_async_queue_push_many:
+ * @queue: a #GAsyncQueue
+ * @items: (array length=n_items): data to push onto the @queue, none of
+ *   which may be %NULL
+ * @n_items: the number of items
+ *
+ * Pushes the @items into the @queue in order, as if by calling
+ * g_async_queue_push() for each of them, but waking up waiting threads
+ * only once.
+ *
+ * If @queue is a bounded queue, this blocks whenever it is full, until all
+ * the @items are pushed. Other threads may push items in between them.
+ *
+ * Since: 2.82
+ */
+void
+g_async_queue_push_many (GAsyncQueue *queue,
+                         gpointer    *items,
+                         guint        n_items)
+{
+  guint i;
+
+  g_return_if_fail (queue);
+  g_return_if_fail (items != NULL || n_items == 0);
+
+  for (i = 0; i < n_items; i++)
+    g_return_if_fail (items[i] != NULL);
+
+  if (queue->ring)
+    {
+      for (i = 0; i < n_items; i++)
+        {
+          if (g_async_queue_ring_try_push (queue->ring, items[i]))
+            continue;
+
+          /* Let the consumers make room */
+          g_async_queue_ring_wake (queue, &queue->ring->waiting_pop, &queue->cond, FALSE, TRUE);
+          g_async_queue_ring_push_wait (queue, items[i], FALSE);
+        }
+
+      g_async_queue_ring_wake (queue, &queue->ring->waiting_pop, &queue->cond, FALSE, n_items > 1);
+      return;
+    }
+
+  g_mutex_lock (&queue->mutex);
+
+  for (i = 0; i < n_items; i++)
+    g_queue_push_head (&queue->queue, items[i]);
+
+  if (queue->waiting_threads > 0 && n_items > 0)
+    {
+      if (n_items > 1)
+        g_cond_broadcast (&queue->cond);
+      else
+        g_cond_signal (&queue->cond);
+    }
+
+  g_mutex_unlock (&queue->mutex);
+}
+
+static guint
+g_async_queue_pop_many_intern (GAsyncQueue *queue,
+                               gpointer    *items,
+                               guint        max_items,
+                               gint64       end_time)
+{
+  guint n_items = 0;
+
+  if (max_items == 0)
+    return 0;
+
+  if (queue->ring)
+    {
+      items[0] = g_async_queue_ring_pop_wait (queue, FALSE, TRUE, end_time);
+      if (items[0] == NULL)
+        return 0;
+
+      for (n_items = 1; n_items < max_items; n_items++)
+        {
+          items[n_items] = g_async_queue_ring_try_pop (queue->ring);
+          if (items[n_items] == NULL)
+            break;
+        }
+
+      g_async_queue_ring_wake (queue, &queue->ring->waiting_push, &queue->ring->not_full,
+                               FALSE, n_items > 1);
+      return n_items;
+    }
+
+  g_mutex_lock (&queue->mutex);
+
+  items[0] = g_async_queue_pop_intern_unlocked (queue, TRUE, end_time);
+  if (items[0] != NULL)
+    {
+      for (n_items = 1; n_items < max_items; n_items++)
+        {
+          items[n_items] = g_queue_pop_tail (&queue->queue);
+          if (items[n_items] == NULL)
+            break;
+        }
+    }
+
+  g_mutex_unlock (&queue->mutex);
+
+  return n_items;
+}
+
+/**
+ * g_async_queue_pop_many:
+ * @queue: a #GAsyncQueue
+ * @items: (out caller-allocates) (array length=max_items): return location
+ *   for the data
+ * @max_items: the maximum number of items to pop
+ *
+ * Pops up to @max_items items from the @queue into @items, in order. If
+ * @queue is empty, this function blocks until data becomes available, and
+ * then pops as many items as are available, without waiting for more.
+ *
+ * Returns: the number of items popped, which is 0 only if @max_items is 0
+ *
+ * Since: 2.82
+ */
+guint
+g_async_queue_pop_many (GAsyncQueue *queue,
+                        gpointer    *items,
+                        guint        max_items)
+{
+  g_return_val_if_fail (queue, 0);
+  g_return_val_if_fail (items != NULL || max_items == 0, 0);
+
+  return g_async_queue_pop_many_intern (queue, items, max_items, -1);
+}
+
+/**
+ * g_async_queue_timeout_pop_many:
+ * @queue: a #GAsyncQueue
+ * @items: (out caller-allocates) (array length=max_items): return location
+ *   for the data
+ * @max_items: the maximum number of items to pop
+ * @timeout: the number of microseconds to wait
+ *
+ * Pops up to @max_items items from the @queue into @items, like
+ * g_async_queue_pop_many(), but if the queue is empty, blocks for at most
+ * @timeout microseconds.
+ *
+ * Returns: the number of items popped, or 0 if no data is received before
+ *   the timeout
+ *
+ * Since: 2.82
+ */
+guint
+g_async_queue_timeout_pop_many (GAsyncQueue *queue,
+                                gpointer    *items,
+                                guint        max_items,
+                                guint64      timeout)
+{
+  gint64 end_time = g_get_monotonic_time () + timeout;
+
+  g_return_val_if_fail (queue, 0);
+  g_return_val_if_fail (items != NULL || max_items == 0, 0);
+
+  return g_async_queue_pop_many_intern (queue, items, max_items, end_time);
+}
+
 /*
  * Private API
  */
@@ -41,6 +41,9 @@ GLIB_AVAILABLE_IN_ALL
 GAsyncQueue *g_async_queue_new                  (void);
 GLIB_AVAILABLE_IN_ALL
 GAsyncQueue *g_async_queue_new_full             (GDestroyNotify item_free_func);
+GLIB_AVAILABLE_IN_2_82
+GAsyncQueue *g_async_queue_new_bounded          (guint             capacity,
+                                                 GDestroyNotify    item_free_func);
 GLIB_AVAILABLE_IN_ALL
 void         g_async_queue_lock                 (GAsyncQueue      *queue);
 GLIB_AVAILABLE_IN_ALL
@@ -112,6 +115,23 @@ GLIB_AVAILABLE_IN_2_46
 void         g_async_queue_push_front_unlocked  (GAsyncQueue      *queue,
                                                  gpointer          item);
 
+GLIB_AVAILABLE_IN_2_82
+gboolean     g_async_queue_try_push             (GAsyncQueue      *queue,
+                                                 gpointer          data);
+GLIB_AVAILABLE_IN_2_82
+void         g_async_queue_push_many            (GAsyncQueue      *queue,
+                                                 gpointer         *items,
+                                                 guint             n_items);
+GLIB_AVAILABLE_IN_2_82
+guint        g_async_queue_pop_many             (GAsyncQueue      *queue,
+                                                 gpointer         *items,
+                                                 guint             max_items);
+GLIB_AVAILABLE_IN_2_82
+guint        g_async_queue_timeout_pop_many     (GAsyncQueue      *queue,
+                                                 gpointer         *items,
+                                                 guint             max_items,
+                                                 guint64           timeout);
+
 G_GNUC_BEGIN_IGNORE_DEPRECATIONS
 GLIB_DEPRECATED_FOR(g_async_queue_timeout_pop)
 gpointer     g_async_queue_timed_pop            (GAsyncQueue      *queue,
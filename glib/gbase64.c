@@ -29,11 +29,392 @@
 
 #include "gbase64.h"
 #include "gtestutils.h"
+#include "gutilsprivate.h"
 #include "glibintl.h"
 
 static const char base64_alphabet[] =
         "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
+/* Vectorised encoding and decoding of the bulk of the data, using the
+ * algorithms described by Wojciech Muła and Daniel Lemire in “Faster Base64
+ * Encoding and Decoding Using AVX2 Instructions” (2018). The functions below
+ * only handle whole blocks of input; the byte-at-a-time code takes care of
+ * the rest, of the saved state between steps, and of line breaks. */
+#if defined (HAVE_X86_SIMD_TARGETS)
+#include <immintrin.h>
+#define BASE64_X86
+#elif defined (__aarch64__) && defined (__ARM_NEON)
+#include <arm_neon.h>
+#define BASE64_NEON
+#endif
+
+#if defined (BASE64_X86) || defined (BASE64_NEON)
+#define BASE64_SIMD
+
+/* For each character, the lookup of the low nibble in one table and of the
+ * high nibble in the other have a common bit set iff the character is not
+ * in the alphabet. */
+static const guint8 base64_invalid_lo[16] = {
+  0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+  0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a,
+};
+static const guint8 base64_invalid_hi[16] = {
+  0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+};
+
+/* What to add to a valid character to get its value, by high nibble; '/'
+ * is moved to the slot before its high nibble */
+static const gint8 base64_decode_shift[16] = {
+  0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+#ifdef BASE64_X86
+
+/* What to add to a 6-bit value to get its character, indexed as described
+ * in base64_encode_vec_ssse3() */
+static const gint8 base64_encode_shift[16] = {
+  'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+  '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+};
+
+/* Spreads each group of 3 bytes in the low 12 bytes over a 32-bit lane,
+ * as 4 bytes holding 6 bits each */
+__attribute__ ((target ("ssse3")))
+static inline __m128i
+base64_encode_vec_ssse3 (__m128i in)
+{
+  const __m128i shift = _mm_loadu_si128 ((const __m128i *) base64_encode_shift);
+  __m128i hi, lo, values, index;
+
+  in = _mm_shuffle_epi8 (in, _mm_setr_epi8 (1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  hi = _mm_mulhi_epu16 (_mm_and_si128 (in, _mm_set1_epi32 (0x0fc0fc00)), _mm_set1_epi32 (0x04000040));
+  lo = _mm_mullo_epi16 (_mm_and_si128 (in, _mm_set1_epi32 (0x003f03f0)), _mm_set1_epi32 (0x01000010));
+  values = _mm_or_si128 (hi, lo);
+
+  /* Map 0…25 to 13, 26…51 to 0, 52…61 to 1…10, 62 to 11 and 63 to 12 */
+  index = _mm_subs_epu8 (values, _mm_set1_epi8 (51));
+  index = _mm_or_si128 (index, _mm_and_si128 (_mm_cmpgt_epi8 (_mm_set1_epi8 (26), values),
+                                              _mm_set1_epi8 (13)));
+
+  return _mm_add_epi8 (values, _mm_shuffle_epi8 (shift, index));
+}
+
+/* Decodes 16 characters into 12 bytes in the low part of @out, returning
+ * %FALSE if any of them is not in the alphabet */
+__attribute__ ((target ("ssse3")))
+static inline gboolean
+base64_decode_vec_ssse3 (__m128i  in,
+                         __m128i *out)
+{
+  const __m128i invalid_lo = _mm_loadu_si128 ((const __m128i *) base64_invalid_lo);
+  const __m128i invalid_hi = _mm_loadu_si128 ((const __m128i *) base64_invalid_hi);
+  const __m128i shift = _mm_loadu_si128 ((const __m128i *) base64_decode_shift);
+  const __m128i low_nibble = _mm_set1_epi8 (0x0f);
+  __m128i hi_nibbles, invalid, values;
+
+  hi_nibbles = _mm_and_si128 (_mm_srli_epi32 (in, 4), low_nibble);
+  invalid = _mm_and_si128 (_mm_shuffle_epi8 (invalid_lo, _mm_and_si128 (in, low_nibble)),
+                           _mm_shuffle_epi8 (invalid_hi, hi_nibbles));
+  if (_mm_movemask_epi8 (_mm_cmpeq_epi8 (invalid, _mm_setzero_si128 ())) != 0xffff)
+    return FALSE;
+
+  values = _mm_add_epi8 (in, _mm_shuffle_epi8 (shift, _mm_add_epi8 (hi_nibbles, _mm_cmpeq_epi8 (in, _mm_set1_epi8 ('/')))));
+
+  /* Pack 4 × 6 bits into 24 bits per 32-bit lane, then move the bytes out
+   * in big-endian order */
+  values = _mm_maddubs_epi16 (values, _mm_set1_epi32 (0x01400140));
+  values = _mm_madd_epi16 (values, _mm_set1_epi32 (0x00011000));
+  *out = _mm_shuffle_epi8 (values, _mm_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+  return TRUE;
+}
+
+__attribute__ ((target ("ssse3")))
+static inline void
+base64_store_12_ssse3 (guchar  *out,
+                       __m128i  v)
+{
+  guint32 last = _mm_cvtsi128_si32 (_mm_srli_si128 (v, 8));
+
+  _mm_storel_epi64 ((__m128i *) out, v);
+  memcpy (out + 8, &last, sizeof (last));
+}
+
+/* Encodes 4 groups at a time, as long as at least 16 bytes can be read */
+__attribute__ ((target ("ssse3")))
+static gsize
+base64_encode_ssse3 (const guchar *in,
+                     gsize         in_len,
+                     gsize         n_groups,
+                     gchar        *out)
+{
+  gsize done;
+
+  for (done = 0; n_groups - done >= 4 && in_len - done * 3 >= 16; done += 4)
+    {
+      __m128i v = _mm_loadu_si128 ((const __m128i *) (in + done * 3));
+
+      _mm_storeu_si128 ((__m128i *) (out + done * 4), base64_encode_vec_ssse3 (v));
+    }
+
+  return done;
+}
+
+__attribute__ ((target ("ssse3")))
+static gsize
+base64_decode_ssse3 (const guchar *in,
+                     gsize         len,
+                     guchar       *out)
+{
+  gsize done;
+
+  for (done = 0; len - done >= 16; done += 16)
+    {
+      __m128i v = _mm_loadu_si128 ((const __m128i *) (in + done));
+      __m128i decoded;
+
+      if (!base64_decode_vec_ssse3 (v, &decoded))
+        break;
+
+      /* Don't write past the 12 bytes, @out may be the input */
+      base64_store_12_ssse3 (out + done / 4 * 3, decoded);
+    }
+
+  return done;
+}
+
+/* As base64_encode_vec_ssse3(), on both 128-bit lanes */
+__attribute__ ((target ("avx2")))
+static inline __m256i
+base64_encode_vec_avx2 (__m256i in)
+{
+  const __m256i shift = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *) base64_encode_shift));
+  __m256i hi, lo, values, index;
+
+  in = _mm256_shuffle_epi8 (in, _mm256_setr_epi8 (1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                                  1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  hi = _mm256_mulhi_epu16 (_mm256_and_si256 (in, _mm256_set1_epi32 (0x0fc0fc00)), _mm256_set1_epi32 (0x04000040));
+  lo = _mm256_mullo_epi16 (_mm256_and_si256 (in, _mm256_set1_epi32 (0x003f03f0)), _mm256_set1_epi32 (0x01000010));
+  values = _mm256_or_si256 (hi, lo);
+
+  index = _mm256_subs_epu8 (values, _mm256_set1_epi8 (51));
+  index = _mm256_or_si256 (index, _mm256_and_si256 (_mm256_cmpgt_epi8 (_mm256_set1_epi8 (26), values),
+                                                    _mm256_set1_epi8 (13)));
+
+  return _mm256_add_epi8 (values, _mm256_shuffle_epi8 (shift, index));
+}
+
+/* As base64_decode_vec_ssse3(), with 12 bytes in the low part of each lane */
+__attribute__ ((target ("avx2")))
+static inline gboolean
+base64_decode_vec_avx2 (__m256i  in,
+                        __m256i *out)
+{
+  const __m256i invalid_lo = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *) base64_invalid_lo));
+  const __m256i invalid_hi = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *) base64_invalid_hi));
+  const __m256i shift = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *) base64_decode_shift));
+  const __m256i low_nibble = _mm256_set1_epi8 (0x0f);
+  __m256i hi_nibbles, invalid, values;
+
+  hi_nibbles = _mm256_and_si256 (_mm256_srli_epi32 (in, 4), low_nibble);
+  invalid = _mm256_and_si256 (_mm256_shuffle_epi8 (invalid_lo, _mm256_and_si256 (in, low_nibble)),
+                              _mm256_shuffle_epi8 (invalid_hi, hi_nibbles));
+  if (!_mm256_testz_si256 (invalid, invalid))
+    return FALSE;
+
+  values = _mm256_add_epi8 (in, _mm256_shuffle_epi8 (shift, _mm256_add_epi8 (hi_nibbles, _mm256_cmpeq_epi8 (in, _mm256_set1_epi8 ('/')))));
+
+  values = _mm256_maddubs_epi16 (values, _mm256_set1_epi32 (0x01400140));
+  values = _mm256_madd_epi16 (values, _mm256_set1_epi32 (0x00011000));
+  *out = _mm256_shuffle_epi8 (values, _mm256_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+  return TRUE;
+}
+
+/* Encodes 8 groups at a time, as long as at least 28 bytes can be read */
+__attribute__ ((target ("avx2")))
+static gsize
+base64_encode_avx2 (const guchar *in,
+                    gsize         in_len,
+                    gsize         n_groups,
+                    gchar        *out)
+{
+  gsize done;
+
+  for (done = 0; n_groups - done >= 8 && in_len - done * 3 >= 28; done += 8)
+    {
+      const guchar *p = in + done * 3;
+      __m256i v = _mm256_inserti128_si256 (_mm256_castsi128_si256 (_mm_loadu_si128 ((const __m128i *) p)),
+                                           _mm_loadu_si128 ((const __m128i *) (p + 12)), 1);
+
+      _mm256_storeu_si256 ((__m256i *) (out + done * 4), base64_encode_vec_avx2 (v));
+    }
+
+  /* Avoid penalties in any following SSE code */
+  _mm256_zeroupper ();
+
+  return done;
+}
+
+__attribute__ ((target ("avx2")))
+static gsize
+base64_decode_avx2 (const guchar *in,
+                    gsize         len,
+                    guchar       *out)
+{
+  gsize done;
+
+  for (done = 0; len - done >= 32; done += 32)
+    {
+      __m256i v = _mm256_loadu_si256 ((const __m256i *) (in + done));
+      __m256i decoded;
+      guchar *o = out + done / 4 * 3;
+
+      if (!base64_decode_vec_avx2 (v, &decoded))
+        break;
+
+      base64_store_12_ssse3 (o, _mm256_castsi256_si128 (decoded));
+      base64_store_12_ssse3 (o + 12, _mm256_extracti128_si256 (decoded, 1));
+    }
+
+  _mm256_zeroupper ();
+
+  return done;
+}
+
+/* Returns how many of the first @n_groups groups of 3 bytes from @in have
+ * been encoded to @out. More bytes than that may be read, but not more than
+ * @in_len. */
+static gsize
+base64_encode_blocks (const guchar *in,
+                      gsize         in_len,
+                      gsize         n_groups,
+                      gchar        *out)
+{
+  GCpuFeatures features = g_get_cpu_features ();
+  gsize done = 0;
+
+  if (features & G_CPU_FEATURE_AVX2)
+    done = base64_encode_avx2 (in, in_len, n_groups, out);
+  if (features & G_CPU_FEATURE_SSSE3)
+    done += base64_encode_ssse3 (in + done * 3, in_len - done * 3, n_groups - done, out + done * 4);
+
+  return done;
+}
+
+/* Returns how many characters from the start of @in have been decoded to
+ * @out, which is a multiple of 4 and stops before any character outside of
+ * the alphabet, including padding. @out may be the same as @in. */
+static gsize
+base64_decode_blocks (const guchar *in,
+                      gsize         len,
+                      guchar       *out)
+{
+  GCpuFeatures features = g_get_cpu_features ();
+  gsize done = 0;
+
+  if (features & G_CPU_FEATURE_AVX2)
+    done = base64_decode_avx2 (in, len, out);
+  if (features & G_CPU_FEATURE_SSSE3)
+    done += base64_decode_ssse3 (in + done, len - done, out + done / 4 * 3);
+
+  return done;
+}
+
+#else /* BASE64_NEON */
+
+/* The vld3q/vst4q and vld4q/vst3q instructions do the (de)interleaving of
+ * the groups, so each byte position of a group is handled in its own
+ * register. */
+static gsize
+base64_encode_blocks (const guchar *in,
+                      gsize         in_len,
+                      gsize         n_groups,
+                      gchar        *out)
+{
+  uint8x16x4_t alphabet;
+  gsize done;
+
+  alphabet.val[0] = vld1q_u8 ((const guint8 *) base64_alphabet);
+  alphabet.val[1] = vld1q_u8 ((const guint8 *) base64_alphabet + 16);
+  alphabet.val[2] = vld1q_u8 ((const guint8 *) base64_alphabet + 32);
+  alphabet.val[3] = vld1q_u8 ((const guint8 *) base64_alphabet + 48);
+
+  for (done = 0; n_groups - done >= 16; done += 16)
+    {
+      uint8x16x3_t v = vld3q_u8 (in + done * 3);
+      uint8x16x4_t c;
+
+      c.val[0] = vshrq_n_u8 (v.val[0], 2);
+      c.val[1] = vorrq_u8 (vshrq_n_u8 (v.val[1], 4), vandq_u8 (vshlq_n_u8 (v.val[0], 4), vdupq_n_u8 (0x3f)));
+      c.val[2] = vorrq_u8 (vshrq_n_u8 (v.val[2], 6), vandq_u8 (vshlq_n_u8 (v.val[1], 2), vdupq_n_u8 (0x3f)));
+      c.val[3] = vandq_u8 (v.val[2], vdupq_n_u8 (0x3f));
+
+      c.val[0] = vqtbl4q_u8 (alphabet, c.val[0]);
+      c.val[1] = vqtbl4q_u8 (alphabet, c.val[1]);
+      c.val[2] = vqtbl4q_u8 (alphabet, c.val[2]);
+      c.val[3] = vqtbl4q_u8 (alphabet, c.val[3]);
+
+      vst4q_u8 ((guint8 *) out + done * 4, c);
+    }
+
+  return done;
+}
+
+/* Maps 16 characters to their values, setting a bit in @invalid if any of
+ * them is not in the alphabet */
+static inline uint8x16_t
+base64_decode_vec_neon (uint8x16_t  in,
+                        uint8x16_t *invalid)
+{
+  const uint8x16_t invalid_lo = vld1q_u8 (base64_invalid_lo);
+  const uint8x16_t invalid_hi = vld1q_u8 (base64_invalid_hi);
+  const uint8x16_t shift = vreinterpretq_u8_s8 (vld1q_s8 (base64_decode_shift));
+  uint8x16_t hi_nibbles = vshrq_n_u8 (in, 4);
+
+  *invalid = vorrq_u8 (*invalid, vandq_u8 (vqtbl1q_u8 (invalid_lo, vandq_u8 (in, vdupq_n_u8 (0x0f))),
+                                           vqtbl1q_u8 (invalid_hi, hi_nibbles)));
+
+  return vaddq_u8 (in, vqtbl1q_u8 (shift, vaddq_u8 (hi_nibbles, vceqq_u8 (in, vdupq_n_u8 ('/')))));
+}
+
+static gsize
+base64_decode_blocks (const guchar *in,
+                      gsize         len,
+                      guchar       *out)
+{
+  gsize done;
+
+  for (done = 0; len - done >= 64; done += 64)
+    {
+      uint8x16x4_t v = vld4q_u8 (in + done);
+      uint8x16_t invalid = vdupq_n_u8 (0);
+      uint8x16x3_t o;
+
+      v.val[0] = base64_decode_vec_neon (v.val[0], &invalid);
+      v.val[1] = base64_decode_vec_neon (v.val[1], &invalid);
+      v.val[2] = base64_decode_vec_neon (v.val[2], &invalid);
+      v.val[3] = base64_decode_vec_neon (v.val[3], &invalid);
+      if (vmaxvq_u8 (invalid) != 0)
+        break;
+
+      o.val[0] = vorrq_u8 (vshlq_n_u8 (v.val[0], 2), vshrq_n_u8 (v.val[1], 4));
+      o.val[1] = vorrq_u8 (vshlq_n_u8 (v.val[1], 4), vshrq_n_u8 (v.val[2], 2));
+      o.val[2] = vorrq_u8 (vshlq_n_u8 (v.val[2], 6), v.val[3]);
+
+      vst3q_u8 (out + done / 4 * 3, o);
+    }
+
+  return done;
+}
+
+#endif
+
+#endif /* BASE64_X86 || BASE64_NEON */
+
+
 /**
  * g_base64_encode_step:
  * @in: (array length=len) (element-type guint8): the binary data to encode
@@ -94,6 +475,9 @@ g_base64_encode_step (const guchar *in,
       const guchar *inend = in+len-2;
       int c1, c2, c3;
       int already;
+#ifdef BASE64_SIMD
+      gsize n_groups;
+#endif
 
       already = *state;
 
@@ -114,6 +498,30 @@ g_base64_encode_step (const guchar *in,
        */
       while (inptr < inend)
         {
+#ifdef BASE64_SIMD
+          n_groups = (inend + 2 - inptr) / 3;
+
+          if (break_lines)
+            n_groups = MIN (n_groups, (gsize) (19 - already));
+
+          if (n_groups >= 4)
+            {
+              n_groups = base64_encode_blocks (inptr, inend + 2 - inptr,
+                                               n_groups, outptr);
+              inptr += n_groups * 3;
+              outptr += n_groups * 4;
+
+              if (break_lines && n_groups > 0 && (already += n_groups) >= 19)
+                {
+                  *outptr++ = '\n';
+                  already = 0;
+                }
+
+              if (inptr >= inend)
+                break;
+            }
+#endif
+
           c1 = *inptr++;
         skip1:
           c2 = *inptr++;
@@ -258,6 +666,51 @@ g_base64_encode (const guchar *data,
   return (gchar *) out;
 }
 
+/**
+ * g_base64_encode_to_buffer:
+ * @data: (array length=len) (element-type guint8) (nullable): the binary data to encode
+ * @len: the length of @data
+ * @out: (array length=out_size) (element-type gchar): the buffer to write
+ *   the encoded string to
+ * @out_size: the size of @out, in bytes
+ *
+ * Encode a sequence of binary data into its Base-64 stringified
+ * representation, like g_base64_encode(), but writing the result into
+ * a buffer provided by the caller instead of allocating one.
+ *
+ * @out must be large enough to hold the encoded data and a trailing
+ * nul byte; that is, @out_size must be at least `(len + 2) / 3 * 4 + 1`
+ * bytes.
+ *
+ * Returns: the length of the encoded string written to @out, not
+ *   including the trailing nul byte
+ *
+ * Since: 2.82
+ */
+gsize
+g_base64_encode_to_buffer (const guchar *data,
+                           gsize         len,
+                           gchar        *out,
+                           gsize         out_size)
+{
+  gint state = 0;
+  gint save = 0;
+  gsize outlen;
+
+  g_return_val_if_fail (data != NULL || len == 0, 0);
+  g_return_val_if_fail (out != NULL, 0);
+  g_return_val_if_fail (len < ((G_MAXSIZE - 1) / 4 - 1) * 3, 0);
+  g_return_val_if_fail (out_size >= (len + 2) / 3 * 4 + 1, 0);
+
+  /* With no line breaks and no saved state, g_base64_encode_step() and
+   * g_base64_encode_close() write exactly (len + 2) / 3 * 4 bytes */
+  outlen = g_base64_encode_step (data, len, FALSE, out, &state, &save);
+  outlen += g_base64_encode_close (FALSE, out + outlen, &state, &save);
+  out[outlen] = '\0';
+
+  return outlen;
+}
+
 static const unsigned char mime_base64_rank[256] = {
   255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
   255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
@@ -341,6 +794,21 @@ g_base64_decode_step (const gchar  *in,
   inptr = (const guchar *)in;
   while (inptr < inend)
     {
+#ifdef BASE64_SIMD
+      /* Whole groups without any padding, whitespace or other characters
+       * to skip are decoded in bulk */
+      if (i == 0 && inend - inptr >= 16)
+        {
+          gsize n_chars = base64_decode_blocks (inptr, inend - inptr, outptr);
+
+          inptr += n_chars;
+          outptr += n_chars / 4 * 3;
+
+          if (inptr >= inend)
+            break;
+        }
+#endif
+
       c = *inptr++;
       rank = mime_base64_rank [c];
       if (rank != 0xff)
@@ -44,6 +44,11 @@ gsize   g_base64_encode_close   (gboolean      break_lines,
 GLIB_AVAILABLE_IN_ALL
 gchar*  g_base64_encode         (const guchar *data,
                                  gsize         len) G_GNUC_MALLOC;
+GLIB_AVAILABLE_IN_2_82
+gsize   g_base64_encode_to_buffer (const guchar *data,
+                                   gsize         len,
+                                   gchar        *out,
+                                   gsize         out_size);
 GLIB_AVAILABLE_IN_ALL
 gsize   g_base64_decode_step    (const gchar  *in,
                                  gsize         len,
@@ -32,6 +32,7 @@
 #include <glib/gslice.h>
 
 #include "gthreadprivate.h"
+#include "gtrace-private.h"
 
 #ifdef G_BIT_LOCK_FORCE_FUTEX_EMULATION
 #undef HAVE_FUTEX
@@ -174,12 +175,69 @@ g_futex_wake (const gint *address)
 #define CONTENTION_CLASSES 11
 static gint g_bit_lock_contended[CONTENTION_CLASSES];  /* (atomic) */
 
+/* Running averages of how long contended bit locks took to be released,
+ * see g_thread_lock_get_max_spins() */
+static gint g_bit_lock_spins[CONTENTION_CLASSES];  /* (atomic) */
+
 G_ALWAYS_INLINE static inline guint
 bit_lock_contended_class (gpointer address)
 {
   return ((gsize) address) % G_N_ELEMENTS (g_bit_lock_contended);
 }
 
+typedef struct
+{
+  gint64 begin_time_nsec;
+  guint n_sleeps;
+  gboolean contended;
+} BitLockWait;
+
+/* Waits until the bit in @mask may have been cleared in @int_address, after
+ * failing to lock it. The first time, this spins for a while, as bit locks
+ * usually protect very short critical sections; after that it sleeps. */
+static void
+bit_lock_wait (const gint  *int_address,
+               guint        mask,
+               guint        class,
+               BitLockWait *wait)
+{
+  guint v;
+
+  if (!wait->contended)
+    {
+      guint spins, max_spins, n;
+
+      wait->contended = TRUE;
+      wait->begin_time_nsec = G_TRACE_CURRENT_TIME;
+
+      spins = (guint) g_atomic_int_get (&g_bit_lock_spins[class]);
+      max_spins = g_thread_lock_get_max_spins (spins);
+
+      for (n = 0; n < max_spins; n++)
+        {
+          if (!((guint) g_atomic_int_get (int_address) & mask))
+            break;
+
+          g_thread_lock_cpu_relax ();
+        }
+
+      if (max_spins > 0)
+        g_atomic_int_set (&g_bit_lock_spins[class], (gint) spins + ((gint) n - (gint) spins) / 8);
+
+      if (n < max_spins)
+        return;
+    }
+
+  v = (guint) g_atomic_int_get (int_address);
+  if (v & mask)
+    {
+      wait->n_sleeps++;
+      g_atomic_int_add (&g_bit_lock_contended[class], +1);
+      g_futex_wait (int_address, v);
+      g_atomic_int_add (&g_bit_lock_contended[class], -1);
+    }
+}
+
 #if (defined (i386) || defined (__amd64__))
   #if G_GNUC_CHECK_VERSION(4, 5)
     #define USE_ASM_GOTO 1
@@ -213,6 +271,7 @@ g_bit_lock (volatile gint *address,
             gint           lock_bit)
 {
   gint *address_nonvolatile = (gint *) address;
+  BitLockWait wait = { 0, 0, FALSE };
 
 #ifdef USE_ASM_GOTO
  retry:
@@ -222,23 +281,16 @@ g_bit_lock (volatile gint *address,
                          : "r" (address), "r" (lock_bit)
                          : "cc", "memory"
                          : contended);
+  if G_UNLIKELY (wait.contended)
+    {
+      g_trace_lock_contended (G_TRACE_LOCK_BIT_LOCK, address_nonvolatile,
+                              wait.begin_time_nsec, wait.n_sleeps);
+    }
   return;
 
  contended:
-  {
-    guint mask = 1u << lock_bit;
-    guint v;
-
-    v = (guint) g_atomic_int_get (address_nonvolatile);
-    if (v & mask)
-      {
-        guint class = bit_lock_contended_class (address_nonvolatile);
-
-        g_atomic_int_add (&g_bit_lock_contended[class], +1);
-        g_futex_wait (address_nonvolatile, v);
-        g_atomic_int_add (&g_bit_lock_contended[class], -1);
-      }
-  }
+  bit_lock_wait (address_nonvolatile, 1u << lock_bit,
+                 bit_lock_contended_class (address_nonvolatile), &wait);
   goto retry;
 #else
   guint mask = 1u << lock_bit;
@@ -249,14 +301,16 @@ g_bit_lock (volatile gint *address,
   if (v & mask)
     /* already locked */
     {
-      guint class = bit_lock_contended_class (address_nonvolatile);
-
-      g_atomic_int_add (&g_bit_lock_contended[class], +1);
-      g_futex_wait (address_nonvolatile, v);
-      g_atomic_int_add (&g_bit_lock_contended[class], -1);
-
+      bit_lock_wait (address_nonvolatile, mask,
+                     bit_lock_contended_class (address_nonvolatile), &wait);
       goto retry;
     }
+
+  if G_UNLIKELY (wait.contended)
+    {
+      g_trace_lock_contended (G_TRACE_LOCK_BIT_LOCK, address_nonvolatile,
+                              wait.begin_time_nsec, wait.n_sleeps);
+    }
 #endif
 }
 
@@ -445,6 +499,7 @@ void
                               guintptr *out_ptr)
 {
   guint class = bit_lock_contended_class (address);
+  BitLockWait wait = { 0, 0, FALSE };
   guintptr mask;
   guintptr v;
 
@@ -463,16 +518,15 @@ void
                                  : "r"(address), "r"((gsize) lock_bit)
                                  : "cc", "memory"
                                  : contended);
+          if G_UNLIKELY (wait.contended)
+            {
+              g_trace_lock_contended (G_TRACE_LOCK_BIT_LOCK, address,
+                                      wait.begin_time_nsec, wait.n_sleeps);
+            }
           return;
 
         contended:
-          v = (guintptr) g_atomic_pointer_get ((gpointer *) address);
-          if (v & mask)
-            {
-              g_atomic_int_add (&g_bit_lock_contended[class], +1);
-              g_futex_wait (g_futex_int_address (address), v);
-              g_atomic_int_add (&g_bit_lock_contended[class], -1);
-            }
+          bit_lock_wait (g_futex_int_address (address), (guint) mask, class, &wait);
         }
     }
 #endif
@@ -482,12 +536,16 @@ retry:
   if (v & mask)
     /* already locked */
     {
-      g_atomic_int_add (&g_bit_lock_contended[class], +1);
-      g_futex_wait (g_futex_int_address (address), (guint) v);
-      g_atomic_int_add (&g_bit_lock_contended[class], -1);
+      bit_lock_wait (g_futex_int_address (address), (guint) mask, class, &wait);
       goto retry;
     }
 
+  if G_UNLIKELY (wait.contended)
+    {
+      g_trace_lock_contended (G_TRACE_LOCK_BIT_LOCK, address,
+                              wait.begin_time_nsec, wait.n_sleeps);
+    }
+
   if (out_ptr)
     *out_ptr = (v | mask);
 }
@@ -31,6 +31,21 @@
 #include <time.h>
 #include <stdarg.h>
 
+#ifdef G_OS_UNIX
+#include <unistd.h>
+#endif
+#ifdef G_OS_WIN32
+#include <io.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+#ifndef O_CLOEXEC
+#define O_CLOEXEC 0
+#endif
+
 #include "gconvert.h"
 #include "gdataset.h"
 #include "gdatetime.h"
@@ -61,6 +76,7 @@
 #define XBEL_DTD_URI		"http://www.python.org/topics/xml/dtds/xbel-1.0.dtd"
 
 #define XBEL_ROOT_ELEMENT	"xbel"
+#define XBEL_ROOT_END_TAG	"</" XBEL_ROOT_ELEMENT ">"
 #define XBEL_FOLDER_ELEMENT	"folder" 	/* unused */
 #define XBEL_BOOKMARK_ELEMENT	"bookmark"
 #define XBEL_ALIAS_ELEMENT	"alias"		/* unused */
@@ -153,6 +169,10 @@ struct _BookmarkItem
   GDateTime *visited;  /* (owned) */
 
   BookmarkMetadata *metadata;
+
+  /* whether the item is unchanged since the file was last loaded
+   * or written */
+  gboolean in_file;
 };
 
 struct _GBookmarkFile
@@ -165,6 +185,16 @@ struct _GBookmarkFile
    */
   GList *items;
   GHashTable *items_by_uri;
+
+  /* the file which was last loaded or written, which new items can be
+   * appended to by g_bookmark_file_update_file() until anything else
+   * changes
+   */
+  gchar *file_path;
+  goffset file_size;
+  gint64 file_mtime;
+  goffset file_root_end;  /* offset of XBEL_ROOT_END_TAG */
+  gboolean needs_rewrite;
 };
 
 /* parser state machine */
@@ -537,6 +567,8 @@ bookmark_item_new (const gchar *uri)
 
   item->metadata = NULL;
 
+  item->in_file = FALSE;
+
   return item;
 }
 
@@ -727,6 +759,9 @@ g_bookmark_file_init (GBookmarkFile *bookmark)
                                                   g_str_equal,
                                                   NULL,
                                                   NULL);
+
+  bookmark->file_path = NULL;
+  bookmark->needs_rewrite = FALSE;
 }
 
 static void
@@ -739,6 +774,62 @@ g_bookmark_file_clear (GBookmarkFile *bookmark)
   bookmark->items = NULL;
 
   g_clear_pointer (&bookmark->items_by_uri, g_hash_table_unref);
+
+  g_clear_pointer (&bookmark->file_path, g_free);
+}
+
+/* Called whenever @item, or @bookmark itself if @item is %NULL, is about
+ * to change: only new items can be appended to the file */
+static void
+g_bookmark_file_item_changed (GBookmarkFile *bookmark,
+                              BookmarkItem  *item)
+{
+  if (item == NULL || item->in_file)
+    bookmark->needs_rewrite = TRUE;
+}
+
+static void
+g_bookmark_file_touch_item (GBookmarkFile *bookmark,
+                            BookmarkItem  *item)
+{
+  g_bookmark_file_item_changed (bookmark, item);
+  bookmark_item_touch_modified (item);
+}
+
+/* Records that @filename, as described by @stat_buf, has the contents of
+ * @bookmark, which are @data */
+static void
+g_bookmark_file_set_file (GBookmarkFile   *bookmark,
+                          const gchar     *filename,
+                          const GStatBuf  *stat_buf,
+                          const gchar     *data,
+                          gsize            length)
+{
+  const gchar *root_end, *p;
+  GList *l;
+
+  g_clear_pointer (&bookmark->file_path, g_free);
+
+  /* Appending new items goes where the root element ends, so nothing but
+   * whitespace may follow it */
+  root_end = g_strrstr_len (data, length, XBEL_ROOT_END_TAG);
+  if (root_end == NULL)
+    return;
+
+  for (p = root_end + strlen (XBEL_ROOT_END_TAG); p < data + length; p++)
+    {
+      if (!g_ascii_isspace (*p))
+        return;
+    }
+
+  bookmark->file_path = g_strdup (filename);
+  bookmark->file_size = stat_buf->st_size;
+  bookmark->file_mtime = stat_buf->st_mtime;
+  bookmark->file_root_end = root_end - data;
+  bookmark->needs_rewrite = FALSE;
+
+  for (l = bookmark->items; l != NULL; l = l->next)
+    ((BookmarkItem *) l->data)->in_file = TRUE;
 }
 
 struct _ParseData
@@ -1799,6 +1890,8 @@ g_bookmark_file_load_from_data (GBookmarkFile  *bookmark,
       g_bookmark_file_init (bookmark);
     }
 
+  g_clear_pointer (&bookmark->file_path, g_free);
+
   parse_error = NULL;
   retval = g_bookmark_file_parse (bookmark, data, length, &parse_error);
 
@@ -1831,16 +1924,25 @@ g_bookmark_file_load_from_file (GBookmarkFile  *bookmark,
   gboolean ret = FALSE;
   gchar *buffer = NULL;
   gsize len;
+  GStatBuf stat_buf;
+  gboolean have_stat;
 
   g_return_val_if_fail (bookmark != NULL, FALSE);
   g_return_val_if_fail (filename != NULL, FALSE);
 
+  /* Before reading, so that changes made in between are noticed by
+   * g_bookmark_file_update_file() */
+  have_stat = g_stat (filename, &stat_buf) == 0;
+
   if (!g_file_get_contents (filename, &buffer, &len, error))
     goto out;
 
   if (!g_bookmark_file_load_from_data (bookmark, buffer, len, error))
     goto out;
 
+  if (have_stat)
+    g_bookmark_file_set_file (bookmark, filename, &stat_buf, buffer, len);
+
   ret = TRUE;
  out:
   g_free (buffer);
@@ -2077,13 +2179,161 @@ g_bookmark_file_to_file (GBookmarkFile  *bookmark,
       retval = FALSE;
     }
   else
-    retval = TRUE;
+    {
+      GStatBuf stat_buf;
+
+      if (g_stat (filename, &stat_buf) == 0)
+        g_bookmark_file_set_file (bookmark, filename, &stat_buf, data, len);
+      else
+        g_clear_pointer (&bookmark->file_path, g_free);
+
+      retval = TRUE;
+    }
 
   g_free (data);
 
   return retval;
 }
 
+/* Appends the items from @last_new to the head of the list, which are
+ * not in the file yet, in place of the end of the root element; returns
+ * %FALSE if the file needs to be rewritten instead */
+static gboolean
+g_bookmark_file_append_items (GBookmarkFile *bookmark,
+                              GList         *last_new)
+{
+  const gsize end_tag_len = strlen (XBEL_ROOT_END_TAG);
+  gchar end_tag[sizeof (XBEL_ROOT_END_TAG)];
+  GStatBuf stat_buf;
+  GString *appended;
+  gboolean retval = FALSE;
+  GList *l;
+  gsize written;
+  int fd;
+
+  /* The file must be exactly as it was last loaded or written */
+  if (g_stat (bookmark->file_path, &stat_buf) != 0 ||
+      stat_buf.st_size != bookmark->file_size ||
+      stat_buf.st_mtime != bookmark->file_mtime)
+    return FALSE;
+
+  fd = g_open (bookmark->file_path, O_RDWR | O_BINARY | O_CLOEXEC, 0);
+  if (fd < 0)
+    return FALSE;
+
+  if (lseek (fd, bookmark->file_root_end, SEEK_SET) != bookmark->file_root_end ||
+      read (fd, end_tag, end_tag_len) != (gssize) end_tag_len ||
+      memcmp (end_tag, XBEL_ROOT_END_TAG, end_tag_len) != 0 ||
+      lseek (fd, bookmark->file_root_end, SEEK_SET) != bookmark->file_root_end)
+    goto out;
+
+  /* the items are stored in reverse order */
+  appended = g_string_new (NULL);
+  for (l = last_new; l != NULL; l = l->prev)
+    {
+      gchar *item_dump = bookmark_item_dump (l->data);
+
+      if (item_dump)
+        g_string_append (appended, item_dump);
+      g_free (item_dump);
+    }
+  g_string_append (appended, XBEL_ROOT_END_TAG);
+
+  for (written = 0; written < appended->len; )
+    {
+      gssize n = write (fd, appended->str + written, appended->len - written);
+
+      if (n < 0 && errno == EINTR)
+        continue;
+      else if (n < 0)
+        break;
+
+      written += n;
+    }
+
+  if (written == appended->len && g_fsync (fd) == 0)
+    {
+      bookmark->file_root_end += appended->len - end_tag_len;
+
+      for (l = last_new; l != NULL; l = l->prev)
+        ((BookmarkItem *) l->data)->in_file = TRUE;
+
+      retval = TRUE;
+    }
+
+  g_string_free (appended, TRUE);
+
+ out:
+  g_close (fd, NULL);
+
+  /* For the next append */
+  if (retval)
+    {
+      if (g_stat (bookmark->file_path, &stat_buf) == 0)
+        {
+          bookmark->file_size = stat_buf.st_size;
+          bookmark->file_mtime = stat_buf.st_mtime;
+        }
+      else
+        g_clear_pointer (&bookmark->file_path, g_free);
+    }
+
+  return retval;
+}
+
+/**
+ * g_bookmark_file_update_file:
+ * @bookmark: a #GBookmarkFile
+ * @filename: (type filename): path of the output file
+ * @error: return location for a #GError, or %NULL
+ *
+ * Writes the changes made to @bookmark since it was loaded from, or last
+ * written to, @filename.
+ *
+ * This is equivalent to g_bookmark_file_to_file(), but cheaper for large
+ * files which are mostly added to, such as the list of recently used
+ * files: if the only changes are new bookmarks and @filename has not been
+ * changed by anyone else since, they are appended to it in place, and if
+ * there are no changes at all the file is left alone. In every other case,
+ * the whole file is rewritten atomically like g_bookmark_file_to_file()
+ * does.
+ *
+ * Appending is not atomic: a reader may see the file while it is
+ * incomplete.
+ *
+ * Returns: %TRUE if the file was successfully written.
+ *
+ * Since: 2.82
+ */
+gboolean
+g_bookmark_file_update_file (GBookmarkFile  *bookmark,
+                             const gchar    *filename,
+                             GError        **error)
+{
+  GList *l, *last_new = NULL;
+
+  g_return_val_if_fail (bookmark != NULL, FALSE);
+  g_return_val_if_fail (filename != NULL, FALSE);
+
+  if (bookmark->needs_rewrite || bookmark->file_path == NULL ||
+      strcmp (bookmark->file_path, filename) != 0)
+    return g_bookmark_file_to_file (bookmark, filename, error);
+
+  /* new items are prepended, so they come before the ones in the file */
+  for (l = bookmark->items; l != NULL && !((BookmarkItem *) l->data)->in_file; l = l->next)
+    last_new = l;
+
+  if (last_new == NULL)
+    return TRUE;
+
+  if (g_bookmark_file_append_items (bookmark, last_new))
+    return TRUE;
+
+  /* This also repairs the file if appending failed half way, and
+   * reports the error if the file can't be written at all */
+  return g_bookmark_file_to_file (bookmark, filename, error);
+}
+
 static BookmarkItem *
 g_bookmark_file_lookup_item (GBookmarkFile *bookmark,
 			     const gchar   *uri)
@@ -2163,6 +2413,8 @@ g_bookmark_file_remove_item (GBookmarkFile  *bookmark,
       return FALSE;
     }
 
+  g_bookmark_file_item_changed (bookmark, item);
+
   bookmark->items = g_list_remove (bookmark->items, item);
   g_hash_table_remove (bookmark->items_by_uri, item->uri);
 
@@ -2260,6 +2512,8 @@ g_bookmark_file_set_title (GBookmarkFile *bookmark,
 
   if (!uri)
     {
+      g_bookmark_file_item_changed (bookmark, NULL);
+
       g_free (bookmark->title);
       bookmark->title = g_strdup (title);
     }
@@ -2277,7 +2531,7 @@ g_bookmark_file_set_title (GBookmarkFile *bookmark,
       g_free (item->title);
       item->title = g_strdup (title);
 
-      bookmark_item_touch_modified (item);
+      g_bookmark_file_touch_item (bookmark, item);
     }
 }
 
@@ -2347,6 +2601,8 @@ g_bookmark_file_set_description (GBookmarkFile *bookmark,
 
   if (!uri)
     {
+      g_bookmark_file_item_changed (bookmark, NULL);
+
       g_free (bookmark->description);
       bookmark->description = g_strdup (description);
     }
@@ -2364,7 +2620,7 @@ g_bookmark_file_set_description (GBookmarkFile *bookmark,
       g_free (item->description);
       item->description = g_strdup (description);
 
-      bookmark_item_touch_modified (item);
+      g_bookmark_file_touch_item (bookmark, item);
     }
 }
 
@@ -2445,7 +2701,7 @@ g_bookmark_file_set_mime_type (GBookmarkFile *bookmark,
   g_free (item->metadata->mime_type);
 
   item->metadata->mime_type = g_strdup (mime_type);
-  bookmark_item_touch_modified (item);
+  g_bookmark_file_touch_item (bookmark, item);
 }
 
 /**
@@ -2531,7 +2787,7 @@ g_bookmark_file_set_is_private (GBookmarkFile *bookmark,
     item->metadata = bookmark_metadata_new ();
 
   item->metadata->is_private = (is_private == TRUE);
-  bookmark_item_touch_modified (item);
+  g_bookmark_file_touch_item (bookmark, item);
 }
 
 /**
@@ -2637,6 +2893,8 @@ g_bookmark_file_set_added_date_time (GBookmarkFile *bookmark,
       g_bookmark_file_add_item (bookmark, item, NULL);
     }
 
+  g_bookmark_file_item_changed (bookmark, item);
+
   g_clear_pointer (&item->added, g_date_time_unref);
   item->added = g_date_time_ref (added);
   g_clear_pointer (&item->modified, g_date_time_unref);
@@ -2772,6 +3030,8 @@ g_bookmark_file_set_modified_date_time (GBookmarkFile *bookmark,
       g_bookmark_file_add_item (bookmark, item, NULL);
     }
 
+  g_bookmark_file_item_changed (bookmark, item);
+
   g_clear_pointer (&item->modified, g_date_time_unref);
   item->modified = g_date_time_ref (modified);
 }
@@ -2907,6 +3167,8 @@ g_bookmark_file_set_visited_date_time (GBookmarkFile *bookmark,
       g_bookmark_file_add_item (bookmark, item, NULL);
     }
 
+  g_bookmark_file_item_changed (bookmark, item);
+
   g_clear_pointer (&item->visited, g_date_time_unref);
   item->visited = g_date_time_ref (visited);
 }
@@ -3067,7 +3329,7 @@ g_bookmark_file_add_group (GBookmarkFile *bookmark,
       item->metadata->groups = g_list_prepend (item->metadata->groups,
                                                g_strdup (group));
 
-      bookmark_item_touch_modified (item);
+      g_bookmark_file_touch_item (bookmark, item);
     }
 }
 
@@ -3129,7 +3391,7 @@ g_bookmark_file_remove_group (GBookmarkFile  *bookmark,
           g_free (l->data);
 	  g_list_free_1 (l);
 
-          bookmark_item_touch_modified (item);
+          g_bookmark_file_touch_item (bookmark, item);
 
           return TRUE;
         }
@@ -3186,7 +3448,7 @@ g_bookmark_file_set_groups (GBookmarkFile  *bookmark,
 					        g_strdup (groups[i]));
     }
 
-  bookmark_item_touch_modified (item);
+  g_bookmark_file_touch_item (bookmark, item);
 }
 
 /**
@@ -3604,7 +3866,7 @@ g_bookmark_file_set_application_info (GBookmarkFile  *bookmark,
       g_hash_table_remove (item->metadata->apps_by_name, ai->name);
       bookmark_app_info_free (ai);
 
-      bookmark_item_touch_modified (item);
+      g_bookmark_file_touch_item (bookmark, item);
 
       return TRUE;
     }
@@ -3622,7 +3884,7 @@ g_bookmark_file_set_application_info (GBookmarkFile  *bookmark,
       ai->exec = g_shell_quote (exec);
     }
 
-  bookmark_item_touch_modified (item);
+  g_bookmark_file_touch_item (bookmark, item);
 
   return TRUE;
 }
@@ -3980,7 +4242,7 @@ g_bookmark_file_move_item (GBookmarkFile  *bookmark,
 
       g_free (item->uri);
       item->uri = g_strdup (new_uri);
-      bookmark_item_touch_modified (item);
+      g_bookmark_file_touch_item (bookmark, item);
 
       g_hash_table_replace (bookmark->items_by_uri, item->uri, item);
 
@@ -4041,7 +4303,7 @@ g_bookmark_file_set_icon (GBookmarkFile *bookmark,
   else
     item->metadata->icon_mime = g_strdup ("application/octet-stream");
 
-  bookmark_item_touch_modified (item);
+  g_bookmark_file_touch_item (bookmark, item);
 }
 
 /**
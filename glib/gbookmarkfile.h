@@ -147,6 +147,10 @@ GLIB_AVAILABLE_IN_ALL
 gboolean       g_bookmark_file_to_file             (GBookmarkFile  *bookmark,
 						    const gchar    *filename,
 						    GError        **error);
+GLIB_AVAILABLE_IN_2_82
+gboolean       g_bookmark_file_update_file         (GBookmarkFile  *bookmark,
+						    const gchar    *filename,
+						    GError        **error);
 
 GLIB_AVAILABLE_IN_ALL
 void           g_bookmark_file_set_title           (GBookmarkFile  *bookmark,
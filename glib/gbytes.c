@@ -26,13 +26,16 @@
 #include "gbytes.h"
 
 #include <glib/garray.h>
+#include <glib/ghash.h>
 #include <glib/gstrfuncs.h>
 #include <glib/gatomic.h>
 #include <glib/gslice.h>
 #include <glib/gtestutils.h>
 #include <glib/gmem.h>
 #include <glib/gmessages.h>
+#include <glib/gqueue.h>
 #include <glib/grefcount.h>
+#include <glib/gthread.h>
 
 #include <string.h>
 
@@ -77,6 +80,8 @@ struct _GBytes
   gpointer user_data;
 };
 
+static void buffer_pool_block_release (gpointer data);
+
 /**
  * g_bytes_new:
  * @data: (transfer none) (array length=size) (element-type guint8) (nullable):
@@ -333,6 +338,14 @@ g_bytes_unref (GBytes *bytes)
 
   if (g_atomic_ref_count_dec (&bytes->ref_count))
     {
+      /* Pooled bytes are embedded in their buffer's block, which goes
+       * back to the pool as a whole */
+      if (bytes->free_func == buffer_pool_block_release)
+        {
+          buffer_pool_block_release (bytes->user_data);
+          return;
+        }
+
       if (bytes->free_func != NULL)
         bytes->free_func (bytes->user_data);
       g_slice_free (GBytes, bytes);
@@ -385,15 +398,10 @@ guint
 g_bytes_hash (gconstpointer bytes)
 {
   const GBytes *a = bytes;
-  const signed char *p, *e;
-  guint32 h = 5381;
 
   g_return_val_if_fail (bytes != NULL, 0);
 
-  for (p = (signed char *)a->data, e = (signed char *)a->data + a->size; p != e; p++)
-    h = (h << 5) + h + *p;
-
-  return h;
+  return g_str_hash_len (a->data, a->size);
 }
 
 /**
@@ -609,4 +617,610 @@ g_bytes_get_region (GBytes *bytes,
    */
 
   return ((guchar *) bytes->data) + offset;
-}
\ No newline at end of file
+}
+/**
+ * GBytesChain:
+ *
+ * A refcounted sequence of #GBytes, which together form one run of bytes
+ * without being copied into one buffer.
+ *
+ * This is useful for composing messages out of parts such as a header, a
+ * body and a trailer: chunks can be appended and prepended in constant
+ * time, ranges of the chain can be taken without copying with
+ * g_bytes_chain_new_from_chain(), and g_bytes_chain_get_vectors() returns
+ * the chunks in a form which can be passed to `g_output_stream_writev()` or
+ * `g_socket_send_message()`. Only g_bytes_chain_to_bytes() copies the
+ * data, when there is more than one chunk.
+ *
+ * A #GBytesChain is not thread-safe; it must not be modified while it is
+ * used from another thread.
+ *
+ * Since: 2.82
+ */
+struct _GBytesChain
+{
+  GQueue chunks;  /* (element-type GBytes) (owned), never empty ones */
+  gsize size;
+  GArray *vectors;  /* (nullable) (element-type GBytesChainVector) */
+  gatomicrefcount ref_count;
+};
+
+/**
+ * g_bytes_chain_new:
+ *
+ * Creates a new, empty #GBytesChain.
+ *
+ * Returns: (transfer full): a new #GBytesChain
+ *
+ * Since: 2.82
+ */
+GBytesChain *
+g_bytes_chain_new (void)
+{
+  GBytesChain *chain = g_new0 (GBytesChain, 1);
+
+  g_queue_init (&chain->chunks);
+  g_atomic_ref_count_init (&chain->ref_count);
+
+  return chain;
+}
+
+/**
+ * g_bytes_chain_new_from_chain:
+ * @chain: a #GBytesChain
+ * @offset: offset into @chain at which the new chain starts
+ * @length: the length of the new chain
+ *
+ * Creates a #GBytesChain of the @length bytes of @chain starting at
+ * @offset, which may span any number of chunks.
+ *
+ * The data is not copied: the chunks which are entirely in the range are
+ * shared with @chain, and the ones at its ends are sliced with
+ * g_bytes_new_from_bytes().
+ *
+ * @offset + @length must not be greater than the size of @chain.
+ *
+ * Returns: (transfer full): a new #GBytesChain
+ *
+ * Since: 2.82
+ */
+GBytesChain *
+g_bytes_chain_new_from_chain (GBytesChain *chain,
+                              gsize        offset,
+                              gsize        length)
+{
+  GBytesChain *range;
+  GList *l;
+
+  g_return_val_if_fail (chain != NULL, NULL);
+  g_return_val_if_fail (offset <= chain->size, NULL);
+  g_return_val_if_fail (length <= chain->size - offset, NULL);
+
+  range = g_bytes_chain_new ();
+
+  for (l = chain->chunks.head; l != NULL && length > 0; l = l->next)
+    {
+      GBytes *bytes = l->data;
+      gsize size = g_bytes_get_size (bytes);
+      gsize n;
+
+      if (offset >= size)
+        {
+          offset -= size;
+          continue;
+        }
+
+      n = MIN (size - offset, length);
+
+      if (offset == 0 && n == size)
+        g_bytes_chain_append (range, bytes);
+      else
+        {
+          GBytes *slice = g_bytes_new_from_bytes (bytes, offset, n);
+
+          g_bytes_chain_append (range, slice);
+          g_bytes_unref (slice);
+        }
+
+      offset = 0;
+      length -= n;
+    }
+
+  return range;
+}
+
+/**
+ * g_bytes_chain_ref:
+ * @chain: a #GBytesChain
+ *
+ * Increases the reference count of @chain.
+ *
+ * Returns: (transfer full): @chain
+ *
+ * Since: 2.82
+ */
+GBytesChain *
+g_bytes_chain_ref (GBytesChain *chain)
+{
+  g_return_val_if_fail (chain != NULL, NULL);
+
+  g_atomic_ref_count_inc (&chain->ref_count);
+
+  return chain;
+}
+
+/**
+ * g_bytes_chain_unref:
+ * @chain: (transfer full): a #GBytesChain
+ *
+ * Decreases the reference count of @chain, and frees it and drops the
+ * references to its chunks if that was the last reference.
+ *
+ * Since: 2.82
+ */
+void
+g_bytes_chain_unref (GBytesChain *chain)
+{
+  g_return_if_fail (chain != NULL);
+
+  if (g_atomic_ref_count_dec (&chain->ref_count))
+    {
+      g_queue_clear_full (&chain->chunks, (GDestroyNotify) g_bytes_unref);
+      g_clear_pointer (&chain->vectors, g_array_unref);
+      g_free (chain);
+    }
+}
+
+/**
+ * g_bytes_chain_append:
+ * @chain: a #GBytesChain
+ * @bytes: the #GBytes to append
+ *
+ * Adds a reference to @bytes at the end of @chain, without copying its
+ * data. Empty #GBytes are ignored.
+ *
+ * Since: 2.82
+ */
+void
+g_bytes_chain_append (GBytesChain *chain,
+                      GBytes      *bytes)
+{
+  g_return_if_fail (chain != NULL);
+  g_return_if_fail (bytes != NULL);
+
+  if (g_bytes_get_size (bytes) == 0)
+    return;
+
+  g_queue_push_tail (&chain->chunks, g_bytes_ref (bytes));
+  chain->size += g_bytes_get_size (bytes);
+  g_clear_pointer (&chain->vectors, g_array_unref);
+}
+
+/**
+ * g_bytes_chain_prepend:
+ * @chain: a #GBytesChain
+ * @bytes: the #GBytes to prepend
+ *
+ * Adds a reference to @bytes at the start of @chain, without copying its
+ * data. Empty #GBytes are ignored.
+ *
+ * Since: 2.82
+ */
+void
+g_bytes_chain_prepend (GBytesChain *chain,
+                       GBytes      *bytes)
+{
+  g_return_if_fail (chain != NULL);
+  g_return_if_fail (bytes != NULL);
+
+  if (g_bytes_get_size (bytes) == 0)
+    return;
+
+  g_queue_push_head (&chain->chunks, g_bytes_ref (bytes));
+  chain->size += g_bytes_get_size (bytes);
+  g_clear_pointer (&chain->vectors, g_array_unref);
+}
+
+/**
+ * g_bytes_chain_get_size:
+ * @chain: a #GBytesChain
+ *
+ * Gets the total size of the chunks in @chain.
+ *
+ * Returns: the size of @chain in bytes
+ *
+ * Since: 2.82
+ */
+gsize
+g_bytes_chain_get_size (GBytesChain *chain)
+{
+  g_return_val_if_fail (chain != NULL, 0);
+
+  return chain->size;
+}
+
+/**
+ * g_bytes_chain_get_n_chunks:
+ * @chain: a #GBytesChain
+ *
+ * Gets the number of chunks in @chain, which is the number of vectors
+ * g_bytes_chain_get_vectors() returns.
+ *
+ * Returns: the number of chunks in @chain
+ *
+ * Since: 2.82
+ */
+guint
+g_bytes_chain_get_n_chunks (GBytesChain *chain)
+{
+  g_return_val_if_fail (chain != NULL, 0);
+
+  return chain->chunks.length;
+}
+
+/**
+ * g_bytes_chain_get_vectors:
+ * @chain: a #GBytesChain
+ * @n_vectors: (out): return location for the number of vectors
+ *
+ * Gets the chunks of @chain as an array of buffers and their sizes, in
+ * order, for passing to scatter/gather I/O functions like
+ * `g_output_stream_writev()`.
+ *
+ * The array is owned by @chain and stays valid until @chain is changed
+ * or freed.
+ *
+ * Returns: (array length=n_vectors) (transfer none) (nullable): the chunks
+ *   of @chain, or %NULL if it is empty
+ *
+ * Since: 2.82
+ */
+const GBytesChainVector *
+g_bytes_chain_get_vectors (GBytesChain *chain,
+                           gsize       *n_vectors)
+{
+  g_return_val_if_fail (chain != NULL, NULL);
+  g_return_val_if_fail (n_vectors != NULL, NULL);
+
+  *n_vectors = chain->chunks.length;
+  if (chain->chunks.length == 0)
+    return NULL;
+
+  if (chain->vectors == NULL)
+    {
+      GList *l;
+
+      chain->vectors = g_array_sized_new (FALSE, FALSE, sizeof (GBytesChainVector),
+                                          chain->chunks.length);
+
+      for (l = chain->chunks.head; l != NULL; l = l->next)
+        {
+          GBytesChainVector vector;
+
+          vector.buffer = g_bytes_get_data (l->data, &vector.size);
+          g_array_append_val (chain->vectors, vector);
+        }
+    }
+
+  return (const GBytesChainVector *) chain->vectors->data;
+}
+
+/**
+ * g_bytes_chain_to_bytes:
+ * @chain: a #GBytesChain
+ *
+ * Gets the data of @chain as one #GBytes.
+ *
+ * If @chain has a single chunk, a reference to it is returned. Otherwise
+ * the data of all the chunks is copied into a new #GBytes.
+ *
+ * Returns: (transfer full): a #GBytes with the data of @chain
+ *
+ * Since: 2.82
+ */
+GBytes *
+g_bytes_chain_to_bytes (GBytesChain *chain)
+{
+  guint8 *data;
+  gsize offset = 0;
+  GList *l;
+
+  g_return_val_if_fail (chain != NULL, NULL);
+
+  if (chain->chunks.length == 0)
+    return g_bytes_new (NULL, 0);
+
+  if (chain->chunks.length == 1)
+    return g_bytes_ref (chain->chunks.head->data);
+
+  data = g_malloc (chain->size);
+  for (l = chain->chunks.head; l != NULL; l = l->next)
+    {
+      GBytes *chunk = l->data;
+      gsize size = g_bytes_get_size (chunk);
+
+      memcpy (data + offset, g_bytes_get_data (chunk, NULL), size);
+      offset += size;
+    }
+
+  return g_bytes_new_take (data, chain->size);
+}
+
+/**
+ * GBufferPool:
+ *
+ * A refcounted pool of fixed-size buffers, for code which receives data
+ * into #GBytes at a high rate.
+ *
+ * Buffers are taken from the pool with g_buffer_pool_acquire(), filled,
+ * and then either wrapped in a #GBytes with g_buffer_pool_new_bytes() or
+ * handed back with g_buffer_pool_release(). The #GBytes header is
+ * allocated together with its buffer, and both go back to the pool when
+ * the last reference to the #GBytes is dropped, so once the pool holds as
+ * many buffers as are in flight at a time, receiving into it does not
+ * allocate.
+ *
+ * Every buffer has the size given to g_buffer_pool_new(), whatever the
+ * size of the data it ends up holding, so the pool should be sized for
+ * the largest expected read or datagram.
+ *
+ * A #GBufferPool is thread-safe: buffers may be acquired and released,
+ * and pooled #GBytes dropped, from any thread. Each buffer which is out of
+ * the pool holds a reference on it.
+ *
+ * Since: 2.82
+ */
+typedef struct _GBufferPoolBlock GBufferPoolBlock;
+
+struct _GBufferPool
+{
+  gsize buffer_size;
+  guint max_unused;
+
+  GMutex lock;
+  GBufferPoolBlock *unused;  /* (owned) (nullable), linked by @next */
+  guint n_unused;
+
+  gatomicrefcount ref_count;
+};
+
+struct _GBufferPoolBlock
+{
+  GBytes bytes;  /* only set up by g_buffer_pool_new_bytes() */
+  GBufferPool *pool;  /* (owned) (nullable), while out of the pool */
+  GBufferPoolBlock *next;  /* while unused */
+};
+
+/* The buffer follows the block header, with the alignment g_malloc()
+ * would give it */
+#define BUFFER_POOL_ALIGNMENT (2 * sizeof (gpointer))
+#define BUFFER_POOL_HEADER_SIZE \
+  ((sizeof (GBufferPoolBlock) + BUFFER_POOL_ALIGNMENT - 1) & ~(BUFFER_POOL_ALIGNMENT - 1))
+
+#define BUFFER_POOL_BLOCK_DATA(block) ((guint8 *) (block) + BUFFER_POOL_HEADER_SIZE)
+#define BUFFER_POOL_DATA_BLOCK(data) ((GBufferPoolBlock *) ((guint8 *) (data) - BUFFER_POOL_HEADER_SIZE))
+
+/**
+ * g_buffer_pool_new:
+ * @buffer_size: the size of each buffer, which must be non-zero
+ * @max_unused: how many released buffers to keep for reuse
+ *
+ * Creates a new #GBufferPool of buffers of @buffer_size bytes.
+ *
+ * Buffers are allocated on demand. When they are released, up to
+ * @max_unused of them are kept for later g_buffer_pool_acquire() calls and
+ * the rest are freed, so @max_unused should be the number of buffers the
+ * caller expects to have in flight at a time.
+ *
+ * Returns: (transfer full): a new #GBufferPool
+ *
+ * Since: 2.82
+ */
+GBufferPool *
+g_buffer_pool_new (gsize buffer_size,
+                   guint max_unused)
+{
+  GBufferPool *pool;
+
+  g_return_val_if_fail (buffer_size > 0, NULL);
+  g_return_val_if_fail (buffer_size <= G_MAXSIZE - BUFFER_POOL_HEADER_SIZE, NULL);
+
+  pool = g_new0 (GBufferPool, 1);
+  pool->buffer_size = buffer_size;
+  pool->max_unused = max_unused;
+  g_mutex_init (&pool->lock);
+  g_atomic_ref_count_init (&pool->ref_count);
+
+  return pool;
+}
+
+/**
+ * g_buffer_pool_ref:
+ * @pool: a #GBufferPool
+ *
+ * Increases the reference count of @pool.
+ *
+ * Returns: (transfer full): @pool
+ *
+ * Since: 2.82
+ */
+GBufferPool *
+g_buffer_pool_ref (GBufferPool *pool)
+{
+  g_return_val_if_fail (pool != NULL, NULL);
+
+  g_atomic_ref_count_inc (&pool->ref_count);
+
+  return pool;
+}
+
+/**
+ * g_buffer_pool_unref:
+ * @pool: (transfer full): a #GBufferPool
+ *
+ * Decreases the reference count of @pool, and frees it and its unused
+ * buffers if that was the last reference.
+ *
+ * Since: 2.82
+ */
+void
+g_buffer_pool_unref (GBufferPool *pool)
+{
+  g_return_if_fail (pool != NULL);
+
+  if (g_atomic_ref_count_dec (&pool->ref_count))
+    {
+      while (pool->unused != NULL)
+        {
+          GBufferPoolBlock *block = pool->unused;
+
+          pool->unused = block->next;
+          g_free (block);
+        }
+
+      g_mutex_clear (&pool->lock);
+      g_free (pool);
+    }
+}
+
+/**
+ * g_buffer_pool_get_buffer_size:
+ * @pool: a #GBufferPool
+ *
+ * Gets the size of the buffers of @pool.
+ *
+ * Returns: the size of each buffer, in bytes
+ *
+ * Since: 2.82
+ */
+gsize
+g_buffer_pool_get_buffer_size (GBufferPool *pool)
+{
+  g_return_val_if_fail (pool != NULL, 0);
+
+  return pool->buffer_size;
+}
+
+/**
+ * g_buffer_pool_acquire:
+ * @pool: a #GBufferPool
+ *
+ * Takes a buffer of g_buffer_pool_get_buffer_size() bytes from @pool,
+ * allocating a new one if there is no unused buffer.
+ *
+ * The contents of the buffer are undefined. It must eventually be given
+ * to either g_buffer_pool_new_bytes() or g_buffer_pool_release().
+ *
+ * Returns: (transfer full) (not nullable): a buffer from @pool
+ *
+ * Since: 2.82
+ */
+gpointer
+g_buffer_pool_acquire (GBufferPool *pool)
+{
+  GBufferPoolBlock *block;
+
+  g_return_val_if_fail (pool != NULL, NULL);
+
+  g_mutex_lock (&pool->lock);
+  block = pool->unused;
+  if (block != NULL)
+    {
+      pool->unused = block->next;
+      pool->n_unused--;
+    }
+  g_mutex_unlock (&pool->lock);
+
+  if (block == NULL)
+    block = g_malloc (BUFFER_POOL_HEADER_SIZE + pool->buffer_size);
+
+  block->pool = g_buffer_pool_ref (pool);
+  block->next = NULL;
+
+  return BUFFER_POOL_BLOCK_DATA (block);
+}
+
+static void
+buffer_pool_block_release (gpointer data)
+{
+  GBufferPoolBlock *block = data;
+  GBufferPool *pool = g_steal_pointer (&block->pool);
+
+  g_mutex_lock (&pool->lock);
+  if (pool->n_unused < pool->max_unused)
+    {
+      block->next = pool->unused;
+      pool->unused = g_steal_pointer (&block);
+      pool->n_unused++;
+    }
+  g_mutex_unlock (&pool->lock);
+
+  g_free (block);
+  g_buffer_pool_unref (pool);
+}
+
+/**
+ * g_buffer_pool_release:
+ * @pool: a #GBufferPool
+ * @buffer: (transfer full): a buffer acquired from @pool
+ *
+ * Hands a buffer acquired with g_buffer_pool_acquire() back to @pool
+ * without wrapping it in a #GBytes, for example because the read into it
+ * failed.
+ *
+ * Since: 2.82
+ */
+void
+g_buffer_pool_release (GBufferPool *pool,
+                       gpointer     buffer)
+{
+  GBufferPoolBlock *block;
+
+  g_return_if_fail (pool != NULL);
+  g_return_if_fail (buffer != NULL);
+
+  block = BUFFER_POOL_DATA_BLOCK (buffer);
+  g_return_if_fail (block->pool == pool);
+
+  buffer_pool_block_release (block);
+}
+
+/**
+ * g_buffer_pool_new_bytes:
+ * @pool: a #GBufferPool
+ * @buffer: (transfer full): a buffer acquired from @pool
+ * @size: the size of the data in @buffer
+ *
+ * Creates a #GBytes of the first @size bytes of @buffer, which must have
+ * been acquired from @pool with g_buffer_pool_acquire().
+ *
+ * This does not allocate: the #GBytes shares its memory with @buffer,
+ * and both go back to @pool when the last reference to the #GBytes is
+ * dropped. @buffer must not be modified or released after this call.
+ *
+ * Returns: (transfer full): a new #GBytes
+ *
+ * Since: 2.82
+ */
+GBytes *
+g_buffer_pool_new_bytes (GBufferPool *pool,
+                         gpointer     buffer,
+                         gsize        size)
+{
+  GBufferPoolBlock *block;
+
+  g_return_val_if_fail (pool != NULL, NULL);
+  g_return_val_if_fail (buffer != NULL, NULL);
+  g_return_val_if_fail (size <= pool->buffer_size, NULL);
+
+  block = BUFFER_POOL_DATA_BLOCK (buffer);
+  g_return_val_if_fail (block->pool == pool, NULL);
+
+  block->bytes.data = buffer;
+  block->bytes.size = size;
+  block->bytes.free_func = buffer_pool_block_release;
+  block->bytes.user_data = block;
+  g_atomic_ref_count_init (&block->bytes.ref_count);
+
+  return &block->bytes;
+}
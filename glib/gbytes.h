@@ -93,6 +93,89 @@ gconstpointer   g_bytes_get_region              (GBytes         *bytes,
                                                  gsize           offset,
                                                  gsize           n_elements);
 
+/**
+ * GBytesChainVector:
+ * @buffer: (array length=size) (element-type guint8): the data of one chunk
+ * @size: the size of @buffer
+ *
+ * One chunk of a #GBytesChain, as returned by g_bytes_chain_get_vectors().
+ *
+ * This has the same layout as `GOutputVector`, and as `struct iovec` where
+ * `GOutputVector` has, so arrays of it can be passed to
+ * `g_output_stream_writev()` or `g_socket_send_message()` by casting them.
+ *
+ * Since: 2.82
+ */
+typedef struct
+{
+  gconstpointer buffer;
+  gsize size;
+} GBytesChainVector;
+
+typedef struct _GBytesChain GBytesChain;
+
+GLIB_AVAILABLE_IN_2_82
+GBytesChain *   g_bytes_chain_new               (void);
+
+GLIB_AVAILABLE_IN_2_82
+GBytesChain *   g_bytes_chain_new_from_chain    (GBytesChain    *chain,
+                                                 gsize           offset,
+                                                 gsize           length);
+
+GLIB_AVAILABLE_IN_2_82
+GBytesChain *   g_bytes_chain_ref               (GBytesChain    *chain);
+
+GLIB_AVAILABLE_IN_2_82
+void            g_bytes_chain_unref             (GBytesChain    *chain);
+
+GLIB_AVAILABLE_IN_2_82
+void            g_bytes_chain_append            (GBytesChain    *chain,
+                                                 GBytes         *bytes);
+
+GLIB_AVAILABLE_IN_2_82
+void            g_bytes_chain_prepend           (GBytesChain    *chain,
+                                                 GBytes         *bytes);
+
+GLIB_AVAILABLE_IN_2_82
+gsize           g_bytes_chain_get_size          (GBytesChain    *chain);
+
+GLIB_AVAILABLE_IN_2_82
+guint           g_bytes_chain_get_n_chunks      (GBytesChain    *chain);
+
+GLIB_AVAILABLE_IN_2_82
+const GBytesChainVector *
+                g_bytes_chain_get_vectors       (GBytesChain    *chain,
+                                                 gsize          *n_vectors);
+
+GLIB_AVAILABLE_IN_2_82
+GBytes *        g_bytes_chain_to_bytes          (GBytesChain    *chain);
+
+typedef struct _GBufferPool GBufferPool;
+
+GLIB_AVAILABLE_IN_2_82
+GBufferPool *   g_buffer_pool_new               (gsize           buffer_size,
+                                                 guint           max_unused);
+
+GLIB_AVAILABLE_IN_2_82
+GBufferPool *   g_buffer_pool_ref               (GBufferPool    *pool);
+
+GLIB_AVAILABLE_IN_2_82
+void            g_buffer_pool_unref             (GBufferPool    *pool);
+
+GLIB_AVAILABLE_IN_2_82
+gsize           g_buffer_pool_get_buffer_size   (GBufferPool    *pool);
+
+GLIB_AVAILABLE_IN_2_82
+gpointer        g_buffer_pool_acquire           (GBufferPool    *pool);
+
+GLIB_AVAILABLE_IN_2_82
+void            g_buffer_pool_release           (GBufferPool    *pool,
+                                                 gpointer        buffer);
+
+GLIB_AVAILABLE_IN_2_82
+GBytes *        g_buffer_pool_new_bytes         (GBufferPool    *pool,
+                                                 gpointer        buffer,
+                                                 gsize           size);
 
 G_END_DECLS
 
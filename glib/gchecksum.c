@@ -22,6 +22,13 @@
 
 #include <string.h>
 
+#ifdef HAVE_X86_SIMD_TARGETS
+#include <immintrin.h>
+#endif
+#ifdef HAVE_ARM_CRYPTO_TARGETS
+#include <arm_neon.h>
+#endif
+
 #include "gchecksum.h"
 
 #include "gslice.h"
@@ -29,6 +36,7 @@
 #include "gstrfuncs.h"
 #include "gtestutils.h"
 #include "gtypes.h"
+#include "gutilsprivate.h"
 #include "glibintl.h"
 
 
@@ -690,6 +698,212 @@ sha1_transform (guint32  buf[5],
 #undef expand
 #undef subRound
 
+/* The hardware implementations below follow the structure of the examples
+ * in the Intel® SHA Extensions white paper (Gulley et al., 2013) and the Arm
+ * Cortex-A Series Programmer’s Guide. They process whole blocks straight
+ * from the input, with the byte swapping done in registers. */
+
+#ifdef HAVE_X86_SHA_TARGETS
+/* Four rounds using @e, which must be the E value from before the previous
+ * four rounds, with the next message words @w. The E value for the next
+ * four rounds is saved in @e_next. */
+#define sha1_rounds_x86(e, e_next, w, f)        G_STMT_START {  \
+    e = _mm_sha1nexte_epu32 (e, w);                             \
+    e_next = abcd;                                              \
+    abcd = _mm_sha1rnds4_epu32 (abcd, e, f); } G_STMT_END
+
+/* Computes the next four message words into @w0 from the last 16 */
+#define sha1_schedule_x86(w0, w1, w2, w3)                       \
+  (w0 = _mm_sha1msg2_epu32 (_mm_xor_si128 (_mm_sha1msg1_epu32 (w0, w1), w2), w3))
+
+__attribute__ ((target ("sha,sse4.1")))
+static void
+sha1_transform_x86 (guint32       buf[5],
+                    const guint8 *data,
+                    gsize         n_blocks)
+{
+  const __m128i byte_swap = _mm_set_epi64x (G_GINT64_CONSTANT (0x0001020304050607),
+                                            G_GINT64_CONSTANT (0x08090a0b0c0d0e0f));
+  __m128i abcd, e0, e1;
+
+  abcd = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i *) buf), 0x1b);
+  e0 = _mm_set_epi32 ((gint32) buf[4], 0, 0, 0);
+
+  for (; n_blocks > 0; n_blocks--, data += SHA1_DATASIZE)
+    {
+      __m128i abcd_save = abcd, e0_save = e0;
+      __m128i w0, w1, w2, w3;
+
+      w0 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *) data), byte_swap);
+      w1 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *) (data + 16)), byte_swap);
+      w2 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *) (data + 32)), byte_swap);
+      w3 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *) (data + 48)), byte_swap);
+
+      /* Rounds 0-15 */
+      e0 = _mm_add_epi32 (e0, w0);
+      e1 = abcd;
+      abcd = _mm_sha1rnds4_epu32 (abcd, e0, 0);
+      sha1_rounds_x86 (e1, e0, w1, 0);
+      sha1_rounds_x86 (e0, e1, w2, 0);
+      sha1_rounds_x86 (e1, e0, w3, 0);
+
+      /* Rounds 16-79, with the rounds function changing every 20 rounds */
+      sha1_schedule_x86 (w0, w1, w2, w3);
+      sha1_rounds_x86 (e0, e1, w0, 0);
+      sha1_schedule_x86 (w1, w2, w3, w0);
+      sha1_rounds_x86 (e1, e0, w1, 1);
+      sha1_schedule_x86 (w2, w3, w0, w1);
+      sha1_rounds_x86 (e0, e1, w2, 1);
+      sha1_schedule_x86 (w3, w0, w1, w2);
+      sha1_rounds_x86 (e1, e0, w3, 1);
+      sha1_schedule_x86 (w0, w1, w2, w3);
+      sha1_rounds_x86 (e0, e1, w0, 1);
+      sha1_schedule_x86 (w1, w2, w3, w0);
+      sha1_rounds_x86 (e1, e0, w1, 1);
+      sha1_schedule_x86 (w2, w3, w0, w1);
+      sha1_rounds_x86 (e0, e1, w2, 2);
+      sha1_schedule_x86 (w3, w0, w1, w2);
+      sha1_rounds_x86 (e1, e0, w3, 2);
+      sha1_schedule_x86 (w0, w1, w2, w3);
+      sha1_rounds_x86 (e0, e1, w0, 2);
+      sha1_schedule_x86 (w1, w2, w3, w0);
+      sha1_rounds_x86 (e1, e0, w1, 2);
+      sha1_schedule_x86 (w2, w3, w0, w1);
+      sha1_rounds_x86 (e0, e1, w2, 2);
+      sha1_schedule_x86 (w3, w0, w1, w2);
+      sha1_rounds_x86 (e1, e0, w3, 3);
+      sha1_schedule_x86 (w0, w1, w2, w3);
+      sha1_rounds_x86 (e0, e1, w0, 3);
+      sha1_schedule_x86 (w1, w2, w3, w0);
+      sha1_rounds_x86 (e1, e0, w1, 3);
+      sha1_schedule_x86 (w2, w3, w0, w1);
+      sha1_rounds_x86 (e0, e1, w2, 3);
+      sha1_schedule_x86 (w3, w0, w1, w2);
+      sha1_rounds_x86 (e1, e0, w3, 3);
+
+      e0 = _mm_sha1nexte_epu32 (e0, e0_save);
+      abcd = _mm_add_epi32 (abcd, abcd_save);
+    }
+
+  _mm_storeu_si128 ((__m128i *) buf, _mm_shuffle_epi32 (abcd, 0x1b));
+  buf[4] = _mm_extract_epi32 (e0, 3);
+}
+
+#undef sha1_rounds_x86
+#undef sha1_schedule_x86
+#endif /* HAVE_X86_SHA_TARGETS */
+
+#ifdef HAVE_ARM_CRYPTO_TARGETS
+/* Four rounds with the message words @w, using the rounds function @op and
+ * the constant @k */
+#define sha1_rounds_arm(op, w, k)               G_STMT_START {  \
+    guint32 e_next = vsha1h_u32 (vgetq_lane_u32 (abcd, 0));     \
+    abcd = op (abcd, e, vaddq_u32 (w, vdupq_n_u32 (k)));        \
+    e = e_next; } G_STMT_END
+
+#define sha1_schedule_arm(w0, w1, w2, w3)                       \
+  (w0 = vsha1su1q_u32 (vsha1su0q_u32 (w0, w1, w2), w3))
+
+__attribute__ ((target ("+crypto")))
+static void
+sha1_transform_arm (guint32       buf[5],
+                    const guint8 *data,
+                    gsize         n_blocks)
+{
+  uint32x4_t abcd = vld1q_u32 (buf);
+  guint32 e = buf[4];
+
+  for (; n_blocks > 0; n_blocks--, data += SHA1_DATASIZE)
+    {
+      uint32x4_t abcd_save = abcd;
+      guint32 e_save = e;
+      uint32x4_t w0, w1, w2, w3;
+
+      w0 = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data)));
+      w1 = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 16)));
+      w2 = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 32)));
+      w3 = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 48)));
+
+      sha1_rounds_arm (vsha1cq_u32, w0, 0x5A827999);
+      sha1_rounds_arm (vsha1cq_u32, w1, 0x5A827999);
+      sha1_rounds_arm (vsha1cq_u32, w2, 0x5A827999);
+      sha1_rounds_arm (vsha1cq_u32, w3, 0x5A827999);
+
+      sha1_schedule_arm (w0, w1, w2, w3);
+      sha1_rounds_arm (vsha1cq_u32, w0, 0x5A827999);
+      sha1_schedule_arm (w1, w2, w3, w0);
+      sha1_rounds_arm (vsha1pq_u32, w1, 0x6ED9EBA1);
+      sha1_schedule_arm (w2, w3, w0, w1);
+      sha1_rounds_arm (vsha1pq_u32, w2, 0x6ED9EBA1);
+      sha1_schedule_arm (w3, w0, w1, w2);
+      sha1_rounds_arm (vsha1pq_u32, w3, 0x6ED9EBA1);
+      sha1_schedule_arm (w0, w1, w2, w3);
+      sha1_rounds_arm (vsha1pq_u32, w0, 0x6ED9EBA1);
+      sha1_schedule_arm (w1, w2, w3, w0);
+      sha1_rounds_arm (vsha1pq_u32, w1, 0x6ED9EBA1);
+      sha1_schedule_arm (w2, w3, w0, w1);
+      sha1_rounds_arm (vsha1mq_u32, w2, 0x8F1BBCDC);
+      sha1_schedule_arm (w3, w0, w1, w2);
+      sha1_rounds_arm (vsha1mq_u32, w3, 0x8F1BBCDC);
+      sha1_schedule_arm (w0, w1, w2, w3);
+      sha1_rounds_arm (vsha1mq_u32, w0, 0x8F1BBCDC);
+      sha1_schedule_arm (w1, w2, w3, w0);
+      sha1_rounds_arm (vsha1mq_u32, w1, 0x8F1BBCDC);
+      sha1_schedule_arm (w2, w3, w0, w1);
+      sha1_rounds_arm (vsha1mq_u32, w2, 0x8F1BBCDC);
+      sha1_schedule_arm (w3, w0, w1, w2);
+      sha1_rounds_arm (vsha1pq_u32, w3, 0xCA62C1D6);
+      sha1_schedule_arm (w0, w1, w2, w3);
+      sha1_rounds_arm (vsha1pq_u32, w0, 0xCA62C1D6);
+      sha1_schedule_arm (w1, w2, w3, w0);
+      sha1_rounds_arm (vsha1pq_u32, w1, 0xCA62C1D6);
+      sha1_schedule_arm (w2, w3, w0, w1);
+      sha1_rounds_arm (vsha1pq_u32, w2, 0xCA62C1D6);
+      sha1_schedule_arm (w3, w0, w1, w2);
+      sha1_rounds_arm (vsha1pq_u32, w3, 0xCA62C1D6);
+
+      abcd = vaddq_u32 (abcd, abcd_save);
+      e += e_save;
+    }
+
+  vst1q_u32 (buf, abcd);
+  buf[4] = e;
+}
+
+#undef sha1_rounds_arm
+#undef sha1_schedule_arm
+#endif /* HAVE_ARM_CRYPTO_TARGETS */
+
+/* Processes @n_blocks whole blocks from @data, which need not be aligned */
+static void
+sha1_transform_blocks (Sha1sum      *sha1,
+                       const guint8 *data,
+                       gsize         n_blocks)
+{
+#ifdef HAVE_X86_SHA_TARGETS
+  if (g_get_cpu_features () & G_CPU_FEATURE_SHA)
+    {
+      sha1_transform_x86 (sha1->buf, data, n_blocks);
+      return;
+    }
+#endif
+#ifdef HAVE_ARM_CRYPTO_TARGETS
+  if (g_get_cpu_features () & G_CPU_FEATURE_SHA)
+    {
+      sha1_transform_arm (sha1->buf, data, n_blocks);
+      return;
+    }
+#endif
+
+  for (; n_blocks > 0; n_blocks--, data += SHA1_DATASIZE)
+    {
+      memcpy (sha1->data, data, SHA1_DATASIZE);
+
+      sha_byte_reverse (sha1->data, SHA1_DATASIZE);
+      sha1_transform (sha1->buf, sha1->data);
+    }
+}
+
 static void
 sha1_sum_update (Sha1sum      *sha1,
                  const guchar *buffer,
@@ -729,15 +943,14 @@ sha1_sum_update (Sha1sum      *sha1,
     }
 
   /* Process data in SHA1_DATASIZE chunks */
-  while (count >= SHA1_DATASIZE)
+  if (count >= SHA1_DATASIZE)
     {
-      memcpy (sha1->data, buffer, SHA1_DATASIZE);
+      gsize n_blocks = count / SHA1_DATASIZE;
 
-      sha_byte_reverse (sha1->data, SHA1_DATASIZE);
-      sha1_transform (sha1->buf, sha1->data);
+      sha1_transform_blocks (sha1, buffer, n_blocks);
 
-      buffer += SHA1_DATASIZE;
-      count -= SHA1_DATASIZE;
+      buffer += n_blocks * SHA1_DATASIZE;
+      count -= n_blocks * SHA1_DATASIZE;
     }
 
   /* Handle any remaining bytes of data. */
@@ -987,6 +1200,182 @@ sha256_transform (guint32      buf[8],
   buf[7] += H;
 }
 
+#if defined (HAVE_X86_SHA_TARGETS) || defined (HAVE_ARM_CRYPTO_TARGETS)
+static const guint32 sha256_k[64] = {
+  0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5,
+  0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+  0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+  0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+  0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC,
+  0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+  0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7,
+  0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+  0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+  0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+  0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3,
+  0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+  0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5,
+  0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+  0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+  0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+#endif
+
+#ifdef HAVE_X86_SHA_TARGETS
+/* Four rounds with the message words @w and the constants from @k */
+#define sha256_rounds_x86(w, k)                 G_STMT_START {          \
+    __m128i wk = _mm_add_epi32 (w, _mm_loadu_si128 ((const __m128i *) (k))); \
+    cdgh = _mm_sha256rnds2_epu32 (cdgh, abef, wk);                      \
+    abef = _mm_sha256rnds2_epu32 (abef, cdgh, _mm_shuffle_epi32 (wk, 0x0e)); } G_STMT_END
+
+/* Computes the next four message words into @w0 from the last 16 */
+#define sha256_schedule_x86(w0, w1, w2, w3)                             \
+  (w0 = _mm_sha256msg2_epu32 (_mm_add_epi32 (_mm_sha256msg1_epu32 (w0, w1), \
+                                             _mm_alignr_epi8 (w3, w2, 4)), w3))
+
+__attribute__ ((target ("sha,sse4.1")))
+static void
+sha256_transform_x86 (guint32       buf[8],
+                      const guint8 *data,
+                      gsize         n_blocks)
+{
+  const __m128i byte_swap = _mm_set_epi64x (G_GINT64_CONSTANT (0x0c0d0e0f08090a0b),
+                                            G_GINT64_CONSTANT (0x0405060700010203));
+  __m128i abef, cdgh, tmp;
+
+  /* The instructions work on the state as (A, B, E, F) and (C, D, G, H) */
+  tmp = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i *) buf), 0xb1);
+  cdgh = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i *) (buf + 4)), 0x1b);
+  abef = _mm_alignr_epi8 (tmp, cdgh, 8);
+  cdgh = _mm_blend_epi16 (cdgh, tmp, 0xf0);
+
+  for (; n_blocks > 0; n_blocks--, data += SHA256_DATASIZE)
+    {
+      __m128i abef_save = abef, cdgh_save = cdgh;
+      __m128i w0, w1, w2, w3;
+      gint i;
+
+      w0 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *) data), byte_swap);
+      w1 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *) (data + 16)), byte_swap);
+      w2 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *) (data + 32)), byte_swap);
+      w3 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *) (data + 48)), byte_swap);
+
+      sha256_rounds_x86 (w0, sha256_k);
+      sha256_rounds_x86 (w1, sha256_k + 4);
+      sha256_rounds_x86 (w2, sha256_k + 8);
+      sha256_rounds_x86 (w3, sha256_k + 12);
+
+      for (i = 16; i < 64; i += 16)
+        {
+          sha256_schedule_x86 (w0, w1, w2, w3);
+          sha256_rounds_x86 (w0, sha256_k + i);
+          sha256_schedule_x86 (w1, w2, w3, w0);
+          sha256_rounds_x86 (w1, sha256_k + i + 4);
+          sha256_schedule_x86 (w2, w3, w0, w1);
+          sha256_rounds_x86 (w2, sha256_k + i + 8);
+          sha256_schedule_x86 (w3, w0, w1, w2);
+          sha256_rounds_x86 (w3, sha256_k + i + 12);
+        }
+
+      abef = _mm_add_epi32 (abef, abef_save);
+      cdgh = _mm_add_epi32 (cdgh, cdgh_save);
+    }
+
+  tmp = _mm_shuffle_epi32 (abef, 0x1b);
+  cdgh = _mm_shuffle_epi32 (cdgh, 0xb1);
+  _mm_storeu_si128 ((__m128i *) buf, _mm_blend_epi16 (tmp, cdgh, 0xf0));
+  _mm_storeu_si128 ((__m128i *) (buf + 4), _mm_alignr_epi8 (cdgh, tmp, 8));
+}
+
+#undef sha256_rounds_x86
+#undef sha256_schedule_x86
+#endif /* HAVE_X86_SHA_TARGETS */
+
+#ifdef HAVE_ARM_CRYPTO_TARGETS
+/* Four rounds with the message words @w and the constants from @k */
+#define sha256_rounds_arm(w, k)                 G_STMT_START {  \
+    uint32x4_t wk = vaddq_u32 (w, vld1q_u32 (k));               \
+    uint32x4_t abcd_prev = abcd;                                \
+    abcd = vsha256hq_u32 (abcd, efgh, wk);                      \
+    efgh = vsha256h2q_u32 (efgh, abcd_prev, wk); } G_STMT_END
+
+#define sha256_schedule_arm(w0, w1, w2, w3)                     \
+  (w0 = vsha256su1q_u32 (vsha256su0q_u32 (w0, w1), w2, w3))
+
+__attribute__ ((target ("+crypto")))
+static void
+sha256_transform_arm (guint32       buf[8],
+                      const guint8 *data,
+                      gsize         n_blocks)
+{
+  uint32x4_t abcd = vld1q_u32 (buf);
+  uint32x4_t efgh = vld1q_u32 (buf + 4);
+
+  for (; n_blocks > 0; n_blocks--, data += SHA256_DATASIZE)
+    {
+      uint32x4_t abcd_save = abcd, efgh_save = efgh;
+      uint32x4_t w0, w1, w2, w3;
+      gint i;
+
+      w0 = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data)));
+      w1 = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 16)));
+      w2 = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 32)));
+      w3 = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 48)));
+
+      sha256_rounds_arm (w0, sha256_k);
+      sha256_rounds_arm (w1, sha256_k + 4);
+      sha256_rounds_arm (w2, sha256_k + 8);
+      sha256_rounds_arm (w3, sha256_k + 12);
+
+      for (i = 16; i < 64; i += 16)
+        {
+          sha256_schedule_arm (w0, w1, w2, w3);
+          sha256_rounds_arm (w0, sha256_k + i);
+          sha256_schedule_arm (w1, w2, w3, w0);
+          sha256_rounds_arm (w1, sha256_k + i + 4);
+          sha256_schedule_arm (w2, w3, w0, w1);
+          sha256_rounds_arm (w2, sha256_k + i + 8);
+          sha256_schedule_arm (w3, w0, w1, w2);
+          sha256_rounds_arm (w3, sha256_k + i + 12);
+        }
+
+      abcd = vaddq_u32 (abcd, abcd_save);
+      efgh = vaddq_u32 (efgh, efgh_save);
+    }
+
+  vst1q_u32 (buf, abcd);
+  vst1q_u32 (buf + 4, efgh);
+}
+
+#undef sha256_rounds_arm
+#undef sha256_schedule_arm
+#endif /* HAVE_ARM_CRYPTO_TARGETS */
+
+/* Processes @n_blocks whole blocks from @data, which need not be aligned */
+static void
+sha256_transform_blocks (guint32       buf[8],
+                         const guint8 *data,
+                         gsize         n_blocks)
+{
+#ifdef HAVE_X86_SHA_TARGETS
+  if (g_get_cpu_features () & G_CPU_FEATURE_SHA)
+    {
+      sha256_transform_x86 (buf, data, n_blocks);
+      return;
+    }
+#endif
+#ifdef HAVE_ARM_CRYPTO_TARGETS
+  if (g_get_cpu_features () & G_CPU_FEATURE_SHA)
+    {
+      sha256_transform_arm (buf, data, n_blocks);
+      return;
+    }
+#endif
+
+  for (; n_blocks > 0; n_blocks--, data += SHA256_DATASIZE)
+    sha256_transform (buf, data);
+}
+
 static void
 sha256_sum_update (Sha256sum    *sha256,
                    const guchar *buffer,
@@ -1011,19 +1400,21 @@ sha256_sum_update (Sha256sum    *sha256,
     {
       memcpy ((sha256->data + left), input, fill);
 
-      sha256_transform (sha256->buf, sha256->data);
+      sha256_transform_blocks (sha256->buf, sha256->data, 1);
       length -= fill;
       input += fill;
 
       left = 0;
     }
 
-  while (length >= SHA256_DATASIZE)
+  if (length >= SHA256_DATASIZE)
     {
-      sha256_transform (sha256->buf, input);
+      gsize n_blocks = length / SHA256_DATASIZE;
+
+      sha256_transform_blocks (sha256->buf, input, n_blocks);
 
-      length -= 64;
-      input += 64;
+      length -= n_blocks * SHA256_DATASIZE;
+      input += n_blocks * SHA256_DATASIZE;
     }
 
   if (length)
@@ -1272,6 +1663,136 @@ sha512_transform (guint64      H[8],
   H[7] += h;
 }
 
+#ifdef HAVE_X86_SIMD_TARGETS
+/* sigma0() and sigma1() on four message words */
+#define ROTR_AVX2(n,x)  (_mm256_or_si256 (_mm256_srli_epi64 (x, n), _mm256_slli_epi64 (x, 64 - n)))
+#define sigma0_avx2(x)  (_mm256_xor_si256 (_mm256_xor_si256 (ROTR_AVX2 ( 1, x), ROTR_AVX2 ( 8, x)), \
+                                           _mm256_srli_epi64 (x, 7)))
+#define sigma1_avx2(x)  (_mm256_xor_si256 (_mm256_xor_si256 (ROTR_AVX2 (19, x), ROTR_AVX2 (61, x)), \
+                                           _mm256_srli_epi64 (x, 6)))
+
+/* Computes the next four message words into @w0 from the last 16. The
+ * last two depend on the first two through sigma1(), so that is done in
+ * two halves. */
+#define sha512_schedule_avx2(w0, w1, w2, w3)                    G_STMT_START {  \
+    __m256i w15 = _mm256_permute4x64_epi64 (_mm256_blend_epi32 (w0, w1, 0x03), 0x39); \
+    __m256i w7 = _mm256_permute4x64_epi64 (_mm256_blend_epi32 (w2, w3, 0x03), 0x39); \
+    __m256i sum = _mm256_add_epi64 (_mm256_add_epi64 (w0, w7), sigma0_avx2 (w15)); \
+    __m256i lo = _mm256_add_epi64 (sum, sigma1_avx2 (_mm256_permute4x64_epi64 (w3, 0x0e))); \
+    __m256i hi = _mm256_add_epi64 (sum, sigma1_avx2 (_mm256_permute4x64_epi64 (lo, 0x40))); \
+    w0 = _mm256_blend_epi32 (lo, hi, 0xf0); } G_STMT_END
+
+/* One round, with @wk already containing the constant */
+#define sha512_round(a,b,c,d,e,f,g,h,wk)        G_STMT_START {  \
+    guint64 T1 = h + SIGMA1 (e) + Ch (e, f, g) + (wk);          \
+    d += T1;                                                    \
+    h = T1 + SIGMA0 (a) + Maj (a, b, c); } G_STMT_END
+
+/* This computes the message schedule four words at a time, and leaves the
+ * rounds to scalar code, which can use the BMI2 rotate instructions */
+__attribute__ ((target ("avx2,bmi2")))
+static void
+sha512_transform_avx2 (guint64       H[8],
+                       const guint8 *data,
+                       gsize         n_blocks)
+{
+  const __m256i byte_swap = _mm256_setr_epi8 (7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                              7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+  for (; n_blocks > 0; n_blocks--, data += SHA2_BLOCK_LEN)
+    {
+      guint64 WK[80];
+      guint64 a, b, c, d, e, f, g, h;
+      __m256i w0, w1, w2, w3;
+      gint t;
+
+      w0 = _mm256_shuffle_epi8 (_mm256_loadu_si256 ((const __m256i *) data), byte_swap);
+      w1 = _mm256_shuffle_epi8 (_mm256_loadu_si256 ((const __m256i *) (data + 32)), byte_swap);
+      w2 = _mm256_shuffle_epi8 (_mm256_loadu_si256 ((const __m256i *) (data + 64)), byte_swap);
+      w3 = _mm256_shuffle_epi8 (_mm256_loadu_si256 ((const __m256i *) (data + 96)), byte_swap);
+
+      for (t = 0; t < 80; t += 16)
+        {
+          if (t > 0)
+            sha512_schedule_avx2 (w0, w1, w2, w3);
+          _mm256_storeu_si256 ((__m256i *) (WK + t),
+                               _mm256_add_epi64 (w0, _mm256_loadu_si256 ((const __m256i *) (SHA2_K + t))));
+          if (t > 0)
+            sha512_schedule_avx2 (w1, w2, w3, w0);
+          _mm256_storeu_si256 ((__m256i *) (WK + t + 4),
+                               _mm256_add_epi64 (w1, _mm256_loadu_si256 ((const __m256i *) (SHA2_K + t + 4))));
+          if (t > 0)
+            sha512_schedule_avx2 (w2, w3, w0, w1);
+          _mm256_storeu_si256 ((__m256i *) (WK + t + 8),
+                               _mm256_add_epi64 (w2, _mm256_loadu_si256 ((const __m256i *) (SHA2_K + t + 8))));
+          if (t > 0)
+            sha512_schedule_avx2 (w3, w0, w1, w2);
+          _mm256_storeu_si256 ((__m256i *) (WK + t + 12),
+                               _mm256_add_epi64 (w3, _mm256_loadu_si256 ((const __m256i *) (SHA2_K + t + 12))));
+        }
+
+      a = H[0];
+      b = H[1];
+      c = H[2];
+      d = H[3];
+      e = H[4];
+      f = H[5];
+      g = H[6];
+      h = H[7];
+
+      for (t = 0; t < 80; t += 8)
+        {
+          sha512_round (a, b, c, d, e, f, g, h, WK[t]);
+          sha512_round (h, a, b, c, d, e, f, g, WK[t + 1]);
+          sha512_round (g, h, a, b, c, d, e, f, WK[t + 2]);
+          sha512_round (f, g, h, a, b, c, d, e, WK[t + 3]);
+          sha512_round (e, f, g, h, a, b, c, d, WK[t + 4]);
+          sha512_round (d, e, f, g, h, a, b, c, WK[t + 5]);
+          sha512_round (c, d, e, f, g, h, a, b, WK[t + 6]);
+          sha512_round (b, c, d, e, f, g, h, a, WK[t + 7]);
+        }
+
+      H[0] += a;
+      H[1] += b;
+      H[2] += c;
+      H[3] += d;
+      H[4] += e;
+      H[5] += f;
+      H[6] += g;
+      H[7] += h;
+    }
+
+  /* Avoid penalties in any following SSE code */
+  _mm256_zeroupper ();
+}
+
+#undef ROTR_AVX2
+#undef sigma0_avx2
+#undef sigma1_avx2
+#undef sha512_schedule_avx2
+#undef sha512_round
+#endif /* HAVE_X86_SIMD_TARGETS */
+
+/* Processes @n_blocks whole blocks from @data, which need not be aligned */
+static void
+sha512_transform_blocks (guint64       H[8],
+                         const guint8 *data,
+                         gsize         n_blocks)
+{
+#ifdef HAVE_X86_SIMD_TARGETS
+  const GCpuFeatures avx2_bmi2 = G_CPU_FEATURE_AVX2 | G_CPU_FEATURE_BMI2;
+
+  if ((g_get_cpu_features () & avx2_bmi2) == avx2_bmi2)
+    {
+      sha512_transform_avx2 (H, data, n_blocks);
+      return;
+    }
+#endif
+
+  for (; n_blocks > 0; n_blocks--, data += SHA2_BLOCK_LEN)
+    sha512_transform (H, data);
+}
+
 static void
 sha512_sum_update (Sha512sum    *sha512,
                    const guchar *buffer,
@@ -1300,20 +1821,20 @@ sha512_sum_update (Sha512sum    *sha512,
 
       if (sha512->block_len == SHA2_BLOCK_LEN)
         {
-          sha512_transform (sha512->H, sha512->block);
+          sha512_transform_blocks (sha512->H, sha512->block, 1);
           sha512->block_len = 0;
         }
     }
 
   /* process complete blocks */
-  while (length >= SHA2_BLOCK_LEN)
+  if (length >= SHA2_BLOCK_LEN)
     {
-      memcpy (sha512->block, buffer + offset, SHA2_BLOCK_LEN);
+      gsize n_blocks = length / SHA2_BLOCK_LEN;
 
-      sha512_transform (sha512->H, sha512->block);
+      sha512_transform_blocks (sha512->H, buffer + offset, n_blocks);
 
-      length -= SHA2_BLOCK_LEN;
-      offset += SHA2_BLOCK_LEN;
+      length -= n_blocks * SHA2_BLOCK_LEN;
+      offset += n_blocks * SHA2_BLOCK_LEN;
     }
 
   /* keep remaining data for next block */
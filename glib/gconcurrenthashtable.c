@@ -0,0 +1,507 @@
+/* gconcurrenthashtable.c: Thread-safe, read-mostly hash table
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gconcurrenthashtable.h"
+
+#include "gmem.h"
+#include "grefcount.h"
+#include "gtestutils.h"
+#include "gthread.h"
+#include "gutils.h"
+
+/**
+ * GConcurrentHashTable:
+ *
+ * `GConcurrentHashTable` is a hash table which can be used from several
+ * threads at once without external locking.
+ *
+ * It uses the same hash and equality functions as [struct@GLib.HashTable],
+ * and calls the destroy notify functions in the same situations, but always
+ * outside of its internal locks, so they may safely call back into the table.
+ *
+ * Entries are spread over a number of shards, each protected by its own
+ * [struct@GLib.RWLock], so that threads working on different keys rarely
+ * contend, and lookups of the same key only take a reader lock. This makes
+ * it well suited to caches and registries which are read much more often
+ * than they are modified.
+ *
+ * As values may be removed and destroyed by another thread at any time,
+ * the value returned by [method@GLib.ConcurrentHashTable.lookup] is only
+ * safe to use if the caller knows it can’t be removed concurrently. Use
+ * [method@GLib.ConcurrentHashTable.lookup_copy] to get a reference or copy
+ * made while the entry is guaranteed to exist.
+ *
+ * Since: 2.82
+ */
+
+/* Padded to a cache line so that locking one shard doesn't bounce the lines
+ * of its neighbours */
+#define SHARD_ALIGNMENT 64
+
+typedef struct
+{
+  GRWLock lock;
+  GHashTable *table;  /* (owned), has no destroy functions */
+  gchar padding[SHARD_ALIGNMENT - sizeof (GRWLock) - sizeof (GHashTable *)];
+} GConcurrentHashShard;
+
+G_STATIC_ASSERT (sizeof (GConcurrentHashShard) == SHARD_ALIGNMENT);
+
+struct _GConcurrentHashTable
+{
+  GConcurrentHashShard *shards;  /* (array length=n_shards) */
+  guint shard_shift;  /* n_shards == 1 << shard_shift */
+
+  GHashFunc hash_func;
+  GEqualFunc key_equal_func;
+  GDestroyNotify key_destroy_func;
+  GDestroyNotify value_destroy_func;
+
+  gatomicrefcount ref_count;
+};
+
+static inline GConcurrentHashShard *
+g_concurrent_hash_table_get_shard (GConcurrentHashTable *hash_table,
+                                   gconstpointer         key)
+{
+  guint hash = hash_table->hash_func (key);
+
+  /* The top bits of a multiplicative hash, as the shard’s GHashTable
+   * distributes entries using the low ones */
+  if (hash_table->shard_shift == 0)
+    return &hash_table->shards[0];
+
+  return &hash_table->shards[(hash * 0x9E3779B1U) >> (32 - hash_table->shard_shift)];
+}
+
+/**
+ * g_concurrent_hash_table_new:
+ * @hash_func: a function to create a hash value from a key
+ * @key_equal_func: a function to check two keys for equality
+ * @key_destroy_func: (nullable): a function to free the memory allocated
+ *     for the key used when removing the entry, or %NULL
+ * @value_destroy_func: (nullable): a function to free the memory allocated
+ *     for the value used when removing the entry, or %NULL
+ *
+ * Creates a new #GConcurrentHashTable with a reference count of 1.
+ *
+ * The functions behave as for g_hash_table_new_full(). @hash_func and
+ * @key_equal_func may be called from any thread, concurrently. The destroy
+ * functions are called from the thread removing or replacing the entry.
+ *
+ * Returns: (transfer full): a new #GConcurrentHashTable
+ *
+ * Since: 2.82
+ */
+GConcurrentHashTable *
+g_concurrent_hash_table_new (GHashFunc      hash_func,
+                             GEqualFunc     key_equal_func,
+                             GDestroyNotify key_destroy_func,
+                             GDestroyNotify value_destroy_func)
+{
+  GConcurrentHashTable *hash_table;
+  guint n_shards, i;
+
+  hash_table = g_new0 (GConcurrentHashTable, 1);
+  g_atomic_ref_count_init (&hash_table->ref_count);
+  hash_table->hash_func = hash_func ? hash_func : g_direct_hash;
+  hash_table->key_equal_func = key_equal_func;
+  hash_table->key_destroy_func = key_destroy_func;
+  hash_table->value_destroy_func = value_destroy_func;
+
+  /* A few shards per processor keeps the chance of two threads wanting
+   * the same one low */
+  n_shards = CLAMP (4 * g_get_num_processors (), 4, 256);
+  while ((1U << hash_table->shard_shift) < n_shards)
+    hash_table->shard_shift++;
+  n_shards = 1U << hash_table->shard_shift;
+
+  hash_table->shards = g_aligned_alloc0 (n_shards, sizeof (GConcurrentHashShard),
+                                         SHARD_ALIGNMENT);
+
+  for (i = 0; i < n_shards; i++)
+    {
+      g_rw_lock_init (&hash_table->shards[i].lock);
+      hash_table->shards[i].table = g_hash_table_new (hash_table->hash_func,
+                                                      key_equal_func);
+    }
+
+  return hash_table;
+}
+
+/**
+ * g_concurrent_hash_table_ref:
+ * @hash_table: a #GConcurrentHashTable
+ *
+ * Atomically increments the reference count of @hash_table by one.
+ *
+ * Returns: (transfer full): the passed in #GConcurrentHashTable
+ *
+ * Since: 2.82
+ */
+GConcurrentHashTable *
+g_concurrent_hash_table_ref (GConcurrentHashTable *hash_table)
+{
+  g_return_val_if_fail (hash_table != NULL, NULL);
+
+  g_atomic_ref_count_inc (&hash_table->ref_count);
+
+  return hash_table;
+}
+
+static void
+destroy_entries (GConcurrentHashTable *hash_table,
+                 GHashTable           *table)
+{
+  GHashTableIter iter;
+  gpointer key, value;
+
+  if (hash_table->key_destroy_func != NULL ||
+      hash_table->value_destroy_func != NULL)
+    {
+      g_hash_table_iter_init (&iter, table);
+      while (g_hash_table_iter_next (&iter, &key, &value))
+        {
+          if (hash_table->key_destroy_func != NULL)
+            hash_table->key_destroy_func (key);
+          if (hash_table->value_destroy_func != NULL)
+            hash_table->value_destroy_func (value);
+        }
+    }
+
+  g_hash_table_unref (table);
+}
+
+/**
+ * g_concurrent_hash_table_unref:
+ * @hash_table: (transfer full): a #GConcurrentHashTable
+ *
+ * Atomically decrements the reference count of @hash_table by one.
+ *
+ * If the reference count drops to 0, all keys and values will be
+ * destroyed, and all memory allocated by the hash table is released.
+ *
+ * Since: 2.82
+ */
+void
+g_concurrent_hash_table_unref (GConcurrentHashTable *hash_table)
+{
+  guint i;
+
+  g_return_if_fail (hash_table != NULL);
+
+  if (!g_atomic_ref_count_dec (&hash_table->ref_count))
+    return;
+
+  for (i = 0; i < (1U << hash_table->shard_shift); i++)
+    {
+      destroy_entries (hash_table, hash_table->shards[i].table);
+      g_rw_lock_clear (&hash_table->shards[i].lock);
+    }
+
+  g_aligned_free (hash_table->shards);
+  g_free (hash_table);
+}
+
+/**
+ * g_concurrent_hash_table_insert:
+ * @hash_table: a #GConcurrentHashTable
+ * @key: (transfer full): a key to insert
+ * @value: (transfer full): the value to associate with the key
+ *
+ * Inserts a new key and value into @hash_table, as g_hash_table_insert()
+ * does.
+ *
+ * If the key already exists, its current value is replaced with the new
+ * value, and the passed key is freed using the key destroy function if
+ * one was given. The old value is freed using the value destroy function.
+ *
+ * Returns: %TRUE if the key did not exist yet
+ *
+ * Since: 2.82
+ */
+gboolean
+g_concurrent_hash_table_insert (GConcurrentHashTable *hash_table,
+                                gpointer              key,
+                                gpointer              value)
+{
+  GConcurrentHashShard *shard;
+  gpointer old_key, old_value;
+  gboolean exists;
+
+  g_return_val_if_fail (hash_table != NULL, FALSE);
+
+  shard = g_concurrent_hash_table_get_shard (hash_table, key);
+
+  g_rw_lock_writer_lock (&shard->lock);
+
+  exists = g_hash_table_lookup_extended (shard->table, key, &old_key, &old_value);
+  g_hash_table_insert (shard->table, exists ? old_key : key, value);
+
+  g_rw_lock_writer_unlock (&shard->lock);
+
+  if (exists)
+    {
+      if (hash_table->key_destroy_func != NULL)
+        hash_table->key_destroy_func (key);
+      if (hash_table->value_destroy_func != NULL)
+        hash_table->value_destroy_func (old_value);
+    }
+
+  return !exists;
+}
+
+/**
+ * g_concurrent_hash_table_remove:
+ * @hash_table: a #GConcurrentHashTable
+ * @key: the key to remove
+ *
+ * Removes a key and its associated value from @hash_table, calling the
+ * destroy functions if they were given.
+ *
+ * Returns: %TRUE if the key was found and removed
+ *
+ * Since: 2.82
+ */
+gboolean
+g_concurrent_hash_table_remove (GConcurrentHashTable *hash_table,
+                                gconstpointer         key)
+{
+  GConcurrentHashShard *shard;
+  gpointer old_key, old_value;
+  gboolean found;
+
+  g_return_val_if_fail (hash_table != NULL, FALSE);
+
+  shard = g_concurrent_hash_table_get_shard (hash_table, key);
+
+  g_rw_lock_writer_lock (&shard->lock);
+  found = g_hash_table_steal_extended (shard->table, key, &old_key, &old_value);
+  g_rw_lock_writer_unlock (&shard->lock);
+
+  if (found)
+    {
+      if (hash_table->key_destroy_func != NULL)
+        hash_table->key_destroy_func (old_key);
+      if (hash_table->value_destroy_func != NULL)
+        hash_table->value_destroy_func (old_value);
+    }
+
+  return found;
+}
+
+/**
+ * g_concurrent_hash_table_remove_all:
+ * @hash_table: a #GConcurrentHashTable
+ *
+ * Removes all keys and their associated values from @hash_table, calling
+ * the destroy functions if they were given.
+ *
+ * Entries inserted concurrently may or may not be removed.
+ *
+ * Since: 2.82
+ */
+void
+g_concurrent_hash_table_remove_all (GConcurrentHashTable *hash_table)
+{
+  guint i;
+
+  g_return_if_fail (hash_table != NULL);
+
+  for (i = 0; i < (1U << hash_table->shard_shift); i++)
+    {
+      GConcurrentHashShard *shard = &hash_table->shards[i];
+      GHashTable *old_table;
+
+      g_rw_lock_writer_lock (&shard->lock);
+      old_table = shard->table;
+      shard->table = g_hash_table_new_similar (old_table);
+      g_rw_lock_writer_unlock (&shard->lock);
+
+      destroy_entries (hash_table, old_table);
+    }
+}
+
+/**
+ * g_concurrent_hash_table_lookup:
+ * @hash_table: a #GConcurrentHashTable
+ * @key: the key to look up
+ *
+ * Looks up a key in @hash_table.
+ *
+ * The returned value is not protected against being removed and destroyed
+ * by another thread; only use this function if that can’t happen, for
+ * example because values are never removed, or are owned elsewhere.
+ * Otherwise, use g_concurrent_hash_table_lookup_copy().
+ *
+ * Returns: (nullable) (transfer none): the associated value, or %NULL if the
+ *   key is not found
+ *
+ * Since: 2.82
+ */
+gpointer
+g_concurrent_hash_table_lookup (GConcurrentHashTable *hash_table,
+                                gconstpointer         key)
+{
+  return g_concurrent_hash_table_lookup_copy (hash_table, key, NULL, NULL);
+}
+
+/**
+ * g_concurrent_hash_table_lookup_copy:
+ * @hash_table: a #GConcurrentHashTable
+ * @key: the key to look up
+ * @copy_func: (nullable) (scope call): a function to copy or reference
+ *   the value, or %NULL
+ * @user_data: data to pass to @copy_func
+ *
+ * Looks up a key in @hash_table and, if it is found, calls @copy_func on
+ * its value while the entry can’t be removed, returning the result.
+ *
+ * @copy_func is called with a reader lock held, so it must be quick, and
+ * must not call into @hash_table. Typically it acquires a reference on the
+ * value, as g_object_ref() or g_rc_box_acquire() do.
+ *
+ * If @copy_func is %NULL, this is the same as
+ * g_concurrent_hash_table_lookup().
+ *
+ * Returns: (nullable) (transfer full): the copied value, or %NULL if the
+ *   key is not found
+ *
+ * Since: 2.82
+ */
+gpointer
+g_concurrent_hash_table_lookup_copy (GConcurrentHashTable *hash_table,
+                                     gconstpointer         key,
+                                     GCopyFunc             copy_func,
+                                     gpointer              user_data)
+{
+  GConcurrentHashShard *shard;
+  gpointer value;
+  gboolean found;
+
+  g_return_val_if_fail (hash_table != NULL, NULL);
+
+  shard = g_concurrent_hash_table_get_shard (hash_table, key);
+
+  g_rw_lock_reader_lock (&shard->lock);
+
+  found = g_hash_table_lookup_extended (shard->table, key, NULL, &value);
+  if (found && copy_func != NULL)
+    value = copy_func (value, user_data);
+
+  g_rw_lock_reader_unlock (&shard->lock);
+
+  return found ? value : NULL;
+}
+
+/**
+ * g_concurrent_hash_table_contains:
+ * @hash_table: a #GConcurrentHashTable
+ * @key: the key to check
+ *
+ * Checks if @key is in @hash_table.
+ *
+ * Returns: %TRUE if @key is in @hash_table
+ *
+ * Since: 2.82
+ */
+gboolean
+g_concurrent_hash_table_contains (GConcurrentHashTable *hash_table,
+                                  gconstpointer         key)
+{
+  GConcurrentHashShard *shard;
+  gboolean found;
+
+  g_return_val_if_fail (hash_table != NULL, FALSE);
+
+  shard = g_concurrent_hash_table_get_shard (hash_table, key);
+
+  g_rw_lock_reader_lock (&shard->lock);
+  found = g_hash_table_contains (shard->table, key);
+  g_rw_lock_reader_unlock (&shard->lock);
+
+  return found;
+}
+
+/**
+ * g_concurrent_hash_table_size:
+ * @hash_table: a #GConcurrentHashTable
+ *
+ * Returns the number of elements contained in @hash_table.
+ *
+ * If the table is being modified concurrently, the result is only an
+ * approximation.
+ *
+ * Returns: the number of key/value pairs in @hash_table
+ *
+ * Since: 2.82
+ */
+guint
+g_concurrent_hash_table_size (GConcurrentHashTable *hash_table)
+{
+  guint i, size = 0;
+
+  g_return_val_if_fail (hash_table != NULL, 0);
+
+  for (i = 0; i < (1U << hash_table->shard_shift); i++)
+    {
+      GConcurrentHashShard *shard = &hash_table->shards[i];
+
+      g_rw_lock_reader_lock (&shard->lock);
+      size += g_hash_table_size (shard->table);
+      g_rw_lock_reader_unlock (&shard->lock);
+    }
+
+  return size;
+}
+
+/**
+ * g_concurrent_hash_table_foreach:
+ * @hash_table: a #GConcurrentHashTable
+ * @func: (scope call): the function to call for each key/value pair
+ * @user_data: user data to pass to the function
+ *
+ * Calls the given function for each of the key/value pairs in @hash_table.
+ *
+ * The table is locked one shard at a time, so @func sees a consistent view
+ * of each shard, but not necessarily of the whole table. @func must not call
+ * into @hash_table.
+ *
+ * Since: 2.82
+ */
+void
+g_concurrent_hash_table_foreach (GConcurrentHashTable *hash_table,
+                                 GHFunc                func,
+                                 gpointer              user_data)
+{
+  guint i;
+
+  g_return_if_fail (hash_table != NULL);
+  g_return_if_fail (func != NULL);
+
+  for (i = 0; i < (1U << hash_table->shard_shift); i++)
+    {
+      GConcurrentHashShard *shard = &hash_table->shards[i];
+
+      g_rw_lock_reader_lock (&shard->lock);
+      g_hash_table_foreach (shard->table, func, user_data);
+      g_rw_lock_reader_unlock (&shard->lock);
+    }
+}
@@ -51,6 +51,7 @@
 #include "gthread.h"
 #include "gthreadprivate.h"
 #include "gunicode.h"
+#include "gunicodeprivate.h"
 #include "gfileutils.h"
 #include "genviron.h"
 
@@ -214,6 +215,199 @@ g_iconv_close (GIConv converter)
   return iconv_close (cd);
 }
 
+/* A per-thread cache of open converters, most recently used first, so that
+ * converting lots of short strings doesn't open a converter every time.
+ * g_iconv_open() can be expensive: with glibc, it looks up and loads gconv
+ * modules.
+ *
+ * Converters are taken out of the cache while they are in use, so a pair of
+ * codesets can be in use more than once at a time, and a converter can be
+ * put back from another thread. The slot it came from keeps the codeset
+ * names, so putting it back in the same thread doesn't allocate. */
+#define ICONV_CACHE_SIZE 8
+
+typedef struct
+{
+  gchar *to_codeset;
+  gchar *from_codeset;
+  GIConv cd;  /* (GIConv) -1 while the converter is in use */
+} IConvCacheEntry;
+
+typedef struct
+{
+  IConvCacheEntry entries[ICONV_CACHE_SIZE];
+  guint n_entries;
+} IConvCache;
+
+static void
+iconv_cache_entry_clear (IConvCacheEntry *entry)
+{
+  if (entry->cd != (GIConv) -1)
+    g_iconv_close (entry->cd);
+  g_free (entry->to_codeset);
+  g_free (entry->from_codeset);
+}
+
+static void
+iconv_cache_free (gpointer data)
+{
+  IConvCache *cache = data;
+  guint i;
+
+  for (i = 0; i < cache->n_entries; i++)
+    iconv_cache_entry_clear (&cache->entries[i]);
+
+  g_free (cache);
+}
+
+static GPrivate iconv_cache_private = G_PRIVATE_INIT (iconv_cache_free);
+
+static IConvCache *
+iconv_cache_get (void)
+{
+  IConvCache *cache = g_private_get (&iconv_cache_private);
+
+  if (G_UNLIKELY (cache == NULL))
+    {
+      cache = g_new0 (IConvCache, 1);
+      g_private_set (&iconv_cache_private, cache);
+    }
+
+  return cache;
+}
+
+/* Decoders for byte-order-detecting codesets such as plain "UTF-16" remember
+ * the byte order of the first BOM they saw, and resetting the shift state
+ * doesn't make them forget it; so converters involving them can't be reused. */
+static gboolean
+iconv_cache_codeset_is_reusable (const gchar *codeset)
+{
+  static const gchar * const prefixes[] = {
+    "UTF-16", "UTF16", "UTF-32", "UTF32", "UCS-2", "UCS2", "UCS-4", "UCS4", "UNICODE",
+  };
+  gsize len = strlen (codeset);
+  gsize i;
+
+  if (len > 2 &&
+      (g_ascii_strcasecmp (codeset + len - 2, "LE") == 0 ||
+       g_ascii_strcasecmp (codeset + len - 2, "BE") == 0))
+    return TRUE;
+
+  for (i = 0; i < G_N_ELEMENTS (prefixes); i++)
+    if (g_ascii_strncasecmp (codeset, prefixes[i], strlen (prefixes[i])) == 0)
+      return FALSE;
+
+  return TRUE;
+}
+
+/* Finds the entry for a pair of codesets whose converter is in the cache, if
+ * @in_use is %FALSE, or has been taken out, if it is %TRUE; and moves it to
+ * the front. */
+static IConvCacheEntry *
+iconv_cache_lookup (IConvCache  *cache,
+                    const gchar *to_codeset,
+                    const gchar *from_codeset,
+                    gboolean     in_use)
+{
+  guint i;
+
+  for (i = 0; i < cache->n_entries; i++)
+    {
+      IConvCacheEntry *entry = &cache->entries[i];
+
+      if ((entry->cd == (GIConv) -1) == in_use &&
+          strcmp (entry->to_codeset, to_codeset) == 0 &&
+          strcmp (entry->from_codeset, from_codeset) == 0)
+        {
+          IConvCacheEntry found = *entry;
+
+          memmove (&cache->entries[1], &cache->entries[0], i * sizeof (IConvCacheEntry));
+          cache->entries[0] = found;
+
+          return &cache->entries[0];
+        }
+    }
+
+  return NULL;
+}
+
+/*
+ * g_iconv_cache_take:
+ * @to_codeset: destination codeset
+ * @from_codeset: source codeset
+ *
+ * Like g_iconv_open(), but reuses a converter from the calling thread's
+ * cache if there is one. When it is no longer needed, it should be given
+ * back with g_iconv_cache_give() rather than closed.
+ *
+ * Returns: a conversion descriptor, or (GIConv)-1 if opening the converter
+ *   failed, with errno set
+ */
+GIConv
+g_iconv_cache_take (const gchar *to_codeset,
+                    const gchar *from_codeset)
+{
+  IConvCacheEntry *entry;
+  GIConv cd;
+
+  entry = iconv_cache_lookup (iconv_cache_get (), to_codeset, from_codeset, FALSE);
+  if (entry == NULL)
+    return g_iconv_open (to_codeset, from_codeset);
+
+  cd = entry->cd;
+  entry->cd = (GIConv) -1;
+
+  return cd;
+}
+
+/*
+ * g_iconv_cache_give:
+ * @to_codeset: destination codeset
+ * @from_codeset: source codeset
+ * @cd: a conversion descriptor from g_iconv_cache_take() on any thread,
+ *   or (GIConv)-1
+ *
+ * Resets @cd and puts it in the calling thread's cache, closing the least
+ * recently used converter if the cache is full.
+ */
+void
+g_iconv_cache_give (const gchar *to_codeset,
+                    const gchar *from_codeset,
+                    GIConv       cd)
+{
+  IConvCache *cache;
+  IConvCacheEntry *entry;
+
+  if (cd == (GIConv) -1)
+    return;
+
+  if (!iconv_cache_codeset_is_reusable (to_codeset) ||
+      !iconv_cache_codeset_is_reusable (from_codeset))
+    {
+      g_iconv_close (cd);
+      return;
+    }
+
+  /* Reset the shift state for the next user */
+  g_iconv (cd, NULL, NULL, NULL, NULL);
+
+  cache = iconv_cache_get ();
+  entry = iconv_cache_lookup (cache, to_codeset, from_codeset, TRUE);
+  if (entry == NULL)
+    {
+      if (cache->n_entries == ICONV_CACHE_SIZE)
+        iconv_cache_entry_clear (&cache->entries[--cache->n_entries]);
+
+      memmove (&cache->entries[1], &cache->entries[0],
+               cache->n_entries++ * sizeof (IConvCacheEntry));
+      entry = &cache->entries[0];
+      entry->to_codeset = g_strdup (to_codeset);
+      entry->from_codeset = g_strdup (from_codeset);
+    }
+
+  entry->cd = cd;
+}
+
 static GIConv
 open_converter (const gchar *to_codeset,
 		const gchar *from_codeset,
@@ -221,7 +415,7 @@ open_converter (const gchar *to_codeset,
 {
   GIConv cd;
 
-  cd = g_iconv_open (to_codeset, from_codeset);
+  cd = g_iconv_cache_take (to_codeset, from_codeset);
 
   if (cd == (GIConv) -1)
     {
@@ -242,13 +436,12 @@ open_converter (const gchar *to_codeset,
   return cd;
 }
 
-static int
-close_converter (GIConv cd)
+static void
+close_converter (const gchar *to_codeset,
+                 const gchar *from_codeset,
+                 GIConv       cd)
 {
-  if (cd == (GIConv) -1)
-    return 0;
-  
-  return g_iconv_close (cd);  
+  g_iconv_cache_give (to_codeset, from_codeset, cd);
 }
 
 /**
@@ -421,6 +614,126 @@ g_convert_with_iconv (const gchar *str,
     return dest;
 }
 
+typedef enum
+{
+  UNICODE_CODESET_OTHER,
+  UNICODE_CODESET_UTF8,
+  UNICODE_CODESET_UTF16LE,
+  UNICODE_CODESET_UTF16BE
+} UnicodeCodeset;
+
+static UnicodeCodeset
+get_unicode_codeset (const gchar *codeset)
+{
+  if (g_ascii_strcasecmp (codeset, "UTF-8") == 0 ||
+      g_ascii_strcasecmp (codeset, "UTF8") == 0)
+    return UNICODE_CODESET_UTF8;
+  else if (g_ascii_strcasecmp (codeset, "UTF-16LE") == 0 ||
+           g_ascii_strcasecmp (codeset, "UTF16LE") == 0)
+    return UNICODE_CODESET_UTF16LE;
+  else if (g_ascii_strcasecmp (codeset, "UTF-16BE") == 0 ||
+           g_ascii_strcasecmp (codeset, "UTF16BE") == 0)
+    return UNICODE_CODESET_UTF16BE;
+  else
+    return UNICODE_CODESET_OTHER;
+}
+
+static void
+swap_utf16 (gunichar2 *str,
+            gsize      len)
+{
+  gsize i;
+
+  for (i = 0; i < len; i++)
+    str[i] = GUINT16_SWAP_LE_BE (str[i]);
+}
+
+/* Converts between UTF-8 and UTF-16 with an explicit byte order without
+ * going through iconv, with the same results as g_convert_with_iconv().
+ * Returns %FALSE, without doing anything, for any other pair of codesets. */
+static gboolean
+convert_utf8_utf16 (const gchar  *str,
+                    gssize        len,
+                    const gchar  *to_codeset,
+                    const gchar  *from_codeset,
+                    gsize        *bytes_read,
+                    gsize        *bytes_written,
+                    gchar       **result,
+                    GError      **error)
+{
+  UnicodeCodeset to = get_unicode_codeset (to_codeset);
+  UnicodeCodeset from = get_unicode_codeset (from_codeset);
+  UnicodeCodeset native = (G_BYTE_ORDER == G_LITTLE_ENDIAN) ? UNICODE_CODESET_UTF16LE : UNICODE_CODESET_UTF16BE;
+  gchar *dest = NULL;
+  gsize n_read = 0;
+  gssize n_written;
+
+  if (to == UNICODE_CODESET_UTF8 && from != UNICODE_CODESET_OTHER && from != UNICODE_CODESET_UTF8)
+    {
+      const gunichar2 *units = (const gunichar2 *) str;
+      gunichar2 *copy = NULL;
+      gsize n_units;
+
+      if (len < 0)
+        len = strlen (str);
+      n_units = len / 2;
+
+      /* Units which need swapping or aligning are copied first */
+      if (from != native || GPOINTER_TO_SIZE (str) % G_ALIGNOF (gunichar2) != 0)
+        {
+          units = copy = g_new (gunichar2, n_units);
+          memcpy (copy, str, n_units * sizeof (gunichar2));
+          if (from != native)
+            swap_utf16 (copy, n_units);
+        }
+
+      dest = g_malloc_n (n_units + 2, 3);
+      n_written = _g_utf16_to_utf8_convert (units, n_units, dest, 3 * n_units,
+                                            bytes_read != NULL, &n_read, error);
+      n_read *= sizeof (gunichar2);
+      g_free (copy);
+
+      if (n_written >= 0 && bytes_read == NULL && n_read != (gsize) len)
+        {
+          g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_PARTIAL_INPUT,
+                               _("Partial character sequence at end of input"));
+          n_written = -1;
+        }
+    }
+  else if (from == UNICODE_CODESET_UTF8 && to != UNICODE_CODESET_OTHER && to != UNICODE_CODESET_UTF8)
+    {
+      if (len < 0)
+        len = strlen (str);
+
+      dest = g_malloc_n (len + 2, sizeof (gunichar2));
+      n_written = _g_utf8_to_utf16_convert (str, len, (gunichar2 *) dest, len,
+                                            bytes_read != NULL, &n_read, error);
+
+      if (n_written >= 0)
+        {
+          if (to != native)
+            swap_utf16 ((gunichar2 *) dest, n_written);
+          n_written *= sizeof (gunichar2);
+        }
+    }
+  else
+    return FALSE;
+
+  if (n_written >= 0)
+    memset (dest + n_written, 0, NUL_TERMINATOR_LENGTH);
+  else
+    g_clear_pointer (&dest, g_free);
+
+  if (bytes_read)
+    *bytes_read = n_read;
+  if (bytes_written)
+    *bytes_written = MAX (n_written, 0);
+
+  *result = dest;
+
+  return TRUE;
+}
+
 /**
  * g_convert:
  * @str:           (array length=len) (element-type guint8):
@@ -459,6 +772,9 @@ g_convert_with_iconv (const gchar *str,
  * Using extensions such as "//TRANSLIT" may not work (or may not work
  * well) on many platforms.  Consider using g_str_to_ascii() instead.
  *
+ * Since GLib 2.82, conversions between UTF-8 and UTF-16LE or UTF-16BE are
+ * done by GLib itself rather than by iconv, which is much faster.
+ *
  * Returns: (array length=bytes_written) (element-type guint8) (transfer full):
  *          If the conversion was successful, a newly allocated buffer
  *          containing the converted string, which must be freed with g_free().
@@ -479,7 +795,11 @@ g_convert (const gchar *str,
   g_return_val_if_fail (str != NULL, NULL);
   g_return_val_if_fail (to_codeset != NULL, NULL);
   g_return_val_if_fail (from_codeset != NULL, NULL);
-  
+
+  if (convert_utf8_utf16 (str, len, to_codeset, from_codeset,
+                          bytes_read, bytes_written, &res, error))
+    return res;
+
   cd = open_converter (to_codeset, from_codeset, error);
 
   if (cd == (GIConv) -1)
@@ -497,7 +817,7 @@ g_convert (const gchar *str,
 			      bytes_read, bytes_written,
 			      error);
 
-  close_converter (cd);
+  close_converter (to_codeset, from_codeset, cd);
 
   return res;
 }
@@ -623,7 +943,7 @@ g_convert_with_fallback (const gchar *str,
 		    bytes_read, &inbytes_remaining, error);
   if (!utf8)
     {
-      close_converter (cd);
+      close_converter (to_codeset, "UTF-8", cd);
       if (bytes_written)
         *bytes_written = 0;
       return NULL;
@@ -736,7 +1056,7 @@ g_convert_with_fallback (const gchar *str,
    */
   memset (outp, 0, NUL_TERMINATOR_LENGTH);
   
-  close_converter (cd);
+  close_converter (to_codeset, "UTF-8", cd);
 
   if (bytes_written)
     *bytes_written = outp - dest;	/* Doesn't include '\0' */
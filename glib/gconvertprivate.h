@@ -37,6 +37,12 @@ gchar *_g_ctype_locale_to_utf8 (const gchar *opsysstring,
                                 gsize *bytes_written,
                                 GError **error) G_GNUC_MALLOC;
 
+GIConv g_iconv_cache_take (const gchar *to_codeset,
+                           const gchar *from_codeset);
+void   g_iconv_cache_give (const gchar *to_codeset,
+                           const gchar *from_codeset,
+                           GIConv       cd);
+
 G_END_DECLS
 
 #endif /* __G_CONVERTPRIVATE_H__ */
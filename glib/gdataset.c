@@ -97,8 +97,19 @@ struct _GData
   guint32  len;     /* Number of elements */
   guint32  alloc;   /* Number of allocated elements */
   GDataElt data[1]; /* Flexible array */
+
+  /* If alloc is at least DATALIST_INDEX_MIN_ALLOC, data[alloc] is followed
+   * (in the same allocation) by an open-addressed index of 2*alloc guint32
+   * slots. Each slot holds 0 for empty, or an element index plus one. Most
+   * datalists have a handful of entries, which a linear scan finds faster,
+   * so they don't pay for the index. */
 };
 
+#define DATALIST_INDEX_MIN_ALLOC 16u
+#define DATALIST_HAS_INDEX(d) ((d)->alloc >= DATALIST_INDEX_MIN_ALLOC)
+#define DATALIST_INDEX(d) ((guint32 *) &(d)->data[(d)->alloc])
+#define DATALIST_INDEX_MASK(d) (2u * (d)->alloc - 1u)
+
 struct _GDataset
 {
   gconstpointer location;
@@ -158,6 +169,101 @@ g_datalist_unlock_and_set (GData **datalist, gpointer ptr)
   g_pointer_bit_unlock_and_set ((void **) datalist, DATALIST_LOCK_BIT, ptr, G_DATALIST_FLAGS_MASK_INTERNAL);
 }
 
+static inline gsize
+datalist_alloc_size (guint32 alloc)
+{
+  gsize size = G_STRUCT_OFFSET (GData, data) + alloc * sizeof (GDataElt);
+
+  if (alloc >= DATALIST_INDEX_MIN_ALLOC)
+    size += 2u * alloc * sizeof (guint32);
+
+  return size;
+}
+
+static inline guint32
+datalist_index_home (GData *d, GQuark key_id)
+{
+  /* Quarks are small consecutive integers, which multiplying by an odd
+   * constant spreads over the low bits without collisions */
+  return (key_id * 0x9E3779B1u) & DATALIST_INDEX_MASK (d);
+}
+
+static void
+datalist_index_insert (GData *d, guint32 idx)
+{
+  guint32 *index = DATALIST_INDEX (d);
+  guint32 mask = DATALIST_INDEX_MASK (d);
+  guint32 slot;
+
+  for (slot = datalist_index_home (d, d->data[idx].key);
+       index[slot] != 0;
+       slot = (slot + 1u) & mask)
+    ;
+
+  index[slot] = idx + 1u;
+}
+
+static void
+datalist_index_rebuild (GData *d)
+{
+  guint32 i;
+
+  memset (DATALIST_INDEX (d), 0, (DATALIST_INDEX_MASK (d) + 1u) * sizeof (guint32));
+  for (i = 0; i < d->len; i++)
+    datalist_index_insert (d, i);
+}
+
+/* Returns the slot which holds element @idx */
+static guint32
+datalist_index_slot_of (GData *d, guint32 idx)
+{
+  guint32 *index = DATALIST_INDEX (d);
+  guint32 mask = DATALIST_INDEX_MASK (d);
+  guint32 slot;
+
+  for (slot = datalist_index_home (d, d->data[idx].key);
+       index[slot] != idx + 1u;
+       slot = (slot + 1u) & mask)
+    {
+#if G_ENABLE_DEBUG
+      g_assert (index[slot] != 0);
+#endif
+    }
+
+  return slot;
+}
+
+static void
+datalist_index_remove_slot (GData *d, guint32 slot)
+{
+  guint32 *index = DATALIST_INDEX (d);
+  guint32 mask = DATALIST_INDEX_MASK (d);
+  guint32 j = slot;
+
+  /* Backward-shift deletion, so that linear probing needs no tombstones:
+   * move up every following entry of the cluster which would no longer be
+   * reachable from its home slot. */
+  index[slot] = 0;
+  while (TRUE)
+    {
+      guint32 home;
+
+      j = (j + 1u) & mask;
+      if (index[j] == 0)
+        break;
+
+      home = datalist_index_home (d, d->data[index[j] - 1u].key);
+
+      /* Leave the entry if its home is cyclically in (slot, j] */
+      if (slot < j ? (home > slot && home <= j) : (home > slot || home <= j))
+        continue;
+
+      index[slot] = index[j];
+      index[j] = 0;
+      slot = j;
+    }
+}
+
 static gboolean
 datalist_append (GData **data, GQuark key_id, gpointer new_data, GDestroyNotify destroy_func)
 {
@@ -167,7 +273,7 @@ datalist_append (GData **data, GQuark key_id, gpointer new_data, GDestroyNotify
   d = *data;
   if (!d)
     {
-      d = g_malloc (G_STRUCT_OFFSET (GData, data) + 2u * sizeof (GDataElt));
+      d = g_malloc (datalist_alloc_size (2u));
       d->len = 0;
       d->alloc = 2u;
       *data = d;
@@ -185,7 +291,7 @@ datalist_append (GData **data, GQuark key_id, gpointer new_data, GDestroyNotify
        * Don't ever try to do that. */
       g_assert (d->alloc > d->len);
 #endif
-      d = g_realloc (d, G_STRUCT_OFFSET (GData, data) + d->alloc * sizeof (GDataElt));
+      d = g_realloc (d, datalist_alloc_size (d->alloc));
       *data = d;
       reallocated = TRUE;
     }
@@ -199,6 +305,14 @@ datalist_append (GData **data, GQuark key_id, gpointer new_data, GDestroyNotify
   };
   d->len++;
 
+  if (DATALIST_HAS_INDEX (d))
+    {
+      if (reallocated)
+        datalist_index_rebuild (d);
+      else
+        datalist_index_insert (d, d->len - 1u);
+    }
+
   return reallocated;
 }
 
@@ -214,10 +328,17 @@ datalist_remove (GData *data, guint32 idx)
    * to @idx are left unchanged, and the last entry is moved to position @idx.
    * */
 
+  if (DATALIST_HAS_INDEX (data))
+    datalist_index_remove_slot (data, datalist_index_slot_of (data, idx));
+
   data->len--;
 
   if (idx != data->len)
-    data->data[idx] = data->data[data->len];
+    {
+      if (DATALIST_HAS_INDEX (data))
+        DATALIST_INDEX (data)[datalist_index_slot_of (data, data->len)] = idx + 1u;
+      data->data[idx] = data->data[data->len];
+    }
 }
 
 static gboolean
@@ -268,7 +389,9 @@ datalist_shrink (GData **data, GData **d_to_free)
 #endif
 
   d->alloc = v;
-  d = g_realloc (d, G_STRUCT_OFFSET (GData, data) + (v * sizeof (GDataElt)));
+  d = g_realloc (d, datalist_alloc_size (v));
+  if (DATALIST_HAS_INDEX (d))
+    datalist_index_rebuild (d);
   *d_to_free = NULL;
   *data = d;
   return TRUE;
@@ -279,7 +402,27 @@ datalist_find (GData *data, GQuark key_id, guint32 *out_idx)
 {
   guint32 i;
 
-  if (data)
+  if (data && DATALIST_HAS_INDEX (data))
+    {
+      guint32 *index = DATALIST_INDEX (data);
+      guint32 mask = DATALIST_INDEX_MASK (data);
+      guint32 slot;
+
+      for (slot = datalist_index_home (data, key_id);
+           index[slot] != 0;
+           slot = (slot + 1u) & mask)
+        {
+          GDataElt *data_elt = &data->data[index[slot] - 1u];
+
+          if (data_elt->key == key_id)
+            {
+              if (out_idx)
+                *out_idx = index[slot] - 1u;
+              return data_elt;
+            }
+        }
+    }
+  else if (data)
     {
       for (i = 0; i < data->len; i++)
         {
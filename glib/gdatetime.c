@@ -3814,60 +3814,381 @@ g_date_time_format (GDateTime   *datetime,
   return g_string_free (outstr, FALSE);
 }
 
+/* A fixed-size output buffer for the _to_buffer() variants.  Like
+ * g_strlcpy(), @len keeps counting past the end of the buffer so that the
+ * required size can be reported. */
+typedef struct
+{
+  gchar *buffer;
+  gsize  size;
+  gsize  len;
+} FormatBuffer;
+
+static inline void
+format_buffer_append_c (FormatBuffer *buf,
+                        gchar         c)
+{
+  if (buf->len + 1 < buf->size)
+    buf->buffer[buf->len] = c;
+  buf->len++;
+}
+
+static void
+format_buffer_append_len (FormatBuffer *buf,
+                          const gchar  *str,
+                          gsize         len)
+{
+  if (buf->len + 1 < buf->size)
+    memcpy (buf->buffer + buf->len, str, MIN (len, buf->size - 1 - buf->len));
+  buf->len += len;
+}
+
+/* Appends @number in ASCII digits, zero padded to @width */
+static void
+format_buffer_append_number (FormatBuffer *buf,
+                             guint64       number,
+                             guint         width)
+{
+  gchar tmp[20];
+  guint i = 0;
+
+  do
+    {
+      tmp[i++] = '0' + number % 10;
+      number /= 10;
+    }
+  while (number);
+
+  while (i < width && i < sizeof (tmp))
+    tmp[i++] = '0';
+
+  while (i)
+    format_buffer_append_c (buf, tmp[--i]);
+}
+
+static void
+format_buffer_append_z (FormatBuffer *buf,
+                        gint          offset,
+                        guint         colons)
+{
+  gint hours;
+  gint minutes;
+  gint seconds;
+
+  format_buffer_append_c (buf, offset >= 0 ? '+' : '-');
+
+  offset = ABS (offset);
+  hours = offset / 3600;
+  minutes = offset / 60 % 60;
+  seconds = offset % 60;
+
+  format_buffer_append_number (buf, hours, 2);
+
+  if (colons == 3 && minutes == 0 && seconds == 0)
+    return;
+
+  if (colons > 0)
+    format_buffer_append_c (buf, ':');
+  format_buffer_append_number (buf, minutes, 2);
+
+  if (colons == 2 || (colons == 3 && seconds != 0))
+    {
+      format_buffer_append_c (buf, ':');
+      format_buffer_append_number (buf, seconds, 2);
+    }
+}
+
+static void
+format_buffer_terminate (FormatBuffer *buf)
+{
+  if (buf->size > 0)
+    buf->buffer[MIN (buf->len, buf->size - 1)] = '\0';
+}
+
+/* Formats @format into @buf if it only uses conversions which do not
+ * depend on the locale, and none of the modifiers apart from the colons
+ * of `%z`.  Returns %FALSE otherwise, leaving @buf to be reset by the
+ * caller, so that the full formatter can be used. */
+static gboolean
+g_date_time_format_simple (GDateTime    *datetime,
+                           const gchar  *format,
+                           FormatBuffer *buf)
+{
+  gint year, month, day;
+  guint colons;
+
+  g_date_time_get_ymd (datetime, &year, &month, &day);
+
+  while (*format)
+    {
+      gsize len = strcspn (format, "%");
+
+      if (len)
+        format_buffer_append_len (buf, format, len);
+
+      format += len;
+      if (!*format)
+        break;
+
+      format++;
+      if (!*format)
+        break;
+
+      colons = 0;
+      while (*format == ':')
+        {
+          colons++;
+          format++;
+        }
+
+      if (colons > 0 && *format != 'z')
+        return FALSE;
+
+      switch (*format++)
+        {
+        case 'C':
+          format_buffer_append_number (buf, year / 100, 2);
+          break;
+        case 'd':
+          format_buffer_append_number (buf, day, 2);
+          break;
+        case 'f':
+          format_buffer_append_number (buf, datetime->usec % G_TIME_SPAN_SECOND, 6);
+          break;
+        case 'F':
+          format_buffer_append_number (buf, year, 0);
+          format_buffer_append_c (buf, '-');
+          format_buffer_append_number (buf, month, 2);
+          format_buffer_append_c (buf, '-');
+          format_buffer_append_number (buf, day, 2);
+          break;
+        case 'H':
+          format_buffer_append_number (buf, g_date_time_get_hour (datetime), 2);
+          break;
+        case 'j':
+          format_buffer_append_number (buf, g_date_time_get_day_of_year (datetime), 3);
+          break;
+        case 'm':
+          format_buffer_append_number (buf, month, 2);
+          break;
+        case 'M':
+          format_buffer_append_number (buf, g_date_time_get_minute (datetime), 2);
+          break;
+        case 'n':
+          format_buffer_append_c (buf, '\n');
+          break;
+        case 'R':
+          format_buffer_append_number (buf, g_date_time_get_hour (datetime), 2);
+          format_buffer_append_c (buf, ':');
+          format_buffer_append_number (buf, g_date_time_get_minute (datetime), 2);
+          break;
+        case 's':
+          {
+            gint64 unix_time = g_date_time_to_unix (datetime);
+
+            if (unix_time < 0)
+              {
+                format_buffer_append_c (buf, '-');
+                format_buffer_append_number (buf, - (guint64) unix_time, 0);
+              }
+            else
+              format_buffer_append_number (buf, unix_time, 0);
+          }
+          break;
+        case 'S':
+          format_buffer_append_number (buf, g_date_time_get_second (datetime), 2);
+          break;
+        case 't':
+          format_buffer_append_c (buf, '\t');
+          break;
+        case 'T':
+          format_buffer_append_number (buf, g_date_time_get_hour (datetime), 2);
+          format_buffer_append_c (buf, ':');
+          format_buffer_append_number (buf, g_date_time_get_minute (datetime), 2);
+          format_buffer_append_c (buf, ':');
+          format_buffer_append_number (buf, g_date_time_get_second (datetime), 2);
+          break;
+        case 'y':
+          format_buffer_append_number (buf, year % 100, 2);
+          break;
+        case 'Y':
+          format_buffer_append_number (buf, year, 0);
+          break;
+        case 'z':
+          if (colons > 3)
+            return FALSE;
+          format_buffer_append_z (buf,
+                                  g_date_time_get_utc_offset (datetime) / USEC_PER_SECOND,
+                                  colons);
+          break;
+        case '%':
+          format_buffer_append_c (buf, '%');
+          break;
+        default:
+          return FALSE;
+        }
+    }
+
+  return TRUE;
+}
+
 /**
- * g_date_time_format_iso8601:
+ * g_date_time_format_to_buffer:
  * @datetime: A #GDateTime
+ * @format: a valid UTF-8 string, containing the format for the
+ *          #GDateTime
+ * @buffer: (out caller-allocates) (array length=buffer_size) (nullable):
+ *   buffer to write the formatted string to
+ * @buffer_size: size of @buffer, in bytes
  *
- * Format @datetime in [ISO 8601 format](https://en.wikipedia.org/wiki/ISO_8601),
- * including the date, time and time zone, and return that as a UTF-8 encoded
- * string.
+ * Formats @datetime like g_date_time_format(), writing the result to
+ * @buffer instead of allocating a new string.
  *
- * Since GLib 2.66, this will output to sub-second precision if needed.
+ * As with g_strlcpy(), at most @buffer_size - 1 bytes are written, the
+ * result is always nul-terminated if @buffer_size is non-zero, and the
+ * return value is the length of the complete formatted string.  If it is
+ * greater than or equal to @buffer_size, the output was truncated.
  *
- * Returns: (transfer full) (nullable): a newly allocated string formatted in
- *   ISO 8601 format or %NULL in the case that there was an error. The string
- *   should be freed with g_free().
+ * Formats which only use conversions which do not depend on the current
+ * locale (such as `%Y`, `%m`, `%d`, `%H`, `%M`, `%S`, `%f`, `%F`, `%T`,
+ * `%s` and `%z`) and no modifiers are written directly to @buffer without
+ * allocating any memory.
  *
- * Since: 2.62
+ * Returns: the length of the formatted string, or -1 in the case that
+ *   there was an error (as for g_date_time_format())
+ *
+ * Since: 2.82
  */
-gchar *
-g_date_time_format_iso8601 (GDateTime *datetime)
+gssize
+g_date_time_format_to_buffer (GDateTime   *datetime,
+                              const gchar *format,
+                              gchar       *buffer,
+                              gsize        buffer_size)
 {
-  GString *outstr = NULL;
-  gchar *main_date = NULL;
+  FormatBuffer buf = { buffer, buffer_size, 0 };
+
+  g_return_val_if_fail (datetime != NULL, -1);
+  g_return_val_if_fail (format != NULL, -1);
+  g_return_val_if_fail (buffer != NULL || buffer_size == 0, -1);
+
+  if (!g_date_time_format_simple (datetime, format, &buf))
+    {
+      gchar *str;
+
+      buf.len = 0;
+
+      str = g_date_time_format (datetime, format);
+      if (str == NULL)
+        {
+          format_buffer_terminate (&buf);
+          return -1;
+        }
+
+      format_buffer_append_len (&buf, str, strlen (str));
+      g_free (str);
+    }
+
+  format_buffer_terminate (&buf);
+
+  return buf.len;
+}
+
+/**
+ * g_date_time_format_iso8601_to_buffer:
+ * @datetime: A #GDateTime
+ * @buffer: (out caller-allocates) (array length=buffer_size) (nullable):
+ *   buffer to write the formatted string to
+ * @buffer_size: size of @buffer, in bytes
+ *
+ * Formats @datetime like g_date_time_format_iso8601(), writing the result
+ * to @buffer instead of allocating a new string.  No memory is allocated.
+ *
+ * The output is at most 35 bytes long, so a buffer of 36 bytes is always
+ * large enough.  Otherwise the output is truncated as for
+ * g_date_time_format_to_buffer().
+ *
+ * Returns: the length of the formatted string
+ *
+ * Since: 2.82
+ */
+gsize
+g_date_time_format_iso8601_to_buffer (GDateTime *datetime,
+                                      gchar     *buffer,
+                                      gsize      buffer_size)
+{
+  FormatBuffer buf = { buffer, buffer_size, 0 };
+  gint year, month, day;
   gint64 offset;
-  gchar *format = "%C%y-%m-%dT%H:%M:%S";
 
-  g_return_val_if_fail (datetime != NULL, NULL);
+  g_return_val_if_fail (datetime != NULL, 0);
+  g_return_val_if_fail (buffer != NULL || buffer_size == 0, 0);
+
+  g_date_time_get_ymd (datetime, &year, &month, &day);
+
+  /* Main date and time, as `%C%y-%m-%dT%H:%M:%S` */
+  format_buffer_append_number (&buf, year, 4);
+  format_buffer_append_c (&buf, '-');
+  format_buffer_append_number (&buf, month, 2);
+  format_buffer_append_c (&buf, '-');
+  format_buffer_append_number (&buf, day, 2);
+  format_buffer_append_c (&buf, 'T');
+  format_buffer_append_number (&buf, g_date_time_get_hour (datetime), 2);
+  format_buffer_append_c (&buf, ':');
+  format_buffer_append_number (&buf, g_date_time_get_minute (datetime), 2);
+  format_buffer_append_c (&buf, ':');
+  format_buffer_append_number (&buf, g_date_time_get_second (datetime), 2);
 
   /* if datetime has sub-second non-zero values below the second precision we
    * should print them as well */
   if (datetime->usec % G_TIME_SPAN_SECOND != 0)
-    format = "%C%y-%m-%dT%H:%M:%S.%f";
-
-  /* Main date and time. */
-  main_date = g_date_time_format (datetime, format);
-  outstr = g_string_new (main_date);
-  g_free (main_date);
+    {
+      format_buffer_append_c (&buf, '.');
+      format_buffer_append_number (&buf, datetime->usec % G_TIME_SPAN_SECOND, 6);
+    }
 
   /* Timezone. Format it as `%:::z` unless the offset is zero, in which case
    * we can simply use `Z`. */
   offset = g_date_time_get_utc_offset (datetime);
 
   if (offset == 0)
-    {
-      g_string_append_c (outstr, 'Z');
-    }
+    format_buffer_append_c (&buf, 'Z');
   else
-    {
-      gchar *time_zone = g_date_time_format (datetime, "%:::z");
-      g_string_append (outstr, time_zone);
-      g_free (time_zone);
-    }
+    format_buffer_append_z (&buf, offset / USEC_PER_SECOND, 3);
 
-  return g_string_free (outstr, FALSE);
+  format_buffer_terminate (&buf);
+
+  return buf.len;
 }
 
+/**
+ * g_date_time_format_iso8601:
+ * @datetime: A #GDateTime
+ *
+ * Format @datetime in [ISO 8601 format](https://en.wikipedia.org/wiki/ISO_8601),
+ * including the date, time and time zone, and return that as a UTF-8 encoded
+ * string.
+ *
+ * Since GLib 2.66, this will output to sub-second precision if needed.
+ *
+ * Returns: (transfer full) (nullable): a newly allocated string formatted in
+ *   ISO 8601 format or %NULL in the case that there was an error. The string
+ *   should be freed with g_free().
+ *
+ * Since: 2.62
+ */
+gchar *
+g_date_time_format_iso8601 (GDateTime *datetime)
+{
+  gchar buffer[36];
+  gsize len;
+
+  g_return_val_if_fail (datetime != NULL, NULL);
+
+  len = g_date_time_format_iso8601_to_buffer (datetime, buffer, sizeof (buffer));
+  g_assert (len < sizeof (buffer));
+
+  return g_strndup (buffer, len);
+}
 
 /* Epilogue {{{1 */
 /* vim:set foldmethod=marker: */
@@ -301,6 +301,15 @@ gchar *                 g_date_time_format                              (GDateTi
                                                                          const gchar    *format) G_GNUC_MALLOC;
 GLIB_AVAILABLE_IN_2_62
 gchar *                 g_date_time_format_iso8601                      (GDateTime      *datetime) G_GNUC_MALLOC;
+GLIB_AVAILABLE_IN_2_82
+gssize                  g_date_time_format_to_buffer                    (GDateTime      *datetime,
+                                                                         const gchar    *format,
+                                                                         gchar          *buffer,
+                                                                         gsize           buffer_size);
+GLIB_AVAILABLE_IN_2_82
+gsize                   g_date_time_format_iso8601_to_buffer            (GDateTime      *datetime,
+                                                                         gchar          *buffer,
+                                                                         gsize           buffer_size);
 
 G_END_DECLS
 
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: LGPL-2.1-or-later
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, see <http://www.gnu.org/licenses/>.
+
+"""Generate gfloattables.h, the powers of ten used by gfloatconv.c.
+
+Usage: gen-float-tables.py > gfloattables.h
+
+Each entry is the 128-bit significand of 10^q, normalised so that its top
+bit is set and truncated towards zero:
+
+    floor (10^q * 2^(127 - floor (log2 (10^q))))
+"""
+
+from fractions import Fraction
+
+MIN_EXPONENT = -342
+MAX_EXPONENT = 324
+
+
+def floor_log2_pow10(e):
+    # Must match float_floor_log2_pow10() in gfloatconv.c
+    return (e * 913124641741) >> 38
+
+
+def main():
+    print("/* This file is automatically generated.  DO NOT EDIT!")
+    print("   Instead, edit gen-float-tables.py and re-run.  */")
+    print()
+    print("#ifndef __G_FLOAT_TABLES_H__")
+    print("#define __G_FLOAT_TABLES_H__")
+    print()
+    print("#define G_FLOAT_POW10_MIN_EXPONENT (%d)" % MIN_EXPONENT)
+    print("#define G_FLOAT_POW10_MAX_EXPONENT %d" % MAX_EXPONENT)
+    print()
+    print("static const guint64 g_float_pow10_table[][2] = {")
+
+    for q in range(MIN_EXPONENT, MAX_EXPONENT + 1):
+        e = floor_log2_pow10(q)
+        significand = Fraction(10) ** q * Fraction(2) ** (127 - e)
+        t = significand.numerator // significand.denominator
+        assert (1 << 127) <= t < (1 << 128), q
+
+        print(
+            "  { G_GUINT64_CONSTANT (0x%016x), G_GUINT64_CONSTANT (0x%016x) }, /* 1e%d */"
+            % (t >> 64, t & 0xFFFFFFFFFFFFFFFF, q)
+        )
+
+    print("};")
+    print()
+    print("#endif /* __G_FLOAT_TABLES_H__ */")
+
+
+if __name__ == "__main__":
+    main()
@@ -915,6 +915,41 @@ sub print_decomp
     }
     print OUT "\n};\n\n";
 
+    &compute_nfqc ($last);
+
+    printf OUT "#define G_UNICODE_NFD_QC_NO %#04x\n", $NFD_QC_NO;
+    printf OUT "#define G_UNICODE_NFKD_QC_NO %#04x\n", $NFKD_QC_NO;
+    printf OUT "#define G_UNICODE_NFC_QC_NO %#04x\n", $NFC_QC_NO;
+    printf OUT "#define G_UNICODE_NFC_QC_MAYBE %#04x\n", $NFC_QC_MAYBE;
+    printf OUT "#define G_UNICODE_NFKC_QC_NO %#04x\n", $NFKC_QC_NO;
+    printf OUT "#define G_UNICODE_NFKC_QC_MAYBE %#04x\n\n", $NFKC_QC_MAYBE;
+
+    $table_index = 0;
+    printf OUT "static const guchar nfqc_data[][256] = {\n";
+    for ($count = 0; $count <= $last; $count += 256)
+    {
+	$row[$count / 256] = &print_row ($count, 1, \&fetch_nfqc);
+    }
+    printf OUT "\n};\n\n";
+
+    print OUT "static const gint16 nfqc_table_part1[$pages_before_e0000] = {\n";
+    for ($count = 0; $count <= $last_part1; $count += 256)
+    {
+	print OUT ",\n" if $count > 0;
+	print OUT "  ", $row[$count / 256];
+	$bytes_out += 2;
+    }
+    print OUT "\n};\n\n";
+
+    print OUT "static const gint16 nfqc_table_part2[768] = {\n";
+    for ($count = 0xE0000; $count <= $last; $count += 256)
+    {
+	print OUT ",\n" if $count > 0xE0000;
+	print OUT "  ", $row[$count / 256];
+	$bytes_out += 2;
+    }
+    print OUT "\n};\n\n";
+
     print OUT "typedef struct\n{\n";
     print OUT "  gunichar ch;\n";
     print OUT "  guint16 canon_offset;\n";
@@ -1073,6 +1108,88 @@ sub fetch_cclass
     return $cclass[$i];
 }
 
+# Fetcher for the normalization quick check flags.
+sub fetch_nfqc
+{
+    my ($i) = @_;
+    return defined $nfqc[$i] ? $nfqc[$i] : 0;
+}
+
+# Derive the NF*_QC properties of UAX #15 from the decompositions,
+# the combining classes and the composition exclusions, rather than
+# reading them from DerivedNormalizationProps.txt.  A character is
+# "No" for a decomposed form if it has a decomposition, and "No" for
+# a composed form if it is excluded from composition (explicitly, as
+# a singleton or as a non-starter decomposition) or, for NFKC, if its
+# compatibility decomposition differs from its canonical one.  The
+# second character of each primary composite is "Maybe" for the
+# composed forms.
+sub compute_nfqc
+{
+    my ($last) = @_;
+    my ($code, @values);
+
+    $NFD_QC_NO = 0x01;
+    $NFKD_QC_NO = 0x02;
+    $NFC_QC_NO = 0x04;
+    $NFC_QC_MAYBE = 0x08;
+    $NFKC_QC_NO = 0x10;
+    $NFKC_QC_MAYBE = 0x20;
+
+    for ($code = 0; $code <= $last; ++$code)
+    {
+	next if ! defined $decompositions[$code];
+
+	$nfqc[$code] |= $NFKD_QC_NO;
+	if ($decompose_compat[$code])
+	{
+	    $nfqc[$code] |= $NFKC_QC_NO;
+	    next;
+	}
+
+	$nfqc[$code] |= $NFD_QC_NO;
+	if (make_decomp ($code, 0) ne make_decomp ($code, 1))
+	{
+	    $nfqc[$code] |= $NFKC_QC_NO;
+	}
+
+	@values = map { hex ($_) } split /\s+/, $decompositions[$code];
+	if (exists $composition_exclusions{$code} || @values == 1
+	    || $cclass[$code] || $cclass[$values[0]])
+	{
+	    $nfqc[$code] |= $NFC_QC_NO | $NFKC_QC_NO;
+	}
+	else
+	{
+	    $nfqc[$values[1]] |= $NFC_QC_MAYBE;
+	}
+    }
+
+    # Hangul syllables decompose algorithmically, and their vowel
+    # and trailing consonant jamo compose with the preceding character
+    for ($code = 0xAC00; $code <= 0xD7A3; ++$code)
+    {
+	$nfqc[$code] |= $NFD_QC_NO | $NFKD_QC_NO;
+    }
+    for ($code = 0x1161; $code <= 0x1175; ++$code)
+    {
+	$nfqc[$code] |= $NFC_QC_MAYBE;
+    }
+    for ($code = 0x11A8; $code <= 0x11C2; ++$code)
+    {
+	$nfqc[$code] |= $NFC_QC_MAYBE;
+    }
+
+    for ($code = 0; $code <= $last; ++$code)
+    {
+	next if ! defined $nfqc[$code];
+
+	$nfqc[$code] &= ~$NFC_QC_MAYBE if $nfqc[$code] & $NFC_QC_NO;
+	$nfqc[$code] |= $NFKC_QC_MAYBE
+	    if ($nfqc[$code] & $NFC_QC_MAYBE) && !($nfqc[$code] & $NFKC_QC_NO);
+    }
+}
+
 # Expand a character decomposition recursively.
 sub expand_decomp
 {
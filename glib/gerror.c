@@ -31,25 +31,14 @@
 
 #include "gerror.h"
 
-#include "ghash.h"
+#include "gatomic.h"
 #include "glib-init.h"
+#include "glib-private.h"
 #include "gslice.h"
 #include "gstrfuncs.h"
 #include "gtestutils.h"
 #include "gthread.h"
 
-static GRWLock error_domain_global;
-/* error_domain_ht must be accessed with error_domain_global
- * locked.
- */
-static GHashTable *error_domain_ht = NULL;
-
-void
-g_error_init (void)
-{
-  error_domain_ht = g_hash_table_new (NULL, NULL);
-}
-
 typedef struct
 {
   /* private_size is already aligned. */
@@ -59,13 +48,30 @@ typedef struct
   GErrorClearFunc clear;
 } ErrorDomainInfo;
 
-/* Must be called with error_domain_global locked.
+/* Extended error domains, indexed by their quark. Every error allocation
+ * and free looks its domain up here, so lookups take no lock: the infos
+ * are never changed once published, and a table which is outgrown is
+ * replaced by a bigger copy but never freed, as a reader may still be
+ * using it. Quarks are small and dense, so this stays small.
  */
+typedef struct
+{
+  GQuark size;
+  ErrorDomainInfo *infos[];  /* (atomic) (nullable) */
+} ErrorDomainTable;
+
+static GMutex error_domain_lock;  /* serialises registrations */
+static ErrorDomainTable *error_domain_table = NULL;  /* (atomic) */
+
 static inline ErrorDomainInfo *
 error_domain_lookup (GQuark domain)
 {
-  return g_hash_table_lookup (error_domain_ht,
-                              GUINT_TO_POINTER (domain));
+  ErrorDomainTable *table = g_atomic_pointer_get (&error_domain_table);
+
+  if (table == NULL || domain >= table->size)
+    return NULL;
+
+  return g_atomic_pointer_get (&table->infos[domain]);
 }
 
 /* Copied from gtype.c. */
@@ -73,6 +79,32 @@ error_domain_lookup (GQuark domain)
 #define ALIGN_STRUCT(offset) \
       ((offset + (STRUCT_ALIGNMENT - 1)) & -STRUCT_ALIGNMENT)
 
+/* Precedes the private data (if any) of every error */
+typedef struct
+{
+  /* The message given to g_set_error_literal_static(), which the error
+   * does not own, or %NULL */
+  const gchar *static_message;
+} ErrorHeader;
+
+#define ERROR_HEADER_SIZE ALIGN_STRUCT (sizeof (ErrorHeader))
+
+static inline ErrorHeader *
+error_get_header (const GError *error,
+                  gsize         private_size)
+{
+  return (ErrorHeader *) (((guint8 *) error) - private_size - ERROR_HEADER_SIZE);
+}
+
+/* Frees @error’s message, unless it is static */
+static inline void
+error_free_message (GError *error,
+                    gsize   private_size)
+{
+  if (error->message != error_get_header (error, private_size)->static_message)
+    g_free (error->message);
+}
+
 static void
 error_domain_register (GQuark            error_quark,
                        gsize             error_type_private_size,
@@ -80,18 +112,36 @@ error_domain_register (GQuark            error_quark,
                        GErrorCopyFunc    error_type_copy,
                        GErrorClearFunc   error_type_clear)
 {
-  g_rw_lock_writer_lock (&error_domain_global);
+  g_mutex_lock (&error_domain_lock);
   if (error_domain_lookup (error_quark) == NULL)
     {
+      ErrorDomainTable *table = error_domain_table;
       ErrorDomainInfo *info = g_new (ErrorDomainInfo, 1);
       info->private_size = ALIGN_STRUCT (error_type_private_size);
       info->init = error_type_init;
       info->copy = error_type_copy;
       info->clear = error_type_clear;
 
-      g_hash_table_insert (error_domain_ht,
-                           GUINT_TO_POINTER (error_quark),
-                           info);
+      if (table == NULL || error_quark >= table->size)
+        {
+          GQuark old_size = (table != NULL) ? table->size : 0;
+          GQuark new_size = MAX (MAX (error_quark + 1, old_size * 2), 64);
+          ErrorDomainTable *new_table;
+
+          new_table = g_malloc0 (sizeof (ErrorDomainTable) +
+                                 new_size * sizeof (ErrorDomainInfo *));
+          new_table->size = new_size;
+          if (old_size > 0)
+            memcpy (new_table->infos, table->infos,
+                    old_size * sizeof (ErrorDomainInfo *));
+
+          /* The old table is leaked on purpose; see above */
+          g_ignore_leak (table);
+          g_atomic_pointer_set (&error_domain_table, new_table);
+          table = new_table;
+        }
+
+      g_atomic_pointer_set (&table->infos[error_quark], info);
     }
   else
     {
@@ -99,7 +149,7 @@ error_domain_register (GQuark            error_quark,
 
       g_critical ("Attempted to register an extended error domain for %s more than once", name);
     }
-  g_rw_lock_writer_unlock (&error_domain_global);
+  g_mutex_unlock (&error_domain_lock);
 }
 
 /**
@@ -202,27 +252,28 @@ g_error_allocate (GQuark domain, ErrorDomainInfo *out_info)
   ErrorDomainInfo *info;
   gsize private_size;
 
-  g_rw_lock_reader_lock (&error_domain_global);
   info = error_domain_lookup (domain);
   if (info != NULL)
     {
       if (out_info != NULL)
         *out_info = *info;
       private_size = info->private_size;
-      g_rw_lock_reader_unlock (&error_domain_global);
     }
   else
     {
-      g_rw_lock_reader_unlock (&error_domain_global);
       if (out_info != NULL)
         memset (out_info, 0, sizeof (*out_info));
       private_size = 0;
     }
+
+  /* The header is allocated as if it were part of the private data */
+  private_size += ERROR_HEADER_SIZE;
+
   /* See comments in g_type_create_instance in gtype.c to see what
    * this magic is about.
    */
 #ifdef ENABLE_VALGRIND
-  if (private_size > 0 && RUNNING_ON_VALGRIND)
+  if (RUNNING_ON_VALGRIND)
     {
       private_size += ALIGN_STRUCT (1);
       allocated = g_slice_alloc0 (private_size + sizeof (GError) + sizeof (gpointer));
@@ -260,6 +311,23 @@ g_error_new_steal (GQuark           domain,
   return error;
 }
 
+/* @message must outlive the error, which does not free it. */
+static GError *
+g_error_new_static (GQuark           domain,
+                    gint             code,
+                    const gchar     *message,
+                    ErrorDomainInfo *out_info)
+{
+  ErrorDomainInfo info;
+  GError *error = g_error_new_steal (domain, code, (gchar *) message, &info);
+
+  error_get_header (error, info.private_size)->static_message = message;
+  if (out_info != NULL)
+    *out_info = info;
+
+  return error;
+}
+
 /**
  * g_error_new_valist:
  * @domain: error domain
@@ -362,29 +430,26 @@ g_error_free (GError *error)
 
   g_return_if_fail (error != NULL);
 
-  g_rw_lock_reader_lock (&error_domain_global);
   info = error_domain_lookup (error->domain);
   if (info != NULL)
     {
-      GErrorClearFunc clear = info->clear;
-
       private_size = info->private_size;
-      g_rw_lock_reader_unlock (&error_domain_global);
-      clear (error);
+      info->clear (error);
     }
   else
-    {
-      g_rw_lock_reader_unlock (&error_domain_global);
-      private_size = 0;
-    }
+    private_size = 0;
+
+  error_free_message (error, private_size);
+
+  /* The header is allocated as if it were part of the private data */
+  private_size += ERROR_HEADER_SIZE;
 
-  g_free (error->message);
   allocated = ((guint8 *) error) - private_size;
   /* See comments in g_type_free_instance in gtype.c to see what this
    * magic is about.
    */
 #ifdef ENABLE_VALGRIND
-  if (private_size > 0 && RUNNING_ON_VALGRIND)
+  if (RUNNING_ON_VALGRIND)
     {
       private_size += ALIGN_STRUCT (1);
       allocated -= ALIGN_STRUCT (1);
@@ -411,6 +476,8 @@ g_error_copy (const GError *error)
 {
   GError *copy;
   ErrorDomainInfo info;
+  const ErrorDomainInfo *domain_info;
+  gsize private_size;
 
   g_return_val_if_fail (error != NULL, NULL);
   g_return_val_if_fail (error->message != NULL, NULL);
@@ -418,10 +485,17 @@ g_error_copy (const GError *error)
   /* See g_error_new_valist for why this doesn’t return */
   g_warn_if_fail (error->domain != 0);
 
-  copy = g_error_new_steal (error->domain,
-                            error->code,
-                            g_strdup (error->message),
-                            &info);
+  domain_info = error_domain_lookup (error->domain);
+  private_size = (domain_info != NULL) ? domain_info->private_size : 0;
+
+  /* A static message can be shared rather than copied */
+  if (error->message == error_get_header (error, private_size)->static_message)
+    copy = g_error_new_static (error->domain, error->code, error->message, &info);
+  else
+    copy = g_error_new_steal (error->domain,
+                              error->code,
+                              g_strdup (error->message),
+                              &info);
   if (info.copy != NULL)
     info.copy (error, copy);
 
@@ -529,6 +603,46 @@ g_set_error_literal (GError      **err,
     g_warning (ERROR_OVERWRITTEN_WARNING, message);
 }
 
+/**
+ * g_set_error_literal_static:
+ * @err: (out callee-allocates) (optional): a return location for a #GError
+ * @domain: error domain
+ * @code: error code
+ * @message: error message, which must remain valid for the lifetime of
+ *   the program
+ *
+ * Does nothing if @err is %NULL; if @err is non-%NULL, then *@err
+ * must be %NULL. A new #GError is created and assigned to *@err.
+ *
+ * Unlike g_set_error_literal(), @message is not copied: the error points
+ * to it directly, and so do copies made with g_error_copy(). This makes
+ * the error cheaper to create for failures which are frequent and
+ * expected, such as %G_IO_ERROR_WOULD_BLOCK, when the message is a string
+ * literal, a translated string or the result of g_strerror().
+ *
+ * The message of such an error must not be freed, or replaced by other
+ * means than g_prefix_error() and related functions.
+ *
+ * Since: 2.82
+ */
+void
+g_set_error_literal_static (GError      **err,
+                            GQuark        domain,
+                            gint          code,
+                            const gchar  *message)
+{
+  if (err == NULL)
+    return;
+
+  g_return_if_fail (message != NULL);
+  g_return_if_fail (domain != 0);
+
+  if (*err == NULL)
+    *err = g_error_new_static (domain, code, message, NULL);
+  else
+    g_warning (ERROR_OVERWRITTEN_WARNING, message);
+}
+
 /**
  * g_propagate_error:
  * @dest: (out callee-allocates) (optional) (nullable): error return location
@@ -583,19 +697,29 @@ g_clear_error (GError **err)
     }
 }
 
+/* Replaces @error’s message with @prefix followed by the old one */
+static void
+g_error_add_prefix_literal (GError      *error,
+                            const gchar *prefix)
+{
+  ErrorDomainInfo *info = error_domain_lookup (error->domain);
+  gchar *newstring;
+
+  newstring = g_strconcat (prefix, error->message, NULL);
+  error_free_message (error, (info != NULL) ? info->private_size : 0);
+  error->message = newstring;
+}
+
 G_GNUC_PRINTF(2, 0)
 static void
-g_error_add_prefix (gchar       **string,
-                    const gchar  *format,
-                    va_list       ap)
+g_error_add_prefix (GError      *error,
+                    const gchar *format,
+                    va_list      ap)
 {
-  gchar *oldstring;
   gchar *prefix;
 
   prefix = g_strdup_vprintf (format, ap);
-  oldstring = *string;
-  *string = g_strconcat (prefix, oldstring, NULL);
-  g_free (oldstring);
+  g_error_add_prefix_literal (error, prefix);
   g_free (prefix);
 }
 
@@ -624,7 +748,7 @@ g_prefix_error (GError      **err,
       va_list ap;
 
       va_start (ap, format);
-      g_error_add_prefix (&(*err)->message, format, ap);
+      g_error_add_prefix (*err, format, ap);
       va_end (ap);
     }
 }
@@ -644,13 +768,7 @@ g_prefix_error_literal (GError      **err,
                         const gchar  *prefix)
 {
   if (err && *err)
-    {
-      gchar *oldstring;
-
-      oldstring = (*err)->message;
-      (*err)->message = g_strconcat (prefix, oldstring, NULL);
-      g_free (oldstring);
-    }
+    g_error_add_prefix_literal (*err, prefix);
 }
 
 /**
@@ -680,7 +798,7 @@ g_propagate_prefixed_error (GError      **dest,
 
       g_assert (*dest != NULL);
       va_start (ap, format);
-      g_error_add_prefix (&(*dest)->message, format, ap);
+      g_error_add_prefix (*dest, format, ap);
       va_end (ap);
     }
 }
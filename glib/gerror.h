@@ -229,6 +229,11 @@ void     g_set_error_literal   (GError       **err,
                                 GQuark         domain,
                                 gint           code,
                                 const gchar   *message);
+GLIB_AVAILABLE_IN_2_82
+void     g_set_error_literal_static (GError       **err,
+                                     GQuark         domain,
+                                     gint           code,
+                                     const gchar   *message);
 
 /* if (dest) *dest = src; also has some sanity checks.
  */
@@ -54,6 +54,7 @@
 
 #include "gfileutils.h"
 
+#include "gmappedfile.h"
 #include "gstdio.h"
 #include "gstdioprivate.h"
 #include "glibintl.h"
@@ -883,13 +884,11 @@ error:
   return FALSE;
 }
 
-static gboolean
-get_contents_posix (const gchar  *filename,
-                    gchar       **contents,
-                    gsize        *length,
-                    GError      **error)
+static gint
+open_for_contents (const gchar  *filename,
+                   struct stat  *stat_buf,
+                   GError      **error)
 {
-  struct stat stat_buf;
   gint fd;
 
   /* O_BINARY useful on Cygwin */
@@ -905,11 +904,11 @@ get_contents_posix (const gchar  *filename,
                         _("Failed to open file “%s”: %s"),
                         saved_errno);
 
-      return FALSE;
+      return -1;
     }
 
   /* I don't think this will ever fail, aside from ENOMEM, but. */
-  if (fstat (fd, &stat_buf) < 0)
+  if (fstat (fd, stat_buf) < 0)
     {
       int saved_errno = errno;
       if (error)
@@ -919,13 +918,25 @@ get_contents_posix (const gchar  *filename,
                         saved_errno);
       close (fd);
 
-      return FALSE;
+      return -1;
     }
 
-  if (stat_buf.st_size > 0 && S_ISREG (stat_buf.st_mode))
+  return fd;
+}
+
+/* Takes ownership of @fd */
+static gboolean
+get_contents_fd (const gchar  *filename,
+                 gint          fd,
+                 struct stat  *stat_buf,
+                 gchar       **contents,
+                 gsize        *length,
+                 GError      **error)
+{
+  if (stat_buf->st_size > 0 && S_ISREG (stat_buf->st_mode))
     {
       gboolean retval = get_contents_regfile (filename,
-					      &stat_buf,
+					      stat_buf,
 					      fd,
 					      contents,
 					      length,
@@ -958,6 +969,74 @@ get_contents_posix (const gchar  *filename,
     }
 }
 
+static gboolean
+get_contents_posix (const gchar  *filename,
+                    gchar       **contents,
+                    gsize        *length,
+                    GError      **error)
+{
+  struct stat stat_buf;
+  gint fd;
+
+  fd = open_for_contents (filename, &stat_buf, error);
+  if (fd < 0)
+    return FALSE;
+
+  return get_contents_fd (filename, fd, &stat_buf, contents, length, error);
+}
+
+/* Regular files at least this big are mapped rather than read */
+#define CONTENTS_MAP_THRESHOLD (1024 * 1024)
+
+static GBytes *
+get_contents_bytes_posix (const gchar  *filename,
+                          GError      **error)
+{
+  struct stat stat_buf;
+  gchar *contents;
+  gsize length;
+  long page_size = sysconf (_SC_PAGESIZE);
+  gint fd;
+
+  fd = open_for_contents (filename, &stat_buf, error);
+  if (fd < 0)
+    return NULL;
+
+  /* The kernel fills the rest of the last page of a mapping with zeros, so
+   * the mapped contents are nul-terminated like the ones read below, unless
+   * the file ends on a page boundary. */
+  if (S_ISREG (stat_buf.st_mode) &&
+      stat_buf.st_size >= CONTENTS_MAP_THRESHOLD &&
+      (guint64) stat_buf.st_size <= G_MAXSIZE &&
+      page_size > 0 &&
+      stat_buf.st_size % page_size != 0)
+    {
+      GMappedFile *mapped_file;
+
+      mapped_file = g_mapped_file_new_from_fd (fd, FALSE, NULL);
+
+      /* Check again in case the file changed since fstat() */
+      if (mapped_file != NULL &&
+          g_mapped_file_get_length (mapped_file) % page_size != 0)
+        {
+          GBytes *bytes = g_mapped_file_get_bytes (mapped_file);
+
+          g_mapped_file_unref (mapped_file);
+          close (fd);
+
+          return bytes;
+        }
+
+      /* Not all file systems support mmap(), read the file instead */
+      g_clear_pointer (&mapped_file, g_mapped_file_unref);
+    }
+
+  if (!get_contents_fd (filename, fd, &stat_buf, &contents, &length, error))
+    return NULL;
+
+  return g_bytes_new_take (contents, length);
+}
+
 #else  /* G_OS_WIN32 */
 
 static gboolean
@@ -1031,6 +1110,75 @@ g_file_get_contents (const gchar  *filename,
 #endif
 }
 
+/**
+ * g_file_get_contents_bytes:
+ * @filename: (type filename): name of a file to read contents from, in the GLib file name encoding
+ * @error: return location for a #GError, or %NULL
+ *
+ * Loads the contents of @filename and returns them as #GBytes.
+ *
+ * This is like g_file_get_contents(), except that large regular files may
+ * be mapped into memory with #GMappedFile rather than read. This avoids
+ * keeping a copy of the file on the heap as well as in the page cache.
+ * Other files, such as pipes or files in `/proc`, are read as usual.
+ *
+ * As with g_mapped_file_new(), if a mapped file is modified or truncated by
+ * another process while the returned #GBytes is in use, the data may change
+ * or accessing it may crash. Use g_file_get_contents() if that is a concern.
+ *
+ * The data contained in the resulting #GBytes is always zero-terminated, but
+ * this is not included in the #GBytes length. The error domain is
+ * %G_FILE_ERROR.
+ *
+ * Returns: (transfer full): the contents of the file, or %NULL on error
+ *
+ * Since: 2.82
+ */
+GBytes *
+g_file_get_contents_bytes (const gchar  *filename,
+                           GError      **error)
+{
+  g_return_val_if_fail (filename != NULL, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+#ifdef G_OS_WIN32
+  {
+    gchar *contents;
+    gsize length;
+
+    if (!get_contents_win32 (filename, &contents, &length, error))
+      return NULL;
+
+    return g_bytes_new_take (contents, length);
+  }
+#else
+  return get_contents_bytes_posix (filename, error);
+#endif
+}
+
+static void
+fsync_directory (const char *dir)
+{
+#ifdef HAVE_FSYNC
+  int dir_fd = g_open (dir, O_RDONLY | O_CLOEXEC, 0);
+
+  if (dir_fd >= 0)
+    {
+      g_fsync (dir_fd);
+      g_close (dir_fd, NULL);
+    }
+#endif  /* HAVE_FSYNC */
+}
+
+static void
+fsync_directory_of (const char *filename)
+{
+  gchar *dir = g_path_get_dirname (filename);
+
+  fsync_directory (dir);
+  g_free (dir);
+}
+
 static gboolean
 rename_file (const char  *old_name,
              const char  *new_name,
@@ -1064,21 +1212,8 @@ rename_file (const char  *old_name,
    * or new contents of the file were visible after recovery.
    *
    * This assumes the @old_name and @new_name are in the same directory. */
-#ifdef HAVE_FSYNC
   if (do_fsync)
-    {
-      gchar *dir = g_path_get_dirname (new_name);
-      int dir_fd = g_open (dir, O_RDONLY | O_CLOEXEC, 0);
-
-      if (dir_fd >= 0)
-        {
-          g_fsync (dir_fd);
-          g_close (dir_fd, NULL);
-        }
-
-      g_free (dir);
-    }
-#endif  /* HAVE_FSYNC */
+    fsync_directory_of (new_name);
 
   return TRUE;
 }
@@ -1154,14 +1289,14 @@ truncate_file (int          fd,
   return TRUE;
 }
 
-/* closes @fd once it’s finished (on success or error) */
+/* leaves @fd open */
 static gboolean
-write_to_file (const gchar  *contents,
-               gsize         length,
-               int           fd,
-               const gchar  *dest_file,
-               gboolean      do_fsync,
-               GError      **err)
+write_contents (const gchar  *contents,
+                gsize         length,
+                int           fd,
+                const gchar  *dest_file,
+                gboolean      do_fsync,
+                GError      **err)
 {
 #ifdef HAVE_FALLOCATE
   if (length > 0)
@@ -1193,8 +1328,6 @@ write_to_file (const gchar  *contents,
             set_file_error (err,
                             dest_file, _("Failed to write file “%s”: write() failed: %s"),
                             saved_errno);
-          close (fd);
-
           return FALSE;
         }
 
@@ -1214,12 +1347,28 @@ write_to_file (const gchar  *contents,
         set_file_error (err,
                         dest_file, _("Failed to write file “%s”: fsync() failed: %s"),
                         saved_errno);
-      close (fd);
-
       return FALSE;
     }
 #endif
 
+  return TRUE;
+}
+
+/* closes @fd once it’s finished (on success or error) */
+static gboolean
+write_to_file (const gchar  *contents,
+               gsize         length,
+               int           fd,
+               const gchar  *dest_file,
+               gboolean      do_fsync,
+               GError      **err)
+{
+  if (!write_contents (contents, length, fd, dest_file, do_fsync, err))
+    {
+      close (fd);
+      return FALSE;
+    }
+
   errno = 0;
   if (!g_close (fd, err))
     return FALSE;
@@ -1227,6 +1376,175 @@ write_to_file (const gchar  *contents,
   return TRUE;
 }
 
+typedef gint (*GTmpFileCallback) (const gchar *, gint, gint);
+
+static gint get_tmp_file (gchar            *tmpl,
+                          GTmpFileCallback  f,
+                          int               flags,
+                          int               mode);
+
+#if defined (O_TMPFILE) && defined (HAVE_LINKAT)
+/* Gives a name to the anonymous file open as @fd, passed as the flags of a
+ * #GTmpFileCallback */
+static gint
+wrap_linkat (const gchar *filename,
+             int          fd,
+             int          mode G_GNUC_UNUSED)
+{
+  gchar proc_path[32];
+
+  g_snprintf (proc_path, sizeof (proc_path), "/proc/self/fd/%d", fd);
+
+  return linkat (AT_FDCWD, proc_path, AT_FDCWD, filename, AT_SYMLINK_FOLLOW);
+}
+#endif
+
+/*
+ * write_tmp_file:
+ * @tmp_filename: (out) (optional): return location for the name of the new
+ *   file, or %NULL if it was linked to @filename directly
+ *
+ * Writes @contents to a new file which is to replace @filename.
+ *
+ * Where `O_TMPFILE` is supported, the file is written anonymously and only
+ * given a name once it is complete, so that a crash never leaves partial
+ * files behind. If @link_to_filename is set and @filename does not exist,
+ * that name is @filename itself, which saves the rename(). Otherwise, and
+ * with a named temporary file where `O_TMPFILE` is not supported, the name
+ * of the new file is returned for the caller to rename() it over @filename.
+ */
+static gboolean
+write_tmp_file (const gchar  *filename,
+                const gchar  *contents,
+                gsize         length,
+                int           mode,
+                gboolean      do_fsync,
+                gboolean      link_to_filename,
+                gchar       **tmp_filename,
+                GError      **error)
+{
+  gchar *tmpl = g_strdup_printf ("%s.XXXXXX", filename);
+  int fd;
+
+#if defined (O_TMPFILE) && defined (HAVE_LINKAT)
+  {
+    gchar *dir = g_path_get_dirname (filename);
+
+    fd = g_open (dir, O_TMPFILE | O_RDWR | O_BINARY | O_CLOEXEC, mode);
+    g_free (dir);
+  }
+
+  if (fd >= 0)
+    {
+      if (!write_contents (contents, length, fd, filename, do_fsync, error))
+        {
+          close (fd);
+          g_free (tmpl);
+          return FALSE;
+        }
+
+      if (link_to_filename && wrap_linkat (filename, fd, 0) == 0)
+        {
+          close (fd);
+          g_free (tmpl);
+          *tmp_filename = NULL;
+          return TRUE;
+        }
+
+      if (get_tmp_file (tmpl, wrap_linkat, fd, 0) == 0)
+        {
+          close (fd);
+          *tmp_filename = tmpl;
+          return TRUE;
+        }
+
+      /* Most likely /proc is not mounted; start again with a named file */
+      close (fd);
+      memcpy (tmpl + strlen (tmpl) - 6, "XXXXXX", 6);
+    }
+#endif
+
+  errno = 0;
+  fd = g_mkstemp_full (tmpl, O_RDWR | O_BINARY | O_CLOEXEC, mode);
+
+  if (fd == -1)
+    {
+      int saved_errno = errno;
+      if (error)
+        set_file_error (error,
+                        tmpl, _("Failed to create file “%s”: %s"),
+                        saved_errno);
+      g_free (tmpl);
+      return FALSE;
+    }
+
+  if (!write_to_file (contents, length, g_steal_fd (&fd), tmpl, do_fsync, error))
+    {
+      g_unlink (tmpl);
+      g_free (tmpl);
+      return FALSE;
+    }
+
+  *tmp_filename = tmpl;
+  return TRUE;
+}
+
+/* Renames @tmp_filename over @filename, or unlinks it on failure */
+static gboolean
+replace_file (const gchar  *tmp_filename,
+              const gchar  *filename,
+              gboolean      do_fsync,
+              GError      **error)
+{
+  GError *rename_error = NULL;
+
+  if (!rename_file (tmp_filename, filename, do_fsync, &rename_error))
+    {
+#ifndef G_OS_WIN32
+
+      g_unlink (tmp_filename);
+      g_propagate_error (error, rename_error);
+      return FALSE;
+
+#else /* G_OS_WIN32 */
+
+      /* Renaming failed, but on Windows this may just mean
+       * the file already exists. So if the target file
+       * exists, try deleting it and do the rename again.
+       */
+      if (!g_file_test (filename, G_FILE_TEST_EXISTS))
+        {
+          g_unlink (tmp_filename);
+          g_propagate_error (error, rename_error);
+          return FALSE;
+        }
+
+      g_error_free (rename_error);
+
+      if (g_unlink (filename) == -1)
+        {
+          int saved_errno = errno;
+          if (error)
+            set_file_error (error,
+                            filename,
+                            _("Existing file “%s” could not be removed: g_unlink() failed: %s"),
+                            saved_errno);
+          g_unlink (tmp_filename);
+          return FALSE;
+        }
+
+      if (!rename_file (tmp_filename, filename, do_fsync, error))
+        {
+          g_unlink (tmp_filename);
+          return FALSE;
+        }
+
+#endif  /* G_OS_WIN32 */
+    }
+
+  return TRUE;
+}
+
 /**
  * g_file_set_contents:
  * @filename: (type filename): name of a file to write @contents to, in the GLib file name
@@ -1315,12 +1633,18 @@ g_file_set_contents (const gchar  *filename,
  * Possible error codes are those in the #GFileError enumeration.
  *
  * Note that the name for the temporary file is constructed by appending up
- * to 7 characters to @filename.
+ * to 7 characters to @filename. Where the system supports `O_TMPFILE`, the
+ * temporary file is only given that name once its contents are complete, and
+ * if @filename does not already exist the file is given its final name
+ * directly.
  *
  * If the file didn’t exist before and is created, it will be given the
  * permissions from @mode. Otherwise, the permissions of the existing file may
  * be changed to @mode depending on @flags, or they may remain unchanged.
  *
+ * To replace several files at once, see #GFileSetContentsBatch, which
+ * batches the `fsync()` calls.
+ *
  * Returns: %TRUE on success, %FALSE if an error occurred
  *
  * Since: 2.66
@@ -1358,86 +1682,23 @@ g_file_set_contents_full (const gchar            *filename,
   if (flags & G_FILE_SET_CONTENTS_CONSISTENT)
     {
       gchar *tmp_filename = NULL;
-      GError *rename_error = NULL;
       gboolean retval;
-      int fd;
       gboolean do_fsync;
 
-      tmp_filename = g_strdup_printf ("%s.XXXXXX", filename);
-
-      errno = 0;
-      fd = g_mkstemp_full (tmp_filename, O_RDWR | O_BINARY | O_CLOEXEC, mode);
-
-      if (fd == -1)
-        {
-          int saved_errno = errno;
-          if (error)
-            set_file_error (error,
-                            tmp_filename, _("Failed to create file “%s”: %s"),
-                            saved_errno);
-          retval = FALSE;
-          goto consistent_out;
-        }
-
-      do_fsync = fd_should_be_fsynced (fd, filename, flags);
-      if (!write_to_file (contents, length, g_steal_fd (&fd), tmp_filename, do_fsync, error))
-        {
-          g_unlink (tmp_filename);
-          retval = FALSE;
-          goto consistent_out;
-        }
+      do_fsync = fd_should_be_fsynced (-1, filename, flags);
+      if (!write_tmp_file (filename, contents, length, mode, do_fsync, TRUE,
+                           &tmp_filename, error))
+        return FALSE;
 
-      if (!rename_file (tmp_filename, filename, do_fsync, &rename_error))
+      /* Linked into place already */
+      if (tmp_filename == NULL)
         {
-#ifndef G_OS_WIN32
-
-          g_unlink (tmp_filename);
-          g_propagate_error (error, rename_error);
-          retval = FALSE;
-          goto consistent_out;
-
-#else /* G_OS_WIN32 */
-
-          /* Renaming failed, but on Windows this may just mean
-           * the file already exists. So if the target file
-           * exists, try deleting it and do the rename again.
-           */
-          if (!g_file_test (filename, G_FILE_TEST_EXISTS))
-            {
-              g_unlink (tmp_filename);
-              g_propagate_error (error, rename_error);
-              retval = FALSE;
-              goto consistent_out;
-            }
-
-          g_error_free (rename_error);
-
-          if (g_unlink (filename) == -1)
-            {
-              int saved_errno = errno;
-              if (error)
-                set_file_error (error,
-                                filename,
-                                _("Existing file “%s” could not be removed: g_unlink() failed: %s"),
-                                saved_errno);
-              g_unlink (tmp_filename);
-              retval = FALSE;
-              goto consistent_out;
-            }
-
-          if (!rename_file (tmp_filename, filename, flags, error))
-            {
-              g_unlink (tmp_filename);
-              retval = FALSE;
-              goto consistent_out;
-            }
-
-#endif  /* G_OS_WIN32 */
+          if (do_fsync)
+            fsync_directory_of (filename);
+          return TRUE;
         }
 
-      retval = TRUE;
-
-consistent_out:
+      retval = replace_file (tmp_filename, filename, do_fsync, error);
       g_free (tmp_filename);
       return retval;
     }
@@ -1500,12 +1761,314 @@ consistent_out:
   return TRUE;
 }
 
+typedef struct
+{
+  gchar *filename;
+  gchar *tmp_filename;  /* (nullable) once replaced */
+  gboolean do_fsync;
+} BatchEntry;
+
+/**
+ * GFileSetContentsBatch:
+ *
+ * An opaque structure for replacing the contents of several files with the
+ * guarantees of g_file_set_contents_full(), at a lower cost than replacing
+ * them one at a time.
+ *
+ * Each file added with g_file_set_contents_batch_add() is written to a
+ * temporary file straight away. g_file_set_contents_batch_commit() then
+ * flushes all of them to disk at once, where the system supports it, renames
+ * each over its destination, and synchronises each containing directory
+ * once. Replacing N files in one directory this way costs a couple of
+ * `fsync()` calls rather than 2N.
+ *
+ * The batch is not atomic as a whole: each file is replaced atomically, but
+ * if renaming one of them fails, the files before it have already been
+ * replaced.
+ *
+ * A #GFileSetContentsBatch is not thread safe.
+ *
+ * Since: 2.82
+ */
+struct _GFileSetContentsBatch
+{
+  GFileSetContentsFlags flags;
+  GArray *entries;  /* (element-type BatchEntry) */
+};
+
+static void
+batch_entry_clear (gpointer data)
+{
+  BatchEntry *entry = data;
+
+  if (entry->tmp_filename != NULL)
+    g_unlink (entry->tmp_filename);
+
+  g_free (entry->tmp_filename);
+  g_free (entry->filename);
+}
+
+/**
+ * g_file_set_contents_batch_new:
+ * @flags: flags controlling the safety vs speed of the operation
+ *
+ * Creates a new, empty #GFileSetContentsBatch.
+ *
+ * @flags are interpreted as for g_file_set_contents_full(), except that
+ * %G_FILE_SET_CONTENTS_CONSISTENT is always implied.
+ *
+ * Returns: (transfer full): a new #GFileSetContentsBatch
+ *
+ * Since: 2.82
+ */
+GFileSetContentsBatch *
+g_file_set_contents_batch_new (GFileSetContentsFlags flags)
+{
+  GFileSetContentsBatch *batch = g_new0 (GFileSetContentsBatch, 1);
+
+  batch->flags = flags | G_FILE_SET_CONTENTS_CONSISTENT;
+  batch->entries = g_array_new (FALSE, FALSE, sizeof (BatchEntry));
+  g_array_set_clear_func (batch->entries, batch_entry_clear);
+
+  return batch;
+}
+
+/**
+ * g_file_set_contents_batch_add:
+ * @batch: a #GFileSetContentsBatch
+ * @filename: (type filename): name of a file to write @contents to, in the GLib file name
+ *   encoding
+ * @contents: (array length=length) (element-type guint8): string to write to the file
+ * @length: length of @contents, or -1 if @contents is a nul-terminated string
+ * @mode: file mode, as passed to `open()`; typically this will be `0666`
+ * @error: return location for a #GError, or %NULL
+ *
+ * Writes @contents to a temporary file next to @filename, which replaces
+ * @filename when @batch is committed with g_file_set_contents_batch_commit().
+ *
+ * @filename is not modified until then. If @batch is freed without being
+ * committed, the temporary file is removed again.
+ *
+ * Adding the same @filename twice is not supported.
+ *
+ * Returns: %TRUE on success, %FALSE if an error occurred
+ *
+ * Since: 2.82
+ */
+gboolean
+g_file_set_contents_batch_add (GFileSetContentsBatch  *batch,
+                               const gchar            *filename,
+                               const gchar            *contents,
+                               gssize                  length,
+                               int                     mode,
+                               GError                **error)
+{
+  BatchEntry entry = { NULL, NULL, FALSE };
+  gboolean fsync_now;
+
+  g_return_val_if_fail (batch != NULL, FALSE);
+  g_return_val_if_fail (filename != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+  g_return_val_if_fail (contents != NULL || length == 0, FALSE);
+  g_return_val_if_fail (length >= -1, FALSE);
+
+  if (length < 0)
+    length = strlen (contents);
+
+  entry.do_fsync = fd_should_be_fsynced (-1, filename, batch->flags);
+
+  /* With syncfs() the data is flushed once per file system on commit;
+   * otherwise each file has to be flushed on its own */
+#ifdef HAVE_SYNCFS
+  fsync_now = FALSE;
+#else
+  fsync_now = entry.do_fsync;
+#endif
+
+  /* Never link straight to @filename, as that would make it visible before
+   * the batch is committed */
+  if (!write_tmp_file (filename, contents, length, mode, fsync_now, FALSE,
+                       &entry.tmp_filename, error))
+    return FALSE;
+
+  entry.filename = g_strdup (filename);
+  g_array_append_val (batch->entries, entry);
+
+  return TRUE;
+}
+
+#ifdef HAVE_SYNCFS
+/* Flushes every file system holding a temporary file which needs to be
+ * synced, once each */
+static gboolean
+batch_syncfs (GFileSetContentsBatch  *batch,
+              GError                **error)
+{
+  GArray *devices = g_array_new (FALSE, FALSE, sizeof (dev_t));
+  gboolean retval = TRUE;
+  guint i, j;
+
+  for (i = 0; i < batch->entries->len && retval; i++)
+    {
+      BatchEntry *entry = &g_array_index (batch->entries, BatchEntry, i);
+      struct stat statbuf;
+      int fd;
+
+      if (entry->tmp_filename == NULL || !entry->do_fsync)
+        continue;
+
+      fd = g_open (entry->tmp_filename, O_RDONLY | O_CLOEXEC, 0);
+      if (fd < 0)
+        {
+          int saved_errno = errno;
+          set_file_error (error,
+                          entry->tmp_filename, _("Failed to open file “%s”: %s"),
+                          saved_errno);
+          retval = FALSE;
+          break;
+        }
+
+      if (fstat (fd, &statbuf) != 0)
+        {
+          int saved_errno = errno;
+          set_file_error (error,
+                          entry->tmp_filename,
+                          _("Failed to get attributes of file “%s”: fstat() failed: %s"),
+                          saved_errno);
+          retval = FALSE;
+        }
+      else
+        {
+          for (j = 0; j < devices->len; j++)
+            if (g_array_index (devices, dev_t, j) == statbuf.st_dev)
+              break;
+
+          if (j == devices->len)
+            {
+              g_array_append_val (devices, statbuf.st_dev);
+
+              if (syncfs (fd) != 0)
+                {
+                  int saved_errno = errno;
+                  set_file_error (error,
+                                  entry->filename,
+                                  _("Failed to write file “%s”: fsync() failed: %s"),
+                                  saved_errno);
+                  retval = FALSE;
+                }
+            }
+        }
+
+      close (fd);
+    }
+
+  g_array_unref (devices);
+
+  return retval;
+}
+#endif  /* HAVE_SYNCFS */
+
+/**
+ * g_file_set_contents_batch_commit:
+ * @batch: a #GFileSetContentsBatch
+ * @error: return location for a #GError, or %NULL
+ *
+ * Replaces each file added to @batch with its new contents.
+ *
+ * The new contents are flushed to disk, if the flags @batch was created with
+ * require it, before any file is replaced. Each file is then renamed into
+ * place, and each directory containing them is synchronised once at the
+ * end.
+ *
+ * If an error occurs, the files replaced so far keep their new contents,
+ * and the remaining ones are left unchanged. Their temporary files are
+ * removed when @batch is freed.
+ *
+ * After a successful commit @batch is empty, and may be reused.
+ *
+ * Returns: %TRUE on success, %FALSE if an error occurred
+ *
+ * Since: 2.82
+ */
+gboolean
+g_file_set_contents_batch_commit (GFileSetContentsBatch  *batch,
+                                  GError                **error)
+{
+  GPtrArray *dirs;
+  gboolean retval = TRUE;
+  guint i;
+
+  g_return_val_if_fail (batch != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+#ifdef HAVE_SYNCFS
+  if (!batch_syncfs (batch, error))
+    return FALSE;
+#endif
+
+  dirs = g_ptr_array_new_with_free_func (g_free);
+
+  for (i = 0; i < batch->entries->len; i++)
+    {
+      BatchEntry *entry = &g_array_index (batch->entries, BatchEntry, i);
+      gchar *dir;
+
+      if (entry->tmp_filename == NULL)
+        continue;
+
+      /* Directories are synced once, below */
+      if (!replace_file (entry->tmp_filename, entry->filename, FALSE, error))
+        {
+          g_clear_pointer (&entry->tmp_filename, g_free);
+          retval = FALSE;
+          break;
+        }
+
+      g_clear_pointer (&entry->tmp_filename, g_free);
+
+      if (!entry->do_fsync)
+        continue;
+
+      dir = g_path_get_dirname (entry->filename);
+      if (!g_ptr_array_find_with_equal_func (dirs, dir, g_str_equal, NULL))
+        g_ptr_array_add (dirs, g_steal_pointer (&dir));
+      g_free (dir);
+    }
+
+  /* Even after a failure, make sure the files which were replaced stay so */
+  for (i = 0; i < dirs->len; i++)
+    fsync_directory (g_ptr_array_index (dirs, i));
+
+  g_ptr_array_unref (dirs);
+
+  if (retval)
+    g_array_set_size (batch->entries, 0);
+
+  return retval;
+}
+
+/**
+ * g_file_set_contents_batch_free:
+ * @batch: (transfer full): a #GFileSetContentsBatch
+ *
+ * Frees @batch, removing the temporary files of any contents which were
+ * added to it but not committed.
+ *
+ * Since: 2.82
+ */
+void
+g_file_set_contents_batch_free (GFileSetContentsBatch *batch)
+{
+  g_return_if_fail (batch != NULL);
+
+  g_array_unref (batch->entries);
+  g_free (batch);
+}
+
 /*
  * get_tmp_file based on the mkstemp implementation from the GNU C library.
  * Copyright (C) 1991,92,93,94,95,96,97,98,99 Free Software Foundation, Inc.
  */
-typedef gint (*GTmpFileCallback) (const gchar *, gint, gint);
-
 static gint
 get_tmp_file (gchar            *tmpl,
               GTmpFileCallback  f,
@@ -1896,13 +2459,69 @@ g_dir_make_tmp (const gchar  *tmpl,
     return fulltemplate;
 }
 
+/* Appends @n bytes of @src to @dest at offset *@len, and advances *@len;
+ * if @dest is %NULL, only the length is accounted for.
+ */
+static inline void
+build_path_append (gchar       *dest,
+                   gsize       *len,
+                   const gchar *src,
+                   gsize        n)
+{
+  if (dest != NULL)
+    memcpy (dest + *len, src, n);
+  *len += n;
+}
+
+typedef gsize (* BuildPathWriteFunc) (const gchar  *separator,
+                                      const gchar  *first_element,
+                                      va_list      *args,
+                                      gchar       **str_array,
+                                      gchar        *dest);
+
+/* Runs @write_func once to measure the path, and once more to write it
+ * into a buffer of exactly the right size, so that building a path costs
+ * a single allocation.
+ */
 static gchar *
-g_build_path_va (const gchar  *separator,
-		 const gchar  *first_element,
-		 va_list      *args,
-		 gchar       **str_array)
+g_build_path_alloc (BuildPathWriteFunc   write_func,
+                    const gchar         *separator,
+                    const gchar         *first_element,
+                    va_list             *args,
+                    gchar              **str_array)
 {
-  GString *result;
+  gchar *result;
+  gsize len;
+
+  if (args != NULL)
+    {
+      va_list args_copy;
+
+      G_VA_COPY (args_copy, *args);
+      len = write_func (separator, first_element, &args_copy, str_array, NULL);
+      va_end (args_copy);
+    }
+  else
+    len = write_func (separator, first_element, NULL, str_array, NULL);
+
+  result = g_malloc (len + 1);
+  write_func (separator, first_element, args, str_array, result);
+
+  return result;
+}
+
+/* Builds the path into @dest, which must be large enough to hold it and
+ * its nul terminator, and returns its length. If @dest is %NULL, only the
+ * length is computed.
+ */
+static gsize
+g_build_path_write (const gchar  *separator,
+		    const gchar  *first_element,
+		    va_list      *args,
+		    gchar       **str_array,
+		    gchar        *dest)
+{
+  gsize len = 0;
   gint separator_len = strlen (separator);
   gboolean is_first = TRUE;
   gboolean have_leading = FALSE;
@@ -1911,8 +2530,6 @@ g_build_path_va (const gchar  *separator,
   const gchar *last_trailing = NULL;
   gint i = 0;
 
-  result = g_string_new (NULL);
-
   if (str_array)
     next_element = str_array[i++];
   else
@@ -1968,7 +2585,7 @@ g_build_path_va (const gchar  *separator,
 	      if (last_trailing <= start)
 		single_element = element;
 		  
-	      g_string_append_len (result, element, start - element);
+	      build_path_append (dest, &len, element, start - element);
 	      have_leading = TRUE;
 	    }
 	  else
@@ -1979,24 +2596,37 @@ g_build_path_va (const gchar  *separator,
 	continue;
 
       if (!is_first)
-	g_string_append (result, separator);
+	build_path_append (dest, &len, separator, separator_len);
       
-      g_string_append_len (result, start, end - start);
+      build_path_append (dest, &len, start, end - start);
       is_first = FALSE;
     }
 
   if (single_element)
     {
-      g_string_free (result, TRUE);
-      return g_strdup (single_element);
-    }
-  else
-    {
-      if (last_trailing)
-	g_string_append (result, last_trailing);
-  
-      return g_string_free (result, FALSE);
+      /* Nothing but the leading separators of this element has been
+       * written so far, so it is safe to overwrite them.
+       */
+      len = 0;
+      build_path_append (dest, &len, single_element, strlen (single_element));
     }
+  else if (last_trailing)
+    build_path_append (dest, &len, last_trailing, strlen (last_trailing));
+
+  if (dest != NULL)
+    dest[len] = '\0';
+
+  return len;
+}
+
+static gchar *
+g_build_path_va (const gchar  *separator,
+		 const gchar  *first_element,
+		 va_list      *args,
+		 gchar       **str_array)
+{
+  return g_build_path_alloc (g_build_path_write, separator,
+                             first_element, args, str_array);
 }
 
 /**
@@ -2082,15 +2712,17 @@ g_build_path (const gchar *separator,
 
 #ifdef G_OS_WIN32
 
-static gchar *
-g_build_pathname_va (const gchar  *first_element,
-		     va_list      *args,
-		     gchar       **str_array)
+static gsize
+g_build_pathname_write (const gchar  *separator G_GNUC_UNUSED,
+			const gchar  *first_element,
+			va_list      *args,
+			gchar       **str_array,
+			gchar        *dest)
 {
-  /* Code copied from g_build_pathv(), and modified to use two
+  /* Code copied from g_build_path_write(), and modified to use two
    * alternative single-character separators.
    */
-  GString *result;
+  gsize len = 0;
   gboolean is_first = TRUE;
   gboolean have_leading = FALSE;
   const gchar *single_element = NULL;
@@ -2099,8 +2731,6 @@ g_build_pathname_va (const gchar  *first_element,
   gchar current_separator = '\\';
   gint i = 0;
 
-  result = g_string_new (NULL);
-
   if (str_array)
     next_element = str_array[i++];
   else
@@ -2163,7 +2793,7 @@ g_build_pathname_va (const gchar  *first_element,
 	      if (last_trailing <= start)
 		single_element = element;
 		  
-	      g_string_append_len (result, element, start - element);
+	      build_path_append (dest, &len, element, start - element);
 	      have_leading = TRUE;
 	    }
 	  else
@@ -2174,42 +2804,52 @@ g_build_pathname_va (const gchar  *first_element,
 	continue;
 
       if (!is_first)
-	g_string_append_len (result, &current_separator, 1);
+	build_path_append (dest, &len, &current_separator, 1);
       
-      g_string_append_len (result, start, end - start);
+      build_path_append (dest, &len, start, end - start);
       is_first = FALSE;
     }
 
   if (single_element)
     {
-      g_string_free (result, TRUE);
-      return g_strdup (single_element);
-    }
-  else
-    {
-      if (last_trailing)
-	g_string_append (result, last_trailing);
-  
-      return g_string_free (result, FALSE);
+      /* Nothing but the leading separators of this element has been
+       * written so far, so it is safe to overwrite them.
+       */
+      len = 0;
+      build_path_append (dest, &len, single_element, strlen (single_element));
     }
+  else if (last_trailing)
+    build_path_append (dest, &len, last_trailing, strlen (last_trailing));
+
+  if (dest != NULL)
+    dest[len] = '\0';
+
+  return len;
 }
 
 #endif
 
-static gchar *
-g_build_filename_va (const gchar  *first_argument,
-                     va_list      *args,
-                     gchar       **str_array)
+static gsize
+g_build_filename_write (const gchar  *separator,
+                        const gchar  *first_argument,
+                        va_list      *args,
+                        gchar       **str_array,
+                        gchar        *dest)
 {
-  gchar *str;
-
 #ifndef G_OS_WIN32
-  str = g_build_path_va (G_DIR_SEPARATOR_S, first_argument, args, str_array);
+  return g_build_path_write (G_DIR_SEPARATOR_S, first_argument, args, str_array, dest);
 #else
-  str = g_build_pathname_va (first_argument, args, str_array);
+  return g_build_pathname_write (NULL, first_argument, args, str_array, dest);
 #endif
+}
 
-  return str;
+static gchar *
+g_build_filename_va (const gchar  *first_argument,
+                     va_list      *args,
+                     gchar       **str_array)
+{
+  return g_build_path_alloc (g_build_filename_write, NULL,
+                             first_argument, args, str_array);
 }
 
 /**
@@ -2304,6 +2944,67 @@ g_build_filename (const gchar *first_element,
   return str;
 }
 
+/**
+ * g_build_filename_to_buffer:
+ * @buffer: (out caller-allocates) (array length=buffer_size) (nullable):
+ *   the buffer to write the path into
+ * @buffer_size: the size of @buffer, in bytes
+ * @first_element: (type filename): the first element in the path
+ * @...: remaining elements in path, terminated by %NULL
+ *
+ * Builds a filename exactly like g_build_filename(), but writes it into
+ * caller-provided memory instead of allocating it.
+ *
+ * If the nul-terminated path fits into @buffer_size bytes it is written
+ * to @buffer; otherwise @buffer is set to the empty string (if
+ * @buffer_size is not zero) and nothing else is written. In both cases,
+ * the length of the full path is returned, not counting the nul
+ * terminator, so a return value greater than or equal to @buffer_size
+ * means the buffer was too small. None of the elements may point into
+ * @buffer.
+ *
+ * This is useful to build paths in a loop, for instance while walking
+ * a directory tree, without an allocation for every path:
+ *
+ * |[<!-- language="C" -->
+ * char path[PATH_MAX];
+ *
+ * if (g_build_filename_to_buffer (path, sizeof (path),
+ *                                 dirname, entry_name, NULL) >= sizeof (path))
+ *   return FALSE;
+ * ]|
+ *
+ * Returns: the length of the built path
+ *
+ * Since: 2.82
+ */
+gsize
+g_build_filename_to_buffer (gchar       *buffer,
+                            gsize        buffer_size,
+                            const gchar *first_element,
+                            ...)
+{
+  va_list args, args_copy;
+  gsize len;
+
+  g_return_val_if_fail (buffer != NULL || buffer_size == 0, 0);
+
+  va_start (args, first_element);
+
+  G_VA_COPY (args_copy, args);
+  len = g_build_filename_write (NULL, first_element, &args_copy, NULL, NULL);
+  va_end (args_copy);
+
+  if (len < buffer_size)
+    g_build_filename_write (NULL, first_element, &args, NULL, buffer);
+  else if (buffer_size > 0)
+    buffer[0] = '\0';
+
+  va_end (args);
+
+  return len;
+}
+
 /**
  * g_file_read_link:
  * @filename: (type filename): the symbolic link
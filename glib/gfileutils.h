@@ -26,6 +26,7 @@
 #endif
 
 #include <glibconfig.h>
+#include <glib/gbytes.h>
 #include <glib/gerror.h>
 
 G_BEGIN_DECLS
@@ -121,6 +122,9 @@ gboolean g_file_get_contents (const gchar  *filename,
                               gchar       **contents,
                               gsize        *length,
                               GError      **error);
+GLIB_AVAILABLE_IN_2_82
+GBytes * g_file_get_contents_bytes (const gchar  *filename,
+                                    GError      **error);
 GLIB_AVAILABLE_IN_ALL
 gboolean g_file_set_contents (const gchar *filename,
                               const gchar *contents,
@@ -134,6 +138,23 @@ gboolean g_file_set_contents_full (const gchar            *filename,
                                    GFileSetContentsFlags   flags,
                                    int                     mode,
                                    GError                **error);
+
+typedef struct _GFileSetContentsBatch GFileSetContentsBatch;
+
+GLIB_AVAILABLE_IN_2_82
+GFileSetContentsBatch *g_file_set_contents_batch_new    (GFileSetContentsFlags   flags);
+GLIB_AVAILABLE_IN_2_82
+gboolean               g_file_set_contents_batch_add    (GFileSetContentsBatch  *batch,
+                                                         const gchar            *filename,
+                                                         const gchar            *contents,
+                                                         gssize                  length,
+                                                         int                     mode,
+                                                         GError                **error);
+GLIB_AVAILABLE_IN_2_82
+gboolean               g_file_set_contents_batch_commit (GFileSetContentsBatch  *batch,
+                                                         GError                **error);
+GLIB_AVAILABLE_IN_2_82
+void                   g_file_set_contents_batch_free   (GFileSetContentsBatch  *batch);
 G_GNUC_END_IGNORE_DEPRECATIONS
 GLIB_AVAILABLE_IN_ALL
 gchar   *g_file_read_link    (const gchar  *filename,
@@ -179,6 +200,11 @@ gchar   *g_build_filenamev    (gchar      **args) G_GNUC_MALLOC;
 GLIB_AVAILABLE_IN_2_56
 gchar   *g_build_filename_valist (const gchar  *first_element,
                                   va_list      *args) G_GNUC_MALLOC;
+GLIB_AVAILABLE_IN_2_82
+gsize    g_build_filename_to_buffer (gchar       *buffer,
+                                     gsize        buffer_size,
+                                     const gchar *first_element,
+                                     ...) G_GNUC_NULL_TERMINATED;
 
 GLIB_AVAILABLE_IN_ALL
 gint     g_mkdir_with_parents (const gchar *pathname,
@@ -0,0 +1,530 @@
+/* gfloatconv.c: Locale-independent conversion between doubles and strings
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Parsing uses the Eisel–Lemire algorithm (Daniel Lemire, “Number Parsing
+ * at a Gigabyte per Second”, 2021), and formatting uses Schubfach
+ * (Raffaello Giulietti, “The Schubfach way to render doubles”, 2020).
+ * Both multiply by the 128-bit powers of ten in gfloattables.h.
+ *
+ * Neither allocates or looks at the locale. The parser only handles input
+ * whose result it can prove is correctly rounded, and leaves the rest to
+ * the C library.
+ */
+
+#include "config.h"
+
+#include <float.h>
+#include <string.h>
+
+#include "gfloatconvprivate.h"
+#include "gfloattables.h"
+
+#include "gstrfuncs.h"
+
+typedef struct
+{
+  guint64 hi;
+  guint64 lo;
+} FloatU128;
+
+static inline FloatU128
+float_mul_64 (guint64 a,
+              guint64 b)
+{
+  FloatU128 r;
+#ifdef HAVE_UINT128_T
+  __uint128_t p = (__uint128_t) a * b;
+
+  r.lo = (guint64) p;
+  r.hi = (guint64) (p >> 64);
+#else
+  guint64 ha = a >> 32, hb = b >> 32, la = (guint32) a, lb = (guint32) b;
+  guint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  guint64 t = rl + (rm0 << 32), c = t < rl;
+
+  r.lo = t + (rm1 << 32);
+  c += r.lo < t;
+  r.hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+
+  return r;
+}
+
+static inline gint
+float_clz64 (guint64 v)
+{
+#if defined(__GNUC__) || g_macro__has_builtin(__builtin_clzll)
+  return __builtin_clzll (v);
+#else
+  gint n = 0;
+
+  while (!(v & (G_GUINT64_CONSTANT (1) << 63)))
+    {
+      v <<= 1;
+      n++;
+    }
+
+  return n;
+#endif
+}
+
+/* floor (log2 (10^e)), for |e| < 1700 or so */
+static inline gint
+float_floor_log2_pow10 (gint e)
+{
+  return (gint) (((gint64) e * G_GINT64_CONSTANT (913124641741)) >> 38);
+}
+
+/* floor (log10 (2^e)) */
+static inline gint
+float_floor_log10_pow2 (gint e)
+{
+  return (gint) (((gint64) e * G_GINT64_CONSTANT (661971961083)) >> 41);
+}
+
+/* floor (log10 (3/4 × 2^e)) */
+static inline gint
+float_floor_log10_three_quarters_pow2 (gint e)
+{
+  return (gint) (((gint64) e * G_GINT64_CONSTANT (661971961083) -
+                  G_GINT64_CONSTANT (274743187321)) >> 41);
+}
+
+static inline const guint64 *
+float_pow10 (gint q)
+{
+  return g_float_pow10_table[q - G_FLOAT_POW10_MIN_EXPONENT];
+}
+
+#define DOUBLE_MANTISSA_BITS 52
+#define DOUBLE_EXPONENT_BIAS 1023
+
+/* Store the double closest to @w × 10^@q in @bits. Returns %FALSE if that
+ * can't be done quickly, or the result is infinite, subnormal or zero
+ * (where the caller needs strtod() to set errno). */
+static gboolean
+float_decimal_to_double (guint64  w,
+                         gint     q,
+                         guint64 *bits)
+{
+  const guint64 *t;
+  FloatU128 p1, p2;
+  guint64 z0, z1, z2, m;
+  gint lz, shift, e;
+  gboolean exact, sticky;
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+  /* Clinger's fast path: both operands are exact, so a single correctly
+   * rounded operation gives the right answer. */
+  if (w <= (G_GUINT64_CONSTANT (1) << 53) && q >= -22 && q <= 22)
+    {
+      static const gdouble exact_pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+      };
+      gdouble d = (gdouble) w;
+
+      if (q < 0)
+        d /= exact_pow10[-q];
+      else
+        d *= exact_pow10[q];
+
+      memcpy (bits, &d, sizeof (d));
+      return TRUE;
+    }
+#endif
+
+  if (q < G_FLOAT_POW10_MIN_EXPONENT || q > DBL_MAX_10_EXP)
+    return FALSE;
+
+  /* With w normalised to 64 bits and the 128 bits of 10^q from the table,
+   * take the top of the 192-bit product, normalised so that bit 191 is set. */
+  lz = float_clz64 (w);
+  w <<= lz;
+  t = float_pow10 (q);
+
+  p1 = float_mul_64 (w, t[0]);
+  p2 = float_mul_64 (w, t[1]);
+  z0 = p2.lo;
+  z1 = p1.lo + p2.hi;
+  z2 = p1.hi + (z1 < p1.lo);
+
+  shift = !(z2 >> 63);
+  if (shift)
+    {
+      z2 = z2 << 1 | z1 >> 63;
+      z1 = z1 << 1 | z0 >> 63;
+      z0 <<= 1;
+    }
+
+  /* The table is exact for 0 ≤ q ≤ 55, as 5^55 < 2^128. Otherwise it is
+   * truncated, so the product is an underestimate by less than w << shift,
+   * i.e. less than 2^65, and the rounding can only be trusted if adding that
+   * can't carry into the round bit (bit 10 of z2). */
+  exact = (q >= 0 && q <= 55);
+  if (!exact && (z2 & 0x3ff) == 0x3ff && z1 >= G_MAXUINT64 - 1)
+    return FALSE;
+
+  /* Round the top 53 bits to nearest, ties to even */
+  m = z2 >> 11;
+  sticky = !exact || (z2 & 0x3ff) != 0 || z1 != 0 || z0 != 0;
+  if (((z2 >> 10) & 1) && (sticky || (m & 1)))
+    m++;
+
+  e = 139 + float_floor_log2_pow10 (q) - 127 - lz - shift;
+  if (m >> (DOUBLE_MANTISSA_BITS + 1))
+    {
+      m >>= 1;
+      e++;
+    }
+
+  e += DOUBLE_MANTISSA_BITS + DOUBLE_EXPONENT_BIAS;
+  if (e <= 0 || e >= 0x7ff)
+    return FALSE;
+
+  *bits = (guint64) e << DOUBLE_MANTISSA_BITS |
+          (m & ((G_GUINT64_CONSTANT (1) << DOUBLE_MANTISSA_BITS) - 1));
+
+  return TRUE;
+}
+
+/* Appends the decimal digit @d to the significand @w. Only 19 digits fit,
+ * and zeros after that can be accounted for in @exp10, but any other digit
+ * would need the slow path. */
+static inline gboolean
+float_push_digit (guint     d,
+                  gboolean  fraction,
+                  guint64  *w,
+                  gint     *n_digits,
+                  gint     *exp10)
+{
+  if (*n_digits < 19)
+    {
+      *w = *w * 10 + d;
+      if (*w != 0)
+        (*n_digits)++;
+      if (fraction)
+        (*exp10)--;
+    }
+  else if (d != 0)
+    return FALSE;
+  else if (!fraction)
+    (*exp10)++;
+
+  return TRUE;
+}
+
+/*
+ * g_ascii_strtod_fast:
+ * @nptr: the string to convert
+ * @endptr: (optional): return location for the end of the number
+ * @value: return location for the number
+ *
+ * Parses a decimal floating point number like `strtod()` does in the C
+ * locale, if that can be done quickly and exactly.
+ *
+ * Hexadecimal numbers, infinities, NaNs, more than 19 significant digits,
+ * and results which over- or underflow aren’t handled.
+ *
+ * Returns: %TRUE if @value and @endptr were set, %FALSE if the caller
+ *   needs to use `strtod()`
+ */
+gboolean
+g_ascii_strtod_fast (const gchar  *nptr,
+                     gchar       **endptr,
+                     gdouble      *value)
+{
+  const gchar *p = nptr;
+  gboolean negative = FALSE, any_digits = FALSE;
+  guint64 w = 0, bits;
+  gint n_digits = 0, exp10 = 0;
+
+  /* The C locale’s isspace() */
+  while (*p == ' ' || (*p >= '\t' && *p <= '\r'))
+    p++;
+
+  if (*p == '+' || *p == '-')
+    negative = *p++ == '-';
+
+  if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+    return FALSE;
+
+  for (; g_ascii_isdigit (*p); p++, any_digits = TRUE)
+    if (!float_push_digit (*p - '0', FALSE, &w, &n_digits, &exp10))
+      return FALSE;
+
+  if (*p == '.')
+    {
+      p++;
+      for (; g_ascii_isdigit (*p); p++, any_digits = TRUE)
+        if (!float_push_digit (*p - '0', TRUE, &w, &n_digits, &exp10))
+          return FALSE;
+    }
+
+  if (!any_digits)
+    return FALSE;
+
+  if (*p == 'e' || *p == 'E')
+    {
+      const gchar *q = p + 1;
+      gboolean exp_negative = FALSE;
+      gint exponent = 0;
+
+      if (*q == '+' || *q == '-')
+        exp_negative = *q++ == '-';
+
+      if (g_ascii_isdigit (*q))
+        {
+          for (; g_ascii_isdigit (*q); q++)
+            if (exponent < 100000)
+              exponent = exponent * 10 + (*q - '0');
+
+          exp10 += exp_negative ? -exponent : exponent;
+          p = q;
+        }
+    }
+
+  if (w == 0)
+    bits = 0;
+  else if (!float_decimal_to_double (w, exp10, &bits))
+    return FALSE;
+
+  if (negative)
+    bits |= G_GUINT64_CONSTANT (1) << 63;
+
+  memcpy (value, &bits, sizeof (bits));
+  if (endptr != NULL)
+    *endptr = (gchar *) p;
+
+  return TRUE;
+}
+
+/* The top 126 bits of @g × @cp / 2^127, rounded to odd */
+static inline guint64
+float_round_to_odd (guint64 g1,
+                    guint64 g0,
+                    guint64 cp)
+{
+  const guint64 mask63 = G_MAXUINT64 >> 1;
+  guint64 x1 = float_mul_64 (g0, cp).hi;
+  FloatU128 y = float_mul_64 (g1, cp);
+  guint64 z = (y.lo >> 1) + x1;
+  guint64 vbp = y.hi + (z >> 63);
+
+  return vbp | (((z & mask63) + mask63) >> 63);
+}
+
+/* Schubfach: find the shortest decimal @f × 10^@e which rounds to
+ * @c × 2^@q, preferring the closest one. */
+static void
+float_to_decimal (gint     q,
+                  guint64  c,
+                  gint     dk,
+                  guint64 *f,
+                  gint    *e)
+{
+  const guint64 c_min = G_GUINT64_CONSTANT (1) << DOUBLE_MANTISSA_BITS;
+  const gint q_min = -1074;
+  guint64 out = c & 1;
+  guint64 cb = c << 2, cbr = cb + 2, cbl;
+  guint64 g1, g0, vb, vbl, vbr, s, t;
+  const guint64 *pow10;
+  gint k, h;
+  gint64 cmp;
+  gboolean uin, win;
+
+  if (c != c_min || q == q_min)
+    {
+      cbl = cb - 2;
+      k = float_floor_log10_pow2 (q);
+    }
+  else
+    {
+      /* The gap below a power of two is half the size */
+      cbl = cb - 1;
+      k = float_floor_log10_three_quarters_pow2 (q);
+    }
+
+  h = q + float_floor_log2_pow10 (-k) + 2;
+
+  /* g = floor (10^-k × 2^(125 - floor (log2 (10^-k)))) + 1, split into two
+   * 63-bit halves */
+  pow10 = float_pow10 (-k);
+  g0 = ((pow10[0] << 62 | pow10[1] >> 2) & (G_MAXUINT64 >> 1)) + 1;
+  g1 = pow10[0] >> 1;
+  g1 += g0 >> 63;
+  g0 &= G_MAXUINT64 >> 1;
+
+  vb = float_round_to_odd (g1, g0, cb << h);
+  vbl = float_round_to_odd (g1, g0, cbl << h);
+  vbr = float_round_to_odd (g1, g0, cbr << h);
+
+  s = vb >> 2;
+  if (s >= 10)
+    {
+      /* Try one digit fewer first */
+      guint64 sp10 = s / 10 * 10;
+      guint64 tp10 = sp10 + 10;
+      gboolean upin = vbl + out <= sp10 << 2;
+      gboolean wpin = (tp10 << 2) + out <= vbr;
+
+      if (upin != wpin)
+        {
+          *f = upin ? sp10 : tp10;
+          *e = k;
+          return;
+        }
+    }
+
+  t = s + 1;
+  uin = vbl + out <= s << 2;
+  win = (t << 2) + out <= vbr;
+
+  if (uin != win)
+    *f = uin ? s : t;
+  else
+    {
+      /* Both are in range: pick the closer, or the even one on a tie */
+      cmp = (gint64) vb - (gint64) ((s + t) << 1);
+      *f = (cmp < 0 || (cmp == 0 && (s & 1) == 0)) ? s : t;
+    }
+
+  *e = k + dk;
+}
+
+/*
+ * g_ascii_dtostr_shortest:
+ * @buffer: a buffer of at least %G_ASCII_DTOSTR_BUF_SIZE bytes
+ * @d: the value to convert
+ *
+ * Formats @d with the fewest significant digits which convert back to the
+ * same double, choosing the closest if there are several.
+ *
+ * The layout is the same as `printf()`’s `%.17g` would use: exponential
+ * notation if the decimal exponent is less than -4 or at least 17, and no
+ * trailing zeros.
+ *
+ * Returns: the length of the string in @buffer, or 0 if @d is not finite
+ *   and nothing was written
+ */
+gsize
+g_ascii_dtostr_shortest (gchar   *buffer,
+                         gdouble  d)
+{
+  guint64 bits, mantissa, f;
+  gint biased_exponent, e, n_digits, exponent, i;
+  gchar digits[20];
+  gchar *p = buffer;
+
+  memcpy (&bits, &d, sizeof (bits));
+  mantissa = bits & ((G_GUINT64_CONSTANT (1) << DOUBLE_MANTISSA_BITS) - 1);
+  biased_exponent = (bits >> DOUBLE_MANTISSA_BITS) & 0x7ff;
+
+  if (biased_exponent == 0x7ff)
+    return 0;
+
+  if (bits >> 63)
+    *p++ = '-';
+
+  if (biased_exponent != 0)
+    {
+      gint mq = DOUBLE_EXPONENT_BIAS + DOUBLE_MANTISSA_BITS - biased_exponent;
+      guint64 c = mantissa | (G_GUINT64_CONSTANT (1) << DOUBLE_MANTISSA_BITS);
+
+      /* Integers are exact */
+      if (mq > 0 && mq <= DOUBLE_MANTISSA_BITS && ((c >> mq) << mq) == c)
+        {
+          f = c >> mq;
+          e = 0;
+        }
+      else
+        float_to_decimal (-mq, c, 0, &f, &e);
+    }
+  else if (mantissa != 0)
+    {
+      float_to_decimal (-1074, mantissa, 0, &f, &e);
+    }
+  else
+    {
+      f = 0;
+      e = 0;
+    }
+
+  while (f >= 10 && f % 10 == 0)
+    {
+      f /= 10;
+      e++;
+    }
+
+  n_digits = 0;
+  do
+    {
+      digits[G_N_ELEMENTS (digits) - ++n_digits] = '0' + f % 10;
+      f /= 10;
+    }
+  while (f != 0);
+  memmove (digits, digits + G_N_ELEMENTS (digits) - n_digits, n_digits);
+
+  /* The exponent of the first digit */
+  exponent = n_digits - 1 + e;
+
+  if (exponent < -4 || exponent >= 17)
+    {
+      *p++ = digits[0];
+      if (n_digits > 1)
+        {
+          *p++ = '.';
+          memcpy (p, digits + 1, n_digits - 1);
+          p += n_digits - 1;
+        }
+
+      *p++ = 'e';
+      *p++ = exponent < 0 ? '-' : '+';
+      if (exponent < 0)
+        exponent = -exponent;
+      if (exponent >= 100)
+        *p++ = '0' + exponent / 100;
+      *p++ = '0' + exponent / 10 % 10;
+      *p++ = '0' + exponent % 10;
+    }
+  else if (exponent < 0)
+    {
+      *p++ = '0';
+      *p++ = '.';
+      for (i = -1; i > exponent; i--)
+        *p++ = '0';
+      memcpy (p, digits, n_digits);
+      p += n_digits;
+    }
+  else
+    {
+      for (i = 0; i <= exponent; i++)
+        *p++ = i < n_digits ? digits[i] : '0';
+      if (n_digits > exponent + 1)
+        {
+          *p++ = '.';
+          memcpy (p, digits + exponent + 1, n_digits - exponent - 1);
+          p += n_digits - exponent - 1;
+        }
+    }
+
+  *p = '\0';
+
+  return p - buffer;
+}
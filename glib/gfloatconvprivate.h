@@ -0,0 +1,34 @@
+/* gfloatconvprivate.h: Locale-independent conversion between doubles and strings
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __G_FLOAT_CONV_PRIVATE_H__
+#define __G_FLOAT_CONV_PRIVATE_H__
+
+#include "gtypes.h"
+
+G_BEGIN_DECLS
+
+gboolean g_ascii_strtod_fast      (const gchar  *nptr,
+                                   gchar       **endptr,
+                                   gdouble      *value);
+gsize    g_ascii_dtostr_shortest  (gchar        *buffer,
+                                   gdouble       d);
+
+G_END_DECLS
+
+#endif /* __G_FLOAT_CONV_PRIVATE_H__ */
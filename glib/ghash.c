@@ -39,9 +39,18 @@
 #include "gatomic.h"
 #include "gtestutils.h"
 #include "gslice.h"
+#include "grand.h"
 #include "grefcount.h"
 #include "gvalgrind.h"
 
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GROUP_MATCH_SSE2
+#elif defined (__ARM_NEON)
+#include <arm_neon.h>
+#define GROUP_MATCH_NEON
+#endif
+
 /* The following #pragma is here so we can do this...
  *
  *   #ifndef USE_SMALL_ARRAYS
@@ -100,6 +109,8 @@
  * Using g_str_hash() in that situation might make your application
  * vulnerable to
  * [Algorithmic Complexity Attacks](https://lwn.net/Articles/474912/).
+ * g_str_hash_fast() is seeded randomly for each process, which makes such
+ * collisions much harder to construct.
  *
  * The key to choosing a good hash is unpredictability.  Even
  * cryptographic hashes are very easy to find collisions for when the
@@ -184,6 +195,22 @@
 #define HASH_IS_TOMBSTONE(h_) ((h_) == TOMBSTONE_HASH_VALUE)
 #define HASH_IS_REAL(h_) ((h_) >= 2)
 
+/* Tables keyed with g_str_hash() or g_str_hash_fast() use grouped probing:
+ * besides the hashes, they keep one control byte per bucket, and probe
+ * groups of GROUP_WIDTH buckets at a time by comparing their control bytes
+ * in parallel. A control byte holds 7 bits of the hash of a real node, so
+ * most buckets whose hash differs can be skipped without touching the
+ * hashes array, which makes lookups in large tables much less cache-miss
+ * bound.
+ *
+ * Tables smaller than a group are padded with CTRL_SENTINEL bytes, which
+ * match neither a tag nor an empty or tombstone bucket. */
+
+#define GROUP_WIDTH 16
+#define CTRL_EMPTY 0x80
+#define CTRL_TOMBSTONE 0xfe
+#define CTRL_SENTINEL 0xff
+
 /* If int is smaller than void * on our arch, we start out with
  * int-sized keys and values and resize to pointer-sized entries as
  * needed. This saves a good amount of memory when the HT is being
@@ -197,6 +224,20 @@
 # define USE_SMALL_ARRAYS
 #endif
 
+/* Most tables never grow beyond the minimum size. Those keep their hashes,
+ * control bytes, keys and values in a single allocation, in that order,
+ * with room for big keys and values so that entries can be widened, and a
+ * set turned into a map, in place. Lookups in them compare the hash of the
+ * key against all the buckets at once rather than probing.
+ *
+ * The storage moves to separate arrays when the table grows, and back
+ * into a single allocation if it shrinks to the minimum size again. */
+
+#define INLINE_SIZE (1 << HASH_TABLE_MIN_SHIFT)
+#define INLINE_ENTRIES_SIZE (INLINE_SIZE * BIG_ENTRY_SIZE)
+
+G_STATIC_ASSERT (INLINE_SIZE == 8);
+
 struct _GHashTable
 {
   gsize            size;
@@ -204,13 +245,16 @@ struct _GHashTable
   guint            mask;
   guint            nnodes;
   guint            noccupied;  /* nnodes + tombstones */
+  guint            reserved;   /* don't shrink below this many nodes */
 
   guint            have_big_keys : 1;
   guint            have_big_values : 1;
+  guint            inline_storage : 1;
 
   gpointer         keys;
   guint           *hashes;
   gpointer         values;
+  guint8          *ctrl;  /* (nullable) only for grouped probing */
 
   GHashFunc        hash_func;
   GEqualFunc       key_equal_func;
@@ -378,6 +422,240 @@ g_hash_table_hash_to_index (GHashTable *hash_table, guint hash)
   return (hash * 11) % hash_table->mod;
 }
 
+static inline guint8
+g_hash_table_ctrl_tag (guint hash)
+{
+  /* Use the top bits of a multiplicative hash, as the low bits of the hash
+   * already pick the group */
+  return (guint8) ((hash * 0x9E3779B1U) >> 25);
+}
+
+static inline guint8
+g_hash_table_ctrl_for_hash (guint hash)
+{
+  if (HASH_IS_REAL (hash))
+    return g_hash_table_ctrl_tag (hash);
+  else if (HASH_IS_TOMBSTONE (hash))
+    return CTRL_TOMBSTONE;
+  else
+    return CTRL_EMPTY;
+}
+
+/* A bit mask of the buckets in a group with a given control byte. With NEON,
+ * each bucket is represented by the top bit of a nibble. */
+#ifdef GROUP_MATCH_NEON
+typedef guint64 GroupMask;
+#define GROUP_MASK_STRIDE 4
+#else
+typedef guint32 GroupMask;
+#define GROUP_MASK_STRIDE 1
+#endif
+
+static inline GroupMask
+g_hash_table_group_match (const guint8 *ctrl,
+                          guint8        value)
+{
+#if defined (GROUP_MATCH_SSE2)
+  __m128i group = _mm_loadu_si128 ((const __m128i *) ctrl);
+
+  return (GroupMask) _mm_movemask_epi8 (_mm_cmpeq_epi8 (group, _mm_set1_epi8 ((char) value)));
+#elif defined (GROUP_MATCH_NEON)
+  uint8x16_t eq = vceqq_u8 (vld1q_u8 (ctrl), vdupq_n_u8 (value));
+  uint8x8_t narrowed = vshrn_n_u16 (vreinterpretq_u16_u8 (eq), 4);
+
+  return vget_lane_u64 (vreinterpret_u64_u8 (narrowed), 0) & G_GUINT64_CONSTANT (0x8888888888888888);
+#else
+  GroupMask mask = 0;
+  guint i;
+
+  for (i = 0; i < GROUP_WIDTH; i++)
+    mask |= (GroupMask) (ctrl[i] == value) << i;
+
+  return mask;
+#endif
+}
+
+/* Index in the group of the first bucket in a non-empty @mask */
+static inline guint
+g_hash_table_group_mask_first (GroupMask mask)
+{
+#if defined (__GNUC__) || defined (__clang__)
+  return __builtin_ctzll (mask) / GROUP_MASK_STRIDE;
+#else
+  guint i = 0;
+
+  while (!(mask & 1))
+    {
+      mask >>= 1;
+      i++;
+    }
+
+  return i / GROUP_MASK_STRIDE;
+#endif
+}
+
+static inline guint
+g_hash_table_n_groups (GHashTable *hash_table)
+{
+  return MAX (hash_table->size / GROUP_WIDTH, 1);
+}
+
+/* The first group of a probe sequence. Subsequent groups are found by
+ * triangular probing, which visits every group as their number is a power
+ * of two. */
+static inline guint
+g_hash_table_hash_to_group (GHashTable *hash_table, guint hash)
+{
+  return g_hash_table_hash_to_index (hash_table, hash) / GROUP_WIDTH;
+}
+
+/*
+ * g_hash_table_lookup_node_grouped:
+ *
+ * Same as g_hash_table_lookup_node(), for tables using grouped probing.
+ */
+static inline guint
+g_hash_table_lookup_node_grouped (GHashTable    *hash_table,
+                                  gconstpointer  key,
+                                  guint          hash_value)
+{
+  guint groups_mask = g_hash_table_n_groups (hash_table) - 1;
+  guint group = g_hash_table_hash_to_group (hash_table, hash_value);
+  guint8 tag = g_hash_table_ctrl_tag (hash_value);
+  guint first_tombstone = 0;
+  gboolean have_tombstone = FALSE;
+  guint step = 0;
+
+  /* There is always at least one empty bucket, see
+   * g_hash_table_maybe_resize(), so this terminates */
+  for (;;)
+    {
+      guint base = group * GROUP_WIDTH;
+      const guint8 *ctrl = hash_table->ctrl + base;
+      GroupMask match, empty;
+
+      for (match = g_hash_table_group_match (ctrl, tag); match != 0; match &= match - 1)
+        {
+          guint node_index = base + g_hash_table_group_mask_first (match);
+          gpointer node_key;
+
+          if (hash_table->hashes[node_index] != hash_value)
+            continue;
+
+          node_key = g_hash_table_fetch_key_or_value (hash_table->keys, node_index, hash_table->have_big_keys);
+
+          if (hash_table->key_equal_func)
+            {
+              if (hash_table->key_equal_func (node_key, key))
+                return node_index;
+            }
+          else if (node_key == key)
+            {
+              return node_index;
+            }
+        }
+
+      if (!have_tombstone)
+        {
+          GroupMask tombstones = g_hash_table_group_match (ctrl, CTRL_TOMBSTONE);
+
+          if (tombstones != 0)
+            {
+              first_tombstone = base + g_hash_table_group_mask_first (tombstones);
+              have_tombstone = TRUE;
+            }
+        }
+
+      empty = g_hash_table_group_match (ctrl, CTRL_EMPTY);
+      if (empty != 0)
+        return have_tombstone ? first_tombstone : base + g_hash_table_group_mask_first (empty);
+
+      step++;
+      group = (group + step) & groups_mask;
+    }
+}
+
+/* A bit mask of the buckets in a table of INLINE_SIZE whose hash is
+ * @hash_value */
+static inline guint
+g_hash_table_linear_match (const guint *hashes,
+                           guint        hash_value)
+{
+#if defined (GROUP_MATCH_SSE2)
+  __m128i hash = _mm_set1_epi32 ((int) hash_value);
+  __m128i lo = _mm_cmpeq_epi32 (_mm_loadu_si128 ((const __m128i *) hashes), hash);
+  __m128i hi = _mm_cmpeq_epi32 (_mm_loadu_si128 ((const __m128i *) (hashes + 4)), hash);
+
+  return (guint) _mm_movemask_epi8 (_mm_packs_epi16 (_mm_packs_epi32 (lo, hi), _mm_setzero_si128 ()));
+#else
+  guint mask = 0;
+  guint i;
+
+  for (i = 0; i < INLINE_SIZE; i++)
+    mask |= (guint) (hashes[i] == hash_value) << i;
+
+  return mask;
+#endif
+}
+
+static inline guint
+g_hash_table_linear_mask_first (guint mask)
+{
+#if defined (__GNUC__) || defined (__clang__)
+  return __builtin_ctz (mask);
+#else
+  guint i = 0;
+
+  while (!(mask & 1))
+    {
+      mask >>= 1;
+      i++;
+    }
+
+  return i;
+#endif
+}
+
+/*
+ * g_hash_table_lookup_node_linear:
+ *
+ * Same as g_hash_table_lookup_node(), for classic tables of the minimum
+ * size. Any bucket can hold any key, as resizing places every node again.
+ */
+static inline guint
+g_hash_table_lookup_node_linear (GHashTable    *hash_table,
+                                 gconstpointer  key,
+                                 guint          hash_value)
+{
+  guint match;
+
+  for (match = g_hash_table_linear_match (hash_table->hashes, hash_value); match != 0; match &= match - 1)
+    {
+      guint node_index = g_hash_table_linear_mask_first (match);
+      gpointer node_key;
+
+      node_key = g_hash_table_fetch_key_or_value (hash_table->keys, node_index, hash_table->have_big_keys);
+
+      if (hash_table->key_equal_func)
+        {
+          if (hash_table->key_equal_func (node_key, key))
+            return node_index;
+        }
+      else if (node_key == key)
+        {
+          return node_index;
+        }
+    }
+
+  /* Reuse tombstones first. There is always at least one unused or
+   * tombstone bucket, see g_hash_table_maybe_resize(). */
+  match = g_hash_table_linear_match (hash_table->hashes, TOMBSTONE_HASH_VALUE);
+  if (match == 0)
+    match = g_hash_table_linear_match (hash_table->hashes, UNUSED_HASH_VALUE);
+
+  return g_hash_table_linear_mask_first (match);
+}
+
 /*
  * g_hash_table_lookup_node:
  * @hash_table: our #GHashTable
@@ -419,6 +697,12 @@ g_hash_table_lookup_node (GHashTable    *hash_table,
 
   *hash_return = hash_value;
 
+  if (hash_table->ctrl != NULL)
+    return g_hash_table_lookup_node_grouped (hash_table, key, hash_value);
+
+  if (hash_table->size == INLINE_SIZE)
+    return g_hash_table_lookup_node_linear (hash_table, key, hash_value);
+
   node_index = g_hash_table_hash_to_index (hash_table, hash_value);
   node_hash = hash_table->hashes[node_index];
 
@@ -485,6 +769,8 @@ g_hash_table_remove_node (GHashTable   *hash_table,
 
   /* Erect tombstone */
   hash_table->hashes[i] = TOMBSTONE_HASH_VALUE;
+  if (hash_table->ctrl != NULL)
+    hash_table->ctrl[i] = CTRL_TOMBSTONE;
 
   /* Be GC friendly */
   g_hash_table_assign_key_or_value (hash_table->keys, i, hash_table->have_big_keys, NULL);
@@ -508,7 +794,65 @@ g_hash_table_remove_node (GHashTable   *hash_table,
  * Initialise the hash table size, mask, mod, and arrays.
  */
 static void
-g_hash_table_setup_storage (GHashTable *hash_table)
+g_hash_table_reset_ctrl (GHashTable *hash_table)
+{
+  memset (hash_table->ctrl, CTRL_EMPTY, hash_table->size);
+  if (hash_table->size < GROUP_WIDTH)
+    memset (hash_table->ctrl + hash_table->size, CTRL_SENTINEL, GROUP_WIDTH - hash_table->size);
+}
+
+static inline gsize
+g_hash_table_inline_keys_offset (gboolean grouped)
+{
+  return INLINE_SIZE * sizeof (guint) + (grouped ? GROUP_WIDTH : 0);
+}
+
+/* Points the arrays of @hash_table into a new single allocation, see
+ * INLINE_SIZE. Its size must be INLINE_SIZE. */
+static void
+g_hash_table_alloc_inline_storage (GHashTable *hash_table,
+                                   gboolean    grouped,
+                                   gboolean    is_a_set)
+{
+  gsize keys_offset = g_hash_table_inline_keys_offset (grouped);
+  guint8 *block;
+
+  g_assert (hash_table->size == INLINE_SIZE);
+
+  block = g_malloc0 (keys_offset + 2 * INLINE_ENTRIES_SIZE);
+
+  hash_table->hashes = (guint *) block;
+  hash_table->ctrl = grouped ? block + INLINE_SIZE * sizeof (guint) : NULL;
+  hash_table->keys = block + keys_offset;
+  hash_table->values = is_a_set ? hash_table->keys : block + keys_offset + INLINE_ENTRIES_SIZE;
+  hash_table->inline_storage = TRUE;
+}
+
+static void
+g_hash_table_free_storage (gpointer  keys,
+                           gpointer  values,
+                           guint    *hashes,
+                           guint8   *ctrl,
+                           gboolean  inline_storage)
+{
+  /* Everything lives in the block starting with the hashes */
+  if (inline_storage)
+    {
+      g_free (hashes);
+      return;
+    }
+
+  if (keys != values)
+    g_free (values);
+
+  g_free (keys);
+  g_free (hashes);
+  g_free (ctrl);
+}
+
+static void
+g_hash_table_setup_storage (GHashTable *hash_table,
+                            gboolean    grouped)
 {
   gboolean small = FALSE;
 
@@ -531,9 +875,10 @@ g_hash_table_setup_storage (GHashTable *hash_table)
   hash_table->have_big_keys = !small;
   hash_table->have_big_values = !small;
 
-  hash_table->keys   = g_hash_table_realloc_key_or_value_array (NULL, hash_table->size, hash_table->have_big_keys);
-  hash_table->values = hash_table->keys;
-  hash_table->hashes = g_new0 (guint, hash_table->size);
+  g_hash_table_alloc_inline_storage (hash_table, grouped, TRUE);
+
+  if (grouped)
+    g_hash_table_reset_ctrl (hash_table);
 }
 
 /*
@@ -566,8 +911,10 @@ g_hash_table_remove_all_nodes (GHashTable *hash_table,
   gpointer *old_keys;
   gpointer *old_values;
   guint    *old_hashes;
+  guint8   *old_ctrl;
   gboolean  old_have_big_keys;
   gboolean  old_have_big_values;
+  gboolean  old_inline_storage;
 
   /* If the hash table is already empty, there is nothing to be done. */
   if (hash_table->nnodes == 0)
@@ -575,6 +922,7 @@ g_hash_table_remove_all_nodes (GHashTable *hash_table,
 
   hash_table->nnodes = 0;
   hash_table->noccupied = 0;
+  hash_table->reserved = 0;
 
   /* Easy case: no callbacks, so we just zero out the arrays */
   if (!notify ||
@@ -584,6 +932,8 @@ g_hash_table_remove_all_nodes (GHashTable *hash_table,
       if (!destruction)
         {
           memset (hash_table->hashes, 0, hash_table->size * sizeof (guint));
+          if (hash_table->ctrl != NULL)
+            g_hash_table_reset_ctrl (hash_table);
 
 #ifdef USE_SMALL_ARRAYS
           memset (hash_table->keys, 0, hash_table->size * (hash_table->have_big_keys ? BIG_ENTRY_SIZE : SMALL_ENTRY_SIZE));
@@ -620,13 +970,16 @@ g_hash_table_remove_all_nodes (GHashTable *hash_table,
   old_size = hash_table->size;
   old_have_big_keys = hash_table->have_big_keys;
   old_have_big_values = hash_table->have_big_values;
+  old_inline_storage = hash_table->inline_storage;
+  hash_table->inline_storage = FALSE;
   old_keys   = g_steal_pointer (&hash_table->keys);
   old_values = g_steal_pointer (&hash_table->values);
   old_hashes = g_steal_pointer (&hash_table->hashes);
+  old_ctrl = g_steal_pointer (&hash_table->ctrl);
 
   if (!destruction)
     /* Any accesses will see an empty table */
-    g_hash_table_setup_storage (hash_table);
+    g_hash_table_setup_storage (hash_table, old_ctrl != NULL);
   else
     /* Will cause a quick crash on any attempted access */
     hash_table->size = hash_table->mod = hash_table->mask = 0;
@@ -653,17 +1006,57 @@ g_hash_table_remove_all_nodes (GHashTable *hash_table,
     }
 
   /* Destroy old storage space. */
-  if (old_keys != old_values)
-    g_free (old_values);
+  g_hash_table_free_storage (old_keys, old_values, old_hashes, old_ctrl, old_inline_storage);
+}
+
+/* Moves the storage of @hash_table, which has just been resized to or from
+ * INLINE_SIZE, between a single allocation and separate arrays. Only the
+ * first INLINE_SIZE buckets are kept, and control bytes are not. */
+static void
+g_hash_table_move_storage (GHashTable *hash_table, gboolean is_a_set)
+{
+  gpointer old_keys = hash_table->keys;
+  gpointer old_values = hash_table->values;
+  guint *old_hashes = hash_table->hashes;
+  guint8 *old_ctrl = hash_table->ctrl;
+  gboolean old_inline_storage = hash_table->inline_storage;
+  gsize key_size = hash_table->have_big_keys ? BIG_ENTRY_SIZE : SMALL_ENTRY_SIZE;
+  gsize value_size = hash_table->have_big_values ? BIG_ENTRY_SIZE : SMALL_ENTRY_SIZE;
+
+  if (hash_table->size == INLINE_SIZE)
+    {
+      g_hash_table_alloc_inline_storage (hash_table, old_ctrl != NULL, is_a_set);
+    }
+  else
+    {
+      hash_table->hashes = g_new (guint, hash_table->size);
+      if (old_ctrl != NULL)
+        hash_table->ctrl = g_new (guint8, MAX (hash_table->size, GROUP_WIDTH));
+      hash_table->keys = g_hash_table_realloc_key_or_value_array (NULL, hash_table->size, hash_table->have_big_keys);
+      hash_table->values = is_a_set ? hash_table->keys : g_hash_table_realloc_key_or_value_array (NULL, hash_table->size, hash_table->have_big_values);
+      hash_table->inline_storage = FALSE;
+    }
 
-  g_free (old_keys);
-  g_free (old_hashes);
+  memcpy (hash_table->hashes, old_hashes, INLINE_SIZE * sizeof (guint));
+  memcpy (hash_table->keys, old_keys, INLINE_SIZE * key_size);
+  if (!is_a_set)
+    memcpy (hash_table->values, old_values, INLINE_SIZE * value_size);
+
+  g_hash_table_free_storage (old_keys, old_values, old_hashes, old_ctrl, old_inline_storage);
 }
 
 static void
 realloc_arrays (GHashTable *hash_table, gboolean is_a_set)
 {
+  if (hash_table->inline_storage || hash_table->size == INLINE_SIZE)
+    {
+      g_hash_table_move_storage (hash_table, is_a_set);
+      return;
+    }
+
   hash_table->hashes = g_renew (guint, hash_table->hashes, hash_table->size);
+  if (hash_table->ctrl != NULL)
+    hash_table->ctrl = g_renew (guint8, hash_table->ctrl, MAX (hash_table->size, GROUP_WIDTH));
   hash_table->keys = g_hash_table_realloc_key_or_value_array (hash_table->keys, hash_table->size, hash_table->have_big_keys);
 
   if (is_a_set)
@@ -692,6 +1085,46 @@ set_status_bit (guint32 *bitmap, guint index)
   bitmap[index / 32] |= 1U << (index % 32);
 }
 
+/* Finds the first bucket in the probe sequence for @hash which has not been
+ * assigned an entry yet during a resize */
+static inline guint
+find_unassigned_bucket (GHashTable *hash_table, guint hash, const guint32 *bitmap)
+{
+  guint step = 0;
+
+  if (hash_table->ctrl != NULL)
+    {
+      guint groups_mask = g_hash_table_n_groups (hash_table) - 1;
+      guint group = g_hash_table_hash_to_group (hash_table, hash);
+      guint group_size = MIN (hash_table->size, GROUP_WIDTH);
+
+      for (;;)
+        {
+          guint i;
+
+          for (i = group * GROUP_WIDTH; i < group * GROUP_WIDTH + group_size; i++)
+            if (!get_status_bit (bitmap, i))
+              return i;
+
+          step++;
+          group = (group + step) & groups_mask;
+        }
+    }
+  else
+    {
+      guint hash_val = g_hash_table_hash_to_index (hash_table, hash);
+
+      while (get_status_bit (bitmap, hash_val))
+        {
+          step++;
+          hash_val += step;
+          hash_val &= hash_table->mask;
+        }
+
+      return hash_val;
+    }
+}
+
 /* By calling dedicated resize functions for sets and maps, we avoid 2x
  * test-and-branch per key in the inner loop. This yields a small
  * performance improvement at the cost of a bit of macro gunk. */
@@ -724,16 +1157,9 @@ static void fname (GHashTable *hash_table, guint old_size, guint32 *reallocated_
         {                                                               \
           guint hash_val;                                               \
           guint replaced_hash;                                          \
-          guint step = 0;                                               \
-                                                                        \
-          hash_val = g_hash_table_hash_to_index (hash_table, node_hash); \
                                                                         \
-          while (get_status_bit (reallocated_buckets_bitmap, hash_val)) \
-            {                                                           \
-              step++;                                                   \
-              hash_val += step;                                         \
-              hash_val &= hash_table->mask;                             \
-            }                                                           \
+          hash_val = find_unassigned_bucket (hash_table, node_hash,     \
+                                             reallocated_buckets_bitmap); \
                                                                         \
           set_status_bit (reallocated_buckets_bitmap, hash_val);        \
                                                                         \
@@ -813,7 +1239,7 @@ g_hash_table_resize (GHashTable *hash_table)
    * Immediately after growing, the load factor will be in the range
    * .375 .. .469. After shrinking, it will be exactly .5. */
 
-  g_hash_table_set_shift_from_size (hash_table, hash_table->nnodes * 1.333);
+  g_hash_table_set_shift_from_size (hash_table, MAX (hash_table->nnodes, hash_table->reserved) * 1.333);
 
   if (hash_table->size > old_size)
     {
@@ -837,6 +1263,15 @@ g_hash_table_resize (GHashTable *hash_table)
   if (hash_table->size < old_size)
     realloc_arrays (hash_table, is_a_set);
 
+  if (hash_table->ctrl != NULL)
+    {
+      gsize i;
+
+      g_hash_table_reset_ctrl (hash_table);
+      for (i = 0; i < hash_table->size; i++)
+        hash_table->ctrl[i] = g_hash_table_ctrl_for_hash (hash_table->hashes[i]);
+    }
+
   hash_table->noccupied = hash_table->nnodes;
 }
 
@@ -855,7 +1290,8 @@ g_hash_table_maybe_resize (GHashTable *hash_table)
   gsize noccupied = hash_table->noccupied;
   gsize size = hash_table->size;
 
-  if ((size > hash_table->nnodes * 4 && size > 1 << HASH_TABLE_MIN_SHIFT) ||
+  if ((size > hash_table->nnodes * 4 && size > 1 << HASH_TABLE_MIN_SHIFT &&
+       hash_table->nnodes >= hash_table->reserved) ||
       (size <= noccupied + (noccupied / 16)))
     g_hash_table_resize (hash_table);
 }
@@ -869,7 +1305,7 @@ entry_is_big (gpointer v)
 }
 
 static inline gboolean
-g_hash_table_maybe_make_big_keys_or_values (gpointer *a_p, gpointer v, gint ht_size)
+g_hash_table_maybe_make_big_keys_or_values (gpointer *a_p, gpointer v, gint ht_size, gboolean in_place)
 {
   if (entry_is_big (v))
     {
@@ -877,6 +1313,16 @@ g_hash_table_maybe_make_big_keys_or_values (gpointer *a_p, gpointer v, gint ht_s
       gpointer *a_new;
       gint i;
 
+      /* Inline storage has room for big entries. Going backwards, each
+       * entry is only overwritten after it was read. */
+      if (in_place)
+        {
+          for (i = ht_size - 1; i >= 0; i--)
+            ((gpointer *) a)[i] = GUINT_TO_POINTER (a[i]);
+
+          return TRUE;
+        }
+
       a_new = g_new (gpointer, ht_size);
 
       for (i = 0; i < ht_size; i++)
@@ -894,6 +1340,16 @@ g_hash_table_maybe_make_big_keys_or_values (gpointer *a_p, gpointer v, gint ht_s
 
 #endif
 
+/* Returns a copy of the keys of a set, to become its values */
+static inline gpointer
+g_hash_table_split_values (GHashTable *hash_table, gsize entry_size)
+{
+  if (hash_table->inline_storage)
+    return memcpy ((guint8 *) hash_table->keys + INLINE_ENTRIES_SIZE, hash_table->keys, hash_table->size * entry_size);
+
+  return g_memdup2 (hash_table->keys, hash_table->size * entry_size);
+}
+
 static inline void
 g_hash_table_ensure_keyval_fits (GHashTable *hash_table, gpointer key, gpointer value)
 {
@@ -907,7 +1363,7 @@ g_hash_table_ensure_keyval_fits (GHashTable *hash_table, gpointer key, gpointer
       if (hash_table->have_big_keys)
         {
           if (key != value)
-            hash_table->values = g_memdup2 (hash_table->keys, sizeof (gpointer) * hash_table->size);
+            hash_table->values = g_hash_table_split_values (hash_table, sizeof (gpointer));
           /* Keys and values are both big now, so no need for further checks */
           return;
         }
@@ -915,7 +1371,7 @@ g_hash_table_ensure_keyval_fits (GHashTable *hash_table, gpointer key, gpointer
         {
           if (key != value)
             {
-              hash_table->values = g_memdup2 (hash_table->keys, sizeof (guint) * hash_table->size);
+              hash_table->values = g_hash_table_split_values (hash_table, sizeof (guint));
               is_a_set = FALSE;
             }
         }
@@ -924,7 +1380,8 @@ g_hash_table_ensure_keyval_fits (GHashTable *hash_table, gpointer key, gpointer
   /* Make keys big? */
   if (!hash_table->have_big_keys)
     {
-      hash_table->have_big_keys = g_hash_table_maybe_make_big_keys_or_values (&hash_table->keys, key, hash_table->size);
+      hash_table->have_big_keys = g_hash_table_maybe_make_big_keys_or_values (&hash_table->keys, key, hash_table->size,
+                                                                               hash_table->inline_storage);
 
       if (is_a_set)
         {
@@ -936,14 +1393,15 @@ g_hash_table_ensure_keyval_fits (GHashTable *hash_table, gpointer key, gpointer
   /* Make values big? */
   if (!is_a_set && !hash_table->have_big_values)
     {
-      hash_table->have_big_values = g_hash_table_maybe_make_big_keys_or_values (&hash_table->values, value, hash_table->size);
+      hash_table->have_big_values = g_hash_table_maybe_make_big_keys_or_values (&hash_table->values, value, hash_table->size,
+                                                                                 hash_table->inline_storage);
     }
 
 #else
 
   /* Just split if necessary */
   if (is_a_set && key != value)
-    hash_table->values = g_memdup2 (hash_table->keys, sizeof (gpointer) * hash_table->size);
+    hash_table->values = g_hash_table_split_values (hash_table, sizeof (gpointer));
 
 #endif
 }
@@ -1017,6 +1475,7 @@ g_hash_table_new_full (GHashFunc      hash_func,
   g_atomic_ref_count_init (&hash_table->ref_count);
   hash_table->nnodes             = 0;
   hash_table->noccupied          = 0;
+  hash_table->reserved           = 0;
   hash_table->hash_func          = hash_func ? hash_func : g_direct_hash;
   hash_table->key_equal_func     = key_equal_func;
 #ifndef G_DISABLE_ASSERT
@@ -1025,7 +1484,9 @@ g_hash_table_new_full (GHashFunc      hash_func,
   hash_table->key_destroy_func   = key_destroy_func;
   hash_table->value_destroy_func = value_destroy_func;
 
-  g_hash_table_setup_storage (hash_table);
+  g_hash_table_setup_storage (hash_table,
+                              hash_table->hash_func == g_str_hash ||
+                              hash_table->hash_func == g_str_hash_fast);
 
   return hash_table;
 }
@@ -1291,6 +1752,8 @@ g_hash_table_insert_node (GHashTable *hash_table,
   else
     {
       hash_table->hashes[node_index] = key_hash;
+      if (hash_table->ctrl != NULL)
+        hash_table->ctrl[node_index] = g_hash_table_ctrl_tag (key_hash);
       key_to_keep = new_key;
     }
 
@@ -1306,6 +1769,12 @@ g_hash_table_insert_node (GHashTable *hash_table,
     {
       hash_table->nnodes++;
 
+      /* Once the reservation has been filled, the table sizes itself
+       * normally again */
+      if (G_UNLIKELY (hash_table->reserved != 0) &&
+          hash_table->nnodes >= hash_table->reserved)
+        hash_table->reserved = 0;
+
       if (HASH_IS_UNUSED (old_hash))
         {
           /* We replaced an empty node, and not a tombstone */
@@ -1431,10 +1900,9 @@ g_hash_table_unref (GHashTable *hash_table)
   if (g_atomic_ref_count_dec (&hash_table->ref_count))
     {
       g_hash_table_remove_all_nodes (hash_table, TRUE, TRUE);
-      if (hash_table->keys != hash_table->values)
-        g_free (hash_table->values);
-      g_free (hash_table->keys);
-      g_free (hash_table->hashes);
+      g_hash_table_free_storage (hash_table->keys, hash_table->values,
+                                 hash_table->hashes, hash_table->ctrl,
+                                 hash_table->inline_storage);
       g_slice_free (GHashTable, hash_table);
     }
 }
@@ -1661,6 +2129,91 @@ g_hash_table_add (GHashTable *hash_table,
   return g_hash_table_insert_internal (hash_table, key, key, TRUE);
 }
 
+/**
+ * g_hash_table_reserve:
+ * @hash_table: a #GHashTable
+ * @n_entries: the number of entries @hash_table should be able to hold
+ *
+ * Grows @hash_table so that it can hold at least @n_entries entries
+ * without being resized again.
+ *
+ * This is useful when the final size of the table is known in advance:
+ * otherwise the table grows through every power of two on its way to
+ * its final size, rehashing all of its entries each time.
+ *
+ * The table will not shrink below the reserved size until it has held
+ * @n_entries entries once, or until it is emptied with
+ * g_hash_table_remove_all() or g_hash_table_steal_all(). This function
+ * never shrinks the table.
+ *
+ * Since: 2.82
+ */
+void
+g_hash_table_reserve (GHashTable *hash_table,
+                      guint       n_entries)
+{
+  g_return_if_fail (hash_table != NULL);
+  g_return_if_fail (n_entries < (1u << 30));
+
+  if (n_entries <= hash_table->nnodes)
+    return;
+
+  hash_table->reserved = n_entries;
+
+  /* This is the size g_hash_table_resize() will pick */
+  if ((gsize) 1 << g_hash_table_find_closest_shift (n_entries * 1.333) > hash_table->size)
+    g_hash_table_resize (hash_table);
+}
+
+/**
+ * g_hash_table_insert_many:
+ * @hash_table: a #GHashTable
+ * @keys: (array length=n_entries): the keys to insert
+ * @values: (array length=n_entries) (nullable): the values to insert, or
+ *   %NULL to use each key as its own value
+ * @n_entries: the number of entries in @keys and @values
+ *
+ * Inserts @n_entries keys and values into @hash_table, as if by calling
+ * g_hash_table_insert() on each pair in order.
+ *
+ * The table is grown up front with g_hash_table_reserve(), so it is
+ * resized at most once no matter how many entries are inserted.
+ *
+ * If @values is %NULL, each key is inserted as its own value, the same
+ * as g_hash_table_add(). A table which only ever holds keys that are
+ * their own values does not need to allocate separate storage for the
+ * values; see the discussion in the section description.
+ *
+ * Returns: the number of keys which were not in @hash_table yet
+ *
+ * Since: 2.82
+ */
+guint
+g_hash_table_insert_many (GHashTable *hash_table,
+                          gpointer   *keys,
+                          gpointer   *values,
+                          gsize       n_entries)
+{
+  guint n_added = 0;
+  gsize i;
+
+  g_return_val_if_fail (hash_table != NULL, 0);
+  g_return_val_if_fail (keys != NULL || n_entries == 0, 0);
+  g_return_val_if_fail (n_entries < (1u << 30) - hash_table->nnodes, 0);
+
+  g_hash_table_reserve (hash_table, hash_table->nnodes + n_entries);
+
+  for (i = 0; i < n_entries; i++)
+    {
+      if (values != NULL)
+        n_added += g_hash_table_insert_internal (hash_table, keys[i], values[i], FALSE);
+      else
+        n_added += g_hash_table_insert_internal (hash_table, keys[i], keys[i], TRUE);
+    }
+
+  return n_added;
+}
+
 /**
  * g_hash_table_contains:
  * @hash_table: a #GHashTable
@@ -2450,7 +3003,8 @@ gboolean
  *
  * Note that this function may not be a perfect fit for all use cases.
  * For example, it produces some hash collisions with strings as short
- * as 2.
+ * as 2. Unless the hash values need to be stable, g_str_hash_fast() is
+ * a better choice.
  *
  * Returns: a hash value corresponding to the key
  */
@@ -2466,6 +3020,208 @@ g_str_hash (gconstpointer v)
   return h;
 }
 
+/* The hash used by g_str_hash_fast() and g_str_hash_len() is wyhash
+ * (final version 4.2) by Wang Yi, which reads the input 8 or 16 bytes at a
+ * time and mixes it with 64×64→128 bit multiplications. */
+static const guint64 hash_secret[4] = {
+  G_GUINT64_CONSTANT (0xa0761d6478bd642f), G_GUINT64_CONSTANT (0xe7037ed1a0b428db),
+  G_GUINT64_CONSTANT (0x8ebc6af09c88c6e3), G_GUINT64_CONSTANT (0x589965cc75374cc3),
+};
+
+static inline void
+hash_mum (guint64 *a,
+          guint64 *b)
+{
+#ifdef HAVE_UINT128_T
+  __uint128_t r = (__uint128_t) *a * *b;
+
+  *a = (guint64) r;
+  *b = (guint64) (r >> 64);
+#else
+  guint64 ha = *a >> 32, hb = *b >> 32, la = (guint32) *a, lb = (guint32) *b;
+  guint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  guint64 t = rl + (rm0 << 32), c = t < rl;
+  guint64 lo = t + (rm1 << 32);
+
+  c += lo < t;
+  *a = lo;
+  *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline guint64
+hash_mix (guint64 a,
+          guint64 b)
+{
+  hash_mum (&a, &b);
+
+  return a ^ b;
+}
+
+static inline guint64
+hash_read64 (const guint8 *p)
+{
+  guint64 v;
+
+  memcpy (&v, p, sizeof (v));
+
+  return GUINT64_FROM_LE (v);
+}
+
+static inline guint64
+hash_read32 (const guint8 *p)
+{
+  guint32 v;
+
+  memcpy (&v, p, sizeof (v));
+
+  return GUINT32_FROM_LE (v);
+}
+
+/* The seed is random for each process, so that the hash values can’t be
+ * predicted to cause collisions on purpose */
+static guint64 hash_seed;
+
+static guint64
+hash_get_seed (void)
+{
+  static gsize initialized = 0;
+
+  if (g_once_init_enter (&initialized))
+    {
+      GRand *rand = g_rand_new ();
+      guint64 seed = ((guint64) g_rand_int (rand) << 32) | g_rand_int (rand);
+
+      g_rand_free (rand);
+
+      /* This part of the hash only depends on the seed */
+      hash_seed = seed ^ hash_mix (seed ^ hash_secret[0], hash_secret[1]);
+
+      g_once_init_leave (&initialized, 1);
+    }
+
+  return hash_seed;
+}
+
+static inline guint
+hash_bytes (const guint8 *p,
+            gsize         len)
+{
+  guint64 seed = hash_get_seed ();
+  guint64 a, b;
+
+  if (G_LIKELY (len <= 16))
+    {
+      if (G_LIKELY (len >= 4))
+        {
+          gsize mid = (len >> 3) << 2;
+
+          a = (hash_read32 (p) << 32) | hash_read32 (p + mid);
+          b = (hash_read32 (p + len - 4) << 32) | hash_read32 (p + len - 4 - mid);
+        }
+      else if (G_LIKELY (len > 0))
+        {
+          a = ((guint64) p[0] << 16) | ((guint64) p[len >> 1] << 8) | p[len - 1];
+          b = 0;
+        }
+      else
+        a = b = 0;
+    }
+  else
+    {
+      gsize i = len;
+
+      if (G_UNLIKELY (i > 48))
+        {
+          guint64 see1 = seed, see2 = seed;
+
+          do
+            {
+              seed = hash_mix (hash_read64 (p) ^ hash_secret[1], hash_read64 (p + 8) ^ seed);
+              see1 = hash_mix (hash_read64 (p + 16) ^ hash_secret[2], hash_read64 (p + 24) ^ see1);
+              see2 = hash_mix (hash_read64 (p + 32) ^ hash_secret[3], hash_read64 (p + 40) ^ see2);
+              p += 48;
+              i -= 48;
+            }
+          while (G_LIKELY (i > 48));
+
+          seed ^= see1 ^ see2;
+        }
+
+      while (G_UNLIKELY (i > 16))
+        {
+          seed = hash_mix (hash_read64 (p) ^ hash_secret[1], hash_read64 (p + 8) ^ seed);
+          i -= 16;
+          p += 16;
+        }
+
+      a = hash_read64 (p + i - 16);
+      b = hash_read64 (p + i - 8);
+    }
+
+  a ^= hash_secret[1];
+  b ^= seed;
+  hash_mum (&a, &b);
+  a = hash_mix (a ^ hash_secret[0] ^ len, b ^ hash_secret[1]);
+
+  return (guint) (a ^ (a >> 32));
+}
+
+/**
+ * g_str_hash_fast:
+ * @v: (not nullable): a string key
+ *
+ * Converts a string to a hash value, like g_str_hash(), but faster and
+ * with a better distribution.
+ *
+ * The hash reads the string several bytes at a time, and is seeded
+ * randomly for each process, which makes it hard to construct keys which
+ * collide on purpose. This means the hash value of a string, and so the
+ * iteration order of a #GHashTable using it, will be different each time
+ * the program is run.
+ *
+ * It can be passed to g_hash_table_new() as the @hash_func parameter,
+ * when using non-%NULL strings as keys in a #GHashTable. The hash value of
+ * a string is the same as that computed by g_str_hash_len() with its
+ * length.
+ *
+ * Returns: a hash value corresponding to the key
+ *
+ * Since: 2.82
+ */
+guint
+g_str_hash_fast (gconstpointer v)
+{
+  const gchar *str = v;
+
+  return hash_bytes ((const guint8 *) str, strlen (str));
+}
+
+/**
+ * g_str_hash_len:
+ * @str: (array length=len): a string
+ * @len: the length of @str, in bytes
+ *
+ * Converts the first @len bytes of @str to a hash value. @str does not
+ * need to be nul-terminated, and may contain nul bytes.
+ *
+ * This computes the same hash as g_str_hash_fast(), so it can be used to
+ * look up keys in a #GHashTable using that, without having to copy
+ * them to nul-terminated strings first.
+ *
+ * Returns: a hash value corresponding to the string
+ *
+ * Since: 2.82
+ */
+guint
+g_str_hash_len (const gchar *str,
+                gsize        len)
+{
+  g_return_val_if_fail (str != NULL || len == 0, 0);
+
+  return hash_bytes ((const guint8 *) str, len);
+}
+
 /**
  * g_direct_hash:
  * @v: (nullable): a #gpointer key
@@ -79,6 +79,14 @@ gboolean    g_hash_table_replace           (GHashTable     *hash_table,
 GLIB_AVAILABLE_IN_ALL
 gboolean    g_hash_table_add               (GHashTable     *hash_table,
                                             gpointer        key);
+GLIB_AVAILABLE_IN_2_82
+guint       g_hash_table_insert_many       (GHashTable     *hash_table,
+                                            gpointer       *keys,
+                                            gpointer       *values,
+                                            gsize           n_entries);
+GLIB_AVAILABLE_IN_2_82
+void        g_hash_table_reserve           (GHashTable     *hash_table,
+                                            guint           n_entries);
 GLIB_AVAILABLE_IN_ALL
 gboolean    g_hash_table_remove            (GHashTable     *hash_table,
                                             gconstpointer   key);
@@ -176,6 +184,11 @@ gboolean g_str_equal    (gconstpointer  v1,
 
 GLIB_AVAILABLE_IN_ALL
 guint    g_str_hash     (gconstpointer  v);
+GLIB_AVAILABLE_IN_2_82
+guint    g_str_hash_fast (gconstpointer  v);
+GLIB_AVAILABLE_IN_2_82
+guint    g_str_hash_len (const gchar   *str,
+                         gsize          len);
 
 GLIB_AVAILABLE_IN_ALL
 gboolean g_int_equal    (gconstpointer  v1,
@@ -153,9 +153,22 @@
 				 : (channel)->read_buf)
 #define BUF_LEN(string)		((string) ? (string)->len : 0)
 
+/* Bytes at the start of USE_BUF () which have already been returned to
+ * the caller but not yet erased from the buffer. Line and character
+ * reads just advance this, so that the buffer is only moved once per
+ * g_io_channel_fill_buffer () rather than once per line. The #GIOChannel
+ * struct is public, so this lives in one of its reserved fields.
+ */
+#define BUF_CONSUMED(channel)	GPOINTER_TO_SIZE ((channel)->reserved1)
+#define BUF_AVAIL(channel)	(BUF_LEN (USE_BUF (channel)) - BUF_CONSUMED (channel))
+#define BUF_START(channel)	(USE_BUF (channel)->str + BUF_CONSUMED (channel))
+
 static GIOError		g_io_error_get_from_g_error	(GIOStatus    status,
 							 GError      *err);
 static void		g_io_channel_purge		(GIOChannel  *channel);
+static void		g_io_channel_consume		(GIOChannel  *channel,
+							 gsize        len);
+static void		g_io_channel_compact		(GIOChannel  *channel);
 static GIOStatus	g_io_channel_fill_buffer	(GIOChannel  *channel,
 							 GError     **err);
 static GIOStatus	g_io_channel_read_line_backend	(GIOChannel  *channel,
@@ -185,6 +198,7 @@ g_io_channel_init (GIOChannel *channel)
   channel->write_cd = (GIConv) -1;
   channel->read_buf = NULL; /* Lazy allocate buffers */
   channel->encoded_read_buf = NULL;
+  channel->reserved1 = NULL;
   channel->write_buf = NULL;
   channel->partial_write_buf[0] = '\0';
   channel->use_buffer = TRUE;
@@ -561,6 +575,7 @@ g_io_channel_purge (GIOChannel *channel)
 
   /* Flush these in case anyone tries to close without unrefing */
 
+  channel->reserved1 = NULL;
   if (channel->read_buf)
     g_string_truncate (channel->read_buf, 0);
   if (channel->write_buf)
@@ -578,6 +593,37 @@ g_io_channel_purge (GIOChannel *channel)
     }
 }
 
+/* Marks @len bytes at BUF_START () as read. They stay in the buffer, so
+ * that a borrowed line remains valid, until g_io_channel_compact ().
+ */
+static void
+g_io_channel_consume (GIOChannel *channel,
+                      gsize       len)
+{
+  g_assert (len <= BUF_AVAIL (channel));
+
+  channel->reserved1 = GSIZE_TO_POINTER (BUF_CONSUMED (channel) + len);
+}
+
+/* Erases the consumed bytes from the front of the read buffer. This is
+ * done before filling the buffer and by any function which looks at the
+ * raw buffers, so only the line and character readers need to know
+ * about BUF_CONSUMED ().
+ */
+static void
+g_io_channel_compact (GIOChannel *channel)
+{
+  gsize consumed = BUF_CONSUMED (channel);
+
+  if (consumed == 0)
+    return;
+
+  g_assert (consumed <= BUF_LEN (USE_BUF (channel)));
+
+  g_string_erase (USE_BUF (channel), 0, consumed);
+  channel->reserved1 = NULL;
+}
+
 /**
  * g_io_create_watch:
  * @channel: a #GIOChannel to watch
@@ -714,16 +760,9 @@ g_io_channel_get_buffer_condition (GIOChannel *channel)
 {
   GIOCondition condition = 0;
 
-  if (channel->encoding)
-    {
-      if (channel->encoded_read_buf && (channel->encoded_read_buf->len > 0))
-        condition |= G_IO_IN; /* Only return if we have full characters */
-    }
-  else
-    {
-      if (channel->read_buf && (channel->read_buf->len > 0))
-        condition |= G_IO_IN;
-    }
+  /* Only return if we have full characters, which USE_BUF () holds */
+  if (BUF_AVAIL (channel) > 0)
+    condition |= G_IO_IN;
 
   if (channel->write_buf && (channel->write_buf->len < channel->buf_size))
     condition |= G_IO_OUT;
@@ -826,6 +865,9 @@ g_io_channel_error_from_errno (gint en)
  * @size: the size of the buffer, or 0 to let GLib pick a good size
  *
  * Sets the buffer size.
+ *
+ * Channels created by g_io_channel_new_file() start out with a larger
+ * buffer than other channels, as reads from regular files never block.
  **/  
 void
 g_io_channel_set_buffer_size (GIOChannel *channel,
@@ -1093,6 +1135,8 @@ g_io_channel_seek_position (GIOChannel  *channel,
 			G_IO_STATUS_ERROR);
   g_return_val_if_fail (channel->is_seekable, G_IO_STATUS_ERROR);
 
+  g_io_channel_compact (channel);
+
   switch (type)
     {
       case G_SEEK_CUR: /* The user is seeking relative to the head of the buffer */
@@ -1244,6 +1288,8 @@ g_io_channel_set_buffered (GIOChannel *channel,
       return;
     }
 
+  g_io_channel_compact (channel);
+
   g_return_if_fail (!channel->read_buf || channel->read_buf->len == 0);
   g_return_if_fail (!channel->write_buf || channel->write_buf->len == 0);
 
@@ -1322,6 +1368,8 @@ g_io_channel_set_encoding (GIOChannel	*channel,
   g_return_val_if_fail (channel != NULL, G_IO_STATUS_ERROR);
   g_return_val_if_fail ((error == NULL) || (*error == NULL), G_IO_STATUS_ERROR);
 
+  g_io_channel_compact (channel);
+
   /* Make sure the encoded buffers are empty */
 
   g_return_val_if_fail (!channel->do_encode || !channel->encoded_read_buf ||
@@ -1463,6 +1511,8 @@ g_io_channel_fill_buffer (GIOChannel  *channel,
   gsize read_size, cur_len, oldlen;
   GIOStatus status;
 
+  g_io_channel_compact (channel);
+
   if (channel->is_seekable && channel->write_buf && channel->write_buf->len > 0)
     {
       status = g_io_channel_flush (channel, err);
@@ -1587,8 +1637,20 @@ reencode:
 
       while (nextchar < lastchar)
         {
+          const gchar *valid_end;
           gunichar val_char;
 
+          /* Validate in bulk, and only look at individual characters
+           * where that stops: at an embedded nul, a partial character at
+           * the end of the buffer, or an invalid sequence.
+           */
+          if (g_utf8_validate_len (nextchar, lastchar - nextchar, &valid_end))
+            {
+              nextchar = lastchar;
+              break;
+            }
+
+          nextchar = (gchar *) valid_end;
           val_char = g_utf8_get_char_validated (nextchar, lastchar - nextchar);
 
           switch (val_char)
@@ -1615,7 +1677,16 @@ reencode:
             }
         }
 
-      if (lastchar > channel->read_buf->str)
+      if (lastchar == channel->read_buf->str + channel->read_buf->len &&
+          channel->encoded_read_buf->len == 0)
+        {
+          GString *validated = channel->read_buf;
+
+          /* All of it is valid: hand the buffer over instead of copying */
+          channel->read_buf = channel->encoded_read_buf;
+          channel->encoded_read_buf = validated;
+        }
+      else if (lastchar > channel->read_buf->str)
         {
           gint copy_len = lastchar - channel->read_buf->str;
 
@@ -1677,10 +1748,10 @@ g_io_channel_read_line (GIOChannel  *channel,
        * #GString, so it’s safe to call g_memdup2() with +1 length to allocate
        * a nul-terminator. */
       g_assert (USE_BUF (channel));
-      line = g_memdup2 (USE_BUF (channel)->str, got_length + 1);
+      line = g_memdup2 (BUF_START (channel), got_length + 1);
       line[got_length] = '\0';
       *str_return = g_steal_pointer (&line);
-      g_string_erase (USE_BUF (channel), 0, got_length);
+      g_io_channel_consume (channel, got_length);
     }
   else
     *str_return = NULL;
@@ -1725,8 +1796,71 @@ g_io_channel_read_line_string (GIOChannel  *channel,
   if (status == G_IO_STATUS_NORMAL)
     {
       g_assert (USE_BUF (channel));
-      g_string_append_len (buffer, USE_BUF (channel)->str, length);
-      g_string_erase (USE_BUF (channel), 0, length);
+      g_string_append_len (buffer, BUF_START (channel), length);
+      g_io_channel_consume (channel, length);
+    }
+
+  return status;
+}
+
+/**
+ * g_io_channel_read_line_borrowed:
+ * @channel: a #GIOChannel
+ * @line: (out) (array length=length) (element-type guint8) (transfer none):
+ *   location to return the line, including the line terminator
+ * @length: (out): location to store the length of the line, in bytes
+ * @terminator_pos: (out) (optional): location to store position of line
+ *   terminator, or %NULL
+ * @error: a location to return an error of type #GConvertError
+ *   or #GIOChannelError
+ *
+ * Reads a line, including the terminating character(s), from a
+ * #GIOChannel without copying it.
+ *
+ * Unlike g_io_channel_read_line(), @line points directly into the
+ * channel’s read buffer. It is not nul-terminated, so @length must be
+ * used to find its end, and it is only valid until the next call to any
+ * function on @channel. This avoids an allocation and a copy per line
+ * when reading large files. As with g_io_channel_read_line(), the line
+ * is UTF-8, or raw bytes if the channel’s encoding is %NULL.
+ *
+ * If the return value is not %G_IO_STATUS_NORMAL, @line is set to %NULL
+ * and @length to zero.
+ *
+ * Returns: the status of the operation.
+ *
+ * Since: 2.82
+ **/
+GIOStatus
+g_io_channel_read_line_borrowed (GIOChannel   *channel,
+                                 const gchar **line,
+                                 gsize        *length,
+                                 gsize        *terminator_pos,
+                                 GError      **error)
+{
+  GIOStatus status;
+  gsize got_length;
+
+  g_return_val_if_fail (channel != NULL, G_IO_STATUS_ERROR);
+  g_return_val_if_fail (line != NULL, G_IO_STATUS_ERROR);
+  g_return_val_if_fail (length != NULL, G_IO_STATUS_ERROR);
+  g_return_val_if_fail ((error == NULL) || (*error == NULL),
+			G_IO_STATUS_ERROR);
+  g_return_val_if_fail (channel->is_readable, G_IO_STATUS_ERROR);
+
+  *line = NULL;
+  *length = 0;
+
+  status = g_io_channel_read_line_backend (channel, &got_length, terminator_pos, error);
+
+  if (status == G_IO_STATUS_NORMAL)
+    {
+      g_assert (USE_BUF (channel));
+      *line = BUF_START (channel);
+      *length = got_length;
+
+      /* The bytes stay where they are until the next fill or compaction */
+      g_io_channel_consume (channel, got_length);
     }
 
   return status;
@@ -1742,6 +1876,7 @@ g_io_channel_read_line_backend (GIOChannel  *channel,
   GIOStatus status;
   gsize checked_to, line_term_len, line_length, got_term_len;
   gboolean first_time = TRUE;
+  gboolean scan_bytes;
 
   if (!channel->use_buffer)
     {
@@ -1761,21 +1896,28 @@ g_io_channel_read_line_backend (GIOChannel  *channel,
      * we autodetect for.
      */
 
+  /* UTF-8 is self-synchronizing, so a terminator which starts on a
+   * character boundary can only ever match at one, and the buffer can be
+   * scanned byte by byte. The autodetected terminators are all like that.
+   */
+  scan_bytes = !channel->encoding || !channel->line_term ||
+               (channel->line_term[0] & 0xc0) != 0x80;
+
   checked_to = 0;
 
   while (TRUE)
     {
-      gchar *nextchar, *lastchar;
-      GString *use_buf;
+      gchar *nextchar, *lastchar, *line_start;
+      gsize avail;
 
-      if (!first_time || (BUF_LEN (USE_BUF (channel)) == 0))
+      if (!first_time || (BUF_AVAIL (channel) == 0))
         {
 read_again:
           status = g_io_channel_fill_buffer (channel, error);
           switch (status)
             {
               case G_IO_STATUS_NORMAL:
-                if (BUF_LEN (USE_BUF (channel)) == 0)
+                if (BUF_AVAIL (channel) == 0)
                   /* Can happen when using conversion and only read
                    * part of a character
                    */
@@ -1785,7 +1927,7 @@ read_again:
                   }
                 break;
               case G_IO_STATUS_EOF:
-                if (BUF_LEN (USE_BUF (channel)) == 0)
+                if (BUF_AVAIL (channel) == 0)
                   {
                     if (length)
                       *length = 0;
@@ -1809,22 +1951,24 @@ read_again:
             }
         }
 
-      g_assert (BUF_LEN (USE_BUF (channel)) != 0);
+      g_assert (BUF_AVAIL (channel) != 0);
 
-      use_buf = USE_BUF (channel); /* The buffer has been created by this point */
+      /* The buffer has been created by this point */
+      line_start = BUF_START (channel);
+      avail = BUF_AVAIL (channel);
 
       first_time = FALSE;
 
-      lastchar = use_buf->str + use_buf->len;
+      lastchar = line_start + avail;
 
-      for (nextchar = use_buf->str + checked_to; nextchar < lastchar;
-           channel->encoding ? nextchar = g_utf8_next_char (nextchar) : nextchar++)
+      for (nextchar = line_start + checked_to; nextchar < lastchar;
+           scan_bytes ? nextchar++ : (nextchar = g_utf8_next_char (nextchar)))
         {
           if (channel->line_term)
             {
               if (memcmp (channel->line_term, nextchar, line_term_len) == 0)
                 {
-                  line_length = nextchar - use_buf->str;
+                  line_length = nextchar - line_start;
                   got_term_len = line_term_len;
                   goto done;
                 }
@@ -1834,13 +1978,13 @@ read_again:
               switch (*nextchar)
                 {
                   case '\n': /* unix */
-                    line_length = nextchar - use_buf->str;
+                    line_length = nextchar - line_start;
                     got_term_len = 1;
                     goto done;
                   case '\r': /* Warning: do not use with sockets */
-                    line_length = nextchar - use_buf->str;
+                    line_length = nextchar - line_start;
                     if ((nextchar == lastchar - 1) && (status != G_IO_STATUS_EOF)
-                       && (lastchar == use_buf->str + use_buf->len))
+                       && (lastchar == line_start + avail))
                       goto read_again; /* Try to read more data */
                     if ((nextchar < lastchar - 1) && (*(nextchar + 1) == '\n')) /* dos */
                       got_term_len = 2;
@@ -1850,13 +1994,13 @@ read_again:
                   case '\xe2': /* Unicode paragraph separator */
                     if (strncmp ("\xe2\x80\xa9", nextchar, 3) == 0)
                       {
-                        line_length = nextchar - use_buf->str;
+                        line_length = nextchar - line_start;
                         got_term_len = 3;
                         goto done;
                       }
                     break;
                   case '\0': /* Embedded null in input */
-                    line_length = nextchar - use_buf->str;
+                    line_length = nextchar - line_start;
                     got_term_len = 1;
                     goto done;
                   default: /* no match */
@@ -1878,13 +2022,13 @@ read_again:
                                    _("Channel terminates in a partial character"));
               return G_IO_STATUS_ERROR;
             }
-          line_length = use_buf->len;
+          line_length = avail;
           got_term_len = 0;
           break;
         }
 
-      if (use_buf->len > line_term_len - 1)
-	checked_to = use_buf->len - (line_term_len - 1);
+      if (avail > line_term_len - 1)
+	checked_to = avail - (line_term_len - 1);
       else
 	checked_to = 0;
     }
@@ -2038,12 +2182,12 @@ g_io_channel_read_chars (GIOChannel  *channel,
 
   status = G_IO_STATUS_NORMAL;
 
-  while (BUF_LEN (USE_BUF (channel)) < count && status == G_IO_STATUS_NORMAL)
+  while (BUF_AVAIL (channel) < count && status == G_IO_STATUS_NORMAL)
     status = g_io_channel_fill_buffer (channel, error);
 
   /* Only return an error if we have no data */
 
-  if (BUF_LEN (USE_BUF (channel)) == 0)
+  if (BUF_AVAIL (channel) == 0)
     {
       g_assert (status != G_IO_STATUS_NORMAL);
 
@@ -2065,18 +2209,18 @@ g_io_channel_read_chars (GIOChannel  *channel,
   if (status == G_IO_STATUS_ERROR)
     g_clear_error (error);
 
-  got_bytes = MIN (count, BUF_LEN (USE_BUF (channel)));
+  got_bytes = MIN (count, BUF_AVAIL (channel));
 
   g_assert (got_bytes > 0);
 
   if (channel->encoding)
     /* Don't validate for NULL encoding, binary safe */
     {
-      gchar *nextchar, *prevchar;
+      gchar *start, *nextchar, *prevchar;
 
       g_assert (USE_BUF (channel) == channel->encoded_read_buf);
 
-      nextchar = channel->encoded_read_buf->str;
+      start = nextchar = BUF_START (channel);
 
       do
         {
@@ -2084,16 +2228,16 @@ g_io_channel_read_chars (GIOChannel  *channel,
           nextchar = g_utf8_next_char (nextchar);
           g_assert (nextchar != prevchar); /* Possible for *prevchar of -1 or -2 */
         }
-      while (nextchar < channel->encoded_read_buf->str + got_bytes);
+      while (nextchar < start + got_bytes);
 
-      if (nextchar > channel->encoded_read_buf->str + got_bytes)
-        got_bytes = prevchar - channel->encoded_read_buf->str;
+      if (nextchar > start + got_bytes)
+        got_bytes = prevchar - start;
 
       g_assert (got_bytes > 0 || count < 6);
     }
 
-  memcpy (buf, USE_BUF (channel)->str, got_bytes);
-  g_string_erase (USE_BUF (channel), 0, got_bytes);
+  memcpy (buf, BUF_START (channel), got_bytes);
+  g_io_channel_consume (channel, got_bytes);
 
   if (bytes_read)
     *bytes_read = got_bytes;
@@ -2126,12 +2270,12 @@ g_io_channel_read_unichar (GIOChannel  *channel,
 			G_IO_STATUS_ERROR);
   g_return_val_if_fail (channel->is_readable, G_IO_STATUS_ERROR);
 
-  while (BUF_LEN (channel->encoded_read_buf) == 0 && status == G_IO_STATUS_NORMAL)
+  while (BUF_AVAIL (channel) == 0 && status == G_IO_STATUS_NORMAL)
     status = g_io_channel_fill_buffer (channel, error);
 
   /* Only return an error if we have no data */
 
-  if (BUF_LEN (USE_BUF (channel)) == 0)
+  if (BUF_AVAIL (channel) == 0)
     {
       g_assert (status != G_IO_STATUS_NORMAL);
 
@@ -2153,11 +2297,10 @@ g_io_channel_read_unichar (GIOChannel  *channel,
     g_clear_error (error);
 
   if (thechar)
-    *thechar = g_utf8_get_char (channel->encoded_read_buf->str);
+    *thechar = g_utf8_get_char (BUF_START (channel));
 
-  g_string_erase (channel->encoded_read_buf, 0,
-                  g_utf8_next_char (channel->encoded_read_buf->str)
-                  - channel->encoded_read_buf->str);
+  g_io_channel_consume (channel, g_utf8_next_char (BUF_START (channel))
+                                 - BUF_START (channel));
 
   return G_IO_STATUS_NORMAL;
 }
@@ -2236,6 +2379,8 @@ g_io_channel_write_chars (GIOChannel   *channel,
 
   /* General case */
 
+  g_io_channel_compact (channel);
+
   if (channel->is_seekable && (( BUF_LEN (channel->read_buf) > 0)
     || (BUF_LEN (channel->encoded_read_buf) > 0)))
     {
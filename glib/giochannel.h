@@ -255,6 +255,12 @@ GIOStatus   g_io_channel_read_line        (GIOChannel   *channel,
 					   gsize        *length,
 					   gsize        *terminator_pos,
 					   GError      **error);
+GLIB_AVAILABLE_IN_2_82
+GIOStatus   g_io_channel_read_line_borrowed (GIOChannel   *channel,
+					     const gchar **line,
+					     gsize        *length,
+					     gsize        *terminator_pos,
+					     GError      **error);
 GLIB_AVAILABLE_IN_ALL
 GIOStatus   g_io_channel_read_line_string (GIOChannel   *channel,
 					   GString      *buffer,
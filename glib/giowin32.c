@@ -90,6 +90,9 @@ typedef struct _GIOWin32Watch GIOWin32Watch;
 
 #define BUFFER_SIZE 4096
 
+/* Default buffer size for channels on regular files; see giounix.c */
+#define G_IO_FILE_BUF_SIZE (64 * 1024)
+
 typedef enum {
   G_IO_WIN32_WINDOWS_MESSAGES,	/* Windows messages */
 
@@ -1722,6 +1725,7 @@ g_io_channel_new_file (const gchar  *filename,
   /* XXX: move this to g_io_channel_win32_new_fd () */
   channel->close_on_unref = TRUE;
   channel->is_seekable = TRUE;
+  channel->buf_size = G_IO_FILE_BUF_SIZE;
 
   /* g_io_channel_win32_new_fd sets is_readable and is_writeable to
    * correspond to actual readability/writeability. Set to FALSE those
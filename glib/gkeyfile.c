@@ -61,6 +61,7 @@
 #include "gdataset.h"
 #include "gerror.h"
 #include "gfileutils.h"
+#include "gmappedfile.h"
 #include "ghash.h"
 #include "glibintl.h"
 #include "glist.h"
@@ -242,6 +243,12 @@
  *   (possibly modified) contents of the key file back to a file;
  *   otherwise only the translations for the current language will be
  *   written back.
+ * @G_KEY_FILE_LAZY_GROUPS: Only check the syntax of the key file when
+ *   loading it, and parse the keys and values of each group when the
+ *   group is first used. The loaded data is kept in memory (mapped, when
+ *   loading from a file) while the key file uses it. This makes loading
+ *   large key files, of which only a few groups are needed, much faster
+ *   and lighter. Since: 2.82
  *
  * Flags which influence the parsing.
  */
@@ -511,6 +518,8 @@ struct _GKeyFile
   gboolean checked_locales;  /* TRUE if @locales has been initialised */
   gchar **locales;  /* (nullable) */
 
+  GBytes *lazy_data;  /* (nullable) loaded data, with G_KEY_FILE_LAZY_GROUPS */
+
   gint ref_count;  /* (atomic) */
 };
 
@@ -526,6 +535,13 @@ struct _GKeyFileGroup
    * increased lookup performance
    */
   GHashTable *lookup_map;
+
+  /* With G_KEY_FILE_LAZY_GROUPS, the key-value pairs are parsed from
+   * this range of lazy_data when the group is first used
+   */
+  gboolean lazy;
+  gsize lazy_start;
+  gsize lazy_end;
 };
 
 struct _GKeyFileKeyValuePair
@@ -623,6 +639,13 @@ static void                  g_key_file_parse_data             (GKeyFile
 								GError                **error);
 static void                  g_key_file_flush_parse_buffer     (GKeyFile               *key_file,
 								GError                **error);
+static void                  g_key_file_parse_lines            (GKeyFile               *key_file,
+								const gchar            *data,
+								gsize                   start,
+								gsize                   end,
+								GError                **error);
+static void                  g_key_file_group_ensure_parsed    (GKeyFile               *key_file,
+								GKeyFileGroup          *group);
 
 G_DEFINE_QUARK (g-key-file-error-quark, g_key_file_error)
 
@@ -656,6 +679,8 @@ g_key_file_clear (GKeyFile *key_file)
       key_file->parse_buffer = NULL;
     }
 
+  g_clear_pointer (&key_file->lazy_data, g_bytes_unref);
+
   tmp = key_file->groups;
   while (tmp != NULL)
     {
@@ -800,6 +825,40 @@ find_file_in_data_dirs (const gchar   *file,
   return fd;
 }
 
+/* Loads @bytes for G_KEY_FILE_LAZY_GROUPS: every line is checked as usual,
+ * but the key-value pairs of the groups are only recorded as ranges of
+ * @bytes, which is kept until the key file is cleared.
+ */
+static gboolean
+g_key_file_load_lazily (GKeyFile       *key_file,
+                        GBytes         *bytes,
+                        GKeyFileFlags   flags,
+                        GError        **error)
+{
+  GError *key_file_error = NULL;
+  const gchar *data;
+  gsize length;
+  gchar list_separator;
+
+  list_separator = key_file->list_separator;
+  g_key_file_clear (key_file);
+  g_key_file_init (key_file);
+  key_file->list_separator = list_separator;
+  key_file->flags = flags;
+  key_file->lazy_data = g_bytes_ref (bytes);
+
+  data = g_bytes_get_data (bytes, &length);
+  g_key_file_parse_lines (key_file, data, 0, length, &key_file_error);
+
+  if (key_file_error)
+    {
+      g_propagate_error (error, key_file_error);
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
 static gboolean
 g_key_file_load_from_fd (GKeyFile       *key_file,
 			 gint            fd,
@@ -829,6 +888,25 @@ g_key_file_load_from_fd (GKeyFile       *key_file,
       return FALSE;
     }
 
+  if (flags & G_KEY_FILE_LAZY_GROUPS)
+    {
+      GMappedFile *mapped_file;
+      GBytes *bytes;
+      gboolean loaded;
+
+      mapped_file = g_mapped_file_new_from_fd (fd, FALSE, error);
+      if (mapped_file == NULL)
+        return FALSE;
+
+      bytes = g_mapped_file_get_bytes (mapped_file);
+      g_mapped_file_unref (mapped_file);
+
+      loaded = g_key_file_load_lazily (key_file, bytes, flags, error);
+      g_bytes_unref (bytes);
+
+      return loaded;
+    }
+
   list_separator = key_file->list_separator;
   g_key_file_clear (key_file);
   g_key_file_init (key_file);
@@ -966,6 +1044,18 @@ g_key_file_load_from_data (GKeyFile       *key_file,
   if (length == (gsize)-1)
     length = strlen (data);
 
+  if (flags & G_KEY_FILE_LAZY_GROUPS)
+    {
+      GBytes *bytes;
+      gboolean loaded;
+
+      bytes = g_bytes_new (data, length);
+      loaded = g_key_file_load_lazily (key_file, bytes, flags, error);
+      g_bytes_unref (bytes);
+
+      return loaded;
+    }
+
   list_separator = key_file->list_separator;
   g_key_file_clear (key_file);
   g_key_file_init (key_file);
@@ -1017,6 +1107,10 @@ g_key_file_load_from_bytes (GKeyFile       *key_file,
   g_return_val_if_fail (key_file != NULL, FALSE);
   g_return_val_if_fail (bytes != NULL, FALSE);
 
+  /* No need to copy the data */
+  if (flags & G_KEY_FILE_LAZY_GROUPS)
+    return g_key_file_load_lazily (key_file, bytes, flags, error);
+
   data = g_bytes_get_data (bytes, &size);
   return g_key_file_load_from_data (key_file, (const gchar *) data, size, flags, error);
 }
@@ -1308,6 +1402,10 @@ g_key_file_parse_comment (GKeyFile     *key_file,
   
   g_warn_if_fail (key_file->current_group != NULL);
 
+  /* Parsed again when the group is first used */
+  if (key_file->current_group->lazy)
+    return;
+
   pair = g_new (GKeyFileKeyValuePair, 1);
   pair->key = NULL;
   pair->value = g_strndup (line, length);
@@ -1392,8 +1490,6 @@ g_key_file_parse_key_value_pair (GKeyFile     *key_file,
       return; 
     }
 
-  key = g_strndup (line, key_len - 1);
-
   /* Pull the value from the line (chugging leading whitespace)
    */
   while (g_ascii_isspace (*value_start))
@@ -1408,7 +1504,8 @@ g_key_file_parse_key_value_pair (GKeyFile     *key_file,
   g_assert (key_file->current_group->name != NULL);
 
   if (key_file->start_group == key_file->current_group
-      && strcmp (key, "Encoding") == 0)
+      && key_len - 1 == strlen ("Encoding")
+      && strncmp (line, "Encoding", key_len - 1) == 0)
     {
       if (value_len != strlen ("UTF-8") ||
           g_ascii_strncasecmp (value_start, "UTF-8", value_len) != 0)
@@ -1420,11 +1517,16 @@ g_key_file_parse_key_value_pair (GKeyFile     *key_file,
 			 "encoding “%s”"), value_utf8);
 	  g_free (value_utf8);
 
-          g_free (key);
           return;
         }
     }
 
+  /* Parsed again when the group is first used */
+  if (key_file->current_group->lazy)
+    return;
+
+  key = g_strndup (line, key_len - 1);
+
   /* Is this key a translation? If so, is it one that we care about?
    */
   locale = key_get_locale (key, &locale_len);
@@ -1565,6 +1667,105 @@ g_key_file_flush_parse_buffer (GKeyFile  *key_file,
     }
 }
 
+/* Parses the lines of @data between @start and @end, which must be the
+ * start of a line, directly rather than through the parse buffer.
+ */
+static void
+g_key_file_parse_lines (GKeyFile     *key_file,
+                        const gchar  *data,
+                        gsize         start,
+                        gsize         end,
+                        GError      **error)
+{
+  GString *line;
+  gsize i;
+
+  line = g_string_sized_new (128);
+
+  i = start;
+  while (i < end)
+    {
+      GError *parse_error = NULL;
+      GKeyFileGroup *group;
+      const gchar *end_of_line;
+      gsize line_length, next;
+
+      end_of_line = memchr (data + i, '\n', end - i);
+
+      if (end_of_line != NULL)
+        {
+          line_length = end_of_line - (data + i);
+          next = end_of_line - data + 1;
+
+          if (line_length > 0 && data[i + line_length - 1] == '\r')
+            line_length--;
+        }
+      else
+        {
+          line_length = end - i;
+          next = end;
+        }
+
+      group = key_file->current_group;
+
+      if (line_length > 0)
+        {
+          g_string_truncate (line, 0);
+          g_string_append_len (line, data + i, line_length);
+          g_key_file_parse_line (key_file, line->str, line->len, &parse_error);
+        }
+      else
+        {
+          g_key_file_parse_comment (key_file, "", 1, &parse_error);
+        }
+
+      if (parse_error)
+        {
+          g_propagate_error (error, parse_error);
+          break;
+        }
+
+      /* Extend the range of the group being loaded lazily */
+      if (key_file->current_group->lazy)
+        {
+          if (key_file->current_group != group)
+            key_file->current_group->lazy_start = next;
+          key_file->current_group->lazy_end = next;
+        }
+
+      i = next;
+    }
+
+  g_string_free (line, TRUE);
+}
+
+static void
+g_key_file_group_ensure_parsed (GKeyFile      *key_file,
+                                GKeyFileGroup *group)
+{
+  GKeyFileGroup *current_group;
+  GList *added_pairs;
+
+  if (!group->lazy)
+    return;
+
+  group->lazy = FALSE;
+
+  /* Pairs added while loading, such as the blank line before the next
+   * group, come after the ones of the group itself
+   */
+  added_pairs = g_steal_pointer (&group->key_value_pairs);
+  current_group = key_file->current_group;
+  key_file->current_group = group;
+
+  /* The lines were already checked when loading */
+  g_key_file_parse_lines (key_file, g_bytes_get_data (key_file->lazy_data, NULL),
+                          group->lazy_start, group->lazy_end, NULL);
+
+  key_file->current_group = current_group;
+  group->key_value_pairs = g_list_concat (added_pairs, group->key_value_pairs);
+}
+
 /**
  * g_key_file_to_data:
  * @key_file: a #GKeyFile
@@ -1601,6 +1802,7 @@ g_key_file_to_data (GKeyFile  *key_file,
       GKeyFileGroup *group;
 
       group = (GKeyFileGroup *) group_node->data;
+      g_key_file_group_ensure_parsed (key_file, group);
 
       if (group->name != NULL)
         g_string_append_printf (data_string, "[%s]\n", group->name);
@@ -3399,6 +3601,7 @@ g_key_file_set_group_comment (GKeyFile     *key_file,
    */
   group_node = g_key_file_lookup_group_node (key_file, group_name);
   group = group_node->next->data;
+  g_key_file_group_ensure_parsed (key_file, group);
   for (GList *lp = group->key_value_pairs; lp != NULL; )
     {
       GList *lnext = lp->next;
@@ -3629,6 +3832,7 @@ g_key_file_get_group_comment (GKeyFile     *key_file,
   group_node = g_key_file_lookup_group_node (key_file, group_name);
   group_node = group_node->next;
   group = (GKeyFileGroup *)group_node->data;  
+  g_key_file_group_ensure_parsed (key_file, group);
   return get_group_comment (key_file, group, error);
 }
 
@@ -3838,6 +4042,7 @@ g_key_file_add_group (GKeyFile    *key_file,
   group = g_new0 (GKeyFileGroup, 1);
   group->name = g_strdup (group_name);
   group->lookup_map = g_hash_table_new (g_str_hash, g_str_equal);
+  group->lazy = (key_file->lazy_data != NULL && !created);
   key_file->groups = g_list_prepend (key_file->groups, group);
   key_file->current_group = group;
 
@@ -3850,6 +4055,11 @@ g_key_file_add_group (GKeyFile    *key_file,
       /* separate groups by a blank line if we don't keep comments or group is created */
       GKeyFileGroup *next_group = key_file->groups->next->data;
       GKeyFileKeyValuePair *pair;
+
+      /* While loading, a lazy group only has the pairs added after it */
+      if (created)
+        g_key_file_group_ensure_parsed (key_file, next_group);
+
       if (next_group->key_value_pairs != NULL)
         pair = next_group->key_value_pairs->data;
 
@@ -4123,10 +4333,16 @@ static GKeyFileGroup *
 g_key_file_lookup_group (GKeyFile    *key_file,
 			 const gchar *group_name)
 {
+  GKeyFileGroup *group;
+
   if (!key_file->group_hash)
     return NULL;
 
-  return (GKeyFileGroup *)g_hash_table_lookup (key_file->group_hash, group_name);
+  group = (GKeyFileGroup *)g_hash_table_lookup (key_file->group_hash, group_name);
+  if (group != NULL)
+    g_key_file_group_ensure_parsed (key_file, group);
+
+  return group;
 }
 
 static GList *
@@ -227,6 +227,10 @@ typedef struct Foo Foo;
  */
 gboolean g_mem_gc_friendly = FALSE;
 
+/* Set if the `G_DEBUG` environment variable includes the key
+ * `dispatch-stats`; read by gmain.c */
+gboolean g_main_dispatch_stats_debug = FALSE;
+
 GLogLevelFlags g_log_msg_prefix = G_LOG_LEVEL_ERROR | G_LOG_LEVEL_WARNING |
                                   G_LOG_LEVEL_CRITICAL | G_LOG_LEVEL_DEBUG;
 GLogLevelFlags g_log_always_fatal = G_LOG_FATAL_MASK;
@@ -394,6 +398,7 @@ g_debug_init (void)
 {
   const GDebugKey keys[] = {
     { "gc-friendly", 1 },
+    { "dispatch-stats", 2 },
     {"fatal-warnings",  G_LOG_LEVEL_WARNING | G_LOG_LEVEL_CRITICAL },
     {"fatal-criticals", G_LOG_LEVEL_CRITICAL }
   };
@@ -404,6 +409,7 @@ g_debug_init (void)
   g_log_always_fatal |= flags & G_LOG_LEVEL_MASK;
 
   g_mem_gc_friendly = flags & 1;
+  g_main_dispatch_stats_debug = (flags & 2) != 0;
 }
 
 void
@@ -419,7 +425,6 @@ glib_init (void)
   g_messages_prefixed_init ();
   g_debug_init ();
   g_quark_init ();
-  g_error_init ();
 }
 
 #ifdef G_PLATFORM_WIN32
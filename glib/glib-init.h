@@ -26,10 +26,10 @@
 
 extern GLogLevelFlags g_log_always_fatal;
 extern GLogLevelFlags g_log_msg_prefix;
+extern gboolean g_main_dispatch_stats_debug;
 
 void glib_init (void);
 void g_quark_init (void);
-void g_error_init (void);
 
 #ifdef G_OS_WIN32
 #include <windows.h>
@@ -25,6 +25,7 @@
 #include "glib-init.h"
 #include "gutilsprivate.h"
 #include "gdatasetprivate.h"
+#include "gconvertprivate.h"
 
 #ifdef USE_INVALID_PARAMETER_HANDLER
 #include <crtdbg.h>
@@ -77,6 +78,18 @@ glib__private__ (void)
     g_set_prgname_once,
 
     g_datalist_id_update_atomic,
+
+    g_iconv_cache_take,
+    g_iconv_cache_give,
+
+    g_big_rw_lock_init,
+    g_big_rw_lock_clear,
+    g_big_rw_lock_reader_lock,
+    g_big_rw_lock_reader_unlock,
+    g_big_rw_lock_writer_lock,
+    g_big_rw_lock_writer_unlock,
+
+    g_rand_get_seed_from_system,
   };
 
   return &table;
@@ -192,6 +192,46 @@ g_end_ignore_leaks (void)
 GMainContext *          g_get_worker_context            (void);
 gboolean                g_check_setuid                  (void);
 GMainContext *          g_main_context_new_with_next_id (guint next_id);
+void                    g_rand_get_seed_from_system     (guint32 seed[4]);
+
+/*
+ * GBigRWLock:
+ *
+ * A reader-writer lock for data which is read very often from many threads
+ * and rarely written, like the type system. Rather than having all readers
+ * update the same counter, each thread counts its read locks in one of
+ * %G_BIG_RW_LOCK_N_SLOTS slots on separate cache lines, so that readers on
+ * different CPUs don’t contend. In exchange, a writer has to wait for all
+ * the slots to drain, which makes write locks more expensive than with a
+ * #GRWLock.
+ *
+ * Read locks can be taken recursively. A zero-filled #GBigRWLock in static
+ * storage is ready to use; others must be initialised with
+ * g_big_rw_lock_init().
+ */
+#define G_BIG_RW_LOCK_N_SLOTS 32
+
+typedef struct
+{
+  gint n_readers;  /* (atomic) */
+  gint padding[15];
+} GBigRWLockSlot;
+
+typedef struct
+{
+  GBigRWLockSlot slots[G_BIG_RW_LOCK_N_SLOTS];
+  gint writer;  /* (atomic) set while a writer waits for or holds the lock */
+  GMutex writer_mutex;
+  GMutex wait_mutex;
+  GCond wait_cond;
+} GBigRWLock;
+
+void                    g_big_rw_lock_init              (GBigRWLock *lock);
+void                    g_big_rw_lock_clear             (GBigRWLock *lock);
+void                    g_big_rw_lock_reader_lock       (GBigRWLock *lock);
+void                    g_big_rw_lock_reader_unlock     (GBigRWLock *lock);
+void                    g_big_rw_lock_writer_lock       (GBigRWLock *lock);
+void                    g_big_rw_lock_writer_unlock     (GBigRWLock *lock);
 
 #if (defined (HAVE__SET_THREAD_LOCAL_INVALID_PARAMETER_HANDLER) || \
      defined (HAVE__SET_INVALID_PARAMETER_HANDLER)) && \
@@ -307,6 +347,24 @@ typedef struct {
                                            GDataListUpdateAtomicFunc callback,
                                            gpointer user_data);
 
+  /* See gconvert.c */
+  GIConv (* g_iconv_cache_take) (const gchar *to_codeset,
+                                 const gchar *from_codeset);
+  void (* g_iconv_cache_give) (const gchar *to_codeset,
+                               const gchar *from_codeset,
+                               GIConv       cd);
+
+  /* See gthread.c */
+  void (* g_big_rw_lock_init) (GBigRWLock *lock);
+  void (* g_big_rw_lock_clear) (GBigRWLock *lock);
+  void (* g_big_rw_lock_reader_lock) (GBigRWLock *lock);
+  void (* g_big_rw_lock_reader_unlock) (GBigRWLock *lock);
+  void (* g_big_rw_lock_writer_lock) (GBigRWLock *lock);
+  void (* g_big_rw_lock_writer_unlock) (GBigRWLock *lock);
+
+  /* See grand.c */
+  void (* g_rand_get_seed_from_system) (guint32 seed[4]);
+
   /* Add other private functions here, initialize them in glib-private.c */
 } GLibPrivateVTable;
 
@@ -40,6 +40,7 @@
 #include <glib/gbytes.h>
 #include <glib/gcharset.h>
 #include <glib/gchecksum.h>
+#include <glib/gconcurrenthashtable.h>
 #include <glib/gconvert.h>
 #include <glib/gdataset.h>
 #include <glib/gdate.h>
@@ -58,9 +59,11 @@
 #include <glib/glist.h>
 #include <glib/gmacros.h>
 #include <glib/gmain.h>
+#include <glib/gmainexecutor.h>
 #include <glib/gmappedfile.h>
 #include <glib/gmarkup.h>
 #include <glib/gmem.h>
+#include <glib/gmemarena.h>
 #include <glib/gmessages.h>
 #include <glib/gnode.h>
 #include <glib/goption.h>
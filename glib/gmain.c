@@ -54,6 +54,9 @@
 #ifdef HAVE_EVENTFD
 #include <sys/eventfd.h>
 #endif
+#ifdef HAVE_EPOLL_CREATE
+#include <sys/epoll.h>
+#endif
 #endif
 
 #include <signal.h>
@@ -114,6 +117,7 @@
 #include "ghook.h"
 #include "gqueue.h"
 #include "gstrfuncs.h"
+#include "gstring.h"
 #include "gtestutils.h"
 #include "gthreadprivate.h"
 #include "gtrace-private.h"
@@ -138,6 +142,7 @@ typedef struct _GTimeoutSource GTimeoutSource;
 typedef struct _GChildWatchSource GChildWatchSource;
 typedef struct _GUnixSignalWatchSource GUnixSignalWatchSource;
 typedef struct _GPollRec GPollRec;
+typedef struct _GPollKernelRec GPollKernelRec;
 typedef struct _GSourceCallback GSourceCallback;
 
 typedef enum
@@ -208,6 +213,9 @@ struct _GMainContext
 
   GPollFD wake_up_rec;
 
+  /* (atomic) (nullable) (owned) created on the first queued invocation */
+  GSource *invoke_source;
+
 /* Flag indicating whether the set of fd's changed during a poll */
   gboolean poll_changed;
 
@@ -215,6 +223,31 @@ struct _GMainContext
 
   gint64   time;
   gboolean time_is_fresh;
+
+  GPtrArray *timer_heap;    /* (element-type GSource) min-heap on ready time */
+  GQueue unparked_timers;   /* sources in timer_heap which are not parked */
+
+  /* (nullable) (owned) (element-type utf8 GDispatchStats) by source name,
+   * or %NULL if dispatch statistics are not being collected */
+  GHashTable *dispatch_stats;
+
+  /* Child processes seen to exit by dispatched child watch sources; see
+   * g_main_context_get_child_watch_stats(). The per-iteration count is only
+   * touched by the owner, and folded into the others after dispatching. */
+  guint children_reaped_iteration;
+  guint children_reaped_max;
+  guint64 children_reaped_total;
+
+#ifdef HAVE_EPOLL_CREATE
+  /* Only used with G_MAIN_CONTEXT_FLAGS_KERNEL_POLLING; -1 otherwise */
+  gint epoll_fd;
+  GHashTable *kernel_poll_records;  /* gint fd -> GPollKernelRec */
+  GArray *kernel_ready_fds;         /* gint fds reported ready by the last poll */
+  struct epoll_event *epoll_events;
+  guint n_epoll_events;
+  guint n_kernel_unpollable;
+  gboolean kernel_revents_stale;
+#endif
 };
 
 struct _GSourceCallback
@@ -241,8 +274,9 @@ struct _GIdleSource
 struct _GTimeoutSource
 {
   GSource     source;
-  /* Measured in seconds if 'seconds' is TRUE, or milliseconds otherwise. */
-  guint       interval;
+  /* Always measured in microseconds. If 'seconds' is TRUE, expirations are
+   * rounded to whole seconds. */
+  guint64     interval;
   gboolean    seconds;
   gboolean    one_shot;
 };
@@ -274,6 +308,17 @@ struct _GPollRec
   gint priority;
 };
 
+/* One per distinct file descriptor registered with the kernel poll set.
+ * All the #GPollRecs for a given fd are consecutive in the (sorted)
+ * poll_records list, starting at @first. */
+struct _GPollKernelRec
+{
+  gint fd;
+  gushort events;       /* events currently registered with the kernel */
+  gboolean unpollable;  /* the kernel refused the fd; use poll() instead */
+  GPollRec *first;
+};
+
 struct _GSourcePrivate
 {
   GSList *child_sources;
@@ -289,6 +334,17 @@ struct _GSourcePrivate
   GSourceDisposeFunc dispose;
 
   gboolean static_name;
+
+  /* Pure timer sources (see source_is_pure_timer()) are kept in
+   * context->timer_heap. While they are not due they are ‘parked’: unlinked
+   * from the context’s source lists so that prepare() and check() don’t have
+   * to look at them. */
+  guint timer_heap_index;  /* index in context->timer_heap plus one, or 0 */
+  gboolean timer_parked;
+  GList timer_link;        /* in context->unparked_timers, if not parked */
+
+  /* When the source was found ready, if collecting dispatch statistics */
+  gint64 dispatch_ready_time;
 };
 
 typedef struct _GSourceIter
@@ -297,6 +353,8 @@ typedef struct _GSourceIter
   gboolean may_modify;
   GList *current_list;
   GSource *source;
+  gboolean in_timer_heap;
+  guint timer_heap_index;
 } GSourceIter;
 
 #define LOCK_CONTEXT(context) g_mutex_lock (&context->mutex)
@@ -344,6 +402,18 @@ static void g_main_context_add_poll_unlocked    (GMainContext *context,
 						 GPollFD      *fd);
 static void g_main_context_remove_poll_unlocked (GMainContext *context,
 						 GPollFD      *fd);
+#ifdef HAVE_EPOLL_CREATE
+static void g_main_context_kernel_poll_add_unlocked    (GMainContext *context,
+                                                        GPollRec     *pollrec);
+static void g_main_context_kernel_poll_remove_unlocked (GMainContext *context,
+                                                        GPollRec     *pollrec);
+static void g_main_context_kernel_poll_update_unlocked (GMainContext *context,
+                                                        gint          fd);
+static inline gboolean g_main_context_uses_kernel_poll_unlocked (GMainContext *context);
+static void g_main_context_kernel_poll_unlocked        (GMainContext *context,
+                                                        gint64        timeout_usec,
+                                                        gint          max_priority);
+#endif
 
 static void     g_source_iter_init  (GSourceIter   *iter,
 				     GMainContext  *context,
@@ -365,6 +435,7 @@ static void     g_child_watch_finalize (GSource     *source);
 
 #ifndef G_OS_WIN32
 static void unref_unix_signal_handler_unlocked (int signum);
+static void rescan_unix_child_watches_unlocked (void);
 #endif
 
 #ifdef G_OS_UNIX
@@ -419,7 +490,7 @@ static volatile sig_atomic_t any_unix_signal_pending;
 G_LOCK_DEFINE_STATIC (unix_signal_lock);
 static guint unix_signal_refcount[NSIG];
 static GSList *unix_signal_watches;
-static GSList *unix_child_watches;
+static GHashTable *unix_child_watches;  /* GPid -> GChildWatchSource, without pidfd */
 
 GSourceFuncs g_unix_signal_funcs =
 {
@@ -433,6 +504,13 @@ GSourceFuncs g_unix_signal_funcs =
 G_LOCK_DEFINE_STATIC (main_context_list);
 static GSList *main_context_list = NULL;
 
+static guint timer_heap_size_counter = 0;
+
+#ifdef HAVE_EPOLL_PWAIT2
+/* Cleared (atomically) if the kernel turns out not to have epoll_pwait2() */
+static gint epoll_pwait2_supported = TRUE;
+#endif
+
 GSourceFuncs g_timeout_funcs =
 {
   NULL, /* prepare */
@@ -560,10 +638,22 @@ g_main_context_unref (GMainContext *context)
   g_mutex_clear (&context->mutex);
 
   g_ptr_array_free (context->pending_dispatches, TRUE);
+  g_ptr_array_free (context->timer_heap, TRUE);
+  g_clear_pointer (&context->dispatch_stats, g_hash_table_unref);
   g_free (context->cached_poll_array);
 
   poll_rec_list_free (context, context->poll_records);
 
+#ifdef HAVE_EPOLL_CREATE
+  if (context->epoll_fd >= 0)
+    {
+      close (context->epoll_fd);
+      g_hash_table_destroy (context->kernel_poll_records);
+      g_array_unref (context->kernel_ready_fds);
+      g_free (context->epoll_events);
+    }
+#endif
+
   g_wakeup_free (context->wakeup);
   g_cond_clear (&context->cond);
 
@@ -580,6 +670,9 @@ g_main_context_unref (GMainContext *context)
       g_source_unref_internal (source, NULL, FALSE);
     }
   g_slist_free (remaining_sources);
+
+  if (context->invoke_source != NULL)
+    g_source_unref_internal (context->invoke_source, NULL, FALSE);
 }
 
 /* Helper function used by mainloop/overflow test.
@@ -631,6 +724,11 @@ g_main_context_new_with_flags (GMainContextFlags flags)
         _g_main_poll_debug = TRUE;
 #endif
 
+      timer_heap_size_counter =
+        g_trace_define_int64_counter ("GLib", "timer heap size",
+                                      "Number of timer sources tracked by the "
+                                      "last modified GMainContext's timer heap");
+
       g_once_init_leave (&initialised, TRUE);
     }
 
@@ -658,6 +756,30 @@ g_main_context_new_with_flags (GMainContextFlags flags)
   context->pending_dispatches = g_ptr_array_new ();
   
   context->time_is_fresh = FALSE;
+
+  context->timer_heap = g_ptr_array_new ();
+  g_queue_init (&context->unparked_timers);
+
+  if (g_main_dispatch_stats_debug)
+    context->dispatch_stats = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                     g_free, g_free);
+
+#ifdef HAVE_EPOLL_CREATE
+  context->epoll_fd = -1;
+
+  if (flags & G_MAIN_CONTEXT_FLAGS_KERNEL_POLLING)
+    {
+      context->epoll_fd = epoll_create1 (EPOLL_CLOEXEC);
+
+      /* Fall back to poll() silently; the flag is only a hint */
+      if (context->epoll_fd >= 0)
+        {
+          context->kernel_poll_records = g_hash_table_new_full (g_int_hash, g_int_equal,
+                                                                NULL, g_free);
+          context->kernel_ready_fds = g_array_new (FALSE, FALSE, sizeof (gint));
+        }
+    }
+#endif
   
   context->wakeup = g_wakeup_new ();
   g_wakeup_get_pollfd (context->wakeup, &context->wake_up_rec);
@@ -984,6 +1106,8 @@ g_source_iter_init (GSourceIter  *iter,
   iter->current_list = NULL;
   iter->source = NULL;
   iter->may_modify = may_modify;
+  iter->in_timer_heap = FALSE;
+  iter->timer_heap_index = 0;
 }
 
 /* Holds context's lock */
@@ -992,12 +1116,12 @@ g_source_iter_next (GSourceIter *iter, GSource **source)
 {
   GSource *next_source;
 
-  if (iter->source)
+  if (iter->source && !iter->in_timer_heap)
     next_source = iter->source->next;
   else
     next_source = NULL;
 
-  if (!next_source)
+  if (!next_source && !iter->in_timer_heap)
     {
       if (iter->current_list)
 	iter->current_list = iter->current_list->next;
@@ -1010,6 +1134,26 @@ g_source_iter_next (GSourceIter *iter, GSource **source)
 
 	  next_source = source_list->head;
 	}
+      else if (!iter->may_modify)
+        iter->in_timer_heap = TRUE;
+    }
+
+  /* Parked timer sources are not in any source list. Only iterators which
+   * don’t drop the context lock see them: prepare() and check() must not. */
+  if (!next_source && iter->in_timer_heap)
+    {
+      GPtrArray *timer_heap = iter->context->timer_heap;
+
+      while (iter->timer_heap_index < timer_heap->len)
+        {
+          GSource *timer = g_ptr_array_index (timer_heap, iter->timer_heap_index++);
+
+          if (timer->priv->timer_parked)
+            {
+              next_source = timer;
+              break;
+            }
+        }
     }
 
   /* Note: unreffing iter->source could potentially cause its
@@ -1157,6 +1301,300 @@ source_remove_from_context (GSource      *source,
     }
 }
 
+/* Timer heap.
+ *
+ * Sources which have no prepare(), check(), fds or child/parent sources can
+ * only become ready through their ready time, which is the common case for
+ * timeouts. Scanning them on every iteration is wasteful when there are many
+ * of them, so they are kept in a binary min-heap ordered by ready time, and
+ * unlinked from the source lists (‘parked’) while they are not due.
+ *
+ * Parking only happens at the start of prepare, when no #GSourceIter can be
+ * pointing at the source. Unparking just appends the source to its priority
+ * list, which is safe at any time. A source which is blocked, or flagged as
+ * ready but not yet dispatched, is never parked.
+ */
+
+static inline gboolean
+source_is_pure_timer (GSource *source)
+{
+  return (source->source_funcs->prepare == NULL &&
+          source->source_funcs->check == NULL &&
+          source->poll_fds == NULL &&
+          source->priv->fds == NULL &&
+          source->priv->parent_source == NULL &&
+          source->priv->child_sources == NULL);
+}
+
+static inline gint64
+timer_heap_key (GSource *source)
+{
+  return (source->priv->ready_time == -1) ? G_MAXINT64 : source->priv->ready_time;
+}
+
+/* Ties are broken by source ID so that the order is deterministic */
+static inline gboolean
+timer_heap_less (GSource *a,
+                 GSource *b)
+{
+  gint64 key_a = timer_heap_key (a), key_b = timer_heap_key (b);
+
+  return key_a < key_b || (key_a == key_b && a->source_id < b->source_id);
+}
+
+static inline void
+timer_heap_set (GPtrArray *timer_heap,
+                guint      index,
+                GSource   *source)
+{
+  timer_heap->pdata[index] = source;
+  source->priv->timer_heap_index = index + 1;
+}
+
+static void
+timer_heap_sift_up (GPtrArray *timer_heap,
+                    guint      index)
+{
+  GSource *source = timer_heap->pdata[index];
+
+  while (index > 0)
+    {
+      guint parent = (index - 1) / 2;
+
+      if (!timer_heap_less (source, timer_heap->pdata[parent]))
+        break;
+
+      timer_heap_set (timer_heap, index, timer_heap->pdata[parent]);
+      index = parent;
+    }
+
+  timer_heap_set (timer_heap, index, source);
+}
+
+static void
+timer_heap_sift_down (GPtrArray *timer_heap,
+                      guint      index)
+{
+  GSource *source = timer_heap->pdata[index];
+
+  while (TRUE)
+    {
+      guint child = 2 * index + 1;
+
+      if (child >= timer_heap->len)
+        break;
+      if (child + 1 < timer_heap->len &&
+          timer_heap_less (timer_heap->pdata[child + 1], timer_heap->pdata[child]))
+        child++;
+      if (!timer_heap_less (timer_heap->pdata[child], source))
+        break;
+
+      timer_heap_set (timer_heap, index, timer_heap->pdata[child]);
+      index = child;
+    }
+
+  timer_heap_set (timer_heap, index, source);
+}
+
+/* Holds context's lock */
+static void
+g_main_context_timer_add_unlocked (GMainContext *context,
+                                   GSource      *source)
+{
+  g_assert (source->priv->timer_heap_index == 0);
+
+  g_ptr_array_add (context->timer_heap, source);
+  timer_heap_sift_up (context->timer_heap, context->timer_heap->len - 1);
+
+  /* Newly attached sources are linked; prepare will park them if needed */
+  source->priv->timer_link.data = source;
+  g_queue_push_tail_link (&context->unparked_timers, &source->priv->timer_link);
+
+  g_trace_set_int64_counter (timer_heap_size_counter, context->timer_heap->len);
+}
+
+/* Holds context's lock. Stops managing @source with the timer heap, making
+ * sure it is linked in the source lists again. */
+static void
+g_main_context_timer_remove_unlocked (GMainContext *context,
+                                      GSource      *source)
+{
+  GPtrArray *timer_heap = context->timer_heap;
+  guint index = source->priv->timer_heap_index;
+  GSource *last;
+
+  if (index == 0)
+    return;
+
+  index--;
+  source->priv->timer_heap_index = 0;
+
+  last = g_ptr_array_steal_index_fast (timer_heap, timer_heap->len - 1);
+  if (last != source)
+    {
+      timer_heap_set (timer_heap, index, last);
+      timer_heap_sift_up (timer_heap, index);
+      timer_heap_sift_down (timer_heap, last->priv->timer_heap_index - 1);
+    }
+
+  if (source->priv->timer_parked)
+    {
+      source->priv->timer_parked = FALSE;
+      source_add_to_context (source, context);
+    }
+  else
+    g_queue_unlink (&context->unparked_timers, &source->priv->timer_link);
+
+  g_trace_set_int64_counter (timer_heap_size_counter, timer_heap->len);
+}
+
+/* Holds context's lock. Called when the ready time of @source changed. */
+static void
+g_main_context_timer_update_unlocked (GMainContext *context,
+                                      GSource      *source)
+{
+  guint index = source->priv->timer_heap_index;
+
+  if (index == 0)
+    return;
+
+  timer_heap_sift_up (context->timer_heap, index - 1);
+  timer_heap_sift_down (context->timer_heap, source->priv->timer_heap_index - 1);
+}
+
+/* Holds context's lock, and context->time must be fresh. Parks the linked
+ * timer sources which are not due. Must only be called when no #GSourceIter
+ * is active on @context. */
+static void
+g_main_context_timer_park_unlocked (GMainContext *context)
+{
+  GList *l, *next;
+
+  for (l = context->unparked_timers.head; l != NULL; l = next)
+    {
+      GSource *source = l->data;
+
+      next = l->next;
+
+      if (SOURCE_BLOCKED (source) ||
+          (source->flags & G_SOURCE_READY) ||
+          timer_heap_key (source) <= context->time)
+        continue;
+
+      g_queue_unlink (&context->unparked_timers, l);
+      source_remove_from_context (source, context);
+      source->priv->timer_parked = TRUE;
+    }
+}
+
+static void
+timer_heap_collect_due (GPtrArray *timer_heap,
+                        guint      index,
+                        gint64     now,
+                        GPtrArray *due)
+{
+  GSource *source;
+
+  if (index >= timer_heap->len)
+    return;
+
+  source = timer_heap->pdata[index];
+  if (timer_heap_key (source) > now)
+    return;
+
+  if (source->priv->timer_parked)
+    g_ptr_array_add (due, source);
+
+  timer_heap_collect_due (timer_heap, 2 * index + 1, now, due);
+  timer_heap_collect_due (timer_heap, 2 * index + 2, now, due);
+}
+
+static gint
+timer_heap_compare (gconstpointer a,
+                    gconstpointer b)
+{
+  GSource *source_a = *(GSource **) a, *source_b = *(GSource **) b;
+
+  return timer_heap_less (source_a, source_b) ? -1 : 1;
+}
+
+/* Holds context's lock, and context->time must be fresh. Links the parked
+ * timer sources which are due back into the source lists, in ready time order,
+ * so that the prepare() and check() loops see them. */
+static void
+g_main_context_timer_unpark_due_unlocked (GMainContext *context)
+{
+  GPtrArray *due;
+  guint i;
+
+  if (context->timer_heap->len == 0 ||
+      timer_heap_key (context->timer_heap->pdata[0]) > context->time)
+    return;
+
+  due = g_ptr_array_new ();
+  timer_heap_collect_due (context->timer_heap, 0, context->time, due);
+  g_ptr_array_sort (due, timer_heap_compare);
+
+  for (i = 0; i < due->len; i++)
+    {
+      GSource *source = due->pdata[i];
+
+      source->priv->timer_parked = FALSE;
+      source_add_to_context (source, context);
+      g_queue_push_tail_link (&context->unparked_timers, &source->priv->timer_link);
+    }
+
+  g_ptr_array_unref (due);
+}
+
+/* Returns the earliest ready time of the parked sources in the subtree at
+ * @index, or -1 if none of them has one */
+static gint64
+timer_heap_min_parked (GPtrArray *timer_heap,
+                       guint      index)
+{
+  GSource *source;
+  gint64 a, b;
+
+  if (index >= timer_heap->len)
+    return -1;
+
+  /* A source without a ready time has the largest key, so the whole
+   * subtree has none either */
+  source = timer_heap->pdata[index];
+  if (timer_heap_key (source) == G_MAXINT64)
+    return -1;
+
+  /* Linked sources are taken care of by the prepare() loop, but parked
+   * ones may still be below them */
+  if (source->priv->timer_parked)
+    return source->priv->ready_time;
+
+  a = timer_heap_min_parked (timer_heap, 2 * index + 1);
+  b = timer_heap_min_parked (timer_heap, 2 * index + 2);
+
+  if (a < 0)
+    return b;
+  if (b < 0)
+    return a;
+
+  return MIN (a, b);
+}
+
+/* Holds context's lock, and context->time must be fresh. Returns the timeout
+ * until the first parked timer source is due, or -1 if there is none. */
+static gint64
+g_main_context_timer_get_timeout_unlocked (GMainContext *context)
+{
+  gint64 ready_time;
+
+  ready_time = timer_heap_min_parked (context->timer_heap, 0);
+  if (ready_time < 0)
+    return -1;
+
+  return MAX (0, ready_time - context->time);
+}
+
 static guint
 g_source_attach_unlocked (GSource      *source,
                           GMainContext *context,
@@ -1180,6 +1618,9 @@ g_source_attach_unlocked (GSource      *source,
 
   source_add_to_context (source, context);
 
+  if (source_is_pure_timer (source))
+    g_main_context_timer_add_unlocked (context, source);
+
   if (!SOURCE_BLOCKED (source))
     {
       tmp_list = source->poll_fds;
@@ -1292,6 +1733,8 @@ g_source_destroy_internal (GSource      *source,
 	  LOCK_CONTEXT (context);
 	}
 
+      g_main_context_timer_remove_unlocked (context, source);
+
       if (!SOURCE_BLOCKED (source))
 	{
 	  tmp_list = source->poll_fds;
@@ -1451,6 +1894,8 @@ g_source_add_poll (GSource *source,
 
   if (context)
     {
+      g_main_context_timer_remove_unlocked (context, source);
+
       if (!SOURCE_BLOCKED (source))
 	g_main_context_add_poll_unlocked (context, source->priority, fd);
       UNLOCK_CONTEXT (context);
@@ -1537,7 +1982,13 @@ g_source_add_child_source (GSource *source,
   context = source->context;
 
   if (context)
-    LOCK_CONTEXT (context);
+    {
+      LOCK_CONTEXT (context);
+
+      /* The child is linked just before its parent, which therefore must not
+       * be parked */
+      g_main_context_timer_remove_unlocked (context, source);
+    }
 
   TRACE (GLIB_SOURCE_ADD_CHILD_SOURCE (source, child_source));
 
@@ -1789,7 +2240,7 @@ g_source_set_priority_unlocked (GSource      *source,
 
   TRACE (GLIB_SOURCE_SET_PRIORITY (source, context, priority));
 
-  if (context)
+  if (context && !source->priv->timer_parked)
     {
       /* Remove the source from the context's source and then
        * add it back after so it is sorted in the correct place
@@ -1801,7 +2252,8 @@ g_source_set_priority_unlocked (GSource      *source,
 
   if (context)
     {
-      source_add_to_context (source, source->context);
+      if (!source->priv->timer_parked)
+        source_add_to_context (source, source->context);
 
       if (!SOURCE_BLOCKED (source))
 	{
@@ -1942,6 +2394,8 @@ g_source_set_ready_time (GSource *source,
 
   if (context)
     {
+      g_main_context_timer_update_unlocked (context, source);
+
       /* Quite likely that we need to change the timeout on the poll */
       if (!SOURCE_BLOCKED (source))
         g_wakeup_signal (context->wakeup);
@@ -2241,6 +2695,7 @@ g_source_unref_internal (GSource      *source,
 	{
 	  if (!SOURCE_DESTROYED (source))
 	    g_warning (G_STRLOC ": ref_count == 0, but source was still attached to a context!");
+          g_main_context_timer_remove_unlocked (context, source);
 	  source_remove_from_context (source, context);
 
 	  g_hash_table_remove (context->sources, &source->source_id);
@@ -2650,6 +3105,8 @@ g_source_add_unix_fd (GSource      *source,
 
   if (context)
     {
+      g_main_context_timer_remove_unlocked (context, source);
+
       if (!SOURCE_BLOCKED (source))
         g_main_context_add_poll_unlocked (context, source->priority, poll_fd);
       UNLOCK_CONTEXT (context);
@@ -2693,10 +3150,21 @@ g_source_modify_unix_fd (GSource      *source,
   context = source->context;
   poll_fd = tag;
 
+  if (context)
+    LOCK_CONTEXT (context);
+
   poll_fd->events = new_events;
 
   if (context)
-    g_main_context_wakeup (context);
+    {
+#ifdef HAVE_EPOLL_CREATE
+      if (context->epoll_fd >= 0 && !SOURCE_BLOCKED (source))
+        g_main_context_kernel_poll_update_unlocked (context, poll_fd->fd);
+#endif
+      UNLOCK_CONTEXT (context);
+
+      g_main_context_wakeup (context);
+    }
 }
 
 /**
@@ -3285,67 +3753,350 @@ unblock_source (GSource *source)
     }
 }
 
+/* Dispatch statistics.
+ *
+ * Histogram bucket 0 counts durations of 0µs, and bucket i > 0 those from
+ * 2^(i-1)µs up to 2^iµs, excluding the latter. The last bucket also counts
+ * anything longer. */
+
+#define DISPATCH_STATS_N_BUCKETS 32
+
+typedef struct
+{
+  guint64 count;
+  gint64 total_duration;  /* µs */
+  gint64 max_duration;  /* µs */
+  gint64 max_latency;  /* µs */
+  guint64 duration_histogram[DISPATCH_STATS_N_BUCKETS];
+  guint64 latency_histogram[DISPATCH_STATS_N_BUCKETS];
+} GDispatchStats;
+
+static inline guint
+dispatch_stats_bucket (gint64 usec)
+{
+  if (usec <= 0)
+    return 0;
+
+  return MIN (g_bit_storage ((guint64) usec), DISPATCH_STATS_N_BUCKETS - 1);
+}
+
+static inline const gchar *
+dispatch_stats_source_name (GSource *source)
+{
+  const gchar *name = g_source_get_name (source);
+
+  return (name != NULL) ? name : "(unnamed)";
+}
+
 /* HOLDS: context's lock */
 static void
-g_main_dispatch (GMainContext *context)
+dispatch_stats_record_unlocked (GMainContext *context,
+                                GSource      *source,
+                                gint64        begin_time,
+                                gint64        end_time)
 {
-  GMainDispatch *current = get_dispatch ();
-  guint i;
+  const gchar *name = dispatch_stats_source_name (source);
+  GDispatchStats *stats;
+  gint64 duration = end_time - begin_time;
 
-  for (i = 0; i < context->pending_dispatches->len; i++)
+  /* They may have been disabled during the dispatch */
+  if (context->dispatch_stats == NULL)
+    return;
+
+  stats = g_hash_table_lookup (context->dispatch_stats, name);
+  if (stats == NULL)
     {
-      GSource *source = context->pending_dispatches->pdata[i];
+      stats = g_new0 (GDispatchStats, 1);
+      g_hash_table_insert (context->dispatch_stats, g_strdup (name), stats);
+    }
 
-      context->pending_dispatches->pdata[i] = NULL;
-      g_assert (source);
+  stats->count++;
+  stats->total_duration += duration;
+  stats->max_duration = MAX (stats->max_duration, duration);
+  stats->duration_histogram[dispatch_stats_bucket (duration)]++;
 
-      source->flags &= ~G_SOURCE_READY;
+  /* Not set if the statistics were enabled after the check */
+  if (source->priv->dispatch_ready_time != 0)
+    {
+      gint64 latency = MAX (0, begin_time - source->priv->dispatch_ready_time);
 
-      if (!SOURCE_DESTROYED (source))
-	{
-	  gboolean was_in_call;
-	  gpointer user_data = NULL;
-	  GSourceFunc callback = NULL;
-	  GSourceCallbackFuncs *cb_funcs;
-	  gpointer cb_data;
-	  gboolean need_destroy;
+      stats->max_latency = MAX (stats->max_latency, latency);
+      stats->latency_histogram[dispatch_stats_bucket (latency)]++;
+      source->priv->dispatch_ready_time = 0;
+    }
+}
 
-	  gboolean (*dispatch) (GSource *,
-				GSourceFunc,
-				gpointer);
-          GSource *prev_source;
-          gint64 begin_time_nsec G_GNUC_UNUSED;
+static gint
+dispatch_stats_compare_total (gconstpointer a,
+                              gconstpointer b,
+                              gpointer      user_data)
+{
+  GHashTable *dispatch_stats = user_data;
+  const GDispatchStats *stats_a = g_hash_table_lookup (dispatch_stats, *(const gchar **) a);
+  const GDispatchStats *stats_b = g_hash_table_lookup (dispatch_stats, *(const gchar **) b);
 
-	  dispatch = source->source_funcs->dispatch;
-	  cb_funcs = source->callback_funcs;
-	  cb_data = source->callback_data;
+  if (stats_a->total_duration != stats_b->total_duration)
+    return (stats_a->total_duration > stats_b->total_duration) ? -1 : 1;
 
-	  if (cb_funcs)
-	    cb_funcs->ref (cb_data);
-	  
-	  if ((source->flags & G_SOURCE_CAN_RECURSE) == 0)
-	    block_source (source);
-	  
-	  was_in_call = source->flags & G_HOOK_FLAG_IN_CALL;
-	  source->flags |= G_HOOK_FLAG_IN_CALL;
+  return strcmp (*(const gchar **) a, *(const gchar **) b);
+}
 
-	  if (cb_funcs)
-	    cb_funcs->get (cb_data, source, &callback, &user_data);
+/* HOLDS: context's lock. Returns a summary of the dispatch statistics, one
+ * source name per line, the most time consuming first. */
+static gchar *
+dispatch_stats_to_string_unlocked (GMainContext *context)
+{
+  GString *string;
+  const gchar **names;
+  guint i, n_names;
 
-	  UNLOCK_CONTEXT (context);
+  names = (const gchar **) g_hash_table_get_keys_as_array (context->dispatch_stats, &n_names);
+  g_qsort_with_data (names, n_names, sizeof (*names),
+                     dispatch_stats_compare_total, context->dispatch_stats);
 
-          /* These operations are safe because 'current' is thread-local
-           * and not modified from anywhere but this function.
-           */
-          prev_source = current->source;
-          current->source = source;
-          current->depth++;
+  string = g_string_new (NULL);
+  g_string_append_printf (string, "Dispatch statistics for GMainContext %p:", context);
 
-          begin_time_nsec = G_TRACE_CURRENT_TIME;
+  for (i = 0; i < n_names; i++)
+    {
+      const GDispatchStats *stats = g_hash_table_lookup (context->dispatch_stats, names[i]);
+
+      g_string_append_printf (string,
+                              "\n  %s: %" G_GUINT64_FORMAT " dispatches, "
+                              "total %" G_GINT64_FORMAT " µs, "
+                              "max %" G_GINT64_FORMAT " µs, "
+                              "max latency %" G_GINT64_FORMAT " µs",
+                              names[i], stats->count, stats->total_duration,
+                              stats->max_duration, stats->max_latency);
+    }
 
-          TRACE (GLIB_MAIN_BEFORE_DISPATCH (g_source_get_name (source), source,
-                                            dispatch, callback, user_data));
-          need_destroy = !(* dispatch) (source, callback, user_data);
+  g_free (names);
+
+  return g_string_free_and_steal (string);
+}
+
+/**
+ * g_main_context_set_dispatch_stats_enabled:
+ * @context: (nullable): a #GMainContext (if %NULL, the global-default
+ *   main context will be used)
+ * @enabled: whether to collect dispatch statistics
+ *
+ * Sets whether @context collects statistics about the sources it dispatches,
+ * which can then be retrieved with g_main_context_get_dispatch_stats().
+ *
+ * Statistics are grouped by source name (see g_source_set_name()). Collecting
+ * them costs two calls to g_get_monotonic_time() per dispatch.
+ *
+ * Disabling the collection discards the statistics collected so far.
+ *
+ * Statistics are collected by all main contexts, and printed when
+ * g_main_loop_run() returns outside of any dispatch, if the `G_DEBUG`
+ * environment variable contains `dispatch-stats`.
+ *
+ * Since: 2.82
+ */
+void
+g_main_context_set_dispatch_stats_enabled (GMainContext *context,
+                                           gboolean      enabled)
+{
+  if (context == NULL)
+    context = g_main_context_default ();
+
+  LOCK_CONTEXT (context);
+
+  if (enabled && context->dispatch_stats == NULL)
+    context->dispatch_stats = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                     g_free, g_free);
+  else if (!enabled)
+    g_clear_pointer (&context->dispatch_stats, g_hash_table_unref);
+
+  UNLOCK_CONTEXT (context);
+}
+
+/**
+ * g_main_context_get_dispatch_stats:
+ * @context: (nullable): a #GMainContext (if %NULL, the global-default
+ *   main context will be used)
+ *
+ * Gets the statistics collected about the sources dispatched by @context
+ * since g_main_context_set_dispatch_stats_enabled() enabled them.
+ *
+ * The result is a dictionary of type `a{sa{sv}}` mapping source names to
+ * dictionaries with the following entries:
+ *
+ *  - `count` (`t`): the number of dispatches
+ *  - `total-duration` (`x`): the total time spent dispatching, in µs
+ *  - `max-duration` (`x`): the longest dispatch, in µs
+ *  - `max-latency` (`x`): the longest time between the source becoming
+ *    ready and its dispatch, in µs
+ *  - `duration-histogram` (`at`): number of dispatches by duration
+ *  - `latency-histogram` (`at`): number of dispatches by latency
+ *
+ * Histograms have logarithmic buckets: the first one counts values of
+ * 0µs, and the following ones values from 2^(i-1)µs to 2^iµs, excluding
+ * the latter, where i is the index of the bucket. The last one also
+ * counts all larger values.
+ *
+ * Sources without a name are grouped under `(unnamed)`. Latency is measured
+ * from the ready time of the source (see g_source_set_ready_time()) when it
+ * was due, or else from when @context found it ready.
+ *
+ * Returns: (transfer full) (nullable): the dispatch statistics, or %NULL if
+ *   they are not being collected
+ *
+ * Since: 2.82
+ */
+GVariant *
+g_main_context_get_dispatch_stats (GMainContext *context)
+{
+  GVariantBuilder builder;
+  GHashTableIter iter;
+  gpointer key, value;
+
+  if (context == NULL)
+    context = g_main_context_default ();
+
+  LOCK_CONTEXT (context);
+
+  if (context->dispatch_stats == NULL)
+    {
+      UNLOCK_CONTEXT (context);
+      return NULL;
+    }
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sa{sv}}"));
+
+  g_hash_table_iter_init (&iter, context->dispatch_stats);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+      const GDispatchStats *stats = value;
+      GVariantDict dict;
+
+      g_variant_dict_init (&dict, NULL);
+      g_variant_dict_insert (&dict, "count", "t", stats->count);
+      g_variant_dict_insert (&dict, "total-duration", "x", stats->total_duration);
+      g_variant_dict_insert (&dict, "max-duration", "x", stats->max_duration);
+      g_variant_dict_insert (&dict, "max-latency", "x", stats->max_latency);
+      g_variant_dict_insert_value (&dict, "duration-histogram",
+                                   g_variant_new_fixed_array (G_VARIANT_TYPE_UINT64,
+                                                              stats->duration_histogram,
+                                                              DISPATCH_STATS_N_BUCKETS,
+                                                              sizeof (guint64)));
+      g_variant_dict_insert_value (&dict, "latency-histogram",
+                                   g_variant_new_fixed_array (G_VARIANT_TYPE_UINT64,
+                                                              stats->latency_histogram,
+                                                              DISPATCH_STATS_N_BUCKETS,
+                                                              sizeof (guint64)));
+
+      g_variant_builder_add (&builder, "{s@a{sv}}", key, g_variant_dict_end (&dict));
+    }
+
+  UNLOCK_CONTEXT (context);
+
+  return g_variant_ref_sink (g_variant_builder_end (&builder));
+}
+
+/**
+ * g_main_context_get_child_watch_stats:
+ * @context: (nullable): a #GMainContext (if %NULL, the global-default
+ *   main context will be used)
+ * @n_reaped: (out) (optional): return location for the number of child
+ *   processes reaped
+ * @max_reaped_per_iteration: (out) (optional): return location for the
+ *   largest number of child processes reaped in a single iteration
+ *
+ * Gets counters of the child processes whose exit was reported by the
+ * child watch sources (see g_child_watch_source_new()) which @context
+ * dispatched. Unlike g_main_context_get_dispatch_stats(), these are always
+ * collected.
+ *
+ * Since: 2.82
+ */
+void
+g_main_context_get_child_watch_stats (GMainContext *context,
+                                      guint64      *n_reaped,
+                                      guint        *max_reaped_per_iteration)
+{
+  if (context == NULL)
+    context = g_main_context_default ();
+
+  LOCK_CONTEXT (context);
+
+  if (n_reaped != NULL)
+    *n_reaped = context->children_reaped_total;
+  if (max_reaped_per_iteration != NULL)
+    *max_reaped_per_iteration = context->children_reaped_max;
+
+  UNLOCK_CONTEXT (context);
+}
+
+/* HOLDS: context's lock */
+static void
+g_main_dispatch (GMainContext *context)
+{
+  GMainDispatch *current = get_dispatch ();
+  guint i;
+
+  for (i = 0; i < context->pending_dispatches->len; i++)
+    {
+      GSource *source = context->pending_dispatches->pdata[i];
+
+      context->pending_dispatches->pdata[i] = NULL;
+      g_assert (source);
+
+      source->flags &= ~G_SOURCE_READY;
+
+      if (!SOURCE_DESTROYED (source))
+	{
+	  gboolean was_in_call;
+	  gpointer user_data = NULL;
+	  GSourceFunc callback = NULL;
+	  GSourceCallbackFuncs *cb_funcs;
+	  gpointer cb_data;
+	  gboolean need_destroy;
+
+	  gboolean (*dispatch) (GSource *,
+				GSourceFunc,
+				gpointer);
+          GSource *prev_source;
+          gint64 begin_time_nsec G_GNUC_UNUSED;
+          gboolean collect_stats;
+          gint64 stats_begin_time = 0;
+
+	  dispatch = source->source_funcs->dispatch;
+	  cb_funcs = source->callback_funcs;
+	  cb_data = source->callback_data;
+
+	  if (cb_funcs)
+	    cb_funcs->ref (cb_data);
+	  
+	  if ((source->flags & G_SOURCE_CAN_RECURSE) == 0)
+	    block_source (source);
+	  
+	  was_in_call = source->flags & G_HOOK_FLAG_IN_CALL;
+	  source->flags |= G_HOOK_FLAG_IN_CALL;
+
+	  if (cb_funcs)
+	    cb_funcs->get (cb_data, source, &callback, &user_data);
+
+          collect_stats = context->dispatch_stats != NULL;
+
+	  UNLOCK_CONTEXT (context);
+
+          /* These operations are safe because 'current' is thread-local
+           * and not modified from anywhere but this function.
+           */
+          prev_source = current->source;
+          current->source = source;
+          current->depth++;
+
+          begin_time_nsec = G_TRACE_CURRENT_TIME;
+          if (G_UNLIKELY (collect_stats))
+            stats_begin_time = g_get_monotonic_time ();
+
+          TRACE (GLIB_MAIN_BEFORE_DISPATCH (g_source_get_name (source), source,
+                                            dispatch, callback, user_data));
+          need_destroy = !(* dispatch) (source, callback, user_data);
           TRACE (GLIB_MAIN_AFTER_DISPATCH (g_source_get_name (source), source,
                                            dispatch, need_destroy));
 
@@ -3362,6 +4113,10 @@ g_main_dispatch (GMainContext *context)
 	    cb_funcs->unref (cb_data);
 
  	  LOCK_CONTEXT (context);
+
+          if (G_UNLIKELY (collect_stats))
+            dispatch_stats_record_unlocked (context, source, stats_begin_time,
+                                            g_get_monotonic_time ());
 	  
 	  if (!was_in_call)
 	    source->flags &= ~G_HOOK_FLAG_IN_CALL;
@@ -3383,6 +4138,14 @@ g_main_dispatch (GMainContext *context)
     }
 
   g_ptr_array_set_size (context->pending_dispatches, 0);
+
+  if (context->children_reaped_iteration > 0)
+    {
+      context->children_reaped_total += context->children_reaped_iteration;
+      context->children_reaped_max = MAX (context->children_reaped_max,
+                                          context->children_reaped_iteration);
+      context->children_reaped_iteration = 0;
+    }
 }
 
 /**
@@ -3716,6 +4479,15 @@ g_main_context_prepare_unlocked (GMainContext *context,
         g_source_unref_internal ((GSource *)context->pending_dispatches->pdata[i], context, TRUE);
     }
   g_ptr_array_set_size (context->pending_dispatches, 0);
+
+  if (context->timer_heap->len > 0)
+    {
+      context->time = g_get_monotonic_time ();
+      context->time_is_fresh = TRUE;
+
+      g_main_context_timer_park_unlocked (context);
+      g_main_context_timer_unpark_due_unlocked (context);
+    }
   
   /* Prepare all sources */
 
@@ -3815,6 +4587,23 @@ g_main_context_prepare_unlocked (GMainContext *context,
     }
   g_source_iter_clear (&iter);
 
+  /* Parked timer sources were not seen by the loop above */
+  if (context->timeout_usec != 0 && context->timer_heap->len > 0)
+    {
+      gint64 timer_timeout_usec;
+
+      if (!context->time_is_fresh)
+        {
+          context->time = g_get_monotonic_time ();
+          context->time_is_fresh = TRUE;
+        }
+
+      timer_timeout_usec = g_main_context_timer_get_timeout_unlocked (context);
+      if (timer_timeout_usec >= 0 &&
+          (context->timeout_usec < 0 || timer_timeout_usec < context->timeout_usec))
+        context->timeout_usec = timer_timeout_usec;
+    }
+
   TRACE (GLIB_MAIN_CONTEXT_AFTER_PREPARE (context, current_priority, n_ready));
   
   if (priority)
@@ -3927,6 +4716,12 @@ g_main_context_query_unlocked (GMainContext *context,
 
   context->poll_changed = FALSE;
 
+#ifdef HAVE_EPOLL_CREATE
+  /* The next kernel poll iteration can’t rely on only the last ready fds
+   * having non-zero revents. */
+  context->kernel_revents_stale = TRUE;
+#endif
+
   if (timeout_usec)
     {
       *timeout_usec = context->timeout_usec;
@@ -3989,6 +4784,7 @@ g_main_context_check_unlocked (GMainContext *context,
   GSourceIter iter;
   GPollRec *pollrec;
   gint n_ready = 0;
+  gint64 stats_time = 0;
   gint i;
 
   if (context == NULL)
@@ -4056,6 +4852,18 @@ g_main_context_check_unlocked (GMainContext *context,
       i++;
     }
 
+  /* Timer sources which became due while polling must be seen by the loop */
+  if (context->timer_heap->len > 0)
+    {
+      if (!context->time_is_fresh)
+        {
+          context->time = g_get_monotonic_time ();
+          context->time_is_fresh = TRUE;
+        }
+
+      g_main_context_timer_unpark_due_unlocked (context);
+    }
+
   g_source_iter_init (&iter, context, TRUE);
   while (g_source_iter_next (&iter, &source))
     {
@@ -4143,6 +4951,19 @@ g_main_context_check_unlocked (GMainContext *context,
 
       if (source->flags & G_SOURCE_READY)
 	{
+          if (G_UNLIKELY (context->dispatch_stats != NULL))
+            {
+              gint64 ready_time = source->priv->ready_time;
+
+              if (stats_time == 0)
+                stats_time = g_get_monotonic_time ();
+
+              /* For a source which was due, count the latency from when it
+               * was due rather than from when it was noticed */
+              source->priv->dispatch_ready_time =
+                (ready_time > 0 && ready_time < stats_time) ? ready_time : stats_time;
+            }
+
           g_source_ref (source);
 	  g_ptr_array_add (context->pending_dispatches, source);
 
@@ -4242,21 +5063,39 @@ g_main_context_iterate_unlocked (GMainContext *context,
   
   g_main_context_prepare_unlocked (context, &max_priority);
 
-  while ((nfds = g_main_context_query_unlocked (
-              context, max_priority, &timeout_usec, fds,
-              allocated_nfds)) > allocated_nfds)
+#ifdef HAVE_EPOLL_CREATE
+  if (g_main_context_uses_kernel_poll_unlocked (context))
     {
-      g_free (fds);
-      context->cached_poll_array_size = allocated_nfds = nfds;
-      context->cached_poll_array = fds = g_new (GPollFD, nfds);
+      timeout_usec = context->timeout_usec;
+      if (timeout_usec != 0)
+        context->time_is_fresh = FALSE;
+
+      if (!block)
+        timeout_usec = 0;
+
+      g_main_context_kernel_poll_unlocked (context, timeout_usec, max_priority);
+
+      some_ready = g_main_context_check_unlocked (context, max_priority, NULL, 0);
     }
+  else
+#endif
+    {
+      while ((nfds = g_main_context_query_unlocked (
+                  context, max_priority, &timeout_usec, fds,
+                  allocated_nfds)) > allocated_nfds)
+        {
+          g_free (fds);
+          context->cached_poll_array_size = allocated_nfds = nfds;
+          context->cached_poll_array = fds = g_new (GPollFD, nfds);
+        }
 
-  if (!block)
-    timeout_usec = 0;
+      if (!block)
+        timeout_usec = 0;
 
-  g_main_context_poll_unlocked (context, timeout_usec, max_priority, fds, nfds);
+      g_main_context_poll_unlocked (context, timeout_usec, max_priority, fds, nfds);
 
-  some_ready = g_main_context_check_unlocked (context, max_priority, fds, nfds);
+      some_ready = g_main_context_check_unlocked (context, max_priority, fds, nfds);
+    }
   
   if (dispatch)
     g_main_context_dispatch_unlocked (context);
@@ -4415,6 +5254,7 @@ void
 g_main_loop_run (GMainLoop *loop)
 {
   GThread *self = G_THREAD_SELF;
+  gchar *stats_summary = NULL;
 
   g_return_if_fail (loop != NULL);
   g_return_if_fail (g_atomic_int_get (&loop->ref_count) > 0);
@@ -4465,7 +5305,18 @@ g_main_loop_run (GMainLoop *loop)
 
   g_main_context_release_unlocked (loop->context);
 
+  if (G_UNLIKELY (g_main_dispatch_stats_debug) &&
+      loop->context->dispatch_stats != NULL &&
+      g_main_depth () == 0)
+    stats_summary = dispatch_stats_to_string_unlocked (loop->context);
+
   UNLOCK_CONTEXT (loop->context);
+
+  if (G_UNLIKELY (stats_summary != NULL))
+    {
+      g_message ("%s", stats_summary);
+      g_free (stats_summary);
+    }
   
   g_main_loop_unref (loop);
 }
@@ -4712,6 +5563,11 @@ g_main_context_add_poll_unlocked (GMainContext *context,
 
   context->n_poll_records++;
 
+#ifdef HAVE_EPOLL_CREATE
+  if (context->epoll_fd >= 0)
+    g_main_context_kernel_poll_add_unlocked (context, newrec);
+#endif
+
   context->poll_changed = TRUE;
 
   /* Now wake up the main loop if it is waiting in the poll() */
@@ -4757,6 +5613,11 @@ g_main_context_remove_poll_unlocked (GMainContext *context,
       nextrec = pollrec->next;
       if (pollrec->fd == fd)
 	{
+#ifdef HAVE_EPOLL_CREATE
+          if (context->epoll_fd >= 0)
+            g_main_context_kernel_poll_remove_unlocked (context, pollrec);
+#endif
+
 	  if (prevrec != NULL)
 	    prevrec->next = nextrec;
 	  else
@@ -4780,6 +5641,306 @@ g_main_context_remove_poll_unlocked (GMainContext *context,
   g_wakeup_signal (context->wakeup);
 }
 
+#ifdef HAVE_EPOLL_CREATE
+/* Kernel poll set support for G_MAIN_CONTEXT_FLAGS_KERNEL_POLLING.
+ *
+ * The poll_records list is still maintained as usual (it is needed by
+ * g_main_context_query() and by custom poll functions), but in addition every
+ * distinct fd in it is registered once with an epoll instance. The
+ * registration is updated incrementally as records are added and removed, so
+ * that an iteration only has to look at the fds the kernel reports as ready.
+ */
+
+static inline guint32
+poll_events_to_epoll (gushort events)
+{
+  guint32 result = 0;
+
+  if (events & G_IO_IN)
+    result |= EPOLLIN;
+  if (events & G_IO_OUT)
+    result |= EPOLLOUT;
+  if (events & G_IO_PRI)
+    result |= EPOLLPRI;
+
+  /* EPOLLERR and EPOLLHUP are always reported, like with poll() */
+  return result;
+}
+
+static inline gushort
+epoll_events_to_poll (guint32 events)
+{
+  gushort result = 0;
+
+  if (events & EPOLLIN)
+    result |= G_IO_IN;
+  if (events & EPOLLOUT)
+    result |= G_IO_OUT;
+  if (events & EPOLLPRI)
+    result |= G_IO_PRI;
+  if (events & EPOLLERR)
+    result |= G_IO_ERR;
+  if (events & EPOLLHUP)
+    result |= G_IO_HUP;
+
+  return result;
+}
+
+/* Recompute the union of the events of all the poll records for @krec->fd
+ * (other than @exclude, if non-%NULL) and push it to the kernel if it
+ * changed. */
+static void
+g_main_context_kernel_poll_sync_unlocked (GMainContext   *context,
+                                          GPollKernelRec *krec,
+                                          GPollRec       *exclude)
+{
+  GPollRec *pollrec;
+  gushort events = 0;
+  struct epoll_event ev = { 0, };
+
+  for (pollrec = krec->first;
+       pollrec != NULL && pollrec->fd->fd == krec->fd;
+       pollrec = pollrec->next)
+    {
+      if (pollrec != exclude)
+        events |= pollrec->fd->events & ~(G_IO_ERR|G_IO_HUP|G_IO_NVAL);
+    }
+
+  if (krec->unpollable || events == krec->events)
+    return;
+
+  ev.events = poll_events_to_epoll (events);
+  ev.data.fd = krec->fd;
+
+  if (epoll_ctl (context->epoll_fd, EPOLL_CTL_MOD, krec->fd, &ev) == 0)
+    krec->events = events;
+}
+
+static void
+g_main_context_kernel_poll_add_unlocked (GMainContext *context,
+                                         GPollRec     *pollrec)
+{
+  GPollKernelRec *krec;
+  gint fd = pollrec->fd->fd;
+  struct epoll_event ev = { 0, };
+
+  /* poll() ignores negative fds, so there is nothing to register */
+  if (fd < 0)
+    return;
+
+  krec = g_hash_table_lookup (context->kernel_poll_records, &fd);
+  if (krec != NULL)
+    {
+      /* New records are inserted after any existing ones with the same fd,
+       * so krec->first stays valid. */
+      g_main_context_kernel_poll_sync_unlocked (context, krec, NULL);
+      return;
+    }
+
+  krec = g_new0 (GPollKernelRec, 1);
+  krec->fd = fd;
+  krec->events = pollrec->fd->events & ~(G_IO_ERR|G_IO_HUP|G_IO_NVAL);
+  krec->first = pollrec;
+
+  ev.events = poll_events_to_epoll (krec->events);
+  ev.data.fd = fd;
+
+  if (epoll_ctl (context->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0)
+    {
+      /* Typically EPERM for regular files, which poll() always reports as
+       * ready, or EBADF, for which poll() reports G_IO_NVAL. Either way the
+       * poll() semantics can’t be emulated, so iterations fall back to
+       * poll() while any such fd is registered. */
+      krec->unpollable = TRUE;
+      context->n_kernel_unpollable++;
+    }
+
+  g_hash_table_insert (context->kernel_poll_records, &krec->fd, krec);
+}
+
+/* Must be called before @pollrec is unlinked from the poll_records list. */
+static void
+g_main_context_kernel_poll_remove_unlocked (GMainContext *context,
+                                            GPollRec     *pollrec)
+{
+  GPollKernelRec *krec;
+  gint fd = pollrec->fd->fd;
+
+  krec = g_hash_table_lookup (context->kernel_poll_records, &fd);
+  if (krec == NULL)
+    return;
+
+  if (krec->first == pollrec)
+    {
+      GPollRec *nextrec = pollrec->next;
+
+      if (nextrec == NULL || nextrec->fd->fd != fd)
+        {
+          /* Last record for this fd. The fd may already have been closed
+           * (which removes it from the epoll set), so ignore errors. */
+          if (krec->unpollable)
+            context->n_kernel_unpollable--;
+          else
+            epoll_ctl (context->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+
+          g_hash_table_remove (context->kernel_poll_records, &fd);
+          return;
+        }
+
+      krec->first = nextrec;
+    }
+
+  g_main_context_kernel_poll_sync_unlocked (context, krec, pollrec);
+}
+
+/* Called when the events of a #GPollFD for @fd were modified in place. */
+static void
+g_main_context_kernel_poll_update_unlocked (GMainContext *context,
+                                            gint          fd)
+{
+  GPollKernelRec *krec;
+
+  krec = g_hash_table_lookup (context->kernel_poll_records, &fd);
+  if (krec != NULL)
+    g_main_context_kernel_poll_sync_unlocked (context, krec, NULL);
+}
+
+static inline gboolean
+g_main_context_uses_kernel_poll_unlocked (GMainContext *context)
+{
+  return (context->epoll_fd >= 0 &&
+          context->poll_func == g_poll &&
+          context->n_kernel_unpollable == 0);
+}
+
+/* HOLDS: context's lock
+ *
+ * Equivalent of g_main_context_query_unlocked(), g_main_context_poll_unlocked()
+ * and the revents part of g_main_context_check_unlocked() for the kernel poll
+ * set. The revents of every poll record with a priority up to @max_priority
+ * are updated, as with poll(). */
+static void
+g_main_context_kernel_poll_unlocked (GMainContext *context,
+                                     gint64        timeout_usec,
+                                     gint          max_priority)
+{
+  GPollRec *pollrec;
+  gboolean use_epoll_wait = TRUE;
+  gint n_ready = -1, errsv = 0;
+  guint i;
+
+  /* Clear the results of the previous iteration. If plain poll() was used
+   * since then, any record could have stale revents. */
+  if (context->kernel_revents_stale)
+    {
+      for (pollrec = context->poll_records; pollrec; pollrec = pollrec->next)
+        pollrec->fd->revents = 0;
+      context->kernel_revents_stale = FALSE;
+    }
+  else
+    {
+      for (i = 0; i < context->kernel_ready_fds->len; i++)
+        {
+          gint fd = g_array_index (context->kernel_ready_fds, gint, i);
+          GPollKernelRec *krec;
+
+          krec = g_hash_table_lookup (context->kernel_poll_records, &fd);
+          if (krec == NULL)
+            continue;
+
+          for (pollrec = krec->first;
+               pollrec != NULL && pollrec->fd->fd == fd;
+               pollrec = pollrec->next)
+            pollrec->fd->revents = 0;
+        }
+    }
+  g_array_set_size (context->kernel_ready_fds, 0);
+
+  if (context->n_epoll_events < g_hash_table_size (context->kernel_poll_records))
+    {
+      context->n_epoll_events = MAX (g_hash_table_size (context->kernel_poll_records), 16);
+      context->epoll_events = g_renew (struct epoll_event, context->epoll_events,
+                                       context->n_epoll_events);
+    }
+
+  context->poll_changed = FALSE;
+
+  UNLOCK_CONTEXT (context);
+#ifdef HAVE_EPOLL_PWAIT2
+  /* epoll_pwait2() takes a timespec, which avoids rounding sub-millisecond
+   * timeouts up. It needs Linux 5.11, so fall back if it is missing. */
+  use_epoll_wait = !g_atomic_int_get (&epoll_pwait2_supported);
+  if (!use_epoll_wait)
+    {
+      struct timespec spec;
+      struct timespec *spec_p = NULL;
+
+      if (timeout_usec > -1)
+        {
+          spec.tv_sec = timeout_usec / G_USEC_PER_SEC;
+          spec.tv_nsec = (timeout_usec % G_USEC_PER_SEC) * 1000L;
+          spec_p = &spec;
+        }
+
+      n_ready = epoll_pwait2 (context->epoll_fd, context->epoll_events,
+                              context->n_epoll_events, spec_p, NULL);
+      errsv = errno;
+
+      if (n_ready < 0 && errsv == ENOSYS)
+        {
+          g_atomic_int_set (&epoll_pwait2_supported, FALSE);
+          use_epoll_wait = TRUE;
+        }
+    }
+#endif
+
+  if (use_epoll_wait)
+    {
+      n_ready = epoll_wait (context->epoll_fd, context->epoll_events,
+                            context->n_epoll_events,
+                            round_timeout_to_msec (timeout_usec));
+      errsv = errno;
+    }
+  LOCK_CONTEXT (context);
+
+  if (n_ready < 0)
+    {
+      if (errsv != EINTR)
+        g_warning ("epoll_wait(2) failed due to: %s.", g_strerror (errsv));
+      return;
+    }
+
+  for (i = 0; i < (guint) n_ready; i++)
+    {
+      gint fd = context->epoll_events[i].data.fd;
+      gushort revents = epoll_events_to_poll (context->epoll_events[i].events);
+      GPollKernelRec *krec;
+
+      /* The fd may have been removed while we were not holding the lock */
+      krec = g_hash_table_lookup (context->kernel_poll_records, &fd);
+      if (krec == NULL)
+        continue;
+
+      if (fd == context->wake_up_rec.fd)
+        {
+          TRACE (GLIB_MAIN_CONTEXT_WAKEUP_ACKNOWLEDGE (context));
+          g_wakeup_acknowledge (context->wakeup);
+        }
+
+      for (pollrec = krec->first;
+           pollrec != NULL && pollrec->fd->fd == fd;
+           pollrec = pollrec->next)
+        {
+          if (pollrec->priority <= max_priority)
+            pollrec->fd->revents =
+              revents & (pollrec->fd->events | G_IO_ERR | G_IO_HUP | G_IO_NVAL);
+        }
+
+      g_array_append_val (context->kernel_ready_fds, fd);
+    }
+}
+#endif  /* HAVE_EPOLL_CREATE */
+
 /**
  * g_source_get_current_time:
  * @source:  a #GSource
@@ -5006,7 +6167,7 @@ g_timeout_set_expiration (GTimeoutSource *timeout_source,
             timer_perturb = 0;
         }
 
-      expiration = current_time + (guint64) timeout_source->interval * 1000 * 1000;
+      expiration = current_time + timeout_source->interval;
 
       /* We want the microseconds part of the timeout to land on the
        * 'timer_perturb' mark, but we need to make sure we don't try to
@@ -5025,7 +6186,7 @@ g_timeout_set_expiration (GTimeoutSource *timeout_source,
     }
   else
     {
-      expiration = current_time + (guint64) timeout_source->interval * 1000;
+      expiration = current_time + timeout_source->interval;
     }
 
   g_source_set_ready_time ((GSource *) timeout_source, expiration);
@@ -5066,14 +6227,14 @@ g_timeout_dispatch (GSource     *source,
 }
 
 static GSource *
-timeout_source_new (guint    interval,
+timeout_source_new (guint64  interval_usec,
                     gboolean seconds,
                     gboolean one_shot)
 {
   GSource *source = g_source_new (&g_timeout_funcs, sizeof (GTimeoutSource));
   GTimeoutSource *timeout_source = (GTimeoutSource *)source;
 
-  timeout_source->interval = interval;
+  timeout_source->interval = interval_usec;
   timeout_source->seconds = seconds;
   timeout_source->one_shot = one_shot;
 
@@ -5100,7 +6261,7 @@ timeout_source_new (guint    interval,
 GSource *
 g_timeout_source_new (guint interval)
 {
-  return timeout_source_new (interval, FALSE, FALSE);
+  return timeout_source_new ((guint64) interval * 1000, FALSE, FALSE);
 }
 
 /**
@@ -5126,7 +6287,40 @@ g_timeout_source_new (guint interval)
 GSource *
 g_timeout_source_new_seconds (guint interval)
 {
-  return timeout_source_new (interval, TRUE, FALSE);
+  return timeout_source_new ((guint64) interval * G_USEC_PER_SEC, TRUE, FALSE);
+}
+
+/**
+ * g_timeout_source_new_us:
+ * @interval: the timeout interval in microseconds
+ *
+ * Creates a new timeout source, like g_timeout_source_new(), but with an
+ * interval given in microseconds.
+ *
+ * The main loop waits with a timeout in microseconds or better where the
+ * platform allows it (using ppoll() or epoll_pwait2() on Linux), so this
+ * is suitable for intervals well below a millisecond. Elsewhere the wait
+ * is rounded up to the next millisecond, as with g_timeout_source_new().
+ *
+ * As with any timeout source, dispatch may be delayed by other sources
+ * or by the scheduler, and the next expiration is computed from the time
+ * of the previous dispatch.
+ *
+ * The source will not initially be associated with any #GMainContext
+ * and must be added to one with g_source_attach() before it will be
+ * executed.
+ *
+ * The interval given is in terms of monotonic time, not wall clock time.
+ * See g_get_monotonic_time().
+ *
+ * Returns: the newly-created timeout source
+ *
+ * Since: 2.82
+ **/
+GSource *
+g_timeout_source_new_us (guint64 interval)
+{
+  return timeout_source_new (interval, FALSE, FALSE);
 }
 
 static guint
@@ -5143,7 +6337,8 @@ timeout_add_full (gint           priority,
 
   g_return_val_if_fail (function != NULL, 0);
 
-  source = timeout_source_new (interval, seconds, one_shot);
+  source = timeout_source_new ((guint64) interval * (seconds ? G_USEC_PER_SEC : 1000),
+                               seconds, one_shot);
 
   if (priority != G_PRIORITY_DEFAULT)
     g_source_set_priority (source, priority);
@@ -5493,7 +6688,13 @@ g_child_watch_finalize (GSource *source)
     }
 
   G_LOCK (unix_signal_lock);
-  unix_child_watches = g_slist_remove (unix_child_watches, source);
+  if (g_hash_table_lookup (unix_child_watches,
+                           GINT_TO_POINTER (child_watch_source->pid)) == source)
+    g_hash_table_remove (unix_child_watches, GINT_TO_POINTER (child_watch_source->pid));
+  /* If it was woken for an exited child which it never reaped, that child
+   * hides any others, so make sure their sources are woken too */
+  if (g_atomic_int_get (&child_watch_source->child_maybe_exited))
+    rescan_unix_child_watches_unlocked ();
   unref_unix_signal_handler_unlocked (SIGCHLD);
   G_UNLOCK (unix_signal_lock);
 #endif /* G_OS_WIN32 */
@@ -5538,6 +6739,18 @@ wake_source (GSource *source)
   G_UNLOCK(main_context_list);
 }
 
+/* HOLDS: unix_signal_lock
+ *
+ * Called after reaping a child: another exited child may have been hidden
+ * behind it from the waitid() in dispatch_unix_signals_unlocked(), possibly
+ * with its SIGCHLD merged into the one for the child just reaped. */
+static void
+rescan_unix_child_watches_unlocked (void)
+{
+  if (unix_child_watches != NULL && g_hash_table_size (unix_child_watches) > 0)
+    g_unix_signal_handler (SIGCHLD);
+}
+
 static void
 dispatch_unix_signals_unlocked (void)
 {
@@ -5569,22 +6782,60 @@ dispatch_unix_signals_unlocked (void)
     }
 
   /* handle GChildWatchSource instances */
-  if (pending[SIGCHLD])
+  if (pending[SIGCHLD] && unix_child_watches != NULL)
     {
-      /* The only way we can do this is to scan all of the children.
-       *
-       * The docs promise that we will not reap children that we are not
+      gboolean wake_all = TRUE;
+#ifdef WNOWAIT
+      siginfo_t child_info = { 0, };
+
+      /* The docs promise that we will not reap children that we are not
        * explicitly watching, so that ties our hands from calling
        * waitpid(-1).  We also can't use siginfo's si_pid field since if
        * multiple SIGCHLD arrive at the same time, one of them can be
        * dropped (since a given UNIX signal can only be pending once).
+       *
+       * What we can do is look at one exited child without reaping it.
+       * If it is being watched, wake only its source: reaping it in
+       * g_child_watch_dispatch() triggers another scan here, which
+       * finds the next exited child, if any. So with many watched
+       * children, each exit costs one wakeup rather than one per watch.
        */
-      for (node = unix_child_watches; node; node = node->next)
+      if (waitid (P_ALL, 0, &child_info, WEXITED | WNOHANG | WNOWAIT) == 0)
         {
-          GChildWatchSource *source = node->data;
+          GChildWatchSource *source;
 
-          if (g_atomic_int_compare_and_exchange (&source->child_maybe_exited, FALSE, TRUE))
-            wake_source ((GSource *) source);
+          if (child_info.si_pid == 0)
+            {
+              /* No child has exited (yet); a new SIGCHLD will follow */
+              wake_all = FALSE;
+            }
+          else if ((source = g_hash_table_lookup (unix_child_watches,
+                                                  GINT_TO_POINTER (child_info.si_pid))) != NULL &&
+                   g_atomic_int_compare_and_exchange (&source->child_maybe_exited, FALSE, TRUE))
+            {
+              wake_source ((GSource *) source);
+              wake_all = FALSE;
+            }
+
+          /* Otherwise the child is not ours to reap, or its source has
+           * not got round to it yet: it hides any other exited children
+           * from waitid(), so fall back to checking all of them. */
+        }
+#endif /* WNOWAIT */
+
+      if (wake_all)
+        {
+          GHashTableIter iter;
+          gpointer value;
+
+          g_hash_table_iter_init (&iter, unix_child_watches);
+          while (g_hash_table_iter_next (&iter, NULL, &value))
+            {
+              GChildWatchSource *source = value;
+
+              if (g_atomic_int_compare_and_exchange (&source->child_maybe_exited, FALSE, TRUE))
+                wake_source ((GSource *) source);
+            }
         }
     }
 
@@ -5858,6 +7109,10 @@ g_child_watch_dispatch (GSource    *source,
                  * status information. */
                 wait_status = siginfo_t_to_wait_status (&child_info);
                 child_exited = TRUE;
+
+                G_LOCK (unix_signal_lock);
+                rescan_unix_child_watches_unlocked ();
+                G_UNLOCK (unix_signal_lock);
               }
             else
               {
@@ -5903,7 +7158,13 @@ g_child_watch_dispatch (GSource    *source,
           }
 
         if (pid > 0)
-          wait_status = wstatus;
+          {
+            wait_status = wstatus;
+
+            G_LOCK (unix_signal_lock);
+            rescan_unix_child_watches_unlocked ();
+            G_UNLOCK (unix_signal_lock);
+          }
         else
           {
             int errsv = errno;
@@ -5918,6 +7179,9 @@ g_child_watch_dispatch (GSource    *source,
   }
 #endif /* G_OS_WIN32 */
 
+  /* Only the owner of the context dispatches, so this needs no locking */
+  source->context->children_reaped_iteration++;
+
   if (!callback)
     {
       g_warning ("Child watch source dispatched without callback. "
@@ -6063,7 +7327,9 @@ g_child_watch_source_new (GPid pid)
 
   G_LOCK (unix_signal_lock);
   ref_unix_signal_handler_unlocked (SIGCHLD);
-  unix_child_watches = g_slist_prepend (unix_child_watches, child_watch_source);
+  if (unix_child_watches == NULL)
+    unix_child_watches = g_hash_table_new (NULL, NULL);
+  g_hash_table_insert (unix_child_watches, GINT_TO_POINTER (pid), child_watch_source);
   G_UNLOCK (unix_signal_lock);
 #endif /* !G_OS_WIN32 */
 
@@ -6393,6 +7659,168 @@ g_idle_remove_by_data (gpointer data)
   return g_source_remove_by_funcs_user_data (&g_idle_funcs, data);
 }
 
+/* Queued invocations.
+ *
+ * g_main_context_invoke_full() calls from threads which can’t acquire the
+ * context are pushed onto a lock-free LIFO by the callers, and the whole list
+ * is taken and run by a single internal source. Only the call which finds the
+ * queue empty wakes the context up, so a burst of invocations costs a single
+ * wakeup, and no #GSource allocation or context lock per call.
+ */
+
+typedef struct _GInvokeItem GInvokeItem;
+
+struct _GInvokeItem
+{
+  GInvokeItem *next;
+  GSourceFunc function;
+  gpointer data;
+  GDestroyNotify notify;
+};
+
+typedef struct
+{
+  GSource source;
+
+  GInvokeItem *queue;  /* (atomic) (owned) most recently pushed first */
+} GInvokeSource;
+
+/* Returns TRUE if the queue was empty */
+static gboolean
+g_invoke_source_push (GInvokeSource *invoke_source,
+                      GInvokeItem   *item)
+{
+  GInvokeItem *head;
+
+  do
+    {
+      head = g_atomic_pointer_get (&invoke_source->queue);
+      item->next = head;
+    }
+  while (!g_atomic_pointer_compare_and_exchange (&invoke_source->queue, head, item));
+
+  return head == NULL;
+}
+
+/* Takes all the queued items, in the order they were pushed */
+static GInvokeItem *
+g_invoke_source_take (GInvokeSource *invoke_source)
+{
+  GInvokeItem *item, *next, *items = NULL;
+
+  item = g_atomic_pointer_exchange (&invoke_source->queue, NULL);
+
+  for (; item != NULL; item = next)
+    {
+      next = item->next;
+      item->next = items;
+      items = item;
+    }
+
+  return items;
+}
+
+static gboolean
+g_invoke_source_prepare (GSource *source,
+                         gint    *timeout)
+{
+  GInvokeSource *invoke_source = (GInvokeSource *) source;
+
+  *timeout = -1;
+
+  return g_atomic_pointer_get (&invoke_source->queue) != NULL;
+}
+
+static gboolean
+g_invoke_source_check (GSource *source)
+{
+  GInvokeSource *invoke_source = (GInvokeSource *) source;
+
+  return g_atomic_pointer_get (&invoke_source->queue) != NULL;
+}
+
+static gboolean
+g_invoke_source_dispatch (GSource     *source,
+                          GSourceFunc  callback,
+                          gpointer     user_data)
+{
+  GInvokeSource *invoke_source = (GInvokeSource *) source;
+  GInvokeItem *item, *next;
+
+  for (item = g_invoke_source_take (invoke_source); item != NULL; item = next)
+    {
+      next = item->next;
+
+      /* As with an idle source, run it again on the next iteration. The
+       * context is running, so there is no need to wake it up. */
+      if (item->function (item->data))
+        {
+          g_invoke_source_push (invoke_source, item);
+          continue;
+        }
+
+      if (item->notify != NULL)
+        item->notify (item->data);
+      g_free (item);
+    }
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+g_invoke_source_finalize (GSource *source)
+{
+  GInvokeSource *invoke_source = (GInvokeSource *) source;
+  GInvokeItem *item, *next;
+
+  for (item = g_invoke_source_take (invoke_source); item != NULL; item = next)
+    {
+      next = item->next;
+
+      if (item->notify != NULL)
+        item->notify (item->data);
+      g_free (item);
+    }
+}
+
+static GSourceFuncs g_invoke_source_funcs =
+{
+  g_invoke_source_prepare,
+  g_invoke_source_check,
+  g_invoke_source_dispatch,
+  g_invoke_source_finalize,
+  NULL, NULL
+};
+
+static GInvokeSource *
+g_main_context_get_invoke_source (GMainContext *context)
+{
+  GSource *source;
+
+  source = g_atomic_pointer_get (&context->invoke_source);
+  if (G_LIKELY (source != NULL))
+    return (GInvokeSource *) source;
+
+  LOCK_CONTEXT (context);
+
+  if (context->invoke_source == NULL)
+    {
+      /* It has no callback, so the g_main_context_find_source_*() functions
+       * never return it */
+      source = g_source_new (&g_invoke_source_funcs, sizeof (GInvokeSource));
+      g_source_set_static_name (source, "GMainContextInvokeSource");
+      g_source_set_can_recurse (source, TRUE);
+      g_source_attach_unlocked (source, context, FALSE);
+      g_atomic_pointer_set (&context->invoke_source, source);
+    }
+
+  source = context->invoke_source;
+
+  UNLOCK_CONTEXT (context);
+
+  return (GInvokeSource *) source;
+}
+
 /**
  * g_main_context_invoke:
  * @context: (nullable): a #GMainContext, or %NULL for the global-default
@@ -6412,11 +7840,10 @@ g_idle_remove_by_data (gpointer data)
  * @function is called and g_main_context_release() is called
  * afterwards.
  *
- * In any other case, an idle source is created to call @function and
- * that source is attached to @context (presumably to be run in another
- * thread).  The idle source is attached with %G_PRIORITY_DEFAULT
- * priority.  If you want a different priority, use
- * g_main_context_invoke_full().
+ * In any other case, @function is queued to be called from @context
+ * (presumably to be run in another thread), as if by an idle source
+ * attached with %G_PRIORITY_DEFAULT priority.  If you want a different
+ * priority, use g_main_context_invoke_full().
  *
  * Note that, as with normal idle functions, @function should probably
  * return %FALSE.  If it returns %TRUE, it will be continuously run in a
@@ -6450,6 +7877,10 @@ g_main_context_invoke (GMainContext *context,
  * lets you specify the priority in case @function ends up being
  * scheduled as an idle and also lets you give a #GDestroyNotify for @data.
  *
+ * Invocations at %G_PRIORITY_DEFAULT share a single queue per @context,
+ * and are run in the order they were made. Other priorities use a
+ * separate idle source for each invocation.
+ *
  * @notify should not assume that it is called from any particular
  * thread or with any particular context acquired.
  *
@@ -6492,6 +7923,21 @@ g_main_context_invoke_full (GMainContext   *context,
           if (notify != NULL)
             notify (data);
         }
+      else if (priority == G_PRIORITY_DEFAULT)
+        {
+          GInvokeSource *invoke_source;
+          GInvokeItem *item;
+
+          invoke_source = g_main_context_get_invoke_source (context);
+
+          item = g_new (GInvokeItem, 1);
+          item->function = function;
+          item->data = data;
+          item->notify = notify;
+
+          if (g_invoke_source_push (invoke_source, item))
+            g_wakeup_signal (context->wakeup);
+        }
       else
         {
           GSource *source;
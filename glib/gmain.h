@@ -27,6 +27,7 @@
 #include <glib/gpoll.h>
 #include <glib/gslist.h>
 #include <glib/gthread.h>
+#include <glib/gvariant.h>
 
 G_BEGIN_DECLS
 
@@ -47,6 +48,13 @@ typedef enum /*< flags >*/
  * free the thread to process other jobs. That's useful if you're using
  * `g_main_context_{prepare,query,check,dispatch}` to integrate GMainContext in
  * other event loops.
+ * @G_MAIN_CONTEXT_FLAGS_KERNEL_POLLING: Keep the set of polled file
+ * descriptors registered with the kernel (using `epoll` on Linux) rather
+ * than rebuilding a #GPollFD array on every iteration, so that the cost of an
+ * iteration scales with the number of ready file descriptors. This is only a
+ * hint: it is ignored on platforms without a suitable kernel interface, and
+ * the normal poll() path is used for any iteration where a custom poll
+ * function has been set with g_main_context_set_poll_func(). Since: 2.82
  *
  * Flags to pass to g_main_context_new_with_flags() which affect the behaviour
  * of a #GMainContext.
@@ -57,7 +65,8 @@ GLIB_AVAILABLE_TYPE_IN_2_72
 typedef enum /*< flags >*/
 {
   G_MAIN_CONTEXT_FLAGS_NONE = 0,
-  G_MAIN_CONTEXT_FLAGS_OWNERLESS_POLLING = 1
+  G_MAIN_CONTEXT_FLAGS_OWNERLESS_POLLING = 1,
+  G_MAIN_CONTEXT_FLAGS_KERNEL_POLLING GLIB_AVAILABLE_ENUMERATOR_IN_2_82 = 2
 } GMainContextFlags;
 
 
@@ -411,6 +420,16 @@ gboolean      g_main_context_iteration (GMainContext *context,
 GLIB_AVAILABLE_IN_ALL
 gboolean      g_main_context_pending   (GMainContext *context);
 
+GLIB_AVAILABLE_IN_2_82
+void          g_main_context_set_dispatch_stats_enabled (GMainContext *context,
+                                                         gboolean      enabled);
+GLIB_AVAILABLE_IN_2_82
+GVariant     *g_main_context_get_dispatch_stats         (GMainContext *context);
+GLIB_AVAILABLE_IN_2_82
+void          g_main_context_get_child_watch_stats      (GMainContext *context,
+                                                         guint64      *n_reaped,
+                                                         guint        *max_reaped_per_iteration);
+
 /* For implementation of legacy interfaces
  */
 GLIB_AVAILABLE_IN_ALL
@@ -720,6 +739,8 @@ GLIB_AVAILABLE_IN_ALL
 GSource *g_timeout_source_new     (guint interval);
 GLIB_AVAILABLE_IN_ALL
 GSource *g_timeout_source_new_seconds (guint interval);
+GLIB_AVAILABLE_IN_2_82
+GSource *g_timeout_source_new_us  (guint64 interval);
 
 /* Miscellaneous functions
  */
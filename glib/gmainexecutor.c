@@ -0,0 +1,492 @@
+/* gmainexecutor.c: Pool of threads running main contexts
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gmainexecutor.h"
+
+#include "gmem.h"
+#include "gmessages.h"
+#include "gqueue.h"
+#include "gstrfuncs.h"
+#include "gthread.h"
+
+/**
+ * GMainExecutor:
+ *
+ * `GMainExecutor` runs a fixed number of threads, each iterating its own
+ * [struct@GLib.MainContext], so that work driven by main loops can use
+ * several cores without every caller sharding it by hand.
+ *
+ * Work is submitted with [method@GLib.MainExecutor.invoke]:
+ *
+ *  - Invocations with a non-%NULL key are always run by the thread which
+ *    the key hashes to, in the order they were submitted (for the same
+ *    priority). Use this for work which must not run concurrently with,
+ *    or out of order with respect to, other work on the same object.
+ *  - Invocations with a %NULL key may run on any thread. They are kept in
+ *    a queue shared by all the threads: an idle thread is woken up to run
+ *    them, and a thread which is busy picks them up as soon as it finishes
+ *    what it is doing, so a long dispatch on one thread does not hold up
+ *    the others.
+ *
+ * Sources can also be attached directly to the context of one of the
+ * threads, see [method@GLib.MainExecutor.get_context] and
+ * [method@GLib.MainExecutor.get_context_for_key]. Each context is the
+ * thread-default context of its thread, so asynchronous operations
+ * started from an invocation complete on the same thread.
+ *
+ * Since: 2.82
+ */
+
+typedef struct _GMainExecutorWorker GMainExecutorWorker;
+
+typedef struct
+{
+  GSourceFunc function;
+  gpointer data;
+  GDestroyNotify notify;
+  gint priority;
+} GMainExecutorJob;
+
+struct _GMainExecutorWorker
+{
+  GMainExecutor *executor;
+  GThread *thread;
+  GMainContext *context;
+  GMainLoop *loop;
+  GSource *shared_source;
+
+  /* Set (with executor->lock held) between the shared source finding the
+   * shared queue empty in prepare() and its next check(), i.e. while the
+   * thread may be blocked in poll(). */
+  gboolean idle;
+};
+
+struct _GMainExecutor
+{
+  guint n_workers;
+  GMainExecutorWorker *workers;
+
+  GMutex lock;
+  GQueue shared_jobs;  /* (element-type GMainExecutorJob) sorted by priority */
+};
+
+typedef struct
+{
+  GSource source;
+  GMainExecutorWorker *worker;
+} GMainExecutorSharedSource;
+
+static void
+main_executor_job_free (GMainExecutorJob *job)
+{
+  if (job->notify)
+    job->notify (job->data);
+  g_free (job);
+}
+
+static gboolean
+shared_source_prepare (GSource *source,
+                       gint    *timeout)
+{
+  GMainExecutorWorker *worker = ((GMainExecutorSharedSource *) source)->worker;
+  GMainExecutor *executor = worker->executor;
+  gboolean ready;
+
+  *timeout = -1;
+
+  g_mutex_lock (&executor->lock);
+  ready = !g_queue_is_empty (&executor->shared_jobs);
+  worker->idle = !ready;
+  g_mutex_unlock (&executor->lock);
+
+  return ready;
+}
+
+static gboolean
+shared_source_check (GSource *source)
+{
+  GMainExecutorWorker *worker = ((GMainExecutorSharedSource *) source)->worker;
+  GMainExecutor *executor = worker->executor;
+  gboolean ready;
+
+  g_mutex_lock (&executor->lock);
+  ready = !g_queue_is_empty (&executor->shared_jobs);
+  worker->idle = FALSE;
+  g_mutex_unlock (&executor->lock);
+
+  return ready;
+}
+
+/* HOLDS: executor->lock */
+static void
+shared_jobs_insert (GMainExecutor    *executor,
+                    GMainExecutorJob *job)
+{
+  GList *l;
+
+  /* Keep FIFO order among jobs of the same priority. Most jobs have the
+   * same priority, so search from the tail. */
+  for (l = executor->shared_jobs.tail; l != NULL; l = l->prev)
+    {
+      GMainExecutorJob *other = l->data;
+
+      if (other->priority <= job->priority)
+        break;
+    }
+
+  if (l != NULL)
+    g_queue_insert_after (&executor->shared_jobs, l, job);
+  else
+    g_queue_push_head (&executor->shared_jobs, job);
+}
+
+static gboolean
+shared_source_dispatch (GSource     *source,
+                        GSourceFunc  callback,
+                        gpointer     user_data)
+{
+  GMainExecutorWorker *worker = ((GMainExecutorSharedSource *) source)->worker;
+  GMainExecutor *executor = worker->executor;
+  GMainExecutorJob *job;
+
+  /* Only run one job per dispatch, so that the other sources of this
+   * context are not starved; the next prepare() sees any remaining ones. */
+  g_mutex_lock (&executor->lock);
+  job = g_queue_pop_head (&executor->shared_jobs);
+  g_mutex_unlock (&executor->lock);
+
+  if (job == NULL)
+    return G_SOURCE_CONTINUE;
+
+  if (job->function (job->data))
+    {
+      g_mutex_lock (&executor->lock);
+      shared_jobs_insert (executor, job);
+      g_mutex_unlock (&executor->lock);
+    }
+  else
+    main_executor_job_free (job);
+
+  return G_SOURCE_CONTINUE;
+}
+
+static GSourceFuncs shared_source_funcs =
+{
+  shared_source_prepare,
+  shared_source_check,
+  shared_source_dispatch,
+  NULL, NULL, NULL
+};
+
+static gpointer
+main_executor_worker_thread (gpointer data)
+{
+  GMainExecutorWorker *worker = data;
+
+  g_main_context_push_thread_default (worker->context);
+  g_main_loop_run (worker->loop);
+  g_main_context_pop_thread_default (worker->context);
+
+  return NULL;
+}
+
+/**
+ * g_main_executor_new:
+ * @n_threads: the number of threads to run, or 0 to use one per
+ *   processor
+ *
+ * Creates a new #GMainExecutor and starts its threads.
+ *
+ * Returns: (transfer full): a new #GMainExecutor, free it with
+ *   g_main_executor_free()
+ *
+ * Since: 2.82
+ */
+GMainExecutor *
+g_main_executor_new (guint n_threads)
+{
+  GMainExecutor *executor;
+  guint i;
+
+  if (n_threads == 0)
+    n_threads = MAX (g_get_num_processors (), 1);
+
+  executor = g_new0 (GMainExecutor, 1);
+  executor->n_workers = n_threads;
+  executor->workers = g_new0 (GMainExecutorWorker, n_threads);
+  g_mutex_init (&executor->lock);
+  g_queue_init (&executor->shared_jobs);
+
+  for (i = 0; i < n_threads; i++)
+    {
+      GMainExecutorWorker *worker = &executor->workers[i];
+      gchar *name;
+
+      worker->executor = executor;
+      worker->context = g_main_context_new ();
+      worker->loop = g_main_loop_new (worker->context, FALSE);
+
+      worker->shared_source = g_source_new (&shared_source_funcs,
+                                            sizeof (GMainExecutorSharedSource));
+      ((GMainExecutorSharedSource *) worker->shared_source)->worker = worker;
+      g_source_set_static_name (worker->shared_source, "GMainExecutor shared jobs");
+      g_source_attach (worker->shared_source, worker->context);
+
+      name = g_strdup_printf ("gexecutor-%u", i);
+      worker->thread = g_thread_new (name, main_executor_worker_thread, worker);
+      g_free (name);
+    }
+
+  return executor;
+}
+
+static gboolean
+quit_worker_cb (gpointer data)
+{
+  GMainExecutorWorker *worker = data;
+
+  g_main_loop_quit (worker->loop);
+
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * g_main_executor_free:
+ * @executor: (transfer full): a #GMainExecutor
+ *
+ * Stops the threads of @executor, waits for them to exit and frees
+ * @executor.
+ *
+ * Invocations which are currently running are finished first. Those
+ * which have not started yet are not run, but their @notify functions
+ * are called. Sources attached to the contexts of the executor are
+ * destroyed along with the contexts.
+ *
+ * This must not be called from one of the threads of @executor.
+ *
+ * Since: 2.82
+ */
+void
+g_main_executor_free (GMainExecutor *executor)
+{
+  guint i;
+
+  g_return_if_fail (executor != NULL);
+
+  for (i = 0; i < executor->n_workers; i++)
+    g_return_if_fail (executor->workers[i].thread != g_thread_self ());
+
+  /* Quit from within each loop: g_main_loop_quit() would be lost if it
+   * were called before the thread got to g_main_loop_run(). An explicit
+   * source rather than g_main_context_invoke(), which could run the
+   * callback on this thread if the worker has not acquired its context
+   * yet. */
+  for (i = 0; i < executor->n_workers; i++)
+    {
+      GMainExecutorWorker *worker = &executor->workers[i];
+      GSource *source;
+
+      source = g_idle_source_new ();
+      g_source_set_priority (source, G_PRIORITY_HIGH - 1);
+      g_source_set_callback (source, quit_worker_cb, worker, NULL);
+      g_source_set_static_name (source, "[glib] g_main_executor_free");
+      g_source_attach (source, worker->context);
+      g_source_unref (source);
+    }
+
+  for (i = 0; i < executor->n_workers; i++)
+    {
+      GMainExecutorWorker *worker = &executor->workers[i];
+
+      g_thread_join (worker->thread);
+
+      g_source_destroy (worker->shared_source);
+      g_source_unref (worker->shared_source);
+      g_main_loop_unref (worker->loop);
+      g_main_context_unref (worker->context);
+    }
+
+  g_queue_clear_full (&executor->shared_jobs, (GDestroyNotify) main_executor_job_free);
+  g_mutex_clear (&executor->lock);
+  g_free (executor->workers);
+  g_free (executor);
+}
+
+/**
+ * g_main_executor_get_n_threads:
+ * @executor: a #GMainExecutor
+ *
+ * Gets the number of threads which @executor runs.
+ *
+ * Returns: the number of threads
+ *
+ * Since: 2.82
+ */
+guint
+g_main_executor_get_n_threads (GMainExecutor *executor)
+{
+  g_return_val_if_fail (executor != NULL, 0);
+
+  return executor->n_workers;
+}
+
+/**
+ * g_main_executor_get_context:
+ * @executor: a #GMainExecutor
+ * @index_: the index of a thread of @executor, less than
+ *   g_main_executor_get_n_threads()
+ *
+ * Gets the #GMainContext iterated by the thread number @index_ of
+ * @executor, to attach sources to it.
+ *
+ * Returns: (transfer none): the context of the thread
+ *
+ * Since: 2.82
+ */
+GMainContext *
+g_main_executor_get_context (GMainExecutor *executor,
+                             guint          index_)
+{
+  g_return_val_if_fail (executor != NULL, NULL);
+  g_return_val_if_fail (index_ < executor->n_workers, NULL);
+
+  return executor->workers[index_].context;
+}
+
+static GMainExecutorWorker *
+main_executor_worker_for_key (GMainExecutor *executor,
+                              gconstpointer  key)
+{
+  guint64 hash;
+
+  /* Pointers and small integers have few significant low bits, so mix
+   * them before reducing to the number of threads */
+  hash = (guint64) GPOINTER_TO_SIZE (key) * G_GUINT64_CONSTANT (0x9e3779b97f4a7c15);
+
+  return &executor->workers[(hash >> 32) % executor->n_workers];
+}
+
+/**
+ * g_main_executor_get_context_for_key:
+ * @executor: a #GMainExecutor
+ * @key: (not nullable): a key, as passed to g_main_executor_invoke()
+ *
+ * Gets the #GMainContext of the thread which runs the invocations of
+ * @executor with the key @key.
+ *
+ * Returns: (transfer none): the context of the thread
+ *
+ * Since: 2.82
+ */
+GMainContext *
+g_main_executor_get_context_for_key (GMainExecutor *executor,
+                                     gconstpointer  key)
+{
+  g_return_val_if_fail (executor != NULL, NULL);
+  g_return_val_if_fail (key != NULL, NULL);
+
+  return main_executor_worker_for_key (executor, key)->context;
+}
+
+/**
+ * g_main_executor_invoke:
+ * @executor: a #GMainExecutor
+ * @key: (nullable): a key to order invocations by, or %NULL
+ * @priority: the priority at which to run @function
+ * @function: function to call
+ * @data: data to pass to @function
+ * @notify: (nullable): a function to call when @data is no longer in use,
+ *   or %NULL
+ *
+ * Runs @function on one of the threads of @executor, as if by an idle
+ * source: it is called again as long as it returns %G_SOURCE_CONTINUE.
+ *
+ * If @key is not %NULL, @function is run by the thread which @key hashes
+ * to, after any invocation made earlier with the same key and priority.
+ * Keys are compared by pointer value: to use a string, pass a pointer to
+ * an interned string or its hash with GUINT_TO_POINTER().
+ *
+ * If @key is %NULL, @function is run by whichever thread becomes free
+ * first. @priority then only orders it among the other invocations with a
+ * %NULL key; they are dispatched at %G_PRIORITY_DEFAULT relative to the
+ * sources of each thread's context.
+ *
+ * This function is thread-safe, and may be called from one of the
+ * threads of @executor.
+ *
+ * Since: 2.82
+ */
+void
+g_main_executor_invoke (GMainExecutor  *executor,
+                        gconstpointer   key,
+                        gint            priority,
+                        GSourceFunc     function,
+                        gpointer        data,
+                        GDestroyNotify  notify)
+{
+  GMainExecutorJob *job;
+  GMainExecutorWorker *wake = NULL;
+  guint i;
+
+  g_return_if_fail (executor != NULL);
+  g_return_if_fail (function != NULL);
+
+  if (key != NULL)
+    {
+      GMainExecutorWorker *worker = main_executor_worker_for_key (executor, key);
+      GSource *source;
+
+      /* Not g_main_context_invoke_full(), which would run @function right
+       * away when called from the worker, ahead of earlier invocations */
+      source = g_idle_source_new ();
+      g_source_set_priority (source, priority);
+      g_source_set_callback (source, function, data, notify);
+      g_source_set_static_name (source, "[glib] g_main_executor_invoke");
+      g_source_attach (source, worker->context);
+      g_source_unref (source);
+
+      return;
+    }
+
+  job = g_new (GMainExecutorJob, 1);
+  job->function = function;
+  job->data = data;
+  job->notify = notify;
+  job->priority = priority;
+
+  g_mutex_lock (&executor->lock);
+  shared_jobs_insert (executor, job);
+
+  /* Wake up one idle thread. If none is idle, a busy one will pick the
+   * job up when it next prepares its context. */
+  for (i = 0; i < executor->n_workers; i++)
+    {
+      if (executor->workers[i].idle)
+        {
+          wake = &executor->workers[i];
+          wake->idle = FALSE;
+          break;
+        }
+    }
+  g_mutex_unlock (&executor->lock);
+
+  if (wake != NULL)
+    g_main_context_wakeup (wake->context);
+}
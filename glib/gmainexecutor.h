@@ -0,0 +1,53 @@
+/* gmainexecutor.h: Pool of threads running main contexts
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#if !defined (__GLIB_H_INSIDE__) && !defined (GLIB_COMPILATION)
+#error "Only <glib.h> can be included directly."
+#endif
+
+#include <glib/gmain.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GMainExecutor GMainExecutor;
+
+GLIB_AVAILABLE_IN_2_82
+GMainExecutor *g_main_executor_new           (guint           n_threads);
+GLIB_AVAILABLE_IN_2_82
+void           g_main_executor_free          (GMainExecutor  *executor);
+
+GLIB_AVAILABLE_IN_2_82
+guint          g_main_executor_get_n_threads (GMainExecutor  *executor);
+GLIB_AVAILABLE_IN_2_82
+GMainContext * g_main_executor_get_context   (GMainExecutor  *executor,
+                                              guint           index_);
+GLIB_AVAILABLE_IN_2_82
+GMainContext * g_main_executor_get_context_for_key (GMainExecutor *executor,
+                                                    gconstpointer  key);
+
+GLIB_AVAILABLE_IN_2_82
+void           g_main_executor_invoke        (GMainExecutor  *executor,
+                                              gconstpointer   key,
+                                              gint            priority,
+                                              GSourceFunc     function,
+                                              gpointer        data,
+                                              GDestroyNotify  notify);
+
+G_END_DECLS
@@ -112,13 +112,15 @@ g_mapped_file_destroy (GMappedFile *file)
 }
 
 static GMappedFile*
-mapped_file_new_from_fd (int           fd,
-			 gboolean      writable,
-                         const gchar  *filename,
-                         GError      **error)
+mapped_file_new_from_fd (int               fd,
+                         GMappedFileFlags  flags,
+                         const gchar      *filename,
+                         GError          **error)
 {
   GMappedFile *file;
   struct stat st;
+  gboolean writable = (flags & G_MAPPED_FILE_FLAGS_WRITABLE) != 0;
+  int map_flags = MAP_PRIVATE;
 
   file = g_slice_new0 (GMappedFile);
   file->ref_count = 1;
@@ -156,6 +158,11 @@ mapped_file_new_from_fd (int           fd,
   file->contents = MAP_FAILED;
 
 #ifdef HAVE_MMAP
+#ifdef MAP_POPULATE
+  if (flags & G_MAPPED_FILE_FLAGS_POPULATE)
+    map_flags |= MAP_POPULATE;
+#endif
+
   if (sizeof (st.st_size) > sizeof (gsize) && st.st_size > (off_t) G_MAXSIZE)
     {
       errno = EINVAL;
@@ -165,8 +172,10 @@ mapped_file_new_from_fd (int           fd,
       file->length = (gsize) st.st_size;
       file->contents = (gchar *) mmap (NULL,  file->length,
 				       writable ? PROT_READ|PROT_WRITE : PROT_READ,
-				       MAP_PRIVATE, fd, 0);
+				       map_flags, fd, 0);
     }
+#else
+  (void) map_flags;
 #endif
 #ifdef G_OS_WIN32
   file->length = st.st_size;
@@ -249,6 +258,38 @@ GMappedFile *
 g_mapped_file_new (const gchar  *filename,
 		   gboolean      writable,
 		   GError      **error)
+{
+  g_return_val_if_fail (filename != NULL, NULL);
+  g_return_val_if_fail (!error || *error == NULL, NULL);
+
+  return g_mapped_file_new_with_flags (filename,
+                                       writable ? G_MAPPED_FILE_FLAGS_WRITABLE : G_MAPPED_FILE_FLAGS_NONE,
+                                       error);
+}
+
+/**
+ * g_mapped_file_new_with_flags:
+ * @filename: (type filename): The path of the file to load, in the GLib
+ *     filename encoding
+ * @flags: flags affecting the mapping
+ * @error: return location for a #GError, or %NULL
+ *
+ * Maps a file into memory, like g_mapped_file_new().
+ *
+ * Pass %G_MAPPED_FILE_FLAGS_POPULATE to read the whole file in up front,
+ * so that latency-sensitive code accessing the mapping later doesn’t stall
+ * on page faults. To start reading it in without waiting, use
+ * g_mapped_file_advise() with %G_MAPPED_FILE_ADVICE_WILLNEED instead.
+ *
+ * Returns: a newly allocated #GMappedFile which must be unref'd
+ *    with g_mapped_file_unref(), or %NULL if the mapping failed.
+ *
+ * Since: 2.82
+ */
+GMappedFile *
+g_mapped_file_new_with_flags (const gchar       *filename,
+                              GMappedFileFlags   flags,
+                              GError           **error)
 {
   GMappedFile *file;
   int fd;
@@ -256,7 +297,9 @@ g_mapped_file_new (const gchar  *filename,
   g_return_val_if_fail (filename != NULL, NULL);
   g_return_val_if_fail (!error || *error == NULL, NULL);
 
-  fd = g_open (filename, (writable ? O_RDWR : O_RDONLY) | _O_BINARY | O_CLOEXEC, 0);
+  fd = g_open (filename,
+               ((flags & G_MAPPED_FILE_FLAGS_WRITABLE) ? O_RDWR : O_RDONLY) | _O_BINARY | O_CLOEXEC,
+               0);
   if (fd == -1)
     {
       int save_errno = errno;
@@ -272,7 +315,7 @@ g_mapped_file_new (const gchar  *filename,
       return NULL;
     }
 
-  file = mapped_file_new_from_fd (fd, writable, filename, error);
+  file = mapped_file_new_from_fd (fd, flags, filename, error);
 
   close (fd);
 
@@ -308,7 +351,9 @@ g_mapped_file_new_from_fd (gint          fd,
 			   gboolean      writable,
 			   GError      **error)
 {
-  return mapped_file_new_from_fd (fd, writable, NULL, error);
+  return mapped_file_new_from_fd (fd,
+                                  writable ? G_MAPPED_FILE_FLAGS_WRITABLE : G_MAPPED_FILE_FLAGS_NONE,
+                                  NULL, error);
 }
 
 /**
@@ -368,6 +413,99 @@ g_mapped_file_free (GMappedFile *file)
   g_mapped_file_unref (file);
 }
 
+/* Applies madvise() @advice to the pages covering @length bytes at @offset */
+static void
+mapped_file_madvise (GMappedFile *file,
+                     gsize        offset,
+                     gsize        length,
+                     int          advice)
+{
+#if defined(HAVE_MMAP) && defined(HAVE_MADVISE)
+  static gsize page_size = 0;
+  gsize start, end;
+
+  if (page_size == 0)
+    page_size = sysconf (_SC_PAGESIZE);
+
+  /* The mapping itself starts on a page boundary */
+  start = offset & ~(page_size - 1);
+  end = offset + length;
+
+  /* This is only advice, so errors are ignored */
+  madvise (file->contents + start, end - start, advice);
+#endif
+}
+
+/**
+ * g_mapped_file_advise:
+ * @file: a #GMappedFile
+ * @advice: how the mapping is going to be accessed
+ *
+ * Tells the system how the contents of @file are going to be accessed, so
+ * that it can read them in more efficiently. For example, pass
+ * %G_MAPPED_FILE_ADVICE_SEQUENTIAL | %G_MAPPED_FILE_ADVICE_WILLNEED before
+ * scanning through a large file.
+ *
+ * This is only a hint, and is ignored where it isn’t supported.
+ *
+ * Since: 2.82
+ */
+void
+g_mapped_file_advise (GMappedFile       *file,
+                      GMappedFileAdvice  advice)
+{
+  g_return_if_fail (file != NULL);
+  g_return_if_fail ((advice & (G_MAPPED_FILE_ADVICE_SEQUENTIAL | G_MAPPED_FILE_ADVICE_RANDOM)) !=
+                    (G_MAPPED_FILE_ADVICE_SEQUENTIAL | G_MAPPED_FILE_ADVICE_RANDOM));
+
+  if (file->length == 0)
+    return;
+
+#if defined(HAVE_MMAP) && defined(HAVE_MADVISE)
+  if (advice & G_MAPPED_FILE_ADVICE_SEQUENTIAL)
+    mapped_file_madvise (file, 0, file->length, MADV_SEQUENTIAL);
+  if (advice & G_MAPPED_FILE_ADVICE_RANDOM)
+    mapped_file_madvise (file, 0, file->length, MADV_RANDOM);
+#ifdef MADV_HUGEPAGE
+  if (advice & G_MAPPED_FILE_ADVICE_HUGEPAGE)
+    mapped_file_madvise (file, 0, file->length, MADV_HUGEPAGE);
+#endif
+  if (advice & G_MAPPED_FILE_ADVICE_WILLNEED)
+    mapped_file_madvise (file, 0, file->length, MADV_WILLNEED);
+#endif
+}
+
+/**
+ * g_mapped_file_prefetch_range:
+ * @file: a #GMappedFile
+ * @offset: offset of the range, in bytes
+ * @length: length of the range, in bytes
+ *
+ * Starts reading in the given range of @file in the background, so that
+ * accessing it later is less likely to stall on page faults. This returns
+ * straight away, without waiting for the data.
+ *
+ * The range must be within the mapping. This is only a hint, and is
+ * ignored where it isn’t supported.
+ *
+ * Since: 2.82
+ */
+void
+g_mapped_file_prefetch_range (GMappedFile *file,
+                              gsize        offset,
+                              gsize        length)
+{
+  g_return_if_fail (file != NULL);
+  g_return_if_fail (offset <= file->length && length <= file->length - offset);
+
+  if (length == 0)
+    return;
+
+#if defined(HAVE_MMAP) && defined(HAVE_MADVISE)
+  mapped_file_madvise (file, offset, length, MADV_WILLNEED);
+#endif
+}
+
 /**
  * g_mapped_file_ref:
  * @file: a #GMappedFile
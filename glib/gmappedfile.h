@@ -33,6 +33,56 @@ G_BEGIN_DECLS
 
 typedef struct _GMappedFile GMappedFile;
 
+/**
+ * GMappedFileFlags:
+ * @G_MAPPED_FILE_FLAGS_NONE: No flags, a read-only mapping.
+ * @G_MAPPED_FILE_FLAGS_WRITABLE: The mapping is writable, see
+ *   g_mapped_file_new().
+ * @G_MAPPED_FILE_FLAGS_POPULATE: Read the whole file in while mapping it,
+ *   so that accessing it later doesn’t fault. Ignored where this isn’t
+ *   supported.
+ *
+ * Flags to pass to g_mapped_file_new_with_flags().
+ *
+ * Since: 2.82
+ */
+GLIB_AVAILABLE_TYPE_IN_2_82
+typedef enum /*< flags >*/
+{
+  G_MAPPED_FILE_FLAGS_NONE = 0,
+  G_MAPPED_FILE_FLAGS_WRITABLE = 1 << 0,
+  G_MAPPED_FILE_FLAGS_POPULATE = 1 << 1
+} GMappedFileFlags;
+
+/**
+ * GMappedFileAdvice:
+ * @G_MAPPED_FILE_ADVICE_NONE: No particular access pattern.
+ * @G_MAPPED_FILE_ADVICE_SEQUENTIAL: The mapping will be read in order, so
+ *   it is worth reading ahead aggressively.
+ * @G_MAPPED_FILE_ADVICE_RANDOM: The mapping will be read in no particular
+ *   order, so reading ahead is not worth it. Must not be combined with
+ *   %G_MAPPED_FILE_ADVICE_SEQUENTIAL.
+ * @G_MAPPED_FILE_ADVICE_WILLNEED: The mapping will be needed soon, so
+ *   start reading it in now, without waiting for it.
+ * @G_MAPPED_FILE_ADVICE_HUGEPAGE: Back the mapping with huge pages where
+ *   the kernel and file system support it.
+ *
+ * Hints passed to g_mapped_file_advise() about how a mapping will be
+ * accessed. They only affect performance, never the contents of the
+ * mapping, and are ignored where the platform doesn’t support them.
+ *
+ * Since: 2.82
+ */
+GLIB_AVAILABLE_TYPE_IN_2_82
+typedef enum /*< flags >*/
+{
+  G_MAPPED_FILE_ADVICE_NONE = 0,
+  G_MAPPED_FILE_ADVICE_SEQUENTIAL = 1 << 0,
+  G_MAPPED_FILE_ADVICE_RANDOM = 1 << 1,
+  G_MAPPED_FILE_ADVICE_WILLNEED = 1 << 2,
+  G_MAPPED_FILE_ADVICE_HUGEPAGE = 1 << 3
+} GMappedFileAdvice;
+
 GLIB_AVAILABLE_IN_ALL
 GMappedFile *g_mapped_file_new          (const gchar  *filename,
 				         gboolean      writable,
@@ -41,12 +91,23 @@ GLIB_AVAILABLE_IN_ALL
 GMappedFile *g_mapped_file_new_from_fd  (gint          fd,
 					 gboolean      writable,
 					 GError      **error);
+GLIB_AVAILABLE_IN_2_82
+GMappedFile *g_mapped_file_new_with_flags (const gchar      *filename,
+                                           GMappedFileFlags  flags,
+                                           GError          **error);
 GLIB_AVAILABLE_IN_ALL
 gsize        g_mapped_file_get_length   (GMappedFile  *file);
 GLIB_AVAILABLE_IN_ALL
 gchar       *g_mapped_file_get_contents (GMappedFile  *file);
 GLIB_AVAILABLE_IN_2_34
 GBytes *     g_mapped_file_get_bytes    (GMappedFile  *file);
+GLIB_AVAILABLE_IN_2_82
+void         g_mapped_file_advise         (GMappedFile       *file,
+                                           GMappedFileAdvice  advice);
+GLIB_AVAILABLE_IN_2_82
+void         g_mapped_file_prefetch_range (GMappedFile       *file,
+                                           gsize              offset,
+                                           gsize              length);
 GLIB_AVAILABLE_IN_ALL
 GMappedFile *g_mapped_file_ref          (GMappedFile  *file);
 GLIB_AVAILABLE_IN_ALL
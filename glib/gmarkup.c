@@ -495,6 +495,31 @@ text_validate (GMarkupParseContext  *context,
     return TRUE;
 }
 
+/*
+ * Checks whether unescaping the text between @start and @end would leave
+ * it unchanged: no entities, no carriage returns to normalise, and no nul
+ * byte (which unescaping would truncate at).
+ */
+static gboolean
+text_is_plain (const gchar *start,
+               const gchar *end,
+               gboolean    *is_ascii)
+{
+  const gchar *p;
+  char mask = 0;
+
+  for (p = start; p != end; p++)
+    {
+      if (*p == '&' || *p == '\r' || *p == '\0')
+        return FALSE;
+      mask |= *p;
+    }
+
+  *is_ascii = !(mask & 0x80);
+
+  return TRUE;
+}
+
 static gchar*
 char_str (gunichar c,
           gchar   *buf)
@@ -1084,6 +1109,8 @@ g_markup_parse_context_parse (GMarkupParseContext  *context,
                               gssize                text_len,
                               GError              **error)
 {
+  gboolean is_plain_ascii;
+
   g_return_val_if_fail (context != NULL, FALSE);
   g_return_val_if_fail (text != NULL, FALSE);
   g_return_val_if_fail (context->state != STATE_ERROR, FALSE);
@@ -1472,6 +1499,41 @@ g_markup_parse_context_parse (GMarkupParseContext  *context,
             }
           while (advance_char (context));
 
+          if (context->iter != context->current_text_end &&
+              (context->partial_chunk == NULL || context->partial_chunk->len == 0) &&
+              text_is_plain (context->start, context->iter, &is_plain_ascii))
+            {
+              /* The whole text is in this chunk and there is nothing to
+               * unescape, so pass it to the text callback where it is,
+               * rather than copying it to the partial chunk.
+               */
+              if (is_plain_ascii || text_validate (context, context->start,
+                                                   context->iter - context->start, error))
+                {
+                  GError *tmp_error = NULL;
+
+                  if (context->parser->text)
+                    (*context->parser->text) (context,
+                                              context->start,
+                                              context->iter - context->start,
+                                              context->user_data,
+                                              &tmp_error);
+
+                  if (tmp_error == NULL)
+                    {
+                      /* advance past open angle and set state. */
+                      advance_char (context);
+                      context->state = STATE_AFTER_OPEN_ANGLE;
+                      /* could begin a passthrough */
+                      context->start = context->iter;
+                    }
+                  else
+                    propagate_error (context, error, tmp_error);
+                }
+
+              break;
+            }
+
           /* The text hasn't necessarily ended. Merge with
            * partial chunk, leave state unchanged.
            */
@@ -55,11 +55,17 @@
 #include <string.h>
 #include <signal.h>
 
+#ifdef HAVE_MADVISE
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include "gslice.h"
 #include "gbacktrace.h"
 #include "gtestutils.h"
 #include "gthread.h"
 #include "glib_trace.h"
+#include "gutilsprivate.h"
 
 /* notes on macros:
  * having G_DISABLE_CHECKS defined disables use of glib_mem_profiler_table and
@@ -765,3 +771,335 @@ g_aligned_free_sized (void   *mem,
   aligned_free (mem);
 #endif
 }
+
+/* Buffers at least this big are backed by transparent huge pages where the
+ * kernel supports it, which cuts TLB misses and page faults when large
+ * arrays and strings are filled. */
+#define G_MEM_LARGE_THRESHOLD (4 * 1024 * 1024)
+
+/*
+ * g_mem_advise_large:
+ * @mem: memory returned by g_malloc() or g_realloc()
+ * @size: size of @mem, in bytes
+ *
+ * Tells the kernel that @mem is a large, long-lived buffer which is going to
+ * be filled sequentially. This is only a hint: it does nothing for buffers
+ * smaller than %G_MEM_LARGE_THRESHOLD or where madvise() isn’t available,
+ * and errors are ignored.
+ *
+ * The memory stays owned by the allocator and must still be freed with
+ * g_free().
+ */
+void
+g_mem_advise_large (gpointer mem,
+                    gsize    size)
+{
+#if defined(HAVE_MADVISE) && defined(MADV_HUGEPAGE)
+  static gsize page_size = 0;
+  guintptr start, end;
+
+  if (size < G_MEM_LARGE_THRESHOLD || mem == NULL)
+    return;
+
+  if (page_size == 0)
+    page_size = sysconf (_SC_PAGESIZE);
+
+  /* Only whole pages inside the buffer can be advised */
+  start = ((guintptr) mem + page_size - 1) & ~(guintptr) (page_size - 1);
+  end = ((guintptr) mem + size) & ~(guintptr) (page_size - 1);
+
+  if (end > start)
+    madvise ((void *) start, end - start, MADV_HUGEPAGE);
+#else
+  (void) mem;
+  (void) size;
+#endif
+}
+
+/* Registry of trimmable caches, kept sorted by priority, then by
+ * registration order (which is also the order of the identifiers).
+ *
+ * mem_caches_lock only protects the list, and is never held while calling
+ * out, so that caches can be registered from anywhere. Trimming marks the
+ * cache whose callback is running, and g_mem_cache_unregister() waits for
+ * that callback to return, so that the cache’s callbacks are never running
+ * once it has been unregistered. mem_caches_trim_lock serialises the walks
+ * over the list. */
+typedef struct
+{
+  guint id;
+  guint priority;
+  gchar *name;
+  GMemCacheTrimFunc trim_func;
+  GMemCacheSizeFunc size_func;
+  gpointer user_data;
+} MemCache;
+
+static GMutex mem_caches_lock;
+static GCond mem_caches_cond;
+static MemCache *mem_caches = NULL;
+static guint n_mem_caches = 0;
+static guint n_mem_caches_allocated = 0;
+static guint mem_caches_next_id = 1;
+static guint mem_caches_running_id = 0;
+static GThread *mem_caches_running_thread = NULL;
+
+static GMutex mem_caches_trim_lock;
+
+/* Returns the index of the first cache after @priority and @id; must be
+ * called with mem_caches_lock held */
+static guint
+mem_cache_find_next (guint priority,
+                     guint id)
+{
+  guint i;
+
+  for (i = 0; i < n_mem_caches; i++)
+    if (mem_caches[i].priority > priority ||
+        (mem_caches[i].priority == priority && mem_caches[i].id > id))
+      break;
+
+  return i;
+}
+
+/* Marks @cache as running, for g_mem_cache_unregister() to wait on; must be
+ * called with mem_caches_lock held, which it drops until the callback is
+ * done. Returns @cache’s trimmed bytes, or its size if @level is -1. */
+static gsize
+mem_cache_call (const MemCache *cache,
+                gint            level)
+{
+  gsize result = 0;
+
+  mem_caches_running_id = cache->id;
+  mem_caches_running_thread = g_thread_self ();
+  g_mutex_unlock (&mem_caches_lock);
+
+  if (level >= 0)
+    result = cache->trim_func (level, cache->user_data);
+  else if (cache->size_func != NULL)
+    result = cache->size_func (cache->user_data);
+
+  g_mutex_lock (&mem_caches_lock);
+  mem_caches_running_id = 0;
+  mem_caches_running_thread = NULL;
+  g_cond_broadcast (&mem_caches_cond);
+
+  return result;
+}
+
+/**
+ * g_mem_cache_register:
+ * @name: a name for the cache, shown by g_mem_cache_foreach()
+ * @priority: the lowest memory pressure level at which the cache is trimmed,
+ *   from 0 to 255
+ * @trim_func: (scope forever) (closure user_data): function to free memory
+ *   held by the cache
+ * @size_func: (nullable) (scope forever) (closure user_data): function to
+ *   estimate the size of the cache, or %NULL
+ * @user_data: data to pass to @trim_func and @size_func
+ *
+ * Registers a cache which can give memory back when the system runs low on
+ * it. g_mem_cache_trim() calls @trim_func for each registered cache whose
+ * @priority is at most the pressure level, in order of increasing
+ * @priority. In GIO, the default handler of the `low-memory-warning` signal
+ * of `GMemoryMonitor` calls g_mem_cache_trim() with the warning level, so
+ * the levels are those of `GMemoryMonitorWarningLevel`: caches which are
+ * cheap to fill again should use a low @priority, such as 50, and expensive
+ * ones a higher one, up to 255.
+ *
+ * @trim_func and @size_func may be called from any thread, and must do
+ * their own locking. They are never called concurrently, nor after
+ * g_mem_cache_unregister() returns, so @user_data may be freed then. As
+ * g_mem_cache_unregister() waits for them to return, it must not be called
+ * while holding a lock which they take. They may register and unregister
+ * caches, but must not call g_mem_cache_trim() or g_mem_cache_foreach().
+ *
+ * Returns: an identifier for the registration, to pass to
+ *   g_mem_cache_unregister(); never 0
+ *
+ * Since: 2.82
+ */
+guint
+g_mem_cache_register (const gchar       *name,
+                      guint              priority,
+                      GMemCacheTrimFunc  trim_func,
+                      GMemCacheSizeFunc  size_func,
+                      gpointer           user_data)
+{
+  MemCache *cache;
+  guint i;
+  guint id;
+
+  g_return_val_if_fail (name != NULL, 0);
+  g_return_val_if_fail (priority <= 255, 0);
+  g_return_val_if_fail (trim_func != NULL, 0);
+
+  g_mutex_lock (&mem_caches_lock);
+
+  if (n_mem_caches == n_mem_caches_allocated)
+    {
+      n_mem_caches_allocated = MAX (8, n_mem_caches_allocated * 2);
+      mem_caches = g_renew (MemCache, mem_caches, n_mem_caches_allocated);
+    }
+
+  /* Insert after all caches of the same priority */
+  for (i = n_mem_caches; i > 0 && mem_caches[i - 1].priority > priority; i--)
+    mem_caches[i] = mem_caches[i - 1];
+
+  id = mem_caches_next_id++;
+
+  cache = &mem_caches[i];
+  cache->id = id;
+  cache->priority = priority;
+  cache->name = g_strdup (name);
+  cache->trim_func = trim_func;
+  cache->size_func = size_func;
+  cache->user_data = user_data;
+  n_mem_caches++;
+
+  g_mutex_unlock (&mem_caches_lock);
+
+  return id;
+}
+
+/**
+ * g_mem_cache_unregister:
+ * @cache_id: an identifier returned by g_mem_cache_register()
+ *
+ * Removes a cache registered with g_mem_cache_register().
+ *
+ * If another thread is calling one of the cache’s callbacks, this waits
+ * for it to return, so that they are guaranteed not to be running when
+ * this returns.
+ *
+ * Since: 2.82
+ */
+void
+g_mem_cache_unregister (guint cache_id)
+{
+  gboolean found = FALSE;
+  guint i;
+
+  g_return_if_fail (cache_id != 0);
+
+  g_mutex_lock (&mem_caches_lock);
+
+  for (i = 0; i < n_mem_caches; i++)
+    {
+      if (mem_caches[i].id == cache_id)
+        {
+          g_free (mem_caches[i].name);
+          memmove (&mem_caches[i], &mem_caches[i + 1],
+                   (n_mem_caches - i - 1) * sizeof (MemCache));
+          n_mem_caches--;
+          found = TRUE;
+          break;
+        }
+    }
+
+  /* A cache may unregister itself from its own callback */
+  while (mem_caches_running_id == cache_id &&
+         mem_caches_running_thread != g_thread_self ())
+    g_cond_wait (&mem_caches_cond, &mem_caches_lock);
+
+  g_mutex_unlock (&mem_caches_lock);
+
+  if (!found)
+    g_critical ("%s: no cache with id %u", G_STRFUNC, cache_id);
+}
+
+/**
+ * g_mem_cache_trim:
+ * @level: the memory pressure level, from 0 to 255
+ *
+ * Trims the caches registered with g_mem_cache_register() whose priority is
+ * at most @level, in order of increasing priority.
+ *
+ * Returns: an estimate of the number of bytes freed
+ *
+ * Since: 2.82
+ */
+gsize
+g_mem_cache_trim (guint level)
+{
+  gsize freed = 0;
+  guint i;
+
+  g_return_val_if_fail (level <= 255, 0);
+
+  g_mutex_lock (&mem_caches_trim_lock);
+  g_mutex_lock (&mem_caches_lock);
+
+  i = 0;
+  while (i < n_mem_caches && mem_caches[i].priority <= level)
+    {
+      /* The list may change while the lock is dropped */
+      MemCache cache = mem_caches[i];
+
+      freed += mem_cache_call (&cache, level);
+      i = mem_cache_find_next (cache.priority, cache.id);
+    }
+
+  g_mutex_unlock (&mem_caches_lock);
+  g_mutex_unlock (&mem_caches_trim_lock);
+
+  return freed;
+}
+
+/**
+ * g_mem_cache_foreach:
+ * @func: (scope call) (closure user_data): function to call for each cache
+ * @user_data: data to pass to @func
+ *
+ * Calls @func for each cache registered with g_mem_cache_register(), with
+ * its current estimated size, in order of increasing priority. This can be
+ * used to see how much memory GLib and the application hold in caches.
+ *
+ * Since: 2.82
+ */
+void
+g_mem_cache_foreach (GMemCacheForeachFunc func,
+                     gpointer             user_data)
+{
+  typedef struct
+  {
+    gchar *name;
+    guint priority;
+    gsize size;
+  } CacheSize;
+  CacheSize *sizes = NULL;
+  guint n_sizes = 0;
+  guint i;
+
+  g_return_if_fail (func != NULL);
+
+  g_mutex_lock (&mem_caches_trim_lock);
+  g_mutex_lock (&mem_caches_lock);
+
+  /* Collect the sizes first, so that @func is called without any lock */
+  i = 0;
+  while (i < n_mem_caches)
+    {
+      MemCache cache = mem_caches[i];
+
+      sizes = g_renew (CacheSize, sizes, n_sizes + 1);
+      sizes[n_sizes].name = g_strdup (cache.name);
+      sizes[n_sizes].priority = cache.priority;
+      sizes[n_sizes].size = mem_cache_call (&cache, -1);
+      n_sizes++;
+
+      i = mem_cache_find_next (cache.priority, cache.id);
+    }
+
+  g_mutex_unlock (&mem_caches_lock);
+  g_mutex_unlock (&mem_caches_trim_lock);
+
+  for (i = 0; i < n_sizes; i++)
+    {
+      func (sizes[i].name, sizes[i].priority, sizes[i].size, user_data);
+      g_free (sizes[i].name);
+    }
+
+  g_free (sizes);
+}
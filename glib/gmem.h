@@ -420,6 +420,68 @@ GLIB_VAR GMemVTable	*glib_mem_profiler_table;
 GLIB_DEPRECATED_IN_2_46
 void	g_mem_profile	(void);
 
+/* Registry of caches which can be trimmed under memory pressure
+ */
+
+/**
+ * GMemCacheTrimFunc:
+ * @level: how much memory should be freed, from 0 to 255; higher values
+ *   mean the system is shorter of memory
+ * @user_data: user data passed to g_mem_cache_register()
+ *
+ * Frees some or all of the memory held by a cache registered with
+ * g_mem_cache_register().
+ *
+ * Returns: an estimate of the number of bytes freed
+ *
+ * Since: 2.82
+ */
+typedef gsize (*GMemCacheTrimFunc)    (guint        level,
+                                       gpointer     user_data);
+
+/**
+ * GMemCacheSizeFunc:
+ * @user_data: user data passed to g_mem_cache_register()
+ *
+ * Estimates the memory held by a cache registered with
+ * g_mem_cache_register().
+ *
+ * Returns: an estimate of the size of the cache, in bytes
+ *
+ * Since: 2.82
+ */
+typedef gsize (*GMemCacheSizeFunc)    (gpointer     user_data);
+
+/**
+ * GMemCacheForeachFunc:
+ * @name: the name the cache was registered with
+ * @priority: the priority the cache was registered with
+ * @size: the estimated size of the cache, in bytes, or 0 if unknown
+ * @user_data: user data passed to g_mem_cache_foreach()
+ *
+ * Specifies the type of the function passed to g_mem_cache_foreach().
+ *
+ * Since: 2.82
+ */
+typedef void  (*GMemCacheForeachFunc) (const gchar *name,
+                                       guint        priority,
+                                       gsize        size,
+                                       gpointer     user_data);
+
+GLIB_AVAILABLE_IN_2_82
+guint   g_mem_cache_register   (const gchar          *name,
+                                guint                 priority,
+                                GMemCacheTrimFunc     trim_func,
+                                GMemCacheSizeFunc     size_func,
+                                gpointer              user_data);
+GLIB_AVAILABLE_IN_2_82
+void    g_mem_cache_unregister (guint                 cache_id);
+GLIB_AVAILABLE_IN_2_82
+gsize   g_mem_cache_trim       (guint                 level);
+GLIB_AVAILABLE_IN_2_82
+void    g_mem_cache_foreach    (GMemCacheForeachFunc  func,
+                                gpointer              user_data);
+
 G_END_DECLS
 
 #endif /* __G_MEM_H__ */
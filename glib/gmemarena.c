@@ -0,0 +1,477 @@
+/* gmemarena.c: Bump allocator for short-lived allocations
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include <string.h>
+
+#include "gmemarena.h"
+#include "gmemarenaprivate.h"
+
+#include "gmem.h"
+#include "gmessages.h"
+#include "gthread.h"
+
+/**
+ * GMemArena:
+ *
+ * `GMemArena` is a bump allocator for memory which is only needed for
+ * a short, well-defined period of time, such as while handling one
+ * request.
+ *
+ * Memory is taken from blocks which are allocated as needed, by
+ * advancing a pointer into the current block. Individual allocations
+ * are never freed: instead, all the memory allocated from an arena is
+ * released at once with [method@GLib.MemArena.reset], which keeps one
+ * block around for reuse, or [method@GLib.MemArena.free].
+ *
+ * This makes allocating from an arena much cheaper than calling
+ * [func@GLib.malloc] and [func@GLib.free] for every temporary object.
+ * [struct@GLib.Array] and [struct@GLib.PtrArray] can keep their contents
+ * in an arena, see [func@GLib.Array.new_in_arena] and
+ * [func@GLib.PtrArray.new_in_arena]. [struct@GLib.String]s can belong to
+ * an arena too, which frees them when it is reset, see
+ * [func@GLib.String.new_in_arena].
+ *
+ * A `GMemArena` is not thread-safe: it must only be used by one thread
+ * at a time. [func@GLib.MemArena.get_thread_local] returns an arena
+ * which belongs to the calling thread.
+ *
+ * Since: 2.82
+ */
+
+#define ARENA_ALIGNMENT (MAX (G_MEM_ALIGN, 2 * sizeof (gsize)))
+#define ARENA_ALIGN(size) (((size) + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1))
+#define ARENA_DEFAULT_BLOCK_SIZE 4096
+#define ARENA_MIN_BLOCK_SIZE 256
+
+typedef struct _GMemArenaBlock GMemArenaBlock;
+
+struct _GMemArenaBlock
+{
+  GMemArenaBlock *next;
+  gsize           size;  /* usable bytes, following the header */
+};
+
+typedef struct _GMemArenaCleanup GMemArenaCleanup;
+
+/* Allocated from the arena itself, so registering one is cheap */
+struct _GMemArenaCleanup
+{
+  GMemArenaCleanup *next;
+  GDestroyNotify    func;
+  gpointer          data;
+};
+
+#define ARENA_BLOCK_HEADER_SIZE (ARENA_ALIGN (sizeof (GMemArenaBlock)))
+#define ARENA_BLOCK_DATA(block) ((guint8 *) (block) + ARENA_BLOCK_HEADER_SIZE)
+
+struct _GMemArena
+{
+  GMemArenaBlock   *blocks;    /* the current block is first */
+  guint8           *ptr;       /* free space in the current block */
+  guint8           *end;
+  guint8           *last;      /* (nullable) last allocation from the current block */
+  gsize             block_size;
+  GMemArenaCleanup *cleanups;  /* most recently added first */
+};
+
+static GMemArenaBlock *
+arena_block_new (gsize size)
+{
+  GMemArenaBlock *block;
+
+  if (G_UNLIKELY (size > G_MAXSIZE - ARENA_BLOCK_HEADER_SIZE))
+    g_error ("%s: overflow allocating %" G_GSIZE_FORMAT " bytes",
+             G_STRLOC, size);
+
+  block = g_malloc (ARENA_BLOCK_HEADER_SIZE + size);
+  block->next = NULL;
+  block->size = size;
+
+  return block;
+}
+
+/**
+ * g_mem_arena_new: (constructor)
+ * @block_size: the size of the blocks of memory the arena allocates
+ *   from, or 0 for a default size
+ *
+ * Creates a new, empty #GMemArena.
+ *
+ * Allocations larger than a quarter of @block_size get a block of
+ * their own, so @block_size should be comfortably larger than the
+ * typical allocation.
+ *
+ * Returns: (transfer full): a new #GMemArena
+ *
+ * Since: 2.82
+ */
+GMemArena *
+g_mem_arena_new (gsize block_size)
+{
+  GMemArena *arena = g_new0 (GMemArena, 1);
+
+  if (block_size == 0)
+    block_size = ARENA_DEFAULT_BLOCK_SIZE;
+
+  arena->block_size = ARENA_ALIGN (MAX (block_size, ARENA_MIN_BLOCK_SIZE));
+
+  return arena;
+}
+
+static void
+arena_free_blocks (GMemArenaBlock *block,
+                   GMemArenaBlock *keep)
+{
+  while (block != NULL)
+    {
+      GMemArenaBlock *next = block->next;
+
+      if (block != keep)
+        g_free (block);
+
+      block = next;
+    }
+}
+
+static void
+arena_run_cleanups (GMemArena *arena)
+{
+  /* A cleanup may not allocate from the arena, so the list is stable */
+  while (arena->cleanups != NULL)
+    {
+      GMemArenaCleanup *cleanup = arena->cleanups;
+
+      arena->cleanups = cleanup->next;
+      cleanup->func (cleanup->data);
+    }
+}
+
+void
+g_mem_arena_add_cleanup (GMemArena      *arena,
+                         GDestroyNotify  func,
+                         gpointer        data)
+{
+  GMemArenaCleanup *cleanup;
+
+  cleanup = g_mem_arena_alloc (arena, sizeof (GMemArenaCleanup));
+  cleanup->func = func;
+  cleanup->data = data;
+  cleanup->next = arena->cleanups;
+  arena->cleanups = cleanup;
+}
+
+/**
+ * g_mem_arena_free:
+ * @arena: (transfer full): a #GMemArena
+ *
+ * Frees @arena and all the memory allocated from it.
+ *
+ * After calling g_mem_arena_free() it is not safe to access any of
+ * the memory which was allocated from @arena, including the contents
+ * of strings and arrays which were created in it.
+ *
+ * Since: 2.82
+ */
+void
+g_mem_arena_free (GMemArena *arena)
+{
+  g_return_if_fail (arena != NULL);
+
+  arena_run_cleanups (arena);
+  arena_free_blocks (arena->blocks, NULL);
+  g_free (arena);
+}
+
+/**
+ * g_mem_arena_reset:
+ * @arena: a #GMemArena
+ *
+ * Releases all the memory allocated from @arena at once, so that it
+ * can be reused for new allocations.
+ *
+ * One block of memory is kept, so an arena which is reset after each
+ * request typically does not need to call into the system allocator
+ * at all once it is warmed up.
+ *
+ * After calling g_mem_arena_reset() it is not safe to access any of
+ * the memory which was allocated from @arena, including the contents
+ * of strings and arrays which were created in it.
+ *
+ * Since: 2.82
+ */
+void
+g_mem_arena_reset (GMemArena *arena)
+{
+  GMemArenaBlock *keep;
+
+  g_return_if_fail (arena != NULL);
+
+  arena_run_cleanups (arena);
+
+  /* Keep one block of the default size; larger ones were only
+   * allocated for single large allocations */
+  for (keep = arena->blocks; keep != NULL; keep = keep->next)
+    if (keep->size == arena->block_size)
+      break;
+
+  arena_free_blocks (arena->blocks, keep);
+
+  arena->blocks = keep;
+  arena->last = NULL;
+
+  if (keep != NULL)
+    {
+      keep->next = NULL;
+      arena->ptr = ARENA_BLOCK_DATA (keep);
+      arena->end = arena->ptr + keep->size;
+
+      if (G_UNLIKELY (g_mem_gc_friendly))
+        memset (arena->ptr, 0, keep->size);
+    }
+  else
+    arena->ptr = arena->end = NULL;
+}
+
+/**
+ * g_mem_arena_alloc:
+ * @arena: a #GMemArena
+ * @size: the number of bytes to allocate
+ *
+ * Allocates @size bytes from @arena.
+ *
+ * The memory is suitably aligned for any type, like the memory
+ * returned by g_malloc(). It must not be freed with g_free(): it is
+ * released when @arena is reset or freed.
+ *
+ * If @size is 0 it returns %NULL. If the allocation fails (because
+ * the system is out of memory), the program is terminated.
+ *
+ * Returns: (nullable) (transfer none): a pointer to the allocated memory
+ *
+ * Since: 2.82
+ */
+gpointer
+g_mem_arena_alloc (GMemArena *arena,
+                   gsize      size)
+{
+  GMemArenaBlock *block;
+  guint8 *mem;
+
+  g_return_val_if_fail (arena != NULL, NULL);
+
+  if (G_UNLIKELY (size == 0))
+    return NULL;
+
+  if (G_UNLIKELY (size > G_MAXSIZE - ARENA_ALIGNMENT))
+    g_error ("%s: overflow allocating %" G_GSIZE_FORMAT " bytes",
+             G_STRLOC, size);
+
+  size = ARENA_ALIGN (size);
+
+  if (G_LIKELY (size <= (gsize) (arena->end - arena->ptr)))
+    {
+      mem = arena->ptr;
+      arena->ptr += size;
+      arena->last = mem;
+
+      return mem;
+    }
+
+  if (size > arena->block_size / 4)
+    {
+      /* Large allocations get a block of their own, which is linked in
+       * after the current block so that its free space is not lost */
+      block = arena_block_new (size);
+
+      if (arena->blocks != NULL)
+        {
+          block->next = arena->blocks->next;
+          arena->blocks->next = block;
+        }
+      else
+        arena->blocks = block;
+
+      return ARENA_BLOCK_DATA (block);
+    }
+
+  block = arena_block_new (arena->block_size);
+  block->next = arena->blocks;
+  arena->blocks = block;
+
+  mem = ARENA_BLOCK_DATA (block);
+  arena->ptr = mem + size;
+  arena->end = mem + block->size;
+  arena->last = mem;
+
+  return mem;
+}
+
+/**
+ * g_mem_arena_alloc0:
+ * @arena: a #GMemArena
+ * @size: the number of bytes to allocate
+ *
+ * Allocates @size bytes from @arena, initialized to 0's.
+ *
+ * See g_mem_arena_alloc().
+ *
+ * Returns: (nullable) (transfer none): a pointer to the allocated memory
+ *
+ * Since: 2.82
+ */
+gpointer
+g_mem_arena_alloc0 (GMemArena *arena,
+                    gsize      size)
+{
+  gpointer mem = g_mem_arena_alloc (arena, size);
+
+  if (mem != NULL)
+    memset (mem, 0, size);
+
+  return mem;
+}
+
+/**
+ * g_mem_arena_realloc:
+ * @arena: a #GMemArena
+ * @mem: (nullable): memory allocated from @arena, or %NULL
+ * @old_size: the size @mem was allocated with
+ * @new_size: the new size of the allocation
+ *
+ * Grows or shrinks a block of memory which was allocated from @arena,
+ * returning a pointer to its new location. The contents of the block
+ * are kept, up to the lesser of @old_size and @new_size.
+ *
+ * Unlike g_realloc(), the caller has to pass in the current size:
+ * arenas don't track the size of individual allocations. If @mem is
+ * the most recent allocation from @arena it is grown in place when
+ * possible; otherwise new memory is allocated and the old memory is
+ * only released when @arena is reset.
+ *
+ * Returns: (nullable) (transfer none): the new address of the memory,
+ *   or %NULL if @new_size is 0
+ *
+ * Since: 2.82
+ */
+gpointer
+g_mem_arena_realloc (GMemArena *arena,
+                     gpointer   mem,
+                     gsize      old_size,
+                     gsize      new_size)
+{
+  gpointer new_mem;
+
+  g_return_val_if_fail (arena != NULL, NULL);
+
+  if (mem == NULL)
+    return g_mem_arena_alloc (arena, new_size);
+
+  if (new_size == 0)
+    {
+      if (mem == arena->last)
+        {
+          arena->ptr = arena->last;
+          arena->last = NULL;
+        }
+
+      return NULL;
+    }
+
+  if (G_UNLIKELY (new_size > G_MAXSIZE - ARENA_ALIGNMENT))
+    g_error ("%s: overflow allocating %" G_GSIZE_FORMAT " bytes",
+             G_STRLOC, new_size);
+
+  if (mem == arena->last &&
+      ARENA_ALIGN (new_size) <= (gsize) (arena->end - arena->last))
+    {
+      arena->ptr = arena->last + ARENA_ALIGN (new_size);
+      return mem;
+    }
+
+  if (new_size <= ARENA_ALIGN (old_size))
+    return mem;
+
+  new_mem = g_mem_arena_alloc (arena, new_size);
+  memcpy (new_mem, mem, old_size);
+
+  return new_mem;
+}
+
+/**
+ * g_mem_arena_strdup:
+ * @arena: a #GMemArena
+ * @str: (nullable): the string to duplicate
+ *
+ * Duplicates a string into @arena. If @str is %NULL it returns %NULL.
+ *
+ * Returns: (nullable) (transfer none): a newly-allocated copy of @str
+ *
+ * Since: 2.82
+ */
+gchar *
+g_mem_arena_strdup (GMemArena   *arena,
+                    const gchar *str)
+{
+  gsize len;
+  gchar *copy;
+
+  g_return_val_if_fail (arena != NULL, NULL);
+
+  if (str == NULL)
+    return NULL;
+
+  len = strlen (str) + 1;
+  copy = g_mem_arena_alloc (arena, len);
+  memcpy (copy, str, len);
+
+  return copy;
+}
+
+static GPrivate thread_arena = G_PRIVATE_INIT ((GDestroyNotify) g_mem_arena_free);
+
+/**
+ * g_mem_arena_get_thread_local:
+ *
+ * Gets the #GMemArena which belongs to the calling thread, creating it
+ * if needed. It uses the default block size, and is freed when the
+ * thread exits.
+ *
+ * Code using the thread-local arena must not keep pointers into it
+ * past the point where it is reset. Typically, one function owns the
+ * arena for a thread (for example, the loop handling requests in a
+ * worker thread) and resets it after each unit of work.
+ *
+ * Returns: (transfer none): the arena of the calling thread
+ *
+ * Since: 2.82
+ */
+GMemArena *
+g_mem_arena_get_thread_local (void)
+{
+  GMemArena *arena = g_private_get (&thread_arena);
+
+  if (G_UNLIKELY (arena == NULL))
+    {
+      arena = g_mem_arena_new (0);
+      g_private_set (&thread_arena, arena);
+    }
+
+  return arena;
+}
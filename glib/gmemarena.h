@@ -0,0 +1,56 @@
+/* gmemarena.h: Bump allocator for short-lived allocations
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#if !defined (__GLIB_H_INSIDE__) && !defined (GLIB_COMPILATION)
+#error "Only <glib.h> can be included directly."
+#endif
+
+#include <glib/gtypes.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GMemArena GMemArena;
+
+GLIB_AVAILABLE_IN_2_82
+GMemArena *g_mem_arena_new              (gsize        block_size);
+GLIB_AVAILABLE_IN_2_82
+void       g_mem_arena_free             (GMemArena   *arena);
+GLIB_AVAILABLE_IN_2_82
+void       g_mem_arena_reset            (GMemArena   *arena);
+
+GLIB_AVAILABLE_IN_2_82
+gpointer   g_mem_arena_alloc            (GMemArena   *arena,
+                                         gsize        size) G_GNUC_MALLOC G_GNUC_ALLOC_SIZE(2);
+GLIB_AVAILABLE_IN_2_82
+gpointer   g_mem_arena_alloc0           (GMemArena   *arena,
+                                         gsize        size) G_GNUC_MALLOC G_GNUC_ALLOC_SIZE(2);
+GLIB_AVAILABLE_IN_2_82
+gpointer   g_mem_arena_realloc          (GMemArena   *arena,
+                                         gpointer     mem,
+                                         gsize        old_size,
+                                         gsize        new_size) G_GNUC_WARN_UNUSED_RESULT;
+GLIB_AVAILABLE_IN_2_82
+gchar *    g_mem_arena_strdup           (GMemArena   *arena,
+                                         const gchar *str) G_GNUC_MALLOC;
+
+GLIB_AVAILABLE_IN_2_82
+GMemArena *g_mem_arena_get_thread_local (void);
+
+G_END_DECLS
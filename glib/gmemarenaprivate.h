@@ -0,0 +1,34 @@
+/* gmemarenaprivate.h: Bump allocator for short-lived allocations
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __G_MEM_ARENA_PRIVATE_H__
+#define __G_MEM_ARENA_PRIVATE_H__
+
+#include "gmemarena.h"
+
+G_BEGIN_DECLS
+
+/* Calls @func with @data when @arena is next reset or freed, for
+ * objects which live in the arena but own memory outside of it. */
+void g_mem_arena_add_cleanup (GMemArena      *arena,
+                              GDestroyNotify  func,
+                              gpointer        data);
+
+G_END_DECLS
+
+#endif /* __G_MEM_ARENA_PRIVATE_H__ */
@@ -57,6 +57,7 @@
 #include "gmem.h"
 #include "gpattern.h"
 #include "gprintfint.h"
+#include "gqueue.h"
 #include "gstrfuncs.h"
 #include "gstring.h"
 #include "gtestutils.h"
@@ -399,6 +400,10 @@ static inline const char * format_string (const char *format,
                                           char      **out_allocated_string)
                                           G_GNUC_PRINTF (1, 0);
 static inline FILE * log_level_to_file (GLogLevelFlags log_level);
+static gboolean should_drop_message (GLogLevelFlags   log_level,
+                                     const char      *log_domain,
+                                     const GLogField *fields,
+                                     gsize            n_fields);
 
 static void
 _g_log_abort (gboolean breakpoint)
@@ -1485,6 +1490,33 @@ done_query:
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wformat-nonliteral"
 
+/* Whether a structured message would be dropped by the writer anyway, so
+ * that formatting its MESSAGE field can be skipped.  This is only known
+ * for the writers which filter like g_log_writer_default(). */
+static gboolean
+log_structured_would_drop (GLogLevelFlags  log_level,
+                           const gchar    *log_domain)
+{
+  GLogWriterFunc writer_func;
+
+  if (log_level & G_LOG_FATAL_MASK)
+    return FALSE;
+
+  if (!should_drop_message (log_level, log_domain, NULL, 0))
+    return FALSE;
+
+  /* The fallback writer used when recursing does no filtering */
+  if (g_private_get (&g_log_structured_depth) != NULL)
+    return FALSE;
+
+  g_mutex_lock (&g_messages_lock);
+  writer_func = log_writer_func;
+  g_mutex_unlock (&g_messages_lock);
+
+  return writer_func == g_log_writer_default ||
+         writer_func == g_log_writer_async;
+}
+
 /**
  * g_log_structured:
  * @log_domain: log domain, usually `G_LOG_DOMAIN`
@@ -1601,6 +1633,9 @@ g_log_structured (const gchar    *log_domain,
   GLogField *fields_allocated = NULL;
   GArray *array = NULL;
 
+  if (log_structured_would_drop (log_level, log_domain))
+    return;
+
   va_start (args, log_level);
 
   /* MESSAGE and PRIORITY are a given */
@@ -1893,6 +1928,9 @@ g_log_structured_standard (const gchar    *log_domain,
   gchar buffer[1025];
   va_list args;
 
+  if (log_structured_would_drop (log_level, log_domain))
+    return;
+
   va_start (args, message_format);
 
   if (log_level & G_LOG_FLAG_RECURSION)
@@ -2883,6 +2921,252 @@ handled:
   return G_LOG_WRITER_HANDLED;
 }
 
+/* Messages queued by g_log_writer_async(), written by async_log_thread.
+ * Writers wait on async_log_cond for space in the queue, the thread waits
+ * for messages, and g_log_writer_async_flush() waits for the queue to
+ * be drained, so it is always broadcast. */
+typedef struct
+{
+  GLogLevelFlags log_level;
+  gsize n_fields;
+  gpointer user_data;
+  GLogField fields[];
+} AsyncLogMessage;
+
+#define ASYNC_LOG_MAX_QUEUED 4096
+
+static GMutex async_log_lock;
+static GCond async_log_cond;
+static GQueue async_log_queue = G_QUEUE_INIT;
+static GThread *async_log_thread = NULL;
+static gboolean async_log_writing = FALSE;
+static guint64 async_log_dropped = 0;
+
+/* Copies @fields, and everything they point to, into a single allocation */
+static AsyncLogMessage *
+async_log_message_new (GLogLevelFlags   log_level,
+                       const GLogField *fields,
+                       gsize            n_fields,
+                       gpointer         user_data)
+{
+  AsyncLogMessage *message;
+  gsize size;
+  gchar *data;
+  gsize i;
+
+  size = sizeof (AsyncLogMessage) + n_fields * sizeof (GLogField);
+  for (i = 0; i < n_fields; i++)
+    {
+      size += strlen (fields[i].key) + 1;
+      if (fields[i].length < 0)
+        size += strlen (fields[i].value) + 1;
+      else
+        size += fields[i].length;
+    }
+
+  message = g_malloc (size);
+  message->log_level = log_level;
+  message->n_fields = n_fields;
+  message->user_data = user_data;
+
+  data = (gchar *) &message->fields[n_fields];
+  for (i = 0; i < n_fields; i++)
+    {
+      gsize value_size;
+
+      message->fields[i].key = data;
+      data = g_stpcpy (data, fields[i].key) + 1;
+
+      if (fields[i].length < 0)
+        value_size = strlen (fields[i].value) + 1;
+      else
+        value_size = fields[i].length;
+
+      message->fields[i].value = data;
+      message->fields[i].length = fields[i].length;
+      if (value_size > 0)
+        memcpy (data, fields[i].value, value_size);
+      data += value_size;
+    }
+
+  return message;
+}
+
+static gpointer
+async_log_thread_func (gpointer data)
+{
+  g_mutex_lock (&async_log_lock);
+
+  while (TRUE)
+    {
+      GQueue batch;
+      AsyncLogMessage *message;
+
+      while (g_queue_is_empty (&async_log_queue))
+        g_cond_wait (&async_log_cond, &async_log_lock);
+
+      /* Take everything queued so far and write it without the lock */
+      batch = async_log_queue;
+      g_queue_init (&async_log_queue);
+      async_log_writing = TRUE;
+      g_cond_broadcast (&async_log_cond);
+      g_mutex_unlock (&async_log_lock);
+
+      while ((message = g_queue_pop_head (&batch)) != NULL)
+        {
+          g_log_writer_default (message->log_level, message->fields,
+                                message->n_fields, message->user_data);
+          g_free (message);
+        }
+
+      g_mutex_lock (&async_log_lock);
+      async_log_writing = FALSE;
+      g_cond_broadcast (&async_log_cond);
+    }
+
+  return NULL;
+}
+
+/**
+ * g_log_writer_async:
+ * @log_level: log level, either from [type@GLib.LogLevelFlags], or a user-defined
+ *    level
+ * @fields: (array length=n_fields): key–value pairs of structured data forming
+ *    the log message
+ * @n_fields: number of elements in the @fields array
+ * @user_data: user data passed to [func@GLib.log_set_writer_func]
+ *
+ * Queue a structured log message to be written by [func@GLib.log_writer_default]
+ * on a separate thread.
+ *
+ * The fields are copied, so the calling thread does not wait for the
+ * systemd journal or a terminal to accept the message. Messages are
+ * written in the order they were queued, in batches.
+ *
+ * At most 4096 messages are queued. When the queue is full, warnings and
+ * critical messages wait for space in the queue, and less severe messages
+ * are dropped and counted by [func@GLib.log_writer_async_get_dropped].
+ * Fatal messages, and messages with a level set in
+ * [func@GLib.log_set_always_fatal], are written synchronously once the
+ * queue has been flushed, so they are never lost.
+ *
+ * Messages which are still queued when the process exits are lost; call
+ * [func@GLib.log_writer_async_flush] before exiting to avoid that.
+ *
+ * This is suitable for use as a [type@GLib.LogWriterFunc]:
+ *
+ * ```c
+ * g_log_set_writer_func (g_log_writer_async, NULL, NULL);
+ * ```
+ *
+ * Returns: [enum@GLib.LogWriterOutput.HANDLED] on success,
+ *   [enum@GLib.LogWriterOutput.UNHANDLED] otherwise
+ * Since: 2.82
+ */
+GLogWriterOutput
+g_log_writer_async (GLogLevelFlags   log_level,
+                    const GLogField *fields,
+                    gsize            n_fields,
+                    gpointer         user_data)
+{
+  AsyncLogMessage *message;
+
+  g_return_val_if_fail (fields != NULL, G_LOG_WRITER_UNHANDLED);
+  g_return_val_if_fail (n_fields > 0, G_LOG_WRITER_UNHANDLED);
+
+  /* Avoid copying messages which would be dropped anyway */
+  if (should_drop_message (log_level, NULL, fields, n_fields))
+    return G_LOG_WRITER_HANDLED;
+
+  /* Fatal messages must be written before the process aborts */
+  if (log_level & (G_LOG_FLAG_FATAL | G_LOG_LEVEL_ERROR | g_log_always_fatal))
+    {
+      g_log_writer_async_flush ();
+      return g_log_writer_default (log_level, fields, n_fields, user_data);
+    }
+
+  message = async_log_message_new (log_level, fields, n_fields, user_data);
+
+  g_mutex_lock (&async_log_lock);
+
+  if (async_log_thread == NULL)
+    async_log_thread = g_thread_try_new ("glog-writer", async_log_thread_func,
+                                         NULL, NULL);
+
+  /* Messages logged while writing a batch are written straight away, as
+   * waiting for space in the queue would deadlock */
+  if (async_log_thread == NULL || g_thread_self () == async_log_thread)
+    {
+      g_mutex_unlock (&async_log_lock);
+      g_free (message);
+      return g_log_writer_default (log_level, fields, n_fields, user_data);
+    }
+
+  while (async_log_queue.length >= ASYNC_LOG_MAX_QUEUED)
+    {
+      if (!(log_level & (G_LOG_LEVEL_CRITICAL | G_LOG_LEVEL_WARNING)))
+        {
+          async_log_dropped++;
+          g_mutex_unlock (&async_log_lock);
+          g_free (message);
+          return G_LOG_WRITER_HANDLED;
+        }
+
+      g_cond_wait (&async_log_cond, &async_log_lock);
+    }
+
+  g_queue_push_tail (&async_log_queue, message);
+  if (async_log_queue.length == 1)
+    g_cond_broadcast (&async_log_cond);
+
+  g_mutex_unlock (&async_log_lock);
+
+  return G_LOG_WRITER_HANDLED;
+}
+
+/**
+ * g_log_writer_async_flush:
+ *
+ * Wait until all messages queued by [func@GLib.log_writer_async] have been
+ * written.
+ *
+ * Since: 2.82
+ */
+void
+g_log_writer_async_flush (void)
+{
+  g_mutex_lock (&async_log_lock);
+
+  if (async_log_thread != NULL && g_thread_self () != async_log_thread)
+    {
+      while (!g_queue_is_empty (&async_log_queue) || async_log_writing)
+        g_cond_wait (&async_log_cond, &async_log_lock);
+    }
+
+  g_mutex_unlock (&async_log_lock);
+}
+
+/**
+ * g_log_writer_async_get_dropped:
+ *
+ * Get the number of messages which [func@GLib.log_writer_async] dropped
+ * because its queue was full.
+ *
+ * Returns: the number of dropped messages
+ * Since: 2.82
+ */
+guint64
+g_log_writer_async_get_dropped (void)
+{
+  guint64 dropped;
+
+  g_mutex_lock (&async_log_lock);
+  dropped = async_log_dropped;
+  g_mutex_unlock (&async_log_lock);
+
+  return dropped;
+}
+
 static GLogWriterOutput
 _g_log_writer_fallback (GLogLevelFlags   log_level,
                         const GLogField *fields,
@@ -250,6 +250,16 @@ GLogWriterOutput g_log_writer_default          (GLogLevelFlags   log_level,
                                                 gsize            n_fields,
                                                 gpointer         user_data);
 
+GLIB_AVAILABLE_IN_2_82
+GLogWriterOutput g_log_writer_async            (GLogLevelFlags   log_level,
+                                                const GLogField *fields,
+                                                gsize            n_fields,
+                                                gpointer         user_data);
+GLIB_AVAILABLE_IN_2_82
+void             g_log_writer_async_flush      (void);
+GLIB_AVAILABLE_IN_2_82
+guint64          g_log_writer_async_get_dropped (void);
+
 GLIB_AVAILABLE_IN_2_68
 void            g_log_writer_default_set_use_stderr (gboolean use_stderr);
 GLIB_AVAILABLE_IN_2_68
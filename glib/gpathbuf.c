@@ -8,9 +8,11 @@
 
 #include "gpathbuf.h"
 
-#include "garray.h"
+#include <string.h>
+
 #include "gfileutils.h"
 #include "ghash.h"
+#include "gmem.h"
 #include "gmessages.h"
 #include "gstrfuncs.h"
 
@@ -51,20 +53,158 @@
  * Since: 2.76
  */
 
+/* The path is kept already joined in a single nul-terminated buffer, with
+ * the extension (if any) appended after @base_len, so pushing and popping
+ * elements only moves the end of the string and retrieving the path does
+ * not need to rebuild it.
+ */
 typedef struct {
-  /* (nullable) (owned) (element-type filename) */
-  GPtrArray *path;
+  /* (nullable): either @storage or an owned allocation of @size bytes;
+   * %NULL until something is pushed */
+  char *path;
+
+  /* Length of @path, including the extension */
+  gsize len;
+
+  /* Length of @path, without the extension */
+  gsize base_len;
+
+  /* Size of the @path allocation */
+  gsize size;
+
+  /* (nullable) (not owned): caller-provided memory, see
+   * g_path_buf_init_with_storage() */
+  char *storage;
+  gsize storage_size;
 
   /* (nullable) (owned) */
   char *extension;
 
-  gpointer padding[6];
+  gpointer padding[1];
 } RealPathBuf;
 
 G_STATIC_ASSERT (sizeof (GPathBuf) == sizeof (RealPathBuf));
 
 #define PATH_BUF(b) ((RealPathBuf *) (b))
 
+#define PATH_BUF_MIN_SIZE 64
+
+#ifdef G_OS_WIN32
+#define PATH_BUF_SEPARATORS "\\/"
+#else
+#define PATH_BUF_SEPARATORS G_DIR_SEPARATOR_S
+#endif
+
+/* Makes room for @extra more bytes after the current path, plus the nul
+ * terminator; the caller storage is used for as long as it is big enough
+ * and then copied to the heap.
+ */
+static void
+path_buf_reserve (RealPathBuf *rbuf,
+                  gsize        extra)
+{
+  gsize needed = rbuf->len + extra + 1;
+  gsize new_size;
+
+  if (rbuf->path == NULL && rbuf->storage != NULL && needed <= rbuf->storage_size)
+    {
+      rbuf->path = rbuf->storage;
+      rbuf->size = rbuf->storage_size;
+      rbuf->path[0] = '\0';
+      return;
+    }
+
+  if (rbuf->path != NULL && needed <= rbuf->size)
+    return;
+
+  new_size = MAX (needed, MAX (rbuf->size * 2, PATH_BUF_MIN_SIZE));
+
+  if (rbuf->path != NULL && rbuf->path != rbuf->storage)
+    {
+      rbuf->path = g_realloc (rbuf->path, new_size);
+    }
+  else
+    {
+      char *new_path = g_malloc (new_size);
+
+      if (rbuf->path != NULL)
+        memcpy (new_path, rbuf->path, rbuf->len + 1);
+      else
+        new_path[0] = '\0';
+
+      rbuf->path = new_path;
+    }
+
+  rbuf->size = new_size;
+}
+
+static void
+path_buf_append (RealPathBuf *rbuf,
+                 const char  *str,
+                 gsize        len)
+{
+  path_buf_reserve (rbuf, len);
+  memcpy (rbuf->path + rbuf->len, str, len);
+  rbuf->len += len;
+  rbuf->path[rbuf->len] = '\0';
+}
+
+/* Drops the extension from the end of the buffer, so that the path
+ * elements can be modified */
+static void
+path_buf_strip_extension (RealPathBuf *rbuf)
+{
+  rbuf->len = rbuf->base_len;
+  rbuf->path[rbuf->len] = '\0';
+}
+
+static void
+path_buf_append_extension (RealPathBuf *rbuf)
+{
+  rbuf->base_len = rbuf->len;
+
+  if (rbuf->extension != NULL)
+    {
+      path_buf_append (rbuf, ".", 1);
+      path_buf_append (rbuf, rbuf->extension, strlen (rbuf->extension));
+    }
+}
+
+/* Appends a single, non-empty element, separating it from the previous
+ * one; this is what g_build_filename() would produce for the same list
+ * of elements, since none of them have leading or trailing separators
+ * except for the root.
+ */
+static void
+path_buf_append_element (RealPathBuf *rbuf,
+                         const char  *element,
+                         gsize        len)
+{
+  if (rbuf->len > 0 && rbuf->path[rbuf->len - 1] != G_DIR_SEPARATOR)
+    path_buf_append (rbuf, G_DIR_SEPARATOR_S, 1);
+
+  path_buf_append (rbuf, element, len);
+}
+
+/* Appends every non-empty element of @path between @separators */
+static void
+path_buf_append_elements (RealPathBuf *rbuf,
+                          const char  *path,
+                          const char  *separators)
+{
+  while (*path != '\0')
+    {
+      gsize len = strcspn (path, separators);
+
+      if (len > 0)
+        path_buf_append_element (rbuf, path, len);
+
+      path += len;
+      if (*path != '\0')
+        path++;
+    }
+}
+
 /**
  * g_path_buf_init:
  * @buf: a path buffer
@@ -81,11 +221,69 @@ g_path_buf_init (GPathBuf *buf)
   RealPathBuf *rbuf = PATH_BUF (buf);
 
   rbuf->path = NULL;
+  rbuf->len = 0;
+  rbuf->base_len = 0;
+  rbuf->size = 0;
+  rbuf->storage = NULL;
+  rbuf->storage_size = 0;
   rbuf->extension = NULL;
 
   return buf;
 }
 
+/**
+ * g_path_buf_init_with_storage:
+ * @buf: a path buffer
+ * @storage: (array length=storage_size) (nullable): memory to build
+ *   the path into
+ * @storage_size: the size of @storage, in bytes
+ *
+ * Initializes a `GPathBuf` instance that builds its path into the memory
+ * provided by the caller, typically an array on the stack.
+ *
+ * As long as the path fits into @storage_size bytes, no memory is
+ * allocated to store it; if it grows larger, it is moved to the heap
+ * transparently. The contents of @storage are undefined while the path
+ * buffer is in use, and @storage must outlive it.
+ *
+ * |[<!-- language="C" -->
+ * char storage[256];
+ * g_auto (GPathBuf) buf = G_PATH_BUF_INIT;
+ *
+ * g_path_buf_init_with_storage (&buf, storage, sizeof (storage));
+ * g_path_buf_push (&buf, dirname);
+ * g_path_buf_push (&buf, basename);
+ *
+ * do_something (g_path_buf_get_path (&buf));
+ * ]|
+ *
+ * You still need to call g_path_buf_clear() when done with the buffer.
+ *
+ * Returns: (transfer none): the initialized path builder
+ *
+ * Since: 2.82
+ */
+GPathBuf *
+g_path_buf_init_with_storage (GPathBuf *buf,
+                              char     *storage,
+                              gsize     storage_size)
+{
+  RealPathBuf *rbuf = PATH_BUF (buf);
+
+  g_return_val_if_fail (buf != NULL, NULL);
+  g_return_val_if_fail (storage != NULL || storage_size == 0, NULL);
+
+  g_path_buf_init (buf);
+
+  if (storage_size > 0)
+    {
+      rbuf->storage = storage;
+      rbuf->storage_size = storage_size;
+    }
+
+  return buf;
+}
+
 /**
  * g_path_buf_init_from_path:
  * @buf: a path buffer
@@ -131,8 +329,12 @@ g_path_buf_clear (GPathBuf *buf)
 
   g_return_if_fail (buf != NULL);
 
-  g_clear_pointer (&rbuf->path, g_ptr_array_unref);
+  if (rbuf->path != rbuf->storage)
+    g_free (rbuf->path);
+
   g_clear_pointer (&rbuf->extension, g_free);
+
+  g_path_buf_init (buf);
 }
 
 /**
@@ -262,14 +464,10 @@ g_path_buf_copy (GPathBuf *buf)
 
   if (rbuf->path != NULL)
     {
-      rcopy->path = g_ptr_array_new_null_terminated (rbuf->path->len, g_free, TRUE);
-      for (guint i = 0; i < rbuf->path->len; i++)
-        {
-          const char *p = g_ptr_array_index (rbuf->path, i);
-
-          if (p != NULL)
-            g_ptr_array_add (rcopy->path, g_strdup (p));
-        }
+      rcopy->path = g_memdup2 (rbuf->path, rbuf->len + 1);
+      rcopy->len = rbuf->len;
+      rcopy->base_len = rbuf->base_len;
+      rcopy->size = rbuf->len + 1;
     }
 
   rcopy->extension = g_strdup (rbuf->extension);
@@ -323,58 +521,23 @@ g_path_buf_push (GPathBuf   *buf,
   g_return_val_if_fail (buf != NULL, NULL);
   g_return_val_if_fail (path != NULL && *path != '\0', buf);
 
+  path_buf_reserve (rbuf, 0);
+  path_buf_strip_extension (rbuf);
+
+  /* Empty elements caused by repeated separators are skipped */
   if (g_path_is_absolute (path))
     {
-#ifdef G_OS_WIN32
-      char **elements = g_strsplit_set (path, "\\/", -1);
-#else
-      char **elements = g_strsplit (path, G_DIR_SEPARATOR_S, -1);
-#endif
+      rbuf->len = 0;
 
 #ifdef G_OS_UNIX
-      /* strsplit() will add an empty element for the leading root,
-       * which will cause the path build to ignore it; to avoid it,
-       * we re-inject the root as the first element.
-       *
-       * The first string is empty, but it's still allocated, so we
-       * need to free it to avoid leaking it.
-       */
-      g_free (elements[0]);
-      elements[0] = g_strdup ("/");
+      /* The root is the first element */
+      path_buf_append (rbuf, G_DIR_SEPARATOR_S, 1);
 #endif
-
-      g_clear_pointer (&rbuf->path, g_ptr_array_unref);
-      rbuf->path = g_ptr_array_new_null_terminated (g_strv_length (elements), g_free, TRUE);
-
-      /* Skip empty elements caused by repeated separators */
-      for (guint i = 0; elements[i] != NULL; i++)
-        {
-          if (*elements[i] != '\0')
-            g_ptr_array_add (rbuf->path, g_steal_pointer (&elements[i]));
-          else
-            g_free (elements[i]);
-        }
-
-      g_free (elements);
     }
-  else
-    {
-      char **elements = g_strsplit (path, G_DIR_SEPARATOR_S, -1);
-
-      if (rbuf->path == NULL)
-        rbuf->path = g_ptr_array_new_null_terminated (g_strv_length (elements), g_free, TRUE);
 
-      /* Skip empty elements caused by repeated separators */
-      for (guint i = 0; elements[i] != NULL; i++)
-        {
-          if (*elements[i] != '\0')
-            g_ptr_array_add (rbuf->path, g_steal_pointer (&elements[i]));
-          else
-            g_free (elements[i]);
-        }
+  path_buf_append_elements (rbuf, path, PATH_BUF_SEPARATORS);
 
-      g_free (elements);
-    }
+  path_buf_append_extension (rbuf);
 
   return buf;
 }
@@ -415,17 +578,27 @@ gboolean
 g_path_buf_pop (GPathBuf *buf)
 {
   RealPathBuf *rbuf = PATH_BUF (buf);
+  const char *sep;
 
   g_return_val_if_fail (buf != NULL, FALSE);
   g_return_val_if_fail (rbuf->path != NULL, FALSE);
 
+  /* Elements never contain G_DIR_SEPARATOR, except for the root, so the
+   * last one starts after the last separator. */
+  path_buf_strip_extension (rbuf);
+  sep = strrchr (rbuf->path, G_DIR_SEPARATOR);
+
   /* Keep the first element of the buffer; it's either '/' or the drive */
-  if (rbuf->path->len > 1)
+  if (sep != NULL && !(sep == rbuf->path && rbuf->len == 1))
     {
-      g_ptr_array_remove_index (rbuf->path, rbuf->path->len - 1);
+      rbuf->len = sep == rbuf->path ? 1 : (gsize) (sep - rbuf->path);
+      rbuf->path[rbuf->len] = '\0';
+      path_buf_append_extension (rbuf);
       return TRUE;
     }
 
+  path_buf_append_extension (rbuf);
+
   return FALSE;
 }
 
@@ -509,10 +682,13 @@ g_path_buf_set_extension  (GPathBuf   *buf,
 
   g_return_val_if_fail (buf != NULL, FALSE);
 
-  if (rbuf->path != NULL)
-    return g_set_str (&rbuf->extension, extension);
-  else
+  if (rbuf->path == NULL || !g_set_str (&rbuf->extension, extension))
     return FALSE;
+
+  path_buf_strip_extension (rbuf);
+  path_buf_append_extension (rbuf);
+
+  return TRUE;
 }
 
 /**
@@ -534,22 +710,39 @@ char *
 g_path_buf_to_path (GPathBuf *buf)
 {
   RealPathBuf *rbuf = PATH_BUF (buf);
-  char *path = NULL;
 
   g_return_val_if_fail (buf != NULL, NULL);
 
-  if (rbuf->path != NULL)
-    path = g_build_filenamev ((char **) rbuf->path->pdata);
+  if (rbuf->path == NULL)
+    return NULL;
 
-  if (path != NULL && rbuf->extension != NULL)
-    {
-      char *tmp = g_strconcat (path, ".", rbuf->extension, NULL);
+  return g_memdup2 (rbuf->path, rbuf->len + 1);
+}
 
-      g_free (path);
-      path = g_steal_pointer (&tmp);
-    }
+/**
+ * g_path_buf_get_path:
+ * @buf: a path buffer
+ *
+ * Retrieves the built path from the path buffer, without copying it.
+ *
+ * This is the same path returned by g_path_buf_to_path(), but it is
+ * owned by the path buffer and only valid until the buffer is modified
+ * or cleared, which makes it convenient to use for temporary paths,
+ * for instance when pushing and popping the elements of a directory
+ * tree while walking it.
+ *
+ * If the path buffer is empty, this function returns `NULL`.
+ *
+ * Returns: (transfer none) (type filename) (nullable): the path
+ *
+ * Since: 2.82
+ */
+const char *
+g_path_buf_get_path (GPathBuf *buf)
+{
+  g_return_val_if_fail (buf != NULL, NULL);
 
-  return path;
+  return PATH_BUF (buf)->path;
 }
 
 /**
@@ -579,18 +772,13 @@ g_path_buf_equal (gconstpointer v1,
   if (v1 == v2)
     return TRUE;
 
-  /* We resolve the buffer into a path to normalize its contents;
+  /* The buffer always holds the built path, which is normalized;
    * this won't resolve symbolic links or `.` and `..` components
    */
-  char *p1 = g_path_buf_to_path ((GPathBuf *) v1);
-  char *p2 = g_path_buf_to_path ((GPathBuf *) v2);
-
-  gboolean res = p1 != NULL && p2 != NULL
-               ? g_str_equal (p1, p2)
-               : FALSE;
-
-  g_free (p1);
-  g_free (p2);
+  const RealPathBuf *b1 = v1;
+  const RealPathBuf *b2 = v2;
 
-  return res;
+  return b1->path != NULL && b2->path != NULL &&
+         b1->len == b2->len &&
+         memcmp (b1->path, b2->path, b1->len) == 0;
 }
@@ -49,6 +49,10 @@ GPathBuf *    g_path_buf_init           (GPathBuf   *buf);
 GLIB_AVAILABLE_IN_2_76
 GPathBuf *    g_path_buf_init_from_path (GPathBuf   *buf,
                                          const char *path);
+GLIB_AVAILABLE_IN_2_82
+GPathBuf *    g_path_buf_init_with_storage (GPathBuf *buf,
+                                            char     *storage,
+                                            gsize     storage_size);
 GLIB_AVAILABLE_IN_2_76
 void          g_path_buf_clear          (GPathBuf   *buf);
 GLIB_AVAILABLE_IN_2_76
@@ -75,6 +79,8 @@ gboolean      g_path_buf_set_extension  (GPathBuf   *buf,
 
 GLIB_AVAILABLE_IN_2_76
 char *        g_path_buf_to_path        (GPathBuf   *buf) G_GNUC_WARN_UNUSED_RESULT;
+GLIB_AVAILABLE_IN_2_82
+const char *  g_path_buf_get_path       (GPathBuf   *buf);
 
 GLIB_AVAILABLE_IN_2_76
 gboolean      g_path_buf_equal          (gconstpointer v1,
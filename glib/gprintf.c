@@ -23,6 +23,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <errno.h>
+#include <string.h>
 
 #include "gprintf.h"
 #include "gprintfint.h"
@@ -253,6 +254,197 @@ g_vsprintf (gchar	 *string,
   return _g_vsprintf (string, format, args);
 }
 
+static inline void
+printf_simple_append (gchar       *string,
+                      gsize        n,
+                      gsize       *len,
+                      const gchar *str,
+                      gsize        str_len)
+{
+  if (*len + 1 < n)
+    memcpy (string + *len, str, MIN (str_len, n - 1 - *len));
+  *len += str_len;
+}
+
+static void
+printf_simple_append_number (gchar    *string,
+                             gsize     n,
+                             gsize    *len,
+                             guint64   value,
+                             gboolean  negative,
+                             guint     base,
+                             gboolean  upper)
+{
+  const gchar *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+  gchar tmp[24];
+  gsize i = sizeof (tmp);
+
+  do
+    {
+      tmp[--i] = digits[value % base];
+      value /= base;
+    }
+  while (value);
+
+  if (negative)
+    tmp[--i] = '-';
+
+  printf_simple_append (string, n, len, tmp + i, sizeof (tmp) - i);
+}
+
+/* Formats the common subset of printf() conversions which take no flags,
+ * field width or precision (%s, %c, %d, %i, %u, %x and %X, optionally with
+ * the `l`, `ll` or `z` length modifiers, and `%%`) directly, without going
+ * through the full printf implementation, which parses the whole format
+ * into a directive array first.
+ *
+ * Returns -1 if @format needs the full implementation, leaving @args
+ * partially consumed, so it must be a copy. %NULL strings also need the
+ * full implementation, as their output is platform specific. */
+static gssize
+printf_simple (gchar       *string,
+               gsize        n,
+               const gchar *format,
+               va_list      args)
+{
+  const gchar *p = format;
+  gsize len = 0;
+
+  while (*p)
+    {
+      const gchar *pct = strchr (p, '%');
+      gsize chunk = pct ? (gsize) (pct - p) : strlen (p);
+      enum { MOD_NONE, MOD_LONG, MOD_LONG_LONG, MOD_SIZE } mod = MOD_NONE;
+      gboolean is_signed = FALSE;
+      guint base = 10;
+      gchar conversion;
+
+      printf_simple_append (string, n, &len, p, chunk);
+      if (pct == NULL)
+        break;
+
+      p = pct + 1;
+      if (*p == 'l')
+        {
+          p++;
+          mod = MOD_LONG;
+          if (*p == 'l')
+            {
+              p++;
+              mod = MOD_LONG_LONG;
+            }
+        }
+      else if (*p == 'z')
+        {
+          p++;
+          mod = MOD_SIZE;
+        }
+
+      conversion = *p;
+      if (conversion == '\0')
+        return -1;
+      p++;
+
+      switch (conversion)
+        {
+        case '%':
+        case 's':
+        case 'c':
+          if (mod != MOD_NONE)
+            return -1;
+
+          if (conversion == '%')
+            printf_simple_append (string, n, &len, "%", 1);
+          else if (conversion == 's')
+            {
+              const gchar *str = va_arg (args, const gchar *);
+
+              if (str == NULL)
+                return -1;
+              printf_simple_append (string, n, &len, str, strlen (str));
+            }
+          else
+            {
+              gchar c = (gchar) va_arg (args, int);
+
+              printf_simple_append (string, n, &len, &c, 1);
+            }
+          continue;
+
+        case 'd':
+        case 'i':
+          is_signed = TRUE;
+          break;
+        case 'u':
+          break;
+        case 'x':
+        case 'X':
+          base = 16;
+          break;
+        default:
+          return -1;
+        }
+
+      if (is_signed)
+        {
+          gint64 value;
+
+          switch (mod)
+            {
+            case MOD_LONG:
+              value = va_arg (args, long);
+              break;
+            case MOD_LONG_LONG:
+              value = va_arg (args, long long);
+              break;
+            case MOD_SIZE:
+              value = va_arg (args, gssize);
+              break;
+            case MOD_NONE:
+            default:
+              value = va_arg (args, int);
+              break;
+            }
+
+          printf_simple_append_number (string, n, &len,
+                                       value < 0 ? - (guint64) value : (guint64) value,
+                                       value < 0, base, FALSE);
+        }
+      else
+        {
+          guint64 value;
+
+          switch (mod)
+            {
+            case MOD_LONG:
+              value = va_arg (args, unsigned long);
+              break;
+            case MOD_LONG_LONG:
+              value = va_arg (args, unsigned long long);
+              break;
+            case MOD_SIZE:
+              value = va_arg (args, gsize);
+              break;
+            case MOD_NONE:
+            default:
+              value = va_arg (args, unsigned int);
+              break;
+            }
+
+          printf_simple_append_number (string, n, &len, value, FALSE, base,
+                                       conversion == 'X');
+        }
+    }
+
+  if (len > G_MAXINT)
+    return -1;
+
+  if (n > 0)
+    string[MIN (len, n - 1)] = '\0';
+
+  return len;
+}
+
 /**
  * g_vsnprintf:
  * @string: the buffer to hold the output
@@ -289,9 +481,19 @@ g_vsnprintf (gchar	 *string,
 	     gchar const *format,
 	     va_list      args)
 {
+  va_list args2;
+  gssize len;
+
   g_return_val_if_fail (n == 0 || string != NULL, -1);
   g_return_val_if_fail (format != NULL, -1);
 
+  va_copy (args2, args);
+  len = printf_simple (string, n, format, args2);
+  va_end (args2);
+
+  if (len >= 0)
+    return len;
+
   return _g_vsnprintf (string, n, format, args);
 }
 
@@ -326,8 +528,32 @@ g_vasprintf (gchar      **string,
 	     va_list      args)
 {
   gint len;
+  gchar buf[256];
+  gssize simple_len;
+  va_list args2;
+
   g_return_val_if_fail (string != NULL, -1);
 
+  va_copy (args2, args);
+  simple_len = printf_simple (buf, sizeof (buf), format, args2);
+  va_end (args2);
+
+  if (simple_len >= 0)
+    {
+      *string = g_new (gchar, (gsize) simple_len + 1);
+
+      if ((gsize) simple_len < sizeof (buf))
+        memcpy (*string, buf, simple_len + 1);
+      else
+        {
+          va_copy (args2, args);
+          printf_simple (*string, simple_len + 1, format, args2);
+          va_end (args2);
+        }
+
+      return simple_len;
+    }
+
 #if !defined(USE_SYSTEM_PRINTF)
 
   len = _g_gnulib_vasprintf (string, format, args);
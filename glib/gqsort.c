@@ -26,8 +26,11 @@
 #include <string.h>
 #include "galloca.h"
 #include "gmem.h"
+#include "gthreadpool.h"
+#include "gutils.h"
 
 #include "gqsort.h"
+#include "gqsortprivate.h"
 
 #include "gtestutils.h"
 
@@ -87,6 +90,13 @@ msort_with_tmp (const struct msort_param *p, void *b, size_t n)
   msort_with_tmp (p, b1, n1);
   msort_with_tmp (p, b2, n2);
 
+  /* Nothing to merge if the halves are already in order, which makes
+     sorting (partly) sorted input close to linear.  */
+  if (p->var == 3
+      ? (*cmp) (*(const void **) (b2 - s), *(const void **) b2, arg) <= 0
+      : (*cmp) (b2 - s, b2, arg) <= 0)
+    return;
+
   switch (p->var)
     {
     case 0:
@@ -303,3 +313,309 @@ g_qsort_with_data (gconstpointer    pbase,
 {
   msort_r ((gpointer)pbase, total_elems, size, compare_func, user_data);
 }
+
+/* Below this many elements, sorting in parallel isn't worth starting
+ * threads for. */
+#define PARALLEL_SORT_MIN_ELEMS (1 << 16)
+#define PARALLEL_SORT_MAX_CHUNKS 64
+
+typedef struct
+{
+  gsize size;
+  GCompareDataFunc compare_func;
+  gpointer user_data;
+  char *src;
+  char *dest;
+  gsize lo, mid, hi;
+} SortTask;
+
+static void
+sort_task_sort (gpointer data,
+                gpointer user_data)
+{
+  SortTask *task = data;
+
+  msort_r (task->src + task->lo * task->size, task->hi - task->lo,
+           task->size, task->compare_func, task->user_data);
+}
+
+/* Stably merges the sorted runs [lo, mid) and [mid, hi) of src into dest. */
+static void
+sort_task_merge (gpointer data,
+                 gpointer user_data)
+{
+  SortTask *task = data;
+  const gsize s = task->size;
+  const char *b1 = task->src + task->lo * s;
+  const char *b2 = task->src + task->mid * s;
+  const char *end1 = b2;
+  const char *end2 = task->src + task->hi * s;
+  char *out = task->dest + task->lo * s;
+
+  if (b1 < end1 && b2 < end2 &&
+      task->compare_func (end1 - s, b2, task->user_data) > 0)
+    {
+      while (b1 < end1 && b2 < end2)
+        {
+          const char *next;
+
+          if (task->compare_func (b1, b2, task->user_data) <= 0)
+            {
+              next = b1;
+              b1 += s;
+            }
+          else
+            {
+              next = b2;
+              b2 += s;
+            }
+
+          if (s == sizeof (gpointer))
+            memcpy (out, next, sizeof (gpointer));
+          else
+            memcpy (out, next, s);
+          out += s;
+        }
+    }
+
+  memcpy (out, b1, end1 - b1);
+  out += end1 - b1;
+  memcpy (out, b2, end2 - b2);
+}
+
+/* Runs @func on each task, spread over the shared thread pool threads and
+ * the calling thread, and returns when all are done. */
+static void
+sort_tasks_run (GFunc     func,
+                SortTask *tasks,
+                guint     n_tasks)
+{
+  GThreadPool *pool = NULL;
+  guint i;
+
+  if (n_tasks > 1)
+    pool = g_thread_pool_new (func, NULL, n_tasks - 1, FALSE, NULL);
+
+  for (i = 1; i < n_tasks; i++)
+    g_thread_pool_push (pool, &tasks[i], NULL);
+
+  func (&tasks[0], NULL);
+
+  if (pool != NULL)
+    g_thread_pool_free (pool, FALSE, TRUE);
+}
+
+/*
+ * g_qsort_with_data_parallel:
+ * @pbase: (not nullable): start of array to sort
+ * @total_elems: elements in the array
+ * @size: size of each element
+ * @compare_func: (scope call): function to compare elements, which must be
+ *   safe to call from several threads at once
+ * @user_data: data to pass to @compare_func
+ *
+ * Like g_qsort_with_data(), and just as stable, but for large arrays sorts
+ * chunks of the array on separate threads and then merges them.
+ */
+void
+g_qsort_with_data_parallel (gpointer         pbase,
+                            gsize            total_elems,
+                            gsize            size,
+                            GCompareDataFunc compare_func,
+                            gpointer         user_data)
+{
+  SortTask tasks[PARALLEL_SORT_MAX_CHUNKS];
+  guint n_chunks, n_procs, i;
+  char *tmp, *src, *dest;
+  gsize width;
+
+  n_procs = g_get_num_processors ();
+  for (n_chunks = 1;
+       n_chunks * 2 <= MIN (n_procs, PARALLEL_SORT_MAX_CHUNKS) &&
+       total_elems / (n_chunks * 2) >= PARALLEL_SORT_MIN_ELEMS / 2;
+       n_chunks *= 2)
+    ;
+
+  if (n_chunks == 1 || total_elems > G_MAXSIZE / size)
+    {
+      msort_r (pbase, total_elems, size, compare_func, user_data);
+      return;
+    }
+
+  for (i = 0; i < n_chunks; i++)
+    {
+      tasks[i].size = size;
+      tasks[i].compare_func = compare_func;
+      tasks[i].user_data = user_data;
+      tasks[i].src = pbase;
+      tasks[i].lo = total_elems * i / n_chunks;
+      tasks[i].hi = total_elems * (i + 1) / n_chunks;
+    }
+
+  sort_tasks_run (sort_task_sort, tasks, n_chunks);
+
+  /* Merge neighbouring runs pairwise, bouncing between the array and a
+   * temporary copy; merging only neighbours keeps the sort stable. */
+  tmp = g_malloc (total_elems * size);
+  src = pbase;
+  dest = tmp;
+
+  for (width = 1; width < n_chunks; width *= 2)
+    {
+      guint n_tasks = 0;
+
+      for (i = 0; i < n_chunks; i += 2 * width)
+        {
+          SortTask *task = &tasks[n_tasks++];
+
+          task->size = size;
+          task->compare_func = compare_func;
+          task->user_data = user_data;
+          task->src = src;
+          task->dest = dest;
+          task->lo = total_elems * i / n_chunks;
+          task->mid = total_elems * (i + width) / n_chunks;
+          task->hi = total_elems * (i + 2 * width) / n_chunks;
+        }
+
+      sort_tasks_run (sort_task_merge, tasks, n_tasks);
+
+      src = dest;
+      dest = (dest == tmp) ? pbase : tmp;
+    }
+
+  if (src != pbase)
+    memcpy (pbase, src, total_elems * size);
+
+  g_free (tmp);
+}
+
+#define RADIX_SORT_MIN_ELEMS 64
+
+static inline guint64
+radix_sort_key (const guint8 *elem,
+                gsize         size,
+                gboolean      is_signed)
+{
+  guint64 key;
+
+  switch (size)
+    {
+    case 1:
+      key = *elem;
+      break;
+    case 2:
+      {
+        guint16 v;
+        memcpy (&v, elem, sizeof (v));
+        key = v;
+      }
+      break;
+    case 4:
+      {
+        guint32 v;
+        memcpy (&v, elem, sizeof (v));
+        key = v;
+      }
+      break;
+    default:
+      memcpy (&key, elem, sizeof (key));
+      break;
+    }
+
+  /* Flipping the sign bit orders two’s complement values as unsigned */
+  if (is_signed)
+    key ^= G_GUINT64_CONSTANT (1) << (size * 8 - 1);
+
+  return key;
+}
+
+static gint
+radix_sort_compare (gconstpointer a,
+                    gconstpointer b,
+                    gpointer      user_data)
+{
+  gsize size = GPOINTER_TO_SIZE (user_data) >> 1;
+  gboolean is_signed = GPOINTER_TO_SIZE (user_data) & 1;
+  guint64 ka = radix_sort_key (a, size, is_signed);
+  guint64 kb = radix_sort_key (b, size, is_signed);
+
+  return (ka > kb) - (ka < kb);
+}
+
+/*
+ * g_sort_integers:
+ * @base: (not nullable): start of array to sort
+ * @n_elems: elements in the array
+ * @size: size of each element, 1, 2, 4 or 8
+ * @is_signed: whether the elements are signed integers
+ *
+ * Sorts an array of native-endian integers into ascending numerical order,
+ * using a least significant digit radix sort.
+ */
+void
+g_sort_integers (gpointer base,
+                 gsize    n_elems,
+                 gsize    size,
+                 gboolean is_signed)
+{
+  gsize counts[8][256];
+  guint8 *tmp, *src, *dest;
+  gsize digit, i;
+
+  g_return_if_fail (size == 1 || size == 2 || size == 4 || size == 8);
+
+  if (n_elems < RADIX_SORT_MIN_ELEMS || n_elems > G_MAXSIZE / size)
+    {
+      msort_r (base, n_elems, size, radix_sort_compare,
+               GSIZE_TO_POINTER (size << 1 | (is_signed ? 1 : 0)));
+      return;
+    }
+
+  /* Count all the digits in one pass */
+  memset (counts, 0, size * sizeof (counts[0]));
+  for (i = 0, src = base; i < n_elems; i++, src += size)
+    {
+      guint64 key = radix_sort_key (src, size, is_signed);
+
+      for (digit = 0; digit < size; digit++)
+        counts[digit][(key >> (digit * 8)) & 0xff]++;
+    }
+
+  tmp = g_malloc (n_elems * size);
+  src = base;
+  dest = tmp;
+
+  for (digit = 0; digit < size; digit++)
+    {
+      gsize *count = counts[digit];
+      gsize offset = 0;
+      guint8 *elem;
+
+      /* Skip digits on which all the elements agree */
+      if (count[(radix_sort_key (src, size, is_signed) >> (digit * 8)) & 0xff] == n_elems)
+        continue;
+
+      for (i = 0; i < 256; i++)
+        {
+          gsize c = count[i];
+          count[i] = offset;
+          offset += c;
+        }
+
+      for (i = 0, elem = src; i < n_elems; i++, elem += size)
+        {
+          guint64 key = radix_sort_key (elem, size, is_signed);
+          memcpy (dest + count[(key >> (digit * 8)) & 0xff]++ * size, elem, size);
+        }
+
+      elem = src;
+      src = dest;
+      dest = elem;
+    }
+
+  if (src != base)
+    memcpy (base, src, n_elems * size);
+
+  g_free (tmp);
+}
@@ -0,0 +1,38 @@
+/* gqsortprivate.h: Parallel and integer sorting
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __G_QSORT_PRIVATE_H__
+#define __G_QSORT_PRIVATE_H__
+
+#include "gtypes.h"
+
+G_BEGIN_DECLS
+
+void g_qsort_with_data_parallel (gpointer         pbase,
+                                 gsize            total_elems,
+                                 gsize            size,
+                                 GCompareDataFunc compare_func,
+                                 gpointer         user_data);
+void g_sort_integers            (gpointer         base,
+                                 gsize            n_elems,
+                                 gsize            size,
+                                 gboolean         is_signed);
+
+G_END_DECLS
+
+#endif /* __G_QSORT_PRIVATE_H__ */
@@ -37,6 +37,7 @@
 
 #include "gslice.h"
 #include "ghash.h"
+#include "gatomic.h"
 #include "gquark.h"
 #include "gstrfuncs.h"
 #include "gthread.h"
@@ -47,23 +48,141 @@
 
 #define QUARK_BLOCK_SIZE         2048
 #define QUARK_STRING_BLOCK_SIZE (4096 - sizeof (gsize))
+#define QUARK_INDEX_MIN_SIZE     512
+
+/* The string to quark index is an open-addressed hash table which is
+ * only ever appended to, since quarks are never freed. Readers walk it
+ * without taking any lock: writers (holding quark_global) fill in the
+ * hash and quark of a free entry before publishing its string, so any
+ * reader which sees a non-%NULL string also sees the rest of the entry.
+ *
+ * When the index gets half full, a twice as large copy is built and
+ * published in its place. As with the quarks array, the old index is
+ * leaked rather than freed, since lockless readers might still be
+ * walking it; the leaked indexes add up to less than the current one.
+ */
+typedef struct
+{
+  const gchar *string;  /* (atomic) */
+  guint        hash;
+  GQuark       quark;
+} QuarkIndexEntry;
+
+typedef struct
+{
+  gsize           mask;
+  gsize           n_entries;
+  QuarkIndexEntry entries[];
+} QuarkIndex;
 
 static inline GQuark  quark_new (gchar *string);
 
 G_LOCK_DEFINE_STATIC (quark_global);
-static GHashTable    *quark_ht = NULL;
+static QuarkIndex    *quark_index = NULL;  /* (atomic) */
 static gchar        **quarks = NULL;
 static gint           quark_seq_id = 0;
+static gint           quarks_size = 0;
 static gchar         *quark_block = NULL;
 static gint           quark_block_offset = 0;
 
+static QuarkIndex *
+quark_index_new (gsize size)
+{
+  QuarkIndex *index;
+
+  index = g_malloc0 (sizeof (QuarkIndex) + size * sizeof (QuarkIndexEntry));
+  index->mask = size - 1;
+  index->n_entries = 0;
+
+  return index;
+}
+
+/* Lock-free; returns the quark and its canonical string, or 0 and %NULL */
+static inline GQuark
+quark_index_lookup (const gchar  *string,
+                    guint         hash,
+                    const gchar **interned)
+{
+  QuarkIndex *index = g_atomic_pointer_get (&quark_index);
+  gsize i;
+
+  for (i = hash & index->mask; ; i = (i + 1) & index->mask)
+    {
+      QuarkIndexEntry *entry = &index->entries[i];
+      const gchar *entry_string = g_atomic_pointer_get (&entry->string);
+
+      if (entry_string == NULL)
+        break;
+
+      if (entry->hash == hash && strcmp (entry_string, string) == 0)
+        {
+          if (interned != NULL)
+            *interned = entry_string;
+          return entry->quark;
+        }
+    }
+
+  if (interned != NULL)
+    *interned = NULL;
+  return 0;
+}
+
+/* HOLDS: quark_global_lock */
+static void
+quark_index_insert_unlocked (QuarkIndex  *index,
+                             const gchar *string,
+                             guint        hash,
+                             GQuark       quark)
+{
+  gsize i;
+
+  for (i = hash & index->mask;
+       index->entries[i].string != NULL;
+       i = (i + 1) & index->mask)
+    ;
+
+  index->entries[i].hash = hash;
+  index->entries[i].quark = quark;
+  g_atomic_pointer_set (&index->entries[i].string, string);
+  index->n_entries++;
+}
+
+/* HOLDS: quark_global_lock */
+static void
+quark_index_insert (const gchar *string,
+                    guint        hash,
+                    GQuark       quark)
+{
+  QuarkIndex *index = quark_index;
+
+  if ((index->n_entries + 1) * 2 > index->mask + 1)
+    {
+      QuarkIndex *new_index;
+      gsize i;
+
+      new_index = quark_index_new (2 * (index->mask + 1));
+      for (i = 0; i <= index->mask; i++)
+        if (index->entries[i].string != NULL)
+          quark_index_insert_unlocked (new_index,
+                                       index->entries[i].string,
+                                       index->entries[i].hash,
+                                       index->entries[i].quark);
+
+      g_ignore_leak (index);
+      g_atomic_pointer_set (&quark_index, new_index);
+      index = new_index;
+    }
+
+  quark_index_insert_unlocked (index, string, hash, quark);
+}
+
 void
 g_quark_init (void)
 {
   g_assert (quark_seq_id == 0);
-  quark_ht = g_hash_table_new (g_str_hash, g_str_equal);
-  quarks = g_new (gchar*, QUARK_BLOCK_SIZE);
-  quarks[0] = NULL;
+  quark_index = quark_index_new (QUARK_INDEX_MIN_SIZE);
+  quarks = g_new0 (gchar*, QUARK_BLOCK_SIZE);
+  quarks_size = QUARK_BLOCK_SIZE;
   quark_seq_id = 1;
 }
 
@@ -132,16 +251,10 @@ g_quark_init (void)
 GQuark
 g_quark_try_string (const gchar *string)
 {
-  GQuark quark = 0;
-
   if (string == NULL)
     return 0;
 
-  G_LOCK (quark_global);
-  quark = GPOINTER_TO_UINT (g_hash_table_lookup (quark_ht, string));
-  G_UNLOCK (quark_global);
-
-  return quark;
+  return quark_index_lookup (string, g_str_hash_fast (string), NULL);
 }
 
 /* HOLDS: quark_global_lock */
@@ -175,15 +288,18 @@ quark_strdup (const gchar *string)
 /* HOLDS: quark_global_lock */
 static inline GQuark
 quark_from_string (const gchar *string,
+                   guint        hash,
                    gboolean     duplicate)
 {
   GQuark quark = 0;
 
-  quark = GPOINTER_TO_UINT (g_hash_table_lookup (quark_ht, string));
+  /* Looked up again, as another thread may have added it meanwhile */
+  quark = quark_index_lookup (string, hash, NULL);
 
   if (!quark)
     {
       quark = quark_new (duplicate ? quark_strdup (string) : (gchar *)string);
+      quark_index_insert (quarks[quark], hash, quark);
       TRACE(GLIB_QUARK_NEW(string, quark));
     }
 
@@ -195,12 +311,19 @@ quark_from_string_locked (const gchar   *string,
                           gboolean       duplicate)
 {
   GQuark quark = 0;
+  guint hash;
 
   if (!string)
     return 0;
 
+  /* Existing quarks are found without taking the lock */
+  hash = g_str_hash_fast (string);
+  quark = quark_index_lookup (string, hash, NULL);
+  if (quark)
+    return quark;
+
   G_LOCK (quark_global);
-  quark = quark_from_string (string, duplicate);
+  quark = quark_from_string (string, hash, duplicate);
   G_UNLOCK (quark_global);
 
   return quark;
@@ -286,15 +409,17 @@ quark_new (gchar *string)
   GQuark quark;
   gchar **quarks_new;
 
-  if (quark_seq_id % QUARK_BLOCK_SIZE == 0)
+  if (quark_seq_id == quarks_size)
     {
-      quarks_new = g_new (gchar*, quark_seq_id + QUARK_BLOCK_SIZE);
-      if (quark_seq_id != 0)
-        memcpy (quarks_new, quarks, sizeof (char *) * quark_seq_id);
-      memset (quarks_new + quark_seq_id, 0, sizeof (char *) * QUARK_BLOCK_SIZE);
+      /* Double the size, so that applications with many thousands of
+       * quarks (e.g. type names) don't copy the array over and over */
+      quarks_new = g_new (gchar*, quarks_size * 2);
+      memcpy (quarks_new, quarks, sizeof (char *) * quark_seq_id);
+      memset (quarks_new + quark_seq_id, 0, sizeof (char *) * quarks_size);
+      quarks_size *= 2;
       /* This leaks the old quarks array. Its unfortunate, but it allows
-       * us to do lockless lookup of the arrays, and there shouldn't be that
-       * many quarks in an app
+       * us to do lockless lookup of the arrays. With doubling, the leaked
+       * arrays add up to less than the current one.
        */
       g_ignore_leak (g_atomic_pointer_get (&quarks));
       g_atomic_pointer_set (&quarks, quarks_new);
@@ -302,7 +427,6 @@ quark_new (gchar *string)
 
   quark = quark_seq_id;
   g_atomic_pointer_set (&quarks[quark], string);
-  g_hash_table_insert (quark_ht, string, GUINT_TO_POINTER (quark));
   g_atomic_int_inc (&quark_seq_id);
 
   return quark;
@@ -314,12 +438,17 @@ quark_intern_string_locked (const gchar   *string,
 {
   const gchar *result;
   GQuark quark;
+  guint hash;
 
   if (!string)
     return NULL;
 
+  hash = g_str_hash_fast (string);
+  if (quark_index_lookup (string, hash, &result))
+    return result;
+
   G_LOCK (quark_global);
-  quark = quark_from_string (string, duplicate);
+  quark = quark_from_string (string, hash, duplicate);
   result = quarks[quark];
   G_UNLOCK (quark_global);
 
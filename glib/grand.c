@@ -52,6 +52,7 @@
 #include "gtestutils.h"
 #include "gthread.h"
 #include "gtimer.h"
+#include "glib-private.h"
 
 #ifdef G_OS_UNIX
 #include <unistd.h>
@@ -114,10 +115,87 @@ get_random_version (void)
 
 struct _GRand
 {
-  guint32 mt[N]; /* the array for the state vector  */
+  gboolean fast; /* always FALSE, see GFastRand */
   guint mti; 
+  guint32 mt[N]; /* the array for the state vector  */
 };
 
+/* Generators created with g_rand_new_fast() use xoshiro256** instead of
+ * the Mersenne Twister. They are handed out as GRand, and told apart by
+ * @fast, which is at the same offset in both structs. */
+typedef struct
+{
+  gboolean fast; /* always TRUE */
+  guint64 s[4];  /* xoshiro256** state */
+} GFastRand;
+
+#define FAST_RAND(rand) ((GFastRand *) (rand))
+
+static inline guint64
+rotl64 (guint64 x,
+        guint   k)
+{
+  return (x << k) | (x >> (64 - k));
+}
+
+/* xoshiro256** by David Blackman and Sebastiano Vigna, public domain */
+static inline guint64
+fast_rand_next (GFastRand *rand)
+{
+  guint64 *s = rand->s;
+  guint64 result = rotl64 (s[1] * 5, 7) * 9;
+  guint64 t = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotl64 (s[3], 45);
+
+  return result;
+}
+
+/* SplitMix64, used to expand seeds into xoshiro256** state */
+static inline guint64
+splitmix64 (guint64 *x)
+{
+  guint64 z = (*x += G_GUINT64_CONSTANT (0x9e3779b97f4a7c15));
+
+  z = (z ^ (z >> 30)) * G_GUINT64_CONSTANT (0xbf58476d1ce4e5b9);
+  z = (z ^ (z >> 27)) * G_GUINT64_CONSTANT (0x94d049bb133111eb);
+  return z ^ (z >> 31);
+}
+
+static void
+fast_rand_set_seed_array (GFastRand     *rand,
+                          const guint32 *seed,
+                          guint          seed_length)
+{
+  guint64 x = 0;
+  guint i;
+
+  for (i = 0; i < seed_length; i++)
+    x = splitmix64 (&x) ^ seed[i];
+
+  /* SplitMix64 never gives four zeros in a row, which is the one state
+   * xoshiro256** must not be in */
+  for (i = 0; i < G_N_ELEMENTS (rand->s); i++)
+    rand->s[i] = splitmix64 (&x);
+}
+
+static GRand *
+fast_rand_new (const guint32 *seed,
+               guint          seed_length)
+{
+  GFastRand *rand = g_new0 (GFastRand, 1);
+
+  rand->fast = TRUE;
+  fast_rand_set_seed_array (rand, seed, seed_length);
+
+  return (GRand *) rand;
+}
+
 /**
  * g_rand_new_with_seed: (constructor)
  * @seed: a value to initialize the random number generator
@@ -170,6 +248,46 @@ GRand*
 g_rand_new (void)
 {
   guint32 seed[4];
+
+  g_rand_get_seed_from_system (seed);
+
+  return g_rand_new_with_seed_array (seed, 4);
+}
+
+/**
+ * g_rand_new_fast: (constructor)
+ *
+ * Creates a new random number generator which uses the
+ * [xoshiro256**](https://prng.di.unimi.it/) algorithm instead of the
+ * Mersenne Twister, seeded like g_rand_new().
+ *
+ * The generator is much faster and its state is only a few bytes, rather
+ * than 2.5 KB, which makes it a good choice for simulations or for keeping
+ * one generator per thread. Like the Mersenne Twister, it is not suitable
+ * for cryptographic purposes.
+ *
+ * It can be reseeded with g_rand_set_seed() or g_rand_set_seed_array() to
+ * produce a reproducible sequence, which is different from the sequence a
+ * Mersenne Twister generator produces for the same seed.
+ *
+ * Returns: (transfer full): the new #GRand
+ *
+ * Since: 2.82
+ */
+GRand *
+g_rand_new_fast (void)
+{
+  guint32 seed[4];
+
+  g_rand_get_seed_from_system (seed);
+
+  return fast_rand_new (seed, G_N_ELEMENTS (seed));
+}
+
+/* Fills all four words of @seed, from /dev/urandom where possible */
+void
+g_rand_get_seed_from_system (guint32 seed[4])
+{
 #ifdef G_OS_UNIX
   static gboolean dev_urandom_exists = TRUE;
 
@@ -191,7 +309,7 @@ g_rand_new (void)
 	  do
 	    {
 	      errno = 0;
-	      r = fread (seed, sizeof (seed), 1, dev_urandom);
+	      r = fread (seed, 4 * sizeof (guint32), 1, dev_urandom);
 	    }
 	  while G_UNLIKELY (errno == EINTR);
 
@@ -219,7 +337,7 @@ g_rand_new (void)
 #if (defined(_MSC_VER) && _MSC_VER >= 1400) || defined(__MINGW64_VERSION_MAJOR)
   gsize i;
 
-  for (i = 0; i < G_N_ELEMENTS (seed); i++)
+  for (i = 0; i < 4; i++)
     rand_s (&seed[i]);
 #else
 #warning Using insecure seed for random number generation because of missing rand_s() in Windows XP
@@ -233,8 +351,6 @@ g_rand_new (void)
 #endif
 
 #endif
-
-  return g_rand_new_with_seed_array (seed, 4);
 }
 
 /**
@@ -270,8 +386,7 @@ g_rand_copy (GRand *rand)
 
   g_return_val_if_fail (rand != NULL, NULL);
 
-  new_rand = g_new0 (GRand, 1);
-  memcpy (new_rand, rand, sizeof (GRand));
+  new_rand = g_memdup2 (rand, rand->fast ? sizeof (GFastRand) : sizeof (GRand));
 
   return new_rand;
 }
@@ -289,6 +404,12 @@ g_rand_set_seed (GRand   *rand,
 {
   g_return_if_fail (rand != NULL);
 
+  if (rand->fast)
+    {
+      fast_rand_set_seed_array (FAST_RAND (rand), &seed, 1);
+      return;
+    }
+
   switch (get_random_version ())
     {
     case 20:
@@ -344,6 +465,12 @@ g_rand_set_seed_array (GRand         *rand,
   g_return_if_fail (rand != NULL);
   g_return_if_fail (seed_length >= 1);
 
+  if (rand->fast)
+    {
+      fast_rand_set_seed_array (FAST_RAND (rand), seed, seed_length);
+      return;
+    }
+
   g_rand_set_seed (rand, 19650218UL);
 
   i=1; j=0;
@@ -407,6 +534,9 @@ g_rand_int (GRand *rand)
 
   g_return_val_if_fail (rand != NULL, 0);
 
+  if (rand->fast)
+    return fast_rand_next (FAST_RAND (rand)) >> 32;
+
   if (rand->mti >= N) { /* generate N words at one time */
     int kk;
     
@@ -532,9 +662,16 @@ g_rand_int_range (GRand  *rand,
 gdouble 
 g_rand_double (GRand *rand)
 {    
+  gdouble retval;
+
+  /* The top 53 bits of one output give every double in [0..1) with a
+   * spacing of 2^-53 */
+  if (rand->fast)
+    return (fast_rand_next (FAST_RAND (rand)) >> 11) * (1.0 / G_GUINT64_CONSTANT (0x20000000000000));
+
   /* We set all 52 bits after the point for this, not only the first
      32. That's why we need two calls to g_rand_int */
-  gdouble retval = g_rand_int (rand) * G_RAND_DOUBLE_TRANSFORM;
+  retval = g_rand_int (rand) * G_RAND_DOUBLE_TRANSFORM;
   retval = (retval + g_rand_int (rand)) * G_RAND_DOUBLE_TRANSFORM;
 
   /* The following might happen due to very bad rounding luck, but
@@ -568,6 +705,101 @@ g_rand_double_range (GRand   *rand,
   return r * end - (r - 1) * begin;
 }
 
+/**
+ * g_rand_fill_bytes:
+ * @rand_: a #GRand
+ * @buffer: (array length=length) (out caller-allocates): the buffer to fill
+ * @length: the size of @buffer, in bytes
+ *
+ * Fills @buffer with random bytes from @rand_.
+ *
+ * This is equivalent to, but much faster than, storing the bytes of
+ * repeated g_rand_int() calls, especially for generators created with
+ * g_rand_new_fast(), which produce eight bytes per step.
+ *
+ * Since: 2.82
+ */
+void
+g_rand_fill_bytes (GRand  *rand,
+                   guint8 *buffer,
+                   gsize   length)
+{
+  g_return_if_fail (rand != NULL);
+  g_return_if_fail (buffer != NULL || length == 0);
+
+  if (rand->fast)
+    {
+      while (length >= sizeof (guint64))
+        {
+          guint64 r = fast_rand_next (FAST_RAND (rand));
+
+          memcpy (buffer, &r, sizeof (r));
+          buffer += sizeof (r);
+          length -= sizeof (r);
+        }
+
+      if (length > 0)
+        {
+          guint64 r = fast_rand_next (FAST_RAND (rand));
+
+          memcpy (buffer, &r, length);
+        }
+    }
+  else
+    {
+      while (length >= sizeof (guint32))
+        {
+          guint32 r = g_rand_int (rand);
+
+          memcpy (buffer, &r, sizeof (r));
+          buffer += sizeof (r);
+          length -= sizeof (r);
+        }
+
+      if (length > 0)
+        {
+          guint32 r = g_rand_int (rand);
+
+          memcpy (buffer, &r, length);
+        }
+    }
+}
+
+/**
+ * g_rand_fill_doubles:
+ * @rand_: a #GRand
+ * @values: (array length=n_values) (out caller-allocates): the array to fill
+ * @n_values: the number of elements in @values
+ *
+ * Fills @values with random #gdouble values from @rand_, equally
+ * distributed over the range [0..1).
+ *
+ * The result is the same as calling g_rand_double() @n_values times.
+ *
+ * Since: 2.82
+ */
+void
+g_rand_fill_doubles (GRand   *rand,
+                     gdouble *values,
+                     gsize    n_values)
+{
+  gsize i;
+
+  g_return_if_fail (rand != NULL);
+  g_return_if_fail (values != NULL || n_values == 0);
+
+  if (rand->fast)
+    {
+      for (i = 0; i < n_values; i++)
+        values[i] = (fast_rand_next (FAST_RAND (rand)) >> 11) * (1.0 / G_GUINT64_CONSTANT (0x20000000000000));
+    }
+  else
+    {
+      for (i = 0; i < n_values; i++)
+        values[i] = g_rand_double (rand);
+    }
+}
+
 static GRand *
 get_global_random (void)
 {
@@ -580,6 +812,39 @@ get_global_random (void)
   return global_random;
 }
 
+/* Until g_random_set_seed() is called, every thread uses its own fast
+ * generator so that the g_random_* functions don't contend on a lock.
+ * Once a seed has been set, callers expect the sequence it defines, so
+ * everything goes back to the shared generator. */
+static gint global_random_seeded = FALSE;
+static GPrivate thread_random = G_PRIVATE_INIT ((GDestroyNotify) g_rand_free);
+
+static GRand *
+get_thread_random (void)
+{
+  GRand *rand;
+
+  if (g_atomic_int_get (&global_random_seeded))
+    return NULL;
+
+  rand = g_private_get (&thread_random);
+  if (G_UNLIKELY (rand == NULL))
+    {
+      guint32 seed[4];
+      gsize i;
+
+      G_LOCK (global_random);
+      for (i = 0; i < G_N_ELEMENTS (seed); i++)
+        seed[i] = g_rand_int (get_global_random ());
+      G_UNLOCK (global_random);
+
+      rand = fast_rand_new (seed, G_N_ELEMENTS (seed));
+      g_private_set (&thread_random, rand);
+    }
+
+  return rand;
+}
+
 /**
  * g_random_boolean:
  *
@@ -599,7 +864,12 @@ get_global_random (void)
 guint32
 g_random_int (void)
 {
+  GRand *rand = get_thread_random ();
   guint32 result;
+
+  if (rand != NULL)
+    return g_rand_int (rand);
+
   G_LOCK (global_random);
   result = g_rand_int (get_global_random ());
   G_UNLOCK (global_random);
@@ -620,7 +890,12 @@ gint32
 g_random_int_range (gint32 begin,
                     gint32 end)
 {
+  GRand *rand = get_thread_random ();
   gint32 result;
+
+  if (rand != NULL)
+    return g_rand_int_range (rand, begin, end);
+
   G_LOCK (global_random);
   result = g_rand_int_range (get_global_random (), begin, end);
   G_UNLOCK (global_random);
@@ -637,7 +912,12 @@ g_random_int_range (gint32 begin,
 gdouble 
 g_random_double (void)
 {
+  GRand *rand = get_thread_random ();
   double result;
+
+  if (rand != NULL)
+    return g_rand_double (rand);
+
   G_LOCK (global_random);
   result = g_rand_double (get_global_random ());
   G_UNLOCK (global_random);
@@ -658,7 +938,12 @@ gdouble
 g_random_double_range (gdouble begin,
                        gdouble end)
 {
+  GRand *rand = get_thread_random ();
   double result;
+
+  if (rand != NULL)
+    return g_rand_double_range (rand, begin, end);
+
   G_LOCK (global_random);
   result = g_rand_double_range (get_global_random (), begin, end);
   G_UNLOCK (global_random);
@@ -671,11 +956,16 @@ g_random_double_range (gdouble begin,
  * 
  * Sets the seed for the global random number generator, which is used
  * by the g_random_* functions, to @seed.
+ *
+ * Until this is called, the g_random_* functions use a fast per-thread
+ * generator and don't need to take a lock. Afterwards they all share the
+ * seeded generator again, so that they return the sequence it defines.
  */
 void
 g_random_set_seed (guint32 seed)
 {
   G_LOCK (global_random);
   g_rand_set_seed (get_global_random (), seed);
+  g_atomic_int_set (&global_random_seeded, TRUE);
   G_UNLOCK (global_random);
 }
@@ -53,6 +53,8 @@ GRand*  g_rand_new_with_seed_array (const guint32 *seed,
 				    guint seed_length);
 GLIB_AVAILABLE_IN_ALL
 GRand*  g_rand_new            (void);
+GLIB_AVAILABLE_IN_2_82
+GRand*  g_rand_new_fast       (void);
 GLIB_AVAILABLE_IN_ALL
 void    g_rand_free           (GRand   *rand_);
 GLIB_AVAILABLE_IN_ALL
@@ -79,6 +81,14 @@ GLIB_AVAILABLE_IN_ALL
 gdouble g_rand_double_range   (GRand   *rand_,
 			       gdouble  begin,
 			       gdouble  end);
+GLIB_AVAILABLE_IN_2_82
+void    g_rand_fill_bytes     (GRand   *rand_,
+			       guint8  *buffer,
+			       gsize    length);
+GLIB_AVAILABLE_IN_2_82
+void    g_rand_fill_doubles   (GRand   *rand_,
+			       gdouble *values,
+			       gsize    n_values);
 GLIB_AVAILABLE_IN_ALL
 void    g_random_set_seed     (guint32  seed);
 
@@ -22,20 +22,76 @@
 
 #include "grefstring.h"
 
+#include "gatomic.h"
 #include "ghash.h"
 #include "gmessages.h"
 #include "grcbox.h"
+#include "grcboxprivate.h"
 #include "gthread.h"
 
 #include <string.h>
 
-/* A global table of refcounted strings; the hash table does not own
- * the strings, just a pointer to them. Strings are interned as long
- * as they are alive; once their reference count drops to zero, they
- * are removed from the table
+/* A global table of refcounted strings, split into shards by hash so that
+ * threads interning different strings rarely contend; the hash tables do
+ * not own the strings, just a pointer to them. Strings are interned as
+ * long as they are alive; once their reference count drops to zero, they
+ * are removed from their table.
+ *
+ * References are only ever taken from a table with the shard's lock held,
+ * and the last reference to a string is only dropped with it held too, so
+ * a string cannot be found in a table while it is being freed. Releasing
+ * any other reference is a plain atomic decrement.
  */
-G_LOCK_DEFINE_STATIC (interned_ref_strings);
-static GHashTable *interned_ref_strings;
+#define INTERN_N_SHARDS 32
+
+typedef struct
+{
+  GMutex lock;
+  GHashTable *table;
+} InternShard;
+
+static InternShard intern_shards[INTERN_N_SHARDS];
+
+/* Each thread also keeps references to the strings it interned most
+ * recently, so that interning the same string again does not take any
+ * lock. The cache is direct-mapped by hash. */
+#define INTERN_CACHE_SIZE 64
+
+typedef struct
+{
+  guint hash;
+  char *str;  /* (owned) (nullable) */
+} InternCacheEntry;
+
+static void intern_cache_free (gpointer data);
+
+static GPrivate intern_cache = G_PRIVATE_INIT (intern_cache_free);
+
+static inline InternShard *
+intern_shard_for_hash (guint hash)
+{
+  return &intern_shards[(hash * 0x9E3779B1u) >> 27];
+}
+
+G_STATIC_ASSERT (INTERN_N_SHARDS == 1 << (32 - 27));
+
+/* Drops a reference unless it is the last one; returns whether it did */
+static inline gboolean
+ref_string_release_unless_last (char *str)
+{
+  GArcBox *real_box = (GArcBox *) (str - G_ARC_BOX_SIZE);
+  gint ref_count = g_atomic_int_get (&real_box->ref_count);
+
+  while (ref_count > 1)
+    {
+      if (g_atomic_int_compare_and_exchange_full (&real_box->ref_count,
+                                                  ref_count, ref_count - 1,
+                                                  &ref_count))
+        return TRUE;
+    }
+
+  return FALSE;
+}
 
 /**
  * g_ref_string_new:
@@ -127,6 +183,10 @@ interned_str_equal (gconstpointer v1,
  * the same contents of @str, it will return a new reference, instead of
  * creating a new string.
  *
+ * Looking up a string which the calling thread has interned recently does
+ * not take any lock, and threads interning different strings rarely
+ * contend with each other.
+ *
  * Returns: (transfer full) (not nullable): the newly created reference
  *   counted string, or a new reference to an existing string
  *
@@ -135,16 +195,36 @@ interned_str_equal (gconstpointer v1,
 char *
 g_ref_string_new_intern (const char *str)
 {
+  InternCacheEntry *cache, *cache_entry;
+  InternShard *shard;
   char *res;
+  guint hash;
 
   g_return_val_if_fail (str != NULL, NULL);
 
-  G_LOCK (interned_ref_strings);
+  hash = g_str_hash (str);
+
+  cache = g_private_get (&intern_cache);
+  if (G_UNLIKELY (cache == NULL))
+    {
+      cache = g_new0 (InternCacheEntry, INTERN_CACHE_SIZE);
+      g_private_set (&intern_cache, cache);
+    }
+
+  /* The cache holds a reference, so the string cannot go away under us */
+  cache_entry = &cache[hash % INTERN_CACHE_SIZE];
+  if (cache_entry->str != NULL &&
+      cache_entry->hash == hash &&
+      interned_str_equal (cache_entry->str, str))
+    return g_atomic_rc_box_acquire (cache_entry->str);
 
-  if (G_UNLIKELY (interned_ref_strings == NULL))
-    interned_ref_strings = g_hash_table_new (g_str_hash, interned_str_equal);
+  shard = intern_shard_for_hash (hash);
+  g_mutex_lock (&shard->lock);
 
-  res = g_hash_table_lookup (interned_ref_strings, str);
+  if (G_UNLIKELY (shard->table == NULL))
+    shard->table = g_hash_table_new (g_str_hash, interned_str_equal);
+
+  res = g_hash_table_lookup (shard->table, str);
   if (res != NULL)
     {
       /* We acquire the reference while holding the lock, to
@@ -153,13 +233,21 @@ g_ref_string_new_intern (const char *str)
        * on the same string
        */
       g_atomic_rc_box_acquire (res);
-      G_UNLOCK (interned_ref_strings);
-      return res;
+    }
+  else
+    {
+      res = g_ref_string_new (str);
+      g_hash_table_add (shard->table, res);
     }
 
-  res = g_ref_string_new (str);
-  g_hash_table_add (interned_ref_strings, res);
-  G_UNLOCK (interned_ref_strings);
+  /* One reference for the caller, one for the cache */
+  g_atomic_rc_box_acquire (res);
+  g_mutex_unlock (&shard->lock);
+
+  if (cache_entry->str != NULL)
+    g_ref_string_release (cache_entry->str);
+  cache_entry->hash = hash;
+  cache_entry->str = res;
 
   return res;
 }
@@ -183,21 +271,18 @@ g_ref_string_acquire (char *str)
 }
 
 static void
-remove_if_interned (gpointer data)
+intern_cache_free (gpointer data)
 {
-  char *str = data;
-
-  G_LOCK (interned_ref_strings);
+  InternCacheEntry *cache = data;
+  gsize i;
 
-  if (G_LIKELY (interned_ref_strings != NULL))
+  for (i = 0; i < INTERN_CACHE_SIZE; i++)
     {
-      g_hash_table_remove (interned_ref_strings, str);
-
-      if (g_hash_table_size (interned_ref_strings) == 0)
-        g_clear_pointer (&interned_ref_strings, g_hash_table_destroy);
+      if (cache[i].str != NULL)
+        g_ref_string_release (cache[i].str);
     }
 
-  G_UNLOCK (interned_ref_strings);
+  g_free (cache);
 }
 
 /**
@@ -212,9 +297,36 @@ remove_if_interned (gpointer data)
 void
 g_ref_string_release (char *str)
 {
+  InternShard *shard;
+  gboolean interned;
+
   g_return_if_fail (str != NULL);
 
-  g_atomic_rc_box_release_full (str, remove_if_interned);
+  if (ref_string_release_unless_last (str))
+    return;
+
+  /* This may be the last reference to an interned string: drop it with
+   * the shard locked, so that nobody can find the string in the table and
+   * acquire it while it is being freed. Someone may have acquired it just
+   * before we took the lock, in which case it stays. */
+  shard = intern_shard_for_hash (g_str_hash (str));
+  g_mutex_lock (&shard->lock);
+
+  interned = shard->table != NULL &&
+             g_hash_table_lookup (shard->table, str) == str;
+
+  if (interned && ref_string_release_unless_last (str))
+    {
+      g_mutex_unlock (&shard->lock);
+      return;
+    }
+
+  if (interned)
+    g_hash_table_remove (shard->table, str);
+
+  g_mutex_unlock (&shard->lock);
+
+  g_atomic_rc_box_release (str);
 }
 
 /**
@@ -806,6 +806,9 @@ translate_compile_error (gint *errcode, const gchar **errmsg)
 
 /* GMatchInfo */
 
+/* Match info used by g_regex_match_full() when the caller doesn't want one */
+static GPrivate cached_match_info = G_PRIVATE_INIT ((GDestroyNotify) g_match_info_unref);
+
 static GMatchInfo *
 match_info_new (const GRegex     *regex,
                 const gchar      *string,
@@ -855,6 +858,56 @@ match_info_new (const GRegex     *regex,
   return match_info;
 }
 
+/* Re-initialises @match_info for a new match of @regex on @string, keeping
+ * the match context, the JIT stack, the offsets array and, if it has enough
+ * room for all the subpatterns of @regex, the PCRE2 match data. */
+static void
+match_info_reset (GMatchInfo       *match_info,
+                  const GRegex     *regex,
+                  const gchar      *string,
+                  gssize            string_len,
+                  gint              start_position,
+                  GRegexMatchFlags  match_options)
+{
+  if (string_len < 0)
+    string_len = strlen (string);
+
+  if (match_info->regex != regex)
+    {
+      g_clear_pointer (&match_info->regex, g_regex_unref);
+      match_info->regex = g_regex_ref ((GRegex *) regex);
+      pcre2_pattern_info (regex->pcre_re, PCRE2_INFO_CAPTURECOUNT,
+                          &match_info->n_subpatterns);
+    }
+
+  match_info->string = string;
+  match_info->string_len = string_len;
+  match_info->matches = PCRE2_ERROR_NOMATCH;
+  match_info->pos = start_position;
+  match_info->match_opts =
+    get_pcre2_match_options (match_options, regex->orig_compile_opts);
+
+  /* n_offsets is always at least 2 */
+  match_info->offsets[0] = -1;
+  match_info->offsets[1] = -1;
+
+  if (match_info->match_data != NULL &&
+      pcre2_get_ovector_count (match_info->match_data) < match_info->n_subpatterns + 1)
+    g_clear_pointer (&match_info->match_data, pcre2_match_data_free);
+
+  if (match_info->match_data == NULL)
+    match_info->match_data = pcre2_match_data_create_from_pattern (regex->pcre_re,
+                                                                   NULL);
+
+  /* A match info which has been reused for a JIT-compiled regex keeps its
+   * own JIT stack rather than falling back to the small default one. */
+  if (regex->jit_status == JIT_STATUS_ENABLED && match_info->jit_stack == NULL)
+    {
+      match_info->jit_stack = pcre2_jit_stack_create (1 << 15, 1 << 19, NULL);
+      pcre2_jit_stack_assign (match_info->match_context, NULL, match_info->jit_stack);
+    }
+}
+
 static gboolean
 recalc_match_offsets (GMatchInfo *match_info,
                       GError     **error)
@@ -936,9 +989,13 @@ enable_jit_with_match_options (GMatchInfo  *match_info,
       match_info->regex->jit_status = JIT_STATUS_ENABLED;
 
       match_info->regex->jit_options = new_jit_options;
-      /* Set min stack size for JIT to 32KiB and max to 512KiB */
-      match_info->jit_stack = pcre2_jit_stack_create (1 << 15, 1 << 19, NULL);
-      pcre2_jit_stack_assign (match_info->match_context, NULL, match_info->jit_stack);
+      /* Set min stack size for JIT to 32KiB and max to 512KiB, unless a
+       * reused match info already has a stack */
+      if (match_info->jit_stack == NULL)
+        {
+          match_info->jit_stack = pcre2_jit_stack_create (1 << 15, 1 << 19, NULL);
+          pcre2_jit_stack_assign (match_info->match_context, NULL, match_info->jit_stack);
+        }
     }
   else
     {
@@ -1040,7 +1097,7 @@ g_match_info_unref (GMatchInfo *match_info)
 {
   if (g_atomic_int_dec_and_test (&match_info->ref_count))
     {
-      g_regex_unref (match_info->regex);
+      g_clear_pointer (&match_info->regex, g_regex_unref);
       if (match_info->match_context)
         pcre2_match_context_free (match_info->match_context);
       if (match_info->jit_stack)
@@ -2289,17 +2346,104 @@ g_regex_match_full (const GRegex      *regex,
   g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
   g_return_val_if_fail ((match_options & ~G_REGEX_MATCH_MASK) == 0, FALSE);
 
+  if (match_info == NULL)
+    {
+      /* Only a boolean is wanted, so match with the match info cached for
+       * this thread rather than allocating a new one and its match data.
+       * It is taken out of the cache while in use. */
+      info = g_private_get (&cached_match_info);
+      g_private_set (&cached_match_info, NULL);
+
+      if (info == NULL)
+        info = match_info_new (regex, string, string_len, start_position,
+                               match_options, FALSE);
+      else
+        match_info_reset (info, regex, string, string_len, start_position,
+                          match_options);
+
+      match_ok = g_match_info_next (info, error);
+
+      /* Don't keep the regex alive, nor point to the caller's string */
+      g_clear_pointer (&info->regex, g_regex_unref);
+      info->string = NULL;
+      g_private_set (&cached_match_info, info);
+
+      return match_ok;
+    }
+
   info = match_info_new (regex, string, string_len, start_position,
                          match_options, FALSE);
   match_ok = g_match_info_next (info, error);
-  if (match_info != NULL)
-    *match_info = info;
-  else
-    g_match_info_free (info);
+  *match_info = info;
 
   return match_ok;
 }
 
+/**
+ * g_regex_match_reusing:
+ * @regex: a #GRegex structure from g_regex_new()
+ * @string: (array length=string_len): the string to scan for matches
+ * @string_len: the length of @string, in bytes, or -1 if @string is nul-terminated
+ * @match_options: match options
+ * @match_info: (inout) (not optional) (nullable): location of a #GMatchInfo
+ *     to reuse, or of %NULL to create a new one
+ *
+ * Scans for a match in @string for the pattern in @regex, like
+ * g_regex_match_full() with a @start_position of 0, but reusing the
+ * #GMatchInfo stored in @match_info if there is one.
+ *
+ * The #GMatchInfo is reset for the new match, keeping the memory it
+ * allocated for previous matches, so matching many strings, or with many
+ * regular expressions, in a loop does not allocate once it has warmed up.
+ * If @match_info points to %NULL, or to a #GMatchInfo which is also
+ * referenced elsewhere, a new #GMatchInfo is stored in it instead.
+ *
+ * As with g_regex_match(), the #GMatchInfo must be freed once it is no
+ * longer needed, and @string must stay valid while it is used.
+ *
+ * |[<!-- language="C" -->
+ * GMatchInfo *match_info = NULL;
+ *
+ * for (i = 0; lines[i] != NULL; i++)
+ *   {
+ *     if (g_regex_match_reusing (regex, lines[i], -1, 0, &match_info))
+ *       handle_match (match_info);
+ *   }
+ *
+ * g_clear_pointer (&match_info, g_match_info_unref);
+ * ]|
+ *
+ * Returns: %TRUE if the string matched, %FALSE otherwise
+ *
+ * Since: 2.82
+ */
+gboolean
+g_regex_match_reusing (const GRegex      *regex,
+                       const gchar       *string,
+                       gssize             string_len,
+                       GRegexMatchFlags   match_options,
+                       GMatchInfo       **match_info)
+{
+  g_return_val_if_fail (regex != NULL, FALSE);
+  g_return_val_if_fail (string != NULL, FALSE);
+  g_return_val_if_fail (match_info != NULL, FALSE);
+  g_return_val_if_fail ((match_options & ~G_REGEX_MATCH_MASK) == 0, FALSE);
+
+  if (*match_info != NULL && g_atomic_int_get (&(*match_info)->ref_count) == 1)
+    {
+      match_info_reset (*match_info, regex, string, string_len, 0,
+                        match_options);
+    }
+  else
+    {
+      g_clear_pointer (match_info, g_match_info_unref);
+      *match_info = match_info_new (regex, string, string_len, 0,
+                                    match_options, FALSE);
+    }
+
+  return g_match_info_next (*match_info, NULL);
+}
+
 /**
  * g_regex_match_all:
  * @regex: a #GRegex structure from g_regex_new()
@@ -3686,3 +3830,591 @@ g_regex_escape_string (const gchar *string,
 
   return g_string_free (escaped, FALSE);
 }
+
+/* GRegexSet */
+
+typedef struct
+{
+  GRegex *regex;
+  gboolean filtered;            /* whether the pattern has a required literal */
+  gint next_same_literal;       /* next pattern with the same literal, or -1 */
+} RegexSetPattern;
+
+/* A node of the Aho-Corasick automaton built over the required literals */
+typedef struct
+{
+  gint first_pattern;           /* first pattern whose literal ends here, or -1 */
+  guint output_link;            /* next node along the fail chain with patterns, or 0 */
+} RegexSetNode;
+
+struct _GRegexSet
+{
+  gint ref_count;               /* the ref count (atomic) */
+  GRegexMatchFlags match_opts;  /* default match options of the regexes */
+  RegexSetPattern *patterns;
+  guint n_patterns;
+  guint n_filtered;             /* number of patterns with a required literal */
+  guint16 byte_classes[256];    /* columns of the transition table for each byte */
+  guint n_classes;
+  RegexSetNode *nodes;          /* nodes[0] is the root */
+  guint n_nodes;
+  guint *transitions;           /* n_nodes × n_classes, complete automaton */
+};
+
+/* Removes the last character from @run, as a quantifier which may match
+ * zero times makes it optional. */
+static void
+regex_set_literal_drop_last (GString  *run,
+                             gboolean  raw)
+{
+  if (run->len == 0)
+    return;
+
+  if (!raw)
+    {
+      while (run->len > 1 && (run->str[run->len - 1] & 0xC0) == 0x80)
+        run->len--;
+    }
+
+  g_string_truncate (run, run->len - 1);
+}
+
+static void
+regex_set_literal_commit (GString *run,
+                          GString *best)
+{
+  if (run->len > best->len)
+    g_string_assign (best, run->str);
+  g_string_truncate (run, 0);
+}
+
+/* Returns the position of the ']' closing the character class starting at
+ * @p, or %NULL if it can't be found. */
+static const gchar *
+regex_set_skip_class (const gchar *p)
+{
+  p++;
+  if (*p == '^')
+    p++;
+  if (*p == ']')
+    p++;
+
+  for (; *p != '\0'; p++)
+    {
+      if (*p == '\\')
+        {
+          if (p[1] == '\0' || p[1] == 'Q')
+            return NULL;
+          p++;
+        }
+      else if (*p == '[' && (p[1] == ':' || p[1] == '.' || p[1] == '='))
+        {
+          const gchar *q;
+
+          /* POSIX classes such as [:alpha:] contain a ']' of their own */
+          for (q = p + 2; *q != '\0' && !(q[0] == p[1] && q[1] == ']'); q++)
+            ;
+          if (*q != '\0')
+            p = q + 1;
+        }
+      else if (*p == ']')
+        {
+          return p;
+        }
+    }
+
+  return NULL;
+}
+
+/* Extracts a literal which appears in every string matched by @pattern, to
+ * be searched for before running the regex. This is deliberately
+ * conservative: any construct which is not understood makes it return %NULL
+ * (the regex then always runs) or stop looking for further literals. */
+static gchar *
+regex_set_extract_literal (const gchar        *pattern,
+                           GRegexCompileFlags  compile_options)
+{
+  GString *run, *best;
+  gboolean raw = (compile_options & G_REGEX_RAW) != 0;
+  gboolean collect = TRUE;
+  gint depth = 0;
+  const gchar *p;
+
+  if (compile_options & (G_REGEX_CASELESS | G_REGEX_EXTENDED))
+    return NULL;
+
+  run = g_string_new (NULL);
+  best = g_string_new (NULL);
+
+  for (p = pattern; *p != '\0'; p++)
+    {
+      switch (*p)
+        {
+        case '\\':
+          p++;
+          if (*p == '\0' || *p == 'Q')
+            goto none;
+
+          if (g_ascii_isalnum (*p))
+            {
+              regex_set_literal_commit (run, best);
+              /* Escapes such as \x or \p take arguments which look like
+               * literals, so don't go any further */
+              if (strchr ("dDwWsShHvVbBAzZGRXKntrfea", *p) == NULL)
+                collect = FALSE;
+            }
+          else if (collect && depth == 0)
+            {
+              g_string_append_c (run, *p);
+            }
+          break;
+
+        case '[':
+          regex_set_literal_commit (run, best);
+          p = regex_set_skip_class (p);
+          if (p == NULL)
+            goto none;
+          break;
+
+        case '(':
+          regex_set_literal_commit (run, best);
+          /* Options, comments, lookarounds and verbs can change the meaning
+           * of the rest of the pattern */
+          if (p[1] == '*' || (p[1] == '?' && p[2] != ':'))
+            goto none;
+          if (p[1] == '?')
+            p += 2;
+          depth++;
+          break;
+
+        case ')':
+          regex_set_literal_commit (run, best);
+          depth--;
+          break;
+
+        case '|':
+          /* A top-level alternative means no literal is required */
+          if (depth == 0)
+            goto none;
+          regex_set_literal_commit (run, best);
+          break;
+
+        case '?':
+        case '*':
+          regex_set_literal_drop_last (run, raw);
+          regex_set_literal_commit (run, best);
+          break;
+
+        case '{':
+          regex_set_literal_drop_last (run, raw);
+          regex_set_literal_commit (run, best);
+          while (g_ascii_isdigit (p[1]) || p[1] == ',')
+            p++;
+          if (p[1] == '}')
+            p++;
+          break;
+
+        case '+':
+        case '.':
+        case '^':
+        case '$':
+          regex_set_literal_commit (run, best);
+          break;
+
+        default:
+          if (collect && depth == 0)
+            g_string_append_c (run, *p);
+          break;
+        }
+    }
+
+  regex_set_literal_commit (run, best);
+  g_string_free (run, TRUE);
+
+  if (best->len == 0)
+    {
+      g_string_free (best, TRUE);
+      return NULL;
+    }
+
+  return g_string_free (best, FALSE);
+
+none:
+  g_string_free (run, TRUE);
+  g_string_free (best, TRUE);
+  return NULL;
+}
+
+static void
+regex_set_build_automaton (GRegexSet  *set,
+                           gchar     **literals)
+{
+  gsize total_len = 0;
+  guint *fail, *queue;
+  guint head, tail;
+  guint i, c;
+
+  /* Bytes which don't appear in any literal share column 0 */
+  set->n_classes = 1;
+  for (i = 0; i < set->n_patterns; i++)
+    {
+      const gchar *l;
+
+      if (literals[i] == NULL)
+        continue;
+
+      for (l = literals[i]; *l != '\0'; l++)
+        {
+          if (set->byte_classes[(guint8) *l] == 0)
+            set->byte_classes[(guint8) *l] = set->n_classes++;
+        }
+      total_len += l - literals[i];
+    }
+
+  set->nodes = g_new (RegexSetNode, total_len + 1);
+  set->transitions = g_new0 (guint, (total_len + 1) * set->n_classes);
+  set->nodes[0].first_pattern = -1;
+  set->nodes[0].output_link = 0;
+  set->n_nodes = 1;
+
+  /* Build the trie, where 0 means there's no child yet as the root can't
+   * be one */
+  for (i = 0; i < set->n_patterns; i++)
+    {
+      const gchar *l;
+      guint node = 0;
+
+      if (literals[i] == NULL)
+        continue;
+
+      for (l = literals[i]; *l != '\0'; l++)
+        {
+          guint *next = &set->transitions[node * set->n_classes +
+                                          set->byte_classes[(guint8) *l]];
+
+          if (*next == 0)
+            {
+              *next = set->n_nodes++;
+              set->nodes[*next].first_pattern = -1;
+              set->nodes[*next].output_link = 0;
+            }
+          node = *next;
+        }
+
+      set->patterns[i].filtered = TRUE;
+      set->patterns[i].next_same_literal = set->nodes[node].first_pattern;
+      set->nodes[node].first_pattern = i;
+      set->n_filtered++;
+    }
+
+  /* Compute the failure links breadth-first, and complete the transitions
+   * with them so that matching never has to follow a failure link */
+  fail = g_new0 (guint, set->n_nodes);
+  queue = g_new (guint, set->n_nodes);
+  head = tail = 0;
+
+  for (c = 0; c < set->n_classes; c++)
+    {
+      guint child = set->transitions[c];
+
+      if (child != 0)
+        queue[tail++] = child;
+    }
+
+  while (head < tail)
+    {
+      guint node = queue[head++];
+      guint *row = &set->transitions[node * set->n_classes];
+      guint *fail_row = &set->transitions[fail[node] * set->n_classes];
+
+      for (c = 0; c < set->n_classes; c++)
+        {
+          guint child = row[c];
+
+          if (child == 0)
+            {
+              row[c] = fail_row[c];
+              continue;
+            }
+
+          fail[child] = fail_row[c];
+          if (set->nodes[fail[child]].first_pattern != -1)
+            set->nodes[child].output_link = fail[child];
+          else
+            set->nodes[child].output_link = set->nodes[fail[child]].output_link;
+          queue[tail++] = child;
+        }
+    }
+
+  g_free (queue);
+  g_free (fail);
+}
+
+/**
+ * g_regex_set_new:
+ * @patterns: (array zero-terminated=1): the regular expressions
+ * @compile_options: compile options for the regular expressions, or 0
+ * @match_options: match options for the regular expressions, or 0
+ * @error: return location for a #GError
+ *
+ * Compiles a set of regular expressions which can then be matched against
+ * a string all at once with g_regex_set_match().
+ *
+ * Matching many regular expressions one by one scans the string once for
+ * each of them. A #GRegexSet instead extracts a literal substring which
+ * every match of a pattern must contain, when it can find one, and searches
+ * for all of these literals in a single pass over the string. Only the
+ * regular expressions whose literal was found, and those without a
+ * literal, are then run. With patterns such as `"ERROR: disk .* full"`,
+ * this makes the cost of matching grow much more slowly than the number of
+ * patterns.
+ *
+ * Returns: (transfer full) (nullable): a #GRegexSet structure or %NULL if an
+ *   error occurred compiling one of the patterns. Call g_regex_set_unref()
+ *   when you are done with it
+ *
+ * Since: 2.82
+ */
+GRegexSet *
+g_regex_set_new (const gchar * const  *patterns,
+                 GRegexCompileFlags    compile_options,
+                 GRegexMatchFlags      match_options,
+                 GError              **error)
+{
+  GRegexSet *set;
+  gchar **literals;
+  guint i;
+
+  g_return_val_if_fail (patterns != NULL, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  set = g_new0 (GRegexSet, 1);
+  set->ref_count = 1;
+  set->match_opts = match_options;
+  set->n_patterns = g_strv_length ((gchar **) patterns);
+  set->patterns = g_new0 (RegexSetPattern, set->n_patterns);
+
+  for (i = 0; i < set->n_patterns; i++)
+    {
+      set->patterns[i].regex = g_regex_new (patterns[i], compile_options,
+                                            match_options, error);
+      set->patterns[i].next_same_literal = -1;
+
+      if (set->patterns[i].regex == NULL)
+        {
+          g_regex_set_unref (set);
+          return NULL;
+        }
+    }
+
+  literals = g_new0 (gchar *, set->n_patterns);
+  for (i = 0; i < set->n_patterns; i++)
+    literals[i] = regex_set_extract_literal (patterns[i], compile_options);
+
+  regex_set_build_automaton (set, literals);
+
+  for (i = 0; i < set->n_patterns; i++)
+    g_free (literals[i]);
+  g_free (literals);
+
+  return set;
+}
+
+/**
+ * g_regex_set_ref:
+ * @set: a #GRegexSet
+ *
+ * Increases reference count of @set by 1.
+ *
+ * Returns: @set
+ *
+ * Since: 2.82
+ */
+GRegexSet *
+g_regex_set_ref (GRegexSet *set)
+{
+  g_return_val_if_fail (set != NULL, NULL);
+  g_atomic_int_inc (&set->ref_count);
+  return set;
+}
+
+/**
+ * g_regex_set_unref:
+ * @set: a #GRegexSet
+ *
+ * Decreases reference count of @set by 1. When reference count drops
+ * to zero, it frees all the memory associated with the set.
+ *
+ * Since: 2.82
+ */
+void
+g_regex_set_unref (GRegexSet *set)
+{
+  g_return_if_fail (set != NULL);
+
+  if (g_atomic_int_dec_and_test (&set->ref_count))
+    {
+      guint i;
+
+      for (i = 0; i < set->n_patterns; i++)
+        g_clear_pointer (&set->patterns[i].regex, g_regex_unref);
+      g_free (set->patterns);
+      g_free (set->nodes);
+      g_free (set->transitions);
+      g_free (set);
+    }
+}
+
+/**
+ * g_regex_set_get_n_patterns:
+ * @set: a #GRegexSet
+ *
+ * Gets the number of regular expressions in @set.
+ *
+ * Returns: the number of regular expressions
+ *
+ * Since: 2.82
+ */
+guint
+g_regex_set_get_n_patterns (const GRegexSet *set)
+{
+  g_return_val_if_fail (set != NULL, 0);
+
+  return set->n_patterns;
+}
+
+/**
+ * g_regex_set_get_regex:
+ * @set: a #GRegexSet
+ * @index_: the index of a pattern given to g_regex_set_new()
+ *
+ * Gets the compiled regular expression for one of the patterns of @set,
+ * for instance to retrieve the details of a match reported by
+ * g_regex_set_match().
+ *
+ * Returns: (transfer none): the #GRegex for the pattern at @index_
+ *
+ * Since: 2.82
+ */
+GRegex *
+g_regex_set_get_regex (const GRegexSet *set,
+                       guint            index_)
+{
+  g_return_val_if_fail (set != NULL, NULL);
+  g_return_val_if_fail (index_ < set->n_patterns, NULL);
+
+  return set->patterns[index_].regex;
+}
+
+/**
+ * g_regex_set_match:
+ * @set: a #GRegexSet structure from g_regex_set_new()
+ * @string: (array length=string_len): the string to scan for matches
+ * @string_len: the length of @string, in bytes, or -1 if @string is nul-terminated
+ * @match_options: match options
+ * @matches: (out) (optional) (array length=n_matches) (transfer full) (nullable):
+ *     return location for the indices of the matching patterns, in
+ *     increasing order, or %NULL
+ * @n_matches: (out) (optional): return location for the number of
+ *     matching patterns, or %NULL
+ *
+ * Finds which regular expressions of @set match @string. The
+ * @match_options are combined with the match options given to
+ * g_regex_set_new().
+ *
+ * A pattern whose matching fails with an error, for instance because of a
+ * resource limit, is treated as not matching.
+ *
+ * Returns: %TRUE if at least one pattern matched, %FALSE otherwise
+ *
+ * Since: 2.82
+ */
+gboolean
+g_regex_set_match (const GRegexSet   *set,
+                   const gchar       *string,
+                   gssize             string_len,
+                   GRegexMatchFlags   match_options,
+                   guint            **matches,
+                   gsize             *n_matches)
+{
+  GArray *result;
+  guint8 *candidates = NULL;
+  gboolean prefilter, matched;
+  guint i;
+
+  g_return_val_if_fail (set != NULL, FALSE);
+  g_return_val_if_fail (string != NULL, FALSE);
+  g_return_val_if_fail ((match_options & ~G_REGEX_MATCH_MASK) == 0, FALSE);
+
+  if (string_len < 0)
+    string_len = strlen (string);
+
+  /* A partial match doesn't need to contain the literal */
+  prefilter = set->n_filtered > 0 &&
+              !((set->match_opts | match_options) &
+                (G_REGEX_MATCH_PARTIAL_SOFT | G_REGEX_MATCH_PARTIAL_HARD));
+
+  if (prefilter)
+    {
+      guint state = 0;
+      guint n_found = 0;
+      gssize pos;
+
+      candidates = g_new0 (guint8, set->n_patterns);
+
+      for (pos = 0; pos < string_len && n_found < set->n_filtered; pos++)
+        {
+          guint node;
+
+          state = set->transitions[state * set->n_classes +
+                                   set->byte_classes[(guint8) string[pos]]];
+
+          node = (set->nodes[state].first_pattern != -1) ? state : set->nodes[state].output_link;
+          for (; node != 0; node = set->nodes[node].output_link)
+            {
+              gint p;
+
+              for (p = set->nodes[node].first_pattern; p != -1; p = set->patterns[p].next_same_literal)
+                {
+                  if (!candidates[p])
+                    {
+                      candidates[p] = TRUE;
+                      n_found++;
+                    }
+                }
+            }
+        }
+    }
+
+  result = g_array_new (FALSE, FALSE, sizeof (guint));
+
+  for (i = 0; i < set->n_patterns; i++)
+    {
+      if (prefilter && set->patterns[i].filtered && !candidates[i])
+        continue;
+
+      if (g_regex_match_full (set->patterns[i].regex, string, string_len, 0,
+                              match_options, NULL, NULL))
+        g_array_append_val (result, i);
+    }
+
+  g_free (candidates);
+
+  matched = result->len > 0;
+
+  if (n_matches != NULL)
+    *n_matches = result->len;
+
+  if (matches != NULL && matched)
+    {
+      *matches = (guint *) g_array_free (result, FALSE);
+    }
+  else
+    {
+      if (matches != NULL)
+        *matches = NULL;
+      g_array_free (result, TRUE);
+    }
+
+  return matched;
+}
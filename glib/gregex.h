@@ -424,6 +424,16 @@ typedef struct _GRegex		GRegex;
  */
 typedef struct _GMatchInfo	GMatchInfo;
 
+/**
+ * GRegexSet:
+ *
+ * A GRegexSet is an opaque struct holding a set of compiled regular
+ * expressions which can be matched against a string in one go.
+ *
+ * Since: 2.82
+ */
+typedef struct _GRegexSet	GRegexSet;
+
 /**
  * GRegexEvalCallback:
  * @match_info: the #GMatchInfo generated by the match.
@@ -499,6 +509,12 @@ gboolean	  g_regex_match_full		(const GRegex        *regex,
 						 GRegexMatchFlags     match_options,
 						 GMatchInfo         **match_info,
 						 GError             **error);
+GLIB_AVAILABLE_IN_2_82
+gboolean	  g_regex_match_reusing		(const GRegex        *regex,
+						 const gchar         *string,
+						 gssize               string_len,
+						 GRegexMatchFlags     match_options,
+						 GMatchInfo         **match_info);
 GLIB_AVAILABLE_IN_ALL
 gboolean	  g_regex_match_all		(const GRegex        *regex,
 						 const gchar         *string,
@@ -607,6 +623,29 @@ gboolean	  g_match_info_fetch_named_pos	(const GMatchInfo    *match_info,
 GLIB_AVAILABLE_IN_ALL
 gchar		**g_match_info_fetch_all	(const GMatchInfo    *match_info);
 
+/* Regular expression sets. */
+GLIB_AVAILABLE_IN_2_82
+GRegexSet	 *g_regex_set_new		(const gchar * const *patterns,
+						 GRegexCompileFlags   compile_options,
+						 GRegexMatchFlags     match_options,
+						 GError             **error);
+GLIB_AVAILABLE_IN_2_82
+GRegexSet	 *g_regex_set_ref		(GRegexSet           *set);
+GLIB_AVAILABLE_IN_2_82
+void		  g_regex_set_unref		(GRegexSet           *set);
+GLIB_AVAILABLE_IN_2_82
+guint		  g_regex_set_get_n_patterns	(const GRegexSet     *set);
+GLIB_AVAILABLE_IN_2_82
+GRegex		 *g_regex_set_get_regex		(const GRegexSet     *set,
+						 guint                index_);
+GLIB_AVAILABLE_IN_2_82
+gboolean	  g_regex_set_match		(const GRegexSet     *set,
+						 const gchar         *string,
+						 gssize               string_len,
+						 GRegexMatchFlags     match_options,
+						 guint              **matches,
+						 gsize               *n_matches);
+
 G_END_DECLS
 
 #endif  /*  __G_REGEX_H__ */
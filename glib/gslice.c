@@ -26,10 +26,290 @@
 
 #include "gslice.h"
 
+#include "gatomic.h"
+#include "genviron.h"
 #include "gmem.h"               /* gslice.h */
+#include "gthread.h"
+#include "gutils.h"
 #include "glib_trace.h"
 #include "gprintf.h"
+#include "gvalgrind.h"
 
+/* By default, slices are allocated with g_malloc(). Optionally (with
+ * G_SLICE=magazine, or the slice_magazines build option) small slices
+ * are instead served from per-thread magazines: one free list per size
+ * class, which needs no locking. When a magazine runs empty, a full one
+ * is taken from the global depot of that size class, or a new slab of
+ * memory is carved up; when it gets full, it is handed to the depot.
+ * Memory taken from the system this way is kept for reuse, and never
+ * returned.
+ *
+ * Statistics are kept in the depots, so they are only updated on the
+ * slow paths: each thread's counts are added to them whenever it
+ * exchanges a magazine with the depot, and when it exits.
+ */
+
+#define SLICE_ALIGN           (2 * sizeof (gpointer))
+#define SLICE_MAX_CHUNK_SIZE  512
+#define SLICE_N_CLASSES       (SLICE_MAX_CHUNK_SIZE / SLICE_ALIGN)
+#define SLICE_CLASS(size)     (((size) + SLICE_ALIGN - 1) / SLICE_ALIGN - 1)
+#define SLICE_CLASS_SIZE(ix)  (((gsize) (ix) + 1) * SLICE_ALIGN)
+#define SLICE_MAGAZINE_SIZE(ix) (CLAMP (8192 / SLICE_CLASS_SIZE (ix), 16, 128))
+
+typedef enum
+{
+  SLICE_MODE_UNKNOWN = 0,
+  SLICE_MODE_MALLOC,
+  SLICE_MODE_MAGAZINE,
+} SliceMode;
+
+/* Free chunks; the smallest chunk is two pointers */
+typedef struct _SliceChunk SliceChunk;
+struct _SliceChunk
+{
+  SliceChunk *next;
+  SliceChunk *next_magazine;  /* only for the first chunk of a depot magazine */
+};
+
+typedef struct
+{
+  SliceChunk *chunks;
+  guint       count;
+  guint64     n_allocs;  /* not yet added to the depot's */
+  guint64     n_frees;
+} SliceMagazine;
+
+typedef struct
+{
+  SliceMagazine magazines[SLICE_N_CLASSES];
+} SliceThreadCache;
+
+typedef struct
+{
+  GMutex      mutex;
+  SliceChunk *magazines;  /* linked through next_magazine */
+  guint64     n_allocs;
+  guint64     n_frees;
+  guint64     n_depot_hits;
+  guint64     n_slab_refills;
+  guint64     n_depot_returns;
+  guint64     n_contended;
+} SliceDepot;
+
+static void slice_thread_cache_free (gpointer data);
+
+static gint slice_mode = SLICE_MODE_UNKNOWN;  /* (atomic) */
+static SliceDepot slice_depots[SLICE_N_CLASSES];
+static GPrivate slice_thread_cache = G_PRIVATE_INIT (slice_thread_cache_free);
+
+static SliceMode
+slice_mode_init (void)
+{
+  const GDebugKey keys[] = {
+    { "always-malloc", SLICE_MODE_MALLOC },
+    { "magazine", SLICE_MODE_MAGAZINE },
+  };
+  SliceMode mode;
+  guint flags;
+
+#ifdef ENABLE_SLICE_MAGAZINES
+  mode = SLICE_MODE_MAGAZINE;
+#else
+  mode = SLICE_MODE_MALLOC;
+#endif
+
+  flags = g_parse_debug_string (g_getenv ("G_SLICE"), keys, G_N_ELEMENTS (keys));
+  if (flags & SLICE_MODE_MALLOC)
+    mode = SLICE_MODE_MALLOC;
+  else if (flags & SLICE_MODE_MAGAZINE)
+    mode = SLICE_MODE_MAGAZINE;
+
+#ifdef ENABLE_VALGRIND
+  /* Let memory checkers see every allocation */
+  if (RUNNING_ON_VALGRIND)
+    mode = SLICE_MODE_MALLOC;
+#endif
+
+  /* Whichever thread gets here first decides, as switching modes with
+   * slices allocated would be fatal */
+  if (!g_atomic_int_compare_and_exchange (&slice_mode, SLICE_MODE_UNKNOWN, mode))
+    mode = g_atomic_int_get (&slice_mode);
+
+  return mode;
+}
+
+static inline SliceMode
+slice_get_mode (void)
+{
+  SliceMode mode = g_atomic_int_get (&slice_mode);
+
+  if (G_UNLIKELY (mode == SLICE_MODE_UNKNOWN))
+    mode = slice_mode_init ();
+
+  return mode;
+}
+
+static inline gboolean
+slice_use_magazines (gsize mem_size)
+{
+  return slice_get_mode () == SLICE_MODE_MAGAZINE &&
+         mem_size != 0 && mem_size <= SLICE_MAX_CHUNK_SIZE;
+}
+
+static void
+slice_depot_lock (SliceDepot *depot)
+{
+  if (!g_mutex_trylock (&depot->mutex))
+    {
+      g_mutex_lock (&depot->mutex);
+      depot->n_contended++;
+    }
+}
+
+/* HOLDS: depot->mutex */
+static void
+slice_depot_add_counts (SliceDepot    *depot,
+                        SliceMagazine *magazine)
+{
+  depot->n_allocs += magazine->n_allocs;
+  depot->n_frees += magazine->n_frees;
+  magazine->n_allocs = 0;
+  magazine->n_frees = 0;
+}
+
+static SliceThreadCache *
+slice_get_thread_cache (void)
+{
+  SliceThreadCache *cache = g_private_get (&slice_thread_cache);
+
+  if (G_UNLIKELY (cache == NULL))
+    {
+      cache = g_new0 (SliceThreadCache, 1);
+      g_private_set (&slice_thread_cache, cache);
+    }
+
+  return cache;
+}
+
+static void
+slice_magazine_flush (guint          ix,
+                      SliceMagazine *magazine)
+{
+  SliceDepot *depot = &slice_depots[ix];
+
+  slice_depot_lock (depot);
+
+  if (magazine->chunks != NULL)
+    {
+      magazine->chunks->next_magazine = depot->magazines;
+      depot->magazines = magazine->chunks;
+      depot->n_depot_returns++;
+    }
+  slice_depot_add_counts (depot, magazine);
+
+  g_mutex_unlock (&depot->mutex);
+
+  magazine->chunks = NULL;
+  magazine->count = 0;
+}
+
+static void
+slice_magazine_refill (guint          ix,
+                       SliceMagazine *magazine)
+{
+  SliceDepot *depot = &slice_depots[ix];
+  gsize chunk_size = SLICE_CLASS_SIZE (ix);
+  guint n_chunks = SLICE_MAGAZINE_SIZE (ix);
+  SliceChunk *chunks;
+  guint8 *slab;
+  guint i;
+
+  slice_depot_lock (depot);
+
+  chunks = depot->magazines;
+  if (chunks != NULL)
+    {
+      depot->magazines = chunks->next_magazine;
+      depot->n_depot_hits++;
+    }
+  else
+    depot->n_slab_refills++;
+  slice_depot_add_counts (depot, magazine);
+
+  g_mutex_unlock (&depot->mutex);
+
+  if (chunks != NULL)
+    {
+      SliceChunk *chunk;
+
+      /* Magazines flushed at thread exit may not be full */
+      magazine->chunks = chunks;
+      for (magazine->count = 0, chunk = chunks; chunk != NULL; chunk = chunk->next)
+        magazine->count++;
+
+      return;
+    }
+
+  /* Carve up a new slab; it is never freed, but stays reachable
+   * through the free lists */
+  slab = g_malloc (chunk_size * n_chunks);
+  for (i = 0; i < n_chunks; i++)
+    ((SliceChunk *) (slab + i * chunk_size))->next =
+      (i + 1 < n_chunks) ? (SliceChunk *) (slab + (i + 1) * chunk_size) : NULL;
+
+  magazine->chunks = (SliceChunk *) slab;
+  magazine->count = n_chunks;
+}
+
+static void
+slice_thread_cache_free (gpointer data)
+{
+  SliceThreadCache *cache = data;
+  guint ix;
+
+  for (ix = 0; ix < SLICE_N_CLASSES; ix++)
+    if (cache->magazines[ix].chunks != NULL ||
+        cache->magazines[ix].n_allocs != 0 ||
+        cache->magazines[ix].n_frees != 0)
+      slice_magazine_flush (ix, &cache->magazines[ix]);
+
+  g_free (cache);
+}
+
+static inline gpointer
+slice_magazine_alloc (gsize mem_size)
+{
+  guint ix = SLICE_CLASS (mem_size);
+  SliceMagazine *magazine = &slice_get_thread_cache ()->magazines[ix];
+  SliceChunk *chunk;
+
+  if (G_UNLIKELY (magazine->chunks == NULL))
+    slice_magazine_refill (ix, magazine);
+
+  chunk = magazine->chunks;
+  magazine->chunks = chunk->next;
+  magazine->count--;
+  magazine->n_allocs++;
+
+  return chunk;
+}
+
+static inline void
+slice_magazine_free (gsize    mem_size,
+                     gpointer mem_block)
+{
+  guint ix = SLICE_CLASS (mem_size);
+  SliceMagazine *magazine = &slice_get_thread_cache ()->magazines[ix];
+  SliceChunk *chunk = mem_block;
+
+  if (G_UNLIKELY (magazine->count >= SLICE_MAGAZINE_SIZE (ix)))
+    slice_magazine_flush (ix, magazine);
+
+  chunk->next = magazine->chunks;
+  magazine->chunks = chunk;
+  magazine->count++;
+  magazine->n_frees++;
+}
 
 /* --- auxiliary functions --- */
 void
@@ -42,17 +322,86 @@ g_slice_set_config (GSliceConfig ckey,
 gint64
 g_slice_get_config (GSliceConfig ckey)
 {
-  /* deprecated, no implementation */
-  return 0;
+  switch (ckey)
+    {
+    case G_SLICE_CONFIG_ALWAYS_MALLOC:
+    case G_SLICE_CONFIG_BYPASS_MAGAZINES:
+      return slice_get_mode () != SLICE_MODE_MAGAZINE;
+    default:
+      return 0;
+    }
 }
 
+/* Values of G_SLICE_CONFIG_STATISTICS, in order */
+enum
+{
+  SLICE_STAT_CHUNK_SIZE,
+  SLICE_STAT_ALLOCS,
+  SLICE_STAT_FREES,
+  SLICE_STAT_DEPOT_HITS,
+  SLICE_STAT_SLAB_REFILLS,
+  SLICE_STAT_DEPOT_RETURNS,
+  SLICE_N_STATS
+};
+
 gint64*
 g_slice_get_config_state (GSliceConfig ckey,
                           gint64       address,
                           guint       *n_values)
 {
-  /* deprecated, no implementation */
-  return NULL;
+  SliceDepot *depot;
+  gint64 *values;
+  guint ix;
+
+  g_return_val_if_fail (n_values != NULL, NULL);
+
+  *n_values = 0;
+
+  if (slice_get_mode () != SLICE_MODE_MAGAZINE)
+    return NULL;
+
+  switch (ckey)
+    {
+    case G_SLICE_CONFIG_CHUNK_SIZES:
+      values = g_new (gint64, SLICE_N_CLASSES);
+      for (ix = 0; ix < SLICE_N_CLASSES; ix++)
+        values[ix] = SLICE_CLASS_SIZE (ix);
+      *n_values = SLICE_N_CLASSES;
+      return values;
+
+    case G_SLICE_CONFIG_CONTENTION_COUNTER:
+    case G_SLICE_CONFIG_STATISTICS:
+      if (address <= 0 || address > SLICE_MAX_CHUNK_SIZE)
+        return NULL;
+
+      ix = SLICE_CLASS (address);
+      depot = &slice_depots[ix];
+
+      slice_depot_lock (depot);
+      if (ckey == G_SLICE_CONFIG_CONTENTION_COUNTER)
+        {
+          values = g_new (gint64, 1);
+          values[0] = depot->n_contended;
+          *n_values = 1;
+        }
+      else
+        {
+          values = g_new (gint64, SLICE_N_STATS);
+          values[SLICE_STAT_CHUNK_SIZE] = SLICE_CLASS_SIZE (ix);
+          values[SLICE_STAT_ALLOCS] = depot->n_allocs;
+          values[SLICE_STAT_FREES] = depot->n_frees;
+          values[SLICE_STAT_DEPOT_HITS] = depot->n_depot_hits;
+          values[SLICE_STAT_SLAB_REFILLS] = depot->n_slab_refills;
+          values[SLICE_STAT_DEPOT_RETURNS] = depot->n_depot_returns;
+          *n_values = SLICE_N_STATS;
+        }
+      g_mutex_unlock (&depot->mutex);
+
+      return values;
+
+    default:
+      return NULL;
+    }
 }
 
 /* --- API functions --- */
@@ -177,8 +526,12 @@ g_slice_get_config_state (GSliceConfig ckey,
  * The block address handed out can be expected to be aligned
  * to at least `1 * sizeof (void*)`.
  *
- * Since GLib 2.76 this always uses the system malloc() implementation
- * internally.
+ * Since GLib 2.76 this uses the system malloc() implementation
+ * internally, unless the thread-caching allocator has been enabled
+ * with [`G_SLICE=magazine`](running.html#environment-variables) or at
+ * build time. In that case, the block must only ever be freed with
+ * g_slice_free1() (or one of the functions and macros built on it),
+ * passing the same @block_size.
  *
  * Returns: (nullable): a pointer to the allocated memory block, which will
  *   be %NULL if and only if @mem_size is 0
@@ -190,7 +543,10 @@ g_slice_alloc (gsize mem_size)
 {
   gpointer mem;
 
-  mem = g_malloc (mem_size);
+  if (slice_use_magazines (mem_size))
+    mem = slice_magazine_alloc (mem_size);
+  else
+    mem = g_malloc (mem_size);
   TRACE (GLIB_SLICE_ALLOC((void*)mem, mem_size));
 
   return mem;
@@ -263,8 +619,9 @@ g_slice_copy (gsize         mem_size,
  *
  * If @mem_block is %NULL, this function does nothing.
  *
- * Since GLib 2.76 this always uses the system free_sized() implementation
- * internally.
+ * Since GLib 2.76 this uses the system free_sized() implementation
+ * internally, unless
+ * [`G_SLICE=magazine`](running.html#environment-variables) is in effect.
  *
  * Since: 2.10
  */
@@ -274,7 +631,10 @@ g_slice_free1 (gsize    mem_size,
 {
   if (G_UNLIKELY (g_mem_gc_friendly && mem_block))
     memset (mem_block, 0, mem_size);
-  g_free_sized (mem_block, mem_size);
+  if (mem_block != NULL && slice_use_magazines (mem_size))
+    slice_magazine_free (mem_size, mem_block);
+  else
+    g_free_sized (mem_block, mem_size);
   TRACE (GLIB_SLICE_FREE((void*)mem_block, mem_size));
 }
 
@@ -295,8 +655,9 @@ g_slice_free1 (gsize    mem_size,
  *
  * If @mem_chain is %NULL, this function does nothing.
  *
- * Since GLib 2.76 this always uses the system free_sized() implementation
- * internally.
+ * Since GLib 2.76 this uses the system free_sized() implementation
+ * internally, unless
+ * [`G_SLICE=magazine`](running.html#environment-variables) is in effect.
  *
  * Since: 2.10
  */
@@ -306,13 +667,18 @@ g_slice_free_chain_with_offset (gsize    mem_size,
                                 gsize    next_offset)
 {
   gpointer slice = mem_chain;
+  gboolean use_magazines = slice_use_magazines (mem_size);
+
   while (slice)
     {
       guint8 *current = slice;
       slice = *(gpointer *) (current + next_offset);
       if (G_UNLIKELY (g_mem_gc_friendly))
         memset (current, 0, mem_size);
-      g_free_sized (current, mem_size);
+      if (use_magazines)
+        slice_magazine_free (mem_size, current);
+      else
+        g_free_sized (current, mem_size);
     }
 }
 
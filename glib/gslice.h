@@ -97,7 +97,8 @@ typedef enum {
   G_SLICE_CONFIG_WORKING_SET_MSECS,
   G_SLICE_CONFIG_COLOR_INCREMENT,
   G_SLICE_CONFIG_CHUNK_SIZES,
-  G_SLICE_CONFIG_CONTENTION_COUNTER
+  G_SLICE_CONFIG_CONTENTION_COUNTER,
+  G_SLICE_CONFIG_STATISTICS GLIB_AVAILABLE_ENUMERATOR_IN_2_82
 } GSliceConfig;
 
 GLIB_DEPRECATED_IN_2_34
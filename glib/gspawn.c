@@ -98,6 +98,12 @@
 #endif /* __GLIBC__ */
 #endif /* HAVE_POSIX_SPAWN */
 
+/* The highest target fd for which closing descriptors in the child is done
+ * with posix_spawn(). The descriptors below it which are not targets have to
+ * be closed one by one, so keep this small.
+ */
+#define POSIX_SPAWN_MAX_TARGET_FD 255
+
 #ifdef HAVE__NSGETENVIRON
 #define environ (*_NSGetEnviron())
 #else
@@ -762,9 +768,12 @@ g_spawn_async_with_pipes (const gchar          *working_directory,
  * are met:
  *
  * 1. %G_SPAWN_DO_NOT_REAP_CHILD is set
- * 2. %G_SPAWN_LEAVE_DESCRIPTORS_OPEN is set
+ * 2. %G_SPAWN_LEAVE_DESCRIPTORS_OPEN is set, or the C library can close
+ *    descriptors in bulk from `posix_spawn()` (as glibc 2.34 and later can,
+ *    using `close_range()`) and none of @target_fds is above 255
  * 3. %G_SPAWN_SEARCH_PATH_FROM_ENVP is not set
- * 4. @working_directory is %NULL
+ * 4. @working_directory is %NULL, or the C library can change directory
+ *    from `posix_spawn()` (as glibc 2.29 and later can)
  * 5. @child_setup is %NULL
  * 6. The program is of a recognised binary format, or has a shebang.
  *    Otherwise, GLib will have to execute the program through the
@@ -1636,9 +1645,44 @@ read_ints (int      fd,
 }
 
 #ifdef POSIX_SPAWN_AVAILABLE
+/* Whether do_posix_spawn() can run the child in @working_directory. */
+static gboolean
+posix_spawn_can_chdir (const gchar *working_directory)
+{
+#ifdef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCHDIR_NP
+  return TRUE;
+#else
+  return working_directory == NULL;
+#endif
+}
+
+/* Whether do_posix_spawn() can close all the descriptors of the child
+ * other than stdin, stdout, stderr and @target_fds. */
+static gboolean
+posix_spawn_can_close_descriptors (gboolean    close_descriptors,
+                                   const gint *target_fds,
+                                   gsize       n_fds)
+{
+#ifdef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP
+  gsize i;
+
+  for (i = 0; i < n_fds; i++)
+    {
+      if (target_fds[i] > POSIX_SPAWN_MAX_TARGET_FD)
+        return !close_descriptors;
+    }
+
+  return TRUE;
+#else
+  return !close_descriptors;
+#endif
+}
+
 static gboolean
 do_posix_spawn (const gchar * const *argv,
                 const gchar * const *envp,
+                const gchar *working_directory,
+                gboolean    close_descriptors,
                 gboolean    search_path,
                 gboolean    stdout_to_null,
                 gboolean    stderr_to_null,
@@ -1706,6 +1750,19 @@ do_posix_spawn (const gchar * const *argv,
   if (r != 0)
     goto out_free_spawnattr;
 
+#ifdef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCHDIR_NP
+  /* As in do_exec(), change directory before anything else, so that a
+   * relative argv[0] is resolved against @working_directory. */
+  if (working_directory != NULL)
+    {
+      r = posix_spawn_file_actions_addchdir_np (&file_actions, working_directory);
+      if (r != 0)
+        goto out_close_fds;
+    }
+#else
+  g_assert (working_directory == NULL);
+#endif
+
   /* Redirect pipes as required */
 
   if (stdin_fd >= 0)
@@ -1842,6 +1899,41 @@ do_posix_spawn (const gchar * const *argv,
         goto out_close_fds;
     }
 
+#ifdef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP
+  /* Close everything but stdin, stdout, stderr and the target fds. The
+   * duped source fds and anything else above the highest target fd are
+   * closed in one go (with close_range() where the kernel has it), which
+   * leaves the few fds below it which are not targets to be closed one by
+   * one. Closing an fd which is not open is not an error here. */
+  if (close_descriptors)
+    {
+      gint fd;
+
+      g_assert (max_target_fd <= POSIX_SPAWN_MAX_TARGET_FD);
+
+      for (fd = 3; fd < max_target_fd; fd++)
+        {
+          gboolean is_target = FALSE;
+
+          for (i = 0; i < n_fds && !is_target; i++)
+            is_target = (target_fds[i] == fd);
+
+          if (is_target)
+            continue;
+
+          r = posix_spawn_file_actions_addclose (&file_actions, fd);
+          if (r != 0)
+            goto out_close_fds;
+        }
+
+      r = posix_spawn_file_actions_addclosefrom_np (&file_actions, MAX (max_target_fd + 1, 3));
+      if (r != 0)
+        goto out_close_fds;
+    }
+#else
+  g_assert (!close_descriptors);
+#endif
+
   argv_pass = file_and_argv_zero ? argv + 1 : argv;
   if (envp == NULL)
     envp = (const gchar * const *) environ;
@@ -1970,7 +2062,8 @@ fork_exec (gboolean              intermediate_child,
   child_close_fds[n_child_close_fds++] = -1;
 
 #ifdef POSIX_SPAWN_AVAILABLE
-  if (!intermediate_child && working_directory == NULL && !close_descriptors &&
+  if (!intermediate_child && posix_spawn_can_chdir (working_directory) &&
+      posix_spawn_can_close_descriptors (close_descriptors, target_fds, n_fds) &&
       !search_path_from_envp && child_setup == NULL)
     {
       g_trace_mark (G_TRACE_CURRENT_TIME, 0,
@@ -1979,6 +2072,8 @@ fork_exec (gboolean              intermediate_child,
 
       status = do_posix_spawn (argv,
                                envp,
+                               working_directory,
+                               close_descriptors,
                                search_path,
                                stdout_to_null,
                                stderr_to_null,
@@ -1995,12 +2090,12 @@ fork_exec (gboolean              intermediate_child,
       if (status == 0)
         goto success;
 
-      if (status != ENOEXEC)
+      if (status != ENOEXEC && working_directory == NULL)
         {
           g_set_error (error,
                        G_SPAWN_ERROR,
-                       G_SPAWN_ERROR_FAILED,
-                       _("Failed to spawn child process “%s” (%s)"),
+                       _g_spawn_exec_err_to_g_error (status),
+                       _("Failed to execute child process “%s” (%s)"),
                        argv[0],
                        g_strerror (status));
           goto cleanup_and_fail;
@@ -2010,8 +2105,13 @@ fork_exec (gboolean              intermediate_child,
        * some situations on some glibc versions, but that will be fixed.
        * So if it fails with ENOEXEC, we fall through to the regular
        * gspawn codepath so that script execution can be attempted,
-       * per standard gspawn behaviour. */
-      g_debug ("posix_spawn failed (ENOEXEC), fall back to regular gspawn");
+       * per standard gspawn behaviour.
+       *
+       * posix_spawn also can’t tell us whether changing to
+       * @working_directory or executing the program failed, so in that
+       * case fall through too, to report the failure precisely. */
+      g_debug ("posix_spawn failed (%s), fall back to regular gspawn",
+               g_strerror (status));
     }
   else
     {
@@ -2019,8 +2119,8 @@ fork_exec (gboolean              intermediate_child,
                     "GLib", "fork",
                     "posix_spawn avoided %s%s%s%s%s",
                     !intermediate_child ? "" : "(automatic reaping requested) ",
-                    working_directory == NULL ? "" : "(workdir specified) ",
-                    !close_descriptors ? "" : "(fd close requested) ",
+                    posix_spawn_can_chdir (working_directory) ? "" : "(workdir specified) ",
+                    posix_spawn_can_close_descriptors (close_descriptors, target_fds, n_fds) ? "" : "(fd close requested) ",
                     !search_path_from_envp ? "" : "(using envp for search path) ",
                     child_setup == NULL ? "" : "(child_setup specified) ");
     }
@@ -52,6 +52,8 @@
 /* do not include <unistd.h> here, it may interfere with g_strsignal() */
 
 #include "gstrfuncs.h"
+#include "gfloatconvprivate.h"
+#include "gutilsprivate.h"
 
 #include "gprintf.h"
 #include "gprintfint.h"
@@ -689,11 +691,15 @@ g_ascii_strtod (const gchar *nptr,
                 gchar      **endptr)
 {
 #if defined(USE_XLOCALE) && defined(HAVE_STRTOD_L)
+  gdouble val;
 
   g_return_val_if_fail (nptr != NULL, 0);
 
   errno = 0;
 
+  if (g_ascii_strtod_fast (nptr, endptr, &val))
+    return val;
+
   return strtod_l (nptr, endptr, get_C_locale ());
 
 #else
@@ -711,6 +717,12 @@ g_ascii_strtod (const gchar *nptr,
 
   g_return_val_if_fail (nptr != NULL, 0);
 
+  if (g_ascii_strtod_fast (nptr, endptr, &val))
+    {
+      errno = 0;
+      return val;
+    }
+
   fail_pos = NULL;
 
 #ifndef __BIONIC__
@@ -869,6 +881,10 @@ g_ascii_strtod (const gchar *nptr,
  * be larger than [const@GLib.ASCII_DTOSTR_BUF_SIZE] bytes, including the terminating
  * nul character, which is always added.
  *
+ * Since GLib 2.82, the shortest such string is generated, so `0.1` is
+ * formatted as `0.1` rather than `0.10000000000000001`. The layout is
+ * otherwise the same as the `%.17g` format of `printf()`.
+ *
  * Returns: the pointer to the buffer with the converted string
  **/
 gchar *
@@ -876,6 +892,22 @@ g_ascii_dtostr (gchar       *buffer,
                 gint         buf_len,
                 gdouble      d)
 {
+  gchar shortest[G_ASCII_DTOSTR_BUF_SIZE];
+
+  g_return_val_if_fail (buffer != NULL, NULL);
+
+  if (buf_len >= G_ASCII_DTOSTR_BUF_SIZE)
+    {
+      if (g_ascii_dtostr_shortest (buffer, d) > 0)
+        return buffer;
+    }
+  else if (buf_len > 0 && g_ascii_dtostr_shortest (shortest, d) > 0)
+    {
+      g_strlcpy (buffer, shortest, buf_len);
+      return buffer;
+    }
+
+  /* Infinities and NaNs */
   return g_ascii_formatd (buffer, buf_len, "%.17g", d);
 }
 
@@ -2374,6 +2406,385 @@ g_strchomp (gchar *string)
   return string;
 }
 
+/**
+ * GStrTokenIter:
+ *
+ * An opaque structure representing an iteration over the tokens of a
+ * string. It is typically allocated on the stack and initialised with
+ * [method@GLib.StrTokenIter.init] or [method@GLib.StrTokenIter.init_set].
+ *
+ * Unlike [func@GLib.strsplit], the iterator doesn’t allocate anything: each
+ * token is returned as a pointer into the original string and a length, so
+ * it is not nul-terminated.
+ *
+ * ```c
+ * GStrTokenIter iter;
+ * const gchar *field;
+ * gsize field_len;
+ *
+ * g_str_token_iter_init (&iter, line, line_len, ",");
+ * while (g_str_token_iter_next (&iter, &field, &field_len))
+ *   handle_field (field, field_len);
+ * ```
+ *
+ * Since: 2.82
+ */
+
+typedef struct
+{
+  const gchar *position;  /* start of the next token, or NULL when finished */
+  const gchar *end;
+  const gchar *delimiter; /* NULL when splitting at any of a set */
+  gsize delimiter_len;
+  guint32 set[8];         /* bitmap of the delimiters in the set */
+  guint8 set_nibbles[32]; /* the same, as nibble lookup tables; see below */
+  gpointer padding[2];
+} RealTokenIter;
+
+G_STATIC_ASSERT (sizeof (GStrTokenIter) == sizeof (RealTokenIter));
+G_STATIC_ASSERT (G_ALIGNOF (GStrTokenIter) >= G_ALIGNOF (RealTokenIter));
+
+#define TOKEN_SET_CONTAINS(set, c) \
+  (((set)[(guchar) (c) >> 5] >> ((guchar) (c) & 31)) & 1)
+
+/* Looking for any of a set of bytes, 16 at a time, using the “shufti” method
+ * from Hyperscan. Each distinct high nibble in the set is given one of 8
+ * bits, and looking up the low and high nibbles of a byte in the tables
+ * gives values with a common bit iff the byte may be in the set. It
+ * definitely is if there are at most 8 distinct high nibbles; otherwise the
+ * candidates are checked against the bitmap. */
+
+#if defined (HAVE_X86_SIMD_TARGETS)
+#include <immintrin.h>
+#define TOKEN_SET_X86
+#elif defined (__aarch64__) && defined (__ARM_NEON)
+#include <arm_neon.h>
+#define TOKEN_SET_NEON
+#endif
+
+#ifdef TOKEN_SET_X86
+#define TOKEN_SET_SIMD
+
+/* Returns the first delimiter, or where fewer than 16 bytes are left */
+__attribute__ ((target ("ssse3")))
+static const gchar *
+token_find_set_ssse3 (const RealTokenIter *ri,
+                      const gchar         *p)
+{
+  const __m128i lo = _mm_loadu_si128 ((const __m128i *) ri->set_nibbles);
+  const __m128i hi = _mm_loadu_si128 ((const __m128i *) (ri->set_nibbles + 16));
+  const __m128i low_nibbles = _mm_set1_epi8 (0x0f);
+
+  for (; ri->end - p >= 16; p += 16)
+    {
+      __m128i v = _mm_loadu_si128 ((const __m128i *) p);
+      __m128i l = _mm_shuffle_epi8 (lo, _mm_and_si128 (v, low_nibbles));
+      __m128i h = _mm_shuffle_epi8 (hi, _mm_and_si128 (_mm_srli_epi16 (v, 4), low_nibbles));
+      guint candidates = ~_mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm_and_si128 (l, h),
+                                                             _mm_setzero_si128 ())) & 0xffff;
+
+      for (; candidates != 0; candidates &= candidates - 1)
+        {
+          const gchar *c = p + g_bit_nth_lsf (candidates, -1);
+
+          if (TOKEN_SET_CONTAINS (ri->set, *c))
+            return c;
+        }
+    }
+
+  return p;
+}
+
+static inline const gchar *
+token_find_set_simd (const RealTokenIter *ri,
+                     const gchar         *p)
+{
+  if (g_get_cpu_features () & G_CPU_FEATURE_SSSE3)
+    return token_find_set_ssse3 (ri, p);
+
+  return p;
+}
+
+#elif defined (TOKEN_SET_NEON)
+#define TOKEN_SET_SIMD
+
+static inline const gchar *
+token_find_set_simd (const RealTokenIter *ri,
+                     const gchar         *p)
+{
+  const uint8x16_t lo = vld1q_u8 (ri->set_nibbles);
+  const uint8x16_t hi = vld1q_u8 (ri->set_nibbles + 16);
+  const uint8x16_t low_nibbles = vdupq_n_u8 (0x0f);
+
+  for (; ri->end - p >= 16; p += 16)
+    {
+      uint8x16_t v = vld1q_u8 ((const guint8 *) p);
+      uint8x16_t l = vqtbl1q_u8 (lo, vandq_u8 (v, low_nibbles));
+      uint8x16_t h = vqtbl1q_u8 (hi, vshrq_n_u8 (v, 4));
+
+      if (vmaxvq_u8 (vandq_u8 (l, h)) != 0)
+        {
+          gint i;
+
+          for (i = 0; i < 16; i++)
+            if (TOKEN_SET_CONTAINS (ri->set, p[i]))
+              return p + i;
+        }
+    }
+
+  return p;
+}
+
+#endif /* TOKEN_SET_NEON */
+
+static void
+str_token_iter_init (RealTokenIter *ri,
+                     const gchar   *string,
+                     gssize         length)
+{
+  if (length < 0)
+    length = strlen (string);
+
+  /* As with g_strsplit(), the empty string has no tokens */
+  ri->position = (length > 0) ? string : NULL;
+  ri->end = string + length;
+  ri->delimiter = NULL;
+  ri->delimiter_len = 0;
+}
+
+/**
+ * g_str_token_iter_init:
+ * @iter: an uninitialized [struct@GLib.StrTokenIter]
+ * @string: the string to split
+ * @length: the length of @string in bytes, or -1 if it is nul-terminated
+ * @delimiter: the non-empty, nul-terminated string which separates the tokens
+ *
+ * Initializes a token iterator to split @string at each occurrence of
+ * @delimiter, like [func@GLib.strsplit] does.
+ *
+ * Neither @string nor @delimiter is copied, so they must stay valid while
+ * @iter is used.
+ *
+ * Since: 2.82
+ */
+void
+g_str_token_iter_init (GStrTokenIter *iter,
+                       const gchar   *string,
+                       gssize         length,
+                       const gchar   *delimiter)
+{
+  RealTokenIter *ri = (RealTokenIter *) iter;
+
+  g_return_if_fail (iter != NULL);
+  g_return_if_fail (string != NULL || length == 0);
+  g_return_if_fail (delimiter != NULL && delimiter[0] != '\0');
+
+  str_token_iter_init (ri, string, length);
+  ri->delimiter = delimiter;
+  ri->delimiter_len = strlen (delimiter);
+}
+
+/**
+ * g_str_token_iter_init_set:
+ * @iter: an uninitialized [struct@GLib.StrTokenIter]
+ * @string: the string to split
+ * @length: the length of @string in bytes, or -1 if it is nul-terminated
+ * @delimiters: a nul-terminated string containing the bytes which separate
+ *   the tokens. It can be empty, in which case the string is not split
+ *
+ * Initializes a token iterator to split @string at each of the bytes in
+ * @delimiters, like [func@GLib.strsplit_set] does.
+ *
+ * @string is not copied, so it must stay valid while @iter is used.
+ *
+ * Since: 2.82
+ */
+void
+g_str_token_iter_init_set (GStrTokenIter *iter,
+                           const gchar   *string,
+                           gssize         length,
+                           const gchar   *delimiters)
+{
+  RealTokenIter *ri = (RealTokenIter *) iter;
+  guint8 buckets[16];
+  guint n_buckets = 0;
+  const guchar *d;
+
+  g_return_if_fail (iter != NULL);
+  g_return_if_fail (string != NULL || length == 0);
+  g_return_if_fail (delimiters != NULL);
+
+  str_token_iter_init (ri, string, length);
+
+  /* A single distinct byte can be found with memchr() */
+  d = (const guchar *) delimiters;
+  while (*d != '\0' && *d == (guchar) delimiters[0])
+    d++;
+  if (delimiters[0] != '\0' && *d == '\0')
+    {
+      ri->delimiter = delimiters;
+      ri->delimiter_len = 1;
+      return;
+    }
+
+  memset (ri->set, 0, sizeof (ri->set));
+  memset (ri->set_nibbles, 0, sizeof (ri->set_nibbles));
+  memset (buckets, 0xff, sizeof (buckets));
+
+  for (d = (const guchar *) delimiters; *d != '\0'; d++)
+    {
+      guint hi = *d >> 4;
+
+      if (buckets[hi] == 0xff)
+        buckets[hi] = n_buckets++ % 8;
+
+      ri->set[*d >> 5] |= 1u << (*d & 31);
+      ri->set_nibbles[*d & 0x0f] |= 1 << buckets[hi];
+      ri->set_nibbles[16 + hi] = 1 << buckets[hi];
+    }
+}
+
+static const gchar *
+str_token_iter_find (const RealTokenIter *ri,
+                     const gchar         *p)
+{
+  if (ri->delimiter_len == 1)
+    return memchr (p, ri->delimiter[0], ri->end - p);
+
+  if (ri->delimiter != NULL)
+    {
+      while ((p = memchr (p, ri->delimiter[0], ri->end - p)) != NULL)
+        {
+          if ((gsize) (ri->end - p) < ri->delimiter_len)
+            return NULL;
+          if (memcmp (p + 1, ri->delimiter + 1, ri->delimiter_len - 1) == 0)
+            return p;
+          p++;
+        }
+
+      return NULL;
+    }
+
+#ifdef TOKEN_SET_SIMD
+  p = token_find_set_simd (ri, p);
+#endif
+
+  for (; p < ri->end; p++)
+    if (TOKEN_SET_CONTAINS (ri->set, *p))
+      return p;
+
+  return NULL;
+}
+
+/**
+ * g_str_token_iter_next:
+ * @iter: an initialized [struct@GLib.StrTokenIter]
+ * @token: (out) (optional) (transfer none) (array length=token_len): return
+ *   location for the start of the token
+ * @token_len: (out) (optional): return location for the length of the token
+ *
+ * Advances @iter to the next token.
+ *
+ * Tokens are the (possibly empty) pieces of the string between delimiters,
+ * and are not nul-terminated. If the string ends with a delimiter, the last
+ * token is empty. An empty string has no tokens at all.
+ *
+ * Returns: %FALSE if there are no more tokens
+ *
+ * Since: 2.82
+ */
+gboolean
+g_str_token_iter_next (GStrTokenIter  *iter,
+                       const gchar   **token,
+                       gsize          *token_len)
+{
+  RealTokenIter *ri = (RealTokenIter *) iter;
+  const gchar *start, *found;
+
+  g_return_val_if_fail (iter != NULL, FALSE);
+
+  start = ri->position;
+  if (start == NULL)
+    return FALSE;
+
+  found = str_token_iter_find (ri, start);
+  if (found != NULL)
+    ri->position = found + MAX (ri->delimiter_len, 1);
+  else
+    {
+      found = ri->end;
+      ri->position = NULL;
+    }
+
+  if (token != NULL)
+    *token = start;
+  if (token_len != NULL)
+    *token_len = found - start;
+
+  return TRUE;
+}
+
+/**
+ * g_str_token_iter_next_remainder:
+ * @iter: an initialized [struct@GLib.StrTokenIter]
+ * @remainder: (out) (optional) (transfer none) (array length=remainder_len):
+ *   return location for the start of the rest of the string
+ * @remainder_len: (out) (optional): return location for the length of the
+ *   rest of the string
+ *
+ * Returns all of the string which has not been split yet, delimiters
+ * included, as the last token, and finishes the iteration.
+ *
+ * This is how [func@GLib.strsplit] limits the number of tokens.
+ *
+ * Returns: %FALSE if there are no more tokens
+ *
+ * Since: 2.82
+ */
+gboolean
+g_str_token_iter_next_remainder (GStrTokenIter  *iter,
+                                 const gchar   **remainder,
+                                 gsize          *remainder_len)
+{
+  RealTokenIter *ri = (RealTokenIter *) iter;
+
+  g_return_val_if_fail (iter != NULL, FALSE);
+
+  if (ri->position == NULL)
+    return FALSE;
+
+  if (remainder != NULL)
+    *remainder = ri->position;
+  if (remainder_len != NULL)
+    *remainder_len = ri->end - ri->position;
+  ri->position = NULL;
+
+  return TRUE;
+}
+
+static gchar **
+strsplit_tokens (GStrTokenIter *iter,
+                 gint           max_tokens)
+{
+  GPtrArray *string_list;
+  const gchar *token;
+  gsize token_len;
+
+  if (max_tokens < 1)
+    max_tokens = G_MAXINT;
+
+  string_list = g_ptr_array_new ();
+
+  while (--max_tokens > 0 && g_str_token_iter_next (iter, &token, &token_len))
+    g_ptr_array_add (string_list, g_strndup (token, token_len));
+  if (g_str_token_iter_next_remainder (iter, &token, &token_len))
+    g_ptr_array_add (string_list, g_strndup (token, token_len));
+
+  g_ptr_array_add (string_list, NULL);
+
+  return (gchar **) g_ptr_array_free (string_list, FALSE);
+}
+
 /**
  * g_strsplit:
  * @string: a string to split
@@ -2405,46 +2816,15 @@ g_strsplit (const gchar *string,
             const gchar *delimiter,
             gint         max_tokens)
 {
-  char *s;
-  const gchar *remainder;
-  GPtrArray *string_list;
+  GStrTokenIter iter;
 
   g_return_val_if_fail (string != NULL, NULL);
   g_return_val_if_fail (delimiter != NULL, NULL);
   g_return_val_if_fail (delimiter[0] != '\0', NULL);
 
-  if (max_tokens < 1)
-    {
-      max_tokens = G_MAXINT;
-      string_list = g_ptr_array_new ();
-    }
-  else
-    {
-      string_list = g_ptr_array_new_full (max_tokens + 1, NULL);
-    }
-
-  remainder = string;
-  s = strstr (remainder, delimiter);
-  if (s)
-    {
-      gsize delimiter_len = strlen (delimiter);
-
-      while (--max_tokens && s)
-        {
-          gsize len;
-
-          len = s - remainder;
-          g_ptr_array_add (string_list, g_strndup (remainder, len));
-          remainder = s + delimiter_len;
-          s = strstr (remainder, delimiter);
-        }
-    }
-  if (*string)
-    g_ptr_array_add (string_list, g_strdup (remainder));
-
-  g_ptr_array_add (string_list, NULL);
+  g_str_token_iter_init (&iter, string, -1, delimiter);
 
-  return (char **) g_ptr_array_free (string_list, FALSE);
+  return strsplit_tokens (&iter, max_tokens);
 }
 
 /**
@@ -2486,65 +2866,14 @@ g_strsplit_set (const gchar *string,
                 const gchar *delimiters,
                 gint         max_tokens)
 {
-  guint8 delim_table[256]; /* 1 = index is a separator; 0 otherwise */
-  GSList *tokens, *list;
-  gint n_tokens;
-  const gchar *s;
-  const gchar *current;
-  gchar *token;
-  gchar **result;
+  GStrTokenIter iter;
 
   g_return_val_if_fail (string != NULL, NULL);
   g_return_val_if_fail (delimiters != NULL, NULL);
 
-  if (max_tokens < 1)
-    max_tokens = G_MAXINT;
+  g_str_token_iter_init_set (&iter, string, -1, delimiters);
 
-  if (*string == '\0')
-    {
-      result = g_new (char *, 1);
-      result[0] = NULL;
-      return result;
-    }
-
-  /* Check if each character in @string is a separator, by indexing by the
-   * character value into the @delim_table, which has value 1 stored at an index
-   * if that index is a separator. */
-  memset (delim_table, FALSE, sizeof (delim_table));
-  for (s = delimiters; *s != '\0'; ++s)
-    delim_table[*(guchar *)s] = TRUE;
-
-  tokens = NULL;
-  n_tokens = 0;
-
-  s = current = string;
-  while (*s != '\0')
-    {
-      if (delim_table[*(guchar *)s] && n_tokens + 1 < max_tokens)
-        {
-          token = g_strndup (current, s - current);
-          tokens = g_slist_prepend (tokens, token);
-          ++n_tokens;
-
-          current = s + 1;
-        }
-
-      ++s;
-    }
-
-  token = g_strndup (current, s - current);
-  tokens = g_slist_prepend (tokens, token);
-  ++n_tokens;
-
-  result = g_new (gchar *, n_tokens + 1);
-
-  result[n_tokens] = NULL;
-  for (list = tokens; list != NULL; list = list->next)
-    result[--n_tokens] = list->data;
-
-  g_slist_free (tokens);
-
-  return result;
+  return strsplit_tokens (&iter, max_tokens);
 }
 
 /**
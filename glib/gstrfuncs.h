@@ -360,6 +360,39 @@ GLIB_AVAILABLE_IN_ALL
 gchar **	      g_strsplit_set   (const gchar *string,
 					const gchar *delimiters,
 					gint         max_tokens);
+
+typedef struct _GStrTokenIter GStrTokenIter;
+
+struct _GStrTokenIter
+{
+  /*< private >*/
+  const gchar *dummy1;
+  const gchar *dummy2;
+  const gchar *dummy3;
+  gsize        dummy4;
+  guint32      dummy5[8];
+  guint8       dummy6[32];
+  gpointer     dummy7[2];
+};
+
+GLIB_AVAILABLE_IN_2_82
+void                  g_str_token_iter_init           (GStrTokenIter  *iter,
+                                                       const gchar    *string,
+                                                       gssize          length,
+                                                       const gchar    *delimiter);
+GLIB_AVAILABLE_IN_2_82
+void                  g_str_token_iter_init_set       (GStrTokenIter  *iter,
+                                                       const gchar    *string,
+                                                       gssize          length,
+                                                       const gchar    *delimiters);
+GLIB_AVAILABLE_IN_2_82
+gboolean              g_str_token_iter_next           (GStrTokenIter  *iter,
+                                                       const gchar   **token,
+                                                       gsize          *token_len);
+GLIB_AVAILABLE_IN_2_82
+gboolean              g_str_token_iter_next_remainder (GStrTokenIter  *iter,
+                                                       const gchar   **remainder,
+                                                       gsize          *remainder_len);
 GLIB_AVAILABLE_IN_ALL
 gchar*                g_strjoinv       (const gchar  *separator,
 					gchar       **str_array) G_GNUC_MALLOC;
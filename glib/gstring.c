@@ -37,6 +37,8 @@
 #include <ctype.h>
 
 #include "gstring.h"
+#include "gmemarena.h"
+#include "gmemarenaprivate.h"
 #include "guriprivate.h"
 #include "gprintf.h"
 #include "gutilsprivate.h"
@@ -80,6 +82,27 @@ g_string_expand (GString *string,
     string->allocated_len = string->len + len + 1;
 
   string->str = g_realloc (string->str, string->allocated_len);
+  g_mem_advise_large (string->str, string->allocated_len);
+}
+
+static void
+g_string_init (GString *string,
+               gsize    dfl_size)
+{
+  string->allocated_len = 0;
+  string->len   = 0;
+  string->str   = NULL;
+
+  g_string_expand (string, MAX (dfl_size, 64));
+  string->str[0] = 0;
+}
+
+static void
+arena_string_free_segment (gpointer data)
+{
+  GString *string = data;
+
+  g_free (string->str);
 }
 
 static inline void
@@ -106,12 +129,44 @@ g_string_sized_new (gsize dfl_size)
 {
   GString *string = g_slice_new (GString);
 
-  string->allocated_len = 0;
-  string->len   = 0;
-  string->str   = NULL;
+  g_string_init (string, dfl_size);
 
-  g_string_expand (string, MAX (dfl_size, 64));
-  string->str[0] = 0;
+  return string;
+}
+
+/**
+ * g_string_sized_new_in_arena: (constructor)
+ * @arena: (nullable): the #GMemArena to allocate the string in
+ * @dfl_size: the default size of the space allocated to hold the string
+ *
+ * Creates a new #GString like g_string_sized_new(), which belongs to
+ * @arena.
+ *
+ * The structure is allocated from @arena, while the character data is
+ * allocated and grown like that of any other #GString. It is freed
+ * when @arena is reset or freed, after which the string must not be
+ * used. The string must not be freed with g_string_free() or any other
+ * function which frees a #GString; to keep its contents, copy them,
+ * for example with g_strndup().
+ *
+ * If @arena is %NULL this is equivalent to g_string_sized_new().
+ *
+ * Returns: (transfer full): the new #GString
+ *
+ * Since: 2.82
+ */
+GString *
+g_string_sized_new_in_arena (GMemArena *arena,
+                             gsize      dfl_size)
+{
+  GString *string;
+
+  if (arena == NULL)
+    return g_string_sized_new (dfl_size);
+
+  string = g_mem_arena_alloc (arena, sizeof (GString));
+  g_string_init (string, dfl_size);
+  g_mem_arena_add_cleanup (arena, arena_string_free_segment, string);
 
   return string;
 }
@@ -127,17 +182,38 @@ g_string_sized_new (gsize dfl_size)
  */
 GString *
 g_string_new (const gchar *init)
+{
+  return g_string_new_in_arena (NULL, init);
+}
+
+/**
+ * g_string_new_in_arena: (constructor)
+ * @arena: (nullable): the #GMemArena to allocate the string in
+ * @init: (nullable): the initial text to copy into the string, or %NULL to
+ *   start with an empty string
+ *
+ * Creates a new #GString like g_string_new(), which belongs to @arena.
+ *
+ * See g_string_sized_new_in_arena() for how such strings behave.
+ *
+ * Returns: (transfer full): the new #GString
+ *
+ * Since: 2.82
+ */
+GString *
+g_string_new_in_arena (GMemArena   *arena,
+                       const gchar *init)
 {
   GString *string;
 
   if (init == NULL || *init == '\0')
-    string = g_string_sized_new (2);
+    string = g_string_sized_new_in_arena (arena, 2);
   else
     {
       size_t len;
 
       len = strlen (init);
-      string = g_string_sized_new (len + 2);
+      string = g_string_sized_new_in_arena (arena, len + 2);
 
       g_string_append_len (string, init, len);
     }
@@ -416,6 +492,30 @@ GString *
   return string;
 }
 
+/**
+ * g_string_reserve:
+ * @string: a #GString
+ * @len: the length to make room for, in bytes
+ *
+ * Makes sure that @string can hold at least @len bytes, not counting the
+ * nul terminator, without having to be reallocated. The contents and length
+ * of @string are not changed.
+ *
+ * Use this before building a large string whose size is known in advance,
+ * to avoid repeatedly growing (and copying) the buffer.
+ *
+ * Since: 2.82
+ */
+void
+g_string_reserve (GString *string,
+                  gsize    len)
+{
+  g_return_if_fail (string != NULL);
+
+  if (len > string->len)
+    g_string_maybe_expand (string, len - string->len);
+}
+
 /**
  * g_string_set_size:
  * @string: a #GString
@@ -1188,6 +1288,43 @@ g_string_up (GString *string)
   return string;
 }
 
+/* Short results are formatted on the stack, so the common case does not
+ * allocate a temporary string. They are not written straight into the
+ * destination, as the arguments are allowed to point into it. */
+#define G_STRING_PRINTF_STACK_SIZE 256
+
+/* Returns @stack_buf, a newly allocated string, or %NULL on error */
+static gchar *
+g_string_format_va (gchar       *stack_buf,
+                    gsize       *len_out,
+                    const gchar *format,
+                    va_list      args)
+{
+  va_list args2;
+  gchar *buf;
+  gint len;
+
+  va_copy (args2, args);
+  len = g_vsnprintf (stack_buf, G_STRING_PRINTF_STACK_SIZE, format, args2);
+  va_end (args2);
+
+  if (len < 0)
+    return NULL;
+
+  if (len < G_STRING_PRINTF_STACK_SIZE)
+    {
+      *len_out = len;
+      return stack_buf;
+    }
+
+  len = g_vasprintf (&buf, format, args);
+  if (len < 0)
+    return NULL;
+
+  *len_out = len;
+  return buf;
+}
+
 /**
  * g_string_append_vprintf:
  * @string: a #GString
@@ -1206,20 +1343,23 @@ g_string_append_vprintf (GString     *string,
                          const gchar *format,
                          va_list      args)
 {
+  gchar stack_buf[G_STRING_PRINTF_STACK_SIZE];
   gchar *buf;
-  gint len;
+  gsize len;
 
   g_return_if_fail (string != NULL);
   g_return_if_fail (format != NULL);
 
-  len = g_vasprintf (&buf, format, args);
+  buf = g_string_format_va (stack_buf, &len, format, args);
 
-  if (len >= 0)
+  if (buf != NULL)
     {
       g_string_maybe_expand (string, len);
       memcpy (string->str + string->len, buf, len + 1);
       string->len += len;
-      g_free (buf);
+
+      if (buf != stack_buf)
+        g_free (buf);
     }
   else
     {
@@ -1323,3 +1463,439 @@ g_string_append_printf (GString     *string,
   g_string_append_vprintf (string, format, args);
   va_end (args);
 }
+
+/**
+ * GStringBuilder:
+ *
+ * A `GStringBuilder` builds a string in a buffer which is part of the
+ * structure itself, and only moves it to the heap once it grows too big
+ * for that. It is meant to be allocated on the stack, which makes building
+ * short strings, such as log messages, free of any allocation until the
+ * result is wanted as a `GString` or a `gchar*`.
+ *
+ * ```c
+ * g_auto (GStringBuilder) builder = G_STRING_BUILDER_INIT;
+ *
+ * g_string_builder_append (&builder, "Hello ");
+ * g_string_builder_append_printf (&builder, "%s, %d", name, count);
+ * g_print ("%s\n", g_string_builder_get_str (&builder));
+ * ```
+ *
+ * A `GStringBuilder` must not be copied or moved once something has
+ * been appended to it.
+ *
+ * Since: 2.82
+ */
+
+/**
+ * G_STRING_BUILDER_INIT:
+ *
+ * Initializes a #GStringBuilder on the stack. This is equivalent to calling
+ * g_string_builder_init().
+ *
+ * |[<!-- language="C" -->
+ *   g_auto (GStringBuilder) builder = G_STRING_BUILDER_INIT;
+ * ]|
+ *
+ * Since: 2.82
+ */
+
+#define G_STRING_BUILDER_INLINE_SIZE (sizeof (gpointer) * 29)
+
+typedef struct {
+  /* (nullable) (owned); %NULL while @inline_buf holds the string */
+  gchar *heap;
+  gsize len;
+  gsize heap_allocated;
+  gchar inline_buf[G_STRING_BUILDER_INLINE_SIZE];
+} RealStringBuilder;
+
+G_STATIC_ASSERT (sizeof (GStringBuilder) == sizeof (RealStringBuilder));
+
+#define STRING_BUILDER(b) ((RealStringBuilder *) (b))
+
+static inline gchar *
+string_builder_get_buf (RealStringBuilder *rbuilder,
+                        gsize             *allocated_len)
+{
+  if (rbuilder->heap != NULL)
+    {
+      *allocated_len = rbuilder->heap_allocated;
+      return rbuilder->heap;
+    }
+
+  *allocated_len = G_STRING_BUILDER_INLINE_SIZE;
+  return rbuilder->inline_buf;
+}
+
+/* Makes room for @len more bytes plus the nul terminator, and returns the
+ * (possibly moved) buffer */
+static gchar *
+string_builder_maybe_expand (RealStringBuilder *rbuilder,
+                             gsize              len)
+{
+  gsize allocated_len;
+  gchar *buf = string_builder_get_buf (rbuilder, &allocated_len);
+  gsize want_len;
+
+  if (G_LIKELY (rbuilder->len + len < allocated_len))
+    return buf;
+
+  /* Detect potential overflow */
+  if G_UNLIKELY ((G_MAXSIZE - rbuilder->len - 1) < len)
+    g_error ("adding %" G_GSIZE_FORMAT " to string would overflow", len);
+
+  want_len = g_nearest_pow (rbuilder->len + len + 1);
+  if (want_len == 0)
+    want_len = rbuilder->len + len + 1;
+
+  if (rbuilder->heap == NULL)
+    {
+      rbuilder->heap = g_malloc (want_len);
+      memcpy (rbuilder->heap, rbuilder->inline_buf, rbuilder->len + 1);
+    }
+  else
+    {
+      rbuilder->heap = g_realloc (rbuilder->heap, want_len);
+      g_mem_advise_large (rbuilder->heap, want_len);
+    }
+
+  rbuilder->heap_allocated = want_len;
+
+  return rbuilder->heap;
+}
+
+/**
+ * g_string_builder_init:
+ * @builder: an uninitialized #GStringBuilder
+ *
+ * Initializes @builder to hold an empty string.
+ *
+ * Release the resources held by @builder with g_string_builder_clear(),
+ * g_string_builder_clear_to_str() or g_string_builder_clear_to_string().
+ *
+ * Returns: (transfer none): @builder
+ *
+ * Since: 2.82
+ */
+GStringBuilder *
+g_string_builder_init (GStringBuilder *builder)
+{
+  RealStringBuilder *rbuilder = STRING_BUILDER (builder);
+
+  g_return_val_if_fail (builder != NULL, NULL);
+
+  rbuilder->heap = NULL;
+  rbuilder->len = 0;
+  rbuilder->heap_allocated = 0;
+  rbuilder->inline_buf[0] = '\0';
+
+  return builder;
+}
+
+/**
+ * g_string_builder_clear:
+ * @builder: a #GStringBuilder
+ *
+ * Frees the memory held by @builder, and resets it to an empty string.
+ * It is safe to call this function more than once.
+ *
+ * Since: 2.82
+ */
+void
+g_string_builder_clear (GStringBuilder *builder)
+{
+  RealStringBuilder *rbuilder = STRING_BUILDER (builder);
+
+  g_return_if_fail (builder != NULL);
+
+  g_free (rbuilder->heap);
+  g_string_builder_init (builder);
+}
+
+/**
+ * g_string_builder_clear_to_str:
+ * @builder: a #GStringBuilder
+ *
+ * Returns the string built by @builder, and resets it to an empty string.
+ *
+ * If the string has grown too big for the inline buffer of @builder, its
+ * buffer is returned without being copied.
+ *
+ * Returns: (transfer full): the built string, free it with g_free()
+ *
+ * Since: 2.82
+ */
+gchar *
+g_string_builder_clear_to_str (GStringBuilder *builder)
+{
+  RealStringBuilder *rbuilder = STRING_BUILDER (builder);
+  gchar *str;
+
+  g_return_val_if_fail (builder != NULL, NULL);
+
+  if (rbuilder->heap != NULL)
+    str = g_steal_pointer (&rbuilder->heap);
+  else
+    str = g_memdup2 (rbuilder->inline_buf, rbuilder->len + 1);
+
+  g_string_builder_init (builder);
+
+  return str;
+}
+
+/**
+ * g_string_builder_clear_to_string:
+ * @builder: a #GStringBuilder
+ *
+ * Returns the string built by @builder as a #GString, and resets @builder
+ * to an empty string.
+ *
+ * If the string has grown too big for the inline buffer of @builder, its
+ * buffer is handed over to the #GString without being copied.
+ *
+ * Returns: (transfer full): the built string
+ *
+ * Since: 2.82
+ */
+GString *
+g_string_builder_clear_to_string (GStringBuilder *builder)
+{
+  RealStringBuilder *rbuilder = STRING_BUILDER (builder);
+  GString *string;
+
+  g_return_val_if_fail (builder != NULL, NULL);
+
+  if (rbuilder->heap == NULL)
+    {
+      string = g_string_new_len (rbuilder->inline_buf, rbuilder->len);
+    }
+  else
+    {
+      string = g_slice_new (GString);
+      string->str = g_steal_pointer (&rbuilder->heap);
+      string->len = rbuilder->len;
+      string->allocated_len = rbuilder->heap_allocated;
+    }
+
+  g_string_builder_init (builder);
+
+  return string;
+}
+
+/**
+ * g_string_builder_get_str:
+ * @builder: a #GStringBuilder
+ *
+ * Gets the string built so far. It is always nul-terminated, and stays
+ * valid until @builder is next modified.
+ *
+ * Returns: (transfer none): the string
+ *
+ * Since: 2.82
+ */
+const gchar *
+g_string_builder_get_str (const GStringBuilder *builder)
+{
+  const RealStringBuilder *rbuilder = (const RealStringBuilder *) builder;
+
+  g_return_val_if_fail (builder != NULL, NULL);
+
+  return rbuilder->heap != NULL ? rbuilder->heap : rbuilder->inline_buf;
+}
+
+/**
+ * g_string_builder_get_len:
+ * @builder: a #GStringBuilder
+ *
+ * Gets the length of the string built so far, not including the
+ * nul terminator.
+ *
+ * Returns: the length in bytes
+ *
+ * Since: 2.82
+ */
+gsize
+g_string_builder_get_len (const GStringBuilder *builder)
+{
+  g_return_val_if_fail (builder != NULL, 0);
+
+  return ((const RealStringBuilder *) builder)->len;
+}
+
+/**
+ * g_string_builder_truncate:
+ * @builder: a #GStringBuilder
+ * @len: the new length
+ *
+ * Cuts off the end of the string built by @builder, leaving the first
+ * @len bytes. If @len is greater than the current length, this does
+ * nothing. The memory held by @builder is kept, so it can be reused.
+ *
+ * Since: 2.82
+ */
+void
+g_string_builder_truncate (GStringBuilder *builder,
+                           gsize           len)
+{
+  RealStringBuilder *rbuilder = STRING_BUILDER (builder);
+  gchar *buf;
+
+  g_return_if_fail (builder != NULL);
+
+  buf = rbuilder->heap != NULL ? rbuilder->heap : rbuilder->inline_buf;
+  rbuilder->len = MIN (len, rbuilder->len);
+  buf[rbuilder->len] = '\0';
+}
+
+/**
+ * g_string_builder_append_len:
+ * @builder: a #GStringBuilder
+ * @val: data to append
+ * @len: length of @val in bytes, or -1 if it is nul-terminated
+ *
+ * Appends @len bytes of @val to the string built by @builder. @val may
+ * contain embedded nuls, and may point into the string itself.
+ *
+ * Since: 2.82
+ */
+void
+g_string_builder_append_len (GStringBuilder *builder,
+                             const gchar    *val,
+                             gssize          len)
+{
+  RealStringBuilder *rbuilder = STRING_BUILDER (builder);
+  gsize len_unsigned, allocated_len;
+  gchar *buf;
+
+  g_return_if_fail (builder != NULL);
+  g_return_if_fail (len == 0 || val != NULL);
+
+  if (len == 0)
+    return;
+
+  len_unsigned = len < 0 ? strlen (val) : (gsize) len;
+
+  buf = string_builder_get_buf (rbuilder, &allocated_len);
+  if (G_UNLIKELY (rbuilder->len + len_unsigned >= allocated_len))
+    {
+      gchar *new_buf;
+
+      new_buf = string_builder_maybe_expand (rbuilder, len_unsigned);
+
+      /* Appending part of the string to itself */
+      if (val >= buf && val <= buf + rbuilder->len)
+        val = new_buf + (val - buf);
+
+      buf = new_buf;
+    }
+
+  memmove (buf + rbuilder->len, val, len_unsigned);
+  rbuilder->len += len_unsigned;
+  buf[rbuilder->len] = '\0';
+}
+
+/**
+ * g_string_builder_append:
+ * @builder: a #GStringBuilder
+ * @val: a nul-terminated string to append
+ *
+ * Appends @val to the string built by @builder.
+ *
+ * Since: 2.82
+ */
+void
+g_string_builder_append (GStringBuilder *builder,
+                         const gchar    *val)
+{
+  g_return_if_fail (val != NULL);
+
+  g_string_builder_append_len (builder, val, -1);
+}
+
+/**
+ * g_string_builder_append_c:
+ * @builder: a #GStringBuilder
+ * @c: the byte to append
+ *
+ * Appends the byte @c to the string built by @builder.
+ *
+ * Since: 2.82
+ */
+void
+g_string_builder_append_c (GStringBuilder *builder,
+                           gchar           c)
+{
+  RealStringBuilder *rbuilder = STRING_BUILDER (builder);
+  gchar *buf;
+
+  g_return_if_fail (builder != NULL);
+
+  buf = string_builder_maybe_expand (rbuilder, 1);
+  buf[rbuilder->len++] = c;
+  buf[rbuilder->len] = '\0';
+}
+
+/**
+ * g_string_builder_append_vprintf:
+ * @builder: a #GStringBuilder
+ * @format: (not nullable): the string format. See the printf() documentation
+ * @args: the list of arguments to insert in the output
+ *
+ * Appends a formatted string to the string built by @builder. This function
+ * is similar to g_string_builder_append_printf() except that the arguments
+ * to the format string are passed as a va_list.
+ *
+ * Since: 2.82
+ */
+void
+g_string_builder_append_vprintf (GStringBuilder *builder,
+                                 const gchar    *format,
+                                 va_list         args)
+{
+  RealStringBuilder *rbuilder = STRING_BUILDER (builder);
+  gchar stack_buf[G_STRING_PRINTF_STACK_SIZE];
+  gchar *buf, *dest;
+  gsize len;
+
+  g_return_if_fail (builder != NULL);
+  g_return_if_fail (format != NULL);
+
+  buf = g_string_format_va (stack_buf, &len, format, args);
+
+  if (buf != NULL)
+    {
+      dest = string_builder_maybe_expand (rbuilder, len);
+      memcpy (dest + rbuilder->len, buf, len + 1);
+      rbuilder->len += len;
+
+      if (buf != stack_buf)
+        g_free (buf);
+    }
+  else
+    {
+      g_critical ("Failed to append to string: invalid format/args passed to g_vasprintf()");
+    }
+}
+
+/**
+ * g_string_builder_append_printf:
+ * @builder: a #GStringBuilder
+ * @format: the string format. See the printf() documentation
+ * @...: the parameters to insert into the format string
+ *
+ * Appends a formatted string to the string built by @builder.
+ *
+ * Since: 2.82
+ */
+void
+g_string_builder_append_printf (GStringBuilder *builder,
+                                const gchar    *format,
+                                ...)
+{
+  va_list args;
+
+  va_start (args, format);
+  g_string_builder_append_vprintf (builder, format, args);
+  va_end (args);
+}
@@ -34,6 +34,7 @@
 #include <glib/gtypes.h>
 #include <glib/gunicode.h>
 #include <glib/gbytes.h>
+#include <glib/gmemarena.h>
 #include <glib/gstrfuncs.h>
 #include <glib/gutils.h>  /* for G_CAN_INLINE */
 #include <string.h>
@@ -58,6 +59,12 @@ GString*     g_string_new_len           (const gchar     *init,
                                          gssize           len);
 GLIB_AVAILABLE_IN_ALL
 GString*     g_string_sized_new         (gsize            dfl_size);
+GLIB_AVAILABLE_IN_2_82
+GString*     g_string_new_in_arena      (GMemArena       *arena,
+                                         const gchar     *init);
+GLIB_AVAILABLE_IN_2_82
+GString*     g_string_sized_new_in_arena (GMemArena      *arena,
+                                         gsize            dfl_size);
 GLIB_AVAILABLE_IN_ALL
 gchar*      (g_string_free)             (GString         *string,
                                          gboolean         free_segment);
@@ -92,6 +99,9 @@ GString*     g_string_truncate          (GString         *string,
 GLIB_AVAILABLE_IN_ALL
 GString*     g_string_set_size          (GString         *string,
                                          gsize            len);
+GLIB_AVAILABLE_IN_2_82
+void         g_string_reserve           (GString         *string,
+                                         gsize            len);
 GLIB_AVAILABLE_IN_ALL
 GString*     g_string_insert_len        (GString         *string,
                                          gssize           pos,
@@ -181,6 +191,52 @@ GString*     g_string_append_uri_escaped (GString         *string,
                                           const gchar     *reserved_chars_allowed,
                                           gboolean         allow_utf8);
 
+typedef struct _GStringBuilder GStringBuilder;
+
+struct _GStringBuilder
+{
+  /*< private >*/
+  gpointer dummy[32];
+};
+
+#define G_STRING_BUILDER_INIT { { NULL, } } \
+  GLIB_AVAILABLE_MACRO_IN_2_82
+
+GLIB_AVAILABLE_IN_2_82
+GStringBuilder *g_string_builder_init          (GStringBuilder       *builder);
+GLIB_AVAILABLE_IN_2_82
+void            g_string_builder_clear         (GStringBuilder       *builder);
+GLIB_AVAILABLE_IN_2_82
+gchar *         g_string_builder_clear_to_str  (GStringBuilder       *builder) G_GNUC_WARN_UNUSED_RESULT;
+GLIB_AVAILABLE_IN_2_82
+GString *       g_string_builder_clear_to_string (GStringBuilder     *builder) G_GNUC_WARN_UNUSED_RESULT;
+GLIB_AVAILABLE_IN_2_82
+const gchar *   g_string_builder_get_str       (const GStringBuilder *builder);
+GLIB_AVAILABLE_IN_2_82
+gsize           g_string_builder_get_len       (const GStringBuilder *builder);
+GLIB_AVAILABLE_IN_2_82
+void            g_string_builder_truncate      (GStringBuilder       *builder,
+                                                gsize                 len);
+GLIB_AVAILABLE_IN_2_82
+void            g_string_builder_append        (GStringBuilder       *builder,
+                                                const gchar          *val);
+GLIB_AVAILABLE_IN_2_82
+void            g_string_builder_append_len    (GStringBuilder       *builder,
+                                                const gchar          *val,
+                                                gssize                len);
+GLIB_AVAILABLE_IN_2_82
+void            g_string_builder_append_c      (GStringBuilder       *builder,
+                                                gchar                 c);
+GLIB_AVAILABLE_IN_2_82
+void            g_string_builder_append_vprintf (GStringBuilder      *builder,
+                                                 const gchar         *format,
+                                                 va_list              args)
+                                                 G_GNUC_PRINTF(2, 0);
+GLIB_AVAILABLE_IN_2_82
+void            g_string_builder_append_printf (GStringBuilder       *builder,
+                                                const gchar          *format,
+                                                ...) G_GNUC_PRINTF (2, 3);
+
 #ifdef G_CAN_INLINE
 
 #if defined (_MSC_VER) && !defined (__clang__)
@@ -34,9 +34,10 @@
 
 #include "gstringchunk.h"
 
-#include "ghash.h"
-#include "gslist.h"
+#include "gatomic.h"
 #include "gmessages.h"
+#include "gslist.h"
+#include "gthread.h"
 
 #include "gutils.h"
 #include "gutilsprivate.h"
@@ -67,17 +68,92 @@
  *
  * To free the entire `GStringChunk` use [method@GLib.StringChunk.free].
  * It is not possible to free individual strings.
+ *
+ * A `GStringChunk` is not thread-safe, unless it was created with
+ * [func@GLib.StringChunk.new_concurrent].
+ */
+
+/* Strings are appended to blocks, each of which belongs to a lane. A
+ * plain chunk has one lane; a concurrent one has several, each with its own
+ * lock, and every thread appends to the lane its #GThread hashes to, so
+ * that threads rarely contend.
+ *
+ * Strings added with g_string_chunk_insert_const() are also recorded in an
+ * open-addressed index which is only appended to until the chunk is
+ * cleared. Lookups walk it without any lock: writers (holding const_lock in
+ * a concurrent chunk) fill in an entry before atomically publishing its
+ * string, as for the quark index. When the index gets half full, a twice
+ * as large copy replaces it; as concurrent readers may still be walking
+ * the old one, it is only freed when the chunk is cleared or freed.
  */
+#define STRING_CHUNK_N_LANES       16
+#define STRING_CHUNK_INDEX_MIN_SIZE 64
+
+typedef struct _StringChunkBlock StringChunkBlock;
+
+struct _StringChunkBlock
+{
+  StringChunkBlock *next;
+  gsize             size;
+  gchar             data[];
+};
+
+typedef struct
+{
+  GMutex            lock;        /* only used if the chunk is concurrent */
+  StringChunkBlock *blocks;      /* most recent first */
+  gsize             storage_next;
+} StringChunkLane;
+
+typedef struct
+{
+  const gchar *string;  /* (atomic) */
+  gsize        len;
+  guint        hash;
+} StringChunkEntry;
+
+typedef struct
+{
+  gsize            mask;
+  gsize            n_entries;
+  StringChunkEntry entries[];
+} StringChunkIndex;
 
 struct _GStringChunk
 {
-  GHashTable *const_table;
-  GSList     *storage_list;
-  gsize       storage_next;
-  gsize       this_size;
-  gsize       default_size;
+  StringChunkIndex *const_index;   /* (atomic) (nullable) */
+  GSList           *old_indexes;   /* (element-type StringChunkIndex) */
+  GMutex            const_lock;
+
+  gboolean          concurrent;
+  guint             n_lanes;
+  StringChunkLane  *lanes;
+
+  GMutex            spare_lock;
+  StringChunkBlock *spare_blocks;  /* blocks of default_size kept by clear */
+  gsize             default_size;
 };
 
+static GStringChunk *
+string_chunk_new (gsize    size,
+                  gboolean concurrent)
+{
+  GStringChunk *new_chunk = g_new0 (GStringChunk, 1);
+  guint i;
+
+  new_chunk->default_size = g_nearest_pow (MAX (1, size));
+  new_chunk->concurrent = concurrent;
+  new_chunk->n_lanes = concurrent ? STRING_CHUNK_N_LANES : 1;
+  new_chunk->lanes = g_new0 (StringChunkLane, new_chunk->n_lanes);
+
+  g_mutex_init (&new_chunk->const_lock);
+  g_mutex_init (&new_chunk->spare_lock);
+  for (i = 0; i < new_chunk->n_lanes; i++)
+    g_mutex_init (&new_chunk->lanes[i].lock);
+
+  return new_chunk;
+}
+
 /**
  * g_string_chunk_new: (constructor)
  * @size: the default size of the blocks of memory which are
@@ -92,18 +168,51 @@ struct _GStringChunk
 GStringChunk *
 g_string_chunk_new (gsize size)
 {
-  GStringChunk *new_chunk = g_new (GStringChunk, 1);
-  gsize actual_size = 1;
+  return string_chunk_new (size, FALSE);
+}
 
-  actual_size = g_nearest_pow (MAX (1, size));
+/**
+ * g_string_chunk_new_concurrent: (constructor)
+ * @size: the default size of the blocks of memory which are
+ *     allocated to store the strings, as for g_string_chunk_new()
+ *
+ * Creates a new #GStringChunk which strings can be inserted into from
+ * several threads at once.
+ *
+ * Threads append to separate blocks, so they rarely wait for each other,
+ * and g_string_chunk_insert_const() finds strings which are already in
+ * the chunk without taking any lock.
+ *
+ * g_string_chunk_clear() and g_string_chunk_free() must still not be
+ * called while other threads use the chunk.
+ *
+ * Returns: (transfer full): a new #GStringChunk
+ *
+ * Since: 2.82
+ */
+GStringChunk *
+g_string_chunk_new_concurrent (gsize size)
+{
+  return string_chunk_new (size, TRUE);
+}
 
-  new_chunk->const_table  = NULL;
-  new_chunk->storage_list = NULL;
-  new_chunk->storage_next = actual_size;
-  new_chunk->default_size = actual_size;
-  new_chunk->this_size    = actual_size;
+static void
+string_chunk_free_blocks (StringChunkBlock *block)
+{
+  while (block != NULL)
+    {
+      StringChunkBlock *next = block->next;
 
-  return new_chunk;
+      g_free (block);
+      block = next;
+    }
+}
+
+static void
+string_chunk_free_indexes (GStringChunk *chunk)
+{
+  g_clear_pointer (&chunk->const_index, g_free);
+  g_slist_free_full (g_steal_pointer (&chunk->old_indexes), g_free);
 }
 
 /**
@@ -117,14 +226,21 @@ g_string_chunk_new (gsize size)
 void
 g_string_chunk_free (GStringChunk *chunk)
 {
-  g_return_if_fail (chunk != NULL);
+  guint i;
 
-  if (chunk->storage_list)
-    g_slist_free_full (chunk->storage_list, g_free);
+  g_return_if_fail (chunk != NULL);
 
-  if (chunk->const_table)
-    g_hash_table_destroy (chunk->const_table);
+  for (i = 0; i < chunk->n_lanes; i++)
+    {
+      string_chunk_free_blocks (chunk->lanes[i].blocks);
+      g_mutex_clear (&chunk->lanes[i].lock);
+    }
+  string_chunk_free_blocks (chunk->spare_blocks);
+  string_chunk_free_indexes (chunk);
 
+  g_mutex_clear (&chunk->const_lock);
+  g_mutex_clear (&chunk->spare_lock);
+  g_free (chunk->lanes);
   g_free (chunk);
 }
 
@@ -136,24 +252,255 @@ g_string_chunk_free (GStringChunk *chunk)
  * After calling g_string_chunk_clear() it is not safe to
  * access any of the strings which were contained within it.
  *
+ * Since 2.82, blocks of the default size are kept and reused for the
+ * strings inserted afterwards, so clearing and refilling a chunk does
+ * not allocate memory again.
+ *
  * Since: 2.14
  */
 void
 g_string_chunk_clear (GStringChunk *chunk)
 {
+  guint i;
+
   g_return_if_fail (chunk != NULL);
 
-  if (chunk->storage_list)
+  for (i = 0; i < chunk->n_lanes; i++)
+    {
+      StringChunkLane *lane = &chunk->lanes[i];
+      StringChunkBlock *block = lane->blocks;
+
+      while (block != NULL)
+        {
+          StringChunkBlock *next = block->next;
+
+          /* Larger blocks were allocated for single large strings */
+          if (block->size == chunk->default_size)
+            {
+              block->next = chunk->spare_blocks;
+              chunk->spare_blocks = block;
+            }
+          else
+            g_free (block);
+
+          block = next;
+        }
+
+      lane->blocks = NULL;
+      lane->storage_next = 0;
+    }
+
+  string_chunk_free_indexes (chunk);
+}
+
+static StringChunkLane *
+string_chunk_lock_lane (GStringChunk *chunk)
+{
+  StringChunkLane *lane;
+  guint64 hash;
+
+  if (!chunk->concurrent)
+    return &chunk->lanes[0];
+
+  hash = (guint64) GPOINTER_TO_SIZE (g_thread_self ()) * G_GUINT64_CONSTANT (0x9e3779b97f4a7c15);
+  lane = &chunk->lanes[(hash >> 32) % chunk->n_lanes];
+  g_mutex_lock (&lane->lock);
+
+  return lane;
+}
+
+static void
+string_chunk_unlock_lane (GStringChunk    *chunk,
+                          StringChunkLane *lane)
+{
+  if (chunk->concurrent)
+    g_mutex_unlock (&lane->lock);
+}
+
+static gchar *
+string_chunk_append (GStringChunk *chunk,
+                     const gchar  *string,
+                     gsize         size)
+{
+  StringChunkLane *lane;
+  StringChunkBlock *block;
+  gchar *pos;
+
+  lane = string_chunk_lock_lane (chunk);
+  block = lane->blocks;
+
+  if (block == NULL ||
+      (G_MAXSIZE - lane->storage_next < size + 1) ||
+      (lane->storage_next + size + 1) > block->size)
+    {
+      gsize new_size = g_nearest_pow (MAX (chunk->default_size, size + 1));
+
+      /* If size is bigger than G_MAXSIZE / 2 then store it in its own
+       * allocation instead of failing here */
+      if (new_size == 0)
+        new_size = size + 1;
+
+      block = NULL;
+      if (new_size == chunk->default_size)
+        {
+          if (chunk->concurrent)
+            g_mutex_lock (&chunk->spare_lock);
+          block = chunk->spare_blocks;
+          if (block != NULL)
+            chunk->spare_blocks = block->next;
+          if (chunk->concurrent)
+            g_mutex_unlock (&chunk->spare_lock);
+        }
+
+      if (block == NULL)
+        {
+          if (new_size > G_MAXSIZE - sizeof (StringChunkBlock))
+            g_error ("%s: failed to allocate %" G_GSIZE_FORMAT " bytes",
+                     G_STRLOC, new_size);
+          block = g_malloc (sizeof (StringChunkBlock) + new_size);
+          block->size = new_size;
+        }
+
+      block->next = lane->blocks;
+      lane->blocks = block;
+      lane->storage_next = 0;
+    }
+
+  pos = block->data + lane->storage_next;
+  lane->storage_next += size + 1;
+
+  string_chunk_unlock_lane (chunk, lane);
+
+  /* The space is ours now, so copy outside of the lock */
+  memcpy (pos, string, size);
+  pos[size] = '\0';
+
+  return pos;
+}
+
+/* A hash which takes the length into account and consumes eight bytes at a
+ * time, rather than g_str_hash()'s one */
+static guint
+string_chunk_hash (const gchar *string,
+                   gsize        len)
+{
+  guint64 h = (guint64) len * G_GUINT64_CONSTANT (0x9e3779b97f4a7c15);
+  guint64 w;
+
+  while (len >= sizeof (w))
     {
-      g_slist_free_full (chunk->storage_list, g_free);
+      memcpy (&w, string, sizeof (w));
+      h = (h ^ w) * G_GUINT64_CONSTANT (0xbf58476d1ce4e5b9);
+      h ^= h >> 29;
+      string += sizeof (w);
+      len -= sizeof (w);
+    }
 
-      chunk->storage_list = NULL;
-      chunk->storage_next = chunk->default_size;
-      chunk->this_size    = chunk->default_size;
+  if (len > 0)
+    {
+      w = 0;
+      memcpy (&w, string, len);
+      h = (h ^ w) * G_GUINT64_CONSTANT (0xbf58476d1ce4e5b9);
     }
 
-  if (chunk->const_table)
-      g_hash_table_remove_all (chunk->const_table);
+  h ^= h >> 32;
+  return (guint) h;
+}
+
+static StringChunkIndex *
+string_chunk_index_new (gsize size)
+{
+  StringChunkIndex *index;
+
+  index = g_malloc0 (sizeof (StringChunkIndex) + size * sizeof (StringChunkEntry));
+  index->mask = size - 1;
+  index->n_entries = 0;
+
+  return index;
+}
+
+/* Lock-free */
+static gchar *
+string_chunk_index_lookup (StringChunkIndex *index,
+                           const gchar      *string,
+                           gsize             len,
+                           guint             hash)
+{
+  gsize i;
+
+  if (index == NULL)
+    return NULL;
+
+  for (i = hash & index->mask; ; i = (i + 1) & index->mask)
+    {
+      StringChunkEntry *entry = &index->entries[i];
+      const gchar *entry_string = g_atomic_pointer_get (&entry->string);
+
+      if (entry_string == NULL)
+        return NULL;
+
+      if (entry->hash == hash && entry->len == len &&
+          memcmp (entry_string, string, len) == 0)
+        return (gchar *) entry_string;
+    }
+}
+
+/* HOLDS: const_lock, if the chunk is concurrent */
+static void
+string_chunk_index_insert_unlocked (StringChunkIndex *index,
+                                    const gchar      *string,
+                                    gsize             len,
+                                    guint             hash)
+{
+  gsize i;
+
+  for (i = hash & index->mask;
+       index->entries[i].string != NULL;
+       i = (i + 1) & index->mask)
+    ;
+
+  index->entries[i].hash = hash;
+  index->entries[i].len = len;
+  g_atomic_pointer_set (&index->entries[i].string, string);
+  index->n_entries++;
+}
+
+/* HOLDS: const_lock, if the chunk is concurrent */
+static void
+string_chunk_index_insert (GStringChunk *chunk,
+                           const gchar  *string,
+                           gsize         len,
+                           guint         hash)
+{
+  StringChunkIndex *index = chunk->const_index;
+
+  if (index == NULL)
+    {
+      index = string_chunk_index_new (STRING_CHUNK_INDEX_MIN_SIZE);
+      g_atomic_pointer_set (&chunk->const_index, index);
+    }
+  else if ((index->n_entries + 1) * 2 > index->mask + 1)
+    {
+      StringChunkIndex *new_index;
+      gsize i;
+
+      new_index = string_chunk_index_new (2 * (index->mask + 1));
+      for (i = 0; i <= index->mask; i++)
+        if (index->entries[i].string != NULL)
+          string_chunk_index_insert_unlocked (new_index,
+                                              index->entries[i].string,
+                                              index->entries[i].len,
+                                              index->entries[i].hash);
+
+      g_atomic_pointer_set (&chunk->const_index, new_index);
+      if (chunk->concurrent)
+        chunk->old_indexes = g_slist_prepend (chunk->old_indexes, index);
+      else
+        g_free (index);
+      index = new_index;
+    }
+
+  string_chunk_index_insert_unlocked (index, string, len, hash);
 }
 
 /**
@@ -211,21 +558,74 @@ gchar*
 g_string_chunk_insert_const (GStringChunk *chunk,
                              const gchar  *string)
 {
-  char* lookup;
+  g_return_val_if_fail (chunk != NULL, NULL);
+
+  return g_string_chunk_insert_len_const (chunk, string, -1);
+}
+
+/**
+ * g_string_chunk_insert_len_const:
+ * @chunk: a #GStringChunk
+ * @string: bytes to insert
+ * @len: number of bytes of @string to insert, or -1 to insert a
+ *     nul-terminated string
+ *
+ * Adds a nul-terminated copy of the first @len bytes of @string to the
+ * #GStringChunk, unless the same bytes have already been added with
+ * g_string_chunk_insert_const() or g_string_chunk_insert_len_const().
+ *
+ * This is like g_string_chunk_insert_const(), but @string does not need
+ * to be nul-terminated, which saves copying tokens out of a larger
+ * buffer before deduplicating them. As with g_string_chunk_insert_len(),
+ * @string may contain nul bytes, and must have at least @len addressable
+ * bytes.
+ *
+ * Returns: a pointer to the new or existing copy of @string
+ *     within the #GStringChunk
+ *
+ * Since: 2.82
+ */
+gchar *
+g_string_chunk_insert_len_const (GStringChunk *chunk,
+                                 const gchar  *string,
+                                 gssize        len)
+{
+  gchar *lookup;
+  gsize size;
+  guint hash;
 
   g_return_val_if_fail (chunk != NULL, NULL);
+  g_return_val_if_fail (len == 0 || string != NULL, NULL);
+
+  if (len < 0)
+    size = strlen (string);
+  else
+    size = (gsize) len;
 
-  if (!chunk->const_table)
-    chunk->const_table = g_hash_table_new (g_str_hash, g_str_equal);
+  hash = string_chunk_hash (string, size);
 
-  lookup = (char*) g_hash_table_lookup (chunk->const_table, (gchar *)string);
+  lookup = string_chunk_index_lookup (g_atomic_pointer_get (&chunk->const_index),
+                                      string, size, hash);
+  if (lookup != NULL)
+    return lookup;
 
-  if (!lookup)
+  if (chunk->concurrent)
     {
-      lookup = g_string_chunk_insert (chunk, string);
-      g_hash_table_add (chunk->const_table, lookup);
+      g_mutex_lock (&chunk->const_lock);
+
+      /* Looked up again, as another thread may have added it meanwhile */
+      lookup = string_chunk_index_lookup (chunk->const_index, string, size, hash);
     }
 
+  if (lookup == NULL)
+    {
+      lookup = string_chunk_append (chunk, string, size);
+      string_chunk_index_insert (chunk, lookup, size, hash);
+    }
+
+  if (chunk->concurrent)
+    g_mutex_unlock (&chunk->const_lock);
+
   return lookup;
 }
 
@@ -256,7 +656,6 @@ g_string_chunk_insert_len (GStringChunk *chunk,
                            gssize        len)
 {
   gsize size;
-  gchar* pos;
 
   g_return_val_if_fail (chunk != NULL, NULL);
 
@@ -265,29 +664,5 @@ g_string_chunk_insert_len (GStringChunk *chunk,
   else
     size = (gsize) len;
 
-  if ((G_MAXSIZE - chunk->storage_next < size + 1) || (chunk->storage_next + size + 1) > chunk->this_size)
-    {
-      gsize new_size = g_nearest_pow (MAX (chunk->default_size, size + 1));
-
-      /* If size is bigger than G_MAXSIZE / 2 then store it in its own
-       * allocation instead of failing here */
-      if (new_size == 0)
-        new_size = size + 1;
-
-      chunk->storage_list = g_slist_prepend (chunk->storage_list,
-                                             g_new (gchar, new_size));
-
-      chunk->this_size = new_size;
-      chunk->storage_next = 0;
-    }
-
-  pos = ((gchar *) chunk->storage_list->data) + chunk->storage_next;
-
-  *(pos + size) = '\0';
-
-  memcpy (pos, string, size);
-
-  chunk->storage_next += size + 1;
-
-  return pos;
+  return string_chunk_append (chunk, string, size);
 }
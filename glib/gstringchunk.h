@@ -39,6 +39,8 @@ typedef struct _GStringChunk GStringChunk;
 
 GLIB_AVAILABLE_IN_ALL
 GStringChunk* g_string_chunk_new          (gsize size);
+GLIB_AVAILABLE_IN_2_82
+GStringChunk* g_string_chunk_new_concurrent (gsize size);
 GLIB_AVAILABLE_IN_ALL
 void          g_string_chunk_free         (GStringChunk *chunk);
 GLIB_AVAILABLE_IN_ALL
@@ -53,6 +55,10 @@ gchar*        g_string_chunk_insert_len   (GStringChunk *chunk,
 GLIB_AVAILABLE_IN_ALL
 gchar*        g_string_chunk_insert_const (GStringChunk *chunk,
                                            const gchar  *string);
+GLIB_AVAILABLE_IN_2_82
+gchar*        g_string_chunk_insert_len_const (GStringChunk *chunk,
+                                               const gchar  *string,
+                                               gssize        len);
 
 G_END_DECLS
 
@@ -37,6 +37,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <inttypes.h>
+#include <math.h>
 #ifdef HAVE_SYS_PRCTL_H
 #include <sys/prctl.h>
 #endif
@@ -2827,6 +2828,187 @@ g_test_add_data_func_full (const char     *testpath,
                      (GTestFixtureFunc) data_free_func);
 }
 
+/* Each sample should take long enough that the resolution of
+ * g_get_monotonic_time() doesn’t matter */
+#define BENCHMARK_SAMPLE_USEC 10000
+#define BENCHMARK_N_WARMUP_SAMPLES 5
+#define BENCHMARK_N_SAMPLES 30
+
+typedef struct
+{
+  GTestBenchmarkFunc func;
+  gconstpointer data;
+} GTestBenchmark;
+
+static gint64
+test_benchmark_time (const GTestBenchmark *benchmark,
+                     guint64               n_iterations)
+{
+  gint64 start = g_get_monotonic_time ();
+
+  benchmark->func (benchmark->data, n_iterations);
+
+  return g_get_monotonic_time () - start;
+}
+
+static int
+test_benchmark_compare_doubles (gconstpointer a,
+                                gconstpointer b)
+{
+  double d = *(const double *) a - *(const double *) b;
+
+  return (d > 0) - (d < 0);
+}
+
+/* Linear interpolation between closest ranks of the sorted @samples */
+static double
+test_benchmark_quantile (const double *samples,
+                         guint         n_samples,
+                         double        q)
+{
+  double pos = q * (n_samples - 1);
+  guint i = (guint) pos;
+
+  if (i + 1 >= n_samples)
+    return samples[n_samples - 1];
+
+  return samples[i] + (pos - i) * (samples[i + 1] - samples[i]);
+}
+
+static void
+test_benchmark_run (gconstpointer data)
+{
+  const GTestBenchmark *benchmark = data;
+  double samples[BENCHMARK_N_SAMPLES];
+  double q1, q3, low, high, median, mean, stddev;
+  char median_str[G_ASCII_DTOSTR_BUF_SIZE];
+  char stddev_str[G_ASCII_DTOSTR_BUF_SIZE];
+  guint64 n_iterations = 1;
+  guint n_samples, n_outliers, i;
+  gint64 elapsed;
+
+  if (!g_test_perf ())
+    {
+      /* Only check that the benchmark works */
+      benchmark->func (benchmark->data, 1);
+      return;
+    }
+
+  /* Calibrate the number of iterations per sample. This also serves as the
+   * start of the warm up. */
+  while ((elapsed = test_benchmark_time (benchmark, n_iterations)) < BENCHMARK_SAMPLE_USEC / 4)
+    {
+      if (n_iterations > G_MAXUINT64 / 16)
+        break;
+      n_iterations *= elapsed > 0 ? MIN (16, BENCHMARK_SAMPLE_USEC / elapsed) : 16;
+    }
+  if (elapsed > 0)
+    n_iterations = MAX (1, (guint64) ((double) n_iterations * BENCHMARK_SAMPLE_USEC / elapsed));
+
+  for (i = 0; i < BENCHMARK_N_WARMUP_SAMPLES; i++)
+    test_benchmark_time (benchmark, n_iterations);
+
+  for (i = 0; i < BENCHMARK_N_SAMPLES; i++)
+    samples[i] = test_benchmark_time (benchmark, n_iterations) * 1000.0 / n_iterations;
+
+  qsort (samples, BENCHMARK_N_SAMPLES, sizeof (double), test_benchmark_compare_doubles);
+
+  /* Reject outliers, for example from preemption, with Tukey’s fences */
+  q1 = test_benchmark_quantile (samples, BENCHMARK_N_SAMPLES, 0.25);
+  q3 = test_benchmark_quantile (samples, BENCHMARK_N_SAMPLES, 0.75);
+  low = q1 - 1.5 * (q3 - q1);
+  high = q3 + 1.5 * (q3 - q1);
+
+  n_samples = 0;
+  for (i = 0; i < BENCHMARK_N_SAMPLES; i++)
+    {
+      if (samples[i] >= low && samples[i] <= high)
+        samples[n_samples++] = samples[i];
+    }
+  n_outliers = BENCHMARK_N_SAMPLES - n_samples;
+
+  median = test_benchmark_quantile (samples, n_samples, 0.5);
+  mean = 0;
+  for (i = 0; i < n_samples; i++)
+    mean += samples[i];
+  mean /= n_samples;
+  stddev = 0;
+  for (i = 0; i < n_samples; i++)
+    stddev += (samples[i] - mean) * (samples[i] - mean);
+  stddev = n_samples > 1 ? sqrt (stddev / (n_samples - 1)) : 0;
+
+  g_test_minimized_result (median, "%s: %.3f ns per iteration (stddev %.3f, "
+                           "%" G_GUINT64_FORMAT " iterations per sample, "
+                           "%u samples, %u outliers)",
+                           test_run_name, median, stddev,
+                           n_iterations, n_samples, n_outliers);
+
+  /* Machine readable version of the result, one line of JSON */
+  g_test_message ("{ \"benchmark\": \"%s\", \"unit\": \"ns\", \"median\": %s, "
+                  "\"stddev\": %s, \"iterations\": %" G_GUINT64_FORMAT ", "
+                  "\"samples\": %u, \"outliers\": %u }",
+                  test_run_name,
+                  g_ascii_dtostr (median_str, sizeof (median_str), median),
+                  g_ascii_dtostr (stddev_str, sizeof (stddev_str), stddev),
+                  n_iterations, n_samples, n_outliers);
+}
+
+/**
+ * GTestBenchmarkFunc:
+ * @user_data: the data provided when registering the benchmark
+ * @n_iterations: how often to repeat the measured operation
+ *
+ * The type used for benchmark functions. The function must perform the
+ * operation it measures @n_iterations times. Anything done once per call,
+ * such as setting up the data, is included in the measurement, so it should
+ * be cheap compared to @n_iterations repetitions of the operation.
+ *
+ * Since: 2.82
+ */
+
+/**
+ * g_test_add_benchmark:
+ * @testpath: /-separated test case path name for the benchmark.
+ * @test_data: Data argument for the benchmark function.
+ * @benchmark_func: (scope forever): The benchmark function.
+ *
+ * Create a new test case that measures how long one iteration of
+ * @benchmark_func takes.
+ *
+ * Normally, @benchmark_func is called once with an iteration count of 1, to
+ * check that it works. When tests are run in performance mode (see
+ * g_test_perf()), the iteration count is first calibrated so that one call
+ * takes about 10 milliseconds. After a warm up, @benchmark_func is called 30
+ * more times, outliers are dropped using the interquartile range, and the
+ * median time per iteration in nanoseconds is reported with
+ * g_test_minimized_result(), along with its standard deviation.
+ *
+ * The result is also reported as a single line of JSON with
+ * g_test_message(), which appears as a comment in the TAP output, for
+ * tools that track benchmark results over time. With Meson, benchmarks can
+ * be declared with `benchmark()` and `args: ['-m', 'perf']`, and run with
+ * `meson test --benchmark`.
+ *
+ * Since: 2.82
+ */
+void
+g_test_add_benchmark (const char         *testpath,
+                      gconstpointer       test_data,
+                      GTestBenchmarkFunc  benchmark_func)
+{
+  GTestBenchmark *benchmark;
+
+  g_return_if_fail (testpath != NULL);
+  g_return_if_fail (testpath[0] == '/');
+  g_return_if_fail (benchmark_func != NULL);
+
+  benchmark = g_new0 (GTestBenchmark, 1);
+  benchmark->func = benchmark_func;
+  benchmark->data = test_data;
+
+  g_test_add_data_func_full (testpath, benchmark, (GTestDataFunc) test_benchmark_run, g_free);
+}
+
 static gboolean
 g_test_suite_case_exists (GTestSuite *suite,
                           const char *test_path)
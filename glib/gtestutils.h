@@ -41,6 +41,8 @@ typedef void (*GTestFunc)        (void);
 typedef void (*GTestDataFunc)    (gconstpointer user_data);
 typedef void (*GTestFixtureFunc) (gpointer      fixture,
                                   gconstpointer user_data);
+typedef void (*GTestBenchmarkFunc) (gconstpointer user_data,
+                                    guint64       n_iterations);
 
 /* assertion API */
 #define g_assert_cmpstr(s1, cmp, s2)    G_STMT_START { \
@@ -383,6 +385,11 @@ void    g_test_add_data_func_full       (const char     *testpath,
                                          GTestDataFunc   test_func,
                                          GDestroyNotify  data_free_func);
 
+GLIB_AVAILABLE_IN_2_82
+void    g_test_add_benchmark            (const char         *testpath,
+                                         gconstpointer       test_data,
+                                         GTestBenchmarkFunc  benchmark_func);
+
 /* tell about currently run test */
 GLIB_AVAILABLE_IN_2_68
 const char * g_test_get_path            (void);
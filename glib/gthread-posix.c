@@ -49,6 +49,7 @@
 #include "gstrfuncs.h"
 #include "gtestutils.h"
 #include "gthreadprivate.h"
+#include "gtrace-private.h"
 #include "gutils.h"
 
 #include <stdlib.h>
@@ -1365,6 +1366,59 @@ g_system_thread_set_name (const gchar *name)
 #endif
 }
 
+guint
+g_system_thread_get_max_cpus (void)
+{
+#ifdef HAVE_PTHREAD_SETAFFINITY_NP
+  return CPU_SETSIZE;
+#else
+  return 0;
+#endif
+}
+
+gboolean
+g_system_thread_set_affinity (const guint  *cpus,
+                              guint         n_cpus,
+                              GError      **error)
+{
+#ifdef HAVE_PTHREAD_SETAFFINITY_NP
+  cpu_set_t cpu_mask;
+  guint i;
+  gint ret;
+
+  CPU_ZERO (&cpu_mask);
+
+  if (n_cpus == 0)
+    {
+      /* Allow all the CPUs again; the kernel leaves out those which are not
+       * available to the process */
+      long n_conf = sysconf (_SC_NPROCESSORS_CONF);
+
+      for (i = 0; i < (guint) CLAMP (n_conf, 1, CPU_SETSIZE); i++)
+        CPU_SET (i, &cpu_mask);
+    }
+
+  for (i = 0; i < n_cpus; i++)
+    if (cpus[i] < CPU_SETSIZE)
+      CPU_SET (cpus[i], &cpu_mask);
+
+  ret = pthread_setaffinity_np (pthread_self (), sizeof (cpu_mask), &cpu_mask);
+
+  if (ret != 0)
+    {
+      g_set_error (error, G_THREAD_ERROR, G_THREAD_ERROR_AFFINITY,
+                   "Error setting CPU affinity: %s", g_strerror (ret));
+      return FALSE;
+    }
+
+  return TRUE;
+#else
+  g_set_error_literal (error, G_THREAD_ERROR, G_THREAD_ERROR_AFFINITY,
+                       "Setting the CPU affinity of threads is not supported");
+  return FALSE;
+#endif
+}
+
 /* {{{1 GMutex and GCond futex implementation */
 
 #if defined(USE_NATIVE_MUTEX)
@@ -1439,6 +1493,7 @@ void
 g_mutex_init (GMutex *mutex)
 {
   mutex->i[0] = G_MUTEX_STATE_EMPTY;
+  mutex->i[1] = 0;  /* spin estimate, see g_mutex_lock_slowpath() */
 }
 
 void
@@ -1455,6 +1510,42 @@ G_GNUC_NO_INLINE
 static void
 g_mutex_lock_slowpath (GMutex *mutex)
 {
+  gint64 begin_time_nsec G_GNUC_UNUSED = G_TRACE_CURRENT_TIME;
+  guint n_sleeps = 0;
+  guint spins, max_spins, n;
+
+  /* Critical sections are usually short, so spin for a while in case the
+   * owner unlocks soon, before going to the kernel. i[1] holds the running
+   * average of how long that took for this mutex, which sets how long to
+   * spin this time.
+   *
+   * Taking the lock as owned rather than contended here is fine even if
+   * other threads are sleeping: the unlock which emptied it woke one of
+   * them, and that one marks it contended again.
+   */
+  spins = (guint) g_atomic_int_get (&mutex->i[1]);
+  max_spins = g_thread_lock_get_max_spins (spins);
+
+  for (n = 0; n < max_spins; n++)
+    {
+      if (g_atomic_int_get (&mutex->i[0]) == G_MUTEX_STATE_EMPTY &&
+          g_atomic_int_compare_and_exchange (&mutex->i[0],
+                                             G_MUTEX_STATE_EMPTY,
+                                             G_MUTEX_STATE_OWNED))
+        break;
+
+      g_thread_lock_cpu_relax ();
+    }
+
+  if (max_spins > 0)
+    g_atomic_int_set (&mutex->i[1], (gint) spins + ((gint) n - (gint) spins) / 8);
+
+  if (n < max_spins)
+    {
+      g_trace_lock_contended (G_TRACE_LOCK_MUTEX, mutex, begin_time_nsec, 0);
+      return;
+    }
+
   /* Set to contended.  If it was empty before then we
    * just acquired the lock.
    *
@@ -1464,7 +1555,10 @@ g_mutex_lock_slowpath (GMutex *mutex)
     {
       g_futex_simple (&mutex->i[0], (gsize) FUTEX_WAIT_PRIVATE,
                       G_MUTEX_STATE_CONTENDED, NULL);
+      n_sleeps++;
     }
+
+  g_trace_lock_contended (G_TRACE_LOCK_MUTEX, mutex, begin_time_nsec, n_sleeps);
 }
 
 G_GNUC_NO_INLINE
@@ -649,6 +649,45 @@ g_system_thread_set_name (const gchar *name)
     SetThreadName ((DWORD) -1, name);
 }
 
+guint
+g_system_thread_get_max_cpus (void)
+{
+  /* Only the processor group of the process is supported */
+  return sizeof (DWORD_PTR) * 8;
+}
+
+gboolean
+g_system_thread_set_affinity (const guint  *cpus,
+                              guint         n_cpus,
+                              GError      **error)
+{
+  DWORD_PTR mask = 0;
+  guint i;
+
+  if (n_cpus == 0)
+    {
+      DWORD_PTR system_mask;
+
+      if (!GetProcessAffinityMask (GetCurrentProcess (), &mask, &system_mask))
+        mask = 0;
+    }
+
+  for (i = 0; i < n_cpus; i++)
+    if (cpus[i] < sizeof (DWORD_PTR) * 8)
+      mask |= (DWORD_PTR) 1 << cpus[i];
+
+  if (mask == 0 || SetThreadAffinityMask (GetCurrentThread (), mask) == 0)
+    {
+      gchar *win_error = g_win32_error_message (GetLastError ());
+      g_set_error (error, G_THREAD_ERROR, G_THREAD_ERROR_AFFINITY,
+                   "Error setting CPU affinity: %s", win_error);
+      g_free (win_error);
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
 /* {{{1 Epilogue */
 
 void
@@ -42,6 +42,7 @@
 
 #include "gthread.h"
 #include "gthreadprivate.h"
+#include "glib-private.h"
 
 #include <string.h>
 
@@ -419,6 +420,9 @@
  * GThreadError:
  * @G_THREAD_ERROR_AGAIN: a thread couldn't be created due to resource
  *                        shortage. Try again later.
+ * @G_THREAD_ERROR_AFFINITY: the CPU affinity of a thread couldn't be set,
+ *                           because the given CPUs are not valid or this
+ *                           is not supported on this platform. Since: 2.82
  *
  * Possible errors of thread related functions.
  **/
@@ -923,6 +927,171 @@ g_thread_try_new (const gchar  *name,
   return g_thread_new_internal (name, g_thread_proxy, func, data, 0, error);
 }
 
+typedef struct
+{
+  GThreadFunc func;
+  gpointer data;
+  guint n_cpus;
+  guint cpus[];
+} GThreadAffinityData;
+
+static gpointer
+g_thread_affinity_proxy (gpointer data)
+{
+  GThreadAffinityData *affinity_data = data;
+  GThreadFunc func = affinity_data->func;
+  gpointer func_data = affinity_data->data;
+
+  /* The CPUs were checked by g_thread_try_new_with_affinity(), so this
+   * should not fail; if it does anyway, the thread just runs unpinned. */
+  g_system_thread_set_affinity (affinity_data->cpus, affinity_data->n_cpus, NULL);
+  g_free (affinity_data);
+
+  return func (func_data);
+}
+
+/**
+ * g_thread_try_new_with_affinity:
+ * @name: (nullable): an (optional) name for the new thread
+ * @func: (closure data) (scope async): a function to execute in the new thread
+ * @data: (nullable): an argument to supply to the new thread
+ * @cpus: (array length=n_cpus): the indices of the CPUs the new thread may
+ *     run on
+ * @n_cpus: the length of @cpus, which must be at least 1
+ * @error: return location for error, or %NULL
+ *
+ * This function is the same as g_thread_try_new() except that the new
+ * thread is restricted to running on @cpus, before it starts invoking
+ * @func. See g_thread_set_cpu_affinity().
+ *
+ * If setting the CPU affinity is not supported on this platform, or any
+ * of @cpus is not a valid CPU index, %G_THREAD_ERROR_AFFINITY is set and
+ * no thread is created.
+ *
+ * Returns: (transfer full): the new #GThread, or %NULL if an error occurred
+ *
+ * Since: 2.82
+ */
+GThread *
+g_thread_try_new_with_affinity (const gchar  *name,
+                                GThreadFunc   func,
+                                gpointer      data,
+                                const guint  *cpus,
+                                guint         n_cpus,
+                                GError      **error)
+{
+  GThreadAffinityData *affinity_data;
+  GThread *thread;
+
+  g_return_val_if_fail (func != NULL, NULL);
+  g_return_val_if_fail (cpus != NULL && n_cpus > 0, NULL);
+
+  if (!g_thread_check_cpus (cpus, n_cpus, error))
+    return NULL;
+
+  affinity_data = g_malloc (sizeof (GThreadAffinityData) + n_cpus * sizeof (guint));
+  affinity_data->func = func;
+  affinity_data->data = data;
+  affinity_data->n_cpus = n_cpus;
+  memcpy (affinity_data->cpus, cpus, n_cpus * sizeof (guint));
+
+  thread = g_thread_new_internal (name, g_thread_proxy, g_thread_affinity_proxy,
+                                  affinity_data, 0, error);
+  if (thread == NULL)
+    g_free (affinity_data);
+
+  return thread;
+}
+
+/**
+ * g_thread_set_cpu_affinity:
+ * @cpus: (array length=n_cpus) (nullable): the indices of the CPUs the
+ *     calling thread may run on
+ * @n_cpus: the length of @cpus
+ * @error: return location for error, or %NULL
+ *
+ * Restricts the calling thread to running on @cpus, where CPUs are numbered
+ * from 0 as the operating system does. Pinning threads avoids them being
+ * moved between CPUs, and, on machines with several NUMA nodes, keeps them
+ * close to the memory they work on.
+ *
+ * If @n_cpus is 0, the thread may run on all the CPUs available to the
+ * process again.
+ *
+ * CPUs which are not available to the process are ignored. If none of
+ * @cpus is available, any of them is not a valid CPU index, or setting the
+ * CPU affinity is not supported on this platform, %G_THREAD_ERROR_AFFINITY
+ * is set and the affinity of the thread is not changed.
+ *
+ * This is supported on Linux and Windows. On Windows, only CPUs of the
+ * processor group of the process can be used.
+ *
+ * Returns: %TRUE on success, %FALSE if an error occurred
+ *
+ * Since: 2.82
+ */
+gboolean
+g_thread_set_cpu_affinity (const guint  *cpus,
+                           guint         n_cpus,
+                           GError      **error)
+{
+  g_return_val_if_fail (cpus != NULL || n_cpus == 0, FALSE);
+
+  if (n_cpus > 0 && !g_thread_check_cpus (cpus, n_cpus, error))
+    return FALSE;
+
+  return g_system_thread_set_affinity (cpus, n_cpus, error);
+}
+
+gboolean
+g_thread_check_cpus (const guint  *cpus,
+                     guint         n_cpus,
+                     GError      **error)
+{
+  guint max_cpus = g_system_thread_get_max_cpus ();
+  guint i;
+
+  if (max_cpus == 0)
+    {
+      g_set_error_literal (error, G_THREAD_ERROR, G_THREAD_ERROR_AFFINITY,
+                           "Setting the CPU affinity of threads is not supported");
+      return FALSE;
+    }
+
+  for (i = 0; i < n_cpus; i++)
+    if (cpus[i] >= max_cpus)
+      {
+        g_set_error (error, G_THREAD_ERROR, G_THREAD_ERROR_AFFINITY,
+                     "Invalid CPU index %u", cpus[i]);
+        return FALSE;
+      }
+
+  return TRUE;
+}
+
+/* Returns how many iterations a thread should spin for a contended lock
+ * before sleeping, given @spins, the running average of what it took
+ * before. Like glibc’s adaptive mutexes, this allows spinning twice as long
+ * as the average, so that the limit can grow if locks are held for longer.
+ * Spinning is pointless with a single CPU: the owner can’t run meanwhile. */
+guint
+g_thread_lock_get_max_spins (guint spins)
+{
+  static gint multi_cpu = -1;  /* (atomic) */
+  gint is_multi_cpu = g_atomic_int_get (&multi_cpu);
+
+  if (G_UNLIKELY (is_multi_cpu < 0))
+    {
+      is_multi_cpu = g_get_num_processors () > 1;
+      g_atomic_int_set (&multi_cpu, is_multi_cpu);
+    }
+
+  if (!is_multi_cpu)
+    return 0;
+
+  return MIN (G_THREAD_LOCK_MAX_SPINS, spins * 2 + 10);
+}
+
 GThread *
 g_thread_new_internal (const gchar *name,
                        GThreadFunc proxy,
@@ -1129,5 +1298,177 @@ g_get_num_processors (void)
   return 1; /* Fallback */
 }
 
+/* GBigRWLock {{{1 ----------------------------------------------------- */
+
+/* A thread remembers the GBigRWLocks it holds read locks on, so that it
+ * can take them recursively even while a writer waits. Beyond this many
+ * different locks, that’s not tracked and recursive read locks may
+ * deadlock with writers. */
+#define G_BIG_RW_LOCK_MAX_HELD 8
+
+typedef struct
+{
+  guint slot;  /* 1 + index of the slot of the thread, 0 until assigned */
+  guint n_held;
+  struct
+  {
+    GBigRWLock *lock;
+    guint depth;
+  } held[G_BIG_RW_LOCK_MAX_HELD];
+} GBigRWLockThread;
+
+static guint g_big_rw_lock_next_slot = 0;  /* (atomic) */
+
+#ifdef G_THREAD_LOCAL
+static G_THREAD_LOCAL GBigRWLockThread g_big_rw_lock_thread;
+#else
+static GPrivate g_big_rw_lock_thread_private = G_PRIVATE_INIT (g_free);
+#endif
+
+static inline GBigRWLockThread *
+g_big_rw_lock_get_thread (void)
+{
+  GBigRWLockThread *thread;
+
+#ifdef G_THREAD_LOCAL
+  thread = &g_big_rw_lock_thread;
+#else
+  thread = g_private_get (&g_big_rw_lock_thread_private);
+  if G_UNLIKELY (thread == NULL)
+    thread = g_private_set_alloc0 (&g_big_rw_lock_thread_private, sizeof (GBigRWLockThread));
+#endif
+
+  /* Spread the threads over the slots */
+  if G_UNLIKELY (thread->slot == 0)
+    thread->slot = (guint) g_atomic_int_add (&g_big_rw_lock_next_slot, 1) % G_BIG_RW_LOCK_N_SLOTS + 1;
+
+  return thread;
+}
+
+static gboolean
+g_big_rw_lock_is_drained (GBigRWLock *lock)
+{
+  guint i;
+
+  for (i = 0; i < G_BIG_RW_LOCK_N_SLOTS; i++)
+    if (g_atomic_int_get (&lock->slots[i].n_readers) != 0)
+      return FALSE;
+
+  return TRUE;
+}
+
+/* Wakes a writer waiting for the readers to drain */
+static void
+g_big_rw_lock_wake_writer (GBigRWLock *lock)
+{
+  g_mutex_lock (&lock->wait_mutex);
+  g_cond_broadcast (&lock->wait_cond);
+  g_mutex_unlock (&lock->wait_mutex);
+}
+
+void
+g_big_rw_lock_init (GBigRWLock *lock)
+{
+  memset (lock, 0, sizeof (GBigRWLock));
+  g_mutex_init (&lock->writer_mutex);
+  g_mutex_init (&lock->wait_mutex);
+  g_cond_init (&lock->wait_cond);
+}
+
+void
+g_big_rw_lock_clear (GBigRWLock *lock)
+{
+  g_mutex_clear (&lock->writer_mutex);
+  g_mutex_clear (&lock->wait_mutex);
+  g_cond_clear (&lock->wait_cond);
+}
+
+void
+g_big_rw_lock_reader_lock (GBigRWLock *lock)
+{
+  GBigRWLockThread *thread = g_big_rw_lock_get_thread ();
+  gint *n_readers = &lock->slots[thread->slot - 1].n_readers;
+  guint i;
+
+  for (i = 0; i < thread->n_held; i++)
+    if (thread->held[i].lock == lock)
+      {
+        /* No writer can get in while this thread holds a read lock */
+        thread->held[i].depth++;
+        g_atomic_int_inc (n_readers);
+        return;
+      }
+
+  while (TRUE)
+    {
+      /* Pairs with the writer setting @writer before checking the slots:
+       * either it sees this reader, or this reader sees it */
+      g_atomic_int_inc (n_readers);
+      if G_LIKELY (!g_atomic_int_get (&lock->writer))
+        break;
+
+      /* Back off until the writer is done */
+      if (g_atomic_int_dec_and_test (n_readers))
+        g_big_rw_lock_wake_writer (lock);
+
+      g_mutex_lock (&lock->wait_mutex);
+      while (g_atomic_int_get (&lock->writer))
+        g_cond_wait (&lock->wait_cond, &lock->wait_mutex);
+      g_mutex_unlock (&lock->wait_mutex);
+    }
+
+  if (thread->n_held < G_BIG_RW_LOCK_MAX_HELD)
+    {
+      thread->held[thread->n_held].lock = lock;
+      thread->held[thread->n_held].depth = 1;
+      thread->n_held++;
+    }
+}
+
+void
+g_big_rw_lock_reader_unlock (GBigRWLock *lock)
+{
+  GBigRWLockThread *thread = g_big_rw_lock_get_thread ();
+  gint *n_readers = &lock->slots[thread->slot - 1].n_readers;
+  guint i;
+
+  for (i = 0; i < thread->n_held; i++)
+    if (thread->held[i].lock == lock)
+      {
+        if (--thread->held[i].depth == 0)
+          thread->held[i] = thread->held[--thread->n_held];
+        break;
+      }
+
+  if (g_atomic_int_dec_and_test (n_readers) &&
+      G_UNLIKELY (g_atomic_int_get (&lock->writer)))
+    g_big_rw_lock_wake_writer (lock);
+}
+
+void
+g_big_rw_lock_writer_lock (GBigRWLock *lock)
+{
+  g_mutex_lock (&lock->writer_mutex);
+
+  /* New readers back off from now on; wait for the current ones */
+  g_atomic_int_set (&lock->writer, 1);
+
+  g_mutex_lock (&lock->wait_mutex);
+  while (!g_big_rw_lock_is_drained (lock))
+    g_cond_wait (&lock->wait_cond, &lock->wait_mutex);
+  g_mutex_unlock (&lock->wait_mutex);
+}
+
+void
+g_big_rw_lock_writer_unlock (GBigRWLock *lock)
+{
+  g_mutex_lock (&lock->wait_mutex);
+  g_atomic_int_set (&lock->writer, 0);
+  g_cond_broadcast (&lock->wait_cond);
+  g_mutex_unlock (&lock->wait_mutex);
+
+  g_mutex_unlock (&lock->writer_mutex);
+}
+
 /* Epilogue {{{1 */
 /* vim: set foldmethod=marker: */
@@ -43,7 +43,8 @@ GQuark g_thread_error_quark (void);
 
 typedef enum
 {
-  G_THREAD_ERROR_AGAIN /* Resource temporarily unavailable */
+  G_THREAD_ERROR_AGAIN, /* Resource temporarily unavailable */
+  G_THREAD_ERROR_AFFINITY GLIB_AVAILABLE_ENUMERATOR_IN_2_82 /* CPU affinity can’t be set */
 } GThreadError;
 
 typedef gpointer (*GThreadFunc) (gpointer data);
@@ -156,6 +157,17 @@ GThread *       g_thread_try_new                (const gchar    *name,
                                                  GThreadFunc     func,
                                                  gpointer        data,
                                                  GError        **error);
+GLIB_AVAILABLE_IN_2_82
+GThread *       g_thread_try_new_with_affinity  (const gchar    *name,
+                                                 GThreadFunc     func,
+                                                 gpointer        data,
+                                                 const guint    *cpus,
+                                                 guint           n_cpus,
+                                                 GError        **error);
+GLIB_AVAILABLE_IN_2_82
+gboolean        g_thread_set_cpu_affinity       (const guint    *cpus,
+                                                 guint           n_cpus,
+                                                 GError        **error);
 GLIB_AVAILABLE_IN_ALL
 GThread *       g_thread_self                   (void);
 G_NORETURN GLIB_AVAILABLE_IN_ALL
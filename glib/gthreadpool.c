@@ -30,8 +30,10 @@
 
 #include "gasyncqueue.h"
 #include "gasyncqueueprivate.h"
+#include "gfileutils.h"
 #include "glib-private.h"
 #include "gmain.h"
+#include "gstrfuncs.h"
 #include "gtestutils.h"
 #include "gthreadprivate.h"
 #include "gtimer.h"
@@ -41,6 +43,7 @@
 /* #define DEBUG_MSG(args) g_printerr args ; g_printerr ("\n");    */
 
 typedef struct _GRealThreadPool GRealThreadPool;
+typedef struct _GThreadPoolWorker GThreadPoolWorker;
 
 /**
  * GThreadPool:
@@ -87,8 +90,58 @@ struct _GRealThreadPool
   gboolean waiting;
   GCompareDataFunc sort_func;
   gpointer sort_user_data;
+
+  /* Only used by %G_THREAD_POOL_FLAGS_WORK_STEALING pools. Tasks are kept in
+   * the workers’ deques, and in @queue while a sort function is set. */
+  gboolean work_stealing;
+  GDestroyNotify item_free_func;
+  GThreadPoolWorker **workers;
+  guint n_workers;
+  guint next_worker;  /* (atomic) round robin index for pushes */
+  gint n_queued;      /* (atomic) tasks in the deques and in @queue */
+  gint n_central;     /* (atomic) tasks in @queue */
+  gint n_sleeping;    /* (atomic) workers waiting on @ws_cond */
+  gint n_live;        /* (atomic) workers which haven’t exited yet */
+  gint stopping;      /* (atomic) set by g_thread_pool_free() */
+  GMutex ws_mutex;
+  GCond ws_cond;
+
+  /* Set by g_thread_pool_set_cpu_set(), protected by the lock of @queue */
+  guint *cpus;
+  guint n_cpus;
+  guint cpu_set_serial;  /* (atomic) changes whenever the threads must be
+                          * pinned again; 0 for unpinned pools */
+
+  /* %G_THREAD_POOL_FLAGS_NUMA: worker i is on node i % n_nodes */
+  gboolean numa;
+  guint n_nodes;
 };
 
+/* A worker of a work-stealing pool, with the deque of tasks which it
+ * runs first. Other workers steal from the front of it when idle. */
+struct _GThreadPoolWorker
+{
+  GMutex mutex;
+  gpointer *items;    /* ring buffer; size is a power of two */
+  guint size;
+  guint head;
+  gint len;           /* (atomic) so that thieves can peek without locking */
+  guint index;
+  guint node;
+  GRealThreadPool *pool;
+  GThread *thread;
+};
+
+/* A NUMA node with CPUs, as found in sysfs */
+typedef struct
+{
+  guint *cpus;
+  guint n_cpus;
+} GThreadPoolNode;
+
+#define G_THREAD_POOL_WORKER_INITIAL_SIZE 64
+#define G_THREAD_POOL_MAX_STEAL 32
+
 /* The following is just an address to mark the wakeup order for a
  * thread, it could be any address (as long, as it isn't a valid
  * GThreadPool address)
@@ -114,6 +167,16 @@ typedef struct
 static GCond spawn_thread_cond;
 static GAsyncQueue *spawn_thread_queue;
 
+/* The GThreadPoolWorker of the current thread, in work-stealing pools */
+static GPrivate current_worker;
+
+/* The cpu_set_serial of the pool the calling thread was last pinned for */
+static GPrivate current_cpu_set_serial;
+static guint cpu_set_serial_counter = 0;
+
+static GThreadPoolNode *numa_nodes = NULL;
+static guint n_numa_nodes = 0;
+
 static void             g_thread_pool_queue_push_unlocked (GRealThreadPool  *pool,
                                                            gpointer          data);
 static void             g_thread_pool_free_internal       (GRealThreadPool  *pool);
@@ -123,6 +186,187 @@ static gboolean         g_thread_pool_start_thread        (GRealThreadPool  *poo
 static void             g_thread_pool_wakeup_and_stop_all (GRealThreadPool  *pool);
 static GRealThreadPool* g_thread_pool_wait_for_new_pool   (void);
 static gpointer         g_thread_pool_wait_for_new_task   (GRealThreadPool  *pool);
+static void             g_thread_pool_ws_start            (GRealThreadPool  *pool,
+                                                           GError          **error);
+static void             g_thread_pool_ws_push             (GRealThreadPool  *pool,
+                                                           gpointer          data,
+                                                           GThreadPoolWorker *worker);
+static void             g_thread_pool_ws_free             (GRealThreadPool  *pool,
+                                                           gboolean          immediate,
+                                                           gboolean          wait_);
+static void             g_thread_pool_ws_set_sort_function (GRealThreadPool *pool,
+                                                            GCompareDataFunc func,
+                                                            gpointer         user_data);
+static gboolean         g_thread_pool_ws_move_to_front    (GRealThreadPool  *pool,
+                                                           gpointer          data);
+
+#ifdef __linux__
+/* Parses a sysfs CPU or node list, like `0-3,8-11` */
+static GArray *
+g_thread_pool_parse_list (const gchar *list)
+{
+  GArray *array = g_array_new (FALSE, FALSE, sizeof (guint));
+  const gchar *p = list;
+
+  while (g_ascii_isdigit (*p))
+    {
+      gchar *end;
+      guint first, last, i;
+
+      first = last = (guint) g_ascii_strtoull (p, &end, 10);
+      if (*end == '-')
+        last = (guint) g_ascii_strtoull (end + 1, &end, 10);
+
+      for (i = first; i <= last && i - first < 65536; i++)
+        g_array_append_val (array, i);
+
+      p = (*end == ',') ? end + 1 : end;
+    }
+
+  return array;
+}
+#endif
+
+static void
+g_thread_pool_init_numa (void)
+{
+  static gsize initialized = 0;
+
+  if (g_once_init_enter (&initialized))
+    {
+      GArray *nodes = g_array_new (FALSE, FALSE, sizeof (GThreadPoolNode));
+#ifdef __linux__
+      gchar *contents = NULL;
+
+      if (g_file_get_contents ("/sys/devices/system/node/online", &contents, NULL, NULL))
+        {
+          GArray *ids = g_thread_pool_parse_list (contents);
+          guint i;
+
+          for (i = 0; i < ids->len; i++)
+            {
+              gchar *path, *cpulist = NULL;
+
+              path = g_strdup_printf ("/sys/devices/system/node/node%u/cpulist",
+                                      g_array_index (ids, guint, i));
+
+              /* Nodes with only memory are left out */
+              if (g_file_get_contents (path, &cpulist, NULL, NULL))
+                {
+                  GArray *cpus = g_thread_pool_parse_list (cpulist);
+                  GThreadPoolNode node;
+
+                  node.n_cpus = cpus->len;
+                  node.cpus = (guint *) g_array_free (cpus, FALSE);
+
+                  if (node.n_cpus > 0)
+                    g_array_append_val (nodes, node);
+                  else
+                    g_free (node.cpus);
+                }
+
+              g_free (cpulist);
+              g_free (path);
+            }
+
+          g_array_unref (ids);
+          g_free (contents);
+        }
+#endif
+
+      /* Without NUMA information, everything is on one node and threads
+       * aren’t pinned */
+      if (nodes->len == 0)
+        {
+          GThreadPoolNode node = { NULL, 0 };
+          g_array_append_val (nodes, node);
+        }
+
+      n_numa_nodes = nodes->len;
+      numa_nodes = (GThreadPoolNode *) g_array_free (nodes, FALSE);
+      g_ignore_leak (numa_nodes);
+
+      g_once_init_leave (&initialized, 1);
+    }
+}
+
+static guint
+g_thread_pool_new_cpu_set_serial (void)
+{
+  guint serial;
+
+  do
+    serial = (guint) g_atomic_int_add (&cpu_set_serial_counter, 1) + 1;
+  while (serial == 0);
+
+  return serial;
+}
+
+/* Pins the calling thread to the CPUs it should run on for @pool, if that
+ * changed since it last did so. @worker is %NULL for the threads of pools
+ * which are not work-stealing. */
+static void
+g_thread_pool_update_cpu_set (GRealThreadPool   *pool,
+                              GThreadPoolWorker *worker,
+                              gboolean           locked)
+{
+  const guint *cpus;
+  guint n_cpus, serial;
+  guint *both = NULL;
+
+  serial = (guint) g_atomic_int_get (&pool->cpu_set_serial);
+  if (GPOINTER_TO_UINT (g_private_get (&current_cpu_set_serial)) == serial)
+    return;
+
+  if (!locked)
+    g_async_queue_lock (pool->queue);
+
+  serial = pool->cpu_set_serial;
+  cpus = pool->cpus;
+  n_cpus = pool->n_cpus;
+
+  if (worker != NULL && pool->numa && numa_nodes[worker->node].n_cpus > 0)
+    {
+      const GThreadPoolNode *node = &numa_nodes[worker->node];
+
+      if (n_cpus == 0)
+        {
+          cpus = node->cpus;
+          n_cpus = node->n_cpus;
+        }
+      else
+        {
+          guint i, j, n_both = 0;
+
+          /* Stay on the node, within the CPUs of the pool. If the pool has
+           * no CPUs on the node, the CPUs of the pool win. */
+          both = g_new (guint, n_cpus);
+          for (i = 0; i < n_cpus; i++)
+            for (j = 0; j < node->n_cpus; j++)
+              if (cpus[i] == node->cpus[j])
+                {
+                  both[n_both++] = cpus[i];
+                  break;
+                }
+
+          if (n_both > 0)
+            {
+              cpus = both;
+              n_cpus = n_both;
+            }
+        }
+    }
+
+  /* The CPUs were checked by g_thread_pool_set_cpu_set(); if they can’t
+   * be used anyway, the thread just isn’t pinned */
+  g_system_thread_set_affinity (cpus, n_cpus, NULL);
+  g_private_set (&current_cpu_set_serial, GUINT_TO_POINTER (serial));
+
+  if (!locked)
+    g_async_queue_unlock (pool->queue);
+
+  g_free (both);
+}
 
 static void
 g_thread_pool_queue_push_unlocked (GRealThreadPool *pool,
@@ -330,6 +574,7 @@ g_thread_pool_thread_proxy (gpointer data)
               /* A task was received and the thread pool is active,
                * so execute the function.
                */
+              g_thread_pool_update_cpu_set (pool, NULL, TRUE);
               g_async_queue_unlock (pool->queue);
               DEBUG_MSG (("thread %p in pool %p calling func.",
                           g_thread_self (), pool));
@@ -602,6 +847,15 @@ g_thread_pool_new_full (GFunc           func,
   retval->waiting = FALSE;
   retval->sort_func = NULL;
   retval->sort_user_data = NULL;
+  retval->work_stealing = FALSE;
+  retval->item_free_func = item_free_func;
+  retval->workers = NULL;
+  retval->n_workers = 0;
+  retval->cpus = NULL;
+  retval->n_cpus = 0;
+  retval->cpu_set_serial = 0;
+  retval->numa = FALSE;
+  retval->n_nodes = 1;
 
   G_LOCK (init);
   if (!unused_thread_queue)
@@ -656,6 +910,538 @@ g_thread_pool_new_full (GFunc           func,
   return (GThreadPool*) retval;
 }
 
+/**
+ * g_thread_pool_new_with_flags:
+ * @func: a function to execute in the threads of the new thread pool
+ * @user_data: user data that is handed over to @func every time it
+ *     is called
+ * @item_free_func: (nullable): used to free the data passed to
+ *     g_thread_pool_push() if the pool is freed before it is processed
+ * @max_threads: the maximal number of threads to execute concurrently
+ *     in the new thread pool, `-1` means no limit
+ * @flags: flags affecting the behaviour of the pool
+ * @error: return location for error, or %NULL
+ *
+ * Creates a new thread pool like g_thread_pool_new_full() does, with the
+ * behaviour given by @flags. %G_THREAD_POOL_FLAGS_EXCLUSIVE is equivalent to
+ * passing %TRUE as @exclusive to g_thread_pool_new_full().
+ *
+ * With %G_THREAD_POOL_FLAGS_WORK_STEALING, which implies
+ * %G_THREAD_POOL_FLAGS_EXCLUSIVE, each of the @max_threads threads of the
+ * pool keeps its own queue of tasks. g_thread_pool_push() spreads tasks over
+ * these queues, g_thread_pool_push_local() adds to the queue of the calling
+ * thread, and idle threads take tasks from the queues of the others. This
+ * avoids contention on a single queue when many small tasks are pushed, or
+ * pushed from many threads, at the cost of only processing tasks roughly in
+ * the order they were pushed.
+ *
+ * The threads of a work-stealing pool are all started by this function, and
+ * their number can’t be changed later with g_thread_pool_set_max_threads().
+ * Setting a sort function with g_thread_pool_set_sort_function() makes
+ * the pool keep all its tasks in a single sorted queue again, for as long as
+ * one is set.
+ *
+ * With %G_THREAD_POOL_FLAGS_NUMA, which implies
+ * %G_THREAD_POOL_FLAGS_WORK_STEALING, thread i of the pool runs on NUMA node
+ * i modulo g_thread_pool_get_n_nodes(), pinned to the CPUs of that node.
+ * Tasks can be pushed to a node with g_thread_pool_push_to_node(), and idle
+ * threads prefer taking tasks from threads on their own node. The NUMA
+ * nodes are currently only known on Linux; elsewhere, such a pool behaves
+ * like a work-stealing one.
+ *
+ * Returns: (transfer full): the new #GThreadPool
+ *
+ * Since: 2.82
+ */
+GThreadPool *
+g_thread_pool_new_with_flags (GFunc             func,
+                              gpointer          user_data,
+                              GDestroyNotify    item_free_func,
+                              gint              max_threads,
+                              GThreadPoolFlags  flags,
+                              GError          **error)
+{
+  GRealThreadPool *retval;
+
+  g_return_val_if_fail (func, NULL);
+
+  if (flags & G_THREAD_POOL_FLAGS_NUMA)
+    flags |= G_THREAD_POOL_FLAGS_WORK_STEALING;
+
+  g_return_val_if_fail (!(flags & G_THREAD_POOL_FLAGS_WORK_STEALING) || max_threads > 0, NULL);
+
+  if (!(flags & G_THREAD_POOL_FLAGS_WORK_STEALING))
+    return g_thread_pool_new_full (func, user_data, item_free_func, max_threads,
+                                   (flags & G_THREAD_POOL_FLAGS_EXCLUSIVE) != 0,
+                                   error);
+
+  retval = g_new0 (GRealThreadPool, 1);
+
+  retval->pool.func = func;
+  retval->pool.user_data = user_data;
+  retval->pool.exclusive = TRUE;
+  retval->queue = g_async_queue_new_full (item_free_func);
+  g_cond_init (&retval->cond);
+  retval->max_threads = max_threads;
+  retval->running = TRUE;
+  retval->work_stealing = TRUE;
+  retval->item_free_func = item_free_func;
+  g_mutex_init (&retval->ws_mutex);
+  g_cond_init (&retval->ws_cond);
+  retval->n_nodes = 1;
+
+  if (flags & G_THREAD_POOL_FLAGS_NUMA)
+    {
+      g_thread_pool_init_numa ();
+
+      retval->numa = TRUE;
+      retval->n_nodes = MIN (n_numa_nodes, (guint) max_threads);
+
+      /* So that the workers pin themselves to their nodes */
+      if (numa_nodes[0].n_cpus > 0)
+        retval->cpu_set_serial = g_thread_pool_new_cpu_set_serial ();
+    }
+
+  g_thread_pool_ws_start (retval, error);
+
+  return (GThreadPool*) retval;
+}
+
+static gboolean
+g_thread_pool_worker_push_unlocked (GThreadPoolWorker *worker,
+                                    gpointer           data)
+{
+  if ((guint) worker->len == worker->size)
+    {
+      gpointer *items = g_new (gpointer, worker->size * 2);
+      guint i;
+
+      for (i = 0; i < (guint) worker->len; i++)
+        items[i] = worker->items[(worker->head + i) & (worker->size - 1)];
+
+      g_free (worker->items);
+      worker->items = items;
+      worker->size *= 2;
+      worker->head = 0;
+    }
+
+  worker->items[(worker->head + worker->len) & (worker->size - 1)] = data;
+  g_atomic_int_set (&worker->len, worker->len + 1);
+
+  return TRUE;
+}
+
+static gpointer
+g_thread_pool_worker_pop_unlocked (GThreadPoolWorker *worker)
+{
+  gpointer data;
+
+  if (worker->len == 0)
+    return NULL;
+
+  data = worker->items[worker->head];
+  worker->head = (worker->head + 1) & (worker->size - 1);
+  g_atomic_int_set (&worker->len, worker->len - 1);
+
+  return data;
+}
+
+static void
+g_thread_pool_ws_wake (GRealThreadPool *pool)
+{
+  /* Pairs with the increment of n_sleeping in g_thread_pool_worker_thread():
+   * either the sleeper sees the new task, or we see the sleeper. */
+  if (g_atomic_int_get (&pool->n_sleeping) > 0)
+    {
+      g_mutex_lock (&pool->ws_mutex);
+      g_cond_signal (&pool->ws_cond);
+      g_mutex_unlock (&pool->ws_mutex);
+    }
+}
+
+/* Pushes @data to the deque of @worker, or to the next one in turn if
+ * @worker is %NULL */
+static void
+g_thread_pool_ws_push (GRealThreadPool   *pool,
+                       gpointer           data,
+                       GThreadPoolWorker *worker)
+{
+  if (g_atomic_pointer_get (&pool->sort_func) != NULL)
+    {
+      g_async_queue_lock (pool->queue);
+      g_thread_pool_queue_push_unlocked (pool, data);
+      g_atomic_int_inc (&pool->n_central);
+      g_atomic_int_inc (&pool->n_queued);
+      g_async_queue_unlock (pool->queue);
+    }
+  else
+    {
+      if (worker == NULL)
+        worker = pool->workers[g_atomic_int_add (&pool->next_worker, 1) % pool->n_workers];
+
+      g_mutex_lock (&worker->mutex);
+      g_thread_pool_worker_push_unlocked (worker, data);
+      g_atomic_int_inc (&pool->n_queued);
+      g_mutex_unlock (&worker->mutex);
+    }
+
+  g_thread_pool_ws_wake (pool);
+}
+
+/* Moves up to half of the tasks of @victim to @worker, and returns the
+ * first of them */
+static gpointer
+g_thread_pool_worker_steal_from (GRealThreadPool   *pool,
+                                 GThreadPoolWorker *worker,
+                                 GThreadPoolWorker *victim)
+{
+  gpointer stolen[G_THREAD_POOL_MAX_STEAL];
+  guint j, n_stolen;
+
+  if (g_atomic_int_get (&victim->len) == 0)
+    return NULL;
+
+  g_mutex_lock (&victim->mutex);
+  n_stolen = MIN ((guint) (victim->len + 1) / 2, G_THREAD_POOL_MAX_STEAL);
+  for (j = 0; j < n_stolen; j++)
+    stolen[j] = g_thread_pool_worker_pop_unlocked (victim);
+  if (n_stolen > 0)
+    g_atomic_int_add (&pool->n_queued, -1);
+  g_mutex_unlock (&victim->mutex);
+
+  if (n_stolen == 0)
+    return NULL;
+
+  if (n_stolen > 1)
+    {
+      /* The rest stay counted in n_queued while they are moved */
+      g_mutex_lock (&worker->mutex);
+      for (j = 1; j < n_stolen; j++)
+        g_thread_pool_worker_push_unlocked (worker, stolen[j]);
+      g_mutex_unlock (&worker->mutex);
+    }
+
+  return stolen[0];
+}
+
+/* Steals from the other workers, from those on the same NUMA node first */
+static gpointer
+g_thread_pool_worker_steal (GRealThreadPool   *pool,
+                            GThreadPoolWorker *worker)
+{
+  guint i, pass;
+
+  for (pass = 0; pass < (pool->numa ? 2u : 1u); pass++)
+    {
+      for (i = 1; i < pool->n_workers; i++)
+        {
+          GThreadPoolWorker *victim = pool->workers[(worker->index + i) % pool->n_workers];
+          gpointer task;
+
+          if ((victim->node == worker->node) != (pass == 0))
+            continue;
+
+          task = g_thread_pool_worker_steal_from (pool, worker, victim);
+          if (task != NULL)
+            return task;
+        }
+    }
+
+  return NULL;
+}
+
+static gpointer
+g_thread_pool_worker_next_task (GRealThreadPool   *pool,
+                                GThreadPoolWorker *worker)
+{
+  gpointer task = NULL;
+
+  /* Tasks in the queue are sorted, or were moved to the front */
+  if (g_atomic_int_get (&pool->n_central) > 0)
+    {
+      g_async_queue_lock (pool->queue);
+      task = g_async_queue_try_pop_unlocked (pool->queue);
+      if (task != NULL)
+        {
+          g_atomic_int_add (&pool->n_central, -1);
+          g_atomic_int_add (&pool->n_queued, -1);
+        }
+      g_async_queue_unlock (pool->queue);
+
+      if (task != NULL)
+        return task;
+    }
+
+  if (g_atomic_int_get (&worker->len) > 0)
+    {
+      g_mutex_lock (&worker->mutex);
+      task = g_thread_pool_worker_pop_unlocked (worker);
+      if (task != NULL)
+        g_atomic_int_add (&pool->n_queued, -1);
+      g_mutex_unlock (&worker->mutex);
+
+      if (task != NULL)
+        return task;
+    }
+
+  return g_thread_pool_worker_steal (pool, worker);
+}
+
+static void
+g_thread_pool_ws_free_internal (GRealThreadPool *pool)
+{
+  guint i;
+
+  for (i = 0; i < pool->n_workers; i++)
+    {
+      GThreadPoolWorker *worker = pool->workers[i];
+      gpointer data;
+
+      while ((data = g_thread_pool_worker_pop_unlocked (worker)) != NULL)
+        if (pool->item_free_func != NULL)
+          pool->item_free_func (data);
+
+      if (worker->thread != NULL)
+        g_thread_unref (worker->thread);
+      g_mutex_clear (&worker->mutex);
+      g_free (worker->items);
+      g_aligned_free (worker);
+    }
+
+  g_free (pool->workers);
+  g_async_queue_unref (pool->queue);
+  g_cond_clear (&pool->cond);
+  g_mutex_clear (&pool->ws_mutex);
+  g_cond_clear (&pool->ws_cond);
+
+  g_free (pool->cpus);
+  g_free (pool);
+}
+
+static gpointer
+g_thread_pool_worker_thread (gpointer data)
+{
+  GThreadPoolWorker *worker = data;
+  GRealThreadPool *pool = worker->pool;
+  gboolean free_pool;
+
+  g_private_set (&current_worker, worker);
+
+  while (TRUE)
+    {
+      gpointer task = NULL;
+      gboolean stop;
+
+      g_thread_pool_update_cpu_set (pool, worker, FALSE);
+
+      if (!g_atomic_int_get (&pool->immediate))
+        task = g_thread_pool_worker_next_task (pool, worker);
+
+      if (task != NULL)
+        {
+          pool->pool.func (task, pool->pool.user_data);
+          continue;
+        }
+
+      g_mutex_lock (&pool->ws_mutex);
+      g_atomic_int_inc (&pool->n_sleeping);
+
+      while (g_atomic_int_get (&pool->n_queued) <= 0 &&
+             !g_atomic_int_get (&pool->stopping))
+        g_cond_wait (&pool->ws_cond, &pool->ws_mutex);
+
+      g_atomic_int_add (&pool->n_sleeping, -1);
+      stop = g_atomic_int_get (&pool->stopping) &&
+             (pool->immediate || g_atomic_int_get (&pool->n_queued) <= 0);
+      g_mutex_unlock (&pool->ws_mutex);
+
+      if (stop)
+        break;
+    }
+
+  g_private_set (&current_worker, NULL);
+
+  g_mutex_lock (&pool->ws_mutex);
+  free_pool = g_atomic_int_dec_and_test (&pool->n_live) && !pool->waiting;
+  g_cond_broadcast (&pool->cond);
+  g_mutex_unlock (&pool->ws_mutex);
+
+  /* The last thread cleans up the pool, unless g_thread_pool_free() is
+   * waiting to do it */
+  if (free_pool)
+    g_thread_pool_ws_free_internal (pool);
+
+  return NULL;
+}
+
+static void
+g_thread_pool_ws_start (GRealThreadPool  *pool,
+                        GError          **error)
+{
+  const gchar *prgname = g_get_prgname ();
+  gchar name[16] = "pool";
+  guint i;
+
+  if (prgname)
+    g_snprintf (name, sizeof (name), "pool-%s", prgname);
+
+  pool->n_workers = (guint) pool->max_threads;
+  pool->workers = g_new (GThreadPoolWorker *, pool->n_workers);
+
+  for (i = 0; i < pool->n_workers; i++)
+    {
+      /* Keep the deques’ locks on separate cache lines */
+      GThreadPoolWorker *worker = g_aligned_alloc0 (1, sizeof (GThreadPoolWorker), 64);
+
+      g_mutex_init (&worker->mutex);
+      worker->size = G_THREAD_POOL_WORKER_INITIAL_SIZE;
+      worker->items = g_new (gpointer, worker->size);
+      worker->index = i;
+      worker->node = i % pool->n_nodes;
+      worker->pool = pool;
+      pool->workers[i] = worker;
+    }
+
+  /* If a thread can’t be started, the others still steal the tasks pushed
+   * to its deque */
+  g_mutex_lock (&pool->ws_mutex);
+
+  for (i = 0; i < pool->n_workers; i++)
+    {
+      GThreadPoolWorker *worker = pool->workers[i];
+
+      worker->thread = g_thread_try_new (name, g_thread_pool_worker_thread, worker, error);
+      if (worker->thread == NULL)
+        break;
+
+      g_atomic_int_inc (&pool->n_live);
+      pool->num_threads++;
+    }
+
+  g_mutex_unlock (&pool->ws_mutex);
+}
+
+static void
+g_thread_pool_ws_free (GRealThreadPool *pool,
+                       gboolean         immediate,
+                       gboolean         wait_)
+{
+  g_mutex_lock (&pool->ws_mutex);
+
+  pool->running = FALSE;
+  pool->waiting = wait_;
+  g_atomic_int_set (&pool->immediate, immediate);
+  g_atomic_int_set (&pool->stopping, TRUE);
+  g_cond_broadcast (&pool->ws_cond);
+
+  if (g_atomic_int_get (&pool->n_live) == 0)
+    {
+      g_mutex_unlock (&pool->ws_mutex);
+      g_thread_pool_ws_free_internal (pool);
+      return;
+    }
+
+  if (!wait_)
+    {
+      /* The last thread will clean up */
+      g_mutex_unlock (&pool->ws_mutex);
+      return;
+    }
+
+  while (g_atomic_int_get (&pool->n_live) > 0)
+    g_cond_wait (&pool->cond, &pool->ws_mutex);
+
+  g_mutex_unlock (&pool->ws_mutex);
+
+  g_thread_pool_ws_free_internal (pool);
+}
+
+static void
+g_thread_pool_ws_set_sort_function (GRealThreadPool  *pool,
+                                    GCompareDataFunc  func,
+                                    gpointer          user_data)
+{
+  guint i;
+
+  g_async_queue_lock (pool->queue);
+
+  pool->sort_user_data = user_data;
+  g_atomic_pointer_set (&pool->sort_func, func);
+
+  if (func)
+    {
+      /* Gather all the tasks, so they can be ordered */
+      for (i = 0; i < pool->n_workers; i++)
+        {
+          GThreadPoolWorker *worker = pool->workers[i];
+          gpointer data;
+
+          g_mutex_lock (&worker->mutex);
+          while ((data = g_thread_pool_worker_pop_unlocked (worker)) != NULL)
+            {
+              g_async_queue_push_unlocked (pool->queue, data);
+              g_atomic_int_inc (&pool->n_central);
+            }
+          g_mutex_unlock (&worker->mutex);
+        }
+
+      g_async_queue_sort_unlocked (pool->queue, func, user_data);
+    }
+
+  g_async_queue_unlock (pool->queue);
+}
+
+static gboolean
+g_thread_pool_ws_move_to_front (GRealThreadPool *pool,
+                                gpointer         data)
+{
+  gboolean found;
+  guint i;
+
+  g_async_queue_lock (pool->queue);
+
+  found = g_async_queue_remove_unlocked (pool->queue, data);
+
+  for (i = 0; !found && i < pool->n_workers; i++)
+    {
+      GThreadPoolWorker *worker = pool->workers[i];
+      guint j;
+
+      g_mutex_lock (&worker->mutex);
+
+      for (j = 0; j < (guint) worker->len; j++)
+        {
+          guint k = (worker->head + j) & (worker->size - 1);
+
+          if (worker->items[k] != data)
+            continue;
+
+          /* Close the gap */
+          for (; j + 1 < (guint) worker->len; j++)
+            {
+              guint next = (k + 1) & (worker->size - 1);
+
+              worker->items[k] = worker->items[next];
+              k = next;
+            }
+
+          g_atomic_int_set (&worker->len, worker->len - 1);
+          g_atomic_int_inc (&pool->n_central);
+          found = TRUE;
+          break;
+        }
+
+      g_mutex_unlock (&worker->mutex);
+    }
+
+  if (found)
+    g_async_queue_push_front_unlocked (pool->queue, data);
+
+  g_async_queue_unlock (pool->queue);
+
+  return found;
+}
+
 /**
  * g_thread_pool_push:
  * @pool: a #GThreadPool
@@ -692,6 +1478,14 @@ g_thread_pool_push (GThreadPool  *pool,
   g_return_val_if_fail (real, FALSE);
   g_return_val_if_fail (real->running, FALSE);
 
+  if (real->work_stealing)
+    {
+      g_return_val_if_fail (data != NULL, FALSE);
+
+      g_thread_pool_ws_push (real, data, NULL);
+      return TRUE;
+    }
+
   result = TRUE;
 
   g_async_queue_lock (real->queue);
@@ -714,6 +1508,181 @@ g_thread_pool_push (GThreadPool  *pool,
   return result;
 }
 
+/**
+ * g_thread_pool_push_local:
+ * @pool: a #GThreadPool
+ * @data: a new task for @pool
+ * @error: return location for error, or %NULL
+ *
+ * Inserts @data into the list of tasks to be executed by @pool, like
+ * g_thread_pool_push(), but when called from one of the threads of a
+ * %G_THREAD_POOL_FLAGS_WORK_STEALING pool, adds it to the queue of that
+ * thread.
+ *
+ * This is meant for tasks which push follow-up tasks, which will then
+ * usually be run by the same thread, unless other threads are idle and
+ * take them. Follow-up tasks may also be pushed while the pool is being
+ * freed with g_thread_pool_free(): they are processed before it is freed,
+ * unless @immediate was set, in which case they are freed with the other
+ * unprocessed tasks.
+ *
+ * For other pools, or when called from other threads, this is the same as
+ * g_thread_pool_push().
+ *
+ * Returns: %TRUE on success, %FALSE if an error occurred
+ *
+ * Since: 2.82
+ */
+gboolean
+g_thread_pool_push_local (GThreadPool  *pool,
+                          gpointer      data,
+                          GError      **error)
+{
+  GRealThreadPool *real = (GRealThreadPool*) pool;
+  GThreadPoolWorker *worker;
+
+  g_return_val_if_fail (real, FALSE);
+
+  worker = g_private_get (&current_worker);
+  if (!real->work_stealing || worker == NULL || worker->pool != real)
+    return g_thread_pool_push (pool, data, error);
+
+  g_return_val_if_fail (data != NULL, FALSE);
+
+  /* If the pool is being freed immediately, this is freed with the other
+   * unprocessed tasks */
+  g_thread_pool_ws_push (real, data, worker);
+
+  return TRUE;
+}
+
+/**
+ * g_thread_pool_push_to_node:
+ * @pool: a #GThreadPool
+ * @data: a new task for @pool
+ * @node: the index of the NUMA node to run @data on, or `-1`
+ * @error: return location for error, or %NULL
+ *
+ * Inserts @data into the list of tasks to be executed by @pool, like
+ * g_thread_pool_push(), but in a %G_THREAD_POOL_FLAGS_NUMA pool adds it to
+ * the queue of one of the threads on @node, so that it is processed close
+ * to the memory it works on. @node ranges from 0 to
+ * g_thread_pool_get_n_nodes() - 1, following the order of the node numbers
+ * of the system.
+ *
+ * @node is only a hint: idle threads on other nodes still take @data when
+ * the threads on @node are busy. For other pools, or if @node is out of
+ * range, this is the same as g_thread_pool_push().
+ *
+ * Returns: %TRUE on success, %FALSE if an error occurred
+ *
+ * Since: 2.82
+ */
+gboolean
+g_thread_pool_push_to_node (GThreadPool  *pool,
+                            gpointer      data,
+                            gint          node,
+                            GError      **error)
+{
+  GRealThreadPool *real = (GRealThreadPool*) pool;
+  guint n_node_workers, i;
+
+  g_return_val_if_fail (real, FALSE);
+
+  if (!real->numa || node < 0 || (guint) node >= real->n_nodes)
+    return g_thread_pool_push (pool, data, error);
+
+  g_return_val_if_fail (real->running, FALSE);
+  g_return_val_if_fail (data != NULL, FALSE);
+
+  /* Workers node, node + n_nodes, node + 2 * n_nodes… are on @node */
+  n_node_workers = (real->n_workers - (guint) node + real->n_nodes - 1) / real->n_nodes;
+  i = (guint) g_atomic_int_add (&real->next_worker, 1) % n_node_workers;
+
+  g_thread_pool_ws_push (real, data, real->workers[(guint) node + i * real->n_nodes]);
+
+  return TRUE;
+}
+
+/**
+ * g_thread_pool_get_n_nodes:
+ * @pool: a #GThreadPool
+ *
+ * Returns the number of NUMA nodes the threads of @pool are spread over.
+ *
+ * This is only more than 1 for %G_THREAD_POOL_FLAGS_NUMA pools on machines
+ * with several NUMA nodes, where it is the number of nodes with CPUs, or
+ * the number of threads of @pool if that is smaller.
+ *
+ * Returns: the number of NUMA nodes of @pool
+ *
+ * Since: 2.82
+ */
+guint
+g_thread_pool_get_n_nodes (GThreadPool *pool)
+{
+  GRealThreadPool *real = (GRealThreadPool*) pool;
+
+  g_return_val_if_fail (real, 0);
+
+  return real->n_nodes;
+}
+
+/**
+ * g_thread_pool_set_cpu_set:
+ * @pool: a #GThreadPool
+ * @cpus: (array length=n_cpus) (nullable): the indices of the CPUs the
+ *     threads of @pool may run on
+ * @n_cpus: the length of @cpus
+ * @error: return location for error, or %NULL
+ *
+ * Restricts the threads of @pool to running on @cpus, like
+ * g_thread_set_cpu_affinity() does. Threads pin themselves before they
+ * process their next task, so a task which is already running is not
+ * affected. If @n_cpus is 0, the threads may run on all CPUs again.
+ *
+ * In a %G_THREAD_POOL_FLAGS_NUMA pool, the threads are pinned to the CPUs
+ * of their NUMA node by default, and this restricts them to the CPUs of
+ * @cpus on their node. Threads on nodes without any of @cpus run on @cpus.
+ *
+ * Threads of pools which are not exclusive are shared with other pools:
+ * they are pinned again when they start processing tasks of another pool.
+ *
+ * If setting the CPU affinity is not supported on this platform, or any
+ * of @cpus is not a valid CPU index, %G_THREAD_ERROR_AFFINITY is set and
+ * the CPUs of @pool are not changed.
+ *
+ * Returns: %TRUE on success, %FALSE if an error occurred
+ *
+ * Since: 2.82
+ */
+gboolean
+g_thread_pool_set_cpu_set (GThreadPool  *pool,
+                           const guint  *cpus,
+                           guint         n_cpus,
+                           GError      **error)
+{
+  GRealThreadPool *real = (GRealThreadPool*) pool;
+
+  g_return_val_if_fail (real, FALSE);
+  g_return_val_if_fail (real->running, FALSE);
+  g_return_val_if_fail (cpus != NULL || n_cpus == 0, FALSE);
+
+  if (n_cpus > 0 && !g_thread_check_cpus (cpus, n_cpus, error))
+    return FALSE;
+
+  g_async_queue_lock (real->queue);
+
+  g_free (real->cpus);
+  real->cpus = g_memdup2 (cpus, n_cpus * sizeof (guint));
+  real->n_cpus = n_cpus;
+  g_atomic_int_set (&real->cpu_set_serial, g_thread_pool_new_cpu_set_serial ());
+
+  g_async_queue_unlock (real->queue);
+
+  return TRUE;
+}
+
 /**
  * g_thread_pool_set_max_threads:
  * @pool: a #GThreadPool
@@ -757,6 +1726,7 @@ g_thread_pool_set_max_threads (GThreadPool  *pool,
 
   g_return_val_if_fail (real, FALSE);
   g_return_val_if_fail (real->running, FALSE);
+  g_return_val_if_fail (!real->work_stealing, FALSE);
   g_return_val_if_fail (!real->pool.exclusive || max_threads != -1, FALSE);
   g_return_val_if_fail (max_threads >= -1, FALSE);
 
@@ -833,6 +1803,9 @@ g_thread_pool_get_num_threads (GThreadPool *pool)
   g_return_val_if_fail (real, 0);
   g_return_val_if_fail (real->running, 0);
 
+  if (real->work_stealing)
+    return (guint) g_atomic_int_get (&real->n_live);
+
   g_async_queue_lock (real->queue);
   retval = real->num_threads;
   g_async_queue_unlock (real->queue);
@@ -859,7 +1832,10 @@ g_thread_pool_unprocessed (GThreadPool *pool)
   g_return_val_if_fail (real, 0);
   g_return_val_if_fail (real->running, 0);
 
-  unprocessed = g_async_queue_length (real->queue);
+  if (real->work_stealing)
+    unprocessed = g_atomic_int_get (&real->n_queued);
+  else
+    unprocessed = g_async_queue_length (real->queue);
 
   return MAX (unprocessed, 0);
 }
@@ -897,6 +1873,12 @@ g_thread_pool_free (GThreadPool *pool,
   g_return_if_fail (real);
   g_return_if_fail (real->running);
 
+  if (real->work_stealing)
+    {
+      g_thread_pool_ws_free (real, immediate, wait_);
+      return;
+    }
+
   /* If there's no thread allowed here, there is not much sense in
    * not stopping this pool immediately, when it's not empty
    */
@@ -953,6 +1935,7 @@ g_thread_pool_free_internal (GRealThreadPool* pool)
   g_async_queue_unref (pool->queue);
   g_cond_clear (&pool->cond);
 
+  g_free (pool->cpus);
   g_free (pool);
 }
 
@@ -1095,6 +2078,12 @@ g_thread_pool_set_sort_function (GThreadPool      *pool,
   g_return_if_fail (real);
   g_return_if_fail (real->running);
 
+  if (real->work_stealing)
+    {
+      g_thread_pool_ws_set_sort_function (real, func, user_data);
+      return;
+    }
+
   g_async_queue_lock (real->queue);
 
   real->sort_func = func;
@@ -1127,6 +2116,9 @@ g_thread_pool_move_to_front (GThreadPool *pool,
   GRealThreadPool *real = (GRealThreadPool*) pool;
   gboolean found;
 
+  if (real->work_stealing)
+    return g_thread_pool_ws_move_to_front (real, data);
+
   g_async_queue_lock (real->queue);
 
   found = g_async_queue_remove_unlocked (real->queue, data);
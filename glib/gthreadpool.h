@@ -37,6 +37,33 @@ G_BEGIN_DECLS
 
 typedef struct _GThreadPool GThreadPool;
 
+/**
+ * GThreadPoolFlags:
+ * @G_THREAD_POOL_FLAGS_NONE: Default behaviour.
+ * @G_THREAD_POOL_FLAGS_EXCLUSIVE: The pool owns its threads, as if created
+ *   with @exclusive set to %TRUE.
+ * @G_THREAD_POOL_FLAGS_WORK_STEALING: Each thread of the pool has its own
+ *   queue of tasks, and idle threads take tasks from the others. Implies
+ *   %G_THREAD_POOL_FLAGS_EXCLUSIVE.
+ * @G_THREAD_POOL_FLAGS_NUMA: The threads of the pool are spread over the
+ *   NUMA nodes of the machine and pinned to the CPUs of their node, and
+ *   idle threads take tasks from threads on the same node first. Implies
+ *   %G_THREAD_POOL_FLAGS_WORK_STEALING.
+ *
+ * Flags to pass to g_thread_pool_new_with_flags() which affect the behaviour
+ * of a #GThreadPool.
+ *
+ * Since: 2.82
+ */
+GLIB_AVAILABLE_TYPE_IN_2_82
+typedef enum /*< flags >*/
+{
+  G_THREAD_POOL_FLAGS_NONE = 0,
+  G_THREAD_POOL_FLAGS_EXCLUSIVE = 1 << 0,
+  G_THREAD_POOL_FLAGS_WORK_STEALING = 1 << 1,
+  G_THREAD_POOL_FLAGS_NUMA = 1 << 2
+} GThreadPoolFlags;
+
 /* Thread Pools
  */
 
@@ -60,6 +87,13 @@ GThreadPool *   g_thread_pool_new_full          (GFunc            func,
                                                  gint             max_threads,
                                                  gboolean         exclusive,
                                                  GError         **error);
+GLIB_AVAILABLE_IN_2_82
+GThreadPool *   g_thread_pool_new_with_flags    (GFunc             func,
+                                                 gpointer          user_data,
+                                                 GDestroyNotify    item_free_func,
+                                                 gint              max_threads,
+                                                 GThreadPoolFlags  flags,
+                                                 GError          **error);
 GLIB_AVAILABLE_IN_ALL
 void            g_thread_pool_free              (GThreadPool     *pool,
                                                  gboolean         immediate,
@@ -68,6 +102,22 @@ GLIB_AVAILABLE_IN_ALL
 gboolean        g_thread_pool_push              (GThreadPool     *pool,
                                                  gpointer         data,
                                                  GError         **error);
+GLIB_AVAILABLE_IN_2_82
+gboolean        g_thread_pool_push_local        (GThreadPool     *pool,
+                                                 gpointer         data,
+                                                 GError         **error);
+GLIB_AVAILABLE_IN_2_82
+gboolean        g_thread_pool_push_to_node      (GThreadPool     *pool,
+                                                 gpointer         data,
+                                                 gint             node,
+                                                 GError         **error);
+GLIB_AVAILABLE_IN_2_82
+guint           g_thread_pool_get_n_nodes       (GThreadPool     *pool);
+GLIB_AVAILABLE_IN_2_82
+gboolean        g_thread_pool_set_cpu_set       (GThreadPool     *pool,
+                                                 const guint     *cpus,
+                                                 guint            n_cpus,
+                                                 GError         **error);
 GLIB_AVAILABLE_IN_ALL
 guint           g_thread_pool_unprocessed       (GThreadPool     *pool);
 GLIB_AVAILABLE_IN_ALL
@@ -159,6 +159,10 @@ void            g_system_thread_free            (GRealThread  *thread);
 
 G_NORETURN void g_system_thread_exit            (void);
 void            g_system_thread_set_name        (const gchar  *name);
+guint           g_system_thread_get_max_cpus    (void);
+gboolean        g_system_thread_set_affinity    (const guint  *cpus,
+                                                 guint         n_cpus,
+                                                 GError      **error);
 
 /* gthread.c */
 GThread *g_thread_new_internal (const gchar *name,
@@ -170,6 +174,27 @@ GThread *g_thread_new_internal (const gchar *name,
 
 gpointer        g_thread_proxy                  (gpointer      thread);
 
+gboolean        g_thread_check_cpus             (const guint  *cpus,
+                                                 guint         n_cpus,
+                                                 GError      **error);
+
+/* Contended locks spin for up to this many iterations before sleeping. The
+ * actual limit is adapted to how long locks were held before, see
+ * g_thread_lock_get_max_spins(). */
+#define G_THREAD_LOCK_MAX_SPINS 100
+
+guint           g_thread_lock_get_max_spins     (guint         spins);
+
+static inline void
+g_thread_lock_cpu_relax (void)
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+  __builtin_ia32_pause ();
+#elif defined(__GNUC__) && (defined(__aarch64__) || (defined(__arm__) && __ARM_ARCH >= 7))
+  __asm__ volatile ("yield" ::: "memory");
+#endif
+}
+
 guint           g_thread_n_created              (void);
 
 gpointer        g_private_set_alloc0            (GPrivate       *key,
@@ -190,6 +190,7 @@ struct _GTimeZone
   GArray  *t_info;         /* Array of TransitionInfo */
   GArray  *transitions;    /* Array of Transition */
   gint     ref_count;
+  gint     last_interval;  /* (atomic) hint for find_universal_interval() */
 };
 
 G_LOCK_DEFINE_STATIC (time_zones);
@@ -198,6 +199,31 @@ G_LOCK_DEFINE_STATIC (tz_default);
 static GTimeZone *tz_default = NULL;
 G_LOCK_DEFINE_STATIC (tz_local);
 static GTimeZone *tz_local = NULL;
+static gchar *tz_local_env = NULL;
+
+/* Identifies the /etc/localtime which the local time zone was loaded
+ * from if TZ is unset, so that changes to it are noticed. */
+typedef struct
+{
+  guint64 ino;
+  gint64  mtime;
+  gint64  ctime;
+} LocalTimeZoneStamp;
+
+static LocalTimeZoneStamp tz_local_stamp;
+
+/* Per-thread copy of tz_local, so the common case of the local time
+ * zone not changing between calls to g_time_zone_new_local() does not
+ * take the lock. */
+typedef struct
+{
+  GTimeZone          *tz;
+  gchar              *env;
+  LocalTimeZoneStamp  stamp;
+} LocalTimeZoneCache;
+
+static void local_time_zone_cache_free (gpointer data);
+static GPrivate local_time_zone_cache = G_PRIVATE_INIT (local_time_zone_cache_free);
 
 #define MIN_TZYEAR 1916 /* Daylight Savings started in WWI */
 #define MAX_TZYEAR 2999 /* And it's not likely ever to go away, but
@@ -2010,6 +2036,52 @@ g_time_zone_new_utc (void)
   return g_time_zone_ref (utc);
 }
 
+static void
+local_time_zone_cache_free (gpointer data)
+{
+  LocalTimeZoneCache *cache = data;
+
+  g_time_zone_unref (cache->tz);
+  g_free (cache->env);
+  g_free (cache);
+}
+
+/* Returns %FALSE if the local time zone for @tzenv can't be cached,
+ * because there is no cheap way to tell whether it changed. */
+static gboolean
+local_time_zone_get_stamp (const gchar        *tzenv,
+                           LocalTimeZoneStamp *stamp)
+{
+  memset (stamp, 0, sizeof (*stamp));
+
+#ifdef G_OS_UNIX
+  if (tzenv == NULL)
+    {
+      GStatBuf buf;
+
+      /* A missing /etc/localtime leaves the stamp zeroed, so creating
+       * it is noticed too */
+      if (g_lstat ("/etc/localtime", &buf) == 0)
+        {
+          stamp->ino = buf.st_ino;
+          stamp->mtime = buf.st_mtime;
+          stamp->ctime = buf.st_ctime;
+        }
+    }
+
+  return TRUE;
+#else
+  return tzenv != NULL;
+#endif
+}
+
+static gboolean
+local_time_zone_stamp_equal (const LocalTimeZoneStamp *a,
+                             const LocalTimeZoneStamp *b)
+{
+  return a->ino == b->ino && a->mtime == b->mtime && a->ctime == b->ctime;
+}
+
 /**
  * g_time_zone_new_local:
  *
@@ -2031,23 +2103,66 @@ GTimeZone *
 g_time_zone_new_local (void)
 {
   const gchar *tzenv = g_getenv ("TZ");
+  LocalTimeZoneStamp stamp;
+  LocalTimeZoneCache *cache;
   GTimeZone *tz;
 
+  if (!local_time_zone_get_stamp (tzenv, &stamp))
+    {
+      /* g_time_zone_new_identifier() checks the system default itself */
+      tz = g_time_zone_new_identifier (tzenv);
+      if (tz == NULL)
+        tz = g_time_zone_new_utc ();
+
+      return tz;
+    }
+
+  cache = g_private_get (&local_time_zone_cache);
+  if (cache != NULL && g_strcmp0 (cache->env, tzenv) == 0 &&
+      local_time_zone_stamp_equal (&cache->stamp, &stamp))
+    return g_time_zone_ref (cache->tz);
+
   G_LOCK (tz_local);
 
-  /* Is time zone changed and must be flushed? */
-  if (tz_local && g_strcmp0 (g_time_zone_get_identifier (tz_local), tzenv))
-    g_clear_pointer (&tz_local, g_time_zone_unref);
+  /* Is time zone changed and must be flushed?  This compares against
+   * the value of TZ the zone was created for rather than its
+   * identifier, which is resolved from /etc/localtime if TZ is unset,
+   * and against the state of /etc/localtime in that case. */
+  if (tz_local && (g_strcmp0 (tz_local_env, tzenv) ||
+                   !local_time_zone_stamp_equal (&tz_local_stamp, &stamp)))
+    {
+      g_clear_pointer (&tz_local, g_time_zone_unref);
+      g_clear_pointer (&tz_local_env, g_free);
+    }
 
   if (tz_local == NULL)
-    tz_local = g_time_zone_new_identifier (tzenv);
-  if (tz_local == NULL)
-    tz_local = g_time_zone_new_utc ();
+    {
+      tz_local = g_time_zone_new_identifier (tzenv);
+      if (tz_local == NULL)
+        tz_local = g_time_zone_new_utc ();
+      tz_local_env = g_strdup (tzenv);
+      tz_local_stamp = stamp;
+    }
 
   tz = g_time_zone_ref (tz_local);
 
   G_UNLOCK (tz_local);
 
+  if (cache == NULL)
+    {
+      cache = g_new0 (LocalTimeZoneCache, 1);
+      g_private_set (&local_time_zone_cache, cache);
+    }
+  else
+    {
+      g_time_zone_unref (cache->tz);
+      g_free (cache->env);
+    }
+
+  cache->tz = g_time_zone_ref (tz);
+  cache->env = g_strdup (tzenv);
+  cache->stamp = stamp;
+
   return tz;
 }
 
@@ -2210,6 +2325,39 @@ interval_valid (GTimeZone *tz,
   return interval <= tz->transitions->len;
 }
 
+/* Finds the first interval whose end is not before @time_ UTC.  Lookups
+ * tend to be close together (typically "now"), so the previous result
+ * is checked first; otherwise the transitions are binary searched.
+ * @tz must have transitions. */
+static guint
+find_universal_interval (GTimeZone *tz,
+                         gint64     time_)
+{
+  guint lo, hi;
+
+  lo = (guint) g_atomic_int_get (&tz->last_interval);
+  if (time_ <= interval_end (tz, lo) &&
+      (lo == 0 || time_ > interval_end (tz, lo - 1)))
+    return lo;
+
+  /* The last interval ends at G_MAXINT64, so this always succeeds */
+  lo = 0;
+  hi = tz->transitions->len;
+  while (lo < hi)
+    {
+      guint mid = lo + (hi - lo) / 2;
+
+      if (time_ <= interval_end (tz, mid))
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+
+  g_atomic_int_set (&tz->last_interval, (gint) lo);
+
+  return lo;
+}
+
 /* g_time_zone_find_interval() {{{1 */
 
 /**
@@ -2252,11 +2400,8 @@ g_time_zone_adjust_time (GTimeZone *tz,
 
   intervals = tz->transitions->len;
 
-  /* find the interval containing *time UTC
-   * TODO: this could be binary searched (or better) */
-  for (i = 0; i <= intervals; i++)
-    if (*time_ <= interval_end (tz, i))
-      break;
+  /* find the interval containing *time UTC */
+  i = find_universal_interval (tz, *time_);
 
   g_assert (interval_start (tz, i) <= *time_ && *time_ <= interval_end (tz, i));
 
@@ -2348,9 +2493,7 @@ g_time_zone_find_interval (GTimeZone *tz,
   if (tz->transitions == NULL)
     return 0;
   intervals = tz->transitions->len;
-  for (i = 0; i <= intervals; i++)
-    if (time_ <= interval_end (tz, i))
-      break;
+  i = find_universal_interval (tz, time_);
 
   if (type == G_TIME_TYPE_UNIVERSAL)
     return i;
@@ -79,4 +79,19 @@ void    (g_trace_set_int64_counter)    (guint       id,
 #define g_trace_set_int64_counter(i,v)
 #endif
 
+typedef enum
+{
+  G_TRACE_LOCK_MUTEX,
+  G_TRACE_LOCK_BIT_LOCK,
+} GTraceLockKind;
+
+void    (g_trace_lock_contended)       (GTraceLockKind  kind,
+                                        gconstpointer   address,
+                                        gint64          begin_time_nsec,
+                                        guint           n_sleeps);
+
+#ifndef HAVE_SYSPROF
+#define g_trace_lock_contended(k, a, b, n)
+#endif
+
 G_END_DECLS
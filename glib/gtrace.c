@@ -173,3 +173,94 @@ void
   sysprof_collector_set_counters (&id, &value, 1);
 #endif
 }
+
+#ifdef HAVE_SYSPROF
+/* Counters are only published every so many contended acquisitions, to
+ * keep the cost of tracing on the slow path low */
+#define LOCK_COUNTERS_INTERVAL 64
+
+typedef struct
+{
+  const char *mark_name;
+  const char *counter_names[2];
+  guint counter_ids[2];
+  guint counts[2];  /* (atomic) contended acquisitions, sleeps */
+} LockCounters;
+
+static const char * const lock_counter_descriptions[] = {
+  "Number of lock acquisitions which had to wait",
+  "Number of times threads slept waiting for a lock",
+};
+
+static LockCounters lock_counters[] = {
+  { "GMutex contended", { "GMutex contended", "GMutex sleeps" }, { 0, 0 }, { 0, 0 } },
+  { "bit lock contended", { "bit lock contended", "bit lock sleeps" }, { 0, 0 }, { 0, 0 } },
+};
+
+/* 0: not defined, 1: being defined, 2: defined. This can’t use g_once_init_enter(),
+ * since it is called while acquiring a GMutex. */
+static gint lock_counters_state = 0;  /* (atomic) */
+#endif
+
+/*
+ * g_trace_lock_contended:
+ * @kind: the kind of lock
+ * @address: the address of the lock
+ * @begin_time_nsec: when the lock was found to be held, as returned by
+ *    %G_TRACE_CURRENT_TIME
+ * @n_sleeps: how many times the thread slept before getting the lock
+ *
+ * Records that a lock was only acquired after waiting for another thread
+ * to release it, either by spinning or by sleeping. This keeps counters of
+ * the contended acquisitions and of the sleeps for each kind of lock, and
+ * adds a mark with the address of the lock when the thread had to sleep,
+ * so hot locks can be found.
+ *
+ * Uncontended acquisitions are not recorded, so that acquiring a lock stays
+ * a single atomic operation.
+ *
+ * Since: 2.82
+ */
+void
+(g_trace_lock_contended) (GTraceLockKind  kind,
+                          gconstpointer   address,
+                          gint64          begin_time_nsec,
+                          guint           n_sleeps)
+{
+#ifdef HAVE_SYSPROF
+  LockCounters *counters = &lock_counters[kind];
+  guint n_contended;
+
+  if (n_sleeps > 0)
+    g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                  "GLib", counters->mark_name,
+                  "%p, %u sleeps", address, n_sleeps);
+
+  n_contended = (guint) g_atomic_int_add (&counters->counts[0], 1) + 1;
+  if (n_sleeps > 0)
+    g_atomic_int_add (&counters->counts[1], (gint) n_sleeps);
+
+  if (n_contended % LOCK_COUNTERS_INTERVAL != 0)
+    return;
+
+  if (g_atomic_int_compare_and_exchange (&lock_counters_state, 0, 1))
+    {
+      gsize i, j;
+
+      for (i = 0; i < G_N_ELEMENTS (lock_counters); i++)
+        for (j = 0; j < G_N_ELEMENTS (lock_counters[i].counter_ids); j++)
+          lock_counters[i].counter_ids[j] =
+            g_trace_define_int64_counter ("GLib", lock_counters[i].counter_names[j],
+                                          lock_counter_descriptions[j]);
+
+      g_atomic_int_set (&lock_counters_state, 2);
+    }
+
+  if (g_atomic_int_get (&lock_counters_state) == 2)
+    {
+      g_trace_set_int64_counter (counters->counter_ids[0], n_contended);
+      g_trace_set_int64_counter (counters->counter_ids[1],
+                                 (guint) g_atomic_int_get (&counters->counts[1]));
+    }
+#endif
+}
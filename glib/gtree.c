@@ -32,6 +32,8 @@
 
 #include "gtree.h"
 
+#include <string.h>
+
 #include "gatomic.h"
 #include "gtestutils.h"
 #include "gslice.h"
@@ -47,15 +49,19 @@ G_STATIC_ASSERT ((G_GUINT64_CONSTANT (1) << (MAX_GTREE_HEIGHT - 2)) >= G_MAXUINT
  * [balanced binary tree][glib-Balanced-Binary-Trees]. It should be
  * accessed only by using the following functions.
  */
+typedef struct _GTreeBNode GTreeBNode;
+
 struct _GTree
 {
   GTreeNode        *root;
+  GTreeBNode       *broot;       /* root, for trees in B-tree mode */
   GCompareDataFunc  key_compare;
   GDestroyNotify    key_destroy_func;
   GDestroyNotify    value_destroy_func;
   gpointer          key_compare_data;
   guint             nnodes;
   gint              ref_count;
+  gboolean          is_btree;
 };
 
 struct _GTreeNode
@@ -69,6 +75,22 @@ struct _GTreeNode
   guint8     right_child;
 };
 
+/* In B-tree mode, entries are kept in sorted arrays in the leaves, which are
+ * linked to each other in order. Each key in a branch is the smallest key
+ * in the subtree of the corresponding child. */
+#define G_TREE_BNODE_SIZE 32
+
+struct _GTreeBNode
+{
+  GTreeBNode *parent;
+  GTreeBNode *prev;          /* neighbouring leaves, for leaves */
+  GTreeBNode *next;
+  guint       n_keys;
+  gboolean    is_leaf;
+  gpointer    keys[G_TREE_BNODE_SIZE];
+  gpointer    items[G_TREE_BNODE_SIZE];  /* values, or children for branches */
+};
+
 
 static GTreeNode* g_tree_node_new                   (gpointer       key,
                                                      gpointer       value);
@@ -101,6 +123,29 @@ static GTreeNode* g_tree_node_rotate_right          (GTreeNode     *node);
 static void       g_tree_node_check                 (GTreeNode     *node);
 #endif
 
+static void       g_tree_btree_insert               (GTree         *tree,
+                                                     gpointer       key,
+                                                     gpointer       value,
+                                                     gboolean       replace);
+static gboolean   g_tree_btree_remove               (GTree         *tree,
+                                                     gconstpointer  key,
+                                                     gboolean       steal);
+static gboolean   g_tree_btree_lookup               (GTree         *tree,
+                                                     gconstpointer  key,
+                                                     gpointer      *orig_key,
+                                                     gpointer      *value);
+static void       g_tree_btree_foreach_from         (GTree         *tree,
+                                                     gboolean       bounded,
+                                                     gconstpointer  lower_key,
+                                                     gconstpointer  upper_key,
+                                                     GTraverseFunc  func,
+                                                     gpointer       user_data);
+static gpointer   g_tree_btree_search               (GTree         *tree,
+                                                     GCompareFunc   search_func,
+                                                     gconstpointer  user_data);
+static void       g_tree_btree_remove_all           (GTree         *tree);
+static gint       g_tree_btree_height               (GTree         *tree);
+
 
 static GTreeNode*
 g_tree_node_new (gpointer key,
@@ -195,10 +240,182 @@ g_tree_new_full (GCompareDataFunc key_compare_func,
   tree->key_compare_data   = key_compare_data;
   tree->nnodes             = 0;
   tree->ref_count          = 1;
+  tree->broot              = NULL;
+  tree->is_btree           = FALSE;
   
   return tree;
 }
 
+/**
+ * g_tree_new_btree: (constructor)
+ * @key_compare_func: qsort()-style comparison function
+ * @key_compare_data: data to pass to comparison function
+ * @key_destroy_func: (nullable): a function to free the memory allocated for
+ *   the key used when removing the entry from the #GTree
+ * @value_destroy_func: (nullable): a function to free the memory allocated for
+ *   the value used when removing the entry from the #GTree
+ *
+ * Creates a new #GTree like g_tree_new_full(), which keeps its entries in a
+ * B-tree with wide nodes rather than a binary tree with a node per entry.
+ *
+ * This uses considerably less memory for large trees, and iterating over
+ * the tree, with g_tree_foreach() or g_tree_foreach_range(), walks arrays of
+ * entries in order. Inserting keys in ascending order fills the nodes
+ * completely.
+ *
+ * The entries of such a tree are not individually addressable, so the
+ * functions which take or return a #GTreeNode, such as g_tree_lookup_node(),
+ * g_tree_insert_node() or g_tree_lower_bound(), can’t be used with it; all
+ * the other functions can. Traversing it with g_tree_traverse() visits the
+ * entries in order whatever the traversal type.
+ *
+ * Returns: a newly allocated #GTree
+ *
+ * Since: 2.82
+ */
+GTree *
+g_tree_new_btree (GCompareDataFunc key_compare_func,
+                  gpointer         key_compare_data,
+                  GDestroyNotify   key_destroy_func,
+                  GDestroyNotify   value_destroy_func)
+{
+  GTree *tree;
+
+  g_return_val_if_fail (key_compare_func != NULL, NULL);
+
+  tree = g_tree_new_full (key_compare_func, key_compare_data,
+                          key_destroy_func, value_destroy_func);
+  tree->is_btree = TRUE;
+
+  return tree;
+}
+
+static GTreeBNode *
+g_tree_bnode_new (gboolean is_leaf)
+{
+  GTreeBNode *bnode = g_new (GTreeBNode, 1);
+
+  bnode->parent = NULL;
+  bnode->prev = NULL;
+  bnode->next = NULL;
+  bnode->n_keys = 0;
+  bnode->is_leaf = is_leaf;
+
+  return bnode;
+}
+
+/**
+ * g_tree_new_from_sorted: (constructor)
+ * @key_compare_func: qsort()-style comparison function
+ * @key_compare_data: data to pass to comparison function
+ * @key_destroy_func: (nullable): a function to free the memory allocated for
+ *   the key used when removing the entry from the #GTree
+ * @value_destroy_func: (nullable): a function to free the memory allocated for
+ *   the value used when removing the entry from the #GTree
+ * @keys: (array length=n_entries) (transfer full): the keys, in strictly
+ *   ascending order according to @key_compare_func
+ * @values: (array length=n_entries) (transfer full) (nullable): the values
+ *   corresponding to @keys, or %NULL to use %NULL values
+ * @n_entries: the number of entries
+ *
+ * Creates a new #GTree in B-tree mode, as g_tree_new_btree() does, holding
+ * the given entries.
+ *
+ * As the keys are already sorted, this takes O(n) time, without comparing
+ * any keys, and packs the nodes of the tree completely. The tree takes
+ * ownership of the keys and values, but not of the arrays.
+ *
+ * If @keys is not sorted, or has duplicates, the resulting tree will not
+ * work correctly.
+ *
+ * Returns: a newly allocated #GTree
+ *
+ * Since: 2.82
+ */
+GTree *
+g_tree_new_from_sorted (GCompareDataFunc  key_compare_func,
+                        gpointer          key_compare_data,
+                        GDestroyNotify    key_destroy_func,
+                        GDestroyNotify    value_destroy_func,
+                        gpointer         *keys,
+                        gpointer         *values,
+                        gsize             n_entries)
+{
+  GTree *tree;
+  GTreeBNode *level, *prev, *bnode;
+  gsize i, n_nodes;
+
+  g_return_val_if_fail (key_compare_func != NULL, NULL);
+  g_return_val_if_fail (keys != NULL || n_entries == 0, NULL);
+  g_return_val_if_fail (n_entries <= G_MAXUINT, NULL);
+
+  tree = g_tree_new_btree (key_compare_func, key_compare_data,
+                           key_destroy_func, value_destroy_func);
+
+  if (n_entries == 0)
+    return tree;
+
+  /* Fill the leaves, then each level of branches above them */
+  level = prev = NULL;
+  for (i = 0; i < n_entries; i += G_TREE_BNODE_SIZE)
+    {
+      bnode = g_tree_bnode_new (TRUE);
+      bnode->n_keys = MIN (n_entries - i, G_TREE_BNODE_SIZE);
+      memcpy (bnode->keys, &keys[i], bnode->n_keys * sizeof (gpointer));
+      if (values != NULL)
+        memcpy (bnode->items, &values[i], bnode->n_keys * sizeof (gpointer));
+      else
+        memset (bnode->items, 0, bnode->n_keys * sizeof (gpointer));
+
+      bnode->prev = prev;
+      if (prev != NULL)
+        prev->next = bnode;
+      else
+        level = bnode;
+      prev = bnode;
+    }
+
+  for (n_nodes = (n_entries + G_TREE_BNODE_SIZE - 1) / G_TREE_BNODE_SIZE;
+       n_nodes > 1;
+       n_nodes = (n_nodes + G_TREE_BNODE_SIZE - 1) / G_TREE_BNODE_SIZE)
+    {
+      GTreeBNode *child = level;
+      GTreeBNode *branch_prev = NULL;
+
+      for (i = 0; i < n_nodes; i++)
+        {
+          GTreeBNode *next_child = child->is_leaf ? child->next : child->prev;
+
+          if (i % G_TREE_BNODE_SIZE == 0)
+            {
+              bnode = g_tree_bnode_new (FALSE);
+
+              /* Branches are chained through prev while building */
+              if (branch_prev != NULL)
+                branch_prev->prev = bnode;
+              else
+                level = bnode;
+              branch_prev = bnode;
+            }
+
+          if (!child->is_leaf)
+            child->prev = NULL;
+          child->parent = bnode;
+          bnode->keys[bnode->n_keys] = child->keys[0];
+          bnode->items[bnode->n_keys] = child;
+          bnode->n_keys++;
+
+          child = next_child;
+        }
+    }
+
+  level->prev = NULL;
+  tree->broot = level;
+  tree->nnodes = n_entries;
+
+  return tree;
+}
+
 /**
  * g_tree_node_first:
  * @tree: a #GTree
@@ -216,6 +433,7 @@ g_tree_node_first (GTree *tree)
   GTreeNode *tmp;
 
   g_return_val_if_fail (tree != NULL, NULL);
+  g_return_val_if_fail (!tree->is_btree, NULL);
 
   if (!tree->root)
     return NULL;
@@ -245,6 +463,7 @@ g_tree_node_last (GTree *tree)
   GTreeNode *tmp;
 
   g_return_val_if_fail (tree != NULL, NULL);
+  g_return_val_if_fail (!tree->is_btree, NULL);
 
   if (!tree->root)
     return NULL;
@@ -328,6 +547,12 @@ g_tree_remove_all (GTree *tree)
 
   g_return_if_fail (tree != NULL);
 
+  if (tree->is_btree)
+    {
+      g_tree_btree_remove_all (tree);
+      return;
+    }
+
   node = g_tree_node_first (tree);
 
   while (node)
@@ -436,6 +661,14 @@ g_tree_insert_replace_node_internal (GTree *tree,
 
   g_return_val_if_fail (tree != NULL, NULL);
 
+  if (tree->is_btree)
+    {
+      /* Only g_tree_insert() and g_tree_replace() can be used */
+      g_return_val_if_fail (!null_ret_ok, NULL);
+      g_tree_btree_insert (tree, key, value, replace);
+      return NULL;
+    }
+
   node = g_tree_insert_internal (tree, key, value, replace, null_ret_ok);
 
 #ifdef G_TREE_DEBUG
@@ -737,6 +970,9 @@ g_tree_remove (GTree         *tree,
 
   g_return_val_if_fail (tree != NULL, FALSE);
 
+  if (tree->is_btree)
+    return g_tree_btree_remove (tree, key, FALSE);
+
   removed = g_tree_remove_internal (tree, key, FALSE);
 
 #ifdef G_TREE_DEBUG
@@ -767,6 +1003,9 @@ g_tree_steal (GTree         *tree,
 
   g_return_val_if_fail (tree != NULL, FALSE);
 
+  if (tree->is_btree)
+    return g_tree_btree_remove (tree, key, TRUE);
+
   removed = g_tree_remove_internal (tree, key, TRUE);
 
 #ifdef G_TREE_DEBUG
@@ -1038,6 +1277,7 @@ g_tree_lookup_node (GTree         *tree,
                     gconstpointer  key)
 {
   g_return_val_if_fail (tree != NULL, NULL);
+  g_return_val_if_fail (!tree->is_btree, NULL);
 
   return g_tree_find_node (tree, key);
 }
@@ -1060,7 +1300,17 @@ g_tree_lookup (GTree         *tree,
 {
   GTreeNode *node;
 
-  node = g_tree_lookup_node (tree, key);
+  g_return_val_if_fail (tree != NULL, NULL);
+
+  if (tree->is_btree)
+    {
+      gpointer value = NULL;
+
+      g_tree_btree_lookup (tree, key, NULL, &value);
+      return value;
+    }
+
+  node = g_tree_find_node (tree, key);
 
   return node ? node->value : NULL;
 }
@@ -1088,6 +1338,9 @@ g_tree_lookup_extended (GTree         *tree,
   GTreeNode *node;
   
   g_return_val_if_fail (tree != NULL, FALSE);
+
+  if (tree->is_btree)
+    return g_tree_btree_lookup (tree, lookup_key, orig_key, value);
   
   node = g_tree_find_node (tree, lookup_key);
   
@@ -1127,6 +1380,12 @@ g_tree_foreach (GTree         *tree,
   GTreeNode *node;
 
   g_return_if_fail (tree != NULL);
+
+  if (tree->is_btree)
+    {
+      g_tree_btree_foreach_from (tree, FALSE, NULL, NULL, func, user_data);
+      return;
+    }
   
   if (!tree->root)
     return;
@@ -1142,6 +1401,55 @@ g_tree_foreach (GTree         *tree,
     }
 }
 
+/**
+ * g_tree_foreach_range:
+ * @tree: a #GTree
+ * @lower_key: the smallest key to visit
+ * @upper_key: the key to stop before
+ * @func: (scope call): the function to call for each node visited.
+ *     If this function returns %TRUE, the traversal is stopped.
+ * @user_data: user data to pass to the function
+ *
+ * Calls the given function, in sorted order, for each of the key/value pairs
+ * in the #GTree whose key is greater than or equal to @lower_key and
+ * strictly less than @upper_key.
+ *
+ * This takes O(log(n)) time to find the start of the range, and then time
+ * proportional to the number of pairs visited.
+ *
+ * As with g_tree_foreach(), the tree may not be modified while iterating
+ * over it.
+ *
+ * Since: 2.82
+ */
+void
+g_tree_foreach_range (GTree         *tree,
+                      gconstpointer  lower_key,
+                      gconstpointer  upper_key,
+                      GTraverseFunc  func,
+                      gpointer       user_data)
+{
+  GTreeNode *node;
+
+  g_return_if_fail (tree != NULL);
+  g_return_if_fail (func != NULL);
+
+  if (tree->is_btree)
+    {
+      g_tree_btree_foreach_from (tree, TRUE, lower_key, upper_key, func, user_data);
+      return;
+    }
+
+  for (node = g_tree_lower_bound (tree, lower_key);
+       node != NULL &&
+       tree->key_compare (node->key, upper_key, tree->key_compare_data) < 0;
+       node = g_tree_node_next (node))
+    {
+      if ((*func) (node->key, node->value, user_data))
+        break;
+    }
+}
+
 /**
  * g_tree_foreach_node:
  * @tree: a #GTree
@@ -1168,6 +1476,7 @@ g_tree_foreach_node (GTree             *tree,
   GTreeNode *node;
 
   g_return_if_fail (tree != NULL);
+  g_return_if_fail (!tree->is_btree);
 
   if (!tree->root)
     return;
@@ -1220,6 +1529,12 @@ g_tree_traverse (GTree         *tree,
 {
   g_return_if_fail (tree != NULL);
 
+  if (tree->is_btree && traverse_type != G_LEVEL_ORDER)
+    {
+      g_tree_btree_foreach_from (tree, FALSE, NULL, NULL, traverse_func, user_data);
+      return;
+    }
+
   if (!tree->root)
     return;
 
@@ -1270,6 +1585,7 @@ g_tree_search_node (GTree         *tree,
                     gconstpointer  user_data)
 {
   g_return_val_if_fail (tree != NULL, NULL);
+  g_return_val_if_fail (!tree->is_btree, NULL);
 
   if (!tree->root)
     return NULL;
@@ -1303,6 +1619,11 @@ g_tree_search (GTree         *tree,
 {
   GTreeNode *node;
 
+  g_return_val_if_fail (tree != NULL, NULL);
+
+  if (tree->is_btree)
+    return g_tree_btree_search (tree, search_func, user_data);
+
   node = g_tree_search_node (tree, search_func, user_data);
 
   return node ? node->value : NULL;
@@ -1334,6 +1655,7 @@ g_tree_lower_bound (GTree         *tree,
   gint cmp;
 
   g_return_val_if_fail (tree != NULL, NULL);
+  g_return_val_if_fail (!tree->is_btree, NULL);
 
   node = tree->root;
   if (!node)
@@ -1388,6 +1710,7 @@ g_tree_upper_bound (GTree         *tree,
   gint cmp;
 
   g_return_val_if_fail (tree != NULL, NULL);
+  g_return_val_if_fail (!tree->is_btree, NULL);
 
   node = tree->root;
   if (!node)
@@ -1436,6 +1759,9 @@ g_tree_height (GTree *tree)
 
   g_return_val_if_fail (tree != NULL, 0);
 
+  if (tree->is_btree)
+    return g_tree_btree_height (tree);
+
   if (!tree->root)
     return 0;
 
@@ -1474,6 +1800,514 @@ g_tree_nnodes (GTree *tree)
   return tree->nnodes;
 }
 
+/* Returns the leaf which @key belongs in; in B-tree mode */
+static GTreeBNode *
+g_tree_btree_find_leaf (GTree         *tree,
+                        gconstpointer  key)
+{
+  GTreeBNode *bnode = tree->broot;
+
+  while (!bnode->is_leaf)
+    {
+      guint lo = 1, hi = bnode->n_keys;
+
+      /* Find the last child whose smallest key is <= @key */
+      while (lo < hi)
+        {
+          guint mid = lo + (hi - lo) / 2;
+
+          if (tree->key_compare (key, bnode->keys[mid], tree->key_compare_data) < 0)
+            hi = mid;
+          else
+            lo = mid + 1;
+        }
+
+      bnode = bnode->items[lo - 1];
+    }
+
+  return bnode;
+}
+
+/* Returns the index of the first key in @leaf which is >= @key */
+static guint
+g_tree_btree_leaf_lower_bound (GTree         *tree,
+                               GTreeBNode    *leaf,
+                               gconstpointer  key,
+                               gboolean      *found)
+{
+  guint lo = 0, hi = leaf->n_keys;
+
+  while (lo < hi)
+    {
+      guint mid = lo + (hi - lo) / 2;
+
+      if (tree->key_compare (leaf->keys[mid], key, tree->key_compare_data) < 0)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+  *found = (lo < leaf->n_keys &&
+            tree->key_compare (key, leaf->keys[lo], tree->key_compare_data) == 0);
+
+  return lo;
+}
+
+static guint
+g_tree_bnode_child_index (GTreeBNode *parent,
+                          GTreeBNode *child)
+{
+  guint i;
+
+  for (i = 0; parent->items[i] != child; i++)
+    ;
+
+  return i;
+}
+
+/* Records @key as the smallest key under @bnode in its ancestors */
+static void
+g_tree_bnode_update_min (GTreeBNode *bnode,
+                         gpointer    key)
+{
+  while (bnode->parent != NULL)
+    {
+      GTreeBNode *parent = bnode->parent;
+      guint i = g_tree_bnode_child_index (parent, bnode);
+
+      parent->keys[i] = key;
+      if (i > 0)
+        break;
+
+      bnode = parent;
+    }
+}
+
+/* Puts @sibling, which is not empty, after @bnode in their parent */
+static void
+g_tree_bnode_add_sibling (GTree      *tree,
+                          GTreeBNode *bnode,
+                          GTreeBNode *sibling)
+{
+  GTreeBNode *parent = bnode->parent;
+  guint i;
+
+  if (parent == NULL)
+    {
+      parent = g_tree_bnode_new (FALSE);
+      parent->keys[0] = bnode->keys[0];
+      parent->items[0] = bnode;
+      parent->n_keys = 1;
+      bnode->parent = parent;
+      tree->broot = parent;
+    }
+
+  i = g_tree_bnode_child_index (parent, bnode);
+
+  if (parent->n_keys == G_TREE_BNODE_SIZE)
+    {
+      GTreeBNode *other = g_tree_bnode_new (FALSE);
+      guint half, j;
+
+      if (i == G_TREE_BNODE_SIZE - 1)
+        {
+          /* Appending, so start a new branch rather than leave two half
+           * empty ones */
+          other->keys[0] = sibling->keys[0];
+          other->items[0] = sibling;
+          other->n_keys = 1;
+          sibling->parent = other;
+          g_tree_bnode_add_sibling (tree, parent, other);
+          return;
+        }
+
+      half = G_TREE_BNODE_SIZE / 2;
+      other->n_keys = G_TREE_BNODE_SIZE - half;
+      memcpy (other->keys, &parent->keys[half], other->n_keys * sizeof (gpointer));
+      memcpy (other->items, &parent->items[half], other->n_keys * sizeof (gpointer));
+      for (j = 0; j < other->n_keys; j++)
+        ((GTreeBNode *) other->items[j])->parent = other;
+      parent->n_keys = half;
+
+      g_tree_bnode_add_sibling (tree, parent, other);
+
+      if (i >= half)
+        {
+          parent = other;
+          i -= half;
+        }
+    }
+
+  memmove (&parent->keys[i + 2], &parent->keys[i + 1],
+           (parent->n_keys - i - 1) * sizeof (gpointer));
+  memmove (&parent->items[i + 2], &parent->items[i + 1],
+           (parent->n_keys - i - 1) * sizeof (gpointer));
+  parent->keys[i + 1] = sibling->keys[0];
+  parent->items[i + 1] = sibling;
+  parent->n_keys++;
+  sibling->parent = parent;
+}
+
+static void
+g_tree_btree_insert (GTree    *tree,
+                     gpointer  key,
+                     gpointer  value,
+                     gboolean  replace)
+{
+  GTreeBNode *leaf, *other;
+  gboolean found;
+  guint i;
+
+  if (tree->broot == NULL)
+    tree->broot = g_tree_bnode_new (TRUE);
+
+  leaf = g_tree_btree_find_leaf (tree, key);
+  i = g_tree_btree_leaf_lower_bound (tree, leaf, key, &found);
+
+  if (found)
+    {
+      if (tree->value_destroy_func)
+        tree->value_destroy_func (leaf->items[i]);
+
+      leaf->items[i] = value;
+
+      if (replace)
+        {
+          if (tree->key_destroy_func)
+            tree->key_destroy_func (leaf->keys[i]);
+
+          leaf->keys[i] = key;
+          if (i == 0)
+            g_tree_bnode_update_min (leaf, key);
+        }
+      else
+        {
+          /* free the passed key */
+          if (tree->key_destroy_func)
+            tree->key_destroy_func (key);
+        }
+
+      return;
+    }
+
+  g_tree_nnodes_inc_checked (tree, TRUE);
+
+  other = NULL;
+  if (leaf->n_keys == G_TREE_BNODE_SIZE)
+    {
+      /* Split the leaf; or when appending, start a new one */
+      guint half = (i == G_TREE_BNODE_SIZE) ? G_TREE_BNODE_SIZE : G_TREE_BNODE_SIZE / 2;
+
+      other = g_tree_bnode_new (TRUE);
+      other->n_keys = G_TREE_BNODE_SIZE - half;
+      memcpy (other->keys, &leaf->keys[half], other->n_keys * sizeof (gpointer));
+      memcpy (other->items, &leaf->items[half], other->n_keys * sizeof (gpointer));
+      leaf->n_keys = half;
+
+      other->prev = leaf;
+      other->next = leaf->next;
+      if (leaf->next != NULL)
+        leaf->next->prev = other;
+      leaf->next = other;
+
+      if (i >= half && (i > half || half == G_TREE_BNODE_SIZE))
+        {
+          i -= half;
+          leaf = other;
+        }
+    }
+
+  memmove (&leaf->keys[i + 1], &leaf->keys[i], (leaf->n_keys - i) * sizeof (gpointer));
+  memmove (&leaf->items[i + 1], &leaf->items[i], (leaf->n_keys - i) * sizeof (gpointer));
+  leaf->keys[i] = key;
+  leaf->items[i] = value;
+  leaf->n_keys++;
+
+  if (i == 0 && leaf != other)
+    g_tree_bnode_update_min (leaf, key);
+
+  if (other != NULL)
+    g_tree_bnode_add_sibling (tree, other->prev, other);
+}
+
+/* Unlinks and frees @bnode, which is not the root */
+static void
+g_tree_bnode_remove (GTree      *tree,
+                     GTreeBNode *bnode)
+{
+  GTreeBNode *parent = bnode->parent;
+  guint i = g_tree_bnode_child_index (parent, bnode);
+
+  if (bnode->is_leaf)
+    {
+      if (bnode->prev != NULL)
+        bnode->prev->next = bnode->next;
+      if (bnode->next != NULL)
+        bnode->next->prev = bnode->prev;
+    }
+
+  g_free (bnode);
+
+  parent->n_keys--;
+  memmove (&parent->keys[i], &parent->keys[i + 1], (parent->n_keys - i) * sizeof (gpointer));
+  memmove (&parent->items[i], &parent->items[i + 1], (parent->n_keys - i) * sizeof (gpointer));
+
+  if (parent->n_keys == 0)
+    g_tree_bnode_remove (tree, parent);
+  else if (i == 0)
+    g_tree_bnode_update_min (parent, parent->keys[0]);
+}
+
+static gboolean
+g_tree_btree_remove (GTree         *tree,
+                     gconstpointer  key,
+                     gboolean       steal)
+{
+  GTreeBNode *leaf, *next;
+  gpointer old_key, old_value;
+  gboolean found;
+  guint i;
+
+  if (tree->broot == NULL)
+    return FALSE;
+
+  leaf = g_tree_btree_find_leaf (tree, key);
+  i = g_tree_btree_leaf_lower_bound (tree, leaf, key, &found);
+  if (!found)
+    return FALSE;
+
+  old_key = leaf->keys[i];
+  old_value = leaf->items[i];
+
+  leaf->n_keys--;
+  memmove (&leaf->keys[i], &leaf->keys[i + 1], (leaf->n_keys - i) * sizeof (gpointer));
+  memmove (&leaf->items[i], &leaf->items[i + 1], (leaf->n_keys - i) * sizeof (gpointer));
+  tree->nnodes--;
+
+  next = leaf->next;
+
+  if (leaf->n_keys == 0)
+    {
+      if (leaf == tree->broot)
+        {
+          g_free (leaf);
+          tree->broot = NULL;
+        }
+      else
+        g_tree_bnode_remove (tree, leaf);
+    }
+  else
+    {
+      if (i == 0)
+        g_tree_bnode_update_min (leaf, leaf->keys[0]);
+
+      /* Merge mostly empty neighbours */
+      if (next != NULL && next->parent == leaf->parent &&
+          leaf->n_keys + next->n_keys <= G_TREE_BNODE_SIZE / 2)
+        {
+          memcpy (&leaf->keys[leaf->n_keys], next->keys, next->n_keys * sizeof (gpointer));
+          memcpy (&leaf->items[leaf->n_keys], next->items, next->n_keys * sizeof (gpointer));
+          leaf->n_keys += next->n_keys;
+          g_tree_bnode_remove (tree, next);
+        }
+    }
+
+  /* Drop branches with a single child from the top */
+  while (tree->broot != NULL && !tree->broot->is_leaf && tree->broot->n_keys == 1)
+    {
+      GTreeBNode *root = tree->broot->items[0];
+
+      g_free (tree->broot);
+      root->parent = NULL;
+      tree->broot = root;
+    }
+
+  if (!steal)
+    {
+      if (tree->key_destroy_func)
+        tree->key_destroy_func (old_key);
+      if (tree->value_destroy_func)
+        tree->value_destroy_func (old_value);
+    }
+
+  return TRUE;
+}
+
+static gboolean
+g_tree_btree_lookup (GTree         *tree,
+                     gconstpointer  key,
+                     gpointer      *orig_key,
+                     gpointer      *value)
+{
+  GTreeBNode *leaf;
+  gboolean found;
+  guint i;
+
+  if (tree->broot == NULL)
+    return FALSE;
+
+  leaf = g_tree_btree_find_leaf (tree, key);
+  i = g_tree_btree_leaf_lower_bound (tree, leaf, key, &found);
+  if (!found)
+    return FALSE;
+
+  if (orig_key)
+    *orig_key = leaf->keys[i];
+  if (value)
+    *value = leaf->items[i];
+
+  return TRUE;
+}
+
+/* Visits the entries from @lower_key up to before @upper_key, or all of them
+ * if not @bounded */
+static void
+g_tree_btree_foreach_from (GTree         *tree,
+                           gboolean       bounded,
+                           gconstpointer  lower_key,
+                           gconstpointer  upper_key,
+                           GTraverseFunc  func,
+                           gpointer       user_data)
+{
+  GTreeBNode *leaf;
+  guint i;
+
+  if (tree->broot == NULL)
+    return;
+
+  if (bounded)
+    {
+      gboolean found;
+
+      leaf = g_tree_btree_find_leaf (tree, lower_key);
+      i = g_tree_btree_leaf_lower_bound (tree, leaf, lower_key, &found);
+    }
+  else
+    {
+      for (leaf = tree->broot; !leaf->is_leaf; leaf = leaf->items[0])
+        ;
+      i = 0;
+    }
+
+  for (; leaf != NULL; leaf = leaf->next, i = 0)
+    {
+      for (; i < leaf->n_keys; i++)
+        {
+          if (bounded &&
+              tree->key_compare (leaf->keys[i], upper_key, tree->key_compare_data) >= 0)
+            return;
+
+          if ((*func) (leaf->keys[i], leaf->items[i], user_data))
+            return;
+        }
+    }
+}
+
+static gpointer
+g_tree_btree_search (GTree         *tree,
+                     GCompareFunc   search_func,
+                     gconstpointer  user_data)
+{
+  GTreeBNode *bnode = tree->broot;
+  guint lo, hi;
+
+  if (bnode == NULL)
+    return NULL;
+
+  /* @search_func returns < 0 when the wanted key is smaller */
+  while (!bnode->is_leaf)
+    {
+      lo = 1;
+      hi = bnode->n_keys;
+
+      while (lo < hi)
+        {
+          guint mid = lo + (hi - lo) / 2;
+
+          if ((*search_func) (bnode->keys[mid], user_data) < 0)
+            hi = mid;
+          else
+            lo = mid + 1;
+        }
+
+      bnode = bnode->items[lo - 1];
+    }
+
+  lo = 0;
+  hi = bnode->n_keys;
+  while (lo < hi)
+    {
+      guint mid = lo + (hi - lo) / 2;
+      gint dir = (*search_func) (bnode->keys[mid], user_data);
+
+      if (dir == 0)
+        return bnode->items[mid];
+      else if (dir < 0)
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+
+  return NULL;
+}
+
+static void
+g_tree_bnode_free (GTreeBNode *bnode)
+{
+  if (!bnode->is_leaf)
+    {
+      guint i;
+
+      for (i = 0; i < bnode->n_keys; i++)
+        g_tree_bnode_free (bnode->items[i]);
+    }
+
+  g_free (bnode);
+}
+
+static void
+g_tree_btree_remove_all (GTree *tree)
+{
+  GTreeBNode *root = tree->broot;
+  GTreeBNode *leaf;
+
+  if (root == NULL)
+    return;
+
+  tree->broot = NULL;
+  tree->nnodes = 0;
+
+  for (leaf = root; !leaf->is_leaf; leaf = leaf->items[0])
+    ;
+
+  for (; leaf != NULL; leaf = leaf->next)
+    {
+      guint i;
+
+      for (i = 0; i < leaf->n_keys; i++)
+        {
+          if (tree->key_destroy_func)
+            tree->key_destroy_func (leaf->keys[i]);
+          if (tree->value_destroy_func)
+            tree->value_destroy_func (leaf->items[i]);
+        }
+    }
+
+  g_tree_bnode_free (root);
+}
+
+static gint
+g_tree_btree_height (GTree *tree)
+{
+  GTreeBNode *bnode;
+  gint height = 0;
+
+  for (bnode = tree->broot; bnode != NULL; bnode = bnode->is_leaf ? NULL : bnode->items[0])
+    height++;
+
+  return height;
+}
+
 static GTreeNode *
 g_tree_node_balance (GTreeNode *node)
 {
@@ -80,6 +80,19 @@ GTree*   g_tree_new_full        (GCompareDataFunc  key_compare_func,
                                  gpointer          key_compare_data,
                                  GDestroyNotify    key_destroy_func,
                                  GDestroyNotify    value_destroy_func);
+GLIB_AVAILABLE_IN_2_82
+GTree*   g_tree_new_btree       (GCompareDataFunc  key_compare_func,
+                                 gpointer          key_compare_data,
+                                 GDestroyNotify    key_destroy_func,
+                                 GDestroyNotify    value_destroy_func);
+GLIB_AVAILABLE_IN_2_82
+GTree*   g_tree_new_from_sorted (GCompareDataFunc  key_compare_func,
+                                 gpointer          key_compare_data,
+                                 GDestroyNotify    key_destroy_func,
+                                 GDestroyNotify    value_destroy_func,
+                                 gpointer         *keys,
+                                 gpointer         *values,
+                                 gsize             n_entries);
 GLIB_AVAILABLE_IN_2_68
 GTreeNode *g_tree_node_first (GTree *tree);
 GLIB_AVAILABLE_IN_2_68
@@ -139,6 +152,12 @@ GLIB_AVAILABLE_IN_ALL
 void     g_tree_foreach         (GTree            *tree,
                                  GTraverseFunc	   func,
                                  gpointer	   user_data);
+GLIB_AVAILABLE_IN_2_82
+void     g_tree_foreach_range   (GTree            *tree,
+                                 gconstpointer     lower_key,
+                                 gconstpointer     upper_key,
+                                 GTraverseFunc     func,
+                                 gpointer          user_data);
 GLIB_AVAILABLE_IN_2_68
 void g_tree_foreach_node (GTree *tree,
                           GTraverseNodeFunc func,
@@ -820,6 +820,23 @@ gchar*   g_utf8_offset_to_pointer (const gchar *str,
 GLIB_AVAILABLE_IN_ALL
 glong    g_utf8_pointer_to_offset (const gchar *str,
                                    const gchar *pos) G_GNUC_PURE;
+
+typedef struct _GUtf8Index GUtf8Index;
+
+GLIB_AVAILABLE_IN_2_82
+GUtf8Index  *g_utf8_index_new               (const gchar *str,
+                                             gssize       len);
+GLIB_AVAILABLE_IN_2_82
+void         g_utf8_index_free              (GUtf8Index  *index_);
+GLIB_AVAILABLE_IN_2_82
+glong        g_utf8_index_get_length        (GUtf8Index  *index_);
+GLIB_AVAILABLE_IN_2_82
+const gchar *g_utf8_index_offset_to_pointer (GUtf8Index  *index_,
+                                             glong        offset);
+GLIB_AVAILABLE_IN_2_82
+glong        g_utf8_index_pointer_to_offset (GUtf8Index  *index_,
+                                             const gchar *pos);
+
 GLIB_AVAILABLE_IN_ALL
 gchar*   g_utf8_prev_char         (const gchar *p) G_GNUC_PURE;
 GLIB_AVAILABLE_IN_ALL
@@ -889,6 +906,20 @@ gchar*     g_utf16_to_utf8     (const gunichar2  *str,
                                 glong            *items_read,
                                 glong            *items_written,
                                 GError          **error) G_GNUC_MALLOC;
+GLIB_AVAILABLE_IN_2_82
+gssize     g_utf8_to_utf16_into (const gchar      *str,
+                                 gssize            len,
+                                 gunichar2        *buffer,
+                                 gsize             buffer_len,
+                                 gsize            *items_read,
+                                 GError          **error);
+GLIB_AVAILABLE_IN_2_82
+gssize     g_utf16_to_utf8_into (const gunichar2  *str,
+                                 gssize            len,
+                                 gchar            *buffer,
+                                 gsize             buffer_len,
+                                 gsize            *items_read,
+                                 GError          **error);
 GLIB_AVAILABLE_IN_ALL
 gunichar2 *g_ucs4_to_utf16     (const gunichar   *str,
                                 glong             len,
@@ -29,6 +29,24 @@ gunichar *_g_utf8_normalize_wc (const gchar    *str,
                                 gssize          max_len,
 				GNormalizeMode  mode);
 
+gsize     _g_utf8_ascii_prefix_len (const gchar *str,
+                                    gsize        len);
+
+gssize    _g_utf8_to_utf16_convert (const gchar      *str,
+                                    gsize             len,
+                                    gunichar2        *buffer,
+                                    gsize             buffer_len,
+                                    gboolean          allow_partial,
+                                    gsize            *items_read,
+                                    GError          **error);
+gssize    _g_utf16_to_utf8_convert (const gunichar2  *str,
+                                    gsize             len,
+                                    gchar            *buffer,
+                                    gsize             buffer_len,
+                                    gboolean          allow_partial,
+                                    gsize            *items_read,
+                                    GError          **error);
+
 G_END_DECLS
 
 #endif /* __G_UNICODE_PRIVATE_H__ */
@@ -22,10 +22,12 @@
 #include "config.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "gunicode.h"
 #include "gunidecomp.h"
 #include "gmem.h"
+#include "gstrfuncs.h"
 #include "gtestutils.h"
 #include "gunicomp.h"
 #include "gunicodeprivate.h"
@@ -48,6 +50,24 @@
       ? CC_PART2 (((Char) - 0xe0000) >> 8, (Char) & 0xff) \
       : 0))
 
+#define NFQC_PART1(Page, Char) \
+  ((nfqc_table_part1[Page] >= G_UNICODE_MAX_TABLE_INDEX) \
+   ? (nfqc_table_part1[Page] - G_UNICODE_MAX_TABLE_INDEX) \
+   : (nfqc_data[nfqc_table_part1[Page]][Char]))
+
+#define NFQC_PART2(Page, Char) \
+  ((nfqc_table_part2[Page] >= G_UNICODE_MAX_TABLE_INDEX) \
+   ? (nfqc_table_part2[Page] - G_UNICODE_MAX_TABLE_INDEX) \
+   : (nfqc_data[nfqc_table_part2[Page]][Char]))
+
+/* The G_UNICODE_*_QC_* flags of a character */
+#define NFQC(Char) \
+  (((Char) <= G_UNICODE_LAST_CHAR_PART1) \
+   ? NFQC_PART1 ((Char) >> 8, (Char) & 0xff) \
+   : (((Char) >= 0xe0000 && (Char) <= G_UNICODE_LAST_CHAR) \
+      ? NFQC_PART2 (((Char) - 0xe0000) >> 8, (Char) & 0xff) \
+      : 0))
+
 /**
  * g_unichar_combining_class:
  * @uc: a Unicode character
@@ -494,6 +514,64 @@ _g_utf8_normalize_wc (const gchar    *str,
   return wc_buffer;
 }
 
+/* The quick check of UAX #15: %TRUE if @str, which is @len bytes of valid
+ * UTF-8, is known to be in the normalization form @mode already. %FALSE
+ * means that it is not, or that it may not be and only the full algorithm
+ * can tell. */
+static gboolean
+utf8_is_normalized_quick (const gchar    *str,
+                          gsize           len,
+                          GNormalizeMode  mode)
+{
+  const gchar *p = str + _g_utf8_ascii_prefix_len (str, len);
+  const gchar *end = str + len;
+  gint last_cc = 0;
+  guint8 mask;
+
+  switch (mode)
+    {
+    case G_NORMALIZE_NFD:
+      mask = G_UNICODE_NFD_QC_NO;
+      break;
+    case G_NORMALIZE_NFKD:
+      mask = G_UNICODE_NFKD_QC_NO;
+      break;
+    case G_NORMALIZE_NFC:
+      mask = G_UNICODE_NFC_QC_NO | G_UNICODE_NFC_QC_MAYBE;
+      break;
+    case G_NORMALIZE_NFKC:
+      mask = G_UNICODE_NFKC_QC_NO | G_UNICODE_NFKC_QC_MAYBE;
+      break;
+    default:
+      return FALSE;
+    }
+
+  while (p < end)
+    {
+      gunichar wc;
+      gint cc;
+
+      /* ASCII characters are starters, and normalized in every form */
+      if ((guchar) *p < 0x80)
+        {
+          p += _g_utf8_ascii_prefix_len (p, end - p);
+          last_cc = 0;
+          continue;
+        }
+
+      wc = g_utf8_get_char (p);
+      cc = COMBINING_CLASS (wc);
+
+      if ((cc != 0 && last_cc > cc) || (NFQC (wc) & mask) != 0)
+        return FALSE;
+
+      last_cc = cc;
+      p = g_utf8_next_char (p);
+    }
+
+  return TRUE;
+}
+
 /**
  * g_utf8_normalize:
  * @str: a UTF-8 encoded string.
@@ -535,8 +613,25 @@ g_utf8_normalize (const gchar    *str,
 		  gssize          len,
 		  GNormalizeMode  mode)
 {
-  gunichar *result_wc = _g_utf8_normalize_wc (str, len, mode);
+  gunichar *result_wc;
   gchar *result = NULL;
+  const gchar *nul;
+  gsize n_bytes;
+
+  /* Like the full algorithm, stop at the first nul */
+  if (len < 0)
+    n_bytes = strlen (str);
+  else if ((nul = memchr (str, '\0', len)) != NULL)
+    n_bytes = nul - str;
+  else
+    n_bytes = len;
+
+  /* Most text is already normalized, and then the result is a copy */
+  if (g_utf8_validate_len (str, n_bytes, NULL) &&
+      utf8_is_normalized_quick (str, n_bytes, mode))
+    return g_strndup (str, n_bytes);
+
+  result_wc = _g_utf8_normalize_wc (str, len, mode);
 
   if (G_LIKELY (result_wc != NULL))
     {
@@ -35,6 +35,14 @@
 #include "gmirroringtable.h"
 #include "gscripttable.h"
 #include "gunicodeprivate.h"
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CASE_MAP_SSE2
+#elif defined (__aarch64__) && defined (__ARM_NEON)
+#include <arm_neon.h>
+#define CASE_MAP_NEON
+#endif
 #ifdef G_OS_WIN32
 #include "gwin32.h"
 #endif
@@ -820,6 +828,72 @@ output_special_case (gchar *out_buffer,
   return len;
 }
 
+/* Case maps the run of ASCII characters at the start of @str, which is at
+ * most @max_len bytes long, stopping at the first non-ASCII byte or nul.
+ * The letters from @first to @first + 25 have their case changed, and
+ * everything else is copied. The result is written to @out_buffer if it
+ * is not %NULL. Returns the length of the run. */
+static gsize
+ascii_case_map_run (const gchar *str,
+                    gsize        max_len,
+                    gchar       *out_buffer,
+                    gchar        first)
+{
+  const guchar *p = (const guchar *) str;
+  gsize i = 0;
+
+#if defined (CASE_MAP_SSE2)
+  /* Shift @first to -128, so that letters are the 26 lowest signed bytes */
+  const __m128i shift = _mm_set1_epi8 ((char) (0x80 - first));
+  const __m128i limit = _mm_set1_epi8 ((char) (-128 + 26));
+  const __m128i case_bit = _mm_set1_epi8 (0x20);
+  const __m128i zero = _mm_setzero_si128 ();
+
+  for (; max_len - i >= 16; i += 16)
+    {
+      __m128i v = _mm_loadu_si128 ((const __m128i *) (p + i));
+      __m128i letters;
+
+      if (_mm_movemask_epi8 (_mm_or_si128 (v, _mm_cmpeq_epi8 (v, zero))) != 0)
+        break;
+
+      if (out_buffer)
+        {
+          letters = _mm_cmplt_epi8 (_mm_add_epi8 (v, shift), limit);
+          v = _mm_xor_si128 (v, _mm_and_si128 (letters, case_bit));
+          _mm_storeu_si128 ((__m128i *) (out_buffer + i), v);
+        }
+    }
+#elif defined (CASE_MAP_NEON)
+  const uint8x16_t first_v = vdupq_n_u8 ((guchar) first);
+  const uint8x16_t n_letters = vdupq_n_u8 (26);
+  const uint8x16_t case_bit = vdupq_n_u8 (0x20);
+
+  for (; max_len - i >= 16; i += 16)
+    {
+      uint8x16_t v = vld1q_u8 (p + i);
+
+      /* Stop at non-ASCII bytes, and at nul: (v - 1) wraps for it */
+      if (vmaxvq_u8 (vorrq_u8 (v, vsubq_u8 (v, vdupq_n_u8 (1)))) >= 0x80)
+        break;
+
+      if (out_buffer)
+        {
+          uint8x16_t letters = vcltq_u8 (vsubq_u8 (v, first_v), n_letters);
+          vst1q_u8 ((guint8 *) out_buffer + i, veorq_u8 (v, vandq_u8 (letters, case_bit)));
+        }
+    }
+#endif
+
+  for (; i < max_len && p[i] != '\0' && p[i] < 0x80; i++)
+    {
+      if (out_buffer)
+        out_buffer[i] = (guchar) (p[i] - first) < 26 ? p[i] ^ 0x20 : p[i];
+    }
+
+  return i;
+}
+
 static gsize
 real_toupper (const gchar *str,
 	      gssize       max_len,
@@ -833,10 +907,24 @@ real_toupper (const gchar *str,
 
   while ((max_len < 0 || p < str + max_len) && *p)
     {
-      gunichar c = g_utf8_get_char (p);
-      int t = TYPE (c);
+      gunichar c;
+      int t;
       gunichar val;
 
+      /* Outside of Turkic and Lithuanian locales, ASCII case mapping
+       * doesn't depend on the context */
+      if (locale_type == LOCALE_NORMAL && max_len >= 0 && (guchar) *p < 0x80)
+        {
+          gsize run = ascii_case_map_run (p, str + max_len - p,
+                                          out_buffer ? out_buffer + len : NULL, 'a');
+
+          p += run;
+          len += run;
+          continue;
+        }
+
+      c = g_utf8_get_char (p);
+      t = TYPE (c);
       last = p;
       p = g_utf8_next_char (p);
 
@@ -960,7 +1048,11 @@ g_utf8_strup (const gchar *str,
   g_return_val_if_fail (str != NULL, NULL);
 
   locale_type = get_locale_type ();
-  
+
+  /* A known length lets ASCII be case mapped in blocks */
+  if (len < 0)
+    len = strlen (str);
+
   /*
    * We use a two pass approach to keep memory management simple
    */
@@ -1006,10 +1098,22 @@ real_tolower (const gchar *str,
 
   while ((max_len < 0 || p < str + max_len) && *p)
     {
-      gunichar c = g_utf8_get_char (p);
-      int t = TYPE (c);
+      gunichar c;
+      int t;
       gunichar val;
 
+      if (locale_type == LOCALE_NORMAL && max_len >= 0 && (guchar) *p < 0x80)
+        {
+          gsize run = ascii_case_map_run (p, str + max_len - p,
+                                          out_buffer ? out_buffer + len : NULL, 'A');
+
+          p += run;
+          len += run;
+          continue;
+        }
+
+      c = g_utf8_get_char (p);
+      t = TYPE (c);
       last = p;
       p = g_utf8_next_char (p);
 
@@ -1154,7 +1258,11 @@ g_utf8_strdown (const gchar *str,
   g_return_val_if_fail (str != NULL, NULL);
 
   locale_type = get_locale_type ();
-  
+
+  /* A known length lets ASCII be case mapped in blocks */
+  if (len < 0)
+    len = strlen (str);
+
   /*
    * We use a two pass approach to keep memory management simple
    */
@@ -1195,15 +1303,32 @@ g_utf8_casefold (const gchar *str,
 
   g_return_val_if_fail (str != NULL, NULL);
 
-  result = g_string_new (NULL);
+  if (len < 0)
+    len = strlen (str);
+
+  result = g_string_sized_new (len);
   p = str;
-  while ((len < 0 || p < str + len) && *p)
+  while (p < str + len && *p)
     {
-      gunichar ch = g_utf8_get_char (p);
-
+      gunichar ch;
       int start = 0;
       int end = G_N_ELEMENTS (casefold_table);
 
+      /* ASCII folds to lowercase, and is done in blocks */
+      if ((guchar) *p < 0x80)
+        {
+          gsize old_len = result->len;
+          gsize run;
+
+          g_string_set_size (result, old_len + (str + len - p));
+          run = ascii_case_map_run (p, str + len - p, result->str + old_len, 'A');
+          g_string_truncate (result, old_len + run);
+          p += run;
+          continue;
+        }
+
+      ch = g_utf8_get_char (p);
+
       if (ch >= casefold_table[start].ch &&
           ch <= casefold_table[end - 1].ch)
 	{
@@ -818,52 +818,46 @@ g_uri_get_default_scheme_port (const char *scheme)
   return -1;
 }
 
-static gboolean
-g_uri_split_internal (const gchar  *uri_string,
-                      GUriFlags     flags,
-                      gchar       **scheme,
-                      gchar       **userinfo,
-                      gchar       **user,
-                      gchar       **password,
-                      gchar       **auth_params,
-                      gchar       **host,
-                      gint         *port,
-                      gchar       **path,
-                      gchar       **query,
-                      gchar       **fragment,
-                      GError      **error)
+/* The position of each component of a URI string, as found by
+ * uri_find_components().  Components which are not present have a %NULL
+ * @start. */
+typedef struct
+{
+  const gchar *start;
+  gsize        length;
+} UriComponent;
+
+typedef struct
+{
+  UriComponent scheme;
+  UriComponent userinfo;
+  UriComponent host;
+  UriComponent port;
+  UriComponent path;
+  UriComponent query;
+  UriComponent fragment;
+} UriComponents;
+
+static inline void
+uri_component_set (UriComponent *component,
+                   const gchar  *start,
+                   const gchar  *end)
+{
+  component->start = start;
+  component->length = end - start;
+}
+
+/* Finds the boundaries of the components of @uri_string, without
+ * decoding or validating them. */
+static void
+uri_find_components (const gchar   *uri_string,
+                     GUriFlags      flags,
+                     UriComponents *components)
 {
   const gchar *end, *colon, *at, *path_start, *semi, *question;
   const gchar *p, *bracket, *hostend;
-  gchar *cleaned_uri_string = NULL;
-  gchar *normalized_scheme = NULL;
 
-  if (scheme)
-    *scheme = NULL;
-  if (userinfo)
-    *userinfo = NULL;
-  if (user)
-    *user = NULL;
-  if (password)
-    *password = NULL;
-  if (auth_params)
-    *auth_params = NULL;
-  if (host)
-    *host = NULL;
-  if (port)
-    *port = -1;
-  if (path)
-    *path = NULL;
-  if (query)
-    *query = NULL;
-  if (fragment)
-    *fragment = NULL;
-
-  if ((flags & G_URI_FLAGS_PARSE_RELAXED) && strpbrk (uri_string, " \t\n\r"))
-    {
-      cleaned_uri_string = uri_cleanup (uri_string);
-      uri_string = cleaned_uri_string;
-    }
+  memset (components, 0, sizeof (*components));
 
   /* Find scheme */
   p = uri_string;
@@ -874,17 +868,11 @@ g_uri_split_internal (const gchar  *uri_string,
 
   if (p > uri_string && *p == ':')
     {
-      normalized_scheme = g_ascii_strdown (uri_string, p - uri_string);
-      if (scheme)
-        *scheme = g_steal_pointer (&normalized_scheme);
+      uri_component_set (&components->scheme, uri_string, p);
       p++;
     }
   else
-    {
-      if (scheme)
-        *scheme = NULL;
-      p = uri_string;
-    }
+    p = uri_string;
 
   /* Check for authority */
   if (strncmp (p, "//", 2) == 0)
@@ -914,19 +902,7 @@ g_uri_split_internal (const gchar  *uri_string,
               while (next_at);
             }
 
-          if (user || password || auth_params ||
-              (flags & (G_URI_FLAGS_HAS_PASSWORD|G_URI_FLAGS_HAS_AUTH_PARAMS)))
-            {
-              if (!parse_userinfo (p, at - p, flags,
-                                   user, password, auth_params,
-                                   error))
-                goto fail;
-            }
-
-          if (!uri_normalize (userinfo, p, at - p, flags,
-                              G_URI_ERROR_BAD_USER, error))
-            goto fail;
-
+          uri_component_set (&components->userinfo, p, at);
           p = at + 1;
         }
 
@@ -963,15 +939,10 @@ g_uri_split_internal (const gchar  *uri_string,
         colon = memchr (p, ':', path_start - p);
 
       hostend = colon ? colon : path_start;
-      if (!parse_host (p, hostend - p, flags, host, error))
-        goto fail;
+      uri_component_set (&components->host, p, hostend);
 
       if (colon && colon != path_start - 1)
-        {
-          p = colon + 1;
-          if (!parse_port (p, path_start - p, port, error))
-            goto fail;
-        }
+        uri_component_set (&components->port, colon + 1, path_start);
 
       p = path_start;
     }
@@ -979,25 +950,118 @@ g_uri_split_internal (const gchar  *uri_string,
   /* Find fragment. */
   end = p + strcspn (p, "#");
   if (*end == '#')
-    {
-      if (!uri_normalize (fragment, end + 1, strlen (end + 1),
-                          flags | (flags & G_URI_FLAGS_ENCODED_FRAGMENT ? G_URI_FLAGS_ENCODED : 0),
-                          G_URI_ERROR_BAD_FRAGMENT, error))
-        goto fail;
-    }
+    uri_component_set (&components->fragment, end + 1, end + 1 + strlen (end + 1));
 
   /* Find query */
   question = memchr (p, '?', end - p);
   if (question)
     {
-      if (!uri_normalize (query, question + 1, end - (question + 1),
-                          flags | (flags & G_URI_FLAGS_ENCODED_QUERY ? G_URI_FLAGS_ENCODED : 0),
-                          G_URI_ERROR_BAD_QUERY, error))
-        goto fail;
+      uri_component_set (&components->query, question + 1, end);
       end = question;
     }
 
-  if (!uri_normalize (path, p, end - p,
+  uri_component_set (&components->path, p, end);
+}
+
+static gboolean
+g_uri_split_internal (const gchar  *uri_string,
+                      GUriFlags     flags,
+                      gchar       **scheme,
+                      gchar       **userinfo,
+                      gchar       **user,
+                      gchar       **password,
+                      gchar       **auth_params,
+                      gchar       **host,
+                      gint         *port,
+                      gchar       **path,
+                      gchar       **query,
+                      gchar       **fragment,
+                      GError      **error)
+{
+  UriComponents components;
+  gchar *cleaned_uri_string = NULL;
+  gchar *normalized_scheme = NULL;
+
+  if (scheme)
+    *scheme = NULL;
+  if (userinfo)
+    *userinfo = NULL;
+  if (user)
+    *user = NULL;
+  if (password)
+    *password = NULL;
+  if (auth_params)
+    *auth_params = NULL;
+  if (host)
+    *host = NULL;
+  if (port)
+    *port = -1;
+  if (path)
+    *path = NULL;
+  if (query)
+    *query = NULL;
+  if (fragment)
+    *fragment = NULL;
+
+  if ((flags & G_URI_FLAGS_PARSE_RELAXED) && strpbrk (uri_string, " \t\n\r"))
+    {
+      cleaned_uri_string = uri_cleanup (uri_string);
+      uri_string = cleaned_uri_string;
+    }
+
+  uri_find_components (uri_string, flags, &components);
+
+  if (components.scheme.start != NULL)
+    {
+      normalized_scheme = g_ascii_strdown (components.scheme.start,
+                                           components.scheme.length);
+      if (scheme)
+        *scheme = g_steal_pointer (&normalized_scheme);
+    }
+
+  if (components.userinfo.start != NULL)
+    {
+      if (user || password || auth_params ||
+          (flags & (G_URI_FLAGS_HAS_PASSWORD|G_URI_FLAGS_HAS_AUTH_PARAMS)))
+        {
+          if (!parse_userinfo (components.userinfo.start,
+                               components.userinfo.length, flags,
+                               user, password, auth_params,
+                               error))
+            goto fail;
+        }
+
+      if (!uri_normalize (userinfo, components.userinfo.start,
+                          components.userinfo.length, flags,
+                          G_URI_ERROR_BAD_USER, error))
+        goto fail;
+    }
+
+  if (components.host.start != NULL &&
+      !parse_host (components.host.start, components.host.length, flags,
+                   host, error))
+    goto fail;
+
+  if (components.port.start != NULL &&
+      !parse_port (components.port.start, components.port.length, port,
+                   error))
+    goto fail;
+
+  if (components.fragment.start != NULL &&
+      !uri_normalize (fragment, components.fragment.start,
+                      components.fragment.length,
+                      flags | (flags & G_URI_FLAGS_ENCODED_FRAGMENT ? G_URI_FLAGS_ENCODED : 0),
+                      G_URI_ERROR_BAD_FRAGMENT, error))
+    goto fail;
+
+  if (components.query.start != NULL &&
+      !uri_normalize (query, components.query.start,
+                      components.query.length,
+                      flags | (flags & G_URI_FLAGS_ENCODED_QUERY ? G_URI_FLAGS_ENCODED : 0),
+                      G_URI_ERROR_BAD_QUERY, error))
+    goto fail;
+
+  if (!uri_normalize (path, components.path.start, components.path.length,
                       flags | (flags & G_URI_FLAGS_ENCODED_PATH ? G_URI_FLAGS_ENCODED : 0),
                       G_URI_ERROR_BAD_PATH, error))
     goto fail;
@@ -1244,6 +1308,176 @@ g_uri_split_network (const gchar  *uri_string,
   return TRUE;
 }
 
+/* Checks that the %-encodings in a component are well formed, without
+ * decoding it */
+static gboolean
+uri_validate_encoding (const UriComponent *component,
+                       GUriFlags           flags,
+                       GUriError           parse_error,
+                       GError            **error)
+{
+  const gchar *s, *end;
+
+  if (component->start == NULL || (flags & G_URI_FLAGS_PARSE_RELAXED))
+    return TRUE;
+
+  s = component->start;
+  end = s + component->length;
+  while ((s = memchr (s, '%', end - s)) != NULL)
+    {
+      if (s + 2 >= end ||
+          !g_ascii_isxdigit (s[1]) ||
+          !g_ascii_isxdigit (s[2]))
+        {
+          g_set_error_literal (error, G_URI_ERROR, parse_error,
+                               /* xgettext: no-c-format */
+                               _("Invalid %-encoding in URI"));
+          return FALSE;
+        }
+
+      s += 3;
+    }
+
+  return TRUE;
+}
+
+static void
+uri_component_to_span (const UriComponent *component,
+                       const gchar        *uri_string,
+                       GUriSpan           *span)
+{
+  if (span == NULL)
+    return;
+
+  if (component != NULL && component->start != NULL)
+    {
+      span->offset = component->start - uri_string;
+      span->length = component->length;
+    }
+  else
+    {
+      span->offset = -1;
+      span->length = 0;
+    }
+}
+
+/**
+ * g_uri_split_view:
+ * @uri_ref: a string containing a relative or absolute URI
+ * @flags: flags for parsing @uri_ref
+ * @scheme: (out caller-allocates) (optional): on return, the position of
+ *    the scheme
+ * @userinfo: (out caller-allocates) (optional): on return, the position
+ *    of the userinfo
+ * @host: (out caller-allocates) (optional): on return, the position of
+ *    the host
+ * @port: (out caller-allocates) (optional): on return, the position of
+ *    the port
+ * @path: (out caller-allocates) (optional): on return, the position of
+ *    the path
+ * @query: (out caller-allocates) (optional): on return, the position of
+ *    the query
+ * @fragment: (out caller-allocates) (optional): on return, the position
+ *    of the fragment
+ * @error: #GError for error reporting, or %NULL to ignore.
+ *
+ * Parses @uri_ref like g_uri_split(), but returns the position of each
+ * component in @uri_ref instead of copying it, so that no memory is
+ * allocated.
+ *
+ * Components are returned exactly as they appear in @uri_ref: the scheme
+ * is not converted to lowercase, `%`-encoded characters are not decoded,
+ * and no scheme-based normalization is done. The brackets around an IPv6
+ * address are not included in @host. Components which are not present
+ * have an offset of `-1`; as with g_uri_split(), the path is always
+ * present, though it may be empty.
+ *
+ * Unless %G_URI_FLAGS_PARSE_RELAXED is given, @uri_ref is checked for
+ * invalid `%`-encodings, ports and IPv6 addresses. Other names are not
+ * checked, in particular hosts are not checked to be valid DNS names.
+ * Whitespace is never removed from @uri_ref, so the offsets always refer
+ * to the string that was passed in. Flags other than
+ * %G_URI_FLAGS_PARSE_RELAXED are ignored.
+ *
+ * The decoded value of a component can be obtained with
+ * g_uri_unescape_segment_to_buffer().
+ *
+ * Returns: (skip): %TRUE if @uri_ref parsed successfully, %FALSE
+ *   on error.
+ *
+ * Since: 2.82
+ */
+gboolean
+g_uri_split_view (const gchar  *uri_ref,
+                  GUriFlags     flags,
+                  GUriSpan     *scheme,
+                  GUriSpan     *userinfo,
+                  GUriSpan     *host,
+                  GUriSpan     *port,
+                  GUriSpan     *path,
+                  GUriSpan     *query,
+                  GUriSpan     *fragment,
+                  GError      **error)
+{
+  UriComponents components;
+
+  g_return_val_if_fail (uri_ref != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  uri_find_components (uri_ref, flags, &components);
+
+  if (!uri_validate_encoding (&components.userinfo, flags,
+                              G_URI_ERROR_BAD_USER, error))
+    goto fail;
+
+  if (components.host.start != NULL && *components.host.start == '[')
+    {
+      if (!parse_ip_literal (components.host.start, components.host.length,
+                             flags, NULL, error))
+        goto fail;
+
+      components.host.start++;
+      components.host.length -= 2;
+    }
+  else if (!uri_validate_encoding (&components.host, flags,
+                                   G_URI_ERROR_BAD_HOST, error))
+    goto fail;
+
+  if (components.port.start != NULL &&
+      !parse_port (components.port.start, components.port.length, NULL,
+                   error))
+    goto fail;
+
+  if (!uri_validate_encoding (&components.fragment, flags,
+                              G_URI_ERROR_BAD_FRAGMENT, error) ||
+      !uri_validate_encoding (&components.query, flags,
+                              G_URI_ERROR_BAD_QUERY, error) ||
+      !uri_validate_encoding (&components.path, flags,
+                              G_URI_ERROR_BAD_PATH, error))
+    goto fail;
+
+  uri_component_to_span (&components.scheme, uri_ref, scheme);
+  uri_component_to_span (&components.userinfo, uri_ref, userinfo);
+  uri_component_to_span (&components.host, uri_ref, host);
+  uri_component_to_span (&components.port, uri_ref, port);
+  uri_component_to_span (&components.path, uri_ref, path);
+  uri_component_to_span (&components.query, uri_ref, query);
+  uri_component_to_span (&components.fragment, uri_ref, fragment);
+
+  return TRUE;
+
+ fail:
+  uri_component_to_span (NULL, uri_ref, scheme);
+  uri_component_to_span (NULL, uri_ref, userinfo);
+  uri_component_to_span (NULL, uri_ref, host);
+  uri_component_to_span (NULL, uri_ref, port);
+  uri_component_to_span (NULL, uri_ref, path);
+  uri_component_to_span (NULL, uri_ref, query);
+  uri_component_to_span (NULL, uri_ref, fragment);
+
+  return FALSE;
+}
+
 /**
  * g_uri_is_valid:
  * @uri_string: a string containing an absolute URI
@@ -2647,6 +2881,99 @@ g_uri_unescape_segment (const gchar *escaped_string,
   return unescaped;
 }
 
+/**
+ * g_uri_unescape_segment_to_buffer:
+ * @escaped_string: a string
+ * @escaped_string_end: (nullable): pointer to end of @escaped_string,
+ *   may be %NULL
+ * @illegal_characters: (nullable): an optional string of illegal
+ *   characters not to be allowed, may be %NULL
+ * @buffer: (out caller-allocates) (array length=buffer_size): buffer to
+ *   write the unescaped string to
+ * @buffer_size: size of @buffer, in bytes
+ *
+ * Unescapes a segment of an escaped string like g_uri_unescape_segment(),
+ * writing the result to @buffer instead of allocating a new string.
+ *
+ * The result is never longer than the escaped string, so a buffer one
+ * byte longer than the segment is always large enough. @buffer may also
+ * be @escaped_string itself, to unescape the segment in place.
+ *
+ * As with g_strlcpy(), at most @buffer_size - 1 bytes are written, the
+ * result is always nul-terminated if @buffer_size is non-zero, and the
+ * return value is the length of the complete unescaped string. If it is
+ * greater than or equal to @buffer_size, the output was truncated.
+ *
+ * Returns: the length of the unescaped string, or `-1` on error (in the
+ *   cases where g_uri_unescape_segment() would return %NULL)
+ *
+ * Since: 2.82
+ **/
+gssize
+g_uri_unescape_segment_to_buffer (const gchar *escaped_string,
+                                  const gchar *escaped_string_end,
+                                  const gchar *illegal_characters,
+                                  gchar       *buffer,
+                                  gsize        buffer_size)
+{
+  const gchar *s, *end, *pct;
+  gsize len = 0;
+
+  g_return_val_if_fail (escaped_string != NULL, -1);
+  g_return_val_if_fail (buffer != NULL || buffer_size == 0, -1);
+
+  if (escaped_string_end)
+    end = escaped_string_end;
+  else
+    end = escaped_string + strlen (escaped_string);
+
+  /* Copy everything between %-escapes as it is. The output is never ahead
+   * of the input, so this also works in place. */
+  for (s = escaped_string; s < end; s = pct + 3)
+    {
+      gsize chunk;
+      gchar c;
+
+      pct = memchr (s, '%', end - s);
+      chunk = (pct ? pct : end) - s;
+
+      if (escaped_string_end && memchr (s, '\0', chunk))
+        goto fail;
+
+      if (len + 1 < buffer_size)
+        memmove (buffer + len, s, MIN (chunk, buffer_size - 1 - len));
+      len += chunk;
+
+      if (pct == NULL)
+        break;
+
+      if (pct + 2 >= end ||
+          !g_ascii_isxdigit (pct[1]) ||
+          !g_ascii_isxdigit (pct[2]))
+        goto fail;
+
+      c = HEXCHAR (pct);
+      if (c == '\0' ||
+          (illegal_characters && strchr (illegal_characters, c)))
+        goto fail;
+
+      if (len + 1 < buffer_size)
+        buffer[len] = c;
+      len++;
+    }
+
+  if (buffer_size > 0)
+    buffer[MIN (len, buffer_size - 1)] = '\0';
+
+  return len;
+
+ fail:
+  if (buffer_size > 0)
+    buffer[0] = '\0';
+
+  return -1;
+}
+
 /**
  * g_uri_unescape_string:
  * @escaped_string: an escaped string to be unescaped.
@@ -124,6 +124,35 @@ gboolean     g_uri_split_network    (const gchar  *uri_string,
                                      gint         *port,
                                      GError      **error);
 
+/**
+ * GUriSpan:
+ * @offset: offset of the component from the start of the URI string, in
+ *   bytes, or `-1` if the component is not present
+ * @length: length of the component, in bytes
+ *
+ * The position of a component within a URI string, as returned by
+ * g_uri_split_view().
+ *
+ * Since: 2.82
+ */
+GLIB_AVAILABLE_TYPE_IN_2_82
+typedef struct {
+  gssize offset;
+  gsize  length;
+} GUriSpan;
+
+GLIB_AVAILABLE_IN_2_82
+gboolean     g_uri_split_view       (const gchar  *uri_ref,
+                                     GUriFlags     flags,
+                                     GUriSpan     *scheme,
+                                     GUriSpan     *userinfo,
+                                     GUriSpan     *host,
+                                     GUriSpan     *port,
+                                     GUriSpan     *path,
+                                     GUriSpan     *query,
+                                     GUriSpan     *fragment,
+                                     GError      **error);
+
 GLIB_AVAILABLE_IN_2_66
 gboolean     g_uri_is_valid         (const gchar  *uri_string,
                                      GUriFlags     flags,
@@ -393,6 +422,12 @@ GLIB_AVAILABLE_IN_ALL
 char *      g_uri_unescape_segment (const char *escaped_string,
                                     const char *escaped_string_end,
                                     const char *illegal_characters);
+GLIB_AVAILABLE_IN_2_82
+gssize      g_uri_unescape_segment_to_buffer (const char *escaped_string,
+                                              const char *escaped_string_end,
+                                              const char *illegal_characters,
+                                              char       *buffer,
+                                              gsize       buffer_size);
 
 GLIB_AVAILABLE_IN_ALL
 char *      g_uri_parse_scheme     (const char *uri);
@@ -40,8 +40,18 @@
 #include "gtestutils.h"
 #include "gtypes.h"
 #include "gthread.h"
+#include "gunicodeprivate.h"
+#include "gutilsprivate.h"
 #include "glibintl.h"
 
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UTF8_COUNT_SSE2
+#elif defined (__aarch64__) && defined (__ARM_NEON)
+#include <arm_neon.h>
+#define UTF8_COUNT_NEON
+#endif
+
 #define UTF8_COMPUTE(Char, Mask, Len)					      \
   if (Char < 128)							      \
     {									      \
@@ -215,6 +225,120 @@ g_utf8_prev_char (const gchar *p)
     }
 }
  
+/* Counts the bytes in @p which are not continuation bytes. For valid UTF-8,
+ * that is the number of characters which start in @p. */
+static gsize
+utf8_count_chars (const gchar *p,
+                  gsize        len)
+{
+  const guchar *up = (const guchar *) p;
+  gsize count = 0;
+  gsize i = 0;
+
+#if defined (UTF8_COUNT_SSE2)
+  const __m128i max_continuation = _mm_set1_epi8 ((char) 0xbf);
+  const __m128i zero = _mm_setzero_si128 ();
+
+  while (len - i >= 16)
+    {
+      /* Per-byte counters, summed before they can overflow */
+      gsize n_blocks = MIN ((len - i) / 16, 255);
+      __m128i counts = zero;
+      __m128i sums;
+
+      for (; n_blocks > 0; n_blocks--, i += 16)
+        {
+          __m128i v = _mm_loadu_si128 ((const __m128i *) (up + i));
+
+          /* As signed bytes, continuation bytes are the lowest values */
+          counts = _mm_sub_epi8 (counts, _mm_cmpgt_epi8 (v, max_continuation));
+        }
+
+      sums = _mm_sad_epu8 (counts, zero);
+      count += _mm_cvtsi128_si32 (sums) + _mm_extract_epi16 (sums, 4);
+    }
+#elif defined (UTF8_COUNT_NEON)
+  const int8x16_t max_continuation = vdupq_n_s8 ((int8_t) 0xbf);
+
+  while (len - i >= 16)
+    {
+      gsize n_blocks = MIN ((len - i) / 16, 255);
+      uint8x16_t counts = vdupq_n_u8 (0);
+
+      for (; n_blocks > 0; n_blocks--, i += 16)
+        {
+          int8x16_t v = vreinterpretq_s8_u8 (vld1q_u8 (up + i));
+
+          counts = vsubq_u8 (counts, vcgtq_s8 (v, max_continuation));
+        }
+
+      count += vaddlvq_u8 (counts);
+    }
+#endif
+
+  for (; i < len; i++)
+    count += (up[i] & 0xc0) != 0x80;
+
+  return count;
+}
+
+/* Returns the length of the run of ASCII bytes at the start of @str, which
+ * is at most @len bytes long. Nul bytes count as ASCII. */
+gsize
+_g_utf8_ascii_prefix_len (const gchar *str,
+                          gsize        len)
+{
+  const guchar *up = (const guchar *) str;
+  gsize i = 0;
+
+#if defined (UTF8_COUNT_SSE2)
+  for (; len - i >= 16; i += 16)
+    {
+      int mask = _mm_movemask_epi8 (_mm_loadu_si128 ((const __m128i *) (up + i)));
+
+      if (mask != 0)
+        return i + g_bit_nth_lsf (mask, -1);
+    }
+#elif defined (UTF8_COUNT_NEON)
+  for (; len - i >= 16; i += 16)
+    {
+      if (vmaxvq_u8 (vld1q_u8 (up + i)) >= 0x80)
+        break;
+    }
+#endif
+
+  while (i < len && up[i] < 0x80)
+    i++;
+
+  return i;
+}
+
+/* Skips @n_chars characters forward from @p, which must all exist. */
+static const gchar *
+utf8_skip_chars (const gchar *p,
+                 gsize        n_chars)
+{
+  /* The result is at least @n_chars bytes away, so all but the last of
+   * those can be checked in bulk without reading the result itself, which
+   * may be past the end of the string; then repeat on the rest. */
+  while (n_chars >= 32)
+    {
+      gsize n_skipped = utf8_count_chars (p, n_chars - 1);
+
+      p += n_chars - 1;
+      n_chars -= n_skipped;
+    }
+
+  /* Finish the character which @p might now be in the middle of */
+  while ((*(const guchar *) p & 0xc0) == 0x80)
+    p++;
+
+  while (n_chars--)
+    p = g_utf8_next_char (p);
+
+  return p;
+}
+
 /**
  * g_utf8_strlen:
  * @p: pointer to the start of a UTF-8 encoded string
@@ -234,36 +358,35 @@ glong
 g_utf8_strlen (const gchar *p,
                gssize       max)
 {
-  glong len = 0;
-  const gchar *start = p;
+  const gchar *nul;
+  glong len;
+  gsize i;
+
   g_return_val_if_fail (p != NULL || max == 0, 0);
 
   if (max < 0)
-    {
-      while (*p)
-        {
-          p = g_utf8_next_char (p);
-          ++len;
-        }
-    }
-  else
-    {
-      if (max == 0 || !*p)
-        return 0;
+    return utf8_count_chars (p, strlen (p));
 
-      p = g_utf8_next_char (p);
+  if (max == 0)
+    return 0;
 
-      while (p - start < max && *p)
+  nul = memchr (p, '\0', max);
+  if (nul != NULL)
+    return utf8_count_chars (p, nul - p);
+
+  len = utf8_count_chars (p, max);
+
+  /* Don't count the last character if it is only partially within @max */
+  for (i = 1; i <= 4 && i <= (gsize) max; i++)
+    {
+      guchar c = p[max - i];
+
+      if ((c & 0xc0) != 0x80)
         {
-          ++len;
-          p = g_utf8_next_char (p);
+          if ((gsize) g_utf8_skip[c] > i)
+            len--;
+          break;
         }
-
-      /* only do the last len increment if we got a complete
-       * char (don't count partial chars)
-       */
-      if (p - start <= max)
-        ++len;
     }
 
   return len;
@@ -371,8 +494,7 @@ g_utf8_offset_to_pointer  (const gchar *str,
   const gchar *s = str;
 
   if (offset > 0) 
-    while (offset--)
-      s = g_utf8_next_char (s);
+    s = utf8_skip_chars (s, offset);
   else
     {
       const char *s1;
@@ -412,19 +534,203 @@ glong
 g_utf8_pointer_to_offset (const gchar *str,
 			  const gchar *pos)
 {
-  const gchar *s = str;
-  glong offset = 0;    
-
   if (pos < str) 
-    offset = - g_utf8_pointer_to_offset (pos, str);
+    return - g_utf8_pointer_to_offset (pos, str);
   else
-    while (s < pos)
-      {
-	s = g_utf8_next_char (s);
-	offset++;
-      }
-  
-  return offset;
+    return utf8_count_chars (str, pos - str);
+}
+
+/* Number of characters between the checkpoints of a #GUtf8Index */
+#define UTF8_INDEX_INTERVAL 64
+
+struct _GUtf8Index
+{
+  const gchar *str;
+  gsize len;
+  gsize n_chars;
+  gsize n_checkpoints;
+  gsize checkpoints[];  /* byte offset of character i * UTF8_INDEX_INTERVAL */
+};
+
+/**
+ * GUtf8Index:
+ *
+ * An opaque structure for converting quickly between character offsets
+ * and byte offsets in a long UTF-8 string.
+ *
+ * [func@GLib.utf8_offset_to_pointer] and [func@GLib.utf8_pointer_to_offset]
+ * have to scan the string up to the requested position each time. A
+ * `GUtf8Index` is built with one pass over the string, and records the
+ * byte offset of every 64th character; conversions then only scan from
+ * the closest recorded position. Converting a character offset to a
+ * pointer takes constant time, and converting a pointer to an offset
+ * takes logarithmic time, in the length of the string.
+ *
+ * The index refers to the string it was created for, which must stay
+ * alive and unmodified for as long as the index is used. After the string
+ * is modified, a new index must be created.
+ *
+ * Since: 2.82
+ */
+
+/**
+ * g_utf8_index_new:
+ * @str: a valid UTF-8 encoded string
+ * @len: the length of @str in bytes, or -1 if it is nul-terminated
+ *
+ * Creates an index for converting between character offsets and pointers
+ * in @str. See [struct@GLib.Utf8Index].
+ *
+ * @str is not copied, and must remain valid and unmodified until the index
+ * is freed with g_utf8_index_free().
+ *
+ * If @len is not negative, @str does not need to be nul-terminated, and any
+ * nul bytes within the first @len bytes count as characters.
+ *
+ * Returns: (transfer full): a new #GUtf8Index
+ *
+ * Since: 2.82
+ */
+GUtf8Index *
+g_utf8_index_new (const gchar *str,
+                  gssize       len)
+{
+  GUtf8Index *index_;
+  gsize n_chars, n_checkpoints, i;
+
+  g_return_val_if_fail (str != NULL || len == 0, NULL);
+
+  if (len < 0)
+    len = strlen (str);
+
+  n_chars = utf8_count_chars (str, len);
+  n_checkpoints = n_chars / UTF8_INDEX_INTERVAL + 1;
+
+  index_ = g_malloc (sizeof (GUtf8Index) + n_checkpoints * sizeof (gsize));
+  index_->str = str;
+  index_->len = len;
+  index_->n_chars = n_chars;
+  index_->n_checkpoints = n_checkpoints;
+
+  index_->checkpoints[0] = 0;
+  for (i = 1; i < n_checkpoints; i++)
+    {
+      const gchar *p = str + index_->checkpoints[i - 1];
+
+      index_->checkpoints[i] = utf8_skip_chars (p, UTF8_INDEX_INTERVAL) - str;
+    }
+
+  return index_;
+}
+
+/**
+ * g_utf8_index_free:
+ * @index_: (transfer full): a #GUtf8Index
+ *
+ * Frees an index created with g_utf8_index_new(). The string it refers to
+ * is left untouched.
+ *
+ * Since: 2.82
+ */
+void
+g_utf8_index_free (GUtf8Index *index_)
+{
+  g_free (index_);
+}
+
+/**
+ * g_utf8_index_get_length:
+ * @index_: a #GUtf8Index
+ *
+ * Gets the length in characters of the string which @index_ was created
+ * for, as g_utf8_strlen() would return.
+ *
+ * Returns: the length of the string in characters
+ *
+ * Since: 2.82
+ */
+glong
+g_utf8_index_get_length (GUtf8Index *index_)
+{
+  g_return_val_if_fail (index_ != NULL, 0);
+
+  return index_->n_chars;
+}
+
+/**
+ * g_utf8_index_offset_to_pointer:
+ * @index_: a #GUtf8Index
+ * @offset: a character offset within the string, between 0 and the length
+ *   of the string
+ *
+ * Converts from an integer character offset to a pointer to a position
+ * within the string @index_ was created for.
+ *
+ * This gives the same result as g_utf8_offset_to_pointer() called on the
+ * start of the string, but only scans at most 63 characters.
+ *
+ * Returns: (transfer none): the resulting pointer
+ *
+ * Since: 2.82
+ */
+const gchar *
+g_utf8_index_offset_to_pointer (GUtf8Index *index_,
+                                glong       offset)
+{
+  const gchar *p;
+
+  g_return_val_if_fail (index_ != NULL, NULL);
+  g_return_val_if_fail (offset >= 0 && (gsize) offset <= index_->n_chars, NULL);
+
+  p = index_->str + index_->checkpoints[offset / UTF8_INDEX_INTERVAL];
+
+  return utf8_skip_chars (p, offset % UTF8_INDEX_INTERVAL);
+}
+
+/**
+ * g_utf8_index_pointer_to_offset:
+ * @index_: a #GUtf8Index
+ * @pos: a pointer to a position within the string @index_ was created for,
+ *   up to and including its end
+ *
+ * Converts from a pointer to a position within the string @index_ was
+ * created for to an integer character offset.
+ *
+ * This gives the same result as g_utf8_pointer_to_offset() called with the
+ * start of the string, but only scans at most 63 characters after finding
+ * the closest checkpoint.
+ *
+ * Returns: the resulting character offset
+ *
+ * Since: 2.82
+ */
+glong
+g_utf8_index_pointer_to_offset (GUtf8Index  *index_,
+                                const gchar *pos)
+{
+  gsize byte_offset, lo, hi;
+
+  g_return_val_if_fail (index_ != NULL, 0);
+  g_return_val_if_fail (pos >= index_->str && pos <= index_->str + index_->len, 0);
+
+  byte_offset = pos - index_->str;
+
+  /* Find the last checkpoint at or before @pos */
+  lo = 0;
+  hi = index_->n_checkpoints;
+  while (hi - lo > 1)
+    {
+      gsize mid = lo + (hi - lo) / 2;
+
+      if (index_->checkpoints[mid] <= byte_offset)
+        lo = mid;
+      else
+        hi = mid;
+    }
+
+  return lo * UTF8_INDEX_INTERVAL +
+         utf8_count_chars (index_->str + index_->checkpoints[lo],
+                           byte_offset - index_->checkpoints[lo]);
 }
 
 
@@ -1061,6 +1367,171 @@ g_ucs4_to_utf8 (const gunichar *str,
 
 #define SURROGATE_VALUE(h,l) (((h) - 0xd800) * 0x400 + (l) - 0xdc00 + 0x10000)
 
+/* The number of units before the first nul in the first @max_len units of
+ * @str, or in all of it if @max_len is negative */
+static gsize
+utf16_strnlen (const gunichar2 *str,
+               gssize           max_len)
+{
+  gsize i = 0;
+
+  if (max_len < 0)
+    {
+      while (str[i])
+        i++;
+
+      return i;
+    }
+
+#if defined (UTF8_COUNT_SSE2)
+  for (; (gsize) max_len - i >= 8; i += 8)
+    {
+      __m128i v = _mm_loadu_si128 ((const __m128i *) (str + i));
+      int mask = _mm_movemask_epi8 (_mm_cmpeq_epi16 (v, _mm_setzero_si128 ()));
+
+      if (mask != 0)
+        return i + g_bit_nth_lsf (mask, -1) / 2;
+    }
+#elif defined (UTF8_COUNT_NEON)
+  for (; (gsize) max_len - i >= 8; i += 8)
+    {
+      if (vminvq_u16 (vld1q_u16 (str + i)) == 0)
+        break;
+    }
+#endif
+
+  while (i < (gsize) max_len && str[i])
+    i++;
+
+  return i;
+}
+
+/* Converts exactly @len units of UTF-16 at @str, including any nul units,
+ * to UTF-8 in one pass. As many complete characters as fit are written to
+ * @buffer, which has room for @buffer_len bytes, and the number of bytes
+ * the whole result needs is returned: so a @buffer_len of 0 just measures.
+ * A trailing high surrogate is an error unless @allow_partial is set, in
+ * which case conversion stops before it.
+ *
+ * On error, -1 is returned. Either way, the number of units read is
+ * stored in @items_read. */
+gssize
+_g_utf16_to_utf8_convert (const gunichar2  *str,
+                          gsize             len,
+                          gchar            *buffer,
+                          gsize             buffer_len,
+                          gboolean          allow_partial,
+                          gsize            *items_read,
+                          GError          **error)
+{
+  const gunichar2 *in = str;
+  const gunichar2 *end = str + len;
+  gsize n_bytes = 0;
+#if defined (UTF8_COUNT_SSE2)
+  const __m128i non_ascii = _mm_set1_epi16 ((short) 0xff80);
+  const __m128i zero = _mm_setzero_si128 ();
+#endif
+
+  while (in < end)
+    {
+      gunichar2 c;
+      gunichar wc;
+      gint n;
+
+#if defined (UTF8_COUNT_SSE2) || defined (UTF8_COUNT_NEON)
+      /* Narrow blocks of ASCII, unless only part of one would fit */
+      if (end - in >= 16 &&
+          (buffer_len - MIN (buffer_len, n_bytes) >= 16 || n_bytes >= buffer_len))
+        {
+#if defined (UTF8_COUNT_SSE2)
+          __m128i lo = _mm_loadu_si128 ((const __m128i *) in);
+          __m128i hi = _mm_loadu_si128 ((const __m128i *) (in + 8));
+          __m128i high_bits = _mm_and_si128 (_mm_or_si128 (lo, hi), non_ascii);
+
+          if (_mm_movemask_epi8 (_mm_cmpeq_epi16 (high_bits, zero)) == 0xffff)
+            {
+              if (n_bytes < buffer_len)
+                _mm_storeu_si128 ((__m128i *) (buffer + n_bytes), _mm_packus_epi16 (lo, hi));
+#else
+          uint16x8_t lo = vld1q_u16 (in);
+          uint16x8_t hi = vld1q_u16 (in + 8);
+
+          if (vmaxvq_u16 (vorrq_u16 (lo, hi)) < 0x80)
+            {
+              if (n_bytes < buffer_len)
+                vst1q_u8 ((guint8 *) buffer + n_bytes,
+                          vcombine_u8 (vmovn_u16 (lo), vmovn_u16 (hi)));
+#endif
+              in += 16;
+              n_bytes += 16;
+              continue;
+            }
+        }
+#endif
+
+      c = *in;
+
+      if (c < 0x80)
+        {
+          if (n_bytes < buffer_len)
+            buffer[n_bytes] = c;
+          n_bytes++;
+          in++;
+          continue;
+        }
+
+      if (c >= 0xdc00 && c < 0xe000) /* low surrogate */
+        {
+          g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_ILLEGAL_SEQUENCE,
+                               _("Invalid sequence in conversion input"));
+          goto err_out;
+        }
+      else if (c >= 0xd800 && c < 0xdc00) /* high surrogate */
+        {
+          if (in + 1 == end)
+            {
+              if (allow_partial)
+                break;
+
+              g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_PARTIAL_INPUT,
+                                   _("Partial character sequence at end of input"));
+              goto err_out;
+            }
+
+          /* The error is reported at the unit after the high surrogate */
+          if (in[1] < 0xdc00 || in[1] >= 0xe000)
+            {
+              in++;
+              g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_ILLEGAL_SEQUENCE,
+                                   _("Invalid sequence in conversion input"));
+              goto err_out;
+            }
+
+          wc = SURROGATE_VALUE (c, in[1]);
+          in += 2;
+        }
+      else
+        {
+          wc = c;
+          in++;
+        }
+
+      n = UTF8_LENGTH (wc);
+      if (n_bytes + n <= buffer_len)
+        g_unichar_to_utf8 (wc, buffer + n_bytes);
+      n_bytes += n;
+    }
+
+  *items_read = in - str;
+
+  return n_bytes;
+
+ err_out:
+  *items_read = in - str;
+
+  return -1;
+}
+
 /**
  * g_utf16_to_utf8:
  * @str: (array length=len) (element-type guint16): a UTF-16 encoded string
@@ -1103,116 +1574,38 @@ g_utf16_to_utf8 (const gunichar2  *str,
 		 glong            *items_written,
 		 GError          **error)
 {
-  /* This function and g_utf16_to_ucs4 are almost exactly identical -
-   * The lines that differ are marked.
-   */
-  const gunichar2 *in;
-  gchar *out;
   gchar *result = NULL;
-  gint n_bytes;
-  gunichar high_surrogate;
+  gsize n_units, n_read = 0;
+  gssize n_bytes;
 
   g_return_val_if_fail (str != NULL, NULL);
 
-  n_bytes = 0;
-  in = str;
-  high_surrogate = 0;
-  while ((len < 0 || in - str < len) && *in)
-    {
-      gunichar2 c = *in;
-      gunichar wc;
+  n_units = utf16_strnlen (str, len);
 
-      if (c >= 0xdc00 && c < 0xe000) /* low surrogate */
-	{
-	  if (high_surrogate)
-	    {
-	      wc = SURROGATE_VALUE (high_surrogate, c);
-	      high_surrogate = 0;
-	    }
-	  else
-	    {
-	      g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_ILLEGAL_SEQUENCE,
-                                   _("Invalid sequence in conversion input"));
-	      goto err_out;
-	    }
-	}
-      else
-	{
-	  if (high_surrogate)
-	    {
-	      g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_ILLEGAL_SEQUENCE,
-                                   _("Invalid sequence in conversion input"));
-	      goto err_out;
-	    }
+  /* Convert in one pass into a buffer big enough for any input: each unit
+   * takes at most three bytes */
+  result = try_malloc_n (n_units + 1, 3, error);
+  if (result == NULL)
+    goto err_out;
 
-	  if (c >= 0xd800 && c < 0xdc00) /* high surrogate */
-	    {
-	      high_surrogate = c;
-	      goto next1;
-	    }
-	  else
-	    wc = c;
-	}
+  n_bytes = _g_utf16_to_utf8_convert (str, n_units, result, 3 * n_units,
+                                      items_read != NULL, &n_read, error);
+  if (n_bytes < 0)
+    {
+      g_clear_pointer (&result, g_free);
+      goto err_out;
+    }
 
-      /********** DIFFERENT for UTF8/UCS4 **********/
-      n_bytes += UTF8_LENGTH (wc);
-
-    next1:
-      in++;
-    }
-
-  if (high_surrogate && !items_read)
-    {
-      g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_PARTIAL_INPUT,
-                           _("Partial character sequence at end of input"));
-      goto err_out;
-    }
-  
-  /* At this point, everything is valid, and we just need to convert
-   */
-  /********** DIFFERENT for UTF8/UCS4 **********/
-  result = try_malloc_n (n_bytes + 1, 1, error);
-  if (result == NULL)
-      goto err_out;
-
-  high_surrogate = 0;
-  out = result;
-  in = str;
-  while (out < result + n_bytes)
-    {
-      gunichar2 c = *in;
-      gunichar wc;
-
-      if (c >= 0xdc00 && c < 0xe000) /* low surrogate */
-	{
-	  wc = SURROGATE_VALUE (high_surrogate, c);
-	  high_surrogate = 0;
-	}
-      else if (c >= 0xd800 && c < 0xdc00) /* high surrogate */
-	{
-	  high_surrogate = c;
-	  goto next2;
-	}
-      else
-	wc = c;
-
-      /********** DIFFERENT for UTF8/UCS4 **********/
-      out += g_unichar_to_utf8 (wc, out);
-
-    next2:
-      in++;
-    }
-  
-  /********** DIFFERENT for UTF8/UCS4 **********/
-  *out = '\0';
+  if ((gsize) n_bytes < 3 * n_units / 2)
+    result = g_realloc (result, n_bytes + 1);
+  result[n_bytes] = '\0';
 
   if (items_written)
-    /********** DIFFERENT for UTF8/UCS4 **********/
-    *items_written = out - result;
+    *items_written = n_bytes;
 
  err_out:
   if (items_read)
-    *items_read = in - str;
+    *items_read = n_read;
 
   return result;
 }
@@ -1355,6 +1748,133 @@ g_utf16_to_ucs4 (const gunichar2  *str,
   return (gunichar *)result;
 }
 
+/* Converts exactly @len bytes of UTF-8 at @str, including any nul bytes,
+ * to UTF-16 in one pass; see _g_utf16_to_utf8_convert(). @buffer_len is
+ * in units, as is the result. */
+gssize
+_g_utf8_to_utf16_convert (const gchar  *str,
+                          gsize         len,
+                          gunichar2    *buffer,
+                          gsize         buffer_len,
+                          gboolean      allow_partial,
+                          gsize        *items_read,
+                          GError      **error)
+{
+  const guchar *in = (const guchar *) str;
+  const guchar *end = in + len;
+  gsize n16 = 0;
+#if defined (UTF8_COUNT_SSE2)
+  const __m128i zero = _mm_setzero_si128 ();
+#endif
+
+  while (in < end)
+    {
+      gunichar wc;
+
+#if defined (UTF8_COUNT_SSE2) || defined (UTF8_COUNT_NEON)
+      /* Widen blocks of ASCII, unless only part of one would fit */
+      if (end - in >= 16 &&
+          (buffer_len - MIN (buffer_len, n16) >= 16 || n16 >= buffer_len))
+        {
+#if defined (UTF8_COUNT_SSE2)
+          __m128i v = _mm_loadu_si128 ((const __m128i *) in);
+
+          if (_mm_movemask_epi8 (v) == 0)
+            {
+              if (n16 < buffer_len)
+                {
+                  _mm_storeu_si128 ((__m128i *) (buffer + n16), _mm_unpacklo_epi8 (v, zero));
+                  _mm_storeu_si128 ((__m128i *) (buffer + n16 + 8), _mm_unpackhi_epi8 (v, zero));
+                }
+#else
+          uint8x16_t v = vld1q_u8 (in);
+
+          if (vmaxvq_u8 (v) < 0x80)
+            {
+              if (n16 < buffer_len)
+                {
+                  vst1q_u16 (buffer + n16, vmovl_u8 (vget_low_u8 (v)));
+                  vst1q_u16 (buffer + n16 + 8, vmovl_high_u8 (v));
+                }
+#endif
+              in += 16;
+              n16 += 16;
+              continue;
+            }
+        }
+#endif
+
+      if (*in < 0x80)
+        {
+          if (n16 < buffer_len)
+            buffer[n16] = *in;
+          n16++;
+          in++;
+          continue;
+        }
+
+      wc = g_utf8_get_char_extended ((const gchar *) in, end - in);
+      if (wc & 0x80000000)
+	{
+          /* A nul can only end a partial sequence at the end of the input */
+	  if (wc == (gunichar)-2 && (gsize) (end - in) < (gsize) g_utf8_skip[*in])
+	    {
+	      if (allow_partial)
+		break;
+
+              g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_PARTIAL_INPUT,
+                                   _("Partial character sequence at end of input"));
+	    }
+	  else
+	    g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_ILLEGAL_SEQUENCE,
+                                 _("Invalid byte sequence in conversion input"));
+
+	  goto err_out;
+	}
+
+      if (wc < 0xd800 || (wc >= 0xe000 && wc < 0x10000))
+	{
+          if (n16 < buffer_len)
+            buffer[n16] = wc;
+	  n16 += 1;
+	}
+      else if (wc < 0xe000)
+	{
+	  g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_ILLEGAL_SEQUENCE,
+                               _("Invalid sequence in conversion input"));
+
+	  goto err_out;
+	}
+      else if (wc < 0x110000)
+	{
+          if (n16 + 2 <= buffer_len)
+            {
+              buffer[n16] = (wc - 0x10000) / 0x400 + 0xd800;
+              buffer[n16 + 1] = (wc - 0x10000) % 0x400 + 0xdc00;
+            }
+	  n16 += 2;
+	}
+      else
+	{
+	  g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_ILLEGAL_SEQUENCE,
+                               _("Character out of range for UTF-16"));
+
+	  goto err_out;
+	}
+
+      in = (const guchar *) g_utf8_next_char (in);
+    }
+
+  *items_read = (const gchar *) in - str;
+
+  return n16;
+
+ err_out:
+  *items_read = (const gchar *) in - str;
+
+  return -1;
+}
+
 /**
  * g_utf8_to_utf16:
  * @str: a UTF-8 encoded string
@@ -1386,92 +1906,169 @@ g_utf8_to_utf16 (const gchar *str,
 		 GError     **error)
 {
   gunichar2 *result = NULL;
-  gint n16;
-  const gchar *in;
-  gint i;
+  const gchar *nul;
+  gsize n_bytes, n_read = 0;
+  gssize n16;
 
   g_return_val_if_fail (str != NULL, NULL);
 
-  in = str;
-  n16 = 0;
-  while ((len < 0 || str + len - in > 0) && *in)
-    {
-      gunichar wc = g_utf8_get_char_extended (in, len < 0 ? 6 : str + len - in);
-      if (wc & 0x80000000)
-	{
-	  if (wc == (gunichar)-2)
-	    {
-	      if (items_read)
-		break;
-	      else
-		g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_PARTIAL_INPUT,
-                                     _("Partial character sequence at end of input"));
-	    }
-	  else
-	    g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_ILLEGAL_SEQUENCE,
-                                 _("Invalid byte sequence in conversion input"));
-
-	  goto err_out;
-	}
-
-      if (wc < 0xd800)
-	n16 += 1;
-      else if (wc < 0xe000)
-	{
-	  g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_ILLEGAL_SEQUENCE,
-                               _("Invalid sequence in conversion input"));
-
-	  goto err_out;
-	}
-      else if (wc < 0x10000)
-	n16 += 1;
-      else if (wc < 0x110000)
-	n16 += 2;
-      else
-	{
-	  g_set_error_literal (error, G_CONVERT_ERROR, G_CONVERT_ERROR_ILLEGAL_SEQUENCE,
-                               _("Character out of range for UTF-16"));
-
-	  goto err_out;
-	}
-      
-      in = g_utf8_next_char (in);
-    }
+  if (len < 0)
+    n_bytes = strlen (str);
+  else if ((nul = memchr (str, '\0', len)) != NULL)
+    n_bytes = nul - str;
+  else
+    n_bytes = len;
 
-  result = try_malloc_n (n16 + 1, sizeof (gunichar2), error);
+  /* Convert in one pass into a buffer big enough for any input: each byte
+   * gives at most one unit */
+  result = try_malloc_n (n_bytes + 1, sizeof (gunichar2), error);
   if (result == NULL)
-      goto err_out;
+    goto err_out;
 
-  in = str;
-  for (i = 0; i < n16;)
+  n16 = _g_utf8_to_utf16_convert (str, n_bytes, result, n_bytes,
+                                  items_read != NULL, &n_read, error);
+  if (n16 < 0)
     {
-      gunichar wc = g_utf8_get_char (in);
-
-      if (wc < 0x10000)
-	{
-	  result[i++] = wc;
-	}
-      else
-	{
-	  result[i++] = (wc - 0x10000) / 0x400 + 0xd800;
-	  result[i++] = (wc - 0x10000) % 0x400 + 0xdc00;
-	}
-      
-      in = g_utf8_next_char (in);
+      g_clear_pointer (&result, g_free);
+      goto err_out;
     }
 
-  result[i] = 0;
+  if ((gsize) n16 < n_bytes / 2)
+    result = g_renew (gunichar2, result, n16 + 1);
+  result[n16] = 0;
 
   if (items_written)
     *items_written = n16;
 
  err_out:
   if (items_read)
-    *items_read = in - str;
-  
+    *items_read = n_read;
+
   return result;
 }
 
+/**
+ * g_utf8_to_utf16_into:
+ * @str: a UTF-8 encoded string
+ * @len: the length of @str in bytes, or -1 if it is nul-terminated
+ * @buffer: (array length=buffer_len) (out caller-allocates) (nullable):
+ *     location to store the UTF-16 result, or %NULL if @buffer_len is 0
+ * @buffer_len: the number of #gunichar2 which fit in @buffer
+ * @items_read: (out) (optional): location to store the number of bytes
+ *     read, or %NULL. If %NULL, then %G_CONVERT_ERROR_PARTIAL_INPUT will
+ *     be returned in case @str contains a trailing partial character. If
+ *     an error occurs then the index of the invalid input is stored here.
+ * @error: location to store the error occurring, or %NULL to ignore
+ *     errors. Any of the errors in #GConvertError other than
+ *     %G_CONVERT_ERROR_NO_CONVERSION and %G_CONVERT_ERROR_NO_MEMORY may
+ *     occur.
+ *
+ * Converts a string from UTF-8 to UTF-16, like g_utf8_to_utf16(), but
+ * writes the result to a buffer provided by the caller rather than
+ * allocating it, and reads the input only once.
+ *
+ * Unlike g_utf8_to_utf16(), if @len is not negative then exactly @len
+ * bytes are converted, including any nul bytes. No terminating 0 is
+ * written to @buffer.
+ *
+ * If the result is longer than @buffer_len, as many complete characters
+ * as fit are written to @buffer, and conversion continues without writing
+ * so that the length of the whole result is still returned. The call can
+ * then be repeated with a big enough buffer. Passing a @buffer_len of 0
+ * just measures the result.
+ *
+ * Returns: the number of #gunichar2 in the result, which may be greater
+ *     than @buffer_len; or -1 if an error occurs
+ *
+ * Since: 2.82
+ */
+gssize
+g_utf8_to_utf16_into (const gchar  *str,
+                      gssize        len,
+                      gunichar2    *buffer,
+                      gsize         buffer_len,
+                      gsize        *items_read,
+                      GError      **error)
+{
+  gsize n_read;
+  gssize n16;
+
+  g_return_val_if_fail (str != NULL, -1);
+  g_return_val_if_fail (buffer != NULL || buffer_len == 0, -1);
+
+  n16 = _g_utf8_to_utf16_convert (str, len < 0 ? strlen (str) : (gsize) len,
+                                  buffer, buffer_len,
+                                  items_read != NULL, &n_read, error);
+
+  if (items_read)
+    *items_read = n_read;
+
+  return n16;
+}
+
+/**
+ * g_utf16_to_utf8_into:
+ * @str: (array length=len) (element-type guint16): a UTF-16 encoded string
+ * @len: the length of @str in #gunichar2, or -1 if it is nul-terminated
+ * @buffer: (array length=buffer_len) (element-type guint8) (out caller-allocates) (nullable):
+ *     location to store the UTF-8 result, or %NULL if @buffer_len is 0
+ * @buffer_len: the number of bytes which fit in @buffer
+ * @items_read: (out) (optional): location to store the number of
+ *     #gunichar2 read, or %NULL. If %NULL, then
+ *     %G_CONVERT_ERROR_PARTIAL_INPUT will be returned in case @str
+ *     contains a trailing partial character. If an error occurs then the
+ *     index of the invalid input is stored here.
+ * @error: location to store the error occurring, or %NULL to ignore
+ *     errors. Any of the errors in #GConvertError other than
+ *     %G_CONVERT_ERROR_NO_CONVERSION and %G_CONVERT_ERROR_NO_MEMORY may
+ *     occur.
+ *
+ * Converts a string from UTF-16 to UTF-8, like g_utf16_to_utf8(), but
+ * writes the result to a buffer provided by the caller rather than
+ * allocating it, and reads the input only once.
+ *
+ * Unlike g_utf16_to_utf8(), if @len is not negative then exactly @len
+ * units are converted, including any nul units. No terminating nul byte
+ * is written to @buffer.
+ *
+ * If the result is longer than @buffer_len, as many complete characters
+ * as fit are written to @buffer, and conversion continues without writing
+ * so that the length of the whole result is still returned. The call can
+ * then be repeated with a big enough buffer. Passing a @buffer_len of 0
+ * just measures the result.
+ *
+ * Returns: the number of bytes in the result, which may be greater than
+ *     @buffer_len; or -1 if an error occurs
+ *
+ * Since: 2.82
+ */
+gssize
+g_utf16_to_utf8_into (const gunichar2  *str,
+                      gssize            len,
+                      gchar            *buffer,
+                      gsize             buffer_len,
+                      gsize            *items_read,
+                      GError          **error)
+{
+  gsize n_read;
+  gssize n_bytes;
+
+  g_return_val_if_fail (str != NULL, -1);
+  g_return_val_if_fail (buffer != NULL || buffer_len == 0, -1);
+
+  if (len < 0)
+    for (len = 0; str[len]; len++)
+      ;
+
+  n_bytes = _g_utf16_to_utf8_convert (str, len, buffer, buffer_len,
+                                      items_read != NULL, &n_read, error);
+
+  if (items_read)
+    *items_read = n_read;
+
+  return n_bytes;
+}
+
 /**
  * g_ucs4_to_utf16:
  * @str: (array length=len) (element-type gunichar): a UCS-4 encoded string
@@ -1565,6 +2162,331 @@ g_ucs4_to_utf16 (const gunichar  *str,
   return result;
 }
 
+/* Vectorised validation, using the lookup table algorithm from
+ * “Validating UTF-8 In Less Than One Instruction Per Byte” (Keiser and
+ * Lemire, 2021). The high nibble of each byte and of its predecessor, and
+ * the low nibble of its predecessor, are each mapped to a set of error
+ * classes that such a byte can be part of; a pair of bytes is invalid if
+ * all three sets intersect. Whether the third and fourth bytes of a
+ * sequence are continuation bytes is checked separately.
+ *
+ * The vectorised code only finds out how many leading blocks of the string
+ * are valid. The byte-by-byte code below then continues from the start of
+ * the first character which was not fully checked, which finds the exact
+ * end of the valid data. */
+#if defined (HAVE_X86_SIMD_TARGETS)
+#include <immintrin.h>
+#define UTF8_VALIDATE_X86
+#elif defined (__aarch64__) && defined (__ARM_NEON)
+#include <arm_neon.h>
+#define UTF8_VALIDATE_NEON
+#endif
+
+#if defined (UTF8_VALIDATE_X86) || defined (UTF8_VALIDATE_NEON)
+#define UTF8_VALIDATE_SIMD
+
+#define TOO_SHORT      (1 << 0) /* 11______ 0_______, 11______ 11______ */
+#define TOO_LONG       (1 << 1) /* 0_______ 10______ */
+#define OVERLONG_3     (1 << 2) /* 11100000 100_____ */
+#define TOO_LARGE      (1 << 3) /* 11110100 1001____, and above */
+#define SURROGATE      (1 << 4) /* 11101101 101_____ */
+#define OVERLONG_2     (1 << 5) /* 1100000_ 10______ */
+#define TOO_LARGE_1000 (1 << 6) /* 11110101 1000____, and above */
+#define OVERLONG_4     (1 << 6) /* 11110000 1000____ */
+#define TWO_CONTS      (1 << 7) /* 10______ 10______ */
+#define CARRY          (TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+/* Indexed by the high nibble of the previous byte */
+static const guint8 utf8_byte_1_high[16] = {
+  /* 0_______ */
+  TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+  TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+  /* 10______ */
+  TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+  /* 1100____ */
+  TOO_SHORT | OVERLONG_2,
+  /* 1101____ */
+  TOO_SHORT,
+  /* 1110____ */
+  TOO_SHORT | OVERLONG_3 | SURROGATE,
+  /* 1111____ */
+  TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+};
+
+/* Indexed by the low nibble of the previous byte */
+static const guint8 utf8_byte_1_low[16] = {
+  /* ____0000 */
+  CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+  /* ____0001 */
+  CARRY | OVERLONG_2,
+  /* ____001_ */
+  CARRY,
+  CARRY,
+  /* ____0100 */
+  CARRY | TOO_LARGE,
+  /* ____0101 */
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  /* ____011_ */
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  /* ____1___ */
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  /* ____1101 */
+  CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+};
+
+/* Indexed by the high nibble of the current byte */
+static const guint8 utf8_byte_2_high[16] = {
+  /* 0_______ */
+  TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+  TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+  /* 1000____ */
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+  /* 1001____ */
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+  /* 101_____ */
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+  /* 11______ */
+  TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+};
+
+/* A block only consisting of ASCII is invalid if the block before it ends
+ * in the middle of a character; that is the case if any of its bytes is
+ * above these limits. */
+static const guint8 utf8_max_complete[32] = {
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xf0 - 1, 0xe0 - 1, 0xc0 - 1,
+};
+
+#undef TOO_SHORT
+#undef TOO_LONG
+#undef OVERLONG_3
+#undef TOO_LARGE
+#undef SURROGATE
+#undef OVERLONG_2
+#undef TOO_LARGE_1000
+#undef OVERLONG_4
+#undef TWO_CONTS
+#undef CARRY
+
+#ifdef UTF8_VALIDATE_X86
+
+/* Returns the offset of the first 16-byte block at or after @start which
+ * contains invalid data or a nul byte, or which includes the end of @str. */
+__attribute__ ((target ("ssse3")))
+static gsize
+utf8_validate_ssse3 (const guchar *str,
+                     gsize         start,
+                     gsize         len)
+{
+  const __m128i byte_1_high = _mm_loadu_si128 ((const __m128i *) utf8_byte_1_high);
+  const __m128i byte_1_low = _mm_loadu_si128 ((const __m128i *) utf8_byte_1_low);
+  const __m128i byte_2_high = _mm_loadu_si128 ((const __m128i *) utf8_byte_2_high);
+  const __m128i max_complete = _mm_loadu_si128 ((const __m128i *) (utf8_max_complete + 16));
+  const __m128i low_nibble = _mm_set1_epi8 (0x0f);
+  const __m128i zero = _mm_setzero_si128 ();
+  __m128i prev;
+  gsize i;
+
+  prev = start >= 16 ? _mm_loadu_si128 ((const __m128i *) (str + start - 16)) : zero;
+
+  for (i = start; len - i >= 16; i += 16)
+    {
+      __m128i input = _mm_loadu_si128 ((const __m128i *) (str + i));
+      __m128i error;
+
+      if (_mm_movemask_epi8 (input) == 0)
+        {
+          error = _mm_subs_epu8 (prev, max_complete);
+        }
+      else
+        {
+          __m128i prev1 = _mm_alignr_epi8 (input, prev, 15);
+          __m128i prev2 = _mm_alignr_epi8 (input, prev, 14);
+          __m128i prev3 = _mm_alignr_epi8 (input, prev, 13);
+          __m128i special, must_continue;
+
+          special = _mm_and_si128 (_mm_shuffle_epi8 (byte_1_high, _mm_and_si128 (_mm_srli_epi16 (prev1, 4), low_nibble)),
+                                   _mm_shuffle_epi8 (byte_1_low, _mm_and_si128 (prev1, low_nibble)));
+          special = _mm_and_si128 (special,
+                                   _mm_shuffle_epi8 (byte_2_high, _mm_and_si128 (_mm_srli_epi16 (input, 4), low_nibble)));
+
+          /* Only bytes after 111_____ or two bytes after 1111____ end up
+           * with the top bit set */
+          must_continue = _mm_or_si128 (_mm_subs_epu8 (prev2, _mm_set1_epi8 (0xe0 - 0x80)),
+                                        _mm_subs_epu8 (prev3, _mm_set1_epi8 (0xf0 - 0x80)));
+          must_continue = _mm_and_si128 (must_continue, _mm_set1_epi8 ((char) 0x80));
+
+          error = _mm_xor_si128 (must_continue, special);
+        }
+
+      error = _mm_or_si128 (error, _mm_cmpeq_epi8 (input, zero));
+      if (_mm_movemask_epi8 (_mm_cmpeq_epi8 (error, zero)) != 0xffff)
+        break;
+
+      prev = input;
+    }
+
+  return i;
+}
+
+/* As utf8_validate_ssse3(), but with 32-byte blocks, starting at 0. */
+__attribute__ ((target ("avx2")))
+static gsize
+utf8_validate_avx2 (const guchar *str,
+                    gsize         len)
+{
+  const __m256i byte_1_high = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *) utf8_byte_1_high));
+  const __m256i byte_1_low = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *) utf8_byte_1_low));
+  const __m256i byte_2_high = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *) utf8_byte_2_high));
+  const __m256i max_complete = _mm256_loadu_si256 ((const __m256i *) utf8_max_complete);
+  const __m256i low_nibble = _mm256_set1_epi8 (0x0f);
+  const __m256i zero = _mm256_setzero_si256 ();
+  __m256i prev = zero;
+  gsize i;
+
+  for (i = 0; len - i >= 32; i += 32)
+    {
+      __m256i input = _mm256_loadu_si256 ((const __m256i *) (str + i));
+      __m256i error;
+
+      if (_mm256_movemask_epi8 (input) == 0)
+        {
+          error = _mm256_subs_epu8 (prev, max_complete);
+        }
+      else
+        {
+          /* The last 16 bytes of @prev followed by the first 16 of @input */
+          __m256i shifted = _mm256_permute2x128_si256 (prev, input, 0x21);
+          __m256i prev1 = _mm256_alignr_epi8 (input, shifted, 15);
+          __m256i prev2 = _mm256_alignr_epi8 (input, shifted, 14);
+          __m256i prev3 = _mm256_alignr_epi8 (input, shifted, 13);
+          __m256i special, must_continue;
+
+          special = _mm256_and_si256 (_mm256_shuffle_epi8 (byte_1_high, _mm256_and_si256 (_mm256_srli_epi16 (prev1, 4), low_nibble)),
+                                      _mm256_shuffle_epi8 (byte_1_low, _mm256_and_si256 (prev1, low_nibble)));
+          special = _mm256_and_si256 (special,
+                                      _mm256_shuffle_epi8 (byte_2_high, _mm256_and_si256 (_mm256_srli_epi16 (input, 4), low_nibble)));
+
+          must_continue = _mm256_or_si256 (_mm256_subs_epu8 (prev2, _mm256_set1_epi8 (0xe0 - 0x80)),
+                                           _mm256_subs_epu8 (prev3, _mm256_set1_epi8 (0xf0 - 0x80)));
+          must_continue = _mm256_and_si256 (must_continue, _mm256_set1_epi8 ((char) 0x80));
+
+          error = _mm256_xor_si256 (must_continue, special);
+        }
+
+      error = _mm256_or_si256 (error, _mm256_cmpeq_epi8 (input, zero));
+      if (!_mm256_testz_si256 (error, error))
+        break;
+
+      prev = input;
+    }
+
+  /* Avoid penalties in any following SSE code; not all compilers insert
+   * this automatically at all optimisation levels */
+  _mm256_zeroupper ();
+
+  return i;
+}
+
+#else /* UTF8_VALIDATE_NEON */
+
+/* Returns the offset of the first 16-byte block which contains invalid
+ * data or a nul byte, or which includes the end of @str. */
+static gsize
+utf8_validate_neon (const guchar *str,
+                    gsize         len)
+{
+  const uint8x16_t byte_1_high = vld1q_u8 (utf8_byte_1_high);
+  const uint8x16_t byte_1_low = vld1q_u8 (utf8_byte_1_low);
+  const uint8x16_t byte_2_high = vld1q_u8 (utf8_byte_2_high);
+  const uint8x16_t max_complete = vld1q_u8 (utf8_max_complete + 16);
+  const uint8x16_t low_nibble = vdupq_n_u8 (0x0f);
+  uint8x16_t prev = vdupq_n_u8 (0);
+  gsize i;
+
+  for (i = 0; len - i >= 16; i += 16)
+    {
+      uint8x16_t input = vld1q_u8 (str + i);
+      uint8x16_t error;
+
+      if (vmaxvq_u8 (input) < 0x80)
+        {
+          error = vqsubq_u8 (prev, max_complete);
+        }
+      else
+        {
+          uint8x16_t prev1 = vextq_u8 (prev, input, 15);
+          uint8x16_t prev2 = vextq_u8 (prev, input, 14);
+          uint8x16_t prev3 = vextq_u8 (prev, input, 13);
+          uint8x16_t special, must_continue;
+
+          special = vandq_u8 (vqtbl1q_u8 (byte_1_high, vshrq_n_u8 (prev1, 4)),
+                              vqtbl1q_u8 (byte_1_low, vandq_u8 (prev1, low_nibble)));
+          special = vandq_u8 (special, vqtbl1q_u8 (byte_2_high, vshrq_n_u8 (input, 4)));
+
+          must_continue = vorrq_u8 (vqsubq_u8 (prev2, vdupq_n_u8 (0xe0 - 0x80)),
+                                    vqsubq_u8 (prev3, vdupq_n_u8 (0xf0 - 0x80)));
+          must_continue = vandq_u8 (must_continue, vdupq_n_u8 (0x80));
+
+          error = veorq_u8 (must_continue, special);
+        }
+
+      error = vorrq_u8 (error, vceqzq_u8 (input));
+      if (vmaxvq_u8 (error) != 0)
+        break;
+
+      prev = input;
+    }
+
+  return i;
+}
+
+#endif
+
+/* Returns the length of a prefix of @str which is valid UTF-8 without any
+ * nul bytes, and which ends on a character boundary. */
+static gsize
+utf8_validate_simd (const gchar *str,
+                    gsize        len)
+{
+  const guchar *ustr = (const guchar *) str;
+  gsize valid;
+
+#ifdef UTF8_VALIDATE_X86
+  GCpuFeatures features = g_get_cpu_features ();
+
+  valid = 0;
+  if ((features & G_CPU_FEATURE_AVX2) && len >= 32)
+    valid = utf8_validate_avx2 (ustr, len);
+  if ((features & G_CPU_FEATURE_SSSE3) && len - valid < 32)
+    valid = utf8_validate_ssse3 (ustr, valid, len);
+#else
+  valid = utf8_validate_neon (ustr, len);
+#endif
+
+  /* The last character checked may continue into the next block, and an
+   * error in the first bytes of a block may be due to the block before, so
+   * start again from the beginning of the last character. */
+  while (valid > 0 && (ustr[valid - 1] & 0xc0) == 0x80)
+    valid--;
+  if (valid > 0 && ustr[valid - 1] >= 0xc0)
+    valid--;
+
+  return valid;
+}
+
+#endif /* UTF8_VALIDATE_X86 || UTF8_VALIDATE_NEON */
+
 #define VALIDATE_BYTE(mask, expect)                      \
   G_STMT_START {                                         \
     if (G_UNLIKELY((*(guchar *)p & (mask)) != (expect))) \
@@ -1573,6 +2495,7 @@ g_ucs4_to_utf16 (const gunichar  *str,
 
 /* see IETF RFC 3629 Section 4 */
 
+#ifndef UTF8_VALIDATE_SIMD
 static const gchar *
 fast_validate (const char *str)
 
@@ -1644,6 +2567,8 @@ fast_validate (const char *str)
   return p;
 }
 
+#endif
+
 static const gchar *
 fast_validate_len (const char *str,
 		   gssize      max_len)
@@ -1653,7 +2578,13 @@ fast_validate_len (const char *str,
 
   g_assert (max_len >= 0);
 
-  for (p = str; ((p - str) < max_len) && *p; p++)
+#ifdef UTF8_VALIDATE_SIMD
+  p = str + utf8_validate_simd (str, max_len);
+#else
+  p = str;
+#endif
+
+  for (; ((p - str) < max_len) && *p; p++)
     {
       if (*(guchar *)p < 128)
 	/* done */;
@@ -1762,7 +2693,13 @@ g_utf8_validate (const char   *str,
   if (max_len >= 0)
     return g_utf8_validate_len (str, max_len, end);
 
+#ifdef UTF8_VALIDATE_SIMD
+  /* Finding the end first is much cheaper than validating, and allows
+   * using the vectorised code */
+  p = fast_validate_len (str, strlen (str));
+#else
   p = fast_validate (str);
+#endif
 
   if (end)
     *end = p;
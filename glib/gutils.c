@@ -3355,3 +3355,76 @@ g_abort (void)
   ExitProcess (127);
 }
 #endif
+
+/*
+ * g_get_cpu_features:
+ *
+ * Gets the optional instruction set extensions supported by the CPU, for
+ * which code is compiled (see `HAVE_X86_SIMD_TARGETS`, `HAVE_X86_SHA_TARGETS`
+ * and `HAVE_ARM_CRYPTO_TARGETS`) and selected at runtime. Extensions which
+ * are part of the baseline of the architecture, such as SSE2 on x86-64 or
+ * NEON on AArch64, are used unconditionally and are not reported.
+ *
+ * If the `G_CPU_FEATURES` environment variable is set, only the extensions
+ * it lists are reported, which allows testing and benchmarking the
+ * fallback code paths.
+ *
+ * The result is computed once and cached. This is thread-safe.
+ *
+ * Returns: the supported #GCpuFeatures
+ */
+GCpuFeatures
+g_get_cpu_features (void)
+{
+#if defined (HAVE_X86_SIMD_TARGETS) || defined (HAVE_ARM_CRYPTO_TARGETS)
+  /* G_CPU_FEATURE_INITIALIZED distinguishes “no features” from “not
+   * checked yet” */
+  static guint features = 0;
+  guint f = g_atomic_int_get (&features);
+
+  if (G_UNLIKELY (f == 0))
+    {
+      const GDebugKey keys[] = {
+        { "ssse3", G_CPU_FEATURE_SSSE3 },
+        { "avx2", G_CPU_FEATURE_AVX2 },
+        { "bmi2", G_CPU_FEATURE_BMI2 },
+        { "sha", G_CPU_FEATURE_SHA },
+      };
+      const gchar *env;
+
+      f = 0;
+
+#ifdef HAVE_X86_SIMD_TARGETS
+      __builtin_cpu_init ();
+      if (__builtin_cpu_supports ("ssse3"))
+        f |= G_CPU_FEATURE_SSSE3;
+      if (__builtin_cpu_supports ("avx2"))
+        f |= G_CPU_FEATURE_AVX2;
+      if (__builtin_cpu_supports ("bmi2"))
+        f |= G_CPU_FEATURE_BMI2;
+#ifdef HAVE_X86_SHA_TARGETS
+      if (__builtin_cpu_supports ("sha") && __builtin_cpu_supports ("sse4.1"))
+        f |= G_CPU_FEATURE_SHA;
+#endif
+#endif
+
+#ifdef HAVE_ARM_CRYPTO_TARGETS
+      if ((getauxval (AT_HWCAP) & (HWCAP_SHA1 | HWCAP_SHA2)) == (HWCAP_SHA1 | HWCAP_SHA2))
+        f |= G_CPU_FEATURE_SHA;
+#endif
+
+      /* This may be called from g_utf8_validate(), so must not use
+       * g_getenv() which can call that on Windows */
+      env = getenv ("G_CPU_FEATURES");
+      if (env != NULL)
+        f &= g_parse_debug_string (env, keys, G_N_ELEMENTS (keys));
+
+      f |= G_CPU_FEATURE_INITIALIZED;
+      g_atomic_int_set (&features, f);
+    }
+
+  return f & ~G_CPU_FEATURE_INITIALIZED;
+#else
+  return 0;
+#endif
+}
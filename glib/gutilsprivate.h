@@ -61,6 +61,22 @@ gboolean _g_localtime (time_t timet, struct tm *tm);
 
 gboolean g_set_prgname_once (const gchar *prgname);
 
+void g_mem_advise_large (gpointer mem,
+                         gsize    size);
+
+typedef enum
+{
+  G_CPU_FEATURE_SSSE3 = 1 << 0,
+  G_CPU_FEATURE_AVX2 = 1 << 1,
+  G_CPU_FEATURE_BMI2 = 1 << 2,
+  /* The x86 SHA extensions (with SSE4.1), or the ARMv8 SHA1 and SHA2
+   * instructions */
+  G_CPU_FEATURE_SHA = 1 << 3,
+  G_CPU_FEATURE_INITIALIZED = 1 << 30,
+} GCpuFeatures;
+
+GCpuFeatures g_get_cpu_features (void);
+
 G_END_DECLS
 
 #endif /* __G_UTILS_PRIVATE_H__ */
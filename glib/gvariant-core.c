@@ -29,9 +29,11 @@
 #include <glib/gbitlock.h>
 #include <glib/gatomic.h>
 #include <glib/gbytes.h>
+#include <glib/ghash.h>
 #include <glib/gslice.h>
 #include <glib/gmem.h>
 #include <glib/grefcount.h>
+#include <glib/gthread.h>
 #include <string.h>
 
 #include "glib_trace.h"
@@ -238,6 +240,11 @@ struct _GVariant
  *    STATE_FLOATING: if this flag is set then the object has a floating
  *                    reference.  See g_variant_ref_sink().
  *
+ *    STATE_INDEXED: for serialized form dictionaries, this means that a
+ *                   key index has been built for the instance and must
+ *                   be dropped when it is freed.  See
+ *                   g_variant_ensure_dict_index().
+ *
  * ref_count: the reference count of the instance
  *
  * depth: the depth of the GVariant in a hierarchy of nested containers,
@@ -249,6 +256,7 @@ struct _GVariant
 #define STATE_SERIALISED 2
 #define STATE_TRUSTED    4
 #define STATE_FLOATING   8
+#define STATE_INDEXED    16
 
 /* -- private -- */
 /* < private >
@@ -275,6 +283,55 @@ g_variant_unlock (GVariant *value)
   g_bit_unlock (&value->state, 0);
 }
 
+/* Key indexes of large serialized dictionaries, see
+ * g_variant_ensure_dict_index().  They are kept aside rather than in
+ * the instance, so that no other GVariant pays for the pointer. */
+typedef struct
+{
+  /* const gchar * into the serialized data -> entry index + 1 */
+  GHashTable *entries;
+  gboolean unique_keys;
+} GVariantDictIndex;
+
+static GMutex dict_indexes_lock;
+static GHashTable *dict_indexes;  /* (owned) GVariant * -> GVariantDictIndex * */
+
+static void
+g_variant_dict_index_free (gpointer data)
+{
+  GVariantDictIndex *dict_index = data;
+
+  g_hash_table_unref (dict_index->entries);
+  g_free (dict_index);
+}
+
+static GVariantDictIndex *
+g_variant_dict_index_get (GVariant *value)
+{
+  GVariantDictIndex *dict_index = NULL;
+
+  g_mutex_lock (&dict_indexes_lock);
+  if (dict_indexes != NULL)
+    dict_index = g_hash_table_lookup (dict_indexes, value);
+  g_mutex_unlock (&dict_indexes_lock);
+
+  return dict_index;
+}
+
+/* < private >
+ * g_variant_drop_dict_index:
+ * @value: a #GVariant being freed, with STATE_INDEXED
+ *
+ * Frees the key index built for @value.
+ */
+static void
+g_variant_drop_dict_index (GVariant *value)
+{
+  g_mutex_lock (&dict_indexes_lock);
+  g_hash_table_remove (dict_indexes, value);
+  g_mutex_unlock (&dict_indexes_lock);
+}
+
 /* < private >
  * g_variant_release_children:
  * @value: a #GVariant
@@ -797,6 +854,9 @@ g_variant_unref (GVariant *value)
 
       g_variant_type_info_unref (value->type_info);
 
+      if (value->state & STATE_INDEXED)
+        g_variant_drop_dict_index (value);
+
       if (value->state & STATE_SERIALISED)
         g_bytes_unref (value->contents.serialised.bytes);
       else
@@ -1342,7 +1402,9 @@ g_variant_store (GVariant *value,
  *
  * If @value is found to be in normal form then it will be marked as
  * being trusted.  If the value was already marked as being trusted then
- * this function will immediately return %TRUE.
+ * this function will immediately return %TRUE.  Children taken from a
+ * trusted value are trusted too, so calling this once on a large value
+ * which is accessed at random saves checking each child separately.
  *
  * There may be implementation specific restrictions on deeply nested values.
  * GVariant is guaranteed to handle nesting up to at least 64 levels.
@@ -1383,3 +1445,111 @@ g_variant_is_normal_form (GVariant *value)
 
   return (value->state & STATE_TRUSTED) != 0;
 }
+
+/* < internal >
+ * g_variant_ensure_dict_index:
+ * @value: a dictionary with string or object path keys
+ * @unique_keys: (out) (optional): return location for whether no key
+ *   occurs more than once in @value
+ *
+ * Builds a hash table index of the keys of @value, unless one exists
+ * already, so that g_variant_lookup_dict_index() can find entries
+ * without scanning the dictionary.
+ *
+ * Only serialized dictionaries with at least
+ * %G_VARIANT_DICT_INDEX_MIN_ENTRIES entries are indexed: their keys
+ * point into the serialized data, which never changes, and scanning
+ * smaller ones is cheaper than building an index.  The index is freed
+ * together with @value.
+ *
+ * Returns: %TRUE if @value is indexed
+ */
+gboolean
+g_variant_ensure_dict_index (GVariant *value,
+                             gboolean *unique_keys)
+{
+  GVariantDictIndex *dict_index, *other;
+  gsize n_entries, i;
+
+  if (~g_atomic_int_get (&value->state) & STATE_SERIALISED)
+    return FALSE;
+
+  if (g_atomic_int_get (&value->state) & STATE_INDEXED)
+    dict_index = g_variant_dict_index_get (value);
+  else
+    {
+      n_entries = g_variant_n_children (value);
+      if (n_entries < G_VARIANT_DICT_INDEX_MIN_ENTRIES)
+        return FALSE;
+
+      dict_index = g_new (GVariantDictIndex, 1);
+      dict_index->entries = g_hash_table_new (g_str_hash, g_str_equal);
+      dict_index->unique_keys = TRUE;
+
+      for (i = 0; i < n_entries; i++)
+        {
+          GVariant *entry = g_variant_get_child_value (value, i);
+          GVariant *key = g_variant_get_child_value (entry, 0);
+          const gchar *str = g_variant_get_string (key, NULL);
+
+          /* Keep the first occurrence, as found by a linear scan */
+          if (g_hash_table_contains (dict_index->entries, str))
+            dict_index->unique_keys = FALSE;
+          else
+            g_hash_table_insert (dict_index->entries, (gpointer) str, GSIZE_TO_POINTER (i + 1));
+
+          g_variant_unref (key);
+          g_variant_unref (entry);
+        }
+
+      g_mutex_lock (&dict_indexes_lock);
+      if (dict_indexes == NULL)
+        dict_indexes = g_hash_table_new_full (NULL, NULL, NULL, g_variant_dict_index_free);
+
+      /* Another thread may have been faster */
+      other = g_hash_table_lookup (dict_indexes, value);
+      if (other != NULL)
+        {
+          g_variant_dict_index_free (dict_index);
+          dict_index = other;
+        }
+      else
+        {
+          g_hash_table_insert (dict_indexes, value, dict_index);
+          g_atomic_int_or (&value->state, STATE_INDEXED);
+        }
+      g_mutex_unlock (&dict_indexes_lock);
+    }
+
+  if (unique_keys != NULL)
+    *unique_keys = dict_index->unique_keys;
+
+  return TRUE;
+}
+
+/* < internal >
+ * g_variant_lookup_dict_index:
+ * @value: a dictionary indexed with g_variant_ensure_dict_index()
+ * @key: the key to look up
+ *
+ * Finds the first entry of @value with @key through its key index.
+ *
+ * Returns: the index of the entry, or %G_MAXSIZE if there is none
+ */
+gsize
+g_variant_lookup_dict_index (GVariant    *value,
+                             const gchar *key)
+{
+  GVariantDictIndex *dict_index;
+  gpointer position;
+
+  g_assert (g_atomic_int_get (&value->state) & STATE_INDEXED);
+
+  /* The index is only freed together with @value */
+  dict_index = g_variant_dict_index_get (value);
+  g_assert (dict_index != NULL);
+
+  position = g_hash_table_lookup (dict_index->entries, key);
+
+  return position ? GPOINTER_TO_SIZE (position) - 1 : G_MAXSIZE;
+}
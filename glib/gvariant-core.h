@@ -41,4 +41,12 @@ gsize                   g_variant_get_depth                             (GVarian
 GVariant *              g_variant_maybe_get_child_value                 (GVariant            *value,
                                                                          gsize                index_);
 
+#define G_VARIANT_DICT_INDEX_MIN_ENTRIES 32
+
+gboolean                g_variant_ensure_dict_index                     (GVariant            *value,
+                                                                         gboolean            *unique_keys);
+
+gsize                   g_variant_lookup_dict_index                     (GVariant            *value,
+                                                                         const gchar         *key);
+
 #endif /* __G_VARIANT_CORE_H__ */
@@ -30,6 +30,7 @@
 #include "gstring.h"
 #include "gstrfuncs.h"
 #include "gtestutils.h"
+#include "gunicode.h"
 #include "gvariant.h"
 #include "glib/gvariant-core.h"
 #include "gvariant-internal.h"
@@ -2464,6 +2465,245 @@ parse (TokenStream  *stream,
   return result;
 }
 
+/* Fast path for arrays of numbers, booleans and strings of a known type,
+ * like large GSettings overrides or test data. The elements are written
+ * straight into the serialised array, without first building an AST node
+ * and a GVariant for each of them.
+ *
+ * Anything unusual, like type annotations, out of range numbers or
+ * syntax errors, makes these functions give up, and the caller then
+ * parses the input again with the generic parser, which also takes care
+ * of reporting errors. */
+static gboolean
+basic_array_parse_number (TokenStream *stream,
+                          gchar        type_char,
+                          GByteArray  *numbers)
+{
+  union {
+    guint8 u8;
+    guint16 u16;
+    guint32 u32;
+    guint64 u64;
+    gdouble dbl;
+  } number;
+  gchar token[64];
+  const gchar *digits;
+  gboolean negative;
+  guint64 abs_val, bits;
+  gsize length, size;
+  gchar *end;
+
+  if (type_char == 'b')
+    {
+      if (token_stream_consume (stream, "true"))
+        number.u8 = TRUE;
+      else if (token_stream_consume (stream, "false"))
+        number.u8 = FALSE;
+      else
+        return FALSE;
+
+      g_byte_array_append (numbers, &number.u8, 1);
+      return TRUE;
+    }
+
+  if (!token_stream_is_numeric (stream))
+    return FALSE;
+
+  length = stream->stream - stream->this;
+  if (length >= sizeof token)
+    return FALSE;
+  memcpy (token, stream->this, length);
+  token[length] = '\0';
+
+  /* Same conversions and range checks as number_get_value() */
+  if (type_char == 'd')
+    {
+      errno = 0;
+      number.dbl = g_ascii_strtod (token, &end);
+      if (*end != '\0' || (number.dbl != 0.0 && errno == ERANGE))
+        return FALSE;
+
+      size = sizeof (gdouble);
+    }
+  else
+    {
+      negative = token[0] == '-';
+      digits = negative ? token + 1 : token;
+
+      errno = 0;
+      abs_val = g_ascii_strtoull (digits, &end, 0);
+      if (*end != '\0' || (abs_val == G_MAXUINT64 && errno == ERANGE))
+        return FALSE;
+
+      if (abs_val == 0)
+        negative = FALSE;
+
+      switch (type_char)
+        {
+        case 'y':
+          if (negative || abs_val > G_MAXUINT8)
+            return FALSE;
+          size = 1;
+          break;
+
+        case 'n':
+          if (abs_val - negative > G_MAXINT16)
+            return FALSE;
+          size = 2;
+          break;
+
+        case 'q':
+          if (negative || abs_val > G_MAXUINT16)
+            return FALSE;
+          size = 2;
+          break;
+
+        case 'i':
+        case 'h':
+          if (abs_val - negative > G_MAXINT32)
+            return FALSE;
+          size = 4;
+          break;
+
+        case 'u':
+          if (negative || abs_val > G_MAXUINT32)
+            return FALSE;
+          size = 4;
+          break;
+
+        case 'x':
+          if (abs_val - negative > G_MAXINT64)
+            return FALSE;
+          size = 8;
+          break;
+
+        case 't':
+          if (negative)
+            return FALSE;
+          size = 8;
+          break;
+
+        default:
+          g_assert_not_reached ();
+        }
+
+      /* Two's complement, truncated to the size of the type */
+      bits = negative ? -abs_val : abs_val;
+      switch (size)
+        {
+        case 1:
+          number.u8 = bits;
+          break;
+        case 2:
+          number.u16 = bits;
+          break;
+        case 4:
+          number.u32 = bits;
+          break;
+        default:
+          number.u64 = bits;
+          break;
+        }
+    }
+
+  token_stream_next (stream);
+  g_byte_array_append (numbers, (const guint8 *) &number, size);
+
+  return TRUE;
+}
+
+static gboolean
+basic_array_parse_string (TokenStream    *stream,
+                          gchar           type_char,
+                          GVariantWriter *strings)
+{
+  const gchar format[] = { type_char, '\0' };
+  gboolean valid;
+  String *string;
+
+  if (!token_stream_peek (stream, '\'') && !token_stream_peek (stream, '"'))
+    return FALSE;
+
+  string = (String *) string_parse (stream, NULL, NULL);
+  if (string == NULL)
+    return FALSE;
+
+  if (type_char == 'o')
+    valid = g_variant_is_object_path (string->string);
+  else if (type_char == 'g')
+    valid = g_variant_is_signature (string->string);
+  else
+    valid = g_utf8_validate (string->string, -1, NULL);
+
+  if (valid)
+    g_variant_writer_add (strings, format, string->string);
+
+  ast_free ((AST *) string);
+
+  return valid;
+}
+
+static GVariant *
+basic_array_parse (TokenStream        *stream,
+                   const GVariantType *type)
+{
+  TokenStream saved = *stream;
+  GByteArray *numbers = NULL;
+  GVariantWriter *strings = NULL;
+  gboolean need_comma = FALSE;
+  GVariant *result = NULL;
+  gchar type_char;
+
+  if (!g_variant_type_is_array (type) ||
+      !g_variant_type_is_basic (g_variant_type_element (type)))
+    return NULL;
+
+  if (!token_stream_consume (stream, "["))
+    {
+      *stream = saved;
+      return NULL;
+    }
+
+  type_char = g_variant_type_peek_string (type)[1];
+  if (type_char == 's' || type_char == 'o' || type_char == 'g')
+    strings = g_variant_writer_new (type);
+  else
+    numbers = g_byte_array_new ();
+
+  while (!token_stream_consume (stream, "]"))
+    {
+      if (need_comma && !token_stream_consume (stream, ","))
+        goto out;
+
+      if (strings ? !basic_array_parse_string (stream, type_char, strings)
+                  : !basic_array_parse_number (stream, type_char, numbers))
+        goto out;
+
+      need_comma = TRUE;
+    }
+
+  if (strings)
+    result = g_variant_writer_end (strings);
+  else
+    {
+      GBytes *bytes = g_byte_array_free_to_bytes (g_steal_pointer (&numbers));
+
+      result = g_variant_new_from_bytes (type, bytes, TRUE);
+      g_bytes_unref (bytes);
+    }
+
+ out:
+  if (strings)
+    g_variant_writer_free (strings);
+  if (numbers)
+    g_byte_array_unref (numbers);
+
+  if (result == NULL)
+    *stream = saved;
+
+  return result;
+}
+
 /**
  * g_variant_parse:
  * @type: (nullable): a #GVariantType, or %NULL
@@ -2529,43 +2769,46 @@ g_variant_parse (const GVariantType  *type,
   stream.stream = text;
   stream.end = limit;
 
-  if ((ast = parse (&stream, G_VARIANT_MAX_RECURSION_DEPTH, NULL, error)))
+  if (type != NULL && (result = basic_array_parse (&stream, type)) != NULL)
+    ast = NULL;
+  else if ((ast = parse (&stream, G_VARIANT_MAX_RECURSION_DEPTH, NULL, error)))
     {
       if (type == NULL)
         result = ast_resolve (ast, error);
       else
         result = ast_get_value (ast, type, error);
+    }
 
-      if (result != NULL)
+  if (result != NULL)
+    {
+      g_variant_ref_sink (result);
+
+      if (endptr == NULL)
         {
-          g_variant_ref_sink (result);
+          while (stream.stream != limit &&
+                 g_ascii_isspace (*stream.stream))
+            stream.stream++;
 
-          if (endptr == NULL)
+          if (stream.stream != limit && *stream.stream != '\0')
             {
-              while (stream.stream != limit &&
-                     g_ascii_isspace (*stream.stream))
-                stream.stream++;
-
-              if (stream.stream != limit && *stream.stream != '\0')
-                {
-                  SourceRef ref = { stream.stream - text,
-                                    stream.stream - text };
+              SourceRef ref = { stream.stream - text,
+                                stream.stream - text };
 
-                  parser_set_error (error, &ref, NULL,
-                                    G_VARIANT_PARSE_ERROR_INPUT_NOT_AT_END,
-                                    "expected end of input");
-                  g_variant_unref (result);
+              parser_set_error (error, &ref, NULL,
+                                G_VARIANT_PARSE_ERROR_INPUT_NOT_AT_END,
+                                "expected end of input");
+              g_variant_unref (result);
 
-                  result = NULL;
-                }
+              result = NULL;
             }
-          else
-            *endptr = stream.stream;
         }
-
-      ast_free (ast);
+      else
+        *endptr = stream.stream;
     }
 
+  if (ast != NULL)
+    ast_free (ast);
+
   return result;
 }
 
@@ -713,25 +713,50 @@ gvs_variable_sized_array_n_children (GVariantSerialised value)
 
 /* Find the index of the first out-of-order element in @data, assuming that
  * @data is an array of elements of given @type, starting at index @start and
- * containing a further @len-@start elements. */
+ * containing a further @len-@start elements. Returns the index of the last
+ * element which is in order.
+ *
+ * Whole blocks of elements are compared pairwise without branching on each
+ * one, which compilers can vectorise, and only a block which is out of order
+ * is searched for the exact position. */
+#define FIND_UNORDERED_BLOCK_SIZE 64
 #define DEFINE_FIND_UNORDERED(type, le_to_native) \
   static gsize \
   find_unordered_##type (const guint8 *data, gsize start, gsize len) \
   { \
-    gsize off; \
+    gsize i, j; \
     type current_le, previous_le, current, previous; \
     \
-    memcpy (&previous_le, data + start * sizeof (current), sizeof (current)); \
+    for (i = start + 1; i < len; i += FIND_UNORDERED_BLOCK_SIZE) \
+      { \
+        gsize block_end = MIN (i + FIND_UNORDERED_BLOCK_SIZE, len); \
+        gboolean unordered = FALSE; \
+        \
+        for (j = i; j < block_end; j++) \
+          { \
+            memcpy (&previous_le, data + (j - 1) * sizeof (current), sizeof (current)); \
+            memcpy (&current_le, data + j * sizeof (current), sizeof (current)); \
+            unordered |= le_to_native (current_le) < le_to_native (previous_le); \
+          } \
+        \
+        if (unordered) \
+          break; \
+      } \
+    \
+    if (i >= len) \
+      return len - 1; \
+    \
+    memcpy (&previous_le, data + (i - 1) * sizeof (current), sizeof (current)); \
     previous = le_to_native (previous_le); \
-    for (off = (start + 1) * sizeof (current); off < len * sizeof (current); off += sizeof (current)) \
+    for (; i < len; i++) \
       { \
-        memcpy (&current_le, data + off, sizeof (current)); \
+        memcpy (&current_le, data + i * sizeof (current), sizeof (current)); \
         current = le_to_native (current_le); \
         if (current < previous) \
           break; \
         previous = current; \
       } \
-    return off / sizeof (current) - 1; \
+    return i - 1; \
   }
 
 #define NO_CONVERSION(x) (x)
@@ -740,6 +765,27 @@ DEFINE_FIND_UNORDERED (guint16, GUINT16_FROM_LE);
 DEFINE_FIND_UNORDERED (guint32, GUINT32_FROM_LE);
 DEFINE_FIND_UNORDERED (guint64, GUINT64_FROM_LE);
 
+static gsize
+gvs_offsets_find_unordered (struct Offsets *offsets,
+                            gsize           start,
+                            gsize           len)
+{
+  switch (offsets->offset_size)
+    {
+    case 1:
+      return find_unordered_guint8 (offsets->array, start, len);
+    case 2:
+      return find_unordered_guint16 (offsets->array, start, len);
+    case 4:
+      return find_unordered_guint32 (offsets->array, start, len);
+    case 8:
+      return find_unordered_guint64 (offsets->array, start, len);
+    default:
+      /* gvs_get_offset_size() only returns maximum 8 */
+      g_assert_not_reached ();
+    }
+}
+
 static GVariantSerialised
 gvs_variable_sized_array_get_child (GVariantSerialised value,
                                     gsize              index_)
@@ -766,37 +812,9 @@ gvs_variable_sized_array_get_child (GVariantSerialised value,
       index_ > value.checked_offsets_up_to &&
       value.ordered_offsets_up_to == value.checked_offsets_up_to)
     {
-      switch (offsets.offset_size)
-        {
-        case 1:
-          {
-            value.ordered_offsets_up_to = find_unordered_guint8 (
-                offsets.array, value.checked_offsets_up_to, index_ + 1);
-            break;
-          }
-        case 2:
-          {
-            value.ordered_offsets_up_to = find_unordered_guint16 (
-                offsets.array, value.checked_offsets_up_to, index_ + 1);
-            break;
-          }
-        case 4:
-          {
-            value.ordered_offsets_up_to = find_unordered_guint32 (
-                offsets.array, value.checked_offsets_up_to, index_ + 1);
-            break;
-          }
-        case 8:
-          {
-            value.ordered_offsets_up_to = find_unordered_guint64 (
-                offsets.array, value.checked_offsets_up_to, index_ + 1);
-            break;
-          }
-        default:
-          /* gvs_get_offset_size() only returns maximum 8 */
-          g_assert_not_reached ();
-        }
-
+      value.ordered_offsets_up_to = gvs_offsets_find_unordered (&offsets,
+                                                                value.checked_offsets_up_to,
+                                                                index_ + 1);
       value.checked_offsets_up_to = index_;
     }
 
@@ -906,6 +924,13 @@ gvs_variable_sized_array_is_normal (GVariantSerialised value)
 
   g_assert (value.size != 0 || offsets.length == 0);
 
+  /* Check the order of all the offsets in one pass first, which is much
+   * cheaper than checking the children, so that corrupt offsets are
+   * rejected early */
+  if (offsets.length > 1 &&
+      gvs_offsets_find_unordered (&offsets, 0, offsets.length) != offsets.length - 1)
+    return FALSE;
+
   child.type_info = g_variant_type_info_element (value.type_info);
   g_variant_type_info_query (child.type_info, &alignment, NULL);
   child.depth = value.depth + 1;
@@ -1672,6 +1697,87 @@ g_variant_serialiser_needed_size (GVariantTypeInfo         *type_info,
 
 /* Byteswapping {{{2 */
 
+/* Returns the size of the numbers in the fixed size type @type_info if
+ * they all have the same size, which then is at least 2. As tuples are
+ * aligned to their largest member, there is no padding in that case.
+ * Returns 0 otherwise. */
+static gsize
+gvs_uniform_word_size (GVariantTypeInfo *type_info)
+{
+  gsize fixed_size, word_size = 0;
+  guint alignment;
+  gsize n_members, i;
+
+  g_variant_type_info_query (type_info, &alignment, &fixed_size);
+  if (!fixed_size || !alignment)
+    return 0;
+
+  /* a number, or a tuple with a single number in it */
+  if (alignment + 1 == fixed_size)
+    return fixed_size;
+
+  if (g_variant_type_info_get_type_char (type_info) != G_VARIANT_TYPE_INFO_CHAR_TUPLE &&
+      g_variant_type_info_get_type_char (type_info) != G_VARIANT_TYPE_INFO_CHAR_DICT_ENTRY)
+    return 0;
+
+  n_members = g_variant_type_info_n_members (type_info);
+  for (i = 0; i < n_members; i++)
+    {
+      gsize member_size;
+
+      member_size = gvs_uniform_word_size (g_variant_type_info_member_info (type_info, i)->type_info);
+      if (member_size == 0 || (word_size && member_size != word_size))
+        return 0;
+
+      word_size = member_size;
+    }
+
+  return word_size;
+}
+
+/* Simple loops over aligned numbers, which compilers turn into vector
+ * byte shuffles */
+static void
+gvs_byteswap_words (guchar *data,
+                    gsize   size,
+                    gsize   word_size)
+{
+  gsize i;
+
+  switch (word_size)
+    {
+    case 2:
+      {
+        guint16 *words = (guint16 *) data;
+
+        for (i = 0; i < size / 2; i++)
+          words[i] = GUINT16_SWAP_LE_BE (words[i]);
+      }
+      break;
+
+    case 4:
+      {
+        guint32 *words = (guint32 *) data;
+
+        for (i = 0; i < size / 4; i++)
+          words[i] = GUINT32_SWAP_LE_BE (words[i]);
+      }
+      break;
+
+    case 8:
+      {
+        guint64 *words = (guint64 *) data;
+
+        for (i = 0; i < size / 8; i++)
+          words[i] = GUINT64_SWAP_LE_BE (words[i]);
+      }
+      break;
+
+    default:
+      g_assert_not_reached ();
+    }
+}
+
 /* < private >
  * g_variant_serialised_byteswap:
  * @value: a #GVariantSerialised
@@ -1684,6 +1790,7 @@ g_variant_serialised_byteswap (GVariantSerialised serialised)
 {
   gsize fixed_size;
   guint alignment;
+  gsize word_size = 0;
 
   g_assert (g_variant_serialised_check (serialised));
 
@@ -1697,6 +1804,25 @@ g_variant_serialised_byteswap (GVariantSerialised serialised)
   if (!alignment)
     return;
 
+  /* fixed size values made up of numbers of one size, and arrays of
+   * them, are just a sequence of numbers of that size */
+  if (fixed_size)
+    word_size = gvs_uniform_word_size (serialised.type_info);
+  else if (g_variant_type_info_get_type_char (serialised.type_info) == G_VARIANT_TYPE_INFO_CHAR_ARRAY)
+    {
+      GVariantTypeInfo *element = g_variant_type_info_element (serialised.type_info);
+
+      g_variant_type_info_query (element, NULL, &fixed_size);
+      if (fixed_size)
+        word_size = gvs_uniform_word_size (element);
+    }
+
+  if (word_size && serialised.size % word_size == 0)
+    {
+      gvs_byteswap_words (serialised.data, serialised.size, word_size);
+      return;
+    }
+
   /* if fixed size and alignment are equal then we are down
    * to the base integer type and we should swap it.  the
    * only exception to this is if we have a tuple with a
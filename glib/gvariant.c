@@ -967,8 +967,10 @@ g_variant_new_dict_entry (GVariant *key,
  * see the section on
  * [`GVariant` format strings](gvariant-format-strings.html#pointers).
  *
- * This function is currently implemented with a linear scan.  If you
- * plan to do many lookups then #GVariantDict may be more efficient.
+ * Small dictionaries are searched with a linear scan.  On the first
+ * lookup in a serialized dictionary with many entries, an index of its
+ * keys is built, which is kept until @dictionary is freed and speeds up
+ * further lookups in it.
  *
  * Returns: %TRUE if a value was unpacked
  *
@@ -1031,8 +1033,10 @@ g_variant_lookup (GVariant    *dictionary,
  * returned.  If @expected_type was specified then any non-%NULL return
  * value will have this type.
  *
- * This function is currently implemented with a linear scan.  If you
- * plan to do many lookups then #GVariantDict may be more efficient.
+ * Small dictionaries are searched with a linear scan.  On the first
+ * lookup in a serialized dictionary with many entries, an index of its
+ * keys is built, which is kept until @dictionary is freed and speeds up
+ * further lookups in it.
  *
  * Returns: (transfer full): the value of the dictionary key, or %NULL
  *
@@ -1053,25 +1057,37 @@ g_variant_lookup_value (GVariant           *dictionary,
                                               G_VARIANT_TYPE ("a{o*}")),
                         NULL);
 
-  g_variant_iter_init (&iter, dictionary);
+  if (g_variant_ensure_dict_index (dictionary, NULL))
+    {
+      gsize position = g_variant_lookup_dict_index (dictionary, key);
+
+      if (position == G_MAXSIZE)
+        return NULL;
 
-  while ((entry = g_variant_iter_next_value (&iter)))
+      entry = g_variant_get_child_value (dictionary, position);
+    }
+  else
     {
-      GVariant *entry_key;
-      gboolean matches;
+      g_variant_iter_init (&iter, dictionary);
 
-      entry_key = g_variant_get_child_value (entry, 0);
-      matches = strcmp (g_variant_get_string (entry_key, NULL), key) == 0;
-      g_variant_unref (entry_key);
+      while ((entry = g_variant_iter_next_value (&iter)))
+        {
+          GVariant *entry_key;
+          gboolean matches;
 
-      if (matches)
-        break;
+          entry_key = g_variant_get_child_value (entry, 0);
+          matches = strcmp (g_variant_get_string (entry_key, NULL), key) == 0;
+          g_variant_unref (entry_key);
 
-      g_variant_unref (entry);
-    }
+          if (matches)
+            break;
 
-  if (entry == NULL)
-    return NULL;
+          g_variant_unref (entry);
+        }
+
+      if (entry == NULL)
+        return NULL;
+    }
 
   value = g_variant_get_child_value (entry, 1);
   g_variant_unref (entry);
@@ -2194,6 +2210,138 @@ g_variant_classify (GVariant *value)
 /* This function is not introspectable because if @string is NULL,
    @returns is (transfer full), otherwise it is (transfer none), which
    is not supported by GObjectIntrospection */
+static void
+g_variant_print_double (GString *string,
+                        gdouble  value)
+{
+  gchar buffer[100];
+  gint i;
+
+  g_ascii_dtostr (buffer, sizeof buffer, value);
+
+  for (i = 0; buffer[i]; i++)
+    if (buffer[i] == '.' || buffer[i] == 'e' ||
+        buffer[i] == 'n' || buffer[i] == 'N')
+      break;
+
+  /* if there is no '.' or 'e' in the float then add one */
+  if (buffer[i] == '\0')
+    {
+      buffer[i++] = '.';
+      buffer[i++] = '0';
+      buffer[i++] = '\0';
+    }
+
+  g_string_append (string, buffer);
+}
+
+/* Prints a non-empty array of numbers straight from its serialised
+ * data, instead of creating a GVariant for each element, in the same
+ * format as g_variant_print_string() prints the elements. @type_string
+ * is the type string of @value. Returns %FALSE if @value is not such an
+ * array. */
+static gboolean
+g_variant_print_fixed_array (GVariant    *value,
+                             const gchar *type_string,
+                             GString     *string,
+                             gboolean     type_annotate)
+{
+  const gchar *annotation = NULL;
+  gconstpointer elements;
+  gsize element_size;
+  gsize n, i;
+
+  switch (type_string[1])
+    {
+    case 'y':
+      annotation = "byte ";
+      element_size = 1;
+      break;
+    case 'n':
+      annotation = "int16 ";
+      element_size = 2;
+      break;
+    case 'q':
+      annotation = "uint16 ";
+      element_size = 2;
+      break;
+    case 'i':
+      element_size = 4;
+      break;
+    case 'h':
+      annotation = "handle ";
+      element_size = 4;
+      break;
+    case 'u':
+      annotation = "uint32 ";
+      element_size = 4;
+      break;
+    case 'x':
+      annotation = "int64 ";
+      element_size = 8;
+      break;
+    case 't':
+      annotation = "uint64 ";
+      element_size = 8;
+      break;
+    case 'd':
+      element_size = 8;
+      break;
+    default:
+      return FALSE;
+    }
+
+  elements = g_variant_get_fixed_array (value, &n, element_size);
+  if (n == 0)
+    return FALSE;
+
+  g_string_append_c (string, '[');
+
+  if (type_annotate && annotation != NULL)
+    g_string_append (string, annotation);
+
+  for (i = 0; i < n; i++)
+    {
+      if (i > 0)
+        g_string_append (string, ", ");
+
+      switch (type_string[1])
+        {
+        case 'y':
+          g_string_append_printf (string, "0x%02x", ((const guint8 *) elements)[i]);
+          break;
+        case 'n':
+          g_string_append_printf (string, "%" G_GINT16_FORMAT, ((const gint16 *) elements)[i]);
+          break;
+        case 'q':
+          g_string_append_printf (string, "%" G_GUINT16_FORMAT, ((const guint16 *) elements)[i]);
+          break;
+        case 'i':
+        case 'h':
+          g_string_append_printf (string, "%" G_GINT32_FORMAT, ((const gint32 *) elements)[i]);
+          break;
+        case 'u':
+          g_string_append_printf (string, "%" G_GUINT32_FORMAT, ((const guint32 *) elements)[i]);
+          break;
+        case 'x':
+          g_string_append_printf (string, "%" G_GINT64_FORMAT, ((const gint64 *) elements)[i]);
+          break;
+        case 't':
+          g_string_append_printf (string, "%" G_GUINT64_FORMAT, ((const guint64 *) elements)[i]);
+          break;
+        case 'd':
+          g_variant_print_double (string, ((const gdouble *) elements)[i]);
+          break;
+        default:
+          g_assert_not_reached ();
+        }
+    }
+
+  g_string_append_c (string, ']');
+
+  return TRUE;
+}
+
 /**
  * g_variant_print_string: (skip)
  * @value: a #GVariant
@@ -2378,6 +2526,9 @@ g_variant_print_string (GVariant *value,
               break;
             }
 
+          if (g_variant_print_fixed_array (value, value_type_string, string, type_annotate))
+            break;
+
           g_string_append_c (string, '[');
           for (i = 0; i < n; i++)
             {
@@ -2589,27 +2740,7 @@ g_variant_print_string (GVariant *value,
       break;
 
     case G_VARIANT_CLASS_DOUBLE:
-      {
-        gchar buffer[100];
-        gint i;
-
-        g_ascii_dtostr (buffer, sizeof buffer, g_variant_get_double (value));
-
-        for (i = 0; buffer[i]; i++)
-          if (buffer[i] == '.' || buffer[i] == 'e' ||
-              buffer[i] == 'n' || buffer[i] == 'N')
-            break;
-
-        /* if there is no '.' or 'e' in the float then add one */
-        if (buffer[i] == '\0')
-          {
-            buffer[i++] = '.';
-            buffer[i++] = '0';
-            buffer[i++] = '\0';
-          }
-
-        g_string_append (string, buffer);
-      }
+      g_variant_print_double (string, g_variant_get_double (value));
       break;
 
     case G_VARIANT_CLASS_OBJECT_PATH:
@@ -3890,6 +4021,11 @@ struct stack_dict
 {
   GHashTable *values;
   gsize magic;
+
+  /* A large serialized dictionary given to g_variant_dict_init(), which
+   * is kept as it is rather than copied into @values.  @values then only
+   * holds the keys modified since, and %NULL for the removed ones. */
+  GVariant *base;
 };
 
 G_STATIC_ASSERT (sizeof (struct stack_dict) <= sizeof (GVariantDict));
@@ -3935,6 +4071,37 @@ ensure_valid_dict (GVariantDict *dict)
   return is_valid_dict (dict);
 }
 
+static void
+dict_value_free (gpointer data)
+{
+  if (data != NULL)
+    g_variant_unref (data);
+}
+
+static gboolean
+dict_base_contains (GVariantDict *dict,
+                    const gchar  *key)
+{
+  return GVSD(dict)->base != NULL &&
+         g_variant_lookup_dict_index (GVSD(dict)->base, key) != G_MAXSIZE;
+}
+
+/* Returns the current value of @key in @dict, as a new reference */
+static GVariant *
+dict_get_value (GVariantDict *dict,
+                const gchar  *key)
+{
+  gpointer value;
+
+  if (g_hash_table_lookup_extended (GVSD(dict)->values, key, NULL, &value))
+    return value ? g_variant_ref (value) : NULL;
+
+  if (GVSD(dict)->base != NULL)
+    return g_variant_lookup_value (GVSD(dict)->base, key, NULL);
+
+  return NULL;
+}
+
 /* return_if_invalid_dict (d) is like
  * g_return_if_fail (ensure_valid_dict (d)), except that
  * the side effects of ensure_valid_dict are evaluated
@@ -4022,11 +4189,24 @@ g_variant_dict_init (GVariantDict *dict,
   gchar *key;
   GVariant *value;
 
-  GVSD(dict)->values = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_variant_unref);
+  GVSD(dict)->values = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, dict_value_free);
   GVSD(dict)->magic = GVSD_MAGIC;
+  GVSD(dict)->base = NULL;
 
   if (from_asv)
     {
+      gboolean unique_keys;
+
+      /* Entries are looked up in indexed dictionaries directly, and only
+       * copied when they are modified */
+      if (g_variant_is_of_type (from_asv, G_VARIANT_TYPE_VARDICT) &&
+          g_variant_ensure_dict_index (from_asv, &unique_keys) &&
+          unique_keys)
+        {
+          GVSD(dict)->base = g_variant_ref (from_asv);
+          return;
+        }
+
       g_variant_iter_init (&iter, from_asv);
       while (g_variant_iter_next (&iter, "{sv}", &key, &value))
         g_hash_table_insert (GVSD(dict)->values, key, value);
@@ -4069,15 +4249,23 @@ g_variant_dict_lookup (GVariantDict *dict,
   g_return_val_if_fail (key != NULL, FALSE);
   g_return_val_if_fail (format_string != NULL, FALSE);
 
-  value = g_hash_table_lookup (GVSD(dict)->values, key);
+  value = dict_get_value (dict, key);
 
-  if (value == NULL || !g_variant_check_format_string (value, format_string, FALSE))
+  if (value == NULL)
     return FALSE;
 
+  if (!g_variant_check_format_string (value, format_string, FALSE))
+    {
+      g_variant_unref (value);
+      return FALSE;
+    }
+
   va_start (ap, format_string);
   g_variant_get_va (value, format_string, NULL, &ap);
   va_end (ap);
 
+  g_variant_unref (value);
+
   return TRUE;
 }
 
@@ -4113,12 +4301,12 @@ g_variant_dict_lookup_value (GVariantDict       *dict,
   return_val_if_invalid_dict (dict, NULL);
   g_return_val_if_fail (key != NULL, NULL);
 
-  result = g_hash_table_lookup (GVSD(dict)->values, key);
+  result = dict_get_value (dict, key);
 
-  if (result && (!expected_type || g_variant_is_of_type (result, expected_type)))
-    return g_variant_ref (result);
+  if (result && expected_type && !g_variant_is_of_type (result, expected_type))
+    g_clear_pointer (&result, g_variant_unref);
 
-  return NULL;
+  return result;
 }
 
 /**
@@ -4136,10 +4324,15 @@ gboolean
 g_variant_dict_contains (GVariantDict *dict,
                          const gchar  *key)
 {
+  gpointer value;
+
   return_val_if_invalid_dict (dict, FALSE);
   g_return_val_if_fail (key != NULL, FALSE);
 
-  return g_hash_table_contains (GVSD(dict)->values, key);
+  if (g_hash_table_lookup_extended (GVSD(dict)->values, key, NULL, &value))
+    return value != NULL;
+
+  return dict_base_contains (dict, key);
 }
 
 /**
@@ -4215,6 +4408,19 @@ g_variant_dict_remove (GVariantDict *dict,
   return_val_if_invalid_dict (dict, FALSE);
   g_return_val_if_fail (key != NULL, FALSE);
 
+  if (dict_base_contains (dict, key))
+    {
+      gpointer value;
+
+      if (g_hash_table_lookup_extended (GVSD(dict)->values, key, NULL, &value) &&
+          value == NULL)
+        return FALSE;
+
+      /* Mask the entry of the base dictionary */
+      g_hash_table_insert (GVSD(dict)->values, g_strdup (key), NULL);
+      return TRUE;
+    }
+
   return g_hash_table_remove (GVSD(dict)->values, key);
 }
 
@@ -4250,6 +4456,7 @@ g_variant_dict_clear (GVariantDict *dict)
 
   g_hash_table_unref (GVSD(dict)->values);
   GVSD(dict)->values = NULL;
+  g_clear_pointer (&GVSD(dict)->base, g_variant_unref);
 
   GVSD(dict)->magic = 0;
 }
@@ -4279,6 +4486,54 @@ g_variant_dict_end (GVariantDict *dict)
 
   return_val_if_invalid_dict (dict, NULL);
 
+  if (GVSD(dict)->base != NULL)
+    {
+      GVariant *base = GVSD(dict)->base;
+      gsize n_entries, i;
+
+      if (g_hash_table_size (GVSD(dict)->values) == 0)
+        {
+          GBytes *bytes = g_variant_get_data_as_bytes (base);
+          GVariant *result;
+
+          result = g_variant_new_from_bytes (G_VARIANT_TYPE_VARDICT, bytes,
+                                             g_variant_is_trusted (base));
+          g_bytes_unref (bytes);
+          g_variant_dict_clear (dict);
+
+          return result;
+        }
+
+      g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
+
+      /* Unmodified entries are copied over as they are */
+      n_entries = g_variant_n_children (base);
+      for (i = 0; i < n_entries; i++)
+        {
+          GVariant *entry = g_variant_get_child_value (base, i);
+          GVariant *entry_key = g_variant_get_child_value (entry, 0);
+          const gchar *entry_key_str = g_variant_get_string (entry_key, NULL);
+
+          if (!g_hash_table_lookup_extended (GVSD(dict)->values, entry_key_str, NULL, &value))
+            g_variant_builder_add_value (&builder, entry);
+          else if (value != NULL)
+            g_variant_builder_add (&builder, "{sv}", entry_key_str, (GVariant *) value);
+
+          g_variant_unref (entry_key);
+          g_variant_unref (entry);
+        }
+
+      /* followed by the added ones */
+      g_hash_table_iter_init (&iter, GVSD(dict)->values);
+      while (g_hash_table_iter_next (&iter, &key, &value))
+        if (value != NULL && !dict_base_contains (dict, key))
+          g_variant_builder_add (&builder, "{sv}", (const gchar *) key, (GVariant *) value);
+
+      g_variant_dict_clear (dict);
+
+      return g_variant_builder_end (&builder);
+    }
+
   g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
 
   g_hash_table_iter_init (&iter, GVSD(dict)->values);
@@ -6168,6 +6423,70 @@ g_variant_byteswap (GVariant *value)
   return g_steal_pointer (&new);
 }
 
+/**
+ * g_variant_byteswap_take:
+ * @value: (transfer full): a #GVariant
+ *
+ * Performs the same byteswapping operation as g_variant_byteswap(), but
+ * consumes @value.
+ *
+ * If @value is in normal form, and nothing else references it or its
+ * serialised data, the data is byteswapped in place instead of being
+ * copied first. That is the case for values created with
+ * g_variant_new_from_bytes() from #GBytes that were given up by the
+ * caller, such as messages just read from a peer with a different byte
+ * order.
+ *
+ * If @value is floating, the floating reference is consumed.
+ *
+ * Returns: (transfer full): the byteswapped form of @value
+ *
+ * Since: 2.82
+ **/
+GVariant *
+g_variant_byteswap_take (GVariant *value)
+{
+  GVariantSerialised serialised = { 0, };
+  GVariant *new;
+  GBytes *bytes;
+  guint alignment;
+
+  g_return_val_if_fail (value != NULL, NULL);
+
+  value = g_variant_take_ref (value);
+
+  g_variant_type_info_query (g_variant_get_type_info (value), &alignment, NULL);
+
+  if (!alignment || !g_variant_is_normal_form (value))
+    {
+      new = g_variant_byteswap (value);
+      g_variant_unref (value);
+
+      return new;
+    }
+
+  serialised.type_info = g_variant_type_info_ref (g_variant_get_type_info (value));
+  serialised.depth = g_variant_get_depth (value);
+  serialised.ordered_offsets_up_to = G_MAXSIZE;  /* operating on the normal form */
+  serialised.checked_offsets_up_to = G_MAXSIZE;
+
+  bytes = g_variant_get_data_as_bytes (value);
+  g_variant_unref (value);
+
+  /* Only copies if something else still references the data */
+  serialised.data = g_bytes_unref_to_data (bytes, &serialised.size);
+
+  g_variant_serialised_byteswap (serialised);
+
+  bytes = g_bytes_new_take (serialised.data, serialised.size);
+  new = g_variant_ref_sink (g_variant_new_from_bytes (G_VARIANT_TYPE (g_variant_type_info_get_type_string (serialised.type_info)),
+                                                      bytes, TRUE));
+  g_bytes_unref (bytes);
+  g_variant_type_info_unref (serialised.type_info);
+
+  return new;
+}
+
 /**
  * g_variant_new_from_data:
  * @type: a definite #GVariantType
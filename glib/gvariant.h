@@ -254,6 +254,8 @@ GLIB_AVAILABLE_IN_ALL
 gboolean                        g_variant_is_normal_form                (GVariant             *value);
 GLIB_AVAILABLE_IN_ALL
 GVariant *                      g_variant_byteswap                      (GVariant             *value);
+GLIB_AVAILABLE_IN_2_82
+GVariant *                      g_variant_byteswap_take                 (GVariant             *value);
 
 GLIB_AVAILABLE_IN_2_36
 GVariant *                      g_variant_new_from_bytes                (const GVariantType   *type,
@@ -536,6 +538,27 @@ GVariantDict *                  g_variant_dict_ref                      (GVarian
 GLIB_AVAILABLE_IN_2_40
 void                            g_variant_dict_unref                    (GVariantDict         *dict);
 
+typedef struct _GVariantWriter GVariantWriter;
+
+GLIB_AVAILABLE_IN_2_82
+GVariantWriter *                g_variant_writer_new                    (const GVariantType   *type);
+GLIB_AVAILABLE_IN_2_82
+void                            g_variant_writer_free                   (GVariantWriter       *writer);
+GLIB_AVAILABLE_IN_2_82
+void                            g_variant_writer_open                   (GVariantWriter       *writer,
+                                                                         const GVariantType   *type);
+GLIB_AVAILABLE_IN_2_82
+void                            g_variant_writer_close                  (GVariantWriter       *writer);
+GLIB_AVAILABLE_IN_2_82
+void                            g_variant_writer_add_value              (GVariantWriter       *writer,
+                                                                         GVariant             *value);
+GLIB_AVAILABLE_IN_2_82
+void                            g_variant_writer_add                    (GVariantWriter       *writer,
+                                                                         const gchar          *format_string,
+                                                                         ...);
+GLIB_AVAILABLE_IN_2_82
+GVariant *                      g_variant_writer_end                    (GVariantWriter       *writer);
+
 G_END_DECLS
 
 #endif /* __G_VARIANT_H__ */
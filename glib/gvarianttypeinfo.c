@@ -30,7 +30,10 @@
 #include <glib/ghash.h>
 #include <glib/grefcount.h>
 
+#include <string.h>
+
 #include "glib_trace.h"
+#include "glib-private.h"
 
 /* < private >
  * GVariantTypeInfo:
@@ -737,9 +740,73 @@ g_variant_type_info_member_info (GVariantTypeInfo *info,
 }
 
 /* == new/ref/unref == */
-static GRecMutex g_variant_type_info_lock;
+
+/* Lookups only take read locks, which don’t contend between threads. The
+ * table is only changed, and containers are only freed, with the write
+ * lock held. */
+static GBigRWLock g_variant_type_info_lock;
 static GHashTable *g_variant_type_info_table;
 
+/* Infos of these common (mostly D-Bus) types are never freed once they
+ * have been created. The table holds an extra reference to them, so
+ * unreffing them never needs the lock, and they are looked up without
+ * any lock from g_variant_type_info_pinned. */
+#define PINNED_TYPE(s) { s, sizeof (s) - 1 }
+static const struct {
+  const gchar *type_string;
+  gsize length;
+} g_variant_type_info_pinned_types[] = {
+  PINNED_TYPE ("ay"),
+  PINNED_TYPE ("as"),
+  PINNED_TYPE ("ao"),
+  PINNED_TYPE ("av"),
+  PINNED_TYPE ("aay"),
+  PINNED_TYPE ("a{sv}"),
+  PINNED_TYPE ("{sv}"),
+  PINNED_TYPE ("a{ss}"),
+  PINNED_TYPE ("{ss}"),
+  PINNED_TYPE ("a{sa{sv}}"),
+  PINNED_TYPE ("{sa{sv}}"),
+  PINNED_TYPE ("a{oa{sa{sv}}}"),
+  PINNED_TYPE ("{oa{sa{sv}}}"),
+  PINNED_TYPE ("(a{sv})"),
+  PINNED_TYPE ("(sa{sv}as)"),
+};
+#undef PINNED_TYPE
+
+static GVariantTypeInfo *g_variant_type_info_pinned[G_N_ELEMENTS (g_variant_type_info_pinned_types)];  /* (atomic) */
+
+static gint
+g_variant_type_info_pinned_index (const gchar *type_string,
+                                  gsize        length)
+{
+  gsize i;
+
+  for (i = 0; i < G_N_ELEMENTS (g_variant_type_info_pinned_types); i++)
+    if (g_variant_type_info_pinned_types[i].length == length &&
+        memcmp (g_variant_type_info_pinned_types[i].type_string, type_string, length) == 0)
+      return i;
+
+  return -1;
+}
+
+static void
+container_info_free (GVariantTypeInfo *info)
+{
+  ContainerInfo *container = (ContainerInfo *) info;
+
+  g_free (container->type_string);
+
+  if (info->container_class == GV_ARRAY_INFO_CLASS)
+    array_info_free (info);
+
+  else if (info->container_class == GV_TUPLE_INFO_CLASS)
+    tuple_info_free (info);
+
+  else
+    g_assert_not_reached ();
+}
+
 /* < private >
  * g_variant_type_info_get:
  * @type: a #GVariantType
@@ -765,47 +832,106 @@ g_variant_type_info_get (const GVariantType *type)
       type_char == G_VARIANT_TYPE_INFO_CHAR_TUPLE ||
       type_char == G_VARIANT_TYPE_INFO_CHAR_DICT_ENTRY)
     {
-      GVariantTypeInfo *info;
+      GVariantTypeInfo *info = NULL;
+      ContainerInfo *container;
+      const gchar *type_peek;
+      gsize length;
+      gint pinned;
+      gchar stack_string[64];
       gchar *type_string;
 
-      type_string = g_variant_type_dup_string (type);
+      type_peek = g_variant_type_peek_string (type);
+      length = g_variant_type_get_string_length (type);
+
+      pinned = g_variant_type_info_pinned_index (type_peek, length);
+      if (pinned >= 0)
+        {
+          /* Pinned infos are never freed, so no lock is needed */
+          info = g_atomic_pointer_get (&g_variant_type_info_pinned[pinned]);
+          if (info != NULL)
+            return g_variant_type_info_ref (info);
+        }
+
+      /* Only allocate the type string if a new info is needed */
+      if (length < sizeof (stack_string))
+        type_string = stack_string;
+      else
+        type_string = g_malloc (length + 1);
+      memcpy (type_string, type_peek, length);
+      type_string[length] = '\0';
+
+      g_big_rw_lock_reader_lock (&g_variant_type_info_lock);
+
+      if (g_variant_type_info_table != NULL)
+        info = g_hash_table_lookup (g_variant_type_info_table, type_string);
+
+      /* The reference can’t drop to zero concurrently, as that only
+       * happens with the write lock held */
+      if (info != NULL)
+        g_variant_type_info_ref (info);
+
+      g_big_rw_lock_reader_unlock (&g_variant_type_info_lock);
+
+      if (info != NULL)
+        {
+          g_variant_type_info_check (info, 0);
+          if (type_string != stack_string)
+            g_free (type_string);
+
+          return info;
+        }
+
+      if (type_string == stack_string)
+        type_string = g_strdup (stack_string);
+
+      /* Build the info without holding the lock, as this looks up the
+       * infos of the member types */
+      if (type_char == G_VARIANT_TYPE_INFO_CHAR_MAYBE ||
+          type_char == G_VARIANT_TYPE_INFO_CHAR_ARRAY)
+        {
+          container = array_info_new (type);
+        }
+      else /* tuple or dict entry */
+        {
+          container = tuple_info_new (type);
+        }
 
-      g_rec_mutex_lock (&g_variant_type_info_lock);
+      container->type_string = type_string;
+      g_atomic_ref_count_init (&container->ref_count);
+
+      g_big_rw_lock_writer_lock (&g_variant_type_info_lock);
 
       if (g_variant_type_info_table == NULL)
         g_variant_type_info_table = g_hash_table_new (g_str_hash,
                                                       g_str_equal);
+
+      /* Another thread may have added it meanwhile */
       info = g_hash_table_lookup (g_variant_type_info_table, type_string);
 
       if (info == NULL)
         {
-          ContainerInfo *container;
-
-          if (type_char == G_VARIANT_TYPE_INFO_CHAR_MAYBE ||
-              type_char == G_VARIANT_TYPE_INFO_CHAR_ARRAY)
-            {
-              container = array_info_new (type);
-            }
-          else /* tuple or dict entry */
-            {
-              container = tuple_info_new (type);
-            }
-
           info = (GVariantTypeInfo *) container;
-          container->type_string = type_string;
-          g_atomic_ref_count_init (&container->ref_count);
+          container = NULL;
 
-          TRACE(GLIB_VARIANT_TYPE_INFO_NEW(info, container->type_string));
+          TRACE(GLIB_VARIANT_TYPE_INFO_NEW(info, type_string));
 
           g_hash_table_insert (g_variant_type_info_table, type_string, info);
-          type_string = NULL;
+
+          if (pinned >= 0)
+            {
+              g_variant_type_info_ref (info);
+              g_atomic_pointer_set (&g_variant_type_info_pinned[pinned], info);
+            }
         }
       else
         g_variant_type_info_ref (info);
 
-      g_rec_mutex_unlock (&g_variant_type_info_lock);
+      g_big_rw_lock_writer_unlock (&g_variant_type_info_lock);
+
+      if (container != NULL)
+        container_info_free ((GVariantTypeInfo *) container);
+
       g_variant_type_info_check (info, 0);
-      g_free (type_string);
 
       return info;
     }
@@ -864,8 +990,19 @@ g_variant_type_info_unref (GVariantTypeInfo *info)
   if (info->container_class)
     {
       ContainerInfo *container = (ContainerInfo *) info;
+      gint ref_count;
+
+      /* Dropping a reference which is not the last one needs no lock */
+      ref_count = g_atomic_int_get (&container->ref_count);
+      while (ref_count > 1)
+        {
+          if (g_atomic_int_compare_and_exchange_full (&container->ref_count,
+                                                      ref_count, ref_count - 1,
+                                                      &ref_count))
+            return;
+        }
 
-      g_rec_mutex_lock (&g_variant_type_info_lock);
+      g_big_rw_lock_writer_lock (&g_variant_type_info_lock);
       if (g_atomic_ref_count_dec (&container->ref_count))
         {
 
@@ -878,26 +1015,72 @@ g_variant_type_info_unref (GVariantTypeInfo *info)
               g_hash_table_unref (g_variant_type_info_table);
               g_variant_type_info_table = NULL;
             }
-          g_rec_mutex_unlock (&g_variant_type_info_lock);
-
-          g_free (container->type_string);
-
-          if (info->container_class == GV_ARRAY_INFO_CLASS)
-            array_info_free (info);
+          g_big_rw_lock_writer_unlock (&g_variant_type_info_lock);
 
-          else if (info->container_class == GV_TUPLE_INFO_CLASS)
-            tuple_info_free (info);
-
-          else
-            g_assert_not_reached ();
+          container_info_free (info);
         }
       else
-        g_rec_mutex_unlock (&g_variant_type_info_lock);
+        g_big_rw_lock_writer_unlock (&g_variant_type_info_lock);
     }
 }
 
+static void
+g_variant_type_info_count_member_ref (GHashTable       *member_refs,
+                                      GVariantTypeInfo *member)
+{
+  if (member->container_class)
+    g_hash_table_insert (member_refs, member,
+                         GUINT_TO_POINTER (GPOINTER_TO_UINT (g_hash_table_lookup (member_refs, member)) + 1));
+}
+
 void
 g_variant_type_info_assert_no_infos (void)
 {
-  g_assert (g_variant_type_info_table == NULL);
+  GHashTable *member_refs;
+  GHashTableIter iter;
+  gpointer value;
+
+  if (g_variant_type_info_table == NULL)
+    return;
+
+  /* Only pinned infos are left.  Each is referenced by the table, and
+   * once more by every remaining (so pinned) container which has it as
+   * a member, such as ‘a{sv}’ holding ‘{sv}’. */
+  member_refs = g_hash_table_new (NULL, NULL);
+
+  g_hash_table_iter_init (&iter, g_variant_type_info_table);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      GVariantTypeInfo *info = value;
+
+      if (info->container_class == GV_ARRAY_INFO_CLASS)
+        g_variant_type_info_count_member_ref (member_refs,
+                                              GV_ARRAY_INFO (info)->element);
+      else
+        {
+          TupleInfo *tuple_info = GV_TUPLE_INFO (info);
+          gsize i;
+
+          for (i = 0; i < tuple_info->n_members; i++)
+            g_variant_type_info_count_member_ref (member_refs,
+                                                  tuple_info->members[i].type_info);
+        }
+    }
+
+  g_hash_table_iter_init (&iter, g_variant_type_info_table);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      ContainerInfo *container = value;
+      gint pinned;
+      guint expected;
+
+      pinned = g_variant_type_info_pinned_index (container->type_string,
+                                                 strlen (container->type_string));
+      g_assert_cmpint (pinned, >=, 0);
+
+      expected = 1 + GPOINTER_TO_UINT (g_hash_table_lookup (member_refs, container));
+      g_assert_cmpint (g_atomic_int_get ((gint *) &container->ref_count), ==, expected);
+    }
+
+  g_hash_table_unref (member_refs);
 }
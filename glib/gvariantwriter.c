@@ -0,0 +1,654 @@
+/*
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include <glib/gvariant-core.h>
+#include <glib/gvarianttypeinfo.h>
+#include <glib/garray.h>
+#include <glib/gbytes.h>
+#include <glib/gmessages.h>
+#include <glib/gtestutils.h>
+#include <glib/gunicode.h>
+
+#include <string.h>
+
+/**
+ * GVariantWriter:
+ *
+ * A utility type for constructing container-type [struct@GLib.Variant]
+ * instances by serialising them directly into one buffer.
+ *
+ * [struct@GLib.VariantBuilder] keeps every child as a separate `GVariant`
+ * and only serialises the whole tree in [method@GLib.VariantBuilder.end].
+ * For large values, such as big `a{sv}` dictionaries, that means many small
+ * allocations and holding the data twice. A `GVariantWriter` instead
+ * appends each value to the serialised data of its container as it is
+ * added, and computes the framing offsets of each container when it is
+ * closed. [method@GLib.VariantWriter.end] then wraps the buffer with
+ * [ctor@GLib.Variant.new_from_bytes], without copying it, and
+ * [method@GLib.Variant.get_data_as_bytes] gives the buffer back, again
+ * without copying.
+ *
+ * The API follows `GVariantBuilder`, with one restriction: all container
+ * types must be definite, since the serialised layout depends on them.
+ *
+ * ```c
+ * GVariantWriter *writer;
+ * GVariant *value;
+ *
+ * writer = g_variant_writer_new (G_VARIANT_TYPE_VARDICT);
+ *
+ * g_variant_writer_open (writer, G_VARIANT_TYPE ("{sv}"));
+ * g_variant_writer_add (writer, "s", "width");
+ * g_variant_writer_open (writer, G_VARIANT_TYPE_VARIANT);
+ * g_variant_writer_add (writer, "u", 800);
+ * g_variant_writer_close (writer);
+ * g_variant_writer_close (writer);
+ *
+ * value = g_variant_writer_end (writer);
+ * g_variant_writer_free (writer);
+ * ```
+ *
+ * Since: 2.82
+ */
+
+typedef struct
+{
+  GVariantTypeInfo *type_info;
+  gsize start;
+  gsize n_children;
+  GArray *offsets;  /* (nullable) framing offsets relative to @start */
+  GVariantTypeInfo *child_info;  /* (nullable) type of the child of a variant */
+} GVariantWriterFrame;
+
+struct _GVariantWriter
+{
+  GByteArray *data;  /* (nullable) after g_variant_writer_end() */
+  GArray *frames;
+  GVariantType *type;
+  gboolean trusted;
+};
+
+/* Same as gvs_get_offset_size() and gvs_calculate_total_size() in
+ * gvariant-serialiser.c */
+static guint
+writer_get_offset_size (gsize size)
+{
+  if (size > G_MAXUINT32)
+    return 8;
+  else if (size > G_MAXUINT16)
+    return 4;
+  else if (size > G_MAXUINT8)
+    return 2;
+  else if (size > 0)
+    return 1;
+
+  return 0;
+}
+
+static gsize
+writer_calculate_total_size (gsize body_size,
+                             gsize offsets)
+{
+  if (body_size + 1 * offsets <= G_MAXUINT8)
+    return body_size + 1 * offsets;
+
+  if (body_size + 2 * offsets <= G_MAXUINT16)
+    return body_size + 2 * offsets;
+
+  if (body_size + 4 * offsets <= G_MAXUINT32)
+    return body_size + 4 * offsets;
+
+  return body_size + 8 * offsets;
+}
+
+static inline GVariantWriterFrame *
+writer_top (GVariantWriter *writer)
+{
+  return &g_array_index (writer->frames, GVariantWriterFrame, writer->frames->len - 1);
+}
+
+static inline guint8 *
+writer_grow (GVariantWriter *writer,
+             gsize           size)
+{
+  gsize old_len = writer->data->len;
+
+  g_byte_array_set_size (writer->data, old_len + size);
+
+  return writer->data->data + old_len;
+}
+
+/* The buffer is allocated with malloc(), so it is aligned for any
+ * GVariant, and every container starts at an offset aligned for all its
+ * children. So aligning absolute offsets is the same as aligning them
+ * relative to the container. */
+static void
+writer_pad (GVariantWriter *writer,
+            guint           alignment)
+{
+  gsize padding = (-writer->data->len) & alignment;
+
+  if (padding)
+    memset (writer_grow (writer, padding), 0, padding);
+}
+
+static gboolean
+writer_begin_child (GVariantWriter   *writer,
+                    GVariantTypeInfo *child_info)
+{
+  GVariantWriterFrame *frame = writer_top (writer);
+  GVariantTypeInfo *expected = NULL;
+  gboolean ok;
+  guint alignment;
+
+  switch (g_variant_type_info_get_type_char (frame->type_info))
+    {
+    case G_VARIANT_TYPE_INFO_CHAR_VARIANT:
+      ok = frame->n_children == 0;
+      break;
+
+    case G_VARIANT_TYPE_INFO_CHAR_MAYBE:
+      expected = g_variant_type_info_element (frame->type_info);
+      ok = frame->n_children == 0 && child_info == expected;
+      break;
+
+    case G_VARIANT_TYPE_INFO_CHAR_ARRAY:
+      expected = g_variant_type_info_element (frame->type_info);
+      ok = child_info == expected;
+      break;
+
+    default:
+      if (frame->n_children < g_variant_type_info_n_members (frame->type_info))
+        {
+          expected = g_variant_type_info_member_info (frame->type_info, frame->n_children)->type_info;
+          ok = child_info == expected;
+        }
+      else
+        ok = FALSE;
+      break;
+    }
+
+  if (!ok)
+    {
+      g_critical ("g_variant_writer: can not add a value of type '%s' to a "
+                  "container of type '%s' here (expected %s%s%s)",
+                  g_variant_type_info_get_type_string (child_info),
+                  g_variant_type_info_get_type_string (frame->type_info),
+                  expected ? "'" : "no more values",
+                  expected ? g_variant_type_info_get_type_string (expected) : "",
+                  expected ? "'" : "");
+      return FALSE;
+    }
+
+  g_variant_type_info_query (child_info, &alignment, NULL);
+  writer_pad (writer, alignment);
+
+  return TRUE;
+}
+
+static void
+writer_add_offset (GVariantWriterFrame *frame,
+                   gsize                end)
+{
+  if (frame->offsets == NULL)
+    frame->offsets = g_array_new (FALSE, FALSE, sizeof (gsize));
+
+  g_array_append_val (frame->offsets, end);
+}
+
+static void
+writer_end_child (GVariantWriter   *writer,
+                  GVariantTypeInfo *child_info)
+{
+  GVariantWriterFrame *frame = writer_top (writer);
+  gsize end = writer->data->len - frame->start;
+  gsize fixed_size;
+
+  switch (g_variant_type_info_get_type_char (frame->type_info))
+    {
+    case G_VARIANT_TYPE_INFO_CHAR_VARIANT:
+      frame->child_info = g_variant_type_info_ref (child_info);
+      break;
+
+    case G_VARIANT_TYPE_INFO_CHAR_MAYBE:
+      break;
+
+    case G_VARIANT_TYPE_INFO_CHAR_ARRAY:
+      g_variant_type_info_query_element (frame->type_info, NULL, &fixed_size);
+      if (fixed_size == 0)
+        writer_add_offset (frame, end);
+      break;
+
+    default:
+      if (g_variant_type_info_member_info (frame->type_info, frame->n_children)->ending_type ==
+          G_VARIANT_MEMBER_ENDING_OFFSET)
+        writer_add_offset (frame, end);
+      break;
+    }
+
+  frame->n_children++;
+}
+
+/* Appends the framing offsets of @frame, in reverse order for tuples */
+static void
+writer_append_offsets (GVariantWriter      *writer,
+                       GVariantWriterFrame *frame,
+                       gboolean             reverse)
+{
+  gsize n_offsets, i;
+  guint offset_size;
+  guint8 *p;
+
+  if (frame->offsets == NULL || frame->offsets->len == 0)
+    return;
+
+  n_offsets = frame->offsets->len;
+  offset_size = writer_get_offset_size (writer_calculate_total_size (writer->data->len - frame->start,
+                                                                      n_offsets));
+  p = writer_grow (writer, n_offsets * offset_size);
+
+  for (i = 0; i < n_offsets; i++)
+    {
+      gsize offset = g_array_index (frame->offsets, gsize, reverse ? n_offsets - 1 - i : i);
+      guint j;
+
+      /* Little endian, as in gvs_write_unaligned_le() */
+      for (j = 0; j < offset_size; j++)
+        {
+          *p++ = offset & 0xff;
+          offset >>= 8;
+        }
+    }
+}
+
+static gboolean
+writer_finish_frame (GVariantWriter      *writer,
+                     GVariantWriterFrame *frame)
+{
+  gsize fixed_size;
+  const gchar *type_string;
+
+  switch (g_variant_type_info_get_type_char (frame->type_info))
+    {
+    case G_VARIANT_TYPE_INFO_CHAR_VARIANT:
+      if (frame->n_children != 1)
+        {
+          g_critical ("g_variant_writer: a variant must contain exactly one value");
+          return FALSE;
+        }
+      type_string = g_variant_type_info_get_type_string (frame->child_info);
+      *writer_grow (writer, 1) = '\0';
+      memcpy (writer_grow (writer, strlen (type_string)), type_string, strlen (type_string));
+      break;
+
+    case G_VARIANT_TYPE_INFO_CHAR_MAYBE:
+      g_variant_type_info_query_element (frame->type_info, NULL, &fixed_size);
+      if (frame->n_children && fixed_size == 0)
+        *writer_grow (writer, 1) = '\0';
+      break;
+
+    case G_VARIANT_TYPE_INFO_CHAR_ARRAY:
+      writer_append_offsets (writer, frame, FALSE);
+      break;
+
+    default:
+      if (frame->n_children != g_variant_type_info_n_members (frame->type_info))
+        {
+          g_critical ("g_variant_writer: a tuple of type '%s' must have %" G_GSIZE_FORMAT
+                      " values, but only %" G_GSIZE_FORMAT " were added",
+                      g_variant_type_info_get_type_string (frame->type_info),
+                      g_variant_type_info_n_members (frame->type_info),
+                      frame->n_children);
+          return FALSE;
+        }
+
+      g_variant_type_info_query (frame->type_info, NULL, &fixed_size);
+      if (fixed_size)
+        {
+          gsize size = writer->data->len - frame->start;
+
+          /* Padding at the end, and the zero byte of the unit tuple */
+          if (size < fixed_size)
+            memset (writer_grow (writer, fixed_size - size), 0, fixed_size - size);
+        }
+      else
+        writer_append_offsets (writer, frame, TRUE);
+      break;
+    }
+
+  return TRUE;
+}
+
+static void
+writer_frame_clear (GVariantWriterFrame *frame)
+{
+  g_clear_pointer (&frame->type_info, g_variant_type_info_unref);
+  g_clear_pointer (&frame->child_info, g_variant_type_info_unref);
+  g_clear_pointer (&frame->offsets, g_array_unref);
+}
+
+static void
+writer_push_frame (GVariantWriter   *writer,
+                   GVariantTypeInfo *type_info)
+{
+  GVariantWriterFrame frame = { 0, };
+
+  frame.type_info = type_info;
+  frame.start = writer->data->len;
+  g_array_append_val (writer->frames, frame);
+}
+
+/**
+ * g_variant_writer_new:
+ * @type: a definite container type
+ *
+ * Creates a new #GVariantWriter for a value of @type.
+ *
+ * Unlike with [ctor@GLib.VariantBuilder.new], @type must be definite.
+ *
+ * Returns: (transfer full): a new #GVariantWriter
+ *
+ * Since: 2.82
+ */
+GVariantWriter *
+g_variant_writer_new (const GVariantType *type)
+{
+  GVariantWriter *writer;
+
+  g_return_val_if_fail (g_variant_type_is_definite (type), NULL);
+  g_return_val_if_fail (g_variant_type_is_container (type), NULL);
+
+  writer = g_new0 (GVariantWriter, 1);
+  writer->data = g_byte_array_new ();
+  writer->frames = g_array_new (FALSE, FALSE, sizeof (GVariantWriterFrame));
+  writer->type = g_variant_type_copy (type);
+  writer->trusted = TRUE;
+
+  writer_push_frame (writer, g_variant_type_info_get (type));
+
+  return writer;
+}
+
+/**
+ * g_variant_writer_free:
+ * @writer: (transfer full): a #GVariantWriter
+ *
+ * Frees @writer, and any data written to it if
+ * [method@GLib.VariantWriter.end] was not called.
+ *
+ * Since: 2.82
+ */
+void
+g_variant_writer_free (GVariantWriter *writer)
+{
+  guint i;
+
+  g_return_if_fail (writer != NULL);
+
+  for (i = 0; i < writer->frames->len; i++)
+    writer_frame_clear (&g_array_index (writer->frames, GVariantWriterFrame, i));
+  g_array_unref (writer->frames);
+  if (writer->data)
+    g_byte_array_unref (writer->data);
+  g_variant_type_free (writer->type);
+  g_free (writer);
+}
+
+/**
+ * g_variant_writer_open:
+ * @writer: a #GVariantWriter
+ * @type: the definite type of the container to open
+ *
+ * Opens a container of @type as the next value of the current container.
+ * Values added after this go into the new container, until it is closed
+ * with [method@GLib.VariantWriter.close].
+ *
+ * To write the value of a variant, open a container of type
+ * %G_VARIANT_TYPE_VARIANT, add one value of any type and close it again.
+ *
+ * Since: 2.82
+ */
+void
+g_variant_writer_open (GVariantWriter     *writer,
+                       const GVariantType *type)
+{
+  GVariantTypeInfo *type_info;
+
+  g_return_if_fail (writer != NULL && writer->data != NULL);
+  g_return_if_fail (g_variant_type_is_definite (type));
+  g_return_if_fail (g_variant_type_is_container (type));
+
+  type_info = g_variant_type_info_get (type);
+  if (!writer_begin_child (writer, type_info))
+    {
+      g_variant_type_info_unref (type_info);
+      return;
+    }
+
+  writer_push_frame (writer, type_info);
+}
+
+/**
+ * g_variant_writer_close:
+ * @writer: a #GVariantWriter
+ *
+ * Closes the container opened last with [method@GLib.VariantWriter.open].
+ *
+ * Since: 2.82
+ */
+void
+g_variant_writer_close (GVariantWriter *writer)
+{
+  GVariantWriterFrame *frame;
+  GVariantTypeInfo *type_info;
+
+  g_return_if_fail (writer != NULL && writer->data != NULL);
+  g_return_if_fail (writer->frames->len > 1);
+
+  frame = writer_top (writer);
+  if (!writer_finish_frame (writer, frame))
+    return;
+
+  type_info = g_steal_pointer (&frame->type_info);
+  writer_frame_clear (frame);
+  g_array_set_size (writer->frames, writer->frames->len - 1);
+
+  writer_end_child (writer, type_info);
+  g_variant_type_info_unref (type_info);
+}
+
+/**
+ * g_variant_writer_add_value:
+ * @writer: a #GVariantWriter
+ * @value: a #GVariant
+ *
+ * Appends the serialised data of @value to the current container.
+ *
+ * If @value is a floating reference, it is consumed.
+ *
+ * Since: 2.82
+ */
+void
+g_variant_writer_add_value (GVariantWriter *writer,
+                            GVariant       *value)
+{
+  GVariantTypeInfo *type_info;
+
+  g_return_if_fail (writer != NULL && writer->data != NULL);
+  g_return_if_fail (value != NULL);
+
+  g_variant_ref_sink (value);
+
+  type_info = g_variant_get_type_info (value);
+  if (writer_begin_child (writer, type_info))
+    {
+      g_variant_store (value, writer_grow (writer, g_variant_get_size (value)));
+      writer->trusted &= g_variant_is_trusted (value);
+      writer_end_child (writer, type_info);
+    }
+
+  g_variant_unref (value);
+}
+
+/* Writes basic values directly, returns %FALSE if @format_string is
+ * not a single basic type */
+static gboolean
+writer_add_basic (GVariantWriter *writer,
+                  const gchar    *format_string,
+                  va_list        *ap)
+{
+  GVariantTypeInfo *type_info;
+  const gchar *string = NULL;
+  union {
+    guint8 u8;
+    guint16 u16;
+    guint32 u32;
+    guint64 u64;
+    gdouble dbl;
+  } number;
+  gsize size;
+
+  if (format_string[0] == '\0' || format_string[1] != '\0')
+    return FALSE;
+
+  switch (format_string[0])
+    {
+    case 'b':
+      number.u8 = va_arg (*ap, gboolean) ? TRUE : FALSE;
+      size = 1;
+      break;
+    case 'y':
+      number.u8 = (guint8) va_arg (*ap, guint);
+      size = 1;
+      break;
+    case 'n':
+    case 'q':
+      number.u16 = (guint16) va_arg (*ap, guint);
+      size = 2;
+      break;
+    case 'i':
+    case 'u':
+    case 'h':
+      number.u32 = va_arg (*ap, guint32);
+      size = 4;
+      break;
+    case 'x':
+    case 't':
+      number.u64 = va_arg (*ap, guint64);
+      size = 8;
+      break;
+    case 'd':
+      number.dbl = va_arg (*ap, gdouble);
+      size = 8;
+      break;
+    case 's':
+    case 'o':
+    case 'g':
+      string = va_arg (*ap, const gchar *);
+      g_return_val_if_fail (string != NULL, TRUE);
+      g_return_val_if_fail (format_string[0] != 's' || g_utf8_validate (string, -1, NULL), TRUE);
+      g_return_val_if_fail (format_string[0] != 'o' || g_variant_is_object_path (string), TRUE);
+      g_return_val_if_fail (format_string[0] != 'g' || g_variant_is_signature (string), TRUE);
+      size = strlen (string) + 1;
+      break;
+    default:
+      return FALSE;
+    }
+
+  type_info = g_variant_type_info_get (G_VARIANT_TYPE (format_string));
+  if (writer_begin_child (writer, type_info))
+    {
+      memcpy (writer_grow (writer, size), string ? (gconstpointer) string : (gconstpointer) &number, size);
+      writer_end_child (writer, type_info);
+    }
+  g_variant_type_info_unref (type_info);
+
+  return TRUE;
+}
+
+/**
+ * g_variant_writer_add:
+ * @writer: a #GVariantWriter
+ * @format_string: a [GVariant format string](gvariant-format-strings.html)
+ * @...: arguments, as per @format_string
+ *
+ * Adds a value to the current container, like
+ * [method@GLib.VariantBuilder.add] does.
+ *
+ * Values of a single basic type, such as `"s"` or `"u"`, are written
+ * directly. Anything else is first constructed with [ctor@GLib.Variant.new];
+ * to avoid that for containers, use [method@GLib.VariantWriter.open].
+ *
+ * Since: 2.82
+ */
+void
+g_variant_writer_add (GVariantWriter *writer,
+                      const gchar    *format_string,
+                      ...)
+{
+  va_list ap;
+
+  g_return_if_fail (writer != NULL && writer->data != NULL);
+  g_return_if_fail (format_string != NULL);
+
+  va_start (ap, format_string);
+  if (!writer_add_basic (writer, format_string, &ap))
+    g_variant_writer_add_value (writer, g_variant_new_va (format_string, NULL, &ap));
+  va_end (ap);
+}
+
+/**
+ * g_variant_writer_end:
+ * @writer: a #GVariantWriter
+ *
+ * Finishes the value written by @writer, which must not have any open
+ * containers left.
+ *
+ * The returned value uses the buffer @writer wrote to, without copying
+ * it. Nothing can be added to @writer after this, it can only be freed.
+ *
+ * Returns: (transfer none): a new, floating #GVariant, or %NULL if the
+ *   value is incomplete
+ *
+ * Since: 2.82
+ */
+GVariant *
+g_variant_writer_end (GVariantWriter *writer)
+{
+  GBytes *bytes;
+  GVariant *value;
+
+  g_return_val_if_fail (writer != NULL && writer->data != NULL, NULL);
+
+  if (writer->frames->len != 1)
+    {
+      g_critical ("g_variant_writer_end: %u containers were not closed",
+                  writer->frames->len - 1);
+      return NULL;
+    }
+
+  if (!writer_finish_frame (writer, writer_top (writer)))
+    return NULL;
+
+  bytes = g_byte_array_free_to_bytes (g_steal_pointer (&writer->data));
+  value = g_variant_new_from_bytes (writer->type, bytes, writer->trusted);
+  g_bytes_unref (bytes);
+
+  return value;
+}
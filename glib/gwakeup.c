@@ -29,6 +29,7 @@
  * (and at all other use sites).
  */
 #ifdef GLIB_COMPILATION
+#include "gatomic.h"
 #include "gtypes.h"
 #include "gpoll.h"
 #else
@@ -120,6 +121,7 @@ g_wakeup_free (GWakeup *wakeup)
 struct _GWakeup
 {
   gint fds[2];
+  gint signalled;  /* (atomic) whether a signal is pending on the fd */
 };
 
 /*< private >
@@ -140,6 +142,7 @@ g_wakeup_new (void)
   GWakeup *wakeup;
 
   wakeup = g_slice_new (GWakeup);
+  wakeup->signalled = FALSE;
 
   /* try eventfd first, if we think we can */
 #if defined (HAVE_EVENTFD)
@@ -225,6 +228,11 @@ g_wakeup_acknowledge (GWakeup *wakeup)
         res = read (wakeup->fds[0], &value, sizeof (value));
       while (res == sizeof (value) || G_UNLIKELY (res == -1 && errno == EINTR));
     }
+
+  /* Only after draining: a g_wakeup_signal() racing with this either writes
+   * to the fd again, or is skipped before the caller looks at whatever it
+   * was woken up for. */
+  g_atomic_int_set (&wakeup->signalled, FALSE);
 }
 
 /*< private >
@@ -239,6 +247,9 @@ g_wakeup_acknowledge (GWakeup *wakeup)
  *
  * This function is safe to call from a UNIX signal handler.
  *
+ * Signalling a #GWakeup which is already signalled does nothing, so
+ * repeated signals before g_wakeup_acknowledge() don’t cost a system call.
+ *
  * Since: 2.30
  **/
 void
@@ -246,6 +257,9 @@ g_wakeup_signal (GWakeup *wakeup)
 {
   int res;
 
+  if (!g_atomic_int_compare_and_exchange (&wakeup->signalled, FALSE, TRUE))
+    return;
+
   if (wakeup->fds[1] == -1)
     {
       uint64_t one = 1;
@@ -843,6 +843,188 @@ array_sort_with_data (gconstpointer test_data)
   g_array_free (garray, TRUE);
 }
 
+typedef struct
+{
+  gint key;
+  guint seq;
+} KeyedItem;
+
+static gint
+keyed_item_compare (gconstpointer p1, gconstpointer p2, gpointer data)
+{
+  const KeyedItem *a = p1;
+  const KeyedItem *b = p2;
+
+  g_atomic_int_inc ((gint *) data);
+
+  return (a->key > b->key) - (a->key < b->key);
+}
+
+/* Check that g_array_sort_parallel() sorts stably, however the input is
+ * ordered. */
+static void
+array_sort_parallel (void)
+{
+  const guint n = 300000;
+  GArray *garray;
+  gint n_compares;
+  guint i, order;
+
+  garray = g_array_new (FALSE, FALSE, sizeof (KeyedItem));
+
+  g_array_sort_parallel (garray, keyed_item_compare, &n_compares);
+
+  for (order = 0; order < 3; order++)
+    {
+      g_array_set_size (garray, 0);
+      for (i = 0; i < n; i++)
+        {
+          KeyedItem item;
+
+          item.key = (order == 0) ? g_random_int_range (0, 100) :
+                     (order == 1) ? (gint) (i / 7) : (gint) ((n - i) / 7);
+          item.seq = i;
+          g_array_append_val (garray, item);
+        }
+
+      n_compares = 0;
+      g_array_sort_parallel (garray, keyed_item_compare, &n_compares);
+      g_assert_cmpuint (garray->len, ==, n);
+
+      for (i = 1; i < n; i++)
+        {
+          const KeyedItem *prev = &g_array_index (garray, KeyedItem, i - 1);
+          const KeyedItem *cur = &g_array_index (garray, KeyedItem, i);
+
+          g_assert_cmpint (prev->key, <=, cur->key);
+          if (prev->key == cur->key)
+            g_assert_cmpuint (prev->seq, <, cur->seq);
+        }
+
+      /* Already sorted input needs about one comparison per element */
+      if (order == 1)
+        g_assert_cmpint (n_compares, <, 2 * n);
+    }
+
+  g_array_free (garray, TRUE);
+}
+
+#define ARRAY_SORT_INTEGERS_TYPE(type, is_signed) \
+  G_STMT_START { \
+    GArray *garray = g_array_new (FALSE, FALSE, sizeof (type)); \
+    GArray *expected = g_array_new (FALSE, FALSE, sizeof (type)); \
+    guint n; \
+    for (n = 0; n < 5000; n += (n < 100) ? 1 : 997) \
+      { \
+        guint i; \
+        g_array_set_size (garray, 0); \
+        for (i = 0; i < n; i++) \
+          { \
+            type v = (type) (((guint64) g_random_int () << 32) | g_random_int ()); \
+            if (i % 3 == 0) \
+              v = (type) (i % 17); \
+            g_array_append_val (garray, v); \
+          } \
+        g_array_set_size (expected, 0); \
+        g_array_append_vals (expected, garray->data, garray->len); \
+        g_array_sort (expected, is_signed ? compare_signed_##type : compare_unsigned_##type); \
+        g_array_sort_integers (garray, is_signed); \
+        g_assert_cmpmem (garray->data, garray->len * sizeof (type), \
+                         expected->data, expected->len * sizeof (type)); \
+      } \
+    g_array_free (expected, TRUE); \
+    g_array_free (garray, TRUE); \
+  } G_STMT_END
+
+#define DEFINE_INTEGER_COMPARE(type, utype, stype) \
+  static gint \
+  compare_unsigned_##type (gconstpointer p1, gconstpointer p2) \
+  { \
+    utype a = *(const utype *) p1, b = *(const utype *) p2; \
+    return (a > b) - (a < b); \
+  } \
+  static gint \
+  compare_signed_##type (gconstpointer p1, gconstpointer p2) \
+  { \
+    stype a = *(const stype *) p1, b = *(const stype *) p2; \
+    return (a > b) - (a < b); \
+  }
+
+DEFINE_INTEGER_COMPARE (guint8, guint8, gint8)
+DEFINE_INTEGER_COMPARE (guint16, guint16, gint16)
+DEFINE_INTEGER_COMPARE (guint32, guint32, gint32)
+DEFINE_INTEGER_COMPARE (guint64, guint64, gint64)
+
+/* Check that g_array_sort_integers() agrees with a comparison sort. */
+static void
+array_sort_integers (void)
+{
+  ARRAY_SORT_INTEGERS_TYPE (guint8, FALSE);
+  ARRAY_SORT_INTEGERS_TYPE (guint8, TRUE);
+  ARRAY_SORT_INTEGERS_TYPE (guint16, FALSE);
+  ARRAY_SORT_INTEGERS_TYPE (guint16, TRUE);
+  ARRAY_SORT_INTEGERS_TYPE (guint32, FALSE);
+  ARRAY_SORT_INTEGERS_TYPE (guint32, TRUE);
+  ARRAY_SORT_INTEGERS_TYPE (guint64, FALSE);
+  ARRAY_SORT_INTEGERS_TYPE (guint64, TRUE);
+}
+
+#define ARRAY_BINARY_SEARCH_INTEGERS_TYPE(type, is_signed) \
+  G_STMT_START { \
+    GArray *garray = g_array_new (FALSE, FALSE, sizeof (type)); \
+    GCompareFunc compare = is_signed ? compare_signed_##type : compare_unsigned_##type; \
+    guint n; \
+    for (n = 0; n < 3000; n += (n < 40) ? 1 : 743) \
+      { \
+        guint i, j; \
+        g_array_set_size (garray, 0); \
+        for (i = 0; i < n; i++) \
+          { \
+            type v = (type) (((guint64) g_random_int () << 32) | g_random_int ()); \
+            if (i % 2 == 0) \
+              v = (type) (i % 7); \
+            g_array_append_val (garray, v); \
+          } \
+        g_array_sort_integers (garray, is_signed); \
+        for (i = 0; i < n + 10; i++) \
+          { \
+            type target = (i < n) ? g_array_index (garray, type, i) : (type) (i - n + 3); \
+            guint expected_index = 0, index = G_MAXUINT, compare_index = G_MAXUINT; \
+            gboolean expected = FALSE; \
+            for (j = 0; j < n; j++) \
+              if (g_array_index (garray, type, j) == target) \
+                { \
+                  expected = TRUE; \
+                  expected_index = j; \
+                  break; \
+                } \
+            g_assert_cmpint (g_array_binary_search_integers (garray, &target, is_signed, &index), ==, expected); \
+            g_assert_cmpint (g_array_binary_search (garray, &target, compare, &compare_index), ==, expected); \
+            if (expected) \
+              { \
+                g_assert_cmpuint (index, ==, expected_index); \
+                g_assert_cmpuint (compare_index, ==, expected_index); \
+              } \
+          } \
+      } \
+    g_array_free (garray, TRUE); \
+  } G_STMT_END
+
+/* Check that g_array_binary_search_integers() and g_array_binary_search()
+ * find the first instance of each element, and nothing else. */
+static void
+array_binary_search_integers (void)
+{
+  ARRAY_BINARY_SEARCH_INTEGERS_TYPE (guint8, FALSE);
+  ARRAY_BINARY_SEARCH_INTEGERS_TYPE (guint8, TRUE);
+  ARRAY_BINARY_SEARCH_INTEGERS_TYPE (guint16, FALSE);
+  ARRAY_BINARY_SEARCH_INTEGERS_TYPE (guint16, TRUE);
+  ARRAY_BINARY_SEARCH_INTEGERS_TYPE (guint32, FALSE);
+  ARRAY_BINARY_SEARCH_INTEGERS_TYPE (guint32, TRUE);
+  ARRAY_BINARY_SEARCH_INTEGERS_TYPE (guint64, FALSE);
+  ARRAY_BINARY_SEARCH_INTEGERS_TYPE (guint64, TRUE);
+}
+
 static gint num_clear_func_invocations = 0;
 
 static void
@@ -2284,6 +2466,34 @@ ptr_compare_data (gconstpointer p1, gconstpointer p2, gpointer data)
   return ptr_compare_values_data (i1, i2, data);
 }
 
+static void
+pointer_array_sort_parallel (void)
+{
+  GPtrArray *gparray;
+  gint i;
+  gint prev, cur;
+
+  gparray = g_ptr_array_new ();
+
+  /* Sort empty array */
+  g_ptr_array_sort_parallel (gparray, ptr_compare_data, NULL);
+
+  for (i = 0; i < 200000; i++)
+    g_ptr_array_add (gparray, GINT_TO_POINTER (g_random_int_range (0, 100000)));
+
+  g_ptr_array_sort_parallel (gparray, ptr_compare_data, NULL);
+
+  prev = -1;
+  for (i = 0; i < 200000; i++)
+    {
+      cur = GPOINTER_TO_INT (g_ptr_array_index (gparray, i));
+      g_assert_cmpint (prev, <=, cur);
+      prev = cur;
+    }
+
+  g_ptr_array_free (gparray, TRUE);
+}
+
 static void
 pointer_array_sort (void)
 {
@@ -2739,6 +2949,102 @@ pointer_array_find_non_empty (void)
   g_ptr_array_free (array, TRUE);
 }
 
+/* g_ptr_array_find() compares blocks of pointers at once, so check matches
+ * at every position in and around such blocks */
+static void
+pointer_array_find_large (void)
+{
+  GPtrArray *array = g_ptr_array_new ();
+  gchar *buffer = g_malloc (200);
+  guint i, j, idx;
+
+  for (i = 0; i < 100; i++)
+    {
+      g_ptr_array_set_size (array, 0);
+      for (j = 0; j < i; j++)
+        g_ptr_array_add (array, buffer + 100 + j);
+
+      for (j = 0; j < i; j++)
+        {
+          gpointer saved = array->pdata[j];
+
+          array->pdata[j] = buffer;
+          g_assert_true (g_ptr_array_find (array, buffer, &idx));
+          g_assert_cmpuint (idx, ==, j);
+          g_assert_true (g_ptr_array_find_with_equal_func (array, buffer, g_direct_equal, &idx));
+          g_assert_cmpuint (idx, ==, j);
+          array->pdata[j] = saved;
+        }
+
+      g_assert_false (g_ptr_array_find (array, buffer, NULL));
+      g_assert_false (g_ptr_array_find (array, buffer + 100 + i, NULL));
+    }
+
+  g_ptr_array_unref (array);
+  g_free (buffer);
+}
+
+static void
+count_free_func (gpointer data)
+{
+  num_free_func_invocations++;
+}
+
+static void
+pointer_array_remove_fast_many (gconstpointer test_data)
+{
+  gboolean null_terminated = GPOINTER_TO_INT (test_data);
+  gpointer to_remove[30];
+  guint n_to_remove;
+
+  /* Both with few pointers to remove, and enough to use a table */
+  for (n_to_remove = 0; n_to_remove < G_N_ELEMENTS (to_remove); n_to_remove += 3)
+    {
+      GPtrArray *array;
+      guint counts[50] = { 0, };
+      guint i, n_expected = 0;
+
+      /* Values 1 to 10 twice, and 11 to 40 once */
+      array = g_ptr_array_new_null_terminated (0, count_free_func, null_terminated);
+      for (i = 0; i < 50; i++)
+        {
+          g_ptr_array_add (array, GUINT_TO_POINTER (i % 40 + 1));
+          counts[i % 40 + 1]++;
+        }
+
+      /* Every other value, a few of them twice, and some missing ones */
+      for (i = 0; i < n_to_remove; i++)
+        {
+          guint v = (i * 2) % 46 + 1;
+
+          to_remove[i] = GUINT_TO_POINTER (v);
+          if (counts[v] > 0)
+            {
+              counts[v]--;
+              n_expected++;
+            }
+        }
+
+      num_free_func_invocations = 0;
+      g_assert_cmpuint (g_ptr_array_remove_fast_many (array, to_remove, n_to_remove), ==, n_expected);
+      g_assert_cmpint (num_free_func_invocations, ==, n_expected);
+      g_assert_cmpuint (array->len, ==, 50 - n_expected);
+      if (null_terminated)
+        g_assert_null (array->pdata[array->len]);
+
+      /* Check which ones are left */
+      for (i = 0; i < G_N_ELEMENTS (counts); i++)
+        {
+          for (; counts[i] > 0; counts[i]--)
+            g_assert_true (g_ptr_array_remove_fast (array, GUINT_TO_POINTER (i)));
+          g_assert_false (g_ptr_array_remove_fast (array, GUINT_TO_POINTER (i)));
+        }
+      g_assert_cmpuint (array->len, ==, 0);
+
+      g_ptr_array_unref (array);
+    }
+}
+
 static void
 pointer_array_remove_range (void)
 {
@@ -2875,6 +3181,36 @@ byte_array_steal (void)
   g_byte_array_free (gbarray, TRUE);
 }
 
+static void
+byte_array_reserve (void)
+{
+  GByteArray *gbarray;
+  guint8 *data;
+  guint i;
+
+  gbarray = g_byte_array_new ();
+  g_byte_array_append (gbarray, (guint8 *) "abcd", 4);
+
+  /* Shrinking is a no-op */
+  g_byte_array_reserve (gbarray, 2);
+  g_assert_cmpuint (gbarray->len, ==, 4);
+
+  /* Large enough to be advised as huge pages */
+  g_byte_array_reserve (gbarray, 8 * 1024 * 1024);
+  g_assert_cmpuint (gbarray->len, ==, 4);
+  g_assert_cmpmem (gbarray->data, 4, "abcd", 4);
+
+  data = gbarray->data;
+  for (i = 1; i < 2 * 1024 * 1024; i++)
+    g_byte_array_append (gbarray, (guint8 *) "abcd", 4);
+
+  g_assert_true (gbarray->data == data);
+  g_assert_cmpuint (gbarray->len, ==, 8 * 1024 * 1024);
+  g_assert_cmpmem (gbarray->data + gbarray->len - 4, 4, "abcd", 4);
+
+  g_free (g_byte_array_free (gbarray, FALSE));
+}
+
 static void
 byte_array_append (void)
 {
@@ -3201,6 +3537,9 @@ main (int argc, char *argv[])
   g_test_add_func ("/array/copy-sized", test_array_copy_sized);
   g_test_add_func ("/array/overflow-append-vals", array_overflow_append_vals);
   g_test_add_func ("/array/overflow-set-size", array_overflow_set_size);
+  g_test_add_func ("/array/sort-parallel", array_sort_parallel);
+  g_test_add_func ("/array/sort-integers", array_sort_integers);
+  g_test_add_func ("/array/binary-search-integers", array_binary_search_integers);
 
   for (i = 0; i < G_N_ELEMENTS (array_configurations); i++)
     {
@@ -3250,12 +3589,16 @@ main (int argc, char *argv[])
   g_test_add_func ("/pointerarray/sort/example", pointer_array_sort_example);
   g_test_add_func ("/pointerarray/sort-with-data", pointer_array_sort_with_data);
   g_test_add_func ("/pointerarray/sort-with-data/example", pointer_array_sort_with_data_example);
+  g_test_add_func ("/pointerarray/sort-parallel", pointer_array_sort_parallel);
   g_test_add_func ("/pointerarray/sort-values", pointer_array_sort_values);
   g_test_add_func ("/pointerarray/sort-values/example", pointer_array_sort_values_example);
   g_test_add_func ("/pointerarray/sort-values-with-data", pointer_array_sort_values_with_data);
   g_test_add_func ("/pointerarray/sort-values-with-data/example", pointer_array_sort_values_with_data_example);
   g_test_add_func ("/pointerarray/find/empty", pointer_array_find_empty);
   g_test_add_func ("/pointerarray/find/non-empty", pointer_array_find_non_empty);
+  g_test_add_func ("/pointerarray/find/large", pointer_array_find_large);
+  g_test_add_data_func ("/pointerarray/remove-fast-many/not-null-terminated", GINT_TO_POINTER (0), pointer_array_remove_fast_many);
+  g_test_add_data_func ("/pointerarray/remove-fast-many/null-terminated", GINT_TO_POINTER (1), pointer_array_remove_fast_many);
   g_test_add_func ("/pointerarray/remove-range", pointer_array_remove_range);
   g_test_add_func ("/pointerarray/steal", pointer_array_steal);
   g_test_add_data_func ("/pointerarray/steal_index/not-null-terminated", GINT_TO_POINTER (0), pointer_array_steal_index);
@@ -3264,6 +3607,7 @@ main (int argc, char *argv[])
   /* byte arrays */
   g_test_add_func ("/bytearray/steal", byte_array_steal);
   g_test_add_func ("/bytearray/append", byte_array_append);
+  g_test_add_func ("/bytearray/reserve", byte_array_reserve);
   g_test_add_func ("/bytearray/prepend", byte_array_prepend);
   g_test_add_func ("/bytearray/remove", byte_array_remove);
   g_test_add_func ("/bytearray/remove-fast", byte_array_remove_fast);
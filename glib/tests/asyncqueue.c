@@ -520,6 +520,204 @@ test_basics (void)
   g_assert_cmpint (destroy_count, ==, 2);
 }
 
+static void
+test_async_queue_many (void)
+{
+  GAsyncQueue *q;
+  gpointer items[5] = { GINT_TO_POINTER (1), GINT_TO_POINTER (2),
+                        GINT_TO_POINTER (3), GINT_TO_POINTER (4),
+                        GINT_TO_POINTER (5) };
+  gpointer popped[8];
+  guint i, n;
+
+  q = g_async_queue_new ();
+
+  g_async_queue_push_many (q, items, G_N_ELEMENTS (items));
+  g_assert_cmpint (g_async_queue_length (q), ==, 5);
+  g_assert_true (g_async_queue_try_push (q, GINT_TO_POINTER (6)));
+
+  n = g_async_queue_pop_many (q, popped, 2);
+  g_assert_cmpuint (n, ==, 2);
+  n += g_async_queue_pop_many (q, popped + 2, G_N_ELEMENTS (popped) - 2);
+  g_assert_cmpuint (n, ==, 6);
+  for (i = 0; i < n; i++)
+    g_assert_cmpint (GPOINTER_TO_INT (popped[i]), ==, i + 1);
+
+  g_assert_cmpuint (g_async_queue_pop_many (q, popped, 0), ==, 0);
+  g_assert_cmpuint (g_async_queue_timeout_pop_many (q, popped, 8, 1000), ==, 0);
+
+  g_async_queue_unref (q);
+}
+
+static void
+test_async_queue_bounded (void)
+{
+  GAsyncQueue *q;
+  gpointer items[6];
+  gpointer popped[8];
+  guint i, n;
+
+  destroy_count = 0;
+
+  /* The capacity is rounded up to 4 */
+  q = g_async_queue_new_bounded (3, destroy_notify);
+  g_assert_nonnull (q);
+
+  g_assert_null (g_async_queue_try_pop (q));
+  g_assert_null (g_async_queue_timeout_pop (q, 1000));
+  g_assert_cmpint (g_async_queue_length (q), ==, 0);
+
+  for (i = 0; i < 4; i++)
+    g_assert_true (g_async_queue_try_push (q, GINT_TO_POINTER (i + 1)));
+  g_assert_false (g_async_queue_try_push (q, GINT_TO_POINTER (5)));
+  g_assert_cmpint (g_async_queue_length (q), ==, 4);
+
+  for (i = 0; i < 4; i++)
+    g_assert_cmpint (GPOINTER_TO_INT (g_async_queue_pop (q)), ==, i + 1);
+  g_assert_null (g_async_queue_try_pop (q));
+
+  /* Wrap around the ring a few times */
+  for (i = 0; i < 6; i++)
+    items[i] = GINT_TO_POINTER (i + 10);
+  for (i = 0; i < 3; i++)
+    {
+      g_async_queue_push_many (q, items, 3);
+      n = g_async_queue_pop_many (q, popped, G_N_ELEMENTS (popped));
+      g_assert_cmpuint (n, ==, 3);
+      g_assert_cmpmem (popped, n * sizeof (gpointer), items, 3 * sizeof (gpointer));
+    }
+
+  /* The _unlocked() variants work too */
+  g_async_queue_lock (q);
+  g_async_queue_push_unlocked (q, GINT_TO_POINTER (20));
+  g_assert_cmpint (g_async_queue_length_unlocked (q), ==, 1);
+  g_assert_cmpint (GPOINTER_TO_INT (g_async_queue_pop_unlocked (q)), ==, 20);
+  g_assert_null (g_async_queue_timeout_pop_unlocked (q, 1000));
+  g_async_queue_unlock (q);
+
+  if (g_test_undefined ())
+    {
+      g_test_expect_message (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL,
+                             "*assertion*ring == NULL*failed*");
+      g_async_queue_push_front (q, GINT_TO_POINTER (1));
+      g_test_assert_expected_messages ();
+
+      g_test_expect_message (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL,
+                             "*assertion*ring == NULL*failed*");
+      g_async_queue_sort (q, compare_func, NULL);
+      g_test_assert_expected_messages ();
+
+      g_test_expect_message (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL,
+                             "*assertion*capacity > 0*failed*");
+      g_assert_null (g_async_queue_new_bounded (0, NULL));
+      g_test_assert_expected_messages ();
+    }
+
+  g_assert_cmpint (destroy_count, ==, 0);
+  g_async_queue_push_many (q, items, 2);
+  g_async_queue_unref (q);
+  g_assert_cmpint (destroy_count, ==, 2);
+}
+
+#define BOUNDED_N_THREADS 4
+#define BOUNDED_N_ITEMS 20000
+
+static gpointer
+bounded_producer (gpointer data)
+{
+  GAsyncQueue *q = data;
+  gpointer batch[7];
+  guint i, n = 0;
+
+  /* Push the numbers 1 … BOUNDED_N_ITEMS, alternating single pushes and
+   * batches */
+  for (i = 1; i <= BOUNDED_N_ITEMS; i++)
+    {
+      if (i % 2)
+        {
+          g_async_queue_push (q, GUINT_TO_POINTER (i));
+          continue;
+        }
+
+      batch[n++] = GUINT_TO_POINTER (i);
+      if (n == G_N_ELEMENTS (batch) || i == BOUNDED_N_ITEMS)
+        {
+          g_async_queue_push_many (q, batch, n);
+          n = 0;
+        }
+    }
+
+  return NULL;
+}
+
+static gpointer
+bounded_consumer (gpointer data)
+{
+  GAsyncQueue *q = data;
+  guint64 sum = 0;
+
+  while (TRUE)
+    {
+      gpointer items[5];
+      guint i, n;
+
+      n = g_async_queue_pop_many (q, items, G_N_ELEMENTS (items));
+      g_assert_cmpuint (n, >, 0);
+
+      for (i = 0; i < n; i++)
+        {
+          /* G_MAXUINT marks the end; leave any other markers popped with
+           * it to the other consumers */
+          if (GPOINTER_TO_UINT (items[i]) == G_MAXUINT)
+            {
+              g_async_queue_push_many (q, items + i + 1, n - i - 1);
+              return g_memdup2 (&sum, sizeof (sum));
+            }
+
+          sum += GPOINTER_TO_UINT (items[i]);
+        }
+    }
+}
+
+static void
+test_async_queue_bounded_threads (void)
+{
+  GAsyncQueue *q;
+  GThread *producers[BOUNDED_N_THREADS];
+  GThread *consumers[BOUNDED_N_THREADS];
+  guint64 sum_total = 0;
+  guint i;
+
+  q = g_async_queue_new_bounded (16, NULL);
+
+  for (i = 0; i < BOUNDED_N_THREADS; i++)
+    {
+      consumers[i] = g_thread_new ("consumer", bounded_consumer, q);
+      producers[i] = g_thread_new ("producer", bounded_producer, q);
+    }
+
+  for (i = 0; i < BOUNDED_N_THREADS; i++)
+    g_thread_join (producers[i]);
+
+  /* One end marker per consumer */
+  for (i = 0; i < BOUNDED_N_THREADS; i++)
+    g_async_queue_push (q, GUINT_TO_POINTER (G_MAXUINT));
+
+  for (i = 0; i < BOUNDED_N_THREADS; i++)
+    {
+      guint64 *sum = g_thread_join (consumers[i]);
+
+      sum_total += *sum;
+      g_free (sum);
+    }
+
+  g_assert_cmpuint (sum_total, ==,
+                    (guint64) BOUNDED_N_THREADS * BOUNDED_N_ITEMS * (BOUNDED_N_ITEMS + 1) / 2);
+  g_assert_cmpint (g_async_queue_length (q), ==, 0);
+
+  g_async_queue_unref (q);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -532,6 +730,9 @@ main (int argc, char *argv[])
   g_test_add_func ("/asyncqueue/timed", test_async_queue_timed);
   g_test_add_func ("/asyncqueue/remove", test_async_queue_remove);
   g_test_add_func ("/asyncqueue/push_front", test_async_queue_push_front);
+  g_test_add_func ("/asyncqueue/many", test_async_queue_many);
+  g_test_add_func ("/asyncqueue/bounded", test_async_queue_bounded);
+  g_test_add_func ("/asyncqueue/bounded/threads", test_async_queue_bounded_threads);
 
   return g_test_run ();
 }
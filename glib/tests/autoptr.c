@@ -606,6 +606,13 @@ test_g_tree (void)
   g_assert_nonnull (val);
 }
 
+static void
+test_g_utf8_index (void)
+{
+  g_autoptr(GUtf8Index) val = g_utf8_index_new ("hello", -1);
+  g_assert_nonnull (val);
+}
+
 static void
 test_g_variant (void)
 {
@@ -835,6 +842,7 @@ main (int argc, gchar *argv[])
   g_test_add_func ("/autoptr/g_timer", test_g_timer);
   g_test_add_func ("/autoptr/g_time_zone", test_g_time_zone);
   g_test_add_func ("/autoptr/g_tree", test_g_tree);
+  g_test_add_func ("/autoptr/g_utf8_index", test_g_utf8_index);
   g_test_add_func ("/autoptr/g_variant", test_g_variant);
   g_test_add_func ("/autoptr/g_variant_builder", test_g_variant_builder);
   g_test_add_func ("/autoptr/g_variant_iter", test_g_variant_iter);
@@ -486,6 +486,70 @@ test_base64_encode_decode_rfc4648 (void)
     }
 }
 
+static void
+test_base64_encode_to_buffer (void)
+{
+  gchar buffer[DATA_SIZE / 3 * 4 + 8];
+  gsize length;
+
+  /* Cover every tail length on either side of the vectorised block sizes */
+  for (length = 0; length <= DATA_SIZE; length += (length < 100) ? 1 : 37)
+    {
+      gchar *expected = g_base64_encode (global_data, length);
+      gsize out_size = (length + 2) / 3 * 4 + 1;
+      gsize written;
+
+      memset (buffer, 'x', sizeof (buffer));
+      written = g_base64_encode_to_buffer (global_data, length, buffer, out_size);
+      g_assert_cmpuint (written, ==, strlen (expected));
+      g_assert_cmpstr (buffer, ==, expected);
+      g_assert_cmpint (buffer[out_size], ==, 'x');
+
+      g_free (expected);
+    }
+
+  g_assert_cmpuint (g_base64_encode_to_buffer (NULL, 0, buffer, 1), ==, 0);
+  g_assert_cmpstr (buffer, ==, "");
+
+  if (g_test_undefined ())
+    {
+      g_test_expect_message (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL, "*out_size*");
+      g_assert_cmpuint (g_base64_encode_to_buffer ((const guchar *) "foo", 3, buffer, 4), ==, 0);
+      g_test_assert_expected_messages ();
+    }
+}
+
+/* Test that whitespace and other characters outside of the alphabet are
+ * skipped wherever they fall relative to the decoder's bulk blocks */
+static void
+test_base64_decode_skip (void)
+{
+  gchar *text;
+  gsize text_len, i;
+
+  text = g_base64_encode (global_data, DATA_SIZE);
+  text_len = strlen (text);
+
+  for (i = 0; i < text_len; i += 13)
+    {
+      GString *mangled = g_string_new_len (text, i);
+      guchar *decoded;
+      gsize decoded_len;
+
+      g_string_append (mangled, (i % 2) ? "\r\n" : " ");
+      g_string_append (mangled, text + i);
+      g_string_insert_c (mangled, mangled->len / 2, '\n');
+
+      decoded = g_base64_decode (mangled->str, &decoded_len);
+      g_assert_cmpmem (global_data, DATA_SIZE, decoded, decoded_len);
+
+      g_free (decoded);
+      g_string_free (mangled, TRUE);
+    }
+
+  g_free (text);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -537,6 +601,8 @@ main (int argc, char *argv[])
   g_test_add_func ("/base64/decode/empty", test_base64_decode_empty);
 
   g_test_add_func ("/base64/encode-decode/rfc4648", test_base64_encode_decode_rfc4648);
+  g_test_add_func ("/base64/encode/to-buffer", test_base64_encode_to_buffer);
+  g_test_add_func ("/base64/decode/skip", test_base64_decode_skip);
 
   return g_test_run ();
 }
@@ -28,12 +28,60 @@ test_bitlocks (void)
   }
 }
 
+#define CONTENDED_THREADS 4
+#define CONTENDED_ITERATIONS 20000
+
+static gint contended_lock = 0;
+static guint contended_counter = 0;
+
+static gpointer
+contended_thread (gpointer data)
+{
+  guint i;
+
+  for (i = 0; i < CONTENDED_ITERATIONS; i++)
+    {
+      g_bit_lock (&contended_lock, 0);
+
+      /* Mostly very short critical sections, which waiters should get
+       * through by spinning, with an occasional long one, which makes them
+       * fall back to sleeping and shortens the spin limit again */
+      contended_counter++;
+      if (i % 2000 == 0)
+        g_usleep (500);
+
+      g_bit_unlock (&contended_lock, 0);
+    }
+
+  return NULL;
+}
+
+static void
+test_bitlocks_contended (void)
+{
+  GThread *threads[CONTENDED_THREADS];
+  guint i;
+
+  g_test_summary ("Test that contended bit locks stay exclusive while the "
+                  "spin limit adapts to short and long critical sections");
+
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    threads[i] = g_thread_new ("bitlock", contended_thread, NULL);
+
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    g_thread_join (threads[i]);
+
+  g_assert_cmpuint (contended_counter, ==, CONTENDED_THREADS * CONTENDED_ITERATIONS);
+  g_assert_cmpint (contended_lock, ==, 0);
+}
+
 int
 main (int argc, char **argv)
 {
   g_test_init (&argc, &argv, NULL);
 
   g_test_add_func ("/bitlock/performance/uncontended", test_bitlocks);
+  g_test_add_func ("/bitlock/contended/adaptive-spinning", test_bitlocks_contended);
 
   return g_test_run ();
 }
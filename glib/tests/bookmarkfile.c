@@ -1,5 +1,6 @@
 #include <glib.h>
 #include <glib/gstdio.h>
+#include <string.h>
 
 #define TEST_URI_0 	"file:///abc/defgh/ijklmnopqrstuvwxyz"
 #define TEST_URI_1 	"file:///test/uri/1"
@@ -99,6 +100,100 @@ test_to_file (void)
   g_free (tmp_filename);
 }
 
+static void
+assert_file_matches (GBookmarkFile *bookmark,
+                     const gchar   *filename)
+{
+  GError *error = NULL;
+  gchar *expected, *contents;
+
+  expected = g_bookmark_file_to_data (bookmark, NULL, &error);
+  g_assert_no_error (error);
+  g_file_get_contents (filename, &contents, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (contents, ==, expected);
+
+  g_free (contents);
+  g_free (expected);
+}
+
+static void
+test_update_file (void)
+{
+  GBookmarkFile *bookmark, *reloaded;
+  GError *error = NULL;
+  gchar *tmp_filename = NULL;
+  gchar *before, *after, *title;
+  gint fd;
+
+  g_test_summary ("Test that g_bookmark_file_update_file() appends new items, "
+                  "and rewrites the file for any other change");
+
+  fd = g_file_open_tmp ("bookmarkfile-test-XXXXXX.xbel", &tmp_filename, NULL);
+  g_assert_cmpint (fd, >, -1);
+  g_close (fd, NULL);
+
+  bookmark = g_bookmark_file_new ();
+  g_bookmark_file_add_application (bookmark, "file:///tmp/a", "app", "app %u");
+
+  /* Not loaded from the file, so it is written whole */
+  g_assert_true (g_bookmark_file_update_file (bookmark, tmp_filename, &error));
+  g_assert_no_error (error);
+  assert_file_matches (bookmark, tmp_filename);
+
+  g_file_get_contents (tmp_filename, &before, NULL, &error);
+  g_assert_no_error (error);
+
+  /* New items are appended, with the same result as rewriting */
+  g_bookmark_file_add_application (bookmark, "file:///tmp/b", "app", "app %u");
+  g_bookmark_file_set_title (bookmark, "file:///tmp/b", "b");
+  g_bookmark_file_add_application (bookmark, "file:///tmp/c", "app", "app %u");
+  g_assert_true (g_bookmark_file_update_file (bookmark, tmp_filename, &error));
+  g_assert_no_error (error);
+  assert_file_matches (bookmark, tmp_filename);
+
+  g_file_get_contents (tmp_filename, &after, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_true (g_str_has_suffix (before, "</xbel>"));
+  g_assert_cmpint (strncmp (after, before, strlen (before) - strlen ("</xbel>")), ==, 0);
+  g_free (after);
+  g_free (before);
+
+  /* Changing an item which is already in the file rewrites it */
+  g_bookmark_file_set_title (bookmark, "file:///tmp/a", "a");
+  g_assert_true (g_bookmark_file_update_file (bookmark, tmp_filename, &error));
+  g_assert_no_error (error);
+  assert_file_matches (bookmark, tmp_filename);
+
+  reloaded = g_bookmark_file_new ();
+  g_assert_true (g_bookmark_file_load_from_file (reloaded, tmp_filename, &error));
+  g_assert_no_error (error);
+  g_assert_cmpint (g_bookmark_file_get_size (reloaded), ==, 3);
+  title = g_bookmark_file_get_title (reloaded, "file:///tmp/a", &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (title, ==, "a");
+  g_free (title);
+
+  /* Removals too */
+  g_assert_true (g_bookmark_file_remove_item (reloaded, "file:///tmp/b", &error));
+  g_assert_no_error (error);
+  g_assert_true (g_bookmark_file_update_file (reloaded, tmp_filename, &error));
+  g_assert_no_error (error);
+  assert_file_matches (reloaded, tmp_filename);
+
+  /* The file was changed behind the back of @bookmark, so its changes
+   * overwrite the file rather than being appended */
+  g_bookmark_file_add_application (bookmark, "file:///tmp/d", "app", "app %u");
+  g_assert_true (g_bookmark_file_update_file (bookmark, tmp_filename, &error));
+  g_assert_no_error (error);
+  assert_file_matches (bookmark, tmp_filename);
+
+  g_bookmark_file_free (reloaded);
+  g_bookmark_file_free (bookmark);
+  g_remove (tmp_filename);
+  g_free (tmp_filename);
+}
+
 static void
 test_move_item (void)
 {
@@ -1356,6 +1451,7 @@ main (int argc, char *argv[])
 
   g_test_add_func ("/bookmarks/load-from-data-dirs", test_load_from_data_dirs);
   g_test_add_func ("/bookmarks/to-file", test_to_file);
+  g_test_add_func ("/bookmarks/update-file", test_update_file);
   g_test_add_func ("/bookmarks/move-item", test_move_item);
   g_test_add_func ("/bookmarks/corner-cases", test_corner_cases);
   g_test_add_func ("/bookmarks/misc", test_misc);
@@ -483,6 +483,148 @@ test_unref_null (void)
   g_bytes_unref (NULL);
 }
 
+static gchar *
+chain_to_string (GBytesChain *chain)
+{
+  const GBytesChainVector *vectors;
+  GString *string = g_string_new (NULL);
+  gsize n_vectors, i;
+
+  vectors = g_bytes_chain_get_vectors (chain, &n_vectors);
+  g_assert_cmpuint (n_vectors, ==, g_bytes_chain_get_n_chunks (chain));
+
+  for (i = 0; i < n_vectors; i++)
+    {
+      g_assert_cmpuint (vectors[i].size, >, 0);
+      g_string_append_len (string, vectors[i].buffer, vectors[i].size);
+    }
+
+  g_assert_cmpuint (string->len, ==, g_bytes_chain_get_size (chain));
+
+  return g_string_free (string, FALSE);
+}
+
+static void
+test_chain (void)
+{
+  GBytesChain *chain, *range;
+  GBytes *header, *body, *trailer, *empty, *flat;
+  const GBytesChainVector *vectors;
+  gsize n_vectors;
+  gchar *string;
+
+  header = g_bytes_new_static ("HEAD", 4);
+  body = g_bytes_new_static (NYAN, N_NYAN);
+  trailer = g_bytes_new_static ("TAIL", 4);
+  empty = g_bytes_new_static (NULL, 0);
+
+  chain = g_bytes_chain_new ();
+  g_assert_null (g_bytes_chain_get_vectors (chain, &n_vectors));
+  g_assert_cmpuint (n_vectors, ==, 0);
+
+  g_bytes_chain_append (chain, body);
+  g_bytes_chain_append (chain, empty);
+  g_bytes_chain_append (chain, trailer);
+  g_bytes_chain_prepend (chain, header);
+  g_assert_cmpuint (g_bytes_chain_get_size (chain), ==, 4 + N_NYAN + 4);
+  g_assert_cmpuint (g_bytes_chain_get_n_chunks (chain), ==, 3);
+
+  /* The chunks are not copied */
+  vectors = g_bytes_chain_get_vectors (chain, &n_vectors);
+  g_assert_cmpuint (n_vectors, ==, 3);
+  g_assert_true (vectors[1].buffer == NYAN);
+
+  string = chain_to_string (chain);
+  g_assert_cmpstr (string, ==, "HEADnyannyanTAIL");
+  g_free (string);
+
+  flat = g_bytes_chain_to_bytes (chain);
+  g_assert_cmpmem (g_bytes_get_data (flat, NULL), g_bytes_get_size (flat),
+                   "HEADnyannyanTAIL", 4 + N_NYAN + 4);
+  g_bytes_unref (flat);
+
+  /* Ranges spanning chunk boundaries */
+  range = g_bytes_chain_new_from_chain (chain, 2, N_NYAN + 4);
+  g_assert_cmpuint (g_bytes_chain_get_n_chunks (range), ==, 3);
+  string = chain_to_string (range);
+  g_assert_cmpstr (string, ==, "ADnyannyanTA");
+  g_free (string);
+  g_bytes_chain_unref (range);
+
+  range = g_bytes_chain_new_from_chain (chain, 4, N_NYAN);
+  g_assert_cmpuint (g_bytes_chain_get_n_chunks (range), ==, 1);
+  flat = g_bytes_chain_to_bytes (range);
+  g_assert_true (flat == body);
+  g_bytes_unref (flat);
+  g_bytes_chain_unref (range);
+
+  range = g_bytes_chain_new_from_chain (chain, 4 + N_NYAN + 4, 0);
+  g_assert_cmpuint (g_bytes_chain_get_size (range), ==, 0);
+  flat = g_bytes_chain_to_bytes (range);
+  g_assert_cmpuint (g_bytes_get_size (flat), ==, 0);
+  g_bytes_unref (flat);
+  g_bytes_chain_unref (range);
+
+  /* Changing the chain updates the vectors */
+  g_bytes_chain_append (chain, header);
+  string = chain_to_string (chain);
+  g_assert_cmpstr (string, ==, "HEADnyannyanTAILHEAD");
+  g_free (string);
+
+  g_bytes_chain_unref (chain);
+  g_bytes_unref (empty);
+  g_bytes_unref (trailer);
+  g_bytes_unref (body);
+  g_bytes_unref (header);
+}
+
+static void
+test_buffer_pool (void)
+{
+  GBufferPool *pool;
+  gpointer buffer, other_buffer;
+  GBytes *bytes, *slice;
+  gpointer data;
+  gsize size;
+
+  pool = g_buffer_pool_new (64, 2);
+  g_assert_cmpuint (g_buffer_pool_get_buffer_size (pool), ==, 64);
+
+  buffer = g_buffer_pool_acquire (pool);
+  memcpy (buffer, NYAN, N_NYAN);
+  bytes = g_buffer_pool_new_bytes (pool, buffer, N_NYAN);
+  g_assert_true (g_bytes_get_data (bytes, &size) == buffer);
+  g_assert_cmpuint (size, ==, N_NYAN);
+
+  /* Slices keep the buffer out of the pool */
+  slice = g_bytes_new_from_bytes (bytes, 1, 2);
+  g_bytes_unref (bytes);
+  g_assert_cmpmem (g_bytes_get_data (slice, NULL), 2, "ya", 2);
+  other_buffer = g_buffer_pool_acquire (pool);
+  g_assert_true (other_buffer != buffer);
+  g_buffer_pool_release (pool, other_buffer);
+  g_bytes_unref (slice);
+
+  /* Once the last reference is dropped, the buffer is reused */
+  g_assert_true (g_buffer_pool_acquire (pool) == buffer);
+
+  /* Pooled data is copied out rather than stolen */
+  memcpy (buffer, NYAN, N_NYAN);
+  bytes = g_buffer_pool_new_bytes (pool, buffer, N_NYAN);
+  data = g_bytes_unref_to_data (bytes, &size);
+  g_assert_true (data != buffer);
+  g_assert_cmpmem (data, size, NYAN, N_NYAN);
+  g_free (data);
+
+  /* Buffers outlive the last reference to the pool */
+  buffer = g_buffer_pool_acquire (pool);
+  g_buffer_pool_unref (pool);
+  memcpy (buffer, "meow", 4);
+  bytes = g_buffer_pool_new_bytes (pool, buffer, 4);
+  g_assert_cmpmem (g_bytes_get_data (bytes, NULL), 4, "meow", 4);
+  g_bytes_unref (bytes);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -509,6 +651,8 @@ main (int argc, char *argv[])
   g_test_add_func ("/bytes/null", test_null);
   g_test_add_func ("/bytes/get-region", test_get_region);
   g_test_add_func ("/bytes/unref-null", test_unref_null);
+  g_test_add_func ("/bytes/chain", test_chain);
+  g_test_add_func ("/bytes/buffer-pool", test_buffer_pool);
 
   return g_test_run ();
 }
@@ -1175,6 +1175,121 @@ test_unsupported (void)
   g_assert (g_checksum_new (20) == NULL);
 }
 
+/* Checksums of one million repetitions of 'a', which are long enough for
+ * the accelerated implementations to be used where the CPU supports them */
+#define LONG_LEN 1000000
+
+static const struct
+{
+  GChecksumType type;
+  const gchar *name;
+  const gchar *sum;
+} long_sums[] = {
+  { G_CHECKSUM_MD5, "MD5", "7707d6ae4e027c70eea2a935c2296f21" },
+  { G_CHECKSUM_SHA1, "SHA1", "34aa973cd4c4daa4f61eeb2bdbad27316534016f" },
+  { G_CHECKSUM_SHA256, "SHA256", "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" },
+  { G_CHECKSUM_SHA384, "SHA384", "9d0e1809716474cb086e834e310a4a1ced149e9c00f248527972cec5"
+                                 "704c2a5b07b8b3dc38ecc4ebae97ddd87f3d8985" },
+  { G_CHECKSUM_SHA512, "SHA512", "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803"
+                                 "afa973ebde0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4e"
+                                 "adb217ad8cc09b" },
+};
+
+/* Runs the test in a subprocess with `G_CPU_FEATURES` set to @features, if
+ * it is not %NULL, so that only the portable code is used */
+static gboolean
+run_with_cpu_features (const gchar          *features,
+                       GTestSubprocessFlags  flags)
+{
+  gchar **envp;
+
+  if (features == NULL || g_test_subprocess ())
+    return FALSE;
+
+  envp = g_environ_setenv (g_get_environ (), "G_CPU_FEATURES", features, TRUE);
+  g_test_trap_subprocess_with_envp (NULL, (const gchar * const *) envp, 0, flags);
+  g_test_trap_assert_passed ();
+  g_strfreev (envp);
+
+  return TRUE;
+}
+
+static void
+test_checksum_long (gconstpointer d)
+{
+  guchar *data;
+  gsize i;
+
+  if (run_with_cpu_features (d, G_TEST_SUBPROCESS_DEFAULT))
+    return;
+
+  data = g_malloc (LONG_LEN);
+  memset (data, 'a', LONG_LEN);
+
+  for (i = 0; i < G_N_ELEMENTS (long_sums); i++)
+    {
+      GChecksum *checksum = g_checksum_new (long_sums[i].type);
+      gchar *sum;
+      gsize pos, chunk;
+
+      /* Feed it in chunks of varying sizes, so the blocks are sometimes
+       * aligned with the chunks and sometimes not */
+      for (pos = 0, chunk = 1; pos < LONG_LEN; pos += chunk, chunk = (chunk * 7 + 5) % 1021 + 1)
+        g_checksum_update (checksum, data + pos, MIN (chunk, LONG_LEN - pos));
+      g_assert_cmpstr (g_checksum_get_string (checksum), ==, long_sums[i].sum);
+      g_checksum_free (checksum);
+
+      sum = g_compute_checksum_for_data (long_sums[i].type, data, LONG_LEN);
+      g_assert_cmpstr (sum, ==, long_sums[i].sum);
+      g_free (sum);
+    }
+
+  g_free (data);
+}
+
+/* Compares the throughput with and without the accelerated implementations.
+ * The subprocess doesn’t run with `-m perf`, and its stdout is the TAP
+ * stream, so it reports its results on stderr. */
+static void
+test_checksum_performance (gconstpointer d)
+{
+  gsize length = 64 * 1024 * 1024;
+  guchar *data;
+  gsize i;
+
+  if (!g_test_perf () && !g_test_subprocess ())
+    {
+      g_test_skip ("Not running performance tests");
+      return;
+    }
+
+  if (run_with_cpu_features (d, G_TEST_SUBPROCESS_INHERIT_STDERR))
+    return;
+
+  data = g_malloc (length);
+  for (i = 0; i < length; i++)
+    data[i] = i * 7;
+
+  for (i = 0; i < G_N_ELEMENTS (long_sums); i++)
+    {
+      gchar *sum;
+      gdouble rate;
+
+      g_test_timer_start ();
+      sum = g_compute_checksum_for_data (long_sums[i].type, data, length);
+      rate = length / g_test_timer_elapsed () / (1024 * 1024);
+      g_free (sum);
+
+      if (g_test_subprocess ())
+        g_printerr ("# %s (G_CPU_FEATURES=%s): %.1f MiB/s\n", long_sums[i].name,
+                    g_getenv ("G_CPU_FEATURES"), rate);
+      else
+        g_test_maximized_result (rate, "%s: %.1f MiB/s", long_sums[i].name, rate);
+    }
+
+  g_free (data);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1209,5 +1324,11 @@ main (int argc, char *argv[])
   add_checksum_string_test (G_CHECKSUM_SHA512, "SHA512", SHA512_sums);
   add_checksum_bytes_test (G_CHECKSUM_SHA512, "SHA512", SHA512_sums);
 
+  g_test_add_data_func ("/checksum/long", NULL, test_checksum_long);
+  g_test_add_data_func ("/checksum/long/portable", "none", test_checksum_long);
+
+  g_test_add_data_func ("/checksum/performance", NULL, test_checksum_performance);
+  g_test_add_data_func ("/checksum/performance/portable", "none", test_checksum_performance);
+
   return g_test_run ();
 }
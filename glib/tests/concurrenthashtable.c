@@ -0,0 +1,253 @@
+/* concurrenthashtable.c: Thread-safe, read-mostly hash table
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <stdlib.h>
+
+static gint n_keys_freed;
+static gint n_values_freed;
+
+static void
+key_free (gpointer key)
+{
+  g_atomic_int_inc (&n_keys_freed);
+  g_free (key);
+}
+
+static void
+value_free (gpointer value)
+{
+  g_atomic_int_inc (&n_values_freed);
+  g_rc_box_release (value);
+}
+
+static gint *
+value_new (gint v)
+{
+  gint *value = g_rc_box_new (gint);
+
+  *value = v;
+
+  return value;
+}
+
+static gpointer
+value_acquire (gconstpointer value,
+               gpointer      user_data)
+{
+  return g_rc_box_acquire ((gpointer) value);
+}
+
+static void
+count_entries (gpointer key,
+               gpointer value,
+               gpointer user_data)
+{
+  guint *count = user_data;
+
+  g_assert_cmpint (atoi ((const gchar *) key), ==, *(gint *) value);
+  (*count)++;
+}
+
+/* Test the basic operations, and when the destroy functions are called */
+static void
+test_basic (void)
+{
+  GConcurrentHashTable *table;
+  gint *value;
+  guint count = 0;
+  gint i;
+
+  n_keys_freed = n_values_freed = 0;
+
+  table = g_concurrent_hash_table_new (g_str_hash, g_str_equal, key_free, value_free);
+  g_assert_cmpuint (g_concurrent_hash_table_size (table), ==, 0);
+  g_assert_null (g_concurrent_hash_table_lookup (table, "1"));
+
+  for (i = 0; i < 100; i++)
+    g_assert_true (g_concurrent_hash_table_insert (table, g_strdup_printf ("%d", i), value_new (i)));
+
+  g_assert_cmpuint (g_concurrent_hash_table_size (table), ==, 100);
+  g_assert_true (g_concurrent_hash_table_contains (table, "42"));
+  g_assert_false (g_concurrent_hash_table_contains (table, "100"));
+  g_assert_cmpint (*(gint *) g_concurrent_hash_table_lookup (table, "42"), ==, 42);
+
+  g_concurrent_hash_table_foreach (table, count_entries, &count);
+  g_assert_cmpuint (count, ==, 100);
+
+  /* Replacing keeps the old key, and frees the new key and old value */
+  g_assert_false (g_concurrent_hash_table_insert (table, g_strdup ("42"), value_new (42)));
+  g_assert_cmpint (n_keys_freed, ==, 1);
+  g_assert_cmpint (n_values_freed, ==, 1);
+  g_assert_cmpuint (g_concurrent_hash_table_size (table), ==, 100);
+
+  /* A copied value outlives its removal */
+  value = g_concurrent_hash_table_lookup_copy (table, "7", value_acquire, NULL);
+  g_assert_nonnull (value);
+  g_assert_true (g_concurrent_hash_table_remove (table, "7"));
+  g_assert_false (g_concurrent_hash_table_remove (table, "7"));
+  g_assert_cmpint (n_keys_freed, ==, 2);
+  g_assert_cmpint (n_values_freed, ==, 2);
+  g_assert_cmpint (*value, ==, 7);
+  g_rc_box_release (value);
+  g_assert_null (g_concurrent_hash_table_lookup_copy (table, "7", value_acquire, NULL));
+
+  g_concurrent_hash_table_remove_all (table);
+  g_assert_cmpuint (g_concurrent_hash_table_size (table), ==, 0);
+  g_assert_cmpint (n_keys_freed, ==, 101);
+  g_assert_cmpint (n_values_freed, ==, 101);
+
+  /* The table is still usable after that */
+  g_assert_true (g_concurrent_hash_table_insert (table, g_strdup ("1"), value_new (1)));
+
+  g_concurrent_hash_table_ref (table);
+  g_concurrent_hash_table_unref (table);
+  g_assert_cmpint (n_keys_freed, ==, 101);
+
+  g_concurrent_hash_table_unref (table);
+  g_assert_cmpint (n_keys_freed, ==, 102);
+  g_assert_cmpint (n_values_freed, ==, 102);
+}
+
+static GConcurrentHashTable *reentrant_table;
+
+static void
+reentrant_value_free (gpointer value)
+{
+  /* Destroy functions are called without any lock held */
+  g_concurrent_hash_table_remove (reentrant_table, value);
+}
+
+static void
+test_reentrant_destroy (void)
+{
+  reentrant_table = g_concurrent_hash_table_new (g_str_hash, g_str_equal, NULL,
+                                                 reentrant_value_free);
+
+  g_concurrent_hash_table_insert (reentrant_table, "a", "b");
+  g_concurrent_hash_table_insert (reentrant_table, "b", "c");
+  g_concurrent_hash_table_insert (reentrant_table, "c", "d");
+
+  g_assert_true (g_concurrent_hash_table_remove (reentrant_table, "a"));
+  g_assert_cmpuint (g_concurrent_hash_table_size (reentrant_table), ==, 0);
+
+  g_concurrent_hash_table_unref (reentrant_table);
+  reentrant_table = NULL;
+}
+
+#define N_THREADS 8
+#define N_KEYS 256
+#define N_ITERATIONS 2000
+
+static GConcurrentHashTable *threaded_table;
+static gint threads_running;
+
+static gpointer
+writer_thread (gpointer data)
+{
+  GRand *rand = g_rand_new_with_seed (GPOINTER_TO_UINT (data));
+  guint i;
+
+  for (i = 0; i < N_ITERATIONS; i++)
+    {
+      gint k = g_rand_int_range (rand, 0, N_KEYS);
+
+      if (g_rand_boolean (rand))
+        g_concurrent_hash_table_insert (threaded_table, g_strdup_printf ("%d", k), value_new (k));
+      else
+        {
+          gchar *key = g_strdup_printf ("%d", k);
+          g_concurrent_hash_table_remove (threaded_table, key);
+          g_free (key);
+        }
+    }
+
+  g_rand_free (rand);
+  g_atomic_int_dec_and_test (&threads_running);
+
+  return NULL;
+}
+
+static gpointer
+reader_thread (gpointer data)
+{
+  GRand *rand = g_rand_new_with_seed (GPOINTER_TO_UINT (data));
+  guint n_found = 0;
+
+  while (g_atomic_int_get (&threads_running) > 0)
+    {
+      gint k = g_rand_int_range (rand, 0, N_KEYS);
+      gchar key[16];
+      gint *value;
+
+      g_snprintf (key, sizeof (key), "%d", k);
+      value = g_concurrent_hash_table_lookup_copy (threaded_table, key, value_acquire, NULL);
+      if (value != NULL)
+        {
+          g_assert_cmpint (*value, ==, k);
+          g_rc_box_release (value);
+          n_found++;
+        }
+    }
+
+  g_rand_free (rand);
+
+  return GUINT_TO_POINTER (n_found);
+}
+
+/* Test concurrent lookups while other threads insert and remove */
+static void
+test_threaded (void)
+{
+  GThread *threads[2 * N_THREADS];
+  gint i;
+
+  n_keys_freed = n_values_freed = 0;
+
+  threaded_table = g_concurrent_hash_table_new (g_str_hash, g_str_equal, key_free, value_free);
+  threads_running = N_THREADS;
+
+  for (i = 0; i < N_THREADS; i++)
+    threads[i] = g_thread_new ("writer", writer_thread, GUINT_TO_POINTER (i + 1));
+  for (i = 0; i < N_THREADS; i++)
+    threads[N_THREADS + i] = g_thread_new ("reader", reader_thread, GUINT_TO_POINTER (i + 1));
+
+  for (i = 0; i < 2 * N_THREADS; i++)
+    g_thread_join (threads[i]);
+
+  g_assert_cmpuint (g_concurrent_hash_table_size (threaded_table), <=, N_KEYS);
+
+  g_concurrent_hash_table_unref (threaded_table);
+  threaded_table = NULL;
+
+  /* Everything that was allocated has been freed exactly once */
+  g_assert_cmpint (n_keys_freed, ==, n_values_freed);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/concurrent-hash-table/basic", test_basic);
+  g_test_add_func ("/concurrent-hash-table/reentrant-destroy", test_reentrant_destroy);
+  g_test_add_func ("/concurrent-hash-table/threaded", test_threaded);
+
+  return g_test_run ();
+}
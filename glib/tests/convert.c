@@ -657,6 +657,271 @@ test_unicode_conversions (void)
   check_ucs4_to_utf16 (ucs4, 3, utf16, 0, 2);
 }
 
+static void
+test_unicode_conversions_into (void)
+{
+  const gchar *utf8 = "abcdefghijklmnopqrstuvwxyz \316\261\316\262 \360\220\200\200!";
+  gunichar2 *utf16;
+  gunichar2 buffer16[64];
+  gchar buffer8[64];
+  glong utf16_len;
+  gsize items_read;
+  gssize n;
+  GError *error = NULL;
+
+  utf16 = g_utf8_to_utf16 (utf8, -1, NULL, &utf16_len, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (utf16_len, ==, 33);
+
+  /* Measuring, then converting */
+  n = g_utf8_to_utf16_into (utf8, -1, NULL, 0, &items_read, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (n, ==, utf16_len);
+  g_assert_cmpuint (items_read, ==, strlen (utf8));
+
+  n = g_utf8_to_utf16_into (utf8, -1, buffer16, G_N_ELEMENTS (buffer16), NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpmem (buffer16, n * sizeof (gunichar2), utf16, utf16_len * sizeof (gunichar2));
+
+  n = g_utf16_to_utf8_into (utf16, utf16_len, buffer8, sizeof (buffer8), &items_read, &error);
+  g_assert_no_error (error);
+  g_assert_cmpmem (buffer8, n, utf8, strlen (utf8));
+  g_assert_cmpuint (items_read, ==, utf16_len);
+
+  /* A short buffer gets the complete characters which fit */
+  memset (buffer16, 0, sizeof (buffer16));
+  n = g_utf8_to_utf16_into (utf8, -1, buffer16, 31, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (n, ==, utf16_len);
+  g_assert_cmpmem (buffer16, 30 * sizeof (gunichar2), utf16, 30 * sizeof (gunichar2));
+  g_assert_cmpuint (buffer16[30], ==, 0);
+
+  memset (buffer8, 0, sizeof (buffer8));
+  n = g_utf16_to_utf8_into (utf16, -1, buffer8, 33, NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (n, ==, strlen (utf8));
+  g_assert_cmpstr (buffer8, ==, "abcdefghijklmnopqrstuvwxyz \316\261\316\262 ");
+
+  /* Nul characters are converted when a length is given */
+  n = g_utf8_to_utf16_into ("a\0b", 3, buffer16, G_N_ELEMENTS (buffer16), NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (n, ==, 3);
+  g_assert_cmpuint (buffer16[1], ==, 0);
+  g_assert_cmpuint (buffer16[2], ==, 'b');
+
+  n = g_utf16_to_utf8_into (buffer16, 3, buffer8, sizeof (buffer8), NULL, &error);
+  g_assert_no_error (error);
+  g_assert_cmpmem (buffer8, n, "a\0b", 3);
+
+  /* Errors */
+  n = g_utf8_to_utf16_into ("abc\316", -1, buffer16, G_N_ELEMENTS (buffer16), &items_read, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (n, ==, 3);
+  g_assert_cmpuint (items_read, ==, 3);
+
+  n = g_utf8_to_utf16_into ("abc\316", -1, buffer16, G_N_ELEMENTS (buffer16), NULL, &error);
+  g_assert_error (error, G_CONVERT_ERROR, G_CONVERT_ERROR_PARTIAL_INPUT);
+  g_assert_cmpint (n, ==, -1);
+  g_clear_error (&error);
+
+  n = g_utf8_to_utf16_into ("abc\316\0def", 8, NULL, 0, &items_read, &error);
+  g_assert_error (error, G_CONVERT_ERROR, G_CONVERT_ERROR_ILLEGAL_SEQUENCE);
+  g_assert_cmpint (n, ==, -1);
+  g_assert_cmpuint (items_read, ==, 3);
+  g_clear_error (&error);
+
+  buffer16[0] = 'a';
+  buffer16[1] = 0xdc01;
+  n = g_utf16_to_utf8_into (buffer16, 2, buffer8, sizeof (buffer8), &items_read, &error);
+  g_assert_error (error, G_CONVERT_ERROR, G_CONVERT_ERROR_ILLEGAL_SEQUENCE);
+  g_assert_cmpint (n, ==, -1);
+  g_assert_cmpuint (items_read, ==, 1);
+  g_clear_error (&error);
+
+  buffer16[1] = 0xd801;
+  n = g_utf16_to_utf8_into (buffer16, 2, buffer8, sizeof (buffer8), &items_read, &error);
+  g_assert_no_error (error);
+  g_assert_cmpint (n, ==, 1);
+  g_assert_cmpuint (items_read, ==, 1);
+
+  g_free (utf16);
+}
+
+/* Check that g_convert() between UTF-8 and UTF-16, which doesn't use iconv,
+ * gives the same results as iconv. */
+static void
+check_convert_utf16 (const gchar *str,
+                     gsize        len,
+                     const gchar *to_codeset,
+                     const gchar *from_codeset)
+{
+  GIConv cd = g_iconv_open (to_codeset, from_codeset);
+  gsize bytes_read, bytes_written, expected_read, expected_written;
+  GError *error = NULL, *expected_error = NULL;
+  gchar *result, *expected;
+
+  g_assert_true (cd != (GIConv) -1);
+
+  result = g_convert (str, len, to_codeset, from_codeset,
+                      &bytes_read, &bytes_written, &error);
+  expected = g_convert_with_iconv (str, len, cd,
+                                   &expected_read, &expected_written, &expected_error);
+  if (expected_error)
+    {
+      g_assert_nonnull (error);
+      g_assert_cmpint (error->code, ==, expected_error->code);
+      g_assert_cmpuint (bytes_read, ==, expected_read);
+      g_assert_null (result);
+    }
+  else
+    {
+      g_assert_no_error (error);
+      g_assert_cmpuint (bytes_read, ==, expected_read);
+      g_assert_cmpmem (result, bytes_written + 2, expected, expected_written + 2);
+    }
+  g_clear_error (&error);
+  g_clear_error (&expected_error);
+  g_free (result);
+  g_free (expected);
+
+  /* Without @bytes_read, partial input is an error */
+  result = g_convert (str, len, to_codeset, from_codeset, NULL, NULL, &error);
+  expected = g_convert_with_iconv (str, len, cd, NULL, NULL, &expected_error);
+  g_assert_cmpint (!!result, ==, !!expected);
+  if (expected_error)
+    g_assert_cmpint (error->code, ==, expected_error->code);
+  g_clear_error (&error);
+  g_clear_error (&expected_error);
+  g_free (result);
+  g_free (expected);
+
+  g_iconv_close (cd);
+}
+
+static void
+test_convert_utf16 (void)
+{
+  const gchar *pieces[] = {
+    "a", "Z", "\0", "\302\251", "\316\261", "\342\202\254",
+    "\360\237\230\200", "\316", "\355\240\200", "\200",
+  };
+  const gchar *codesets[] = { "UTF-16LE", "UTF-16BE" };
+  GString *str = g_string_new (NULL);
+  guint i, j;
+
+  for (i = 0; i < 2000; i++)
+    {
+      guint n = g_test_rand_int_range (0, 60);
+      const gchar *codeset = codesets[i % 2];
+      gchar *utf16;
+      gsize utf16_len;
+
+      g_string_truncate (str, 0);
+      for (j = 0; j < n; j++)
+        {
+          /* Mostly valid text, with runs of ASCII */
+          if (g_test_rand_int_range (0, 4) != 0)
+            g_string_append (str, pieces[g_test_rand_int_range (0, 2)]);
+          else if (g_test_rand_int_range (0, 20) != 0)
+            g_string_append_len (str, pieces[g_test_rand_int_range (2, 7)], -1);
+          else
+            g_string_append (str, pieces[g_test_rand_int_range (7, G_N_ELEMENTS (pieces))]);
+
+          if (j == 0 && i % 7 == 0)
+            g_string_append_len (str, "\0", 1);
+        }
+
+      check_convert_utf16 (str->str, str->len, codeset, "UTF-8");
+
+      /* And back, from valid UTF-16 possibly cut short or unaligned */
+      utf16 = g_convert (str->str, str->len, codeset, "UTF-8", &utf16_len, NULL, NULL);
+      if (utf16 != NULL)
+        {
+          gchar *unaligned = g_malloc (utf16_len + 1);
+
+          memcpy (unaligned + 1, utf16, utf16_len);
+          check_convert_utf16 (utf16, utf16_len, "UTF-8", codeset);
+          if (utf16_len > 0)
+            check_convert_utf16 (utf16, utf16_len - 1, "UTF-8", codeset);
+          if (utf16_len > 2)
+            check_convert_utf16 (utf16, utf16_len - 2, "UTF-8", codeset);
+          check_convert_utf16 (unaligned + 1, utf16_len, "UTF-8", codeset);
+          g_free (unaligned);
+          g_free (utf16);
+        }
+    }
+
+  g_string_free (str, TRUE);
+}
+
+static gpointer
+iconv_cache_thread (gpointer data)
+{
+  /* More pairs than fit in the cache, some of which are stateful */
+  const gchar *codesets[] = {
+    "ISO-8859-1", "ISO-8859-15", "CP1252", "UTF-16", "UTF-32", "UTF-7",
+    "ISO-2022-JP", "EUC-JP", "SHIFT_JIS", "ISO-8859-2", "CP850",
+  };
+  guint n_rounds = GPOINTER_TO_UINT (data);
+  guint i, j;
+
+  for (i = 0; i < n_rounds; i++)
+    for (j = 0; j < G_N_ELEMENTS (codesets); j++)
+      {
+        const gchar *utf8 = j >= 6 && j < 9 ? "\346\227\245\346\234\254 x" : "caf\303\251 x";
+        GError *error = NULL;
+        gchar *converted, *back;
+        gsize len;
+
+        converted = g_convert (utf8, -1, codesets[j], "UTF-8", NULL, &len, &error);
+        if (g_error_matches (error, G_CONVERT_ERROR, G_CONVERT_ERROR_NO_CONVERSION))
+          {
+            g_clear_error (&error);
+            continue;
+          }
+        g_assert_no_error (error);
+
+        back = g_convert (converted, len, "UTF-8", codesets[j], NULL, NULL, &error);
+        g_assert_no_error (error);
+        g_assert_cmpstr (back, ==, utf8);
+
+        g_free (back);
+        g_free (converted);
+      }
+
+  return NULL;
+}
+
+static void
+test_iconv_cache (void)
+{
+  GThread *threads[4];
+  GIConv cd;
+  gchar *outer, *inner;
+  gsize i;
+
+  /* Converters are reused, and must not carry state over, in one thread or
+   * several at once */
+  iconv_cache_thread (GUINT_TO_POINTER (3));
+
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    threads[i] = g_thread_new ("iconv-cache", iconv_cache_thread, GUINT_TO_POINTER (20));
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    g_thread_join (threads[i]);
+
+  /* Using the same pair while it is in use, as g_convert_with_fallback()
+   * can, gets another converter */
+  cd = g_iconv_open ("ISO-8859-1", "UTF-8");
+  outer = g_convert_with_iconv ("caf\303\251", -1, cd, NULL, NULL, NULL);
+  inner = g_convert_with_fallback ("\342\202\254 caf\303\251", -1, "ISO-8859-1", "UTF-8",
+                                   "?", NULL, NULL, NULL);
+  g_assert_cmpstr (outer, ==, "caf\351");
+  g_assert_cmpstr (inner, ==, "? caf\351");
+  g_free (inner);
+  g_free (outer);
+  g_iconv_close (cd);
+}
+
 static void
 test_filename_utf8 (void)
 {
@@ -998,6 +1263,9 @@ main (int argc, char *argv[])
   g_test_add_func ("/conversion/illegal-sequence", test_one_half);
   g_test_add_func ("/conversion/byte-order", test_byte_order);
   g_test_add_func ("/conversion/unicode", test_unicode_conversions);
+  g_test_add_func ("/conversion/unicode/into", test_unicode_conversions_into);
+  g_test_add_func ("/conversion/utf16", test_convert_utf16);
+  g_test_add_func ("/conversion/iconv-cache", test_iconv_cache);
   g_test_add_func ("/conversion/filename-utf8", test_filename_utf8);
   g_test_add_func ("/conversion/filename-display", test_filename_display);
   g_test_add_func ("/conversion/convert-embedded-nul", test_convert_embedded_nul);
@@ -68,6 +68,122 @@ test_quark_string (void)
   g_free (copy);
 }
 
+#define N_QUARK_THREADS 4
+
+static gint quark_threads_ready;
+
+/* Threads racing to create the same quarks all get the same value, and
+ * quarks stay findable while the index is being grown under them */
+static gpointer
+quark_create_thread (gpointer data)
+{
+  guint n_quarks = GPOINTER_TO_UINT (data);
+  GQuark *quarks = g_new (GQuark, n_quarks);
+  guint i;
+
+  g_atomic_int_inc (&quark_threads_ready);
+  while (g_atomic_int_get (&quark_threads_ready) < N_QUARK_THREADS)
+    g_thread_yield ();
+
+  for (i = 0; i < n_quarks; i++)
+    {
+      gchar name[32];
+
+      g_snprintf (name, sizeof (name), "threaded-quark-%u", i);
+      quarks[i] = g_quark_from_string (name);
+      g_assert_cmpuint (quarks[i], !=, 0);
+      g_assert_cmpstr (g_quark_to_string (quarks[i]), ==, name);
+
+      /* Look up one created a while ago */
+      g_snprintf (name, sizeof (name), "threaded-quark-%u", i / 2);
+      g_assert_cmpuint (g_quark_try_string (name), ==, quarks[i / 2]);
+    }
+
+  return quarks;
+}
+
+static void
+test_quark_threaded (void)
+{
+  guint n_quarks = 10000;
+  GThread *threads[N_QUARK_THREADS];
+  GQuark *quarks[N_QUARK_THREADS];
+  guint i, j;
+
+  quark_threads_ready = 0;
+
+  for (i = 0; i < N_QUARK_THREADS; i++)
+    threads[i] = g_thread_new ("quark", quark_create_thread, GUINT_TO_POINTER (n_quarks));
+  for (i = 0; i < N_QUARK_THREADS; i++)
+    quarks[i] = g_thread_join (threads[i]);
+
+  for (i = 1; i < N_QUARK_THREADS; i++)
+    for (j = 0; j < n_quarks; j++)
+      g_assert_cmpuint (quarks[i][j], ==, quarks[0][j]);
+
+  for (i = 0; i < N_QUARK_THREADS; i++)
+    g_free (quarks[i]);
+}
+
+static gchar **perf_quark_names;
+static guint perf_n_quark_names;
+static guint perf_n_lookups;
+
+static gpointer
+quark_lookup_thread (gpointer data)
+{
+  guint i;
+
+  g_atomic_int_inc (&quark_threads_ready);
+  while (g_atomic_int_get (&quark_threads_ready) < N_QUARK_THREADS)
+    g_thread_yield ();
+
+  for (i = 0; i < perf_n_lookups; i++)
+    {
+      const gchar *name = perf_quark_names[((guint64) i * 7919) % perf_n_quark_names];
+
+      if (g_quark_from_string (name) == 0)
+        g_assert_not_reached ();
+    }
+
+  return NULL;
+}
+
+/* Throughput of looking up existing quarks from several threads at once */
+static void
+test_quark_lookup_perf (void)
+{
+  GThread *threads[N_QUARK_THREADS];
+  gdouble elapsed;
+  guint i;
+
+  perf_n_quark_names = 1000;
+  perf_n_lookups = g_test_perf () ? 10000000 : 10000;
+
+  perf_quark_names = g_new0 (gchar *, perf_n_quark_names + 1);
+  for (i = 0; i < perf_n_quark_names; i++)
+    {
+      perf_quark_names[i] = g_strdup_printf ("perf-quark-%u", i);
+      g_quark_from_string (perf_quark_names[i]);
+    }
+
+  quark_threads_ready = 0;
+
+  g_test_timer_start ();
+  for (i = 0; i < N_QUARK_THREADS; i++)
+    threads[i] = g_thread_new ("quark", quark_lookup_thread, NULL);
+  for (i = 0; i < N_QUARK_THREADS; i++)
+    g_thread_join (threads[i]);
+  elapsed = g_test_timer_elapsed ();
+
+  g_test_maximized_result (N_QUARK_THREADS * perf_n_lookups / elapsed,
+                           "%6.0f quark lookups per second from %d threads",
+                           N_QUARK_THREADS * perf_n_lookups / elapsed,
+                           N_QUARK_THREADS);
+
+  g_strfreev (perf_quark_names);
+}
+
 static void
 test_dataset_basic (void)
 {
@@ -377,6 +493,59 @@ test_datalist_id_remove_multiple_resize (void)
   g_free (quarks2);
 }
 
+static void
+test_datalist_many_keys (void)
+{
+  const guint N = 200;
+  GQuark *quarks;
+  gboolean *present;
+  GData *list = NULL;
+  char sbuf[100];
+  guint i, i_run;
+
+  quarks = g_new (GQuark, N);
+  present = g_new0 (gboolean, N);
+
+  for (i = 0; i < N; i++)
+    {
+      g_snprintf (sbuf, sizeof (sbuf), "many-keys-%u", i);
+      quarks[i] = g_quark_from_string (sbuf);
+    }
+
+  /* Grow and shrink across the size at which the datalist gets an index,
+   * and check every lookup against what we expect after each step. */
+  for (i_run = 0; i_run < 5000; i_run++)
+    {
+      guint j = ((guint) g_test_rand_int ()) % N;
+      guint limit = (i_run / 500) % 2 ? N : 12;
+
+      if (j >= limit || (present[j] && g_test_rand_bit ()))
+        {
+          g_datalist_id_remove_data (&list, quarks[j]);
+          present[j] = FALSE;
+        }
+      else
+        {
+          g_datalist_id_set_data (&list, quarks[j], GUINT_TO_POINTER (j + 1));
+          present[j] = TRUE;
+        }
+
+      if (i_run % 50 == 0)
+        {
+          for (i = 0; i < N; i++)
+            {
+              gpointer expected = present[i] ? GUINT_TO_POINTER (i + 1) : NULL;
+
+              g_assert_true (g_datalist_id_get_data (&list, quarks[i]) == expected);
+            }
+        }
+    }
+
+  g_datalist_clear (&list);
+  g_free (quarks);
+  g_free (present);
+}
+
 static void
 destroy_func (gpointer data)
 {
@@ -472,6 +641,8 @@ main (int argc, char *argv[])
 
   g_test_add_func ("/quark/basic", test_quark_basic);
   g_test_add_func ("/quark/string", test_quark_string);
+  g_test_add_func ("/quark/threaded", test_quark_threaded);
+  g_test_add_func ("/quark/perf/lookup", test_quark_lookup_perf);
   g_test_add_func ("/dataset/basic", test_dataset_basic);
   g_test_add_func ("/dataset/id", test_dataset_id);
   g_test_add_func ("/dataset/full", test_dataset_full);
@@ -485,6 +656,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/datalist/id-remove-multiple-destroy-order",
                    test_datalist_id_remove_multiple_destroy_order);
   g_test_add_func ("/datalist/update-atomic", test_datalist_update_atomic);
+  g_test_add_func ("/datalist/many-keys", test_datalist_many_keys);
 
   return g_test_run ();
 }
@@ -396,6 +396,56 @@ test_extended_non_static (void)
   g_error_free (error);
 }
 
+static void
+test_literal_static (void)
+{
+  static const gchar message[] = "static message";
+  TestErrorCheck check = { 0, 0, 0 };
+  GError *error = NULL;
+  GError *copy;
+
+  g_test_summary ("Test that g_set_error_literal_static() doesn’t copy the "
+                  "message, and that such errors can be copied and prefixed");
+
+  g_set_error_literal_static (NULL, G_FILE_ERROR, G_FILE_ERROR_NOENT, message);
+
+  g_set_error_literal_static (&error, G_FILE_ERROR, G_FILE_ERROR_NOENT, message);
+  g_assert_nonnull (error);
+  g_assert_error (error, G_FILE_ERROR, G_FILE_ERROR_NOENT);
+  g_assert_true (error->message == message);
+
+  copy = g_error_copy (error);
+  g_assert_nonnull (copy);
+  g_assert_error (copy, G_FILE_ERROR, G_FILE_ERROR_NOENT);
+  g_assert_true (copy->message == message);
+
+  g_prefix_error (&copy, "%s: ", "prefix");
+  g_assert_cmpstr (copy->message, ==, "prefix: static message");
+  g_prefix_error_literal (&error, "other: ");
+  g_assert_cmpstr (error->message, ==, "other: static message");
+
+  g_error_free (copy);
+  g_clear_error (&error);
+
+  /* The same with an extended domain, which has private data too */
+  init_check = &check;
+  g_set_error_literal_static (&error, TEST_ERROR, 1, message);
+  g_assert_nonnull (error);
+  fill_test_error (error, &check);
+  g_assert_true (error->message == message);
+  g_assert_cmpint (test_error_get_private (error)->foo, ==, 13);
+
+  copy = g_error_copy (error);
+  g_assert_nonnull (copy);
+  g_assert_true (copy->message == message);
+  g_assert_cmpint (check.copy_called, ==, 1);
+
+  g_error_free (copy);
+  g_clear_error (&error);
+  g_assert_cmpint (check.init_called, ==, 2);
+  g_assert_cmpint (check.free_called, ==, 2);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -412,6 +462,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/error/extended", test_extended);
   g_test_add_func ("/error/extended/duplicate", test_extended_duplicate);
   g_test_add_func ("/error/extended/non-static", test_extended_non_static);
+  g_test_add_func ("/error/literal-static", test_literal_static);
 
   return g_test_run ();
 }
@@ -659,6 +659,41 @@ test_build_filenamev (void)
 #endif /* G_OS_WIN32 */
 }
 
+static void
+test_build_filename_to_buffer (void)
+{
+  gchar buffer[16];
+  gsize len;
+
+  len = g_build_filename_to_buffer (buffer, sizeof (buffer), S, NULL);
+  g_assert_cmpuint (len, ==, 1);
+  g_assert_cmpstr (buffer, ==, S);
+
+  len = g_build_filename_to_buffer (buffer, sizeof (buffer), "x", "", "y"S, NULL);
+  g_assert_cmpuint (len, ==, 4);
+  g_assert_cmpstr (buffer, ==, "x"S"y"S);
+
+  len = g_build_filename_to_buffer (buffer, sizeof (buffer), S S"x"S S, S"y", "z", NULL);
+  g_assert_cmpuint (len, ==, 7);
+  g_assert_cmpstr (buffer, ==, S S"x"S"y"S"z");
+
+  /* Exactly fits, including the nul terminator */
+  len = g_build_filename_to_buffer (buffer, 8, "abc", "def", NULL);
+  g_assert_cmpuint (len, ==, 7);
+  g_assert_cmpstr (buffer, ==, "abc"S"def");
+
+  /* Too small: nothing but the nul terminator is written */
+  memset (buffer, 'a', sizeof (buffer));
+  len = g_build_filename_to_buffer (buffer, 7, "abc", "def", NULL);
+  g_assert_cmpuint (len, ==, 7);
+  g_assert_cmpstr (buffer, ==, "");
+  g_assert_cmpint (buffer[1], ==, 'a');
+
+  /* Only measure the path */
+  len = g_build_filename_to_buffer (NULL, 0, "abc", "def", "ghi", NULL);
+  g_assert_cmpuint (len, ==, 11);
+}
+
 #undef S
 
 static void
@@ -1474,6 +1509,46 @@ test_get_contents (void)
   g_remove (filename);
 }
 
+static void
+test_get_contents_bytes (void)
+{
+  const gchar *filename = "file-test-get-contents-bytes";
+  GBytes *bytes;
+  GError *error = NULL;
+  gchar *contents;
+  const gchar *data;
+  /* The large ones are read and mapped, respectively */
+  gsize sizes[] = { 0, 26, 2 * 1024 * 1024, 2 * 1024 * 1024 + 1 };
+  gsize len, i;
+
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++)
+    {
+      contents = g_malloc (sizes[i]);
+      memset (contents, 'a' + i, sizes[i]);
+      g_file_set_contents (filename, contents, sizes[i], &error);
+      g_assert_no_error (error);
+
+      bytes = g_file_get_contents_bytes (filename, &error);
+      g_assert_no_error (error);
+      g_assert_nonnull (bytes);
+
+      data = g_bytes_get_data (bytes, &len);
+      g_assert_cmpmem (data, len, contents, sizes[i]);
+      if (len > 0)
+        g_assert_cmpint (data[len], ==, '\0');
+
+      g_bytes_unref (bytes);
+      g_free (contents);
+    }
+
+  g_remove (filename);
+
+  bytes = g_file_get_contents_bytes (filename, &error);
+  g_assert_error (error, G_FILE_ERROR, G_FILE_ERROR_NOENT);
+  g_assert_null (bytes);
+  g_clear_error (&error);
+}
+
 static gboolean
 resize_file (const gchar *filename,
              gint64       size)
@@ -1976,6 +2051,146 @@ test_set_contents_full_read_only_directory (void)
 #endif
 }
 
+static guint
+count_dir_entries (const gchar *dir_name)
+{
+  GError *error = NULL;
+  GDir *dir;
+  guint n = 0;
+
+  dir = g_dir_open (dir_name, 0, &error);
+  g_assert_no_error (error);
+  while (g_dir_read_name (dir) != NULL)
+    n++;
+  g_dir_close (dir);
+
+  return n;
+}
+
+static void
+test_set_contents_batch (void)
+{
+  GFileSetContentsFlags flags[] =
+    {
+      G_FILE_SET_CONTENTS_NONE,
+      G_FILE_SET_CONTENTS_CONSISTENT,
+      G_FILE_SET_CONTENTS_CONSISTENT | G_FILE_SET_CONTENTS_ONLY_EXISTING,
+      G_FILE_SET_CONTENTS_CONSISTENT | G_FILE_SET_CONTENTS_DURABLE,
+    };
+  gsize i;
+
+  g_test_summary ("Test replacing several files with a GFileSetContentsBatch");
+
+  for (i = 0; i < G_N_ELEMENTS (flags); i++)
+    {
+      GError *error = NULL;
+      GFileSetContentsBatch *batch;
+      gchar *dir_name;
+      gchar *file_names[3];
+      gchar *contents;
+      gsize length;
+      gsize j;
+
+      g_test_message ("Flags %d", flags[i]);
+
+      dir_name = g_dir_make_tmp ("glib-file-set-contents-batch-XXXXXX", &error);
+      g_assert_no_error (error);
+
+      for (j = 0; j < G_N_ELEMENTS (file_names); j++)
+        {
+          gchar *name = g_strdup_printf ("file%" G_GSIZE_FORMAT, j);
+
+          file_names[j] = g_build_filename (dir_name, name, NULL);
+          g_free (name);
+        }
+
+      /* One of the files already exists */
+      g_file_set_contents (file_names[0], "old", -1, &error);
+      g_assert_no_error (error);
+
+      batch = g_file_set_contents_batch_new (flags[i]);
+      g_assert_true (g_file_set_contents_batch_add (batch, file_names[0], "zero", -1, 0644, &error));
+      g_assert_no_error (error);
+      g_assert_true (g_file_set_contents_batch_add (batch, file_names[1], "one", -1, 0644, &error));
+      g_assert_no_error (error);
+      g_assert_true (g_file_set_contents_batch_add (batch, file_names[2], "two\0two", 7, 0644, &error));
+      g_assert_no_error (error);
+
+      /* Nothing is replaced until the batch is committed */
+      g_assert_true (g_file_get_contents (file_names[0], &contents, &length, &error));
+      g_assert_no_error (error);
+      g_assert_cmpstr (contents, ==, "old");
+      g_free (contents);
+      g_assert_false (g_file_test (file_names[1], G_FILE_TEST_EXISTS));
+
+      g_assert_true (g_file_set_contents_batch_commit (batch, &error));
+      g_assert_no_error (error);
+      g_file_set_contents_batch_free (batch);
+
+      g_assert_true (g_file_get_contents (file_names[0], &contents, &length, &error));
+      g_assert_no_error (error);
+      g_assert_cmpmem (contents, length, "zero", 4);
+      g_free (contents);
+
+      g_assert_true (g_file_get_contents (file_names[1], &contents, &length, &error));
+      g_assert_no_error (error);
+      g_assert_cmpmem (contents, length, "one", 3);
+      g_free (contents);
+
+      g_assert_true (g_file_get_contents (file_names[2], &contents, &length, &error));
+      g_assert_no_error (error);
+      g_assert_cmpmem (contents, length, "two\0two", 7);
+      g_free (contents);
+
+      /* No temporary files are left behind */
+      g_assert_cmpuint (count_dir_entries (dir_name), ==, G_N_ELEMENTS (file_names));
+
+      for (j = 0; j < G_N_ELEMENTS (file_names); j++)
+        {
+          g_remove (file_names[j]);
+          g_free (file_names[j]);
+        }
+      g_rmdir (dir_name);
+      g_free (dir_name);
+    }
+}
+
+static void
+test_set_contents_batch_free (void)
+{
+  GError *error = NULL;
+  GFileSetContentsBatch *batch;
+  gchar *dir_name;
+  gchar *file_name;
+  gchar *contents;
+
+  g_test_summary ("Test that freeing an uncommitted GFileSetContentsBatch leaves files untouched");
+
+  dir_name = g_dir_make_tmp ("glib-file-set-contents-batch-XXXXXX", &error);
+  g_assert_no_error (error);
+  file_name = g_build_filename (dir_name, "file", NULL);
+
+  g_file_set_contents (file_name, "old", -1, &error);
+  g_assert_no_error (error);
+
+  batch = g_file_set_contents_batch_new (G_FILE_SET_CONTENTS_CONSISTENT);
+  g_assert_true (g_file_set_contents_batch_add (batch, file_name, "new", -1, 0644, &error));
+  g_assert_no_error (error);
+  g_file_set_contents_batch_free (batch);
+
+  g_assert_true (g_file_get_contents (file_name, &contents, NULL, &error));
+  g_assert_no_error (error);
+  g_assert_cmpstr (contents, ==, "old");
+  g_free (contents);
+
+  g_assert_cmpuint (count_dir_entries (dir_name), ==, 1);
+
+  g_remove (file_name);
+  g_rmdir (dir_name);
+  g_free (file_name);
+  g_free (dir_name);
+}
+
 static void
 test_read_link (void)
 {
@@ -2753,6 +2968,7 @@ main (int   argc,
   g_test_add_func ("/fileutils/build-pathv", test_build_pathv);
   g_test_add_func ("/fileutils/build-filename", test_build_filename);
   g_test_add_func ("/fileutils/build-filenamev", test_build_filenamev);
+  g_test_add_func ("/fileutils/build-filename-to-buffer", test_build_filename_to_buffer);
   g_test_add_func ("/fileutils/mkdir-with-parents", test_mkdir_with_parents);
   g_test_add_func ("/fileutils/mkdir-with-parents-permission", test_mkdir_with_parents_permission);
   g_test_add_func ("/fileutils/format-size-for-display", test_format_size_for_display);
@@ -2767,10 +2983,13 @@ main (int   argc,
   g_test_add_func ("/fileutils/mkdtemp", test_mkdtemp);
   g_test_add_func ("/fileutils/get-contents", test_get_contents);
   g_test_add_func ("/fileutils/get-contents-large-file", test_get_contents_largefile);
+  g_test_add_func ("/fileutils/get-contents-bytes", test_get_contents_bytes);
   g_test_add_func ("/fileutils/set-contents", test_set_contents);
   g_test_add_func ("/fileutils/set-contents-full", test_set_contents_full);
   g_test_add_func ("/fileutils/set-contents-full/read-only-file", test_set_contents_full_read_only_file);
   g_test_add_func ("/fileutils/set-contents-full/read-only-directory", test_set_contents_full_read_only_directory);
+  g_test_add_func ("/fileutils/set-contents-batch", test_set_contents_batch);
+  g_test_add_func ("/fileutils/set-contents-batch/free", test_set_contents_batch_free);
   g_test_add_func ("/fileutils/read-link", test_read_link);
   g_test_add_func ("/fileutils/stdio-wrappers", test_stdio_wrappers);
   g_test_add_func ("/fileutils/fopen-modes", test_fopen_modes);
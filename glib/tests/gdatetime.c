@@ -2615,6 +2615,65 @@ test_format_iso8601 (void)
   g_time_zone_unref (tz);
 }
 
+static void
+test_format_to_buffer (void)
+{
+  const gchar *formats[] = {
+    "%Y-%m-%d %H:%M:%S.%f",
+    "%F %T %z %:z %::z %:::z",
+    "[%C%y %j %R %s%%%t]",
+    "%e %k",
+    "%a %b %p",
+    "%-d %_m %0H",
+  };
+  GTimeZone *tz;
+  GDateTime *dt;
+  gchar buffer[64];
+  gchar small[8];
+  gssize len;
+  gsize iso_len;
+  gchar *p;
+  gsize i;
+
+  tz = g_time_zone_new_offset (5 * 60 * 60 + 30 * 60);
+  dt = g_date_time_new (tz, 2024, 3, 7, 9, 5, 2.5);
+
+  /* Whether or not the fast path is used, the result must match
+   * g_date_time_format() */
+  for (i = 0; i < G_N_ELEMENTS (formats); i++)
+    {
+      p = g_date_time_format (dt, formats[i]);
+      g_assert_nonnull (p);
+
+      len = g_date_time_format_to_buffer (dt, formats[i], buffer, sizeof (buffer));
+      g_assert_cmpint (len, ==, strlen (p));
+      g_assert_cmpstr (buffer, ==, p);
+
+      len = g_date_time_format_to_buffer (dt, formats[i], small, sizeof (small));
+      g_assert_cmpint (len, ==, strlen (p));
+      g_assert_cmpmem (small, strlen (small), p, sizeof (small) - 1);
+
+      len = g_date_time_format_to_buffer (dt, formats[i], NULL, 0);
+      g_assert_cmpint (len, ==, strlen (p));
+
+      g_free (p);
+    }
+
+  g_assert_cmpint (g_date_time_format_to_buffer (dt, "%D", buffer, sizeof (buffer)), ==, -1);
+  g_assert_cmpstr (buffer, ==, "");
+
+  iso_len = g_date_time_format_iso8601_to_buffer (dt, buffer, sizeof (buffer));
+  g_assert_cmpstr (buffer, ==, "2024-03-07T09:05:02.500000+05:30");
+  g_assert_cmpuint (iso_len, ==, strlen (buffer));
+
+  iso_len = g_date_time_format_iso8601_to_buffer (dt, small, sizeof (small));
+  g_assert_cmpstr (small, ==, "2024-03");
+  g_assert_cmpuint (iso_len, ==, strlen (buffer));
+
+  g_date_time_unref (dt);
+  g_time_zone_unref (tz);
+}
+
 typedef struct
 {
   gboolean utf8_messages;
@@ -2857,6 +2916,55 @@ test_find_interval (void)
   g_time_zone_unref (tz);
 }
 
+static void
+test_find_interval_order (void)
+{
+  GTimeZone *tz;
+  gint intervals[200];
+  gint64 start, step;
+  gsize i;
+
+#ifdef G_OS_UNIX
+  tz = g_time_zone_new_identifier ("America/Toronto");
+#elif defined G_OS_WIN32
+  tz = g_time_zone_new_identifier ("Eastern Standard Time");
+#endif
+  g_assert_nonnull (tz);
+
+  /* Roughly every six weeks from 1900 */
+  start = G_GINT64_CONSTANT (-2208988800);
+  step = 42 * 24 * 60 * 60 + 1234;
+
+  for (i = 0; i < G_N_ELEMENTS (intervals); i++)
+    {
+      intervals[i] = g_time_zone_find_interval (tz, G_TIME_TYPE_UNIVERSAL,
+                                                start + (gint64) i * step);
+      g_assert_cmpint (intervals[i], >=, 0);
+      if (i > 0)
+        g_assert_cmpint (intervals[i], >=, intervals[i - 1]);
+    }
+
+  /* Looking up the same times out of order must give the same results */
+  for (i = G_N_ELEMENTS (intervals); i > 0; i--)
+    g_assert_cmpint (g_time_zone_find_interval (tz, G_TIME_TYPE_UNIVERSAL,
+                                                start + (gint64) (i - 1) * step),
+                     ==, intervals[i - 1]);
+
+  for (i = 0; i < G_N_ELEMENTS (intervals); i += 7)
+    {
+      gsize j = (i * 31) % G_N_ELEMENTS (intervals);
+
+      g_assert_cmpint (g_time_zone_find_interval (tz, G_TIME_TYPE_UNIVERSAL,
+                                                  start + (gint64) j * step),
+                       ==, intervals[j]);
+      g_assert_cmpint (g_time_zone_find_interval (tz, G_TIME_TYPE_UNIVERSAL,
+                                                  start + (gint64) i * step),
+                       ==, intervals[i]);
+    }
+
+  g_time_zone_unref (tz);
+}
+
 static void
 test_adjust_time (void)
 {
@@ -3492,6 +3600,7 @@ main (gint   argc,
   g_test_add_func ("/GDateTime/non_utf8_printf", test_non_utf8_printf);
   g_test_add_func ("/GDateTime/format_unrepresentable", test_format_unrepresentable);
   g_test_add_func ("/GDateTime/format_iso8601", test_format_iso8601);
+  g_test_add_func ("/GDateTime/format_to_buffer", test_format_to_buffer);
   g_test_add_data_func ("/GDateTime/format_mixed/utf8_time_non_utf8_messages",
                         &utf8_time_non_utf8_messages,
                         test_format_time_mixed_utf8);
@@ -3522,6 +3631,7 @@ main (gint   argc,
   g_test_add_func ("/GDateTime/unix_usec", test_date_time_unix_usec);
 
   g_test_add_func ("/GTimeZone/find-interval", test_find_interval);
+  g_test_add_func ("/GTimeZone/find-interval-order", test_find_interval_order);
   g_test_add_func ("/GTimeZone/adjust-time", test_adjust_time);
   g_test_add_func ("/GTimeZone/no-header", test_no_header);
   g_test_add_func ("/GTimeZone/no-header-identifier", test_no_header_identifier);
@@ -1091,6 +1091,35 @@ test_gvarianttypeinfo (void)
   g_variant_type_info_assert_no_infos ();
 }
 
+static void
+test_gvarianttypeinfo_pinned (void)
+{
+  GVariantTypeInfo *info1, *info2;
+  GVariantType *type;
+
+  /* Common types stay interned once all references are dropped */
+  info1 = g_variant_type_info_get (G_VARIANT_TYPE_VARDICT);
+  g_variant_type_info_unref (info1);
+  info2 = g_variant_type_info_get (G_VARIANT_TYPE_VARDICT);
+  g_assert_true (info1 == info2);
+  g_assert_true (g_variant_type_info_element (info2) ==
+                 g_variant_type_info_get (G_VARIANT_TYPE ("{sv}")));
+  g_variant_type_info_unref (g_variant_type_info_element (info2));
+  g_variant_type_info_unref (info2);
+
+  /* Others are still freed, including ones with long type strings */
+  type = g_variant_type_new ("(a{sv}a{sv}a{sv}a{sv}a{sv}a{sv}a{sv}a{sv}a{sv}a{sv}a{sv}a{sv}a{sv})");
+  info1 = g_variant_type_info_get (type);
+  info2 = g_variant_type_info_get (type);
+  g_assert_true (info1 == info2);
+  g_assert_cmpstr (g_variant_type_info_get_type_string (info1), ==, g_variant_type_peek_string (type));
+  g_variant_type_info_unref (info2);
+  g_variant_type_info_unref (info1);
+  g_variant_type_free (type);
+
+  g_variant_type_info_assert_no_infos ();
+}
+
 #define MAX_FIXED_MULTIPLIER    256
 #define MAX_INSTANCE_SIZE       1024
 #define MAX_ARRAY_CHILDREN      128
@@ -3874,6 +3903,65 @@ test_gv_byteswap (void)
   g_free (string);
 }
 
+static void
+test_gv_byteswap_take (void)
+{
+  const gchar *texts[] = {
+    "[(1, 2), (-3, 4)]",
+    "[uint64 1, 2, 18446744073709551615]",
+    "[(int16 1, uint16 2), (3, 4)]",
+    "[(byte 1, 2), (3, 4)]",
+    "{'a': <(1, int64 2)>, 'b': <[1.5, 2.5]>}",
+    "@at []",
+  };
+  guint32 words[] = { 1, 2, 3, 4 };
+  GVariant *value, *swapped, *swapped_take;
+  GBytes *bytes;
+  gconstpointer data;
+  gsize i;
+
+  for (i = 0; i < G_N_ELEMENTS (texts); i++)
+    {
+      value = g_variant_parse (NULL, texts[i], NULL, NULL, NULL);
+      g_variant_ref_sink (value);
+
+      swapped = g_variant_byteswap (value);
+      swapped_take = g_variant_byteswap_take (g_variant_ref (value));
+      g_assert_cmpvariant (swapped, swapped_take);
+      g_assert_cmpmem (g_variant_get_data (swapped), g_variant_get_size (swapped),
+                       g_variant_get_data (swapped_take), g_variant_get_size (swapped_take));
+
+      /* Swapping back gives the original value */
+      swapped_take = g_variant_byteswap_take (swapped_take);
+      g_assert_cmpvariant (value, swapped_take);
+
+      g_variant_unref (swapped_take);
+      g_variant_unref (swapped);
+      g_variant_unref (value);
+    }
+
+  /* Data nothing else references is swapped in place */
+  bytes = g_bytes_new (words, sizeof (words));
+  value = g_variant_new_from_bytes (G_VARIANT_TYPE ("a(uu)"), bytes, TRUE);
+  g_bytes_unref (bytes);
+  data = g_variant_get_data (value);
+  swapped = g_variant_byteswap_take (value);
+  g_assert_true (g_variant_get_data (swapped) == data);
+  value = g_variant_ref_sink (g_variant_new_parsed ("[(uint32 0x1000000, uint32 0x2000000), (0x3000000, 0x4000000)]"));
+  g_assert_cmpvariant (swapped, value);
+  g_variant_unref (value);
+  g_variant_unref (swapped);
+
+  /* and copied otherwise */
+  bytes = g_bytes_new (words, sizeof (words));
+  value = g_variant_new_from_bytes (G_VARIANT_TYPE ("a(uu)"), bytes, TRUE);
+  swapped = g_variant_byteswap_take (value);
+  g_assert_true (g_variant_get_data (swapped) != g_bytes_get_data (bytes, NULL));
+  g_assert_cmpmem (g_bytes_get_data (bytes, NULL), g_bytes_get_size (bytes), words, sizeof (words));
+  g_variant_unref (swapped);
+  g_bytes_unref (bytes);
+}
+
 static void
 test_gv_byteswap_non_normal_non_aligned (void)
 {
@@ -4255,6 +4343,114 @@ test_parser_integer_bounds (void)
 #undef test_bound
 }
 
+/* Test the fast path for arrays of basic types of a known type against the
+ * generic parser, which is used when the type is not known. */
+static void
+test_parser_basic_arrays (void)
+{
+  const struct {
+    const gchar *type;
+    const gchar *text;
+  } arrays[] = {
+    { "ab", "[true, false, true]" },
+    { "ay", "[0, 255, 0x10]" },
+    { "an", "[-32768, 32767, -0, +5]" },
+    { "aq", "[0, 65535]" },
+    { "ai", "[-2147483648, 2147483647, 0x7fffffff, -0x10]" },
+    { "au", "[0, 4294967295]" },
+    { "ax", "[-9223372036854775808, 9223372036854775807]" },
+    { "at", "[0, 18446744073709551615]" },
+    { "ah", "[-1, 1]" },
+    { "ad", "[1, -2.5, 1e10, .5]" },
+    { "as", "['a', \"b'c\", '\\u00e9\\n', '']" },
+    { "ao", "['/', '/org/gtk/GLib']" },
+    { "ag", "['', 'a{sv}']" },
+    { "ai", "[]" },
+    { "ai", "  [ 1 ,2 ]  " },
+  };
+  const struct {
+    const gchar *type;
+    const gchar *text;
+    GVariantParseError error;
+  } errors[] = {
+    { "ay", "[1, 256]", G_VARIANT_PARSE_ERROR_NUMBER_OUT_OF_RANGE },
+    { "au", "[1, -1]", G_VARIANT_PARSE_ERROR_NUMBER_OUT_OF_RANGE },
+    { "ai", "[1, 2,]", G_VARIANT_PARSE_ERROR_VALUE_EXPECTED },
+    { "ai", "[1, 2", G_VARIANT_PARSE_ERROR_UNEXPECTED_TOKEN },
+    { "ai", "[1, 2] 3", G_VARIANT_PARSE_ERROR_INPUT_NOT_AT_END },
+    { "ai", "[1, 2x]", G_VARIANT_PARSE_ERROR_INVALID_CHARACTER },
+    { "ao", "['/', 'a']", G_VARIANT_PARSE_ERROR_INVALID_OBJECT_PATH },
+  };
+  GString *large;
+  GVariant *value, *expected;
+  gchar *text;
+  gsize i;
+
+  for (i = 0; i < G_N_ELEMENTS (arrays); i++)
+    {
+      GError *local_error = NULL;
+
+      value = g_variant_parse (G_VARIANT_TYPE (arrays[i].type), arrays[i].text,
+                               NULL, NULL, &local_error);
+      g_assert_no_error (local_error);
+
+      text = g_strdup_printf ("@%s %s", arrays[i].type, arrays[i].text);
+      expected = g_variant_parse (NULL, text, NULL, NULL, &local_error);
+      g_assert_no_error (local_error);
+      g_free (text);
+
+      g_assert_cmpvariant (value, expected);
+      g_assert_cmpmem (g_variant_get_data (value), g_variant_get_size (value),
+                       g_variant_get_data (expected), g_variant_get_size (expected));
+
+      g_variant_unref (expected);
+      g_variant_unref (value);
+    }
+
+  for (i = 0; i < G_N_ELEMENTS (errors); i++)
+    {
+      GError *local_error = NULL;
+
+      value = g_variant_parse (G_VARIANT_TYPE (errors[i].type), errors[i].text,
+                               NULL, NULL, &local_error);
+      g_assert_error (local_error, G_VARIANT_PARSE_ERROR, (gint) errors[i].error);
+      g_assert_null (value);
+      g_clear_error (&local_error);
+    }
+
+  /* Printing arrays of numbers doesn't go through each element either */
+  large = g_string_new ("[");
+  for (i = 0; i < 10000; i++)
+    g_string_append_printf (large, "%s%" G_GSIZE_FORMAT, i ? ", " : "", i * 7);
+  g_string_append_c (large, ']');
+
+  value = g_variant_parse (G_VARIANT_TYPE ("ai"), large->str, NULL, NULL, NULL);
+  g_assert_cmpuint (g_variant_n_children (value), ==, 10000);
+  text = g_variant_print (value, FALSE);
+  g_assert_cmpstr (text, ==, large->str);
+  g_free (text);
+  g_variant_unref (value);
+  g_string_free (large, TRUE);
+
+  value = g_variant_ref_sink (g_variant_new_parsed ("[int16 -1, 2]"));
+  text = g_variant_print (value, TRUE);
+  g_assert_cmpstr (text, ==, "[int16 -1, 2]");
+  g_free (text);
+  g_variant_unref (value);
+
+  value = g_variant_ref_sink (g_variant_new_parsed ("[byte 1, 0]"));
+  text = g_variant_print (value, TRUE);
+  g_assert_cmpstr (text, ==, "[byte 0x01, 0x00]");
+  g_free (text);
+  g_variant_unref (value);
+
+  value = g_variant_ref_sink (g_variant_new_parsed ("[1.0, -2.5]"));
+  text = g_variant_print (value, TRUE);
+  g_assert_cmpstr (text, ==, "[1.0, -2.5]");
+  g_free (text);
+  g_variant_unref (value);
+}
+
 /* Test that #GVariants which recurse too deeply are rejected. */
 static void
 test_parser_recursion (void)
@@ -4618,6 +4814,113 @@ untrusted (GVariant *a)
   return b;
 }
 
+/* Builds a serialized a{sv} with @n_entries entries "key0": <0>, ... */
+static GVariant *
+new_large_vardict (guint    n_entries,
+                   gboolean duplicate)
+{
+  GVariantBuilder builder;
+  guint i;
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
+  for (i = 0; i < n_entries; i++)
+    {
+      gchar key[16];
+
+      g_snprintf (key, sizeof key, "key%u", i);
+      g_variant_builder_add (&builder, "{sv}", key, g_variant_new_uint32 (i));
+    }
+  if (duplicate)
+    g_variant_builder_add (&builder, "{sv}", "key1", g_variant_new_uint32 (G_MAXUINT32));
+
+  return untrusted (g_variant_ref_sink (g_variant_builder_end (&builder)));
+}
+
+static void
+test_lookup_indexed (void)
+{
+  GVariant *dict;
+  GVariant *value;
+  guint num;
+  guint i;
+
+  g_test_summary ("Test lookups in dictionaries large enough to be indexed");
+
+  dict = new_large_vardict (200, TRUE);
+
+  for (i = 0; i < 200; i++)
+    {
+      gchar key[16];
+
+      g_snprintf (key, sizeof key, "key%u", i);
+      g_assert_true (g_variant_lookup (dict, key, "u", &num));
+      g_assert_cmpuint (num, ==, i);
+    }
+
+  g_assert_false (g_variant_lookup (dict, "key200", "u", &num));
+  g_assert_false (g_variant_lookup (dict, "key1", "s", NULL));
+
+  /* Like the linear scan, the first of duplicate keys wins */
+  value = g_variant_lookup_value (dict, "key1", G_VARIANT_TYPE_UINT32);
+  g_assert_nonnull (value);
+  g_assert_cmpuint (g_variant_get_uint32 (value), ==, 1);
+  g_variant_unref (value);
+
+  g_variant_unref (dict);
+}
+
+static void
+test_dict_indexed (void)
+{
+  GVariantDict dict;
+  GVariant *asv;
+  GVariant *result;
+  guint num;
+
+  g_test_summary ("Test GVariantDict on a dictionary large enough to be "
+                  "kept in serialized form");
+
+  asv = new_large_vardict (100, FALSE);
+
+  /* Unmodified, the data is passed through */
+  g_variant_dict_init (&dict, asv);
+  g_assert_true (g_variant_dict_contains (&dict, "key42"));
+  result = g_variant_ref_sink (g_variant_dict_end (&dict));
+  g_assert_true (g_variant_equal (result, asv));
+  g_variant_unref (result);
+
+  g_variant_dict_init (&dict, asv);
+  g_assert_true (g_variant_dict_lookup (&dict, "key7", "u", &num));
+  g_assert_cmpuint (num, ==, 7);
+  g_assert_false (g_variant_dict_lookup (&dict, "key7", "s", NULL));
+  g_assert_false (g_variant_dict_contains (&dict, "extra"));
+
+  g_variant_dict_insert (&dict, "key7", "s", "seven");
+  g_variant_dict_insert (&dict, "extra", "u", 1000);
+  g_assert_true (g_variant_dict_remove (&dict, "key8"));
+  g_assert_false (g_variant_dict_remove (&dict, "key8"));
+  g_assert_false (g_variant_dict_contains (&dict, "key8"));
+  g_assert_null (g_variant_dict_lookup_value (&dict, "key8", NULL));
+  g_assert_true (g_variant_dict_remove (&dict, "key9"));
+  g_variant_dict_insert (&dict, "key9", "u", 99);
+  g_assert_true (g_variant_dict_remove (&dict, "extra"));
+  g_variant_dict_insert (&dict, "extra", "u", 1001);
+
+  result = g_variant_ref_sink (g_variant_dict_end (&dict));
+  g_assert_cmpuint (g_variant_n_children (result), ==, 100);
+  g_assert_true (g_variant_lookup (result, "key6", "u", &num));
+  g_assert_cmpuint (num, ==, 6);
+  g_assert_true (g_variant_lookup (result, "key7", "&s", NULL));
+  g_assert_false (g_variant_lookup (result, "key8", "u", &num));
+  g_assert_true (g_variant_lookup (result, "key9", "u", &num));
+  g_assert_cmpuint (num, ==, 99);
+  g_assert_true (g_variant_lookup (result, "extra", "u", &num));
+  g_assert_cmpuint (num, ==, 1001);
+  g_variant_unref (result);
+
+  g_variant_unref (asv);
+}
+
 static void
 test_compare (void)
 {
@@ -5311,6 +5614,61 @@ test_normal_checking_array_offsets2 (void)
   g_variant_unref (variant);
 }
 
+/* Test that out-of-order offsets are found anywhere in a large array, including
+ * at the boundaries of the blocks which the offsets are checked in. */
+static void
+test_normal_checking_array_offsets_unordered (void)
+{
+  const gsize positions[] = { 1, 63, 64, 65, 128, 500, 999 };
+  GVariantBuilder builder;
+  GVariant *constructed;
+  gsize i, j;
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE_STRING_ARRAY);
+  for (i = 0; i < 1000; i++)
+    g_variant_builder_add (&builder, "s", (i % 2) ? "odd" : "even");
+  constructed = g_variant_ref_sink (g_variant_builder_end (&builder));
+
+  /* 2 byte offsets */
+  g_assert_cmpuint (g_variant_get_size (constructed), >, G_MAXUINT8);
+  g_assert_cmpuint (g_variant_get_size (constructed), <=, G_MAXUINT16);
+
+  for (i = 0; i < G_N_ELEMENTS (positions); i++)
+    {
+      gsize size = g_variant_get_size (constructed);
+      guint8 *data = g_memdup2 (g_variant_get_data (constructed), size);
+      guint8 *offsets = data + (data[size - 2] | (data[size - 1] << 8));
+      gsize k = positions[i];
+      guint16 previous_end = offsets[2 * (k - 1)] | (offsets[2 * (k - 1) + 1] << 8);
+      GVariant *variant;
+
+      /* Make element @k end before element @k - 1 does */
+      offsets[2 * k] = (previous_end - 1) & 0xff;
+      offsets[2 * k + 1] = (previous_end - 1) >> 8;
+
+      variant = g_variant_new_from_data (G_VARIANT_TYPE_STRING_ARRAY, data, size,
+                                         FALSE, g_free, data);
+      g_variant_ref_sink (variant);
+
+      /* Accessing the last element checks all the offsets before it */
+      for (j = 0; j < 2; j++)
+        {
+          gsize index = j ? k - 1 : 999;
+          GVariant *child = g_variant_get_child_value (variant, index);
+          const gchar *expected = (index >= k) ? "" : (index % 2) ? "odd" : "even";
+
+          g_assert_cmpstr (g_variant_get_string (child, NULL), ==, expected);
+          g_variant_unref (child);
+        }
+
+      g_assert_false (g_variant_is_normal_form (variant));
+
+      g_variant_unref (variant);
+    }
+
+  g_variant_unref (constructed);
+}
+
 /* Test that an otherwise-valid serialised GVariant is considered non-normal if
  * its offset table entries are too wide.
  *
@@ -5807,6 +6165,119 @@ test_unaligned_construction (void)
     }
 }
 
+/* Checks that @written is byte-for-byte the serialisation of @expected */
+static void
+assert_written_equal (GVariant *written,
+                      GVariant *expected)
+{
+  g_variant_ref_sink (written);
+  g_variant_ref_sink (expected);
+
+  g_assert_cmpvariant (written, expected);
+  g_assert_cmpmem (g_variant_get_data (written), g_variant_get_size (written),
+                   g_variant_get_data (expected), g_variant_get_size (expected));
+  g_assert_true (g_variant_is_normal_form (written));
+
+  g_variant_unref (written);
+  g_variant_unref (expected);
+}
+
+static void
+test_writer (void)
+{
+  GVariantWriter *writer;
+  GVariantBuilder builder;
+  guint i;
+
+  /* A dictionary large enough to need two byte offsets */
+  writer = g_variant_writer_new (G_VARIANT_TYPE_VARDICT);
+  g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
+  for (i = 0; i < 100; i++)
+    {
+      gchar *key = g_strdup_printf ("key%u", i);
+
+      g_variant_writer_open (writer, G_VARIANT_TYPE ("{sv}"));
+      g_variant_writer_add (writer, "s", key);
+      g_variant_writer_open (writer, G_VARIANT_TYPE_VARIANT);
+      if (i % 3 == 0)
+        g_variant_writer_add (writer, "u", i);
+      else if (i % 3 == 1)
+        g_variant_writer_add (writer, "(ds)", i / 2.0, key);
+      else
+        g_variant_writer_add_value (writer, g_variant_new_byte (i));
+      g_variant_writer_close (writer);
+      g_variant_writer_close (writer);
+
+      if (i % 3 == 0)
+        g_variant_builder_add (&builder, "{sv}", key, g_variant_new_uint32 (i));
+      else if (i % 3 == 1)
+        g_variant_builder_add (&builder, "{sv}", key, g_variant_new ("(ds)", i / 2.0, key));
+      else
+        g_variant_builder_add (&builder, "{sv}", key, g_variant_new_byte (i));
+
+      g_free (key);
+    }
+  assert_written_equal (g_variant_writer_end (writer), g_variant_builder_end (&builder));
+  g_variant_writer_free (writer);
+
+  /* Fixed and variable sized tuples, maybes and empty containers */
+  writer = g_variant_writer_new (G_VARIANT_TYPE ("(y(yx)msmias()ao(bn))"));
+  g_variant_writer_add (writer, "y", 1);
+  g_variant_writer_open (writer, G_VARIANT_TYPE ("(yx)"));
+  g_variant_writer_add (writer, "y", 2);
+  g_variant_writer_add (writer, "x", G_GINT64_CONSTANT (-3));
+  g_variant_writer_close (writer);
+  g_variant_writer_open (writer, G_VARIANT_TYPE ("ms"));
+  g_variant_writer_add (writer, "s", "maybe");
+  g_variant_writer_close (writer);
+  g_variant_writer_open (writer, G_VARIANT_TYPE ("mi"));
+  g_variant_writer_close (writer);
+  g_variant_writer_open (writer, G_VARIANT_TYPE_STRING_ARRAY);
+  g_variant_writer_add (writer, "s", "");
+  g_variant_writer_add (writer, "s", "two");
+  g_variant_writer_close (writer);
+  g_variant_writer_open (writer, G_VARIANT_TYPE_UNIT);
+  g_variant_writer_close (writer);
+  g_variant_writer_open (writer, G_VARIANT_TYPE_OBJECT_PATH_ARRAY);
+  g_variant_writer_close (writer);
+  g_variant_writer_add (writer, "(bn)", TRUE, -5);
+  assert_written_equal (g_variant_writer_end (writer),
+                        g_variant_new_parsed ("(byte 1, (byte 2, int64 -3), @ms 'maybe', @mi nothing, "
+                                              "['', 'two'], (), @ao [], (true, int16 -5))"));
+  g_variant_writer_free (writer);
+
+  /* Nested variants and arrays of fixed size values */
+  writer = g_variant_writer_new (G_VARIANT_TYPE ("(vat)"));
+  g_variant_writer_open (writer, G_VARIANT_TYPE_VARIANT);
+  g_variant_writer_open (writer, G_VARIANT_TYPE_VARIANT);
+  g_variant_writer_add (writer, "g", "a{sv}");
+  g_variant_writer_close (writer);
+  g_variant_writer_close (writer);
+  g_variant_writer_open (writer, G_VARIANT_TYPE ("at"));
+  g_variant_writer_add (writer, "t", G_GUINT64_CONSTANT (1));
+  g_variant_writer_add (writer, "t", G_MAXUINT64);
+  g_variant_writer_close (writer);
+  assert_written_equal (g_variant_writer_end (writer),
+                        g_variant_new_parsed ("(<<signature 'a{sv}'>>, [uint64 1, 18446744073709551615])"));
+  g_variant_writer_free (writer);
+
+  if (!g_test_undefined ())
+    return;
+
+  /* Values of the wrong type are rejected */
+  writer = g_variant_writer_new (G_VARIANT_TYPE ("(ss)"));
+  g_variant_writer_add (writer, "s", "one");
+  g_test_expect_message (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL, "*can not add a value of type 'u'*");
+  g_variant_writer_add (writer, "u", 2);
+  g_test_assert_expected_messages ();
+  g_test_expect_message (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL, "*must have 2 values*");
+  g_assert_null (g_variant_writer_end (writer));
+  g_test_assert_expected_messages ();
+  g_variant_writer_add (writer, "s", "two");
+  assert_written_equal (g_variant_writer_end (writer), g_variant_new_parsed ("('one', 'two')"));
+  g_variant_writer_free (writer);
+}
+
 int
 main (int argc, char **argv)
 {
@@ -5820,6 +6291,7 @@ main (int argc, char **argv)
   g_test_add_func ("/gvariant/type/string-scan/recursion/array",
                    test_gvarianttype_string_scan_recursion_array);
   g_test_add_func ("/gvariant/typeinfo", test_gvarianttypeinfo);
+  g_test_add_func ("/gvariant/typeinfo/pinned", test_gvarianttypeinfo_pinned);
   g_test_add_func ("/gvariant/serialiser/maybe", test_maybes);
   g_test_add_func ("/gvariant/serialiser/array", test_arrays);
   g_test_add_func ("/gvariant/serialiser/tuple", test_tuples);
@@ -5849,9 +6321,11 @@ main (int argc, char **argv)
   g_test_add_func ("/gvariant/builder-memory", test_builder_memory);
   g_test_add_func ("/gvariant/hashing", test_hashing);
   g_test_add_func ("/gvariant/byteswap", test_gv_byteswap);
+  g_test_add_func ("/gvariant/byteswap/take", test_gv_byteswap_take);
   g_test_add_func ("/gvariant/byteswap/non-normal-non-aligned", test_gv_byteswap_non_normal_non_aligned);
   g_test_add_func ("/gvariant/parser", test_parses);
   g_test_add_func ("/gvariant/parser/integer-bounds", test_parser_integer_bounds);
+  g_test_add_func ("/gvariant/parser/basic-arrays", test_parser_basic_arrays);
   g_test_add_func ("/gvariant/parser/recursion", test_parser_recursion);
   g_test_add_func ("/gvariant/parser/recursion/typedecls", test_parser_recursion_typedecls);
   g_test_add_func ("/gvariant/parser/recursion/maybes", test_parser_recursion_maybes);
@@ -5864,6 +6338,8 @@ main (int argc, char **argv)
   g_test_add_func ("/gvariant/bytestring", test_bytestring);
   g_test_add_func ("/gvariant/lookup-value", test_lookup_value);
   g_test_add_func ("/gvariant/lookup", test_lookup);
+  g_test_add_func ("/gvariant/lookup/indexed", test_lookup_indexed);
+  g_test_add_func ("/gvariant/dict/indexed", test_dict_indexed);
   g_test_add_func ("/gvariant/compare", test_compare);
   g_test_add_func ("/gvariant/equal", test_equal);
   g_test_add_func ("/gvariant/fixed-array", test_fixed_array);
@@ -5887,6 +6363,8 @@ main (int argc, char **argv)
                    test_normal_checking_array_offsets);
   g_test_add_func ("/gvariant/normal-checking/array-offsets2",
                    test_normal_checking_array_offsets2);
+  g_test_add_func ("/gvariant/normal-checking/array-offsets/unordered",
+                   test_normal_checking_array_offsets_unordered);
   g_test_add_func ("/gvariant/normal-checking/array-offsets/minimal-sized",
                    test_normal_checking_array_offsets_minimal_sized);
   g_test_add_func ("/gvariant/normal-checking/tuple-offsets",
@@ -5912,5 +6390,7 @@ main (int argc, char **argv)
   g_test_add_func ("/gvariant/unaligned-construction",
                    test_unaligned_construction);
 
+  g_test_add_func ("/gvariant/writer", test_writer);
+
   return g_test_run ();
 }
@@ -1430,13 +1430,16 @@ struct _GHashTable
   guint            mask;
   gint             nnodes;
   gint             noccupied;  /* nnodes + tombstones */
+  guint            reserved;
 
   guint            have_big_keys : 1;
   guint            have_big_values : 1;
+  guint            inline_storage : 1;
 
   gpointer        *keys;
   guint           *hashes;
   gpointer        *values;
+  guint8          *ctrl;
 
   GHashFunc        hash_func;
   GEqualFunc       key_equal_func;
@@ -1496,6 +1499,17 @@ check_data (GHashTable *h)
         {
           g_assert_cmpint (h->hashes[i], ==, h->hash_func (fetch_key_or_value (h->keys, i, h->have_big_keys)));
         }
+
+      /* Control bytes of grouped tables: a 7-bit tag, empty or tombstone */
+      if (h->ctrl != NULL)
+        {
+          if (h->hashes[i] == 0)
+            g_assert_cmpuint (h->ctrl[i], ==, 0x80);
+          else if (h->hashes[i] == 1)
+            g_assert_cmpuint (h->ctrl[i], ==, 0xfe);
+          else
+            g_assert_cmpuint (h->ctrl[i], <, 0x80);
+        }
     }
 }
 
@@ -1894,6 +1908,333 @@ test_primes (void)
   g_assert_cmpfloat (max, <, 2.0);
 }
 
+/* Test that reserving space sizes the table once, and that the
+ * reservation survives until it has been filled */
+static void
+test_reserve (void)
+{
+  GHashTable *h;
+  gsize size;
+  guint i;
+
+  h = g_hash_table_new (NULL, NULL);
+  g_hash_table_reserve (h, 1000);
+  size = h->size;
+  g_assert_cmpuint (size, >=, 1000);
+  check_consistency (h);
+
+  /* Inserting the first few entries does not shrink the table back.
+   * Keys start at 2, as smaller direct hashes are remapped. */
+  for (i = 2; i < 1002; i++)
+    {
+      g_hash_table_insert (h, GUINT_TO_POINTER (i), GUINT_TO_POINTER (i));
+      g_assert_cmpuint (h->size, ==, size);
+    }
+  check_consistency (h);
+  g_assert_cmpuint (h->reserved, ==, 0);
+
+  /* Reserving less than the current size does nothing */
+  g_hash_table_reserve (h, 10);
+  g_assert_cmpuint (h->size, ==, size);
+
+  /* Once filled, the table shrinks normally again */
+  for (i = 2; i < 1002; i++)
+    g_hash_table_remove (h, GUINT_TO_POINTER (i));
+  g_assert_cmpuint (h->size, <, size);
+  check_consistency (h);
+
+  /* remove_all() drops an unfilled reservation */
+  g_hash_table_reserve (h, 1000);
+  g_hash_table_insert (h, GUINT_TO_POINTER (2), GUINT_TO_POINTER (2));
+  g_hash_table_remove_all (h);
+  g_assert_cmpuint (h->reserved, ==, 0);
+
+  g_hash_table_unref (h);
+}
+
+static void
+test_insert_many (void)
+{
+  GHashTable *h;
+  gpointer keys[500];
+  gpointer values[500];
+  gsize size;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (keys); i++)
+    {
+      keys[i] = g_strdup_printf ("%u", i);
+      values[i] = GUINT_TO_POINTER (i);
+    }
+
+  /* As a map */
+  h = g_hash_table_new (g_str_hash, g_str_equal);
+  g_assert_cmpuint (g_hash_table_insert_many (h, keys, values, G_N_ELEMENTS (keys)), ==, 500);
+  g_assert_cmpuint (g_hash_table_size (h), ==, 500);
+  g_assert_true (h->keys != h->values);
+  check_consistency (h);
+  for (i = 0; i < G_N_ELEMENTS (keys); i++)
+    g_assert_cmpuint (GPOINTER_TO_UINT (g_hash_table_lookup (h, keys[i])), ==, i);
+
+  /* Inserting the same keys again adds nothing and does not resize */
+  size = h->size;
+  g_assert_cmpuint (g_hash_table_insert_many (h, keys, values, 250), ==, 0);
+  g_assert_cmpuint (h->size, ==, size);
+  g_assert_cmpuint (g_hash_table_insert_many (h, NULL, NULL, 0), ==, 0);
+  g_hash_table_unref (h);
+
+  /* As a set, which keeps a single array for keys and values */
+  h = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  g_assert_cmpuint (g_hash_table_insert_many (h, keys, NULL, G_N_ELEMENTS (keys)), ==, 500);
+  g_assert_true (h->keys == h->values);
+  check_consistency (h);
+  for (i = 0; i < G_N_ELEMENTS (keys); i++)
+    g_assert_true (g_hash_table_lookup (h, keys[i]) == keys[i]);
+  g_hash_table_unref (h);
+}
+
+/* Not g_str_hash() itself, so tables using it keep the classic layout */
+static guint
+classic_str_hash (gconstpointer key)
+{
+  return g_str_hash (key);
+}
+
+/* Tables of the minimum size keep everything in one allocation, see
+ * INLINE_SIZE in ghash.c, which must survive set to map conversion,
+ * widening of entries and resizing in both directions */
+static void
+test_small_tables (void)
+{
+  GHashTable *h;
+  gpointer big = (gpointer) (guintptr) G_MAXSIZE;
+  guint i;
+
+  h = g_hash_table_new (NULL, NULL);
+  g_assert_cmpuint (h->size, ==, 8);
+  g_assert_true (h->inline_storage);
+  g_assert_true (h->keys == h->values);
+
+  /* Keys start at 2, as smaller direct hashes are remapped */
+  for (i = 2; i < 7; i++)
+    g_hash_table_add (h, GUINT_TO_POINTER (i));
+  g_assert_true (h->keys == h->values);
+  check_consistency (h);
+
+  /* Becomes a map, then gets big keys and values */
+  g_hash_table_insert (h, GUINT_TO_POINTER (7), GUINT_TO_POINTER (70));
+  g_assert_true (h->keys != h->values);
+  g_hash_table_remove (h, GUINT_TO_POINTER (2));
+  g_hash_table_insert (h, big, big);
+  g_assert_cmpuint (h->size, ==, 8);
+  g_assert_true (h->inline_storage);
+  check_consistency (h);
+
+  for (i = 3; i < 7; i++)
+    g_assert_true (g_hash_table_lookup (h, GUINT_TO_POINTER (i)) == GUINT_TO_POINTER (i));
+  g_assert_true (g_hash_table_lookup (h, GUINT_TO_POINTER (7)) == GUINT_TO_POINTER (70));
+  g_assert_true (g_hash_table_lookup (h, big) == big);
+  g_assert_false (g_hash_table_contains (h, GUINT_TO_POINTER (2)));
+
+  /* Growing moves to separate arrays */
+  for (i = 100; i < 200; i++)
+    g_hash_table_insert (h, GUINT_TO_POINTER (i), GUINT_TO_POINTER (i));
+  g_assert_cmpuint (h->size, >, 8);
+  g_assert_false (h->inline_storage);
+  check_consistency (h);
+
+  /* And shrinking back moves them into one allocation again */
+  for (i = 3; i < 6; i++)
+    g_hash_table_remove (h, GUINT_TO_POINTER (i));
+  for (i = 100; i < 200; i++)
+    g_hash_table_remove (h, GUINT_TO_POINTER (i));
+  g_assert_cmpuint (h->size, ==, 8);
+  g_assert_true (h->inline_storage);
+  check_consistency (h);
+
+  g_assert_true (g_hash_table_lookup (h, GUINT_TO_POINTER (6)) == GUINT_TO_POINTER (6));
+  g_assert_true (g_hash_table_lookup (h, GUINT_TO_POINTER (7)) == GUINT_TO_POINTER (70));
+  g_assert_true (g_hash_table_lookup (h, big) == big);
+
+  g_hash_table_remove_all (h);
+  check_consistency (h);
+  g_assert_true (h->inline_storage);
+
+  g_hash_table_unref (h);
+}
+
+static void
+test_grouped_probing (void)
+{
+  GHashTable *grouped, *classic;
+  GRand *rand;
+  gchar **keys;
+  guint n_keys = 2000;
+  guint i, j;
+
+  g_test_summary ("Test that string tables using grouped probing behave "
+                  "like tables using the classic layout under churn");
+
+  rand = g_rand_new_with_seed (42);
+  keys = g_new0 (gchar *, n_keys + 1);
+  for (i = 0; i < n_keys; i++)
+    keys[i] = g_strdup_printf ("key-%u", i);
+
+  grouped = g_hash_table_new (g_str_hash, g_str_equal);
+  classic = g_hash_table_new (classic_str_hash, g_str_equal);
+  g_assert_nonnull (grouped->ctrl);
+  g_assert_null (classic->ctrl);
+
+  for (j = 0; j < 20000; j++)
+    {
+      const gchar *key = keys[g_rand_int_range (rand, 0, n_keys)];
+      guint op = g_rand_int_range (rand, 0, 3);
+
+      if (op == 0)
+        {
+          g_assert_cmpint (g_hash_table_remove (grouped, key), ==,
+                           g_hash_table_remove (classic, key));
+        }
+      else
+        {
+          g_hash_table_insert (grouped, (gpointer) key, GUINT_TO_POINTER (j));
+          g_hash_table_insert (classic, (gpointer) key, GUINT_TO_POINTER (j));
+        }
+
+      /* Shrink now and then to move through all table sizes */
+      if (j % 5000 == 4999)
+        {
+          for (i = 0; i < n_keys; i += 2)
+            {
+              g_hash_table_remove (grouped, keys[i]);
+              g_hash_table_remove (classic, keys[i]);
+            }
+        }
+
+      if (j % 1000 == 0)
+        check_consistency (grouped);
+    }
+
+  check_consistency (grouped);
+  g_assert_cmpuint (g_hash_table_size (grouped), ==, g_hash_table_size (classic));
+  for (i = 0; i < n_keys; i++)
+    {
+      gpointer grouped_value, classic_value;
+      gboolean in_grouped, in_classic;
+
+      in_grouped = g_hash_table_lookup_extended (grouped, keys[i], NULL, &grouped_value);
+      in_classic = g_hash_table_lookup_extended (classic, keys[i], NULL, &classic_value);
+      g_assert_cmpint (in_grouped, ==, in_classic);
+      if (in_grouped)
+        g_assert_true (grouped_value == classic_value);
+    }
+
+  g_hash_table_remove_all (grouped);
+  check_consistency (grouped);
+  g_assert_null (g_hash_table_lookup (grouped, keys[0]));
+
+  g_hash_table_unref (grouped);
+  g_hash_table_unref (classic);
+  g_strfreev (keys);
+  g_rand_free (rand);
+}
+
+static void
+test_str_hash_fast (void)
+{
+  GHashTable *h;
+  gchar buf[200];
+  guint hashes[sizeof (buf)];
+  guint n_collisions = 0;
+  gsize len, i;
+
+  for (i = 0; i < sizeof (buf); i++)
+    buf[i] = 'a' + i % 26;
+
+  /* The same hash as g_str_hash_len(), across the lengths where the
+   * inputs are read differently */
+  for (len = 0; len < sizeof (buf); len++)
+    {
+      gchar *str = g_strndup (buf, len);
+
+      hashes[len] = g_str_hash_fast (str);
+      g_assert_cmpuint (hashes[len], ==, g_str_hash_len (buf, len));
+      g_assert_cmpuint (hashes[len], ==, g_str_hash_fast (str));
+
+      for (i = 0; i < len; i++)
+        if (hashes[i] == hashes[len])
+          n_collisions++;
+
+      g_free (str);
+    }
+
+  /* Prefixes of each other should practically never collide. The seed is
+   * random, so allow for one. */
+  g_assert_cmpuint (n_collisions, <=, 1);
+
+  g_assert_cmpuint (g_str_hash_len (NULL, 0), ==, g_str_hash_fast (""));
+
+  /* Nul bytes are hashed like any other */
+  g_assert_cmpuint (g_str_hash_len ("a\0b", 3), !=, g_str_hash_len ("a\0c", 3));
+
+  h = g_hash_table_new_full (g_str_hash_fast, g_str_equal, g_free, NULL);
+  g_assert_nonnull (h->ctrl);
+
+  for (i = 0; i < 1000; i++)
+    g_hash_table_add (h, g_strdup_printf ("/org/gtk/resource/%" G_GSIZE_FORMAT, i));
+
+  for (i = 0; i < 1000; i++)
+    {
+      gchar *key = g_strdup_printf ("/org/gtk/resource/%" G_GSIZE_FORMAT, i);
+
+      g_assert_true (g_hash_table_contains (h, key));
+      g_free (key);
+    }
+  g_assert_false (g_hash_table_contains (h, "/org/gtk/resource/"));
+
+  check_counts (h, 1000, 0);
+  g_hash_table_unref (h);
+}
+
+static void
+test_lookup_perf (gconstpointer data)
+{
+  GHashFunc hash_func = (GHashFunc) data;
+  GHashTable *h;
+  gchar **keys;
+  guint n_keys = g_test_perf () ? 1000000 : 1000;
+  guint n_misses = 0;
+  gdouble elapsed;
+  guint i;
+
+  keys = g_new0 (gchar *, n_keys + 1);
+  for (i = 0; i < n_keys; i++)
+    keys[i] = g_strdup_printf ("/org/gtk/resource/%u/path", i);
+
+  h = g_hash_table_new (hash_func, g_str_equal);
+  for (i = 0; i < n_keys; i += 2)
+    g_hash_table_insert (h, keys[i], keys[i]);
+
+  /* Half hits, half misses, in random order */
+  g_test_timer_start ();
+  for (i = 0; i < n_keys; i++)
+    {
+      guint k = ((guint64) i * 7919) % n_keys;
+
+      if (g_hash_table_lookup (h, keys[k]) == NULL)
+        n_misses++;
+    }
+  elapsed = g_test_timer_elapsed ();
+
+  g_assert_cmpuint (n_misses, ==, n_keys / 2);
+  g_test_minimized_result (elapsed, "%u string lookups in %6.4f seconds (%s)",
+                           n_keys, elapsed,
+                           (h->ctrl != NULL) ? "grouped" : "classic");
+
+  g_hash_table_unref (h);
+  g_strfreev (keys);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1910,6 +2251,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/hash/double", double_hash_test);
   g_test_add_func ("/hash/double/collisions", double_hash_collision_test);
   g_test_add_func ("/hash/string", string_hash_test);
+  g_test_add_func ("/hash/string/fast", test_str_hash_fast);
   g_test_add_func ("/hash/set", set_hash_test);
   g_test_add_func ("/hash/set-ref", set_ref_hash_test);
   g_test_add_func ("/hash/ref", test_hash_ref);
@@ -1925,6 +2267,13 @@ main (int argc, char *argv[])
   g_test_add_func ("/hash/steal-all-values", test_steal_all_values);
   g_test_add_func ("/hash/lookup-extended", test_lookup_extended);
   g_test_add_func ("/hash/new-similar", test_new_similar);
+  g_test_add_func ("/hash/grouped-probing", test_grouped_probing);
+  g_test_add_func ("/hash/reserve", test_reserve);
+  g_test_add_func ("/hash/small-tables", test_small_tables);
+  g_test_add_func ("/hash/insert-many", test_insert_many);
+  g_test_add_data_func ("/hash/perf/lookup/classic", (gconstpointer) classic_str_hash, test_lookup_perf);
+  g_test_add_data_func ("/hash/perf/lookup/grouped", (gconstpointer) g_str_hash, test_lookup_perf);
+  g_test_add_data_func ("/hash/perf/lookup/fast", (gconstpointer) g_str_hash_fast, test_lookup_perf);
 
   /* tests for individual bugs */
   g_test_add_func ("/hash/lookup-null-key", test_lookup_null_key);
@@ -216,6 +216,118 @@ test_read_line_embedded_nuls (void)
   g_free (filename);
 }
 
+static void
+test_read_line_borrowed (void)
+{
+  GString *contents = g_string_new (NULL);
+  gint fd;
+  gchar *filename = NULL;
+  GIOChannel *channel = NULL;
+  GError *local_error = NULL;
+  const gchar *line;
+  gchar *copied;
+  gchar chars[4];
+  gsize line_length, terminator_pos, bytes_read;
+  GIOStatus status;
+  guint i;
+
+  g_test_summary ("Test that borrowed lines can be mixed with the other read "
+                  "functions, across buffer refills and partial characters.");
+
+  for (i = 0; i < 500; i++)
+    g_string_append_printf (contents, "line %u \xc3\xa9\xe2\x82\xac%s", i,
+                            (i % 3 == 0) ? "\r\n" : (i % 3 == 1) ? "\n" : "\xe2\x80\xa9");
+  g_string_append (contents, "end");
+
+  fd = g_file_open_tmp ("glib-test-io-channel-XXXXXX", &filename, &local_error);
+  g_assert_no_error (local_error);
+  g_close (fd, NULL);
+  fd = -1;
+
+  g_file_set_contents (filename, contents->str, contents->len, &local_error);
+  g_assert_no_error (local_error);
+
+  channel = g_io_channel_new_file (filename, "r", &local_error);
+  g_assert_no_error (local_error);
+
+  /* Files get a bigger buffer than the default by default */
+  g_assert_cmpuint (g_io_channel_get_buffer_size (channel), >, 1024);
+
+  /* But use a small one here so lines and characters straddle refills */
+  g_io_channel_set_buffer_size (channel, 13);
+
+  for (i = 0; i < 500; i++)
+    {
+      gchar *expected = g_strdup_printf ("line %u \xc3\xa9\xe2\x82\xac", i);
+      gsize expected_length = strlen (expected);
+
+      if (i % 5 == 0)
+        {
+          status = g_io_channel_read_line (channel, &copied, &line_length,
+                                           &terminator_pos, &local_error);
+          g_assert_no_error (local_error);
+          g_assert_cmpint (status, ==, G_IO_STATUS_NORMAL);
+          g_assert_cmpmem (copied, terminator_pos, expected, expected_length);
+          g_free (copied);
+        }
+      else if (i % 5 == 1)
+        {
+          /* Read the start of the line as characters, then borrow the rest */
+          status = g_io_channel_read_chars (channel, chars, 4, &bytes_read,
+                                            &local_error);
+          g_assert_no_error (local_error);
+          g_assert_cmpint (status, ==, G_IO_STATUS_NORMAL);
+          g_assert_cmpmem (chars, bytes_read, "line", 4);
+
+          status = g_io_channel_read_line_borrowed (channel, &line, &line_length,
+                                                    &terminator_pos, &local_error);
+          g_assert_no_error (local_error);
+          g_assert_cmpint (status, ==, G_IO_STATUS_NORMAL);
+          g_assert_cmpmem (line, terminator_pos, expected + 4, expected_length - 4);
+        }
+      else
+        {
+          status = g_io_channel_read_line_borrowed (channel, &line, &line_length,
+                                                    &terminator_pos, &local_error);
+          g_assert_no_error (local_error);
+          g_assert_cmpint (status, ==, G_IO_STATUS_NORMAL);
+          g_assert_cmpmem (line, terminator_pos, expected, expected_length);
+          g_assert_cmpuint (line_length - terminator_pos, ==,
+                            (i % 3 == 0) ? 2 : (i % 3 == 1) ? 1 : 3);
+        }
+
+      g_free (expected);
+    }
+
+  status = g_io_channel_read_line_borrowed (channel, &line, &line_length,
+                                            &terminator_pos, &local_error);
+  g_assert_no_error (local_error);
+  g_assert_cmpint (status, ==, G_IO_STATUS_NORMAL);
+  g_assert_cmpmem (line, line_length, "end", 3);
+
+  status = g_io_channel_read_line_borrowed (channel, &line, &line_length,
+                                            NULL, &local_error);
+  g_assert_no_error (local_error);
+  g_assert_cmpint (status, ==, G_IO_STATUS_EOF);
+  g_assert_null (line);
+  g_assert_cmpuint (line_length, ==, 0);
+
+  /* Seeking back discards the borrowed line and the buffer */
+  status = g_io_channel_seek_position (channel, 0, G_SEEK_SET, &local_error);
+  g_assert_no_error (local_error);
+  g_assert_cmpint (status, ==, G_IO_STATUS_NORMAL);
+
+  status = g_io_channel_read_line_borrowed (channel, &line, &line_length,
+                                            NULL, &local_error);
+  g_assert_no_error (local_error);
+  g_assert_cmpint (status, ==, G_IO_STATUS_NORMAL);
+  g_assert_cmpmem (line, line_length, "line 0 \xc3\xa9\xe2\x82\xac\r\n", 14);
+
+  g_io_channel_unref (channel);
+  g_free (filename);
+  g_string_free (contents, TRUE);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -224,6 +336,7 @@ main (int   argc,
 
   g_test_add_func ("/io-channel/read-write", test_read_write);
   g_test_add_func ("/io-channel/read-line/embedded-nuls", test_read_line_embedded_nuls);
+  g_test_add_func ("/io-channel/read-line/borrowed", test_read_line_borrowed);
 
   return g_test_run ();
 }
@@ -1926,6 +1926,108 @@ test_free_when_not_last_ref (void)
   g_key_file_unref (kf);
 }
 
+static void
+test_lazy_groups (void)
+{
+  static const gchar data[] =
+    "# top comment\n"
+    "[first]\n"
+    "key1=value1\n"
+    "\n"
+    "# comment of second\n"
+    "[second]\n"
+    "key2=value2\r\n"
+    "key2[de]=Wert2\n"
+    "[third]\n"
+    "key4 = a;b;c\n"
+    "[second]\n"
+    "key3=value3\n";
+  GKeyFileFlags flags[] = {
+    G_KEY_FILE_NONE,
+    G_KEY_FILE_KEEP_COMMENTS,
+    G_KEY_FILE_KEEP_COMMENTS | G_KEY_FILE_KEEP_TRANSLATIONS,
+  };
+  gsize i;
+
+  g_test_summary ("Test that G_KEY_FILE_LAZY_GROUPS gives the same results as eager parsing");
+
+  for (i = 0; i < G_N_ELEMENTS (flags); i++)
+    {
+      GKeyFile *eager, *lazy;
+      gchar *eager_data, *lazy_data, *value, *comment;
+      gchar **list;
+      GError *error = NULL;
+
+      eager = load_data (data, flags[i]);
+      lazy = load_data (data, flags[i] | G_KEY_FILE_LAZY_GROUPS);
+
+      value = g_key_file_get_string (lazy, "third", "key4", &error);
+      g_assert_no_error (error);
+      g_assert_cmpstr (value, ==, "a;b;c");
+      g_free (value);
+
+      list = g_key_file_get_keys (lazy, "first", NULL, &error);
+      g_assert_no_error (error);
+      g_assert_cmpstrv (list, ((const gchar *[]) { "key1", NULL }));
+      g_strfreev (list);
+
+      g_assert_true (g_key_file_has_key (lazy, "second", "key3", NULL));
+
+      value = g_key_file_get_comment (lazy, "second", NULL, NULL);
+      comment = g_key_file_get_comment (eager, "second", NULL, NULL);
+      g_assert_cmpstr (value, ==, comment);
+      g_free (comment);
+      g_free (value);
+
+      /* Modifying a group which hasn't been parsed yet */
+      g_key_file_set_string (lazy, "second", "key5", "value5");
+      g_key_file_set_string (eager, "second", "key5", "value5");
+      g_key_file_set_string (lazy, "fourth", "key6", "value6");
+      g_key_file_set_string (eager, "fourth", "key6", "value6");
+
+      eager_data = g_key_file_to_data (eager, NULL, NULL);
+      lazy_data = g_key_file_to_data (lazy, NULL, NULL);
+      g_assert_cmpstr (lazy_data, ==, eager_data);
+      g_free (eager_data);
+      g_free (lazy_data);
+
+      g_key_file_free (lazy);
+      g_key_file_free (eager);
+    }
+}
+
+static void
+test_lazy_groups_errors (void)
+{
+  GKeyFile *keyfile;
+  GBytes *bytes;
+  GError *error = NULL;
+
+  g_test_summary ("Test that G_KEY_FILE_LAZY_GROUPS still reports syntax errors when loading");
+
+  keyfile = g_key_file_new ();
+
+  g_key_file_load_from_data (keyfile, "[a]\nk=v\n[b]\nnot a key\n", -1,
+                             G_KEY_FILE_LAZY_GROUPS, &error);
+  check_error (&error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_PARSE);
+
+  g_key_file_load_from_data (keyfile, "[a]\nk=v\n[b]\nk[=v\n", -1,
+                             G_KEY_FILE_LAZY_GROUPS, &error);
+  check_error (&error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_PARSE);
+
+  g_key_file_load_from_data (keyfile, "[a]\nEncoding=ISO-8859-1\n", -1,
+                             G_KEY_FILE_LAZY_GROUPS, &error);
+  check_error (&error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_UNKNOWN_ENCODING);
+
+  bytes = g_bytes_new_static ("[a]\nk=v\n", 8);
+  g_key_file_load_from_bytes (keyfile, bytes, G_KEY_FILE_LAZY_GROUPS, &error);
+  g_assert_no_error (error);
+  g_bytes_unref (bytes);
+  g_assert_true (g_key_file_has_key (keyfile, "a", "k", NULL));
+
+  g_key_file_free (keyfile);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1971,6 +2073,8 @@ main (int argc, char *argv[])
   g_test_add_func ("/keyfile/bytes", test_bytes);
   g_test_add_func ("/keyfile/get-locale", test_get_locale);
   g_test_add_func ("/keyfile/free-when-not-last-ref", test_free_when_not_last_ref);
+  g_test_add_func ("/keyfile/lazy-groups", test_lazy_groups);
+  g_test_add_func ("/keyfile/lazy-groups/errors", test_lazy_groups_errors);
 
   return g_test_run ();
 }
@@ -1044,6 +1044,28 @@ test_structured_logging_set_writer_func_twice (void)
     }
 }
 
+static void
+test_structured_logging_async_writer (void)
+{
+  if (g_test_subprocess ())
+    {
+      guint i;
+
+      g_log_set_writer_func (g_log_writer_async, NULL, NULL);
+
+      for (i = 0; i < 10; i++)
+        g_message ("async message %u", i);
+
+      g_log_writer_async_flush ();
+      g_assert_cmpuint (g_log_writer_async_get_dropped (), ==, 0);
+      return;
+    }
+
+  g_test_trap_subprocess (NULL, 0, G_TEST_SUBPROCESS_DEFAULT);
+  g_test_trap_assert_passed ();
+  g_test_trap_assert_stderr ("*Message*async message 0*async message 9*");
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1090,6 +1112,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/structured-logging/variant1", test_structured_logging_variant1);
   g_test_add_func ("/structured-logging/variant2", test_structured_logging_variant2);
   g_test_add_func ("/structured-logging/set-writer-func-twice", test_structured_logging_set_writer_func_twice);
+  g_test_add_func ("/structured-logging/async-writer", test_structured_logging_async_writer);
 
   return g_test_run ();
 }
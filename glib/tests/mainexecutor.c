@@ -0,0 +1,253 @@
+/* mainexecutor.c: Pool of threads running main contexts
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+
+typedef struct
+{
+  GMutex lock;
+  GCond cond;
+  guint n_done;
+  guint n_expected;
+  GThread *threads[16];
+  guint order[16][100];
+  guint n_order[16];
+} InvokeData;
+
+typedef struct
+{
+  InvokeData *data;
+  guint key;
+  guint seq;
+} InvokeItem;
+
+static void
+invoke_data_wait (InvokeData *data)
+{
+  g_mutex_lock (&data->lock);
+  while (data->n_done < data->n_expected)
+    g_cond_wait (&data->cond, &data->lock);
+  g_mutex_unlock (&data->lock);
+}
+
+static gboolean
+keyed_cb (gpointer user_data)
+{
+  InvokeItem *item = user_data;
+  InvokeData *data = item->data;
+
+  g_mutex_lock (&data->lock);
+
+  /* Everything with the same key runs on the same thread, in order */
+  if (data->threads[item->key] == NULL)
+    data->threads[item->key] = g_thread_self ();
+  g_assert_true (data->threads[item->key] == g_thread_self ());
+  data->order[item->key][data->n_order[item->key]++] = item->seq;
+
+  data->n_done++;
+  g_cond_signal (&data->cond);
+  g_mutex_unlock (&data->lock);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+test_keyed (void)
+{
+  GMainExecutor *executor;
+  InvokeData data = { 0, };
+  guint key, seq;
+
+  executor = g_main_executor_new (4);
+  g_assert_cmpuint (g_main_executor_get_n_threads (executor), ==, 4);
+
+  data.n_expected = 16 * 100;
+
+  for (seq = 0; seq < 100; seq++)
+    for (key = 0; key < 16; key++)
+      {
+        InvokeItem *item = g_new (InvokeItem, 1);
+
+        item->data = &data;
+        item->key = key;
+        item->seq = seq;
+        g_main_executor_invoke (executor, GUINT_TO_POINTER (key + 1),
+                                G_PRIORITY_DEFAULT, keyed_cb, item, g_free);
+      }
+
+  invoke_data_wait (&data);
+
+  for (key = 0; key < 16; key++)
+    {
+      g_assert_cmpuint (data.n_order[key], ==, 100);
+      for (seq = 0; seq < 100; seq++)
+        g_assert_cmpuint (data.order[key][seq], ==, seq);
+    }
+
+  g_main_executor_free (executor);
+}
+
+static gint context_checked = 0;
+
+static gboolean
+check_context_cb (gpointer user_data)
+{
+  GMainContext *expected = user_data;
+
+  g_assert_true (g_main_context_get_thread_default () == expected);
+  g_assert_true (g_main_context_is_owner (expected));
+  g_atomic_int_set (&context_checked, 1);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+test_context_for_key (void)
+{
+  GMainExecutor *executor;
+  GMainContext *context;
+  guint i;
+
+  executor = g_main_executor_new (3);
+
+  for (i = 0; i < 3; i++)
+    g_assert_nonnull (g_main_executor_get_context (executor, i));
+
+  context = g_main_executor_get_context_for_key (executor, &i);
+  g_main_executor_invoke (executor, &i, G_PRIORITY_DEFAULT,
+                          check_context_cb, context, NULL);
+  while (!g_atomic_int_get (&context_checked))
+    g_usleep (1000);
+
+  g_main_executor_free (executor);
+}
+
+typedef struct
+{
+  gint running;
+  gint max_running;
+  gint remaining;
+  GMutex lock;
+  GCond cond;
+} SharedData;
+
+static gboolean
+shared_cb (gpointer user_data)
+{
+  SharedData *data = user_data;
+  gint running, max_running;
+
+  running = g_atomic_int_add (&data->running, 1) + 1;
+  do
+    max_running = g_atomic_int_get (&data->max_running);
+  while (running > max_running &&
+         !g_atomic_int_compare_and_exchange (&data->max_running, max_running, running));
+
+  g_usleep (20 * G_TIME_SPAN_MILLISECOND);
+
+  g_atomic_int_add (&data->running, -1);
+
+  g_mutex_lock (&data->lock);
+  data->remaining--;
+  g_cond_signal (&data->cond);
+  g_mutex_unlock (&data->lock);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+test_shared (void)
+{
+  GMainExecutor *executor;
+  SharedData data = { 0, };
+  guint i;
+
+  executor = g_main_executor_new (4);
+
+  data.remaining = 16;
+  for (i = 0; i < 16; i++)
+    g_main_executor_invoke (executor, NULL, G_PRIORITY_DEFAULT,
+                            shared_cb, &data, NULL);
+
+  g_mutex_lock (&data.lock);
+  while (data.remaining > 0)
+    g_cond_wait (&data.cond, &data.lock);
+  g_mutex_unlock (&data.lock);
+
+  /* Jobs without a key were spread over several threads */
+  g_assert_cmpint (data.max_running, >, 1);
+  g_assert_cmpint (data.max_running, <=, 4);
+
+  g_main_executor_free (executor);
+}
+
+static gboolean
+unreachable_cb (gpointer user_data)
+{
+  g_assert_not_reached ();
+  return G_SOURCE_REMOVE;
+}
+
+static void
+count_notify (gpointer user_data)
+{
+  g_atomic_int_inc ((gint *) user_data);
+}
+
+static gboolean
+block_cb (gpointer user_data)
+{
+  g_usleep (50 * G_TIME_SPAN_MILLISECOND);
+  return G_SOURCE_REMOVE;
+}
+
+static void
+test_free_pending (void)
+{
+  GMainExecutor *executor;
+  gint n_notified = 0;
+
+  executor = g_main_executor_new (1);
+
+  /* Keep the only thread busy so that the next jobs are still pending
+   * when the executor is freed */
+  g_main_executor_invoke (executor, NULL, G_PRIORITY_DEFAULT, block_cb, NULL, NULL);
+  g_usleep (10 * G_TIME_SPAN_MILLISECOND);
+  g_main_executor_invoke (executor, NULL, G_PRIORITY_DEFAULT,
+                          unreachable_cb, &n_notified, count_notify);
+  g_main_executor_invoke (executor, GUINT_TO_POINTER (1), G_PRIORITY_DEFAULT,
+                          unreachable_cb, &n_notified, count_notify);
+
+  g_main_executor_free (executor);
+
+  g_assert_cmpint (n_notified, ==, 2);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/main-executor/keyed", test_keyed);
+  g_test_add_func ("/main-executor/context-for-key", test_context_for_key);
+  g_test_add_func ("/main-executor/shared", test_shared);
+  g_test_add_func ("/main-executor/free-pending", test_free_pending);
+
+  return g_test_run ();
+}
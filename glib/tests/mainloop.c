@@ -425,6 +425,116 @@ test_invoke (void)
   g_main_context_unref (ctx);
 }
 
+static gboolean
+append_to_array (gpointer data)
+{
+  GArray *order = data;
+  guint n = order->len;
+
+  g_array_append_val (order, n);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean
+repeat_twice (gpointer data)
+{
+  gint *repeats = data;
+
+  return ++(*repeats) < 3;
+}
+
+static gint n_notified;
+
+static void
+count_notify (gpointer data)
+{
+  n_notified++;
+}
+
+#define N_INVOKE_THREADS 4
+#define N_INVOKES_PER_THREAD 1000
+
+static gint n_invoked;
+
+static gboolean
+count_invoked (gpointer data)
+{
+  g_atomic_int_inc (&n_invoked);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gpointer
+invoke_thread_func (gpointer data)
+{
+  GMainContext *ctx = data;
+  guint i;
+
+  for (i = 0; i < N_INVOKES_PER_THREAD; i++)
+    g_main_context_invoke (ctx, count_invoked, NULL);
+
+  return NULL;
+}
+
+static void
+test_invoke_queue (void)
+{
+  GMainContext *ctx;
+  GArray *order;
+  GThread *threads[N_INVOKE_THREADS];
+  gint repeats = 0;
+  guint i;
+
+  g_test_summary ("Test that invocations at the default priority from a "
+                  "thread which can’t acquire the context are queued");
+
+  ctx = g_main_context_new ();
+  order = g_array_new (FALSE, FALSE, sizeof (guint));
+
+  for (i = 0; i < 10; i++)
+    g_main_context_invoke_full (ctx, G_PRIORITY_DEFAULT, append_to_array,
+                                order, count_notify);
+  g_main_context_invoke_full (ctx, G_PRIORITY_DEFAULT, repeat_twice,
+                              &repeats, count_notify);
+
+  /* Nothing runs until the context is iterated, and the internal source is
+   * not visible to the lookup functions */
+  g_assert_cmpuint (order->len, ==, 0);
+  g_assert_null (g_main_context_find_source_by_user_data (ctx, NULL));
+
+  g_assert_true (g_main_context_iteration (ctx, FALSE));
+  g_assert_cmpuint (order->len, ==, 10);
+  for (i = 0; i < order->len; i++)
+    g_assert_cmpuint (g_array_index (order, guint, i), ==, i);
+  g_assert_cmpint (n_notified, ==, 10);
+  g_assert_cmpint (repeats, ==, 1);
+
+  /* A function returning %G_SOURCE_CONTINUE is run again, like an idle */
+  while (g_main_context_iteration (ctx, FALSE));
+  g_assert_cmpint (repeats, ==, 3);
+  g_assert_cmpint (n_notified, ==, 11);
+
+  /* Many producers */
+  for (i = 0; i < N_INVOKE_THREADS; i++)
+    threads[i] = g_thread_new ("invoke", invoke_thread_func, ctx);
+  while (g_atomic_int_get (&n_invoked) < N_INVOKE_THREADS * N_INVOKES_PER_THREAD)
+    g_main_context_iteration (ctx, TRUE);
+  for (i = 0; i < N_INVOKE_THREADS; i++)
+    g_thread_join (threads[i]);
+  g_assert_false (g_main_context_pending (ctx));
+  g_assert_cmpint (n_invoked, ==, N_INVOKE_THREADS * N_INVOKES_PER_THREAD);
+
+  /* Pending invocations are dropped, and their data freed, with the context */
+  g_main_context_invoke_full (ctx, G_PRIORITY_DEFAULT, append_to_array,
+                              order, count_notify);
+  g_main_context_unref (ctx);
+  g_assert_cmpint (n_notified, ==, 12);
+  g_assert_cmpuint (order->len, ==, 10);
+
+  g_array_unref (order);
+}
+
 /* We can't use timeout sources here because on slow or heavily-loaded
  * machines, the test program might not get enough cycles to hit the
  * timeouts at the expected times. So instead we define a source that
@@ -1092,6 +1202,222 @@ test_ready_time (void)
   g_source_destroy (source);
 }
 
+static gboolean
+count_dispatch (gpointer user_data)
+{
+  guint *count = user_data;
+
+  (*count)++;
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean
+ready_time_count_dispatch (GSource     *source,
+                           GSourceFunc  callback,
+                           gpointer     user_data)
+{
+  guint *count = user_data;
+
+  g_source_set_ready_time (source, -1);
+  (*count)++;
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+test_timer_heap (void)
+{
+  GSourceFuncs timer_funcs = {
+    NULL, NULL, ready_time_count_dispatch, NULL, NULL, NULL
+  };
+  GMainContext *context;
+  GSource *sources[100];
+  GSource *timer;
+  GPollFD poll_fd = { -1, 0, 0 };
+  guint count = 0, n_fired = 0;
+  gsize i;
+
+  g_test_summary ("Test that timer sources not yet due are tracked correctly "
+                  "while they are kept out of the source lists");
+
+  context = g_main_context_new ();
+
+  /* Timeouts far in the future, which get parked on the first iteration */
+  for (i = 0; i < G_N_ELEMENTS (sources); i++)
+    {
+      sources[i] = g_timeout_source_new_seconds (3600 + i);
+      g_source_set_callback (sources[i], count_dispatch, &count, NULL);
+      g_source_attach (sources[i], context);
+    }
+
+  g_assert_false (g_main_context_iteration (context, FALSE));
+  g_assert_cmpuint (count, ==, 0);
+
+  /* Parked sources can still be found */
+  g_assert_true (g_main_context_find_source_by_user_data (context, &count) != NULL);
+  g_assert_true (g_main_context_find_source_by_id (context, g_source_get_id (sources[50])) == sources[50]);
+  g_assert_true (g_main_context_find_source_by_funcs_user_data (context, &g_timeout_funcs, &count) != NULL);
+
+  /* Destroying and re-prioritising parked sources */
+  g_source_destroy (sources[10]);
+  g_source_set_priority (sources[20], G_PRIORITY_HIGH);
+  g_assert_cmpint (g_source_get_priority (sources[20]), ==, G_PRIORITY_HIGH);
+
+  /* A source whose ready time is moved to now fires on the next iteration,
+   * and can be re-armed afterwards */
+  timer = g_source_new (&timer_funcs, sizeof (GSource));
+  g_source_set_callback (timer, count_dispatch, &n_fired, NULL);
+  g_source_set_ready_time (timer, g_get_monotonic_time () + G_TIME_SPAN_HOUR);
+  g_source_attach (timer, context);
+
+  g_assert_false (g_main_context_iteration (context, FALSE));
+  g_assert_cmpuint (n_fired, ==, 0);
+
+  g_source_set_ready_time (timer, 0);
+  g_assert_true (g_main_context_iteration (context, FALSE));
+  g_assert_cmpuint (n_fired, ==, 1);
+  g_assert_cmpint (g_source_get_ready_time (timer), ==, -1);
+  g_assert_false (g_source_is_destroyed (timer));
+
+  /* Cancelled ready time: never fires, but stays attached */
+  g_assert_false (g_main_context_iteration (context, FALSE));
+  g_assert_cmpuint (n_fired, ==, 1);
+
+  g_source_set_ready_time (timer, g_get_monotonic_time () - G_TIME_SPAN_SECOND);
+  while (g_main_context_iteration (context, FALSE));
+  g_assert_cmpuint (n_fired, ==, 2);
+
+  /* The re-prioritised parked timeout becomes due and is dispatched */
+  g_source_set_ready_time (sources[20], 0);
+  g_assert_true (g_main_context_iteration (context, FALSE));
+  g_assert_cmpuint (count, ==, 1);
+  g_assert_true (g_source_is_destroyed (sources[20]));
+
+  /* Blocking poll wakes up for a parked timer becoming due */
+  g_source_set_ready_time (sources[30], g_get_monotonic_time () + 10 * G_TIME_SPAN_MILLISECOND);
+  while (count < 2)
+    g_main_context_iteration (context, TRUE);
+  g_assert_true (g_source_is_destroyed (sources[30]));
+
+  /* Adding a poll takes the source out of the timer heap, and it's still
+   * dispatched normally */
+  g_source_add_poll (timer, &poll_fd);
+  g_source_set_ready_time (timer, 0);
+  g_assert_true (g_main_context_iteration (context, FALSE));
+  g_assert_cmpuint (n_fired, ==, 3);
+
+  g_source_remove_poll (timer, &poll_fd);
+  g_source_destroy (timer);
+  g_source_unref (timer);
+
+  /* Unref the context with parked sources still attached */
+  g_main_context_unref (context);
+
+  for (i = 0; i < G_N_ELEMENTS (sources); i++)
+    {
+      g_assert_true (g_source_is_destroyed (sources[i]));
+      g_source_unref (sources[i]);
+    }
+}
+
+static gboolean
+sleep_dispatch (gpointer user_data)
+{
+  g_usleep (2000);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+test_dispatch_stats (void)
+{
+  GMainContext *ctx;
+  GSource *source;
+  GVariant *stats, *source_stats, *histogram;
+  guint64 count, total;
+  gint64 max_duration, total_duration;
+  gsize n_buckets, i;
+  const guint64 *buckets;
+
+  g_test_summary ("Test that dispatch statistics are collected by source name");
+
+  ctx = g_main_context_new ();
+
+  g_assert_null (g_main_context_get_dispatch_stats (ctx));
+
+  g_main_context_set_dispatch_stats_enabled (ctx, TRUE);
+
+  for (i = 0; i < 3; i++)
+    {
+      source = g_idle_source_new ();
+      g_source_set_static_name (source, "sleeper");
+      g_source_set_callback (source, sleep_dispatch, NULL, NULL);
+      g_source_attach (source, ctx);
+      g_source_unref (source);
+    }
+
+  /* Idle sources are named by default */
+  source = g_idle_source_new ();
+  g_source_set_callback (source, sleep_dispatch, NULL, NULL);
+  g_source_attach (source, ctx);
+  g_source_unref (source);
+
+  while (g_main_context_iteration (ctx, FALSE));
+
+  stats = g_main_context_get_dispatch_stats (ctx);
+  g_assert_nonnull (stats);
+  g_assert_false (g_variant_is_floating (stats));
+  g_assert_cmpuint (g_variant_n_children (stats), ==, 2);
+
+  source_stats = g_variant_lookup_value (stats, "sleeper", G_VARIANT_TYPE_VARDICT);
+  g_assert_nonnull (source_stats);
+  g_assert_true (g_variant_lookup (source_stats, "count", "t", &count));
+  g_assert_cmpuint (count, ==, 3);
+  g_assert_true (g_variant_lookup (source_stats, "total-duration", "x", &total_duration));
+  g_assert_true (g_variant_lookup (source_stats, "max-duration", "x", &max_duration));
+  g_assert_cmpint (max_duration, >=, 2000);
+  g_assert_cmpint (total_duration, >=, 3 * 2000);
+  g_assert_cmpint (total_duration, >=, max_duration);
+
+  histogram = g_variant_lookup_value (source_stats, "duration-histogram", G_VARIANT_TYPE ("at"));
+  g_assert_nonnull (histogram);
+  buckets = g_variant_get_fixed_array (histogram, &n_buckets, sizeof (guint64));
+  for (i = 0, total = 0; i < n_buckets; i++)
+    total += buckets[i];
+  g_assert_cmpuint (total, ==, 3);
+  /* Nothing could have taken less than 2ms */
+  for (i = 0; i < 11; i++)
+    g_assert_cmpuint (buckets[i], ==, 0);
+  g_variant_unref (histogram);
+
+  histogram = g_variant_lookup_value (source_stats, "latency-histogram", G_VARIANT_TYPE ("at"));
+  g_assert_nonnull (histogram);
+  buckets = g_variant_get_fixed_array (histogram, &n_buckets, sizeof (guint64));
+  for (i = 0, total = 0; i < n_buckets; i++)
+    total += buckets[i];
+  g_assert_cmpuint (total, ==, 3);
+  g_variant_unref (histogram);
+  g_variant_unref (source_stats);
+
+  source_stats = g_variant_lookup_value (stats, "GIdleSource", G_VARIANT_TYPE_VARDICT);
+  g_assert_nonnull (source_stats);
+  g_assert_true (g_variant_lookup (source_stats, "count", "t", &count));
+  g_assert_cmpuint (count, ==, 1);
+  g_variant_unref (source_stats);
+  g_variant_unref (stats);
+
+  /* Disabling discards them */
+  g_main_context_set_dispatch_stats_enabled (ctx, FALSE);
+  g_assert_null (g_main_context_get_dispatch_stats (ctx));
+  g_main_context_set_dispatch_stats_enabled (ctx, TRUE);
+  stats = g_main_context_get_dispatch_stats (ctx);
+  g_assert_cmpuint (g_variant_n_children (stats), ==, 0);
+  g_variant_unref (stats);
+
+  g_main_context_unref (ctx);
+}
+
 static void
 test_wakeup(void)
 {
@@ -1675,6 +2001,131 @@ test_unix_file_poll (void)
   close (fd);
 }
 
+static guint counting_poll_calls = 0;
+
+static gint
+counting_poll (GPollFD *ufds,
+               guint    nfds,
+               gint     timeout_)
+{
+  counting_poll_calls++;
+
+  return g_poll (ufds, nfds, timeout_);
+}
+
+static void
+test_kernel_polling (void)
+{
+  GSourceFuncs no_funcs = {
+    NULL, NULL, return_true, NULL, NULL, NULL
+  };
+  GMainContext *context;
+  GSource *source_a;
+  GSource *source_b;
+  GSource *file_source;
+  gpointer tag_b1, tag_b2;
+  gint fds_a[2];
+  gint fds_b[2];
+  gint null_fd;
+  gchar c;
+  GMainLoop *loop;
+
+  g_test_summary ("Test that G_MAIN_CONTEXT_FLAGS_KERNEL_POLLING reports the "
+                  "same events as poll()");
+
+  context = g_main_context_new_with_flags (G_MAIN_CONTEXT_FLAGS_KERNEL_POLLING);
+
+  g_assert_cmpint (pipe (fds_a), ==, 0);
+  g_assert_cmpint (pipe (fds_b), ==, 0);
+
+  source_a = g_source_new (&no_funcs, sizeof (FlagSource));
+  source_b = g_source_new (&no_funcs, sizeof (FlagSource));
+
+  /* Nothing to read yet */
+  g_source_add_unix_fd (source_a, fds_a[0], G_IO_IN);
+  g_source_attach (source_a, context);
+  g_assert_false (g_main_context_iteration (context, FALSE));
+  assert_not_flagged (source_a);
+
+  g_assert_cmpint (write (fds_a[1], "x", 1), ==, 1);
+  g_assert_true (g_main_context_iteration (context, FALSE));
+  assert_flagged (source_a);
+  clear_flag (source_a);
+
+  /* A higher priority source which is always ready must take precedence,
+   * and the lower priority fd must not be reported. */
+  g_source_set_priority (source_b, G_PRIORITY_HIGH);
+  tag_b1 = g_source_add_unix_fd (source_b, fds_b[1], G_IO_OUT);
+  g_source_attach (source_b, context);
+  g_assert_true (g_main_context_iteration (context, FALSE));
+  assert_flagged (source_b);
+  assert_not_flagged (source_a);
+  clear_flag (source_b);
+
+  /* Changing the events must be reflected in the kernel registration */
+  g_source_modify_unix_fd (source_b, tag_b1, G_IO_IN);
+  g_assert_true (g_main_context_iteration (context, FALSE));
+  assert_not_flagged (source_b);
+  assert_flagged (source_a);
+  clear_flag (source_a);
+
+  /* Two records for the same fd, from different sources */
+  tag_b2 = g_source_add_unix_fd (source_b, fds_a[0], G_IO_IN);
+  g_assert_true (g_main_context_iteration (context, FALSE));
+  assert_flagged (source_b);
+  assert_not_flagged (source_a);
+  clear_flag (source_b);
+
+  g_source_remove_unix_fd (source_b, tag_b2);
+  g_assert_true (g_main_context_iteration (context, FALSE));
+  assert_flagged (source_a);
+  assert_not_flagged (source_b);
+  clear_flag (source_a);
+
+  /* Drain the pipe; nothing should be ready any more */
+  g_assert_cmpint (read (fds_a[0], &c, 1), ==, 1);
+  g_assert_false (g_main_context_iteration (context, FALSE));
+  assert_not_flagged (source_a);
+  assert_not_flagged (source_b);
+
+  /* Regular files can’t be added to an epoll set, but must still poll as
+   * ready, as they do with poll(). */
+  null_fd = open ("/dev/null", O_RDONLY);
+  g_assert_cmpint (null_fd, >=, 0);
+
+  loop = g_main_loop_new (context, FALSE);
+  file_source = g_unix_fd_source_new (null_fd, G_IO_IN);
+  g_source_set_callback (file_source, (GSourceFunc) unixfd_quit_loop, loop, NULL);
+  g_source_attach (file_source, context);
+  g_main_loop_run (loop);
+  g_source_destroy (file_source);
+  g_source_unref (file_source);
+  g_main_loop_unref (loop);
+  close (null_fd);
+
+  /* A poll function override must still be honoured */
+  g_main_context_set_poll_func (context, counting_poll);
+  counting_poll_calls = 0;
+  g_assert_cmpint (write (fds_a[1], "x", 1), ==, 1);
+  g_assert_true (g_main_context_iteration (context, FALSE));
+  assert_flagged (source_a);
+  g_assert_cmpuint (counting_poll_calls, ==, 1);
+  g_main_context_set_poll_func (context, NULL);
+
+  g_source_destroy (source_a);
+  g_source_destroy (source_b);
+  g_assert_false (g_main_context_iteration (context, FALSE));
+
+  g_source_unref (source_a);
+  g_source_unref (source_b);
+  g_main_context_unref (context);
+
+  close (fds_a[0]);
+  close (fds_a[1]);
+  close (fds_b[0]);
+  close (fds_b[1]);
+}
+
 static void
 test_unix_fd_priority (void)
 {
@@ -2509,6 +2960,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/mainloop/timeouts", test_timeouts);
   g_test_add_func ("/mainloop/priorities", test_priorities);
   g_test_add_func ("/mainloop/invoke", test_invoke);
+  g_test_add_func ("/mainloop/invoke-queue", test_invoke_queue);
   g_test_add_func ("/mainloop/child_sources", test_child_sources);
   g_test_add_func ("/mainloop/recursive_child_sources", test_recursive_child_sources);
   g_test_add_func ("/mainloop/recursive_loop_child_sources", test_recursive_loop_child_sources);
@@ -2517,6 +2969,8 @@ main (int argc, char *argv[])
   g_test_add_func ("/mainloop/source_time", test_source_time);
   g_test_add_func ("/mainloop/overflow", test_mainloop_overflow);
   g_test_add_func ("/mainloop/ready-time", test_ready_time);
+  g_test_add_func ("/mainloop/timer-heap", test_timer_heap);
+  g_test_add_func ("/mainloop/dispatch-stats", test_dispatch_stats);
   g_test_add_func ("/mainloop/wakeup", test_wakeup);
   g_test_add_func ("/mainloop/remove-invalid", test_remove_invalid);
   g_test_add_func ("/mainloop/unref-while-pending", test_unref_while_pending);
@@ -2527,6 +2981,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/mainloop/wait", test_mainloop_wait);
   g_test_add_func ("/mainloop/unix-file-poll", test_unix_file_poll);
   g_test_add_func ("/mainloop/unix-fd-priority", test_unix_fd_priority);
+  g_test_add_func ("/mainloop/kernel-polling", test_kernel_polling);
 #endif
   g_test_add_func ("/mainloop/nfds", test_nfds);
   g_test_add_func ("/mainloop/steal-fd", test_steal_fd);
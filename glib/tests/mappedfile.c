@@ -186,6 +186,48 @@ test_gbytes (void)
   g_bytes_unref (bytes);
 }
 
+static void
+test_advise (void)
+{
+  GMappedFile *file;
+  GError *error = NULL;
+  const gchar *filename;
+  gchar *contents;
+  gsize length;
+
+  filename = g_test_get_filename (G_TEST_DIST, "4096-random-bytes", NULL);
+  g_file_get_contents (filename, &contents, &length, &error);
+  g_assert_no_error (error);
+
+  file = g_mapped_file_new_with_flags (filename, G_MAPPED_FILE_FLAGS_POPULATE, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (g_mapped_file_get_length (file), ==, length);
+
+  /* Hints never change the contents */
+  g_mapped_file_advise (file, G_MAPPED_FILE_ADVICE_SEQUENTIAL |
+                              G_MAPPED_FILE_ADVICE_WILLNEED |
+                              G_MAPPED_FILE_ADVICE_HUGEPAGE);
+  g_mapped_file_advise (file, G_MAPPED_FILE_ADVICE_RANDOM);
+  g_mapped_file_prefetch_range (file, 0, length);
+  g_mapped_file_prefetch_range (file, 1000, 10);
+  g_mapped_file_prefetch_range (file, length, 0);
+
+  g_assert_cmpmem (g_mapped_file_get_contents (file), g_mapped_file_get_length (file),
+                   contents, length);
+
+  g_mapped_file_unref (file);
+
+  /* Empty mappings are fine too */
+  file = g_mapped_file_new_with_flags (g_test_get_filename (G_TEST_DIST, "empty", NULL),
+                                       G_MAPPED_FILE_FLAGS_POPULATE, &error);
+  g_assert_no_error (error);
+  g_mapped_file_advise (file, G_MAPPED_FILE_ADVICE_WILLNEED);
+  g_mapped_file_prefetch_range (file, 0, 0);
+  g_mapped_file_unref (file);
+
+  g_free (contents);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -200,6 +242,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/mappedfile/writable", test_writable);
   g_test_add_func ("/mappedfile/writable_fd", test_writable_fd);
   g_test_add_func ("/mappedfile/gbytes", test_gbytes);
+  g_test_add_func ("/mappedfile/advise", test_advise);
 
   return g_test_run ();
 }
@@ -89,12 +89,80 @@ test_markup_stack (void)
   g_markup_parse_context_free (context);
 }
 
+static void
+collect_text (GMarkupParseContext  *context,
+              const gchar          *text,
+              gsize                 text_len,
+              gpointer              user_data,
+              GError              **error)
+{
+  GPtrArray *texts = user_data;
+
+  g_ptr_array_add (texts, g_strndup (text, text_len));
+}
+
+static void
+test_markup_text (void)
+{
+  const gchar document[] =
+    "<a>plain<b>caf\xc3\xa9</b>&lt;escaped&gt;<c>one\r\ntwo</c>&#65;</a>";
+  GMarkupParser parser = { NULL, NULL, collect_text, NULL, NULL };
+  const gchar *expected[] = {
+    "plain", "caf\xc3\xa9", "<escaped>", "one\ntwo", "A", NULL
+  };
+  gsize chunk_sizes[] = { sizeof (document) - 1, 7, 1 };
+  gsize i;
+
+  g_test_summary ("Test that text is unescaped the same whether or not it "
+                  "can be passed without copying");
+
+  for (i = 0; i < G_N_ELEMENTS (chunk_sizes); i++)
+    {
+      GMarkupParseContext *context;
+      GPtrArray *texts;
+      GString *joined;
+      gsize offset, j;
+      GError *error = NULL;
+
+      texts = g_ptr_array_new_with_free_func (g_free);
+      context = g_markup_parse_context_new (&parser, G_MARKUP_DEFAULT_FLAGS, texts, NULL);
+
+      for (offset = 0; offset < sizeof (document) - 1; offset += chunk_sizes[i])
+        {
+          gsize len = MIN (chunk_sizes[i], sizeof (document) - 1 - offset);
+
+          g_assert_true (g_markup_parse_context_parse (context, document + offset, len, &error));
+          g_assert_no_error (error);
+        }
+
+      g_assert_true (g_markup_parse_context_end_parse (context, &error));
+      g_assert_no_error (error);
+      g_markup_parse_context_free (context);
+
+      /* Text split across chunks may be reported in several pieces */
+      joined = g_string_new (NULL);
+      for (j = 0; j < texts->len; j++)
+        g_string_append (joined, g_ptr_array_index (texts, j));
+      g_assert_cmpstr (joined->str, ==, "plaincaf\xc3\xa9<escaped>one\ntwoA");
+      g_string_free (joined, TRUE);
+
+      if (chunk_sizes[i] == sizeof (document) - 1)
+        {
+          g_ptr_array_add (texts, NULL);
+          g_assert_cmpstrv ((const gchar * const *) texts->pdata, expected);
+        }
+
+      g_ptr_array_unref (texts);
+    }
+}
+
 int
 main (int argc, char *argv[])
 {
   g_test_init (&argc, &argv, NULL);
 
   g_test_add_func ("/markup/stack", test_markup_stack);
+  g_test_add_func ("/markup/text", test_markup_text);
 
   return g_test_run ();
 }
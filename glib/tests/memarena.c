@@ -0,0 +1,301 @@
+/* memarena.c: Bump allocator for short-lived allocations
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <string.h>
+
+static void
+test_basic (void)
+{
+  GMemArena *arena;
+  guint8 *prev = NULL;
+  guint i;
+
+  arena = g_mem_arena_new (0);
+
+  g_assert_null (g_mem_arena_alloc (arena, 0));
+
+  /* Allocations are aligned and don't overlap */
+  for (i = 1; i < 2000; i++)
+    {
+      guint8 *mem = g_mem_arena_alloc (arena, i % 100 + 1);
+
+      g_assert_nonnull (mem);
+      g_assert_cmpuint (GPOINTER_TO_SIZE (mem) % (2 * sizeof (gsize)), ==, 0);
+      memset (mem, 0xaa, i % 100 + 1);
+
+      if (prev != NULL)
+        g_assert_cmpuint (prev[0], ==, 0xaa);
+      prev = mem;
+    }
+
+  prev = g_mem_arena_alloc0 (arena, 64);
+  for (i = 0; i < 64; i++)
+    g_assert_cmpuint (prev[i], ==, 0);
+
+  g_assert_cmpstr (g_mem_arena_strdup (arena, "hello"), ==, "hello");
+  g_assert_null (g_mem_arena_strdup (arena, NULL));
+
+  g_mem_arena_free (arena);
+}
+
+static void
+test_realloc (void)
+{
+  GMemArena *arena;
+  gchar *mem, *grown, *other;
+
+  arena = g_mem_arena_new (1024);
+
+  /* The last allocation grows in place */
+  mem = g_mem_arena_alloc (arena, 16);
+  strcpy (mem, "in place");
+  grown = g_mem_arena_realloc (arena, mem, 16, 128);
+  g_assert_true (grown == mem);
+  g_assert_cmpstr (grown, ==, "in place");
+
+  /* Others are copied */
+  other = g_mem_arena_alloc (arena, 16);
+  grown = g_mem_arena_realloc (arena, mem, 128, 200);
+  g_assert_true (grown != mem);
+  g_assert_true (grown != other);
+  g_assert_cmpstr (grown, ==, "in place");
+
+  /* Shrinking never moves */
+  g_assert_true (g_mem_arena_realloc (arena, grown, 200, 10) == grown);
+
+  g_assert_null (g_mem_arena_realloc (arena, grown, 10, 0));
+  g_assert_nonnull (g_mem_arena_realloc (arena, NULL, 0, 10));
+
+  g_mem_arena_free (arena);
+}
+
+static void
+test_reset (void)
+{
+  GMemArena *arena;
+  gpointer first, large;
+  guint i;
+
+  arena = g_mem_arena_new (1024);
+
+  first = g_mem_arena_alloc (arena, 32);
+  for (i = 0; i < 100; i++)
+    g_mem_arena_alloc (arena, 32);
+
+  /* A large allocation gets its own block, and doesn't waste the
+   * free space in the current one */
+  large = g_mem_arena_alloc (arena, 100000);
+  memset (large, 0, 100000);
+
+  /* After a reset, a block is reused */
+  g_mem_arena_reset (arena);
+  g_assert_nonnull (g_mem_arena_alloc (arena, 32));
+
+  g_mem_arena_reset (arena);
+  g_mem_arena_reset (arena);
+  g_assert_nonnull (first);
+
+  g_mem_arena_free (arena);
+
+  /* Resetting an unused arena is fine too */
+  arena = g_mem_arena_new (0);
+  g_mem_arena_reset (arena);
+  g_mem_arena_alloc (arena, 10000);
+  g_mem_arena_reset (arena);
+  g_mem_arena_free (arena);
+}
+
+static gpointer
+thread_local_thread (gpointer data)
+{
+  GMemArena *arena = g_mem_arena_get_thread_local ();
+
+  g_assert_true (arena != data);
+  g_assert_true (g_mem_arena_get_thread_local () == arena);
+  g_mem_arena_alloc (arena, 100);
+
+  return NULL;
+}
+
+static void
+test_thread_local (void)
+{
+  GMemArena *arena = g_mem_arena_get_thread_local ();
+  GThread *thread;
+
+  g_assert_nonnull (arena);
+  g_assert_true (g_mem_arena_get_thread_local () == arena);
+
+  thread = g_thread_new ("arena", thread_local_thread, arena);
+  g_thread_join (thread);
+
+  g_mem_arena_reset (arena);
+}
+
+static void
+test_string (void)
+{
+  GMemArena *arena;
+  GString *string;
+  gchar *copy;
+  guint i;
+
+  arena = g_mem_arena_new (0);
+
+  string = g_string_new_in_arena (arena, "hello");
+  for (i = 0; i < 1000; i++)
+    g_string_append_printf (string, " %u", i);
+  g_string_prepend_c (string, '>');
+  g_assert_true (g_str_has_prefix (string->str, ">hello 0 1 2"));
+  g_assert_true (g_str_has_suffix (string->str, " 998 999"));
+
+  /* The contents are freed with the arena, so keep a copy */
+  copy = g_strndup (string->str, string->len);
+  g_assert_true (g_str_has_prefix (copy, ">hello 0 1 2"));
+
+  /* Resetting the arena frees the character data of its strings */
+  g_mem_arena_reset (arena);
+
+  string = g_string_sized_new_in_arena (arena, 10);
+  g_string_append (string, "reset");
+  g_string_append_len (string, copy, 1000);
+  g_assert_cmpuint (string->len, ==, 1005);
+  g_assert_true (g_str_has_prefix (string->str, "reset>hello"));
+
+  /* Strings in no arena */
+  string = g_string_new_in_arena (NULL, "heap");
+  g_string_append (string, " string");
+  g_assert_cmpstr (string->str, ==, "heap string");
+  g_string_free (string, TRUE);
+
+  g_mem_arena_free (arena);
+  g_assert_true (g_str_has_suffix (copy, " 998 999"));
+  g_free (copy);
+}
+
+static gint n_cleared;
+
+static void
+clear_element (gpointer data)
+{
+  n_cleared++;
+}
+
+static void
+test_array (void)
+{
+  GMemArena *arena;
+  GArray *array;
+  gint *data;
+  gsize len;
+  gint i;
+
+  arena = g_mem_arena_new (0);
+
+  array = g_array_new_in_arena (arena, TRUE, FALSE, sizeof (gint), 0);
+  for (i = 0; i < 1000; i++)
+    g_array_append_val (array, i);
+  g_assert_cmpuint (array->len, ==, 1000);
+  for (i = 0; i < 1000; i++)
+    g_assert_cmpint (g_array_index (array, gint, i), ==, i);
+  g_assert_cmpint (g_array_index (array, gint, 1000), ==, 0);
+
+  data = g_array_steal (array, &len);
+  g_assert_cmpuint (len, ==, 1000);
+  g_assert_cmpint (data[999], ==, 999);
+  g_assert_cmpint (data[1000], ==, 0);
+  g_array_unref (array);
+
+  n_cleared = 0;
+  array = g_array_new_in_arena (arena, FALSE, TRUE, sizeof (gint), 8);
+  g_array_set_clear_func (array, clear_element);
+  g_array_set_size (array, 5);
+  g_array_unref (array);
+  g_assert_cmpint (n_cleared, ==, 5);
+
+  g_mem_arena_free (arena);
+
+  g_assert_cmpint (data[500], ==, 500);
+  g_free (data);
+}
+
+static void
+test_ptr_array (void)
+{
+  GMemArena *arena;
+  GPtrArray *array, *other;
+  gpointer *data;
+  guint i;
+
+  arena = g_mem_arena_new (0);
+
+  array = g_ptr_array_new_in_arena (arena, 0, NULL);
+  for (i = 0; i < 1000; i++)
+    g_ptr_array_add (array, GUINT_TO_POINTER (i));
+  g_ptr_array_remove_index (array, 0);
+  g_assert_cmpuint (array->len, ==, 999);
+  g_assert_cmpuint (GPOINTER_TO_UINT (array->pdata[0]), ==, 1);
+
+  data = g_ptr_array_free (array, FALSE);
+
+  n_cleared = 0;
+  array = g_ptr_array_new_in_arena (arena, 4, clear_element);
+  g_ptr_array_add (array, arena);
+  g_ptr_array_add (array, arena);
+  other = g_ptr_array_new ();
+  g_ptr_array_extend_and_steal (other, g_ptr_array_ref (array));
+  g_assert_cmpuint (other->len, ==, 2);
+  g_ptr_array_unref (other);
+  g_ptr_array_unref (array);
+  g_assert_cmpint (n_cleared, ==, 0);
+
+  array = g_ptr_array_new_in_arena (arena, 4, clear_element);
+  g_ptr_array_add (array, arena);
+  g_ptr_array_unref (array);
+  g_assert_cmpint (n_cleared, ==, 1);
+
+  g_mem_arena_reset (arena);
+
+  /* Requests can reuse the arena after a reset */
+  array = g_ptr_array_new_in_arena (arena, 0, NULL);
+  g_ptr_array_add (array, data);
+  g_ptr_array_unref (array);
+
+  g_mem_arena_free (arena);
+
+  g_assert_cmpuint (GPOINTER_TO_UINT (data[998]), ==, 999);
+  g_free (data);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/mem-arena/basic", test_basic);
+  g_test_add_func ("/mem-arena/realloc", test_realloc);
+  g_test_add_func ("/mem-arena/reset", test_reset);
+  g_test_add_func ("/mem-arena/thread-local", test_thread_local);
+  g_test_add_func ("/mem-arena/string", test_string);
+  g_test_add_func ("/mem-arena/array", test_array);
+  g_test_add_func ("/mem-arena/ptr-array", test_ptr_array);
+
+  return g_test_run ();
+}
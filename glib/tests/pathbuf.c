@@ -243,6 +243,75 @@ test_pathbuf_filename_extension (void)
 #endif
 }
 
+static void
+test_pathbuf_storage (void)
+{
+#ifdef G_OS_UNIX
+  char storage[16];
+  GPathBuf buf, cmp;
+  GPathBuf *copy;
+  char *path;
+
+  g_path_buf_init_with_storage (&buf, storage, sizeof (storage));
+  g_assert_null (g_path_buf_get_path (&buf));
+
+  /* The path is built into the caller storage while it fits */
+  g_path_buf_push (&buf, "/usr");
+  g_assert_true (g_path_buf_get_path (&buf) == storage);
+  g_assert_cmpstr (g_path_buf_get_path (&buf), ==, "/usr");
+
+  g_path_buf_push (&buf, "lib");
+  g_assert_true (g_path_buf_set_extension (&buf, "d"));
+  g_assert_true (g_path_buf_get_path (&buf) == storage);
+  g_assert_cmpstr (g_path_buf_get_path (&buf), ==, "/usr/lib.d");
+
+  /* …and moved to the heap when it outgrows it */
+  g_path_buf_push (&buf, "x86_64-linux-gnu");
+  g_assert_false (g_path_buf_get_path (&buf) == storage);
+  g_assert_cmpstr (g_path_buf_get_path (&buf), ==, "/usr/lib/x86_64-linux-gnu.d");
+
+  g_path_buf_init_from_path (&cmp, "/usr/lib/x86_64-linux-gnu");
+  g_path_buf_set_extension (&cmp, "d");
+  g_assert_path_buf_equal (&buf, &cmp);
+  g_path_buf_clear (&cmp);
+
+  copy = g_path_buf_copy (&buf);
+  g_assert_path_buf_equal (&buf, copy);
+  g_path_buf_free (copy);
+
+  g_assert_true (g_path_buf_pop (&buf));
+  g_assert_true (g_path_buf_pop (&buf));
+  g_assert_cmpstr (g_path_buf_get_path (&buf), ==, "/usr.d");
+  g_assert_true (g_path_buf_pop (&buf));
+  g_assert_false (g_path_buf_pop (&buf));
+  g_assert_true (g_path_buf_set_extension (&buf, NULL));
+  g_assert_cmpstr (g_path_buf_get_path (&buf), ==, "/");
+
+  path = g_path_buf_clear_to_path (&buf);
+  g_assert_cmpstr (path, ==, "/");
+  g_free (path);
+
+  g_path_buf_init_with_storage (&buf, storage, sizeof (storage));
+  g_path_buf_push (&buf, "foo//bar/");
+  g_assert_true (g_path_buf_get_path (&buf) == storage);
+  g_assert_cmpstr (g_path_buf_get_path (&buf), ==, "foo/bar");
+  g_path_buf_clear (&buf);
+#elif defined(G_OS_WIN32)
+  char storage[16];
+  GPathBuf buf;
+
+  g_path_buf_init_with_storage (&buf, storage, sizeof (storage));
+  g_path_buf_push (&buf, "C:\\windows");
+  g_path_buf_push (&buf, "system32/drivers");
+  g_assert_cmpstr (g_path_buf_get_path (&buf), ==, "C:\\windows\\system32\\drivers");
+  g_assert_true (g_path_buf_pop (&buf));
+  g_assert_cmpstr (g_path_buf_get_path (&buf), ==, "C:\\windows\\system32");
+  g_path_buf_clear (&buf);
+#else
+  g_test_skip ("Unsupported platform");
+#endif
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -253,6 +322,7 @@ main (int   argc,
   g_test_add_func ("/pathbuf/init", test_pathbuf_init);
   g_test_add_func ("/pathbuf/push-pop", test_pathbuf_push_pop);
   g_test_add_func ("/pathbuf/filename-extension", test_pathbuf_filename_extension);
+  g_test_add_func ("/pathbuf/storage", test_pathbuf_storage);
 
   return g_test_run ();
 }
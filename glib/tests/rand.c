@@ -22,6 +22,8 @@
  */
 
 #include "glib.h"
+#include "glib/glib-private.h"
+#include <string.h>
 
 /* Outputs tested against the reference implementation mt19937ar.c from
  * http://www.math.sci.hiroshima-u.ac.jp/~m-mat/MT/MT2002/emt19937ar.html
@@ -170,6 +172,123 @@ test_double_range (void)
   g_assert_cmpfloat (d, <, G_MAXDOUBLE);
 }
 
+static void
+test_fast_rand (void)
+{
+  const guint32 seed[] = { 1, 2, 3, 4 };
+  GRand *rand, *copy;
+  guint8 bytes[37];
+  gdouble doubles[100];
+  guint8 seen = 0;
+  gsize i;
+
+  rand = g_rand_new_fast ();
+  copy = g_rand_new_fast ();
+
+  /* the same seed gives the same sequence */
+  g_rand_set_seed_array (rand, seed, G_N_ELEMENTS (seed));
+  g_rand_set_seed_array (copy, seed, G_N_ELEMENTS (seed));
+  for (i = 0; i < 100; i++)
+    g_assert_cmpuint (g_rand_int (rand), ==, g_rand_int (copy));
+
+  g_rand_set_seed (rand, 42);
+  g_rand_free (copy);
+  copy = g_rand_copy (rand);
+  for (i = 0; i < 100; i++)
+    g_assert_cmpfloat (g_rand_double (rand), ==, g_rand_double (copy));
+
+  /* bulk fills match the single-value calls */
+  g_rand_fill_doubles (rand, doubles, G_N_ELEMENTS (doubles));
+  for (i = 0; i < G_N_ELEMENTS (doubles); i++)
+    {
+      g_assert_cmpfloat (doubles[i], >=, 0.0);
+      g_assert_cmpfloat (doubles[i], <, 1.0);
+      g_assert_cmpfloat (doubles[i], ==, g_rand_double (copy));
+    }
+
+  memset (bytes, 0, sizeof (bytes));
+  for (i = 0; i < 100; i++)
+    {
+      g_rand_fill_bytes (rand, bytes, sizeof (bytes));
+      seen |= bytes[sizeof (bytes) - 1];
+    }
+  g_assert_cmpuint (seen, !=, 0);
+
+  for (i = 0; i < 1000; i++)
+    {
+      gint32 r = g_rand_int_range (rand, -3, 5);
+
+      g_assert_cmpint (r, >=, -3);
+      g_assert_cmpint (r, <, 5);
+    }
+
+  g_rand_free (rand);
+  g_rand_free (copy);
+}
+
+static void
+test_fill (void)
+{
+  GRand *rand, *copy;
+  gdouble doubles[10];
+  guint8 bytes[10];
+  guint32 expected[3];
+  gsize i;
+
+  rand = g_rand_new_with_seed (42);
+  copy = g_rand_copy (rand);
+
+  g_rand_fill_doubles (rand, doubles, G_N_ELEMENTS (doubles));
+  for (i = 0; i < G_N_ELEMENTS (doubles); i++)
+    g_assert_cmpfloat (doubles[i], ==, g_rand_double (copy));
+
+  g_rand_fill_bytes (rand, bytes, sizeof (bytes));
+  for (i = 0; i < G_N_ELEMENTS (expected); i++)
+    expected[i] = g_rand_int (copy);
+  g_assert_cmpmem (bytes, sizeof (bytes), expected, sizeof (bytes));
+
+  g_rand_free (rand);
+  g_rand_free (copy);
+}
+
+static void
+test_system_seed (void)
+{
+  const guint32 sentinel = 0xa5a5a5a5;
+  gboolean changed[4] = { FALSE, };
+  gsize i, j;
+
+  /* Every word of the seed is filled in, not just the first few. Any
+   * single word may legitimately come out as the sentinel, so try a few
+   * times. */
+  for (i = 0; i < 4; i++)
+    {
+      guint32 seed[4] = { sentinel, sentinel, sentinel, sentinel };
+
+      GLIB_PRIVATE_CALL (g_rand_get_seed_from_system) (seed);
+      for (j = 0; j < G_N_ELEMENTS (seed); j++)
+        changed[j] |= (seed[j] != sentinel);
+    }
+
+  for (j = 0; j < G_N_ELEMENTS (changed); j++)
+    g_assert_true (changed[j]);
+}
+
+static void
+test_random_set_seed (void)
+{
+  GRand *rand;
+  gsize i;
+
+  /* after seeding, the global functions give the seeded sequence */
+  g_random_set_seed (42);
+  rand = g_rand_new_with_seed (42);
+  for (i = 0; i < 100; i++)
+    g_assert_cmpuint (g_random_int (), ==, g_rand_int (rand));
+
+  g_rand_free (rand);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -178,6 +297,10 @@ main (int   argc,
 
   g_test_add_func ("/rand/test-rand", test_rand);
   g_test_add_func ("/rand/double-range", test_double_range);
+  g_test_add_func ("/rand/fast", test_fast_rand);
+  g_test_add_func ("/rand/fill", test_fill);
+  g_test_add_func ("/rand/system-seed", test_system_seed);
+  g_test_add_func ("/rand/random-set-seed", test_random_set_seed);
 
   return g_test_run();
 }
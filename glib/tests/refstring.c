@@ -102,6 +102,84 @@ test_refstring_intern (void)
   g_ref_string_release (s);
 }
 
+/* test_refstring_intern_not_interned: Test that releasing a string which
+ * was not interned does not affect an interned string with the same
+ * contents */
+static void
+test_refstring_intern_not_interned (void)
+{
+  char *s = g_ref_string_new_intern ("not interned");
+  char *p = g_ref_string_new ("not interned");
+  char *q;
+
+  g_assert_false (s == p);
+  g_ref_string_release (p);
+
+  q = g_ref_string_new_intern ("not interned");
+  g_assert_true (s == q);
+
+  g_ref_string_release (q);
+  g_ref_string_release (s);
+}
+
+#define N_INTERN_THREADS 4
+#define N_INTERN_STRINGS 200
+
+static char *intern_expected[N_INTERN_STRINGS];
+
+static gpointer
+intern_thread (gpointer data)
+{
+  guint i, j;
+
+  for (i = 0; i < 50; i++)
+    {
+      for (j = 0; j < N_INTERN_STRINGS; j++)
+        {
+          char buf[32];
+          char *s;
+
+          g_snprintf (buf, sizeof (buf), "intern-%u", j);
+          s = g_ref_string_new_intern (buf);
+          g_assert_true (s == intern_expected[j]);
+          g_ref_string_release (s);
+
+          /* Strings which nobody else keeps alive come and go */
+          g_snprintf (buf, sizeof (buf), "transient-%u", (i * 7 + j) % 300);
+          s = g_ref_string_new_intern (buf);
+          g_assert_cmpstr (s, ==, buf);
+          g_ref_string_release (s);
+        }
+    }
+
+  return NULL;
+}
+
+/* test_refstring_intern_threaded: Test interning the same strings from
+ * several threads at once */
+static void
+test_refstring_intern_threaded (void)
+{
+  GThread *threads[N_INTERN_THREADS];
+  guint i;
+
+  for (i = 0; i < N_INTERN_STRINGS; i++)
+    {
+      char buf[32];
+
+      g_snprintf (buf, sizeof (buf), "intern-%u", i);
+      intern_expected[i] = g_ref_string_new_intern (buf);
+    }
+
+  for (i = 0; i < N_INTERN_THREADS; i++)
+    threads[i] = g_thread_new ("intern", intern_thread, NULL);
+  for (i = 0; i < N_INTERN_THREADS; i++)
+    g_thread_join (threads[i]);
+
+  for (i = 0; i < N_INTERN_STRINGS; i++)
+    g_ref_string_release (intern_expected[i]);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -113,6 +191,8 @@ main (int   argc,
   g_test_add_func ("/refstring/length-auto", test_refstring_length_auto);
   g_test_add_func ("/refstring/length-nuls", test_refstring_length_nuls);
   g_test_add_func ("/refstring/intern", test_refstring_intern);
+  g_test_add_func ("/refstring/intern/not-interned", test_refstring_intern_not_interned);
+  g_test_add_func ("/refstring/intern/threaded", test_refstring_intern_threaded);
 
   return g_test_run ();
 }
@@ -2529,6 +2529,153 @@ test_compiled_regex_after_jit_failure (void)
   g_regex_unref (regex);
 }
 
+static void
+test_match_reusing (void)
+{
+  GRegex *words, *pairs;
+  GMatchInfo *match_info = NULL;
+  GMatchInfo *reused;
+  gchar *str;
+
+  g_test_summary ("Test that g_regex_match_reusing() reuses and resets match infos");
+
+  words = g_regex_new ("[a-z]+", G_REGEX_OPTIMIZE, G_REGEX_MATCH_DEFAULT, NULL);
+  pairs = g_regex_new ("([a-z]+)=([0-9]+)", G_REGEX_DEFAULT, G_REGEX_MATCH_DEFAULT, NULL);
+
+  g_assert_true (g_regex_match_reusing (words, "123 abc", -1, 0, &match_info));
+  g_assert_nonnull (match_info);
+  reused = match_info;
+  str = g_match_info_fetch (match_info, 0);
+  g_assert_cmpstr (str, ==, "abc");
+  g_free (str);
+
+  /* A failed match resets the previous results */
+  g_assert_false (g_regex_match_reusing (words, "123", -1, 0, &match_info));
+  g_assert_true (match_info == reused);
+  g_assert_false (g_match_info_matches (match_info));
+  g_assert_null (g_match_info_fetch (match_info, 0));
+
+  /* Switching to a regex with more subpatterns */
+  g_assert_true (g_regex_match_reusing (pairs, "x key=42", -1, 0, &match_info));
+  g_assert_true (match_info == reused);
+  g_assert_true (g_match_info_get_regex (match_info) == pairs);
+  g_assert_cmpint (g_match_info_get_match_count (match_info), ==, 3);
+  str = g_match_info_fetch (match_info, 2);
+  g_assert_cmpstr (str, ==, "42");
+  g_free (str);
+  g_assert_false (g_match_info_next (match_info, NULL));
+
+  /* A match info referenced elsewhere is not modified */
+  g_match_info_ref (match_info);
+  g_assert_true (g_regex_match_reusing (words, "def", 3, 0, &match_info));
+  g_assert_true (match_info != reused);
+  g_assert_true (g_match_info_get_regex (reused) == pairs);
+  g_match_info_unref (reused);
+
+  g_match_info_unref (match_info);
+
+  /* Boolean matches must not keep the regex alive nor leak state between
+   * regexes */
+  g_assert_true (g_regex_match (pairs, "a=1", 0, NULL));
+  g_assert_false (g_regex_match (words, "123", 0, NULL));
+  g_assert_true (g_regex_match (words, "abc", 0, NULL));
+
+  g_regex_unref (pairs);
+  g_regex_unref (words);
+}
+
+static void
+test_regex_set (void)
+{
+  const gchar *patterns[] = {
+    "ERROR: disk .* full",
+    "warn(ing)?: [0-9]+",
+    "foo|bar",
+    "colou?r",
+    "a\\.b\\d+c",
+    "x{2,3}yz",
+    "[[:alpha:]]]end",
+    "(?:abc)+def",
+    "\\x41BC",
+    "(?i)caseless",
+    "café+",
+    "ERROR",
+    NULL
+  };
+  const gchar *strings[] = {
+    "",
+    "ERROR: disk /dev/sda full",
+    "warning: 42 and warn: 7",
+    "a bar at the color",
+    "a.b12c",
+    "xxyz and xxxyz",
+    "q]end",
+    "abcabcdef",
+    "ABC",
+    "CASELESS",
+    "cafééé",
+    "colr foo",
+    "nothing to see here",
+  };
+  GRegexSet *set;
+  gsize i;
+
+  g_test_summary ("Test that GRegexSet finds the same matches as individual regexes");
+
+  set = g_regex_set_new (patterns, G_REGEX_DEFAULT, G_REGEX_MATCH_DEFAULT, NULL);
+  g_assert_nonnull (set);
+  g_assert_cmpuint (g_regex_set_get_n_patterns (set), ==, G_N_ELEMENTS (patterns) - 1);
+  g_assert_cmpstr (g_regex_get_pattern (g_regex_set_get_regex (set, 3)), ==, "colou?r");
+
+  for (i = 0; i < G_N_ELEMENTS (strings); i++)
+    {
+      GArray *expected = g_array_new (FALSE, FALSE, sizeof (guint));
+      guint *matches = NULL;
+      gsize n_matches = 0;
+      gboolean matched;
+      guint j;
+
+      for (j = 0; patterns[j] != NULL; j++)
+        {
+          if (g_regex_match (g_regex_set_get_regex (set, j), strings[i], 0, NULL))
+            g_array_append_val (expected, j);
+        }
+
+      matched = g_regex_set_match (set, strings[i], -1, 0, &matches, &n_matches);
+      g_assert_cmpint (matched, ==, expected->len > 0);
+      g_assert_cmpmem (matches, n_matches * sizeof (guint),
+                       expected->data, expected->len * sizeof (guint));
+
+      g_free (matches);
+      g_array_unref (expected);
+    }
+
+  g_regex_set_unref (set);
+}
+
+static void
+test_regex_set_errors (void)
+{
+  const gchar *patterns[] = { "fine", "(broken", NULL };
+  const gchar *no_patterns[] = { NULL };
+  GRegexSet *set;
+  guint *matches = NULL;
+  gsize n_matches = 1;
+  GError *error = NULL;
+
+  set = g_regex_set_new (patterns, G_REGEX_DEFAULT, G_REGEX_MATCH_DEFAULT, &error);
+  g_assert_error (error, G_REGEX_ERROR, G_REGEX_ERROR_UNMATCHED_PARENTHESIS);
+  g_assert_null (set);
+  g_clear_error (&error);
+
+  set = g_regex_set_new (no_patterns, G_REGEX_DEFAULT, G_REGEX_MATCH_DEFAULT, &error);
+  g_assert_no_error (error);
+  g_assert_false (g_regex_set_match (set, "anything", -1, 0, &matches, &n_matches));
+  g_assert_null (matches);
+  g_assert_cmpuint (n_matches, ==, 0);
+  g_regex_set_unref (set);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -2550,6 +2697,9 @@ main (int argc, char *argv[])
   g_test_add_func ("/regex/jit-unsupported-matching", test_jit_unsupported_matching_options);
   g_test_add_func ("/regex/unmatched-named-subpattern", test_unmatched_named_subpattern);
   g_test_add_func ("/regex/compiled-regex-after-jit-failure", test_compiled_regex_after_jit_failure);
+  g_test_add_func ("/regex/match-reusing", test_match_reusing);
+  g_test_add_func ("/regex/set", test_regex_set);
+  g_test_add_func ("/regex/set/errors", test_regex_set_errors);
 
   /* TEST_NEW(pattern, compile_opts, match_opts) */
   TEST_NEW("[A-Z]+", G_REGEX_CASELESS | G_REGEX_EXTENDED | G_REGEX_OPTIMIZE, G_REGEX_MATCH_NOTBOL | G_REGEX_MATCH_PARTIAL);
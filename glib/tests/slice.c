@@ -1,6 +1,8 @@
 #include <string.h>
 #include <glib.h>
 
+#include "../gvalgrind.h"
+
 /* We test deprecated functionality here */
 G_GNUC_BEGIN_IGNORE_DEPRECATIONS
 
@@ -90,6 +92,92 @@ test_allocate (void)
     g_thread_join (threads[i]);
 }
 
+static void
+test_magazine (void)
+{
+  gint64 *stats;
+  gint64 *contention;
+  gint64 *sizes;
+  gpointer blocks[1000];
+  GThread *threads[8];
+  guint n_values;
+  gsize i;
+
+  if (!g_test_subprocess ())
+    {
+      gchar **envp = g_environ_setenv (g_get_environ (), "G_SLICE", "magazine", TRUE);
+
+      g_test_trap_subprocess_with_envp (NULL, (const gchar * const *) envp, 0,
+                                        G_TEST_SUBPROCESS_DEFAULT);
+      g_test_trap_assert_passed ();
+      g_strfreev (envp);
+      return;
+    }
+
+  if (RUNNING_ON_VALGRIND)
+    {
+      g_test_skip ("Magazines are disabled under valgrind");
+      return;
+    }
+
+  g_assert_cmpint (g_slice_get_config (G_SLICE_CONFIG_ALWAYS_MALLOC), ==, FALSE);
+
+  sizes = g_slice_get_config_state (G_SLICE_CONFIG_CHUNK_SIZES, 0, &n_values);
+  g_assert_nonnull (sizes);
+  g_assert_cmpuint (n_values, >, 0);
+  g_assert_cmpint (sizes[0], ==, 2 * sizeof (gpointer));
+  g_free (sizes);
+
+  /* Blocks are aligned, distinct and reused */
+  for (i = 0; i < G_N_ELEMENTS (blocks); i++)
+    {
+      blocks[i] = g_slice_alloc (24);
+      g_assert_cmpuint (GPOINTER_TO_SIZE (blocks[i]) % sizeof (gpointer), ==, 0);
+      memset (blocks[i], i & 0xff, 24);
+    }
+  for (i = 0; i < G_N_ELEMENTS (blocks); i++)
+    {
+      guint8 *block = blocks[i];
+
+      g_assert_cmpuint (block[0], ==, i & 0xff);
+      g_assert_cmpuint (block[23], ==, i & 0xff);
+      g_slice_free1 (24, blocks[i]);
+    }
+
+  test_chain ();
+
+  /* Exchange magazines between threads through the depots */
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    threads[i] = g_thread_new ("slice", thread_allocate, NULL);
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    g_thread_join (threads[i]);
+
+  /* Large blocks are not served from magazines */
+  g_slice_free1 (4096, g_slice_alloc (4096));
+  g_assert_null (g_slice_get_config_state (G_SLICE_CONFIG_STATISTICS, 4096, &n_values));
+  g_assert_cmpuint (n_values, ==, 0);
+
+  stats = g_slice_get_config_state (G_SLICE_CONFIG_STATISTICS, 24, &n_values);
+  g_assert_nonnull (stats);
+  g_assert_cmpuint (n_values, ==, 6);
+  g_assert_cmpint (stats[0], >=, 24);
+  /* The counts of exited threads have been flushed */
+  g_assert_cmpint (stats[1], >, 0);
+  g_assert_cmpint (stats[2], >, 0);
+  g_assert_cmpint (stats[4], >, 0);
+  g_test_message ("%" G_GINT64_FORMAT "-byte slices: %" G_GINT64_FORMAT " allocated, "
+                  "%" G_GINT64_FORMAT " freed, %" G_GINT64_FORMAT " refills from the "
+                  "depot, %" G_GINT64_FORMAT " new slabs, %" G_GINT64_FORMAT
+                  " magazines returned",
+                  stats[0], stats[1], stats[2], stats[3], stats[4], stats[5]);
+  g_free (stats);
+
+  contention = g_slice_get_config_state (G_SLICE_CONFIG_CONTENTION_COUNTER, 24, &n_values);
+  g_assert_cmpuint (n_values, ==, 1);
+  g_assert_cmpint (contention[0], >=, 0);
+  g_free (contention);
+}
+
 int
 main (int argc, char **argv)
 {
@@ -98,6 +186,7 @@ main (int argc, char **argv)
   g_test_add_func ("/slice/copy", test_slice_copy);
   g_test_add_func ("/slice/chain", test_chain);
   g_test_add_func ("/slice/allocate", test_allocate);
+  g_test_add_func ("/slice/magazine", test_magazine);
 
   return g_test_run ();
 }
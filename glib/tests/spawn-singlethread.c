@@ -36,6 +36,7 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
 #include <unistd.h>
 #endif
 
@@ -471,6 +472,34 @@ test_posix_spawn (void)
   g_ptr_array_free (argv, TRUE);
 }
 
+/* Like test_posix_spawn but with a working directory and the default of
+ * closing descriptors, which the optimized codepath can also handle with
+ * some C libraries. */
+static void
+test_spawn_working_directory (void)
+{
+  GError *error = NULL;
+  const char *argv[] = { NULL, "working directory", NULL };
+  char *stdout_str = NULL;
+  int estatus;
+
+  argv[0] = echo_prog_path;
+
+  g_spawn_sync (g_get_tmp_dir (), (char **) argv, NULL, G_SPAWN_DEFAULT,
+                NULL, NULL, &stdout_str, NULL, &estatus, &error);
+  g_assert_no_error (error);
+  g_assert_cmpstr (stdout_str, ==, "working directory");
+  g_free (stdout_str);
+
+  /* A missing working directory must still be told apart from a missing
+   * program. */
+  g_spawn_sync ("/this/does/not/exist", (char **) argv, NULL, G_SPAWN_DEFAULT,
+                NULL, NULL, &stdout_str, NULL, &estatus, &error);
+  g_assert_error (error, G_SPAWN_ERROR, G_SPAWN_ERROR_CHDIR);
+  g_assert_null (stdout_str);
+  g_clear_error (&error);
+}
+
 static void
 test_spawn_script (void)
 {
@@ -581,6 +610,52 @@ test_spawn_fd_assignment_clash (void)
     g_close (source_fds[i], NULL);
 }
 
+#ifdef G_OS_UNIX
+/* Spawn a child the way a GSubprocessLauncher with a working directory, a
+ * stdout pipe and an fd mapping does, and wait for it. */
+static void
+benchmark_spawn (gconstpointer data,
+                 guint64       n_iterations)
+{
+  const char *argv[] = { NULL, "benchmark", NULL };
+  int fds[2];
+  int source_fds[1];
+  int target_fds[1] = { 3 };
+  guint64 i;
+
+  argv[0] = echo_prog_path;
+
+  g_assert_no_errno (pipe (fds));
+  source_fds[0] = fds[1];
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      GError *error = NULL;
+      GPid pid;
+      int stdout_fd;
+      char buf[64];
+      int wait_status;
+
+      g_spawn_async_with_pipes_and_fds (g_get_tmp_dir (), argv, NULL,
+                                        G_SPAWN_DO_NOT_REAP_CHILD | G_SPAWN_CLOEXEC_PIPES,
+                                        NULL, NULL, -1, -1, -1,
+                                        source_fds, target_fds, G_N_ELEMENTS (source_fds),
+                                        &pid, NULL, &stdout_fd, NULL,
+                                        &error);
+      g_assert_no_error (error);
+
+      while (read (stdout_fd, buf, sizeof (buf)) > 0);
+      g_close (stdout_fd, NULL);
+
+      g_assert_cmpint (waitpid (pid, &wait_status, 0), ==, pid);
+      g_spawn_close_pid (pid);
+    }
+
+  g_close (fds[0], NULL);
+  g_close (fds[1], NULL);
+}
+#endif
+
 int
 main (int   argc,
       char *argv[])
@@ -613,7 +688,11 @@ main (int   argc,
   g_test_add_func ("/gthread/spawn-script", test_spawn_script);
   g_test_add_func ("/gthread/spawn/nonexistent", test_spawn_nonexistent);
   g_test_add_func ("/gthread/spawn-posix-spawn", test_posix_spawn);
+  g_test_add_func ("/gthread/spawn/working-directory", test_spawn_working_directory);
   g_test_add_func ("/gthread/spawn/fd-assignment-clash", test_spawn_fd_assignment_clash);
+#ifdef G_OS_UNIX
+  g_test_add_benchmark ("/gthread/spawn/benchmark", NULL, benchmark_spawn);
+#endif
 
   ret = g_test_run();
 
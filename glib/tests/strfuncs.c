@@ -1579,6 +1579,135 @@ test_strsplit_set (void)
 }
 
 /* Testing g_strv_length() function with various positive and negative cases */
+/* Splits @string at any of @set, one byte at a time */
+static GPtrArray *
+split_bytes (const gchar *string,
+             gsize        length,
+             const gchar *set)
+{
+  GPtrArray *tokens = g_ptr_array_new_with_free_func (g_free);
+  gsize i, start = 0;
+
+  if (length == 0)
+    return tokens;
+
+  for (i = 0; i < length; i++)
+    if (strchr (set, string[i]) != NULL && string[i] != '\0')
+      {
+        g_ptr_array_add (tokens, g_strndup (string + start, i - start));
+        start = i + 1;
+      }
+  g_ptr_array_add (tokens, g_strndup (string + start, length - start));
+
+  return tokens;
+}
+
+static void
+check_token_iter (GStrTokenIter *iter,
+                  GPtrArray     *expected)
+{
+  const gchar *token;
+  gsize token_len;
+  guint n = 0;
+
+  while (g_str_token_iter_next (iter, &token, &token_len))
+    {
+      g_assert_cmpuint (n, <, expected->len);
+      g_assert_cmpmem (token, token_len, expected->pdata[n], strlen (expected->pdata[n]));
+      n++;
+    }
+
+  g_assert_cmpuint (n, ==, expected->len);
+  g_assert_false (g_str_token_iter_next (iter, &token, &token_len));
+  g_assert_false (g_str_token_iter_next_remainder (iter, &token, &token_len));
+}
+
+static void
+test_str_token_iter (void)
+{
+  GStrTokenIter iter;
+  const gchar *token;
+  gsize token_len;
+  const gchar *sets[] = { ",", ",;", "ab", "\t \n", "\x01\x11\x21\x31\x41\x51\x61\x71\x81\x91\xa1\xb1\xc1\xd1\xe1\xf1", "\xff\x80" };
+  gchar buffer[200];
+  guint i, j;
+
+  /* Multi-byte delimiters, with the string's length given */
+  g_str_token_iter_init (&iter, "a::b:::c::", 9, "::");
+  g_assert_true (g_str_token_iter_next (&iter, &token, &token_len));
+  g_assert_cmpmem (token, token_len, "a", 1);
+  g_assert_true (g_str_token_iter_next (&iter, &token, &token_len));
+  g_assert_cmpmem (token, token_len, "b", 1);
+  g_assert_true (g_str_token_iter_next (&iter, &token, &token_len));
+  g_assert_cmpmem (token, token_len, ":c:", 3);
+  g_assert_false (g_str_token_iter_next (&iter, &token, &token_len));
+
+  /* The remainder includes the delimiters */
+  g_str_token_iter_init (&iter, "k=v=w", -1, "=");
+  g_assert_true (g_str_token_iter_next (&iter, &token, &token_len));
+  g_assert_cmpmem (token, token_len, "k", 1);
+  g_assert_true (g_str_token_iter_next_remainder (&iter, &token, &token_len));
+  g_assert_cmpmem (token, token_len, "v=w", 3);
+  g_assert_false (g_str_token_iter_next (&iter, NULL, NULL));
+
+  /* The empty string has no tokens */
+  g_str_token_iter_init (&iter, "", -1, ",");
+  g_assert_false (g_str_token_iter_next (&iter, NULL, NULL));
+  g_str_token_iter_init_set (&iter, NULL, 0, ",");
+  g_assert_false (g_str_token_iter_next_remainder (&iter, NULL, NULL));
+
+  /* Without delimiters, there's only one */
+  g_str_token_iter_init_set (&iter, "a,b", -1, "");
+  g_assert_true (g_str_token_iter_next (&iter, &token, &token_len));
+  g_assert_cmpmem (token, token_len, "a,b", 3);
+  g_assert_false (g_str_token_iter_next (&iter, NULL, NULL));
+
+  /* Nul bytes are part of the tokens */
+  g_str_token_iter_init (&iter, "a\0b,c", 5, ",");
+  g_assert_true (g_str_token_iter_next (&iter, &token, &token_len));
+  g_assert_cmpmem (token, token_len, "a\0b", 3);
+
+  /* Random strings of various lengths, to cover both the vectorised and the
+   * byte-at-a-time scanning */
+  for (i = 0; i < G_N_ELEMENTS (sets); i++)
+    for (j = 0; j < 500; j++)
+      {
+        gsize length = g_test_rand_int_range (0, sizeof (buffer));
+        const gchar *alphabet = "xyz,;ab\t \n\x01\x21\xf1\x80\xff";
+        GPtrArray *expected;
+        gchar **strv;
+        gsize k;
+
+        for (k = 0; k < length; k++)
+          {
+            if (g_test_rand_int_range (0, 4) == 0)
+              buffer[k] = alphabet[g_test_rand_int_range (0, strlen (alphabet))];
+            else
+              buffer[k] = 'x';
+          }
+        buffer[length] = '\0';
+
+        expected = split_bytes (buffer, length, sets[i]);
+
+        g_str_token_iter_init_set (&iter, buffer, length, sets[i]);
+        check_token_iter (&iter, expected);
+
+        strv = g_strsplit_set (buffer, sets[i], -1);
+        g_assert_cmpuint (g_strv_length (strv), ==, expected->len);
+        for (k = 0; k < expected->len; k++)
+          g_assert_cmpstr (strv[k], ==, expected->pdata[k]);
+        g_strfreev (strv);
+
+        if (strlen (sets[i]) == 1)
+          {
+            g_str_token_iter_init (&iter, buffer, -1, sets[i]);
+            check_token_iter (&iter, expected);
+          }
+
+        g_ptr_array_unref (expected);
+      }
+}
+
 static void
 test_strv_length (void)
 {
@@ -1744,6 +1873,116 @@ test_ascii_strtod (void)
   check_strtod_number (1e99, "%.0e", "1e+99");
 }
 
+/* Cases near the rounding boundaries, compared against the C library */
+static void
+test_ascii_strtod_rounding (void)
+{
+  const gchar *numbers[] = {
+    "9007199254740993",           /* halfway between 2^53 and 2^53 + 2 */
+    "9007199254740993.0000000001",
+    "9007199254740995",
+    "90071992547409930e-1",
+    "1e23",
+    "8.98846567431158e307",
+    "1.7976931348623157e308",
+    "1.7976931348623159e308",     /* overflows */
+    "2.2250738585072011e-308",    /* largest subnormal */
+    "2.2250738585072014e-308",    /* smallest normal */
+    "4.9406564584124654e-324",
+    "2.4703282292062327e-324",    /* underflows */
+    "1e-400",
+    "0.000000000000000000000000000000000000000001",
+    "123456789012345678901234567890",
+    "0.1000000000000000055511151231257827021181583404541015625",
+    "7.3177701707893310e+15",
+    "1448997445238699",
+    "-0",
+    "0e999999",
+    "00000000000000000000000000000000000001.5",
+    "1.5e",
+    "1.5e+",
+    "1ee5",
+  };
+  gsize i;
+
+  for (i = 0; i < G_N_ELEMENTS (numbers); i++)
+    {
+      gchar *end, *expected_end;
+      gdouble d, expected;
+      gint err;
+
+      errno = 0;
+      expected = strtod (numbers[i], &expected_end);
+      err = errno;
+
+      errno = 0;
+      d = g_ascii_strtod (numbers[i], &end);
+      g_assert_cmpmem (&d, sizeof (d), &expected, sizeof (expected));
+      g_assert_true (end == expected_end);
+      g_assert_cmpint (errno, ==, err);
+    }
+}
+
+static void
+check_dtostr (gdouble      d,
+              const gchar *expected)
+{
+  gchar buffer[G_ASCII_DTOSTR_BUF_SIZE];
+
+  g_assert_cmpstr (g_ascii_dtostr (buffer, sizeof (buffer), d), ==, expected);
+  g_assert_true (g_ascii_strtod (buffer, NULL) == d);
+}
+
+/* g_ascii_dtostr() gives the shortest string which parses to the same value */
+static void
+test_ascii_dtostr (void)
+{
+  gchar buffer[G_ASCII_DTOSTR_BUF_SIZE];
+  gchar small[4];
+  guint i;
+
+  check_dtostr (0.0, "0");
+  check_dtostr (-0.0, "-0");
+  check_dtostr (1.0, "1");
+  check_dtostr (0.1, "0.1");
+  check_dtostr (0.1 + 0.2, "0.30000000000000004");
+  check_dtostr (-123.125, "-123.125");
+  check_dtostr (1e-4, "0.0001");
+  check_dtostr (1e-5, "1e-05");
+  check_dtostr (1.5e-300, "1.5e-300");
+  check_dtostr (1e16, "10000000000000000");
+  check_dtostr (1e17, "1e+17");
+  check_dtostr (123456789012345680.0, "1.2345678901234568e+17");
+  check_dtostr (5e-324, "5e-324");
+  check_dtostr (2.2250738585072014e-308, "2.2250738585072014e-308");
+  check_dtostr (1.7976931348623157e308, "1.7976931348623157e+308");
+  check_dtostr (9007199254740993.0, "9007199254740992");
+
+#ifdef INFINITY
+  check_dtostr (INFINITY, "inf");
+  check_dtostr (-INFINITY, "-inf");
+#endif
+
+  /* Truncation */
+  g_assert_cmpstr (g_ascii_dtostr (small, sizeof (small), 3.25), ==, "3.2");
+
+  /* Random values round trip */
+  for (i = 0; i < 10000; i++)
+    {
+      guint64 bits = (guint64) g_test_rand_int () << 32 | (guint32) g_test_rand_int ();
+      gdouble d, parsed;
+
+      memcpy (&d, &bits, sizeof (d));
+      if (isnan (d) || isinf (d))
+        continue;
+
+      g_ascii_dtostr (buffer, sizeof (buffer), d);
+      parsed = g_ascii_strtod (buffer, NULL);
+      g_assert_cmpmem (&parsed, sizeof (parsed), &d, sizeof (d));
+      g_assert_true (strtod (buffer, NULL) == d);
+    }
+}
+
 static void
 check_uint64 (const gchar *str,
 	      const gchar *end,
@@ -2728,9 +2967,11 @@ main (int   argc,
   g_test_add_func ("/strfuncs/ascii-strcasecmp", test_ascii_strcasecmp);
   g_test_add_func ("/strfuncs/ascii-string-to-num/pathological", test_ascii_string_to_number_pathological);
   g_test_add_func ("/strfuncs/ascii-string-to-num/usual", test_ascii_string_to_number_usual);
+  g_test_add_func ("/strfuncs/ascii_dtostr", test_ascii_dtostr);
   g_test_add_func ("/strfuncs/ascii_strdown", test_ascii_strdown);
   g_test_add_func ("/strfuncs/ascii_strdup", test_ascii_strup);
   g_test_add_func ("/strfuncs/ascii_strtod", test_ascii_strtod);
+  g_test_add_func ("/strfuncs/ascii_strtod/rounding", test_ascii_strtod_rounding);
   g_test_add_func ("/strfuncs/bounds-check", test_bounds);
   g_test_add_func ("/strfuncs/has-prefix", test_has_prefix);
   g_test_add_func ("/strfuncs/has-prefix-macro", test_has_prefix_macro);
@@ -2765,6 +3006,7 @@ main (int   argc,
   g_test_add_func ("/strfuncs/strsignal", test_strsignal);
   g_test_add_func ("/strfuncs/strsplit", test_strsplit);
   g_test_add_func ("/strfuncs/strsplit-set", test_strsplit_set);
+  g_test_add_func ("/strfuncs/str-token-iter", test_str_token_iter);
   g_test_add_func ("/strfuncs/strstr", test_strstr);
   g_test_add_func ("/strfuncs/strtod", test_strtod);
   g_test_add_func ("/strfuncs/strtoull-strtoll", test_strtoll);
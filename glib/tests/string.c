@@ -79,6 +79,116 @@ test_string_chunk_insert (void)
   g_string_chunk_free (chunk);
 }
 
+static void
+test_string_chunk_insert_len_const (void)
+{
+  const gchar buf[] = "key=value;key=other";
+  GStringChunk *chunk;
+  gchar *a, *b, *c, *d;
+  guint i;
+
+  chunk = g_string_chunk_new (16);
+
+  a = g_string_chunk_insert_len_const (chunk, buf, 3);
+  b = g_string_chunk_insert_len_const (chunk, buf + 10, 3);
+  c = g_string_chunk_insert_const (chunk, "key");
+  d = g_string_chunk_insert_len_const (chunk, buf, 9);
+
+  g_assert_cmpstr (a, ==, "key");
+  g_assert_true (a == b);
+  g_assert_true (a == c);
+  g_assert_cmpstr (d, ==, "key=value");
+  g_assert_true (d != a);
+
+  /* Embedded nul bytes are part of the key */
+  a = g_string_chunk_insert_len_const (chunk, "a\0b", 3);
+  b = g_string_chunk_insert_len_const (chunk, "a\0c", 3);
+  g_assert_true (a != b);
+  g_assert_true (a == g_string_chunk_insert_len_const (chunk, "a\0b", 3));
+
+  /* Enough strings to grow the index */
+  for (i = 0; i < 1000; i++)
+    {
+      gchar *s = g_strdup_printf ("string %u", i);
+
+      a = g_string_chunk_insert_const (chunk, s);
+      g_assert_cmpstr (a, ==, s);
+      g_assert_true (a == g_string_chunk_insert_len_const (chunk, s, -1));
+      g_free (s);
+    }
+
+  /* Clearing keeps the blocks of the default size, and forgets the
+   * strings */
+  g_string_chunk_clear (chunk);
+  a = g_string_chunk_insert_const (chunk, "key");
+  g_assert_cmpstr (a, ==, "key");
+  g_assert_true (a == g_string_chunk_insert_const (chunk, "key"));
+
+  g_string_chunk_free (chunk);
+}
+
+#define N_CHUNK_THREADS 4
+
+static gpointer
+string_chunk_concurrent_thread (gpointer data)
+{
+  GStringChunk *chunk = data;
+  gchar **results = g_new (gchar *, 500);
+  guint i, round;
+
+  for (round = 0; round < 20; round++)
+    {
+      for (i = 0; i < 500; i++)
+        {
+          gchar buf[32];
+          gchar *s;
+
+          g_snprintf (buf, sizeof (buf), "token-%u", i);
+          s = g_string_chunk_insert_const (chunk, buf);
+          g_assert_cmpstr (s, ==, buf);
+
+          if (round == 0)
+            results[i] = s;
+          else
+            g_assert_true (s == results[i]);
+
+          s = g_string_chunk_insert (chunk, buf);
+          g_assert_cmpstr (s, ==, buf);
+        }
+    }
+
+  return results;
+}
+
+static void
+test_string_chunk_concurrent (void)
+{
+  GStringChunk *chunk;
+  GThread *threads[N_CHUNK_THREADS];
+  gchar **results[N_CHUNK_THREADS];
+  guint i, j;
+
+  chunk = g_string_chunk_new_concurrent (256);
+
+  for (i = 0; i < N_CHUNK_THREADS; i++)
+    threads[i] = g_thread_new ("chunk", string_chunk_concurrent_thread, chunk);
+  for (i = 0; i < N_CHUNK_THREADS; i++)
+    results[i] = g_thread_join (threads[i]);
+
+  /* Every thread got the same copy of each string */
+  for (i = 1; i < N_CHUNK_THREADS; i++)
+    for (j = 0; j < 500; j++)
+      g_assert_true (results[i][j] == results[0][j]);
+
+  for (i = 0; i < N_CHUNK_THREADS; i++)
+    g_free (results[i]);
+
+  g_string_chunk_clear (chunk);
+  g_assert_cmpstr (g_string_chunk_insert_const (chunk, "after clear"), ==, "after clear");
+
+  g_string_chunk_free (chunk);
+}
+
 static void
 test_string_new (void)
 {
@@ -607,6 +717,115 @@ test_string_set_size (void)
   g_string_free (s, TRUE);
 }
 
+static void
+test_string_reserve (void)
+{
+  GString *s;
+  char *str;
+  gsize i;
+
+  s = g_string_new ("foo");
+
+  g_string_reserve (s, 1);
+  g_assert_cmpstr (s->str, ==, "foo");
+
+  g_string_reserve (s, 100);
+  g_assert_cmpuint (s->len, ==, 3);
+  g_assert_cmpuint (s->allocated_len, >, 100);
+  g_assert_cmpstr (s->str, ==, "foo");
+
+  str = s->str;
+  for (i = 3; i < 100; i++)
+    g_string_append_c (s, 'x');
+  g_assert_true (s->str == str);
+  g_assert_cmpuint (s->len, ==, 100);
+
+  /* Large enough to be advised as huge pages */
+  g_string_reserve (s, 8 * 1024 * 1024);
+  g_assert_cmpuint (s->len, ==, 100);
+  g_assert_cmpuint (s->allocated_len, >, 8 * 1024 * 1024);
+  g_assert_true (g_str_has_prefix (s->str, "fooxxx"));
+
+  g_string_free (s, TRUE);
+}
+
+static void
+test_string_append_printf_self (void)
+{
+  GString *s;
+
+  /* The arguments may point into the string being appended to */
+  s = g_string_new ("abc");
+  g_string_append_printf (s, "%s-%s", s->str, s->str);
+  g_assert_cmpstr (s->str, ==, "abcabc-abc");
+
+  g_string_truncate (s, 0);
+  while (s->len < 1000)
+    g_string_append_c (s, 'x');
+  g_string_append_printf (s, "%s", s->str);
+  g_assert_cmpuint (s->len, ==, 2000);
+  g_assert_cmpuint (strspn (s->str, "x"), ==, 2000);
+
+  g_string_free (s, TRUE);
+}
+
+static void
+test_string_builder (void)
+{
+  GStringBuilder builder = G_STRING_BUILDER_INIT;
+  GString *string;
+  char *str;
+  gsize i;
+
+  g_assert_cmpstr (g_string_builder_get_str (&builder), ==, "");
+  g_assert_cmpuint (g_string_builder_get_len (&builder), ==, 0);
+
+  /* Short strings stay in the inline buffer */
+  g_string_builder_append (&builder, "Hello");
+  g_string_builder_append_c (&builder, ' ');
+  g_string_builder_append_printf (&builder, "%s %d", "world", 42);
+  g_string_builder_append_len (&builder, "!\0?", 3);
+  g_assert_cmpuint (g_string_builder_get_len (&builder), ==, 17);
+  g_assert_cmpmem (g_string_builder_get_str (&builder), 18, "Hello world 42!\0?", 18);
+
+  g_string_builder_truncate (&builder, 5);
+  g_assert_cmpstr (g_string_builder_get_str (&builder), ==, "Hello");
+
+  str = g_string_builder_clear_to_str (&builder);
+  g_assert_cmpstr (str, ==, "Hello");
+  g_assert_cmpstr (g_string_builder_get_str (&builder), ==, "");
+  g_free (str);
+
+  /* Long strings spill to the heap */
+  for (i = 0; i < 1000; i++)
+    g_string_builder_append_printf (&builder, "%03" G_GSIZE_FORMAT, i);
+  g_assert_cmpuint (g_string_builder_get_len (&builder), ==, 3000);
+  g_assert_true (g_str_has_prefix (g_string_builder_get_str (&builder), "000001002"));
+  g_assert_true (g_str_has_suffix (g_string_builder_get_str (&builder), "997998999"));
+
+  /* Appending the string to itself, across a reallocation */
+  g_string_builder_append (&builder, g_string_builder_get_str (&builder));
+  g_assert_cmpuint (g_string_builder_get_len (&builder), ==, 6000);
+  g_assert_cmpmem (g_string_builder_get_str (&builder) + 3000, 9, "000001002", 9);
+
+  string = g_string_builder_clear_to_string (&builder);
+  g_assert_cmpuint (string->len, ==, 6000);
+  g_assert_cmpuint (string->allocated_len, >, 6000);
+  g_string_append (string, "end");
+  g_assert_true (g_str_has_suffix (string->str, "999end"));
+  g_string_free (string, TRUE);
+
+  g_assert_cmpuint (g_string_builder_get_len (&builder), ==, 0);
+
+  g_string_builder_append (&builder, "short");
+  string = g_string_builder_clear_to_string (&builder);
+  g_assert_cmpstr (string->str, ==, "short");
+  g_string_free (string, TRUE);
+
+  g_string_builder_clear (&builder);
+  g_string_builder_clear (&builder);
+}
+
 static void
 test_string_to_bytes (void)
 {
@@ -760,6 +979,8 @@ main (int   argc,
 
   g_test_add_func ("/string/test-string-chunks", test_string_chunks);
   g_test_add_func ("/string/test-string-chunk-insert", test_string_chunk_insert);
+  g_test_add_func ("/string/test-string-chunk-insert-len-const", test_string_chunk_insert_len_const);
+  g_test_add_func ("/string/test-string-chunk-concurrent", test_string_chunk_concurrent);
   g_test_add_func ("/string/test-string-new", test_string_new);
   g_test_add_func ("/string/test-string-printf", test_string_printf);
   g_test_add_func ("/string/test-string-assign", test_string_assign);
@@ -776,6 +997,9 @@ main (int   argc,
   g_test_add_func ("/string/test-string-nul-handling", test_string_nul_handling);
   g_test_add_func ("/string/test-string-up-down", test_string_up_down);
   g_test_add_func ("/string/test-string-set-size", test_string_set_size);
+  g_test_add_func ("/string/test-string-reserve", test_string_reserve);
+  g_test_add_func ("/string/test-string-append-printf-self", test_string_append_printf_self);
+  g_test_add_func ("/string/test-string-builder", test_string_builder);
   g_test_add_func ("/string/test-string-to-bytes", test_string_to_bytes);
   g_test_add_func ("/string/test-string-replace", test_string_replace);
   g_test_add_func ("/string/test-string-steal", test_string_steal);
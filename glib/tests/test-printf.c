@@ -972,6 +972,92 @@ test_vasprintf_invalid_wide_string (void)
 #endif
 }
 
+/* Formats which only use %s, %c, %d, %i, %u, %x and %X without flags,
+ * width or precision take a faster path; adding a field width of 1 forces
+ * the full implementation without changing the output. */
+static void
+test_simple_conversions (void)
+{
+  const gint ints[] = { 0, 1, -1, 42, -12345, G_MAXINT, G_MININT };
+  const gint64 int64s[] = { 0, -1, G_MAXINT64, G_MININT64 };
+  gchar *fast, *full;
+  gchar buf[8];
+  gsize i;
+
+  for (i = 0; i < G_N_ELEMENTS (ints); i++)
+    {
+      fast = g_strdup_printf ("[%d|%i|%u|%x|%X|%c]", ints[i], ints[i],
+                              (guint) ints[i], (guint) ints[i], (guint) ints[i],
+                              'a' + (ints[i] & 7));
+      full = g_strdup_printf ("[%1d|%1i|%1u|%1x|%1X|%1c]", ints[i], ints[i],
+                              (guint) ints[i], (guint) ints[i], (guint) ints[i],
+                              'a' + (ints[i] & 7));
+      g_assert_cmpstr (fast, ==, full);
+      g_free (fast);
+      g_free (full);
+    }
+
+  for (i = 0; i < G_N_ELEMENTS (int64s); i++)
+    {
+      fast = g_strdup_printf ("%" G_GINT64_FORMAT " %" G_GUINT64_FORMAT " %" G_GINT64_MODIFIER "x %" G_GSIZE_FORMAT " %" G_GSSIZE_FORMAT " %ld",
+                              int64s[i], (guint64) int64s[i], (guint64) int64s[i],
+                              (gsize) int64s[i], (gssize) int64s[i], (long) int64s[i]);
+      full = g_strdup_printf ("%1" G_GINT64_FORMAT " %1" G_GUINT64_FORMAT " %1" G_GINT64_MODIFIER "x %1" G_GSIZE_FORMAT " %1" G_GSSIZE_FORMAT " %1ld",
+                              int64s[i], (guint64) int64s[i], (guint64) int64s[i],
+                              (gsize) int64s[i], (gssize) int64s[i], (long) int64s[i]);
+      g_assert_cmpstr (fast, ==, full);
+      g_free (fast);
+      g_free (full);
+    }
+
+  fast = g_strdup_printf ("%s=%s%%", "key", "value");
+  g_assert_cmpstr (fast, ==, "key=value%");
+  g_free (fast);
+
+  /* Truncation */
+  g_assert_cmpint (g_snprintf (buf, sizeof (buf), "%s-%d", "abcdef", 123), ==, 10);
+  g_assert_cmpstr (buf, ==, "abcdef-");
+  g_assert_cmpint (g_snprintf (NULL, 0, "%s-%d", "abcdef", 123), ==, 10);
+
+  /* Longer than the stack buffer g_vasprintf() uses for the fast path */
+  full = g_strnfill (1000, 'x');
+  fast = g_strdup_printf ("<%s>", full);
+  g_assert_cmpuint (strlen (fast), ==, 1002);
+  g_assert_true (g_str_has_prefix (fast, "<xxx"));
+  g_assert_true (g_str_has_suffix (fast, "xxx>"));
+  g_free (fast);
+  g_free (full);
+}
+
+static void
+test_simple_conversions_perf (void)
+{
+  const guint n_iterations = 1000000;
+  gdouble fast_time, full_time;
+  guint i;
+
+  if (!g_test_perf ())
+    {
+      g_test_skip ("Not running performance tests");
+      return;
+    }
+
+  g_test_timer_start ();
+  for (i = 0; i < n_iterations; i++)
+    g_free (g_strdup_printf ("%s: request %u took %d ms", "handler", i, (gint) i % 1000));
+  fast_time = g_test_timer_elapsed ();
+
+  g_test_timer_start ();
+  for (i = 0; i < n_iterations; i++)
+    g_free (g_strdup_printf ("%1s: request %1u took %1d ms", "handler", i, (gint) i % 1000));
+  full_time = g_test_timer_elapsed ();
+
+  g_test_message ("g_strdup_printf(): %.3f s with simple conversions, "
+                  "%.3f s through the full implementation",
+                  fast_time, full_time);
+  g_test_minimized_result (fast_time, "simple conversions: %.3f s", fast_time);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -1012,6 +1098,9 @@ main (int   argc,
   g_test_add_func ("/sprintf/test-positional-params", test_positional_params3);
   g_test_add_func ("/sprintf/upper-bound", test_upper_bound);
 
+  g_test_add_func ("/printf/simple-conversions", test_simple_conversions);
+  g_test_add_func ("/printf/simple-conversions/perf", test_simple_conversions_perf);
+
   g_test_add_func ("/vasprintf/invalid-format-placeholder", test_vasprintf_invalid_format_placeholder);
   g_test_add_func ("/vasprintf/invalid-wide-string", test_vasprintf_invalid_wide_string);
 
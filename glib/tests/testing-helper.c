@@ -46,6 +46,20 @@ test_skip_printf (void)
   g_test_skip_printf ("not enough %s", beverage);
 }
 
+static void
+test_benchmark (gconstpointer data,
+                guint64       n_iterations)
+{
+  volatile guint64 acc = 0;
+  guint64 i;
+
+  g_assert_cmpuint (GPOINTER_TO_UINT (data), ==, 42);
+  g_assert_cmpuint (n_iterations, >, 0);
+
+  for (i = 0; i < n_iterations; i++)
+    acc += i;
+}
+
 static void
 test_fail (void)
 {
@@ -265,6 +279,10 @@ main (int   argc,
     {
       g_test_add_func ("/message", test_message);
     }
+  else if (g_strcmp0 (argv1, "benchmark") == 0)
+    {
+      g_test_add_benchmark ("/benchmark", GUINT_TO_POINTER (42), test_benchmark);
+    }
   else if (g_strcmp0 (argv1, "print") == 0)
     {
       g_test_add_func ("/print", test_print);
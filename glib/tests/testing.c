@@ -2312,6 +2312,63 @@ test_tap_subtest_summary (void)
   g_ptr_array_unref (argv);
 }
 
+static void
+test_tap_benchmark (void)
+{
+  const char *testing_helper;
+  GPtrArray *argv;
+  GError *error = NULL;
+  int status;
+  gchar *output;
+
+  g_test_summary ("Test that g_test_add_benchmark() only measures in "
+                  "performance mode, and reports its results in the TAP output.");
+
+  testing_helper = g_test_get_filename (G_TEST_BUILT, "testing-helper" EXEEXT, NULL);
+
+  argv = g_ptr_array_new ();
+  g_ptr_array_add (argv, (char *) testing_helper);
+  g_ptr_array_add (argv, "benchmark");
+  g_ptr_array_add (argv, "--tap");
+  g_ptr_array_add (argv, NULL);
+
+  g_spawn_sync (NULL, (char **) argv->pdata, NULL,
+                G_SPAWN_STDERR_TO_DEV_NULL,
+                NULL, NULL, &output, NULL, &status,
+                &error);
+  g_assert_no_error (error);
+
+  g_spawn_check_wait_status (status, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (strstr (output, "ok 1 /benchmark\n"));
+  g_assert_null (strstr (output, "min perf: "));
+  g_free (output);
+
+  g_ptr_array_set_size (argv, 0);
+  g_ptr_array_add (argv, (char *) testing_helper);
+  g_ptr_array_add (argv, "benchmark");
+  g_ptr_array_add (argv, "--tap");
+  g_ptr_array_add (argv, "-m");
+  g_ptr_array_add (argv, "perf");
+  g_ptr_array_add (argv, NULL);
+
+  g_spawn_sync (NULL, (char **) argv->pdata, NULL,
+                G_SPAWN_STDERR_TO_DEV_NULL,
+                NULL, NULL, &output, NULL, &status,
+                &error);
+  g_assert_no_error (error);
+
+  g_spawn_check_wait_status (status, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (strstr (output, "ok 1 /benchmark\n"));
+  g_assert_nonnull (strstr (output, "min perf: /benchmark: "));
+  g_assert_nonnull (strstr (output, "ns per iteration"));
+  g_assert_nonnull (strstr (output, "{ \"benchmark\": \"/benchmark\", \"unit\": \"ns\", \"median\": "));
+  g_free (output);
+
+  g_ptr_array_unref (argv);
+}
+
 static void
 test_tap_message (void)
 {
@@ -2967,6 +3024,7 @@ main (int   argc,
   g_test_add_func ("/tap/summary", test_tap_summary);
   g_test_add_func ("/tap/subtest/summary", test_tap_subtest_summary);
   g_test_add_func ("/tap/message", test_tap_message);
+  g_test_add_func ("/tap/benchmark", test_tap_benchmark);
   g_test_add_func ("/tap/subtest/message", test_tap_subtest_message);
   g_test_add_func ("/tap/print", test_tap_print);
   g_test_add_func ("/tap/subtest/print", test_tap_subtest_print);
@@ -189,8 +189,9 @@ test_thread_pool_full (gconstpointer shared_first)
 
   g_thread_pool_set_max_unused_threads (0);
 
-  /* Run the test twice, once with a shared pool and once with an exclusive one. */
-  for (i = 0; i < 2; i++)
+  /* Run the test three times: with a shared pool, an exclusive one and a
+   * work-stealing one. */
+  for (i = 0; i < 3; i++)
     {
       GThreadPool *pool;
       TestThreadPoolFullData test_data;
@@ -206,10 +207,15 @@ test_thread_pool_full (gconstpointer shared_first)
       test_data.n_free_func_calls = 0;
 
       /* Create a thread pool with only one worker thread. The pool can be
-       * created in shared or exclusive mode. */
-      pool = g_thread_pool_new_full (full_thread_func, &test_data, free_func,
-                                     1, (i == 0),
-                                     &local_error);
+       * created in shared, exclusive or work-stealing mode. */
+      if (i < 2)
+        pool = g_thread_pool_new_full (full_thread_func, &test_data, free_func,
+                                       1, (i == 0),
+                                       &local_error);
+      else
+        pool = g_thread_pool_new_with_flags (full_thread_func, &test_data, free_func,
+                                             1, G_THREAD_POOL_FLAGS_WORK_STEALING,
+                                             &local_error);
       g_assert_no_error (local_error);
       g_assert_nonnull (pool);
 
@@ -255,6 +261,286 @@ test_thread_pool_full (gconstpointer shared_first)
     }
 }
 
+typedef struct
+{
+  GThreadPool *pool;
+  guint n_tasks;  /* (atomic) */
+  guint n_local;  /* (atomic) */
+} WorkStealingData;
+
+#define WORK_STEALING_DEPTH 4
+
+static void
+work_stealing_func (gpointer data,
+                    gpointer user_data)
+{
+  WorkStealingData *ws_data = user_data;
+  guint depth = GPOINTER_TO_UINT (data);
+
+  g_atomic_int_inc (&ws_data->n_tasks);
+
+  /* Each task below the maximum depth pushes two follow-up tasks */
+  if (depth < WORK_STEALING_DEPTH)
+    {
+      guint i;
+
+      for (i = 0; i < 2; i++)
+        {
+          g_assert_true (g_thread_pool_push_local (ws_data->pool, GUINT_TO_POINTER (depth + 1), NULL));
+          g_atomic_int_inc (&ws_data->n_local);
+        }
+    }
+}
+
+static void
+test_work_stealing (void)
+{
+  WorkStealingData ws_data = { NULL, 0, 0 };
+  GError *local_error = NULL;
+  guint i, n_roots = 1000;
+
+  g_test_summary ("Tests that a work-stealing pool runs all the tasks pushed "
+                  "to it, including follow-up tasks pushed during shutdown");
+
+  ws_data.pool = g_thread_pool_new_with_flags (work_stealing_func, &ws_data, NULL,
+                                               4, G_THREAD_POOL_FLAGS_WORK_STEALING,
+                                               &local_error);
+  g_assert_no_error (local_error);
+  g_assert_nonnull (ws_data.pool);
+  g_assert_cmpuint (g_thread_pool_get_num_threads (ws_data.pool), ==, 4);
+  g_assert_cmpint (g_thread_pool_get_max_threads (ws_data.pool), ==, 4);
+
+  for (i = 0; i < n_roots; i++)
+    {
+      /* From outside the pool, this is the same as g_thread_pool_push() */
+      if (i % 2)
+        g_assert_true (g_thread_pool_push (ws_data.pool, GUINT_TO_POINTER (1), &local_error));
+      else
+        g_assert_true (g_thread_pool_push_local (ws_data.pool, GUINT_TO_POINTER (1), &local_error));
+      g_assert_no_error (local_error);
+    }
+
+  /* Wait for everything, including the tasks pushed meanwhile */
+  g_thread_pool_free (ws_data.pool, FALSE, TRUE);
+
+  g_assert_cmpuint (ws_data.n_tasks, ==, n_roots * ((1 << WORK_STEALING_DEPTH) - 1));
+  g_assert_cmpuint (ws_data.n_local, ==, ws_data.n_tasks - n_roots);
+}
+
+typedef struct
+{
+  GMutex mutex;
+  GCond cond;
+  gboolean blocked;
+  GArray *order;  /* (owned) protected by mutex */
+} WorkStealingSortData;
+
+static void
+work_stealing_sort_func (gpointer data,
+                         gpointer user_data)
+{
+  WorkStealingSortData *sort_data = user_data;
+  guint value = GPOINTER_TO_UINT (data);
+
+  g_mutex_lock (&sort_data->mutex);
+
+  while (value == 1000 && sort_data->blocked)
+    g_cond_wait (&sort_data->cond, &sort_data->mutex);
+
+  if (value != 1000)
+    g_array_append_val (sort_data->order, value);
+
+  g_mutex_unlock (&sort_data->mutex);
+}
+
+static gint
+compare_uints (gconstpointer a,
+               gconstpointer b,
+               gpointer      user_data)
+{
+  guint ua = GPOINTER_TO_UINT (a);
+  guint ub = GPOINTER_TO_UINT (b);
+
+  return (ua > ub) - (ua < ub);
+}
+
+static void
+test_work_stealing_sort (void)
+{
+  WorkStealingSortData sort_data;
+  GThreadPool *pool;
+  const guint values[] = { 5, 3, 9, 1, 7, 2 };
+  const guint expected[] = { 9, 1, 2, 3, 5, 7 };
+  guint i;
+
+  g_test_summary ("Tests that a work-stealing pool processes tasks in order "
+                  "once a sort function is set");
+
+  g_mutex_init (&sort_data.mutex);
+  g_cond_init (&sort_data.cond);
+  sort_data.blocked = TRUE;
+  sort_data.order = g_array_new (FALSE, FALSE, sizeof (guint));
+
+  pool = g_thread_pool_new_with_flags (work_stealing_sort_func, &sort_data, NULL,
+                                       1, G_THREAD_POOL_FLAGS_WORK_STEALING, NULL);
+
+  /* Keep the only thread busy until everything is queued */
+  g_thread_pool_push (pool, GUINT_TO_POINTER (1000), NULL);
+  while (g_thread_pool_unprocessed (pool) > 0);
+
+  /* Some tasks are queued before the sort function is set, and some after */
+  for (i = 0; i < 3; i++)
+    g_thread_pool_push (pool, GUINT_TO_POINTER (values[i]), NULL);
+  g_thread_pool_set_sort_function (pool, compare_uints, NULL);
+  for (; i < G_N_ELEMENTS (values); i++)
+    g_thread_pool_push (pool, GUINT_TO_POINTER (values[i]), NULL);
+
+  g_assert_cmpuint (g_thread_pool_unprocessed (pool), ==, G_N_ELEMENTS (values));
+
+  /* And one is moved to the front */
+  g_assert_true (g_thread_pool_move_to_front (pool, GUINT_TO_POINTER (9)));
+  g_assert_false (g_thread_pool_move_to_front (pool, GUINT_TO_POINTER (4)));
+
+  g_mutex_lock (&sort_data.mutex);
+  sort_data.blocked = FALSE;
+  g_cond_signal (&sort_data.cond);
+  g_mutex_unlock (&sort_data.mutex);
+
+  g_thread_pool_free (pool, FALSE, TRUE);
+
+  g_assert_cmpmem (sort_data.order->data, sort_data.order->len * sizeof (guint),
+                   expected, sizeof (expected));
+
+  g_array_unref (sort_data.order);
+  g_cond_clear (&sort_data.cond);
+  g_mutex_clear (&sort_data.mutex);
+}
+
+typedef struct
+{
+  GMutex mutex;
+  guint n_processed;
+  guint max_n_processors;  /* largest g_get_num_processors() seen by a task */
+} CpuSetData;
+
+static void
+cpu_set_func (gpointer data,
+              gpointer user_data)
+{
+  CpuSetData *cpu_set_data = user_data;
+  guint n_processors = g_get_num_processors ();
+
+  g_mutex_lock (&cpu_set_data->mutex);
+  cpu_set_data->n_processed++;
+  cpu_set_data->max_n_processors = MAX (cpu_set_data->max_n_processors, n_processors);
+  g_mutex_unlock (&cpu_set_data->mutex);
+}
+
+static void
+test_cpu_set (gconstpointer user_data)
+{
+  GThreadPoolFlags flags = GPOINTER_TO_UINT (user_data);
+  CpuSetData cpu_set_data = { 0, };
+  GThreadPool *pool;
+  GError *error = NULL;
+  guint cpu = 0;  /* assumed to be available to the test */
+  guint invalid_cpu = G_MAXUINT;
+  guint n_processors = g_get_num_processors ();
+  guint i;
+
+  g_test_summary ("Tests pinning the threads of a pool to CPUs");
+
+  g_mutex_init (&cpu_set_data.mutex);
+
+  pool = g_thread_pool_new_with_flags (cpu_set_func, &cpu_set_data, NULL,
+                                       2, flags, &error);
+  g_assert_no_error (error);
+
+  g_assert_false (g_thread_pool_set_cpu_set (pool, &invalid_cpu, 1, &error));
+  g_assert_error (error, G_THREAD_ERROR, G_THREAD_ERROR_AFFINITY);
+  g_clear_error (&error);
+
+  if (!g_thread_pool_set_cpu_set (pool, &cpu, 1, &error))
+    {
+      g_assert_error (error, G_THREAD_ERROR, G_THREAD_ERROR_AFFINITY);
+      g_test_skip ("Setting the CPU affinity is not supported");
+      g_clear_error (&error);
+      g_thread_pool_free (pool, FALSE, TRUE);
+      g_mutex_clear (&cpu_set_data.mutex);
+      return;
+    }
+
+  for (i = 0; i < 100; i++)
+    g_thread_pool_push (pool, GUINT_TO_POINTER (i + 1), NULL);
+
+  g_mutex_lock (&cpu_set_data.mutex);
+  while (cpu_set_data.n_processed < 100)
+    {
+      g_mutex_unlock (&cpu_set_data.mutex);
+      g_usleep (1000);
+      g_mutex_lock (&cpu_set_data.mutex);
+    }
+
+  g_assert_cmpuint (cpu_set_data.max_n_processors, ==, 1);
+  cpu_set_data.max_n_processors = 0;
+  g_mutex_unlock (&cpu_set_data.mutex);
+
+  /* And unpin them again */
+  g_assert_true (g_thread_pool_set_cpu_set (pool, NULL, 0, &error));
+  g_assert_no_error (error);
+
+  for (i = 0; i < 100; i++)
+    g_thread_pool_push (pool, GUINT_TO_POINTER (i + 1), NULL);
+
+  g_thread_pool_free (pool, FALSE, TRUE);
+
+  g_assert_cmpuint (cpu_set_data.n_processed, ==, 200);
+  if (!(flags & G_THREAD_POOL_FLAGS_NUMA))
+    g_assert_cmpuint (cpu_set_data.max_n_processors, ==, n_processors);
+
+  g_mutex_clear (&cpu_set_data.mutex);
+}
+
+static void
+test_numa (void)
+{
+  CpuSetData cpu_set_data = { 0, };
+  GThreadPool *pool;
+  guint n_nodes, i;
+  gint node;
+
+  g_test_summary ("Tests pushing tasks to the NUMA nodes of a pool");
+
+  g_mutex_init (&cpu_set_data.mutex);
+
+  pool = g_thread_pool_new_with_flags (cpu_set_func, &cpu_set_data, NULL,
+                                       4, G_THREAD_POOL_FLAGS_NUMA, NULL);
+  n_nodes = g_thread_pool_get_n_nodes (pool);
+  g_assert_cmpuint (n_nodes, >=, 1);
+  g_assert_cmpuint (n_nodes, <=, 4);
+
+  /* Out of range nodes are only hints, too */
+  for (i = 0; i < 100; i++)
+    for (node = -1; node <= (gint) n_nodes; node++)
+      g_assert_true (g_thread_pool_push_to_node (pool, GUINT_TO_POINTER (i + 1), node, NULL));
+
+  g_thread_pool_free (pool, FALSE, TRUE);
+
+  g_assert_cmpuint (cpu_set_data.n_processed, ==, 100 * (n_nodes + 2));
+
+  /* Other pools just ignore the node */
+  cpu_set_data.n_processed = 0;
+  pool = g_thread_pool_new (cpu_set_func, &cpu_set_data, 2, TRUE, NULL);
+  g_assert_cmpuint (g_thread_pool_get_n_nodes (pool), ==, 1);
+  for (i = 0; i < 10; i++)
+    g_assert_true (g_thread_pool_push_to_node (pool, GUINT_TO_POINTER (i + 1), 0, NULL));
+  g_thread_pool_free (pool, FALSE, TRUE);
+
+  g_assert_cmpuint (cpu_set_data.n_processed, ==, 10);
+
+  g_mutex_clear (&cpu_set_data.mutex);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -265,6 +551,12 @@ main (int argc, char *argv[])
   g_test_add_data_func ("/thread_pool/create_shared_after_exclusive", GINT_TO_POINTER (FALSE), test_create_first_pool);
   g_test_add_data_func ("/thread_pool/create_full", NULL, test_thread_pool_full);
   g_test_add_data_func ("/thread_pool/create_exclusive_after_shared", GINT_TO_POINTER (TRUE), test_create_first_pool);
+  g_test_add_func ("/thread_pool/work-stealing", test_work_stealing);
+  g_test_add_func ("/thread_pool/work-stealing/sort", test_work_stealing_sort);
+  g_test_add_data_func ("/thread_pool/cpu-set", GUINT_TO_POINTER (G_THREAD_POOL_FLAGS_EXCLUSIVE), test_cpu_set);
+  g_test_add_data_func ("/thread_pool/cpu-set/work-stealing", GUINT_TO_POINTER (G_THREAD_POOL_FLAGS_WORK_STEALING), test_cpu_set);
+  g_test_add_data_func ("/thread_pool/cpu-set/numa", GUINT_TO_POINTER (G_THREAD_POOL_FLAGS_NUMA), test_cpu_set);
+  g_test_add_func ("/thread_pool/numa", test_numa);
 
   return g_test_run ();
 }
@@ -253,6 +253,91 @@ test_thread7 (void)
 #endif
 }
 
+#if defined(THREADS_POSIX) && defined(HAVE_PTHREAD_SETAFFINITY_NP)
+static guint
+get_first_cpu (void)
+{
+  cpu_set_t mask;
+  guint cpu;
+  int err;
+
+  err = pthread_getaffinity_np (pthread_self (), sizeof (mask), &mask);
+  g_assert_cmpint (err, ==, 0);
+
+  for (cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    if (CPU_ISSET (cpu, &mask))
+      return cpu;
+
+  g_assert_not_reached ();
+}
+
+static gpointer
+thread8_func (gpointer data)
+{
+  guint cpu = GPOINTER_TO_UINT (data);
+  cpu_set_t mask;
+  int err;
+
+  err = pthread_getaffinity_np (pthread_self (), sizeof (mask), &mask);
+  g_assert_cmpint (err, ==, 0);
+  g_assert_cmpint (CPU_COUNT (&mask), ==, 1);
+  g_assert_true (CPU_ISSET (cpu, &mask));
+
+  return GINT_TO_POINTER (TRUE);
+}
+
+static gpointer
+thread8_reset_func (gpointer data)
+{
+  guint cpu = GPOINTER_TO_UINT (data);
+  GError *error = NULL;
+
+  g_assert_true (g_thread_set_cpu_affinity (&cpu, 1, &error));
+  g_assert_no_error (error);
+  g_assert_cmpuint (g_get_num_processors (), ==, 1);
+
+  g_assert_true (g_thread_set_cpu_affinity (NULL, 0, &error));
+  g_assert_no_error (error);
+
+  return GINT_TO_POINTER (g_get_num_processors ());
+}
+#endif
+
+static void
+test_thread8 (void)
+{
+#if defined(THREADS_POSIX) && defined(HAVE_PTHREAD_SETAFFINITY_NP)
+  GThread *thread;
+  GError *error = NULL;
+  guint cpu = get_first_cpu ();
+  guint invalid_cpu = G_MAXUINT;
+
+  g_test_summary ("Tests pinning threads to CPUs");
+
+  thread = g_thread_try_new_with_affinity ("affinity", thread8_func,
+                                           GUINT_TO_POINTER (cpu), &cpu, 1,
+                                           &error);
+  g_assert_no_error (error);
+  g_assert_true (GPOINTER_TO_INT (g_thread_join (thread)));
+
+  thread = g_thread_try_new_with_affinity ("affinity", thread8_func, NULL,
+                                           &invalid_cpu, 1, &error);
+  g_assert_error (error, G_THREAD_ERROR, G_THREAD_ERROR_AFFINITY);
+  g_assert_null (thread);
+  g_clear_error (&error);
+
+  g_assert_false (g_thread_set_cpu_affinity (&invalid_cpu, 1, &error));
+  g_assert_error (error, G_THREAD_ERROR, G_THREAD_ERROR_AFFINITY);
+  g_clear_error (&error);
+
+  /* Allowing all CPUs again undoes the pinning */
+  thread = g_thread_new ("affinity", thread8_reset_func, GUINT_TO_POINTER (cpu));
+  g_assert_cmpint (GPOINTER_TO_INT (g_thread_join (thread)), ==, g_get_num_processors ());
+#else
+  g_test_skip ("Skipping because pthread_setaffinity_np() is not available");
+#endif
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -265,6 +350,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/thread/thread5", test_thread5);
   g_test_add_func ("/thread/thread6", test_thread6);
   g_test_add_func ("/thread/thread7", test_thread7);
+  g_test_add_func ("/thread/thread8", test_thread8);
 
   return g_test_run ();
 }
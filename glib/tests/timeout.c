@@ -205,6 +205,90 @@ test_rounding (void)
   g_main_loop_unref (loop);
 }
 
+typedef struct
+{
+  gint64 last_time;
+  gint64 max_latency;
+  gint64 total_latency;
+  guint count;
+  guint n_iterations;
+  guint64 interval;
+} UsecTimeoutData;
+
+static gboolean
+usec_timeout_cb (gpointer user_data)
+{
+  UsecTimeoutData *data = user_data;
+  gint64 now = g_get_monotonic_time ();
+  gint64 latency;
+
+  /* The source must never fire early */
+  g_assert_cmpint (now - data->last_time, >=, (gint64) data->interval);
+
+  latency = now - data->last_time - (gint64) data->interval;
+  data->max_latency = MAX (data->max_latency, latency);
+  data->total_latency += latency;
+  data->last_time = now;
+
+  if (++data->count < data->n_iterations)
+    return G_SOURCE_CONTINUE;
+
+  g_main_loop_quit (loop);
+  return G_SOURCE_REMOVE;
+}
+
+static void
+run_usec_timeout (UsecTimeoutData *data)
+{
+  GSource *source;
+
+  loop = g_main_loop_new (NULL, FALSE);
+
+  source = g_timeout_source_new_us (data->interval);
+  g_source_set_callback (source, usec_timeout_cb, data, NULL);
+  data->last_time = g_get_monotonic_time ();
+  g_source_attach (source, NULL);
+
+  g_main_loop_run (loop);
+
+  g_source_unref (source);
+  g_main_loop_unref (loop);
+}
+
+static void
+test_usec (void)
+{
+  UsecTimeoutData data = { 0, };
+
+  data.interval = 250;
+  data.n_iterations = 20;
+  run_usec_timeout (&data);
+
+  g_assert_cmpuint (data.count, ==, data.n_iterations);
+}
+
+static void
+test_usec_latency (void)
+{
+  UsecTimeoutData data = { 0, };
+
+  if (!g_test_perf ())
+    {
+      g_test_skip ("Not running performance tests");
+      return;
+    }
+
+  /* A 2 kHz timer */
+  data.interval = 500;
+  data.n_iterations = 2000;
+  run_usec_timeout (&data);
+
+  g_test_minimized_result (data.total_latency / data.n_iterations,
+                           "Mean firing latency of a %" G_GUINT64_FORMAT " us timeout: %" G_GINT64_FORMAT " us",
+                           data.interval, data.total_latency / data.n_iterations);
+  g_test_message ("Maximum firing latency: %" G_GINT64_FORMAT " us", data.max_latency);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -215,6 +299,8 @@ main (int argc, char *argv[])
   g_test_add_func ("/timeout/weeks-overflow", test_weeks_overflow);
   g_test_add_func ("/timeout/far-future-ready-time", test_far_future_ready_time);
   g_test_add_func ("/timeout/rounding", test_rounding);
+  g_test_add_func ("/timeout/usec", test_usec);
+  g_test_add_func ("/timeout/usec/latency", test_usec_latency);
 
   return g_test_run ();
 }
@@ -729,6 +729,327 @@ test_tree_bounds (void)
   g_tree_unref (tree);
 }
 
+static gint
+int_compare (gconstpointer a,
+             gconstpointer b,
+             gpointer      user_data)
+{
+  gint ia = GPOINTER_TO_INT (a);
+  gint ib = GPOINTER_TO_INT (b);
+
+  return (ia > ib) - (ia < ib);
+}
+
+static gint
+int_search (gconstpointer a,
+            gconstpointer b)
+{
+  return int_compare (b, a, NULL);
+}
+
+static gboolean
+collect_keys (gpointer key,
+              gpointer value,
+              gpointer data)
+{
+  GArray *keys = data;
+  gint k = GPOINTER_TO_INT (key);
+
+  g_assert_cmpint (GPOINTER_TO_INT (value), ==, k * 2);
+  g_array_append_val (keys, k);
+
+  return FALSE;
+}
+
+static void
+assert_trees_equal (GTree *btree,
+                    GTree *tree)
+{
+  GArray *keys = g_array_new (FALSE, FALSE, sizeof (gint));
+  GArray *expected = g_array_new (FALSE, FALSE, sizeof (gint));
+
+  g_tree_foreach (btree, collect_keys, keys);
+  g_tree_foreach (tree, collect_keys, expected);
+
+  g_assert_cmpuint (g_tree_nnodes (btree), ==, g_tree_nnodes (tree));
+  g_assert_cmpmem (keys->data, keys->len * sizeof (gint),
+                   expected->data, expected->len * sizeof (gint));
+
+  g_array_unref (keys);
+  g_array_unref (expected);
+}
+
+static void
+test_tree_btree (void)
+{
+  GTree *btree, *tree;
+  GRand *rand;
+  guint i;
+
+  g_test_summary ("Test a GTree in B-tree mode against one in binary tree mode");
+
+  btree = g_tree_new_btree (int_compare, NULL, NULL, NULL);
+  tree = g_tree_new_full (int_compare, NULL, NULL, NULL);
+  rand = g_rand_new_with_seed (42);
+
+  g_assert_cmpint (g_tree_height (btree), ==, 0);
+  g_assert_null (g_tree_lookup (btree, GINT_TO_POINTER (1)));
+  g_assert_false (g_tree_remove (btree, GINT_TO_POINTER (1)));
+
+  /* Ascending, then random insertions and removals */
+  for (i = 0; i < 5000; i++)
+    {
+      g_tree_insert (btree, GINT_TO_POINTER (i * 2), GINT_TO_POINTER (i * 4));
+      g_tree_insert (tree, GINT_TO_POINTER (i * 2), GINT_TO_POINTER (i * 4));
+    }
+
+  assert_trees_equal (btree, tree);
+  g_assert_cmpint (g_tree_height (btree), ==, 3);
+
+  for (i = 0; i < 100000; i++)
+    {
+      gint k = g_rand_int_range (rand, -1000, 11000);
+
+      if (g_rand_boolean (rand))
+        {
+          g_tree_replace (btree, GINT_TO_POINTER (k), GINT_TO_POINTER (k * 2));
+          g_tree_replace (tree, GINT_TO_POINTER (k), GINT_TO_POINTER (k * 2));
+        }
+      else
+        g_assert_cmpint (g_tree_remove (btree, GINT_TO_POINTER (k)), ==,
+                         g_tree_remove (tree, GINT_TO_POINTER (k)));
+
+      if (i % 10000 == 0)
+        assert_trees_equal (btree, tree);
+    }
+
+  assert_trees_equal (btree, tree);
+
+  for (i = 0; i < 12000; i++)
+    {
+      gint k = (gint) i - 1000;
+      gpointer orig_key = NULL, value = NULL;
+      gboolean found = g_tree_lookup_extended (tree, GINT_TO_POINTER (k), NULL, NULL);
+
+      g_assert_cmpint (g_tree_lookup_extended (btree, GINT_TO_POINTER (k), &orig_key, &value), ==, found);
+      if (found)
+        {
+          g_assert_cmpint (GPOINTER_TO_INT (orig_key), ==, k);
+          g_assert_cmpint (GPOINTER_TO_INT (value), ==, k * 2);
+          g_assert_cmpint (GPOINTER_TO_INT (g_tree_lookup (btree, GINT_TO_POINTER (k))), ==, k * 2);
+          g_assert_cmpint (GPOINTER_TO_INT (g_tree_search (btree, int_search, GINT_TO_POINTER (k))), ==, k * 2);
+        }
+      else
+        g_assert_null (g_tree_search (btree, int_search, GINT_TO_POINTER (k)));
+    }
+
+  /* Remove everything */
+  for (i = 0; i < 12000; i++)
+    {
+      gint k = (gint) i - 1000;
+
+      g_assert_cmpint (g_tree_remove (btree, GINT_TO_POINTER (k)), ==,
+                       g_tree_remove (tree, GINT_TO_POINTER (k)));
+    }
+
+  g_assert_cmpint (g_tree_nnodes (btree), ==, 0);
+  g_assert_cmpint (g_tree_height (btree), ==, 0);
+
+  g_rand_free (rand);
+  g_tree_unref (btree);
+  g_tree_unref (tree);
+}
+
+static void
+test_tree_btree_destroy (void)
+{
+  GTree *tree;
+  char c, d;
+  gsize i;
+
+  g_test_summary ("Test destroy notifications for a GTree in B-tree mode");
+
+  tree = g_tree_new_btree ((GCompareDataFunc) my_compare, NULL,
+                           my_key_destroy, my_value_destroy);
+
+  /* Insert in reverse, so that each key becomes the smallest */
+  for (i = strlen (chars); i > 0; i--)
+    g_tree_insert (tree, &chars[i - 1], &chars[i - 1]);
+
+  c = '0';
+  g_tree_insert (tree, &c, &c);
+  g_assert_true (destroyed_key == &c);
+  g_assert_true (destroyed_value == &chars[0]);
+  destroyed_key = NULL;
+  destroyed_value = NULL;
+
+  d = '1';
+  g_tree_replace (tree, &d, &d);
+  g_assert_true (destroyed_key == &chars[1]);
+  g_assert_true (destroyed_value == &chars[1]);
+  destroyed_key = NULL;
+  destroyed_value = NULL;
+
+  c = '3';
+  g_assert_true (g_tree_steal (tree, &c));
+  g_assert_null (destroyed_key);
+  g_assert_null (destroyed_value);
+
+  c = '2';
+  g_assert_true (g_tree_remove (tree, &c));
+  g_assert_true (destroyed_key == &chars[2]);
+  g_assert_true (destroyed_value == &chars[2]);
+
+  destroyed_key_count = 0;
+  destroyed_value_count = 0;
+
+  g_tree_remove_all (tree);
+
+  g_assert_cmpuint (destroyed_key_count, ==, strlen (chars) - 2);
+  g_assert_cmpuint (destroyed_value_count, ==, strlen (chars) - 2);
+  g_assert_cmpint (g_tree_nnodes (tree), ==, 0);
+
+  g_tree_unref (tree);
+}
+
+static void
+test_tree_from_sorted (void)
+{
+  gsize sizes[] = { 0, 1, 31, 32, 33, 1024, 1025, 40000 };
+  gsize i, j;
+
+  g_test_summary ("Test bulk loading a GTree from sorted keys");
+
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++)
+    {
+      gsize n = sizes[i];
+      gpointer *keys = g_new (gpointer, n + 1);
+      gpointer *values = g_new (gpointer, n + 1);
+      GTree *tree, *expected;
+
+      expected = g_tree_new_full (int_compare, NULL, NULL, NULL);
+      for (j = 0; j < n; j++)
+        {
+          keys[j] = GINT_TO_POINTER (j * 3);
+          values[j] = GINT_TO_POINTER (j * 6);
+          g_tree_insert (expected, keys[j], values[j]);
+        }
+
+      tree = g_tree_new_from_sorted (int_compare, NULL, NULL, NULL,
+                                     keys, values, n);
+      assert_trees_equal (tree, expected);
+
+      /* The tree stays usable afterwards */
+      for (j = 0; j < n; j += 7)
+        {
+          g_tree_remove (tree, GINT_TO_POINTER (j * 3));
+          g_tree_remove (expected, GINT_TO_POINTER (j * 3));
+          g_tree_insert (tree, GINT_TO_POINTER (j * 3 + 1), GINT_TO_POINTER ((j * 3 + 1) * 2));
+          g_tree_insert (expected, GINT_TO_POINTER (j * 3 + 1), GINT_TO_POINTER ((j * 3 + 1) * 2));
+        }
+      assert_trees_equal (tree, expected);
+
+      g_tree_unref (tree);
+      g_tree_unref (expected);
+
+      /* Without values */
+      tree = g_tree_new_from_sorted (int_compare, NULL, NULL, NULL,
+                                     keys, NULL, n);
+      g_assert_cmpint (g_tree_nnodes (tree), ==, n);
+      if (n > 0)
+        {
+          gpointer value = GINT_TO_POINTER (1);
+
+          g_assert_true (g_tree_lookup_extended (tree, keys[n - 1], NULL, &value));
+          g_assert_null (value);
+        }
+      g_tree_unref (tree);
+
+      g_free (keys);
+      g_free (values);
+    }
+}
+
+static void
+test_tree_foreach_range (void)
+{
+  GTree *trees[2];
+  gsize i, t;
+
+  g_test_summary ("Test g_tree_foreach_range() in both modes");
+
+  trees[0] = g_tree_new_full (int_compare, NULL, NULL, NULL);
+  trees[1] = g_tree_new_btree (int_compare, NULL, NULL, NULL);
+
+  for (t = 0; t < G_N_ELEMENTS (trees); t++)
+    for (i = 0; i < 1000; i++)
+      g_tree_insert (trees[t], GINT_TO_POINTER (i * 2), GINT_TO_POINTER (i * 4));
+
+  for (t = 0; t < G_N_ELEMENTS (trees); t++)
+    {
+      struct { gint lower, upper, first, n; } ranges[] = {
+        { 0, 10, 0, 5 },
+        { 1, 11, 2, 5 },
+        { -100, 1, 0, 1 },
+        { 500, 500, 0, 0 },
+        { 600, 500, 0, 0 },
+        { 1990, 5000, 1990, 5 },
+        { 2000, 5000, 0, 0 },
+        { -10, 5000, 0, 1000 },
+      };
+
+      for (i = 0; i < G_N_ELEMENTS (ranges); i++)
+        {
+          GArray *keys = g_array_new (FALSE, FALSE, sizeof (gint));
+          gint j;
+
+          g_tree_foreach_range (trees[t],
+                                GINT_TO_POINTER (ranges[i].lower),
+                                GINT_TO_POINTER (ranges[i].upper),
+                                collect_keys, keys);
+
+          g_assert_cmpuint (keys->len, ==, ranges[i].n);
+          for (j = 0; j < ranges[i].n; j++)
+            g_assert_cmpint (g_array_index (keys, gint, j), ==, ranges[i].first + j * 2);
+
+          g_array_unref (keys);
+        }
+
+      g_tree_unref (trees[t]);
+    }
+}
+
+static void
+test_tree_btree_node_api (void)
+{
+  GTree *tree;
+
+  g_test_summary ("Test that the GTreeNode API is rejected in B-tree mode");
+
+  tree = g_tree_new_btree (int_compare, NULL, NULL, NULL);
+  g_tree_insert (tree, GINT_TO_POINTER (1), GINT_TO_POINTER (2));
+
+  g_test_expect_message ("GLib", G_LOG_LEVEL_CRITICAL, "*is_btree*");
+  g_assert_null (g_tree_lookup_node (tree, GINT_TO_POINTER (1)));
+  g_test_assert_expected_messages ();
+
+  g_test_expect_message ("GLib", G_LOG_LEVEL_CRITICAL, "*null_ret_ok*");
+  g_assert_null (g_tree_insert_node (tree, GINT_TO_POINTER (3), NULL));
+  g_test_assert_expected_messages ();
+
+  g_test_expect_message ("GLib", G_LOG_LEVEL_CRITICAL, "*is_btree*");
+  g_assert_null (g_tree_node_first (tree));
+  g_test_assert_expected_messages ();
+
+  g_test_expect_message ("GLib", G_LOG_LEVEL_CRITICAL, "*is_btree*");
+  g_assert_null (g_tree_lower_bound (tree, GINT_TO_POINTER (0)));
+  g_test_assert_expected_messages ();
+
+  g_assert_cmpint (g_tree_nnodes (tree), ==, 1);
+
+  g_tree_unref (tree);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -741,6 +1062,11 @@ main (int argc, char *argv[])
   g_test_add_func ("/tree/insert", test_tree_insert);
   g_test_add_func ("/tree/bounds", test_tree_bounds);
   g_test_add_func ("/tree/remove-all", test_tree_remove_all);
+  g_test_add_func ("/tree/btree", test_tree_btree);
+  g_test_add_func ("/tree/btree/destroy", test_tree_btree_destroy);
+  g_test_add_func ("/tree/btree/node-api", test_tree_btree_node_api);
+  g_test_add_func ("/tree/from-sorted", test_tree_from_sorted);
+  g_test_add_func ("/tree/foreach-range", test_tree_foreach_range);
 
   return g_test_run ();
 }
@@ -195,6 +195,100 @@ test_unicode_normalize_bad_length (void)
   g_free (output);
 }
 
+/* Check g_utf8_normalize() in all modes against the full algorithm, which
+ * is forced by appending ANGSTROM SIGN (U+212B): it is not normalized in any
+ * form, and as a starter which decomposes to another starter it normalizes
+ * separately from what precedes it. */
+static void
+check_normalize_quick (const gchar *str)
+{
+  static const GNormalizeMode modes[] = {
+    G_NORMALIZE_NFD, G_NORMALIZE_NFC, G_NORMALIZE_NFKD, G_NORMALIZE_NFKC
+  };
+  gsize i;
+
+  for (i = 0; i < G_N_ELEMENTS (modes); i++)
+    {
+      gchar *forced = g_strconcat (str, "\xe2\x84\xab", NULL);
+      gchar *result = g_utf8_normalize (str, -1, modes[i]);
+      gchar *expected = g_utf8_normalize (forced, -1, modes[i]);
+      gchar *suffix = g_utf8_normalize ("\xe2\x84\xab", -1, modes[i]);
+
+      g_assert_true (g_str_has_suffix (expected, suffix));
+      expected[strlen (expected) - strlen (suffix)] = '\0';
+      g_assert_cmpstr (result, ==, expected);
+
+      g_free (suffix);
+      g_free (expected);
+      g_free (result);
+      g_free (forced);
+    }
+}
+
+static void
+test_unicode_normalize_quick_check (void)
+{
+  const gchar *pieces[] = {
+    "a", "Z", " ", "0",
+    "\xc3\xa9",          /* LATIN SMALL LETTER E WITH ACUTE */
+    "\xcc\x81",          /* COMBINING ACUTE ACCENT */
+    "\xcc\xa3",          /* COMBINING DOT BELOW */
+    "\xcd\x85",          /* COMBINING GREEK YPOGEGRAMMENI */
+    "\xc2\xb2",          /* SUPERSCRIPT TWO */
+    "\xef\xac\x81",      /* LATIN SMALL LIGATURE FI */
+    "\xe1\x84\x80",      /* HANGUL CHOSEONG KIYEOK */
+    "\xe1\x85\xa1",      /* HANGUL JUNGSEONG A */
+    "\xe1\x86\xa8",      /* HANGUL JONGSEONG KIYEOK */
+    "\xea\xb0\x80",      /* HANGUL SYLLABLE GA */
+    "\xe0\xa4\xbc",      /* DEVANAGARI SIGN NUKTA */
+    "\xf0\x9d\x85\x9e",  /* MUSICAL SYMBOL HALF NOTE */
+    "\xf0\x9f\x98\x80",  /* GRINNING FACE */
+  };
+  gchar *str;
+  GString *random;
+  guint i, j;
+
+  check_normalize_quick ("");
+  check_normalize_quick ("plain ASCII text which is long enough for a few blocks");
+  check_normalize_quick ("caf\xc3\xa9 cafe\xcc\x81");
+
+  /* Out of order combining marks */
+  check_normalize_quick ("a\xcc\x81\xcc\xa3");
+  str = g_utf8_normalize ("a\xcc\x81\xcc\xa3", -1, G_NORMALIZE_NFD);
+  g_assert_cmpstr (str, ==, "a\xcc\xa3\xcc\x81");
+  g_free (str);
+
+  /* Normalized input, including a nul within @len, is copied */
+  str = g_utf8_normalize ("caf\xc3\xa9\0tail", 9, G_NORMALIZE_NFC);
+  g_assert_cmpstr (str, ==, "caf\xc3\xa9");
+  g_free (str);
+  str = g_utf8_normalize ("caf\xc3\xa9", 3, G_NORMALIZE_NFD);
+  g_assert_cmpstr (str, ==, "caf");
+  g_free (str);
+
+  /* Invalid UTF-8 still gives %NULL */
+  g_assert_null (g_utf8_normalize ("abc\xc3", -1, G_NORMALIZE_NFC));
+
+  random = g_string_new (NULL);
+  for (i = 0; i < 2000; i++)
+    {
+      guint n = g_test_rand_int_range (0, 40);
+
+      g_string_truncate (random, 0);
+      for (j = 0; j < n; j++)
+        {
+          /* Mostly ASCII, so that there are runs of it */
+          if (g_test_rand_bit () && g_test_rand_bit ())
+            g_string_append (random, pieces[g_test_rand_int_range (4, G_N_ELEMENTS (pieces))]);
+          else
+            g_string_append (random, pieces[g_test_rand_int_range (0, 4)]);
+        }
+
+      check_normalize_quick (random->str);
+    }
+  g_string_free (random, TRUE);
+}
+
 int
 main (int argc, char **argv)
 {
@@ -204,6 +298,7 @@ main (int argc, char **argv)
   g_test_add_func ("/unicode/normalize-invalid",
                    test_unicode_normalize_invalid);
   g_test_add_func ("/unicode/normalize/bad-length", test_unicode_normalize_bad_length);
+  g_test_add_func ("/unicode/normalize/quick-check", test_unicode_normalize_quick_check);
 
   return g_test_run ();
 }
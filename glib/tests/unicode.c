@@ -596,6 +596,84 @@ test_casefold (void)
   g_free (str_casefold);
 }
 
+/* Test that case mapping long strings, where ASCII is done in blocks,
+ * gives the same results as mapping each character on its own. */
+static void
+test_casemap_ascii_runs (void)
+{
+  const gchar *pieces[] = {
+    "a", "z", "A", "Z", "@", "[", "`", "{", "0", " ", "\x7f",
+    "\xc3\xa9",          /* LATIN SMALL LETTER E WITH ACUTE */
+    "\xc3\x89",          /* LATIN CAPITAL LETTER E WITH ACUTE */
+    "\xc3\x9f",          /* LATIN SMALL LETTER SHARP S */
+    "\xd0\x96",          /* CYRILLIC CAPITAL LETTER ZHE */
+    "\xef\xbc\xa1",      /* FULLWIDTH LATIN CAPITAL LETTER A */
+    "\xf0\x90\x90\x80",  /* DESERET CAPITAL LETTER LONG I */
+  };
+  GString *str, *up, *down, *folded;
+  gchar *result;
+  guint i, j;
+
+  str = g_string_new (NULL);
+  up = g_string_new (NULL);
+  down = g_string_new (NULL);
+  folded = g_string_new (NULL);
+
+  for (i = 0; i < 1000; i++)
+    {
+      guint n = g_test_rand_int_range (0, 100);
+
+      g_string_truncate (str, 0);
+      g_string_truncate (up, 0);
+      g_string_truncate (down, 0);
+      g_string_truncate (folded, 0);
+
+      for (j = 0; j < n; j++)
+        {
+          const gchar *piece;
+
+          if (g_test_rand_int_range (0, 8) == 0)
+            piece = pieces[g_test_rand_int_range (11, G_N_ELEMENTS (pieces))];
+          else
+            piece = pieces[g_test_rand_int_range (0, 11)];
+
+          g_string_append (str, piece);
+          result = g_utf8_strup (piece, -1);
+          g_string_append (up, result);
+          g_free (result);
+          result = g_utf8_strdown (piece, -1);
+          g_string_append (down, result);
+          g_free (result);
+          result = g_utf8_casefold (piece, -1);
+          g_string_append (folded, result);
+          g_free (result);
+        }
+
+      result = g_utf8_strup (str->str, -1);
+      g_assert_cmpstr (result, ==, up->str);
+      g_free (result);
+      result = g_utf8_strdown (str->str, str->len);
+      g_assert_cmpstr (result, ==, down->str);
+      g_free (result);
+      result = g_utf8_casefold (str->str, -1);
+      g_assert_cmpstr (result, ==, folded->str);
+      g_free (result);
+    }
+
+  /* Mapping stops at a nul within the given length */
+  result = g_utf8_strup ("abcdefghijklmnopqrstuvwxyz\0abc", 30);
+  g_assert_cmpstr (result, ==, "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+  g_free (result);
+  result = g_utf8_casefold ("ABCDEFGHIJKLMNOPQRSTUVWXYZ\0ABC", 30);
+  g_assert_cmpstr (result, ==, "abcdefghijklmnopqrstuvwxyz");
+  g_free (result);
+
+  g_string_free (folded, TRUE);
+  g_string_free (down, TRUE);
+  g_string_free (up, TRUE);
+  g_string_free (str, TRUE);
+}
+
 static void
 test_casemap_and_casefold (void)
 {
@@ -1958,6 +2036,7 @@ main (int   argc,
   g_test_add_func ("/unicode/canonical-decomposition", test_canonical_decomposition);
   g_test_add_func ("/unicode/casefold", test_casefold);
   g_test_add_func ("/unicode/casemap_and_casefold", test_casemap_and_casefold);
+  g_test_add_func ("/unicode/casemap/ascii-runs", test_casemap_ascii_runs);
   g_test_add_func ("/unicode/cases", test_cases);
   g_test_add_func ("/unicode/character-type", test_unichar_character_type);
   g_test_add_func ("/unicode/cntrl", test_cntrl);
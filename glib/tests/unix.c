@@ -878,6 +878,68 @@ test_child_wait (void)
     }
 }
 
+static void
+child_wait_many_cb (GPid     pid,
+                    gint     wait_status,
+                    gpointer user_data)
+{
+  guint *n_exited = user_data;
+
+  g_assert_true (WIFEXITED (wait_status));
+  g_assert_cmpint (WEXITSTATUS (wait_status), ==, 0);
+  (*n_exited)++;
+}
+
+static void
+test_child_wait_many (void)
+{
+  const guint n_children = 50;
+  GMainContext *context;
+  guint n_exited = 0;
+  guint64 n_reaped;
+  guint max_reaped;
+  guint i;
+
+  g_test_summary ("Test that many children exiting together are all reaped, "
+                  "and counted by g_main_context_get_child_watch_stats()");
+
+  context = g_main_context_new ();
+
+  g_main_context_get_child_watch_stats (context, &n_reaped, &max_reaped);
+  g_assert_cmpuint (n_reaped, ==, 0);
+  g_assert_cmpuint (max_reaped, ==, 0);
+
+  for (i = 0; i < n_children; i++)
+    {
+      char *argv[] = { "/bin/true", NULL };
+      GSource *source;
+      GPid pid;
+
+      if (!g_spawn_async (NULL, argv, NULL, G_SPAWN_DO_NOT_REAP_CHILD,
+                          NULL, NULL, &pid, NULL))
+        {
+          g_test_skip ("failure to spawn test process in test_child_wait_many()");
+          g_main_context_unref (context);
+          return;
+        }
+
+      source = g_child_watch_source_new (pid);
+      g_source_set_callback (source, G_SOURCE_FUNC (child_wait_many_cb), &n_exited, NULL);
+      g_source_attach (source, context);
+      g_source_unref (source);
+    }
+
+  while (n_exited < n_children)
+    g_main_context_iteration (context, TRUE);
+
+  g_main_context_get_child_watch_stats (context, &n_reaped, &max_reaped);
+  g_assert_cmpuint (n_reaped, ==, n_children);
+  g_assert_cmpuint (max_reaped, >=, 1);
+  g_assert_cmpuint (max_reaped, <=, n_children);
+
+  g_main_context_unref (context);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -906,6 +968,7 @@ main (int   argc,
   g_test_add_func ("/glib-unix/get-passwd-entry/root", test_get_passwd_entry_root);
   g_test_add_func ("/glib-unix/get-passwd-entry/nonexistent", test_get_passwd_entry_nonexistent);
   g_test_add_func ("/glib-unix/child-wait", test_child_wait);
+  g_test_add_func ("/glib-unix/child-wait/many", test_child_wait_many);
 
   return g_test_run();
 }
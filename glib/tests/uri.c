@@ -2039,6 +2039,136 @@ test_uri_normalize (void)
     }
 }
 
+static void
+assert_span (const gchar    *uri,
+             const GUriSpan *span,
+             const gchar    *expected)
+{
+  if (expected == NULL)
+    {
+      g_assert_cmpint (span->offset, ==, -1);
+      return;
+    }
+
+  g_assert_cmpint (span->offset, >=, 0);
+  g_assert_cmpmem (uri + span->offset, span->length, expected, strlen (expected));
+}
+
+static void
+test_uri_split_view (void)
+{
+  const struct
+    {
+      const gchar *uri;
+      const gchar *scheme, *userinfo, *host, *port, *path, *query, *fragment;
+    }
+  tests[] =
+    {
+      { "HTTP://user%20x@Example.com:8080/a%2Fb?q=1#frag",
+        "HTTP", "user%20x", "Example.com", "8080", "/a%2Fb", "q=1", "frag" },
+      { "http://[fe80::1%25eth0]:80/",
+        "http", NULL, "fe80::1%25eth0", "80", "/", NULL, NULL },
+      { "file:///etc/hosts",
+        "file", NULL, "", NULL, "/etc/hosts", NULL, NULL },
+      { "http://host:/",
+        "http", NULL, "host", NULL, "/", NULL, NULL },
+      { "mailto:someone@example.com",
+        "mailto", NULL, NULL, NULL, "someone@example.com", NULL, NULL },
+      { "../relative?x#",
+        NULL, NULL, NULL, NULL, "../relative", "x", "" },
+    };
+  GUriSpan scheme, userinfo, host, port, path, query, fragment;
+  GError *error = NULL;
+  gsize i;
+
+  for (i = 0; i < G_N_ELEMENTS (tests); i++)
+    {
+      g_test_message ("URI %s", tests[i].uri);
+
+      g_assert_true (g_uri_split_view (tests[i].uri, G_URI_FLAGS_NONE,
+                                       &scheme, &userinfo, &host, &port,
+                                       &path, &query, &fragment, &error));
+      g_assert_no_error (error);
+
+      assert_span (tests[i].uri, &scheme, tests[i].scheme);
+      assert_span (tests[i].uri, &userinfo, tests[i].userinfo);
+      assert_span (tests[i].uri, &host, tests[i].host);
+      assert_span (tests[i].uri, &port, tests[i].port);
+      assert_span (tests[i].uri, &path, tests[i].path);
+      assert_span (tests[i].uri, &query, tests[i].query);
+      assert_span (tests[i].uri, &fragment, tests[i].fragment);
+    }
+
+  g_assert_false (g_uri_split_view ("http://host/%2", G_URI_FLAGS_NONE,
+                                    NULL, NULL, NULL, NULL, &path, NULL, NULL,
+                                    &error));
+  g_assert_error (error, G_URI_ERROR, G_URI_ERROR_BAD_PATH);
+  g_assert_cmpint (path.offset, ==, -1);
+  g_clear_error (&error);
+
+  g_assert_true (g_uri_split_view ("http://host/%2", G_URI_FLAGS_PARSE_RELAXED,
+                                   NULL, NULL, NULL, NULL, &path, NULL, NULL,
+                                   &error));
+  g_assert_no_error (error);
+  assert_span ("http://host/%2", &path, "/%2");
+
+  g_assert_false (g_uri_split_view ("http://host:99999/", G_URI_FLAGS_NONE,
+                                    NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                    &error));
+  g_assert_error (error, G_URI_ERROR, G_URI_ERROR_BAD_PORT);
+  g_clear_error (&error);
+
+  g_assert_false (g_uri_split_view ("http://[notipv6]/", G_URI_FLAGS_NONE,
+                                    NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                    &error));
+  g_assert_error (error, G_URI_ERROR, G_URI_ERROR_BAD_HOST);
+  g_clear_error (&error);
+}
+
+static void
+test_uri_unescape_segment_to_buffer (void)
+{
+  const gchar *escaped = "a%20b%2Fc/d";
+  gchar buffer[32];
+  gchar small[4];
+  gchar in_place[] = "x%41%42y";
+
+  g_assert_cmpint (g_uri_unescape_segment_to_buffer (escaped, NULL, NULL,
+                                                     buffer, sizeof (buffer)),
+                   ==, 7);
+  g_assert_cmpstr (buffer, ==, "a b/c/d");
+
+  g_assert_cmpint (g_uri_unescape_segment_to_buffer (escaped, escaped + 5, NULL,
+                                                     buffer, sizeof (buffer)),
+                   ==, 3);
+  g_assert_cmpstr (buffer, ==, "a b");
+
+  g_assert_cmpint (g_uri_unescape_segment_to_buffer (escaped, NULL, NULL,
+                                                     small, sizeof (small)),
+                   ==, 7);
+  g_assert_cmpstr (small, ==, "a b");
+
+  g_assert_cmpint (g_uri_unescape_segment_to_buffer (escaped, NULL, NULL,
+                                                     NULL, 0),
+                   ==, 7);
+
+  g_assert_cmpint (g_uri_unescape_segment_to_buffer (escaped, NULL, "/",
+                                                     buffer, sizeof (buffer)),
+                   ==, -1);
+  g_assert_cmpstr (buffer, ==, "");
+  g_assert_cmpint (g_uri_unescape_segment_to_buffer ("a%00b", NULL, NULL,
+                                                     buffer, sizeof (buffer)),
+                   ==, -1);
+  g_assert_cmpint (g_uri_unescape_segment_to_buffer ("a%2", NULL, NULL,
+                                                     buffer, sizeof (buffer)),
+                   ==, -1);
+
+  g_assert_cmpint (g_uri_unescape_segment_to_buffer (in_place, NULL, NULL,
+                                                     in_place, sizeof (in_place)),
+                   ==, 4);
+  g_assert_cmpstr (in_place, ==, "xABy");
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -2053,6 +2183,7 @@ main (int   argc,
   g_test_add_data_func ("/uri/unescape-bytes/nul-terminated", GINT_TO_POINTER (TRUE), test_uri_unescape_bytes);
   g_test_add_data_func ("/uri/unescape-bytes/length", GINT_TO_POINTER (FALSE), test_uri_unescape_bytes);
   g_test_add_func ("/uri/unescape-segment", test_uri_unescape_segment);
+  g_test_add_func ("/uri/unescape-segment-to-buffer", test_uri_unescape_segment_to_buffer);
   g_test_add_func ("/uri/escape-string", test_uri_escape_string);
   g_test_add_func ("/uri/escape-bytes", test_uri_escape_bytes);
   g_test_add_func ("/uri/scheme", test_uri_scheme);
@@ -2060,6 +2191,7 @@ main (int   argc,
   g_test_add_func ("/uri/parsing/relative", test_uri_parsing_relative);
   g_test_add_func ("/uri/build", test_uri_build);
   g_test_add_func ("/uri/split", test_uri_split);
+  g_test_add_func ("/uri/split-view", test_uri_split_view);
   g_test_add_func ("/uri/is_valid", test_uri_is_valid);
   g_test_add_func ("/uri/to-string", test_uri_to_string);
   g_test_add_func ("/uri/join", test_uri_join);
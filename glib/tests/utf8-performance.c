@@ -22,6 +22,8 @@
 
 #include <glib.h>
 
+#include "../../gobject/tests/performance/performance-report.h"
+
 static guint num_iterations = 0;
 
 static const char str_ascii[] =
@@ -40,6 +42,14 @@ static const char str_cyrillic[] =
 static const char str_han[] =
     "漢字，亦稱中文字、中国字，在台灣又被稱為國字，是漢字文化圈廣泛使用的一種文字，屬於表意文字的詞素音節文字";
 
+/* Longer texts, built in main(), to measure throughput on larger inputs
+ * rather than the overhead of each call */
+static gchar *str_ascii_long;
+static gchar *str_mixed_long;
+static gchar *str_han_long;
+
+#define LONG_TEXT_LENGTH 4096
+
 typedef int (* GrindFunc) (const char *, gsize);
 
 #define GRIND_LOOP_BEGIN                 \
@@ -172,6 +182,29 @@ grind_utf8_validate_sized (const char *str, gsize len)
   return 0;
 }
 
+static int
+grind_utf8_strlen (const char *str, gsize len)
+{
+  /* Avoid the pure function call being hoisted out of the loop */
+  const char * volatile vstr = str;
+  glong acc = 0;
+  GRIND_LOOP_BEGIN
+    acc += g_utf8_strlen (vstr, -1);
+  GRIND_LOOP_END;
+  return acc;
+}
+
+static int
+grind_utf8_pointer_to_offset (const char *str, gsize len)
+{
+  const char * volatile vstr = str;
+  glong acc = 0;
+  GRIND_LOOP_BEGIN
+    acc += g_utf8_pointer_to_offset (vstr, str + len);
+  GRIND_LOOP_END;
+  return acc;
+}
+
 typedef struct _GrindData {
   GrindFunc func;
   const char *str;
@@ -186,27 +219,36 @@ perform (gconstpointer data)
   gsize len;
   gulong bytes_ground;
   gdouble time_elapsed;
-  gdouble result;
+  gdouble *results;
+  gint i;
 
   len = strlen (str);
   bytes_ground = (gulong) len * num_iterations;
 
-  g_test_timer_start ();
+  results = g_new (gdouble, perf_report_repeat);
 
-  grind_func (str, len);
+  for (i = 0; i < perf_report_repeat; i++)
+    {
+      g_test_timer_start ();
+
+      grind_func (str, len);
+
+      time_elapsed = g_test_timer_elapsed ();
+
+      results[i] = ((gdouble) bytes_ground / time_elapsed) * 1.0e-6;
+    }
 
-  time_elapsed = g_test_timer_elapsed ();
+  perf_report_add (g_test_get_path (), "MB/s", TRUE, results, perf_report_repeat);
 
-  result = ((gdouble) bytes_ground / time_elapsed) * 1.0e-6;
+  /* Sorted by perf_report_add() */
+  g_test_maximized_result (results[perf_report_repeat / 2], "%7.1f MB/s",
+                           results[perf_report_repeat / 2]);
 
-  g_test_maximized_result (result, "%7.1f MB/s", result);
+  g_free (results);
 
   g_slice_free (GrindData, gd);
 }
 
-static void
-add_cases(const char *path, GrindFunc func)
-{
 #define ADD_CASE(script)                              \
   G_STMT_START {                                      \
     GrindData *gd;                                    \
@@ -219,21 +261,65 @@ add_cases(const char *path, GrindFunc func)
     g_free (full_path);                               \
   } G_STMT_END
 
+static void
+add_cases(const char *path, GrindFunc func)
+{
   ADD_CASE(ascii);
   ADD_CASE(latin1);
   ADD_CASE(cyrillic);
   ADD_CASE(han);
+}
+
+static void
+add_long_cases (const char *path, GrindFunc func)
+{
+  ADD_CASE(ascii_long);
+  ADD_CASE(mixed_long);
+  ADD_CASE(han_long);
+}
 
 #undef ADD_CASE
+
+static gchar *
+repeat_text (const gchar *text)
+{
+  GString *string = g_string_sized_new (LONG_TEXT_LENGTH);
+
+  while (string->len < LONG_TEXT_LENGTH)
+    g_string_append (string, text);
+
+  return g_string_free (string, FALSE);
 }
 
 int
 main (int argc, char **argv)
 {
+  GOptionContext *context;
+  GError *error = NULL;
+  gchar *mixed;
+  int ret;
+
   g_test_init (&argc, &argv, NULL);
 
+  /* GTest writes TAP to stdout, so use --output for the JSON results */
+  context = g_option_context_new (NULL);
+  g_option_context_add_main_entries (context, perf_report_entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error) ||
+      !perf_report_init (&error))
+    {
+      g_printerr ("%s: %s\n", argv[0], error->message);
+      return 1;
+    }
+  g_option_context_free (context);
+
   num_iterations = g_test_perf () ? 500000 : 1;
 
+  str_ascii_long = repeat_text (str_ascii);
+  mixed = g_strjoin (" ", str_ascii, str_latin1, str_cyrillic, str_han, NULL);
+  str_mixed_long = repeat_text (mixed);
+  g_free (mixed);
+  str_han_long = repeat_text (str_han);
+
   add_cases ("/utf8/perf/get_char", grind_get_char);
   add_cases ("/utf8/perf/get_char-backwards", grind_get_char_backwards);
   add_cases ("/utf8/perf/get_char_validated", grind_get_char_validated);
@@ -243,6 +329,18 @@ main (int argc, char **argv)
   add_cases ("/utf8/perf/utf8_to_ucs4_fast-sized", grind_utf8_to_ucs4_fast_sized);
   add_cases ("/utf8/perf/utf8_validate", grind_utf8_validate);
   add_cases ("/utf8/perf/utf8_validate-sized", grind_utf8_validate_sized);
+  add_long_cases ("/utf8/perf/utf8_validate", grind_utf8_validate);
+  add_long_cases ("/utf8/perf/utf8_validate-sized", grind_utf8_validate_sized);
+  add_cases ("/utf8/perf/utf8_strlen", grind_utf8_strlen);
+  add_long_cases ("/utf8/perf/utf8_strlen", grind_utf8_strlen);
+  add_long_cases ("/utf8/perf/pointer_to_offset", grind_utf8_pointer_to_offset);
+
+  ret = g_test_run ();
+  ret |= perf_report_finish ();
+
+  g_free (str_ascii_long);
+  g_free (str_mixed_long);
+  g_free (str_han_long);
 
-  return g_test_run ();
+  return ret;
 }
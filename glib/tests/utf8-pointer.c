@@ -91,6 +91,109 @@ test_length (void)
   g_assert (g_utf8_strlen ("a\340\250\201c", 5) == 3);
 }
 
+static gchar *mixedline = "Zwölf Boxkämpfer jagen Viktor quer über den großen Sylter Deich. "
+"Широкая электрификация южных губерний даст мощный толчок подъёму сельского хозяйства. "
+"漢字，亦稱中文字、中国字，在台灣又被稱為國字，是漢字文化圈廣泛使用的一種文字 "
+"\360\220\244\200\360\220\244\201\360\220\244\202\360\220\244\203 € ç è ò ù 𝄞𝄞𝄞𝄞 "
+"Широкая электрификация 漢字，亦稱中文字 Zwölf Boxkämpfer\n";
+
+static void
+test_length_partial (void)
+{
+  GString *string = g_string_new (NULL);
+  const gchar *chars[] = { "a", "\303\247", "\342\202\254", "\360\235\204\236" };
+  glong n_chars = 0;
+  gsize i;
+
+  /* Long enough to be counted in blocks, with a partial last character at
+   * each offset within a block */
+  for (i = 0; i < 100; i++)
+    {
+      gsize j;
+
+      for (j = 0; j < G_N_ELEMENTS (chars); j++)
+        {
+          gsize k, len = strlen (chars[j]);
+
+          g_string_append (string, chars[j]);
+          n_chars++;
+
+          g_assert_cmpint (g_utf8_strlen (string->str, -1), ==, n_chars);
+          g_assert_cmpint (g_utf8_strlen (string->str, string->len), ==, n_chars);
+          g_assert_cmpint (g_utf8_strlen (string->str, string->len + 10), ==, n_chars);
+          for (k = 1; k < len; k++)
+            g_assert_cmpint (g_utf8_strlen (string->str, string->len - k), ==, n_chars - 1);
+
+          g_assert_cmpint (g_utf8_pointer_to_offset (string->str, string->str + string->len), ==, n_chars);
+          g_assert_true (g_utf8_offset_to_pointer (string->str, n_chars) == string->str + string->len);
+          g_assert_true (g_utf8_offset_to_pointer (string->str, n_chars - 1) == string->str + string->len - len);
+        }
+    }
+
+  g_string_free (string, TRUE);
+}
+
+static void
+check_index (const gchar *string,
+             gsize        len)
+{
+  GUtf8Index *index;
+  const gchar *p, *end = string + len;
+  glong n_chars, i;
+
+  index = g_utf8_index_new (string, len);
+  n_chars = g_utf8_strlen (string, len);
+  g_assert_cmpint (g_utf8_index_get_length (index), ==, n_chars);
+
+  for (p = string, i = 0; i <= n_chars; i++)
+    {
+      const gchar *q;
+
+      g_assert_true (g_utf8_index_offset_to_pointer (index, i) == p);
+      g_assert_cmpint (g_utf8_index_pointer_to_offset (index, p), ==, i);
+
+      if (i == n_chars)
+        break;
+
+      /* Positions within a character are counted like g_utf8_pointer_to_offset() does */
+      for (q = p + 1; q < g_utf8_next_char (p); q++)
+        g_assert_cmpint (g_utf8_index_pointer_to_offset (index, q), ==, i + 1);
+
+      p = g_utf8_next_char (p);
+    }
+  g_assert_true (p == end);
+
+  g_utf8_index_free (index);
+}
+
+static void
+test_index (void)
+{
+  GString *string;
+  gchar *copy;
+  gsize i;
+
+  check_index ("", 0);
+  check_index ("a", 1);
+  check_index (longline, strlen (longline));
+  check_index (mixedline, strlen (mixedline));
+
+  string = g_string_new (NULL);
+  for (i = 0; i < 50; i++)
+    {
+      g_string_append (string, mixedline);
+      g_string_append (string, longline);
+    }
+  check_index (string->str, string->len);
+
+  /* Not nul-terminated */
+  copy = g_memdup2 (string->str, string->len);
+  check_index (copy, string->len);
+  g_free (copy);
+
+  g_string_free (string, TRUE);
+}
+
 static void
 test_find (void)
 {
@@ -183,7 +286,10 @@ int main (int argc, char *argv[])
   g_test_init (&argc, &argv, NULL);
 
   g_test_add_data_func ("/utf8/offsets", longline, test_utf8);
+  g_test_add_data_func ("/utf8/offsets/mixed", mixedline, test_utf8);
   g_test_add_func ("/utf8/lengths", test_length);
+  g_test_add_func ("/utf8/lengths/partial", test_length_partial);
+  g_test_add_func ("/utf8/index", test_index);
   g_test_add_func ("/utf8/find", test_find);
 
   return g_test_run ();
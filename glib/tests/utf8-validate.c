@@ -301,6 +301,56 @@ do_test (gconstpointer d)
     }
 }
 
+/* Check each of the tests above again in the middle of longer strings, so
+ * that the invalid data ends up at every position within the blocks which
+ * are validated at once by the vectorised implementations. */
+static void
+test_utf8_validate_long (void)
+{
+  const gchar *paddings[] = { "x", "\xc3\xa9", "\xe2\x89\xa0", "\xf0\x9f\x92\xa9" };
+  gsize i, j, k;
+
+  for (i = 0; global_test[i].text; i++)
+    {
+      const Test *test = &global_test[i];
+
+      if (test->max_len >= 0)
+        continue;
+
+      for (j = 0; j < G_N_ELEMENTS (paddings); j++)
+        {
+          GString *string = g_string_new (NULL);
+
+          for (k = 0; k < 70; k++)
+            {
+              gsize expected;
+              const gchar *end;
+              gboolean result;
+
+              g_string_truncate (string, 0);
+              while (string->len < k)
+                g_string_append (string, paddings[j]);
+              expected = string->len + test->offset;
+
+              g_string_append (string, test->text);
+              g_string_append (string, "0123456789abcdef0123456789abcdef");
+              if (test->valid)
+                expected = string->len;
+
+              result = g_utf8_validate (string->str, -1, &end);
+              g_assert_true (result == test->valid);
+              g_assert_cmpint (end - string->str, ==, expected);
+
+              result = g_utf8_validate_len (string->str, string->len, &end);
+              g_assert_true (result == test->valid);
+              g_assert_cmpint (end - string->str, ==, expected);
+            }
+
+          g_string_free (string, TRUE);
+        }
+    }
+}
+
 /* Test the behaviour of g_utf8_get_char_validated() with various inputs and
  * length restrictions. */
 static void
@@ -373,6 +423,7 @@ main (int argc, char *argv[])
       g_free (path);
     }
 
+  g_test_add_func ("/utf8/validate/long", test_utf8_validate_long);
   g_test_add_func ("/utf8/get-char-validated", test_utf8_get_char_validated);
 
   return g_test_run ();
@@ -1204,6 +1204,98 @@ test_free_sized (void)
   g_free_sized (NULL, 123);
 }
 
+typedef struct
+{
+  gsize size;
+  guint n_trims;
+  guint last_level;
+} TestCache;
+
+static gsize
+test_cache_trim (guint    level,
+                 gpointer user_data)
+{
+  TestCache *cache = user_data;
+  gsize freed = cache->size;
+
+  cache->size = 0;
+  cache->n_trims++;
+  cache->last_level = level;
+
+  return freed;
+}
+
+static gsize
+test_cache_get_size (gpointer user_data)
+{
+  TestCache *cache = user_data;
+
+  return cache->size;
+}
+
+static void
+test_cache_foreach_cb (const gchar *name,
+                       guint        priority,
+                       gsize        size,
+                       gpointer     user_data)
+{
+  GString *seen = user_data;
+
+  if (g_str_has_prefix (name, "test-"))
+    g_string_append_printf (seen, "%s:%u:%" G_GSIZE_FORMAT ";", name, priority, size);
+}
+
+static void
+test_mem_cache (void)
+{
+  TestCache cheap = { 100, 0, 0 }, expensive = { 1000, 0, 0 };
+  guint cheap_id, expensive_id;
+  GString *seen;
+
+  g_test_summary ("Test registering and trimming caches with g_mem_cache_register()");
+
+  /* Registered out of order, listed by priority */
+  expensive_id = g_mem_cache_register ("test-expensive", 100, test_cache_trim,
+                                       test_cache_get_size, &expensive);
+  cheap_id = g_mem_cache_register ("test-cheap", 50, test_cache_trim,
+                                   test_cache_get_size, &cheap);
+  g_assert_cmpuint (cheap_id, !=, 0);
+  g_assert_cmpuint (expensive_id, !=, 0);
+  g_assert_cmpuint (cheap_id, !=, expensive_id);
+
+  seen = g_string_new (NULL);
+  g_mem_cache_foreach (test_cache_foreach_cb, seen);
+  g_assert_cmpstr (seen->str, ==, "test-cheap:50:100;test-expensive:100:1000;");
+
+  /* Only caches with a priority of at most the level are trimmed */
+  g_assert_cmpuint (g_mem_cache_trim (10), ==, 0);
+  g_assert_cmpuint (cheap.n_trims, ==, 0);
+
+  g_assert_cmpuint (g_mem_cache_trim (50), ==, 100);
+  g_assert_cmpuint (cheap.n_trims, ==, 1);
+  g_assert_cmpuint (cheap.last_level, ==, 50);
+  g_assert_cmpuint (expensive.n_trims, ==, 0);
+
+  cheap.size = 10;
+  g_assert_cmpuint (g_mem_cache_trim (255), ==, 1010);
+  g_assert_cmpuint (cheap.n_trims, ==, 2);
+  g_assert_cmpuint (expensive.n_trims, ==, 1);
+  g_assert_cmpuint (expensive.last_level, ==, 255);
+
+  /* Unregistered caches are left alone */
+  g_mem_cache_unregister (cheap_id);
+  g_mem_cache_trim (255);
+  g_assert_cmpuint (cheap.n_trims, ==, 2);
+  g_assert_cmpuint (expensive.n_trims, ==, 2);
+
+  g_string_truncate (seen, 0);
+  g_mem_cache_foreach (test_cache_foreach_cb, seen);
+  g_assert_cmpstr (seen->str, ==, "test-expensive:100:0;");
+
+  g_mem_cache_unregister (expensive_id);
+  g_string_free (seen, TRUE);
+}
+
 static void
 test_nullify (void)
 {
@@ -1376,6 +1468,7 @@ main (int   argc,
   g_test_add_func ("/utils/aligned-mem/zeroed", test_aligned_mem_zeroed);
   g_test_add_func ("/utils/aligned-mem/free-sized", test_aligned_mem_free_sized);
   g_test_add_func ("/utils/free-sized", test_free_sized);
+  g_test_add_func ("/utils/mem-cache", test_mem_cache);
   g_test_add_func ("/utils/nullify", test_nullify);
   g_test_add_func ("/utils/atexit", test_atexit);
   g_test_add_func ("/utils/check-setuid", test_check_setuid);
@@ -147,6 +147,7 @@ struct _GModule
   guint ref_count : 31;
   guint is_resident : 1;
   GModuleUnload unload;
+  GHashTable *symbols;  /* (owned) (nullable) name -> address, of found symbols */
   GModule *next;
 };
 
@@ -500,6 +501,7 @@ g_module_open_full (const gchar   *file_name,
 	      main_module->ref_count = 1;
 	      main_module->is_resident = TRUE;
 	      main_module->unload = NULL;
+	      main_module->symbols = NULL;
 	      main_module->next = NULL;
 	    }
 	}
@@ -652,6 +654,7 @@ g_module_open_full (const gchar   *file_name,
       module->ref_count = 1;
       module->is_resident = FALSE;
       module->unload = NULL;
+      module->symbols = NULL;
       module->next = modules;
       modules = module;
       
@@ -761,6 +764,7 @@ g_module_close (GModule *module)
       module->next = NULL;
       
       _g_module_close (module->handle);
+      g_clear_pointer (&module->symbols, g_hash_table_unref);
       g_free (module->file_name);
       g_free (module);
     }
@@ -797,6 +801,55 @@ g_module_error (void)
   return g_private_get (&module_error_private);
 }
 
+/* Must be called with g_module_global_lock held. Sets the module error on
+ * failure. */
+static gboolean
+g_module_symbol_locked (GModule     *module,
+                        const gchar *symbol_name,
+                        gpointer    *symbol)
+{
+  const gchar *module_error;
+
+  if (module->symbols != NULL &&
+      g_hash_table_lookup_extended (module->symbols, symbol_name, NULL, symbol))
+    return TRUE;
+
+#ifdef	G_MODULE_NEED_USCORE
+  {
+    gchar *name;
+
+    name = g_strconcat ("_", symbol_name, NULL);
+    *symbol = _g_module_symbol (module->handle, name);
+    g_free (name);
+  }
+#else	/* !G_MODULE_NEED_USCORE */
+  *symbol = _g_module_symbol (module->handle, symbol_name);
+#endif	/* !G_MODULE_NEED_USCORE */
+  
+  module_error = g_module_error ();
+  if (module_error)
+    {
+      gchar *error;
+
+      error = g_strconcat ("'", symbol_name, "': ", module_error, NULL);
+      g_module_set_error (error);
+      g_free (error);
+      *symbol = NULL;
+      return FALSE;
+    }
+
+  /* The symbols of the main module depend on which other modules are
+   * loaded, so only symbols of other modules are cached */
+  if (module != main_module)
+    {
+      if (module->symbols == NULL)
+        module->symbols = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+      g_hash_table_insert (module->symbols, g_strdup (symbol_name), *symbol);
+    }
+
+  return TRUE;
+}
+
 /**
  * g_module_symbol:
  * @module: a #GModule
@@ -813,7 +866,7 @@ g_module_symbol (GModule     *module,
                  const gchar *symbol_name,
                  gpointer    *symbol)
 {
-  const gchar *module_error;
+  gboolean found;
 
   if (symbol)
     *symbol = NULL;
@@ -824,32 +877,62 @@ g_module_symbol (GModule     *module,
   g_return_val_if_fail (symbol != NULL, FALSE);
   
   g_rec_mutex_lock (&g_module_global_lock);
+  found = g_module_symbol_locked (module, symbol_name, symbol);
+  g_rec_mutex_unlock (&g_module_global_lock);
 
-#ifdef	G_MODULE_NEED_USCORE
-  {
-    gchar *name;
+  return found;
+}
 
-    name = g_strconcat ("_", symbol_name, NULL);
-    *symbol = _g_module_symbol (module->handle, name);
-    g_free (name);
-  }
-#else	/* !G_MODULE_NEED_USCORE */
-  *symbol = _g_module_symbol (module->handle, symbol_name);
-#endif	/* !G_MODULE_NEED_USCORE */
-  
-  module_error = g_module_error ();
-  if (module_error)
+/**
+ * g_module_symbols:
+ * @module: a #GModule
+ * @symbol_names: (array zero-terminated=1): a %NULL-terminated array of the
+ *   names of the symbols to find
+ * @symbols: (out caller-allocates) (array): return location for the pointers
+ *   to the symbol values, with as many elements as @symbol_names
+ *
+ * Gets several symbol pointers from a module at once. This is equivalent to
+ * calling g_module_symbol() for each element of @symbol_names, but is faster
+ * when resolving many symbols, such as a library’s `_get_type()` functions.
+ *
+ * Symbols which can’t be found are set to %NULL in @symbols, and the module
+ * error describes the first of them. Note that a valid symbol can be %NULL.
+ *
+ * Returns: %TRUE if all the symbols were found
+ *
+ * Since: 2.82
+ */
+gboolean
+g_module_symbols (GModule            *module,
+                  const gchar * const *symbol_names,
+                  gpointer           *symbols)
+{
+  gchar *first_error = NULL;
+  gsize i;
+
+  SUPPORT_OR_RETURN (FALSE);
+
+  g_return_val_if_fail (module != NULL, FALSE);
+  g_return_val_if_fail (symbol_names != NULL, FALSE);
+  g_return_val_if_fail (symbols != NULL, FALSE);
+
+  g_rec_mutex_lock (&g_module_global_lock);
+
+  for (i = 0; symbol_names[i] != NULL; i++)
     {
-      gchar *error;
+      if (!g_module_symbol_locked (module, symbol_names[i], &symbols[i]) &&
+          first_error == NULL)
+        first_error = g_strdup (g_module_error ());
 
-      error = g_strconcat ("'", symbol_name, "': ", module_error, NULL);
-      g_module_set_error (error);
-      g_free (error);
-      *symbol = NULL;
+      /* Each lookup checks the module error afresh */
+      g_module_set_error (NULL);
     }
-  
+
+  g_module_set_error_unduped (first_error);
+
   g_rec_mutex_unlock (&g_module_global_lock);
-  return !module_error;
+
+  return first_error == NULL;
 }
 
 /**
@@ -123,6 +123,12 @@ gboolean              g_module_symbol        (GModule      *module,
 					      const gchar  *symbol_name,
 					      gpointer     *symbol);
 
+/* retrieve several symbol pointers from 'module', returns TRUE if all are found */
+GMODULE_AVAILABLE_IN_2_82
+gboolean              g_module_symbols       (GModule            *module,
+                                              const gchar * const *symbol_names,
+                                              gpointer           *symbols);
+
 /* retrieve the file name from an existing module */
 GMODULE_AVAILABLE_IN_ALL
 const gchar *         g_module_name          (GModule      *module);
@@ -193,6 +193,26 @@ test_module_basics (void)
   gmod_f (module_a);
   test_states (NULL, "BOOH", NULL);
 
+  /* look up several symbols at once */
+
+  {
+    const gchar *names[] = { "gplugin_a_func", "gplugin_a_state", "gplugin_a_nonexistent", NULL };
+    gpointer symbols[G_N_ELEMENTS (names) - 1];
+    gpointer func;
+
+    g_assert_true (g_module_symbol (module_a, "gplugin_a_func", &func));
+
+    g_assert_false (g_module_symbols (module_a, names, symbols));
+    g_assert_true (symbols[0] == func);
+    g_assert_true (symbols[1] == (gpointer) gplugin_a_state);
+    g_assert_null (symbols[2]);
+    g_assert_nonnull (g_strstr_len (g_module_error (), -1, "gplugin_a_nonexistent"));
+
+    names[2] = NULL;
+    g_assert_true (g_module_symbols (module_a, names, symbols));
+    g_assert_null (g_module_error ());
+  }
+
   /* unload plugins  */
 
   if (!g_module_close (module_a))
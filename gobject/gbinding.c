@@ -90,6 +90,11 @@
  * various ways of blocking a signal emission, like [func@GObject.signal_stop_emission]
  * or [func@GObject.signal_handler_block].
  *
+ * As notifications are held back while the source is frozen with
+ * [method@GObject.Object.freeze_notify], changing the source property
+ * several times while frozen updates the target only once, when the
+ * source is thawed again.
+ *
  * A binding will be severed, and the resources it allocates freed, whenever
  * either one of the `GObject` instances it refers to are finalized, or when
  * the #GBinding instance loses its last reference.
@@ -112,6 +117,7 @@
 #include "gobject.h"
 #include "gsignal.h"
 #include "gparamspecs.h"
+#include "gtype-private.h"
 #include "gvaluetypes.h"
 
 #include "glibintl.h"
@@ -254,6 +260,11 @@ struct _GBinding
   GParamSpec *source_pspec;
   GParamSpec *target_pspec;
 
+  /* how default_transform() converts values in each direction, resolved
+   * once when the binding is constructed; see resolve_value_transform() */
+  GValueTransform value_transform_s2t;
+  GValueTransform value_transform_t2s;
+
   GBindingFlags flags;
 
   guint source_notify; /* LOCK: unbind_lock */
@@ -262,6 +273,10 @@ struct _GBinding
 
   /* a guard, to avoid loops */
   guint is_frozen : 1;
+
+  /* whether default_transform() copies the values, per direction */
+  guint copy_s2t : 1;
+  guint copy_t2s : 1;
 };
 
 struct _GBindingClass
@@ -493,6 +508,49 @@ default_invert_boolean_transform (GBinding     *binding,
   return TRUE;
 }
 
+/* Resolves how default_transform() converts a value of @src_type into
+ * one of @dest_type, so that it does not have to be looked up again
+ * on each notification */
+static void
+resolve_value_transform (GType            src_type,
+                         GType            dest_type,
+                         gboolean        *copy,
+                         GValueTransform *transform)
+{
+  *copy = g_type_is_a (src_type, dest_type) ||
+          g_value_type_compatible (src_type, dest_type);
+  *transform = *copy ? NULL : _g_value_transform_lookup (src_type, dest_type);
+}
+
+/* Like @transform_func, short-cutting default_transform() with the
+ * conversion resolved by resolve_value_transform() */
+static gboolean
+binding_transform (GBinding              *binding,
+                   GBindingTransformFunc  transform_func,
+                   gpointer               transform_data,
+                   gboolean               copy,
+                   GValueTransform        value_transform,
+                   const GValue          *from_value,
+                   GValue                *to_value)
+{
+  if (transform_func == default_transform)
+    {
+      if (copy)
+        {
+          g_value_copy (from_value, to_value);
+          return TRUE;
+        }
+
+      if (value_transform != NULL)
+        {
+          _g_value_transform_with (value_transform, from_value, to_value);
+          return TRUE;
+        }
+    }
+
+  return transform_func (binding, from_value, to_value, transform_data);
+}
+
 static void
 on_source_notify (GObject          *source,
                   GParamSpec       *pspec,
@@ -536,12 +594,15 @@ on_source_notify (GObject          *source,
   g_value_init (&from_value, G_PARAM_SPEC_VALUE_TYPE (binding->source_pspec));
   g_value_init (&to_value, G_PARAM_SPEC_VALUE_TYPE (binding->target_pspec));
 
-  g_object_get_property (source, binding->source_pspec->name, &from_value);
+  _g_object_get_property_by_pspec (source, binding->source_pspec, &from_value);
 
-  res = transform_func->transform_s2t (binding,
-                                       &from_value,
-                                       &to_value,
-                                       transform_func->transform_data);
+  res = binding_transform (binding,
+                           transform_func->transform_s2t,
+                           transform_func->transform_data,
+                           binding->copy_s2t,
+                           binding->value_transform_s2t,
+                           &from_value,
+                           &to_value);
 
   transform_func_unref (transform_func);
 
@@ -550,7 +611,7 @@ on_source_notify (GObject          *source,
       binding->is_frozen = TRUE;
 
       (void) g_param_value_validate (binding->target_pspec, &to_value);
-      g_object_set_property (target, binding->target_pspec->name, &to_value);
+      g_object_set_many_and_notify (target, 1, &binding->target_pspec, &to_value);
 
       binding->is_frozen = FALSE;
     }
@@ -605,12 +666,15 @@ on_target_notify (GObject          *target,
   g_value_init (&from_value, G_PARAM_SPEC_VALUE_TYPE (binding->target_pspec));
   g_value_init (&to_value, G_PARAM_SPEC_VALUE_TYPE (binding->source_pspec));
 
-  g_object_get_property (target, binding->target_pspec->name, &from_value);
+  _g_object_get_property_by_pspec (target, binding->target_pspec, &from_value);
 
-  res = transform_func->transform_t2s (binding,
-                                       &from_value,
-                                       &to_value,
-                                       transform_func->transform_data);
+  res = binding_transform (binding,
+                           transform_func->transform_t2s,
+                           transform_func->transform_data,
+                           binding->copy_t2s,
+                           binding->value_transform_t2s,
+                           &from_value,
+                           &to_value);
   transform_func_unref (transform_func);
 
   if (res)
@@ -618,7 +682,7 @@ on_target_notify (GObject          *target,
       binding->is_frozen = TRUE;
 
       (void) g_param_value_validate (binding->source_pspec, &to_value);
-      g_object_set_property (source, binding->source_pspec->name, &to_value);
+      g_object_set_many_and_notify (source, 1, &binding->source_pspec, &to_value);
 
       binding->is_frozen = FALSE;
     }
@@ -796,6 +860,7 @@ g_binding_constructed (GObject *gobject)
   GBinding *binding = G_BINDING (gobject);
   GBindingTransformFunc transform_func = default_transform;
   GObject *source, *target;
+  gboolean copy;
   GQuark source_property_detail;
   GClosure *source_notify_closure;
 
@@ -816,6 +881,15 @@ g_binding_constructed (GObject *gobject)
   g_assert (binding->source_pspec != NULL);
   g_assert (binding->target_pspec != NULL);
 
+  resolve_value_transform (G_PARAM_SPEC_VALUE_TYPE (binding->source_pspec),
+                           G_PARAM_SPEC_VALUE_TYPE (binding->target_pspec),
+                           &copy, &binding->value_transform_s2t);
+  binding->copy_s2t = copy;
+  resolve_value_transform (G_PARAM_SPEC_VALUE_TYPE (binding->target_pspec),
+                           G_PARAM_SPEC_VALUE_TYPE (binding->source_pspec),
+                           &copy, &binding->value_transform_t2s);
+  binding->copy_t2s = copy;
+
   /* switch to the invert boolean transform if needed */
   if (binding->flags & G_BINDING_INVERT_BOOLEAN)
     transform_func = default_invert_boolean_transform;
@@ -372,6 +372,15 @@ typedef gsize GType;
  */
 #define G_TYPE_STRV_BUILDER (g_strv_builder_get_type ())
 
+/**
+ * G_TYPE_REGEX_SET:
+ *
+ * The #GType for a boxed type holding a #GRegexSet reference.
+ *
+ * Since: 2.82
+ */
+#define G_TYPE_REGEX_SET (g_regex_set_get_type ())
+
 GOBJECT_AVAILABLE_IN_ALL
 GType   g_date_get_type            (void) G_GNUC_CONST;
 GOBJECT_AVAILABLE_IN_ALL
@@ -444,6 +453,8 @@ GOBJECT_AVAILABLE_IN_2_80
 GType   g_rand_get_type (void) G_GNUC_CONST;
 GOBJECT_AVAILABLE_IN_2_80
 GType   g_strv_builder_get_type (void) G_GNUC_CONST;
+GOBJECT_AVAILABLE_IN_2_82
+GType   g_regex_set_get_type (void) G_GNUC_CONST;
 
 GOBJECT_DEPRECATED_FOR('G_TYPE_VARIANT')
 GType   g_variant_get_gtype        (void) G_GNUC_CONST;
@@ -0,0 +1,349 @@
+/* GObject - GLib Type, Object, Parameter and Signal Library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ___G_SIGNAL_MARSHAL_MARSHAL_H__
+#define ___G_SIGNAL_MARSHAL_MARSHAL_H__
+
+#include "gclosure.h"
+
+G_BEGIN_DECLS
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__BOXED (GClosure     *closure,
+                                       GValue       *return_value,
+                                       guint         n_param_values,
+                                       const GValue *param_values,
+                                       gpointer      invocation_hint,
+                                       gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__BOXEDv (GClosure *closure,
+                                        GValue   *return_value,
+                                        gpointer  instance,
+                                        va_list   args,
+                                        gpointer  marshal_data,
+                                        int       n_params,
+                                        GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__INT (GClosure     *closure,
+                                     GValue       *return_value,
+                                     guint         n_param_values,
+                                     const GValue *param_values,
+                                     gpointer      invocation_hint,
+                                     gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__INTv (GClosure *closure,
+                                      GValue   *return_value,
+                                      gpointer  instance,
+                                      va_list   args,
+                                      gpointer  marshal_data,
+                                      int       n_params,
+                                      GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__OBJECT (GClosure     *closure,
+                                        GValue       *return_value,
+                                        guint         n_param_values,
+                                        const GValue *param_values,
+                                        gpointer      invocation_hint,
+                                        gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__OBJECTv (GClosure *closure,
+                                         GValue   *return_value,
+                                         gpointer  instance,
+                                         va_list   args,
+                                         gpointer  marshal_data,
+                                         int       n_params,
+                                         GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__POINTER (GClosure     *closure,
+                                         GValue       *return_value,
+                                         guint         n_param_values,
+                                         const GValue *param_values,
+                                         gpointer      invocation_hint,
+                                         gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__POINTERv (GClosure *closure,
+                                          GValue   *return_value,
+                                          gpointer  instance,
+                                          va_list   args,
+                                          gpointer  marshal_data,
+                                          int       n_params,
+                                          GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__STRING (GClosure     *closure,
+                                        GValue       *return_value,
+                                        guint         n_param_values,
+                                        const GValue *param_values,
+                                        gpointer      invocation_hint,
+                                        gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__STRINGv (GClosure *closure,
+                                         GValue   *return_value,
+                                         gpointer  instance,
+                                         va_list   args,
+                                         gpointer  marshal_data,
+                                         int       n_params,
+                                         GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__UINT (GClosure     *closure,
+                                      GValue       *return_value,
+                                      guint         n_param_values,
+                                      const GValue *param_values,
+                                      gpointer      invocation_hint,
+                                      gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__UINTv (GClosure *closure,
+                                       GValue   *return_value,
+                                       gpointer  instance,
+                                       va_list   args,
+                                       gpointer  marshal_data,
+                                       int       n_params,
+                                       GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__VOID (GClosure     *closure,
+                                      GValue       *return_value,
+                                      guint         n_param_values,
+                                      const GValue *param_values,
+                                      gpointer      invocation_hint,
+                                      gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_BOOLEAN__VOIDv (GClosure *closure,
+                                       GValue   *return_value,
+                                       gpointer  instance,
+                                       va_list   args,
+                                       gpointer  marshal_data,
+                                       int       n_params,
+                                       GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__BOOLEAN_BOOLEAN (GClosure     *closure,
+                                              GValue       *return_value,
+                                              guint         n_param_values,
+                                              const GValue *param_values,
+                                              gpointer      invocation_hint,
+                                              gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__BOOLEAN_BOOLEANv (GClosure *closure,
+                                               GValue   *return_value,
+                                               gpointer  instance,
+                                               va_list   args,
+                                               gpointer  marshal_data,
+                                               int       n_params,
+                                               GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__BOXED_BOXED (GClosure     *closure,
+                                          GValue       *return_value,
+                                          guint         n_param_values,
+                                          const GValue *param_values,
+                                          gpointer      invocation_hint,
+                                          gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__BOXED_BOXEDv (GClosure *closure,
+                                           GValue   *return_value,
+                                           gpointer  instance,
+                                           va_list   args,
+                                           gpointer  marshal_data,
+                                           int       n_params,
+                                           GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__DOUBLE_DOUBLE (GClosure     *closure,
+                                            GValue       *return_value,
+                                            guint         n_param_values,
+                                            const GValue *param_values,
+                                            gpointer      invocation_hint,
+                                            gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__DOUBLE_DOUBLEv (GClosure *closure,
+                                             GValue   *return_value,
+                                             gpointer  instance,
+                                             va_list   args,
+                                             gpointer  marshal_data,
+                                             int       n_params,
+                                             GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__INT_INT (GClosure     *closure,
+                                      GValue       *return_value,
+                                      guint         n_param_values,
+                                      const GValue *param_values,
+                                      gpointer      invocation_hint,
+                                      gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__INT_INTv (GClosure *closure,
+                                       GValue   *return_value,
+                                       gpointer  instance,
+                                       va_list   args,
+                                       gpointer  marshal_data,
+                                       int       n_params,
+                                       GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__INT_INT_INT (GClosure     *closure,
+                                          GValue       *return_value,
+                                          guint         n_param_values,
+                                          const GValue *param_values,
+                                          gpointer      invocation_hint,
+                                          gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__INT_INT_INTv (GClosure *closure,
+                                           GValue   *return_value,
+                                           gpointer  instance,
+                                           va_list   args,
+                                           gpointer  marshal_data,
+                                           int       n_params,
+                                           GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__OBJECT_OBJECT (GClosure     *closure,
+                                            GValue       *return_value,
+                                            guint         n_param_values,
+                                            const GValue *param_values,
+                                            gpointer      invocation_hint,
+                                            gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__OBJECT_OBJECTv (GClosure *closure,
+                                             GValue   *return_value,
+                                             gpointer  instance,
+                                             va_list   args,
+                                             gpointer  marshal_data,
+                                             int       n_params,
+                                             GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__OBJECT_POINTER (GClosure     *closure,
+                                             GValue       *return_value,
+                                             guint         n_param_values,
+                                             const GValue *param_values,
+                                             gpointer      invocation_hint,
+                                             gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__OBJECT_POINTERv (GClosure *closure,
+                                              GValue   *return_value,
+                                              gpointer  instance,
+                                              va_list   args,
+                                              gpointer  marshal_data,
+                                              int       n_params,
+                                              GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__OBJECT_STRING (GClosure     *closure,
+                                            GValue       *return_value,
+                                            guint         n_param_values,
+                                            const GValue *param_values,
+                                            gpointer      invocation_hint,
+                                            gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__OBJECT_STRINGv (GClosure *closure,
+                                             GValue   *return_value,
+                                             gpointer  instance,
+                                             va_list   args,
+                                             gpointer  marshal_data,
+                                             int       n_params,
+                                             GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__OBJECT_UINT (GClosure     *closure,
+                                          GValue       *return_value,
+                                          guint         n_param_values,
+                                          const GValue *param_values,
+                                          gpointer      invocation_hint,
+                                          gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__OBJECT_UINTv (GClosure *closure,
+                                           GValue   *return_value,
+                                           gpointer  instance,
+                                           va_list   args,
+                                           gpointer  marshal_data,
+                                           int       n_params,
+                                           GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__POINTER_POINTER (GClosure     *closure,
+                                              GValue       *return_value,
+                                              guint         n_param_values,
+                                              const GValue *param_values,
+                                              gpointer      invocation_hint,
+                                              gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__POINTER_POINTERv (GClosure *closure,
+                                               GValue   *return_value,
+                                               gpointer  instance,
+                                               va_list   args,
+                                               gpointer  marshal_data,
+                                               int       n_params,
+                                               GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__STRING_STRING (GClosure     *closure,
+                                            GValue       *return_value,
+                                            guint         n_param_values,
+                                            const GValue *param_values,
+                                            gpointer      invocation_hint,
+                                            gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__STRING_STRINGv (GClosure *closure,
+                                             GValue   *return_value,
+                                             gpointer  instance,
+                                             va_list   args,
+                                             gpointer  marshal_data,
+                                             int       n_params,
+                                             GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__UINT_UINT (GClosure     *closure,
+                                        GValue       *return_value,
+                                        guint         n_param_values,
+                                        const GValue *param_values,
+                                        gpointer      invocation_hint,
+                                        gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__UINT_UINTv (GClosure *closure,
+                                         GValue   *return_value,
+                                         gpointer  instance,
+                                         va_list   args,
+                                         gpointer  marshal_data,
+                                         int       n_params,
+                                         GType    *param_types);
+
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__UINT_UINT_UINT (GClosure     *closure,
+                                             GValue       *return_value,
+                                             guint         n_param_values,
+                                             const GValue *param_values,
+                                             gpointer      invocation_hint,
+                                             gpointer      marshal_data);
+G_GNUC_INTERNAL
+void _g_signal_marshal_VOID__UINT_UINT_UINTv (GClosure *closure,
+                                              GValue   *return_value,
+                                              gpointer  instance,
+                                              va_list   args,
+                                              gpointer  marshal_data,
+                                              int       n_params,
+                                              GType    *param_types);
+
+
+G_END_DECLS
+
+#endif /* ___G_SIGNAL_MARSHAL_MARSHAL_H__ */
@@ -216,13 +216,25 @@ static void object_interface_check_properties           (gpointer        check_d
 /* --- typedefs --- */
 typedef struct _GObjectNotifyQueue            GObjectNotifyQueue;
 
+#define NOTIFY_QUEUE_N_INLINE_PSPECS 16
+
+/* Pending pspecs are kept in the order they were queued, in
+ * @pspecs_inline until that is full, then in a heap array. @pspecs_mask
+ * has one bit set per queued pspec, picked by its address, so that only
+ * pspecs which might be queued already need to be searched for. */
 struct _GObjectNotifyQueue
 {
-  GSList  *pspecs;
+  GParamSpec **pspecs;
   guint16  n_pspecs;
+  guint16  n_pspecs_allocated;
   guint16  freeze_count;
+  guint64  pspecs_mask;
+  GParamSpec *pspecs_inline[NOTIFY_QUEUE_N_INLINE_PSPECS];
 };
 
+#define NOTIFY_QUEUE_PSPEC_BIT(pspec) \
+  (G_GUINT64_CONSTANT (1) << ((((guintptr) (pspec)) / sizeof (gpointer)) % 64))
+
 /* --- variables --- */
 static GQuark	            quark_closure_array = 0;
 static GQuark	            quark_weak_notifies = 0;
@@ -656,7 +668,8 @@ g_object_notify_queue_free (gpointer data)
 {
   GObjectNotifyQueue *nqueue = data;
 
-  g_slist_free (nqueue->pspecs);
+  if (nqueue->pspecs != nqueue->pspecs_inline)
+    g_free (nqueue->pspecs);
   g_free_sized (nqueue, sizeof (GObjectNotifyQueue));
 }
 
@@ -665,11 +678,13 @@ g_object_notify_queue_create_queue_frozen (GObject *object)
 {
   GObjectNotifyQueue *nqueue;
 
-  nqueue = g_new0 (GObjectNotifyQueue, 1);
+  nqueue = g_new (GObjectNotifyQueue, 1);
 
   *nqueue = (GObjectNotifyQueue){
     .freeze_count = 1,
+    .n_pspecs_allocated = NOTIFY_QUEUE_N_INLINE_PSPECS,
   };
+  nqueue->pspecs = nqueue->pspecs_inline;
 
   g_datalist_id_set_data_full (&object->qdata, quark_notify_queue,
                                nqueue, g_object_notify_queue_free);
@@ -709,9 +724,8 @@ g_object_notify_queue_thaw (GObject            *object,
                             GObjectNotifyQueue *nqueue,
                             gboolean take_ref)
 {
-  GParamSpec *pspecs_mem[16], **pspecs, **free_me = NULL;
-  GSList *slist;
-  guint n_pspecs = 0;
+  GParamSpec *pspecs_mem[NOTIFY_QUEUE_N_INLINE_PSPECS], **pspecs, **free_me = NULL;
+  guint n_pspecs, i;
 
   object_bit_lock (object, OPTIONAL_BIT_LOCK_NOTIFY);
 
@@ -737,14 +751,29 @@ g_object_notify_queue_thaw (GObject            *object,
       return;
     }
 
-  pspecs = nqueue->n_pspecs > 16 ? free_me = g_new (GParamSpec*, nqueue->n_pspecs) : pspecs_mem;
-
-  for (slist = nqueue->pspecs; slist; slist = slist->next)
+  n_pspecs = nqueue->n_pspecs;
+  if (nqueue->pspecs != nqueue->pspecs_inline)
+    {
+      /* Steal the heap array rather than copying it */
+      pspecs = free_me = nqueue->pspecs;
+      nqueue->pspecs = nqueue->pspecs_inline;
+    }
+  else
     {
-      pspecs[n_pspecs++] = slist->data;
+      pspecs = pspecs_mem;
+      memcpy (pspecs, nqueue->pspecs, n_pspecs * sizeof (GParamSpec *));
     }
   g_datalist_id_set_data (&object->qdata, quark_notify_queue, NULL);
 
+  /* Dispatch the most recently queued pspec first */
+  for (i = 0; i < n_pspecs / 2; i++)
+    {
+      GParamSpec *tmp = pspecs[i];
+
+      pspecs[i] = pspecs[n_pspecs - 1 - i];
+      pspecs[n_pspecs - 1 - i] = tmp;
+    }
+
   object_bit_unlock (object, OPTIONAL_BIT_LOCK_NOTIFY);
 
   if (n_pspecs)
@@ -797,12 +826,36 @@ g_object_notify_queue_add (GObject            *object,
 
   g_assert (nqueue->n_pspecs < 65535);
 
-  if (g_slist_find (nqueue->pspecs, pspec) == NULL)
+  if ((nqueue->pspecs_mask & NOTIFY_QUEUE_PSPEC_BIT (pspec)) != 0)
     {
-      nqueue->pspecs = g_slist_prepend (nqueue->pspecs, pspec);
-      nqueue->n_pspecs++;
+      guint i;
+
+      for (i = 0; i < nqueue->n_pspecs; i++)
+        if (nqueue->pspecs[i] == pspec)
+          {
+            object_bit_unlock (object, OPTIONAL_BIT_LOCK_NOTIFY);
+            return TRUE;
+          }
+    }
+
+  if (G_UNLIKELY (nqueue->n_pspecs == nqueue->n_pspecs_allocated))
+    {
+      guint n_allocated = MIN (nqueue->n_pspecs_allocated * 2u, 65535u);
+
+      if (nqueue->pspecs == nqueue->pspecs_inline)
+        {
+          nqueue->pspecs = g_new (GParamSpec *, n_allocated);
+          memcpy (nqueue->pspecs, nqueue->pspecs_inline,
+                  sizeof (nqueue->pspecs_inline));
+        }
+      else
+        nqueue->pspecs = g_renew (GParamSpec *, nqueue->pspecs, n_allocated);
+      nqueue->n_pspecs_allocated = n_allocated;
     }
 
+  nqueue->pspecs[nqueue->n_pspecs++] = pspec;
+  nqueue->pspecs_mask |= NOTIFY_QUEUE_PSPEC_BIT (pspec);
+
   object_bit_unlock (object, OPTIONAL_BIT_LOCK_NOTIFY);
 
   return TRUE;
@@ -948,6 +1001,7 @@ g_object_base_class_init (GObjectClass *class)
   class->set_property = NULL;
   class->pspecs = NULL;
   class->n_pspecs = 0;
+  class->pspec_index = NULL;
 }
 
 static void
@@ -960,6 +1014,7 @@ g_object_base_class_finalize (GObjectClass *class)
   g_slist_free (class->construct_properties);
   class->construct_properties = NULL;
   class->n_construct_properties = 0;
+  g_clear_pointer ((GHashTable **) &class->pspec_index, g_hash_table_unref);
   list = g_param_spec_pool_list_owned (pspec_pool, G_OBJECT_CLASS_TYPE (class));
   for (node = list; node; node = node->next)
     {
@@ -1085,6 +1140,69 @@ validate_pspec_to_install (GParamSpec *pspec)
 }
 
 /* Sinks @pspec if it’s a floating ref. */
+/* The index of all properties of a class by name, the way
+ * g_param_spec_pool_lookup() finds them when walking the ancestors, is
+ * built on the first lookup by name and published atomically, so that
+ * lookups afterwards don't need the pool lock. Installing properties
+ * later drops it, which is no less thread-safe than installing them
+ * after class_init is to begin with. */
+static GHashTable *
+class_build_pspec_index (GObjectClass *class)
+{
+  GHashTable *index;
+  GType type;
+
+  index = g_hash_table_new (g_str_hash, g_str_equal);
+
+  for (type = G_OBJECT_CLASS_TYPE (class); type; type = g_type_parent (type))
+    {
+      GList *list, *node;
+
+      list = g_param_spec_pool_list_owned (pspec_pool, type);
+      for (node = list; node; node = node->next)
+        {
+          GParamSpec *pspec = node->data;
+
+          /* properties of derived types take precedence */
+          if (!g_hash_table_contains (index, pspec->name))
+            g_hash_table_insert (index, (gchar *) pspec->name, pspec);
+        }
+      g_list_free (list);
+    }
+
+  return index;
+}
+
+static inline GHashTable *
+class_get_pspec_index (GObjectClass *class)
+{
+  GHashTable *index;
+  gpointer old_index;
+
+  index = g_atomic_pointer_get (&class->pspec_index);
+  if (G_LIKELY (index))
+    return index;
+
+  index = class_build_pspec_index (class);
+  if (!g_atomic_pointer_compare_and_exchange_full (&class->pspec_index, NULL, index, &old_index))
+    {
+      g_hash_table_unref (index);
+      index = old_index;
+    }
+
+  return index;
+}
+
+static void
+class_invalidate_pspec_index (GObjectClass *class)
+{
+  GHashTable *index;
+
+  index = g_atomic_pointer_exchange (&class->pspec_index, NULL);
+  if (index)
+    g_hash_table_unref (index);
+}
+
 static gboolean
 validate_and_install_class_property (GObjectClass *class,
                                      GType         oclass_type,
@@ -1107,6 +1225,8 @@ validate_and_install_class_property (GObjectClass *class,
   class->flags |= CLASS_HAS_PROPS_FLAG;
   if (install_property_internal (oclass_type, property_id, pspec))
     {
+      class_invalidate_pspec_index (class);
+
       if (pspec->flags & (G_PARAM_CONSTRUCT | G_PARAM_CONSTRUCT_ONLY))
         {
           class->construct_properties = g_slist_append (class->construct_properties, pspec);
@@ -1184,14 +1304,15 @@ compare_pspec_entry (const void *a,
   return ae->name < be->name ? -1 : (ae->name > be->name ? 1 : 0);
 }
 
-/* This uses pointer comparisons with @property_name, so
- * will only work with string literals. */
+/* This first tries pointer comparisons with @property_name, which
+ * only work with string literals, then the class' property index. */
 static inline GParamSpec *
 find_pspec (GObjectClass *class,
             const char   *property_name)
 {
   const PspecEntry *pspecs = (const PspecEntry *)class->pspecs;
   gsize n_pspecs = class->n_pspecs;
+  GParamSpec *pspec;
 
   g_assert (n_pspecs <= G_MAXSSIZE);
 
@@ -1200,7 +1321,7 @@ find_pspec (GObjectClass *class,
    *
    * Both searches use pointer comparisons against @property_name.
    * If this function is called with a non-static @property_name,
-   * it will fall through to the g_param_spec_pool_lookup() case.
+   * it will fall through to the class_get_pspec_index() case.
    * That’s OK; this is an opportunistic optimisation which relies
    * on the fact that *most* (but not all) property lookups use
    * static property names.
@@ -1232,6 +1353,11 @@ find_pspec (GObjectClass *class,
         }
     }
 
+  pspec = g_hash_table_lookup (class_get_pspec_index (class), property_name);
+  if (pspec)
+    return pspec;
+
+  /* non-canonical or type-prefixed names */
   return g_param_spec_pool_lookup (pspec_pool,
                                    property_name,
                                    ((GTypeClass *)class)->g_type,
@@ -1960,10 +2086,7 @@ g_object_notify (GObject     *object,
    * (by, e.g. calling g_object_class_find_property())
    * because g_object_notify_queue_add() does that
    */
-  pspec = g_param_spec_pool_lookup (pspec_pool,
-				    property_name,
-				    G_OBJECT_TYPE (object),
-				    TRUE);
+  pspec = find_pspec (G_OBJECT_GET_CLASS (object), property_name);
 
   if (!pspec)
     g_critical ("%s: object class '%s' has no property named '%s'",
@@ -2591,10 +2714,14 @@ g_object_new_with_custom_constructor (GObjectClass          *class,
   return object;
 }
 
+/* @construct_map, if given, holds for each of the class' construct
+ * properties the index of its value in @params, or -1 for the default,
+ * as precomputed by g_object_class_prepare_new(). */
 static gpointer
 g_object_new_internal (GObjectClass          *class,
                        GObjectConstructParam *params,
-                       guint                  n_params)
+                       guint                  n_params,
+                       const gint            *construct_map)
 {
   GObjectNotifyQueue *nqueue = NULL;
   GObject *object;
@@ -2627,7 +2754,7 @@ g_object_new_internal (GObjectClass          *class,
        * properties, but they may come from either the class default
        * values or the passed-in parameter list.
        */
-      for (node = class->construct_properties; node; node = node->next)
+      for (node = class->construct_properties, i = 0; node; node = node->next, i++)
         {
           const GValue *value;
           GParamSpec *pspec;
@@ -2637,13 +2764,24 @@ g_object_new_internal (GObjectClass          *class,
           pspec = node->data;
           value = NULL; /* to silence gcc... */
 
-          for (j = 0; j < n_params; j++)
-            if (params[j].pspec == pspec)
-              {
-                value = params[j].value;
-                user_specified = TRUE;
-                break;
-              }
+          if (construct_map)
+            {
+              if (construct_map[i] >= 0)
+                {
+                  value = params[construct_map[i]].value;
+                  user_specified = TRUE;
+                }
+            }
+          else
+            {
+              for (j = 0; j < n_params; j++)
+                if (params[j].pspec == pspec)
+                  {
+                    value = params[j].value;
+                    user_specified = TRUE;
+                    break;
+                  }
+            }
 
           if (value == NULL)
             value = g_param_spec_get_default_value (pspec);
@@ -2763,10 +2901,10 @@ g_object_new_with_properties (GType          object_type,
           params[count].value = (GValue *) &values[i];
           count++;
         }
-      object = g_object_new_internal (class, params, count);
+      object = g_object_new_internal (class, params, count, NULL);
     }
   else
-    object = g_object_new_internal (class, NULL, 0);
+    object = g_object_new_internal (class, NULL, 0, NULL);
 
   if (unref_class != NULL)
     g_type_class_unref (unref_class);
@@ -2774,6 +2912,187 @@ g_object_new_with_properties (GType          object_type,
   return object;
 }
 
+/**
+ * GObjectNewPlan:
+ *
+ * An opaque, immutable description of how to create objects of a class
+ * with a given set of properties, see g_object_class_prepare_new().
+ *
+ * Since: 2.82
+ */
+struct _GObjectNewPlan
+{
+  gatomicrefcount ref_count;
+  GObjectClass *class;
+  guint n_properties;
+  guint n_params;
+  GParamSpec **pspecs;      /* (array length=n_params) */
+  guint *value_indices;     /* (array length=n_params), into the values */
+  gint *construct_map;      /* (array length=class->n_construct_properties) */
+};
+
+/**
+ * g_object_class_prepare_new:
+ * @oclass: (type GObject.ObjectClass): a #GObjectClass
+ * @n_properties: the number of properties
+ * @names: (array length=n_properties): the names of each property to be set
+ *
+ * Resolves the properties in @names for @oclass once, so that objects can
+ * be created repeatedly with g_object_new_prepared() without looking up
+ * and validating the properties, or matching them up with the construct
+ * properties of @oclass, on every call.
+ *
+ * Properties which would make g_object_new_with_properties() fail are
+ * reported here and skipped by g_object_new_prepared().
+ *
+ * The returned plan holds a reference on @oclass and can be used from any
+ * thread.
+ *
+ * Returns: (transfer full): a new #GObjectNewPlan, free with
+ *   g_object_new_plan_unref()
+ *
+ * Since: 2.82
+ */
+GObjectNewPlan *
+g_object_class_prepare_new (GObjectClass *oclass,
+                            guint         n_properties,
+                            const char   *names[])
+{
+  GObjectConstructParam *params;
+  GObjectNewPlan *plan;
+  GType object_type;
+  GSList *node;
+  guint i, j;
+
+  g_return_val_if_fail (G_IS_OBJECT_CLASS (oclass), NULL);
+  g_return_val_if_fail (n_properties == 0 || names != NULL, NULL);
+
+  object_type = G_OBJECT_CLASS_TYPE (oclass);
+
+  plan = g_new0 (GObjectNewPlan, 1);
+  g_atomic_ref_count_init (&plan->ref_count);
+  plan->class = g_type_class_ref (object_type);
+  plan->n_properties = n_properties;
+  plan->pspecs = g_new (GParamSpec *, n_properties);
+  plan->value_indices = g_new (guint, n_properties);
+  plan->construct_map = g_new (gint, oclass->n_construct_properties);
+
+  /* g_object_new_is_valid_property() checks for duplicates in here */
+  params = g_newa0 (GObjectConstructParam, n_properties);
+
+  for (i = 0; i < n_properties; i++)
+    {
+      GParamSpec *pspec = g_object_class_find_property (oclass, names[i]);
+
+      if (!g_object_new_is_valid_property (object_type, pspec, names[i], params, plan->n_params))
+        continue;
+
+      params[plan->n_params].pspec = pspec;
+      plan->pspecs[plan->n_params] = pspec;
+      plan->value_indices[plan->n_params] = i;
+      plan->n_params++;
+    }
+
+  for (node = oclass->construct_properties, i = 0; node; node = node->next, i++)
+    {
+      plan->construct_map[i] = -1;
+
+      for (j = 0; j < plan->n_params; j++)
+        if (plan->pspecs[j] == node->data)
+          {
+            plan->construct_map[i] = j;
+            break;
+          }
+    }
+
+  return plan;
+}
+
+/**
+ * g_object_new_plan_ref:
+ * @plan: a #GObjectNewPlan
+ *
+ * Increases the reference count of @plan.
+ *
+ * Returns: (transfer full): @plan
+ *
+ * Since: 2.82
+ */
+GObjectNewPlan *
+g_object_new_plan_ref (GObjectNewPlan *plan)
+{
+  g_return_val_if_fail (plan != NULL, NULL);
+
+  g_atomic_ref_count_inc (&plan->ref_count);
+
+  return plan;
+}
+
+/**
+ * g_object_new_plan_unref:
+ * @plan: (transfer full): a #GObjectNewPlan
+ *
+ * Decreases the reference count of @plan, freeing it and dropping its
+ * reference on the class once it reaches zero.
+ *
+ * Since: 2.82
+ */
+void
+g_object_new_plan_unref (GObjectNewPlan *plan)
+{
+  g_return_if_fail (plan != NULL);
+
+  if (!g_atomic_ref_count_dec (&plan->ref_count))
+    return;
+
+  g_type_class_unref (plan->class);
+  g_free (plan->pspecs);
+  g_free (plan->value_indices);
+  g_free (plan->construct_map);
+  g_free (plan);
+}
+
+G_DEFINE_BOXED_TYPE (GObjectNewPlan, g_object_new_plan,
+                     g_object_new_plan_ref, g_object_new_plan_unref)
+
+/**
+ * g_object_new_prepared: (skip)
+ * @plan: a #GObjectNewPlan
+ * @values: (array): the values of each property named when creating @plan,
+ *   in the same order
+ *
+ * Creates a new instance of the class @plan was prepared for, like
+ * g_object_new_with_properties() with the names given to
+ * g_object_class_prepare_new() and @values.
+ *
+ * Returns: (type GObject.Object) (transfer full): a new instance of the
+ *   class of @plan
+ *
+ * Since: 2.82
+ */
+GObject *
+g_object_new_prepared (GObjectNewPlan *plan,
+                       const GValue    values[])
+{
+  GObjectConstructParam *params;
+  guint i;
+
+  g_return_val_if_fail (plan != NULL, NULL);
+  g_return_val_if_fail (plan->n_properties == 0 || values != NULL, NULL);
+
+  if (plan->n_params == 0)
+    return g_object_new_internal (plan->class, NULL, 0, plan->construct_map);
+
+  params = g_newa (GObjectConstructParam, plan->n_params);
+  for (i = 0; i < plan->n_params; i++)
+    {
+      params[i].pspec = plan->pspecs[i];
+      params[i].value = (GValue *) &values[plan->value_indices[i]];
+    }
+
+  return g_object_new_internal (plan->class, params, plan->n_params, plan->construct_map);
+}
+
 /**
  * g_object_newv:
  * @object_type: the type id of the #GObject subtype to instantiate
@@ -2831,11 +3150,11 @@ g_object_newv (GType       object_type,
           j++;
         }
 
-      object = g_object_new_internal (class, cparams, j);
+      object = g_object_new_internal (class, cparams, j, NULL);
     }
   else
     /* Fast case: no properties passed in. */
-    object = g_object_new_internal (class, NULL, 0);
+    object = g_object_new_internal (class, NULL, 0, NULL);
 
   if (unref_class)
     g_type_class_unref (unref_class);
@@ -2942,7 +3261,7 @@ g_object_new_valist (GType        object_type,
         }
       while ((name = va_arg (var_args, const gchar *)));
 
-      object = g_object_new_internal (class, params, n_params);
+      object = g_object_new_internal (class, params, n_params, NULL);
 
       while (n_params--)
         {
@@ -2962,7 +3281,7 @@ g_object_new_valist (GType        object_type,
     }
   else
     /* Fast case: no properties passed in. */
-    object = g_object_new_internal (class, NULL, 0);
+    object = g_object_new_internal (class, NULL, 0, NULL);
 
   if (unref_class)
     g_type_class_unref (unref_class);
@@ -3089,6 +3408,68 @@ g_object_setv (GObject       *object,
   g_object_unref (object);
 }
 
+/**
+ * g_object_set_many_and_notify: (skip)
+ * @object: a #GObject
+ * @n_properties: the number of properties
+ * @pspecs: (array length=n_properties): the #GParamSpecs of the properties
+ *   to be set, as installed on the class of @object or its ancestors
+ * @values: (array length=n_properties): the values of each property to be set
+ *
+ * Sets @n_properties properties for an @object, like g_object_setv(), but
+ * taking the #GParamSpecs instead of the names of the properties, so that
+ * they don't have to be looked up.
+ *
+ * Change notifications for all of the properties are held back until all
+ * of them have been set, and then emitted once per changed property in a
+ * single call to #GObjectClass.dispatch_properties_changed.
+ *
+ * Since: 2.82
+ */
+void
+g_object_set_many_and_notify (GObject      *object,
+                              guint         n_properties,
+                              GParamSpec   *pspecs[],
+                              const GValue  values[])
+{
+  GObjectNotifyQueue *nqueue = NULL;
+  guint i;
+
+  g_return_if_fail (G_IS_OBJECT (object));
+  g_return_if_fail (n_properties == 0 || (pspecs != NULL && values != NULL));
+
+  if (n_properties == 0)
+    return;
+
+  g_object_ref (object);
+
+  if (_g_object_has_notify_handler (object))
+    nqueue = g_object_notify_queue_freeze (object);
+
+  for (i = 0; i < n_properties; i++)
+    {
+      GParamSpec *pspec = pspecs[i];
+
+      if (G_UNLIKELY (!G_IS_PARAM_SPEC (pspec) ||
+                      !g_type_is_a (G_OBJECT_TYPE (object), pspec->owner_type)))
+        {
+          g_critical ("%s: invalid property %u for object class '%s'",
+                      G_STRFUNC, i, G_OBJECT_TYPE_NAME (object));
+          break;
+        }
+
+      if (!g_object_set_is_valid_property (object, pspec, pspec->name))
+        break;
+
+      object_set_property (object, pspec, &values[i], nqueue, TRUE);
+    }
+
+  if (nqueue)
+    g_object_notify_queue_thaw (object, nqueue, FALSE);
+
+  g_object_unref (object);
+}
+
 /**
  * g_object_set_valist: (skip)
  * @object: a #GObject
@@ -3267,8 +3648,10 @@ g_object_get_valist (GObject	 *object,
       g_value_init (&value, pspec->value_type);
       
       object_get_property (object, pspec, &value);
-      
-      G_VALUE_LCOPY (&value, var_args, 0, &error);
+
+      /* The value is temporary, so hand its contents over to the caller
+       * rather than copying them */
+      _G_VALUE_LCOPY_TAKE (&value, var_args, &error);
       if (error)
 	{
 	  g_critical ("%s: %s", G_STRFUNC, error);
@@ -3383,6 +3766,25 @@ g_object_set_property (GObject	    *object,
   g_object_setv (object, 1, &property_name, value);
 }
 
+/*< private >
+ * _g_object_get_property_by_pspec:
+ * @object: a #GObject
+ * @pspec: a readable property of @object, as returned by
+ *   g_object_class_find_property()
+ * @value: a #GValue initialized to the value type of @pspec
+ *
+ * Gets a property like g_object_get_property(), without looking up the
+ * property by name or converting @value. The caller must hold a
+ * reference on @object.
+ */
+void
+_g_object_get_property_by_pspec (GObject    *object,
+                                 GParamSpec *pspec,
+                                 GValue     *value)
+{
+  object_get_property (object, pspec, value);
+}
+
 /**
  * g_object_get_property:
  * @object: a #GObject
@@ -5730,6 +6132,32 @@ g_weak_ref_get (GWeakRef *weak_ref)
    * But first we must get a reference to the @wrdata.
    */
   _weak_ref_lock (weak_ref, &object);
+
+  if (object)
+    {
+      gint old_ref = g_atomic_int_get (&object->ref_count);
+
+      /* Fast path: while we hold the lock on @weak_ref, @object cannot be
+       * cleared from it, so it is still alive. With at least two references,
+       * it also cannot be in _object_unref_clear_weak_locations(), which
+       * only clears the weak locations at a ref count of 1 while holding the
+       * @wrdata lock, and a strong reference can only be taken from 1 by the
+       * owner of the last reference, or by the slow path below with that lock
+       * held. So just like in object_ref(), when we manage to increment a ref
+       * count of at least 2, no toggle notification is due and we are done,
+       * without touching the per-object @wrdata at all. */
+      while (old_ref > 1 && old_ref < G_MAXINT)
+        {
+          if (g_atomic_int_compare_and_exchange_full ((int *) &object->ref_count,
+                                                      old_ref, old_ref + 1, &old_ref))
+            {
+              _weak_ref_unlock (weak_ref);
+              TRACE (GOBJECT_OBJECT_REF (object, G_TYPE_FROM_INSTANCE (object), old_ref));
+              return object;
+            }
+        }
+    }
+
   wrdata = object
                ? weak_ref_data_ref (weak_ref_data_get (object))
                : NULL;
@@ -142,6 +142,14 @@ G_BEGIN_DECLS
  * The type for #GInitiallyUnowned.
  */
 #define G_TYPE_INITIALLY_UNOWNED	      (g_initially_unowned_get_type())
+/**
+ * G_TYPE_OBJECT_NEW_PLAN:
+ *
+ * The type for #GObjectNewPlan.
+ *
+ * Since: 2.82
+ */
+#define G_TYPE_OBJECT_NEW_PLAN	      (g_object_new_plan_get_type())
 /**
  * G_INITIALLY_UNOWNED:
  * @object: Object which is subject to casting.
@@ -194,6 +202,7 @@ typedef struct _GObjectClass             GObjectClass;
 typedef struct _GObject                  GInitiallyUnowned;
 typedef struct _GObjectClass             GInitiallyUnownedClass;
 typedef struct _GObjectConstructParam    GObjectConstructParam;
+typedef struct _GObjectNewPlan           GObjectNewPlan;
 /**
  * GObjectGetPropertyFunc:
  * @object: a #GObject
@@ -361,8 +370,10 @@ struct  _GObjectClass
   gpointer pspecs;
   gsize n_pspecs;
 
+  gpointer pspec_index;
+
   /* padding */
-  gpointer	pdummy[3];
+  gpointer	pdummy[2];
 };
 
 /**
@@ -437,6 +448,19 @@ GObject*    g_object_new_with_properties      (GType           object_type,
                                                guint           n_properties,
                                                const char     *names[],
                                                const GValue    values[]);
+GOBJECT_AVAILABLE_IN_2_82
+GType       g_object_new_plan_get_type        (void) G_GNUC_CONST;
+GOBJECT_AVAILABLE_IN_2_82
+GObjectNewPlan *g_object_class_prepare_new    (GObjectClass   *oclass,
+                                               guint           n_properties,
+                                               const char     *names[]);
+GOBJECT_AVAILABLE_IN_2_82
+GObjectNewPlan *g_object_new_plan_ref         (GObjectNewPlan *plan);
+GOBJECT_AVAILABLE_IN_2_82
+void        g_object_new_plan_unref           (GObjectNewPlan *plan);
+GOBJECT_AVAILABLE_IN_2_82
+GObject*    g_object_new_prepared             (GObjectNewPlan *plan,
+                                               const GValue    values[]);
 
 G_GNUC_BEGIN_IGNORE_DEPRECATIONS
 
@@ -472,6 +496,11 @@ void        g_object_setv                     (GObject        *object,
                                                guint           n_properties,
                                                const gchar    *names[],
                                                const GValue    values[]);
+GOBJECT_AVAILABLE_IN_2_82
+void        g_object_set_many_and_notify      (GObject        *object,
+                                               guint           n_properties,
+                                               GParamSpec     *pspecs[],
+                                               const GValue    values[]);
 GOBJECT_AVAILABLE_IN_ALL
 void        g_object_set_valist               (GObject        *object,
 					       const gchar    *first_property_name,
@@ -29,6 +29,7 @@
 #include "gparamspecs.h"
 #include "gvaluecollector.h"
 #include "gtype-private.h"
+#include "glib-private.h"
 
 /**
  * GParamSpec: (ref-func g_param_spec_ref_sink) (unref-func g_param_spec_unref) (set-value-func g_value_set_param) (get-value-func g_value_get_param)
@@ -943,11 +944,16 @@ value_param_lcopy_value (const GValue *value,
  */
 struct _GParamSpecPool
 {
-  GMutex       mutex;
+  GBigRWLock   lock;  /* lookups are much more common than changes */
   gboolean     type_prefixing;
   GHashTable  *hash_table;
 };
 
+#define POOL_READ_LOCK(pool)    GLIB_PRIVATE_CALL (g_big_rw_lock_reader_lock) (&(pool)->lock)
+#define POOL_READ_UNLOCK(pool)  GLIB_PRIVATE_CALL (g_big_rw_lock_reader_unlock) (&(pool)->lock)
+#define POOL_WRITE_LOCK(pool)   GLIB_PRIVATE_CALL (g_big_rw_lock_writer_lock) (&(pool)->lock)
+#define POOL_WRITE_UNLOCK(pool) GLIB_PRIVATE_CALL (g_big_rw_lock_writer_unlock) (&(pool)->lock)
+
 static guint
 param_spec_pool_hash (gconstpointer key_spec)
 {
@@ -989,10 +995,9 @@ param_spec_pool_equals (gconstpointer key_spec_1,
 GParamSpecPool*
 g_param_spec_pool_new (gboolean type_prefixing)
 {
-  static GMutex init_mutex;
   GParamSpecPool *pool = g_new (GParamSpecPool, 1);
 
-  memcpy (&pool->mutex, &init_mutex, sizeof (init_mutex));
+  GLIB_PRIVATE_CALL (g_big_rw_lock_init) (&pool->lock);
   pool->type_prefixing = type_prefixing != FALSE;
   pool->hash_table = g_hash_table_new_full (param_spec_pool_hash,
                                             param_spec_pool_equals,
@@ -1013,10 +1018,10 @@ g_param_spec_pool_new (gboolean type_prefixing)
 void
 g_param_spec_pool_free (GParamSpecPool *pool)
 {
-  g_mutex_lock (&pool->mutex);
+  POOL_WRITE_LOCK (pool);
   g_hash_table_unref (pool->hash_table);
-  g_mutex_unlock (&pool->mutex);
-  g_mutex_clear (&pool->mutex);
+  POOL_WRITE_UNLOCK (pool);
+  GLIB_PRIVATE_CALL (g_big_rw_lock_clear) (&pool->lock);
   g_free (pool);
 }
 
@@ -1045,11 +1050,11 @@ g_param_spec_pool_insert (GParamSpecPool *pool,
 	      return;
 	    }
 	}
-      g_mutex_lock (&pool->mutex);
+      POOL_WRITE_LOCK (pool);
       pspec->owner_type = owner_type;
       g_param_spec_ref (pspec);
       g_hash_table_add (pool->hash_table, pspec);
-      g_mutex_unlock (&pool->mutex);
+      POOL_WRITE_UNLOCK (pool);
     }
   else
     {
@@ -1073,10 +1078,10 @@ g_param_spec_pool_remove (GParamSpecPool *pool,
 {
   if (pool && pspec)
     {
-      g_mutex_lock (&pool->mutex);
+      POOL_WRITE_LOCK (pool);
       if (!g_hash_table_remove (pool->hash_table, pspec))
 	g_critical (G_STRLOC ": attempt to remove unknown pspec '%s' from pool", pspec->name);
-      g_mutex_unlock (&pool->mutex);
+      POOL_WRITE_UNLOCK (pool);
     }
   else
     {
@@ -1163,13 +1168,13 @@ g_param_spec_pool_lookup (GParamSpecPool *pool,
   g_return_val_if_fail (pool != NULL, NULL);
   g_return_val_if_fail (param_name != NULL, NULL);
 
-  g_mutex_lock (&pool->mutex);
+  POOL_READ_LOCK (pool);
 
   /* try quick and away, i.e. without prefix */
   pspec = param_spec_ht_lookup (pool->hash_table, param_name, owner_type, walk_ancestors);
   if (pspec)
     {
-      g_mutex_unlock (&pool->mutex);
+      POOL_READ_UNLOCK (pool);
       return pspec;
     }
 
@@ -1196,14 +1201,14 @@ g_param_spec_pool_lookup (GParamSpecPool *pool,
               /* sanity check, these cases don't make a whole lot of sense */
               if ((!walk_ancestors && type != owner_type) || !g_type_is_a (owner_type, type))
                 {
-                  g_mutex_unlock (&pool->mutex);
+                  POOL_READ_UNLOCK (pool);
 
                   return NULL;
                 }
               owner_type = type;
               param_name += l + 2;
               pspec = param_spec_ht_lookup (pool->hash_table, param_name, owner_type, walk_ancestors);
-              g_mutex_unlock (&pool->mutex);
+              POOL_READ_UNLOCK (pool);
 
               return pspec;
             }
@@ -1212,7 +1217,7 @@ g_param_spec_pool_lookup (GParamSpecPool *pool,
 
   /* malformed param_name */
 
-  g_mutex_unlock (&pool->mutex);
+  POOL_READ_UNLOCK (pool);
 
   return NULL;
 }
@@ -1251,11 +1256,11 @@ g_param_spec_pool_list_owned (GParamSpecPool *pool,
   g_return_val_if_fail (pool != NULL, NULL);
   g_return_val_if_fail (owner_type > 0, NULL);
   
-  g_mutex_lock (&pool->mutex);
+  POOL_READ_LOCK (pool);
   data[0] = NULL;
   data[1] = GTYPE_TO_POINTER (owner_type);
   g_hash_table_foreach (pool->hash_table, pool_list, &data);
-  g_mutex_unlock (&pool->mutex);
+  POOL_READ_UNLOCK (pool);
 
   return data[0];
 }
@@ -1388,7 +1393,7 @@ g_param_spec_pool_list (GParamSpecPool *pool,
   g_return_val_if_fail (owner_type > 0, NULL);
   g_return_val_if_fail (n_pspecs_p != NULL, NULL);
   
-  g_mutex_lock (&pool->mutex);
+  POOL_READ_LOCK (pool);
   d = g_type_depth (owner_type);
   slists = g_new0 (GSList*, d);
   data[0] = slists;
@@ -1413,7 +1418,7 @@ g_param_spec_pool_list (GParamSpecPool *pool,
     }
   *p++ = NULL;
   g_free (slists);
-  g_mutex_unlock (&pool->mutex);
+  POOL_READ_UNLOCK (pool);
 
   *n_pspecs_p = n_pspecs;
 
@@ -36,6 +36,7 @@
 #include "gvaluetypes.h"
 #include "gobject.h"
 #include "genums.h"
+#include "gmarshal-internal.h"
 #include "gobject_trace.h"
 
 
@@ -154,9 +155,15 @@ struct _SignalNode
   GHookList         *emission_hooks;
 
   GClosure *single_va_closure;
+
+  /* A copy of flags with SKIP_UNHANDLED_EMISSION set while an emission
+   * on an instance without handlers is known to do nothing, so
+   * g_signal_emit() can return without taking the signal lock */
+  gint               unhandled_emission_flags; /* (atomic) */
 };
 
 #define	SINGLE_VA_CLOSURE_EMPTY_MAGIC GINT_TO_POINTER(1)	/* indicates single_va_closure is valid but empty */
+#define SKIP_UNHANDLED_EMISSION (G_SIGNAL_FLAGS_MASK + 1)
 
 struct _SignalKey
 {
@@ -229,6 +236,7 @@ static GBSearchConfig g_class_closure_bconfig = {
   0,
 };
 static GHashTable    *g_handler_list_bsa_ht = NULL;
+static GQuark         quark_handler_list = 0;
 static Emission      *g_emissions = NULL;
 static gulong         g_handler_sequential_number = 1;
 static GHashTable    *g_handlers = NULL;
@@ -239,8 +247,10 @@ G_LOCK_DEFINE_STATIC (g_signal_mutex);
 
 
 /* --- signal nodes --- */
-static guint          g_n_signal_nodes = 0;
-static SignalNode   **g_signal_nodes = NULL;
+static guint          g_n_signal_nodes = 0;        /* (atomic) */
+static SignalNode   **g_signal_nodes = NULL;       /* (atomic) */
+static guint          g_n_signal_nodes_alloced = 0;
+static GSList        *g_signal_nodes_retired = NULL;
 
 static inline SignalNode*
 LOOKUP_SIGNAL_NODE (guint signal_id)
@@ -251,6 +261,45 @@ LOOKUP_SIGNAL_NODE (guint signal_id)
     return NULL;
 }
 
+/* Like LOOKUP_SIGNAL_NODE(), but may be called without holding the
+ * signal lock. Only the node's permanent portion and
+ * unhandled_emission_flags may be accessed then. */
+static inline SignalNode*
+lookup_signal_node_lockless (guint signal_id)
+{
+  if (signal_id < (guint) g_atomic_int_get (&g_n_signal_nodes))
+    return ((SignalNode **) g_atomic_pointer_get (&g_signal_nodes))[signal_id];
+  else
+    return NULL;
+}
+
+static guint
+signal_nodes_append (SignalNode *node)
+{
+  guint signal_id = g_n_signal_nodes;
+
+  if (signal_id >= g_n_signal_nodes_alloced)
+    {
+      SignalNode **nodes;
+
+      g_n_signal_nodes_alloced = MAX (32, g_n_signal_nodes_alloced * 2);
+      nodes = g_new (SignalNode*, g_n_signal_nodes_alloced);
+      if (signal_id > 0)
+        memcpy (nodes, g_signal_nodes, signal_id * sizeof (SignalNode*));
+
+      /* lockless readers may still be looking at the old array, so it
+       * can't be freed; growing geometrically bounds what is kept around */
+      if (g_signal_nodes)
+        g_signal_nodes_retired = g_slist_prepend (g_signal_nodes_retired, g_signal_nodes);
+      g_atomic_pointer_set (&g_signal_nodes, nodes);
+    }
+
+  g_signal_nodes[signal_id] = node;
+  g_atomic_int_set (&g_n_signal_nodes, signal_id + 1);
+
+  return signal_id;
+}
+
 
 /* --- functions --- */
 /* @key must have already been validated with is_valid()
@@ -380,11 +429,37 @@ handler_lists_cmp (gconstpointer node1,
   return G_BSEARCH_ARRAY_CMP (hlist1->signal_id, hlist2->signal_id);
 }
 
+/* The handler lists of a GObject are kept in its qdata, so finding them
+ * only touches the object itself rather than a global hash table holding
+ * every instance that has handlers. Other instance types have no qdata
+ * and use g_handler_list_bsa_ht. */
+static inline GBSearchArray*
+handler_list_bsa_get (gpointer instance)
+{
+  if (G_IS_OBJECT (instance))
+    return g_datalist_id_get_data (&((GObject *) instance)->qdata, quark_handler_list);
+  else
+    return g_hash_table_lookup (g_handler_list_bsa_ht, instance);
+}
+
+static inline void
+handler_list_bsa_set (gpointer       instance,
+                      GBSearchArray *hlbsa)
+{
+  if (G_IS_OBJECT (instance))
+    g_datalist_id_set_data (&((GObject *) instance)->qdata, quark_handler_list, hlbsa);
+  else if (hlbsa)
+    g_hash_table_insert (g_handler_list_bsa_ht, instance, hlbsa);
+  else
+    g_hash_table_remove (g_handler_list_bsa_ht, instance);
+}
+
 static inline HandlerList*
 handler_list_ensure (guint    signal_id,
 		     gpointer instance)
 {
-  GBSearchArray *hlbsa = g_hash_table_lookup (g_handler_list_bsa_ht, instance);
+  GBSearchArray *hlbsa = handler_list_bsa_get (instance);
+  GBSearchArray *old_hlbsa = hlbsa;
   HandlerList key;
   
   key.signal_id = signal_id;
@@ -396,7 +471,8 @@ handler_list_ensure (guint    signal_id,
       hlbsa = g_bsearch_array_create (&g_signal_hlbsa_bconfig);
     }
   hlbsa = g_bsearch_array_insert (hlbsa, &g_signal_hlbsa_bconfig, &key);
-  g_hash_table_insert (g_handler_list_bsa_ht, instance, hlbsa);
+  if (hlbsa != old_hlbsa)
+    handler_list_bsa_set (instance, hlbsa);
   return g_bsearch_array_lookup (hlbsa, &g_signal_hlbsa_bconfig, &key);
 }
 
@@ -404,7 +480,7 @@ static inline HandlerList*
 handler_list_lookup (guint    signal_id,
 		     gpointer instance)
 {
-  GBSearchArray *hlbsa = g_hash_table_lookup (g_handler_list_bsa_ht, instance);
+  GBSearchArray *hlbsa = handler_list_bsa_get (instance);
   HandlerList key;
   
   key.signal_id = signal_id;
@@ -444,7 +520,7 @@ handler_lookup (gpointer  instance,
 
     }
 
-  hlbsa = g_hash_table_lookup (g_handler_list_bsa_ht, instance);
+  hlbsa = handler_list_bsa_get (instance);
   
   if (hlbsa)
     {
@@ -539,7 +615,7 @@ handlers_find (gpointer         instance,
     }
   else
     {
-      GBSearchArray *hlbsa = g_hash_table_lookup (g_handler_list_bsa_ht, instance);
+      GBSearchArray *hlbsa = handler_list_bsa_get (instance);
       
       mask = ~mask;
       if (hlbsa)
@@ -717,6 +793,13 @@ handler_insert (guint    signal_id,
     hlist->tail_after = handler;
 }
 
+static inline void
+node_invalidate_single_va_closure (SignalNode *node)
+{
+  node->single_va_closure_is_valid = FALSE;
+  g_atomic_int_set (&node->unhandled_emission_flags, 0);
+}
+
 static void
 node_update_single_va_closure (SignalNode *node)
 {
@@ -756,6 +839,13 @@ node_update_single_va_closure (SignalNode *node)
   node->single_va_closure_is_valid = TRUE;
   node->single_va_closure = closure;
   node->single_va_closure_is_after = is_after;
+
+  /* With neither a class closure nor emission hooks nor a return value
+   * to reset, only instance handlers can make an emission do anything */
+  if (closure == SINGLE_VA_CLOSURE_EMPTY_MAGIC &&
+      node->return_type == G_TYPE_NONE)
+    g_atomic_int_set (&node->unhandled_emission_flags,
+                      node->flags | SKIP_UNHANDLED_EMISSION);
 }
 
 static inline void
@@ -829,12 +919,11 @@ _g_signal_init (void)
     {
       /* setup handler list binary searchable array hash table (in german, that'd be one word ;) */
       g_handler_list_bsa_ht = g_hash_table_new (g_direct_hash, NULL);
+      quark_handler_list = g_quark_from_static_string ("GSignal-handler-list");
       g_signal_key_bsa = g_bsearch_array_create (&g_signal_key_bconfig);
       
       /* invalid (0) signal_id */
-      g_n_signal_nodes = 1;
-      g_signal_nodes = g_renew (SignalNode*, g_signal_nodes, g_n_signal_nodes);
-      g_signal_nodes[0] = NULL;
+      signal_nodes_append (NULL);
       g_handlers = g_hash_table_new (handler_hash, handler_equal);
     }
   SIGNAL_UNLOCK ();
@@ -980,7 +1069,7 @@ g_signal_add_emission_hook (guint               signal_id,
       SIGNAL_UNLOCK ();
       return 0;
     }
-    node->single_va_closure_is_valid = FALSE;
+    node_invalidate_single_va_closure (node);
   if (!node->emission_hooks)
     {
       node->emission_hooks = g_new (GHookList, 1);
@@ -1032,7 +1121,7 @@ g_signal_remove_emission_hook (guint  signal_id,
   else if (!node->emission_hooks || !g_hook_destroy (node->emission_hooks, hook_id))
     g_critical ("%s: signal \"%s\" had no hook (%lu) to remove", G_STRLOC, node->name, hook_id);
 
-  node->single_va_closure_is_valid = FALSE;
+  node_invalidate_single_va_closure (node);
 
  out:
   SIGNAL_UNLOCK ();
@@ -1544,7 +1633,7 @@ signal_add_class_closure (SignalNode *node,
 {
   ClassClosure key;
 
-  node->single_va_closure_is_valid = FALSE;
+  node_invalidate_single_va_closure (node);
 
   if (!node->class_closure_bsa)
     node->class_closure_bsa = g_bsearch_array_create (&g_class_closure_bconfig);
@@ -1562,6 +1651,81 @@ signal_add_class_closure (SignalNode *node,
     }
 }
 
+/* Marshallers used for signals created without one, in place of the
+ * libffi based generic marshallers; types are matched by their
+ * fundamental type. Single argument signals without return value are
+ * handled in g_signal_newv() directly. */
+typedef struct
+{
+  GType                return_type;
+  guint                n_params;
+  GType                param_types[3];
+  GSignalCMarshaller   c_marshaller;
+  GSignalCVaMarshaller va_marshaller;
+} BuiltinMarshaller;
+
+#define BUILTIN_MARSHALLER(marshaller) marshaller, marshaller ## v
+
+static const BuiltinMarshaller builtin_marshallers[] = {
+  { G_TYPE_BOOLEAN, 0, { 0, }, BUILTIN_MARSHALLER (_g_signal_marshal_BOOLEAN__VOID) },
+  { G_TYPE_BOOLEAN, 1, { G_TYPE_BOXED }, BUILTIN_MARSHALLER (_g_signal_marshal_BOOLEAN__BOXED) },
+  { G_TYPE_BOOLEAN, 1, { G_TYPE_FLAGS }, BUILTIN_MARSHALLER (g_cclosure_marshal_BOOLEAN__FLAGS) },
+  { G_TYPE_BOOLEAN, 1, { G_TYPE_INT }, BUILTIN_MARSHALLER (_g_signal_marshal_BOOLEAN__INT) },
+  { G_TYPE_BOOLEAN, 1, { G_TYPE_OBJECT }, BUILTIN_MARSHALLER (_g_signal_marshal_BOOLEAN__OBJECT) },
+  { G_TYPE_BOOLEAN, 1, { G_TYPE_POINTER }, BUILTIN_MARSHALLER (_g_signal_marshal_BOOLEAN__POINTER) },
+  { G_TYPE_BOOLEAN, 1, { G_TYPE_STRING }, BUILTIN_MARSHALLER (_g_signal_marshal_BOOLEAN__STRING) },
+  { G_TYPE_BOOLEAN, 1, { G_TYPE_UINT }, BUILTIN_MARSHALLER (_g_signal_marshal_BOOLEAN__UINT) },
+  { G_TYPE_BOOLEAN, 2, { G_TYPE_BOXED, G_TYPE_BOXED }, BUILTIN_MARSHALLER (g_cclosure_marshal_BOOLEAN__BOXED_BOXED) },
+  { G_TYPE_STRING, 2, { G_TYPE_OBJECT, G_TYPE_POINTER }, BUILTIN_MARSHALLER (g_cclosure_marshal_STRING__OBJECT_POINTER) },
+  { G_TYPE_NONE, 2, { G_TYPE_BOOLEAN, G_TYPE_BOOLEAN }, BUILTIN_MARSHALLER (_g_signal_marshal_VOID__BOOLEAN_BOOLEAN) },
+  { G_TYPE_NONE, 2, { G_TYPE_BOXED, G_TYPE_BOXED }, BUILTIN_MARSHALLER (_g_signal_marshal_VOID__BOXED_BOXED) },
+  { G_TYPE_NONE, 2, { G_TYPE_DOUBLE, G_TYPE_DOUBLE }, BUILTIN_MARSHALLER (_g_signal_marshal_VOID__DOUBLE_DOUBLE) },
+  { G_TYPE_NONE, 2, { G_TYPE_INT, G_TYPE_INT }, BUILTIN_MARSHALLER (_g_signal_marshal_VOID__INT_INT) },
+  { G_TYPE_NONE, 2, { G_TYPE_OBJECT, G_TYPE_OBJECT }, BUILTIN_MARSHALLER (_g_signal_marshal_VOID__OBJECT_OBJECT) },
+  { G_TYPE_NONE, 2, { G_TYPE_OBJECT, G_TYPE_POINTER }, BUILTIN_MARSHALLER (_g_signal_marshal_VOID__OBJECT_POINTER) },
+  { G_TYPE_NONE, 2, { G_TYPE_OBJECT, G_TYPE_STRING }, BUILTIN_MARSHALLER (_g_signal_marshal_VOID__OBJECT_STRING) },
+  { G_TYPE_NONE, 2, { G_TYPE_OBJECT, G_TYPE_UINT }, BUILTIN_MARSHALLER (_g_signal_marshal_VOID__OBJECT_UINT) },
+  { G_TYPE_NONE, 2, { G_TYPE_POINTER, G_TYPE_POINTER }, BUILTIN_MARSHALLER (_g_signal_marshal_VOID__POINTER_POINTER) },
+  { G_TYPE_NONE, 2, { G_TYPE_STRING, G_TYPE_STRING }, BUILTIN_MARSHALLER (_g_signal_marshal_VOID__STRING_STRING) },
+  { G_TYPE_NONE, 2, { G_TYPE_UINT, G_TYPE_POINTER }, BUILTIN_MARSHALLER (g_cclosure_marshal_VOID__UINT_POINTER) },
+  { G_TYPE_NONE, 2, { G_TYPE_UINT, G_TYPE_UINT }, BUILTIN_MARSHALLER (_g_signal_marshal_VOID__UINT_UINT) },
+  { G_TYPE_NONE, 3, { G_TYPE_INT, G_TYPE_INT, G_TYPE_INT }, BUILTIN_MARSHALLER (_g_signal_marshal_VOID__INT_INT_INT) },
+  { G_TYPE_NONE, 3, { G_TYPE_UINT, G_TYPE_UINT, G_TYPE_UINT }, BUILTIN_MARSHALLER (_g_signal_marshal_VOID__UINT_UINT_UINT) },
+};
+
+#undef BUILTIN_MARSHALLER
+
+static const BuiltinMarshaller *
+builtin_marshaller_lookup (GType        return_type,
+                           guint        n_params,
+                           const GType *param_types)
+{
+  gsize i;
+  guint j;
+
+  if (n_params > G_N_ELEMENTS (builtin_marshallers[0].param_types))
+    return NULL;
+
+  return_type = G_TYPE_FUNDAMENTAL (return_type);
+
+  for (i = 0; i < G_N_ELEMENTS (builtin_marshallers); i++)
+    {
+      const BuiltinMarshaller *builtin = &builtin_marshallers[i];
+
+      if (builtin->return_type != return_type || builtin->n_params != n_params)
+        continue;
+
+      for (j = 0; j < n_params; j++)
+        if (G_TYPE_FUNDAMENTAL (param_types[j] & ~G_SIGNAL_TYPE_STATIC_SCOPE) != builtin->param_types[j])
+          break;
+
+      if (j == n_params)
+        return builtin;
+    }
+
+  return NULL;
+}
+
 /**
  * g_signal_newv:
  * @signal_name: the name for the signal
@@ -1682,12 +1846,11 @@ g_signal_newv (const gchar       *signal_name,
     {
       SignalKey key;
       
-      signal_id = g_n_signal_nodes++;
       node = g_new (SignalNode, 1);
-      node->signal_id = signal_id;
-      g_signal_nodes = g_renew (SignalNode*, g_signal_nodes, g_n_signal_nodes);
-      g_signal_nodes[signal_id] = node;
       node->itype = itype;
+      node->unhandled_emission_flags = 0;
+      signal_id = signal_nodes_append (node);
+      node->signal_id = signal_id;
       key.itype = itype;
       key.signal_id = signal_id;
       node->name = g_intern_string (name);
@@ -1699,7 +1862,7 @@ g_signal_newv (const gchar       *signal_name,
   node->destroyed = FALSE;
 
   /* setup reinitializable portion */
-  node->single_va_closure_is_valid = FALSE;
+  node_invalidate_single_va_closure (node);
   node->flags = signal_flags & G_SIGNAL_FLAGS_MASK;
   node->n_params = n_params;
   node->param_types = g_memdup2 (param_types, sizeof (GType) * n_params);
@@ -1753,6 +1916,18 @@ g_signal_newv (const gchar       *signal_name,
       ADD_CHECK (VARIANT)
     }
 
+  if (builtin_c_marshaller == NULL)
+    {
+      const BuiltinMarshaller *builtin;
+
+      builtin = builtin_marshaller_lookup (return_type, n_params, param_types);
+      if (builtin)
+        {
+          builtin_c_marshaller = builtin->c_marshaller;
+          builtin_va_marshaller = builtin->va_marshaller;
+        }
+    }
+
   if (c_marshaller == NULL)
     {
       if (builtin_c_marshaller)
@@ -1817,7 +1992,7 @@ g_signal_set_va_marshaller (guint              signal_id,
 	    _g_closure_set_va_marshal (cc->closure, va_marshaller);
 	}
 
-      node->single_va_closure_is_valid = FALSE;
+      node_invalidate_single_va_closure (node);
     }
 
   SIGNAL_UNLOCK ();
@@ -1901,7 +2076,7 @@ signal_destroy_R (SignalNode *signal_node)
   signal_node->destroyed = TRUE;
   
   /* reentrancy caution, zero out real contents first */
-  signal_node->single_va_closure_is_valid = FALSE;
+  node_invalidate_single_va_closure (signal_node);
   signal_node->n_params = 0;
   signal_node->param_types = NULL;
   signal_node->return_type = 0;
@@ -2162,6 +2337,7 @@ g_signal_chain_from_overridden_handler (gpointer instance,
 
   if (closure)
     {
+      GValueVector params;
       GValue *instance_and_params;
       GType signal_return_type;
       GValue *param_values;
@@ -2171,7 +2347,8 @@ g_signal_chain_from_overridden_handler (gpointer instance,
       va_start (var_args, instance);
 
       signal_return_type = node->return_type;
-      instance_and_params = g_newa0 (GValue, n_params + 1);
+      _g_value_vector_init (&params, n_params + 1);
+      instance_and_params = params.values;
       param_values = instance_and_params + 1;
 
       for (i = 0; i < node->n_params; i++)
@@ -2193,8 +2370,8 @@ g_signal_chain_from_overridden_handler (gpointer instance,
               /* we purposely leak the value here, it might not be
                * in a correct state if an error condition occurred
                */
-              while (i--)
-                g_value_unset (param_values + i);
+              memset (param_values + i, 0, sizeof (GValue));
+              _g_value_vector_clear (&params);
 
               va_end (var_args);
               return;
@@ -2232,10 +2409,10 @@ g_signal_chain_from_overridden_handler (gpointer instance,
                             instance_and_params,
                             &emission->ihint);
 
-          G_VALUE_LCOPY (&return_value,
-                         var_args,
-                         static_scope ? G_VALUE_NOCOPY_CONTENTS : 0,
-                         &error);
+          if (static_scope)
+            G_VALUE_LCOPY (&return_value, var_args, G_VALUE_NOCOPY_CONTENTS, &error);
+          else
+            _G_VALUE_LCOPY_TAKE (&return_value, var_args, &error);
           if (!error)
             {
               g_value_unset (&return_value);
@@ -2251,9 +2428,7 @@ g_signal_chain_from_overridden_handler (gpointer instance,
             }
         }
 
-      for (i = 0; i < n_params; i++)
-        g_value_unset (param_values + i);
-      g_value_unset (instance_and_params);
+      _g_value_vector_clear (&params);
 
       va_end (var_args);
 
@@ -2726,13 +2901,13 @@ g_signal_handlers_destroy (gpointer instance)
   g_return_if_fail (G_TYPE_CHECK_INSTANCE (instance));
   
   SIGNAL_LOCK ();
-  hlbsa = g_hash_table_lookup (g_handler_list_bsa_ht, instance);
+  hlbsa = handler_list_bsa_get (instance);
   if (hlbsa)
     {
       guint i;
       
       /* reentrancy caution, delete instance trace first */
-      g_hash_table_remove (g_handler_list_bsa_ht, instance);
+      handler_list_bsa_set (instance, NULL);
       
       for (i = 0; i < hlbsa->n_nodes; i++)
         {
@@ -3236,6 +3411,45 @@ signal_emit_valist_unlocked (gpointer instance,
                              GQuark   detail,
                              va_list  var_args);
 
+/*<private>
+ * signal_emission_is_noop:
+ * @instance: The instance to emit from
+ * @signal_id: Signal id to emit
+ * @detail: Signal detail
+ *
+ * Checks, without taking the signal mutex, whether emitting @signal_id
+ * on @instance would not run anything: the signal has no class closure,
+ * emission hooks or return value, and no handler was ever connected to
+ * the instance. A handler or hook being added concurrently is ordered
+ * after this emission.
+ *
+ * Invalid arguments are left for the locked path to complain about.
+ *
+ * Returns: %TRUE if the emission can be skipped
+ */
+static inline gboolean
+signal_emission_is_noop (gpointer instance,
+                         guint    signal_id,
+                         GQuark   detail)
+{
+  SignalNode *node;
+  gint flags;
+
+  node = lookup_signal_node_lockless (signal_id);
+  if (node == NULL)
+    return FALSE;
+
+  /* SKIP_UNHANDLED_EMISSION is only ever set for signals of object types */
+  flags = g_atomic_int_get (&node->unhandled_emission_flags);
+  if (!(flags & SKIP_UNHANDLED_EMISSION) ||
+      (detail && !(flags & G_SIGNAL_DETAILED)) ||
+      !G_TYPE_CHECK_INSTANCE (instance) ||
+      !g_type_is_a (G_TYPE_FROM_INSTANCE (instance), node->itype))
+    return FALSE;
+
+  return !_g_object_has_signal_handler ((GObject *) instance);
+}
+
 /**
  * g_signal_emit_valist: (skip)
  * @instance: (type GObject.TypeInstance): the instance the signal is being
@@ -3258,11 +3472,265 @@ g_signal_emit_valist (gpointer instance,
 		      GQuark   detail,
 		      va_list  var_args)
 {
+  if (signal_emission_is_noop (instance, signal_id, detail))
+    return;
+
   SIGNAL_LOCK ();
   if (signal_emit_valist_unlocked (instance, signal_id, detail, var_args))
     SIGNAL_UNLOCK ();
 }
 
+/* Collects the arguments of an emission of @node from a copy of
+ * @var_args into @instance_and_params, holding the instance and all
+ * parameters, as signal_emit_valist_unlocked() does. */
+static gboolean
+signal_collect_params (const SignalNode *node,
+                       gpointer          instance,
+                       va_list           var_args,
+                       GValueVector     *instance_and_params)
+{
+  GValue *param_values;
+  va_list args;
+  guint i;
+
+  _g_value_vector_init (instance_and_params, node->n_params + 1);
+  param_values = instance_and_params->values + 1;
+
+  G_VA_COPY (args, var_args);
+
+  for (i = 0; i < node->n_params; i++)
+    {
+      gchar *error;
+      GType ptype = node->param_types[i] & ~G_SIGNAL_TYPE_STATIC_SCOPE;
+      gboolean static_scope = node->param_types[i] & G_SIGNAL_TYPE_STATIC_SCOPE;
+
+      G_VALUE_COLLECT_INIT (param_values + i, ptype,
+			    args,
+			    static_scope ? G_VALUE_NOCOPY_CONTENTS : 0,
+			    &error);
+      if (error)
+	{
+	  g_critical ("%s: %s", G_STRLOC, error);
+	  g_free (error);
+
+	  /* we purposely leak the value here, it might not be
+	   * in a correct state if an error condition occurred
+	   */
+	  memset (param_values + i, 0, sizeof (GValue));
+	  _g_value_vector_clear (instance_and_params);
+	  va_end (args);
+
+          return FALSE;
+	}
+    }
+  va_end (args);
+
+  g_value_init_from_instance (instance_and_params->values, instance);
+
+  return TRUE;
+}
+
+/* Invokes @closure for an emission without return value, straight from
+ * the arguments in @var_args when it has a va marshaller, otherwise from
+ * @instance_and_params, which get collected on first use. Called with the
+ * signal lock released. */
+static void
+signal_invoke_va (const SignalNode       *node,
+                  GClosure               *closure,
+                  gpointer                instance,
+                  va_list                 var_args,
+                  GValueVector           *instance_and_params,
+                  GSignalInvocationHint  *ihint)
+{
+  va_list args;
+
+  if (G_LIKELY (_g_closure_supports_invoke_va (closure)))
+    {
+      G_VA_COPY (args, var_args);
+      _g_closure_invoke_va (closure, NULL, instance, args,
+                            node->n_params, node->param_types);
+      va_end (args);
+      return;
+    }
+
+  /* The marshaller can change after connecting, through
+   * g_closure_set_meta_marshal() */
+  if (instance_and_params->n_values == 0 &&
+      !signal_collect_params (node, instance, var_args, instance_and_params))
+    return;
+
+  g_closure_invoke (closure, NULL, node->n_params + 1, instance_and_params->values, ihint);
+}
+
+/*<private>
+ * signal_emit_va_unlocked_R:
+ * @node: Copy of the signal node
+ * @detail: Signal detail
+ * @instance: The instance to emit from
+ * @class_closure: (nullable): The class closure to run
+ * @var_args: Call arguments
+ *
+ * Like signal_emit_unlocked_R(), for signals without return value or
+ * emission hooks whose class closure and handlers can be invoked from
+ * @var_args, so that no arguments have to be collected into GValues.
+ * Each closure gets its own copy of @var_args.
+ *
+ * Called with the signal mutex held, returns with it released.
+ */
+static void
+signal_emit_va_unlocked_R (const SignalNode *node,
+                           GQuark            detail,
+                           gpointer          instance,
+                           GClosure         *class_closure,
+                           va_list           var_args)
+{
+  Emission emission;
+  HandlerList *hlist;
+  Handler *handler_list = NULL;
+  GValueVector instance_and_params;
+  GType instance_type = G_TYPE_FROM_INSTANCE (instance);
+  guint signal_id = node->signal_id;
+  gulong max_sequential_handler_number;
+
+  TRACE(GOBJECT_SIGNAL_EMIT(signal_id, detail, instance, instance_type));
+
+  _g_value_vector_init (&instance_and_params, 0);
+
+  emission.instance = instance;
+  emission.ihint.signal_id = signal_id;
+  emission.ihint.detail = detail;
+  emission.ihint.run_type = G_SIGNAL_RUN_FIRST | G_SIGNAL_ACCUMULATOR_FIRST_RUN;
+  emission.state = EMISSION_RUN;
+  emission.chain_type = G_TYPE_NONE;
+  emission_push (&emission);
+
+  max_sequential_handler_number = g_handler_sequential_number;
+  hlist = handler_list_lookup (signal_id, instance);
+  handler_list = hlist ? hlist->handlers : NULL;
+  if (handler_list)
+    handler_ref (handler_list);
+
+  /* The GValue holding the instance keeps it alive on the slow path */
+#ifndef __COVERITY__
+  g_object_ref (instance);
+#endif
+
+  if (class_closure && !node->single_va_closure_is_after)
+    {
+      emission.chain_type = instance_type;
+      SIGNAL_UNLOCK ();
+      signal_invoke_va (node, class_closure, instance, var_args,
+                        &instance_and_params, &emission.ihint);
+      SIGNAL_LOCK ();
+      emission.chain_type = G_TYPE_NONE;
+
+      if (emission.state == EMISSION_STOP)
+        goto EMIT_CLEANUP;
+    }
+
+  if (handler_list)
+    {
+      Handler *handler = handler_list;
+
+      handler_ref (handler);
+      do
+	{
+	  Handler *tmp;
+
+	  if (handler->after)
+	    {
+	      handler_unref_R (signal_id, instance, handler_list);
+	      handler_list = handler;
+	      break;
+	    }
+	  else if (!handler->block_count && (!handler->detail || handler->detail == detail) &&
+		   handler->sequential_number < max_sequential_handler_number)
+	    {
+	      SIGNAL_UNLOCK ();
+	      signal_invoke_va (node, handler->closure, instance, var_args,
+	                        &instance_and_params, &emission.ihint);
+	      SIGNAL_LOCK ();
+
+	      tmp = emission.state == EMISSION_RUN ? handler->next : NULL;
+	    }
+	  else
+	    tmp = handler->next;
+
+	  if (tmp)
+	    handler_ref (tmp);
+	  handler_unref_R (signal_id, instance, handler_list);
+	  handler_list = handler;
+	  handler = tmp;
+	}
+      while (handler);
+
+      if (emission.state == EMISSION_STOP)
+	goto EMIT_CLEANUP;
+    }
+
+  emission.ihint.run_type &= ~G_SIGNAL_RUN_FIRST;
+  emission.ihint.run_type |= G_SIGNAL_RUN_LAST;
+
+  if (class_closure && node->single_va_closure_is_after)
+    {
+      emission.chain_type = instance_type;
+      SIGNAL_UNLOCK ();
+      signal_invoke_va (node, class_closure, instance, var_args,
+                        &instance_and_params, &emission.ihint);
+      SIGNAL_LOCK ();
+      emission.chain_type = G_TYPE_NONE;
+
+      if (emission.state == EMISSION_STOP)
+        goto EMIT_CLEANUP;
+    }
+
+  if (handler_list)
+    {
+      Handler *handler = handler_list;
+
+      handler_ref (handler);
+      do
+	{
+	  Handler *tmp;
+
+	  if (handler->after && !handler->block_count && (!handler->detail || handler->detail == detail) &&
+	      handler->sequential_number < max_sequential_handler_number)
+	    {
+	      SIGNAL_UNLOCK ();
+	      signal_invoke_va (node, handler->closure, instance, var_args,
+	                        &instance_and_params, &emission.ihint);
+	      SIGNAL_LOCK ();
+
+	      tmp = emission.state == EMISSION_RUN ? handler->next : NULL;
+	    }
+	  else
+	    tmp = handler->next;
+
+	  if (tmp)
+	    handler_ref (tmp);
+	  handler_unref_R (signal_id, instance, handler);
+	  handler = tmp;
+	}
+      while (handler);
+    }
+
+ EMIT_CLEANUP:
+
+  if (handler_list)
+    handler_unref_R (signal_id, instance, handler_list);
+
+  emission_pop (&emission);
+  SIGNAL_UNLOCK ();
+
+  _g_value_vector_clear (&instance_and_params);
+
+  TRACE(GOBJECT_SIGNAL_EMIT_END(signal_id, detail, instance, instance_type));
+
+#ifndef __COVERITY__
+  g_object_unref (instance);
+#endif
+}
+
 /*<private>
  * signal_emit_valist_unlocked:
  * @instance: The instance to emit from
@@ -3278,6 +3746,7 @@ signal_emit_valist_unlocked (gpointer instance,
                              GQuark   detail,
                              va_list  var_args)
 {
+  GValueVector params;
   GValue *instance_and_params;
   GValue *param_values;
   SignalNode *node;
@@ -3317,7 +3786,9 @@ signal_emit_valist_unlocked (gpointer instance,
       Handler *fastpath_handler = NULL;
       Handler *l;
       GClosure *closure = NULL;
+      GClosure *class_closure = NULL;
       gboolean fastpath = TRUE;
+      gboolean multiple_closures = FALSE;
       GSignalFlags run_type = G_SIGNAL_RUN_FIRST;
 
       if (node->single_va_closure != SINGLE_VA_CLOSURE_EMPTY_MAGIC &&
@@ -3325,7 +3796,7 @@ signal_emit_valist_unlocked (gpointer instance,
 	{
 	  if (_g_closure_supports_invoke_va (node->single_va_closure))
 	    {
-	      closure = node->single_va_closure;
+	      closure = class_closure = node->single_va_closure;
 	      if (node->single_va_closure_is_after)
 		run_type = G_SIGNAL_RUN_LAST;
 	      else
@@ -3346,11 +3817,13 @@ signal_emit_valist_unlocked (gpointer instance,
 	  if (!l->block_count &&
 	      (!l->detail || l->detail == detail))
 	    {
-	      if (closure != NULL || !_g_closure_supports_invoke_va (l->closure))
+	      if (!_g_closure_supports_invoke_va (l->closure))
 		{
 		  fastpath = FALSE;
 		  break;
 		}
+	      else if (closure != NULL)
+		multiple_closures = TRUE;
 	      else
 		{
                   fastpath_handler = l;
@@ -3366,6 +3839,21 @@ signal_emit_valist_unlocked (gpointer instance,
       if (fastpath && closure == NULL && node_copy.return_type == G_TYPE_NONE)
         return TRUE;
 
+      /* Several closures can all be invoked from the va_list as well, as
+       * long as there is no return value to accumulate and no restart */
+      if (fastpath && multiple_closures)
+        {
+          if (node_copy.return_type == G_TYPE_NONE &&
+              (node_copy.flags & G_SIGNAL_NO_RECURSE) == 0)
+            {
+              signal_emit_va_unlocked_R (&node_copy, detail, instance,
+                                         class_closure, var_args);
+              return FALSE;
+            }
+
+          fastpath = FALSE;
+        }
+
       /* Don't allow no-recurse emission as we might have to restart, which means
 	 we will run multiple handlers and thus must ref all arguments */
       if (closure != NULL && (node_copy.flags & (G_SIGNAL_NO_RECURSE)) != 0)
@@ -3454,10 +3942,10 @@ signal_emit_valist_unlocked (gpointer instance,
               if (closure == NULL)
                 g_value_init (&emission_return, rtype);
 
-	      G_VALUE_LCOPY (&emission_return,
-			     var_args,
-			     static_scope ? G_VALUE_NOCOPY_CONTENTS : 0,
-			     &error);
+              if (static_scope)
+                G_VALUE_LCOPY (&emission_return, var_args, G_VALUE_NOCOPY_CONTENTS, &error);
+              else
+                _G_VALUE_LCOPY_TAKE (&emission_return, var_args, &error);
 	      if (!error)
 		g_value_unset (&emission_return);
 	      else
@@ -3484,7 +3972,8 @@ signal_emit_valist_unlocked (gpointer instance,
 
   SIGNAL_UNLOCK ();
 
-  instance_and_params = g_newa0 (GValue, node_copy.n_params + 1);
+  _g_value_vector_init (&params, node_copy.n_params + 1);
+  instance_and_params = params.values;
   param_values = instance_and_params + 1;
 
   for (i = 0; i < node_copy.n_params; i++)
@@ -3505,8 +3994,8 @@ signal_emit_valist_unlocked (gpointer instance,
 	  /* we purposely leak the value here, it might not be
 	   * in a correct state if an error condition occurred
 	   */
-	  while (i--)
-	    g_value_unset (param_values + i);
+	  memset (param_values + i, 0, sizeof (GValue));
+	  _g_value_vector_clear (&params);
 
           return FALSE;
 	}
@@ -3532,10 +4021,10 @@ signal_emit_valist_unlocked (gpointer instance,
       signal_emit_unlocked_R (&node_copy, detail, instance, &return_value, instance_and_params);
       SIGNAL_UNLOCK ();
 
-      G_VALUE_LCOPY (&return_value,
-		     var_args,
-		     static_scope ? G_VALUE_NOCOPY_CONTENTS : 0,
-		     &error);
+      if (static_scope)
+        G_VALUE_LCOPY (&return_value, var_args, G_VALUE_NOCOPY_CONTENTS, &error);
+      else
+        _G_VALUE_LCOPY_TAKE (&return_value, var_args, &error);
       if (!error)
 	g_value_unset (&return_value);
       else
@@ -3548,9 +4037,7 @@ signal_emit_valist_unlocked (gpointer instance,
 	   */
 	}
     }
-  for (i = 0; i < node_copy.n_params; i++)
-    g_value_unset (param_values + i);
-  g_value_unset (instance_and_params);
+  _g_value_vector_clear (&params);
 
   return FALSE;
 }
@@ -99,6 +99,67 @@ gboolean    _g_object_has_signal_handler     (GObject     *object);
 void        _g_object_set_has_signal_handler (GObject     *object,
                                               guint        signal_id);
 
+/* for gobject.c and gsignal.c */
+gboolean    _g_value_owns_contents (const GValue *value);
+
+/*< private >
+ * _G_VALUE_LCOPY_TAKE:
+ * @value: a #GValue which is going to be unset afterwards
+ * @var_args: the va_list variable
+ * @__error: a #gchar** variable that will be modified to hold a g_new()
+ *  allocated error message if something fails
+ *
+ * Like G_VALUE_LCOPY() without %G_VALUE_NOCOPY_CONTENTS, for a temporary
+ * @value whose contents never escape: if @value owns its string, boxed
+ * value or reference, it is moved to the location collected from
+ * @var_args instead of being duplicated, and @value is left empty.
+ *
+ * Requires gvaluecollector.h.
+ */
+#define _G_VALUE_LCOPY_TAKE(value, var_args, __error)                         \
+G_STMT_START {                                                               \
+  GValue *g_lt_value = (value);                                              \
+  if (_g_value_owns_contents (g_lt_value))                                   \
+    {                                                                        \
+      G_VALUE_LCOPY (g_lt_value, var_args, G_VALUE_NOCOPY_CONTENTS, __error); \
+      if (*(__error) == NULL)                                                \
+        memset (g_lt_value->data, 0, sizeof (g_lt_value->data));             \
+    }                                                                        \
+  else                                                                       \
+    G_VALUE_LCOPY (g_lt_value, var_args, 0, __error);                        \
+} G_STMT_END
+
+/*< private >
+ * GValueVector:
+ * @values: the values, either @inline_values or a heap allocation
+ * @n_values: the number of values
+ *
+ * A temporary array of zero-initialized #GValues, which only allocates
+ * when more than %G_VALUE_VECTOR_N_INLINE values are needed.
+ */
+#define G_VALUE_VECTOR_N_INLINE 8
+
+typedef struct
+{
+  GValue *values;
+  guint n_values;
+  GValue inline_values[G_VALUE_VECTOR_N_INLINE];
+} GValueVector;
+
+void        _g_value_vector_init  (GValueVector *vector,
+                                   guint         n_values);
+void        _g_value_vector_clear (GValueVector *vector);
+
+/* for gbinding.c */
+GValueTransform _g_value_transform_lookup (GType            src_type,
+                                           GType            dest_type);
+void            _g_value_transform_with   (GValueTransform  transform,
+                                           const GValue    *src_value,
+                                           GValue          *dest_value);
+void            _g_object_get_property_by_pspec (GObject    *object,
+                                                 GParamSpec *pspec,
+                                                 GValue     *value);
+
 /**
  * _G_DEFINE_TYPE_EXTENDED_WITH_PRELUDE:
  *
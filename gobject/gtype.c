@@ -35,6 +35,7 @@
 
 #include "glib-private.h"
 #include "gconstructor.h"
+#include "../glib/gtrace-private.h"
 
 #ifdef G_OS_WIN32
 #include <windows.h>
@@ -75,15 +76,15 @@
  */
 
 #ifdef LOCK_DEBUG
-#define G_READ_LOCK(rw_lock)    do { g_printerr (G_STRLOC ": readL++\n"); g_rw_lock_reader_lock (rw_lock); } while (0)
-#define G_READ_UNLOCK(rw_lock)  do { g_printerr (G_STRLOC ": readL--\n"); g_rw_lock_reader_unlock (rw_lock); } while (0)
-#define G_WRITE_LOCK(rw_lock)   do { g_printerr (G_STRLOC ": writeL++\n"); g_rw_lock_writer_lock (rw_lock); } while (0)
-#define G_WRITE_UNLOCK(rw_lock) do { g_printerr (G_STRLOC ": writeL--\n"); g_rw_lock_writer_unlock (rw_lock); } while (0)
+#define G_READ_LOCK(rw_lock)    do { g_printerr (G_STRLOC ": readL++\n"); GLIB_PRIVATE_CALL (g_big_rw_lock_reader_lock) (rw_lock); } while (0)
+#define G_READ_UNLOCK(rw_lock)  do { g_printerr (G_STRLOC ": readL--\n"); GLIB_PRIVATE_CALL (g_big_rw_lock_reader_unlock) (rw_lock); } while (0)
+#define G_WRITE_LOCK(rw_lock)   do { g_printerr (G_STRLOC ": writeL++\n"); GLIB_PRIVATE_CALL (g_big_rw_lock_writer_lock) (rw_lock); } while (0)
+#define G_WRITE_UNLOCK(rw_lock) do { g_printerr (G_STRLOC ": writeL--\n"); GLIB_PRIVATE_CALL (g_big_rw_lock_writer_unlock) (rw_lock); } while (0)
 #else
-#define G_READ_LOCK(rw_lock)    g_rw_lock_reader_lock (rw_lock)
-#define G_READ_UNLOCK(rw_lock)  g_rw_lock_reader_unlock (rw_lock)
-#define G_WRITE_LOCK(rw_lock)   g_rw_lock_writer_lock (rw_lock)
-#define G_WRITE_UNLOCK(rw_lock) g_rw_lock_writer_unlock (rw_lock)
+#define G_READ_LOCK(rw_lock)    GLIB_PRIVATE_CALL (g_big_rw_lock_reader_lock) (rw_lock)
+#define G_READ_UNLOCK(rw_lock)  GLIB_PRIVATE_CALL (g_big_rw_lock_reader_unlock) (rw_lock)
+#define G_WRITE_LOCK(rw_lock)   GLIB_PRIVATE_CALL (g_big_rw_lock_writer_lock) (rw_lock)
+#define G_WRITE_UNLOCK(rw_lock) GLIB_PRIVATE_CALL (g_big_rw_lock_writer_unlock) (rw_lock)
 #endif
 #define	INVALID_RECURSION(func, arg, type_name) G_STMT_START{ \
     static const gchar _action[] = " invalidly modified type ";  \
@@ -132,6 +133,7 @@
 
 /* --- typedefs --- */
 typedef struct _TypeNode        TypeNode;
+typedef struct _InstanceCounters InstanceCounters;
 typedef struct _CommonData      CommonData;
 typedef struct _BoxedData       BoxedData;
 typedef struct _IFaceData       IFaceData;
@@ -190,12 +192,19 @@ typedef enum
 } InitState;
 
 /* --- structures --- */
+/* Interfaces an instantiatable type is known to conform to, in a small
+ * direct-mapped cache indexed by the interface type. Interfaces are never
+ * removed from a type, so a hit is always right, and a miss just falls
+ * back to looking up the interface entry. */
+#define IFACE_CACHE_SIZE 8
+#define IFACE_CACHE_SLOT(iface_type) (((iface_type) >> 4) % IFACE_CACHE_SIZE)
+
 struct _TypeNode
 {
   guint        ref_count;  /* (atomic) */
-#ifdef G_ENABLE_DEBUG
-  guint        instance_count;  /* (atomic) */
-#endif
+  guint        instance_cache_size;  /* (atomic) */
+  InstanceCounters *instance_counters;  /* (atomic) */
+  gpointer     iface_cache[IFACE_CACHE_SIZE];  /* (atomic) */
   GTypePlugin *plugin;
   guint        n_children; /* writable with lock */
   guint        n_supers : 8;
@@ -344,7 +353,7 @@ typedef struct {
 
 
 /* --- variables --- */
-static GRWLock         type_rw_lock;
+static GBigRWLock      type_rw_lock;
 static GRecMutex       class_init_rec_mutex;
 static guint           static_n_class_cache_funcs = 0;
 static ClassCacheFunc *static_class_cache_funcs = NULL;
@@ -482,8 +491,11 @@ type_node_any_new_W (TypeNode             *pnode,
 	    }
 	}
 
+      /* Grow in powers of two, fundamental types like GObject get
+       * thousands of children */
       i = pnode->n_children++;
-      pnode->children = g_renew (GType, pnode->children, pnode->n_children);
+      if ((i & (i - 1)) == 0)
+        pnode->children = g_renew (GType, pnode->children, i ? i * 2 : 1);
       pnode->children[i] = type;
     }
 
@@ -1840,6 +1852,422 @@ maybe_issue_deprecation_warning (GType type)
                name);
 }
 
+/* --- instance caches --- */
+/* Freed instances of types with an instance cache size are kept in a
+ * per-thread cache of up to that many blocks per type, and reused by
+ * g_type_create_instance() on the same thread. Trimming bumps a
+ * generation counter, on which each thread drops its cached blocks the
+ * next time it uses its cache. */
+typedef struct
+{
+  GType     type;
+  gsize     block_size;
+  guint     n_blocks;
+  guint     n_blocks_allocated;
+  gpointer *blocks;
+} InstanceCache;
+
+typedef struct
+{
+  guint          generation;
+  guint          n_caches;
+  InstanceCache *caches;
+} InstanceCaches;
+
+static void instance_caches_free (gpointer data);
+
+static GPrivate instance_caches_private = G_PRIVATE_INIT (instance_caches_free);
+static guint instance_caches_generation = 0;  /* (atomic) */
+
+static void
+instance_cache_clear (InstanceCache *cache)
+{
+  while (cache->n_blocks)
+    g_free_sized (cache->blocks[--cache->n_blocks], cache->block_size);
+}
+
+static void
+instance_caches_free (gpointer data)
+{
+  InstanceCaches *caches = data;
+  guint i;
+
+  for (i = 0; i < caches->n_caches; i++)
+    {
+      instance_cache_clear (&caches->caches[i]);
+      g_free (caches->caches[i].blocks);
+    }
+  g_free (caches->caches);
+  g_free (caches);
+}
+
+static InstanceCache *
+instance_cache_lookup (GType    type,
+                       gsize    block_size,
+                       gboolean create)
+{
+  InstanceCaches *caches;
+  guint generation, i;
+
+  caches = g_private_get (&instance_caches_private);
+  if (caches == NULL)
+    {
+      if (!create)
+        return NULL;
+
+      caches = g_new0 (InstanceCaches, 1);
+      caches->generation = g_atomic_int_get (&instance_caches_generation);
+      g_private_set (&instance_caches_private, caches);
+    }
+
+  generation = g_atomic_int_get (&instance_caches_generation);
+  if (G_UNLIKELY (caches->generation != generation))
+    {
+      for (i = 0; i < caches->n_caches; i++)
+        instance_cache_clear (&caches->caches[i]);
+      caches->generation = generation;
+    }
+
+  for (i = 0; i < caches->n_caches; i++)
+    if (caches->caches[i].type == type)
+      {
+        InstanceCache *cache = &caches->caches[i];
+
+        /* Dynamic types can come back with a different layout */
+        if (G_UNLIKELY (cache->block_size != block_size))
+          {
+            instance_cache_clear (cache);
+            cache->block_size = block_size;
+          }
+
+        return cache;
+      }
+
+  if (!create)
+    return NULL;
+
+  caches->caches = g_renew (InstanceCache, caches->caches, caches->n_caches + 1);
+  caches->caches[caches->n_caches] = (InstanceCache) {
+    .type = type,
+    .block_size = block_size,
+  };
+
+  return &caches->caches[caches->n_caches++];
+}
+
+/* Returns a zeroed block of @block_size bytes from the cache of @node,
+ * or %NULL */
+static inline gpointer
+instance_cache_pop (TypeNode *node,
+                    gsize     block_size)
+{
+  InstanceCache *cache;
+  gpointer block;
+
+  if (G_LIKELY (g_atomic_int_get (&node->instance_cache_size) == 0))
+    return NULL;
+
+  cache = instance_cache_lookup (NODE_TYPE (node), block_size, FALSE);
+  if (cache == NULL || cache->n_blocks == 0)
+    return NULL;
+
+  block = cache->blocks[--cache->n_blocks];
+  memset (block, 0, block_size);
+
+  return block;
+}
+
+/* Takes @block of @block_size bytes into the cache of @node, unless it
+ * is full */
+static inline gboolean
+instance_cache_push (TypeNode *node,
+                     gpointer  block,
+                     gsize     block_size)
+{
+  InstanceCache *cache;
+  guint cache_size;
+
+  cache_size = g_atomic_int_get (&node->instance_cache_size);
+  if (G_LIKELY (cache_size == 0))
+    return FALSE;
+
+  cache = instance_cache_lookup (NODE_TYPE (node), block_size, TRUE);
+  if (cache->n_blocks >= cache_size)
+    return FALSE;
+
+  if (cache->n_blocks == cache->n_blocks_allocated)
+    {
+      cache->n_blocks_allocated = MIN (cache_size, MAX (8, cache->n_blocks_allocated * 2));
+      cache->blocks = g_renew (gpointer, cache->blocks, cache->n_blocks_allocated);
+    }
+
+  cache->blocks[cache->n_blocks++] = block;
+
+  return TRUE;
+}
+
+/**
+ * g_type_set_instance_cache_size:
+ * @type: an instantiatable, non-abstract type
+ * @cache_size: the maximum number of freed instances to keep per thread,
+ *   or 0 to disable caching
+ *
+ * Makes g_type_free_instance() keep the memory of up to @cache_size
+ * freed instances of exactly @type per thread, for g_type_create_instance()
+ * to reuse on that thread instead of allocating new memory.
+ *
+ * This is meant for types whose instances are created and destroyed at a
+ * very high rate. Cached memory is given back with
+ * g_type_trim_instance_caches(), and when the thread exits.
+ *
+ * Since: 2.82
+ */
+void
+g_type_set_instance_cache_size (GType type,
+                                guint cache_size)
+{
+  TypeNode *node;
+
+  node = lookup_type_node_I (type);
+  g_return_if_fail (node != NULL && node->is_instantiatable);
+  g_return_if_fail (!G_TYPE_IS_ABSTRACT (type));
+
+  g_atomic_int_set (&node->instance_cache_size, cache_size);
+}
+
+/**
+ * g_type_trim_instance_caches:
+ *
+ * Frees the memory of the instances kept by
+ * g_type_set_instance_cache_size(). The caches of the calling thread are
+ * freed immediately, those of other threads the next time the thread
+ * creates or frees an instance of a type with an instance cache.
+ *
+ * The default #GMemoryMonitor calls this on low memory warnings.
+ *
+ * Since: 2.82
+ */
+void
+g_type_trim_instance_caches (void)
+{
+  g_atomic_int_inc (&instance_caches_generation);
+
+  /* Drops the blocks of the calling thread right away */
+  (void) instance_cache_lookup (G_TYPE_INVALID, 0, FALSE);
+}
+
+/* Counters of the instances of a type, see g_type_enable_instance_counting().
+ * They are split into stripes on separate cache lines, and each thread
+ * only updates its own stripe, so that threads creating instances of the
+ * same type don't contend on one counter. Readers add up all stripes. */
+#define INSTANCE_COUNTER_STRIPES 16
+#define INSTANCE_COUNTER_ALIGNMENT 64
+
+/* The sysprof counters are only updated every so many changes to a stripe */
+#define INSTANCE_COUNTERS_TRACE_INTERVAL 64
+
+typedef struct
+{
+  gssize live;  /* (atomic) */
+  gssize total;  /* (atomic) */
+#ifdef HAVE_SYSPROF
+  guint changes;  /* (atomic) */
+#endif
+} InstanceCounterStripe;
+
+struct _InstanceCounters
+{
+  union {
+    InstanceCounterStripe counts;
+    char padding[INSTANCE_COUNTER_ALIGNMENT];
+  } stripes[INSTANCE_COUNTER_STRIPES];
+  guint trace_live_id;
+  guint trace_total_id;
+};
+
+static guint instance_counters_next_stripe = 0;  /* (atomic) */
+static GPrivate instance_counters_stripe_private;  /* stripe index + 1 */
+
+static inline guint
+instance_counters_get_stripe (void)
+{
+  guint stripe = GPOINTER_TO_UINT (g_private_get (&instance_counters_stripe_private));
+
+  if (G_UNLIKELY (stripe == 0))
+    {
+      stripe = (guint) g_atomic_int_add (&instance_counters_next_stripe, 1) % INSTANCE_COUNTER_STRIPES + 1;
+      g_private_set (&instance_counters_stripe_private, GUINT_TO_POINTER (stripe));
+    }
+
+  return stripe - 1;
+}
+
+static void
+instance_counters_sum (InstanceCounters *counters,
+                       gssize           *live,
+                       gssize           *total)
+{
+  guint i;
+
+  *live = 0;
+  *total = 0;
+  for (i = 0; i < INSTANCE_COUNTER_STRIPES; i++)
+    {
+      *live += g_atomic_pointer_get (&counters->stripes[i].counts.live);
+      *total += g_atomic_pointer_get (&counters->stripes[i].counts.total);
+    }
+
+  /* Instances created before counting was enabled are only seen when
+   * they are freed */
+  *live = MAX (*live, 0);
+}
+
+static InstanceCounters *
+instance_counters_ensure (TypeNode *node)
+{
+  InstanceCounters *counters;
+
+  counters = g_aligned_alloc0 (1, sizeof (InstanceCounters), INSTANCE_COUNTER_ALIGNMENT);
+
+#ifdef HAVE_SYSPROF
+  {
+    char *name, *description;
+
+    name = g_strdup_printf ("%s live", NODE_NAME (node));
+    description = g_strdup_printf ("Number of live instances of %s", NODE_NAME (node));
+    counters->trace_live_id = g_trace_define_int64_counter ("GObject", name, description);
+    g_free (name);
+    g_free (description);
+
+    name = g_strdup_printf ("%s total", NODE_NAME (node));
+    description = g_strdup_printf ("Number of instances of %s ever created", NODE_NAME (node));
+    counters->trace_total_id = g_trace_define_int64_counter ("GObject", name, description);
+    g_free (name);
+    g_free (description);
+  }
+#endif
+
+  if (!g_atomic_pointer_compare_and_exchange (&node->instance_counters, NULL, counters))
+    {
+      /* Another thread won */
+      g_aligned_free (counters);
+      return g_atomic_pointer_get (&node->instance_counters);
+    }
+
+  /* Lives as long as the type */
+  g_ignore_leak (counters);
+
+  return counters;
+}
+
+static inline void
+instance_counters_add (TypeNode *node,
+                       gssize    delta)
+{
+  InstanceCounters *counters;
+  InstanceCounterStripe *stripe;
+
+  counters = g_atomic_pointer_get (&node->instance_counters);
+  if (G_LIKELY (counters == NULL))
+    {
+      if (G_LIKELY (!(_g_type_debug_flags & G_TYPE_DEBUG_INSTANCE_COUNT)))
+        return;
+
+      counters = instance_counters_ensure (node);
+    }
+
+  stripe = &counters->stripes[instance_counters_get_stripe ()].counts;
+  g_atomic_pointer_add (&stripe->live, delta);
+  if (delta > 0)
+    g_atomic_pointer_add (&stripe->total, delta);
+
+#ifdef HAVE_SYSPROF
+  if ((g_atomic_int_add (&stripe->changes, 1) % INSTANCE_COUNTERS_TRACE_INTERVAL) == 0)
+    {
+      gssize live, total;
+
+      instance_counters_sum (counters, &live, &total);
+      g_trace_set_int64_counter (counters->trace_live_id, live);
+      g_trace_set_int64_counter (counters->trace_total_id, total);
+    }
+#endif
+}
+
+/**
+ * g_type_enable_instance_counting:
+ * @type: an instantiatable type
+ *
+ * Starts counting the instances of exactly @type, that is not including
+ * instances of its subtypes. The counts can be queried with
+ * g_type_get_instance_counts(), and when GLib is built with sysprof
+ * support, they are also published as the sysprof counters “TypeName live”
+ * and “TypeName total” in the “GObject” group.
+ *
+ * Counting is cheap enough to be left enabled in production, for example
+ * to watch for leaks or high churn of a type. Threads update separate
+ * counters, so they don't contend with each other. Counting can not be
+ * disabled again.
+ *
+ * Setting the `GOBJECT_DEBUG` environment variable to include
+ * `instance-count` enables counting for all types.
+ *
+ * Since: 2.82
+ */
+void
+g_type_enable_instance_counting (GType type)
+{
+  TypeNode *node;
+
+  node = lookup_type_node_I (type);
+  g_return_if_fail (node != NULL && node->is_instantiatable);
+
+  if (g_atomic_pointer_get (&node->instance_counters) == NULL)
+    instance_counters_ensure (node);
+}
+
+/**
+ * g_type_get_instance_counts:
+ * @type: an instantiatable type
+ * @n_live: (out) (optional): return location for the number of live
+ *   instances of @type
+ * @n_total: (out) (optional): return location for the number of instances
+ *   of @type created so far
+ *
+ * Gets the instance counts of @type kept since
+ * g_type_enable_instance_counting() was called for it. Instances that
+ * were created before that are not counted.
+ *
+ * The counts are updated by each thread separately, so while other
+ * threads create and free instances they are only approximate.
+ *
+ * Returns: %TRUE if instances of @type are counted, %FALSE otherwise
+ *
+ * Since: 2.82
+ */
+gboolean
+g_type_get_instance_counts (GType    type,
+                            gsize   *n_live,
+                            guint64 *n_total)
+{
+  InstanceCounters *counters;
+  TypeNode *node;
+  gssize live = 0, total = 0;
+
+  node = lookup_type_node_I (type);
+  g_return_val_if_fail (node != NULL && node->is_instantiatable, FALSE);
+
+  counters = g_atomic_pointer_get (&node->instance_counters);
+  if (counters)
+    instance_counters_sum (counters, &live, &total);
+
+  if (n_live)
+    *n_live = live;
+  if (n_total)
+    *n_total = total;
+
+  return counters != NULL;
+}
+
 /**
  * g_type_create_instance: (skip)
  * @type: an instantiatable type to create an instance for
@@ -1930,7 +2358,11 @@ g_type_create_instance (GType type)
     }
   else
 #endif
-    allocated = g_malloc0 (private_size + ivar_size);
+    {
+      allocated = instance_cache_pop (node, private_size + ivar_size);
+      if (allocated == NULL)
+        allocated = g_malloc0 (private_size + ivar_size);
+    }
 
   instance = (GTypeInstance *) (allocated + private_size);
 
@@ -1950,12 +2382,7 @@ g_type_create_instance (GType type)
   if (node->data->instance.instance_init)
     node->data->instance.instance_init (instance, class);
 
-#ifdef	G_ENABLE_DEBUG
-  IF_DEBUG (INSTANCE_COUNT)
-    {
-      g_atomic_int_inc ((int *) &node->instance_count);
-    }
-#endif
+  instance_counters_add (node, 1);
 
   TRACE(GOBJECT_OBJECT_NEW(instance, type));
 
@@ -2027,14 +2454,12 @@ g_type_free_instance (GTypeInstance *instance)
     }
   else
 #endif
-    g_free_sized (allocated, private_size + ivar_size);
-
-#ifdef	G_ENABLE_DEBUG
-  IF_DEBUG (INSTANCE_COUNT)
     {
-      g_atomic_int_add ((int *) &node->instance_count, -1);
+      if (!instance_cache_push (node, allocated, private_size + ivar_size))
+        g_free_sized (allocated, private_size + ivar_size);
     }
-#endif
+
+  instance_counters_add (node, -1);
 
   g_type_class_unref (class);
 }
@@ -2204,6 +2629,7 @@ type_class_init_Wm (TypeNode   *node,
   IFaceEntry *entry;
   TypeNode *bnode, *pnode;
   guint i;
+  gint64 begin_time_nsec G_GNUC_UNUSED = G_TRACE_CURRENT_TIME;
   
   /* Accessing data->class will work for instantiatable types
    * too because ClassData is a subset of InstanceData
@@ -2352,6 +2778,9 @@ type_class_init_Wm (TypeNode   *node,
     }
   
   g_atomic_int_set (&node->data->class.init_state, INITIALIZED);
+
+  g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                "GObject", "class init", "%s", NODE_NAME (node));
 }
 
 static void
@@ -2816,6 +3245,15 @@ g_type_register_static_simple (GType             parent_type,
  * instances (if not abstract). The value of @flags determines the nature
  * (e.g. abstract or not) of the type.
  *
+ * Registering a type is cheap: the class structure is only allocated and
+ * initialized, including its interfaces, when it is first needed, that is
+ * on the first g_type_class_ref() or when the first instance is created.
+ * So registering types that may never be used, for example all types of a
+ * library from one initialization function, only costs memory for the
+ * type node. When built with sysprof support, the time spent registering
+ * and initializing the class of each type is recorded as "type register"
+ * and "class init" marks in the "GObject" group.
+ *
  * Returns: the new type identifier
  */
 GType
@@ -2826,6 +3264,7 @@ g_type_register_static (GType            parent_type,
 {
   TypeNode *pnode, *node;
   GType type = 0;
+  gint64 begin_time_nsec G_GNUC_UNUSED = G_TRACE_CURRENT_TIME;
   
   g_assert_type_system_initialized ();
   g_return_val_if_fail (parent_type > 0, 0);
@@ -2854,6 +3293,9 @@ g_type_register_static (GType            parent_type,
 			check_value_table_I (type_name, info->value_table) ? info->value_table : NULL);
     }
   G_WRITE_UNLOCK (&type_rw_lock);
+
+  g_trace_mark (begin_time_nsec, G_TRACE_CURRENT_TIME - begin_time_nsec,
+                "GObject", "type register", "%s", type_name);
   
   return type;
 }
@@ -3546,6 +3988,11 @@ type_node_check_conformities_UorL (TypeNode *node,
   match = FALSE;
   if (support_interfaces)
     {
+      gpointer *slot = &node->iface_cache[IFACE_CACHE_SLOT (NODE_TYPE (iface_node))];
+
+      if (g_atomic_pointer_get (slot) == GTYPE_TO_POINTER (NODE_TYPE (iface_node)))
+        return TRUE;
+
       if (have_lock)
 	{
 	  if (type_lookup_iface_entry_L (node, iface_node))
@@ -3556,6 +4003,9 @@ type_node_check_conformities_UorL (TypeNode *node,
 	  if (type_lookup_iface_vtable_I (node, iface_node, NULL))
 	    match = TRUE;
 	}
+
+      if (match)
+        g_atomic_pointer_set (slot, GTYPE_TO_POINTER (NODE_TYPE (iface_node)));
     }
   if (!match &&
       support_prerequisites)
@@ -3926,9 +4376,12 @@ g_type_query (GType       type,
  * @type: a #GType
  *
  * Returns the number of instances allocated of the particular type;
- * this is only available if GLib is built with debugging support and
- * the `instance-count` debug flag is set (by setting the `GOBJECT_DEBUG`
- * variable to include `instance-count`).
+ * this is only available if instance counting was enabled for @type with
+ * g_type_enable_instance_counting(), or for all types by setting the
+ * `GOBJECT_DEBUG` variable to include `instance-count`.
+ *
+ * See g_type_get_instance_counts() for a version that can also tell the
+ * total number of instances created.
  *
  * Returns: the number of instances allocated of the given type;
  *   if instance counts are not available, returns 0.
@@ -3938,16 +4391,16 @@ g_type_query (GType       type,
 int
 g_type_get_instance_count (GType type)
 {
-#ifdef G_ENABLE_DEBUG
   TypeNode *node;
+  gsize n_live = 0;
 
   node = lookup_type_node_I (type);
   g_return_val_if_fail (node != NULL, 0);
 
-  return g_atomic_int_get (&node->instance_count);
-#else
-  return 0;
-#endif
+  if (node->is_instantiatable)
+    g_type_get_instance_counts (type, &n_live, NULL);
+
+  return (int) MIN (n_live, (gsize) G_MAXINT);
 }
 
 /* --- implementation details --- */
@@ -805,6 +805,18 @@ void		      g_type_query		     (GType	       type,
 GOBJECT_AVAILABLE_IN_2_44
 int                   g_type_get_instance_count      (GType            type);
 
+GOBJECT_AVAILABLE_IN_2_82
+void                  g_type_set_instance_cache_size (GType            type,
+                                                      guint            cache_size);
+GOBJECT_AVAILABLE_IN_2_82
+void                  g_type_trim_instance_caches    (void);
+GOBJECT_AVAILABLE_IN_2_82
+void                  g_type_enable_instance_counting (GType          type);
+GOBJECT_AVAILABLE_IN_2_82
+gboolean              g_type_get_instance_counts     (GType            type,
+                                                      gsize           *n_live,
+                                                      guint64         *n_total);
+
 /* --- type registration --- */
 /**
  * GBaseInitFunc:
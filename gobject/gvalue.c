@@ -198,6 +198,99 @@ g_value_unset (GValue *value)
   memset (value, 0, sizeof (*value));
 }
 
+/*< private >
+ * _g_value_owns_contents:
+ * @value: An initialized #GValue structure.
+ *
+ * Checks whether @value holds a string, boxed value, object, param spec
+ * or variant that it owns, and whose lcopy_value() function hands out
+ * exactly that allocation or reference when called with
+ * %G_VALUE_NOCOPY_CONTENTS. Clearing the data of such a value after
+ * such a copy moves its contents, see _G_VALUE_LCOPY_TAKE().
+ *
+ * Values with static, interned or otherwise borrowed contents, and
+ * types with custom value tables, are never considered owning.
+ *
+ * Returns: %TRUE if the contents of @value can be moved out of it
+ */
+gboolean
+_g_value_owns_contents (const GValue *value)
+{
+  GType fundamental = G_TYPE_FUNDAMENTAL (G_VALUE_TYPE (value));
+  GTypeValueTable *value_table;
+
+  switch (fundamental)
+    {
+    case G_TYPE_INTERFACE:
+      /* Interfaces with an object prerequisite use its value table */
+      fundamental = G_TYPE_OBJECT;
+      break;
+    case G_TYPE_STRING:
+    case G_TYPE_BOXED:
+    case G_TYPE_OBJECT:
+    case G_TYPE_PARAM:
+    case G_TYPE_VARIANT:
+      break;
+    default:
+      return FALSE;
+    }
+
+  if (value->data[0].v_pointer == NULL ||
+      value->data[1].v_uint != 0)
+    return FALSE;
+
+  value_table = g_type_value_table_peek (G_VALUE_TYPE (value));
+
+  return value_table != NULL &&
+         value_table->lcopy_value == g_type_value_table_peek (fundamental)->lcopy_value &&
+         value_table->value_free == g_type_value_table_peek (fundamental)->value_free;
+}
+
+/*< private >
+ * _g_value_vector_init:
+ * @vector: an uninitialized #GValueVector
+ * @n_values: the number of values
+ *
+ * Initializes @vector to hold @n_values zero-filled #GValues, using the
+ * storage inside @vector when they fit.
+ */
+void
+_g_value_vector_init (GValueVector *vector,
+                      guint         n_values)
+{
+  if (n_values <= G_N_ELEMENTS (vector->inline_values))
+    {
+      vector->values = vector->inline_values;
+      memset (vector->values, 0, sizeof (GValue) * n_values);
+    }
+  else
+    vector->values = g_new0 (GValue, n_values);
+
+  vector->n_values = n_values;
+}
+
+/*< private >
+ * _g_value_vector_clear:
+ * @vector: a #GValueVector
+ *
+ * Unsets all values of @vector and frees its storage. @vector is left
+ * empty, as if initialized for zero values.
+ */
+void
+_g_value_vector_clear (GValueVector *vector)
+{
+  guint i;
+
+  for (i = 0; i < vector->n_values; i++)
+    g_value_unset (&vector->values[i]);
+
+  if (vector->values != vector->inline_values)
+    g_free (vector->values);
+
+  vector->values = vector->inline_values;
+  vector->n_values = 0;
+}
+
 /**
  * g_value_fits_pointer:
  * @value: An initialized #GValue structure.
@@ -559,3 +652,44 @@ g_value_transform (const GValue *src_value,
     }
   return FALSE;
 }
+
+/*< private >
+ * _g_value_transform_lookup:
+ * @src_type: Source type.
+ * @dest_type: Target type.
+ *
+ * Looks up the transformation function g_value_transform() would use
+ * between values of @src_type and @dest_type, so that callers converting
+ * many values between the same types only have to look it up once.
+ *
+ * Returns: (nullable): the transformation function, or %NULL
+ */
+GValueTransform
+_g_value_transform_lookup (GType src_type,
+                           GType dest_type)
+{
+  return transform_func_lookup (src_type, dest_type);
+}
+
+/*< private >
+ * _g_value_transform_with:
+ * @transform: a function returned by _g_value_transform_lookup()
+ * @src_value: Source value.
+ * @dest_value: Target value.
+ *
+ * Transforms @src_value into @dest_value with @transform, as
+ * g_value_transform() does after looking it up.
+ */
+void
+_g_value_transform_with (GValueTransform  transform,
+                         const GValue    *src_value,
+                         GValue          *dest_value)
+{
+  GType dest_type = G_VALUE_TYPE (dest_value);
+
+  g_value_unset (dest_value);
+
+  /* setup and transform */
+  value_meminit (dest_value, dest_type);
+  transform (src_value, dest_value);
+}
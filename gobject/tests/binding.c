@@ -521,6 +521,56 @@ binding_transform_default (void)
   g_assert_null (binding);
 }
 
+static void
+count_notify (GObject    *gobject,
+              GParamSpec *pspec,
+              gpointer    user_data)
+{
+  guint *count = user_data;
+
+  (*count)++;
+}
+
+static void
+binding_frozen_source (void)
+{
+  BindingSource *source = g_object_new (binding_source_get_type (), NULL);
+  BindingTarget *target = g_object_new (binding_target_get_type (), NULL);
+  GBinding *binding G_GNUC_UNUSED;
+  guint n_target_notify = 0;
+
+  g_test_summary ("Test that changes to a frozen source are propagated once, on thaw");
+
+  binding = g_object_bind_property (source, "foo",
+                                    target, "bar",
+                                    G_BINDING_DEFAULT);
+  g_object_bind_property (source, "foo",
+                          target, "double-value",
+                          G_BINDING_DEFAULT);
+  g_signal_connect (target, "notify::bar", G_CALLBACK (count_notify), &n_target_notify);
+
+  g_object_freeze_notify (G_OBJECT (source));
+  g_object_set (source, "foo", 1, NULL);
+  g_object_set (source, "foo", 2, NULL);
+  g_object_set (source, "foo", 3, NULL);
+  g_assert_cmpint (target->bar, ==, 0);
+  g_assert_cmpfloat (target->double_value, ==, 0.0);
+  g_assert_cmpuint (n_target_notify, ==, 0);
+
+  g_object_thaw_notify (G_OBJECT (source));
+  g_assert_cmpint (target->bar, ==, 3);
+  g_assert_cmpfloat (target->double_value, ==, 3.0);
+  g_assert_cmpuint (n_target_notify, ==, 1);
+
+  g_object_set (source, "foo", 4, NULL);
+  g_assert_cmpint (target->bar, ==, 4);
+  g_assert_cmpfloat (target->double_value, ==, 4.0);
+  g_assert_cmpuint (n_target_notify, ==, 2);
+
+  g_object_unref (source);
+  g_object_unref (target);
+}
+
 static void
 binding_transform (void)
 {
@@ -1145,6 +1195,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/binding/bidirectional", binding_bidirectional);
   g_test_add_func ("/binding/transform", binding_transform);
   g_test_add_func ("/binding/transform-default", binding_transform_default);
+  g_test_add_func ("/binding/frozen-source", binding_frozen_source);
   g_test_add_func ("/binding/transform-closure", binding_transform_closure);
   g_test_add_func ("/binding/chain", binding_chain);
   g_test_add_func ("/binding/sync-create", binding_sync_create);
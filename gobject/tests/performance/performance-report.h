@@ -0,0 +1,365 @@
+/* GObject - GLib Type, Object, Parameter and Signal Library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Reporting shared by the performance tests: repeated measurements with
+ * median and standard deviation, JSON output, pinning to a CPU and
+ * comparison against a baseline saved with `--format=json`.
+ *
+ * Add perf_report_entries to the option context, call perf_report_init()
+ * after parsing the options, perf_report_add() for every measured test and
+ * return perf_report_finish() from main(). Only depends on GLib, so it can
+ * be used by the GLib performance tests too.
+ */
+
+#ifndef __PERFORMANCE_REPORT_H__
+#define __PERFORMANCE_REPORT_H__
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+static char *perf_report_format = NULL;
+static char *perf_report_output = NULL;
+static char *perf_report_baseline = NULL;
+static int perf_report_repeat = 1;
+static int perf_report_cpu = -1;
+static double perf_report_max_regression = 5.0;
+
+static GOptionEntry perf_report_entries[] = {
+  {"format", 0, 0, G_OPTION_ARG_STRING, &perf_report_format,
+   "Output format, \"text\" (default) or \"json\"", "FORMAT"},
+  {"output", 0, 0, G_OPTION_ARG_FILENAME, &perf_report_output,
+   "Write the JSON results to FILE instead of stdout", "FILE"},
+  {"repeat", 0, 0, G_OPTION_ARG_INT, &perf_report_repeat,
+   "Measure each test N times and report the median", "N"},
+  {"cpu", 0, 0, G_OPTION_ARG_INT, &perf_report_cpu,
+   "Pin the process to CPU number N", "N"},
+  {"baseline", 0, 0, G_OPTION_ARG_FILENAME, &perf_report_baseline,
+   "Compare against results saved with --format=json", "FILE"},
+  {"max-regression", 0, 0, G_OPTION_ARG_DOUBLE, &perf_report_max_regression,
+   "Fail if a test is more than PERCENT slower than the baseline (default 5)", "PERCENT"},
+  G_OPTION_ENTRY_NULL
+};
+
+typedef struct {
+  char *name;
+  char *unit;
+  gboolean higher_is_better;
+  guint n_samples;
+  double median;
+  double stddev;
+} PerfReportResult;
+
+static GArray *perf_report_results = NULL;
+static GHashTable *perf_report_baseline_medians = NULL;
+static gboolean perf_report_regressed = FALSE;
+
+static gboolean
+perf_report_is_json (void)
+{
+  return g_strcmp0 (perf_report_format, "json") == 0;
+}
+
+static gboolean
+perf_report_pin_cpu (int      cpu,
+                     GError **error)
+{
+#ifdef __linux__
+  cpu_set_t set;
+
+  if (cpu >= CPU_SETSIZE)
+    {
+      g_set_error (error, G_OPTION_ERROR, G_OPTION_ERROR_BAD_VALUE,
+                   "CPU %d out of range", cpu);
+      return FALSE;
+    }
+
+  CPU_ZERO (&set);
+  CPU_SET (cpu, &set);
+
+  /* Threads started later inherit the affinity */
+  if (sched_setaffinity (0, sizeof (set), &set) != 0)
+    {
+      int errsv = errno;
+
+      g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errsv),
+                   "Failed to pin to CPU %d: %s", cpu, g_strerror (errsv));
+      return FALSE;
+    }
+
+  return TRUE;
+#else
+  g_set_error_literal (error, G_OPTION_ERROR, G_OPTION_ERROR_FAILED,
+                       "Pinning to a CPU is not supported on this platform");
+  return FALSE;
+#endif
+}
+
+/* The baseline is the output of a previous run with --format=json, which
+ * has one result object per line, so there's no need for a full JSON
+ * parser here. */
+static gboolean
+perf_report_load_baseline (const char  *filename,
+                           GError     **error)
+{
+  GRegex *regex;
+  char *contents;
+  char **lines;
+  gsize i;
+
+  if (!g_file_get_contents (filename, &contents, NULL, error))
+    return FALSE;
+
+  regex = g_regex_new ("\"name\": \"([^\"]*)\".*\"median\": ([-+0-9.eE]+|null)",
+                       G_REGEX_DEFAULT, G_REGEX_MATCH_DEFAULT, NULL);
+  g_assert (regex != NULL);
+
+  perf_report_baseline_medians = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+
+  lines = g_strsplit (contents, "\n", -1);
+  for (i = 0; lines[i] != NULL; i++)
+    {
+      GMatchInfo *match_info;
+
+      if (g_regex_match (regex, lines[i], G_REGEX_MATCH_DEFAULT, &match_info))
+        {
+          char *median = g_match_info_fetch (match_info, 2);
+
+          if (strcmp (median, "null") != 0)
+            {
+              double *value = g_new (double, 1);
+
+              *value = g_ascii_strtod (median, NULL);
+              g_hash_table_replace (perf_report_baseline_medians,
+                                    g_match_info_fetch (match_info, 1), value);
+            }
+          g_free (median);
+        }
+      g_match_info_free (match_info);
+    }
+
+  g_strfreev (lines);
+  g_regex_unref (regex);
+  g_free (contents);
+
+  if (g_hash_table_size (perf_report_baseline_medians) == 0)
+    {
+      g_set_error (error, G_FILE_ERROR, G_FILE_ERROR_INVAL,
+                   "No results found in baseline %s", filename);
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+static gboolean
+perf_report_init (GError **error)
+{
+  if (perf_report_format != NULL &&
+      strcmp (perf_report_format, "text") != 0 &&
+      strcmp (perf_report_format, "json") != 0)
+    {
+      g_set_error (error, G_OPTION_ERROR, G_OPTION_ERROR_BAD_VALUE,
+                   "Unknown output format \"%s\"", perf_report_format);
+      return FALSE;
+    }
+
+  if (perf_report_repeat < 1)
+    {
+      g_set_error_literal (error, G_OPTION_ERROR, G_OPTION_ERROR_BAD_VALUE,
+                           "The number of repetitions must be positive");
+      return FALSE;
+    }
+
+  if (perf_report_max_regression < 0)
+    {
+      g_set_error_literal (error, G_OPTION_ERROR, G_OPTION_ERROR_BAD_VALUE,
+                           "The maximum regression must not be negative");
+      return FALSE;
+    }
+
+  if (perf_report_cpu >= 0 && !perf_report_pin_cpu (perf_report_cpu, error))
+    return FALSE;
+
+  if (perf_report_baseline != NULL &&
+      !perf_report_load_baseline (perf_report_baseline, error))
+    return FALSE;
+
+  perf_report_results = g_array_new (FALSE, TRUE, sizeof (PerfReportResult));
+
+  return TRUE;
+}
+
+static int
+perf_report_compare_doubles (gconstpointer a,
+                             gconstpointer b)
+{
+  double d = *(const double *) a - *(const double *) b;
+
+  if (d < 0)
+    return -1;
+  if (d > 0)
+    return 1;
+  return 0;
+}
+
+/* Records the @n_samples measurements of test @name, in @unit. @samples
+ * is reordered. */
+static void
+perf_report_add (const char *name,
+                 const char *unit,
+                 gboolean    higher_is_better,
+                 double     *samples,
+                 guint       n_samples)
+{
+  PerfReportResult result = { 0, };
+  double mean = 0;
+  double *baseline;
+  guint i;
+
+  g_return_if_fail (perf_report_results != NULL);
+  g_return_if_fail (n_samples > 0);
+
+  qsort (samples, n_samples, sizeof (double), perf_report_compare_doubles);
+
+  if (n_samples % 2 == 1)
+    result.median = samples[n_samples / 2];
+  else
+    result.median = (samples[n_samples / 2 - 1] + samples[n_samples / 2]) / 2;
+
+  for (i = 0; i < n_samples; i++)
+    mean += samples[i];
+  mean /= n_samples;
+
+  for (i = 0; i < n_samples; i++)
+    result.stddev += (samples[i] - mean) * (samples[i] - mean);
+  if (n_samples > 1)
+    result.stddev = sqrt (result.stddev / (n_samples - 1));
+
+  result.name = g_strdup (name);
+  result.unit = g_strdup (unit);
+  result.higher_is_better = higher_is_better;
+  result.n_samples = n_samples;
+  g_array_append_val (perf_report_results, result);
+
+  if (!perf_report_is_json () && n_samples > 1)
+    g_print ("%s: median of %u runs %g %s, stddev %.2f%%\n",
+             name, n_samples, result.median, unit,
+             result.median != 0 ? 100 * result.stddev / result.median : 0);
+
+  if (perf_report_baseline_medians != NULL &&
+      (baseline = g_hash_table_lookup (perf_report_baseline_medians, name)) != NULL &&
+      *baseline > 0)
+    {
+      double change = 100 * (result.median - *baseline) / *baseline;
+      double regression = higher_is_better ? -change : change;
+
+      if (regression > perf_report_max_regression)
+        {
+          g_printerr ("REGRESSION %s: %.2f%% worse than baseline (%g -> %g %s)\n",
+                      name, regression, *baseline, result.median, unit);
+          perf_report_regressed = TRUE;
+        }
+      else if (!perf_report_is_json ())
+        {
+          g_print ("%s: %+.2f%% compared to baseline\n", name, change);
+        }
+    }
+}
+
+static void
+perf_report_append_double (GString *string,
+                           double   value)
+{
+  char buf[G_ASCII_DTOSTR_BUF_SIZE];
+
+  if (isfinite (value))
+    g_string_append (string, g_ascii_dtostr (buf, sizeof (buf), value));
+  else
+    g_string_append (string, "null");
+}
+
+static int
+perf_report_finish (void)
+{
+  guint i;
+
+  g_return_val_if_fail (perf_report_results != NULL, 1);
+
+  if (perf_report_is_json ())
+    {
+      GString *json = g_string_new ("{\n  \"results\": [\n");
+
+      for (i = 0; i < perf_report_results->len; i++)
+        {
+          PerfReportResult *result = &g_array_index (perf_report_results, PerfReportResult, i);
+
+          /* One result per line, see perf_report_load_baseline() */
+          g_string_append_printf (json, "    { \"name\": \"%s\", \"unit\": \"%s\", "
+                                  "\"higher-is-better\": %s, \"samples\": %u, \"median\": ",
+                                  result->name, result->unit,
+                                  result->higher_is_better ? "true" : "false",
+                                  result->n_samples);
+          perf_report_append_double (json, result->median);
+          g_string_append (json, ", \"stddev\": ");
+          perf_report_append_double (json, result->stddev);
+          g_string_append (json, i + 1 < perf_report_results->len ? " },\n" : " }\n");
+        }
+      g_string_append (json, "  ]\n}\n");
+
+      if (perf_report_output != NULL)
+        {
+          GError *error = NULL;
+
+          if (!g_file_set_contents (perf_report_output, json->str, json->len, &error))
+            {
+              g_printerr ("Failed to write %s: %s\n", perf_report_output, error->message);
+              g_error_free (error);
+              perf_report_regressed = TRUE;
+            }
+        }
+      else
+        {
+          fputs (json->str, stdout);
+          fflush (stdout);
+        }
+
+      g_string_free (json, TRUE);
+    }
+
+  for (i = 0; i < perf_report_results->len; i++)
+    {
+      PerfReportResult *result = &g_array_index (perf_report_results, PerfReportResult, i);
+
+      g_free (result->name);
+      g_free (result->unit);
+    }
+  g_clear_pointer (&perf_report_results, g_array_unref);
+  g_clear_pointer (&perf_report_baseline_medians, g_hash_table_unref);
+
+  return perf_report_regressed ? 1 : 0;
+}
+
+#endif /* __PERFORMANCE_REPORT_H__ */
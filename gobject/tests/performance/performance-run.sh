@@ -29,6 +29,12 @@
 #      STRIP: if set to 1, call `strip` on the library and binary before running.
 #   Arguments: arguments are directly passed to performance. For example try "-s 1".
 #
+#   Alternatively, to check a single build against a saved baseline, run
+#   `performance --format=json --output=baseline.json --repeat 5` once and later
+#   `performance --baseline=baseline.json --repeat 5`. That fails when a test got
+#   slower by more than `--max-regression` percent (5 by default). Use `--cpu N`
+#   to pin the test to one CPU for more stable numbers.
+#
 # Example:
 #
 #    # once:
@@ -19,6 +19,7 @@
 #include <string.h>
 #include <glib-object.h>
 #include "../testcommon.h"
+#include "performance-report.h"
 
 #define DEFAULT_TEST_TIME 2 /* seconds */
 
@@ -136,6 +137,69 @@ liststore_interface_peek_same_run (gpointer klass)
     }
 }
 
+/* One object that all threads take weak references to, kept alive by a
+ * strong reference for the whole run */
+static GObject *weak_ref_object;
+static GWeakRef shared_weak_ref;
+
+static void
+weak_ref_object_init (void)
+{
+  static gsize inited = 0;
+
+  if (g_once_init_enter (&inited))
+    {
+      weak_ref_object = g_object_new (G_TYPE_OBJECT, NULL);
+      g_weak_ref_init (&shared_weak_ref, weak_ref_object);
+      g_once_init_leave (&inited, 1);
+    }
+}
+
+static gpointer
+weak_ref_setup (void)
+{
+  GWeakRef *weak_ref;
+
+  weak_ref_object_init ();
+
+  weak_ref = g_new0 (GWeakRef, 1);
+  g_weak_ref_init (weak_ref, weak_ref_object);
+
+  return weak_ref;
+}
+
+static void
+weak_ref_get_run (gpointer data)
+{
+  GWeakRef *weak_ref = data;
+  guint i;
+
+  for (i = 0; i < 1000; i++)
+    {
+      GObject *object = g_weak_ref_get (weak_ref);
+
+      g_assert (object == weak_ref_object);
+      g_object_unref (object);
+    }
+}
+
+static void
+weak_ref_teardown (gpointer data)
+{
+  GWeakRef *weak_ref = data;
+
+  g_weak_ref_clear (weak_ref);
+  g_free (weak_ref);
+}
+
+static gpointer
+weak_ref_shared_setup (void)
+{
+  weak_ref_object_init ();
+
+  return &shared_weak_ref;
+}
+
 #if 0
 /* DUMB test doing nothing */
 
@@ -187,6 +251,16 @@ static const PerformanceTest tests[] = {
     liststore_interface_peek_same_run,
     no_reset,
     g_type_class_unref },
+  { "weak-ref-get",
+    weak_ref_setup,
+    weak_ref_get_run,
+    no_reset,
+    weak_ref_teardown },
+  { "weak-ref-get-shared",
+    weak_ref_shared_setup,
+    weak_ref_get_run,
+    no_reset,
+    no_teardown },
 #if 0
   { "nothing",
     no_setup,
@@ -251,25 +325,13 @@ run_test_thread (gpointer user_data)
   return results;
 }
 
-static int
-compare_doubles (gconstpointer a, gconstpointer b)
-{
-  double d = *(double *) a - *(double *) b;
-
-  if (d < 0)
-    return -1;
-  if (d > 0)
-    return 1;
-  return 0;
-}
-
 static void
 print_results (GArray *array)
 {
   double min, max, avg;
   guint i;
 
-  g_array_sort (array, compare_doubles);
+  g_array_sort (array, perf_report_compare_doubles);
 
   /* FIXME: discard outliers */
 
@@ -282,16 +344,15 @@ print_results (GArray *array)
     }
   avg = avg / array->len * 1000;
 
-  g_print ("  %u runs, min/avg/max = %.3f/%.3f/%.3f ms\n", array->len, min, avg, max);
+  if (!perf_report_is_json ())
+    g_print ("  %u runs, min/avg/max = %.3f/%.3f/%.3f ms\n", array->len, min, avg, max);
 }
 
-static void
-run_test (const PerformanceTest *test)
+static GArray *
+run_test_once (const PerformanceTest *test)
 {
   GArray *results;
 
-  g_print ("Running test \"%s\"\n", test->name);
-
   if (n_threads == 0) {
     results = run_test_thread ((gpointer) test);
   } else {
@@ -314,8 +375,32 @@ run_test (const PerformanceTest *test)
     g_free (threads);
   }
 
-  print_results (results);
-  g_array_free (results, TRUE);
+  return results;
+}
+
+static void
+run_test (const PerformanceTest *test)
+{
+  double *samples;
+  guint r;
+
+  if (!perf_report_is_json ())
+    g_print ("Running test \"%s\"\n", test->name);
+
+  samples = g_new (double, perf_report_repeat);
+
+  for (r = 0; r < (guint) perf_report_repeat; r++)
+    {
+      GArray *results = run_test_once (test);
+
+      /* Sorts the results */
+      print_results (results);
+      samples[r] = g_array_index (results, double, results->len / 2) * 1000;
+      g_array_free (results, TRUE);
+    }
+
+  perf_report_add (test->name, "msecs per run", FALSE, samples, perf_report_repeat);
+  g_free (samples);
 }
 
 static const PerformanceTest *
@@ -341,7 +426,9 @@ main (int   argc,
 
   context = g_option_context_new ("GObject performance tests");
   g_option_context_add_main_entries (context, cmd_entries, NULL);
-  if (!g_option_context_parse (context, &argc, &argv, &error))
+  g_option_context_add_main_entries (context, perf_report_entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error) ||
+      !perf_report_init (&error))
     {
       g_printerr ("%s: %s\n", argv[0], error->message);
       return 1;
@@ -373,5 +460,5 @@ main (int   argc,
     }
 
   g_option_context_free (context);
-  return 0;
+  return perf_report_finish ();
 }
@@ -20,6 +20,7 @@
 #include <string.h>
 #include <glib-object.h>
 #include "../testcommon.h"
+#include "performance-report.h"
 
 #define WARM_UP_N_RUNS 50
 #define WARM_UP_ALWAYS_SEC 2.0
@@ -75,6 +76,8 @@ run_test (PerformanceTest *test)
   gpointer data = NULL;
   guint64 i, num_rounds;
   double elapsed, min_elapsed, max_elapsed, avg_elapsed, factor;
+  double *samples;
+  guint r;
   GTimer *timer;
 
   if (verbose || !quiet)
@@ -174,48 +177,63 @@ run_test (PerformanceTest *test)
   if (verbose)
     g_print ("Running %"G_GINT64_MODIFIER"d rounds\n", num_rounds);
 
-  /* Run the test */
-  avg_elapsed = 0.0;
-  min_elapsed = 1e100;
-  max_elapsed = 0.0;
-  for (i = 0; i < num_rounds; i++)
-    {
-      test->init (test, data, factor);
-      g_timer_start (timer);
-      test->run (test, data);
-      g_timer_stop (timer);
-      test->finish (test, data);
+  samples = g_new (double, perf_report_repeat);
 
-      if (i < num_rounds / 20)
+  for (r = 0; r < (guint) perf_report_repeat; r++)
+    {
+      /* Run the test */
+      avg_elapsed = 0.0;
+      min_elapsed = 1e100;
+      max_elapsed = 0.0;
+      for (i = 0; i < num_rounds; i++)
         {
-          /* The first 5% are additional warm up. Ignore. */
-          continue;
+          test->init (test, data, factor);
+          g_timer_start (timer);
+          test->run (test, data);
+          g_timer_stop (timer);
+          test->finish (test, data);
+
+          if (i < num_rounds / 20)
+            {
+              /* The first 5% are additional warm up. Ignore. */
+              continue;
+            }
+
+          elapsed = g_timer_elapsed (timer, NULL);
+
+          min_elapsed = MIN (min_elapsed, elapsed);
+          max_elapsed = MAX (max_elapsed, elapsed);
+          avg_elapsed += elapsed;
         }
 
-      elapsed = g_timer_elapsed (timer, NULL);
+      if (num_rounds > 1)
+        avg_elapsed = avg_elapsed / num_rounds;
 
-      min_elapsed = MIN (min_elapsed, elapsed);
-      max_elapsed = MAX (max_elapsed, elapsed);
-      avg_elapsed += elapsed;
+      if (verbose)
+        {
+          g_print ("Minimum corrected round time: %.2f msecs\n", min_elapsed * 1000);
+          g_print ("Maximum corrected round time: %.2f msecs\n", max_elapsed * 1000);
+          g_print ("Average corrected round time: %.2f msecs\n", avg_elapsed * 1000);
+        }
+
+      /* The amount of work in a round scales with the factor, so this is
+       * comparable between runs with a different factor */
+      samples[r] = min_elapsed / factor * 1000000;
     }
 
-  if (num_rounds > 1)
-    avg_elapsed = avg_elapsed / num_rounds;
+  perf_report_add (test->name, "usecs per round", FALSE, samples, perf_report_repeat);
 
-  if (verbose)
+  /* Print the results, for the median round */
+  if (!perf_report_is_json ())
     {
-      g_print ("Minimum corrected round time: %.2f msecs\n", min_elapsed * 1000);
-      g_print ("Maximum corrected round time: %.2f msecs\n", max_elapsed * 1000);
-      g_print ("Average corrected round time: %.2f msecs\n", avg_elapsed * 1000);
+      g_print ("%s: ", test->name);
+      test->print_result (test, data, samples[perf_report_repeat / 2] * factor / 1000000);
     }
 
-  /* Print the results */
-  g_print ("%s: ", test->name);
-  test->print_result (test, data, min_elapsed);
-
   /* Tear down */
   test->teardown (test, data);
   g_timer_destroy (timer);
+  g_free (samples);
 }
 
 /*************************************************************
@@ -772,6 +790,27 @@ test_type_check_run (PerformanceTest *test,
     }
 }
 
+/* The same interface check over and over, as in G_IS_LIST_MODEL() calls
+ * in a loop */
+static void
+test_type_check_interface_run (PerformanceTest *test,
+                               gpointer _data)
+{
+  struct TypeCheckTest *data = _data;
+  GObject *object = data->object;
+  GType type = test_iface3_get_type ();
+  int i, j;
+
+  for (i = 0; i < data->n_checks; i++)
+    {
+      for (j = 0; j < 1000; j++)
+        {
+          my_type_check_instance_is_a ((GTypeInstance *)object,
+                                       type);
+        }
+    }
+}
+
 static void
 test_type_check_finish (PerformanceTest *test,
 			gpointer data)
@@ -1117,6 +1156,7 @@ test_notify_handled_teardown (PerformanceTest *test,
 
 struct SetTest {
   GObject *object;
+  char *name;
   unsigned n_checks;
 };
 
@@ -1131,6 +1171,20 @@ test_set_run (PerformanceTest *test,
     g_object_set (object, "val1", i, NULL);
 }
 
+static void
+test_set_by_name_run (PerformanceTest *test,
+                      void *_data)
+{
+  struct SetTest *data = _data;
+  GObject *object = data->object;
+  const char *name = data->name;
+
+  /* A non-literal name misses the class' pspecs array and has
+   * to be looked up by name */
+  for (unsigned i = 0; i < data->n_checks; i++)
+    g_object_set (object, name, i, NULL);
+}
+
 static void *
 test_set_setup (PerformanceTest *test)
 {
@@ -1138,6 +1192,7 @@ test_set_setup (PerformanceTest *test)
 
   data = g_new0 (struct SetTest, 1);
   data->object = g_object_new (COMPLEX_TYPE_OBJECT, NULL);
+  data->name = g_strdup ("val1");
 
   /* g_object_get() will take a reference. Increasing the ref count from 1 to 2
    * is more expensive, due to the check for toggle notifications. We have a
@@ -1183,6 +1238,7 @@ test_set_teardown (PerformanceTest *test,
 
   g_object_unref (data->object);
   g_object_unref (data->object);
+  g_free (data->name);
   g_free (data);
 }
 
@@ -1194,6 +1250,7 @@ test_set_teardown (PerformanceTest *test,
 
 struct GetTest {
   GObject *object;
+  char *name;
   unsigned n_checks;
 };
 
@@ -1209,6 +1266,19 @@ test_get_run (PerformanceTest *test,
     g_object_get (object, "val1", &val, NULL);
 }
 
+static void
+test_get_by_name_run (PerformanceTest *test,
+                      void *_data)
+{
+  struct GetTest *data = _data;
+  GObject *object = data->object;
+  const char *name = data->name;
+  int val;
+
+  for (unsigned i = 0; i < data->n_checks; i++)
+    g_object_get (object, name, &val, NULL);
+}
+
 static void *
 test_get_setup (PerformanceTest *test)
 {
@@ -1216,6 +1286,7 @@ test_get_setup (PerformanceTest *test)
 
   data = g_new0 (struct GetTest, 1);
   data->object = g_object_new (COMPLEX_TYPE_OBJECT, NULL);
+  data->name = g_strdup ("val1");
 
   /* g_object_get() will take a reference. Increasing the ref count from 1 to 2
    * is more expensive, due to the check for toggle notifications. We have a
@@ -1261,6 +1332,7 @@ test_get_teardown (PerformanceTest *test,
 
   g_object_unref (data->object);
   g_object_unref (data->object);
+  g_free (data->name);
   g_free (data);
 }
 
@@ -1455,6 +1527,16 @@ static PerformanceTest tests[] = {
     test_type_check_teardown,
     test_type_check_print_result
   },
+  {
+    "type-check-interface",
+    NULL,
+    test_type_check_setup,
+    test_type_check_init,
+    test_type_check_interface_run,
+    test_type_check_finish,
+    test_type_check_teardown,
+    test_type_check_print_result
+  },
   {
     "emit-unhandled",
     GINT_TO_POINTER (COMPLEX_SIGNAL),
@@ -1615,6 +1697,26 @@ static PerformanceTest tests[] = {
     test_get_teardown,
     test_get_print_result
   },
+  {
+    "property-set-by-name",
+    complex_object_get_type,
+    test_set_setup,
+    test_set_init,
+    test_set_by_name_run,
+    test_set_finish,
+    test_set_teardown,
+    test_set_print_result
+  },
+  {
+    "property-get-by-name",
+    complex_object_get_type,
+    test_get_setup,
+    test_get_init,
+    test_get_by_name_run,
+    test_get_finish,
+    test_get_teardown,
+    test_get_print_result
+  },
   {
     "refcount",
     NULL,
@@ -1675,12 +1777,21 @@ main (int   argc,
 
   context = g_option_context_new ("GObject performance tests");
   g_option_context_add_main_entries (context, cmd_entries, NULL);
-  if (!g_option_context_parse (context, &argc, &argv, &error))
+  g_option_context_add_main_entries (context, perf_report_entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error) ||
+      !perf_report_init (&error))
     {
       g_printerr ("%s: %s\n", argv[0], error->message);
       return 1;
     }
 
+  if (perf_report_is_json ())
+    {
+      /* Keep stdout parseable */
+      verbose = FALSE;
+      quiet = TRUE;
+    }
+
   if (test_factor < 0)
     {
       g_printerr ("%s: test factor must be positive\n", argv[0]);
@@ -1707,5 +1818,5 @@ main (int   argc,
 
   g_option_context_free (context);
   g_clear_pointer (&global_timer, g_timer_destroy);
-  return 0;
+  return perf_report_finish ();
 }
@@ -746,6 +746,45 @@ properties_get_property (void)
   g_object_unref (test_obj);
 }
 
+static void
+properties_get_transfer (void)
+{
+  TestObject *test_obj;
+  gchar *baz1 = NULL, *baz2 = NULL;
+  GVariant *var1 = NULL, *var2 = NULL;
+
+  g_test_summary ("g_object_get() returns contents owned by the caller, "
+                  "not shared with the object or between calls");
+
+  test_obj = g_object_new (test_object_get_type (),
+                           "baz", "hello",
+                           "var", g_variant_new_string ("one"),
+                           NULL);
+
+  g_object_get (test_obj, "baz", &baz1, "var", &var1, NULL);
+  g_object_get (test_obj, "baz", &baz2, "var", &var2, NULL);
+  g_assert_cmpstr (baz1, ==, "hello");
+  g_assert_cmpstr (baz2, ==, "hello");
+  g_assert_true (baz1 != baz2);
+  g_assert_true (baz1 != test_obj->baz);
+  g_assert_true (var1 == var2);
+  g_assert_false (g_variant_is_floating (var1));
+
+  g_object_set (test_obj,
+                "baz", "world",
+                "var", g_variant_new_string ("two"),
+                NULL);
+  g_object_unref (test_obj);
+
+  g_assert_cmpstr (baz1, ==, "hello");
+  g_assert_cmpstr (g_variant_get_string (var1, NULL), ==, "one");
+
+  g_free (baz1);
+  g_free (baz2);
+  g_variant_unref (var1);
+  g_variant_unref (var2);
+}
+
 static void
 properties_set_property_variant_floating (void)
 {
@@ -821,6 +860,227 @@ properties_testv_notify_queue (void)
   g_object_unref (test_obj);
 }
 
+/* More than fit into the notify queue inline */
+#define N_MANY_PROPERTIES 24
+
+typedef struct {
+  GObject parent_instance;
+  gint values[N_MANY_PROPERTIES];
+} ManyObject;
+
+typedef GObjectClass ManyObjectClass;
+
+static GParamSpec *many_properties[N_MANY_PROPERTIES + 1] = { NULL, };
+
+static GType many_object_get_type (void);
+G_DEFINE_TYPE (ManyObject, many_object, G_TYPE_OBJECT)
+
+static void
+many_object_set_property (GObject      *gobject,
+                          guint         prop_id,
+                          const GValue *value,
+                          GParamSpec   *pspec)
+{
+  ((ManyObject *) gobject)->values[prop_id - 1] = g_value_get_int (value);
+}
+
+static void
+many_object_get_property (GObject    *gobject,
+                          guint       prop_id,
+                          GValue     *value,
+                          GParamSpec *pspec)
+{
+  g_value_set_int (value, ((ManyObject *) gobject)->values[prop_id - 1]);
+}
+
+static void
+many_object_class_init (ManyObjectClass *klass)
+{
+  guint i;
+
+  klass->set_property = many_object_set_property;
+  klass->get_property = many_object_get_property;
+
+  for (i = 1; i < G_N_ELEMENTS (many_properties); i++)
+    {
+      gchar *name = g_strdup_printf ("value%u", i);
+
+      many_properties[i] = g_param_spec_int (name, NULL, NULL,
+                                             G_MININT, G_MAXINT, 0,
+                                             G_PARAM_READWRITE);
+      g_free (name);
+    }
+
+  g_object_class_install_properties (klass, G_N_ELEMENTS (many_properties), many_properties);
+}
+
+static void
+many_object_init (ManyObject *self)
+{
+}
+
+static void
+on_notify_log (GObject    *gobject,
+               GParamSpec *pspec,
+               GPtrArray  *notified)
+{
+  g_ptr_array_add (notified, pspec);
+}
+
+static void
+properties_set_many_and_notify (void)
+{
+  GValue values[N_MANY_PROPERTIES] = { G_VALUE_INIT, };
+  GPtrArray *notified;
+  GObject *obj;
+  gint value;
+  guint i;
+
+  g_test_summary ("Test setting many properties at once by pspec");
+
+  obj = g_object_new (many_object_get_type (), NULL);
+  notified = g_ptr_array_new ();
+  g_signal_connect (obj, "notify", G_CALLBACK (on_notify_log), notified);
+
+  for (i = 0; i < N_MANY_PROPERTIES; i++)
+    {
+      g_value_init (&values[i], G_TYPE_INT);
+      g_value_set_int (&values[i], i * 10);
+    }
+
+  g_object_set_many_and_notify (obj, N_MANY_PROPERTIES, many_properties + 1, values);
+
+  for (i = 0; i < N_MANY_PROPERTIES; i++)
+    {
+      g_object_get (obj, many_properties[i + 1]->name, &value, NULL);
+      g_assert_cmpint (value, ==, i * 10);
+    }
+
+  /* Each property is notified once, the last one set first */
+  g_assert_cmpuint (notified->len, ==, N_MANY_PROPERTIES);
+  for (i = 0; i < N_MANY_PROPERTIES; i++)
+    g_assert_true (notified->pdata[i] == many_properties[N_MANY_PROPERTIES - i]);
+
+  /* Queueing the same properties again while frozen coalesces them */
+  g_ptr_array_set_size (notified, 0);
+  g_object_freeze_notify (obj);
+  g_object_set_many_and_notify (obj, N_MANY_PROPERTIES, many_properties + 1, values);
+  g_object_set_many_and_notify (obj, N_MANY_PROPERTIES, many_properties + 1, values);
+  g_assert_cmpuint (notified->len, ==, 0);
+  g_object_thaw_notify (obj);
+  g_assert_cmpuint (notified->len, ==, N_MANY_PROPERTIES);
+
+  for (i = 0; i < N_MANY_PROPERTIES; i++)
+    g_value_unset (&values[i]);
+  g_ptr_array_unref (notified);
+  g_object_unref (obj);
+}
+
+static void
+properties_lookup_by_name (void)
+{
+  GObjectClass *class;
+  TestObject *test_obj;
+  gchar *name;
+  gint foo;
+
+  g_test_summary ("Test property lookups with names that aren't the "
+                  "literals the properties were installed with");
+
+  class = g_type_class_ref (test_object_get_type ());
+
+  name = g_strdup ("quux");
+  g_assert_true (g_object_class_find_property (class, name) == properties[PROP_QUUX]);
+  g_free (name);
+
+  name = g_strdup ("nope");
+  g_assert_null (g_object_class_find_property (class, name));
+  g_free (name);
+
+  /* Type-prefixed names go through the pool */
+  name = g_strdup ("TestObject::foo");
+  g_assert_true (g_object_class_find_property (class, name) == properties[PROP_FOO]);
+  g_free (name);
+
+  test_obj = g_object_new (test_object_get_type (), NULL);
+  name = g_strdup ("foo");
+  g_object_set (test_obj, name, 23, NULL);
+  g_object_get (test_obj, name, &foo, NULL);
+  g_assert_cmpint (foo, ==, 23);
+  g_free (name);
+  g_object_unref (test_obj);
+
+  g_type_class_unref (class);
+}
+
+static void
+properties_new_prepared (void)
+{
+  const char *prop_names[3] = { "foo", "boo", "baz" };
+  const char *construct_names[1] = { "target-type" };
+  GValue values[3] = { G_VALUE_INIT, G_VALUE_INIT, G_VALUE_INIT };
+  GObjectClass *class;
+  GObjectNewPlan *plan;
+  TestObject *test_obj;
+  GObject *group;
+  GType target_type;
+  gint foo;
+  gchar *baz;
+  guint i;
+
+  g_test_summary ("Test creating objects from a GObjectNewPlan");
+
+  g_value_init (&values[0], G_TYPE_INT);
+  g_value_init (&values[1], G_TYPE_INT);
+  g_value_init (&values[2], G_TYPE_STRING);
+  g_value_set_string (&values[2], "pigs");
+
+  /* Unknown properties are reported once, when preparing */
+  g_test_expect_message ("GLib-GObject", G_LOG_LEVEL_CRITICAL, "*has no property named 'boo'*");
+  class = g_type_class_ref (test_object_get_type ());
+  plan = g_object_class_prepare_new (class, G_N_ELEMENTS (prop_names), prop_names);
+  g_test_assert_expected_messages ();
+  g_type_class_unref (class);
+
+  for (i = 0; i < 3; i++)
+    {
+      g_value_set_int (&values[0], i);
+      test_obj = (TestObject *) g_object_new_prepared (plan, values);
+      g_object_get (test_obj, "foo", &foo, "baz", &baz, NULL);
+      g_assert_cmpint (foo, ==, i);
+      g_assert_cmpstr (baz, ==, "pigs");
+      g_free (baz);
+      g_object_unref (test_obj);
+    }
+
+  g_object_new_plan_unref (plan);
+
+  for (i = 0; i < G_N_ELEMENTS (values); i++)
+    g_value_unset (&values[i]);
+
+  /* Construct-only properties, given and defaulted */
+  g_value_init (&values[0], G_TYPE_GTYPE);
+  g_value_set_gtype (&values[0], test_object_get_type ());
+
+  class = g_type_class_ref (G_TYPE_SIGNAL_GROUP);
+  plan = g_object_class_prepare_new (class, G_N_ELEMENTS (construct_names), construct_names);
+  group = g_object_new_prepared (plan, values);
+  g_object_get (group, "target-type", &target_type, NULL);
+  g_assert_cmpint (target_type, ==, test_object_get_type ());
+  g_object_unref (group);
+  g_object_new_plan_unref (plan);
+
+  plan = g_object_class_prepare_new (class, 0, NULL);
+  group = g_object_new_prepared (plan, NULL);
+  g_object_get (group, "target-type", &target_type, NULL);
+  g_assert_cmpint (target_type, ==, G_TYPE_OBJECT);
+  g_object_unref (group);
+  g_object_new_plan_unref (plan);
+
+  g_type_class_unref (class);
+  g_value_unset (&values[0]);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -832,6 +1092,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/properties/notify-queue", properties_notify_queue);
   g_test_add_func ("/properties/construct", properties_construct);
   g_test_add_func ("/properties/get-property", properties_get_property);
+  g_test_add_func ("/properties/get-transfer", properties_get_transfer);
   g_test_add_func ("/properties/set-property/variant/floating", properties_set_property_variant_floating);
 
   g_test_add_func ("/properties/testv_with_no_properties",
@@ -845,6 +1106,9 @@ main (int argc, char *argv[])
   g_test_add_func ("/properties/testv_getv", properties_testv_getv);
   g_test_add_func ("/properties/testv_notify_queue",
       properties_testv_notify_queue);
+  g_test_add_func ("/properties/lookup-by-name", properties_lookup_by_name);
+  g_test_add_func ("/properties/set-many-and-notify", properties_set_many_and_notify);
+  g_test_add_func ("/properties/new-prepared", properties_new_prepared);
 
   return g_test_run ();
 }
@@ -542,6 +542,34 @@ test_class_init (TestClass *klass)
                 G_TYPE_VARIANT,
 		G_TYPE_INT64,
 		G_TYPE_UINT64);
+  g_signal_new ("uint-uint-uint",
+                G_TYPE_FROM_CLASS (klass),
+                G_SIGNAL_RUN_LAST,
+                0,
+                NULL, NULL,
+                NULL,
+                G_TYPE_NONE,
+                3,
+                G_TYPE_UINT, G_TYPE_UINT, G_TYPE_UINT);
+  g_signal_new ("boolean-void",
+                G_TYPE_FROM_CLASS (klass),
+                G_SIGNAL_RUN_LAST,
+                0,
+                NULL, NULL,
+                NULL,
+                G_TYPE_BOOLEAN,
+                0);
+  g_signal_new ("string-many-strings",
+                G_TYPE_FROM_CLASS (klass),
+                G_SIGNAL_RUN_LAST,
+                0,
+                NULL, NULL,
+                NULL,
+                G_TYPE_STRING,
+                10,
+                G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING,
+                G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING,
+                G_TYPE_STRING, G_TYPE_STRING);
 }
 
 typedef struct _Test Test2;
@@ -1491,6 +1519,9 @@ test_introspection (void)
     "all-types-null",
     "all-types-empty",
     "custom-marshaller",
+    "uint-uint-uint",
+    "boolean-void",
+    "string-many-strings",
     NULL
   };
   GSignalQuery query;
@@ -2083,6 +2114,220 @@ test_weak_ref_disconnect (void)
   g_weak_ref_clear (&state.wr);
 }
 
+static void
+test_unhandled_emission (void)
+{
+  GObject *test;
+  gint count = 0;
+  gulong hook;
+
+  g_test_summary ("Test that emissions skipped because nothing is connected "
+                  "notice hooks and handlers added later");
+
+  test = g_object_new (test_get_type (), NULL);
+
+  /* Nothing connected: these may return without any locking */
+  g_signal_emit (test, simple_id, 0);
+  g_signal_emit (test, simple_id, 0);
+  g_signal_emit_by_name (test, "simple-detailed::a");
+  g_signal_emit_by_name (test, "simple-detailed::a");
+
+  hook = g_signal_add_emission_hook (simple_id, 0, hook_func, &count, NULL);
+  g_signal_emit (test, simple_id, 0);
+  g_assert_cmpint (count, ==, 1);
+  g_signal_remove_emission_hook (simple_id, hook);
+
+  g_signal_emit (test, simple_id, 0);
+  g_signal_emit (test, simple_id, 0);
+  g_assert_cmpint (count, ==, 1);
+
+  g_signal_connect (test, "simple", G_CALLBACK (test_handler), &count);
+  g_signal_emit (test, simple_id, 0);
+  g_assert_cmpint (count, ==, 2);
+
+  g_object_unref (test);
+}
+
+typedef struct
+{
+  GObject *object;
+  gint n_handled;  /* (atomic) */
+  gint stop;       /* (atomic) */
+} UnhandledEmissionThreaded;
+
+static void
+unhandled_emission_handler (gpointer instance,
+                            gpointer data)
+{
+  UnhandledEmissionThreaded *state = data;
+
+  g_atomic_int_inc (&state->n_handled);
+}
+
+static gpointer
+unhandled_emission_thread (gpointer data)
+{
+  UnhandledEmissionThreaded *state = data;
+  GObject *own = g_object_new (test_get_type (), NULL);
+
+  while (!g_atomic_int_get (&state->stop))
+    {
+      g_signal_emit (own, simple_id, 0);
+      g_signal_emit (state->object, simple_id, 0);
+    }
+
+  g_object_unref (own);
+
+  return NULL;
+}
+
+static void
+test_unhandled_emission_threaded (void)
+{
+  UnhandledEmissionThreaded state = { NULL, 0, 0 };
+  GThread *threads[4];
+  gsize i;
+
+  g_test_summary ("Test that a handler connected while other threads emit "
+                  "on an unhandled instance gets called");
+
+  state.object = g_object_new (test_get_type (), NULL);
+
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    threads[i] = g_thread_new ("emitter", unhandled_emission_thread, &state);
+
+  g_usleep (G_USEC_PER_SEC / 100);
+  g_signal_connect (state.object, "simple", G_CALLBACK (unhandled_emission_handler), &state);
+
+  while (g_atomic_int_get (&state.n_handled) < 1000)
+    g_thread_yield ();
+
+  g_atomic_int_set (&state.stop, TRUE);
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    g_thread_join (threads[i]);
+
+  g_object_unref (state.object);
+}
+
+static void
+uint_uint_uint_handler (GObject  *test,
+                        guint     a,
+                        guint     b,
+                        guint     c,
+                        gpointer  data)
+{
+  GString *log = data;
+
+  g_string_append_printf (log, "%u%u%u,", a, b, c);
+}
+
+static void
+uint_uint_uint_handler_after (GObject  *test,
+                              guint     a,
+                              guint     b,
+                              guint     c,
+                              gpointer  data)
+{
+  GString *log = data;
+
+  g_string_append (log, "after,");
+}
+
+static void
+uint_uint_uint_handler_stop (GObject  *test,
+                             guint     a,
+                             guint     b,
+                             guint     c,
+                             gpointer  data)
+{
+  GString *log = data;
+
+  g_string_append (log, "stop,");
+  g_signal_stop_emission_by_name (test, "uint-uint-uint");
+}
+
+static gboolean
+boolean_void_handler (GObject  *test,
+                      gpointer  data)
+{
+  return TRUE;
+}
+
+static void
+test_builtin_marshallers (void)
+{
+  GObject *test;
+  GString *log = g_string_new (NULL);
+  gboolean ret = FALSE;
+
+  g_test_summary ("Test signals using the builtin marshallers picked when "
+                  "none is given, with several handlers run from the va_list");
+
+  test = g_object_new (test_get_type (), NULL);
+
+  g_signal_connect (test, "uint-uint-uint", G_CALLBACK (uint_uint_uint_handler), log);
+  g_signal_connect_after (test, "uint-uint-uint", G_CALLBACK (uint_uint_uint_handler_after), log);
+  g_signal_connect (test, "uint-uint-uint", G_CALLBACK (uint_uint_uint_handler), log);
+
+  g_signal_emit_by_name (test, "uint-uint-uint", 1, 2, 3);
+  g_assert_cmpstr (log->str, ==, "123,123,after,");
+
+  g_string_truncate (log, 0);
+  g_signal_connect (test, "uint-uint-uint", G_CALLBACK (uint_uint_uint_handler_stop), log);
+  g_signal_connect (test, "uint-uint-uint", G_CALLBACK (uint_uint_uint_handler), log);
+  g_signal_emit_by_name (test, "uint-uint-uint", 4, 5, 6);
+  g_assert_cmpstr (log->str, ==, "456,456,stop,");
+
+  g_signal_connect (test, "boolean-void", G_CALLBACK (boolean_void_handler), NULL);
+  g_signal_emit_by_name (test, "boolean-void", &ret);
+  g_assert_true (ret);
+
+  g_object_unref (test);
+  g_string_free (log, TRUE);
+}
+
+static gchar *
+string_many_strings_handler (GObject     *test,
+                             const gchar *a,
+                             const gchar *b,
+                             const gchar *c,
+                             const gchar *d,
+                             const gchar *e,
+                             const gchar *f,
+                             const gchar *g,
+                             const gchar *h,
+                             const gchar *i,
+                             const gchar *j,
+                             gpointer     data)
+{
+  return g_strconcat (a, b, c, d, e, f, g, h, i, j, NULL);
+}
+
+static void
+test_many_params_return_string (void)
+{
+  GObject *test;
+  gchar *ret = NULL;
+  guint i;
+
+  g_test_summary ("Test emitting a signal with more parameters than are "
+                  "collected without allocating, returning a string");
+
+  test = g_object_new (test_get_type (), NULL);
+  g_signal_connect (test, "string-many-strings", G_CALLBACK (string_many_strings_handler), NULL);
+
+  for (i = 0; i < 3; i++)
+    {
+      g_signal_emit_by_name (test, "string-many-strings",
+                             "a", "b", "c", "d", "e", "f", "g", "h", "i", "j",
+                             &ret);
+      g_assert_cmpstr (ret, ==, "abcdefghij");
+      g_free (ret);
+    }
+
+  g_object_unref (test);
+}
+
 /* --- */
 
 int
@@ -2122,6 +2367,10 @@ main (int argc,
   g_test_add_data_func ("/gobject/signals/invalid-name/empty", "", test_signals_invalid_name);
   g_test_add_func ("/gobject/signals/is-valid-name", test_signal_is_valid_name);
   g_test_add_func ("/gobject/signals/weak-ref-disconnect", test_weak_ref_disconnect);
+  g_test_add_func ("/gobject/signals/unhandled-emission", test_unhandled_emission);
+  g_test_add_func ("/gobject/signals/unhandled-emission/threaded", test_unhandled_emission_threaded);
+  g_test_add_func ("/gobject/signals/builtin-marshallers", test_builtin_marshallers);
+  g_test_add_func ("/gobject/signals/many-params-return-string", test_many_params_return_string);
 
   return g_test_run ();
 }
@@ -229,6 +229,125 @@ test_query (void)
   g_assert_cmpuint (results.type, ==, 0);
 }
 
+typedef struct {
+  GObject parent_instance;
+  int value;
+} Cached;
+
+typedef GObjectClass CachedClass;
+
+/* No private data, which valgrind builds would allocate differently */
+static GType cached_get_type (void);
+G_DEFINE_TYPE (Cached, cached, G_TYPE_OBJECT)
+
+static void
+cached_class_init (CachedClass *klass)
+{
+}
+
+static void
+cached_init (Cached *self)
+{
+  g_assert_cmpint (self->value, ==, 0);
+}
+
+static void
+test_instance_cache (void)
+{
+  Cached *object, *cached;
+
+  g_test_summary ("Test that freed instances are reused, zeroed, when "
+                  "the type has an instance cache");
+
+  g_type_set_instance_cache_size (cached_get_type (), 4);
+
+  object = g_object_new (cached_get_type (), NULL);
+  object->value = 1;
+  g_object_unref (object);
+
+  /* cached_init() checks that it is zeroed again */
+  cached = g_object_new (cached_get_type (), NULL);
+  g_assert_true (cached == object);
+  g_object_unref (cached);
+
+  g_type_trim_instance_caches ();
+  object = g_object_new (cached_get_type (), NULL);
+  g_object_unref (object);
+
+  g_type_set_instance_cache_size (cached_get_type (), 0);
+  g_type_trim_instance_caches ();
+}
+
+typedef GObject Counted;
+typedef GObjectClass CountedClass;
+
+static GType counted_get_type (void);
+G_DEFINE_TYPE (Counted, counted, G_TYPE_OBJECT)
+
+static void
+counted_class_init (CountedClass *klass)
+{
+}
+
+static void
+counted_init (Counted *self)
+{
+}
+
+static gpointer
+create_counted_objects (gpointer data)
+{
+  guint i;
+
+  for (i = 0; i < 100; i++)
+    g_object_unref (g_object_new (counted_get_type (), NULL));
+
+  return NULL;
+}
+
+static void
+test_instance_counting (void)
+{
+  GObject *objects[3];
+  GThread *threads[4];
+  gsize n_live;
+  guint64 n_total;
+  guint i;
+
+  g_test_summary ("Test that live and total instances are counted once "
+                  "counting is enabled, also across threads");
+
+  g_assert_false (g_type_get_instance_counts (counted_get_type (), &n_live, &n_total));
+  g_assert_cmpuint (n_live, ==, 0);
+  g_assert_cmpuint (n_total, ==, 0);
+
+  g_type_enable_instance_counting (counted_get_type ());
+
+  for (i = 0; i < G_N_ELEMENTS (objects); i++)
+    objects[i] = g_object_new (counted_get_type (), NULL);
+  g_object_unref (objects[0]);
+
+  g_assert_true (g_type_get_instance_counts (counted_get_type (), &n_live, &n_total));
+  g_assert_cmpuint (n_live, ==, 2);
+  g_assert_cmpuint (n_total, ==, 3);
+  g_assert_cmpint (g_type_get_instance_count (counted_get_type ()), ==, 2);
+
+  /* Only enabled for exactly this type */
+  g_assert_false (g_type_get_instance_counts (G_TYPE_OBJECT, NULL, NULL));
+
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    threads[i] = g_thread_new ("counted", create_counted_objects, NULL);
+  for (i = 0; i < G_N_ELEMENTS (threads); i++)
+    g_thread_join (threads[i]);
+
+  g_object_unref (objects[1]);
+  g_object_unref (objects[2]);
+
+  g_assert_true (g_type_get_instance_counts (counted_get_type (), &n_live, &n_total));
+  g_assert_cmpuint (n_live, ==, 0);
+  g_assert_cmpuint (n_total, ==, 3 + G_N_ELEMENTS (threads) * 100);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -240,6 +359,8 @@ main (int argc, char *argv[])
   g_test_add_func ("/type/next-base", test_next_base);
   g_test_add_func ("/type/is-a", test_is_a);
   g_test_add_func ("/type/query", test_query);
+  g_test_add_func ("/type/instance-cache", test_instance_cache);
+  g_test_add_func ("/type/instance-counting", test_instance_counting);
 
   return g_test_run ();
 }